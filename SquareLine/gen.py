@@ -1,4 +1,4 @@
-# SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
 # SPDX-License-Identifier: Apache-2.0
 import sys
 import os
@@ -18,6 +18,29 @@ BOARD_GENFILE = "manifest.json"
 COMPONENTS_SPECIFIC_FILES = "components"
 # Files, which are specific for each board. Will be copied from boards/BOARD/ directory
 BOARD_SPECIFIC_FILES = {"sdkconfig.defaults", "main/idf_component.yml", "partitions.csv"}
+# sdkconfig file of the board, the performance profile is added to it
+SDKCONFIG_FILE = "sdkconfig.defaults"
+# Performance profile of LVGL 9 boards (settings of examples/display_lvgl_benchmark), common for all MCUs
+PERF_PROFILE = {
+    "CONFIG_ESPTOOLPY_FLASHMODE_QIO": "y",
+    "CONFIG_ESPTOOLPY_FLASHFREQ_80M": "y",
+    "CONFIG_COMPILER_OPTIMIZATION_PERF": "y",
+    "CONFIG_FREERTOS_HZ": "1000",
+    "CONFIG_LV_ATTRIBUTE_FAST_MEM_USE_IRAM": "y",
+}
+# Performance profile by MCU (maximal CPU frequency, assembly render of esp_lvgl_port where available)
+PERF_PROFILE_ASM = {
+    "CONFIG_LV_DRAW_SW_ASM_CUSTOM": "y",
+    "CONFIG_LV_USE_DRAW_SW_ASM": "255",
+    "CONFIG_LV_DRAW_SW_ASM_CUSTOM_INCLUDE": "\"esp_lvgl_port_lv_blend.h\"",
+}
+PERF_PROFILE_MCU = {
+    "ESP32": {"CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ_240": "y", **PERF_PROFILE_ASM},
+    "ESP32S2": {"CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ_240": "y"},
+    "ESP32S3": {"CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ_240": "y", **PERF_PROFILE_ASM},
+    "ESP32C3": {"CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ_160": "y"},
+    "ESP32P4": {"CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ_360": "y", **PERF_PROFILE_ASM},
+}
 # Generated output directory
 OUT_DIR = "espressif"
 # SquareLine output directory
@@ -191,6 +214,48 @@ def create_slb_file(output, output_filename, manifest):
     print(f"  File {output_filename}.slb created.")
 
 
+# Get sdkconfig option name from line ("CONFIG_X=y" or "# CONFIG_X is not set"), None for other lines
+def get_sdkconfig_option(line):
+    line = line.strip()
+    if line.startswith("CONFIG_") and "=" in line:
+        return line.split("=", 1)[0]
+    if line.startswith("# CONFIG_") and line.endswith(" is not set"):
+        return line[2:-len(" is not set")]
+    return None
+
+
+# Get performance profile of the board: common, MCU and board settings from manifest "performance" (value null removes option)
+def get_performance_profile(manifest):
+    check_json_key(manifest, "mcu")
+    check_json_key(manifest, "supported_lvgl_version")
+    performance = manifest.get("performance", {})
+    if not manifest["supported_lvgl_version"].startswith("9") or not performance.get("enabled", True):
+        return {}
+    profile = {**PERF_PROFILE, **PERF_PROFILE_MCU.get(manifest["mcu"].upper(), {}), **performance.get("sdkconfig", {})}
+    return {key: value for key, value in profile.items() if value is not None}
+
+
+# Add performance profile to sdkconfig; the options set by the board sdkconfig are kept
+def add_performance_profile(sdkconfig_path, manifest):
+    profile = get_performance_profile(manifest)
+    if not profile:
+        return
+    lines = []
+    if os.path.exists(sdkconfig_path):
+        with open(sdkconfig_path, "r") as f:
+            lines = f.read().splitlines()
+    board_options = {get_sdkconfig_option(line) for line in lines}
+    added = [f"{key}={value}" for key, value in profile.items() if key not in board_options]
+    if not added:
+        return
+    if lines:
+        lines.append("")
+    lines += ["# Performance profile (generated by gen.py)"] + added
+    with open(sdkconfig_path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print(f"  Performance profile: {len(added)} options added to {SDKCONFIG_FILE}")
+
+
 # Process of the board generating
 def process_board(board_name, output, dir):
     print(f"Processing board: {dir}")
@@ -217,6 +282,7 @@ def process_board(board_name, output, dir):
             board_specific_file = os.path.join(dir, file)
             if os.path.exists(board_specific_file):
                 copy_file(board_specific_file, os.path.join(squareline_dir_path, file), placeholders)
+        add_performance_profile(os.path.join(squareline_dir_path, SDKCONFIG_FILE), manifest)
         # Copy components, if exists
         components_dir_path = os.path.join(dir, COMPONENTS_SPECIFIC_FILES)
         if os.path.exists(components_dir_path):
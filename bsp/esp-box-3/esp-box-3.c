@@ -4,6 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
 #include "driver/gpio.h"
 #include "driver/ledc.h"
 #include "driver/spi_master.h"
@@ -15,6 +19,14 @@
 #include "esp_lcd_panel_vendor.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_vfs_fat.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#if CONFIG_BSP_PROBE_CACHE
+#include "nvs.h"
+#endif
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 
 #include "iot_button.h"
 #include "bsp/esp-box-3.h"
@@ -23,6 +35,7 @@
 #include "esp_lcd_touch_tt21100.h"
 #include "esp_lcd_touch_gt911.h"
 #include "esp_lcd_ili9341.h"
+#include "icm42670.h"
 #include "esp_lvgl_port.h"
 #include "bsp_err_check.h"
 #include "esp_codec_dev_defaults.h"
@@ -57,6 +70,8 @@ static lv_display_t *disp;
 static lv_indev_t *disp_indev = NULL;
 static esp_lcd_touch_handle_t tp;   // LCD touch handle
 static esp_lcd_panel_handle_t panel_handle = NULL;
+static esp_lcd_panel_io_handle_t panel_io_handle = NULL;
+static bool brightness_initialized = false;
 sdmmc_card_t *bsp_sdcard = NULL;    // Global SD card handler
 
 /**
@@ -69,6 +84,11 @@ sdmmc_card_t *bsp_sdcard = NULL;    // Global SD card handler
  */
 static i2c_master_bus_handle_t i2c_handle = NULL;
 static bool i2c_initialized = false;
+#if CONFIG_BSP_I2C_SCHED
+static esp_i2c_sched_handle_t i2c_sched = NULL;
+static esp_i2c_sched_dev_handle_t tp_sched = NULL;
+static esp_err_t (*tp_read_data)(esp_lcd_touch_handle_t tp) = NULL;
+#endif
 
 // This is just a wrapper to get function signature for espressif/button API callback
 static uint8_t bsp_get_main_button(void *param);
@@ -109,6 +129,12 @@ esp_err_t bsp_i2c_init(void)
         .clk_source = I2C_CLK_SRC_DEFAULT,
     };
     BSP_ERROR_CHECK_RETURN_ERR(i2c_new_master_bus(&i2c_config, &i2c_handle));
+#if CONFIG_BSP_I2C_SCHED
+    /* Scheduler is kept over deinit, devices may stay added */
+    if (i2c_sched == NULL) {
+        BSP_ERROR_CHECK_RETURN_ERR(esp_i2c_sched_new(&i2c_sched));
+    }
+#endif
 
     i2c_initialized = true;
     return ESP_OK;
@@ -132,6 +158,94 @@ static esp_err_t bsp_i2c_device_probe(uint8_t addr)
     return i2c_master_probe(i2c_handle, addr, 100);
 }
 
+#if CONFIG_BSP_PROBE_CACHE
+#define BSP_PROBE_CACHE_NAMESPACE   "bsp"
+#define BSP_PROBE_CACHE_KEY_TOUCH   "box3_touch"
+
+static esp_err_t bsp_probe_cache_get(const char *key, uint8_t *value)
+{
+    nvs_handle_t nvs;
+    esp_err_t ret = nvs_open(BSP_PROBE_CACHE_NAMESPACE, NVS_READONLY, &nvs);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = nvs_get_u8(nvs, key, value);
+    nvs_close(nvs);
+    return ret;
+}
+
+static void bsp_probe_cache_set(const char *key, uint8_t value)
+{
+    nvs_handle_t nvs;
+    uint8_t stored;
+    /* NVS not initialized by the application, the cache is not used */
+    if (nvs_open(BSP_PROBE_CACHE_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK) {
+        return;
+    }
+    if (nvs_get_u8(nvs, key, &stored) != ESP_OK || stored != value) {
+        if (nvs_set_u8(nvs, key, value) != ESP_OK || nvs_commit(nvs) != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to store probe result");
+        }
+    }
+    nvs_close(nvs);
+}
+#endif
+
+#if CONFIG_BSP_LVGL_FS
+#define BSP_LVGL_FS_SPIFFS  BIT(0)
+#define BSP_LVGL_FS_SDCARD  BIT(1)
+
+static portMUX_TYPE lvgl_fs_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool lvgl_fs_ready = false;      /* LVGL port initialized */
+static uint32_t lvgl_fs_mounted = 0;
+
+static void bsp_lvgl_fs_add(uint32_t fs)
+{
+    const lvgl_port_fs_cfg_t cfg = {
+        .letter = (fs == BSP_LVGL_FS_SDCARD) ? BSP_SD_LVGL_LETTER : BSP_SPIFFS_LVGL_LETTER,
+        .path = (fs == BSP_LVGL_FS_SDCARD) ? BSP_SD_MOUNT_POINT : BSP_SPIFFS_MOUNT_POINT,
+#if CONFIG_SPIRAM
+        .flags = {
+            .buff_spiram = true,
+        }
+#endif
+    };
+    if (lvgl_port_fs_add(&cfg) != ESP_OK) {
+        ESP_LOGW(TAG, "LVGL file system %c: not added", cfg.letter);
+    }
+}
+
+/* Drivers are added, when both the file system is mounted and LVGL is initialized (in any order) */
+static void bsp_lvgl_fs_mounted(uint32_t fs, bool mounted)
+{
+    portENTER_CRITICAL(&lvgl_fs_lock);
+    lvgl_fs_mounted = mounted ? (lvgl_fs_mounted | fs) : (lvgl_fs_mounted & ~fs);
+    const bool ready = lvgl_fs_ready;
+    portEXIT_CRITICAL(&lvgl_fs_lock);
+
+    if (ready && mounted) {
+        bsp_lvgl_fs_add(fs);
+    } else if (ready) {
+        lvgl_port_fs_remove((fs == BSP_LVGL_FS_SDCARD) ? BSP_SD_LVGL_LETTER : BSP_SPIFFS_LVGL_LETTER);
+    }
+}
+
+static void bsp_lvgl_fs_start(void)
+{
+    portENTER_CRITICAL(&lvgl_fs_lock);
+    lvgl_fs_ready = true;
+    const uint32_t mounted = lvgl_fs_mounted;
+    portEXIT_CRITICAL(&lvgl_fs_lock);
+
+    if (mounted & BSP_LVGL_FS_SPIFFS) {
+        bsp_lvgl_fs_add(BSP_LVGL_FS_SPIFFS);
+    }
+    if (mounted & BSP_LVGL_FS_SDCARD) {
+        bsp_lvgl_fs_add(BSP_LVGL_FS_SDCARD);
+    }
+}
+#endif
+
 esp_err_t bsp_spiffs_mount(void)
 {
     esp_vfs_spiffs_conf_t conf = {
@@ -148,6 +262,9 @@ esp_err_t bsp_spiffs_mount(void)
     esp_err_t ret_val = esp_vfs_spiffs_register(&conf);
 
     BSP_ERROR_CHECK_RETURN_ERR(ret_val);
+#if CONFIG_BSP_LVGL_FS
+    bsp_lvgl_fs_mounted(BSP_LVGL_FS_SPIFFS, true);
+#endif
 
     size_t total = 0, used = 0;
     ret_val = esp_spiffs_info(conf.partition_label, &total, &used);
@@ -162,11 +279,93 @@ esp_err_t bsp_spiffs_mount(void)
 
 esp_err_t bsp_spiffs_unmount(void)
 {
+#if CONFIG_BSP_LVGL_FS
+    bsp_lvgl_fs_mounted(BSP_LVGL_FS_SPIFFS, false);
+#endif
     return esp_vfs_spiffs_unregister(CONFIG_BSP_SPIFFS_PARTITION_LABEL);
 }
 
+static size_t sdcard_file_buffer_size = 0;
+
+static esp_mmap_assets_handle_t assets = NULL;
+
+esp_err_t bsp_assets_mount(void)
+{
+    ESP_RETURN_ON_FALSE(assets == NULL, ESP_ERR_INVALID_STATE, TAG, "Assets already mapped");
+    return esp_mmap_assets_new(CONFIG_BSP_ASSETS_PARTITION_LABEL, &assets);
+}
+
+esp_err_t bsp_assets_unmount(void)
+{
+    ESP_RETURN_ON_FALSE(assets, ESP_ERR_INVALID_STATE, TAG, "Assets not mapped");
+    ESP_RETURN_ON_ERROR(esp_mmap_assets_del(assets), TAG, "");
+    assets = NULL;
+    return ESP_OK;
+}
+
+esp_mmap_assets_handle_t bsp_assets_get_handle(void)
+{
+    return assets;
+}
+
+esp_err_t bsp_assets_get_image(const char *name, lv_img_dsc_t *dsc)
+{
+    ESP_RETURN_ON_FALSE(name && dsc, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    ESP_RETURN_ON_FALSE(assets, ESP_ERR_INVALID_STATE, TAG, "Assets not mapped");
+
+    esp_mmap_asset_t asset;
+    ESP_RETURN_ON_ERROR(esp_mmap_assets_find(assets, name, &asset), TAG, "Asset %s not found", name);
+
+    memset(dsc, 0, sizeof(lv_img_dsc_t));
+    switch (asset.format) {
+#if LVGL_VERSION_MAJOR >= 9
+    case ESP_MMAP_ASSET_FORMAT_RGB565:
+        dsc->header.cf = LV_COLOR_FORMAT_RGB565;
+        break;
+    case ESP_MMAP_ASSET_FORMAT_RGB565A8:
+        dsc->header.cf = LV_COLOR_FORMAT_RGB565A8;
+        break;
+    case ESP_MMAP_ASSET_FORMAT_JPEG:
+    case ESP_MMAP_ASSET_FORMAT_PNG:
+        dsc->header.cf = LV_COLOR_FORMAT_RAW;
+        break;
+#else
+    case ESP_MMAP_ASSET_FORMAT_RGB565:
+        dsc->header.cf = LV_IMG_CF_TRUE_COLOR;
+        break;
+    case ESP_MMAP_ASSET_FORMAT_JPEG:
+    case ESP_MMAP_ASSET_FORMAT_PNG:
+        dsc->header.cf = LV_IMG_CF_RAW;
+        break;
+#endif
+    default:
+        ESP_LOGE(TAG, "Asset %s is not supported image", name);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+#if LVGL_VERSION_MAJOR >= 9
+    dsc->header.magic = LV_IMAGE_HEADER_MAGIC;
+    if (asset.format == ESP_MMAP_ASSET_FORMAT_RGB565 || asset.format == ESP_MMAP_ASSET_FORMAT_RGB565A8) {
+        dsc->header.stride = asset.width * sizeof(uint16_t);
+    }
+#endif
+    dsc->header.w = asset.width;
+    dsc->header.h = asset.height;
+    dsc->data_size = asset.size;
+    dsc->data = asset.data;
+    return ESP_OK;
+}
+
 esp_err_t bsp_sdcard_mount(void)
 {
+    const bsp_sdcard_cfg_t cfg = BSP_SDCARD_DEFAULT_CONFIG();
+    return bsp_sdcard_mount_with_config(&cfg);
+}
+
+esp_err_t bsp_sdcard_mount_with_config(const bsp_sdcard_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
     gpio_config_t power_gpio_config = {
         .mode = GPIO_MODE_OUTPUT,
         .pin_bit_mask = 1ULL << BSP_SD_POWER
@@ -182,11 +381,12 @@ esp_err_t bsp_sdcard_mount(void)
 #else
         .format_if_mount_failed = false,
 #endif
-        .max_files = 5,
-        .allocation_unit_size = 16 * 1024
+        .max_files = cfg->max_files,
+        .allocation_unit_size = cfg->allocation_unit_size
     };
 
     sdmmc_host_t host = SDMMC_HOST_DEFAULT();
+    host.max_freq_khz = cfg->max_freq_khz;
     sdmmc_slot_config_t slot_config = SDMMC_SLOT_CONFIG_DEFAULT();
     slot_config.width = 4;
     slot_config.cmd = BSP_SD_CMD;
@@ -196,11 +396,97 @@ esp_err_t bsp_sdcard_mount(void)
     slot_config.d2 = BSP_SD_D2;
     slot_config.d3 = BSP_SD_D3;
 
-    return esp_vfs_fat_sdmmc_mount(BSP_SD_MOUNT_POINT, &host, &slot_config, &mount_config, &bsp_sdcard);
+    sdcard_file_buffer_size = cfg->file_buffer_size;
+    ESP_RETURN_ON_ERROR(esp_vfs_fat_sdmmc_mount(BSP_SD_MOUNT_POINT, &host, &slot_config, &mount_config, &bsp_sdcard), TAG, "SD card mount failed");
+#if CONFIG_BSP_LVGL_FS
+    bsp_lvgl_fs_mounted(BSP_LVGL_FS_SDCARD, true);
+#endif
+    return ESP_OK;
+}
+
+void *bsp_sdcard_file_buffer_add(FILE *f)
+{
+    if (f == NULL || sdcard_file_buffer_size == 0) {
+        return NULL;
+    }
+
+    void *buf = heap_caps_malloc(sdcard_file_buffer_size, MALLOC_CAP_SPIRAM);
+    if (buf == NULL) {
+        buf = malloc(sdcard_file_buffer_size);
+    }
+    if (buf == NULL) {
+        ESP_LOGW(TAG, "Not enough memory for file buffer");
+        return NULL;
+    }
+    if (setvbuf(f, buf, _IOFBF, sdcard_file_buffer_size) != 0) {
+        ESP_LOGW(TAG, "File buffer not set");
+        free(buf);
+        return NULL;
+    }
+    return buf;
+}
+
+esp_err_t bsp_sdcard_speed_test(size_t size, size_t chunk_size, uint32_t *write_kbps, uint32_t *read_kbps)
+{
+    esp_err_t ret = ESP_OK;
+    const char *path = BSP_SD_MOUNT_POINT"/speed.tmp";
+    ESP_RETURN_ON_FALSE(size > 0 && chunk_size > 0 && write_kbps && read_kbps, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    uint8_t *chunk = heap_caps_malloc(chunk_size, MALLOC_CAP_DMA);
+    ESP_RETURN_ON_FALSE(chunk, ESP_ERR_NO_MEM, TAG, "Not enough memory for test chunk");
+    for (size_t i = 0; i < chunk_size; i++) {
+        chunk[i] = i;
+    }
+
+    FILE *f = fopen(path, "wb");
+    ESP_GOTO_ON_FALSE(f, ESP_FAIL, err, TAG, "Failed to create %s", path);
+    /* Chunks go directly to the card, the stdio buffer would only copy them */
+    setvbuf(f, NULL, _IONBF, 0);
+    int64_t start = esp_timer_get_time();
+    for (size_t done = 0; done < size; done += chunk_size) {
+        const size_t len = (size - done < chunk_size) ? size - done : chunk_size;
+        if (fwrite(chunk, 1, len, f) != len) {
+            ret = ESP_FAIL;
+            break;
+        }
+    }
+    if (ret == ESP_OK && fsync(fileno(f)) != 0) {
+        ret = ESP_FAIL;
+    }
+    int64_t time_us = esp_timer_get_time() - start;
+    fclose(f);
+    ESP_GOTO_ON_ERROR(ret, clean, TAG, "Failed to write %s", path);
+    *write_kbps = (uint32_t)((uint64_t)size * 1000 / (time_us > 0 ? time_us : 1));
+
+    f = fopen(path, "rb");
+    ESP_GOTO_ON_FALSE(f, ESP_FAIL, clean, TAG, "Failed to open %s", path);
+    setvbuf(f, NULL, _IONBF, 0);
+    start = esp_timer_get_time();
+    for (size_t done = 0; done < size; done += chunk_size) {
+        const size_t len = (size - done < chunk_size) ? size - done : chunk_size;
+        if (fread(chunk, 1, len, f) != len) {
+            ret = ESP_FAIL;
+            break;
+        }
+    }
+    time_us = esp_timer_get_time() - start;
+    fclose(f);
+    ESP_GOTO_ON_ERROR(ret, clean, TAG, "Failed to read %s", path);
+    *read_kbps = (uint32_t)((uint64_t)size * 1000 / (time_us > 0 ? time_us : 1));
+    ESP_LOGI(TAG, "SD card: write %"PRIu32" kB/s, read %"PRIu32" kB/s (%zu B chunks)", *write_kbps, *read_kbps, chunk_size);
+
+clean:
+    unlink(path);
+err:
+    free(chunk);
+    return ret;
 }
 
 esp_err_t bsp_sdcard_unmount(void)
 {
+#if CONFIG_BSP_LVGL_FS
+    bsp_lvgl_fs_mounted(BSP_LVGL_FS_SDCARD, false);
+#endif
     return esp_vfs_fat_sdcard_unmount(BSP_SD_MOUNT_POINT, bsp_sdcard);
 }
 
@@ -255,18 +541,8 @@ esp_codec_dev_handle_t bsp_audio_codec_speaker_init(void)
     return esp_codec_dev_new(&codec_dev_cfg);
 }
 
-esp_codec_dev_handle_t bsp_audio_codec_microphone_init(void)
+static esp_codec_dev_handle_t bsp_audio_codec_es7210_new(const audio_codec_data_if_t *i2s_data_if, uint8_t mic_selected)
 {
-    const audio_codec_data_if_t *i2s_data_if = bsp_audio_get_codec_itf();
-    if (i2s_data_if == NULL) {
-        /* Initilize I2C */
-        BSP_ERROR_CHECK_RETURN_ERR(bsp_i2c_init());
-        /* Configure I2S peripheral and Power Amplifier */
-        BSP_ERROR_CHECK_RETURN_ERR(bsp_audio_init(NULL));
-        i2s_data_if = bsp_audio_get_codec_itf();
-    }
-    assert(i2s_data_if);
-
     audio_codec_i2c_cfg_t i2c_cfg = {
         .port = BSP_I2C_NUM,
         .addr = ES7210_CODEC_DEFAULT_ADDR,
@@ -277,6 +553,7 @@ esp_codec_dev_handle_t bsp_audio_codec_microphone_init(void)
 
     es7210_codec_cfg_t es7210_cfg = {
         .ctrl_if = i2c_ctrl_if,
+        .mic_selected = mic_selected,
     };
     const audio_codec_if_t *es7210_dev = es7210_codec_new(&es7210_cfg);
     BSP_NULL_CHECK(es7210_dev, NULL);
@@ -289,6 +566,38 @@ esp_codec_dev_handle_t bsp_audio_codec_microphone_init(void)
     return esp_codec_dev_new(&codec_es7210_dev_cfg);
 }
 
+esp_codec_dev_handle_t bsp_audio_codec_microphone_init(void)
+{
+    const audio_codec_data_if_t *i2s_data_if = bsp_audio_get_codec_itf();
+    if (i2s_data_if == NULL) {
+        /* Initilize I2C */
+        BSP_ERROR_CHECK_RETURN_ERR(bsp_i2c_init());
+        /* Configure I2S peripheral and Power Amplifier */
+        BSP_ERROR_CHECK_RETURN_ERR(bsp_audio_init(NULL));
+        i2s_data_if = bsp_audio_get_codec_itf();
+    }
+    assert(i2s_data_if);
+
+    /* Default selection of esp_codec_dev */
+    return bsp_audio_codec_es7210_new(i2s_data_if, 0);
+}
+
+esp_codec_dev_handle_t bsp_audio_codec_microphone_aec_init(void)
+{
+    const audio_codec_data_if_t *i2s_data_if = bsp_audio_get_codec_itf();
+    if (i2s_data_if == NULL) {
+        /* Initilize I2C */
+        BSP_ERROR_CHECK_RETURN_ERR(bsp_i2c_init());
+        /* Configure I2S peripheral in TDM mode */
+        BSP_ERROR_CHECK_RETURN_ERR(bsp_audio_aec_init(16000));
+        i2s_data_if = bsp_audio_get_codec_itf();
+    }
+    assert(i2s_data_if);
+
+    /* More than 2 selected inputs enable TDM mode of ES7210 */
+    return bsp_audio_codec_es7210_new(i2s_data_if, ES7120_SEL_MIC1 | ES7120_SEL_MIC2 | ES7120_SEL_MIC3 | ES7120_SEL_MIC4);
+}
+
 // Bit number used to represent command and parameter
 #define LCD_CMD_BITS           8
 #define LCD_PARAM_BITS         8
@@ -296,6 +605,11 @@ esp_codec_dev_handle_t bsp_audio_codec_microphone_init(void)
 
 esp_err_t bsp_display_brightness_init(void)
 {
+    /* Keep the running backlight, e.g. of splash screen */
+    if (brightness_initialized) {
+        return ESP_OK;
+    }
+
     // Setup LEDC peripheral for PWM backlight control
     const ledc_channel_config_t LCD_backlight_channel = {
         .gpio_num = BSP_LCD_BACKLIGHT,
@@ -317,6 +631,13 @@ esp_err_t bsp_display_brightness_init(void)
     BSP_ERROR_CHECK_RETURN_ERR(ledc_timer_config(&LCD_backlight_timer));
     BSP_ERROR_CHECK_RETURN_ERR(ledc_channel_config(&LCD_backlight_channel));
 
+    // Hardware fading, the function may be already installed by the application
+    const esp_err_t ret = ledc_fade_func_install(0);
+    if (ret != ESP_ERR_INVALID_STATE) {
+        BSP_ERROR_CHECK_RETURN_ERR(ret);
+    }
+
+    brightness_initialized = true;
     return ESP_OK;
 }
 
@@ -331,8 +652,30 @@ esp_err_t bsp_display_brightness_set(int brightness_percent)
 
     ESP_LOGI(TAG, "Setting LCD backlight: %d%%", brightness_percent);
     uint32_t duty_cycle = (1023 * brightness_percent) / 100; // LEDC resolution set to 10bits, thus: 100% = 1023
-    BSP_ERROR_CHECK_RETURN_ERR(ledc_set_duty(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH, duty_cycle));
-    BSP_ERROR_CHECK_RETURN_ERR(ledc_update_duty(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH));
+    ledc_fade_stop(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH);
+    BSP_ERROR_CHECK_RETURN_ERR(ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH, duty_cycle, 0));
+
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_brightness_fade(int brightness_percent, uint32_t fade_ms)
+{
+    if (brightness_percent > 100) {
+        brightness_percent = 100;
+    }
+    if (brightness_percent < 0) {
+        brightness_percent = 0;
+    }
+
+    ESP_LOGD(TAG, "Fading LCD backlight: %d%% in %"PRIu32" ms", brightness_percent, fade_ms);
+    uint32_t duty_cycle = (1023 * brightness_percent) / 100;
+    // Retarget the running fade
+    ledc_fade_stop(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH);
+    if (fade_ms == 0) {
+        BSP_ERROR_CHECK_RETURN_ERR(ledc_set_duty_and_update(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH, duty_cycle, 0));
+    } else {
+        BSP_ERROR_CHECK_RETURN_ERR(ledc_set_fade_time_and_start(LEDC_LOW_SPEED_MODE, LCD_LEDC_CH, duty_cycle, fade_ms, LEDC_FADE_NO_WAIT));
+    }
 
     return ESP_OK;
 }
@@ -388,7 +731,8 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
         .lcd_cmd_bits = LCD_CMD_BITS,
         .lcd_param_bits = LCD_PARAM_BITS,
         .spi_mode = 0,
-        .trans_queue_depth = 10,
+        .trans_queue_depth = (config->trans_queue_depth > 0) ? config->trans_queue_depth :
+                             BSP_LCD_TRANS_QUEUE_DEPTH(BSP_LCD_H_RES * BSP_LCD_V_RES * BSP_LCD_BITS_PER_PIXEL / 8, config->max_transfer_sz),
     };
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)BSP_LCD_SPI_NUM, &io_config, ret_io), err, TAG, "New panel IO failed");
 
@@ -428,27 +772,254 @@ err:
     return ret;
 }
 
+/* Lines of the automatically sized draw buffers, see bsp_display_auto_buffers() */
+#define AUTO_BUF_MIN_LINES  (10)
+#define AUTO_BUF_MAX_LINES  (BSP_LCD_V_RES / 4)
+/* SPI transfer size must fit both the configured and the automatically sized buffers */
+#define BSP_LCD_DRAW_BUF_MAX_LINES  (CONFIG_BSP_LCD_DRAW_BUF_HEIGHT > AUTO_BUF_MAX_LINES ? CONFIG_BSP_LCD_DRAW_BUF_HEIGHT : AUTO_BUF_MAX_LINES)
+
+#define SPLASH_CHUNK_LINES  (10)    /* At most BSP_LCD_DRAW_BUF_MAX_LINES, to fit the SPI transfer size of LVGL */
+
+typedef struct {
+    const uint16_t *data;
+    const uint16_t *end;
+    uint16_t count;     /* Remaining pixels of the current block */
+    bool run;
+} splash_rle_t;
+
+static esp_err_t splash_rle_decode(splash_rle_t *rle, uint16_t *out, size_t len)
+{
+    while (len > 0) {
+        if (rle->count == 0) {
+            ESP_RETURN_ON_FALSE(rle->data < rle->end, ESP_ERR_INVALID_SIZE, TAG, "Splash data too short");
+            const uint16_t header = *rle->data++;
+            rle->run = (header & 0x8000) != 0;
+            rle->count = header & 0x7FFF;
+            ESP_RETURN_ON_FALSE(!rle->run || rle->data < rle->end, ESP_ERR_INVALID_SIZE, TAG, "Splash data too short");
+            if (rle->run && rle->count == 0) {
+                rle->data++;
+            }
+            continue;
+        }
+
+        const size_t n = (rle->count < len) ? rle->count : len;
+        if (rle->run) {
+            for (size_t i = 0; i < n; i++) {
+                out[i] = *rle->data;
+            }
+        } else {
+            ESP_RETURN_ON_FALSE((size_t)(rle->end - rle->data) >= n, ESP_ERR_INVALID_SIZE, TAG, "Splash data too short");
+            memcpy(out, rle->data, n * sizeof(uint16_t));
+            rle->data += n;
+        }
+        rle->count -= n;
+        out += n;
+        len -= n;
+        if (rle->run && rle->count == 0) {
+            rle->data++;
+        }
+    }
+    return ESP_OK;
+}
+
+static IRAM_ATTR bool splash_trans_done(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+    BaseType_t need_yield = pdFALSE;
+    xSemaphoreGiveFromISR((SemaphoreHandle_t)user_ctx, &need_yield);
+    return need_yield == pdTRUE;
+}
+
+esp_err_t bsp_display_splash_show(const bsp_display_splash_t *splash)
+{
+    esp_err_t ret = ESP_OK;
+    uint16_t *buf[2] = {NULL, NULL};
+    SemaphoreHandle_t free_bufs = NULL;
+
+    ESP_RETURN_ON_FALSE(splash && splash->data && splash->width > 0 && splash->height > 0 &&
+                        splash->width <= BSP_LCD_H_RES && splash->height <= BSP_LCD_V_RES,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid splash image");
+    ESP_RETURN_ON_FALSE(disp == NULL, ESP_ERR_INVALID_STATE, TAG, "Display already started");
+
+    if (panel_handle == NULL) {
+        /* Same transfer size as in bsp_display_lcd_init(), the SPI bus is kept for LVGL */
+        const bsp_display_config_t bsp_disp_cfg = {
+            .max_transfer_sz = (BSP_LCD_H_RES * BSP_LCD_DRAW_BUF_MAX_LINES) * sizeof(uint16_t),
+        };
+        ESP_RETURN_ON_ERROR(bsp_display_new(&bsp_disp_cfg, &panel_handle, &panel_io_handle), TAG, "Display init failed");
+    }
+
+    /* Two chunks, one is decompressed while the other is sent */
+    const size_t chunk_px = BSP_LCD_H_RES * SPLASH_CHUNK_LINES;
+    for (int i = 0; i < 2; i++) {
+        buf[i] = heap_caps_malloc(chunk_px * sizeof(uint16_t), MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(buf[i], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for splash");
+    }
+    free_bufs = xSemaphoreCreateCounting(2, 2);
+    ESP_GOTO_ON_FALSE(free_bufs, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for splash");
+    const esp_lcd_panel_io_callbacks_t cbs = {
+        .on_color_trans_done = splash_trans_done,
+    };
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_io_register_event_callbacks(panel_io_handle, &cbs, free_bufs), err, TAG, "");
+
+    int b = 0;
+    if (splash->width < BSP_LCD_H_RES || splash->height < BSP_LCD_V_RES) {
+        for (int y = 0; y < BSP_LCD_V_RES; y += SPLASH_CHUNK_LINES) {
+            const int lines = (BSP_LCD_V_RES - y < SPLASH_CHUNK_LINES) ? BSP_LCD_V_RES - y : SPLASH_CHUNK_LINES;
+            xSemaphoreTake(free_bufs, portMAX_DELAY);
+            for (size_t i = 0; i < chunk_px; i++) {
+                buf[b][i] = splash->bg_color;
+            }
+            ret = esp_lcd_panel_draw_bitmap(panel_handle, 0, y, BSP_LCD_H_RES, y + lines, buf[b]);
+            if (ret != ESP_OK) {
+                xSemaphoreGive(free_bufs);
+                goto wait;
+            }
+            b ^= 1;
+        }
+    }
+
+    const int x0 = (BSP_LCD_H_RES - splash->width) / 2;
+    const int y0 = (BSP_LCD_V_RES - splash->height) / 2;
+    const int chunk_lines = chunk_px / splash->width;
+    splash_rle_t rle = {
+        .data = splash->data,
+        .end = splash->data + splash->data_len,
+    };
+    for (int y = 0; y < splash->height; y += chunk_lines) {
+        const int lines = (splash->height - y < chunk_lines) ? splash->height - y : chunk_lines;
+        xSemaphoreTake(free_bufs, portMAX_DELAY);
+        ret = splash_rle_decode(&rle, buf[b], lines * splash->width);
+        if (ret == ESP_OK) {
+            ret = esp_lcd_panel_draw_bitmap(panel_handle, x0, y0 + y, x0 + splash->width, y0 + y + lines, buf[b]);
+        }
+        if (ret != ESP_OK) {
+            xSemaphoreGive(free_bufs);
+            goto wait;
+        }
+        b ^= 1;
+    }
+
+wait:
+    /* Both chunks are free after the last transfer */
+    xSemaphoreTake(free_bufs, portMAX_DELAY);
+    xSemaphoreTake(free_bufs, portMAX_DELAY);
+    const esp_lcd_panel_io_callbacks_t no_cbs = {0};
+    esp_lcd_panel_io_register_event_callbacks(panel_io_handle, &no_cbs, NULL);
+    if (ret == ESP_OK) {
+        esp_lcd_panel_disp_on_off(panel_handle, true);
+        ret = bsp_display_brightness_set(splash->brightness);
+    }
+
+err:
+    if (free_bufs) {
+        vSemaphoreDelete(free_bufs);
+    }
+    free(buf[0]);
+    free(buf[1]);
+    return ret;
+}
+
+typedef struct {
+    uint32_t buffer_size;
+    uint32_t trans_size;
+    bool double_buffer;
+    bool buff_dma;
+    bool buff_spiram;
+} bsp_display_buffers_t;
+
+/**
+ * @brief Select LVGL draw buffers from the free memory
+ *
+ * Rendering of a buffer overlaps the SPI transfer of the other one, so double buffers are preferred.
+ * At most a quarter of free internal DMA memory is used, the rest is left for WiFi, audio and the application.
+ * When it does not fit AUTO_BUF_MIN_LINES, the buffers are placed in PSRAM (not DMA capable)
+ * and copied to the LCD through SRAM bounce buffers of trans_size pixels.
+ */
+static void bsp_display_auto_buffers(bsp_display_buffers_t *bufs)
+{
+    const uint32_t caps = MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL;
+    const size_t line_size = BSP_LCD_H_RES * sizeof(uint16_t);
+    const size_t dma_free = heap_caps_get_free_size(caps);
+    const size_t dma_largest = heap_caps_get_largest_free_block(caps);
+    const size_t psram_size = heap_caps_get_total_size(MALLOC_CAP_SPIRAM);
+
+    /* Lines of each of two buffers in the budget, one buffer must fit the largest free block */
+    size_t lines = (dma_free / 4) / (2 * line_size);
+    if (lines > dma_largest / line_size) {
+        lines = dma_largest / line_size;
+    }
+    if (lines > AUTO_BUF_MAX_LINES) {
+        lines = AUTO_BUF_MAX_LINES;
+    }
+
+    *bufs = (bsp_display_buffers_t) {
+        .double_buffer = true,
+    };
+    if (lines >= AUTO_BUF_MIN_LINES) {
+        bufs->buffer_size = BSP_LCD_H_RES * lines;
+        bufs->buff_dma = true;
+    } else if (psram_size > 0) {
+        lines = AUTO_BUF_MAX_LINES;
+        bufs->buffer_size = BSP_LCD_H_RES * lines;
+        bufs->trans_size = BSP_LCD_H_RES * AUTO_BUF_MIN_LINES;
+        bufs->buff_spiram = true;
+    } else {
+        /* Low memory, single small buffer */
+        lines = AUTO_BUF_MIN_LINES;
+        bufs->buffer_size = BSP_LCD_H_RES * lines;
+        bufs->double_buffer = false;
+        bufs->buff_dma = true;
+    }
+
+    /* Full frame transfer time limits the frame rate regardless of the buffers */
+    const uint32_t frame_us = (uint64_t)BSP_LCD_H_RES * BSP_LCD_V_RES * BSP_LCD_BITS_PER_PIXEL * 1000000 / BSP_LCD_PIXEL_CLOCK_HZ;
+    ESP_LOGI(TAG, "Draw buffers: %s %u lines in %s%s (DMA free %u, largest %u, PSRAM %u), SPI frame %"PRIu32" us",
+             bufs->double_buffer ? "2x" : "1x", (unsigned)lines, bufs->buff_spiram ? "PSRAM" : "internal DMA",
+             bufs->trans_size ? " with SRAM bounce" : "", (unsigned)dma_free, (unsigned)dma_largest, (unsigned)psram_size, frame_us);
+}
+
 static lv_display_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
 {
     assert(cfg != NULL);
-    esp_lcd_panel_io_handle_t io_handle = NULL;
-    const bsp_display_config_t bsp_disp_cfg = {
-        .max_transfer_sz = (BSP_LCD_H_RES * CONFIG_BSP_LCD_DRAW_BUF_HEIGHT) * sizeof(uint16_t),
+    bsp_display_buffers_t bufs = {
+        .buffer_size = cfg->buffer_size,
+        .double_buffer = cfg->double_buffer,
+        .buff_dma = cfg->flags.buff_dma,
+        .buff_spiram = cfg->flags.buff_spiram,
     };
-    BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new(&bsp_disp_cfg, &panel_handle, &io_handle));
+    if (cfg->buffer_size == 0) {
+        bsp_display_auto_buffers(&bufs);
+    }
 
-    esp_lcd_panel_disp_on_off(panel_handle, true);
+    if (panel_handle == NULL) {
+        const int max_transfer_sz = (BSP_LCD_H_RES * BSP_LCD_DRAW_BUF_MAX_LINES) * sizeof(uint16_t);
+        /* One flush sends the draw buffer, or a bounce buffer of trans_size from PSRAM */
+        const size_t flush_px = bufs.trans_size ? bufs.trans_size : bufs.buffer_size;
+        const bsp_display_config_t bsp_disp_cfg = {
+            .max_transfer_sz = max_transfer_sz,
+            /* Whole flush is queued at once, so the flush callback does not wait for the bus */
+            .trans_queue_depth = BSP_LCD_TRANS_QUEUE_DEPTH(flush_px * sizeof(uint16_t), max_transfer_sz),
+        };
+        BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new(&bsp_disp_cfg, &panel_handle, &panel_io_handle));
+
+        esp_lcd_panel_disp_on_off(panel_handle, true);
+    }
+    /* Else the panel was initialized by bsp_display_splash_show() for a full frame queue, it is taken over without reset */
 
     /* Add LCD screen */
     ESP_LOGD(TAG, "Add LCD screen");
     const lvgl_port_display_cfg_t disp_cfg = {
-        .io_handle = io_handle,
+        .io_handle = panel_io_handle,
         .panel_handle = panel_handle,
-        .buffer_size = cfg->buffer_size,
-        .double_buffer = cfg->double_buffer,
+        .buffer_size = bufs.buffer_size,
+        .double_buffer = bufs.double_buffer,
+        .trans_size = bufs.trans_size,
         .hres = BSP_LCD_H_RES,
         .vres = BSP_LCD_V_RES,
         .monochrome = false,
+#if LVGL_VERSION_MAJOR >= 9
+        .te_gpio_num = BSP_LCD_TE,
+#endif
         /* Rotation values must be same as used in esp_lcd for initial settings of the screen */
         .rotation = {
             .swap_xy = false,
@@ -456,10 +1027,12 @@ static lv_display_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
             .mirror_y = true,
         },
         .flags = {
-            .buff_dma = cfg->flags.buff_dma,
-            .buff_spiram = cfg->flags.buff_spiram,
+            .buff_dma = bufs.buff_dma,
+            .buff_spiram = bufs.buff_spiram,
 #if LVGL_VERSION_MAJOR >= 9
+            .coalesce_flush = (bufs.trans_size > 0),
             .swap_bytes = (BSP_LCD_BIGENDIAN ? true : false),
+            .te_sync = (cfg->flags.te_sync && BSP_LCD_TE != GPIO_NUM_NC),
 #endif
         }
     };
@@ -491,6 +1064,73 @@ static esp_err_t bsp_touch_exit_sleep(void)
     return esp_lcd_touch_exit_sleep(tp);
 }
 
+#if CONFIG_BSP_I2C_SCHED
+esp_i2c_sched_handle_t bsp_i2c_sched_get_handle(void)
+{
+    bsp_i2c_init();
+    return i2c_sched;
+}
+
+static esp_err_t bsp_touch_read_data_sched(esp_lcd_touch_handle_t tp)
+{
+    ESP_RETURN_ON_ERROR(esp_i2c_sched_lock(tp_sched, 100), TAG, "I2C bus busy");
+    esp_err_t ret = tp_read_data(tp);
+    esp_i2c_sched_unlock(tp_sched);
+    return ret;
+}
+
+static esp_err_t bsp_touch_sched_add(esp_lcd_touch_handle_t tp)
+{
+    if (tp_sched == NULL) {
+        const esp_i2c_sched_dev_config_t dev_cfg = {
+            .name = "touch",
+            .prio = ESP_I2C_SCHED_PRIO_TOUCH,
+            .budget_us = 1000,
+        };
+        ESP_RETURN_ON_ERROR(esp_i2c_sched_add_device(i2c_sched, &dev_cfg, &tp_sched), TAG, "");
+    }
+    /* Every read of the touch driver waits for the bus in the touch class */
+    tp_read_data = tp->read_data;
+    tp->read_data = bsp_touch_read_data_sched;
+    return ESP_OK;
+}
+#endif
+
+static esp_err_t bsp_touch_detect(uint8_t *addr)
+{
+    /* Boards were produced with different touch controllers */
+    static const uint8_t tp_addresses[] = {
+        ESP_LCD_TOUCH_IO_I2C_GT911_ADDRESS,
+        ESP_LCD_TOUCH_IO_I2C_GT911_ADDRESS_BACKUP,
+        ESP_LCD_TOUCH_IO_I2C_TT21100_ADDRESS,
+    };
+
+#if CONFIG_BSP_PROBE_CACHE
+    /* One probe of the controller found in the last boot, the full detection only when it does not respond */
+    uint8_t cached;
+    if (bsp_probe_cache_get(BSP_PROBE_CACHE_KEY_TOUCH, &cached) == ESP_OK) {
+        for (int i = 0; i < sizeof(tp_addresses); i++) {
+            if (tp_addresses[i] == cached && bsp_i2c_device_probe(cached) == ESP_OK) {
+                *addr = cached;
+                return ESP_OK;
+            }
+        }
+        ESP_LOGW(TAG, "Cached touch 0x%02x not found, detecting", cached);
+    }
+#endif
+
+    for (int i = 0; i < sizeof(tp_addresses); i++) {
+        if (bsp_i2c_device_probe(tp_addresses[i]) == ESP_OK) {
+            *addr = tp_addresses[i];
+#if CONFIG_BSP_PROBE_CACHE
+            bsp_probe_cache_set(BSP_PROBE_CACHE_KEY_TOUCH, *addr);
+#endif
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
 esp_err_t bsp_touch_new(const bsp_touch_config_t *config, esp_lcd_touch_handle_t *ret_touch)
 {
     /* Initilize I2C */
@@ -515,20 +1155,16 @@ esp_err_t bsp_touch_new(const bsp_touch_config_t *config, esp_lcd_touch_handle_t
     esp_lcd_panel_io_handle_t tp_io_handle = NULL;
     esp_lcd_panel_io_i2c_config_t tp_io_config;
 
-    if (ESP_OK == bsp_i2c_device_probe(ESP_LCD_TOUCH_IO_I2C_GT911_ADDRESS)) {
-        esp_lcd_panel_io_i2c_config_t config = ESP_LCD_TOUCH_IO_I2C_GT911_CONFIG();
-        memcpy(&tp_io_config, &config, sizeof(config));
-    } else if (ESP_OK == bsp_i2c_device_probe(ESP_LCD_TOUCH_IO_I2C_GT911_ADDRESS_BACKUP)) {
-        esp_lcd_panel_io_i2c_config_t config = ESP_LCD_TOUCH_IO_I2C_GT911_CONFIG();
-        config.dev_addr = ESP_LCD_TOUCH_IO_I2C_GT911_ADDRESS_BACKUP;
-        memcpy(&tp_io_config, &config, sizeof(config));
-    } else if (ESP_OK == bsp_i2c_device_probe(ESP_LCD_TOUCH_IO_I2C_TT21100_ADDRESS)) {
+    uint8_t tp_addr;
+    ESP_RETURN_ON_ERROR(bsp_touch_detect(&tp_addr), TAG, "Touch not found");
+    if (ESP_LCD_TOUCH_IO_I2C_TT21100_ADDRESS == tp_addr) {
         esp_lcd_panel_io_i2c_config_t config = ESP_LCD_TOUCH_IO_I2C_TT21100_CONFIG();
         memcpy(&tp_io_config, &config, sizeof(config));
         tp_cfg.flags.mirror_x = 1;
     } else {
-        ESP_LOGE(TAG, "Touch not found");
-        return ESP_ERR_NOT_FOUND;
+        esp_lcd_panel_io_i2c_config_t config = ESP_LCD_TOUCH_IO_I2C_GT911_CONFIG();
+        config.dev_addr = tp_addr;
+        memcpy(&tp_io_config, &config, sizeof(config));
     }
     tp_io_config.scl_speed_hz = CONFIG_BSP_I2C_CLK_SPEED_HZ; // This parameter was introduced together with I2C Driver-NG in IDF v5.2
 
@@ -538,6 +1174,9 @@ esp_err_t bsp_touch_new(const bsp_touch_config_t *config, esp_lcd_touch_handle_t
     } else {
         ESP_RETURN_ON_ERROR(esp_lcd_touch_new_i2c_gt911(tp_io_handle, &tp_cfg, ret_touch), TAG, "New gt911 failed");
     }
+#if CONFIG_BSP_I2C_SCHED
+    ESP_RETURN_ON_ERROR(bsp_touch_sched_add(*ret_touch), TAG, "Touch scheduling failed");
+#endif
 
     return ESP_OK;
 }
@@ -556,11 +1195,31 @@ static lv_indev_t *bsp_display_indev_init(lv_display_t *disp)
     return lvgl_port_add_touch(&touch_cfg);
 }
 
-lv_display_t *bsp_display_start(void)
+/* LVGL port configuration with the task placement of the profile */
+static void bsp_display_port_cfg(const bsp_display_cfg_t *cfg, lvgl_port_cfg_t *port_cfg)
 {
-    bsp_display_cfg_t cfg = {
+    *port_cfg = cfg->lvgl_port_cfg;
+#if !CONFIG_FREERTOS_UNICORE
+    if (cfg->task_profile == BSP_DISPLAY_TASK_PROFILE_COEX) {
+        port_cfg->task_affinity = BSP_CORE_UI;
+        port_cfg->draw_task_affinity = BSP_CORE_UI;
+        port_cfg->task_priority = BSP_DISPLAY_TASK_PRIORITY;
+    }
+#endif
+}
+
+static void bsp_display_default_cfg(bsp_display_cfg_t *cfg)
+{
+    *cfg = (bsp_display_cfg_t) {
         .lvgl_port_cfg = ESP_LVGL_PORT_INIT_CONFIG(),
+#if CONFIG_BSP_DISPLAY_TASK_PROFILE_COEX
+        .task_profile = BSP_DISPLAY_TASK_PROFILE_COEX,
+#endif
+#if CONFIG_BSP_LCD_DRAW_BUF_AUTO
+        .buffer_size = 0,
+#else
         .buffer_size = BSP_LCD_H_RES * CONFIG_BSP_LCD_DRAW_BUF_HEIGHT,
+#endif
 #if CONFIG_BSP_LCD_DRAW_BUF_DOUBLE
         .double_buffer = 1,
 #else
@@ -571,13 +1230,24 @@ lv_display_t *bsp_display_start(void)
             .buff_spiram = false,
         }
     };
+}
+
+lv_display_t *bsp_display_start(void)
+{
+    bsp_display_cfg_t cfg;
+    bsp_display_default_cfg(&cfg);
     return bsp_display_start_with_config(&cfg);
 }
 
 lv_display_t *bsp_display_start_with_config(const bsp_display_cfg_t *cfg)
 {
     assert(cfg != NULL);
-    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_init(&cfg->lvgl_port_cfg));
+    lvgl_port_cfg_t port_cfg;
+    bsp_display_port_cfg(cfg, &port_cfg);
+    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_init(&port_cfg));
+#if CONFIG_BSP_LVGL_FS
+    bsp_lvgl_fs_start();
+#endif
 
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_brightness_init());
 
@@ -608,6 +1278,557 @@ void bsp_display_unlock(void)
     lvgl_port_unlock();
 }
 
+/* Default power-saving curve: dim in dark rooms, full brightness only in daylight */
+static const bsp_display_backlight_point_t backlight_default_curve[] = {
+    {.lux = 0, .percent = 10},
+    {.lux = 20, .percent = 25},
+    {.lux = 100, .percent = 40},
+    {.lux = 500, .percent = 65},
+    {.lux = 2000, .percent = 100},
+};
+
+#define BACKLIGHT_AUTO_HYSTERESIS   (3)     /* Minimal change of brightness in [%] */
+#define BACKLIGHT_AUTO_WAKE_FADE_MS (100)   /* Fast fade-in on activity */
+
+static struct {
+    bsp_display_backlight_auto_cfg_t cfg;
+    lv_timer_t *timer;
+    volatile int32_t ambient_lux;   /* -1: not reported */
+    int percent;                    /* Current target brightness */
+    bool idle;
+} backlight_auto;
+
+static int backlight_auto_curve(int32_t lux)
+{
+    const bsp_display_backlight_point_t *curve = backlight_auto.cfg.curve;
+    const size_t len = backlight_auto.cfg.curve_len;
+
+    if (lux <= curve[0].lux) {
+        return curve[0].percent;
+    }
+    for (size_t i = 1; i < len; i++) {
+        if (lux < curve[i].lux) {
+            // linear interpolation between the points
+            return curve[i - 1].percent + (curve[i].percent - curve[i - 1].percent) * (lux - curve[i - 1].lux) /
+                   (curve[i].lux - curve[i - 1].lux);
+        }
+    }
+    return curve[len - 1].percent;
+}
+
+static void backlight_auto_timer_cb(lv_timer_t *timer)
+{
+    const bsp_display_backlight_auto_cfg_t *cfg = &backlight_auto.cfg;
+    const uint32_t inactive_ms = disp ? lv_disp_get_inactive_time(disp) : 0;
+    const int32_t lux = backlight_auto.ambient_lux;
+    int percent = (lux < 0) ? cfg->default_percent : backlight_auto_curve(lux);
+    bool idle = false;
+
+    if (cfg->off_timeout_ms && inactive_ms >= cfg->off_timeout_ms) {
+        percent = 0;
+        idle = true;
+    } else if (cfg->dim_timeout_ms && inactive_ms >= cfg->dim_timeout_ms) {
+        percent = LV_MIN(percent, cfg->dim_percent);
+        idle = true;
+    }
+
+    if (backlight_auto.idle && !idle) {
+        // Wake up immediately on user activity
+        bsp_display_brightness_fade(percent, BACKLIGHT_AUTO_WAKE_FADE_MS);
+    } else if (idle != backlight_auto.idle || abs(percent - backlight_auto.percent) >= BACKLIGHT_AUTO_HYSTERESIS) {
+        bsp_display_brightness_fade(percent, cfg->fade_ms);
+    } else {
+        return;
+    }
+    backlight_auto.percent = percent;
+    backlight_auto.idle = idle;
+}
+
+esp_err_t bsp_display_backlight_auto_start(const bsp_display_backlight_auto_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg && cfg->update_period_ms > 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!cfg->curve || cfg->curve_len > 0, ESP_ERR_INVALID_ARG, TAG, "invalid curve");
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_STATE, TAG, "display not started");
+
+    bsp_display_lock(0);
+    if (backlight_auto.timer) {
+        bsp_display_unlock();
+        ESP_LOGE(TAG, "Automatic backlight already running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    backlight_auto.cfg = *cfg;
+    if (!cfg->curve) {
+        backlight_auto.cfg.curve = backlight_default_curve;
+        backlight_auto.cfg.curve_len = sizeof(backlight_default_curve) / sizeof(backlight_default_curve[0]);
+    }
+    backlight_auto.ambient_lux = -1;
+    backlight_auto.percent = -100; // force the first update
+    backlight_auto.idle = false;
+    backlight_auto.timer = lv_timer_create(backlight_auto_timer_cb, cfg->update_period_ms, NULL);
+    bsp_display_unlock();
+
+    ESP_RETURN_ON_FALSE(backlight_auto.timer, ESP_ERR_NO_MEM, TAG, "timer create failed");
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_backlight_auto_stop(void)
+{
+    bsp_display_lock(0);
+    if (!backlight_auto.timer) {
+        bsp_display_unlock();
+        return ESP_ERR_INVALID_STATE;
+    }
+    lv_timer_del(backlight_auto.timer);
+    backlight_auto.timer = NULL;
+    bsp_display_unlock();
+    return ESP_OK;
+}
+
+void bsp_display_backlight_auto_set_ambient(float lux)
+{
+    backlight_auto.ambient_lux = (lux < 0) ? 0 : (lux > INT32_MAX) ? INT32_MAX : (int32_t)lux;
+}
+
+#define DISPLAY_POWER_CHECK_MS      (500)   /* Period of inactivity checks in active state */
+#define DISPLAY_POWER_WAKE_CHECK_MS (20)    /* Period in the other states, wake up is noticed early */
+#define DISPLAY_POWER_SLEEP_OUT_MS  (5)     /* LCD needs this after sleep out before the next command */
+
+static struct {
+    bsp_display_power_cfg_t cfg;
+    lv_timer_t *timer;
+    volatile bsp_display_power_state_t state;
+    int64_t off_since;              /* Start of the backlight fade out in screen-off state */
+    bool lcd_off;                   /* LCD display is off */
+    bool lcd_sleep;                 /* LCD is in sleep */
+} display_power;
+
+/* With display lock */
+static void display_power_set(bsp_display_power_state_t state)
+{
+    const bsp_display_power_cfg_t *cfg = &display_power.cfg;
+    const bsp_display_power_state_t prev = display_power.state;
+
+    if (state == prev) {
+        return;
+    }
+
+    switch (state) {
+    case BSP_DISPLAY_POWER_ACTIVE:
+        if (prev == BSP_DISPLAY_POWER_UI_SUSPENDED) {
+            /* Already resumed, when woken by touch. Touch in monitor mode is reactivated by its next interrupt. */
+            lvgl_port_resume();
+            lv_disp_trigger_activity(disp);
+        }
+        if (display_power.lcd_sleep) {
+            esp_lcd_panel_disp_sleep(panel_handle, false);
+            vTaskDelay(pdMS_TO_TICKS(DISPLAY_POWER_SLEEP_OUT_MS));
+            display_power.lcd_sleep = false;
+        }
+        if (display_power.lcd_off) {
+            bsp_lcd_exit_sleep();
+            display_power.lcd_off = false;
+        }
+        bsp_display_brightness_fade(cfg->active_percent, cfg->wake_fade_ms);
+        /* The touch waking a dark screen is not a click */
+        if (prev >= BSP_DISPLAY_POWER_SCREEN_OFF && disp_indev) {
+            lv_indev_wait_release(disp_indev);
+        }
+        break;
+    case BSP_DISPLAY_POWER_DIMMED:
+        bsp_display_brightness_fade(cfg->dim_percent, cfg->fade_ms);
+        break;
+    case BSP_DISPLAY_POWER_SCREEN_OFF:
+        /* LCD is turned off after the fade by the timer */
+        bsp_display_brightness_fade(0, cfg->fade_ms);
+        display_power.off_since = esp_timer_get_time();
+        break;
+    case BSP_DISPLAY_POWER_UI_SUSPENDED:
+        /* Touch must be able to wake LVGL, otherwise the screen stays off only */
+#if LVGL_VERSION_MAJOR >= 9
+        if (disp_indev && lvgl_port_touch_suspend(disp_indev) != ESP_OK) {
+#else
+        if (disp_indev) {
+#endif
+            ESP_LOGW(TAG, "Touch cannot wake suspended UI, UI suspend disabled");
+            display_power.cfg.suspend_timeout_ms = 0;
+            return;
+        }
+        if (!disp_indev) {
+            lvgl_port_stop();
+        }
+        bsp_display_brightness_fade(0, 0);
+        if (!display_power.lcd_off) {
+            bsp_lcd_enter_sleep();
+            display_power.lcd_off = true;
+        }
+        /* Frame stays in LCD memory */
+        display_power.lcd_sleep = (esp_lcd_panel_disp_sleep(panel_handle, true) == ESP_OK);
+        break;
+    }
+
+    ESP_LOGD(TAG, "Display power state %d -> %d", (int)prev, (int)state);
+    display_power.state = state;
+    lv_timer_set_period(display_power.timer, (state == BSP_DISPLAY_POWER_ACTIVE) ? DISPLAY_POWER_CHECK_MS : DISPLAY_POWER_WAKE_CHECK_MS);
+    if (cfg->state_cb) {
+        cfg->state_cb(state, cfg->user_ctx);
+    }
+}
+
+static void display_power_timer_cb(lv_timer_t *timer)
+{
+    const bsp_display_power_cfg_t *cfg = &display_power.cfg;
+    const uint32_t inactive_ms = lv_disp_get_inactive_time(disp);
+    bsp_display_power_state_t state = BSP_DISPLAY_POWER_ACTIVE;
+
+    if (cfg->suspend_timeout_ms && inactive_ms >= cfg->suspend_timeout_ms) {
+        state = BSP_DISPLAY_POWER_UI_SUSPENDED;
+    } else if (cfg->off_timeout_ms && inactive_ms >= cfg->off_timeout_ms) {
+        state = BSP_DISPLAY_POWER_SCREEN_OFF;
+    } else if (cfg->dim_timeout_ms && inactive_ms >= cfg->dim_timeout_ms) {
+        state = BSP_DISPLAY_POWER_DIMMED;
+    }
+
+    if (state == BSP_DISPLAY_POWER_SCREEN_OFF && display_power.state == BSP_DISPLAY_POWER_SCREEN_OFF && !display_power.lcd_off &&
+            esp_timer_get_time() - display_power.off_since >= (int64_t)cfg->fade_ms * 1000) {
+        bsp_lcd_enter_sleep();
+        display_power.lcd_off = true;
+    }
+    display_power_set(state);
+}
+
+static void display_power_wake_cb(void *arg)
+{
+    if (display_power.timer) {
+        lv_disp_trigger_activity(disp);
+        display_power_set(BSP_DISPLAY_POWER_ACTIVE);
+    }
+}
+
+esp_err_t bsp_display_power_start(const bsp_display_power_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg && cfg->active_percent >= 0 && cfg->active_percent <= 100 && cfg->dim_percent >= 0 &&
+                        cfg->dim_percent <= 100, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!cfg->dim_timeout_ms || !cfg->off_timeout_ms || cfg->dim_timeout_ms < cfg->off_timeout_ms,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid timeouts");
+    ESP_RETURN_ON_FALSE(!cfg->suspend_timeout_ms || (cfg->suspend_timeout_ms > cfg->off_timeout_ms && cfg->suspend_timeout_ms > cfg->dim_timeout_ms),
+                        ESP_ERR_INVALID_ARG, TAG, "invalid timeouts");
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_STATE, TAG, "display not started");
+
+    bsp_display_lock(0);
+    if (display_power.timer || backlight_auto.timer) {
+        bsp_display_unlock();
+        ESP_LOGE(TAG, "Power manager or automatic backlight already running");
+        return ESP_ERR_INVALID_STATE;
+    }
+    display_power.cfg = *cfg;
+    display_power.state = BSP_DISPLAY_POWER_ACTIVE;
+    display_power.lcd_off = false;
+    display_power.lcd_sleep = false;
+    display_power.timer = lv_timer_create(display_power_timer_cb, DISPLAY_POWER_CHECK_MS, NULL);
+    if (display_power.timer) {
+        bsp_display_brightness_fade(cfg->active_percent, cfg->wake_fade_ms);
+    }
+    bsp_display_unlock();
+
+    ESP_RETURN_ON_FALSE(display_power.timer, ESP_ERR_NO_MEM, TAG, "timer create failed");
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_power_stop(void)
+{
+    bsp_display_lock(0);
+    if (!display_power.timer) {
+        bsp_display_unlock();
+        return ESP_ERR_INVALID_STATE;
+    }
+    display_power_set(BSP_DISPLAY_POWER_ACTIVE);
+    lv_timer_del(display_power.timer);
+    display_power.timer = NULL;
+    bsp_display_unlock();
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_power_wake(void)
+{
+    ESP_RETURN_ON_FALSE(display_power.timer, ESP_ERR_INVALID_STATE, TAG, "Power manager not running");
+    /* LVGL task runs the queued calls also when LVGL is stopped */
+    return lvgl_port_async_call(display_power_wake_cb, NULL);
+}
+
+bsp_display_power_state_t bsp_display_power_get_state(void)
+{
+    return display_power.timer ? display_power.state : BSP_DISPLAY_POWER_ACTIVE;
+}
+
+#define AUTO_ROTATE_FIFO_BURST  (16)    /* FIFO samples read in one I2C transaction */
+
+static struct {
+    bsp_display_auto_rotate_cfg_t cfg;
+    icm42670_handle_t imu;
+    float sensitivity;              /* Accelerometer LSB per g */
+    TaskHandle_t task;
+    volatile bool stop;
+    SemaphoreHandle_t stopped;      /* Given by the task before exit */
+} auto_rotate;
+
+/* Gravity pointing to the bottom of the display in the rotation */
+static float auto_rotate_gravity(const icm42670_value_t *acce, lv_disp_rotation_t rotation)
+{
+    switch (rotation) {
+    case LV_DISPLAY_ROTATION_0:
+        return -acce->y;
+    case LV_DISPLAY_ROTATION_90:
+        return -acce->x;
+    case LV_DISPLAY_ROTATION_180:
+        return acce->y;
+    case LV_DISPLAY_ROTATION_270:
+        return acce->x;
+    }
+    return 0;
+}
+
+/* Average of the samples waiting in FIFO, false when there is none */
+static bool auto_rotate_read(icm42670_value_t *acce)
+{
+    icm42670_fifo_sample_t samples[AUTO_ROTATE_FIFO_BURST];
+    int32_t sum_x = 0, sum_y = 0, sum_z = 0;
+    size_t num = 0;
+    size_t read;
+
+    do {
+        if (icm42670_fifo_read(auto_rotate.imu, samples, AUTO_ROTATE_FIFO_BURST, &read) != ESP_OK) {
+            break;
+        }
+        for (size_t i = 0; i < read; i++) {
+            if (samples[i].has_acce) {
+                sum_x += samples[i].acce.x;
+                sum_y += samples[i].acce.y;
+                sum_z += samples[i].acce.z;
+                num++;
+            }
+        }
+    } while (read == AUTO_ROTATE_FIFO_BURST);
+
+    if (num == 0) {
+        return false;
+    }
+    const float div = num * auto_rotate.sensitivity;
+    acce->x = sum_x / div;
+    acce->y = sum_y / div;
+    acce->z = sum_z / div;
+    return true;
+}
+
+static void auto_rotate_task(void *arg)
+{
+    const bsp_display_auto_rotate_cfg_t *cfg = &auto_rotate.cfg;
+    bsp_display_lock(0);
+    lv_disp_rotation_t current = lv_disp_get_rotation(disp);
+    bsp_display_unlock();
+    lv_disp_rotation_t candidate = current;
+    int64_t candidate_since = 0;
+
+    while (!auto_rotate.stop) {
+        vTaskDelay(pdMS_TO_TICKS(cfg->period_ms));
+        icm42670_value_t acce;
+        if (!auto_rotate_read(&acce)) {
+            continue;
+        }
+
+        /* Hysteresis: the current orientation is kept until it is left clearly */
+        lv_disp_rotation_t next = current;
+        if (auto_rotate_gravity(&acce, current) < cfg->leave_g) {
+            float max_g = cfg->enter_g;
+            for (lv_disp_rotation_t r = LV_DISPLAY_ROTATION_0; r <= LV_DISPLAY_ROTATION_270; r++) {
+                const float g = auto_rotate_gravity(&acce, r);
+                if (r != current && g > max_g) {
+                    max_g = g;
+                    next = r;
+                }
+            }
+        }
+
+        const int64_t now = esp_timer_get_time();
+        if (next != candidate) {
+            candidate = next;
+            candidate_since = now;
+        }
+        if (candidate == current || now - candidate_since < (int64_t)cfg->debounce_ms * 1000) {
+            continue;
+        }
+
+        /* Panel swap/mirror and touch transformation are changed together, LVGL task waits for the lock */
+        bsp_display_lock(0);
+        lv_disp_set_rotation(disp, candidate);
+        if (cfg->rotated_cb) {
+            cfg->rotated_cb(disp, candidate, cfg->user_ctx);
+        }
+        bsp_display_unlock();
+        current = candidate;
+        ESP_LOGD(TAG, "Auto rotation %d (acce %.2f, %.2f, %.2f)", (int)current, acce.x, acce.y, acce.z);
+    }
+
+    xSemaphoreGive(auto_rotate.stopped);
+    vTaskDelete(NULL);
+}
+
+static void auto_rotate_release(void)
+{
+    if (auto_rotate.imu) {
+        icm42670_acce_set_pwr(auto_rotate.imu, ACCE_PWR_OFF);
+        icm42670_delete(auto_rotate.imu);
+        auto_rotate.imu = NULL;
+    }
+    if (auto_rotate.stopped) {
+        vSemaphoreDelete(auto_rotate.stopped);
+        auto_rotate.stopped = NULL;
+    }
+}
+
+esp_err_t bsp_display_auto_rotate_start(const bsp_display_auto_rotate_cfg_t *cfg)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(cfg && cfg->period_ms > 0 && cfg->leave_g < cfg->enter_g, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_STATE, TAG, "display not started");
+    ESP_RETURN_ON_FALSE(!auto_rotate.task, ESP_ERR_INVALID_STATE, TAG, "Automatic rotation already running");
+
+    auto_rotate.cfg = *cfg;
+    auto_rotate.stop = false;
+    ESP_RETURN_ON_ERROR(bsp_i2c_init(), TAG, "I2C init failed");
+    ESP_RETURN_ON_ERROR(icm42670_create(i2c_handle, ICM42670_I2C_ADDRESS, &auto_rotate.imu), TAG, "IMU create failed");
+
+    /* Only the accelerometer is needed, at low rate it fills FIFO for several periods */
+    const icm42670_cfg_t imu_cfg = {
+        .acce_fs = ACCE_FS_2G,
+        .acce_odr = ACCE_ODR_25HZ,
+        .gyro_fs = GYRO_FS_2000DPS,
+        .gyro_odr = GYRO_ODR_25HZ,
+    };
+    ESP_GOTO_ON_ERROR(icm42670_config(auto_rotate.imu, &imu_cfg), err, TAG, "IMU config failed");
+    ESP_GOTO_ON_ERROR(icm42670_acce_set_pwr(auto_rotate.imu, ACCE_PWR_LOWPOWER), err, TAG, "IMU power on failed");
+    ESP_GOTO_ON_ERROR(icm42670_get_acce_sensitivity(auto_rotate.imu, &auto_rotate.sensitivity), err, TAG, "IMU sensitivity failed");
+    const icm42670_fifo_cfg_t fifo_cfg = {
+        .acce = true,
+    };
+    ESP_GOTO_ON_ERROR(icm42670_fifo_config(auto_rotate.imu, &fifo_cfg), err, TAG, "IMU FIFO config failed");
+
+    auto_rotate.stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(auto_rotate.stopped, ESP_ERR_NO_MEM, err, TAG, "Not enough memory");
+    if (xTaskCreate(auto_rotate_task, "auto_rotate", cfg->task_stack, NULL, cfg->task_priority, &auto_rotate.task) != pdPASS) {
+        auto_rotate.task = NULL;
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_NO_MEM, err, TAG, "Create task fail!");
+    }
+    return ESP_OK;
+
+err:
+    auto_rotate_release();
+    return ret;
+}
+
+esp_err_t bsp_display_auto_rotate_stop(void)
+{
+    ESP_RETURN_ON_FALSE(auto_rotate.task, ESP_ERR_INVALID_STATE, TAG, "Automatic rotation not running");
+    auto_rotate.stop = true;
+    xSemaphoreTake(auto_rotate.stopped, portMAX_DELAY);
+    auto_rotate.task = NULL;
+    auto_rotate_release();
+    return ESP_OK;
+}
+
+#define TASK_MONITOR_OVERLAY_TASKS  (5)    /* Tasks with the highest load on the overlay */
+#define TASK_MONITOR_OVERLAY_LEN    (96 + TASK_MONITOR_OVERLAY_TASKS * (32 + configMAX_TASK_NAME_LEN))
+
+static struct {
+    esp_task_monitor_handle_t mon;
+    lv_obj_t *label;                /* Overlay on the top layer, NULL when not drawn */
+    char *text;
+} task_monitor;
+
+static void task_monitor_report_cb(const esp_task_monitor_report_t *report, void *user_ctx)
+{
+    if (!task_monitor.label) {
+        return;
+    }
+    /* Skip the report rather than block the monitor behind a long rendering */
+    if (lvgl_port_lock(100)) {
+        /* The text is formatted under the lock, LVGL reads the static text while rendering */
+        esp_task_monitor_format(report, task_monitor.text, TASK_MONITOR_OVERLAY_LEN, TASK_MONITOR_OVERLAY_TASKS);
+        lv_label_set_text_static(task_monitor.label, task_monitor.text);
+        lvgl_port_unlock();
+    }
+}
+
+#if CONFIG_BSP_TASK_MONITOR_OVERLAY
+static void task_monitor_overlay_create(void)
+{
+    task_monitor.text = calloc(1, TASK_MONITOR_OVERLAY_LEN);
+    if (!task_monitor.text) {
+        ESP_LOGW(TAG, "Not enough memory for task monitor overlay");
+        return;
+    }
+    lvgl_port_lock(0);
+    lv_obj_t *label = lv_label_create(lv_layer_top());
+    lv_obj_set_style_bg_color(label, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(label, LV_OPA_60, 0);
+    lv_obj_set_style_text_color(label, lv_color_white(), 0);
+    lv_obj_set_style_pad_all(label, 2, 0);
+    lv_label_set_text_static(label, task_monitor.text);
+    lv_obj_align(label, LV_ALIGN_TOP_LEFT, 0, 0);
+    task_monitor.label = label;
+    lvgl_port_unlock();
+}
+#endif
+
+esp_err_t bsp_task_monitor_start(void)
+{
+    ESP_RETURN_ON_FALSE(!task_monitor.mon, ESP_ERR_INVALID_STATE, TAG, "Task monitor already started");
+
+#if CONFIG_BSP_TASK_MONITOR_OVERLAY
+    if (disp) {
+        task_monitor_overlay_create();
+    }
+#endif
+    const esp_task_monitor_config_t cfg = {
+#if CONFIG_BSP_TASK_MONITOR
+        .period_ms = CONFIG_BSP_TASK_MONITOR_PERIOD_MS,
+#endif
+        .report_cb = task_monitor_report_cb,
+        .flags = {
+#if CONFIG_BSP_TASK_MONITOR_LOG
+            .log = true,
+#endif
+        },
+    };
+    esp_err_t ret = esp_task_monitor_new(&cfg, &task_monitor.mon);
+    if (ret != ESP_OK) {
+        bsp_task_monitor_stop();
+    }
+    return ret;
+}
+
+esp_err_t bsp_task_monitor_stop(void)
+{
+    ESP_RETURN_ON_FALSE(task_monitor.mon || task_monitor.label, ESP_ERR_INVALID_STATE, TAG, "Task monitor not started");
+    if (task_monitor.mon) {
+        esp_task_monitor_del(task_monitor.mon);
+        task_monitor.mon = NULL;
+    }
+    if (task_monitor.label) {
+        lvgl_port_lock(0);
+        lv_obj_del(task_monitor.label);
+        task_monitor.label = NULL;
+        lvgl_port_unlock();
+    }
+    free(task_monitor.text);
+    task_monitor.text = NULL;
+    return ESP_OK;
+}
+
+esp_task_monitor_handle_t bsp_task_monitor_get_handle(void)
+{
+    return task_monitor.mon;
+}
+
 esp_err_t bsp_display_enter_sleep(void)
 {
     BSP_ERROR_CHECK_RETURN_ERR(bsp_lcd_enter_sleep());
@@ -624,6 +1845,184 @@ esp_err_t bsp_display_exit_sleep(void)
     return ESP_OK;
 }
 
+typedef struct {
+    const bsp_start_cfg_t *cfg;
+    bsp_start_result_t *result;
+    SemaphoreHandle_t done;
+} bsp_start_ctx_t;
+
+typedef struct {
+    const char *name;
+    esp_err_t (*func)(bsp_start_ctx_t *ctx);
+    bsp_start_ctx_t *ctx;
+    esp_err_t err;
+    int64_t time_us;
+} bsp_start_job_t;
+
+#define BSP_START_TASK_STACK    (4096)
+
+static esp_err_t bsp_start_display(bsp_start_ctx_t *ctx)
+{
+    bsp_display_cfg_t default_cfg;
+    const bsp_display_cfg_t *cfg = ctx->cfg->display_cfg;
+    if (cfg == NULL) {
+        bsp_display_default_cfg(&default_cfg);
+        cfg = &default_cfg;
+    }
+
+    lvgl_port_cfg_t port_cfg;
+    bsp_display_port_cfg(cfg, &port_cfg);
+    ESP_RETURN_ON_ERROR(lvgl_port_init(&port_cfg), TAG, "LVGL port init failed");
+#if CONFIG_BSP_LVGL_FS
+    bsp_lvgl_fs_start();
+#endif
+    ESP_RETURN_ON_ERROR(bsp_display_brightness_init(), TAG, "Brightness init failed");
+    disp = bsp_display_lcd_init(cfg);
+    ESP_RETURN_ON_FALSE(disp, ESP_FAIL, TAG, "LCD init failed");
+    return ESP_OK;
+}
+
+static esp_err_t bsp_start_touch(bsp_start_ctx_t *ctx)
+{
+    /* Touch is probed while the LCD waits for reset and sleep-out, it is added to LVGL after both are done */
+    return bsp_touch_new(NULL, &tp);
+}
+
+static esp_err_t bsp_start_storage(bsp_start_ctx_t *ctx)
+{
+    esp_err_t ret = ESP_OK;
+    if (ctx->cfg->flags.sdcard) {
+        ret = bsp_sdcard_mount();
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "SD card mount failed (%s)", esp_err_to_name(ret));
+        }
+    }
+    if (ctx->cfg->flags.spiffs) {
+        esp_err_t spiffs_ret = bsp_spiffs_mount();
+        if (spiffs_ret != ESP_OK) {
+            ESP_LOGW(TAG, "SPIFFS mount failed (%s)", esp_err_to_name(spiffs_ret));
+            ret = (ret == ESP_OK) ? spiffs_ret : ret;
+        }
+    }
+    return ret;
+}
+
+static esp_err_t bsp_start_audio(bsp_start_ctx_t *ctx)
+{
+    /* Both codecs share the I2S channels, so they are created in one task */
+    ESP_RETURN_ON_ERROR(bsp_audio_init(NULL), TAG, "I2S init failed");
+    if (ctx->cfg->flags.speaker) {
+        ctx->result->speaker = bsp_audio_codec_speaker_init();
+        ESP_RETURN_ON_FALSE(ctx->result->speaker, ESP_FAIL, TAG, "Speaker init failed");
+    }
+    if (ctx->cfg->flags.microphone) {
+        ctx->result->microphone = bsp_audio_codec_microphone_init();
+        ESP_RETURN_ON_FALSE(ctx->result->microphone, ESP_FAIL, TAG, "Microphone init failed");
+    }
+    return ESP_OK;
+}
+
+static void bsp_start_job_run(bsp_start_job_t *job)
+{
+    const int64_t start = esp_timer_get_time();
+    job->err = job->func(job->ctx);
+    job->time_us = esp_timer_get_time() - start;
+}
+
+static void bsp_start_task(void *arg)
+{
+    bsp_start_job_t *job = (bsp_start_job_t *)arg;
+    bsp_start_job_run(job);
+    xSemaphoreGive(job->ctx->done);
+    vTaskDelete(NULL);
+}
+
+esp_err_t bsp_start_all(const bsp_start_cfg_t *cfg, bsp_start_result_t *result)
+{
+    ESP_RETURN_ON_FALSE(cfg && result, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    *result = (bsp_start_result_t) {
+        0
+    };
+
+    const int64_t start = esp_timer_get_time();
+    /* Shared by touch and codecs, must exist before they start */
+    ESP_RETURN_ON_ERROR(bsp_i2c_init(), TAG, "I2C init failed");
+    const int64_t i2c_time = esp_timer_get_time() - start;
+
+    bsp_start_ctx_t ctx = {
+        .cfg = cfg,
+        .result = result,
+    };
+    bsp_start_job_t jobs[4];
+    int job_num = 0;
+    if (cfg->flags.display) {
+        jobs[job_num++] = (bsp_start_job_t) {
+            .name = "display", .func = bsp_start_display, .ctx = &ctx
+        };
+        jobs[job_num++] = (bsp_start_job_t) {
+            .name = "touch", .func = bsp_start_touch, .ctx = &ctx
+        };
+    }
+    if (cfg->flags.sdcard || cfg->flags.spiffs) {
+        jobs[job_num++] = (bsp_start_job_t) {
+            .name = "storage", .func = bsp_start_storage, .ctx = &ctx
+        };
+    }
+    if (cfg->flags.speaker || cfg->flags.microphone) {
+        jobs[job_num++] = (bsp_start_job_t) {
+            .name = "audio", .func = bsp_start_audio, .ctx = &ctx
+        };
+    }
+
+    ctx.done = xSemaphoreCreateCounting(job_num > 0 ? job_num : 1, 0);
+    ESP_RETURN_ON_FALSE(ctx.done, ESP_ERR_NO_MEM, TAG, "Not enough memory for semaphore");
+
+    int started = 0;
+    for (int i = 0; i < job_num; i++) {
+        if (xTaskCreate(bsp_start_task, jobs[i].name, BSP_START_TASK_STACK, &jobs[i], uxTaskPriorityGet(NULL), NULL) == pdPASS) {
+            started++;
+        } else {
+            /* Not enough memory for the task, run it here */
+            bsp_start_job_run(&jobs[i]);
+        }
+    }
+    for (int i = 0; i < started; i++) {
+        xSemaphoreTake(ctx.done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(ctx.done);
+
+    esp_err_t ret = ESP_OK;
+    if (cfg->flags.display) {
+        /* jobs[0] is display, jobs[1] is touch */
+        if (jobs[0].err == ESP_OK) {
+            result->display = disp;
+            if (jobs[1].err == ESP_OK) {
+                const lvgl_port_touch_cfg_t touch_cfg = {
+                    .disp = disp,
+                    .handle = tp,
+                };
+                disp_indev = lvgl_port_add_touch(&touch_cfg);
+                if (disp_indev == NULL) {
+                    jobs[1].err = ESP_FAIL;
+                }
+            }
+        }
+    }
+
+    int64_t serial_time = i2c_time;
+    ESP_LOGI(TAG, "Start: i2c %" PRId64 " ms", i2c_time / 1000);
+    for (int i = 0; i < job_num; i++) {
+        serial_time += jobs[i].time_us;
+        ESP_LOGI(TAG, "Start: %s %" PRId64 " ms (%s)", jobs[i].name, jobs[i].time_us / 1000, esp_err_to_name(jobs[i].err));
+        if (ret == ESP_OK && jobs[i].err != ESP_OK) {
+            ret = jobs[i].err;
+        }
+    }
+    ESP_LOGI(TAG, "Start: total %" PRId64 " ms, serial would take %" PRId64 " ms",
+             (esp_timer_get_time() - start) / 1000, serial_time / 1000);
+    return ret;
+}
+
 static uint8_t bsp_get_main_button(void *param)
 {
     assert(tp);
@@ -4,7 +4,11 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <inttypes.h>
+#include <sys/param.h>
 #include "esp_err.h"
+#include "esp_check.h"
+#include "esp_log.h"
 #include "bsp/esp-box-3.h"
 #include "bsp_err_check.h"
 #include "esp_codec_dev_defaults.h"
@@ -14,6 +18,7 @@ static const char *TAG = "ESP-BOX-3";
 static i2s_chan_handle_t i2s_tx_chan = NULL;
 static i2s_chan_handle_t i2s_rx_chan = NULL;
 static const audio_codec_data_if_t *i2s_data_if = NULL;  /* Codec data interface */
+static bool i2s_tdm_mode = false;  /* I2S initialized by bsp_audio_aec_init() */
 
 
 /* Can be used for i2s_std_gpio_config_t and/or i2s_std_config_t initialization */
@@ -39,32 +44,74 @@ static const audio_codec_data_if_t *i2s_data_if = NULL;  /* Codec data interface
         .gpio_cfg = BSP_I2S_GPIO_CFG,                                                                 \
     }
 
-esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config)
+/* Used by bsp_audio_aec_init(), ES7210 sends the microphones and the reference in 4 slots of one frame */
+#define BSP_I2S_TDM_AEC_CFG(_sample_rate)                                                             \
+    {                                                                                                 \
+        .clk_cfg = I2S_TDM_CLK_DEFAULT_CONFIG(_sample_rate),                                          \
+        .slot_cfg = I2S_TDM_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO, \
+                    I2S_TDM_SLOT0 | I2S_TDM_SLOT1 | I2S_TDM_SLOT2 | I2S_TDM_SLOT3),                   \
+        .gpio_cfg = BSP_I2S_GPIO_CFG,                                                                 \
+    }
+
+/* DMA buffer of one descriptor is limited to 4092 bytes */
+#define BSP_I2S_DMA_BUFFER_MAX  (4092)
+#define BSP_I2S_DMA_DESC_MAX    (16)
+#define BSP_I2S_DMA_FRAME_MIN   (16)
+
+static uint32_t i2s_dma_desc_num = 0;
+static uint32_t i2s_dma_frame_num = 0;
+
+/* Derive DMA buffers from the latency target, the wakeup budget sets the minimal size of one buffer */
+static void bsp_audio_dma_calc(const i2s_std_config_t *i2s_config, uint32_t latency_ms, uint32_t max_wakeups,
+                               uint32_t *desc_num, uint32_t *frame_num)
 {
-    esp_err_t ret = ESP_FAIL;
-    if (i2s_tx_chan && i2s_rx_chan) {
-        /* Audio was initialized before */
-        return ESP_OK;
+    const uint32_t rate = i2s_config->clk_cfg.sample_rate_hz;
+    const uint32_t bits = (i2s_config->slot_cfg.data_bit_width == I2S_DATA_BIT_WIDTH_24BIT) ? 32 : i2s_config->slot_cfg.data_bit_width;
+    const uint32_t frame_bytes = ((i2s_config->slot_cfg.slot_mode == I2S_SLOT_MODE_MONO) ? 1 : 2) * bits / 8;
+    const uint32_t total = MAX(rate * latency_ms / 1000, 2 * BSP_I2S_DMA_FRAME_MIN);
+
+    uint32_t frame = (total + BSP_I2S_DMA_DESC_MAX - 1) / BSP_I2S_DMA_DESC_MAX;
+    if (max_wakeups > 0) {
+        frame = MAX(frame, (rate + max_wakeups - 1) / max_wakeups);
+    }
+    frame = MAX(frame, BSP_I2S_DMA_FRAME_MIN);
+    frame = MIN(frame, MIN(total / 2, BSP_I2S_DMA_BUFFER_MAX / frame_bytes)); // at least double buffering
+    if (max_wakeups > 0 && rate / frame > max_wakeups) {
+        ESP_LOGW(TAG, "%"PRIu32" ms latency needs %"PRIu32" wakeups/s", latency_ms, rate / frame);
     }
 
+    *frame_num = frame;
+    *desc_num = MAX(2, MIN((total + frame / 2) / frame, BSP_I2S_DMA_DESC_MAX));
+}
+
+/* Exactly one of std_cfg and tdm_cfg is set */
+static esp_err_t bsp_audio_channels_init(const i2s_std_config_t *std_cfg, const i2s_tdm_config_t *tdm_cfg,
+                                         uint32_t desc_num, uint32_t frame_num)
+{
+    esp_err_t ret = ESP_FAIL;
+
     /* Setup I2S peripheral */
     i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(CONFIG_BSP_I2S_NUM, I2S_ROLE_MASTER);
+    chan_cfg.dma_desc_num = desc_num;
+    chan_cfg.dma_frame_num = frame_num;
     chan_cfg.auto_clear = true; // Auto clear the legacy data in the DMA buffer
     BSP_ERROR_CHECK_RETURN_ERR(i2s_new_channel(&chan_cfg, &i2s_tx_chan, &i2s_rx_chan));
 
     /* Setup I2S channels */
-    const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(22050);
-    const i2s_std_config_t *p_i2s_cfg = &std_cfg_default;
-    if (i2s_config != NULL) {
-        p_i2s_cfg = i2s_config;
-    }
-
     if (i2s_tx_chan != NULL) {
-        ESP_GOTO_ON_ERROR(i2s_channel_init_std_mode(i2s_tx_chan, p_i2s_cfg), err, TAG, "I2S channel initialization failed");
+        if (tdm_cfg) {
+            ESP_GOTO_ON_ERROR(i2s_channel_init_tdm_mode(i2s_tx_chan, tdm_cfg), err, TAG, "I2S channel initialization failed");
+        } else {
+            ESP_GOTO_ON_ERROR(i2s_channel_init_std_mode(i2s_tx_chan, std_cfg), err, TAG, "I2S channel initialization failed");
+        }
         ESP_GOTO_ON_ERROR(i2s_channel_enable(i2s_tx_chan), err, TAG, "I2S enabling failed");
     }
     if (i2s_rx_chan != NULL) {
-        ESP_GOTO_ON_ERROR(i2s_channel_init_std_mode(i2s_rx_chan, p_i2s_cfg), err, TAG, "I2S channel initialization failed");
+        if (tdm_cfg) {
+            ESP_GOTO_ON_ERROR(i2s_channel_init_tdm_mode(i2s_rx_chan, tdm_cfg), err, TAG, "I2S channel initialization failed");
+        } else {
+            ESP_GOTO_ON_ERROR(i2s_channel_init_std_mode(i2s_rx_chan, std_cfg), err, TAG, "I2S channel initialization failed");
+        }
         ESP_GOTO_ON_ERROR(i2s_channel_enable(i2s_rx_chan), err, TAG, "I2S enabling failed");
     }
 
@@ -75,6 +122,9 @@ esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config)
     };
     i2s_data_if = audio_codec_new_i2s_data(&i2s_cfg);
     BSP_NULL_CHECK_GOTO(i2s_data_if, err);
+    i2s_tdm_mode = (tdm_cfg != NULL);
+    i2s_dma_desc_num = desc_num;
+    i2s_dma_frame_num = frame_num;
 
     return ESP_OK;
 
@@ -89,6 +139,59 @@ err:
     return ret;
 }
 
+esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config)
+{
+    if (i2s_tx_chan && i2s_rx_chan) {
+        /* Audio was initialized before */
+        return ESP_OK;
+    }
+
+    const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(22050);
+    return bsp_audio_channels_init(i2s_config ? i2s_config : &std_cfg_default, NULL,
+                                   CONFIG_BSP_I2S_DMA_DESC_NUM, CONFIG_BSP_I2S_DMA_FRAME_NUM);
+}
+
+esp_err_t bsp_audio_init_with_latency(const bsp_audio_latency_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg && cfg->latency_ms > 0, ESP_ERR_INVALID_ARG, TAG, "invalid latency config");
+    if (i2s_tx_chan && i2s_rx_chan) {
+        /* Audio was initialized before */
+        return ESP_OK;
+    }
+
+    const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(22050);
+    const i2s_std_config_t *p_i2s_cfg = cfg->i2s_config ? cfg->i2s_config : &std_cfg_default;
+    ESP_RETURN_ON_FALSE(p_i2s_cfg->clk_cfg.sample_rate_hz > 0, ESP_ERR_INVALID_ARG, TAG, "invalid sample rate");
+
+    uint32_t desc_num;
+    uint32_t frame_num;
+    bsp_audio_dma_calc(p_i2s_cfg, cfg->latency_ms, cfg->max_wakeups, &desc_num, &frame_num);
+    ESP_RETURN_ON_ERROR(bsp_audio_channels_init(p_i2s_cfg, NULL, desc_num, frame_num), TAG, "I2S init failed");
+    ESP_LOGI(TAG, "I2S DMA %"PRIu32" x %"PRIu32" frames, latency %"PRIu32" us, %"PRIu32" wakeups/s", desc_num, frame_num,
+             bsp_audio_get_latency_us(p_i2s_cfg->clk_cfg.sample_rate_hz), p_i2s_cfg->clk_cfg.sample_rate_hz / frame_num);
+    return ESP_OK;
+}
+
+uint32_t bsp_audio_get_latency_us(uint32_t sample_rate)
+{
+    if (sample_rate == 0 || !i2s_tx_chan) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)i2s_dma_desc_num * i2s_dma_frame_num * 1000000 / sample_rate);
+}
+
+esp_err_t bsp_audio_aec_init(uint32_t sample_rate)
+{
+    if (i2s_tx_chan && i2s_rx_chan) {
+        /* Audio was initialized before */
+        ESP_RETURN_ON_FALSE(i2s_tdm_mode, ESP_ERR_INVALID_STATE, TAG, "Audio initialized in standard mode");
+        return ESP_OK;
+    }
+
+    const i2s_tdm_config_t tdm_cfg = BSP_I2S_TDM_AEC_CFG(sample_rate);
+    return bsp_audio_channels_init(NULL, &tdm_cfg, CONFIG_BSP_I2S_DMA_DESC_NUM, CONFIG_BSP_I2S_DMA_FRAME_NUM);
+}
+
 const audio_codec_data_if_t *bsp_audio_get_codec_itf(void)
 {
     return i2s_data_if;
@@ -15,6 +15,8 @@
  */
 
 #pragma once
+#include <stdint.h>
+#include <stddef.h>
 #include "esp_lcd_types.h"
 
 /* LCD color formats */
@@ -37,12 +39,22 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Panel IO transactions needed to queue a flush of flush_sz bytes without waiting
+ *
+ * Color data of one esp_lcd_panel_draw_bitmap() is split into transactions of max_transfer_sz bytes.
+ * When the queue is shorter, the call blocks until the first transactions are sent.
+ */
+#define BSP_LCD_TRANS_QUEUE_DEPTH(flush_sz, max_transfer_sz) (((flush_sz) + (max_transfer_sz) - 1) / (max_transfer_sz))
+
 /**
  * @brief BSP display configuration structure
  *
  */
 typedef struct {
     int max_transfer_sz;    /*!< Maximum transfer size, in bytes. */
+    int trans_queue_depth;  /*!< Panel IO transaction queue depth, 0 to queue a full frame without waiting.
+                                 Use BSP_LCD_TRANS_QUEUE_DEPTH() for the size of the draw buffer */
 } bsp_display_config_t;
 
 /**
@@ -94,6 +106,21 @@ esp_err_t bsp_display_brightness_init(void);
  */
 esp_err_t bsp_display_brightness_set(int brightness_percent);
 
+/**
+ * @brief Fade display's brightness
+ *
+ * The brightness is changed smoothly by LEDC hardware fading, this function does not wait for the end of the fade.
+ * A running fade is replaced by the new one.
+ * Brightness must be already initialized by calling bsp_display_brightness_init() or bsp_display_new()
+ *
+ * @param[in] brightness_percent Brightness in [%]
+ * @param[in] fade_ms            Duration of the fade in [ms], 0 sets the brightness immediately
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Parameter error
+ */
+esp_err_t bsp_display_brightness_fade(int brightness_percent, uint32_t fade_ms);
+
 /**
  * @brief Turn on display backlight
  *
@@ -118,6 +145,44 @@ esp_err_t bsp_display_backlight_on(void);
  */
 esp_err_t bsp_display_backlight_off(void);
 
+/**
+ * @brief Splash image compressed by run-length encoding
+ *
+ * The data are 16-bit words, each block starts with a header word:
+ *  - bit 15 set:   run, the next word is a pixel repeated (header & 0x7FFF) times
+ *  - bit 15 clear: literal, the next (header) words are pixels
+ *
+ * Pixels are RGB565 in the byte order sent to the LCD (see BSP_LCD_BIGENDIAN), rows go from top to bottom.
+ * Runs and literals may continue over the end of a row.
+ */
+typedef struct {
+    const uint16_t *data;   /*!< Compressed image, e.g. embedded by EMBED_FILES */
+    size_t data_len;        /*!< Number of words in data */
+    uint16_t width;         /*!< Image width, at most BSP_LCD_H_RES */
+    uint16_t height;        /*!< Image height, at most BSP_LCD_V_RES */
+    uint16_t bg_color;      /*!< Color of the screen around the centered image, same byte order as the pixels */
+    int brightness;         /*!< Backlight in [%] turned on after the image is drawn */
+} bsp_display_splash_t;
+
+/**
+ * @brief Show splash image before the graphical library is started
+ *
+ * The LCD is initialized by bsp_display_new() and the image is decompressed in small chunks
+ * directly to esp_lcd_panel_draw_bitmap(), no frame buffer is allocated.
+ * The panel stays initialized, bsp_display_start() takes it over without reset,
+ * so the splash is visible until LVGL draws the first screen.
+ *
+ * @param[in] splash Splash image
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Image is NULL or larger than the LCD
+ *      - ESP_ERR_INVALID_SIZE  Compressed data end before the last pixel
+ *      - ESP_ERR_INVALID_STATE Display is already started
+ *      - ESP_ERR_NO_MEM        Not enough DMA memory for the chunks
+ *      - Else                  esp_lcd failure
+ */
+esp_err_t bsp_display_splash_show(const bsp_display_splash_t *splash);
+
 #ifdef __cplusplus
 }
 #endif
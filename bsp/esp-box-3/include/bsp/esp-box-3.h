@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <stdio.h>
 #include "sdkconfig.h"
 #include "driver/gpio.h"
 #include "driver/i2s_std.h"
@@ -20,6 +21,11 @@
 #include "lvgl.h"
 #include "esp_lvgl_port.h"
 #include "esp_codec_dev.h"
+#include "esp_mmap_assets.h"
+#if CONFIG_BSP_I2C_SCHED
+#include "esp_i2c_sched.h"
+#include "esp_task_monitor.h"
+#endif
 #include "iot_button.h"
 #include "bsp/display.h"
 
@@ -58,6 +64,7 @@
 #define BSP_LCD_CS            (GPIO_NUM_5)
 #define BSP_LCD_DC            (GPIO_NUM_4)
 #define BSP_LCD_RST           (GPIO_NUM_48)
+#define BSP_LCD_TE            (GPIO_NUM_NC)   /* TE output of LCD is not routed to ESP */
 
 #define BSP_LCD_BACKLIGHT     (GPIO_NUM_47)
 #define BSP_LCD_TOUCH_INT     (GPIO_NUM_3)
@@ -129,17 +136,42 @@ typedef enum {
 extern "C" {
 #endif
 
+/**
+ * @brief Cores and priorities of BSP_DISPLAY_TASK_PROFILE_COEX
+ *
+ * Wi-Fi/BT controller and Wi-Fi task (priority 23) run on BSP_CORE_NET, lwIP task (priority 18) should be pinned there
+ * too (CONFIG_LWIP_TCPIP_TASK_AFFINITY_CPU0). Application tasks of network (MQTT, HTTP, OTA download) should be created
+ * on BSP_CORE_NET with BSP_NET_TASK_PRIORITY, audio tasks with BSP_AUDIO_TASK_PRIORITY (above lwIP, below Wi-Fi).
+ * LVGL task, draw tasks and flush tasks run on BSP_CORE_UI with BSP_DISPLAY_TASK_PRIORITY.
+ */
+#define BSP_CORE_NET                (0)
+#define BSP_CORE_UI                 (1)
+#define BSP_DISPLAY_TASK_PRIORITY   (5)
+#define BSP_NET_TASK_PRIORITY       (5)
+#define BSP_AUDIO_TASK_PRIORITY     (20)
+
+/**
+ * @brief Placement of display tasks
+ */
+typedef enum {
+    BSP_DISPLAY_TASK_PROFILE_DEFAULT = 0, /*!< LVGL tasks as set in lvgl_port_cfg */
+    BSP_DISPLAY_TASK_PROFILE_COEX,        /*!< LVGL tasks on BSP_CORE_UI, away from Wi-Fi/BT, network and audio (task_affinity, draw_task_affinity and task_priority of lvgl_port_cfg are overridden) */
+} bsp_display_task_profile_t;
+
 /**
  * @brief BSP display configuration structure
  *
  */
 typedef struct {
     lvgl_port_cfg_t lvgl_port_cfg;  /*!< LVGL port configuration */
-    uint32_t        buffer_size;    /*!< Size of the buffer for the screen in pixels */
+    bsp_display_task_profile_t task_profile; /*!< Placement of LVGL tasks (ignored with CONFIG_FREERTOS_UNICORE) */
+    uint32_t        buffer_size;    /*!< Size of the buffer for the screen in pixels, 0 to select the buffers from free memory
+                                         (double_buffer and buff_* flags are ignored then, the decision is logged) */
     bool            double_buffer;  /*!< True, if should be allocated two buffers */
     struct {
         unsigned int buff_dma: 1;    /*!< Allocated LVGL buffer will be DMA capable */
         unsigned int buff_spiram: 1; /*!< Allocated LVGL buffer will be in PSRAM */
+        unsigned int te_sync: 1;     /*!< Start the flush of each frame on TE edge of LCD, when BSP_LCD_TE is connected (LVGL 9 only) */
     } flags;
 } bsp_display_cfg_t;
 
@@ -179,6 +211,39 @@ typedef struct {
  */
 esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config);
 
+/**
+ * @brief Audio buffering configuration of bsp_audio_init_with_latency()
+ */
+typedef struct {
+    const i2s_std_config_t *i2s_config; /*!< I2S configuration, NULL for default values (Mono, duplex, 16bit, 22050 Hz) */
+    uint32_t latency_ms;                /*!< Target buffering latency of each direction (TX and RX) in ms */
+    uint32_t max_wakeups;               /*!< CPU wakeup budget: DMA interrupts per second of each direction, 0 for no limit */
+} bsp_audio_latency_cfg_t;
+
+/**
+ * @brief Init audio with I2S DMA buffers derived from target latency
+ *
+ * The latency (number of DMA buffers multiplied by their frames) is split into as many buffers as
+ * the wakeup budget allows, e.g. 20 ms and 200 wakeups/s for voice, 200 ms and 20 wakeups/s for music.
+ * If both targets cannot be met, the latency wins. Sizes are derived at the sample rate of i2s_config.
+ *
+ * @note Same as bsp_audio_init(), the DMA buffers stay the same until the I2S channels are deleted.
+ * @param[in] cfg Buffering configuration
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   NULL pointer or invalid configuration
+ *      - Others                Same as bsp_audio_init()
+ */
+esp_err_t bsp_audio_init_with_latency(const bsp_audio_latency_cfg_t *cfg);
+
+/**
+ * @brief Get buffering latency of I2S DMA
+ *
+ * @param[in] sample_rate Current sample rate in Hz
+ * @return Latency of DMA buffers of one direction in microseconds, 0 if audio is not initialized
+ */
+uint32_t bsp_audio_get_latency_us(uint32_t sample_rate);
+
 /**
  * @brief Get codec I2S interface (initialized in bsp_audio_init)
  *
@@ -201,6 +266,49 @@ esp_codec_dev_handle_t bsp_audio_codec_speaker_init(void);
  */
 esp_codec_dev_handle_t bsp_audio_codec_microphone_init(void);
 
+/* Echo cancellation (AEC) capture, see bsp_audio_aec_init() */
+#define BSP_AUDIO_AEC_CHANNELS      (4)       /*!< Captured channels (TDM slots of ES7210) */
+#define BSP_AUDIO_AEC_REF_CHANNEL   (0)       /*!< Channel of playback reference (hardware loopback of the speaker signal) */
+#define BSP_AUDIO_AEC_INPUT_FORMAT  "RMNM"  /*!< Channel layout for esp-sr AFE: M - microphone, R - reference, N - unused */
+
+/**
+ * @brief Init audio for echo cancellation (AEC)
+ *
+ * I2S is configured in TDM mode with 4 slots of 16 bits for both directions, they share the bit and frame clocks.
+ * ES7210 captures microphones and the playback reference (loopback of the speaker signal) by the same ADC clock
+ * in one TDM frame, so the reference is sample-aligned with the microphone data and the latency between
+ * playback and reference is constant. No software delay estimation or alignment buffers are needed.
+ *
+ * @note Call it instead of bsp_audio_init(), before bsp_audio_codec_speaker_init() and bsp_audio_codec_microphone_aec_init().
+ *       Open both codec devices with the same sample rate, 16 bits per sample and BSP_AUDIO_AEC_CHANNELS channels,
+ *       so the slot configuration of I2S stays the same. ES8311 plays channel 0 of the written frames.
+ * @param[in] sample_rate Sample rate in Hz, e.g. 16000 for voice
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Audio was already initialized in standard mode by bsp_audio_init()
+ *      - Others                I2S channel initialization failed
+ */
+esp_err_t bsp_audio_aec_init(uint32_t sample_rate);
+
+/**
+ * @brief Initialize microphone codec device with playback reference
+ *
+ * All 4 inputs of ES7210 are captured in TDM, open the device with BSP_AUDIO_AEC_CHANNELS channels:
+ * \code{.c}
+ * esp_codec_dev_sample_info_t fs = {
+ *     .sample_rate = 16000,
+ *     .channel = BSP_AUDIO_AEC_CHANNELS,
+ *     .bits_per_sample = 16,
+ * };
+ * esp_codec_dev_open(mic_codec_dev, &fs);
+ * esp_codec_dev_read(mic_codec_dev, frames, frames_bytes); // reference is at BSP_AUDIO_AEC_REF_CHANNEL of each frame
+ * \endcode
+ *
+ * @note I2S is initialized by bsp_audio_aec_init() at 16 kHz, if it was not initialized before.
+ * @return Pointer to codec device handle or NULL when error occurred
+ */
+esp_codec_dev_handle_t bsp_audio_codec_microphone_aec_init(void);
+
 /**************************************************************************************************
  *
  * I2C interface
@@ -235,6 +343,19 @@ esp_err_t bsp_i2c_init(void);
  */
 esp_err_t bsp_i2c_deinit(void);
 
+#if CONFIG_BSP_I2C_SCHED
+/**
+ * @brief Get priority scheduler of the I2C bus
+ *
+ * @note Touch created by bsp_touch_new() is already scheduled in ESP_I2C_SCHED_PRIO_TOUCH class.
+ *
+ * @return
+ *      - Scheduler handle
+ *      - NULL if I2C was not initialized
+ */
+esp_i2c_sched_handle_t bsp_i2c_sched_get_handle(void);
+#endif
+
 /**
  * @brief Get I2C driver handle
  *
@@ -255,6 +376,8 @@ i2c_master_bus_handle_t bsp_i2c_get_handle(void);
  * \endcode
  **************************************************************************************************/
 #define BSP_SPIFFS_MOUNT_POINT      CONFIG_BSP_SPIFFS_MOUNT_POINT
+/* LVGL drive of SPIFFS (CONFIG_BSP_LVGL_FS), e.g. lv_img_set_src(img, "F:/image.png") */
+#define BSP_SPIFFS_LVGL_LETTER      'F'
 
 /**
  * @brief Mount SPIFFS to virtual file system
@@ -281,6 +404,64 @@ esp_err_t bsp_spiffs_mount(void);
  */
 esp_err_t bsp_spiffs_unmount(void);
 
+/**************************************************************************************************
+ *
+ * Assets
+ *
+ * Read-only images, fonts and sounds packed by esp_mmap_assets/tools/pack_assets.py to the partition
+ * CONFIG_BSP_ASSETS_PARTITION_LABEL. The partition is memory-mapped, the data are used in place without copy:
+ * \code{.c}
+ * lv_img_dsc_t logo;
+ * bsp_assets_get_image("logo_320x240.rgb565", &logo);
+ * lv_img_set_src(img, &logo);
+ * \endcode
+ **************************************************************************************************/
+
+/**
+ * @brief Map assets partition
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the assets are already mapped
+ *      - other error codes from esp_mmap_assets_new()
+ */
+esp_err_t bsp_assets_mount(void);
+
+/**
+ * @brief Unmap assets partition
+ *
+ * @note Images and fonts from the assets must not be used after this call.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_STATE if the assets are not mapped
+ */
+esp_err_t bsp_assets_unmount(void);
+
+/**
+ * @brief Get handle of mapped assets, e.g. for esp_mmap_assets_find()
+ *
+ * @return Handle of assets or NULL when not mapped
+ */
+esp_mmap_assets_handle_t bsp_assets_get_handle(void);
+
+/**
+ * @brief Fill LVGL image descriptor of an asset
+ *
+ * The descriptor points to the mapped flash, it must exist as long as the image is shown.
+ * RGB565 (and RGB565A8 with LVGL 9) pixels must be in the LVGL color format, JPEG and PNG need an LVGL decoder.
+ *
+ * @param[in]  name Name of the asset
+ * @param[out] dsc  LVGL image descriptor
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if some pointer is NULL
+ *      - ESP_ERR_INVALID_STATE if the assets are not mapped
+ *      - ESP_ERR_NOT_FOUND if there is no asset of this name
+ *      - ESP_ERR_NOT_SUPPORTED if the asset is not an image or the format is not supported by this LVGL version
+ */
+esp_err_t bsp_assets_get_image(const char *name, lv_img_dsc_t *dsc);
+
 /**************************************************************************************************
  *
  * SD card
@@ -295,11 +476,47 @@ esp_err_t bsp_spiffs_unmount(void);
  * @attention IO2 is also routed to RGB LED and push button
  **************************************************************************************************/
 #define BSP_SD_MOUNT_POINT      CONFIG_BSP_SD_MOUNT_POINT
+/* LVGL drive of SD card (CONFIG_BSP_LVGL_FS), e.g. lv_img_set_src(img, "S:/image.png") */
+#define BSP_SD_LVGL_LETTER      'S'
 extern sdmmc_card_t *bsp_sdcard;
 
+/**
+ * @brief SD card mount configuration
+ */
+typedef struct {
+    int max_freq_khz;               /*!< SDMMC clock in [kHz], e.g. SDMMC_FREQ_HIGHSPEED (the card must support high speed) */
+    int max_files;                  /*!< Maximum number of open files */
+    size_t allocation_unit_size;    /*!< Cluster size used when the card is formatted, bigger clusters mean less FAT updates */
+    size_t file_buffer_size;        /*!< Size of write-back buffer of bsp_sdcard_file_buffer_add(), 0 to disable */
+} bsp_sdcard_cfg_t;
+
+/**
+ * @brief Configuration used by bsp_sdcard_mount()
+ */
+#define BSP_SDCARD_DEFAULT_CONFIG()         \
+    {                                       \
+        .max_freq_khz = SDMMC_FREQ_DEFAULT, \
+        .max_files = 5,                     \
+        .allocation_unit_size = 16 * 1024,  \
+        .file_buffer_size = 0,              \
+    }
+
+/**
+ * @brief Configuration for streaming (e.g. audio recording): 40 MHz clock, 64 kB clusters and 32 kB file buffers
+ */
+#define BSP_SDCARD_HIGH_THROUGHPUT_CONFIG()     \
+    {                                           \
+        .max_freq_khz = SDMMC_FREQ_HIGHSPEED,   \
+        .max_files = 5,                         \
+        .allocation_unit_size = 64 * 1024,      \
+        .file_buffer_size = 32 * 1024,          \
+    }
+
 /**
  * @brief Mount microSD card to virtual file system
  *
+ * Same as bsp_sdcard_mount_with_config() with BSP_SDCARD_DEFAULT_CONFIG().
+ *
  * @return
  *      - ESP_OK on success
  *      - ESP_ERR_INVALID_STATE if esp_vfs_fat_sdmmc_mount was already called
@@ -309,6 +526,62 @@ extern sdmmc_card_t *bsp_sdcard;
  */
 esp_err_t bsp_sdcard_mount(void);
 
+/**
+ * @brief Mount microSD card to virtual file system with configuration
+ *
+ * @note When the card does not support the high speed mode, the mount fails. Mount it again with lower clock.
+ *
+ * @param[in] cfg Mount configuration
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if cfg is NULL
+ *      - ESP_ERR_INVALID_STATE if esp_vfs_fat_sdmmc_mount was already called
+ *      - ESP_ERR_NO_MEM if memory can not be allocated
+ *      - ESP_FAIL if partition can not be mounted
+ *      - other error codes from SDMMC or SPI drivers, SDMMC protocol, or FATFS drivers
+ */
+esp_err_t bsp_sdcard_mount_with_config(const bsp_sdcard_cfg_t *cfg);
+
+/**
+ * @brief Add write-back buffer to a file opened on microSD card
+ *
+ * Small writes (e.g. audio frames) are collected in the buffer and the card gets whole clusters,
+ * so the data and FAT are updated less often and a stall of the card is absorbed by the buffer.
+ * The buffer of file_buffer_size is allocated in PSRAM when available. It must be added before the first access to the file
+ * and freed by the caller after fclose().
+ *
+ * \code{.c}
+ * FILE *f = fopen(BSP_SD_MOUNT_POINT"/rec.wav", "wb");
+ * void *buf = bsp_sdcard_file_buffer_add(f);
+ * fwrite(...);
+ * fclose(f);
+ * free(buf);
+ * \endcode
+ *
+ * @param[in] f Opened file
+ * @return
+ *      - Pointer to the buffer
+ *      - NULL when buffering is disabled (file_buffer_size is 0) or error occurred, the file is still usable
+ */
+void *bsp_sdcard_file_buffer_add(FILE *f);
+
+/**
+ * @brief Measure sequential throughput of mounted microSD card
+ *
+ * A temporary file is written in chunks, flushed to the card, read back and deleted.
+ *
+ * @param[in]  size       Size of the test file in bytes
+ * @param[in]  chunk_size Size of one write/read in bytes
+ * @param[out] write_kbps Write throughput in [kB/s]
+ * @param[out] read_kbps  Read throughput in [kB/s]
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if some pointer is NULL or size is 0
+ *      - ESP_ERR_NO_MEM if memory can not be allocated
+ *      - ESP_FAIL if the file can not be written or read
+ */
+esp_err_t bsp_sdcard_speed_test(size_t size, size_t chunk_size, uint32_t *write_kbps, uint32_t *read_kbps);
+
 /**
  * @brief Unmount micorSD card from virtual file system
  *
@@ -415,6 +688,342 @@ esp_err_t bsp_display_exit_sleep(void);
  * @param[in] rotation Angle of the display rotation
  */
 void bsp_display_rotate(lv_display_t *disp, lv_disp_rotation_t rotation);
+
+/**
+ * @brief Point of ambient light to brightness curve
+ */
+typedef struct {
+    int32_t lux;    /*!< Ambient light in [lx] */
+    int percent;    /*!< Brightness in [%] */
+} bsp_display_backlight_point_t;
+
+/**
+ * @brief Automatic backlight configuration structure
+ */
+typedef struct {
+    const bsp_display_backlight_point_t *curve; /*!< Brightness by ambient light, points sorted by lux (NULL: default power-saving curve) */
+    size_t curve_len;           /*!< Number of curve points */
+    int default_percent;        /*!< Brightness until ambient light is reported by bsp_display_backlight_auto_set_ambient() */
+    int dim_percent;            /*!< Maximal brightness after dim_timeout_ms of UI inactivity */
+    uint32_t dim_timeout_ms;    /*!< UI inactivity before dimming (0: never) */
+    uint32_t off_timeout_ms;    /*!< UI inactivity before backlight off (0: never) */
+    uint32_t fade_ms;           /*!< Duration of brightness changes */
+    uint32_t update_period_ms;  /*!< Period of brightness updates */
+} bsp_display_backlight_auto_cfg_t;
+
+#define BSP_DISPLAY_BACKLIGHT_AUTO_DEFAULT_CONFIG() \
+    {                                               \
+        .curve = NULL,                              \
+        .curve_len = 0,                             \
+        .default_percent = 70,                      \
+        .dim_percent = 10,                          \
+        .dim_timeout_ms = 30000,                    \
+        .off_timeout_ms = 120000,                   \
+        .fade_ms = 500,                             \
+        .update_period_ms = 200,                    \
+    }
+
+/**
+ * @brief Start automatic backlight control
+ *
+ * The brightness follows ambient light (reported by bsp_display_backlight_auto_set_ambient(), e.g. from BH1750)
+ * and is dimmed or turned off on UI inactivity (LVGL inactive time). Changes are faded by LEDC hardware.
+ * Any touch turns the brightness back up.
+ *
+ * Display must be already initialized by calling bsp_display_start().
+ * Do not set the brightness by other functions while the automatic control is running.
+ *
+ * @param[in] cfg Automatic backlight configuration
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Parameter error
+ *      - ESP_ERR_INVALID_STATE Display is not started or automatic backlight is already running
+ *      - ESP_ERR_NO_MEM        Not enough memory
+ */
+esp_err_t bsp_display_backlight_auto_start(const bsp_display_backlight_auto_cfg_t *cfg);
+
+/**
+ * @brief Stop automatic backlight control
+ *
+ * The brightness stays at its last value.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Automatic backlight is not running
+ */
+esp_err_t bsp_display_backlight_auto_stop(void);
+
+/**
+ * @brief Report ambient light to automatic backlight control
+ *
+ * Can be called from any task (e.g. from bh1750 sampler callback).
+ *
+ * @param[in] lux Ambient light in [lx]
+ */
+void bsp_display_backlight_auto_set_ambient(float lux);
+
+/**
+ * @brief Display power state
+ */
+typedef enum {
+    BSP_DISPLAY_POWER_ACTIVE,       /*!< Backlight at active brightness */
+    BSP_DISPLAY_POWER_DIMMED,       /*!< Backlight at dimmed brightness */
+    BSP_DISPLAY_POWER_SCREEN_OFF,   /*!< Backlight off, then LCD display off (LVGL keeps running) */
+    BSP_DISPLAY_POWER_UI_SUSPENDED, /*!< LCD in sleep, LVGL stopped, touch in monitor mode (when supported) */
+} bsp_display_power_state_t;
+
+/**
+ * @brief Callback of display power state change, called in LVGL task with display lock
+ */
+typedef void (*bsp_display_power_cb_t)(bsp_display_power_state_t state, void *user_ctx);
+
+/**
+ * @brief Display power manager configuration structure
+ *
+ * Timeouts are UI inactivity (LVGL inactive time), every one must be longer than the previous used one.
+ */
+typedef struct {
+    int active_percent;             /*!< Brightness in active state [%] */
+    int dim_percent;                /*!< Brightness in dimmed state [%] */
+    uint32_t dim_timeout_ms;        /*!< Inactivity before dimming (0: never) */
+    uint32_t off_timeout_ms;        /*!< Inactivity before screen off (0: never) */
+    uint32_t suspend_timeout_ms;    /*!< Inactivity before UI suspend (0: never) */
+    uint32_t fade_ms;               /*!< Duration of fading down */
+    uint32_t wake_fade_ms;          /*!< Duration of fading up on wake (0: immediately) */
+    bsp_display_power_cb_t state_cb;/*!< Called on every state change (optional) */
+    void *user_ctx;                 /*!< Passed to state_cb */
+} bsp_display_power_cfg_t;
+
+#define BSP_DISPLAY_POWER_DEFAULT_CONFIG()  \
+    {                                       \
+        .active_percent = 100,              \
+        .dim_percent = 10,                  \
+        .dim_timeout_ms = 30000,            \
+        .off_timeout_ms = 60000,            \
+        .suspend_timeout_ms = 90000,        \
+        .fade_ms = 500,                     \
+        .wake_fade_ms = 30,                 \
+        .state_cb = NULL,                   \
+        .user_ctx = NULL,                   \
+    }
+
+/**
+ * @brief Start display power manager
+ *
+ * The display goes through active, dimmed, screen-off and UI-suspended states on UI inactivity. Backlight changes
+ * are faded by LEDC hardware. The LCD is only turned off (screen off) or put to sleep (UI suspended),
+ * so the frame in LCD memory is kept and the wake up does not need any redraw.
+ * In UI-suspended state the LVGL timers, tick and task are stopped (LVGL 9: lvgl_port_touch_suspend()).
+ *
+ * Any touch or bsp_display_power_wake() returns to active state. The touch which woke the display
+ * from screen-off or UI-suspended states is not passed to the UI.
+ *
+ * Display must be already initialized by calling bsp_display_start().
+ * Do not use it together with automatic backlight (bsp_display_backlight_auto_start()) or bsp_display_enter_sleep().
+ *
+ * @param[in] cfg Power manager configuration
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Parameter error
+ *      - ESP_ERR_INVALID_STATE Display is not started or power manager or automatic backlight is already running
+ *      - ESP_ERR_NO_MEM        Not enough memory
+ */
+esp_err_t bsp_display_power_start(const bsp_display_power_cfg_t *cfg);
+
+/**
+ * @brief Stop display power manager
+ *
+ * Display is woken up to active state first.
+ *
+ * @note It must not be called with display lock.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Power manager is not running
+ */
+esp_err_t bsp_display_power_stop(void);
+
+/**
+ * @brief Wake display to active state (e.g. from button callback)
+ *
+ * Can be called from any task or ISR.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Power manager or LVGL task is not running
+ */
+esp_err_t bsp_display_power_wake(void);
+
+/**
+ * @brief Get display power state
+ *
+ * @return Current state (BSP_DISPLAY_POWER_ACTIVE, when power manager is not running)
+ */
+bsp_display_power_state_t bsp_display_power_get_state(void);
+
+/**
+ * @brief Callback of automatic rotation, called with display lock right after the rotation
+ */
+typedef void (*bsp_display_auto_rotate_cb_t)(lv_display_t *disp, lv_disp_rotation_t rotation, void *user_ctx);
+
+/**
+ * @brief Automatic rotation configuration structure
+ */
+typedef struct {
+    float enter_g;              /*!< Gravity on the axis of a new orientation needed to rotate the display [g] */
+    float leave_g;              /*!< Current orientation is kept while gravity on its axis is above this [g] (hysteresis) */
+    uint32_t debounce_ms;       /*!< New orientation must be stable this long before rotation */
+    uint32_t period_ms;         /*!< Period of IMU FIFO reading, the samples of one period are averaged */
+    bsp_display_auto_rotate_cb_t rotated_cb; /*!< Called after rotation (optional) */
+    void *user_ctx;             /*!< Passed to rotated_cb */
+    uint32_t task_priority;     /*!< Priority of the rotation task */
+    uint32_t task_stack;        /*!< Stack of the rotation task */
+} bsp_display_auto_rotate_cfg_t;
+
+#define BSP_DISPLAY_AUTO_ROTATE_DEFAULT_CONFIG()  \
+    {                                           \
+        .enter_g = 0.6f,                        \
+        .leave_g = 0.4f,                        \
+        .debounce_ms = 300,                     \
+        .period_ms = 100,                       \
+        .rotated_cb = NULL,                     \
+        .user_ctx = NULL,                       \
+        .task_priority = 2,                     \
+        .task_stack = 3072,                     \
+    }
+
+/**
+ * @brief Start automatic rotation of the display by the IMU
+ *
+ * The accelerometer of ICM42670 runs in low-power mode at 25 Hz and fills its FIFO, the rotation task reads
+ * the FIFO in one burst every period_ms and averages the samples (INT1 of the IMU is not connected on ESP-BOX-3).
+ * The display is rotated when gravity on the axis of another orientation is above enter_g, gravity on the axis
+ * of the current one dropped below leave_g and this lasts debounce_ms.
+ *
+ * The rotation is done by the LCD controller (swap_xy and mirror set by esp_lvgl_port), so the frames are not
+ * rotated by software. The touch coordinates follow the LVGL display rotation, which is changed together with
+ * the panel under display lock, so no touch is read with the old transformation.
+ *
+ * Display must be already initialized by calling bsp_display_start().
+ *
+ * @param[in] cfg Automatic rotation configuration
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Parameter error
+ *      - ESP_ERR_INVALID_STATE Display is not started or automatic rotation is already running
+ *      - ESP_ERR_NO_MEM        Not enough memory
+ *      - Others                IMU error
+ */
+esp_err_t bsp_display_auto_rotate_start(const bsp_display_auto_rotate_cfg_t *cfg);
+
+/**
+ * @brief Stop automatic rotation of the display
+ *
+ * The display keeps its last rotation and the IMU is released.
+ *
+ * @note It must not be called with display lock.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Automatic rotation is not running
+ */
+esp_err_t bsp_display_auto_rotate_stop(void);
+/**************************************************************************************************
+ *
+ * Board bring-up
+ *
+ * bsp_start_all() initializes the selected subsystems in parallel tasks, so the waits of one
+ * (e.g. LCD reset and sleep-out, SD card identification) overlap with the others.
+ * The I2C bus is initialized first and shared by touch and codecs, the I2C master driver serializes
+ * their transactions. The time of each subsystem is logged at the end.
+ **************************************************************************************************/
+
+/**
+ * @brief Configuration of board bring-up
+ */
+typedef struct {
+    const bsp_display_cfg_t *display_cfg;   /*!< Display configuration, NULL for the defaults of bsp_display_start() */
+    struct {
+        unsigned int display: 1;            /*!< Start LCD, LVGL and touch */
+        unsigned int sdcard: 1;             /*!< Mount microSD card */
+        unsigned int spiffs: 1;             /*!< Mount SPIFFS */
+        unsigned int speaker: 1;            /*!< Initialize speaker codec */
+        unsigned int microphone: 1;         /*!< Initialize microphone codec */
+    } flags;
+} bsp_start_cfg_t;
+
+/**
+ * @brief Handles of started subsystems, NULL when not selected or failed
+ */
+typedef struct {
+    lv_display_t *display;                  /*!< LVGL display */
+    esp_codec_dev_handle_t speaker;         /*!< Speaker codec device */
+    esp_codec_dev_handle_t microphone;      /*!< Microphone codec device */
+} bsp_start_result_t;
+
+/**
+ * @brief Initialize selected subsystems of the board in parallel
+ *
+ * The subsystems run in separate tasks with the priority of the calling task:
+ * display (LVGL port, backlight PWM, LCD), touch, storage (microSD card, then SPIFFS) and audio (I2S, speaker, microphone).
+ * A failed subsystem does not stop the others.
+ * LCD backlight must be enabled separately by calling bsp_display_brightness_set().
+ *
+ * @note Not thread-safe, call it once at start of the application.
+ *
+ * @param[in]  cfg    Bring-up configuration
+ * @param[out] result Handles of started subsystems
+ * @return
+ *      - ESP_OK              All selected subsystems started
+ *      - ESP_ERR_INVALID_ARG NULL pointer
+ *      - ESP_ERR_NO_MEM      No memory for synchronization
+ *      - Error of the first failed subsystem otherwise
+ */
+esp_err_t bsp_start_all(const bsp_start_cfg_t *cfg, bsp_start_result_t *result);
+
+/**************************************************************************************************
+ *
+ * Task monitor
+ *
+ * Periodic report of CPU load of all tasks (LVGL, touch, audio and application tasks), idle time of
+ * both cores and stack high-water marks, from FreeRTOS run-time statistics (enable CONFIG_BSP_TASK_MONITOR).
+ * The report is printed to the log (CONFIG_BSP_TASK_MONITOR_LOG) and drawn over the screen of the
+ * started display (CONFIG_BSP_TASK_MONITOR_OVERLAY). Period is set by CONFIG_BSP_TASK_MONITOR_PERIOD_MS.
+ **************************************************************************************************/
+
+/**
+ * @brief Start the task monitor
+ *
+ * @note The overlay is drawn only when the display is started before the monitor.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Task monitor already started
+ *      - ESP_ERR_NOT_SUPPORTED FreeRTOS run-time statistics are disabled
+ *      - ESP_ERR_NO_MEM        Not enough memory
+ */
+esp_err_t bsp_task_monitor_start(void);
+
+/**
+ * @brief Stop the task monitor and remove its overlay
+ *
+ * @note It must not be called with display lock.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Task monitor is not started
+ */
+esp_err_t bsp_task_monitor_stop(void);
+
+/**
+ * @brief Get handle of the started task monitor
+ *
+ * The last report can be read by esp_task_monitor_get_report().
+ *
+ * @return Task monitor handle, NULL when not started
+ */
+esp_task_monitor_handle_t bsp_task_monitor_get_handle(void);
+
 /**************************************************************************************************
  *
  * Button
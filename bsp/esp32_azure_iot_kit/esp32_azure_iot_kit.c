@@ -298,10 +298,25 @@ lv_display_t *bsp_display_start(void)
     return bsp_display_start_with_config(&cfg);
 }
 
+/* LVGL port configuration with the task placement of the profile */
+static void bsp_display_port_cfg(const bsp_display_cfg_t *cfg, lvgl_port_cfg_t *port_cfg)
+{
+    *port_cfg = cfg->lvgl_port_cfg;
+#if !CONFIG_FREERTOS_UNICORE
+    if (cfg->task_profile == BSP_DISPLAY_TASK_PROFILE_COEX) {
+        port_cfg->task_affinity = BSP_CORE_UI;
+        port_cfg->draw_task_affinity = BSP_CORE_UI;
+        port_cfg->task_priority = BSP_DISPLAY_TASK_PRIORITY;
+    }
+#endif
+}
+
 lv_display_t *bsp_display_start_with_config(const bsp_display_cfg_t *cfg)
 {
     assert(cfg != NULL);
-    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_init(&cfg->lvgl_port_cfg));
+    lvgl_port_cfg_t port_cfg;
+    bsp_display_port_cfg(cfg, &port_cfg);
+    BSP_ERROR_CHECK_RETURN_NULL(lvgl_port_init(&port_cfg));
 
     BSP_NULL_CHECK(disp = bsp_display_lcd_init(cfg), NULL);
 
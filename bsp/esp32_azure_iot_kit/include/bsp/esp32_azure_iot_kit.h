@@ -62,12 +62,33 @@ typedef enum {
     BSP_BUTTON_NUM
 } bsp_button_t;
 
+/**
+ * @brief Cores and priorities of BSP_DISPLAY_TASK_PROFILE_COEX
+ *
+ * Wi-Fi/BT controller and Wi-Fi task (priority 23) run on BSP_CORE_NET, lwIP task (priority 18) should be pinned there
+ * too (CONFIG_LWIP_TCPIP_TASK_AFFINITY_CPU0). Application tasks of network (MQTT, HTTP, OTA download) should be created
+ * on BSP_CORE_NET with BSP_NET_TASK_PRIORITY. LVGL task and draw tasks run on BSP_CORE_UI with BSP_DISPLAY_TASK_PRIORITY.
+ */
+#define BSP_CORE_NET                (0)
+#define BSP_CORE_UI                 (1)
+#define BSP_DISPLAY_TASK_PRIORITY   (5)
+#define BSP_NET_TASK_PRIORITY       (5)
+
+/**
+ * @brief Placement of display tasks
+ */
+typedef enum {
+    BSP_DISPLAY_TASK_PROFILE_DEFAULT = 0, /*!< LVGL tasks as set in lvgl_port_cfg */
+    BSP_DISPLAY_TASK_PROFILE_COEX,        /*!< LVGL tasks on BSP_CORE_UI, away from Wi-Fi/BT and network (task_affinity, draw_task_affinity and task_priority of lvgl_port_cfg are overridden) */
+} bsp_display_task_profile_t;
+
 /**
  * @brief BSP display configuration structure
  *
  */
 typedef struct {
     lvgl_port_cfg_t lvgl_port_cfg;  /*!< LVGL port configuration */
+    bsp_display_task_profile_t task_profile; /*!< Placement of LVGL tasks (ignored with CONFIG_FREERTOS_UNICORE) */
     uint32_t        buffer_size;    /*!< Size of the buffer for the screen in pixels */
     bool            double_buffer;  /*!< True, if should be allocated two buffers */
     struct {
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <inttypes.h>
+#include <sys/param.h>
 #include "sdkconfig.h"
 #include "driver/gpio.h"
 #include "driver/ledc.h"
@@ -181,32 +183,54 @@ esp_err_t bsp_spiffs_unmount(void)
     return esp_vfs_spiffs_unregister(CONFIG_BSP_SPIFFS_PARTITION_LABEL);
 }
 
-esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config)
+/* DMA buffer of one descriptor is limited to 4092 bytes */
+#define BSP_I2S_DMA_BUFFER_MAX  (4092)
+#define BSP_I2S_DMA_DESC_MAX    (16)
+#define BSP_I2S_DMA_FRAME_MIN   (16)
+
+static uint32_t i2s_dma_desc_num = 0;
+static uint32_t i2s_dma_frame_num = 0;
+
+/* Derive DMA buffers from the latency target, the wakeup budget sets the minimal size of one buffer */
+static void bsp_audio_dma_calc(const i2s_std_config_t *i2s_config, uint32_t latency_ms, uint32_t max_wakeups,
+                               uint32_t *desc_num, uint32_t *frame_num)
 {
-    if (i2s_tx_chan && i2s_rx_chan) {
-        /* Audio was initialized before */
-        return ESP_OK;
+    const uint32_t rate = i2s_config->clk_cfg.sample_rate_hz;
+    const uint32_t bits = (i2s_config->slot_cfg.data_bit_width == I2S_DATA_BIT_WIDTH_24BIT) ? 32 : i2s_config->slot_cfg.data_bit_width;
+    const uint32_t frame_bytes = ((i2s_config->slot_cfg.slot_mode == I2S_SLOT_MODE_MONO) ? 1 : 2) * bits / 8;
+    const uint32_t total = MAX(rate * latency_ms / 1000, 2 * BSP_I2S_DMA_FRAME_MIN);
+
+    uint32_t frame = (total + BSP_I2S_DMA_DESC_MAX - 1) / BSP_I2S_DMA_DESC_MAX;
+    if (max_wakeups > 0) {
+        frame = MAX(frame, (rate + max_wakeups - 1) / max_wakeups);
+    }
+    frame = MAX(frame, BSP_I2S_DMA_FRAME_MIN);
+    frame = MIN(frame, MIN(total / 2, BSP_I2S_DMA_BUFFER_MAX / frame_bytes)); // at least double buffering
+    if (max_wakeups > 0 && rate / frame > max_wakeups) {
+        ESP_LOGW(TAG, "%"PRIu32" ms latency needs %"PRIu32" wakeups/s", latency_ms, rate / frame);
     }
 
+    *frame_num = frame;
+    *desc_num = MAX(2, MIN((total + frame / 2) / frame, BSP_I2S_DMA_DESC_MAX));
+}
+
+static esp_err_t bsp_audio_channels_init(const i2s_std_config_t *i2s_config, uint32_t desc_num, uint32_t frame_num)
+{
     /* Setup I2S peripheral */
     i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(CONFIG_BSP_I2S_NUM, I2S_ROLE_MASTER);
+    chan_cfg.dma_desc_num = desc_num;
+    chan_cfg.dma_frame_num = frame_num;
     chan_cfg.auto_clear = true; // Auto clear the legacy data in the DMA buffer
     ESP_ERROR_CHECK(i2s_new_channel(&chan_cfg, &i2s_tx_chan, &i2s_rx_chan));
 
     /* Setup I2S channels */
-    const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(22050);
-    const i2s_std_config_t *p_i2s_cfg = &std_cfg_default;
-    if (i2s_config != NULL) {
-        p_i2s_cfg = i2s_config;
-    }
-
     if (i2s_tx_chan != NULL) {
-        ESP_ERROR_CHECK(i2s_channel_init_std_mode(i2s_tx_chan, p_i2s_cfg));
+        ESP_ERROR_CHECK(i2s_channel_init_std_mode(i2s_tx_chan, i2s_config));
         ESP_ERROR_CHECK(i2s_channel_enable(i2s_tx_chan));
     }
 
     if (i2s_rx_chan != NULL) {
-        ESP_ERROR_CHECK(i2s_channel_init_std_mode(i2s_rx_chan, p_i2s_cfg));
+        ESP_ERROR_CHECK(i2s_channel_init_std_mode(i2s_rx_chan, i2s_config));
         ESP_ERROR_CHECK(i2s_channel_enable(i2s_rx_chan));
     }
 
@@ -216,10 +240,55 @@ esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config)
         .rx_handle = i2s_rx_chan,
     };
     i2s_data_if = audio_codec_new_i2s_data(&i2s_cfg);
+    i2s_dma_desc_num = desc_num;
+    i2s_dma_frame_num = frame_num;
+
+    return ESP_OK;
+}
+
+esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config)
+{
+    if (i2s_tx_chan && i2s_rx_chan) {
+        /* Audio was initialized before */
+        return ESP_OK;
+    }
+
+    /* Default DMA buffers of I2S driver */
+    const i2s_chan_config_t chan_cfg_default = I2S_CHANNEL_DEFAULT_CONFIG(CONFIG_BSP_I2S_NUM, I2S_ROLE_MASTER);
+    const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(22050);
+    return bsp_audio_channels_init(i2s_config ? i2s_config : &std_cfg_default, chan_cfg_default.dma_desc_num,
+                                   chan_cfg_default.dma_frame_num);
+}
+
+esp_err_t bsp_audio_init_with_latency(const bsp_audio_latency_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg && cfg->latency_ms > 0, ESP_ERR_INVALID_ARG, TAG, "invalid latency config");
+    if (i2s_tx_chan && i2s_rx_chan) {
+        /* Audio was initialized before */
+        return ESP_OK;
+    }
 
+    const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(22050);
+    const i2s_std_config_t *p_i2s_cfg = cfg->i2s_config ? cfg->i2s_config : &std_cfg_default;
+    ESP_RETURN_ON_FALSE(p_i2s_cfg->clk_cfg.sample_rate_hz > 0, ESP_ERR_INVALID_ARG, TAG, "invalid sample rate");
+
+    uint32_t desc_num;
+    uint32_t frame_num;
+    bsp_audio_dma_calc(p_i2s_cfg, cfg->latency_ms, cfg->max_wakeups, &desc_num, &frame_num);
+    ESP_RETURN_ON_ERROR(bsp_audio_channels_init(p_i2s_cfg, desc_num, frame_num), TAG, "I2S init failed");
+    ESP_LOGI(TAG, "I2S DMA %"PRIu32" x %"PRIu32" frames, latency %"PRIu32" us, %"PRIu32" wakeups/s", desc_num, frame_num,
+             bsp_audio_get_latency_us(p_i2s_cfg->clk_cfg.sample_rate_hz), p_i2s_cfg->clk_cfg.sample_rate_hz / frame_num);
     return ESP_OK;
 }
 
+uint32_t bsp_audio_get_latency_us(uint32_t sample_rate)
+{
+    if (sample_rate == 0 || !i2s_tx_chan) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)i2s_dma_desc_num * i2s_dma_frame_num * 1000000 / sample_rate);
+}
+
 esp_codec_dev_handle_t bsp_audio_codec_speaker_init(void)
 {
     if (i2s_data_if == NULL) {
@@ -746,6 +815,15 @@ lv_display_t *bsp_display_start_with_config(const bsp_display_cfg_t *cfg)
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_brightness_init());
 
     BSP_NULL_CHECK(disp = bsp_display_lcd_init(cfg), NULL);
+#if CONFIG_BSP_DISPLAY_LVGL_HW_JPEG && LVGL_VERSION_MAJOR >= 9
+    /* Not fatal, TJPGD decodes JPEG images without it (LVGL older than 9.2) */
+    lvgl_port_lock(0);
+    esp_err_t err = lvgl_port_jpeg_decoder_init();
+    lvgl_port_unlock();
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Hardware JPEG decoder not available, JPEG images are decoded by software");
+    }
+#endif
 #if !CONFIG_BSP_LCD_TYPE_HDMI
     BSP_NULL_CHECK(disp_indev = bsp_display_indev_init(disp), NULL);
 #endif
@@ -154,6 +154,39 @@ i2c_master_bus_handle_t bsp_i2c_get_handle(void);
  */
 esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config);
 
+/**
+ * @brief Audio buffering configuration of bsp_audio_init_with_latency()
+ */
+typedef struct {
+    const i2s_std_config_t *i2s_config; /*!< I2S configuration, NULL for default values (Mono, duplex, 16bit, 22050 Hz) */
+    uint32_t latency_ms;                /*!< Target buffering latency of each direction (TX and RX) in ms */
+    uint32_t max_wakeups;               /*!< CPU wakeup budget: DMA interrupts per second of each direction, 0 for no limit */
+} bsp_audio_latency_cfg_t;
+
+/**
+ * @brief Init audio with I2S DMA buffers derived from target latency
+ *
+ * The latency (number of DMA buffers multiplied by their frames) is split into as many buffers as
+ * the wakeup budget allows, e.g. 20 ms and 200 wakeups/s for voice, 200 ms and 20 wakeups/s for music.
+ * If both targets cannot be met, the latency wins. Sizes are derived at the sample rate of i2s_config.
+ *
+ * @note Same as bsp_audio_init(), the DMA buffers stay the same until the I2S channels are deleted.
+ * @param[in] cfg Buffering configuration
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   NULL pointer or invalid configuration
+ *      - Others                Same as bsp_audio_init()
+ */
+esp_err_t bsp_audio_init_with_latency(const bsp_audio_latency_cfg_t *cfg);
+
+/**
+ * @brief Get buffering latency of I2S DMA
+ *
+ * @param[in] sample_rate Current sample rate in Hz
+ * @return Latency of DMA buffers of one direction in microseconds, 0 if audio is not initialized
+ */
+uint32_t bsp_audio_get_latency_us(uint32_t sample_rate);
+
 /**
  * @brief Initialize speaker codec device
  *
@@ -294,6 +294,15 @@ esp_err_t bsp_touchpad_calibrate(bsp_touchpad_button_t tch_pad, float tch_thresh
     return ESP_OK;
 }
 
+esp_err_t bsp_touchpad_deinit(void)
+{
+    BSP_ERROR_CHECK_RETURN_ERR(touch_pad_intr_disable(TOUCH_PAD_INTR_MASK_ALL));
+    BSP_ERROR_CHECK_RETURN_ERR(touch_pad_fsm_stop());
+    BSP_ERROR_CHECK_RETURN_ERR(touch_pad_deinit());
+
+    return ESP_OK;
+}
+
 // Bit number used to represent command and parameter
 #define LCD_CMD_BITS           (8)
 #define LCD_PARAM_BITS         (8)
@@ -322,7 +331,8 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
         .lcd_cmd_bits = LCD_CMD_BITS,
         .lcd_param_bits = LCD_PARAM_BITS,
         .spi_mode = 0,
-        .trans_queue_depth = 10,
+        .trans_queue_depth = (config->trans_queue_depth > 0) ? config->trans_queue_depth :
+                             BSP_LCD_TRANS_QUEUE_DEPTH(BSP_LCD_H_RES * BSP_LCD_V_RES * BSP_LCD_BITS_PER_PIXEL / 8, config->max_transfer_sz),
     };
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)BSP_LCD_SPI_NUM, &io_config, ret_io), err, TAG, "New panel IO failed");
 
@@ -357,8 +367,11 @@ static lv_display_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
     assert(cfg != NULL);
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
+    const int max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t);
     const bsp_display_config_t bsp_disp_cfg = {
-        .max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t),
+        .max_transfer_sz = max_transfer_sz,
+        /* Whole draw buffer is queued at once, so the flush callback does not wait for the bus */
+        .trans_queue_depth = BSP_LCD_TRANS_QUEUE_DEPTH(cfg->buffer_size * sizeof(uint16_t), max_transfer_sz),
     };
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new(&bsp_disp_cfg, &panel_handle, &io_handle));
 
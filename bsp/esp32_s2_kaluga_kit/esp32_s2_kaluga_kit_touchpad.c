@@ -0,0 +1,282 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_sleep.h"
+
+#include "bsp/esp32_s2_kaluga_kit.h"
+
+static const char *TAG = "Kaluga-touch";
+
+/* Pads reported as buttons, guard ring only blocks the others */
+#define BSP_TOUCHPAD_BUTTON_MASK    (BIT(TOUCH_BUTTON_PLAY) | BIT(TOUCH_BUTTON_PHOTO) | BIT(TOUCH_BUTTON_NETWORK) | \
+                                     BIT(TOUCH_BUTTON_RECORD) | BIT(TOUCH_BUTTON_VOLUP) | BIT(TOUCH_BUTTON_VOLDOWN))
+#define BSP_TOUCHPAD_ALL_MASK       (BSP_TOUCHPAD_BUTTON_MASK | BIT(TOUCH_BUTTON_GUARD))
+
+typedef struct {
+    bsp_touchpad_config_t cfg;
+    volatile uint32_t   pressed_mask;           /* Touch state updated by the interrupt */
+    TickType_t          press_tick[TOUCH_PAD_MAX];
+    TaskHandle_t        task;
+    volatile bool       running;
+} bsp_touchpad_t;
+
+static bsp_touchpad_t *bsp_tp = NULL;
+
+static void bsp_touchpad_isr(void *arg)
+{
+    bsp_touchpad_t *tp = (bsp_touchpad_t *)arg;
+    BaseType_t need_yield = pdFALSE;
+
+    const uint32_t intr = touch_pad_read_intr_status_mask();
+    if (intr & (TOUCH_PAD_INTR_MASK_ACTIVE | TOUCH_PAD_INTR_MASK_INACTIVE)) {
+        tp->pressed_mask = touch_pad_get_status() & BSP_TOUCHPAD_BUTTON_MASK;
+        vTaskNotifyGiveFromISR(tp->task, &need_yield);
+    }
+    if (need_yield) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static esp_err_t bsp_touchpad_update_thresh(bsp_touchpad_t *tp, touch_pad_t pad)
+{
+    uint32_t benchmark = 0;
+    ESP_RETURN_ON_ERROR(touch_pad_read_benchmark(pad, &benchmark), TAG, "Read benchmark failed");
+    const uint32_t thresh = (uint32_t)((float)benchmark * tp->cfg.threshold);
+    ESP_RETURN_ON_ERROR(touch_pad_set_thresh(pad, thresh), TAG, "Set threshold failed");
+    if (pad == (touch_pad_t)tp->cfg.wakeup_pad) {
+        ESP_RETURN_ON_ERROR(touch_pad_sleep_set_threshold(pad, thresh), TAG, "Set sleep threshold failed");
+    }
+    return ESP_OK;
+}
+
+static void bsp_touchpad_task(void *arg)
+{
+    bsp_touchpad_t *tp = (bsp_touchpad_t *)arg;
+    const TickType_t stuck_ticks = pdMS_TO_TICKS(tp->cfg.stuck_timeout_ms);
+    uint32_t reported = 0;
+
+    while (tp->running) {
+        /* Sleep until next touch interrupt, or until the oldest touch gets stuck */
+        TickType_t wait = portMAX_DELAY;
+        const TickType_t now = xTaskGetTickCount();
+        if (reported && stuck_ticks) {
+            for (int pad = 0; pad < TOUCH_PAD_MAX; pad++) {
+                if (reported & BIT(pad)) {
+                    const TickType_t held = now - tp->press_tick[pad];
+                    const TickType_t left = (held < stuck_ticks) ? stuck_ticks - held : 0;
+                    wait = (left < wait) ? left : wait;
+                }
+            }
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+        if (!tp->running) {
+            break;
+        }
+
+        const uint32_t pressed = tp->pressed_mask;
+        const uint32_t changed = pressed ^ reported;
+        const TickType_t tick = xTaskGetTickCount();
+        for (int pad = 0; pad < TOUCH_PAD_MAX; pad++) {
+            if (!(changed & BIT(pad))) {
+                continue;
+            }
+            const bool is_pressed = pressed & BIT(pad);
+            if (is_pressed) {
+                tp->press_tick[pad] = tick;
+            } else {
+                /* Benchmark was tracked while released, keep the threshold relative to it */
+                bsp_touchpad_update_thresh(tp, pad);
+            }
+            if (tp->cfg.on_event) {
+                tp->cfg.on_event((bsp_touchpad_button_t)pad, is_pressed, tp->cfg.user_ctx);
+            }
+        }
+        reported = pressed;
+
+        if (reported && stuck_ticks) {
+            for (int pad = 0; pad < TOUCH_PAD_MAX; pad++) {
+                if ((reported & BIT(pad)) && (tick - tp->press_tick[pad]) >= stuck_ticks) {
+                    /* Release interrupt will follow, when benchmark catches up with the raw value */
+                    ESP_LOGW(TAG, "Pad %d touched for %"PRIu32" ms, resetting benchmark", pad, tp->cfg.stuck_timeout_ms);
+                    touch_pad_reset_benchmark(pad);
+                    tp->press_tick[pad] = tick;
+                }
+            }
+        }
+    }
+
+    tp->task = NULL;
+    vTaskDelete(NULL);
+}
+
+esp_err_t bsp_touchpad_start(const bsp_touchpad_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    bool isr_registered = false;
+
+    ESP_RETURN_ON_FALSE(config, ESP_ERR_INVALID_ARG, TAG, "Invalid config");
+    ESP_RETURN_ON_FALSE(config->threshold > 0.0f && config->threshold <= 1.0f, ESP_ERR_INVALID_ARG, TAG, "Invalid threshold");
+    ESP_RETURN_ON_FALSE(config->debounce_cnt <= 7, ESP_ERR_INVALID_ARG, TAG, "Invalid debounce count");
+    ESP_RETURN_ON_FALSE(config->wakeup_pad == 0 || (BIT(config->wakeup_pad) & BSP_TOUCHPAD_BUTTON_MASK),
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid wakeup pad");
+    ESP_RETURN_ON_FALSE(bsp_tp == NULL, ESP_ERR_INVALID_STATE, TAG, "Touch pad already started");
+
+    bsp_touchpad_t *tp = calloc(1, sizeof(bsp_touchpad_t));
+    ESP_RETURN_ON_FALSE(tp, ESP_ERR_NO_MEM, TAG, "Not enough memory");
+    tp->cfg = *config;
+    tp->running = true;
+
+    ESP_GOTO_ON_ERROR(touch_pad_init(), err, TAG, "Touch pad init failed");
+    for (int pad = 0; pad < TOUCH_PAD_MAX; pad++) {
+        if (BIT(pad) & BSP_TOUCHPAD_ALL_MASK) {
+            ESP_GOTO_ON_ERROR(touch_pad_config(pad), err, TAG, "Touch pad %d config failed", pad);
+        }
+    }
+    ESP_GOTO_ON_ERROR(touch_pad_set_measurement_interval(config->meas_interval), err, TAG, "Set interval failed");
+
+    /* Denoise channel (TOUCH_PAD_NUM0) measures common noise, which is subtracted from all pads */
+    const touch_pad_denoise_t denoise = {
+        .grade = TOUCH_PAD_DENOISE_BIT4,
+        .cap_level = TOUCH_PAD_DENOISE_CAP_L4,
+    };
+    ESP_GOTO_ON_ERROR(touch_pad_denoise_set_config(&denoise), err, TAG, "Denoise config failed");
+    ESP_GOTO_ON_ERROR(touch_pad_denoise_enable(), err, TAG, "Denoise enable failed");
+
+    const touch_pad_waterproof_t waterproof = {
+        .guard_ring_pad = (touch_pad_t)TOUCH_BUTTON_GUARD,
+        .shield_driver = TOUCH_PAD_SHIELD_DRV_L0,
+    };
+    ESP_GOTO_ON_ERROR(touch_pad_waterproof_set_config(&waterproof), err, TAG, "Waterproof config failed");
+    ESP_GOTO_ON_ERROR(touch_pad_waterproof_enable(), err, TAG, "Waterproof enable failed");
+
+    /* Hardware filter smooths the raw values and tracks benchmark of released pads */
+    const touch_filter_config_t filter = {
+        .mode = TOUCH_PAD_FILTER_IIR_16,
+        .debounce_cnt = config->debounce_cnt,
+        .noise_thr = 0,
+        .jitter_step = 4,
+        .smh_lvl = TOUCH_PAD_SMOOTH_IIR_2,
+    };
+    ESP_GOTO_ON_ERROR(touch_pad_filter_set_config(&filter), err, TAG, "Filter config failed");
+    ESP_GOTO_ON_ERROR(touch_pad_filter_enable(), err, TAG, "Filter enable failed");
+
+    if (config->wakeup_pad) {
+        ESP_GOTO_ON_ERROR(touch_pad_sleep_channel_enable((touch_pad_t)config->wakeup_pad, true), err, TAG, "Sleep channel failed");
+        ESP_GOTO_ON_ERROR(touch_pad_sleep_channel_enable_proximity((touch_pad_t)config->wakeup_pad, false), err, TAG, "Sleep channel failed");
+    }
+
+    BaseType_t res = xTaskCreate(bsp_touchpad_task, "touchpad", config->task.stack_size, tp, config->task.priority, &tp->task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create task failed");
+
+    ESP_GOTO_ON_ERROR(touch_pad_isr_register(bsp_touchpad_isr, tp, TOUCH_PAD_INTR_MASK_ACTIVE | TOUCH_PAD_INTR_MASK_INACTIVE),
+                      err, TAG, "Touch ISR register failed");
+    isr_registered = true;
+
+    ESP_GOTO_ON_ERROR(touch_pad_set_fsm_mode(TOUCH_FSM_MODE_TIMER), err, TAG, "Set FSM mode failed");
+    ESP_GOTO_ON_ERROR(touch_pad_fsm_start(), err, TAG, "FSM start failed");
+
+    /* Wait for filter to settle, thresholds are relative to benchmark */
+    vTaskDelay(pdMS_TO_TICKS(100));
+    for (int pad = 0; pad < TOUCH_PAD_MAX; pad++) {
+        if (BIT(pad) & BSP_TOUCHPAD_ALL_MASK) {
+            ESP_GOTO_ON_ERROR(bsp_touchpad_update_thresh(tp, pad), err, TAG, "Calibration failed");
+        }
+    }
+    ESP_GOTO_ON_ERROR(touch_pad_intr_enable(TOUCH_PAD_INTR_MASK_ACTIVE | TOUCH_PAD_INTR_MASK_INACTIVE), err, TAG, "Interrupt enable failed");
+
+    if (config->wakeup_pad) {
+        ESP_GOTO_ON_ERROR(esp_sleep_enable_touchpad_wakeup(), err, TAG, "Touch wakeup enable failed");
+    }
+
+    bsp_tp = tp;
+    return ESP_OK;
+
+err:
+    touch_pad_intr_disable(TOUCH_PAD_INTR_MASK_ALL);
+    if (isr_registered) {
+        touch_pad_isr_deregister(bsp_touchpad_isr, tp);
+    }
+    touch_pad_fsm_stop();
+    touch_pad_deinit();
+    if (tp->task) {
+        tp->running = false;
+        xTaskNotifyGive(tp->task);
+        while (tp->task) {
+            vTaskDelay(1);
+        }
+    }
+    free(tp);
+    return ret;
+}
+
+esp_err_t bsp_touchpad_stop(void)
+{
+    bsp_touchpad_t *tp = bsp_tp;
+    ESP_RETURN_ON_FALSE(tp, ESP_ERR_INVALID_STATE, TAG, "Touch pad not started");
+
+    if (tp->cfg.wakeup_pad) {
+        esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TOUCHPAD);
+        touch_pad_sleep_channel_enable((touch_pad_t)tp->cfg.wakeup_pad, false);
+    }
+    touch_pad_intr_disable(TOUCH_PAD_INTR_MASK_ALL);
+    touch_pad_isr_deregister(bsp_touchpad_isr, tp);
+    touch_pad_fsm_stop();
+    touch_pad_deinit();
+
+    tp->running = false;
+    xTaskNotifyGive(tp->task);
+    while (tp->task) {
+        vTaskDelay(1);
+    }
+    bsp_tp = NULL;
+    free(tp);
+    return ESP_OK;
+}
+
+bool bsp_touchpad_is_pressed(bsp_touchpad_button_t pad)
+{
+    bsp_touchpad_t *tp = bsp_tp;
+    return tp && (tp->pressed_mask & BIT(pad));
+}
+
+static esp_err_t bsp_touchpad_button_init(void *param)
+{
+    ESP_RETURN_ON_FALSE(bsp_tp, ESP_ERR_INVALID_STATE, TAG, "Call bsp_touchpad_start() first");
+    return ESP_OK;
+}
+
+static uint8_t bsp_touchpad_button_get_key_value(void *param)
+{
+    return bsp_touchpad_is_pressed((bsp_touchpad_button_t)(uintptr_t)param) ? 1 : 0;
+}
+
+static esp_err_t bsp_touchpad_button_deinit(void *param)
+{
+    return ESP_OK;
+}
+
+esp_err_t bsp_touchpad_get_button_config(bsp_touchpad_button_t pad, button_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(config, ESP_ERR_INVALID_ARG, TAG, "Invalid config");
+    ESP_RETURN_ON_FALSE((int)pad < TOUCH_PAD_MAX && (BIT(pad) & BSP_TOUCHPAD_BUTTON_MASK), ESP_ERR_INVALID_ARG, TAG, "Invalid pad");
+
+    *config = (button_config_t) {
+        .type = BUTTON_TYPE_CUSTOM,
+        .custom_button_config.active_level = 1,
+        .custom_button_config.button_custom_init = bsp_touchpad_button_init,
+        .custom_button_config.button_custom_get_key_value = bsp_touchpad_button_get_key_value,
+        .custom_button_config.button_custom_deinit = bsp_touchpad_button_deinit,
+        .custom_button_config.priv = (void *)(uintptr_t)pad,
+    };
+    return ESP_OK;
+}
@@ -502,6 +502,135 @@ esp_err_t bsp_touchpad_deinit(void);
  */
 esp_err_t bsp_touchpad_calibrate(bsp_touchpad_button_t tch_pad, float tch_threshold);
 
+/**************************************************************************************************
+ *
+ * TouchPad buttons
+ *
+ * Event driven alternative to bsp_touchpad_init(). The touch sensor scans the pads by its own timer,
+ * with hardware IIR filter, debounce and noise subtraction of the denoise channel. The CPU is woken
+ * only by the touch interrupt, there is no polling of the pads.
+ *
+ * The benchmark (baseline) of each pad is tracked by the touch sensor while the pad is released.
+ * Thresholds are refreshed from the benchmark on every release and a pad held longer than
+ * stuck_timeout_ms (e.g. by water or drift) gets its benchmark reset.
+ *
+ * Pads can be used as navigation buttons of esp_lvgl_port:
+ * \code{.c}
+ * bsp_touchpad_config_t tp_cfg = BSP_TOUCHPAD_CONFIG_DEFAULT();
+ * bsp_touchpad_start(&tp_cfg);
+ *
+ * button_config_t prev, next, enter;
+ * bsp_touchpad_get_button_config(TOUCH_BUTTON_VOLDOWN, &prev);
+ * bsp_touchpad_get_button_config(TOUCH_BUTTON_VOLUP, &next);
+ * bsp_touchpad_get_button_config(TOUCH_BUTTON_PLAY, &enter);
+ * const lvgl_port_nav_btns_cfg_t nav_cfg = {
+ *     .disp = disp,
+ *     .button_prev = &prev,
+ *     .button_next = &next,
+ *     .button_enter = &enter,
+ * };
+ * lvgl_port_add_navigation_buttons(&nav_cfg);
+ * \endcode
+ **************************************************************************************************/
+
+/**
+ * @brief Touch pad event callback
+ *
+ * @note Called from the touch pad task, not from the interrupt
+ *
+ * @param[in] pad      Touched or released pad
+ * @param[in] pressed  true: pad was touched, false: pad was released
+ * @param[in] user_ctx User context from bsp_touchpad_config_t
+ */
+typedef void (*bsp_touchpad_event_cb_t)(bsp_touchpad_button_t pad, bool pressed, void *user_ctx);
+
+/**
+ * @brief Touch pad buttons configuration
+ */
+typedef struct {
+    float threshold;                    /*!< Touch threshold as ratio of pad benchmark. Min.: 0, max.: 1 */
+    uint8_t debounce_cnt;               /*!< Measurements over threshold before touch is reported (0-7) */
+    uint16_t meas_interval;             /*!< Sleep between scans in RTC slow clock cycles (~90 kHz). Longer saves power */
+    uint32_t stuck_timeout_ms;          /*!< Reset benchmark of pad touched longer than this, 0 to disable */
+    bsp_touchpad_button_t wakeup_pad;   /*!< Pad scanned in light/deep sleep to wake up the CPU, 0 to disable */
+    bsp_touchpad_event_cb_t on_event;   /*!< Touch/release callback, can be NULL */
+    void *user_ctx;                     /*!< User context passed to on_event */
+    struct {
+        int priority;                   /*!< Touch pad task priority */
+        uint32_t stack_size;            /*!< Touch pad task stack size */
+    } task;
+} bsp_touchpad_config_t;
+
+/**
+ * @brief Default touch pad buttons configuration
+ */
+#define BSP_TOUCHPAD_CONFIG_DEFAULT()   \
+    {                                   \
+        .threshold = 0.1f,              \
+        .debounce_cnt = 2,              \
+        .meas_interval = 1000,          \
+        .stuck_timeout_ms = 10000,      \
+        .wakeup_pad = 0,                \
+        .on_event = NULL,               \
+        .user_ctx = NULL,               \
+        .task = {                       \
+            .priority = 5,              \
+            .stack_size = 3072,         \
+        },                              \
+    }
+
+/**
+ * @brief Start touch pad buttons
+ *
+ * Initializes touch sensor with filter, denoise and waterproof guard ring, calibrates thresholds
+ * and starts the task delivering touch events.
+ *
+ * @note When wakeup_pad is set, touch pad is enabled as wakeup source by esp_sleep_enable_touchpad_wakeup()
+ *
+ * @param[in] config Touch pad buttons configuration
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Invalid configuration
+ *      - ESP_ERR_INVALID_STATE Touch pad buttons already started
+ *      - ESP_ERR_NO_MEM        No memory
+ */
+esp_err_t bsp_touchpad_start(const bsp_touchpad_config_t *config);
+
+/**
+ * @brief Stop touch pad buttons
+ *
+ * Stops the task, touch sensor and disables touch pad wakeup.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Touch pad buttons not started
+ */
+esp_err_t bsp_touchpad_stop(void);
+
+/**
+ * @brief Get touch state of a pad
+ *
+ * @param[in] pad Touch pad from bsp_touchpad_button_t enum
+ * @return true when the pad is touched
+ */
+bool bsp_touchpad_is_pressed(bsp_touchpad_button_t pad);
+
+/**
+ * @brief Get button configuration of a touch pad
+ *
+ * Returned configuration of BUTTON_TYPE_CUSTOM reads touch state updated by the touch interrupt.
+ * It can be used with iot_button_create() or as navigation button of esp_lvgl_port.
+ *
+ * @note Touch pad buttons must be started by bsp_touchpad_start()
+ *
+ * @param[in]  pad    Touch pad from bsp_touchpad_button_t enum, except guard ring
+ * @param[out] config Button configuration
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Invalid pad or NULL pointer
+ */
+esp_err_t bsp_touchpad_get_button_config(bsp_touchpad_button_t pad, button_config_t *config);
+
 #ifdef __cplusplus
 }
 #endif
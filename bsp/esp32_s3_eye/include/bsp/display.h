@@ -37,12 +37,22 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Panel IO transactions needed to queue a flush of flush_sz bytes without waiting
+ *
+ * Color data of one esp_lcd_panel_draw_bitmap() is split into transactions of max_transfer_sz bytes.
+ * When the queue is shorter, the call blocks until the first transactions are sent.
+ */
+#define BSP_LCD_TRANS_QUEUE_DEPTH(flush_sz, max_transfer_sz) (((flush_sz) + (max_transfer_sz) - 1) / (max_transfer_sz))
+
 /**
  * @brief BSP display configuration structure
  *
  */
 typedef struct {
     int max_transfer_sz;    /*!< Maximum transfer size, in bytes. */
+    int trans_queue_depth;  /*!< Panel IO transaction queue depth, 0 to queue a full frame without waiting.
+                                 Use BSP_LCD_TRANS_QUEUE_DEPTH() for the size of the draw buffer */
 } bsp_display_config_t;
 
 /**
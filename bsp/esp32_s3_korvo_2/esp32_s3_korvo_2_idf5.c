@@ -4,7 +4,12 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <inttypes.h>
+#include <sys/param.h>
 #include "esp_err.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_adc/adc_cali_scheme.h"
 #include "esp_adc/adc_oneshot.h"
 #include "bsp/esp32_s3_korvo_2.h"
@@ -16,9 +21,33 @@ static const char *TAG = "S3-KORVO-2";
 static i2s_chan_handle_t i2s_tx_chan = NULL;
 static i2s_chan_handle_t i2s_rx_chan = NULL;
 static const audio_codec_data_if_t *i2s_data_if = NULL;  /* Codec data interface */
+static bool i2s_tdm_mode = false;  /* I2S initialized by bsp_audio_aec_init() */
 static adc_oneshot_unit_handle_t bsp_adc_handle = NULL;
 static adc_cali_handle_t bsp_adc_cali_handle; /* ADC1 calibration handle */
 
+#define BSP_BATTERY_ADC_CHANNEL         ADC_CHANNEL_5
+#define BSP_POWER_MONITOR_PERIOD_MS     (100)
+#define BSP_POWER_MONITOR_SAMPLE_MS     (10)
+
+typedef struct {
+    esp_timer_handle_t  timer;
+    uint32_t            samples;        /* Samples in one update period */
+    uint32_t            count;
+    uint32_t            sum;
+    bsp_power_monitor_cb_t threshold_cb;
+    void                *user_ctx;
+    volatile int        voltage_mv[BSP_POWER_MONITOR_MAX];
+    int                 threshold_mv[BSP_POWER_MONITOR_MAX];
+    int                 hysteresis_mv[BSP_POWER_MONITOR_MAX];
+    int8_t              above[BSP_POWER_MONITOR_MAX];   /* -1 is unknown */
+    portMUX_TYPE        lock;
+} bsp_power_monitor_t;
+
+static bsp_power_monitor_t bsp_power_monitor = {
+    .voltage_mv = {-1},
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
 /* Can be used for i2s_std_gpio_config_t and/or i2s_std_config_t initialization */
 #define BSP_I2S_GPIO_CFG       \
     {                          \
@@ -42,32 +71,74 @@ static adc_cali_handle_t bsp_adc_cali_handle; /* ADC1 calibration handle */
         .gpio_cfg = BSP_I2S_GPIO_CFG,                                                                 \
     }
 
-esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config)
+/* Used by bsp_audio_aec_init(), ES7210 sends the microphones and the reference in 4 slots of one frame */
+#define BSP_I2S_TDM_AEC_CFG(_sample_rate)                                                             \
+    {                                                                                                 \
+        .clk_cfg = I2S_TDM_CLK_DEFAULT_CONFIG(_sample_rate),                                          \
+        .slot_cfg = I2S_TDM_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO, \
+                    I2S_TDM_SLOT0 | I2S_TDM_SLOT1 | I2S_TDM_SLOT2 | I2S_TDM_SLOT3),                   \
+        .gpio_cfg = BSP_I2S_GPIO_CFG,                                                                 \
+    }
+
+/* DMA buffer of one descriptor is limited to 4092 bytes */
+#define BSP_I2S_DMA_BUFFER_MAX  (4092)
+#define BSP_I2S_DMA_DESC_MAX    (16)
+#define BSP_I2S_DMA_FRAME_MIN   (16)
+
+static uint32_t i2s_dma_desc_num = 0;
+static uint32_t i2s_dma_frame_num = 0;
+
+/* Derive DMA buffers from the latency target, the wakeup budget sets the minimal size of one buffer */
+static void bsp_audio_dma_calc(const i2s_std_config_t *i2s_config, uint32_t latency_ms, uint32_t max_wakeups,
+                               uint32_t *desc_num, uint32_t *frame_num)
 {
-    esp_err_t ret = ESP_FAIL;
-    if (i2s_tx_chan && i2s_rx_chan) {
-        /* Audio was initialized before */
-        return ESP_OK;
+    const uint32_t rate = i2s_config->clk_cfg.sample_rate_hz;
+    const uint32_t bits = (i2s_config->slot_cfg.data_bit_width == I2S_DATA_BIT_WIDTH_24BIT) ? 32 : i2s_config->slot_cfg.data_bit_width;
+    const uint32_t frame_bytes = ((i2s_config->slot_cfg.slot_mode == I2S_SLOT_MODE_MONO) ? 1 : 2) * bits / 8;
+    const uint32_t total = MAX(rate * latency_ms / 1000, 2 * BSP_I2S_DMA_FRAME_MIN);
+
+    uint32_t frame = (total + BSP_I2S_DMA_DESC_MAX - 1) / BSP_I2S_DMA_DESC_MAX;
+    if (max_wakeups > 0) {
+        frame = MAX(frame, (rate + max_wakeups - 1) / max_wakeups);
+    }
+    frame = MAX(frame, BSP_I2S_DMA_FRAME_MIN);
+    frame = MIN(frame, MIN(total / 2, BSP_I2S_DMA_BUFFER_MAX / frame_bytes)); // at least double buffering
+    if (max_wakeups > 0 && rate / frame > max_wakeups) {
+        ESP_LOGW(TAG, "%"PRIu32" ms latency needs %"PRIu32" wakeups/s", latency_ms, rate / frame);
     }
 
+    *frame_num = frame;
+    *desc_num = MAX(2, MIN((total + frame / 2) / frame, BSP_I2S_DMA_DESC_MAX));
+}
+
+/* Exactly one of std_cfg and tdm_cfg is set */
+static esp_err_t bsp_audio_channels_init(const i2s_std_config_t *std_cfg, const i2s_tdm_config_t *tdm_cfg,
+                                         uint32_t desc_num, uint32_t frame_num)
+{
+    esp_err_t ret = ESP_FAIL;
+
     /* Setup I2S peripheral */
     i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(CONFIG_BSP_I2S_NUM, I2S_ROLE_MASTER);
+    chan_cfg.dma_desc_num = desc_num;
+    chan_cfg.dma_frame_num = frame_num;
     chan_cfg.auto_clear = true; // Auto clear the legacy data in the DMA buffer
     BSP_ERROR_CHECK_RETURN_ERR(i2s_new_channel(&chan_cfg, &i2s_tx_chan, &i2s_rx_chan));
 
     /* Setup I2S channels */
-    const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(22050);
-    const i2s_std_config_t *p_i2s_cfg = &std_cfg_default;
-    if (i2s_config != NULL) {
-        p_i2s_cfg = i2s_config;
-    }
-
     if (i2s_tx_chan != NULL) {
-        ESP_GOTO_ON_ERROR(i2s_channel_init_std_mode(i2s_tx_chan, p_i2s_cfg), err, TAG, "I2S channel initialization failed");
+        if (tdm_cfg) {
+            ESP_GOTO_ON_ERROR(i2s_channel_init_tdm_mode(i2s_tx_chan, tdm_cfg), err, TAG, "I2S channel initialization failed");
+        } else {
+            ESP_GOTO_ON_ERROR(i2s_channel_init_std_mode(i2s_tx_chan, std_cfg), err, TAG, "I2S channel initialization failed");
+        }
         ESP_GOTO_ON_ERROR(i2s_channel_enable(i2s_tx_chan), err, TAG, "I2S enabling failed");
     }
     if (i2s_rx_chan != NULL) {
-        ESP_GOTO_ON_ERROR(i2s_channel_init_std_mode(i2s_rx_chan, p_i2s_cfg), err, TAG, "I2S channel initialization failed");
+        if (tdm_cfg) {
+            ESP_GOTO_ON_ERROR(i2s_channel_init_tdm_mode(i2s_rx_chan, tdm_cfg), err, TAG, "I2S channel initialization failed");
+        } else {
+            ESP_GOTO_ON_ERROR(i2s_channel_init_std_mode(i2s_rx_chan, std_cfg), err, TAG, "I2S channel initialization failed");
+        }
         ESP_GOTO_ON_ERROR(i2s_channel_enable(i2s_rx_chan), err, TAG, "I2S enabling failed");
     }
 
@@ -78,6 +149,9 @@ esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config)
     };
     i2s_data_if = audio_codec_new_i2s_data(&i2s_cfg);
     BSP_NULL_CHECK_GOTO(i2s_data_if, err);
+    i2s_tdm_mode = (tdm_cfg != NULL);
+    i2s_dma_desc_num = desc_num;
+    i2s_dma_frame_num = frame_num;
 
     return ESP_OK;
 
@@ -92,6 +166,59 @@ err:
     return ret;
 }
 
+esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config)
+{
+    if (i2s_tx_chan && i2s_rx_chan) {
+        /* Audio was initialized before */
+        return ESP_OK;
+    }
+
+    const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(22050);
+    return bsp_audio_channels_init(i2s_config ? i2s_config : &std_cfg_default, NULL,
+                                   CONFIG_BSP_I2S_DMA_DESC_NUM, CONFIG_BSP_I2S_DMA_FRAME_NUM);
+}
+
+esp_err_t bsp_audio_init_with_latency(const bsp_audio_latency_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg && cfg->latency_ms > 0, ESP_ERR_INVALID_ARG, TAG, "invalid latency config");
+    if (i2s_tx_chan && i2s_rx_chan) {
+        /* Audio was initialized before */
+        return ESP_OK;
+    }
+
+    const i2s_std_config_t std_cfg_default = BSP_I2S_DUPLEX_MONO_CFG(22050);
+    const i2s_std_config_t *p_i2s_cfg = cfg->i2s_config ? cfg->i2s_config : &std_cfg_default;
+    ESP_RETURN_ON_FALSE(p_i2s_cfg->clk_cfg.sample_rate_hz > 0, ESP_ERR_INVALID_ARG, TAG, "invalid sample rate");
+
+    uint32_t desc_num;
+    uint32_t frame_num;
+    bsp_audio_dma_calc(p_i2s_cfg, cfg->latency_ms, cfg->max_wakeups, &desc_num, &frame_num);
+    ESP_RETURN_ON_ERROR(bsp_audio_channels_init(p_i2s_cfg, NULL, desc_num, frame_num), TAG, "I2S init failed");
+    ESP_LOGI(TAG, "I2S DMA %"PRIu32" x %"PRIu32" frames, latency %"PRIu32" us, %"PRIu32" wakeups/s", desc_num, frame_num,
+             bsp_audio_get_latency_us(p_i2s_cfg->clk_cfg.sample_rate_hz), p_i2s_cfg->clk_cfg.sample_rate_hz / frame_num);
+    return ESP_OK;
+}
+
+uint32_t bsp_audio_get_latency_us(uint32_t sample_rate)
+{
+    if (sample_rate == 0 || !i2s_tx_chan) {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)i2s_dma_desc_num * i2s_dma_frame_num * 1000000 / sample_rate);
+}
+
+esp_err_t bsp_audio_aec_init(uint32_t sample_rate)
+{
+    if (i2s_tx_chan && i2s_rx_chan) {
+        /* Audio was initialized before */
+        ESP_RETURN_ON_FALSE(i2s_tdm_mode, ESP_ERR_INVALID_STATE, TAG, "Audio initialized in standard mode");
+        return ESP_OK;
+    }
+
+    const i2s_tdm_config_t tdm_cfg = BSP_I2S_TDM_AEC_CFG(sample_rate);
+    return bsp_audio_channels_init(NULL, &tdm_cfg, CONFIG_BSP_I2S_DMA_DESC_NUM, CONFIG_BSP_I2S_DMA_FRAME_NUM);
+}
+
 const audio_codec_data_if_t *bsp_audio_get_codec_itf(void)
 {
     return i2s_data_if;
@@ -128,7 +255,7 @@ esp_err_t bsp_voltage_init(void)
         .bitwidth = ADC_BITWIDTH_DEFAULT,
         .atten = ADC_ATTEN_DB_11,
     };
-    BSP_ERROR_CHECK_RETURN_ERR(adc_oneshot_config_channel(bsp_adc_handle, ADC_CHANNEL_5, &config));
+    BSP_ERROR_CHECK_RETURN_ERR(adc_oneshot_config_channel(bsp_adc_handle, BSP_BATTERY_ADC_CHANNEL, &config));
 
     /* ESP32-S3 supports Curve Fitting calibration scheme */
     const adc_cali_curve_fitting_config_t cali_config = {
@@ -144,8 +271,134 @@ int bsp_voltage_battery_get(void)
 {
     int voltage, adc_raw;
 
+    if (bsp_power_monitor.timer) {
+        return bsp_power_monitor.voltage_mv[BSP_POWER_MONITOR_BATTERY];
+    }
     assert(bsp_adc_handle);
-    BSP_ERROR_CHECK(adc_oneshot_read(bsp_adc_handle, ADC_CHANNEL_5, &adc_raw), -1);
+    BSP_ERROR_CHECK(adc_oneshot_read(bsp_adc_handle, BSP_BATTERY_ADC_CHANNEL, &adc_raw), -1);
     BSP_ERROR_CHECK(adc_cali_raw_to_voltage(bsp_adc_cali_handle, adc_raw, &voltage), -1);
     return voltage * BSP_BATTERY_VOLTAGE_DIV;
 }
+
+static void bsp_power_monitor_update(bsp_power_monitor_t *mon, bsp_power_monitor_channel_t channel, int voltage_mv)
+{
+    bool notify = false;
+    bool above = false;
+
+    mon->voltage_mv[channel] = voltage_mv;
+    portENTER_CRITICAL(&mon->lock);
+    const int threshold = mon->threshold_mv[channel];
+    const int hysteresis = mon->hysteresis_mv[channel];
+    if (threshold > 0) {
+        if (mon->above[channel] != 1 && voltage_mv > threshold + hysteresis) {
+            mon->above[channel] = 1;
+            notify = true;
+        } else if (mon->above[channel] != 0 && voltage_mv < threshold - hysteresis) {
+            mon->above[channel] = 0;
+            notify = true;
+        } else if (mon->above[channel] < 0) {
+            /* First value inside of the hysteresis */
+            mon->above[channel] = (voltage_mv >= threshold);
+            notify = true;
+        }
+        above = (mon->above[channel] == 1);
+    }
+    portEXIT_CRITICAL(&mon->lock);
+
+    if (notify && mon->threshold_cb) {
+        mon->threshold_cb(channel, voltage_mv, above, mon->user_ctx);
+    }
+}
+
+/* Called from esp_timer task, like the ADC buttons, so the oneshot reads do not collide */
+static void bsp_power_monitor_sample(void *arg)
+{
+    bsp_power_monitor_t *mon = (bsp_power_monitor_t *)arg;
+    int adc_raw = 0;
+
+    if (adc_oneshot_read(bsp_adc_handle, BSP_BATTERY_ADC_CHANNEL, &adc_raw) == ESP_OK) {
+        mon->sum += adc_raw;
+        mon->count++;
+    }
+    if (mon->count < mon->samples) {
+        return;
+    }
+
+    /* Calibration curve is applied once per update to the average */
+    int voltage = 0;
+    const int raw = (mon->sum + mon->count / 2) / mon->count;
+    mon->sum = 0;
+    mon->count = 0;
+    if (adc_cali_raw_to_voltage(bsp_adc_cali_handle, raw, &voltage) == ESP_OK) {
+        bsp_power_monitor_update(mon, BSP_POWER_MONITOR_BATTERY, voltage * BSP_BATTERY_VOLTAGE_DIV);
+    }
+}
+
+esp_err_t bsp_power_monitor_start(const bsp_power_monitor_cfg_t *cfg)
+{
+    esp_err_t ret = ESP_OK;
+    bsp_power_monitor_t *mon = &bsp_power_monitor;
+    ESP_RETURN_ON_FALSE(mon->timer == NULL, ESP_ERR_INVALID_STATE, TAG, "Power monitor is already running");
+
+    if (bsp_adc_cali_handle == NULL) {
+        ESP_RETURN_ON_ERROR(bsp_voltage_init(), TAG, "Voltage measurement init failed");
+    }
+
+    const uint32_t period_ms = (cfg && cfg->update_period_ms ? cfg->update_period_ms : BSP_POWER_MONITOR_PERIOD_MS);
+    mon->samples = (period_ms > BSP_POWER_MONITOR_SAMPLE_MS ? period_ms / BSP_POWER_MONITOR_SAMPLE_MS : 1);
+    mon->count = 0;
+    mon->sum = 0;
+    mon->threshold_cb = (cfg ? cfg->threshold_cb : NULL);
+    mon->user_ctx = (cfg ? cfg->user_ctx : NULL);
+    for (int ch = 0; ch < BSP_POWER_MONITOR_MAX; ch++) {
+        mon->voltage_mv[ch] = -1;
+        mon->above[ch] = -1;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = bsp_power_monitor_sample,
+        .arg = mon,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "power_mon",
+    };
+    ESP_RETURN_ON_ERROR(esp_timer_create(&timer_args, &mon->timer), TAG, "Create power monitor timer fail!");
+    ESP_GOTO_ON_ERROR(esp_timer_start_periodic(mon->timer, BSP_POWER_MONITOR_SAMPLE_MS * 1000), err, TAG, "Start power monitor timer fail!");
+    return ESP_OK;
+
+err:
+    esp_timer_delete(mon->timer);
+    mon->timer = NULL;
+    return ret;
+}
+
+esp_err_t bsp_power_monitor_stop(void)
+{
+    bsp_power_monitor_t *mon = &bsp_power_monitor;
+    ESP_RETURN_ON_FALSE(mon->timer, ESP_ERR_INVALID_STATE, TAG, "Power monitor is not running");
+
+    esp_timer_stop(mon->timer);
+    esp_timer_delete(mon->timer);
+    mon->timer = NULL;
+    return ESP_OK;
+}
+
+int bsp_power_monitor_get(bsp_power_monitor_channel_t channel)
+{
+    if (channel >= BSP_POWER_MONITOR_MAX) {
+        return -1;
+    }
+    return bsp_power_monitor.voltage_mv[channel];
+}
+
+esp_err_t bsp_power_monitor_set_threshold(bsp_power_monitor_channel_t channel, int threshold_mv, int hysteresis_mv)
+{
+    bsp_power_monitor_t *mon = &bsp_power_monitor;
+    ESP_RETURN_ON_FALSE(channel < BSP_POWER_MONITOR_MAX && threshold_mv >= 0 && hysteresis_mv >= 0, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    portENTER_CRITICAL(&mon->lock);
+    mon->threshold_mv[channel] = threshold_mv;
+    mon->hysteresis_mv[channel] = hysteresis_mv;
+    mon->above[channel] = -1;
+    portEXIT_CRITICAL(&mon->lock);
+    return ESP_OK;
+}
@@ -211,6 +211,39 @@ esp_err_t bsp_iot_button_create(button_handle_t btn_array[], int *btn_cnt, int b
  */
 esp_err_t bsp_audio_init(const i2s_std_config_t *i2s_config);
 
+/**
+ * @brief Audio buffering configuration of bsp_audio_init_with_latency()
+ */
+typedef struct {
+    const i2s_std_config_t *i2s_config; /*!< I2S configuration, NULL for default values (Mono, duplex, 16bit, 22050 Hz) */
+    uint32_t latency_ms;                /*!< Target buffering latency of each direction (TX and RX) in ms */
+    uint32_t max_wakeups;               /*!< CPU wakeup budget: DMA interrupts per second of each direction, 0 for no limit */
+} bsp_audio_latency_cfg_t;
+
+/**
+ * @brief Init audio with I2S DMA buffers derived from target latency
+ *
+ * The latency (number of DMA buffers multiplied by their frames) is split into as many buffers as
+ * the wakeup budget allows, e.g. 20 ms and 200 wakeups/s for voice, 200 ms and 20 wakeups/s for music.
+ * If both targets cannot be met, the latency wins. Sizes are derived at the sample rate of i2s_config.
+ *
+ * @note Same as bsp_audio_init(), the DMA buffers stay the same until the I2S channels are deleted.
+ * @param[in] cfg Buffering configuration
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   NULL pointer or invalid configuration
+ *      - Others                Same as bsp_audio_init()
+ */
+esp_err_t bsp_audio_init_with_latency(const bsp_audio_latency_cfg_t *cfg);
+
+/**
+ * @brief Get buffering latency of I2S DMA
+ *
+ * @param[in] sample_rate Current sample rate in Hz
+ * @return Latency of DMA buffers of one direction in microseconds, 0 if audio is not initialized
+ */
+uint32_t bsp_audio_get_latency_us(uint32_t sample_rate);
+
 /**
  * @brief Get codec I2S interface (initialized in bsp_audio_init)
  *
@@ -233,6 +266,49 @@ esp_codec_dev_handle_t bsp_audio_codec_speaker_init(void);
  */
 esp_codec_dev_handle_t bsp_audio_codec_microphone_init(void);
 
+/* Echo cancellation (AEC) capture, see bsp_audio_aec_init() */
+#define BSP_AUDIO_AEC_CHANNELS      (4)       /*!< Captured channels (TDM slots of ES7210) */
+#define BSP_AUDIO_AEC_REF_CHANNEL   (3)       /*!< Channel of playback reference (hardware loopback of the speaker signal) */
+#define BSP_AUDIO_AEC_INPUT_FORMAT  "MMNR"  /*!< Channel layout for esp-sr AFE: M - microphone, R - reference, N - unused */
+
+/**
+ * @brief Init audio for echo cancellation (AEC)
+ *
+ * I2S is configured in TDM mode with 4 slots of 16 bits for both directions, they share the bit and frame clocks.
+ * ES7210 captures microphones and the playback reference (loopback of the speaker signal) by the same ADC clock
+ * in one TDM frame, so the reference is sample-aligned with the microphone data and the latency between
+ * playback and reference is constant. No software delay estimation or alignment buffers are needed.
+ *
+ * @note Call it instead of bsp_audio_init(), before bsp_audio_codec_speaker_init() and bsp_audio_codec_microphone_aec_init().
+ *       Open both codec devices with the same sample rate, 16 bits per sample and BSP_AUDIO_AEC_CHANNELS channels,
+ *       so the slot configuration of I2S stays the same. ES8311 plays channel 0 of the written frames.
+ * @param[in] sample_rate Sample rate in Hz, e.g. 16000 for voice
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Audio was already initialized in standard mode by bsp_audio_init()
+ *      - Others                I2S channel initialization failed
+ */
+esp_err_t bsp_audio_aec_init(uint32_t sample_rate);
+
+/**
+ * @brief Initialize microphone codec device with playback reference
+ *
+ * All 4 inputs of ES7210 are captured in TDM, open the device with BSP_AUDIO_AEC_CHANNELS channels:
+ * \code{.c}
+ * esp_codec_dev_sample_info_t fs = {
+ *     .sample_rate = 16000,
+ *     .channel = BSP_AUDIO_AEC_CHANNELS,
+ *     .bits_per_sample = 16,
+ * };
+ * esp_codec_dev_open(mic_codec_dev, &fs);
+ * esp_codec_dev_read(mic_codec_dev, frames, frames_bytes); // reference is at BSP_AUDIO_AEC_REF_CHANNEL of each frame
+ * \endcode
+ *
+ * @note I2S is initialized by bsp_audio_aec_init() at 16 kHz, if it was not initialized before.
+ * @return Pointer to codec device handle or NULL when error occurred
+ */
+esp_codec_dev_handle_t bsp_audio_codec_microphone_aec_init(void);
+
 /**************************************************************************************************
  *
  * I2C interface
@@ -589,11 +665,88 @@ esp_err_t bsp_voltage_init(void);
 /**
  * @brief Get battery voltage
  *
- * @note bsp_voltage_init() must be called first
+ * @note bsp_voltage_init() must be called first. When the power monitor is running, its latest value is returned.
  * @return Resulting voltage in [mV] or -1 on error
  */
 int bsp_voltage_battery_get(void);
 
+/**
+ * @brief Voltages measured by power monitor
+ */
+typedef enum {
+    BSP_POWER_MONITOR_BATTERY,
+    BSP_POWER_MONITOR_MAX,
+} bsp_power_monitor_channel_t;
+
+/**
+ * @brief Callback called from esp_timer task, when the voltage crosses the threshold
+ *
+ * @param channel       measured voltage
+ * @param voltage_mv    voltage in [mV]
+ * @param above         the voltage is above the threshold
+ * @param user_ctx      user context from configuration
+ */
+typedef void (*bsp_power_monitor_cb_t)(bsp_power_monitor_channel_t channel, int voltage_mv, bool above, void *user_ctx);
+
+/**
+ * @brief Power monitor configuration
+ */
+typedef struct {
+    uint32_t update_period_ms;          /*!< Period of voltage updates (0: 100 ms) */
+    bsp_power_monitor_cb_t threshold_cb; /*!< Threshold callback (optional) */
+    void *user_ctx;                     /*!< User context of the callback */
+} bsp_power_monitor_cfg_t;
+
+/**
+ * @brief Start power monitor
+ *
+ * Battery voltage is sampled every 10 ms by periodic esp_timer and averaged in each update period.
+ * The latest voltage is read by bsp_power_monitor_get() without ADC access.
+ *
+ * @note ADC1 is sampled in oneshot mode, because ADC buttons share ADC1 oneshot unit (continuous mode would block their reads).
+ *       bsp_voltage_init() is called, when it was not called before.
+ *
+ * @param[in] cfg   configuration (NULL: default)
+ * @return
+ *     - ESP_OK                 On success
+ *     - ESP_ERR_INVALID_STATE  Power monitor is already running
+ *     - ESP_ERR_NO_MEM         No memory
+ *     - ESP_ERR_NOT_SUPPORTED  ADC calibration scheme required eFuse bits not burnt
+ */
+esp_err_t bsp_power_monitor_start(const bsp_power_monitor_cfg_t *cfg);
+
+/**
+ * @brief Stop power monitor
+ *
+ * @return
+ *     - ESP_OK                 On success
+ *     - ESP_ERR_INVALID_STATE  Power monitor is not running
+ */
+esp_err_t bsp_power_monitor_stop(void);
+
+/**
+ * @brief Get the latest voltage of power monitor
+ *
+ * @param channel   measured voltage
+ * @return Voltage in [mV] or -1, if there is no value yet
+ */
+int bsp_power_monitor_get(bsp_power_monitor_channel_t channel);
+
+/**
+ * @brief Set voltage threshold of power monitor
+ *
+ * The threshold callback is called with the first value and then, when the voltage gets above threshold + hysteresis
+ * or below threshold - hysteresis.
+ *
+ * @param channel       measured voltage
+ * @param threshold_mv  threshold in [mV] (0: disabled)
+ * @param hysteresis_mv hysteresis in [mV]
+ * @return
+ *     - ESP_OK                 On success
+ *     - ESP_ERR_INVALID_ARG    Invalid channel or negative values
+ */
+esp_err_t bsp_power_monitor_set_threshold(bsp_power_monitor_channel_t channel, int threshold_mv, int hysteresis_mv);
+
 #ifdef __cplusplus
 }
 #endif
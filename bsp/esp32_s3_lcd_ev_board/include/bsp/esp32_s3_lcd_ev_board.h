@@ -417,6 +417,28 @@ uint16_t bsp_display_get_h_res(void);
  */
 uint16_t bsp_display_get_v_res(void);
 
+/**
+ * @brief Detect the sub-board again and switch the started display to it
+ *
+ * The LCD panel and touch of the previous sub-board are deleted and the ones of the detected sub-board are created.
+ * The LVGL display is not removed: its resolution and draw buffers are changed by `lvgl_port_disp_reconfigure()`,
+ * so screens and objects created before are kept and laid out for the new resolution. It is meant for test fixtures
+ * which replace the sub-boards, without restart of the application.
+ *
+ * @note  Display must be already started by calling `bsp_display_start()`. Do not hold the display lock.
+ * @note  The input device is replaced, get the new one by `bsp_display_get_input_dev()`.
+ * @note  Only LVGL 9. `CONFIG_BSP_DISPLAY_LVGL_PAN` is not supported. With a fixed `CONFIG_BSP_LCD_SUB_BOARD_TYPE`,
+ *        only the same sub-board is detected.
+ *
+ * @return
+ *      - ESP_OK:                Success
+ *      - ESP_ERR_INVALID_STATE: Display is not started
+ *      - ESP_ERR_NOT_FOUND:     No sub-board detected, the previous display is kept
+ *      - ESP_ERR_NOT_SUPPORTED: LVGL 8 or `CONFIG_BSP_DISPLAY_LVGL_PAN`
+ *      - Others:                New panel or touch cannot be created, the display cannot be used
+ */
+esp_err_t bsp_display_reconfigure(void);
+
 /**************************************************************************************************
  *
  * Button Interface
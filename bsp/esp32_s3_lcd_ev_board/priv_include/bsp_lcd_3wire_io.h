@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_io_expander.h"
+#include "esp_lcd_panel_io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Configuration of 3-wire SPI panel IO (9-bit frames: D/C bit and 8 data bits, only for initialization commands)
+ */
+typedef struct {
+    esp_io_expander_handle_t io_expander;   /*!< IO expander of all lines (NULL: all lines are GPIOs) */
+    uint32_t cs;                            /*!< CS line: expander pin mask or GPIO number */
+    uint32_t scl;                           /*!< SCL line: expander pin mask or GPIO number */
+    uint32_t sda;                           /*!< SDA line: expander pin mask or GPIO number */
+    uint8_t scl_active_falling;             /*!< Data is sampled on falling edge of SCL (otherwise on rising edge) */
+} bsp_lcd_3wire_io_config_t;
+
+/**
+ * @brief Create 3-wire SPI panel IO
+ *
+ * Every command frame (command with its parameters) is converted to a sequence of line levels, which is sent
+ * by `esp_io_expander_write_sequence` (a few I2C writes per frame), or toggled directly on GPIOs.
+ *
+ * @param config: IO configuration
+ * @param ret_io: Output panel IO handle
+ *
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    parameter error
+ *      - ESP_ERR_NO_MEM         not enough memory
+ */
+esp_err_t bsp_lcd_new_panel_io_3wire(const bsp_lcd_3wire_io_config_t *config, esp_lcd_panel_io_handle_t *ret_io);
+
+#ifdef __cplusplus
+}
+#endif
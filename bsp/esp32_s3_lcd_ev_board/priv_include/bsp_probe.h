@@ -41,6 +41,18 @@ bsp_module_type_t bsp_probe_module_type(void);
  */
 bsp_sub_board_type_t bsp_probe_sub_board_type(void);
 
+/**
+ * @brief Detect sub-board type again (e.g. after a sub-board was replaced)
+ *
+ * @note The previous type is kept, when no sub-board is detected
+ *
+ * @return
+ *      - SUB_BOARD_TYPE_UNKNOW: No sub-board detected
+ *      - SUB_BOARD_TYPE_2_480_480: Sub-board 2 with 480x480 LCD (GC9503), Touch (FT5x06)
+ *      - SUB_BOARD_TYPE_3_800_480: Sub-board 3 with 800x480 LCD (ST7262), Touch (GT1151)
+ */
+bsp_sub_board_type_t bsp_probe_sub_board_redetect(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,220 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include "driver/gpio.h"
+#include "esp_bit_defs.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_lcd_panel_io_interface.h"
+#include "esp_rom_sys.h"
+
+#include "bsp_lcd_3wire_io.h"
+
+#define LEVELS_LEN          (64)    /* Line levels sent at once (3 bytes of frame) */
+#define GPIO_HALF_CLK_US    (1)     /* Half period of SCL on GPIOs */
+
+/* Lines in the levels of GPIO path */
+#define GPIO_LINE_CS        BIT(0)
+#define GPIO_LINE_SCL       BIT(1)
+#define GPIO_LINE_SDA       BIT(2)
+
+typedef struct {
+    esp_lcd_panel_io_t base;
+    esp_io_expander_handle_t io_expander;
+    uint32_t cs_gpio;               /* GPIO numbers (without IO expander) */
+    uint32_t scl_gpio;
+    uint32_t sda_gpio;
+    uint32_t cs_mask;               /* Line bits in levels (expander pins or GPIO_LINE_x) */
+    uint32_t scl_mask;
+    uint32_t sda_mask;
+    uint32_t last_level;            /* Level of lines at the end of levels */
+    uint8_t scl_active_falling;
+    size_t levels_cnt;
+    uint32_t levels[LEVELS_LEN];
+} bsp_lcd_3wire_io_t;
+
+static const char *TAG = "bsp_3wire_io";
+
+static esp_err_t panel_io_3wire_tx_param(esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size);
+static esp_err_t panel_io_3wire_rx_param(esp_lcd_panel_io_t *io, int lcd_cmd, void *param, size_t param_size);
+static esp_err_t panel_io_3wire_tx_color(esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size);
+static esp_err_t panel_io_3wire_register_event_callbacks(esp_lcd_panel_io_t *io, const esp_lcd_panel_io_callbacks_t *cbs, void *user_ctx);
+static esp_err_t panel_io_3wire_del(esp_lcd_panel_io_t *io);
+static esp_err_t levels_add(bsp_lcd_3wire_io_t *io_3wire, uint32_t level);
+static esp_err_t levels_add_byte(bsp_lcd_3wire_io_t *io_3wire, bool dc, uint8_t data);
+static esp_err_t levels_flush(bsp_lcd_3wire_io_t *io_3wire);
+
+esp_err_t bsp_lcd_new_panel_io_3wire(const bsp_lcd_3wire_io_config_t *config, esp_lcd_panel_io_handle_t *ret_io)
+{
+    ESP_RETURN_ON_FALSE(config && ret_io, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_err_t ret = ESP_OK;
+    bsp_lcd_3wire_io_t *io_3wire = calloc(1, sizeof(bsp_lcd_3wire_io_t));
+    ESP_RETURN_ON_FALSE(io_3wire, ESP_ERR_NO_MEM, TAG, "no mem for 3-wire panel io");
+
+    io_3wire->io_expander = config->io_expander;
+    io_3wire->scl_active_falling = config->scl_active_falling;
+    if (config->io_expander) {
+        io_3wire->cs_mask = config->cs;
+        io_3wire->scl_mask = config->scl;
+        io_3wire->sda_mask = config->sda;
+        const uint32_t lines = config->cs | config->scl | config->sda;
+        ESP_GOTO_ON_ERROR(esp_io_expander_set_dir(config->io_expander, lines, IO_EXPANDER_OUTPUT), err, TAG, "set expander dir failed");
+    } else {
+        io_3wire->cs_gpio = config->cs;
+        io_3wire->scl_gpio = config->scl;
+        io_3wire->sda_gpio = config->sda;
+        io_3wire->cs_mask = GPIO_LINE_CS;
+        io_3wire->scl_mask = GPIO_LINE_SCL;
+        io_3wire->sda_mask = GPIO_LINE_SDA;
+        const gpio_config_t io_conf = {
+            .pin_bit_mask = BIT64(config->cs) | BIT64(config->scl) | BIT64(config->sda),
+            .mode = GPIO_MODE_OUTPUT,
+        };
+        ESP_GOTO_ON_ERROR(gpio_config(&io_conf), err, TAG, "configure GPIO failed");
+    }
+
+    /* Idle: CS inactive, SCL low */
+    io_3wire->last_level = ~io_3wire->cs_mask;
+    ESP_GOTO_ON_ERROR(levels_add(io_3wire, io_3wire->cs_mask), err, TAG, "set idle level failed");
+    ESP_GOTO_ON_ERROR(levels_flush(io_3wire), err, TAG, "set idle level failed");
+
+    io_3wire->base.rx_param = panel_io_3wire_rx_param;
+    io_3wire->base.tx_param = panel_io_3wire_tx_param;
+    io_3wire->base.tx_color = panel_io_3wire_tx_color;
+    io_3wire->base.register_event_callbacks = panel_io_3wire_register_event_callbacks;
+    io_3wire->base.del = panel_io_3wire_del;
+
+    *ret_io = &io_3wire->base;
+    return ESP_OK;
+
+err:
+    free(io_3wire);
+    return ret;
+}
+
+static esp_err_t panel_io_3wire_tx_param(esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size)
+{
+    bsp_lcd_3wire_io_t *io_3wire = __containerof(io, bsp_lcd_3wire_io_t, base);
+    const uint8_t *data = param;
+
+    ESP_RETURN_ON_FALSE(param || !param_size, ESP_ERR_INVALID_ARG, TAG, "invalid param");
+
+    /* Whole frame under one CS: command (D/C 0) and parameters (D/C 1) */
+    ESP_RETURN_ON_ERROR(levels_add(io_3wire, 0), TAG, "add levels failed");
+    if (lcd_cmd >= 0) {
+        ESP_RETURN_ON_ERROR(levels_add_byte(io_3wire, false, lcd_cmd), TAG, "add levels failed");
+    }
+    for (size_t i = 0; i < param_size; i++) {
+        ESP_RETURN_ON_ERROR(levels_add_byte(io_3wire, true, data[i]), TAG, "add levels failed");
+    }
+    ESP_RETURN_ON_ERROR(levels_add(io_3wire, 0), TAG, "add levels failed");
+    ESP_RETURN_ON_ERROR(levels_add(io_3wire, io_3wire->cs_mask), TAG, "add levels failed");
+
+    return levels_flush(io_3wire);
+}
+
+static esp_err_t panel_io_3wire_rx_param(esp_lcd_panel_io_t *io, int lcd_cmd, void *param, size_t param_size)
+{
+    ESP_LOGE(TAG, "reading is not supported");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static esp_err_t panel_io_3wire_tx_color(esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size)
+{
+    ESP_LOGE(TAG, "color data is not supported, use RGB interface");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static esp_err_t panel_io_3wire_register_event_callbacks(esp_lcd_panel_io_t *io, const esp_lcd_panel_io_callbacks_t *cbs, void *user_ctx)
+{
+    /* Transfers are blocking, no color transfer is done */
+    return ESP_OK;
+}
+
+static esp_err_t panel_io_3wire_del(esp_lcd_panel_io_t *io)
+{
+    bsp_lcd_3wire_io_t *io_3wire = __containerof(io, bsp_lcd_3wire_io_t, base);
+
+    /* Lines stay configured as outputs with inactive CS */
+    free(io_3wire);
+    return ESP_OK;
+}
+
+/**
+ * @brief Add levels of one 9-bit frame (MSB first)
+ */
+static esp_err_t levels_add_byte(bsp_lcd_3wire_io_t *io_3wire, bool dc, uint8_t data)
+{
+    const uint16_t frame = (dc ? 0x100 : 0) | data;
+
+    for (int bit = 8; bit >= 0; bit--) {
+        const uint32_t sda = (frame & BIT(bit)) ? io_3wire->sda_mask : 0;
+        /* Data is changed on the first edge and sampled on the second one */
+        if (io_3wire->scl_active_falling) {
+            ESP_RETURN_ON_ERROR(levels_add(io_3wire, sda | io_3wire->scl_mask), TAG, "add level failed");
+            ESP_RETURN_ON_ERROR(levels_add(io_3wire, sda), TAG, "add level failed");
+        } else {
+            ESP_RETURN_ON_ERROR(levels_add(io_3wire, sda), TAG, "add level failed");
+            ESP_RETURN_ON_ERROR(levels_add(io_3wire, sda | io_3wire->scl_mask), TAG, "add level failed");
+        }
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t levels_add(bsp_lcd_3wire_io_t *io_3wire, uint32_t level)
+{
+    if (io_3wire->levels_cnt == LEVELS_LEN) {
+        ESP_RETURN_ON_ERROR(levels_flush(io_3wire), TAG, "flush levels failed");
+    }
+    io_3wire->levels[io_3wire->levels_cnt++] = level;
+
+    return ESP_OK;
+}
+
+static esp_err_t levels_flush(bsp_lcd_3wire_io_t *io_3wire)
+{
+    const size_t cnt = io_3wire->levels_cnt;
+
+    if (cnt == 0) {
+        return ESP_OK;
+    }
+    io_3wire->levels_cnt = 0;
+
+    if (io_3wire->io_expander) {
+        const uint32_t lines = io_3wire->cs_mask | io_3wire->scl_mask | io_3wire->sda_mask;
+        ESP_RETURN_ON_ERROR(esp_io_expander_write_sequence(io_3wire->io_expander, lines, io_3wire->levels, cnt), TAG,
+                            "write expander sequence failed");
+        io_3wire->last_level = io_3wire->levels[cnt - 1];
+        return ESP_OK;
+    }
+
+    /* Native GPIOs, only changed lines are set */
+    for (size_t i = 0; i < cnt; i++) {
+        const uint32_t level = io_3wire->levels[i];
+        const uint32_t changed = level ^ io_3wire->last_level;
+        const bool scl_high = level & GPIO_LINE_SCL;
+        if (changed & GPIO_LINE_CS) {
+            gpio_set_level(io_3wire->cs_gpio, !!(level & GPIO_LINE_CS));
+        }
+        /* SDA changes only while SCL is low */
+        if ((changed & GPIO_LINE_SCL) && !scl_high) {
+            gpio_set_level(io_3wire->scl_gpio, 0);
+        }
+        if (changed & GPIO_LINE_SDA) {
+            gpio_set_level(io_3wire->sda_gpio, !!(level & GPIO_LINE_SDA));
+        }
+        if ((changed & GPIO_LINE_SCL) && scl_high) {
+            gpio_set_level(io_3wire->scl_gpio, 1);
+        }
+        io_3wire->last_level = level;
+        esp_rom_delay_us(GPIO_HALF_CLK_US);
+    }
+
+    return ESP_OK;
+}
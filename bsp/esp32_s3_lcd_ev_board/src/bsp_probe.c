@@ -6,6 +6,9 @@
 #include "driver/i2c_master.h"
 #include "esp_check.h"
 #include "esp_psram.h"
+#if CONFIG_BSP_PROBE_CACHE
+#include "nvs.h"
+#endif
 
 #include "esp_lcd_touch_ft5x06.h"
 #include "esp_lcd_touch_gt1151.h"
@@ -19,6 +22,39 @@ static const char *TAG = "bsp_probe";
 static bsp_module_type_t module_type = MODULE_TYPE_UNKNOW;
 static bsp_sub_board_type_t sub_board_type = SUB_BOARD_TYPE_UNKNOW;
 
+#if CONFIG_BSP_PROBE_CACHE
+#define PROBE_CACHE_NAMESPACE   "bsp"
+#define PROBE_CACHE_KEY         "ev_sub_board"
+
+static esp_err_t probe_cache_get(uint8_t *value)
+{
+    nvs_handle_t nvs;
+    esp_err_t ret = nvs_open(PROBE_CACHE_NAMESPACE, NVS_READONLY, &nvs);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = nvs_get_u8(nvs, PROBE_CACHE_KEY, value);
+    nvs_close(nvs);
+    return ret;
+}
+
+static void probe_cache_set(uint8_t value)
+{
+    nvs_handle_t nvs;
+    uint8_t stored;
+    /* NVS not initialized by the application, the cache is not used */
+    if (nvs_open(PROBE_CACHE_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK) {
+        return;
+    }
+    if (nvs_get_u8(nvs, PROBE_CACHE_KEY, &stored) != ESP_OK || stored != value) {
+        if (nvs_set_u8(nvs, PROBE_CACHE_KEY, value) != ESP_OK || nvs_commit(nvs) != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to store sub_board type");
+        }
+    }
+    nvs_close(nvs);
+}
+#endif
+
 bsp_module_type_t bsp_probe_module_type(void)
 {
     if (module_type != MODULE_TYPE_UNKNOW) {
@@ -52,7 +88,20 @@ bsp_sub_board_type_t bsp_probe_sub_board_type(void)
     };
     bsp_sub_board_type_t detect_type = SUB_BOARD_TYPE_UNKNOW;
 
-    for (int i = 0; i < sizeof(tp_address); i++) {
+#if CONFIG_BSP_PROBE_CACHE
+    /* One probe of the sub-board found in the last boot, the full detection only when it does not respond */
+    uint8_t cached;
+    if (probe_cache_get(&cached) == ESP_OK) {
+        if ((cached == SUB_BOARD_TYPE_2_480_480 || cached == SUB_BOARD_TYPE_3_800_480) &&
+                i2c_master_probe(i2c_handle, tp_address[cached - SUB_BOARD_TYPE_2_480_480], 100) == ESP_OK) {
+            detect_type = cached;
+        } else {
+            ESP_LOGW(TAG, "Cached sub_board %d not found, detecting", cached);
+        }
+    }
+#endif
+
+    for (int i = 0; i < sizeof(tp_address) && detect_type == SUB_BOARD_TYPE_UNKNOW; i++) {
         if (i2c_master_probe(i2c_handle, tp_address[i], 100) == ESP_OK) {
             if (tp_address[i] == ESP_LCD_TOUCH_IO_I2C_FT5x06_ADDRESS) {
                 ESP_LOGI(TAG, "Detect sub_board2 with 480x480 LCD (GC9503), Touch (FT5x06)");
@@ -73,6 +122,23 @@ bsp_sub_board_type_t bsp_probe_sub_board_type(void)
                             "Sub_board type mismatch, please check the software configuration and hardware connection");
     }
     sub_board_type = detect_type;
+#if CONFIG_BSP_PROBE_CACHE
+    probe_cache_set(sub_board_type);
+#endif
+
+    return sub_board_type;
+}
+
+bsp_sub_board_type_t bsp_probe_sub_board_redetect(void)
+{
+    const bsp_sub_board_type_t prev_type = sub_board_type;
+
+    sub_board_type = SUB_BOARD_TYPE_UNKNOW;
+    bsp_probe_sub_board_type();
+    if (sub_board_type == SUB_BOARD_TYPE_UNKNOW) {
+        sub_board_type = prev_type;
+        return SUB_BOARD_TYPE_UNKNOW;
+    }
 
     return sub_board_type;
 }
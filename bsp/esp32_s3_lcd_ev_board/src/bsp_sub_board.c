@@ -11,7 +11,6 @@
 #include "esp_io_expander_tca9554.h"
 #include "esp_lcd_gc9503.h"
 #include "esp_lcd_panel_io.h"
-#include "esp_lcd_panel_io_additions.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_panel_rgb.h"
 #include "esp_lcd_touch_ft5x06.h"
@@ -21,6 +20,7 @@
 
 #include "sdkconfig.h"
 #include "bsp_err_check.h"
+#include "bsp_lcd_3wire_io.h"
 #include "bsp_probe.h"
 #include "bsp/display.h"
 #include "bsp/esp32_s3_lcd_ev_board.h"
@@ -84,22 +84,15 @@ drift, please enable `ESP32S3_DATA_CACHE_LINE_32B` instead");
 
         BSP_NULL_CHECK(expander = bsp_io_expander_init(), ESP_FAIL);
         ESP_LOGI(TAG, "Install panel IO");
-        spi_line_config_t line_config = {
-            .cs_io_type = IO_TYPE_EXPANDER,
-            .cs_expander_pin = BSP_LCD_SUB_BOARD_2_SPI_CS,
-            .scl_io_type = IO_TYPE_EXPANDER,
-            .scl_expander_pin = BSP_LCD_SUB_BOARD_2_SPI_SCK,
-            .sda_io_type = IO_TYPE_EXPANDER,
-            .sda_expander_pin = BSP_LCD_SUB_BOARD_2_SPI_SDO,
+        /* Lines are on the IO expander, every command frame is sent in a few I2C writes */
+        const bsp_lcd_3wire_io_config_t io_config = {
             .io_expander = expander,
+            .cs = BSP_LCD_SUB_BOARD_2_SPI_CS,
+            .scl = BSP_LCD_SUB_BOARD_2_SPI_SCK,
+            .sda = BSP_LCD_SUB_BOARD_2_SPI_SDO,
+            .scl_active_falling = SUB_BOARD2_480_480_PANEL_SCL_ACTIVE_EDGE,
         };
-#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2)
-        esp_lcd_panel_io_3wire_spi_config_t io_config = GC9503_PANEL_IO_3WIRE_SPI_CONFIG(
-                    line_config, SUB_BOARD2_480_480_PANEL_SCL_ACTIVE_EDGE);
-#else
-        esp_lcd_panel_io_3wire_spi_config_t io_config = GC9503_PANEL_IO_3WIRE_SPI_CONFIG(line_config);
-#endif
-        BSP_ERROR_CHECK_RETURN_ERR(esp_lcd_new_panel_io_3wire_spi(&io_config, &io_handle));
+        BSP_ERROR_CHECK_RETURN_ERR(bsp_lcd_new_panel_io_3wire(&io_config, &io_handle));
 
         ESP_LOGI(TAG, "Initialize RGB panel");
         esp_lcd_rgb_panel_config_t rgb_conf = {
@@ -135,6 +128,13 @@ drift, please enable `ESP32S3_DATA_CACHE_LINE_32B` instead");
             .num_fbs = CONFIG_BSP_LCD_RGB_BUFFER_NUMS,
 #if CONFIG_BSP_LCD_RGB_BOUNCE_BUFFER_MODE
             .bounce_buffer_size_px = BSP_LCD_SUB_BOARD_2_H_RES * CONFIG_BSP_LCD_RGB_BOUNCE_BUFFER_HEIGHT,
+#endif
+#if CONFIG_BSP_LCD_RGB_BOUNCE_BUFFER_INVALIDATE_CACHE
+            .flags.bb_invalidate_cache = 1,
+#endif
+#if CONFIG_BSP_DISPLAY_LVGL_PAN
+            /* Bounce buffers are filled from the virtual frame buffer of LVGL port */
+            .flags.no_fb = 1,
 #endif
         };
         // To compatible with ESP32-S3-WROOM-N16R16V module
@@ -197,6 +197,13 @@ drift, please enable `ESP32S3_DATA_CACHE_LINE_32B` instead");
             .num_fbs = CONFIG_BSP_LCD_RGB_BUFFER_NUMS,
 #if CONFIG_BSP_LCD_RGB_BOUNCE_BUFFER_MODE
             .bounce_buffer_size_px = BSP_LCD_SUB_BOARD_3_H_RES * CONFIG_BSP_LCD_RGB_BOUNCE_BUFFER_HEIGHT,
+#endif
+#if CONFIG_BSP_LCD_RGB_BOUNCE_BUFFER_INVALIDATE_CACHE
+            .flags.bb_invalidate_cache = 1,
+#endif
+#if CONFIG_BSP_DISPLAY_LVGL_PAN
+            /* Bounce buffers are filled from the virtual frame buffer of LVGL port */
+            .flags.no_fb = 1,
 #endif
         };
         // To compatible with ESP32-S3-WROOM-N16R16V module
@@ -71,6 +71,7 @@ static esp_io_expander_handle_t io_expander = NULL; // IO expander tca9554 handl
 static adc_oneshot_unit_handle_t bsp_adc_handle = NULL;
 
 static lv_display_t *disp;
+static esp_lcd_panel_handle_t disp_panel = NULL;    // LCD panel handle of the display
 static lv_indev_t *disp_indev = NULL;
 static esp_lcd_touch_handle_t tp;   // LCD touch handle
 
@@ -330,6 +331,16 @@ esp_err_t bsp_audio_poweramp_enable(bool enable)
     return ESP_OK;
 }
 
+/* LVGL draw buffer size in pixels for resolution of the detected sub-board */
+static uint32_t bsp_display_buffer_size(void)
+{
+#if CONFIG_BSP_DISPLAY_LVGL_AVOID_TEAR
+    return BSP_LCD_H_RES * BSP_LCD_V_RES;
+#else
+    return BSP_LCD_H_RES * LVGL_BUFFER_HEIGHT;
+#endif /* CONFIG_BSP_DISPLAY_LVGL_AVOID_TEAR */
+}
+
 static lv_display_t *bsp_display_lcd_init()
 {
     esp_lcd_panel_io_handle_t io_handle = NULL;
@@ -338,18 +349,12 @@ static lv_display_t *bsp_display_lcd_init()
     bsp_display_config_t disp_config = { 0 };
 
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new(&disp_config, &panel_handle, &io_handle));
-
-    int buffer_size = 0;
-#if CONFIG_BSP_DISPLAY_LVGL_AVOID_TEAR
-    buffer_size = BSP_LCD_H_RES * BSP_LCD_V_RES;
-#else
-    buffer_size = BSP_LCD_H_RES * LVGL_BUFFER_HEIGHT;
-#endif /* CONFIG_BSP_DISPLAY_LVGL_AVOID_TEAR */
+    disp_panel = panel_handle;
 
     const lvgl_port_display_cfg_t disp_cfg = {
         .io_handle = io_handle,
         .panel_handle = panel_handle,
-        .buffer_size = buffer_size,
+        .buffer_size = bsp_display_buffer_size(),
 
         .monochrome = false,
         .hres = BSP_LCD_H_RES,
@@ -387,10 +392,20 @@ static lv_display_t *bsp_display_lcd_init()
 #endif
 #if CONFIG_BSP_DISPLAY_LVGL_AVOID_TEAR
             .avoid_tearing = true,
+#if CONFIG_BSP_LCD_RGB_BUFFER_NUMS == 3 && LV_VERSION_CHECK(9, 1, 0)
+            /* LVGL renders into the third frame buffer, while the previous frame waits for vsync */
+            .triple_buffer = true,
+#endif
 #else
             .avoid_tearing = false,
 #endif
-        }
+#if CONFIG_BSP_DISPLAY_LVGL_PAN && LVGL_VERSION_MAJOR >= 9
+            .pan = true,
+#endif
+        },
+#if CONFIG_BSP_DISPLAY_LVGL_PAN && LVGL_VERSION_MAJOR >= 9
+        .virtual_height = BSP_LCD_V_RES + CONFIG_BSP_DISPLAY_LVGL_PAN_LINES,
+#endif
     };
 
 #if CONFIG_BSP_LCD_RGB_BOUNCE_BUFFER_MODE
@@ -444,6 +459,57 @@ lv_indev_t *bsp_display_get_input_dev(void)
     return disp_indev;
 }
 
+esp_err_t bsp_display_reconfigure(void)
+{
+#if LVGL_VERSION_MAJOR >= 9 && !CONFIG_BSP_DISPLAY_LVGL_PAN
+    esp_lcd_panel_io_handle_t io_handle = NULL;
+    esp_lcd_panel_handle_t panel_handle = NULL;
+    const bsp_display_config_t disp_config = { 0 };
+    esp_err_t ret = ESP_OK;
+
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_STATE, TAG, "Display is not started");
+    const bsp_sub_board_type_t prev_type = bsp_probe_sub_board_type();
+    ESP_RETURN_ON_FALSE(bsp_probe_sub_board_redetect() != SUB_BOARD_TYPE_UNKNOW, ESP_ERR_NOT_FOUND, TAG, "No sub-board detected");
+    ESP_LOGI(TAG, "Reconfigure display from sub-board %d to sub-board %d", prev_type + 1, bsp_probe_sub_board_type() + 1);
+
+    /* Touch controller of the other sub-board has another address and range */
+    if (disp_indev) {
+        lvgl_port_remove_touch(disp_indev);
+        disp_indev = NULL;
+    }
+    if (tp) {
+        esp_lcd_panel_io_handle_t tp_io = tp->io;
+        esp_lcd_touch_del(tp);
+        esp_lcd_panel_io_del(tp_io);
+        tp = NULL;
+    }
+
+    /* There is only one RGB peripheral, the old panel is deleted first. LVGL does not render until the new one is set. */
+    bsp_display_lock(0);
+    esp_lcd_panel_del(disp_panel);
+    disp_panel = NULL;
+    ret = bsp_display_new(&disp_config, &panel_handle, &io_handle);
+    if (ret == ESP_OK) {
+        disp_panel = panel_handle;
+        const lvgl_port_disp_reconfig_t reconfig = {
+            .io_handle = io_handle,
+            .panel_handle = panel_handle,
+            .hres = BSP_LCD_H_RES,
+            .vres = BSP_LCD_V_RES,
+            .buffer_size = bsp_display_buffer_size(),
+        };
+        ret = lvgl_port_disp_reconfigure(disp, &reconfig);
+    }
+    bsp_display_unlock();
+    ESP_RETURN_ON_ERROR(ret, TAG, "Display reconfiguration failed");
+
+    BSP_NULL_CHECK(disp_indev = bsp_display_indev_init(disp), ESP_FAIL);
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 esp_err_t bsp_display_brightness_init(void)
 {
     ESP_LOGW(TAG, "This board doesn't support to change brightness of LCD");
@@ -4,15 +4,75 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include "esp_err.h"
+#include "esp_log.h"
+#include "esp_check.h"
 #include "esp_adc/adc_cali_scheme.h"
 #include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_continuous.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "bsp/esp32_s3_usb_otg.h"
 #include "bsp_err_check.h"
 
+/* Hardware IIR filters of ADC digital controller */
+#if SOC_ADC_DIG_IIR_FILTER_SUPPORTED && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+#include "esp_adc/adc_filter.h"
+#define BSP_POWER_MONITOR_IIR       1
+#endif
+
+#define BSP_BATTERY_ADC_CHANNEL     ADC_CHANNEL_5
+#define BSP_USB_ADC_CHANNEL         ADC_CHANNEL_0
+
+#define BSP_POWER_MONITOR_PERIOD_MS     (100)
+#define BSP_POWER_MONITOR_SAMPLE_FREQ   (SOC_ADC_SAMPLE_FREQ_THRES_LOW)
+#define BSP_POWER_MONITOR_MAX_RESULTS   (1000)  /* One DMA frame is shorter than 4095 bytes */
+#define BSP_POWER_MONITOR_TASK_STACK    (3072)
+#define BSP_POWER_MONITOR_TASK_PRIO     (2)
+/* Voltage dividers in Q10 fixed point */
+#define BSP_POWER_MONITOR_DIV_Q10(div)  ((int)((div) * 1024 + 0.5f))
+
+static const char *TAG = "S3-USB-OTG";
+
 static adc_oneshot_unit_handle_t bsp_adc_handle = NULL;
 static adc_cali_handle_t bsp_adc_cali_handle; /* ADC1 calibration handle */
 
+typedef struct {
+    adc_continuous_handle_t adc;
+#if BSP_POWER_MONITOR_IIR
+    adc_iir_filter_handle_t filters[BSP_POWER_MONITOR_MAX];
+#endif
+    TaskHandle_t        task;
+    TaskHandle_t        stop_task;      /* Task waiting for the end of monitor task */
+    volatile bool       running;
+    uint8_t             *frame;
+    uint32_t            frame_size;
+    uint32_t            period_ms;
+    bsp_power_monitor_cb_t threshold_cb;
+    void                *user_ctx;
+    volatile int        voltage_mv[BSP_POWER_MONITOR_MAX];
+    int                 threshold_mv[BSP_POWER_MONITOR_MAX];
+    int                 hysteresis_mv[BSP_POWER_MONITOR_MAX];
+    int8_t              above[BSP_POWER_MONITOR_MAX];   /* -1 is unknown */
+    portMUX_TYPE        lock;
+} bsp_power_monitor_t;
+
+static bsp_power_monitor_t bsp_power_monitor = {
+    .voltage_mv = {-1, -1},
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+static const adc_channel_t bsp_power_monitor_adc_channels[BSP_POWER_MONITOR_MAX] = {
+    [BSP_POWER_MONITOR_BATTERY] = BSP_BATTERY_ADC_CHANNEL,
+    [BSP_POWER_MONITOR_USB] = BSP_USB_ADC_CHANNEL,
+};
+
+static const int bsp_power_monitor_div_q10[BSP_POWER_MONITOR_MAX] = {
+    [BSP_POWER_MONITOR_BATTERY] = BSP_POWER_MONITOR_DIV_Q10(BSP_BATTERY_VOLTAGE_DIV),
+    [BSP_POWER_MONITOR_USB] = BSP_POWER_MONITOR_DIV_Q10(BSP_USB_HOST_VOLTAGE_DIV),
+};
+
 
 esp_err_t bsp_adc_initialize(void)
 {
@@ -45,8 +105,8 @@ esp_err_t bsp_voltage_init(void)
         .bitwidth = ADC_BITWIDTH_DEFAULT,
         .atten = ADC_ATTEN_DB_11,
     };
-    BSP_ERROR_CHECK_RETURN_ERR(adc_oneshot_config_channel(bsp_adc_handle, ADC_CHANNEL_0, &config));
-    BSP_ERROR_CHECK_RETURN_ERR(adc_oneshot_config_channel(bsp_adc_handle, ADC_CHANNEL_5, &config));
+    BSP_ERROR_CHECK_RETURN_ERR(adc_oneshot_config_channel(bsp_adc_handle, BSP_USB_ADC_CHANNEL, &config));
+    BSP_ERROR_CHECK_RETURN_ERR(adc_oneshot_config_channel(bsp_adc_handle, BSP_BATTERY_ADC_CHANNEL, &config));
 
     /* ESP32-S3 supports Curve Fitting calibration scheme */
     const adc_cali_curve_fitting_config_t cali_config = {
@@ -62,8 +122,11 @@ int bsp_voltage_battery_get(void)
 {
     int voltage, adc_raw;
 
+    if (bsp_power_monitor.running) {
+        return bsp_power_monitor.voltage_mv[BSP_POWER_MONITOR_BATTERY];
+    }
     assert(bsp_adc_handle);
-    BSP_ERROR_CHECK(adc_oneshot_read(bsp_adc_handle, ADC_CHANNEL_5, &adc_raw), -1);
+    BSP_ERROR_CHECK(adc_oneshot_read(bsp_adc_handle, BSP_BATTERY_ADC_CHANNEL, &adc_raw), -1);
     BSP_ERROR_CHECK(adc_cali_raw_to_voltage(bsp_adc_cali_handle, adc_raw, &voltage), -1);
     return voltage * BSP_BATTERY_VOLTAGE_DIV;
 }
@@ -72,8 +135,214 @@ int bsp_voltage_usb_get(void)
 {
     int voltage, adc_raw;
 
+    if (bsp_power_monitor.running) {
+        return bsp_power_monitor.voltage_mv[BSP_POWER_MONITOR_USB];
+    }
     assert(bsp_adc_handle);
-    BSP_ERROR_CHECK(adc_oneshot_read(bsp_adc_handle, ADC_CHANNEL_0, &adc_raw), -1);
+    BSP_ERROR_CHECK(adc_oneshot_read(bsp_adc_handle, BSP_USB_ADC_CHANNEL, &adc_raw), -1);
     BSP_ERROR_CHECK(adc_cali_raw_to_voltage(bsp_adc_cali_handle, adc_raw, &voltage), -1);
     return (float)voltage * BSP_USB_HOST_VOLTAGE_DIV;
 }
+
+static void bsp_power_monitor_update(bsp_power_monitor_t *mon, bsp_power_monitor_channel_t channel, int voltage_mv)
+{
+    bool notify = false;
+    bool above = false;
+
+    mon->voltage_mv[channel] = voltage_mv;
+    portENTER_CRITICAL(&mon->lock);
+    const int threshold = mon->threshold_mv[channel];
+    const int hysteresis = mon->hysteresis_mv[channel];
+    if (threshold > 0) {
+        if (mon->above[channel] != 1 && voltage_mv > threshold + hysteresis) {
+            mon->above[channel] = 1;
+            notify = true;
+        } else if (mon->above[channel] != 0 && voltage_mv < threshold - hysteresis) {
+            mon->above[channel] = 0;
+            notify = true;
+        } else if (mon->above[channel] < 0) {
+            /* First value inside of the hysteresis */
+            mon->above[channel] = (voltage_mv >= threshold);
+            notify = true;
+        }
+        above = (mon->above[channel] == 1);
+    }
+    portEXIT_CRITICAL(&mon->lock);
+
+    if (notify && mon->threshold_cb) {
+        mon->threshold_cb(channel, voltage_mv, above, mon->user_ctx);
+    }
+}
+
+static void bsp_power_monitor_task(void *arg)
+{
+    bsp_power_monitor_t *mon = (bsp_power_monitor_t *)arg;
+
+    while (mon->running) {
+        uint32_t len = 0;
+        if (adc_continuous_read(mon->adc, mon->frame, mon->frame_size, &len, mon->period_ms * 2) != ESP_OK) {
+            continue;
+        }
+
+        /* Average of filtered results in one frame (one update period) */
+        uint32_t sum[BSP_POWER_MONITOR_MAX] = {0};
+        uint32_t count[BSP_POWER_MONITOR_MAX] = {0};
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= len; i += SOC_ADC_DIGI_RESULT_BYTES) {
+            const adc_digi_output_data_t *result = (const adc_digi_output_data_t *)&mon->frame[i];
+            for (int ch = 0; ch < BSP_POWER_MONITOR_MAX; ch++) {
+                if (result->type2.channel == bsp_power_monitor_adc_channels[ch]) {
+                    sum[ch] += result->type2.data;
+                    count[ch]++;
+                    break;
+                }
+            }
+        }
+        for (int ch = 0; ch < BSP_POWER_MONITOR_MAX; ch++) {
+            int voltage = 0;
+            if (count[ch] == 0 || adc_cali_raw_to_voltage(bsp_adc_cali_handle, (sum[ch] + count[ch] / 2) / count[ch], &voltage) != ESP_OK) {
+                continue;
+            }
+            bsp_power_monitor_update(mon, ch, (voltage * bsp_power_monitor_div_q10[ch] + 512) >> 10);
+        }
+    }
+
+    xTaskNotifyGive(mon->stop_task);
+    vTaskDelete(NULL);
+}
+
+static void bsp_power_monitor_free(bsp_power_monitor_t *mon)
+{
+    if (mon->adc) {
+#if BSP_POWER_MONITOR_IIR
+        for (int ch = 0; ch < BSP_POWER_MONITOR_MAX; ch++) {
+            if (mon->filters[ch]) {
+                adc_continuous_iir_filter_disable(mon->filters[ch]);
+                adc_del_continuous_iir_filter(mon->filters[ch]);
+                mon->filters[ch] = NULL;
+            }
+        }
+#endif
+        adc_continuous_deinit(mon->adc);
+        mon->adc = NULL;
+    }
+    free(mon->frame);
+    mon->frame = NULL;
+}
+
+esp_err_t bsp_power_monitor_start(const bsp_power_monitor_cfg_t *cfg)
+{
+    esp_err_t ret = ESP_OK;
+    bsp_power_monitor_t *mon = &bsp_power_monitor;
+    ESP_RETURN_ON_FALSE(!mon->running && mon->adc == NULL, ESP_ERR_INVALID_STATE, TAG, "Power monitor is already running");
+
+    /* Calibration is shared with oneshot reads */
+    if (bsp_adc_cali_handle == NULL) {
+        const adc_cali_curve_fitting_config_t cali_config = {
+            .unit_id = BSP_ADC_UNIT,
+            .atten = ADC_ATTEN_DB_11,
+            .bitwidth = SOC_ADC_DIGI_MAX_BITWIDTH,
+        };
+        ESP_RETURN_ON_ERROR(adc_cali_create_scheme_curve_fitting(&cali_config, &bsp_adc_cali_handle), TAG, "ADC calibration failed");
+    }
+
+    mon->period_ms = (cfg && cfg->update_period_ms ? cfg->update_period_ms : BSP_POWER_MONITOR_PERIOD_MS);
+    mon->threshold_cb = (cfg ? cfg->threshold_cb : NULL);
+    mon->user_ctx = (cfg ? cfg->user_ctx : NULL);
+    for (int ch = 0; ch < BSP_POWER_MONITOR_MAX; ch++) {
+        mon->voltage_mv[ch] = -1;
+        mon->above[ch] = -1;
+    }
+
+    /* One DMA frame per update period */
+    uint32_t results = BSP_POWER_MONITOR_SAMPLE_FREQ * mon->period_ms / 1000;
+    results = (results < BSP_POWER_MONITOR_MAX ? BSP_POWER_MONITOR_MAX : (results > BSP_POWER_MONITOR_MAX_RESULTS ? BSP_POWER_MONITOR_MAX_RESULTS : results));
+    mon->frame_size = results * SOC_ADC_DIGI_RESULT_BYTES;
+    mon->frame = malloc(mon->frame_size);
+    ESP_RETURN_ON_FALSE(mon->frame, ESP_ERR_NO_MEM, TAG, "Not enough memory for ADC frame");
+
+    const adc_continuous_handle_cfg_t handle_cfg = {
+        .max_store_buf_size = mon->frame_size * 2,
+        .conv_frame_size = mon->frame_size,
+    };
+    ESP_GOTO_ON_ERROR(adc_continuous_new_handle(&handle_cfg, &mon->adc), err, TAG, "ADC continuous init failed");
+
+    adc_digi_pattern_config_t patterns[BSP_POWER_MONITOR_MAX];
+    for (int ch = 0; ch < BSP_POWER_MONITOR_MAX; ch++) {
+        patterns[ch] = (adc_digi_pattern_config_t) {
+            .atten = ADC_ATTEN_DB_11,
+            .channel = bsp_power_monitor_adc_channels[ch],
+            .unit = BSP_ADC_UNIT,
+            .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+        };
+    }
+    const adc_continuous_config_t dig_cfg = {
+        .pattern_num = BSP_POWER_MONITOR_MAX,
+        .adc_pattern = patterns,
+        .sample_freq_hz = BSP_POWER_MONITOR_SAMPLE_FREQ,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+    };
+    ESP_GOTO_ON_ERROR(adc_continuous_config(mon->adc, &dig_cfg), err, TAG, "ADC continuous config failed");
+
+#if BSP_POWER_MONITOR_IIR
+    for (int ch = 0; ch < BSP_POWER_MONITOR_MAX; ch++) {
+        const adc_continuous_iir_filter_config_t filter_cfg = {
+            .unit = BSP_ADC_UNIT,
+            .channel = bsp_power_monitor_adc_channels[ch],
+            .coeff = ADC_DIGI_IIR_FILTER_COEFF_16,
+        };
+        ESP_GOTO_ON_ERROR(adc_new_continuous_iir_filter(mon->adc, &filter_cfg, &mon->filters[ch]), err, TAG, "ADC IIR filter init failed");
+        ESP_GOTO_ON_ERROR(adc_continuous_iir_filter_enable(mon->filters[ch]), err, TAG, "ADC IIR filter enable failed");
+    }
+#endif
+
+    ESP_GOTO_ON_ERROR(adc_continuous_start(mon->adc), err, TAG, "ADC continuous start failed");
+    mon->running = true;
+    if (xTaskCreate(bsp_power_monitor_task, "power_mon", BSP_POWER_MONITOR_TASK_STACK, mon, BSP_POWER_MONITOR_TASK_PRIO, &mon->task) != pdPASS) {
+        mon->running = false;
+        adc_continuous_stop(mon->adc);
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_NO_MEM, err, TAG, "Create power monitor task fail!");
+    }
+    return ESP_OK;
+
+err:
+    bsp_power_monitor_free(mon);
+    return ret;
+}
+
+esp_err_t bsp_power_monitor_stop(void)
+{
+    bsp_power_monitor_t *mon = &bsp_power_monitor;
+    ESP_RETURN_ON_FALSE(mon->running, ESP_ERR_INVALID_STATE, TAG, "Power monitor is not running");
+
+    /* The task ends after the current read (one update period at most) */
+    mon->stop_task = xTaskGetCurrentTaskHandle();
+    mon->running = false;
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    mon->task = NULL;
+
+    adc_continuous_stop(mon->adc);
+    bsp_power_monitor_free(mon);
+    return ESP_OK;
+}
+
+int bsp_power_monitor_get(bsp_power_monitor_channel_t channel)
+{
+    if (channel >= BSP_POWER_MONITOR_MAX) {
+        return -1;
+    }
+    return bsp_power_monitor.voltage_mv[channel];
+}
+
+esp_err_t bsp_power_monitor_set_threshold(bsp_power_monitor_channel_t channel, int threshold_mv, int hysteresis_mv)
+{
+    bsp_power_monitor_t *mon = &bsp_power_monitor;
+    ESP_RETURN_ON_FALSE(channel < BSP_POWER_MONITOR_MAX && threshold_mv >= 0 && hysteresis_mv >= 0, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    portENTER_CRITICAL(&mon->lock);
+    mon->threshold_mv[channel] = threshold_mv;
+    mon->hysteresis_mv[channel] = hysteresis_mv;
+    mon->above[channel] = -1;
+    portEXIT_CRITICAL(&mon->lock);
+    return ESP_OK;
+}
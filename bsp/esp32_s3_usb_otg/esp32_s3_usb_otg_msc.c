@@ -0,0 +1,493 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "driver/sdmmc_host.h"
+#include "sdmmc_cmd.h"
+#include "bsp/esp32_s3_usb_otg.h"
+
+#if CONFIG_TINYUSB_MSC_ENABLED
+#include "tinyusb.h"
+#include "class/msc/msc_device.h"
+#endif
+
+static const char *TAG = "S3-USB-OTG";
+
+#if CONFIG_TINYUSB_MSC_ENABLED
+
+#define BSP_USB_MSC_STAGE_SECTORS   (CONFIG_BSP_USB_MSC_STAGE_SECTORS)
+#define BSP_USB_MSC_FLUSH_MS        (CONFIG_BSP_USB_MSC_FLUSH_MS)
+/* Pauses of host transfers longer than this are not counted to the throughput */
+#define BSP_USB_MSC_IDLE_US         (100 * 1000)
+#define BSP_USB_MSC_TASK_STACK      (3072)
+#define BSP_USB_MSC_TASK_PRIO       (5)
+#define BSP_USB_MSC_SCSI_SYNC_CACHE (0x35)
+
+typedef struct {
+    sdmmc_card_t        card;
+    uint16_t            sector_size;
+    /* One staging buffer in internal DMA memory, read-ahead window or coalesced writes */
+    uint8_t             *stage;
+    uint32_t            stage_lba;      /* First sector in the buffer */
+    uint32_t            stage_sectors;  /* Valid sectors of read-ahead */
+    uint32_t            dirty_bytes;    /* Coalesced bytes of writes from stage_lba, 0 in read mode */
+    int64_t             last_write_us;
+    SemaphoreHandle_t   lock;
+    TaskHandle_t        flush_task;
+    volatile bool       running;
+    bool                ejected;
+    /* Statistics */
+    bsp_usb_msc_stats_t stats;
+    int64_t             read_active_us;
+    int64_t             write_active_us;
+    int64_t             last_read_us;
+    int64_t             last_io_write_us;
+} bsp_usb_msc_t;
+
+static bsp_usb_msc_t *bsp_msc = NULL;
+
+/* Time of host transfers, without long pauses */
+static void bsp_usb_msc_account(int64_t *active_us, int64_t *last_us)
+{
+    const int64_t now = esp_timer_get_time();
+    if (*last_us && now - *last_us < BSP_USB_MSC_IDLE_US) {
+        *active_us += now - *last_us;
+    }
+    *last_us = now;
+}
+
+/* Called with the lock, whole coalesced sectors are written, the rest of last sector stays */
+static esp_err_t bsp_usb_msc_flush(bsp_usb_msc_t *msc)
+{
+    const uint32_t sectors = msc->dirty_bytes / msc->sector_size;
+    if (sectors == 0) {
+        return ESP_OK;
+    }
+
+    esp_err_t ret = sdmmc_write_sectors(&msc->card, msc->stage, msc->stage_lba, sectors);
+    msc->stats.sd_writes++;
+    if (ret != ESP_OK) {
+        msc->stats.errors++;
+        ESP_LOGE(TAG, "uSD card write of %"PRIu32" sectors failed (%s)", sectors, esp_err_to_name(ret));
+    }
+    const uint32_t written = sectors * msc->sector_size;
+    memmove(msc->stage, msc->stage + written, msc->dirty_bytes - written);
+    msc->dirty_bytes -= written;
+    msc->stage_lba += sectors;
+    return ret;
+}
+
+static void bsp_usb_msc_flush_task(void *arg)
+{
+    bsp_usb_msc_t *msc = (bsp_usb_msc_t *)arg;
+
+    while (msc->running) {
+        /* Notified after each coalesced write */
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (msc->running) {
+            vTaskDelay(pdMS_TO_TICKS(BSP_USB_MSC_FLUSH_MS));
+            xSemaphoreTake(msc->lock, portMAX_DELAY);
+            const bool idle = (esp_timer_get_time() - msc->last_write_us >= BSP_USB_MSC_FLUSH_MS * 1000);
+            if (idle) {
+                bsp_usb_msc_flush(msc);
+            }
+            const bool pending = (msc->dirty_bytes >= msc->sector_size);
+            xSemaphoreGive(msc->lock);
+            if (idle && !pending) {
+                break;
+            }
+        }
+    }
+
+    msc->flush_task = NULL;
+    vTaskDelete(NULL);
+}
+
+/*******************************************************************************
+* TinyUSB MSC callbacks, called from TinyUSB task
+*******************************************************************************/
+
+void tud_msc_inquiry_cb(uint8_t lun, uint8_t vendor_id[8], uint8_t product_id[16], uint8_t product_rev[4])
+{
+    (void)lun;
+    const char vid[] = "Espressif";
+    const char pid[] = "S3-USB-OTG uSD";
+    const char rev[] = "1.0";
+
+    memcpy(vendor_id, vid, MIN(strlen(vid), 8));
+    memcpy(product_id, pid, MIN(strlen(pid), 16));
+    memcpy(product_rev, rev, MIN(strlen(rev), 4));
+}
+
+bool tud_msc_test_unit_ready_cb(uint8_t lun)
+{
+    (void)lun;
+    if (bsp_msc == NULL || bsp_msc->ejected) {
+        /* Medium not present */
+        tud_msc_set_sense(lun, SCSI_SENSE_NOT_READY, 0x3A, 0x00);
+        return false;
+    }
+    return true;
+}
+
+void tud_msc_capacity_cb(uint8_t lun, uint32_t *block_count, uint16_t *block_size)
+{
+    (void)lun;
+    if (bsp_msc == NULL) {
+        *block_count = 0;
+        *block_size = 512;
+        return;
+    }
+    *block_count = bsp_msc->card.csd.capacity;
+    *block_size = bsp_msc->sector_size;
+}
+
+bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, bool load_eject)
+{
+    (void)lun;
+    (void)power_condition;
+    if (bsp_msc && load_eject) {
+        xSemaphoreTake(bsp_msc->lock, portMAX_DELAY);
+        if (!start) {
+            bsp_usb_msc_flush(bsp_msc);
+        }
+        bsp_msc->ejected = !start;
+        xSemaphoreGive(bsp_msc->lock);
+    }
+    return true;
+}
+
+int32_t tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buffer, uint32_t bufsize)
+{
+    (void)lun;
+    bsp_usb_msc_t *msc = bsp_msc;
+    if (msc == NULL) {
+        return -1;
+    }
+    const uint32_t ss = msc->sector_size;
+    int32_t ret = (int32_t)bufsize;
+    lba += offset / ss;
+    offset %= ss;
+
+    xSemaphoreTake(msc->lock, portMAX_DELAY);
+    bsp_usb_msc_account(&msc->read_active_us, &msc->last_read_us);
+    /* Read-ahead and coalesced writes share the staging buffer */
+    if (msc->dirty_bytes) {
+        bsp_usb_msc_flush(msc);
+        msc->dirty_bytes = 0;
+        msc->stage_sectors = 0;
+    }
+
+    if (offset == 0 && (bufsize % ss) == 0 && bufsize / ss >= BSP_USB_MSC_STAGE_SECTORS &&
+            esp_ptr_dma_capable(buffer) && ((uintptr_t)buffer % 4) == 0) {
+        /* Big request, DMA directly into the endpoint buffer */
+        msc->stats.sd_reads++;
+        if (sdmmc_read_sectors(&msc->card, buffer, lba, bufsize / ss) != ESP_OK) {
+            msc->stats.errors++;
+            ret = -1;
+        }
+    } else {
+        uint8_t *dst = (uint8_t *)buffer;
+        uint32_t left = bufsize;
+        while (left) {
+            if (lba < msc->stage_lba || lba >= msc->stage_lba + msc->stage_sectors) {
+                /* Read-ahead from the requested sector */
+                const uint32_t capacity = (uint32_t)msc->card.csd.capacity;
+                const uint32_t count = (lba < capacity ? MIN(BSP_USB_MSC_STAGE_SECTORS, capacity - lba) : 0);
+                msc->stats.sd_reads++;
+                if (count == 0 || sdmmc_read_sectors(&msc->card, msc->stage, lba, count) != ESP_OK) {
+                    msc->stats.errors++;
+                    msc->stage_sectors = 0;
+                    ret = -1;
+                    break;
+                }
+                msc->stage_lba = lba;
+                msc->stage_sectors = count;
+            } else {
+                msc->stats.cache_hits++;
+            }
+            const uint32_t pos = (lba - msc->stage_lba) * ss + offset;
+            const uint32_t len = MIN(left, msc->stage_sectors * ss - pos);
+            memcpy(dst, msc->stage + pos, len);
+            dst += len;
+            left -= len;
+            lba += (offset + len) / ss;
+            offset = (offset + len) % ss;
+        }
+    }
+    if (ret > 0) {
+        msc->stats.bytes_read += bufsize;
+    }
+    xSemaphoreGive(msc->lock);
+    return ret;
+}
+
+int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_t bufsize)
+{
+    (void)lun;
+    bsp_usb_msc_t *msc = bsp_msc;
+    if (msc == NULL) {
+        return -1;
+    }
+    const uint32_t ss = msc->sector_size;
+    const uint32_t stage_bytes = BSP_USB_MSC_STAGE_SECTORS * ss;
+    int32_t ret = (int32_t)bufsize;
+    bool notify = false;
+    lba += offset / ss;
+    offset %= ss;
+
+    xSemaphoreTake(msc->lock, portMAX_DELAY);
+    bsp_usb_msc_account(&msc->write_active_us, &msc->last_io_write_us);
+    if (msc->dirty_bytes == 0) {
+        /* Read-ahead is not valid anymore */
+        msc->stage_sectors = 0;
+        msc->stage_lba = lba;
+    }
+
+    const uint64_t addr = (uint64_t)lba * ss + offset;
+    if (addr != (uint64_t)msc->stage_lba * ss + msc->dirty_bytes) {
+        /* Not sequential, write out the coalesced sectors */
+        if (bsp_usb_msc_flush(msc) != ESP_OK) {
+            ret = -1;
+        }
+        msc->dirty_bytes = 0;
+        msc->stage_lba = lba;
+        if (offset) {
+            /* Rare unaligned start, keep the rest of the sector from the card */
+            msc->stats.sd_reads++;
+            if (sdmmc_read_sectors(&msc->card, msc->stage, lba, 1) != ESP_OK) {
+                msc->stats.errors++;
+                ret = -1;
+            }
+            msc->dirty_bytes = offset;
+        }
+    }
+
+    if (msc->dirty_bytes == 0 && offset == 0 && (bufsize % ss) == 0 && bufsize >= stage_bytes &&
+            esp_ptr_dma_capable(buffer) && ((uintptr_t)buffer % 4) == 0) {
+        /* Big request, DMA directly from the endpoint buffer */
+        msc->stats.sd_writes++;
+        if (sdmmc_write_sectors(&msc->card, buffer, lba, bufsize / ss) != ESP_OK) {
+            msc->stats.errors++;
+            ret = -1;
+        }
+        msc->stage_lba = lba + bufsize / ss;
+    } else {
+        const uint8_t *src = buffer;
+        uint32_t left = bufsize;
+        while (left && ret > 0) {
+            const uint32_t len = MIN(left, stage_bytes - msc->dirty_bytes);
+            memcpy(msc->stage + msc->dirty_bytes, src, len);
+            msc->dirty_bytes += len;
+            src += len;
+            left -= len;
+            if (msc->dirty_bytes == stage_bytes && bsp_usb_msc_flush(msc) != ESP_OK) {
+                ret = -1;
+            }
+        }
+        notify = (msc->dirty_bytes != 0);
+    }
+    msc->last_write_us = esp_timer_get_time();
+    if (ret > 0) {
+        msc->stats.bytes_written += bufsize;
+    }
+    xSemaphoreGive(msc->lock);
+
+    if (notify && msc->flush_task) {
+        xTaskNotifyGive(msc->flush_task);
+    }
+    return ret;
+}
+
+int32_t tud_msc_scsi_cb(uint8_t lun, uint8_t const scsi_cmd[16], void *buffer, uint16_t bufsize)
+{
+    (void)buffer;
+    (void)bufsize;
+
+    switch (scsi_cmd[0]) {
+    case SCSI_CMD_PREVENT_ALLOW_MEDIUM_REMOVAL:
+        return 0;
+    case BSP_USB_MSC_SCSI_SYNC_CACHE:
+        if (bsp_msc) {
+            xSemaphoreTake(bsp_msc->lock, portMAX_DELAY);
+            const esp_err_t ret = bsp_usb_msc_flush(bsp_msc);
+            xSemaphoreGive(bsp_msc->lock);
+            if (ret != ESP_OK) {
+                tud_msc_set_sense(lun, SCSI_SENSE_MEDIUM_ERROR, 0x0C, 0x00);
+                return -1;
+            }
+        }
+        return 0;
+    default:
+        /* Invalid command operation code */
+        tud_msc_set_sense(lun, SCSI_SENSE_ILLEGAL_REQUEST, 0x20, 0x00);
+        return -1;
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t bsp_usb_msc_start(void)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(bsp_msc == NULL && bsp_sdcard == NULL, ESP_ERR_INVALID_STATE, TAG, "uSD card is mounted or USB MSC is running");
+
+    bsp_usb_msc_t *msc = heap_caps_calloc(1, sizeof(bsp_usb_msc_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(msc, ESP_ERR_NO_MEM, TAG, "Not enough memory for USB MSC");
+    bool host_init = false;
+
+    /* SDMMC DMA works only with internal memory, the board has no PSRAM */
+    msc->stage = heap_caps_malloc(BSP_USB_MSC_STAGE_SECTORS * 512, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    msc->lock = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(msc->stage && msc->lock, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for USB MSC");
+
+    sdmmc_host_t host = SDMMC_HOST_DEFAULT();
+    host.max_freq_khz = SDMMC_FREQ_HIGHSPEED;
+    const sdmmc_slot_config_t slot_config = {
+        .clk = BSP_SD_CLK,
+        .cmd = BSP_SD_CMD,
+        .d0 = BSP_SD_D0,
+        .d1 = BSP_SD_D1,
+        .d2 = BSP_SD_D2,
+        .d3 = BSP_SD_D3,
+        .d4 = GPIO_NUM_NC,
+        .d5 = GPIO_NUM_NC,
+        .d6 = GPIO_NUM_NC,
+        .d7 = GPIO_NUM_NC,
+        .cd = SDMMC_SLOT_NO_CD,
+        .wp = SDMMC_SLOT_NO_WP,
+        .width = 4,
+        .flags = 0,
+    };
+    ESP_GOTO_ON_ERROR(sdmmc_host_init(), err, TAG, "SDMMC host init failed");
+    host_init = true;
+    ESP_GOTO_ON_ERROR(sdmmc_host_init_slot(host.slot, &slot_config), err, TAG, "SDMMC slot init failed");
+    ESP_GOTO_ON_ERROR(sdmmc_card_init(&host, &msc->card), err, TAG, "uSD card init failed");
+    ESP_GOTO_ON_FALSE(msc->card.csd.sector_size == 512, ESP_ERR_NOT_SUPPORTED, err, TAG, "Unsupported sector size");
+    msc->sector_size = msc->card.csd.sector_size;
+    sdmmc_card_print_info(stdout, &msc->card);
+
+    msc->running = true;
+    ESP_GOTO_ON_FALSE(xTaskCreate(bsp_usb_msc_flush_task, "usb_msc_flush", BSP_USB_MSC_TASK_STACK, msc,
+                                  BSP_USB_MSC_TASK_PRIO, &msc->flush_task) == pdPASS, ESP_ERR_NO_MEM, err, TAG,
+                      "Create flush task failed");
+    bsp_msc = msc;
+
+    ESP_GOTO_ON_ERROR(bsp_usb_mode_select_device(), err, TAG, "USB device mode failed");
+    const tinyusb_config_t tusb_cfg = {
+        .device_descriptor = NULL,
+        .string_descriptor = NULL,
+        .external_phy = false,
+        .configuration_descriptor = NULL,
+    };
+    ESP_GOTO_ON_ERROR(tinyusb_driver_install(&tusb_cfg), err, TAG, "TinyUSB install failed");
+    ESP_LOGI(TAG, "USB MSC started, %"PRIu32" sectors", (uint32_t)msc->card.csd.capacity);
+    return ESP_OK;
+
+err:
+    bsp_msc = NULL;
+    if (msc->flush_task) {
+        msc->running = false;
+        xTaskNotifyGive(msc->flush_task);
+        while (msc->flush_task) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+    }
+    if (host_init) {
+        sdmmc_host_deinit();
+    }
+    if (msc->lock) {
+        vSemaphoreDelete(msc->lock);
+    }
+    free(msc->stage);
+    free(msc);
+    return ret;
+}
+
+esp_err_t bsp_usb_msc_stop(void)
+{
+    ESP_RETURN_ON_FALSE(bsp_msc, ESP_ERR_INVALID_STATE, TAG, "USB MSC is not running");
+    bsp_usb_msc_t *msc = bsp_msc;
+
+    tinyusb_driver_uninstall();
+    xSemaphoreTake(msc->lock, portMAX_DELAY);
+    bsp_usb_msc_flush(msc);
+    bsp_msc = NULL;
+    xSemaphoreGive(msc->lock);
+
+    msc->running = false;
+    xTaskNotifyGive(msc->flush_task);
+    while (msc->flush_task) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    sdmmc_host_deinit();
+    vSemaphoreDelete(msc->lock);
+    free(msc->stage);
+    free(msc);
+    return ESP_OK;
+}
+
+esp_err_t bsp_usb_msc_get_stats(bsp_usb_msc_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    bsp_usb_msc_t *msc = bsp_msc;
+    if (msc == NULL) {
+        memset(stats, 0, sizeof(bsp_usb_msc_stats_t));
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(msc->lock, portMAX_DELAY);
+    *stats = msc->stats;
+    /* Bytes per millisecond equals kB/s */
+    stats->read_kBps = (msc->read_active_us ? (uint32_t)(msc->stats.bytes_read * 1000 / msc->read_active_us) : 0);
+    stats->write_kBps = (msc->write_active_us ? (uint32_t)(msc->stats.bytes_written * 1000 / msc->write_active_us) : 0);
+    if (reset) {
+        memset(&msc->stats, 0, sizeof(msc->stats));
+        msc->read_active_us = 0;
+        msc->write_active_us = 0;
+        msc->last_read_us = 0;
+        msc->last_io_write_us = 0;
+    }
+    xSemaphoreGive(msc->lock);
+    return ESP_OK;
+}
+
+#else
+
+esp_err_t bsp_usb_msc_start(void)
+{
+    ESP_LOGE(TAG, "USB MSC requires CONFIG_TINYUSB_MSC_ENABLED");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t bsp_usb_msc_stop(void)
+{
+    return ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t bsp_usb_msc_get_stats(bsp_usb_msc_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    (void)reset;
+    memset(stats, 0, sizeof(bsp_usb_msc_stats_t));
+    return ESP_OK;
+}
+
+#endif
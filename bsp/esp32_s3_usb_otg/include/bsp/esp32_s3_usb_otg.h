@@ -426,6 +426,71 @@ esp_err_t bsp_usb_host_start(bsp_usb_host_power_mode_t mode, bool limit_500mA);
  */
 esp_err_t bsp_usb_host_stop(void);
 
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+/**
+ * @brief Statistics of USB Mass Storage
+ */
+typedef struct {
+    uint64_t bytes_read;        /*!< Bytes read by the host */
+    uint64_t bytes_written;     /*!< Bytes written by the host */
+    uint32_t read_kBps;         /*!< Read throughput during transfers in [kB/s] */
+    uint32_t write_kBps;        /*!< Write throughput during transfers in [kB/s] */
+    uint32_t sd_reads;          /*!< Multi-sector reads of uSD card */
+    uint32_t sd_writes;         /*!< Multi-sector writes of uSD card */
+    uint32_t cache_hits;        /*!< Host reads served from the read-ahead buffer */
+    uint32_t errors;            /*!< Failed uSD card transfers */
+} bsp_usb_msc_stats_t;
+
+/**
+ * @brief Expose uSD card as USB Mass Storage device on USB DEV connector
+ *
+ * The uSD card is initialized in 4-bit high speed mode (it must not be mounted by bsp_sdcard_mount()) and the
+ * board is switched to USB device mode. Host reads are served from a read-ahead buffer filled by multi-sector DMA
+ * transfers, sequential host writes are coalesced and written by multi-sector transfers. Coalesced data are written
+ * after CONFIG_BSP_USB_MSC_FLUSH_MS of idle time, on SCSI SYNCHRONIZE CACHE and on eject.
+ *
+ * @note Requires CONFIG_TINYUSB_MSC_ENABLED. The tinyusb_msc_storage API of esp_tinyusb must not be used with it.
+ * @note Bigger CONFIG_TINYUSB_MSC_BUFSIZE (e.g. 8192) lowers the count of TinyUSB callbacks.
+ * @note This function is available only in IDF5 and higher
+ *
+ * @return
+ *     - ESP_OK                 On success
+ *     - ESP_ERR_INVALID_STATE  uSD card is mounted or USB MSC is running
+ *     - ESP_ERR_NOT_SUPPORTED  TinyUSB MSC class is not enabled
+ *     - ESP_ERR_NO_MEM         Memory cannot be allocated
+ *     - Error of uSD card or TinyUSB initialization otherwise
+ */
+esp_err_t bsp_usb_msc_start(void);
+
+/**
+ * @brief Stop USB Mass Storage
+ *
+ * Coalesced data are written to the uSD card, TinyUSB is uninstalled and the uSD card deinitialized.
+ *
+ * @note This function is available only in IDF5 and higher
+ *
+ * @return
+ *     - ESP_OK                 On success
+ *     - ESP_ERR_INVALID_STATE  USB MSC is not running
+ */
+esp_err_t bsp_usb_msc_stop(void);
+
+/**
+ * @brief Get statistics of USB Mass Storage
+ *
+ * Throughput is computed over the time of host transfers, pauses longer than 100 ms are not counted.
+ *
+ * @note This function is available only in IDF5 and higher
+ *
+ * @param[out] stats Statistics
+ * @param[in]  reset Reset the statistics after reading
+ * @return
+ *     - ESP_OK                 On success
+ *     - ESP_ERR_INVALID_ARG    stats is NULL
+ */
+esp_err_t bsp_usb_msc_get_stats(bsp_usb_msc_stats_t *stats, bool reset);
+#endif
+
 /**************************************************************************************************
  *
  * Voltage measurements
@@ -478,7 +543,7 @@ esp_err_t bsp_voltage_init(void);
 /**
  * @brief Get battery voltage
  *
- * @note bsp_voltage_init() must be called first
+ * @note bsp_voltage_init() must be called first. When the power monitor is running, its latest value is returned.
  * @return Resulting voltage in [mV] or -1 on error
  */
 int bsp_voltage_battery_get(void);
@@ -486,11 +551,91 @@ int bsp_voltage_battery_get(void);
 /**
  * @brief Get USB device connector voltage
  *
- * @note bsp_voltage_init() must be called first
+ * @note bsp_voltage_init() must be called first. When the power monitor is running, its latest value is returned.
  * @return Resulting voltage in [mV] or -1 on error
  */
 int bsp_voltage_usb_get(void);
 
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+/**
+ * @brief Voltages measured by power monitor
+ */
+typedef enum {
+    BSP_POWER_MONITOR_BATTERY,
+    BSP_POWER_MONITOR_USB,
+    BSP_POWER_MONITOR_MAX,
+} bsp_power_monitor_channel_t;
+
+/**
+ * @brief Callback called from power monitor task, when the voltage crosses the threshold
+ *
+ * @param channel       measured voltage
+ * @param voltage_mv    voltage in [mV]
+ * @param above         the voltage is above the threshold
+ * @param user_ctx      user context from configuration
+ */
+typedef void (*bsp_power_monitor_cb_t)(bsp_power_monitor_channel_t channel, int voltage_mv, bool above, void *user_ctx);
+
+/**
+ * @brief Power monitor configuration
+ */
+typedef struct {
+    uint32_t update_period_ms;          /*!< Period of voltage updates (0: 100 ms) */
+    bsp_power_monitor_cb_t threshold_cb; /*!< Threshold callback (optional) */
+    void *user_ctx;                     /*!< User context of the callback */
+} bsp_power_monitor_cfg_t;
+
+/**
+ * @brief Start power monitor
+ *
+ * Battery and USB voltages are sampled by ADC in continuous mode with DMA at the lowest sample rate,
+ * smoothed by hardware IIR filters and averaged in each update period. The latest voltages are read
+ * by bsp_power_monitor_get() without ADC access.
+ *
+ * @note ADC1 oneshot reads (bsp_adc_get_handle()) fail with ESP_ERR_TIMEOUT while the monitor is running.
+ *
+ * @param[in] cfg   configuration (NULL: default)
+ * @return
+ *     - ESP_OK                 On success
+ *     - ESP_ERR_INVALID_STATE  Power monitor is already running
+ *     - ESP_ERR_NO_MEM         No memory
+ *     - ESP_ERR_NOT_SUPPORTED  ADC calibration scheme required eFuse bits not burnt
+ */
+esp_err_t bsp_power_monitor_start(const bsp_power_monitor_cfg_t *cfg);
+
+/**
+ * @brief Stop power monitor
+ *
+ * @return
+ *     - ESP_OK                 On success
+ *     - ESP_ERR_INVALID_STATE  Power monitor is not running
+ */
+esp_err_t bsp_power_monitor_stop(void);
+
+/**
+ * @brief Get the latest voltage of power monitor
+ *
+ * @param channel   measured voltage
+ * @return Voltage in [mV] or -1, if there is no value yet
+ */
+int bsp_power_monitor_get(bsp_power_monitor_channel_t channel);
+
+/**
+ * @brief Set voltage threshold of power monitor
+ *
+ * The threshold callback is called with the first value and then, when the voltage gets above threshold + hysteresis
+ * or below threshold - hysteresis.
+ *
+ * @param channel       measured voltage
+ * @param threshold_mv  threshold in [mV] (0: disabled)
+ * @param hysteresis_mv hysteresis in [mV]
+ * @return
+ *     - ESP_OK                 On success
+ *     - ESP_ERR_INVALID_ARG    Invalid channel or negative values
+ */
+esp_err_t bsp_power_monitor_set_threshold(bsp_power_monitor_channel_t channel, int threshold_mv, int hysteresis_mv);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -103,6 +103,11 @@ typedef enum {
     BSP_LED_NUM
 } bsp_led_t;
 
+#if CONFIG_BSP_LED_TYPE_RGB && CONFIG_BSP_LEDS_NUM > 0
+/* Number of pixels of addressable RGB LED strip */
+#define BSP_LED_STRIP_LEN   (CONFIG_BSP_LED_RGB_STRIP_LEN)
+#endif
+
 /* Default LED effects */
 enum {
     BSP_LED_ON,
@@ -296,6 +301,127 @@ esp_err_t bsp_led_set(led_indicator_handle_t handle, const bool on);
  */
 esp_err_t bsp_led_set_temperature(led_indicator_handle_t handle, const uint16_t temperature);
 
+#if CONFIG_BSP_LED_TYPE_RGB && CONFIG_BSP_LED_RGB_BACKEND_RMT && CONFIG_BSP_LEDS_NUM > 0
+/**************************************************************************************************
+ *
+ * LED strip animations
+ *
+ * Animation is defined by keyframes with colors of all pixels. Frames are blended from keyframes,
+ * gamma corrected and stored when the animation is created. While playing, the frames are
+ * streamed by RMT (with DMA on supported chips) in a single transaction, there is no timer
+ * or task running per animation step.
+ *
+ * @note LED animations and bsp_led_indicator_create() use the same LED strip GPIO,
+ *       do not use them at the same time.
+ **************************************************************************************************/
+
+/**
+ * @brief RGB color of one pixel
+ */
+typedef struct {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} bsp_led_rgb_t;
+
+/**
+ * @brief Blending between keyframes
+ */
+typedef enum {
+    BSP_LED_ANIM_BLEND_LINEAR = 0,  /*!< Crossfade to the next keyframe */
+    BSP_LED_ANIM_BLEND_STEP,        /*!< Hold keyframe until the next one */
+} bsp_led_anim_blend_t;
+
+/**
+ * @brief Animation keyframe
+ */
+typedef struct {
+    const bsp_led_rgb_t *pixels;    /*!< Colors of BSP_LED_STRIP_LEN pixels */
+    uint32_t duration_ms;           /*!< Time from this keyframe to the next one */
+} bsp_led_anim_keyframe_t;
+
+/**
+ * @brief Animation configuration
+ */
+typedef struct {
+    const bsp_led_anim_keyframe_t *keyframes;   /*!< Keyframes, can be freed after bsp_led_anim_new() */
+    size_t keyframe_num;                        /*!< Number of keyframes */
+    uint16_t fps;                               /*!< Frames per second (1-200) */
+    uint8_t brightness;                         /*!< Brightness applied to all colors (0-255) */
+    float gamma;                                /*!< Gamma correction, 0 or 1 disables it */
+    const uint8_t *gamma_lut;                   /*!< Custom LUT of 256 entries, replaces gamma. Can be NULL */
+    bsp_led_anim_blend_t blend;                 /*!< Blending between keyframes */
+    struct {
+        unsigned int loop: 1;                   /*!< Repeat forever, last keyframe blends back to the first one */
+    } flags;
+} bsp_led_anim_config_t;
+
+/**
+ * @brief Default animation configuration
+ */
+#define BSP_LED_ANIM_CONFIG_DEFAULT(kf, kf_num) \
+    {                                           \
+        .keyframes = (kf),                      \
+        .keyframe_num = (kf_num),               \
+        .fps = 50,                              \
+        .brightness = 255,                      \
+        .gamma = 2.2f,                          \
+        .gamma_lut = NULL,                      \
+        .blend = BSP_LED_ANIM_BLEND_LINEAR,     \
+        .flags.loop = 1,                        \
+    }
+
+typedef struct bsp_led_anim_t *bsp_led_anim_handle_t;
+
+/**
+ * @brief Create LED strip animation
+ *
+ * Precomputes all frames, memory needed is (duration * fps * BSP_LED_STRIP_LEN * 3) bytes.
+ *
+ * @param[in]  config   Animation configuration
+ * @param[out] ret_anim Animation handle
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_NO_MEM Not enough memory for frames
+ */
+esp_err_t bsp_led_anim_new(const bsp_led_anim_config_t *config, bsp_led_anim_handle_t *ret_anim);
+
+/**
+ * @brief Delete LED strip animation
+ *
+ * @param[in] anim Animation handle
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - ESP_ERR_INVALID_STATE Animation is playing (call bsp_led_anim_stop() first)
+ */
+esp_err_t bsp_led_anim_del(bsp_led_anim_handle_t anim);
+
+/**
+ * @brief Play LED strip animation
+ *
+ * Stops the playing animation and starts the new one. Not looped animation stays on its last frame.
+ *
+ * @param[in] anim Animation handle
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Parameter error
+ *     - Others RMT driver error
+ */
+esp_err_t bsp_led_anim_play(bsp_led_anim_handle_t anim);
+
+/**
+ * @brief Stop LED strip animation
+ *
+ * @note Pixels keep the colors they latched last.
+ *
+ * @return
+ *     - ESP_OK Success
+ */
+esp_err_t bsp_led_anim_stop(void);
+#endif // CONFIG_BSP_LED_TYPE_RGB && CONFIG_BSP_LED_RGB_BACKEND_RMT && CONFIG_BSP_LEDS_NUM > 0
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,317 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "bsp/esp-bsp.h"
+
+#if CONFIG_BSP_LED_TYPE_RGB && CONFIG_BSP_LED_RGB_BACKEND_RMT && CONFIG_BSP_LEDS_NUM > 0
+#include "driver/rmt_tx.h"
+#include "driver/rmt_encoder.h"
+#include "soc/soc_caps.h"
+
+static const char *TAG = "BSP-LED-anim";
+
+#define BSP_LED_ANIM_RESOLUTION_HZ  (10 * 1000 * 1000)  // 0.1us per tick
+#define BSP_LED_ANIM_BIT_TICKS      (12)                // WS2812 bit is 1.2us
+#define BSP_LED_ANIM_MIN_GAP_TICKS  (3000)              // 300us reset code, enough for WS2812B
+#define BSP_LED_ANIM_SYMBOL_TICKS   (2 * 32767)         // Longest RMT symbol
+#define BSP_LED_ANIM_FRAME_BYTES    (BSP_LED_STRIP_LEN * 3)
+
+#if CONFIG_RMT_ISR_IRAM_SAFE
+#define BSP_LED_ANIM_MEM_CAPS       (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+#define BSP_LED_ANIM_MEM_CAPS       (MALLOC_CAP_DEFAULT)
+#endif
+
+struct bsp_led_anim_t {
+    uint8_t *frames;                    /* Precomputed GRB frames, gamma and brightness applied */
+    size_t frame_num;
+    size_t gap_full;                    /* Number of longest idle symbols after each frame */
+    rmt_symbol_word_t gap_full_symbol;
+    rmt_symbol_word_t gap_tail_symbol;  /* Rest of the frame period */
+    bool loop;
+};
+
+typedef struct {
+    rmt_encoder_t base;
+    rmt_encoder_t *bytes_encoder;
+    rmt_encoder_t *copy_encoder;
+    size_t frame;
+    size_t gap;
+    int state;
+} bsp_led_anim_encoder_t;
+
+static rmt_channel_handle_t bsp_led_anim_chan = NULL;
+static bsp_led_anim_encoder_t *bsp_led_anim_enc = NULL;
+static bsp_led_anim_handle_t bsp_led_anim_playing = NULL;
+
+/* Runs in RMT interrupt, streams frames and idle gaps until the memory block is full */
+static size_t bsp_led_anim_encode(rmt_encoder_t *encoder, rmt_channel_handle_t channel,
+                                  const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state)
+{
+    bsp_led_anim_encoder_t *enc = __containerof(encoder, bsp_led_anim_encoder_t, base);
+    const struct bsp_led_anim_t *anim = primary_data;
+    rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+    rmt_encode_state_t state = RMT_ENCODING_RESET;
+    size_t encoded_symbols = 0;
+
+    while (1) {
+        if (enc->state == 0) {
+            const uint8_t *pixels = anim->frames + enc->frame * BSP_LED_ANIM_FRAME_BYTES;
+            encoded_symbols += enc->bytes_encoder->encode(enc->bytes_encoder, channel, pixels,
+                               BSP_LED_ANIM_FRAME_BYTES, &session_state);
+            if (session_state & RMT_ENCODING_COMPLETE) {
+                enc->state = 1;
+                enc->gap = 0;
+            }
+        } else {
+            const rmt_symbol_word_t *symbol = (enc->gap < anim->gap_full) ? &anim->gap_full_symbol : &anim->gap_tail_symbol;
+            encoded_symbols += enc->copy_encoder->encode(enc->copy_encoder, channel, symbol, sizeof(rmt_symbol_word_t), &session_state);
+            if ((session_state & RMT_ENCODING_COMPLETE) && ++enc->gap > anim->gap_full) {
+                enc->state = 0;
+                if (++enc->frame == anim->frame_num) {
+                    enc->frame = 0;
+                    if (!anim->loop) {
+                        state |= RMT_ENCODING_COMPLETE;
+                        break;
+                    }
+                }
+            }
+        }
+        if (session_state & RMT_ENCODING_MEM_FULL) {
+            state |= RMT_ENCODING_MEM_FULL;
+            break;
+        }
+    }
+
+    *ret_state = state;
+    return encoded_symbols;
+}
+
+static esp_err_t bsp_led_anim_encoder_reset(rmt_encoder_t *encoder)
+{
+    bsp_led_anim_encoder_t *enc = __containerof(encoder, bsp_led_anim_encoder_t, base);
+    rmt_encoder_reset(enc->bytes_encoder);
+    rmt_encoder_reset(enc->copy_encoder);
+    enc->frame = 0;
+    enc->gap = 0;
+    enc->state = 0;
+    return ESP_OK;
+}
+
+static esp_err_t bsp_led_anim_encoder_del(rmt_encoder_t *encoder)
+{
+    bsp_led_anim_encoder_t *enc = __containerof(encoder, bsp_led_anim_encoder_t, base);
+    if (enc->bytes_encoder) {
+        rmt_del_encoder(enc->bytes_encoder);
+    }
+    if (enc->copy_encoder) {
+        rmt_del_encoder(enc->copy_encoder);
+    }
+    free(enc);
+    return ESP_OK;
+}
+
+static esp_err_t bsp_led_anim_hw_init(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    if (bsp_led_anim_chan) {
+        return ESP_OK;
+    }
+
+    const rmt_tx_channel_config_t chan_config = {
+        .gpio_num = CONFIG_BSP_LED_RGB_GPIO,
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = BSP_LED_ANIM_RESOLUTION_HZ,
+#if CONFIG_BSP_LED_ANIM_DMA
+        .mem_block_symbols = 1024,  // DMA buffer, encoder is called on every half of it
+        .flags.with_dma = true,
+#else
+        .mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL,
+#endif
+        .trans_queue_depth = 1,
+    };
+    ESP_RETURN_ON_ERROR(rmt_new_tx_channel(&chan_config, &bsp_led_anim_chan), TAG, "RMT channel create failed");
+
+    bsp_led_anim_enc = calloc(1, sizeof(bsp_led_anim_encoder_t));
+    ESP_GOTO_ON_FALSE(bsp_led_anim_enc, ESP_ERR_NO_MEM, err, TAG, "Not enough memory");
+    bsp_led_anim_enc->base.encode = bsp_led_anim_encode;
+    bsp_led_anim_enc->base.reset = bsp_led_anim_encoder_reset;
+    bsp_led_anim_enc->base.del = bsp_led_anim_encoder_del;
+
+    const rmt_bytes_encoder_config_t bytes_config = {
+        .bit0 = {.level0 = 1, .duration0 = 3, .level1 = 0, .duration1 = 9},    // T0H 0.3us, T0L 0.9us
+        .bit1 = {.level0 = 1, .duration0 = 9, .level1 = 0, .duration1 = 3},    // T1H 0.9us, T1L 0.3us
+        .flags.msb_first = 1,
+    };
+    ESP_GOTO_ON_ERROR(rmt_new_bytes_encoder(&bytes_config, &bsp_led_anim_enc->bytes_encoder), err, TAG, "Bytes encoder create failed");
+    const rmt_copy_encoder_config_t copy_config = {};
+    ESP_GOTO_ON_ERROR(rmt_new_copy_encoder(&copy_config, &bsp_led_anim_enc->copy_encoder), err, TAG, "Copy encoder create failed");
+
+    return ESP_OK;
+
+err:
+    if (bsp_led_anim_enc) {
+        bsp_led_anim_encoder_del(&bsp_led_anim_enc->base);
+        bsp_led_anim_enc = NULL;
+    }
+    rmt_del_channel(bsp_led_anim_chan);
+    bsp_led_anim_chan = NULL;
+    return ret;
+}
+
+esp_err_t bsp_led_anim_new(const bsp_led_anim_config_t *config, bsp_led_anim_handle_t *ret_anim)
+{
+    ESP_RETURN_ON_FALSE(config && ret_anim, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments");
+    ESP_RETURN_ON_FALSE(config->keyframes && config->keyframe_num > 0, ESP_ERR_INVALID_ARG, TAG, "No keyframes");
+    ESP_RETURN_ON_FALSE(config->fps > 0 && config->fps <= 200, ESP_ERR_INVALID_ARG, TAG, "Invalid FPS");
+    for (size_t i = 0; i < config->keyframe_num; i++) {
+        ESP_RETURN_ON_FALSE(config->keyframes[i].pixels, ESP_ERR_INVALID_ARG, TAG, "Keyframe %d without pixels", (int)i);
+    }
+
+    /* Looped animation blends the last keyframe back to the first one, otherwise it ends on the last keyframe */
+    const bool loop = config->flags.loop;
+    const size_t segments = loop ? config->keyframe_num : config->keyframe_num - 1;
+    uint64_t total_ms = 0;
+    for (size_t i = 0; i < segments; i++) {
+        total_ms += config->keyframes[i].duration_ms;
+    }
+    size_t frame_num = (size_t)(total_ms * config->fps / 1000);
+    if (!loop || frame_num == 0) {
+        frame_num++;
+    }
+
+    struct bsp_led_anim_t *anim = calloc(1, sizeof(struct bsp_led_anim_t));
+    ESP_RETURN_ON_FALSE(anim, ESP_ERR_NO_MEM, TAG, "Not enough memory");
+    anim->frames = heap_caps_malloc(frame_num * BSP_LED_ANIM_FRAME_BYTES, BSP_LED_ANIM_MEM_CAPS);
+    if (anim->frames == NULL) {
+        free(anim);
+        ESP_LOGE(TAG, "Not enough memory for %d frames", (int)frame_num);
+        return ESP_ERR_NO_MEM;
+    }
+    anim->frame_num = frame_num;
+    anim->loop = loop;
+
+    /* Gamma and brightness in one LUT */
+    uint8_t lut[256];
+    for (int i = 0; i < 256; i++) {
+        const int scaled = (i * config->brightness + 127) / 255;
+        if (config->gamma_lut) {
+            lut[i] = config->gamma_lut[scaled];
+        } else if (config->gamma > 0.0f && config->gamma != 1.0f) {
+            lut[i] = (uint8_t)(powf(scaled / 255.0f, config->gamma) * 255.0f + 0.5f);
+        } else {
+            lut[i] = (uint8_t)scaled;
+        }
+    }
+
+    /* Blend keyframes into frames */
+    size_t seg = 0;
+    uint64_t seg_start_ms = 0;
+    for (size_t f = 0; f < frame_num; f++) {
+        const uint64_t t_ms = (uint64_t)f * 1000 / config->fps;
+        while (seg < segments && t_ms >= seg_start_ms + config->keyframes[seg].duration_ms) {
+            seg_start_ms += config->keyframes[seg].duration_ms;
+            seg++;
+        }
+        const bsp_led_rgb_t *from;
+        const bsp_led_rgb_t *to;
+        uint32_t alpha = 0; // 0-256
+        if (seg >= segments) {
+            from = to = config->keyframes[config->keyframe_num - 1].pixels;
+        } else {
+            from = config->keyframes[seg].pixels;
+            to = config->keyframes[(seg + 1) % config->keyframe_num].pixels;
+            if (config->blend == BSP_LED_ANIM_BLEND_LINEAR) {
+                alpha = (uint32_t)((t_ms - seg_start_ms) * 256 / config->keyframes[seg].duration_ms);
+            }
+        }
+
+        uint8_t *out = anim->frames + f * BSP_LED_ANIM_FRAME_BYTES;
+        for (int p = 0; p < BSP_LED_STRIP_LEN; p++) {
+            const uint8_t r = (from[p].r * (256 - alpha) + to[p].r * alpha) >> 8;
+            const uint8_t g = (from[p].g * (256 - alpha) + to[p].g * alpha) >> 8;
+            const uint8_t b = (from[p].b * (256 - alpha) + to[p].b * alpha) >> 8;
+            /* WS2812 byte order */
+            *out++ = lut[g];
+            *out++ = lut[r];
+            *out++ = lut[b];
+        }
+    }
+
+    /* Idle line after each frame completes the frame period */
+    const uint32_t data_ticks = BSP_LED_STRIP_LEN * 24 * BSP_LED_ANIM_BIT_TICKS;
+    const uint32_t period_ticks = BSP_LED_ANIM_RESOLUTION_HZ / config->fps;
+    uint32_t gap_ticks = (period_ticks > data_ticks + BSP_LED_ANIM_MIN_GAP_TICKS) ? period_ticks - data_ticks : BSP_LED_ANIM_MIN_GAP_TICKS;
+    if (gap_ticks % BSP_LED_ANIM_SYMBOL_TICKS < 2) {
+        gap_ticks += 2;  // RMT symbol duration 0 is end marker
+    }
+    anim->gap_full = gap_ticks / BSP_LED_ANIM_SYMBOL_TICKS;
+    anim->gap_full_symbol = (rmt_symbol_word_t) {
+        .level0 = 0, .duration0 = BSP_LED_ANIM_SYMBOL_TICKS / 2, .level1 = 0, .duration1 = BSP_LED_ANIM_SYMBOL_TICKS / 2,
+    };
+    const uint32_t tail = gap_ticks % BSP_LED_ANIM_SYMBOL_TICKS;
+    anim->gap_tail_symbol = (rmt_symbol_word_t) {
+        .level0 = 0, .duration0 = tail / 2, .level1 = 0, .duration1 = tail - tail / 2,
+    };
+    if (period_ticks < data_ticks + BSP_LED_ANIM_MIN_GAP_TICKS) {
+        ESP_LOGW(TAG, "%d pixels can't be refreshed at %d FPS", BSP_LED_STRIP_LEN, config->fps);
+    }
+
+    ESP_LOGD(TAG, "Animation of %d frames (%d bytes)", (int)frame_num, (int)(frame_num * BSP_LED_ANIM_FRAME_BYTES));
+    *ret_anim = anim;
+    return ESP_OK;
+}
+
+esp_err_t bsp_led_anim_del(bsp_led_anim_handle_t anim)
+{
+    ESP_RETURN_ON_FALSE(anim, ESP_ERR_INVALID_ARG, TAG, "Invalid animation");
+    ESP_RETURN_ON_FALSE(anim != bsp_led_anim_playing, ESP_ERR_INVALID_STATE, TAG, "Animation is playing");
+    free(anim->frames);
+    free(anim);
+    return ESP_OK;
+}
+
+esp_err_t bsp_led_anim_play(bsp_led_anim_handle_t anim)
+{
+    ESP_RETURN_ON_FALSE(anim, ESP_ERR_INVALID_ARG, TAG, "Invalid animation");
+    ESP_RETURN_ON_ERROR(bsp_led_anim_hw_init(), TAG, "LED animation init failed");
+    ESP_RETURN_ON_ERROR(bsp_led_anim_stop(), TAG, "Stop failed");
+
+    rmt_encoder_reset(&bsp_led_anim_enc->base);
+    ESP_RETURN_ON_ERROR(rmt_enable(bsp_led_anim_chan), TAG, "RMT enable failed");
+    const rmt_transmit_config_t tx_config = {
+        .loop_count = 0,
+    };
+    /* Looped animation is one endless transaction, CPU is involved only by the encoder in RMT interrupt */
+    esp_err_t ret = rmt_transmit(bsp_led_anim_chan, &bsp_led_anim_enc->base, anim, sizeof(struct bsp_led_anim_t), &tx_config);
+    if (ret != ESP_OK) {
+        rmt_disable(bsp_led_anim_chan);
+        ESP_LOGE(TAG, "RMT transmit failed");
+        return ret;
+    }
+    bsp_led_anim_playing = anim;
+    return ESP_OK;
+}
+
+esp_err_t bsp_led_anim_stop(void)
+{
+    if (bsp_led_anim_playing == NULL) {
+        return ESP_OK;
+    }
+    /* Aborts the ongoing transaction */
+    ESP_RETURN_ON_ERROR(rmt_disable(bsp_led_anim_chan), TAG, "RMT disable failed");
+    bsp_led_anim_playing = NULL;
+    return ESP_OK;
+}
+#endif // CONFIG_BSP_LED_TYPE_RGB && CONFIG_BSP_LED_RGB_BACKEND_RMT && CONFIG_BSP_LEDS_NUM > 0
@@ -202,7 +202,7 @@ static led_indicator_gpio_config_t bsp_leds_gpio_config[] = {
 #if CONFIG_BSP_LED_TYPE_RGB && CONFIG_BSP_LEDS_NUM > 0
 static const led_strip_config_t bsp_leds_rgb_strip_config = {
     .strip_gpio_num = CONFIG_BSP_LED_RGB_GPIO,   // The GPIO that connected to the LED strip's data line
-    .max_leds = BSP_LED_NUM,                  // The number of LEDs in the strip,
+    .max_leds = BSP_LED_STRIP_LEN,            // The number of LEDs in the strip,
     .led_model = LED_MODEL_WS2812,            // LED strip model
     .flags.invert_out = false,                // whether to invert the output signal
 };
@@ -434,11 +434,32 @@ esp_err_t bsp_sdcard_unmount(void)
 #define LCD_CMD_BITS           CONFIG_BSP_DISPLAY_CMD_BITS
 #define LCD_PARAM_BITS         CONFIG_BSP_DISPLAY_PARAM_BITS
 
+#if CONFIG_BSP_DISPLAY_ROTATION_MIRROR_X
+#define BSP_LCD_MIRROR_X       (true)
+#else
+#define BSP_LCD_MIRROR_X       (false)
+#endif
+#if CONFIG_BSP_DISPLAY_ROTATION_MIRROR_Y
+#define BSP_LCD_MIRROR_Y       (true)
+#else
+#define BSP_LCD_MIRROR_Y       (false)
+#endif
+#if CONFIG_BSP_DISPLAY_ROTATION_SWAP_XY
+#define BSP_LCD_SWAP_XY        (true)
+#else
+#define BSP_LCD_SWAP_XY        (false)
+#endif
+#if CONFIG_BSP_DISPLAY_INVERT_COLOR
+#define BSP_LCD_INVERT_COLOR   (true)
+#else
+#define BSP_LCD_INVERT_COLOR   (false)
+#endif
+
 esp_err_t bsp_display_brightness_init(void)
 {
 #if CONFIG_BSP_DISPLAY_BRIGHTNESS_LEDC_CH
     // Setup LEDC peripheral for PWM backlight control
-    const ledc_channel_config_t LCD_backlight_channel = {
+    static const ledc_channel_config_t LCD_backlight_channel = {
         .gpio_num = BSP_LCD_BACKLIGHT,
         .speed_mode = LEDC_LOW_SPEED_MODE,
         .channel = CONFIG_BSP_DISPLAY_BRIGHTNESS_LEDC_CH,
@@ -447,7 +468,7 @@ esp_err_t bsp_display_brightness_init(void)
         .duty = 0,
         .hpoint = 0
     };
-    const ledc_timer_config_t LCD_backlight_timer = {
+    static const ledc_timer_config_t LCD_backlight_timer = {
         .speed_mode = LEDC_LOW_SPEED_MODE,
         .duty_resolution = LEDC_TIMER_10_BIT,
         .timer_num = 1,
@@ -501,6 +522,16 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
     ESP_RETURN_ON_ERROR(bsp_display_brightness_init(), TAG, "Brightness init failed");
 
     ESP_LOGD(TAG, "Initialize SPI bus");
+#if CONFIG_BSP_DISPLAY_INTERFACE_QSPI
+    const spi_bus_config_t buscfg = {
+        .sclk_io_num = BSP_LCD_PCLK,
+        .data0_io_num = BSP_LCD_DATA0,
+        .data1_io_num = BSP_LCD_DATA1,
+        .data2_io_num = BSP_LCD_DATA2,
+        .data3_io_num = BSP_LCD_DATA3,
+        .max_transfer_sz = config->max_transfer_sz,
+    };
+#else
     const spi_bus_config_t buscfg = {
         .sclk_io_num = BSP_LCD_PCLK,
         .mosi_io_num = BSP_LCD_DATA0,
@@ -509,6 +540,7 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
         .quadhd_io_num = GPIO_NUM_NC,
         .max_transfer_sz = config->max_transfer_sz,
     };
+#endif
     ESP_RETURN_ON_ERROR(spi_bus_initialize(BSP_LCD_SPI_NUM, &buscfg, SPI_DMA_CH_AUTO), TAG, "SPI init failed");
 
     ESP_LOGD(TAG, "Install panel IO");
@@ -519,15 +551,27 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
         .lcd_cmd_bits = LCD_CMD_BITS,
         .lcd_param_bits = LCD_PARAM_BITS,
         .spi_mode = 0,
-        .trans_queue_depth = 10,
+        .trans_queue_depth = (config->trans_queue_depth > 0) ? config->trans_queue_depth :
+                             BSP_LCD_TRANS_QUEUE_DEPTH(BSP_LCD_H_RES * BSP_LCD_V_RES * BSP_LCD_BITS_PER_PIXEL / 8, config->max_transfer_sz),
+#if CONFIG_BSP_DISPLAY_INTERFACE_QSPI
+        .flags.quad_mode = true,
+#endif
     };
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)BSP_LCD_SPI_NUM, &io_config, ret_io), err, TAG, "New panel IO failed");
 
     ESP_LOGD(TAG, "Install LCD driver");
-    const esp_lcd_panel_dev_config_t panel_config = {
+#if CONFIG_BSP_DISPLAY_DRIVER_GC9A01 && CONFIG_BSP_DISPLAY_INTERFACE_QSPI
+    static const gc9a01_vendor_config_t vendor_config = {
+        .flags.use_qspi_interface = 1,
+    };
+#endif
+    static const esp_lcd_panel_dev_config_t panel_config = {
         .reset_gpio_num = BSP_LCD_RST,
         .color_space = BSP_LCD_COLOR_SPACE,
         .bits_per_pixel = BSP_LCD_BITS_PER_PIXEL,
+#if CONFIG_BSP_DISPLAY_DRIVER_GC9A01 && CONFIG_BSP_DISPLAY_INTERFACE_QSPI
+        .vendor_config = (void *) &vendor_config,
+#endif
     };
 #if CONFIG_BSP_DISPLAY_DRIVER_ST7789
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_st7789(*ret_io, &panel_config, ret_panel), err, TAG, "New panel failed");
@@ -542,26 +586,10 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
     esp_lcd_panel_reset(*ret_panel);
     esp_lcd_panel_init(*ret_panel);
 
-    bool disp_swap_xy = false;
-    bool disp_mirror_x = false;
-    bool disp_mirror_y = false;
-    bool disp_invert_color = false;
-#if CONFIG_BSP_DISPLAY_ROTATION_SWAP_XY
-    disp_swap_xy = true;
-#endif
-#if CONFIG_BSP_DISPLAY_ROTATION_MIRROR_X
-    disp_mirror_x = true;
-#endif
-#if CONFIG_BSP_DISPLAY_ROTATION_MIRROR_Y
-    disp_mirror_y = true;
-#endif
-#if CONFIG_BSP_DISPLAY_INVERT_COLOR
-    disp_invert_color = true;
-#endif
-
-    esp_lcd_panel_mirror(*ret_panel, disp_mirror_x, disp_mirror_y);
-    esp_lcd_panel_swap_xy(*ret_panel, disp_swap_xy);
-    esp_lcd_panel_invert_color(*ret_panel, disp_invert_color);
+    /* Always sent, init sequences of some panels already mirror or invert */
+    esp_lcd_panel_mirror(*ret_panel, BSP_LCD_MIRROR_X, BSP_LCD_MIRROR_Y);
+    esp_lcd_panel_swap_xy(*ret_panel, BSP_LCD_SWAP_XY);
+    esp_lcd_panel_invert_color(*ret_panel, BSP_LCD_INVERT_COLOR);
     return ret;
 
 err:
@@ -579,8 +607,11 @@ static lv_display_t *bsp_display_lcd_init(void)
 {
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
+    const int max_transfer_sz = (BSP_LCD_H_RES * CONFIG_BSP_LCD_DRAW_BUF_HEIGHT) * sizeof(uint16_t);
     const bsp_display_config_t bsp_disp_cfg = {
-        .max_transfer_sz = (BSP_LCD_H_RES * CONFIG_BSP_LCD_DRAW_BUF_HEIGHT) * sizeof(uint16_t),
+        .max_transfer_sz = max_transfer_sz,
+        /* Whole draw buffer is queued at once, so the flush callback does not wait for the bus */
+        .trans_queue_depth = BSP_LCD_TRANS_QUEUE_DEPTH(BSP_LCD_H_RES * CONFIG_BSP_LCD_DRAW_BUF_HEIGHT * sizeof(uint16_t), max_transfer_sz),
     };
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new(&bsp_disp_cfg, &panel_handle, &io_handle));
 
@@ -632,7 +663,7 @@ esp_err_t bsp_touch_new(const bsp_touch_config_t *config, esp_lcd_touch_handle_t
     BSP_ERROR_CHECK_RETURN_ERR(bsp_i2c_init());
 
     /* Initialize touch */
-    const esp_lcd_touch_config_t tp_cfg = {
+    static const esp_lcd_touch_config_t tp_cfg = {
         .x_max = BSP_LCD_H_RES,
         .y_max = BSP_LCD_V_RES,
         .rst_gpio_num = BSP_LCD_TOUCH_RST,
@@ -12,6 +12,9 @@
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_vendor.h"
 #include "esp_lcd_panel_ops.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "driver/spi_master.h"
 #include "driver/ledc.h"
 
@@ -233,7 +236,8 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
         .lcd_cmd_bits = LCD_CMD_BITS,
         .lcd_param_bits = LCD_PARAM_BITS,
         .spi_mode = 0,
-        .trans_queue_depth = 10,
+        .trans_queue_depth = (config->trans_queue_depth > 0) ? config->trans_queue_depth :
+                             BSP_LCD_TRANS_QUEUE_DEPTH(BSP_LCD_H_RES * BSP_LCD_V_RES * BSP_LCD_BITS_PER_PIXEL / 8, config->max_transfer_sz),
     };
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)BSP_LCD_SPI_NUM, &io_config, ret_io), err, TAG, "New panel IO failed");
 
@@ -263,14 +267,145 @@ err:
     return ret;
 }
 
+struct bsp_display_fb_t {
+    esp_lcd_panel_handle_t panel;
+    esp_lcd_panel_io_handle_t io;
+    size_t buffer_size;
+    void *buf[2];
+    int next;                       /* Buffer returned by the next acquire */
+    bool acquired;
+    SemaphoreHandle_t free_bufs;    /* Counts buffers not being sent */
+};
+
+#define BSP_FB_TIMEOUT_TICKS(ms)    ((ms) == 0 ? portMAX_DELAY : pdMS_TO_TICKS(ms))
+
+static IRAM_ATTR bool bsp_display_fb_trans_done(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+    struct bsp_display_fb_t *fb = (struct bsp_display_fb_t *)user_ctx;
+    BaseType_t need_yield = pdFALSE;
+    xSemaphoreGiveFromISR(fb->free_bufs, &need_yield);
+    return need_yield == pdTRUE;
+}
+
+esp_err_t bsp_display_fb_new(const bsp_display_fb_config_t *config, bsp_display_fb_handle_t *ret_fb)
+{
+    ESP_RETURN_ON_FALSE(config && config->panel && config->io && config->buffer_size > 0 && ret_fb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+    /* Transfer done callback can be set only in panel IO config */
+    return ESP_ERR_NOT_SUPPORTED;
+#else
+    esp_err_t ret = ESP_OK;
+    struct bsp_display_fb_t *fb = calloc(1, sizeof(struct bsp_display_fb_t));
+    ESP_RETURN_ON_FALSE(fb, ESP_ERR_NO_MEM, TAG, "Not enough memory for framebuffer");
+    fb->panel = config->panel;
+    fb->io = config->io;
+    fb->buffer_size = config->buffer_size;
+    for (int i = 0; i < 2; i++) {
+        fb->buf[i] = heap_caps_malloc(config->buffer_size, MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(fb->buf[i], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for framebuffer");
+    }
+    fb->free_bufs = xSemaphoreCreateCounting(2, 2);
+    ESP_GOTO_ON_FALSE(fb->free_bufs, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for framebuffer");
+    const esp_lcd_panel_io_callbacks_t cbs = {
+        .on_color_trans_done = bsp_display_fb_trans_done,
+    };
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_io_register_event_callbacks(fb->io, &cbs, fb), err, TAG, "Register callback failed");
+
+    *ret_fb = fb;
+    return ESP_OK;
+
+err:
+    if (fb->free_bufs) {
+        vSemaphoreDelete(fb->free_bufs);
+    }
+    free(fb->buf[0]);
+    free(fb->buf[1]);
+    free(fb);
+    return ret;
+#endif
+}
+
+void *bsp_display_fb_acquire(bsp_display_fb_handle_t fb, uint32_t timeout_ms)
+{
+    assert(fb != NULL);
+    if (!fb->acquired) {
+        if (xSemaphoreTake(fb->free_bufs, BSP_FB_TIMEOUT_TICKS(timeout_ms)) != pdTRUE) {
+            return NULL;
+        }
+        fb->acquired = true;
+    }
+    return fb->buf[fb->next];
+}
+
+esp_err_t bsp_display_fb_present(bsp_display_fb_handle_t fb, int x_start, int y_start, int x_end, int y_end)
+{
+    assert(fb != NULL);
+    ESP_RETURN_ON_FALSE(fb->acquired, ESP_ERR_INVALID_STATE, TAG, "No buffer acquired");
+    ESP_RETURN_ON_FALSE(x_end > x_start && y_end > y_start &&
+                        (size_t)(x_end - x_start) * (y_end - y_start) * BSP_LCD_BITS_PER_PIXEL / 8 <= fb->buffer_size,
+                        ESP_ERR_INVALID_SIZE, TAG, "Area does not fit the buffer");
+
+    const esp_err_t ret = esp_lcd_panel_draw_bitmap(fb->panel, x_start, y_start, x_end, y_end, fb->buf[fb->next]);
+    fb->acquired = false;
+    if (ret != ESP_OK) {
+        /* No transfer, the buffer is free again */
+        xSemaphoreGive(fb->free_bufs);
+        return ret;
+    }
+    fb->next ^= 1;
+    return ESP_OK;
+}
+
+esp_err_t bsp_display_fb_wait(bsp_display_fb_handle_t fb, uint32_t timeout_ms)
+{
+    assert(fb != NULL);
+    const TickType_t timeout = BSP_FB_TIMEOUT_TICKS(timeout_ms);
+    const TickType_t start = xTaskGetTickCount();
+    const int busy = fb->acquired ? 1 : 2;
+    int taken = 0;
+
+    /* All buffers are free when their semaphores can be taken */
+    for (; taken < busy; taken++) {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        const TickType_t wait = (timeout == portMAX_DELAY) ? portMAX_DELAY : (elapsed < timeout ? timeout - elapsed : 0);
+        if (xSemaphoreTake(fb->free_bufs, wait) != pdTRUE) {
+            break;
+        }
+    }
+    for (int i = 0; i < taken; i++) {
+        xSemaphoreGive(fb->free_bufs);
+    }
+    return (taken == busy) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+esp_err_t bsp_display_fb_del(bsp_display_fb_handle_t fb)
+{
+    if (fb == NULL) {
+        return ESP_OK;
+    }
+    bsp_display_fb_wait(fb, 0);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    const esp_lcd_panel_io_callbacks_t no_cbs = {0};
+    esp_lcd_panel_io_register_event_callbacks(fb->io, &no_cbs, NULL);
+#endif
+    vSemaphoreDelete(fb->free_bufs);
+    free(fb->buf[0]);
+    free(fb->buf[1]);
+    free(fb);
+    return ESP_OK;
+}
+
 #if (BSP_CONFIG_NO_GRAPHIC_LIB == 0)
 static lv_display_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
 {
     assert(cfg != NULL);
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
+    const int max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t);
     const bsp_display_config_t bsp_disp_cfg = {
-        .max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t),
+        .max_transfer_sz = max_transfer_sz,
+        /* Whole draw buffer is queued at once, so the flush callback does not wait for the bus */
+        .trans_queue_depth = BSP_LCD_TRANS_QUEUE_DEPTH(cfg->buffer_size * sizeof(uint16_t), max_transfer_sz),
     };
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new(&bsp_disp_cfg, &panel_handle, &io_handle));
 
@@ -15,6 +15,8 @@
  */
 
 #pragma once
+#include <stddef.h>
+#include <stdint.h>
 #include "esp_lcd_types.h"
 #include "sdkconfig.h"
 
@@ -42,12 +44,22 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Panel IO transactions needed to queue a flush of flush_sz bytes without waiting
+ *
+ * Color data of one esp_lcd_panel_draw_bitmap() is split into transactions of max_transfer_sz bytes.
+ * When the queue is shorter, the call blocks until the first transactions are sent.
+ */
+#define BSP_LCD_TRANS_QUEUE_DEPTH(flush_sz, max_transfer_sz) (((flush_sz) + (max_transfer_sz) - 1) / (max_transfer_sz))
+
 /**
  * @brief BSP display configuration structure
  *
  */
 typedef struct {
     int max_transfer_sz;    /*!< Maximum transfer size, in bytes. */
+    int trans_queue_depth;  /*!< Panel IO transaction queue depth, 0 to queue a full frame without waiting.
+                                 Use BSP_LCD_TRANS_QUEUE_DEPTH() for the size of the draw buffer */
 } bsp_display_config_t;
 
 /**
@@ -123,6 +135,96 @@ esp_err_t bsp_display_backlight_on(void);
  */
 esp_err_t bsp_display_backlight_off(void);
 
+/**
+ * @brief BSP display framebuffer configuration structure
+ *
+ */
+typedef struct {
+    esp_lcd_panel_handle_t panel;       /*!< Panel created by bsp_display_new() */
+    esp_lcd_panel_io_handle_t io;       /*!< Panel IO created by bsp_display_new() */
+    size_t buffer_size;                 /*!< Size of each of the two DMA buffers, in bytes. Must not exceed max_transfer_sz of the display */
+} bsp_display_fb_config_t;
+
+typedef struct bsp_display_fb_t *bsp_display_fb_handle_t;  /*!< Handle of display framebuffer */
+
+/**
+ * @brief Create framebuffer for drawing without graphical library
+ *
+ * Two DMA buffers are used in turn: the application draws into one buffer while the other one is being sent to the display.
+ * The buffer is released in the color transfer done callback of the panel IO, so the callback must not be used by the application.
+ *
+ * \code{.c}
+ * for (int y = 0; y < BSP_LCD_V_RES; y += lines) {
+ *     uint16_t *buf = bsp_display_fb_acquire(fb, 0);
+ *     render_lines(buf, y, lines);
+ *     bsp_display_fb_present(fb, 0, y, BSP_LCD_H_RES, y + lines);
+ * }
+ * \endcode
+ *
+ * @param[in]  config    framebuffer configuration
+ * @param[out] ret_fb    framebuffer handle
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Parameter error
+ *      - ESP_ERR_NO_MEM        Not enough DMA memory
+ *      - ESP_ERR_NOT_SUPPORTED ESP-IDF older than v5.0
+ */
+esp_err_t bsp_display_fb_new(const bsp_display_fb_config_t *config, bsp_display_fb_handle_t *ret_fb);
+
+/**
+ * @brief Get buffer for drawing
+ *
+ * Waits until the transfer of the previous content of the buffer is done.
+ * Calling it again before bsp_display_fb_present() returns the same buffer.
+ *
+ * @param[in] fb         framebuffer handle
+ * @param[in] timeout_ms timeout in milliseconds, 0 waits forever
+ * @return
+ *      - Pointer to DMA buffer of buffer_size bytes
+ *      - NULL on timeout
+ */
+void *bsp_display_fb_acquire(bsp_display_fb_handle_t fb, uint32_t timeout_ms);
+
+/**
+ * @brief Send the acquired buffer to the display area
+ *
+ * The function returns after the transfer is queued, the buffer must not be used until it is acquired again.
+ *
+ * @param[in] fb      framebuffer handle
+ * @param[in] x_start start column (inclusive)
+ * @param[in] y_start start row (inclusive)
+ * @param[in] x_end   end column (exclusive)
+ * @param[in] y_end   end row (exclusive)
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE No buffer acquired
+ *      - ESP_ERR_INVALID_SIZE  Area is larger than the buffer
+ *      - Else                  esp_lcd failure
+ */
+esp_err_t bsp_display_fb_present(bsp_display_fb_handle_t fb, int x_start, int y_start, int x_end, int y_end);
+
+/**
+ * @brief Wait until all presented buffers are sent to the display
+ *
+ * @param[in] fb         framebuffer handle
+ * @param[in] timeout_ms timeout in milliseconds, 0 waits forever
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_TIMEOUT       Transfers are not done in time
+ */
+esp_err_t bsp_display_fb_wait(bsp_display_fb_handle_t fb, uint32_t timeout_ms);
+
+/**
+ * @brief Delete framebuffer
+ *
+ * Waits for the running transfers and removes the panel IO callback. The panel and IO are not deleted.
+ *
+ * @param[in] fb framebuffer handle
+ * @return
+ *      - ESP_OK                On success
+ */
+esp_err_t bsp_display_fb_del(bsp_display_fb_handle_t fb);
+
 #ifdef __cplusplus
 }
 #endif
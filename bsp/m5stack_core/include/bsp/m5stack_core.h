@@ -196,6 +196,37 @@ esp_err_t bsp_sdcard_mount(void);
  */
 esp_err_t bsp_sdcard_unmount(void);
 
+/**
+ * @brief Statistics of the SPI bus shared by the LCD and the SD card
+ */
+typedef struct {
+    uint32_t sd_reads;          /*!< Multiple block reads of the SD card */
+    uint32_t sd_chunks;         /*!< SD card transactions sent to the bus (long reads are split) */
+    uint64_t sd_wait_us;        /*!< Time the SD card waited for display flushes */
+    uint64_t sd_busy_us;        /*!< Time the SD card held the bus */
+    uint32_t lcd_flushes;       /*!< Color transfers to the LCD */
+    uint64_t lcd_wait_us;       /*!< Time the color transfers waited to be queued (behind the SD card or previous flush) */
+} bsp_spi_bus_stats_t;
+
+/**
+ * @brief Give display flushes priority on the SPI bus shared with the SD card
+ *
+ * The SD card and the LCD share one SPI host. Long SD card reads are always split into
+ * CONFIG_BSP_SD_SPI_CHUNK_SECTORS sectors, so the display can use the bus between them.
+ * With priority (e.g. during animations), the next SD chunk waits until the pending flush is queued.
+ *
+ * @param[in] enable true to give display flushes priority
+ */
+void bsp_spi_bus_display_priority(bool enable);
+
+/**
+ * @brief Get statistics of the SPI bus shared by the LCD and the SD card
+ *
+ * @param[out] stats Statistics since the start or the last reset
+ * @param[in]  reset Reset the statistics after reading
+ */
+void bsp_spi_bus_get_stats(bsp_spi_bus_stats_t *stats, bool reset);
+
 /**************************************************************************************************
  *
  * LCD interface
@@ -4,11 +4,16 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <esp_err.h>
 #include <esp_log.h>
 #include <esp_check.h>
 #include <esp_spiffs.h>
 #include <esp_vfs_fat.h>
+#include <sdmmc_cmd.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 #include <driver/gpio.h>
 #include <driver/i2c_master.h>
@@ -18,6 +23,7 @@
 #include <driver/ledc.h>
 
 #include <esp_lcd_panel_io.h>
+#include <esp_lcd_panel_io_interface.h>
 #include <esp_lcd_panel_vendor.h>
 #include <esp_lcd_panel_ops.h>
 
@@ -46,6 +52,14 @@ static bool i2c_initialized = false;
 static i2c_master_dev_handle_t ip5306_h = NULL;
 static bool spi_initialized = false;
 
+/* Arbitration of the SPI bus shared by the LCD and the SD card */
+static portMUX_TYPE spi_bus_lock = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t lcd_idle_sem = NULL;
+static volatile uint32_t lcd_pending = 0;
+static bool lcd_priority = false;
+static bsp_spi_bus_stats_t spi_bus_stats;
+static esp_err_t (*lcd_tx_color)(esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size) = NULL;
+
 esp_err_t bsp_i2c_init(void)
 {
     /* I2C was initialized before */
@@ -127,11 +141,108 @@ static esp_err_t bsp_spi_init(uint32_t max_transfer_sz)
     };
     ESP_RETURN_ON_ERROR(spi_bus_initialize(BSP_LCD_SPI_NUM, &buscfg, SPI_DMA_CH_AUTO), TAG, "SPI init failed");
 
+    if (lcd_idle_sem == NULL) {
+        lcd_idle_sem = xSemaphoreCreateBinary();
+        ESP_RETURN_ON_FALSE(lcd_idle_sem, ESP_ERR_NO_MEM, TAG, "Not enough memory");
+    }
     spi_initialized = true;
 
     return ESP_OK;
 }
 
+void bsp_spi_bus_display_priority(bool enable)
+{
+    lcd_priority = enable;
+}
+
+void bsp_spi_bus_get_stats(bsp_spi_bus_stats_t *stats, bool reset)
+{
+    assert(stats);
+    portENTER_CRITICAL(&spi_bus_lock);
+    *stats = spi_bus_stats;
+    if (reset) {
+        memset(&spi_bus_stats, 0, sizeof(spi_bus_stats));
+    }
+    portEXIT_CRITICAL(&spi_bus_lock);
+}
+
+/* Color transfers of the LCD are counted, so the SD card can leave them the bus */
+static esp_err_t bsp_lcd_tx_color(esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size)
+{
+    portENTER_CRITICAL(&spi_bus_lock);
+    lcd_pending++;
+    portEXIT_CRITICAL(&spi_bus_lock);
+
+    const int64_t start = esp_timer_get_time();
+    esp_err_t ret = lcd_tx_color(io, lcd_cmd, color, color_size);
+    const int64_t wait = esp_timer_get_time() - start;
+
+    portENTER_CRITICAL(&spi_bus_lock);
+    const bool idle = (--lcd_pending == 0);
+    spi_bus_stats.lcd_flushes++;
+    spi_bus_stats.lcd_wait_us += wait;
+    portEXIT_CRITICAL(&spi_bus_lock);
+    if (idle) {
+        xSemaphoreGive(lcd_idle_sem);
+    }
+    return ret;
+}
+
+/* One transaction of the SD card, it waits for pending flushes when the display has priority */
+static esp_err_t bsp_sdspi_do_chunk(int slot, sdmmc_command_t *cmdinfo)
+{
+    const int64_t start = esp_timer_get_time();
+    while (lcd_priority && lcd_pending > 0) {
+        /* Timeout only guards against a missed wake up */
+        xSemaphoreTake(lcd_idle_sem, pdMS_TO_TICKS(10));
+    }
+    const int64_t begin = esp_timer_get_time();
+    esp_err_t ret = sdspi_host_do_transaction(slot, cmdinfo);
+    const int64_t end = esp_timer_get_time();
+
+    portENTER_CRITICAL(&spi_bus_lock);
+    spi_bus_stats.sd_chunks++;
+    spi_bus_stats.sd_wait_us += begin - start;
+    spi_bus_stats.sd_busy_us += end - begin;
+    portEXIT_CRITICAL(&spi_bus_lock);
+    return ret;
+}
+
+/* The SD card holds the bus for a whole command, long reads are split so the display is not blocked */
+static esp_err_t bsp_sdspi_do_transaction(int slot, sdmmc_command_t *cmdinfo)
+{
+    const size_t chunk_len = CONFIG_BSP_SD_SPI_CHUNK_SECTORS * cmdinfo->blklen;
+    if (cmdinfo->opcode != MMC_READ_BLOCK_MULTIPLE || bsp_sdcard == NULL || cmdinfo->blklen == 0 || cmdinfo->datalen <= chunk_len) {
+        return bsp_sdspi_do_chunk(slot, cmdinfo);
+    }
+
+    /* Argument is the block number for SDHC/SDXC, byte address for SDSC */
+    const bool block_addressing = (bsp_sdcard->ocr & SD_OCR_SDHC_CAP) != 0;
+    sdmmc_command_t chunk = *cmdinfo;
+    uint8_t *data = cmdinfo->data;
+    size_t remain = cmdinfo->datalen;
+    esp_err_t ret = ESP_OK;
+
+    portENTER_CRITICAL(&spi_bus_lock);
+    spi_bus_stats.sd_reads++;
+    portEXIT_CRITICAL(&spi_bus_lock);
+    while (remain > 0 && ret == ESP_OK) {
+        chunk.data = data;
+        chunk.datalen = (remain < chunk_len) ? remain : chunk_len;
+        chunk.error = ESP_OK;
+        ret = bsp_sdspi_do_chunk(slot, &chunk);
+        if (ret == ESP_OK) {
+            ret = chunk.error;
+        }
+        chunk.arg += block_addressing ? (chunk.datalen / cmdinfo->blklen) : chunk.datalen;
+        data += chunk.datalen;
+        remain -= chunk.datalen;
+    }
+    memcpy(cmdinfo->response, chunk.response, sizeof(cmdinfo->response));
+    cmdinfo->error = chunk.error;
+    return ret;
+}
+
 esp_err_t bsp_spiffs_mount(void)
 {
     esp_vfs_spiffs_conf_t conf = {
@@ -179,6 +290,8 @@ esp_err_t bsp_sdcard_mount(void)
 
     sdmmc_host_t host = SDSPI_HOST_DEFAULT();
     host.slot = BSP_LCD_SPI_NUM;
+    /* SPI bus is shared with the LCD */
+    host.do_transaction = bsp_sdspi_do_transaction;
     sdspi_device_config_t slot_config = SDSPI_DEVICE_CONFIG_DEFAULT();
     slot_config.gpio_cs = BSP_SD_CS;
     slot_config.host_id = host.slot;
@@ -286,10 +399,14 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
         .lcd_cmd_bits      = LCD_CMD_BITS,
         .lcd_param_bits    = LCD_PARAM_BITS,
         .spi_mode          = 0,
-        .trans_queue_depth = 10,
+        .trans_queue_depth = (config->trans_queue_depth > 0) ? config->trans_queue_depth :
+                             BSP_LCD_TRANS_QUEUE_DEPTH(BSP_LCD_H_RES * BSP_LCD_V_RES * BSP_LCD_BITS_PER_PIXEL / 8, config->max_transfer_sz),
     };
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)BSP_LCD_SPI_NUM, &io_config, ret_io), err, TAG,
                       "New panel IO failed");
+    /* Color transfers are tracked by the arbitration of the SPI bus shared with the SD card */
+    lcd_tx_color = (*ret_io)->tx_color;
+    (*ret_io)->tx_color = bsp_lcd_tx_color;
 
     ESP_LOGI(TAG, "Install LCD driver");
     const esp_lcd_panel_dev_config_t panel_config = {
@@ -326,8 +443,11 @@ static lv_display_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
     assert(cfg != NULL);
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
+    const int max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t);
     const bsp_display_config_t bsp_disp_cfg = {
-        .max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t),
+        .max_transfer_sz = max_transfer_sz,
+        /* Whole draw buffer is queued at once, so the flush callback does not wait for the bus */
+        .trans_queue_depth = BSP_LCD_TRANS_QUEUE_DEPTH(cfg->buffer_size * sizeof(uint16_t), max_transfer_sz),
     };
 
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new(&bsp_disp_cfg, &panel_handle, &io_handle));
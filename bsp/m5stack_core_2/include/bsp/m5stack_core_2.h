@@ -250,6 +250,29 @@ esp_err_t bsp_sdcard_unmount(void);
 #define BSP_LCD_PIXEL_CLOCK_HZ     (40 * 1000 * 1000)
 #define BSP_LCD_SPI_NUM            (SPI2_HOST)
 
+/**
+ * @brief Set display enter sleep mode
+ *
+ * The LCD enters sleep mode (its memory keeps the frame) and the backlight rail is gated.
+ * The touch stays powered, so it can be used to wake up the application.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Display is not initialized
+ *      - Others                LCD or PMU error
+ */
+esp_err_t bsp_display_enter_sleep(void);
+
+/**
+ * @brief Set display exit sleep mode
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE Display is not initialized
+ *      - Others                LCD or PMU error
+ */
+esp_err_t bsp_display_exit_sleep(void);
+
 
 #if (BSP_CONFIG_NO_GRAPHIC_LIB == 0)
 #define BSP_LCD_DRAW_BUFF_SIZE     (BSP_LCD_H_RES * 50)
@@ -356,6 +379,97 @@ typedef enum {
 
 esp_err_t bsp_feature_enable(bsp_feature_t feature, bool enable);
 
+/**************************************************************************************************
+ *
+ * PMU power rails
+ *
+ * Power rails of AXP192 (Core2 v1.0) or AXP2101 (Core2 v1.1) can be gated and their voltage can be set at runtime.
+ * The BSP keeps cached copy of PMU registers, so only changed registers are sent over I2C. Changes made between
+ * bsp_pmu_batch_begin() and bsp_pmu_batch_commit() are sent in one I2C transaction.
+ *
+ * LCD logic, touch controller and SD card share one rail. bsp_feature_enable() keeps it powered while any of these
+ * features is enabled.
+ *
+ * @note PMU registers must not be written by other means than this API, otherwise the cache is not valid.
+ **************************************************************************************************/
+
+/**
+ * @brief PMU power rails
+ */
+typedef enum {
+    BSP_PMU_RAIL_LCD_BACKLIGHT, /*!< LCD backlight (AXP192 DCDC3 / AXP2101 BLDO1) */
+    BSP_PMU_RAIL_PERIPH,        /*!< LCD logic, touch and SD card (AXP192 LDO2 / AXP2101 ALDO4) */
+    BSP_PMU_RAIL_SPEAKER,       /*!< Speaker amplifier (AXP192 GPIO2 enable / AXP2101 ALDO3) */
+    BSP_PMU_RAIL_VIBRATION,     /*!< Vibration motor (AXP192 LDO3 / AXP2101 DLDO1) */
+} bsp_pmu_rail_t;
+
+/**
+ * @brief Enable or disable PMU power rail
+ *
+ * Enabled rail is set to the voltage from bsp_pmu_rail_set_voltage() (3.3 V by default).
+ *
+ * @param[in] rail   Power rail
+ * @param[in] enable true to power the rail, false to gate it
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Invalid rail
+ *      - Others                I2C error
+ */
+esp_err_t bsp_pmu_rail_enable(bsp_pmu_rail_t rail, bool enable);
+
+/**
+ * @brief Set voltage of PMU power rail
+ *
+ * The voltage is rounded down to the step of the regulator. When the rail is disabled, the voltage is used when it is
+ * enabled again.
+ *
+ * @param[in] rail       Power rail
+ * @param[in] voltage_mv Voltage in [mV]
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Invalid rail or voltage out of range of the regulator
+ *      - ESP_ERR_NOT_SUPPORTED Voltage of the rail cannot be set (AXP192 speaker)
+ *      - Others                I2C error
+ */
+esp_err_t bsp_pmu_rail_set_voltage(bsp_pmu_rail_t rail, uint32_t voltage_mv);
+
+/**
+ * @brief Get state of PMU power rail
+ *
+ * @param[in]  rail       Power rail
+ * @param[out] enabled    Rail is powered (can be NULL)
+ * @param[out] voltage_mv Voltage of the rail in [mV], 0 if it cannot be set (can be NULL)
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   Invalid rail
+ *      - Others                I2C error
+ */
+esp_err_t bsp_pmu_rail_get(bsp_pmu_rail_t rail, bool *enabled, uint32_t *voltage_mv);
+
+/**
+ * @brief Start batch of PMU changes
+ *
+ * PMU changes of this task (rails, features, brightness) are kept in the cache until bsp_pmu_batch_commit().
+ * Other tasks wait for the commit. Batches can be nested, the changes are sent by the outermost commit.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - Others                I2C initialization error
+ */
+esp_err_t bsp_pmu_batch_begin(void);
+
+/**
+ * @brief Send batch of PMU changes
+ *
+ * All changed registers are sent in one I2C transaction.
+ *
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_STATE bsp_pmu_batch_begin() was not called
+ *      - Others                I2C error, values of the changed registers are read again on next access
+ */
+esp_err_t bsp_pmu_batch_commit(void);
+
 #ifdef __cplusplus
 }
 #endif
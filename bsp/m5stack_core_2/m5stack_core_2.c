@@ -24,18 +24,17 @@
 #include "esp_lcd_ili9341.h"
 #include "esp_lcd_touch_ft5x06.h"
 #include "bsp_err_check.h"
+#include "bsp_pmu.h"
 #include "esp_codec_dev_defaults.h"
 
 static const char *TAG = "M5Stack";
 
-#define BSP_AXP192_ADDR  0x34
-#define BSP_AXP2101_ADDR 0x34
-
 #if (BSP_CONFIG_NO_GRAPHIC_LIB == 0)
 static lv_display_t *disp;
 static lv_indev_t *disp_indev = NULL;
 #endif                               // (BSP_CONFIG_NO_GRAPHIC_LIB == 0)
 static esp_lcd_touch_handle_t tp;    // LCD touch handle
+static esp_lcd_panel_handle_t panel_handle = NULL;
 sdmmc_card_t *bsp_sdcard    = NULL;  // Global SD card handler
 static bool i2c_initialized = false;
 static bool spi_initialized = false;
@@ -56,6 +55,7 @@ esp_err_t bsp_i2c_init(void)
                                   };
     BSP_ERROR_CHECK_RETURN_ERR(i2c_param_config(BSP_I2C_NUM, &i2c_conf));
     BSP_ERROR_CHECK_RETURN_ERR(i2c_driver_install(BSP_I2C_NUM, i2c_conf.mode, 0, 0, 0));
+    BSP_ERROR_CHECK_RETURN_ERR(bsp_pmu_init());
 
     i2c_initialized = true;
 
@@ -69,19 +69,8 @@ esp_err_t bsp_i2c_deinit(void)
     return ESP_OK;
 }
 
-uint8_t read8bit(uint8_t sub_addr)
-{
-    // Read register data
-    uint8_t reg_data[1] = {0};
-    esp_err_t err = i2c_master_write_read_device(BSP_I2C_NUM, BSP_AXP192_ADDR, &sub_addr, 1, reg_data, sizeof(reg_data),
-                    1000 / portTICK_PERIOD_MS);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to write & read register address: %s", esp_err_to_name(err));
-    }
-    ESP_LOGD(TAG, "AXP192 register %x: 0x%x", sub_addr, reg_data[0]);
-
-    return reg_data[0];
-}
+/* Features powered by BSP_PMU_RAIL_PERIPH */
+static uint32_t periph_rail_users = 0;
 
 esp_err_t bsp_feature_enable(bsp_feature_t feature, bool enable)
 {
@@ -91,70 +80,34 @@ esp_err_t bsp_feature_enable(bsp_feature_t feature, bool enable)
     BSP_ERROR_CHECK_RETURN_ERR(bsp_i2c_init());
 
     switch (feature) {
-    case BSP_FEATURE_LCD:  // ldo2
+    case BSP_FEATURE_LCD:
     case BSP_FEATURE_TOUCH:
     case BSP_FEATURE_SD:
-#if defined(CONFIG_BSP_PMU_AXP2101)
-        /* AXP ALDO4 voltage / SD Card / Touch Pad / 3V3 */
-        const uint8_t aldo4_value = enable ? 0x1C : 0x00;
-        const uint8_t feature_ctr[] = {0x95, aldo4_value};  // axp: lcd logic and sdcard voltage preset to 3.3v
-        err |= i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, feature_ctr, sizeof(feature_ctr),
-                                          1000 / portTICK_PERIOD_MS);
-
-#elif defined(CONFIG_BSP_PMU_AXP192)
-        const uint8_t pmu_value = enable ? (read8bit(0x28) & 0x0f) | 0xf0 : (read8bit(0x28) & 0x0f);
-        const uint8_t  pmu_ldo2[] = {
-            0x28, pmu_value
-        };
-
-        err |= i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, pmu_ldo2, sizeof(pmu_ldo2),
-                                          1000 / portTICK_PERIOD_MS);
-#endif
+        /* Shared rail is gated when the last of its features is disabled */
+        BSP_ERROR_CHECK_RETURN_ERR(bsp_pmu_batch_begin());
+        if (enable) {
+            periph_rail_users |= BIT(feature);
+        } else {
+            periph_rail_users &= ~BIT(feature);
+        }
+        err = bsp_pmu_rail_enable(BSP_PMU_RAIL_PERIPH, periph_rail_users != 0);
+        if (err == ESP_OK) {
+            err = bsp_pmu_batch_commit();
+        } else {
+            bsp_pmu_batch_commit();
+        }
         break;
     case BSP_FEATURE_SPEAKER:
-#if defined(CONFIG_BSP_PMU_AXP2101)
-        /* AXP ALDO3 voltage / Codec+Mic / 3V3 */
-        const uint8_t aldo3_value = enable ? 0x1C : 0x00;
-        const uint8_t spk_ctr[] = {0x94, aldo3_value};  // axp: lcd logic and sdcard voltage preset to 3.3v
-        err |= i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, spk_ctr, sizeof(spk_ctr),
-                                          1000 / portTICK_PERIOD_MS);
-#elif defined(CONFIG_BSP_PMU_AXP192)
-        const uint8_t led_gpio_value = enable ? (read8bit(0x94) | 0x04) | 0xf0 : (read8bit(0x94) & ~0x04);
-        const uint8_t led_gpio_set[] = {0x94, led_gpio_value};
-        ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, led_gpio_set,
-                            sizeof(led_gpio_set), 1000 / portTICK_PERIOD_MS),
-                            TAG, "I2C write failed");
-#endif
+        err = bsp_pmu_rail_enable(BSP_PMU_RAIL_SPEAKER, enable);
         break;
     case BSP_FEATURE_BATTERY:
 #if defined(CONFIG_BSP_PMU_AXP2101)
         // Battery detection enabled.
-        const uint8_t axp_bat_val = enable ? 0x01 : 0x00;
-        const uint8_t axp_bat_ctr[] = {0x68, axp_bat_val};
-        err |= i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, axp_bat_ctr, sizeof(axp_bat_ctr),
-                                          1000 / portTICK_PERIOD_MS);
+        err = bsp_pmu_update_bits(0x68, 0x01, enable ? 0x01 : 0x00);
 #endif
         break;
     case BSP_FEATURE_VIBRATION:
-#if defined(CONFIG_BSP_PMU_AXP2101)
-        const uint8_t dldo1_vol[] = {0x99, 0x1C};  // AXP DLDO1 Voltage set
-        err |= i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, dldo1_vol, sizeof(dldo1_vol),
-                                          1000 / portTICK_PERIOD_MS);
-        const uint8_t dldo1_en_val = enable ? (read8bit(0x90) | 0x80) : (read8bit(0x90) & ~0x80);
-        const uint8_t dldo1_en[] = {0x90, dldo1_en_val};  // AXP DLDO1 Enable
-        err |= i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, dldo1_en, sizeof(dldo1_en),
-                                          1000 / portTICK_PERIOD_MS);
-#elif defined(CONFIG_BSP_PMU_AXP192)
-        const uint8_t pmu_ldo3[] = {0x28, (read8bit(0x28) & 0xf0) | 0x0f};  // Vibrator power voltage preset
-        ESP_RETURN_ON_ERROR(
-            i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, pmu_ldo3, sizeof(pmu_ldo3), 1000 / portTICK_PERIOD_MS),
-            TAG, "I2C write failed");
-        const uint8_t pmu_ldo3_en_val = enable ? read8bit(0x12) | 0x08 : read8bit(0x12) & ~0x08;
-        const uint8_t pmu_ldo3_en[] = {0x12, pmu_ldo3_en_val};  // ldo3 enable
-        ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, pmu_ldo3_en, sizeof(pmu_ldo3_en),
-                            1000 / portTICK_PERIOD_MS),
-                            TAG, "I2C write failed");
-#endif
+        err = bsp_pmu_rail_enable(BSP_PMU_RAIL_VIBRATION, enable);
         break;
     }
     return err;
@@ -273,110 +226,57 @@ esp_codec_dev_handle_t bsp_audio_codec_speaker_init(void)
 #define LCD_PARAM_BITS 8
 #define LCD_LEDC_CH    CONFIG_BSP_DISPLAY_BRIGHTNESS_LEDC_CH
 
+#if defined(CONFIG_BSP_PMU_AXP2101)
+static const bsp_pmu_reg_t pmu_init_seq[] = {
+    {0x90, 0x33, 0x33},         // AXP ALDO1~2 BLDO1~2 Enable, ALDO3~4 DLDO1 follow bsp_feature_enable()
+    // PowerKey Hold=1sec / PowerOff=4sec IRQLEVEL/OFFLEVEL/ONLEVEL setting
+    {0x27, 0xFF, 0b00000000},
+    {0x10, 0xFF, 0b00110000},   // Internal off-discharge enable for DCDC & LDO & SWITCH
+    {0x12, 0xFF, 0b00000000},   // BATFET disable
+    {0x69, 0xFF, 0b00010011},   // CHGLED setting
+};
+#elif defined(CONFIG_BSP_PMU_AXP192)
+static const bsp_pmu_reg_t pmu_init_seq[] = {
+    {0x30, 0xFB, 0x02},         // axp: vbus limit off
+    {0x92, 0x07, 0x00},         // AXP192 GPIO1:OD OUTPUT
+    {0x93, 0x07, 0x00},         // AXP192 GPIO2:OD OUTPUT
+    {0x35, 0xE3, 0xA2},         // AXP192 RTC CHG
+    {0x26, 0xFF, 0x6A},         // AXP192 DCDC1 (ESP32) voltage
+    {0x33, 0x0F, 0x00},         // Charge current
+    {0x95, 0x8D, 0x84},         // AXP192 GPIO4
+    {0x36, 0xFF, 0x4C},         // PEK key
+    {0x82, 0xFF, 0xFF},         // ADC enable
+};
+#endif
+
 esp_err_t bsp_display_brightness_init(void)
 {
+    esp_err_t ret = ESP_OK;
+
     /* Initilize I2C */
     BSP_ERROR_CHECK_RETURN_ERR(bsp_i2c_init());
-#if defined(CONFIG_BSP_PMU_AXP2101)
-    const uint8_t lcd_bl_en[] = {0x90, 0x3F};  // AXP ALDO1~4 BLDO1~2 Enable
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, lcd_bl_en, sizeof(lcd_bl_en),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    const uint8_t lcd_bl_val[] = {0x96, 0b000011000};  // AXP BLDO1 voltage
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, lcd_bl_val, sizeof(lcd_bl_val),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-
-    // AXP2101
-    // PowerKey Hold=1sec / PowerOff=4sec IRQLEVEL/OFFLEVEL/ONLEVEL setting
-    const uint8_t axp_pwr_val[] = {0x27, 0b00000000};
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, axp_pwr_val, sizeof(axp_pwr_val),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    // Internal off-discharge enable for DCDC & LDO & SWITCH
-    const uint8_t axp_en_val[] = {0x10, 0b00110000};
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, axp_en_val, sizeof(axp_en_val),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    // BATFET disable
-    const uint8_t axp_bat_val[] = {0x12, 0b00000000};
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, axp_bat_val, sizeof(axp_bat_val),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    // CHGLED setting
-    const uint8_t axp_hgled_val[] = {0x69, 0b00010011};
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, axp_hgled_val, sizeof(axp_hgled_val),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-#elif defined(CONFIG_BSP_PMU_AXP192)
-    read8bit(0x12);
-
-    const uint8_t vbus_limit[] = {0x30, (read8bit(0x30) & 0x04) | 0x02};  // axp: vbus limit off
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, vbus_limit, sizeof(vbus_limit),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    const uint8_t pmu_gpio1[] = {0x92, read8bit(0x92) & 0xf8};  // AXP192 GPIO1:OD OUTPUT
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, pmu_gpio1, sizeof(pmu_gpio1),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    const uint8_t pmu_gpio2[] = {0x93, read8bit(0x93) & 0xf8};  // AXP192 GPIO2:OD OUTPUT
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, pmu_gpio2, sizeof(pmu_gpio2),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    const uint8_t pmu_gpio3[] = {0x35, (read8bit(0x35) & 0x1c) | 0xa2};  // AXP192 RTC CHG
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, pmu_gpio3, sizeof(pmu_gpio3),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    const uint8_t esp_vol[] = {0x26, 0x6a};  // AXP192 RTC CHG
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, esp_vol, sizeof(esp_vol), 1000 / portTICK_PERIOD_MS),
-        TAG, "I2C write failed");
-    const uint8_t lcd_bl_val[] = {0x27, 0x68};  // Lcd backlight voltage
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, lcd_bl_val, sizeof(lcd_bl_val),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    const uint8_t pmu_ldo2[] = {0x28,
-                                (read8bit(0x28) & 0x0f) | 0xf0
-                               };  // axp: lcd logic and sdcard voltage preset to 3.3v
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, pmu_ldo2, sizeof(pmu_ldo2), 1000 / portTICK_PERIOD_MS),
-        TAG, "I2C write failed");
-    const uint8_t pmu_ldo2_en[] = {0x12, (read8bit(0x12) & 0xfb) | 0x04};  // ldo2 enable
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, pmu_ldo2_en, sizeof(pmu_ldo2_en),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    const uint8_t lcd_bl_en[] = {0x12, (read8bit(0x12) & 0xfd) | 0x02};  // Lcd backlight enable
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, lcd_bl_en, sizeof(lcd_bl_en),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-
-    const uint8_t chg_current[] = {0x33, ((read8bit(0x33) & 0xf0)) | 0x0};
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, chg_current, sizeof(chg_current),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-
-    const uint8_t apx_gpio4[] = {0x95, (read8bit(0x95) & 0x72) | 0x84};
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, apx_gpio4, sizeof(apx_gpio4),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    read8bit(0x95);
-    const uint8_t pek_key[] = {0x36, 0x4c};  // Lcd backlight enable
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, pek_key, sizeof(pek_key), 1000 / portTICK_PERIOD_MS),
-        TAG, "I2C write failed");
-    const uint8_t adc_en[] = {0x82, 0xff};  // Lcd backlight enable
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, adc_en, sizeof(adc_en), 1000 / portTICK_PERIOD_MS),
-        TAG, "I2C write failed");
-    const uint8_t lcd_rset2[] = {0x96, read8bit(0x96) &(~0x02)};   // Lcd backlight enable
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, lcd_rset2, sizeof(lcd_rset2),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
-    vTaskDelay(pdMS_TO_TICKS(100));                            // 延迟100ms
-    const uint8_t lcd_rset[] = {0x96, read8bit(0x96) | 0x02};  // Lcd backlight enable
-    ESP_RETURN_ON_ERROR(
-        i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, lcd_rset, sizeof(lcd_rset), 1000 / portTICK_PERIOD_MS),
-        TAG, "I2C write failed");
+
+    /* Whole sequence is sent in one I2C transaction */
+    BSP_ERROR_CHECK_RETURN_ERR(bsp_pmu_batch_begin());
+    ret = bsp_pmu_write_seq(pmu_init_seq, sizeof(pmu_init_seq) / sizeof(pmu_init_seq[0]));
+    if (ret == ESP_OK) {
+        ret = bsp_feature_enable(BSP_FEATURE_LCD, true);
+    }
+    if (ret == ESP_OK) {
+        ret = bsp_pmu_rail_enable(BSP_PMU_RAIL_LCD_BACKLIGHT, true);
+    }
+    if (ret == ESP_OK) {
+        ret = bsp_pmu_batch_commit();
+    } else {
+        bsp_pmu_batch_commit();
+    }
+    ESP_RETURN_ON_ERROR(ret, TAG, "PMU init failed");
+
+#if defined(CONFIG_BSP_PMU_AXP192)
+    /* LCD reset (AXP192 GPIO4) */
+    ESP_RETURN_ON_ERROR(bsp_pmu_update_bits(0x96, 0x02, 0x00), TAG, "I2C write failed");
+    vTaskDelay(pdMS_TO_TICKS(100));
+    ESP_RETURN_ON_ERROR(bsp_pmu_update_bits(0x96, 0x02, 0x02), TAG, "I2C write failed");
 #endif
     return ESP_OK;
 }
@@ -391,19 +291,25 @@ esp_err_t bsp_display_brightness_set(int brightness_percent)
     }
 
     ESP_LOGI(TAG, "Setting LCD backlight: %d%%", brightness_percent);
+    if (brightness_percent == 0) {
+        return bsp_pmu_rail_enable(BSP_PMU_RAIL_LCD_BACKLIGHT, false);
+    }
 #if defined(CONFIG_BSP_PMU_AXP2101)
-    const uint8_t reg_val      = 20 + ((8 * brightness_percent) / 100);  // 0b00000 ~ 0b11100; under 20, it is too dark
-    const uint8_t lcd_bl_val[] = {0x96, reg_val};                        // AXP BLDO1 voltage
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP2101_ADDR, lcd_bl_val, sizeof(lcd_bl_val),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
+    const uint32_t voltage_mv = 2500 + 100 * ((8 * brightness_percent) / 100);  // BLDO1 2.5 V ~ 3.3 V; under 2.5 V, it is too dark
 #elif defined(CONFIG_BSP_PMU_AXP192)
-    const uint8_t reg_val      = 90 + ((8 * brightness_percent) / 100);  // 0b00000 ~ 0b11100; under 20, it is too dark
-    const uint8_t lcd_bl_val[] = {0x27, reg_val};                        // AXP DCDC3 voltage
-    ESP_RETURN_ON_ERROR(i2c_master_write_to_device(BSP_I2C_NUM, BSP_AXP192_ADDR, lcd_bl_val, sizeof(lcd_bl_val),
-                        1000 / portTICK_PERIOD_MS),
-                        TAG, "I2C write failed");
+    const uint32_t voltage_mv = 2950 + 25 * ((8 * brightness_percent) / 100);   // DCDC3 2.95 V ~ 3.15 V
 #endif
+    ESP_RETURN_ON_ERROR(bsp_pmu_batch_begin(), TAG, "");
+    esp_err_t ret = bsp_pmu_rail_set_voltage(BSP_PMU_RAIL_LCD_BACKLIGHT, voltage_mv);
+    if (ret == ESP_OK) {
+        ret = bsp_pmu_rail_enable(BSP_PMU_RAIL_LCD_BACKLIGHT, true);
+    }
+    if (ret == ESP_OK) {
+        ret = bsp_pmu_batch_commit();
+    } else {
+        bsp_pmu_batch_commit();
+    }
+    ESP_RETURN_ON_ERROR(ret, TAG, "I2C write failed");
 
     return ESP_OK;
 }
@@ -418,6 +324,23 @@ esp_err_t bsp_display_backlight_on(void)
     return bsp_display_brightness_set(100);
 }
 
+esp_err_t bsp_display_enter_sleep(void)
+{
+    ESP_RETURN_ON_FALSE(panel_handle, ESP_ERR_INVALID_STATE, TAG, "display not initialized");
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_disp_on_off(panel_handle, false), TAG, "LCD off failed");
+    /* Frame stays in LCD memory, touch stays powered to wake up the application */
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_disp_sleep(panel_handle, true), TAG, "LCD sleep failed");
+    return bsp_pmu_rail_enable(BSP_PMU_RAIL_LCD_BACKLIGHT, false);
+}
+
+esp_err_t bsp_display_exit_sleep(void)
+{
+    ESP_RETURN_ON_FALSE(panel_handle, ESP_ERR_INVALID_STATE, TAG, "display not initialized");
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_disp_sleep(panel_handle, false), TAG, "LCD wake up failed");
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_disp_on_off(panel_handle, true), TAG, "LCD on failed");
+    return bsp_pmu_rail_enable(BSP_PMU_RAIL_LCD_BACKLIGHT, true);
+}
+
 esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_handle_t *ret_panel,
                           esp_lcd_panel_io_handle_t *ret_io)
 {
@@ -437,7 +360,8 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
         .lcd_cmd_bits      = LCD_CMD_BITS,
         .lcd_param_bits    = LCD_PARAM_BITS,
         .spi_mode          = 0,
-        .trans_queue_depth = 10,
+        .trans_queue_depth = (config->trans_queue_depth > 0) ? config->trans_queue_depth :
+                             BSP_LCD_TRANS_QUEUE_DEPTH(BSP_LCD_H_RES * BSP_LCD_V_RES * BSP_LCD_BITS_PER_PIXEL / 8, config->max_transfer_sz),
     };
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)BSP_LCD_SPI_NUM, &io_config, ret_io), err, TAG,
                       "New panel IO failed");
@@ -454,6 +378,7 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
     esp_lcd_panel_reset(*ret_panel);
     esp_lcd_panel_init(*ret_panel);
     esp_lcd_panel_invert_color(*ret_panel, true);
+    panel_handle = *ret_panel;
     return ret;
 
 err:
@@ -501,9 +426,11 @@ static lv_display_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
 {
     assert(cfg != NULL);
     esp_lcd_panel_io_handle_t io_handle     = NULL;
-    esp_lcd_panel_handle_t panel_handle     = NULL;
+    const int max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t);
     const bsp_display_config_t bsp_disp_cfg = {
-        .max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t),
+        .max_transfer_sz = max_transfer_sz,
+        /* Whole draw buffer is queued at once, so the flush callback does not wait for the bus */
+        .trans_queue_depth = BSP_LCD_TRANS_QUEUE_DEPTH(cfg->buffer_size * sizeof(uint16_t), max_transfer_sz),
     };
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new(&bsp_disp_cfg, &panel_handle, &io_handle));
 
@@ -0,0 +1,257 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "driver/i2c.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_check.h"
+
+#include "bsp/m5stack_core_2.h"
+#include "bsp_pmu.h"
+
+static const char *TAG = "M5Stack";
+
+/* AXP192 and AXP2101 have same address */
+#define BSP_PMU_ADDR        0x34
+#define BSP_PMU_TIMEOUT_MS  1000
+#define BSP_PMU_REG_COUNT   256
+
+#define BSP_PMU_BIT_GET(map, reg)   (((map)[(reg) / 32] >> ((reg) % 32)) & 1)
+#define BSP_PMU_BIT_SET(map, reg)   ((map)[(reg) / 32] |= (1UL << ((reg) % 32)))
+
+/* Enable bit and voltage field of one rail */
+typedef struct {
+    uint8_t en_reg;
+    uint8_t en_mask;
+    uint8_t vol_reg;
+    uint8_t vol_mask;       /* Mask of voltage field (not shifted), 0 when the voltage cannot be set */
+    uint8_t vol_shift;
+    uint8_t vol_max;        /* Highest step of the regulator */
+    uint16_t vol_min_mv;
+    uint16_t vol_step_mv;
+} bsp_pmu_rail_desc_t;
+
+#if defined(CONFIG_BSP_PMU_AXP2101)
+static const bsp_pmu_rail_desc_t bsp_pmu_rails[] = {
+    [BSP_PMU_RAIL_LCD_BACKLIGHT] = {.en_reg = 0x90, .en_mask = BIT(4), .vol_reg = 0x96, .vol_mask = 0x1F, .vol_max = 30, .vol_min_mv = 500, .vol_step_mv = 100}, // BLDO1
+    [BSP_PMU_RAIL_PERIPH]        = {.en_reg = 0x90, .en_mask = BIT(3), .vol_reg = 0x95, .vol_mask = 0x1F, .vol_max = 30, .vol_min_mv = 500, .vol_step_mv = 100}, // ALDO4
+    [BSP_PMU_RAIL_SPEAKER]       = {.en_reg = 0x90, .en_mask = BIT(2), .vol_reg = 0x94, .vol_mask = 0x1F, .vol_max = 30, .vol_min_mv = 500, .vol_step_mv = 100}, // ALDO3
+    [BSP_PMU_RAIL_VIBRATION]     = {.en_reg = 0x90, .en_mask = BIT(7), .vol_reg = 0x99, .vol_mask = 0x1F, .vol_max = 30, .vol_min_mv = 500, .vol_step_mv = 100}, // DLDO1
+};
+#define BSP_PMU_RAIL_DEFAULT_MV     {2900, 3300, 3300, 3300}
+#elif defined(CONFIG_BSP_PMU_AXP192)
+static const bsp_pmu_rail_desc_t bsp_pmu_rails[] = {
+    [BSP_PMU_RAIL_LCD_BACKLIGHT] = {.en_reg = 0x12, .en_mask = BIT(1), .vol_reg = 0x27, .vol_mask = 0x7F, .vol_max = 112, .vol_min_mv = 700, .vol_step_mv = 25}, // DCDC3
+    [BSP_PMU_RAIL_PERIPH]        = {.en_reg = 0x12, .en_mask = BIT(2), .vol_reg = 0x28, .vol_mask = 0x0F, .vol_shift = 4, .vol_max = 15, .vol_min_mv = 1800, .vol_step_mv = 100}, // LDO2
+    [BSP_PMU_RAIL_SPEAKER]       = {.en_reg = 0x94, .en_mask = BIT(2)}, // GPIO2 output drives amplifier enable
+    [BSP_PMU_RAIL_VIBRATION]     = {.en_reg = 0x12, .en_mask = BIT(3), .vol_reg = 0x28, .vol_mask = 0x0F, .vol_max = 15, .vol_min_mv = 1800, .vol_step_mv = 100}, // LDO3
+};
+#define BSP_PMU_RAIL_DEFAULT_MV     {3300, 3300, 0, 3300}
+#endif
+
+#define BSP_PMU_RAIL_COUNT  (sizeof(bsp_pmu_rails) / sizeof(bsp_pmu_rails[0]))
+
+static struct {
+    SemaphoreHandle_t lock;                 /* Recursive, held during batch */
+    StaticSemaphore_t lock_buf;
+    uint32_t batch;                         /* Nesting of batches of the lock holder */
+    uint8_t reg[BSP_PMU_REG_COUNT];         /* Cached register values */
+    uint32_t cached[BSP_PMU_REG_COUNT / 32]; /* Register value is known */
+    uint32_t dirty[BSP_PMU_REG_COUNT / 32];  /* Register value is not sent yet */
+    uint16_t rail_mv[BSP_PMU_RAIL_COUNT];   /* Voltage of enabled rails */
+} pmu = {
+    .rail_mv = BSP_PMU_RAIL_DEFAULT_MV,
+};
+
+esp_err_t bsp_pmu_init(void)
+{
+    if (pmu.lock == NULL) {
+        pmu.lock = xSemaphoreCreateRecursiveMutexStatic(&pmu.lock_buf);
+    }
+    return ESP_OK;
+}
+
+static esp_err_t bsp_pmu_read(uint8_t reg, uint8_t *value)
+{
+    if (BSP_PMU_BIT_GET(pmu.cached, reg)) {
+        *value = pmu.reg[reg];
+        return ESP_OK;
+    }
+
+    ESP_RETURN_ON_ERROR(i2c_master_write_read_device(BSP_I2C_NUM, BSP_PMU_ADDR, &reg, 1, &pmu.reg[reg], 1,
+                        pdMS_TO_TICKS(BSP_PMU_TIMEOUT_MS)), TAG, "PMU register 0x%02x read failed", reg);
+    BSP_PMU_BIT_SET(pmu.cached, reg);
+    ESP_LOGD(TAG, "PMU register 0x%02x: 0x%02x", reg, pmu.reg[reg]);
+    *value = pmu.reg[reg];
+    return ESP_OK;
+}
+
+/* Send all dirty registers in one transaction (repeated start between registers) */
+static esp_err_t bsp_pmu_flush(void)
+{
+    esp_err_t ret = ESP_OK;
+    int count = 0;
+
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    ESP_GOTO_ON_FALSE(cmd, ESP_ERR_NO_MEM, end, TAG, "no mem for I2C commands");
+    for (int reg = 0; reg < BSP_PMU_REG_COUNT; reg++) {
+        if (!BSP_PMU_BIT_GET(pmu.dirty, reg)) {
+            continue;
+        }
+        ESP_GOTO_ON_ERROR(i2c_master_start(cmd), end, TAG, "");
+        ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, (BSP_PMU_ADDR << 1) | I2C_MASTER_WRITE, true), end, TAG, "");
+        ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, reg, true), end, TAG, "");
+        ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, pmu.reg[reg], true), end, TAG, "");
+        count++;
+    }
+    if (count) {
+        ESP_GOTO_ON_ERROR(i2c_master_stop(cmd), end, TAG, "");
+        ESP_GOTO_ON_ERROR(i2c_master_cmd_begin(BSP_I2C_NUM, cmd, pdMS_TO_TICKS(BSP_PMU_TIMEOUT_MS)), end, TAG,
+                          "PMU write failed");
+        ESP_LOGD(TAG, "PMU: %d registers written", count);
+    }
+
+end:
+    if (cmd) {
+        i2c_cmd_link_delete(cmd);
+    }
+    /* Values of not sent registers are not known */
+    for (int i = 0; i < BSP_PMU_REG_COUNT / 32; i++) {
+        if (ret != ESP_OK) {
+            pmu.cached[i] &= ~pmu.dirty[i];
+        }
+        pmu.dirty[i] = 0;
+    }
+    return ret;
+}
+
+esp_err_t bsp_pmu_batch_begin(void)
+{
+    if (pmu.lock == NULL) {
+        ESP_RETURN_ON_ERROR(bsp_i2c_init(), TAG, "I2C init failed");
+    }
+    xSemaphoreTakeRecursive(pmu.lock, portMAX_DELAY);
+    pmu.batch++;
+    return ESP_OK;
+}
+
+esp_err_t bsp_pmu_batch_commit(void)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(pmu.lock && xSemaphoreGetMutexHolder(pmu.lock) == xTaskGetCurrentTaskHandle() && pmu.batch,
+                        ESP_ERR_INVALID_STATE, TAG, "PMU batch not started");
+
+    if (--pmu.batch == 0) {
+        ret = bsp_pmu_flush();
+    }
+    xSemaphoreGiveRecursive(pmu.lock);
+    return ret;
+}
+
+/* Commit the batch, the first error is returned */
+static esp_err_t bsp_pmu_batch_end(esp_err_t ret)
+{
+    const esp_err_t commit_ret = bsp_pmu_batch_commit();
+    return (ret != ESP_OK) ? ret : commit_ret;
+}
+
+esp_err_t bsp_pmu_update_bits(uint8_t reg, uint8_t mask, uint8_t value)
+{
+    esp_err_t ret = ESP_OK;
+    uint8_t old = 0;
+    ESP_RETURN_ON_ERROR(bsp_pmu_batch_begin(), TAG, "");
+
+    /* Whole register is written without reading it */
+    const bool known = BSP_PMU_BIT_GET(pmu.cached, reg);
+    if (known || mask != 0xFF) {
+        ESP_GOTO_ON_ERROR(bsp_pmu_read(reg, &old), end, TAG, "");
+    }
+    const uint8_t new = (old & ~mask) | (value & mask);
+    if (!known || new != old) {
+        pmu.reg[reg] = new;
+        BSP_PMU_BIT_SET(pmu.cached, reg);
+        BSP_PMU_BIT_SET(pmu.dirty, reg);
+    }
+
+end:
+    return bsp_pmu_batch_end(ret);
+}
+
+esp_err_t bsp_pmu_write_seq(const bsp_pmu_reg_t *seq, size_t count)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_ERROR(bsp_pmu_batch_begin(), TAG, "");
+    for (size_t i = 0; i < count && ret == ESP_OK; i++) {
+        ret = bsp_pmu_update_bits(seq[i].reg, seq[i].mask, seq[i].value);
+    }
+    return bsp_pmu_batch_end(ret);
+}
+
+static esp_err_t bsp_pmu_rail_write_voltage(const bsp_pmu_rail_desc_t *rail, uint32_t voltage_mv)
+{
+    const uint8_t step = (voltage_mv - rail->vol_min_mv) / rail->vol_step_mv;
+    return bsp_pmu_update_bits(rail->vol_reg, rail->vol_mask << rail->vol_shift, step << rail->vol_shift);
+}
+
+esp_err_t bsp_pmu_rail_enable(bsp_pmu_rail_t rail, bool enable)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(rail < BSP_PMU_RAIL_COUNT, ESP_ERR_INVALID_ARG, TAG, "invalid rail");
+    const bsp_pmu_rail_desc_t *desc = &bsp_pmu_rails[rail];
+
+    ESP_RETURN_ON_ERROR(bsp_pmu_batch_begin(), TAG, "");
+    if (enable && desc->vol_mask) {
+        ret = bsp_pmu_rail_write_voltage(desc, pmu.rail_mv[rail]);
+    }
+    if (ret == ESP_OK) {
+        ret = bsp_pmu_update_bits(desc->en_reg, desc->en_mask, enable ? desc->en_mask : 0);
+    }
+    return bsp_pmu_batch_end(ret);
+}
+
+esp_err_t bsp_pmu_rail_set_voltage(bsp_pmu_rail_t rail, uint32_t voltage_mv)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(rail < BSP_PMU_RAIL_COUNT, ESP_ERR_INVALID_ARG, TAG, "invalid rail");
+    const bsp_pmu_rail_desc_t *desc = &bsp_pmu_rails[rail];
+    ESP_RETURN_ON_FALSE(desc->vol_mask, ESP_ERR_NOT_SUPPORTED, TAG, "voltage of rail %d cannot be set", rail);
+    ESP_RETURN_ON_FALSE(voltage_mv >= desc->vol_min_mv &&
+                        voltage_mv <= desc->vol_min_mv + (uint32_t)desc->vol_max * desc->vol_step_mv,
+                        ESP_ERR_INVALID_ARG, TAG, "voltage %"PRIu32" mV out of range", voltage_mv);
+
+    ESP_RETURN_ON_ERROR(bsp_pmu_batch_begin(), TAG, "");
+    pmu.rail_mv[rail] = voltage_mv;
+    ret = bsp_pmu_rail_write_voltage(desc, voltage_mv);
+    return bsp_pmu_batch_end(ret);
+}
+
+esp_err_t bsp_pmu_rail_get(bsp_pmu_rail_t rail, bool *enabled, uint32_t *voltage_mv)
+{
+    esp_err_t ret = ESP_OK;
+    uint8_t value = 0;
+    ESP_RETURN_ON_FALSE(rail < BSP_PMU_RAIL_COUNT, ESP_ERR_INVALID_ARG, TAG, "invalid rail");
+    const bsp_pmu_rail_desc_t *desc = &bsp_pmu_rails[rail];
+
+    ESP_RETURN_ON_ERROR(bsp_pmu_batch_begin(), TAG, "");
+    if (enabled) {
+        ESP_GOTO_ON_ERROR(bsp_pmu_read(desc->en_reg, &value), end, TAG, "");
+        *enabled = (value & desc->en_mask) != 0;
+    }
+    if (voltage_mv) {
+        *voltage_mv = 0;
+        if (desc->vol_mask) {
+            ESP_GOTO_ON_ERROR(bsp_pmu_read(desc->vol_reg, &value), end, TAG, "");
+            *voltage_mv = desc->vol_min_mv + ((value >> desc->vol_shift) & desc->vol_mask) * desc->vol_step_mv;
+        }
+    }
+
+end:
+    return bsp_pmu_batch_end(ret);
+}
@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One masked register write of PMU init sequence
+ */
+typedef struct {
+    uint8_t reg;    /* Register address */
+    uint8_t mask;   /* Changed bits, 0xFF writes the whole register without reading it */
+    uint8_t value;  /* New value of the changed bits */
+} bsp_pmu_reg_t;
+
+/**
+ * @brief Initialize PMU register cache (called from bsp_i2c_init)
+ */
+esp_err_t bsp_pmu_init(void);
+
+/**
+ * @brief Update bits of PMU register
+ *
+ * The register is read only once, then its cached value is used. Nothing is sent when the value does not change.
+ * Inside of bsp_pmu_batch_begin() / bsp_pmu_batch_commit() the write is deferred until the commit.
+ */
+esp_err_t bsp_pmu_update_bits(uint8_t reg, uint8_t mask, uint8_t value);
+
+/**
+ * @brief Apply sequence of masked register writes in one batch
+ */
+esp_err_t bsp_pmu_write_seq(const bsp_pmu_reg_t *seq, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -17,6 +17,9 @@
 #include "driver/sdmmc_host.h"
 #include "soc/usb_pins.h"
 #include "esp_codec_dev.h"
+#if CONFIG_BSP_I2C_SCHED
+#include "esp_i2c_sched.h"
+#endif
 #include "bsp/config.h"
 #include "bsp/display.h"
 
@@ -62,6 +65,7 @@
 #define BSP_LCD_CS            (GPIO_NUM_3)
 #define BSP_LCD_DC            (GPIO_NUM_35)
 #define BSP_LCD_RST           (GPIO_NUM_NC)
+#define BSP_LCD_TE            (GPIO_NUM_NC)   /* TE output of LCD is not routed to ESP */
 #define BSP_LCD_BACKLIGHT     (GPIO_NUM_NC)
 #define BSP_LCD_TOUCH_INT     (GPIO_NUM_NC)
 
@@ -184,6 +188,19 @@ esp_err_t bsp_i2c_init(void);
  */
 esp_err_t bsp_i2c_deinit(void);
 
+#if CONFIG_BSP_I2C_SCHED
+/**
+ * @brief Get priority scheduler of the I2C bus
+ *
+ * @note Touch created by bsp_touch_new() is already scheduled in ESP_I2C_SCHED_PRIO_TOUCH class.
+ *
+ * @return
+ *      - Scheduler handle
+ *      - NULL if I2C was not initialized
+ */
+esp_i2c_sched_handle_t bsp_i2c_sched_get_handle(void);
+#endif
+
 /**************************************************************************************************
  *
  * Camera interface
@@ -349,6 +366,7 @@ typedef struct {
     struct {
         unsigned int buff_dma: 1;    /*!< Allocated LVGL buffer will be DMA capable */
         unsigned int buff_spiram: 1; /*!< Allocated LVGL buffer will be in PSRAM */
+        unsigned int te_sync: 1;     /*!< Start the flush of each frame on TE edge of LCD, when BSP_LCD_TE is connected (LVGL 9 only) */
     } flags;
 } bsp_display_cfg_t;
 /**
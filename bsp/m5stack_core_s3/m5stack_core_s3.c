@@ -54,6 +54,11 @@ sdmmc_card_t *bsp_sdcard = NULL;    // Global SD card handler
  */
 static i2c_master_bus_handle_t i2c_handle = NULL;
 static bool i2c_initialized = false;
+#if CONFIG_BSP_I2C_SCHED
+static esp_i2c_sched_handle_t i2c_sched = NULL;
+static esp_i2c_sched_dev_handle_t tp_sched = NULL;
+static esp_err_t (*tp_read_data)(esp_lcd_touch_handle_t tp) = NULL;
+#endif
 static i2c_master_dev_handle_t axp2101_h = NULL;
 static i2c_master_dev_handle_t aw9523_h = NULL;
 static bool spi_initialized = false;
@@ -86,6 +91,12 @@ esp_err_t bsp_i2c_init(void)
         .scl_speed_hz = CONFIG_BSP_I2C_CLK_SPEED_HZ,
     };
     BSP_ERROR_CHECK_RETURN_ERR(i2c_master_bus_add_device(i2c_handle, &aw9523_config, &aw9523_h));
+#if CONFIG_BSP_I2C_SCHED
+    /* Scheduler is kept over deinit, devices may stay added */
+    if (i2c_sched == NULL) {
+        BSP_ERROR_CHECK_RETURN_ERR(esp_i2c_sched_new(&i2c_sched));
+    }
+#endif
 
     i2c_initialized = true;
     return ESP_OK;
@@ -386,7 +397,8 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
         .lcd_cmd_bits = LCD_CMD_BITS,
         .lcd_param_bits = LCD_PARAM_BITS,
         .spi_mode = 0,
-        .trans_queue_depth = 10,
+        .trans_queue_depth = (config->trans_queue_depth > 0) ? config->trans_queue_depth :
+                             BSP_LCD_TRANS_QUEUE_DEPTH(BSP_LCD_H_RES * BSP_LCD_V_RES * BSP_LCD_BITS_PER_PIXEL / 8, config->max_transfer_sz),
     };
     ESP_GOTO_ON_ERROR(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)BSP_LCD_SPI_NUM, &io_config, ret_io), err, TAG, "New panel IO failed");
 
@@ -414,6 +426,38 @@ err:
     return ret;
 }
 
+#if CONFIG_BSP_I2C_SCHED
+esp_i2c_sched_handle_t bsp_i2c_sched_get_handle(void)
+{
+    bsp_i2c_init();
+    return i2c_sched;
+}
+
+static esp_err_t bsp_touch_read_data_sched(esp_lcd_touch_handle_t tp)
+{
+    ESP_RETURN_ON_ERROR(esp_i2c_sched_lock(tp_sched, 100), TAG, "I2C bus busy");
+    esp_err_t ret = tp_read_data(tp);
+    esp_i2c_sched_unlock(tp_sched);
+    return ret;
+}
+
+static esp_err_t bsp_touch_sched_add(esp_lcd_touch_handle_t tp)
+{
+    if (tp_sched == NULL) {
+        const esp_i2c_sched_dev_config_t dev_cfg = {
+            .name = "touch",
+            .prio = ESP_I2C_SCHED_PRIO_TOUCH,
+            .budget_us = 1000,
+        };
+        ESP_RETURN_ON_ERROR(esp_i2c_sched_add_device(i2c_sched, &dev_cfg, &tp_sched), TAG, "");
+    }
+    /* Every read of the touch driver waits for the bus in the touch class */
+    tp_read_data = tp->read_data;
+    tp->read_data = bsp_touch_read_data_sched;
+    return ESP_OK;
+}
+#endif
+
 esp_err_t bsp_touch_new(const bsp_touch_config_t *config, esp_lcd_touch_handle_t *ret_touch)
 {
     BSP_ERROR_CHECK_RETURN_ERR(bsp_enable_feature(BSP_FEATURE_TOUCH));
@@ -438,7 +482,11 @@ esp_err_t bsp_touch_new(const bsp_touch_config_t *config, esp_lcd_touch_handle_t
     esp_lcd_panel_io_i2c_config_t tp_io_config = ESP_LCD_TOUCH_IO_I2C_FT5x06_CONFIG();
     tp_io_config.scl_speed_hz = CONFIG_BSP_I2C_CLK_SPEED_HZ; // This parameter was introduced together with I2C Driver-NG in IDF v5.2
     ESP_RETURN_ON_ERROR(esp_lcd_new_panel_io_i2c(i2c_handle, &tp_io_config, &tp_io_handle), TAG, "");
-    return esp_lcd_touch_new_i2c_ft5x06(tp_io_handle, &tp_cfg, ret_touch);
+    ESP_RETURN_ON_ERROR(esp_lcd_touch_new_i2c_ft5x06(tp_io_handle, &tp_cfg, ret_touch), TAG, "New ft5x06 failed");
+#if CONFIG_BSP_I2C_SCHED
+    ESP_RETURN_ON_ERROR(bsp_touch_sched_add(*ret_touch), TAG, "Touch scheduling failed");
+#endif
+    return ESP_OK;
 }
 
 #if (BSP_CONFIG_NO_GRAPHIC_LIB == 0)
@@ -447,8 +495,11 @@ static lv_display_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
     assert(cfg != NULL);
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
+    const int max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t);
     const bsp_display_config_t bsp_disp_cfg = {
-        .max_transfer_sz = BSP_LCD_DRAW_BUFF_SIZE * sizeof(uint16_t),
+        .max_transfer_sz = max_transfer_sz,
+        /* Whole draw buffer is queued at once, so the flush callback does not wait for the bus */
+        .trans_queue_depth = BSP_LCD_TRANS_QUEUE_DEPTH(cfg->buffer_size * sizeof(uint16_t), max_transfer_sz),
     };
     BSP_ERROR_CHECK_RETURN_NULL(bsp_display_new(&bsp_disp_cfg, &panel_handle, &io_handle));
 
@@ -464,6 +515,9 @@ static lv_display_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
         .hres = BSP_LCD_H_RES,
         .vres = BSP_LCD_V_RES,
         .monochrome = false,
+#if LVGL_VERSION_MAJOR >= 9
+        .te_gpio_num = BSP_LCD_TE,
+#endif
         /* Rotation values must be same as used in esp_lcd for initial settings of the screen */
         .rotation = {
             .swap_xy = false,
@@ -475,6 +529,7 @@ static lv_display_t *bsp_display_lcd_init(const bsp_display_cfg_t *cfg)
             .buff_spiram = cfg->flags.buff_spiram,
 #if LVGL_VERSION_MAJOR >= 9
             .swap_bytes = (BSP_LCD_BIGENDIAN ? true : false),
+            .te_sync = (cfg->flags.te_sync && BSP_LCD_TE != GPIO_NUM_NC),
 #endif
         }
     };
@@ -5,49 +5,82 @@
  */
 
 #include <stdio.h>
-#include "driver/i2c.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "bh1750.h"
 
+#define I2C_CLK_SPEED 400000
+#define I2C_TIMEOUT_MS 1000
+
 #define BH_1750_MEASUREMENT_ACCURACY    1.2    /*!< the typical measurement accuracy of  BH1750 sensor */
 
 #define BH1750_POWER_DOWN        0x00    /*!< Command to set Power Down*/
 #define BH1750_POWER_ON          0x01    /*!< Command to set Power On*/
 
+#define BH1750_H_RES_TIME_MAX_MS        180     /*!< Maximal H-resolution measurement time at the default measurement time */
+#define BH1750_RANGE_LOW_COUNT          1000    /*!< Raise the measurement time below this count */
+#define BH1750_RANGE_HIGH_COUNT         50000   /*!< Lower the measurement time above this count */
+#define BH1750_RANGE_TARGET_COUNT       20000   /*!< Count aimed at by the auto-ranging */
+#define BH1750_SAMPLER_TASK_STACK       (3 * 1024)
+
+static const char *TAG = "BH1750";
+
 typedef struct {
-    i2c_port_t bus;
-    uint16_t dev_addr;
+    i2c_master_dev_handle_t i2c_handle;
+
+    // sampler
+    TaskHandle_t sampler_task;
+    TaskHandle_t sampler_stop_task;
+    volatile bool sampler_running;
+    bh1750_sampler_config_t sampler_config;
+    portMUX_TYPE sample_lock;
+    bh1750_sample_t sample;
+    bool sample_valid;
 } bh1750_dev_t;
 
 static esp_err_t bh1750_write_byte(const bh1750_dev_t *const sens, const uint8_t byte)
 {
-    esp_err_t ret;
-
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_WRITE, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, byte, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_stop(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_cmd_begin(sens->bus, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
-
-    return ret;
+    return i2c_master_transmit(sens->i2c_handle, &byte, 1, I2C_TIMEOUT_MS);
 }
 
-bh1750_handle_t bh1750_create(i2c_port_t port, const uint16_t dev_addr)
+esp_err_t bh1750_create(i2c_master_bus_handle_t i2c_bus, const uint8_t dev_addr, bh1750_handle_t *handle_ret)
 {
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(i2c_bus && handle_ret, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
     bh1750_dev_t *sensor = (bh1750_dev_t *) calloc(1, sizeof(bh1750_dev_t));
-    sensor->bus = port;
-    sensor->dev_addr = dev_addr << 1;
-    return (bh1750_handle_t) sensor;
+    ESP_RETURN_ON_FALSE(sensor, ESP_ERR_NO_MEM, TAG, "Not enough memory");
+    portMUX_INITIALIZE(&sensor->sample_lock);
+
+    // Add new I2C device
+    const i2c_device_config_t i2c_dev_cfg = {
+        .device_address = dev_addr,
+        .scl_speed_hz = I2C_CLK_SPEED,
+    };
+    ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(i2c_bus, &i2c_dev_cfg, &sensor->i2c_handle), err, TAG, "Failed to add new I2C device");
+
+    *handle_ret = sensor;
+    return ESP_OK;
+
+err:
+    bh1750_delete(sensor);
+    return ret;
 }
 
 esp_err_t bh1750_delete(bh1750_handle_t sensor)
 {
     bh1750_dev_t *sens = (bh1750_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    if (sens->sampler_task) {
+        bh1750_sampler_stop(sensor);
+    }
+
+    if (sens->i2c_handle) {
+        i2c_master_bus_rm_device(sens->i2c_handle);
+    }
     free(sens);
     return ESP_OK;
 }
@@ -86,28 +119,162 @@ esp_err_t bh1750_set_measure_mode(bh1750_handle_t sensor, const bh1750_measure_m
     return bh1750_write_byte(sens, (uint8_t)cmd_measure);
 }
 
+static esp_err_t bh1750_get_count(const bh1750_dev_t *const sens, uint16_t *const count)
+{
+    uint8_t bh1750_data[2];
+
+    esp_err_t ret = i2c_master_receive(sens->i2c_handle, bh1750_data, sizeof(bh1750_data), I2C_TIMEOUT_MS);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    *count = bh1750_data[0] << 8 | bh1750_data[1];
+    return ESP_OK;
+}
+
 esp_err_t bh1750_get_data(bh1750_handle_t sensor, float *const data)
 {
-    esp_err_t ret;
-    uint8_t bh1750_data_h, bh1750_data_l;
+    uint16_t count;
     bh1750_dev_t *sens = (bh1750_dev_t *) sensor;
 
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_READ, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_read_byte(cmd, &bh1750_data_h, I2C_MASTER_ACK);
-    assert(ESP_OK == ret);
-    ret = i2c_master_read_byte(cmd, &bh1750_data_l, I2C_MASTER_NACK);
-    assert(ESP_OK == ret);
-    ret = i2c_master_stop(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_cmd_begin(sens->bus, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
+    esp_err_t ret = bh1750_get_count(sens, &count);
     if (ESP_OK != ret) {
         return ret;
     }
-    *data = (( bh1750_data_h << 8 | bh1750_data_l ) / BH_1750_MEASUREMENT_ACCURACY);
+    *data = count / BH_1750_MEASUREMENT_ACCURACY;
     return ESP_OK;
 }
+
+static uint32_t bh1750_measure_time_ms(const uint8_t measure_time)
+{
+    // measurement time scales with MTreg
+    return (BH1750_H_RES_TIME_MAX_MS * measure_time + BH1750_MEASURE_TIME_DEFAULT - 1) / BH1750_MEASURE_TIME_DEFAULT;
+}
+
+static uint8_t bh1750_auto_range(const uint16_t count, const uint8_t measure_time)
+{
+    if ((count >= BH1750_RANGE_LOW_COUNT || measure_time == BH1750_MEASURE_TIME_MAX) &&
+            (count <= BH1750_RANGE_HIGH_COUNT || measure_time == BH1750_MEASURE_TIME_MIN)) {
+        return measure_time;
+    }
+    // count is proportional to the measurement time, jump directly to the target count
+    uint32_t new_time = (uint32_t)measure_time * BH1750_RANGE_TARGET_COUNT / (count ? count : 1);
+    if (new_time < BH1750_MEASURE_TIME_MIN) {
+        new_time = BH1750_MEASURE_TIME_MIN;
+    } else if (new_time > BH1750_MEASURE_TIME_MAX) {
+        new_time = BH1750_MEASURE_TIME_MAX;
+    }
+    return (uint8_t)new_time;
+}
+
+static esp_err_t bh1750_start_continuous(bh1750_dev_t *const sens, const uint8_t measure_time)
+{
+    ESP_RETURN_ON_ERROR(bh1750_set_measure_time(sens, measure_time), TAG, "set measure time failed");
+    // new measurement time is used from the next measurement, restart it
+    return bh1750_set_measure_mode(sens, BH1750_CONTINUE_1LX_RES);
+}
+
+static void bh1750_sampler_task(void *args)
+{
+    bh1750_dev_t *sens = (bh1750_dev_t *)args;
+    const bh1750_sampler_config_t *config = &sens->sampler_config;
+    uint8_t measure_time = config->measure_time;
+    TickType_t wait = pdMS_TO_TICKS(bh1750_measure_time_ms(measure_time)) + 1;
+    uint16_t count;
+    bh1750_sample_t sample;
+
+    while (sens->sampler_running) {
+        ulTaskNotifyTake(pdTRUE, wait); // woken up by bh1750_sampler_stop
+        if (!sens->sampler_running) {
+            break;
+        }
+
+        esp_err_t ret = bh1750_get_count(sens, &count);
+        if (ESP_OK != ret) {
+            ESP_LOGW(TAG, "sample failed (%s)", esp_err_to_name(ret));
+            continue;
+        }
+        sample.timestamp_us = esp_timer_get_time();
+        sample.lux = count / BH_1750_MEASUREMENT_ACCURACY * BH1750_MEASURE_TIME_DEFAULT / measure_time;
+        sample.measure_time = measure_time;
+
+        portENTER_CRITICAL(&sens->sample_lock);
+        sens->sample = sample;
+        sens->sample_valid = true;
+        portEXIT_CRITICAL(&sens->sample_lock);
+        if (config->callback) {
+            config->callback(sens, &sample, config->user_ctx);
+        }
+
+        if (config->auto_range) {
+            const uint8_t new_time = bh1750_auto_range(count, measure_time);
+            if (new_time != measure_time) {
+                ret = bh1750_start_continuous(sens, new_time);
+                if (ESP_OK != ret) {
+                    ESP_LOGW(TAG, "range change failed (%s)", esp_err_to_name(ret));
+                    continue;
+                }
+                measure_time = new_time;
+                wait = pdMS_TO_TICKS(bh1750_measure_time_ms(measure_time)) + 1;
+            }
+        }
+    }
+
+    TaskHandle_t stop_task = sens->sampler_stop_task;
+    sens->sampler_task = NULL;
+    xTaskNotifyGive(stop_task);
+    vTaskDelete(NULL);
+}
+
+esp_err_t bh1750_sampler_start(bh1750_handle_t sensor, const bh1750_sampler_config_t *config)
+{
+    bh1750_dev_t *sens = (bh1750_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens && config, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->measure_time == 0 ||
+                        (config->measure_time >= BH1750_MEASURE_TIME_MIN && config->measure_time <= BH1750_MEASURE_TIME_MAX),
+                        ESP_ERR_INVALID_ARG, TAG, "invalid measure time");
+    ESP_RETURN_ON_FALSE(!sens->sampler_task, ESP_ERR_INVALID_STATE, TAG, "sampler running");
+
+    sens->sampler_config = *config;
+    if (sens->sampler_config.measure_time == 0) {
+        sens->sampler_config.measure_time = BH1750_MEASURE_TIME_DEFAULT;
+    }
+    sens->sample_valid = false;
+
+    ESP_RETURN_ON_ERROR(bh1750_power_on(sens), TAG, "power on failed");
+    ESP_RETURN_ON_ERROR(bh1750_start_continuous(sens, sens->sampler_config.measure_time), TAG, "start failed");
+
+    sens->sampler_running = true;
+    BaseType_t res = xTaskCreate(bh1750_sampler_task, "BH1750 sampler", BH1750_SAMPLER_TASK_STACK, sens, config->task_priority, &sens->sampler_task);
+    if (pdPASS != res) {
+        sens->sampler_running = false;
+        sens->sampler_task = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t bh1750_sampler_stop(bh1750_handle_t sensor)
+{
+    bh1750_dev_t *sens = (bh1750_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(sens->sampler_task, ESP_ERR_INVALID_STATE, TAG, "sampler not running");
+
+    sens->sampler_stop_task = xTaskGetCurrentTaskHandle();
+    sens->sampler_running = false;
+    xTaskNotifyGive(sens->sampler_task);
+    // wait for the end of the running sample
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return ESP_OK;
+}
+
+esp_err_t bh1750_sampler_get_latest(bh1750_handle_t sensor, bh1750_sample_t *const sample)
+{
+    bh1750_dev_t *sens = (bh1750_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens && sample, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&sens->sample_lock);
+    const bool valid = sens->sample_valid;
+    *sample = sens->sample;
+    portEXIT_CRITICAL(&sens->sample_lock);
+    return valid ? ESP_OK : ESP_ERR_NOT_FINISHED;
+}
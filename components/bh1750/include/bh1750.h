@@ -15,7 +15,9 @@
 extern "C" {
 #endif
 
-#include "driver/i2c.h"
+#include <stdbool.h>
+#include "driver/i2c_master.h"
+#include "freertos/FreeRTOS.h"
 
 typedef enum {
     BH1750_CONTINUE_1LX_RES       = 0x10,   /*!< Command to set measure mode as Continuously H-Resolution mode*/
@@ -27,8 +29,42 @@ typedef enum {
 } bh1750_measure_mode_t;
 
 #define BH1750_I2C_ADDRESS_DEFAULT   (0x23)
+
+#define BH1750_MEASURE_TIME_DEFAULT  (69)    /*!< Default value of measurement time register (MTreg) */
+#define BH1750_MEASURE_TIME_MIN      (31)    /*!< Minimal measurement time, the highest range (up to ~120 klx) */
+#define BH1750_MEASURE_TIME_MAX      (254)   /*!< Maximal measurement time, the finest resolution (~0.23 lx) */
+
 typedef void *bh1750_handle_t;
 
+/**
+ * @brief One sample of the sampler
+ */
+typedef struct {
+    int64_t timestamp_us;   /*!< Time of the read-out (esp_timer_get_time) */
+    float lux;              /*!< Light intensity in [lx], compensated for the measurement time */
+    uint8_t measure_time;   /*!< Measurement time (MTreg) of the sample */
+} bh1750_sample_t;
+
+/**
+ * @brief Callback of the sampler (called from the sampler task)
+ *
+ * @param sensor object handle of bh1750
+ * @param[in] sample New sample
+ * @param[in] user_ctx User context of the sampler configuration
+ */
+typedef void (*bh1750_sample_callback_t)(bh1750_handle_t sensor, const bh1750_sample_t *sample, void *user_ctx);
+
+/**
+ * @brief Configuration of the sampler
+ */
+typedef struct {
+    uint8_t measure_time;               /*!< Initial measurement time (MTreg), 0: BH1750_MEASURE_TIME_DEFAULT */
+    bool auto_range;                    /*!< Adjust the measurement time to the last reading */
+    bh1750_sample_callback_t callback;  /*!< Callback of new sample (optional) */
+    void *user_ctx;                     /*!< User context passed to the callback */
+    UBaseType_t task_priority;          /*!< Priority of the sampler task */
+} bh1750_sampler_config_t;
+
 /**
  * @brief Set bh1750 as power down mode (low current)
  *
@@ -105,16 +141,19 @@ esp_err_t bh1750_get_data(bh1750_handle_t sensor, float *const data);
 esp_err_t bh1750_set_measure_time(bh1750_handle_t sensor, const uint8_t measure_time);
 
 /**
- * @brief Create and init sensor object and return a sensor handle
+ * @brief Create and init sensor object
  *
- * @param     port     I2C port number
- * @param[in] dev_addr I2C device address of sensor
+ * @param[in]  i2c_bus    I2C bus handle. Obtained from i2c_new_master_bus()
+ * @param[in]  dev_addr   I2C device address of sensor
+ * @param[out] handle_ret Handle to created BH1750 driver object
  *
  * @return
- *     - NULL Fail
- *     - Others Success
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ *     - ESP_ERR_NO_MEM Not enough memory for the driver
+ *     - Others Error from underlying I2C driver
  */
-bh1750_handle_t bh1750_create(i2c_port_t port, const uint16_t dev_addr);
+esp_err_t bh1750_create(i2c_master_bus_handle_t i2c_bus, const uint8_t dev_addr, bh1750_handle_t *handle_ret);
 
 /**
  * @brief Delete and release a sensor object
@@ -127,6 +166,54 @@ bh1750_handle_t bh1750_create(i2c_port_t port, const uint16_t dev_addr);
  */
 esp_err_t bh1750_delete(bh1750_handle_t sensor);
 
+/**
+ * @brief Start continuous sampling of light intensity
+ *
+ * The sensor is powered on and set to continuous H-resolution mode. The sampler task reads every finished measurement
+ * and keeps the last sample, so `bh1750_sampler_get_latest()` returns without any wait.
+ * With auto_range, the measurement time is lowered close to saturation and raised in dark,
+ * the sample in [lx] is compensated for it.
+ *
+ * @note Other functions of the sensor must not be called while the sampler is running.
+ *
+ * @param sensor object handle of bh1750
+ * @param[in] config Sampler configuration
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid configuration
+ *     - ESP_ERR_INVALID_STATE The sampler is running
+ *     - ESP_ERR_NO_MEM Failed to create the sampler task
+ *     - Others Error from underlying I2C driver
+ */
+esp_err_t bh1750_sampler_start(bh1750_handle_t sensor, const bh1750_sampler_config_t *config);
+
+/**
+ * @brief Stop the sampler
+ *
+ * The sensor stays in continuous mode, call `bh1750_power_down()` to save power.
+ *
+ * @param sensor object handle of bh1750
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE Sampler is not running
+ */
+esp_err_t bh1750_sampler_stop(bh1750_handle_t sensor);
+
+/**
+ * @brief Get the last sample of the sampler
+ *
+ * @param sensor object handle of bh1750
+ * @param[out] sample Last sample
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ *     - ESP_ERR_NOT_FINISHED No sample yet
+ */
+esp_err_t bh1750_sampler_get_latest(bh1750_handle_t sensor, bh1750_sample_t *const sample);
+
 #ifdef __cplusplus
 }
 #endif
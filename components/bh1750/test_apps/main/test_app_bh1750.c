@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include "unity.h"
+#include "driver/i2c_master.h"
+#include "bh1750.h"
+#include "esp_log.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define I2C_MASTER_SCL_IO 26      /*!< gpio number for I2C master clock */
+#define I2C_MASTER_SDA_IO 25      /*!< gpio number for I2C master data  */
+#define I2C_MASTER_NUM I2C_NUM_0  /*!< I2C port number for master dev */
+
+static const char *TAG = "bh1750 test";
+static bh1750_handle_t bh1750 = NULL;
+static i2c_master_bus_handle_t i2c_handle = NULL;
+
+/**
+ * @brief i2c master initialization
+ */
+static void i2c_bus_init(void)
+{
+    const i2c_master_bus_config_t bus_config = {
+        .i2c_port = I2C_MASTER_NUM,
+        .sda_io_num = I2C_MASTER_SDA_IO,
+        .scl_io_num = I2C_MASTER_SCL_IO,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .flags.enable_internal_pullup = true,
+    };
+
+    esp_err_t ret = i2c_new_master_bus(&bus_config, &i2c_handle);
+    TEST_ASSERT_EQUAL_MESSAGE(ESP_OK, ret, "I2C install returned error");
+}
+
+void bh1750_init(void)
+{
+    i2c_bus_init();
+    esp_err_t ret = bh1750_create(i2c_handle, BH1750_I2C_ADDRESS_DEFAULT, &bh1750);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_NOT_NULL_MESSAGE(bh1750, "BH1750 create returned NULL");
+}
+
+TEST_CASE("Sensor BH1750 test", "[bh1750][iot][sensor]")
+{
+    esp_err_t ret;
+    bh1750_measure_mode_t cmd_measure;
+    float bh1750_data;
+
+    bh1750_init();
+
+    ret = bh1750_power_on(bh1750);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    // one-shot mode
+    cmd_measure = BH1750_ONETIME_4LX_RES;
+    ret = bh1750_set_measure_mode(bh1750, cmd_measure);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(30 / portTICK_PERIOD_MS);
+
+    ret = bh1750_get_data(bh1750, &bh1750_data);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ESP_LOGI(TAG, "bh1750 val(one time mode): %f\n", bh1750_data);
+
+    // continous mode
+    cmd_measure = BH1750_CONTINUE_4LX_RES;
+    ret = bh1750_set_measure_mode(bh1750, cmd_measure);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(30 / portTICK_PERIOD_MS);
+
+    ret = bh1750_get_data(bh1750, &bh1750_data);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ESP_LOGI(TAG, "bh1750 val(continuously mode): %f\n", bh1750_data);
+
+    // clean-up
+    ret = bh1750_delete(bh1750);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(10); // Give FreeRTOS some time to free its resources
+}
+
+TEST_CASE("Sensor BH1750 sampler test", "[bh1750][iot][sensor]")
+{
+    esp_err_t ret;
+    bh1750_sample_t sample;
+    const bh1750_sampler_config_t sampler_cfg = {
+        .auto_range = true,
+        .task_priority = 5,
+    };
+
+    bh1750_init();
+
+    ret = bh1750_sampler_start(bh1750, &sampler_cfg);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = bh1750_sampler_get_latest(bh1750, &sample);
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FINISHED, ret);
+
+    // the longest measurement with a range change
+    vTaskDelay(pdMS_TO_TICKS(2000));
+    ret = bh1750_sampler_get_latest(bh1750, &sample);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_GREATER_OR_EQUAL(BH1750_MEASURE_TIME_MIN, sample.measure_time);
+    TEST_ASSERT_LESS_OR_EQUAL(BH1750_MEASURE_TIME_MAX, sample.measure_time);
+    ESP_LOGI(TAG, "bh1750 val(sampler): %f lx, MTreg %d", sample.lux, sample.measure_time);
+
+    ret = bh1750_sampler_stop(bh1750);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = bh1750_sampler_stop(bh1750);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ret);
+
+    // clean-up
+    ret = bh1750_power_down(bh1750);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = bh1750_delete(bh1750);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(10); // Give FreeRTOS some time to free its resources
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (500)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
@@ -17,27 +17,27 @@
 static int s_ds18b20_device_num = 0;
 static float s_temperature = 0.0;
 static ds18b20_device_handle_t s_ds18b20s[EXAMPLE_ONEWIRE_MAX_DS18B20];
+static onewire_bus_handle_t s_bus = NULL;
 
 static const char *TAG = "DS18B20";
 
 static void sensor_detect(void)
 {
     // install 1-wire bus
-    onewire_bus_handle_t bus = NULL;
     onewire_bus_config_t bus_config = {
         .bus_gpio_num = EXAMPLE_ONEWIRE_BUS_GPIO,
     };
     onewire_bus_rmt_config_t rmt_config = {
         .max_rx_bytes = 10, // 1byte ROM command + 8byte ROM number + 1byte device command
     };
-    ESP_ERROR_CHECK(onewire_new_bus_rmt(&bus_config, &rmt_config, &bus));
+    ESP_ERROR_CHECK(onewire_new_bus_rmt(&bus_config, &rmt_config, &s_bus));
 
     onewire_device_iter_handle_t iter = NULL;
     onewire_device_t next_onewire_device;
     esp_err_t search_result = ESP_OK;
 
     // create 1-wire device iterator, which is used for device search
-    ESP_ERROR_CHECK(onewire_new_device_iter(bus, &iter));
+    ESP_ERROR_CHECK(onewire_new_device_iter(s_bus, &iter));
     ESP_LOGI(TAG, "Device iterator created, start searching...");
     do {
         search_result = onewire_device_iter_get_next(iter, &next_onewire_device);
@@ -58,8 +58,13 @@ static void sensor_detect(void)
 
 void sensor_read(void)
 {
+    // start the conversion of all DS18B20 at once, then read them one by one
+    ds18b20_conversion_config_t conv_cfg = {
+        .resolution = DS18B20_RESOLUTION_12B,
+        .poll_completion = true,
+    };
+    ESP_ERROR_CHECK(ds18b20_trigger_temperature_conversion_for_all(s_bus, &conv_cfg));
     for (int i = 0; i < s_ds18b20_device_num; i ++) {
-        ESP_ERROR_CHECK(ds18b20_trigger_temperature_conversion(s_ds18b20s[i]));
         ESP_ERROR_CHECK(ds18b20_get_temperature(s_ds18b20s[i], &s_temperature));
         ESP_LOGI(TAG, "temperature read from DS18B20[%d]: %.2fC", i, s_temperature);
     }
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "onewire_bus.h"
 #include "onewire_device.h"
 #include "ds18b20_types.h"
 
@@ -22,8 +24,28 @@ typedef struct ds18b20_device_t *ds18b20_device_handle_t;
  * @brief DS18B20 configuration
  */
 typedef struct {
+    bool poll_completion; /*!< Poll the bus for the end of temperature conversion, instead of waiting for the maximal conversion time
+                               (externally powered device only, parasite powered device cannot signal it) */
 } ds18b20_config_t;
 
+/**
+ * @brief Callback of finished temperature conversion, see `ds18b20_start_temperature_conversion_with_cb`
+ *
+ * @param[in] ds18b20 DS18B20 device handle
+ * @param[in] status ESP_OK when the conversion is done and the temperature can be read, error code otherwise
+ * @param[in] user_ctx User context passed to `ds18b20_start_temperature_conversion_with_cb`
+ */
+typedef void (*ds18b20_conversion_done_cb_t)(ds18b20_device_handle_t ds18b20, esp_err_t status, void *user_ctx);
+
+/**
+ * @brief Configuration of temperature conversion of all DS18B20 on the bus
+ */
+typedef struct {
+    ds18b20_resolution_t resolution;  /*!< The highest resolution set on the bus, gives the maximal conversion time */
+    bool poll_completion;             /*!< Poll the bus and return when all devices finished the conversion
+                                           (externally powered devices only, parasite powered devices cannot signal it) */
+} ds18b20_conversion_config_t;
+
 /**
  * @brief Create a new DS18B20 device based on the general 1-Wire device
  *
@@ -70,15 +92,85 @@ esp_err_t ds18b20_set_resolution(ds18b20_device_handle_t ds18b20, ds18b20_resolu
  *
  * @note After send the trigger command, the DS18B20 will start temperature conversion.
  *       This function will delay for some while, to ensure the temperature conversion won't be interrupted.
+ *       With `poll_completion`, it returns as soon as the DS18B20 reports the end of conversion.
  *
  * @param[in] ds18b20 DS18B20 device handle returned by `ds18b20_new_device`
  * @return
  *      - ESP_OK: Trigger temperature conversion successfully
  *      - ESP_ERR_INVALID_ARG: Trigger temperature conversion failed due to invalid argument
+ *      - ESP_ERR_TIMEOUT: The conversion did not finish in the maximal conversion time (poll_completion only)
  *      - ESP_FAIL: Trigger temperature conversion failed due to other reasons
  */
 esp_err_t ds18b20_trigger_temperature_conversion(ds18b20_device_handle_t ds18b20);
 
+/**
+ * @brief Start temperature conversion of DS18B20 without waiting
+ *
+ * @note Check the end of conversion by `ds18b20_poll_temperature_conversion`, then read the result by `ds18b20_get_temperature`.
+ *       With `poll_completion`, the bus must not be used for other devices until the end of conversion,
+ *       because the DS18B20 signals it only in the read time slots right after the command.
+ *
+ * @param[in] ds18b20 DS18B20 device handle returned by `ds18b20_new_device`
+ * @return
+ *      - ESP_OK: Start temperature conversion successfully
+ *      - ESP_ERR_INVALID_ARG: Start temperature conversion failed due to invalid argument
+ *      - ESP_FAIL: Start temperature conversion failed due to other reasons
+ */
+esp_err_t ds18b20_start_temperature_conversion(ds18b20_device_handle_t ds18b20);
+
+/**
+ * @brief Check if the temperature conversion started by `ds18b20_start_temperature_conversion` is finished
+ *
+ * @note Without `poll_completion`, the conversion is finished after the maximal conversion time of the resolution
+ *       and the bus is not accessed.
+ *
+ * @param[in] ds18b20 DS18B20 device handle returned by `ds18b20_new_device`
+ * @return
+ *      - ESP_OK: The conversion is finished, the temperature can be read
+ *      - ESP_ERR_NOT_FINISHED: The conversion is still running, check again later
+ *      - ESP_ERR_INVALID_ARG: Check failed due to invalid argument
+ *      - ESP_ERR_INVALID_STATE: The conversion was not started
+ *      - ESP_ERR_TIMEOUT: The conversion did not finish in the maximal conversion time (poll_completion only)
+ *      - ESP_FAIL: Check failed due to other reasons
+ */
+esp_err_t ds18b20_poll_temperature_conversion(ds18b20_device_handle_t ds18b20);
+
+/**
+ * @brief Start temperature conversion of DS18B20 and call the callback at its end
+ *
+ * @note The end of conversion is checked by an esp_timer and the callback is called from the esp_timer task,
+ *       so it should not block (e.g. notify the task reading the temperature).
+ *       With `poll_completion`, the bus is polled from the esp_timer task and must not be used until the callback.
+ *
+ * @param[in] ds18b20 DS18B20 device handle returned by `ds18b20_new_device`
+ * @param[in] cb Callback of finished conversion
+ * @param[in] user_ctx User context passed to the callback
+ * @return
+ *      - ESP_OK: Start temperature conversion successfully
+ *      - ESP_ERR_INVALID_ARG: Start temperature conversion failed due to invalid argument
+ *      - ESP_ERR_INVALID_STATE: The previous conversion with callback is not finished
+ *      - ESP_ERR_NO_MEM: Start temperature conversion failed due to out of memory
+ *      - ESP_FAIL: Start temperature conversion failed due to other reasons
+ */
+esp_err_t ds18b20_start_temperature_conversion_with_cb(ds18b20_device_handle_t ds18b20, ds18b20_conversion_done_cb_t cb, void *user_ctx);
+
+/**
+ * @brief Trigger temperature conversion of all DS18B20 on the bus at once
+ *
+ * @note The command is sent to all devices by SKIP ROM, so the conversions run in parallel.
+ *       Read the results by `ds18b20_get_temperature` of each device afterwards.
+ *       Without polling, this function waits for the maximal conversion time of the resolution.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[in] config Conversion configuration
+ * @return
+ *      - ESP_OK: All conversions are finished
+ *      - ESP_ERR_INVALID_ARG: Trigger temperature conversion failed due to invalid argument
+ *      - ESP_ERR_TIMEOUT: Some device did not finish in the maximal conversion time (poll_completion only)
+ *      - ESP_FAIL: Trigger temperature conversion failed due to other reasons
+ */
+esp_err_t ds18b20_trigger_temperature_conversion_for_all(onewire_bus_handle_t bus, const ds18b20_conversion_config_t *config);
+
 /**
  * @brief Get temperature from DS18B20
  *
@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "onewire_bus.h"
+#include "ds18b20.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Type of DS18B20 bus manager handle
+ */
+typedef struct ds18b20_bus_t *ds18b20_bus_handle_t;
+
+/**
+ * @brief DS18B20 bus manager configuration
+ */
+typedef struct {
+    size_t max_devices;           /*!< Maximal number of DS18B20 on the bus */
+    const char *nvs_namespace;    /*!< NVS namespace of the stored ROM IDs, NULL to search the bus on every discovery.
+                                       NVS must be initialized by nvs_flash_init() before the discovery */
+    bool poll_completion;         /*!< Poll the bus for the end of conversions (externally powered devices only) */
+} ds18b20_bus_config_t;
+
+/**
+ * @brief Create a DS18B20 bus manager
+ *
+ * @note The manager owns the DS18B20 devices found by `ds18b20_bus_discover` and deletes them with itself.
+ *
+ * @param[in] bus 1-Wire bus handle
+ * @param[in] config Bus manager configuration
+ * @param[out] ret_bus Returned bus manager handle
+ * @return
+ *      - ESP_OK: Create bus manager successfully
+ *      - ESP_ERR_INVALID_ARG: Create bus manager failed due to invalid argument
+ *      - ESP_ERR_NO_MEM: Create bus manager failed due to out of memory
+ */
+esp_err_t ds18b20_bus_new(onewire_bus_handle_t bus, const ds18b20_bus_config_t *config, ds18b20_bus_handle_t *ret_bus);
+
+/**
+ * @brief Delete DS18B20 bus manager and its devices
+ *
+ * @param[in] ds_bus Bus manager handle
+ * @return
+ *      - ESP_OK: Delete bus manager successfully
+ *      - ESP_ERR_INVALID_ARG: Delete bus manager failed due to invalid argument
+ */
+esp_err_t ds18b20_bus_del(ds18b20_bus_handle_t ds_bus);
+
+/**
+ * @brief Discover DS18B20 devices on the bus
+ *
+ * @note With `nvs_namespace`, the ROM IDs stored by the previous discovery are validated by reading the scratchpad
+ *       of each device, which is much faster than the ROM search. The bus is searched (and the table is stored again)
+ *       only when some stored device does not answer, the table is missing or `force_search` is set.
+ *       New devices added to a valid chain are found only with `force_search`.
+ *       The resolution of each device is read during the discovery.
+ *
+ * @param[in] ds_bus Bus manager handle
+ * @param[in] force_search Search the bus even if the stored table is valid
+ * @param[out] ret_searched Set to true if the bus was searched (optional)
+ * @return
+ *      - ESP_OK: Discovery done, see `ds18b20_bus_get_device_count`
+ *      - ESP_ERR_INVALID_ARG: Discovery failed due to invalid argument
+ *      - ESP_ERR_NO_MEM: Discovery failed due to out of memory
+ *      - ESP_FAIL: Discovery failed due to other reasons
+ */
+esp_err_t ds18b20_bus_discover(ds18b20_bus_handle_t ds_bus, bool force_search, bool *ret_searched);
+
+/**
+ * @brief Get number of DS18B20 found by `ds18b20_bus_discover`
+ *
+ * @param[in] ds_bus Bus manager handle
+ * @return Number of devices
+ */
+size_t ds18b20_bus_get_device_count(ds18b20_bus_handle_t ds_bus);
+
+/**
+ * @brief Get DS18B20 device handle
+ *
+ * @param[in] ds_bus Bus manager handle
+ * @param[in] index Index of the device (0 to count - 1), the order is the order of the ROM search
+ * @param[out] ret_ds18b20 Device handle, owned by the bus manager
+ * @return
+ *      - ESP_OK: Get device successfully
+ *      - ESP_ERR_INVALID_ARG: Get device failed due to invalid argument
+ */
+esp_err_t ds18b20_bus_get_device(ds18b20_bus_handle_t ds_bus, size_t index, ds18b20_device_handle_t *ret_ds18b20);
+
+/**
+ * @brief Set resolution of all devices on the bus
+ *
+ * @note Only devices with a different resolution are written. When more of them differ,
+ *       the scratchpad is written to all devices at once by SKIP ROM.
+ *
+ * @param[in] ds_bus Bus manager handle
+ * @param[in] resolution Resolution of the temperature conversion
+ * @return
+ *      - ESP_OK: Set resolution successfully
+ *      - ESP_ERR_INVALID_ARG: Set resolution failed due to invalid argument
+ *      - ESP_FAIL: Set resolution failed due to other reasons
+ */
+esp_err_t ds18b20_bus_set_resolution(ds18b20_bus_handle_t ds_bus, ds18b20_resolution_t resolution);
+
+/**
+ * @brief Convert and read temperature of all devices
+ *
+ * @note One conversion command is sent to all devices. The devices are grouped by resolution and every group
+ *       is read back-to-back as soon as its conversion time elapsed, while the groups of higher resolution are still converting.
+ *       Parasite powered devices need the strong pull-up during the whole conversion, use one resolution for them.
+ *
+ * @param[in] ds_bus Bus manager handle
+ * @param[out] temperatures Temperatures in order of the devices, NAN for a device that failed
+ * @param[in] count Size of temperatures array
+ * @return
+ *      - ESP_OK: All temperatures read successfully
+ *      - ESP_ERR_INVALID_ARG: Read failed due to invalid argument
+ *      - ESP_ERR_INVALID_CRC: Scratchpad of some device had CRC error
+ *      - ESP_ERR_TIMEOUT: Some device did not finish the conversion (poll_completion only)
+ *      - ESP_FAIL: Read failed due to other reasons
+ */
+esp_err_t ds18b20_bus_read_temperatures(ds18b20_bus_handle_t ds_bus, float *temperatures, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "ds18b20.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DS18B20_FAMILY_CODE           0x28
+
+#define DS18B20_CMD_CONVERT_TEMP      0x44
+#define DS18B20_CMD_WRITE_SCRATCHPAD  0x4E
+#define DS18B20_CMD_READ_SCRATCHPAD   0xBE
+
+#define DS18B20_POLL_INTERVAL_MS      10
+
+/**
+ * @brief Maximal temperature conversion time of each resolution
+ */
+extern const uint32_t ds18b20_conversion_time_ms[4];
+
+/**
+ * @brief Structure of DS18B20's scratchpad
+ */
+typedef struct  {
+    uint8_t temp_lsb;      /*!< lsb of temperature */
+    uint8_t temp_msb;      /*!< msb of temperature */
+    uint8_t th_user1;      /*!< th register or user byte 1 */
+    uint8_t tl_user2;      /*!< tl register or user byte 2 */
+    uint8_t configuration; /*!< resolution configuration register */
+    uint8_t _reserved1;
+    uint8_t _reserved2;
+    uint8_t _reserved3;
+    uint8_t crc_value;     /*!< crc value of scratchpad data */
+} __attribute__((packed)) ds18b20_scratchpad_t;
+
+typedef struct ds18b20_device_t {
+    onewire_bus_handle_t bus;
+    onewire_device_address_t addr;
+    uint8_t th_user1;
+    uint8_t tl_user2;
+    ds18b20_resolution_t resolution;
+    bool poll_completion;
+    bool converting;
+    int64_t conversion_start_us;
+    esp_timer_handle_t conversion_timer;
+    ds18b20_conversion_done_cb_t conversion_done_cb;
+    void *user_ctx;
+} ds18b20_device_t;
+
+/**
+ * @brief Reset the bus, select the device and read its scratchpad
+ *
+ * @param[in] ds18b20 DS18B20 device handle
+ * @param[out] scratchpad Scratchpad with checked CRC
+ * @return
+ *      - ESP_OK: Read scratchpad successfully
+ *      - ESP_ERR_INVALID_CRC: CRC check error (e.g. the device is not present)
+ *      - ESP_FAIL: Read failed due to other reasons
+ */
+esp_err_t ds18b20_read_scratchpad(ds18b20_device_handle_t ds18b20, ds18b20_scratchpad_t *scratchpad);
+
+/**
+ * @brief Convert temperature in the scratchpad to degrees Celsius
+ */
+float ds18b20_scratchpad_to_celsius(const ds18b20_scratchpad_t *scratchpad);
+
+/**
+ * @brief Resolution of the configuration register in the scratchpad
+ */
+static inline ds18b20_resolution_t ds18b20_scratchpad_resolution(const ds18b20_scratchpad_t *scratchpad)
+{
+    return (ds18b20_resolution_t)((scratchpad->configuration >> 5) & 0x03);
+}
+
+#ifdef __cplusplus
+}
+#endif
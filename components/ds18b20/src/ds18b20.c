@@ -7,46 +7,24 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_check.h"
+#include "esp_timer.h"
 #include "onewire_bus.h"
 #include "onewire_cmd.h"
 #include "onewire_crc.h"
 #include "ds18b20.h"
+#include "ds18b20_priv.h"
 
 static const char *TAG = "ds18b20";
 
-#define DS18B20_CMD_CONVERT_TEMP      0x44
-#define DS18B20_CMD_WRITE_SCRATCHPAD  0x4E
-#define DS18B20_CMD_READ_SCRATCHPAD   0xBE
-
-/**
- * @brief Structure of DS18B20's scratchpad
- */
-typedef struct  {
-    uint8_t temp_lsb;      /*!< lsb of temperature */
-    uint8_t temp_msb;      /*!< msb of temperature */
-    uint8_t th_user1;      /*!< th register or user byte 1 */
-    uint8_t tl_user2;      /*!< tl register or user byte 2 */
-    uint8_t configuration; /*!< resolution configuration register */
-    uint8_t _reserved1;
-    uint8_t _reserved2;
-    uint8_t _reserved3;
-    uint8_t crc_value;     /*!< crc value of scratchpad data */
-} __attribute__((packed)) ds18b20_scratchpad_t;
-
-typedef struct ds18b20_device_t {
-    onewire_bus_handle_t bus;
-    onewire_device_address_t addr;
-    uint8_t th_user1;
-    uint8_t tl_user2;
-    ds18b20_resolution_t resolution;
-} ds18b20_device_t;
+// maximal temperature conversion time of each resolution
+const uint32_t ds18b20_conversion_time_ms[4] = {100, 200, 400, 800};
 
 esp_err_t ds18b20_new_device(onewire_device_t *device, const ds18b20_config_t *config, ds18b20_device_handle_t *ret_ds18b20)
 {
     ds18b20_device_t *ds18b20 = NULL;
     ESP_RETURN_ON_FALSE(device && config && ret_ds18b20, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
     // check ROM ID, the family code of DS18B20 is 0x28
-    if ((device->address & 0xFF) != 0x28) {
+    if ((device->address & 0xFF) != DS18B20_FAMILY_CODE) {
         ESP_LOGD(TAG, "%016llX is not a DS18B20 device", device->address);
         return ESP_ERR_NOT_SUPPORTED;
     }
@@ -56,6 +34,7 @@ esp_err_t ds18b20_new_device(onewire_device_t *device, const ds18b20_config_t *c
     ds18b20->bus = device->bus;
     ds18b20->addr = device->address;
     ds18b20->resolution = DS18B20_RESOLUTION_12B; // DS18B20 default resolution is 12 bits
+    ds18b20->poll_completion = config->poll_completion;
 
     *ret_ds18b20 = ds18b20;
     return ESP_OK;
@@ -64,6 +43,10 @@ esp_err_t ds18b20_new_device(onewire_device_t *device, const ds18b20_config_t *c
 esp_err_t ds18b20_del_device(ds18b20_device_handle_t ds18b20)
 {
     ESP_RETURN_ON_FALSE(ds18b20, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (ds18b20->conversion_timer) {
+        esp_timer_stop(ds18b20->conversion_timer);
+        esp_timer_delete(ds18b20->conversion_timer);
+    }
     free(ds18b20);
     return ESP_OK;
 }
@@ -100,7 +83,7 @@ esp_err_t ds18b20_set_resolution(ds18b20_device_handle_t ds18b20, ds18b20_resolu
     return ESP_OK;
 }
 
-esp_err_t ds18b20_trigger_temperature_conversion(ds18b20_device_handle_t ds18b20)
+esp_err_t ds18b20_start_temperature_conversion(ds18b20_device_handle_t ds18b20)
 {
     ESP_RETURN_ON_FALSE(ds18b20, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
     // reset bus and check if the ds18b20 is present
@@ -109,16 +92,134 @@ esp_err_t ds18b20_trigger_temperature_conversion(ds18b20_device_handle_t ds18b20
     // send command: DS18B20_CMD_CONVERT_TEMP
     ESP_RETURN_ON_ERROR(ds18b20_send_command(ds18b20, DS18B20_CMD_CONVERT_TEMP), TAG, "send DS18B20_CMD_CONVERT_TEMP failed");
 
-    // delay proper time for temperature conversion
-    const uint32_t delays_ms[] = {100, 200, 400, 800};
-    vTaskDelay(pdMS_TO_TICKS(delays_ms[ds18b20->resolution]));
+    ds18b20->conversion_start_us = esp_timer_get_time();
+    ds18b20->converting = true;
+    return ESP_OK;
+}
+
+esp_err_t ds18b20_poll_temperature_conversion(ds18b20_device_handle_t ds18b20)
+{
+    ESP_RETURN_ON_FALSE(ds18b20, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(ds18b20->converting, ESP_ERR_INVALID_STATE, TAG, "conversion not started");
+
+    const bool expired = (esp_timer_get_time() - ds18b20->conversion_start_us) >= ds18b20_conversion_time_ms[ds18b20->resolution] * 1000LL;
+    if (ds18b20->poll_completion) {
+        // the ds18b20 holds the read time slots low while converting
+        uint8_t done = 0;
+        ESP_RETURN_ON_ERROR(onewire_bus_read_bit(ds18b20->bus, &done), TAG, "read conversion status failed");
+        if (!done) {
+            if (expired) {
+                ds18b20->converting = false;
+                ESP_LOGE(TAG, "temperature conversion timeout");
+                return ESP_ERR_TIMEOUT;
+            }
+            return ESP_ERR_NOT_FINISHED;
+        }
+    } else if (!expired) {
+        return ESP_ERR_NOT_FINISHED;
+    }
 
+    ds18b20->converting = false;
     return ESP_OK;
 }
 
-esp_err_t ds18b20_get_temperature(ds18b20_device_handle_t ds18b20, float *ret_temperature)
+static uint64_t ds18b20_next_poll_us(ds18b20_device_handle_t ds18b20)
+{
+    if (ds18b20->poll_completion) {
+        return DS18B20_POLL_INTERVAL_MS * 1000ULL;
+    }
+    // without polling, the conversion is done after the maximal conversion time
+    int64_t remain_us = ds18b20->conversion_start_us + ds18b20_conversion_time_ms[ds18b20->resolution] * 1000LL - esp_timer_get_time();
+    return remain_us > 0 ? remain_us : 0;
+}
+
+static void ds18b20_conversion_timer_cb(void *arg)
+{
+    ds18b20_device_handle_t ds18b20 = (ds18b20_device_handle_t)arg;
+    esp_err_t ret = ds18b20_poll_temperature_conversion(ds18b20);
+    if (ret == ESP_ERR_NOT_FINISHED) {
+        ret = esp_timer_start_once(ds18b20->conversion_timer, ds18b20_next_poll_us(ds18b20));
+        if (ret == ESP_OK) {
+            return;
+        }
+        ds18b20->converting = false;
+    }
+    ds18b20->conversion_done_cb(ds18b20, ret, ds18b20->user_ctx);
+}
+
+esp_err_t ds18b20_start_temperature_conversion_with_cb(ds18b20_device_handle_t ds18b20, ds18b20_conversion_done_cb_t cb, void *user_ctx)
+{
+    ESP_RETURN_ON_FALSE(ds18b20 && cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!ds18b20->conversion_timer) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = ds18b20_conversion_timer_cb,
+            .arg = ds18b20,
+            .name = "ds18b20",
+        };
+        ESP_RETURN_ON_ERROR(esp_timer_create(&timer_args, &ds18b20->conversion_timer), TAG, "create timer failed");
+    }
+    ESP_RETURN_ON_FALSE(!esp_timer_is_active(ds18b20->conversion_timer), ESP_ERR_INVALID_STATE, TAG, "conversion in progress");
+
+    ds18b20->conversion_done_cb = cb;
+    ds18b20->user_ctx = user_ctx;
+    ESP_RETURN_ON_ERROR(ds18b20_start_temperature_conversion(ds18b20), TAG, "start conversion failed");
+    esp_err_t ret = esp_timer_start_once(ds18b20->conversion_timer, ds18b20_next_poll_us(ds18b20));
+    if (ret != ESP_OK) {
+        ds18b20->converting = false;
+    }
+    return ret;
+}
+
+esp_err_t ds18b20_trigger_temperature_conversion(ds18b20_device_handle_t ds18b20)
+{
+    ESP_RETURN_ON_ERROR(ds18b20_start_temperature_conversion(ds18b20), TAG, "start conversion failed");
+
+    // delay proper time for temperature conversion, or until the ds18b20 reports it is done
+    esp_err_t ret;
+    while ((ret = ds18b20_poll_temperature_conversion(ds18b20)) == ESP_ERR_NOT_FINISHED) {
+        uint32_t delay_ms = (ds18b20_next_poll_us(ds18b20) + 999) / 1000;
+        vTaskDelay(pdMS_TO_TICKS(delay_ms) ? pdMS_TO_TICKS(delay_ms) : 1);
+    }
+
+    return ret;
+}
+
+esp_err_t ds18b20_trigger_temperature_conversion_for_all(onewire_bus_handle_t bus, const ds18b20_conversion_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(bus && config && config->resolution <= DS18B20_RESOLUTION_12B, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    // reset bus and check if any device is present
+    ESP_RETURN_ON_ERROR(onewire_bus_reset(bus), TAG, "reset bus error");
+
+    // send command to all devices at once: DS18B20_CMD_CONVERT_TEMP
+    const uint8_t tx_buffer[] = {ONEWIRE_CMD_SKIP_ROM, DS18B20_CMD_CONVERT_TEMP};
+    ESP_RETURN_ON_ERROR(onewire_bus_write_bytes(bus, tx_buffer, sizeof(tx_buffer)), TAG, "send DS18B20_CMD_CONVERT_TEMP failed");
+
+    const uint32_t conversion_time_ms = ds18b20_conversion_time_ms[config->resolution];
+    if (!config->poll_completion) {
+        vTaskDelay(pdMS_TO_TICKS(conversion_time_ms));
+        return ESP_OK;
+    }
+
+    // devices hold the read time slots low while converting, the bus reads 1 when the last one is done
+    const TickType_t poll_ticks = pdMS_TO_TICKS(DS18B20_POLL_INTERVAL_MS) ? pdMS_TO_TICKS(DS18B20_POLL_INTERVAL_MS) : 1;
+    const TickType_t start = xTaskGetTickCount();
+    uint8_t done = 0;
+    while (true) {
+        ESP_RETURN_ON_ERROR(onewire_bus_read_bit(bus, &done), TAG, "read conversion status failed");
+        if (done) {
+            return ESP_OK;
+        }
+        if ((xTaskGetTickCount() - start) >= pdMS_TO_TICKS(conversion_time_ms)) {
+            break;
+        }
+        vTaskDelay(poll_ticks);
+    }
+    ESP_LOGE(TAG, "temperature conversion timeout");
+    return ESP_ERR_TIMEOUT;
+}
+
+esp_err_t ds18b20_read_scratchpad(ds18b20_device_handle_t ds18b20, ds18b20_scratchpad_t *scratchpad)
 {
-    ESP_RETURN_ON_FALSE(ds18b20 && ret_temperature, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
     // reset bus and check if the ds18b20 is present
     ESP_RETURN_ON_ERROR(onewire_bus_reset(ds18b20->bus), TAG, "reset bus error");
 
@@ -126,18 +227,30 @@ esp_err_t ds18b20_get_temperature(ds18b20_device_handle_t ds18b20, float *ret_te
     ESP_RETURN_ON_ERROR(ds18b20_send_command(ds18b20, DS18B20_CMD_READ_SCRATCHPAD), TAG, "send DS18B20_CMD_READ_SCRATCHPAD failed");
 
     // read scratchpad data
-    ds18b20_scratchpad_t scratchpad;
-    ESP_RETURN_ON_ERROR(onewire_bus_read_bytes(ds18b20->bus, (uint8_t *)&scratchpad, sizeof(scratchpad)),
+    ESP_RETURN_ON_ERROR(onewire_bus_read_bytes(ds18b20->bus, (uint8_t *)scratchpad, sizeof(*scratchpad)),
                         TAG, "error while reading scratchpad data");
     // check crc
-    ESP_RETURN_ON_FALSE(onewire_crc8(0, (uint8_t *)&scratchpad, 8) == scratchpad.crc_value, ESP_ERR_INVALID_CRC, TAG, "scratchpad crc error");
+    ESP_RETURN_ON_FALSE(onewire_crc8(0, (uint8_t *)scratchpad, 8) == scratchpad->crc_value, ESP_ERR_INVALID_CRC, TAG, "scratchpad crc error");
+    return ESP_OK;
+}
 
+float ds18b20_scratchpad_to_celsius(const ds18b20_scratchpad_t *scratchpad)
+{
     const uint8_t lsb_mask[4] = {0x07, 0x03, 0x01, 0x00}; // mask bits not used in low resolution
-    uint8_t lsb_masked = scratchpad.temp_lsb & (~lsb_mask[scratchpad.configuration >> 5]);
+    uint8_t lsb_masked = scratchpad->temp_lsb & (~lsb_mask[ds18b20_scratchpad_resolution(scratchpad)]);
     // Combine the MSB and masked LSB into a signed 16-bit integer
-    int16_t temperature_raw = (((int16_t)scratchpad.temp_msb << 8) | lsb_masked);
+    int16_t temperature_raw = (((int16_t)scratchpad->temp_msb << 8) | lsb_masked);
     // Convert the raw temperature to a float,
-    *ret_temperature = temperature_raw / 16.0f;
+    return temperature_raw / 16.0f;
+}
+
+esp_err_t ds18b20_get_temperature(ds18b20_device_handle_t ds18b20, float *ret_temperature)
+{
+    ESP_RETURN_ON_FALSE(ds18b20 && ret_temperature, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    ds18b20_scratchpad_t scratchpad;
+    ESP_RETURN_ON_ERROR(ds18b20_read_scratchpad(ds18b20, &scratchpad), TAG, "read scratchpad failed");
+    *ret_temperature = ds18b20_scratchpad_to_celsius(&scratchpad);
 
     return ESP_OK;
 }
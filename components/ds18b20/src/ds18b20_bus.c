@@ -0,0 +1,315 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "nvs.h"
+#include "onewire_bus.h"
+#include "onewire_cmd.h"
+#include "onewire_device.h"
+#include "ds18b20.h"
+#include "ds18b20_bus.h"
+#include "ds18b20_priv.h"
+
+static const char *TAG = "ds18b20_bus";
+
+#define DS18B20_BUS_NVS_KEY  "rom_ids"
+
+typedef struct ds18b20_bus_t {
+    onewire_bus_handle_t bus;
+    char nvs_namespace[NVS_KEY_NAME_MAX_SIZE];
+    bool poll_completion;
+    size_t max_devices;
+    size_t num_devices;
+    ds18b20_device_handle_t devices[];
+} ds18b20_bus_t;
+
+esp_err_t ds18b20_bus_new(onewire_bus_handle_t bus, const ds18b20_bus_config_t *config, ds18b20_bus_handle_t *ret_bus)
+{
+    ESP_RETURN_ON_FALSE(bus && config && ret_bus && config->max_devices, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!config->nvs_namespace || strlen(config->nvs_namespace) < NVS_KEY_NAME_MAX_SIZE,
+                        ESP_ERR_INVALID_ARG, TAG, "NVS namespace too long");
+
+    ds18b20_bus_t *ds_bus = calloc(1, sizeof(ds18b20_bus_t) + config->max_devices * sizeof(ds18b20_device_handle_t));
+    ESP_RETURN_ON_FALSE(ds_bus, ESP_ERR_NO_MEM, TAG, "no mem for ds18b20 bus");
+    ds_bus->bus = bus;
+    ds_bus->poll_completion = config->poll_completion;
+    ds_bus->max_devices = config->max_devices;
+    if (config->nvs_namespace) {
+        strcpy(ds_bus->nvs_namespace, config->nvs_namespace);
+    }
+
+    *ret_bus = ds_bus;
+    return ESP_OK;
+}
+
+static void ds18b20_bus_clear(ds18b20_bus_handle_t ds_bus)
+{
+    for (size_t i = 0; i < ds_bus->num_devices; i++) {
+        ds18b20_del_device(ds_bus->devices[i]);
+        ds_bus->devices[i] = NULL;
+    }
+    ds_bus->num_devices = 0;
+}
+
+esp_err_t ds18b20_bus_del(ds18b20_bus_handle_t ds_bus)
+{
+    ESP_RETURN_ON_FALSE(ds_bus, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ds18b20_bus_clear(ds_bus);
+    free(ds_bus);
+    return ESP_OK;
+}
+
+/* Create the device and read its scratchpad, which checks its presence and gives its resolution */
+static esp_err_t ds18b20_bus_add_device(ds18b20_bus_handle_t ds_bus, onewire_device_address_t address)
+{
+    onewire_device_t device = {
+        .bus = ds_bus->bus,
+        .address = address,
+    };
+    const ds18b20_config_t ds_cfg = {
+        .poll_completion = ds_bus->poll_completion,
+    };
+    ds18b20_device_handle_t ds18b20 = NULL;
+    ESP_RETURN_ON_ERROR(ds18b20_new_device(&device, &ds_cfg, &ds18b20), TAG, "create device failed");
+
+    ds18b20_scratchpad_t scratchpad;
+    esp_err_t ret = ds18b20_read_scratchpad(ds18b20, &scratchpad);
+    if (ret != ESP_OK) {
+        ds18b20_del_device(ds18b20);
+        return ret;
+    }
+    ds18b20->resolution = ds18b20_scratchpad_resolution(&scratchpad);
+    ds18b20->th_user1 = scratchpad.th_user1;
+    ds18b20->tl_user2 = scratchpad.tl_user2;
+    ds_bus->devices[ds_bus->num_devices++] = ds18b20;
+    return ESP_OK;
+}
+
+static esp_err_t ds18b20_bus_load_table(ds18b20_bus_handle_t ds_bus, onewire_device_address_t *addrs, size_t *count)
+{
+    nvs_handle_t nvs;
+    size_t len = ds_bus->max_devices * sizeof(onewire_device_address_t);
+    // missing table is the first boot, not an error
+    esp_err_t ret = nvs_open(ds_bus->nvs_namespace, NVS_READONLY, &nvs);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = nvs_get_blob(nvs, DS18B20_BUS_NVS_KEY, addrs, &len);
+    nvs_close(nvs);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ESP_RETURN_ON_FALSE(len && len % sizeof(onewire_device_address_t) == 0, ESP_ERR_INVALID_SIZE, TAG, "invalid stored ROM IDs");
+    *count = len / sizeof(onewire_device_address_t);
+    return ESP_OK;
+}
+
+static esp_err_t ds18b20_bus_store_table(ds18b20_bus_handle_t ds_bus)
+{
+    onewire_device_address_t addrs[ds_bus->num_devices ? ds_bus->num_devices : 1];
+    for (size_t i = 0; i < ds_bus->num_devices; i++) {
+        addrs[i] = ds_bus->devices[i]->addr;
+    }
+
+    nvs_handle_t nvs;
+    ESP_RETURN_ON_ERROR(nvs_open(ds_bus->nvs_namespace, NVS_READWRITE, &nvs), TAG, "open NVS failed");
+    esp_err_t ret = nvs_set_blob(nvs, DS18B20_BUS_NVS_KEY, addrs, ds_bus->num_devices * sizeof(onewire_device_address_t));
+    if (ret == ESP_OK) {
+        ret = nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+    ESP_RETURN_ON_ERROR(ret, TAG, "store ROM IDs failed");
+    return ESP_OK;
+}
+
+/* Validate the stored table, all stored devices must answer */
+static esp_err_t ds18b20_bus_validate_table(ds18b20_bus_handle_t ds_bus, const onewire_device_address_t *addrs, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (ds18b20_bus_add_device(ds_bus, addrs[i]) != ESP_OK) {
+            ESP_LOGI(TAG, "stored DS18B20 %016llX not found", addrs[i]);
+            ds18b20_bus_clear(ds_bus);
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t ds18b20_bus_search(ds18b20_bus_handle_t ds_bus)
+{
+    onewire_device_iter_handle_t iter = NULL;
+    onewire_device_t next_onewire_device;
+    esp_err_t search_result = ESP_OK;
+
+    ESP_RETURN_ON_ERROR(onewire_new_device_iter(ds_bus->bus, &iter), TAG, "create device iterator failed");
+    do {
+        search_result = onewire_device_iter_get_next(iter, &next_onewire_device);
+        if (search_result == ESP_OK && (next_onewire_device.address & 0xFF) == DS18B20_FAMILY_CODE) {
+            if (ds_bus->num_devices == ds_bus->max_devices) {
+                ESP_LOGW(TAG, "more than %u DS18B20 on the bus", (unsigned)ds_bus->max_devices);
+                break;
+            }
+            if (ds18b20_bus_add_device(ds_bus, next_onewire_device.address) != ESP_OK) {
+                ESP_LOGW(TAG, "DS18B20 %016llX does not answer", next_onewire_device.address);
+            }
+        }
+    } while (search_result != ESP_ERR_NOT_FOUND);
+    onewire_del_device_iter(iter);
+    return ESP_OK;
+}
+
+esp_err_t ds18b20_bus_discover(ds18b20_bus_handle_t ds_bus, bool force_search, bool *ret_searched)
+{
+    ESP_RETURN_ON_FALSE(ds_bus, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ds18b20_bus_clear(ds_bus);
+
+    const bool use_nvs = ds_bus->nvs_namespace[0] != '\0';
+    if (use_nvs && !force_search) {
+        onewire_device_address_t *addrs = calloc(ds_bus->max_devices, sizeof(onewire_device_address_t));
+        ESP_RETURN_ON_FALSE(addrs, ESP_ERR_NO_MEM, TAG, "no mem for ROM IDs");
+        size_t count = 0;
+        esp_err_t ret = ds18b20_bus_load_table(ds_bus, addrs, &count);
+        if (ret == ESP_OK) {
+            ret = ds18b20_bus_validate_table(ds_bus, addrs, count);
+        }
+        free(addrs);
+        if (ret == ESP_OK) {
+            ESP_LOGD(TAG, "%u stored DS18B20 validated", (unsigned)ds_bus->num_devices);
+            if (ret_searched) {
+                *ret_searched = false;
+            }
+            return ESP_OK;
+        }
+    }
+
+    ESP_RETURN_ON_ERROR(ds18b20_bus_search(ds_bus), TAG, "search bus failed");
+    ESP_LOGI(TAG, "%u DS18B20 found by search", (unsigned)ds_bus->num_devices);
+    if (ret_searched) {
+        *ret_searched = true;
+    }
+    if (use_nvs) {
+        ESP_RETURN_ON_ERROR(ds18b20_bus_store_table(ds_bus), TAG, "store table failed");
+    }
+    return ESP_OK;
+}
+
+size_t ds18b20_bus_get_device_count(ds18b20_bus_handle_t ds_bus)
+{
+    return ds_bus ? ds_bus->num_devices : 0;
+}
+
+esp_err_t ds18b20_bus_get_device(ds18b20_bus_handle_t ds_bus, size_t index, ds18b20_device_handle_t *ret_ds18b20)
+{
+    ESP_RETURN_ON_FALSE(ds_bus && ret_ds18b20 && index < ds_bus->num_devices, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    *ret_ds18b20 = ds_bus->devices[index];
+    return ESP_OK;
+}
+
+esp_err_t ds18b20_bus_set_resolution(ds18b20_bus_handle_t ds_bus, ds18b20_resolution_t resolution)
+{
+    ESP_RETURN_ON_FALSE(ds_bus && resolution <= DS18B20_RESOLUTION_12B, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    size_t differ = 0;
+    ds18b20_device_handle_t last = NULL;
+    for (size_t i = 0; i < ds_bus->num_devices; i++) {
+        if (ds_bus->devices[i]->resolution != resolution) {
+            last = ds_bus->devices[i];
+            differ++;
+        }
+    }
+    if (differ == 0) {
+        return ESP_OK;
+    }
+    if (differ == 1) {
+        return ds18b20_set_resolution(last, resolution);
+    }
+
+    // write scratchpad of all devices at once, the alarm bytes of the first device are written to all of them
+    const uint8_t resolution_data[] = {0x1F, 0x3F, 0x5F, 0x7F};
+    const uint8_t tx_buffer[] = {ONEWIRE_CMD_SKIP_ROM, DS18B20_CMD_WRITE_SCRATCHPAD,
+                                 ds_bus->devices[0]->th_user1, ds_bus->devices[0]->tl_user2, resolution_data[resolution]
+                                };
+    ESP_RETURN_ON_ERROR(onewire_bus_reset(ds_bus->bus), TAG, "reset bus error");
+    ESP_RETURN_ON_ERROR(onewire_bus_write_bytes(ds_bus->bus, tx_buffer, sizeof(tx_buffer)), TAG, "send new resolution failed");
+    for (size_t i = 0; i < ds_bus->num_devices; i++) {
+        ds_bus->devices[i]->resolution = resolution;
+        ds_bus->devices[i]->th_user1 = ds_bus->devices[0]->th_user1;
+        ds_bus->devices[i]->tl_user2 = ds_bus->devices[0]->tl_user2;
+    }
+    return ESP_OK;
+}
+
+/* Read all devices of one resolution group, keeps the first error */
+static esp_err_t ds18b20_bus_read_group(ds18b20_bus_handle_t ds_bus, int resolution, float *temperatures, size_t count, esp_err_t ret)
+{
+    ds18b20_scratchpad_t scratchpad;
+    for (size_t i = 0; i < count; i++) {
+        ds18b20_device_handle_t ds18b20 = ds_bus->devices[i];
+        if (resolution >= 0 && (int)ds18b20->resolution != resolution) {
+            continue;
+        }
+        esp_err_t err = ds18b20_read_scratchpad(ds18b20, &scratchpad);
+        if (err == ESP_OK) {
+            temperatures[i] = ds18b20_scratchpad_to_celsius(&scratchpad);
+        } else {
+            temperatures[i] = NAN;
+            ret = (ret == ESP_OK) ? err : ret;
+        }
+    }
+    return ret;
+}
+
+esp_err_t ds18b20_bus_read_temperatures(ds18b20_bus_handle_t ds_bus, float *temperatures, size_t count)
+{
+    ESP_RETURN_ON_FALSE(ds_bus && temperatures, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    count = (count < ds_bus->num_devices) ? count : ds_bus->num_devices;
+    if (count == 0) {
+        return ESP_OK;
+    }
+
+    // groups of resolution present on the bus
+    uint8_t groups = 0;
+    ds18b20_resolution_t highest = DS18B20_RESOLUTION_9B;
+    for (size_t i = 0; i < count; i++) {
+        groups |= (1 << ds_bus->devices[i]->resolution);
+        highest = (ds_bus->devices[i]->resolution > highest) ? ds_bus->devices[i]->resolution : highest;
+    }
+
+    if (ds_bus->poll_completion) {
+        // the devices signal the end only right after the command, so all of them are read at the end
+        const ds18b20_conversion_config_t conv_cfg = {
+            .resolution = highest,
+            .poll_completion = true,
+        };
+        ESP_RETURN_ON_ERROR(ds18b20_trigger_temperature_conversion_for_all(ds_bus->bus, &conv_cfg), TAG, "conversion failed");
+        return ds18b20_bus_read_group(ds_bus, -1, temperatures, count, ESP_OK);
+    }
+
+    ESP_RETURN_ON_ERROR(onewire_bus_reset(ds_bus->bus), TAG, "reset bus error");
+    const uint8_t tx_buffer[] = {ONEWIRE_CMD_SKIP_ROM, DS18B20_CMD_CONVERT_TEMP};
+    ESP_RETURN_ON_ERROR(onewire_bus_write_bytes(ds_bus->bus, tx_buffer, sizeof(tx_buffer)), TAG, "send DS18B20_CMD_CONVERT_TEMP failed");
+    const int64_t start_us = esp_timer_get_time();
+
+    // read every group as soon as its conversion time elapsed, the higher resolutions continue converting
+    esp_err_t ret = ESP_OK;
+    for (int res = DS18B20_RESOLUTION_9B; res <= DS18B20_RESOLUTION_12B; res++) {
+        if (!(groups & (1 << res))) {
+            continue;
+        }
+        const int64_t remain_us = start_us + ds18b20_conversion_time_ms[res] * 1000LL - esp_timer_get_time();
+        if (remain_us > 0) {
+            const TickType_t ticks = pdMS_TO_TICKS((remain_us + 999) / 1000);
+            vTaskDelay(ticks ? ticks : 1);
+        }
+        ret = ds18b20_bus_read_group(ds_bus, res, temperatures, count, ret);
+    }
+    return ret;
+}
@@ -5,6 +5,7 @@
  */
 
 #include <inttypes.h>
+#include <sys/param.h>
 #include "es7210.h"
 #include "es7210_reg.h"
 #include "esp_log.h"
@@ -29,11 +30,6 @@ const static char *TAG = "ES7210";
                         TAG, "i2c communication error while writing "#reg_addr); \
 } while(0)
 
-struct es7210_dev_t {
-    i2c_port_t  i2c_port;
-    uint8_t     i2c_addr;
-};
-
 /**
  * @brief Clock coefficient structure
  *
@@ -51,6 +47,17 @@ typedef struct {
     uint32_t lrck_l;          /*!< The low 8 bits of lrck */
 } coeff_div_t;
 
+typedef struct {
+    uint8_t reg;
+    uint8_t value;
+} es7210_reg_value_t;
+
+struct es7210_dev_t {
+    i2c_port_t          i2c_port;
+    uint8_t             i2c_addr;
+    const coeff_div_t   *coeff;     /* coefficients of the current sample rate, NULL if not configured */
+};
+
 /**
  * @brief ES7210 clock coefficient lookup table
  *
@@ -150,10 +157,100 @@ err:
     return ret;
 }
 
-static esp_err_t es7210_set_i2s_format(es7210_dev_handle_t handle, es7210_i2s_fmt_t i2s_format,
-                                       es7210_i2s_bits_t bit_width, bool tdm_enable)
+/* All registers of the table are written in one I2C transaction, each of them after repeated START */
+static esp_err_t es7210_write_regs(es7210_dev_handle_t handle, const es7210_reg_value_t *regs, size_t count)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid device handle");
+    esp_err_t ret = ESP_OK;
+
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    ESP_GOTO_ON_FALSE(cmd, ESP_ERR_NO_MEM, err, TAG, "memory allocation for i2c cmd handle failed");
+
+    for (size_t i = 0; i < count; i++) {
+        ESP_GOTO_ON_ERROR(i2c_master_start(cmd), err, TAG, "error while appending i2c command");
+        ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, handle->i2c_addr << 1 | I2C_MASTER_WRITE, true),
+                          err, TAG, "error while appending i2c command");
+        ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, regs[i].reg, true), err,
+                          TAG, "error while appending i2c command");
+        ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, regs[i].value, true), err,
+                          TAG, "error while appending i2c command");
+    }
+    ESP_GOTO_ON_ERROR(i2c_master_stop(cmd), err, TAG, "error while appending i2c command");
+
+    ESP_GOTO_ON_ERROR(i2c_master_cmd_begin(handle->i2c_port, cmd, pdMS_TO_TICKS(1000)),
+                      err, TAG, "error while writing registers");
+err:
+    if (cmd) {
+        i2c_cmd_link_delete(cmd);
+    }
+    return ret;
+}
+
+/* Consecutive registers are read in one I2C transaction, register address is incremented by ES7210 */
+static esp_err_t es7210_read_regs(es7210_dev_handle_t handle, uint8_t reg_addr, uint8_t *reg_val, size_t count)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid device handle");
+    esp_err_t ret = ESP_OK;
+
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    ESP_GOTO_ON_FALSE(cmd, ESP_ERR_NO_MEM, err, TAG, "memory allocation for i2c cmd handle failed");
+
+    ESP_GOTO_ON_ERROR(i2c_master_start(cmd), err, TAG, "error while appending i2c command");
+    ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, handle->i2c_addr << 1 | I2C_MASTER_WRITE, true),
+                      err, TAG, "error while appending i2c command");
+    ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, reg_addr, true), err,
+                      TAG, "error while appending i2c command");
+    ESP_GOTO_ON_ERROR(i2c_master_start(cmd), err, TAG, "error while appending i2c command");
+    ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, handle->i2c_addr << 1 | I2C_MASTER_READ, true),
+                      err, TAG, "error while appending i2c command");
+    ESP_GOTO_ON_ERROR(i2c_master_read(cmd, reg_val, count, I2C_MASTER_LAST_NACK), err,
+                      TAG, "error while appending i2c command");
+    ESP_GOTO_ON_ERROR(i2c_master_stop(cmd), err, TAG, "error while appending i2c command");
+
+    ESP_GOTO_ON_ERROR(i2c_master_cmd_begin(handle->i2c_port, cmd, pdMS_TO_TICKS(1000)),
+                      err, TAG, "error while reading registers");
+err:
+    if (cmd) {
+        i2c_cmd_link_delete(cmd);
+    }
+    return ret;
+}
+
+/*
+ * Compare the last value written to each register of the table with one bulk read of the register range.
+ * Reset control register is not compared, it is a command rather than configuration.
+ */
+static esp_err_t es7210_verify_regs(es7210_dev_handle_t handle, const es7210_reg_value_t *regs, size_t count)
+{
+    uint8_t first = 0xFF;
+    uint8_t last = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (regs[i].reg == ES7210_RESET_REG00) {
+            continue;
+        }
+        first = MIN(first, regs[i].reg);
+        last = MAX(last, regs[i].reg);
+    }
+    uint8_t read_val[ES7210_MIC34_POWER_REG4C + 1];
+    ESP_RETURN_ON_FALSE(last < sizeof(read_val), ESP_ERR_INVALID_ARG, TAG, "register out of range");
+    ESP_RETURN_ON_ERROR(es7210_read_regs(handle, first, &read_val[first], last - first + 1), TAG, "error while reading registers");
+
+    for (size_t i = 0; i < count; i++) {
+        bool overwritten = false;
+        for (size_t j = i + 1; j < count && !overwritten; j++) {
+            overwritten = (regs[j].reg == regs[i].reg);
+        }
+        if (regs[i].reg != ES7210_RESET_REG00 && !overwritten && read_val[regs[i].reg] != regs[i].value) {
+            ESP_LOGE(TAG, "register 0x%02x: 0x%02x, written 0x%02x", regs[i].reg, read_val[regs[i].reg], regs[i].value);
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t es7210_i2s_format_regs(es7210_i2s_fmt_t i2s_format, es7210_i2s_bits_t bit_width, bool tdm_enable,
+                                        uint8_t *reg11, uint8_t *reg12)
 {
-    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid device handle pointer");
     ESP_RETURN_ON_FALSE(IS_ES7210_I2S_FMT(i2s_format), ESP_ERR_INVALID_ARG, TAG, "invalid i2s format argument");
     ESP_RETURN_ON_FALSE(IS_ES7210_I2S_BITS(bit_width), ESP_ERR_INVALID_ARG, TAG, "invalid i2s bit width argument");
 
@@ -178,7 +275,7 @@ static esp_err_t es7210_set_i2s_format(es7210_dev_handle_t handle, es7210_i2s_fm
     default:
         abort();
     }
-    ES7210_WRITE_REG(ES7210_SDP_INTERFACE1_REG11, i2s_format | reg_val);
+    *reg11 = i2s_format | reg_val;
 
     const char *mode_str = NULL;
     switch (i2s_format) {
@@ -202,11 +299,8 @@ static esp_err_t es7210_set_i2s_format(es7210_dev_handle_t handle, es7210_i2s_fm
         abort();
     }
 
-    if (tdm_enable) { // enable 1xFS TDM
-        ES7210_WRITE_REG(ES7210_SDP_INTERFACE2_REG12, reg_val);
-    } else {
-        ES7210_WRITE_REG(ES7210_SDP_INTERFACE2_REG12, 0x00);
-    }
+    /* enable 1xFS TDM */
+    *reg12 = tdm_enable ? reg_val : 0x00;
 
     ESP_LOGI(TAG, "format: %s, bit width: %d, tdm mode %s", mode_str, bit_width, tdm_enable ? "enabled" : "disabled");
     return ESP_OK;
@@ -220,42 +314,31 @@ static esp_err_t es7210_set_i2s_sample_rate(es7210_dev_handle_t handle, uint32_t
     const coeff_div_t *coeff_div = es7210_get_coeff(mclk_freq_hz, sample_rate_hz);
     ESP_RETURN_ON_FALSE(coeff_div, ESP_ERR_NOT_SUPPORTED, TAG,
                         "unable to set %"PRIu32"Hz sample rate with %"PRIu32"Hz MCLK", sample_rate_hz, mclk_freq_hz);
+    const coeff_div_t *prev = handle->coeff;
+    handle->coeff = NULL; // unknown state on error
+
+    /* Only the registers that differ from the current sample rate are written */
     /* Set osr */
-    ES7210_WRITE_REG(ES7210_OSR_REG07, coeff_div->osr);
+    if (!prev || prev->osr != coeff_div->osr) {
+        ES7210_WRITE_REG(ES7210_OSR_REG07, coeff_div->osr);
+    }
     /* Set adc_div & doubler & dll */
-    ES7210_WRITE_REG(ES7210_MAINCLK_REG02, (coeff_div->adc_div) | (coeff_div->doubler << 6) | (coeff_div->dll << 7));
+    if (!prev || prev->adc_div != coeff_div->adc_div || prev->doubler != coeff_div->doubler || prev->dll != coeff_div->dll) {
+        ES7210_WRITE_REG(ES7210_MAINCLK_REG02, (coeff_div->adc_div) | (coeff_div->doubler << 6) | (coeff_div->dll << 7));
+    }
     /* Set lrck */
-    ES7210_WRITE_REG(ES7210_LRCK_DIVH_REG04, coeff_div->lrck_h);
-    ES7210_WRITE_REG(ES7210_LRCK_DIVL_REG05, coeff_div->lrck_l);
+    if (!prev || prev->lrck_h != coeff_div->lrck_h) {
+        ES7210_WRITE_REG(ES7210_LRCK_DIVH_REG04, coeff_div->lrck_h);
+    }
+    if (!prev || prev->lrck_l != coeff_div->lrck_l) {
+        ES7210_WRITE_REG(ES7210_LRCK_DIVL_REG05, coeff_div->lrck_l);
+    }
+    handle->coeff = coeff_div;
 
     ESP_LOGI(TAG, "sample rate: %"PRIu32"Hz, mclk frequency: %"PRIu32"Hz", sample_rate_hz, mclk_freq_hz);
     return ESP_OK;
 }
 
-static esp_err_t es7210_set_mic_gain(es7210_dev_handle_t handle, es7210_mic_gain_t mic_gain)
-{
-    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid device handle pointer");
-    ESP_RETURN_ON_FALSE(IS_ES7210_MIC_GAIN(mic_gain), ESP_ERR_INVALID_ARG, TAG, "invalid mic gain value");
-
-    ES7210_WRITE_REG(ES7210_MIC1_GAIN_REG43, mic_gain | 0x10);
-    ES7210_WRITE_REG(ES7210_MIC2_GAIN_REG44, mic_gain | 0x10);
-    ES7210_WRITE_REG(ES7210_MIC3_GAIN_REG45, mic_gain | 0x10);
-    ES7210_WRITE_REG(ES7210_MIC4_GAIN_REG46, mic_gain | 0x10);
-
-    return ESP_OK;
-}
-
-static esp_err_t es7210_set_mic_bias(es7210_dev_handle_t handle, es7210_mic_bias_t mic_bias)
-{
-    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid device handle pointer");
-    ESP_RETURN_ON_FALSE(IS_ES7210_MIC_BIAS(mic_bias), ESP_ERR_INVALID_ARG, TAG, "invalid mic bias value");
-
-    ES7210_WRITE_REG(ES7210_MIC12_BIAS_REG41, mic_bias);
-    ES7210_WRITE_REG(ES7210_MIC34_BIAS_REG42, mic_bias);
-
-    return ESP_OK;
-}
-
 esp_err_t es7210_new_codec(const es7210_i2c_config_t *i2c_conf, es7210_dev_handle_t *handle_out)
 {
     ESP_RETURN_ON_FALSE(i2c_conf, ESP_ERR_INVALID_ARG, TAG, "invalid device config pointer");
@@ -285,41 +368,94 @@ esp_err_t es7210_config_codec(es7210_dev_handle_t handle, const es7210_codec_con
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid device handle pointer");
     ESP_RETURN_ON_FALSE(codec_conf, ESP_ERR_INVALID_ARG, TAG, "invalid codec config pointer");
 
-    /* Perform software reset */
-    ES7210_WRITE_REG(ES7210_RESET_REG00, 0xFF);
-    ES7210_WRITE_REG(ES7210_RESET_REG00, 0x32);
-    /* Set the initialization time when device powers up */
-    ES7210_WRITE_REG(ES7210_TIME_CONTROL0_REG09, 0x30);
-    ES7210_WRITE_REG(ES7210_TIME_CONTROL1_REG0A, 0x30);
-    /* Configure HPF for ADC1-4 */
-    ES7210_WRITE_REG(ES7210_ADC12_HPF1_REG23, 0x2A);
-    ES7210_WRITE_REG(ES7210_ADC12_HPF2_REG22, 0x0A);
-    ES7210_WRITE_REG(ES7210_ADC34_HPF1_REG21, 0x2A);
-    ES7210_WRITE_REG(ES7210_ADC34_HPF2_REG20, 0x0A);
-    /* Set bits per sample to 16, data protocal to I2S, enable 1xFS TDM */
-    ESP_RETURN_ON_ERROR(es7210_set_i2s_format(handle, codec_conf->i2s_format, codec_conf->bit_width,
-                        codec_conf->flags.tdm_enable), TAG, "error while setting i2s format");
-    /* Configure analog power and VMID voltage */
-    ES7210_WRITE_REG(ES7210_ANALOG_REG40, 0xC3);
-    /* Set MIC14 bias to 2.87V */
-    ESP_RETURN_ON_ERROR(es7210_set_mic_bias(handle, codec_conf->mic_bias), TAG, "error while setting mic bias");
-    /* Set MIC1-4 gain to 30dB */
-    ESP_RETURN_ON_ERROR(es7210_set_mic_gain(handle, codec_conf->mic_gain), TAG, "error while setting mic gain");
-    /* Power on MIC1-4 */
-    ES7210_WRITE_REG(ES7210_MIC1_POWER_REG47, 0x08);
-    ES7210_WRITE_REG(ES7210_MIC2_POWER_REG48, 0x08);
-    ES7210_WRITE_REG(ES7210_MIC3_POWER_REG49, 0x08);
-    ES7210_WRITE_REG(ES7210_MIC4_POWER_REG4A, 0x08);
-    /* Set ADC sample rate to 48kHz */
-    ESP_RETURN_ON_ERROR(es7210_set_i2s_sample_rate(handle, codec_conf->sample_rate_hz, codec_conf->mclk_ratio),
-                        TAG, "error while setting sample rate");
-    /* Power down DLL */
-    ES7210_WRITE_REG(ES7210_POWER_DOWN_REG06, 0x04);
-    /* Power on MIC1-4 bias & ADC1-4 & PGA1-4 Power */
-    ES7210_WRITE_REG(ES7210_MIC12_POWER_REG4B, 0x0F);
-    ES7210_WRITE_REG(ES7210_MIC34_POWER_REG4C, 0x0F);
-    /* Enable device */
+    ESP_RETURN_ON_FALSE(IS_ES7210_MIC_GAIN(codec_conf->mic_gain), ESP_ERR_INVALID_ARG, TAG, "invalid mic gain value");
+    ESP_RETURN_ON_FALSE(IS_ES7210_MIC_BIAS(codec_conf->mic_bias), ESP_ERR_INVALID_ARG, TAG, "invalid mic bias value");
+
+    const uint32_t mclk_freq_hz = codec_conf->sample_rate_hz * codec_conf->mclk_ratio;
+    const coeff_div_t *coeff_div = es7210_get_coeff(mclk_freq_hz, codec_conf->sample_rate_hz);
+    ESP_RETURN_ON_FALSE(coeff_div, ESP_ERR_NOT_SUPPORTED, TAG, "unable to set %"PRIu32"Hz sample rate with %"PRIu32"Hz MCLK",
+                        codec_conf->sample_rate_hz, mclk_freq_hz);
+
+    /* Set bits per sample, data protocol and TDM */
+    uint8_t reg11;
+    uint8_t reg12;
+    ESP_RETURN_ON_ERROR(es7210_i2s_format_regs(codec_conf->i2s_format, codec_conf->bit_width, codec_conf->flags.tdm_enable,
+                        &reg11, &reg12), TAG, "error while setting i2s format");
+    const uint8_t mic_gain = codec_conf->mic_gain | 0x10;
+
+    /* Register image of the whole configuration, written in one pass */
+    const es7210_reg_value_t regs[] = {
+        /* Perform software reset */
+        {ES7210_RESET_REG00, 0xFF},
+        {ES7210_RESET_REG00, 0x32},
+        /* Set the initialization time when device powers up */
+        {ES7210_TIME_CONTROL0_REG09, 0x30},
+        {ES7210_TIME_CONTROL1_REG0A, 0x30},
+        /* Configure HPF for ADC1-4 */
+        {ES7210_ADC12_HPF1_REG23, 0x2A},
+        {ES7210_ADC12_HPF2_REG22, 0x0A},
+        {ES7210_ADC34_HPF1_REG21, 0x2A},
+        {ES7210_ADC34_HPF2_REG20, 0x0A},
+        /* Set bits per sample, data protocol and TDM */
+        {ES7210_SDP_INTERFACE1_REG11, reg11},
+        {ES7210_SDP_INTERFACE2_REG12, reg12},
+        /* Configure analog power and VMID voltage */
+        {ES7210_ANALOG_REG40, 0xC3},
+        /* Set MIC1-4 bias */
+        {ES7210_MIC12_BIAS_REG41, codec_conf->mic_bias},
+        {ES7210_MIC34_BIAS_REG42, codec_conf->mic_bias},
+        /* Set MIC1-4 gain */
+        {ES7210_MIC1_GAIN_REG43, mic_gain},
+        {ES7210_MIC2_GAIN_REG44, mic_gain},
+        {ES7210_MIC3_GAIN_REG45, mic_gain},
+        {ES7210_MIC4_GAIN_REG46, mic_gain},
+        /* Power on MIC1-4 */
+        {ES7210_MIC1_POWER_REG47, 0x08},
+        {ES7210_MIC2_POWER_REG48, 0x08},
+        {ES7210_MIC3_POWER_REG49, 0x08},
+        {ES7210_MIC4_POWER_REG4A, 0x08},
+        /* Set ADC sample rate: osr, adc_div & doubler & dll, lrck */
+        {ES7210_OSR_REG07, coeff_div->osr},
+        {ES7210_MAINCLK_REG02, (coeff_div->adc_div) | (coeff_div->doubler << 6) | (coeff_div->dll << 7)},
+        {ES7210_LRCK_DIVH_REG04, coeff_div->lrck_h},
+        {ES7210_LRCK_DIVL_REG05, coeff_div->lrck_l},
+        /* Power down DLL */
+        {ES7210_POWER_DOWN_REG06, 0x04},
+        /* Power on MIC1-4 bias & ADC1-4 & PGA1-4 Power */
+        {ES7210_MIC12_POWER_REG4B, 0x0F},
+        {ES7210_MIC34_POWER_REG4C, 0x0F},
+        /* Enable device */
+        {ES7210_RESET_REG00, 0x71},
+        {ES7210_RESET_REG00, 0x41},
+    };
+    const size_t count = sizeof(regs) / sizeof(regs[0]);
+
+    handle->coeff = NULL; // unknown state on error
+    ESP_RETURN_ON_ERROR(es7210_write_regs(handle, regs, count), TAG, "error while configuring codec");
+    if (codec_conf->flags.verify) {
+        ESP_RETURN_ON_ERROR(es7210_verify_regs(handle, regs, count), TAG, "codec configuration verification failed");
+    }
+    handle->coeff = coeff_div;
+
+    ESP_LOGI(TAG, "sample rate: %"PRIu32"Hz, mclk frequency: %"PRIu32"Hz", codec_conf->sample_rate_hz, mclk_freq_hz);
+    return ESP_OK;
+}
+
+esp_err_t es7210_config_sample_rate(es7210_dev_handle_t handle, uint32_t sample_rate_hz, uint32_t mclk_ratio)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid device handle pointer");
+    ESP_RETURN_ON_FALSE(handle->coeff, ESP_ERR_INVALID_STATE, TAG, "codec not configured");
+
+    const coeff_div_t *coeff_div = es7210_get_coeff(sample_rate_hz * mclk_ratio, sample_rate_hz);
+    ESP_RETURN_ON_FALSE(coeff_div, ESP_ERR_NOT_SUPPORTED, TAG,
+                        "unable to set %"PRIu32"Hz sample rate with %"PRIu32"Hz MCLK", sample_rate_hz, sample_rate_hz * mclk_ratio);
+    if (coeff_div == handle->coeff) {
+        return ESP_OK;
+    }
+
+    /* Hold the digital part in reset while the clock dividers change, same as at the end of es7210_config_codec() */
     ES7210_WRITE_REG(ES7210_RESET_REG00, 0x71);
+    ESP_RETURN_ON_ERROR(es7210_set_i2s_sample_rate(handle, sample_rate_hz, mclk_ratio), TAG, "error while setting sample rate");
     ES7210_WRITE_REG(ES7210_RESET_REG00, 0x41);
 
     return ESP_OK;
@@ -343,3 +479,76 @@ esp_err_t es7210_config_volume(es7210_dev_handle_t handle, int8_t volume_db)
 
     return ESP_OK;
 }
+
+esp_err_t es7210_config_tdm_capture(es7210_dev_handle_t handle, uint32_t sample_rate_hz, es7210_mic_gain_t mic_gain)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid device handle pointer");
+
+    const es7210_codec_config_t codec_conf = {
+        .sample_rate_hz = sample_rate_hz,
+        .mclk_ratio = 256,
+        .i2s_format = ES7210_I2S_FMT_I2S,
+        .bit_width = ES7210_I2S_BITS_16B,
+        .mic_bias = ES7210_MIC_BIAS_2V87,
+        .mic_gain = mic_gain,
+        .flags.tdm_enable = 1,
+    };
+    return es7210_config_codec(handle, &codec_conf);
+}
+
+void es7210_tdm_to_planar_f32(const int16_t *in, float *const out[], size_t channels, size_t samples)
+{
+    const float scale = 1.0f / 32768.0f;
+
+    if (channels == ES7210_TDM_CHANNELS && ((uintptr_t)in & 0x3) == 0) {
+        /* One frame of 4 channels is loaded by two 32-bit reads, channels are split by shifts (little endian) */
+        const uint32_t *src = (const uint32_t *)in;
+        float *out0 = out[0];
+        float *out1 = out[1];
+        float *out2 = out[2];
+        float *out3 = out[3];
+        for (size_t i = 0; i < samples; i++) {
+            const uint32_t ch01 = src[0];
+            const uint32_t ch23 = src[1];
+            src += 2;
+            out0[i] = (float)(int16_t)ch01 * scale;
+            out1[i] = (float)(int16_t)(ch01 >> 16) * scale;
+            out2[i] = (float)(int16_t)ch23 * scale;
+            out3[i] = (float)(int16_t)(ch23 >> 16) * scale;
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < samples; i++) {
+        for (size_t ch = 0; ch < channels; ch++) {
+            out[ch][i] = (float)in[i * channels + ch] * scale;
+        }
+    }
+}
+
+void es7210_tdm_to_planar_s16(const int16_t *in, int16_t *const out[], size_t channels, size_t samples)
+{
+    if (channels == ES7210_TDM_CHANNELS && ((uintptr_t)in & 0x3) == 0) {
+        const uint32_t *src = (const uint32_t *)in;
+        int16_t *out0 = out[0];
+        int16_t *out1 = out[1];
+        int16_t *out2 = out[2];
+        int16_t *out3 = out[3];
+        for (size_t i = 0; i < samples; i++) {
+            const uint32_t ch01 = src[0];
+            const uint32_t ch23 = src[1];
+            src += 2;
+            out0[i] = (int16_t)ch01;
+            out1[i] = (int16_t)(ch01 >> 16);
+            out2[i] = (int16_t)ch23;
+            out3[i] = (int16_t)(ch23 >> 16);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < samples; i++) {
+        for (size_t ch = 0; ch < channels; ch++) {
+            out[ch][i] = in[i * channels + ch];
+        }
+    }
+}
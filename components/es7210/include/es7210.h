@@ -12,6 +12,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "driver/i2c.h"
 
@@ -37,6 +38,11 @@
 #define ES7210_ADDRESS_10 (0x42)
 #define ES7210_ADDRESS_11 (0x43)
 
+/**
+ * @brief Number of microphone channels of ES7210 in TDM mode
+ */
+#define ES7210_TDM_CHANNELS (4)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -128,6 +134,7 @@ typedef struct {
     es7210_mic_gain_t mic_gain;     /*!< Gain of analog MIC, please adjust according to your MIC's sensitivity */
     struct {
         uint32_t tdm_enable: 1;     /*!< Choose whether to enable TDM mode */
+        uint32_t verify: 1;         /*!< Read back the configured registers in one bulk read and compare them */
     } flags;
 } es7210_codec_config_t;
 
@@ -158,6 +165,9 @@ esp_err_t es7210_del_codec(es7210_dev_handle_t handle);
 /**
  * @brief Configure codec-related parameters of ES7210.
  *
+ * All register values are computed from codec_conf in advance and written in a single I2C transaction,
+ * without reading the registers back (unless codec_conf->flags.verify is set).
+ *
  * @param[in] handle ES7210 device handle
  * @param[in] codec_conf codec-related parameters of ES7210
  * @return
@@ -167,10 +177,31 @@ esp_err_t es7210_del_codec(es7210_dev_handle_t handle);
  *          - ESP_FAIL                Sending command error, slave hasn't ACK the transfer.
  *          - ESP_ERR_INVALID_STATE   I2C driver not installed or not in master mode.
  *          - ESP_ERR_TIMEOUT         Operation timeout because the bus is busy.
+ *          - ESP_ERR_INVALID_RESPONSE A register read back differs from the written value (flags.verify).
  *
  */
 esp_err_t es7210_config_codec(es7210_dev_handle_t handle, const es7210_codec_config_t *codec_conf);
 
+/**
+ * @brief Change sample rate of configured ES7210
+ *
+ * Fast path for switching e.g. between 16 kHz voice and 48 kHz media: only the clock divider registers that differ
+ * are written and the rest of es7210_config_codec() configuration is kept.
+ * Disable the I2S channel during the switch and reconfigure its clock to the new sample rate and MCLK.
+ *
+ * @param[in] handle ES7210 device handle
+ * @param[in] sample_rate_hz New sample rate in Hz
+ * @param[in] mclk_ratio MCLK-to-Sample-rate clock ratio, typically 256
+ * @return
+ *          - ESP_OK                  Sample rate changed (or it is already set).
+ *          - ESP_ERR_INVALID_ARG     Invalid device handle or argument.
+ *          - ESP_ERR_INVALID_STATE   Codec was not configured by es7210_config_codec().
+ *          - ESP_ERR_NOT_SUPPORTED   Sample rate cannot be set with the MCLK.
+ *          - Others                  I2C error.
+ *
+ */
+esp_err_t es7210_config_sample_rate(es7210_dev_handle_t handle, uint32_t sample_rate_hz, uint32_t mclk_ratio);
+
 /**
  * @brief Configure volume of ES7210.
  *
@@ -187,6 +218,46 @@ esp_err_t es7210_config_codec(es7210_dev_handle_t handle, const es7210_codec_con
  */
 esp_err_t es7210_config_volume(es7210_dev_handle_t handle, int8_t volume_db);
 
+/**
+ * @brief Configure ES7210 for capture of 4 microphones in TDM mode
+ *
+ * The codec outputs 16-bit samples of MIC1-4 in standard I2S format with 1xFS TDM, MCLK is 256 * sample rate and MIC bias is 2.87V.
+ * I2S peripheral must be configured in TDM mode with 4 slots of 16 bits (I2S_TDM_PHILIPS_SLOT_DEFAULT_CONFIG with I2S_TDM_SLOT0-3).
+ * Use es7210_tdm_to_planar_f32() or es7210_tdm_to_planar_s16() for splitting of the captured stream to channels.
+ *
+ * @param[in] handle ES7210 device handle
+ * @param[in] sample_rate_hz Sample rate in Hz
+ * @param[in] mic_gain Gain of analog MICs
+ * @return
+ *          - ESP_OK                  Codec config success.
+ *          - ESP_ERR_INVALID_ARG     Invalid device handle or argument.
+ *          - Others                  Error of es7210_config_codec()
+ *
+ */
+esp_err_t es7210_config_tdm_capture(es7210_dev_handle_t handle, uint32_t sample_rate_hz, es7210_mic_gain_t mic_gain);
+
+/**
+ * @brief Split interleaved 16-bit TDM stream into planar float buffers (e.g. for AFE)
+ *
+ * Samples are normalized to range [-1.0, 1.0). 4 channels from 4-byte aligned input use optimized path (2 words per frame).
+ *
+ * @param[in]  in        Interleaved samples (samples * channels)
+ * @param[out] out       Array of channels pointers to output buffers (samples each)
+ * @param[in]  channels  Number of channels in the stream
+ * @param[in]  samples   Number of samples per channel
+ */
+void es7210_tdm_to_planar_f32(const int16_t *in, float *const out[], size_t channels, size_t samples);
+
+/**
+ * @brief Split interleaved 16-bit TDM stream into planar 16-bit buffers
+ *
+ * @param[in]  in        Interleaved samples (samples * channels)
+ * @param[out] out       Array of channels pointers to output buffers (samples each)
+ * @param[in]  channels  Number of channels in the stream
+ * @param[in]  samples   Number of samples per channel
+ */
+void es7210_tdm_to_planar_s16(const int16_t *in, int16_t *const out[], size_t channels, size_t samples);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <stdint.h>
 #include "unity.h"
 #include "driver/i2c.h"
 #include "es7210.h"
@@ -61,7 +62,8 @@ static void test_es7210_init(bool is_tdm)
         .bit_width = ES7210_BIT_WIDTH,
         .mic_bias = ES7210_MIC_BIAS,
         .mic_gain = ES7210_MIC_GAIN,
-        .flags.tdm_enable = is_tdm
+        .flags.tdm_enable = is_tdm,
+        .flags.verify = 1,
     };
     TEST_ERROR_CHECK(es7210_config_codec(es7210_handle, &codec_conf), "Failed to config ES7210");
     TEST_ERROR_CHECK(es7210_config_volume(es7210_handle, ES7210_ADC_VOLUME), "Failed  to config the volume of ES7210");
@@ -76,3 +78,30 @@ TEST_CASE("ADC Codec ES7210 basic functionality test", "[es7210][iot][device]")
     TEST_ERROR_CHECK(es7210_del_codec(es7210_handle), "Failed to delete ES7210 handle");
     TEST_ERROR_CHECK(i2c_driver_delete(I2C_MASTER_NUM), "Failed to delete I2C driver");
 }
+
+TEST_CASE("ADC Codec ES7210 TDM deinterleave test", "[es7210]")
+{
+    int16_t tdm[8 * ES7210_TDM_CHANNELS] __attribute__((aligned(4)));
+    float planar_f32[ES7210_TDM_CHANNELS][8];
+    int16_t planar_s16[ES7210_TDM_CHANNELS][8];
+    float *const out_f32[ES7210_TDM_CHANNELS] = {planar_f32[0], planar_f32[1], planar_f32[2], planar_f32[3]};
+    int16_t *const out_s16[ES7210_TDM_CHANNELS] = {planar_s16[0], planar_s16[1], planar_s16[2], planar_s16[3]};
+
+    for (int i = 0; i < 8; i++) {
+        for (int ch = 0; ch < ES7210_TDM_CHANNELS; ch++) {
+            tdm[i * ES7210_TDM_CHANNELS + ch] = (int16_t)((ch % 2 ? -1 : 1) * (i * 1000 + ch * 100));
+        }
+    }
+    tdm[0] = INT16_MIN;
+
+    es7210_tdm_to_planar_f32(tdm, out_f32, ES7210_TDM_CHANNELS, 8);
+    es7210_tdm_to_planar_s16(tdm, out_s16, ES7210_TDM_CHANNELS, 8);
+    for (int i = 0; i < 8; i++) {
+        for (int ch = 0; ch < ES7210_TDM_CHANNELS; ch++) {
+            const int16_t expected = tdm[i * ES7210_TDM_CHANNELS + ch];
+            TEST_ASSERT_EQUAL_INT16(expected, planar_s16[ch][i]);
+            TEST_ASSERT_EQUAL_FLOAT((float)expected / 32768.0f, planar_f32[ch][i]);
+        }
+    }
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, planar_f32[0][0]);
+}
@@ -5,17 +5,42 @@
  */
 
 #include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <sys/param.h>
 #include "es8311.h"
 #include "driver/gpio.h"
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_check.h"
+#include "esp_timer.h"
 
 #include "es8311_reg.h"
 
+#define ES8311_SHADOW_SIZE          0x46    /* Shadowed configuration registers 0x00 - 0x45 */
+#define ES8311_VOLUME_COALESCE_US   20000   /* Deferred volume is written at most every 20 ms */
+#define ES8311_EQ_COEFF_FRAC_BITS   27      /* Equalizer coefficients are 30-bit two's complement, range <-4, 4) */
+#define ES8311_EQ_COEFF_MAX         5       /* ADC biquad has 5 coefficients, DAC first order section 3 */
+
+typedef struct {
+    uint8_t reg;
+    uint8_t value;
+} es8311_reg_value_t;
+
 typedef struct {
     i2c_port_t port;
     uint16_t dev_addr;
+
+    /* Shadow of configuration registers, saves reads in read-modify-write */
+    uint8_t shadow[ES8311_SHADOW_SIZE];
+    uint8_t shadow_valid[(ES8311_SHADOW_SIZE + 7) / 8];
+
+    /* Index of the last used clock coefficients */
+    int coeff_cached;
+
+    /* Deferred volume */
+    esp_timer_handle_t volume_timer;
+    volatile int volume_pending;
 } es8311_dev_t;
 
 /*
@@ -142,17 +167,85 @@ static const struct _coeff_div coeff_div[] = {
 
 static const char *TAG = "ES8311";
 
+static inline void es8311_shadow_set(es8311_dev_t *es, uint8_t reg_addr, uint8_t value)
+{
+    if (reg_addr < ES8311_SHADOW_SIZE) {
+        es->shadow[reg_addr] = value;
+        es->shadow_valid[reg_addr / 8] |= BIT(reg_addr % 8);
+    }
+}
+
+static inline bool es8311_shadow_get(const es8311_dev_t *es, uint8_t reg_addr, uint8_t *value)
+{
+    if (reg_addr < ES8311_SHADOW_SIZE && (es->shadow_valid[reg_addr / 8] & BIT(reg_addr % 8))) {
+        *value = es->shadow[reg_addr];
+        return true;
+    }
+    return false;
+}
+
 static inline esp_err_t es8311_write_reg(es8311_handle_t dev, uint8_t reg_addr, uint8_t data)
 {
     es8311_dev_t *es = (es8311_dev_t *) dev;
     const uint8_t write_buf[2] = {reg_addr, data};
-    return i2c_master_write_to_device(es->port, es->dev_addr, write_buf, sizeof(write_buf), pdMS_TO_TICKS(1000));
+    esp_err_t ret = i2c_master_write_to_device(es->port, es->dev_addr, write_buf, sizeof(write_buf), pdMS_TO_TICKS(1000));
+    if (ret == ESP_OK) {
+        es8311_shadow_set(es, reg_addr, data);
+    }
+    return ret;
 }
 
 static inline esp_err_t es8311_read_reg(es8311_handle_t dev, uint8_t reg_addr, uint8_t *reg_value)
 {
     es8311_dev_t *es = (es8311_dev_t *) dev;
-    return i2c_master_write_read_device(es->port, es->dev_addr, &reg_addr, 1, reg_value, 1, pdMS_TO_TICKS(1000));
+    if (es8311_shadow_get(es, reg_addr, reg_value)) {
+        return ESP_OK;
+    }
+    esp_err_t ret = i2c_master_write_read_device(es->port, es->dev_addr, &reg_addr, 1, reg_value, 1, pdMS_TO_TICKS(1000));
+    if (ret == ESP_OK) {
+        es8311_shadow_set(es, reg_addr, *reg_value);
+    }
+    return ret;
+}
+
+/*
+ * Write register table in one I2C transaction, each register is addressed by repeated START,
+ * so register address auto-increment of the codec is not needed. Nothing is read back.
+ */
+static esp_err_t es8311_write_regs(es8311_handle_t dev, const es8311_reg_value_t *regs, size_t count)
+{
+    es8311_dev_t *es = (es8311_dev_t *) dev;
+    esp_err_t ret = ESP_OK;
+
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    ESP_RETURN_ON_FALSE(cmd, ESP_ERR_NO_MEM, TAG, "memory allocation for i2c cmd handle failed");
+    for (size_t i = 0; i < count; i++) {
+        ESP_GOTO_ON_ERROR(i2c_master_start(cmd), err, TAG, "error while appending i2c command");
+        ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, (es->dev_addr << 1) | I2C_MASTER_WRITE, true), err, TAG, "error while appending i2c command");
+        ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, regs[i].reg, true), err, TAG, "error while appending i2c command");
+        ESP_GOTO_ON_ERROR(i2c_master_write_byte(cmd, regs[i].value, true), err, TAG, "error while appending i2c command");
+    }
+    ESP_GOTO_ON_ERROR(i2c_master_stop(cmd), err, TAG, "error while appending i2c command");
+    ESP_GOTO_ON_ERROR(i2c_master_cmd_begin(es->port, cmd, pdMS_TO_TICKS(1000)), err, TAG, "I2C read/write error");
+
+    for (size_t i = 0; i < count; i++) {
+        es8311_shadow_set(es, regs[i].reg, regs[i].value);
+    }
+err:
+    i2c_cmd_link_delete(cmd);
+    return ret;
+}
+
+/* Write only bits in mask, skip the I2C transfer if the register already has the value */
+static esp_err_t es8311_update_reg(es8311_handle_t dev, uint8_t reg_addr, uint8_t mask, uint8_t value)
+{
+    uint8_t regv;
+    ESP_RETURN_ON_ERROR(es8311_read_reg(dev, reg_addr, &regv), TAG, "I2C read/write error");
+    const uint8_t new_regv = (regv & ~mask) | (value & mask);
+    if (new_regv == regv) {
+        return ESP_OK;
+    }
+    return es8311_write_reg(dev, reg_addr, new_regv);
 }
 
 /*
@@ -171,91 +264,51 @@ static int get_coeff(uint32_t mclk, uint32_t rate)
 
 esp_err_t es8311_sample_frequency_config(es8311_handle_t dev, int mclk_frequency, int sample_frequency)
 {
-    uint8_t regv;
+    es8311_dev_t *es = (es8311_dev_t *) dev;
 
-    /* Get clock coefficients from coefficient table */
-    int coeff = get_coeff(mclk_frequency, sample_frequency);
+    /* Get clock coefficients from coefficient table, the last one is checked first */
+    int coeff = es->coeff_cached;
+    if (coeff_div[coeff].rate != sample_frequency || coeff_div[coeff].mclk != mclk_frequency) {
+        coeff = get_coeff(mclk_frequency, sample_frequency);
+    }
 
     if (coeff < 0) {
         ESP_LOGE(TAG, "Unable to configure sample rate %dHz with %dHz MCLK", sample_frequency, mclk_frequency);
         return ESP_ERR_INVALID_ARG;
     }
+    es->coeff_cached = coeff;
 
     const struct _coeff_div *const selected_coeff = &coeff_div[coeff];
 
+    /* Only the changed registers are written, the unchanged are checked against the shadow */
     /* register 0x02 */
-    ESP_RETURN_ON_ERROR(es8311_read_reg(dev, ES8311_CLK_MANAGER_REG02, &regv), TAG, "I2C read/write error");
-    regv &= 0x07;
-    regv |= (selected_coeff->pre_div - 1) << 5;
-    regv |= selected_coeff->pre_multi << 3;
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_CLK_MANAGER_REG02, regv), TAG, "I2C read/write error");
+    ESP_RETURN_ON_ERROR(es8311_update_reg(dev, ES8311_CLK_MANAGER_REG02, 0xF8,
+                                          ((selected_coeff->pre_div - 1) << 5) | (selected_coeff->pre_multi << 3)), TAG, "I2C read/write error");
 
     /* register 0x03 */
     const uint8_t reg03 = (selected_coeff->fs_mode << 6) | selected_coeff->adc_osr;
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_CLK_MANAGER_REG03, reg03), TAG, "I2C read/write error");
+    ESP_RETURN_ON_ERROR(es8311_update_reg(dev, ES8311_CLK_MANAGER_REG03, 0xFF, reg03), TAG, "I2C read/write error");
 
     /* register 0x04 */
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_CLK_MANAGER_REG04, selected_coeff->dac_osr), TAG, "I2C read/write error");
+    ESP_RETURN_ON_ERROR(es8311_update_reg(dev, ES8311_CLK_MANAGER_REG04, 0xFF, selected_coeff->dac_osr), TAG, "I2C read/write error");
 
     /* register 0x05 */
     const uint8_t reg05 = ((selected_coeff->adc_div - 1) << 4) | (selected_coeff->dac_div - 1);
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_CLK_MANAGER_REG05, reg05), TAG, "I2C read/write error");
+    ESP_RETURN_ON_ERROR(es8311_update_reg(dev, ES8311_CLK_MANAGER_REG05, 0xFF, reg05), TAG, "I2C read/write error");
 
     /* register 0x06 */
-    ESP_RETURN_ON_ERROR(es8311_read_reg(dev, ES8311_CLK_MANAGER_REG06, &regv), TAG, "I2C read/write error");
-    regv &= 0xE0;
-
-    if (selected_coeff->bclk_div < 19) {
-        regv |= (selected_coeff->bclk_div - 1) << 0;
-    } else {
-        regv |= (selected_coeff->bclk_div) << 0;
-    }
-
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_CLK_MANAGER_REG06, regv), TAG, "I2C read/write error");
+    const uint8_t bclk_div = (selected_coeff->bclk_div < 19) ? (selected_coeff->bclk_div - 1) : selected_coeff->bclk_div;
+    ESP_RETURN_ON_ERROR(es8311_update_reg(dev, ES8311_CLK_MANAGER_REG06, 0x1F, bclk_div), TAG, "I2C read/write error");
 
     /* register 0x07 */
-    ESP_RETURN_ON_ERROR(es8311_read_reg(dev, ES8311_CLK_MANAGER_REG07, &regv), TAG, "I2C read/write error");
-    regv &= 0xC0;
-    regv |= selected_coeff->lrck_h << 0;
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_CLK_MANAGER_REG07, regv), TAG, "I2C read/write error");
+    ESP_RETURN_ON_ERROR(es8311_update_reg(dev, ES8311_CLK_MANAGER_REG07, 0x3F, selected_coeff->lrck_h), TAG, "I2C read/write error");
 
     /* register 0x08 */
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_CLK_MANAGER_REG08, selected_coeff->lrck_l), TAG, "I2C read/write error");
+    ESP_RETURN_ON_ERROR(es8311_update_reg(dev, ES8311_CLK_MANAGER_REG08, 0xFF, selected_coeff->lrck_l), TAG, "I2C read/write error");
 
     return ESP_OK;
 }
 
-static esp_err_t es8311_clock_config(es8311_handle_t dev, const es8311_clock_config_t *const clk_cfg, es8311_resolution_t res)
-{
-    uint8_t reg06;
-    uint8_t reg01 = 0x3F; // Enable all clocks
-    int mclk_hz;
-
-    /* Select clock source for internal MCLK and determine its frequency */
-    if (clk_cfg->mclk_from_mclk_pin) {
-        mclk_hz = clk_cfg->mclk_frequency;
-    } else {
-        mclk_hz = clk_cfg->sample_frequency * (int)res * 2;
-        reg01 |= BIT(7); // Select BCLK (a.k.a. SCK) pin
-    }
-
-    if (clk_cfg->mclk_inverted) {
-        reg01 |= BIT(6); // Invert MCLK pin
-    }
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_CLK_MANAGER_REG01, reg01), TAG, "I2C read/write error");
-
-    ESP_RETURN_ON_ERROR(es8311_read_reg(dev, ES8311_CLK_MANAGER_REG06, &reg06), TAG, "I2C read/write error");
-    if (clk_cfg->sclk_inverted) {
-        reg06 |= BIT(5);
-    } else {
-        reg06 &= ~BIT(5);
-    }
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_CLK_MANAGER_REG06, reg06), TAG, "I2C read/write error");
-
-    /* Configure clock dividers */
-    return es8311_sample_frequency_config(dev, mclk_hz, clk_cfg->sample_frequency);
-}
-
 static esp_err_t es8311_resolution_config(const es8311_resolution_t res, uint8_t *reg)
 {
     switch (res) {
@@ -280,27 +333,6 @@ static esp_err_t es8311_resolution_config(const es8311_resolution_t res, uint8_t
     return ESP_OK;
 }
 
-static esp_err_t es8311_fmt_config(es8311_handle_t dev, const es8311_resolution_t res_in, const es8311_resolution_t res_out)
-{
-    uint8_t reg09 = 0; // SDP In
-    uint8_t reg0a = 0; // SDP Out
-
-    ESP_LOGI(TAG, "ES8311 in Slave mode and I2S format");
-    uint8_t reg00;
-    ESP_RETURN_ON_ERROR(es8311_read_reg(dev, ES8311_RESET_REG00, &reg00), TAG, "I2C read/write error");
-    reg00 &= 0xBF;
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_RESET_REG00, reg00), TAG, "I2C read/write error"); // Slave serial port - default
-
-    /* Setup SDP In and Out resolution */
-    es8311_resolution_config(res_in, &reg09);
-    es8311_resolution_config(res_out, &reg0a);
-
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_SDPIN_REG09, reg09), TAG, "I2C read/write error");
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_SDPOUT_REG0A, reg0a), TAG, "I2C read/write error");
-
-    return ESP_OK;
-}
-
 esp_err_t es8311_microphone_config(es8311_handle_t dev, bool digital_mic)
 {
     uint8_t reg14 = 0x1A; // enable analog MIC and max PGA gain
@@ -325,30 +357,100 @@ esp_err_t es8311_init(es8311_handle_t dev, const es8311_clock_config_t *const cl
     }
 
 
+    /* Select clock source for internal MCLK and determine its frequency */
+    uint8_t reg01 = 0x3F; // Enable all clocks
+    int mclk_hz;
+    if (clk_cfg->mclk_from_mclk_pin) {
+        mclk_hz = clk_cfg->mclk_frequency;
+    } else {
+        mclk_hz = clk_cfg->sample_frequency * (int)res_out * 2;
+        reg01 |= BIT(7); // Select BCLK (a.k.a. SCK) pin
+    }
+    if (clk_cfg->mclk_inverted) {
+        reg01 |= BIT(6); // Invert MCLK pin
+    }
+
+    const int coeff = get_coeff(mclk_hz, clk_cfg->sample_frequency);
+    if (coeff < 0) {
+        ESP_LOGE(TAG, "Unable to configure sample rate %dHz with %dHz MCLK", clk_cfg->sample_frequency, mclk_hz);
+        return ESP_ERR_INVALID_ARG;
+    }
+    const struct _coeff_div *const selected_coeff = &coeff_div[coeff];
+
+    uint8_t reg06 = (selected_coeff->bclk_div < 19) ? (selected_coeff->bclk_div - 1) : selected_coeff->bclk_div;
+    if (clk_cfg->sclk_inverted) {
+        reg06 |= BIT(5);
+    }
+
+    /* Setup SDP In and Out resolution */
+    uint8_t reg09 = 0; // SDP In
+    uint8_t reg0a = 0; // SDP Out
+    ESP_RETURN_ON_ERROR(es8311_resolution_config(res_in, &reg09), TAG, "invalid input resolution");
+    ESP_RETURN_ON_ERROR(es8311_resolution_config(res_out, &reg0a), TAG, "invalid output resolution");
+
+    /* Whole configuration is known from the arguments, registers are written in one pass without read-modify-write */
+    const es8311_reg_value_t init_regs[] = {
+        {ES8311_RESET_REG00, 0x00},
+        {ES8311_RESET_REG00, 0x80}, // Power-on command, slave serial port - default
+        /* Setup clock: source, polarity and clock dividers */
+        {ES8311_CLK_MANAGER_REG01, reg01},
+        {ES8311_CLK_MANAGER_REG02, ((selected_coeff->pre_div - 1) << 5) | (selected_coeff->pre_multi << 3)},
+        {ES8311_CLK_MANAGER_REG03, (selected_coeff->fs_mode << 6) | selected_coeff->adc_osr},
+        {ES8311_CLK_MANAGER_REG04, selected_coeff->dac_osr},
+        {ES8311_CLK_MANAGER_REG05, ((selected_coeff->adc_div - 1) << 4) | (selected_coeff->dac_div - 1)},
+        {ES8311_CLK_MANAGER_REG06, reg06},
+        {ES8311_CLK_MANAGER_REG07, selected_coeff->lrck_h},
+        {ES8311_CLK_MANAGER_REG08, selected_coeff->lrck_l},
+        /* Setup audio format (fmt): resolution, I2S */
+        {ES8311_SDPIN_REG09, reg09},
+        {ES8311_SDPOUT_REG0A, reg0a},
+        {ES8311_SYSTEM_REG0D, 0x01}, // Power up analog circuitry - NOT default
+        {ES8311_SYSTEM_REG0E, 0x02}, // Enable analog PGA, enable ADC modulator - NOT default
+        {ES8311_SYSTEM_REG12, 0x00}, // power-up DAC - NOT default
+        {ES8311_SYSTEM_REG13, 0x10}, // Enable output to HP drive - NOT default
+        {ES8311_ADC_REG1C, 0x6A}, // ADC Equalizer bypass, cancel DC offset in digital domain
+        {ES8311_DAC_REG37, 0x08}, // Bypass DAC equalizer - NOT default
+    };
+
     /* Reset ES8311 to its default */
     ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_RESET_REG00, 0x1F), TAG, "I2C read/write error");
+    es8311_dev_t *es = (es8311_dev_t *) dev;
+    memset(es->shadow_valid, 0, sizeof(es->shadow_valid)); // registers are at their defaults now
     vTaskDelay(pdMS_TO_TICKS(20));
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_RESET_REG00, 0x00), TAG, "I2C read/write error");
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_RESET_REG00, 0x80), TAG, "I2C read/write error"); // Power-on command
 
-    /* Setup clock: source, polarity and clock dividers */
-    ESP_RETURN_ON_ERROR(es8311_clock_config(dev, clk_cfg, res_out), TAG, "");
+    ESP_LOGI(TAG, "ES8311 in Slave mode and I2S format");
+    ESP_RETURN_ON_ERROR(es8311_write_regs(dev, init_regs, sizeof(init_regs) / sizeof(init_regs[0])), TAG, "I2C read/write error");
+    es->coeff_cached = coeff;
 
-    /* Setup audio format (fmt): master/slave, resolution, I2S */
-    ESP_RETURN_ON_ERROR(es8311_fmt_config(dev, res_in, res_out), TAG, "");
+    return ESP_OK;
+}
 
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_SYSTEM_REG0D, 0x01), TAG, "I2C read/write error"); // Power up analog circuitry - NOT default
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_SYSTEM_REG0E, 0x02), TAG, "I2C read/write error"); // Enable analog PGA, enable ADC modulator - NOT default
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_SYSTEM_REG12, 0x00), TAG, "I2C read/write error"); // power-up DAC - NOT default
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_SYSTEM_REG13, 0x10), TAG, "I2C read/write error"); // Enable output to HP drive - NOT default
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_ADC_REG1C, 0x6A), TAG, "I2C read/write error"); // ADC Equalizer bypass, cancel DC offset in digital domain
-    ESP_RETURN_ON_ERROR(es8311_write_reg(dev, ES8311_DAC_REG37, 0x08), TAG, "I2C read/write error"); // Bypass DAC equalizer - NOT default
+esp_err_t es8311_register_verify(es8311_handle_t dev)
+{
+    es8311_dev_t *es = (es8311_dev_t *) dev;
+    ESP_RETURN_ON_FALSE(es, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
 
+    uint8_t regs[ES8311_SHADOW_SIZE];
+    const uint8_t reg_addr = 0x00;
+    ESP_RETURN_ON_ERROR(i2c_master_write_read_device(es->port, es->dev_addr, &reg_addr, 1, regs, sizeof(regs), pdMS_TO_TICKS(1000)),
+                        TAG, "I2C read/write error");
+    for (uint8_t reg = 0; reg < ES8311_SHADOW_SIZE; reg++) {
+        uint8_t value;
+        if (es8311_shadow_get(es, reg, &value) && value != regs[reg]) {
+            ESP_LOGE(TAG, "REG:%02x: %02x, written %02x", reg, regs[reg], value);
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+    }
     return ESP_OK;
 }
 
 void es8311_delete(es8311_handle_t dev)
 {
+    es8311_dev_t *es = (es8311_dev_t *) dev;
+    if (es && es->volume_timer) {
+        esp_timer_stop(es->volume_timer);
+        esp_timer_delete(es->volume_timer);
+    }
     free(dev);
 }
 
@@ -371,7 +473,27 @@ esp_err_t es8311_voice_volume_set(es8311_handle_t dev, int volume, int *volume_s
     if (volume_set != NULL) {
         *volume_set = volume;
     }
-    return es8311_write_reg(dev, ES8311_DAC_REG32, reg32);
+    return es8311_update_reg(dev, ES8311_DAC_REG32, 0xFF, reg32);
+}
+
+static void es8311_volume_timer_cb(void *arg)
+{
+    es8311_dev_t *es = (es8311_dev_t *) arg;
+    esp_err_t ret = es8311_voice_volume_set(es, es->volume_pending, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Deferred volume failed (%s)", esp_err_to_name(ret));
+    }
+}
+
+esp_err_t es8311_voice_volume_set_async(es8311_handle_t dev, int volume)
+{
+    es8311_dev_t *es = (es8311_dev_t *) dev;
+    ESP_RETURN_ON_FALSE(es, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    es->volume_pending = volume;
+    // a running timer writes the latest value
+    esp_err_t ret = esp_timer_start_once(es->volume_timer, ES8311_VOLUME_COALESCE_US);
+    return (ret == ESP_ERR_INVALID_STATE) ? ESP_OK : ret;
 }
 
 esp_err_t es8311_voice_volume_get(es8311_handle_t dev, int *volume)
@@ -389,16 +511,7 @@ esp_err_t es8311_voice_volume_get(es8311_handle_t dev, int *volume)
 
 esp_err_t es8311_voice_mute(es8311_handle_t dev, bool mute)
 {
-    uint8_t reg31;
-    ESP_RETURN_ON_ERROR(es8311_read_reg(dev, ES8311_DAC_REG31, &reg31), TAG, "I2C read/write error");
-
-    if (mute) {
-        reg31 |= BIT(6) | BIT(5);
-    } else {
-        reg31 &= ~(BIT(6) | BIT(5));
-    }
-
-    return es8311_write_reg(dev, ES8311_DAC_REG31, reg31);
+    return es8311_update_reg(dev, ES8311_DAC_REG31, BIT(6) | BIT(5), mute ? (BIT(6) | BIT(5)) : 0);
 }
 
 esp_err_t es8311_microphone_gain_set(es8311_handle_t dev, es8311_mic_gain_t gain_db)
@@ -408,27 +521,189 @@ esp_err_t es8311_microphone_gain_set(es8311_handle_t dev, es8311_mic_gain_t gain
 
 esp_err_t es8311_voice_fade(es8311_handle_t dev, const es8311_fade_t fade)
 {
-    uint8_t reg37;
-    ESP_RETURN_ON_ERROR(es8311_read_reg(dev, ES8311_DAC_REG37, &reg37), TAG, "I2C read/write error");
-    reg37 &= 0x0F;
-    reg37 |= (fade << 4);
-    return es8311_write_reg(dev, ES8311_DAC_REG37, reg37);
+    return es8311_update_reg(dev, ES8311_DAC_REG37, 0xF0, fade << 4);
 }
 
 esp_err_t es8311_microphone_fade(es8311_handle_t dev, const es8311_fade_t fade)
 {
-    uint8_t reg15;
-    ESP_RETURN_ON_ERROR(es8311_read_reg(dev, ES8311_ADC_REG15, &reg15), TAG, "I2C read/write error");
-    reg15 &= 0x0F;
-    reg15 |= (fade << 4);
-    return es8311_write_reg(dev, ES8311_ADC_REG15, reg15);
+    return es8311_update_reg(dev, ES8311_ADC_REG15, 0xF0, fade << 4);
+}
+
+/*
+ * Coefficients are written in register order, 4 registers each (MSB first) in one I2C transaction.
+ * The equalizer is bypassed meanwhile, so a half-written filter is never applied.
+ */
+static esp_err_t es8311_eq_write(es8311_handle_t dev, uint8_t reg_addr, const float *coeffs, size_t count,
+                                 uint8_t bypass_reg, uint8_t bypass_bit)
+{
+    es8311_reg_value_t regs[ES8311_EQ_COEFF_MAX * 4];
+    assert(count <= ES8311_EQ_COEFF_MAX);
+
+    for (size_t i = 0; i < count; i++) {
+        ESP_RETURN_ON_FALSE(coeffs[i] >= -4.0f && coeffs[i] < 4.0f, ESP_ERR_INVALID_ARG, TAG, "coefficient out of range");
+        int32_t fixed = (int32_t)lrintf(coeffs[i] * (1 << ES8311_EQ_COEFF_FRAC_BITS));
+        fixed = MIN(fixed, (1 << 29) - 1);
+        const uint32_t bits = (uint32_t)fixed & 0x3FFFFFFF;
+        for (size_t j = 0; j < 4; j++) {
+            regs[i * 4 + j].reg = reg_addr + i * 4 + j;
+            regs[i * 4 + j].value = (bits >> (24 - j * 8)) & 0xFF;
+        }
+    }
+
+    ESP_RETURN_ON_ERROR(es8311_update_reg(dev, bypass_reg, bypass_bit, bypass_bit), TAG, "I2C read/write error");
+    ESP_RETURN_ON_ERROR(es8311_write_regs(dev, regs, count * 4), TAG, "I2C read/write error");
+    return es8311_update_reg(dev, bypass_reg, bypass_bit, 0);
+}
+
+esp_err_t es8311_adc_eq_config(es8311_handle_t dev, const es8311_biquad_t *biquad)
+{
+    ESP_RETURN_ON_FALSE(dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (biquad == NULL) {
+        return es8311_update_reg(dev, ES8311_ADC_REG1C, BIT(6), BIT(6));
+    }
+    const float coeffs[] = {biquad->b0, biquad->a1, biquad->a2, biquad->b1, biquad->b2}; // register order
+    return es8311_eq_write(dev, ES8311_ADCEQ_B0_REG1D, coeffs, sizeof(coeffs) / sizeof(coeffs[0]), ES8311_ADC_REG1C, BIT(6));
+}
+
+esp_err_t es8311_dac_eq_config(es8311_handle_t dev, const es8311_first_order_t *filter)
+{
+    ESP_RETURN_ON_FALSE(dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (filter == NULL) {
+        return es8311_update_reg(dev, ES8311_DAC_REG37, BIT(3), BIT(3));
+    }
+    const float coeffs[] = {filter->b0, filter->b1, filter->a1}; // register order
+    return es8311_eq_write(dev, ES8311_DACEQ_B0_REG38, coeffs, sizeof(coeffs) / sizeof(coeffs[0]), ES8311_DAC_REG37, BIT(3));
+}
+
+/* Nearest DRC level 20*log10((N+1)/32) */
+static uint8_t es8311_drc_level(float level_db)
+{
+    const int level = (int)lrintf(32.0f * powf(10.0f, level_db / 20.0f)) - 1;
+    return (uint8_t)MAX(0, MIN(level, 15));
+}
+
+esp_err_t es8311_dac_drc_config(es8311_handle_t dev, const es8311_drc_config_t *drc)
+{
+    ESP_RETURN_ON_FALSE(dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (drc == NULL) {
+        return es8311_update_reg(dev, ES8311_DAC_REG34, BIT(7), 0);
+    }
+    ESP_RETURN_ON_FALSE(drc->win_size <= 0x0F, ESP_ERR_INVALID_ARG, TAG, "invalid DRC window size");
+    ESP_RETURN_ON_FALSE(drc->max_level_db >= drc->min_level_db, ESP_ERR_INVALID_ARG, TAG, "DRC max level below min level");
+
+    const uint8_t reg35 = (es8311_drc_level(drc->max_level_db) << 4) | es8311_drc_level(drc->min_level_db);
+    ESP_RETURN_ON_ERROR(es8311_update_reg(dev, ES8311_DAC_REG35, 0xFF, reg35), TAG, "I2C read/write error");
+    return es8311_update_reg(dev, ES8311_DAC_REG34, BIT(7) | 0x0F, BIT(7) | drc->win_size);
+}
+
+esp_err_t es8311_biquad_calc(es8311_filter_type_t type, int sample_frequency, float frequency, float gain_db, float q,
+                             es8311_biquad_t *biquad)
+{
+    ESP_RETURN_ON_FALSE(biquad && q > 0.0f, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(frequency > 0.0f && frequency < sample_frequency / 2.0f, ESP_ERR_INVALID_ARG, TAG, "invalid frequency");
+
+    const float w0 = 2.0f * (float)M_PI * frequency / sample_frequency;
+    const float cos_w0 = cosf(w0);
+    const float alpha = sinf(w0) / (2.0f * q);
+    const float A = powf(10.0f, gain_db / 40.0f);
+    const float sqrt_a2 = 2.0f * sqrtf(A) * alpha;
+    float b0, b1, b2, a0, a1, a2;
+
+    switch (type) {
+    case ES8311_FILTER_LOWPASS:
+        b0 = (1.0f - cos_w0) / 2.0f;
+        b1 = 1.0f - cos_w0;
+        b2 = b0;
+        a0 = 1.0f + alpha;
+        a1 = -2.0f * cos_w0;
+        a2 = 1.0f - alpha;
+        break;
+    case ES8311_FILTER_HIGHPASS:
+        b0 = (1.0f + cos_w0) / 2.0f;
+        b1 = -(1.0f + cos_w0);
+        b2 = b0;
+        a0 = 1.0f + alpha;
+        a1 = -2.0f * cos_w0;
+        a2 = 1.0f - alpha;
+        break;
+    case ES8311_FILTER_PEAKING:
+        b0 = 1.0f + alpha * A;
+        b1 = -2.0f * cos_w0;
+        b2 = 1.0f - alpha * A;
+        a0 = 1.0f + alpha / A;
+        a1 = -2.0f * cos_w0;
+        a2 = 1.0f - alpha / A;
+        break;
+    case ES8311_FILTER_LOW_SHELF:
+        b0 = A * ((A + 1.0f) - (A - 1.0f) * cos_w0 + sqrt_a2);
+        b1 = 2.0f * A * ((A - 1.0f) - (A + 1.0f) * cos_w0);
+        b2 = A * ((A + 1.0f) - (A - 1.0f) * cos_w0 - sqrt_a2);
+        a0 = (A + 1.0f) + (A - 1.0f) * cos_w0 + sqrt_a2;
+        a1 = -2.0f * ((A - 1.0f) + (A + 1.0f) * cos_w0);
+        a2 = (A + 1.0f) + (A - 1.0f) * cos_w0 - sqrt_a2;
+        break;
+    case ES8311_FILTER_HIGH_SHELF:
+        b0 = A * ((A + 1.0f) + (A - 1.0f) * cos_w0 + sqrt_a2);
+        b1 = -2.0f * A * ((A - 1.0f) + (A + 1.0f) * cos_w0);
+        b2 = A * ((A + 1.0f) + (A - 1.0f) * cos_w0 - sqrt_a2);
+        a0 = (A + 1.0f) - (A - 1.0f) * cos_w0 + sqrt_a2;
+        a1 = 2.0f * ((A - 1.0f) - (A + 1.0f) * cos_w0);
+        a2 = (A + 1.0f) - (A - 1.0f) * cos_w0 - sqrt_a2;
+        break;
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    biquad->b0 = b0 / a0;
+    biquad->b1 = b1 / a0;
+    biquad->b2 = b2 / a0;
+    biquad->a1 = a1 / a0;
+    biquad->a2 = a2 / a0;
+    return ESP_OK;
+}
+
+esp_err_t es8311_first_order_calc(es8311_filter_type_t type, int sample_frequency, float frequency, float gain_db,
+                                  es8311_first_order_t *filter)
+{
+    ESP_RETURN_ON_FALSE(filter, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(frequency > 0.0f && frequency < sample_frequency / 2.0f, ESP_ERR_INVALID_ARG, TAG, "invalid frequency");
+
+    /* Bilinear transform with prewarped corner frequency */
+    const float k = tanf((float)M_PI * frequency / sample_frequency);
+    const float g = powf(10.0f, gain_db / 20.0f);
+    const float norm = 1.0f / (1.0f + k);
+
+    switch (type) {
+    case ES8311_FILTER_LOWPASS:
+        filter->b0 = k * norm;
+        filter->b1 = k * norm;
+        break;
+    case ES8311_FILTER_HIGHPASS:
+        filter->b0 = norm;
+        filter->b1 = -norm;
+        break;
+    case ES8311_FILTER_LOW_SHELF: // H(s) = (s + g) / (s + 1)
+        filter->b0 = (1.0f + g * k) * norm;
+        filter->b1 = (g * k - 1.0f) * norm;
+        break;
+    case ES8311_FILTER_HIGH_SHELF: // H(s) = (g * s + 1) / (s + 1)
+        filter->b0 = (g + k) * norm;
+        filter->b1 = (k - g) * norm;
+        break;
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+    filter->a1 = (k - 1.0f) * norm;
+    return ESP_OK;
 }
 
 void es8311_register_dump(es8311_handle_t dev)
 {
-    for (int reg = 0; reg < 0x4A; reg++) {
+    es8311_dev_t *es = (es8311_dev_t *) dev;
+    for (uint8_t reg = 0; reg < 0x4A; reg++) {
         uint8_t value;
-        ESP_ERROR_CHECK(es8311_read_reg(dev, reg, &value));
+        // real content of the registers, not the shadow
+        ESP_ERROR_CHECK(i2c_master_write_read_device(es->port, es->dev_addr, &reg, 1, &value, 1, pdMS_TO_TICKS(1000)));
         printf("REG:%02x: %02x", reg, value);
     }
 }
@@ -436,7 +711,21 @@ void es8311_register_dump(es8311_handle_t dev)
 es8311_handle_t es8311_create(const i2c_port_t port, const uint16_t dev_addr)
 {
     es8311_dev_t *sensor = (es8311_dev_t *) calloc(1, sizeof(es8311_dev_t));
+    if (sensor == NULL) {
+        return NULL;
+    }
     sensor->port = port;
     sensor->dev_addr = dev_addr;
+
+    const esp_timer_create_args_t volume_timer_args = {
+        .callback = es8311_volume_timer_cb,
+        .arg = sensor,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "es8311_volume",
+    };
+    if (esp_timer_create(&volume_timer_args, &sensor->volume_timer) != ESP_OK) {
+        free(sensor);
+        return NULL;
+    }
     return (es8311_handle_t) sensor;
 }
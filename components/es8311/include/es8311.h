@@ -75,9 +75,56 @@ typedef struct es8311_clock_config_t {
     int  sample_frequency;   // in Hz
 } es8311_clock_config_t;
 
+/**
+ * @brief Second order section (biquad) of ADC equalizer
+ *
+ * H(z) = (b0 + b1*z^-1 + b2*z^-2) / (1 + a1*z^-1 + a2*z^-2), coefficients must be in range <-4, 4).
+ */
+typedef struct es8311_biquad_t {
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+} es8311_biquad_t;
+
+/**
+ * @brief First order section of DAC equalizer
+ *
+ * H(z) = (b0 + b1*z^-1) / (1 + a1*z^-1), coefficients must be in range <-4, 4).
+ */
+typedef struct es8311_first_order_t {
+    float b0;
+    float b1;
+    float a1;
+} es8311_first_order_t;
+
+typedef enum es8311_filter_type_t {
+    ES8311_FILTER_LOWPASS,
+    ES8311_FILTER_HIGHPASS,
+    ES8311_FILTER_PEAKING,    // Biquad only
+    ES8311_FILTER_LOW_SHELF,
+    ES8311_FILTER_HIGH_SHELF,
+} es8311_filter_type_t;
+
+/**
+ * @brief DAC Dynamic Range Control (limiter and loudness)
+ *
+ * ES8311 keeps the output level between min_level_db and max_level_db (dBFS) by automatic gain.
+ * Levels are rounded to the nearest level of ES8311, 20*log10((N+1)/32) for N = 0..15, i.e. -30.1 to -6.0 dBFS.
+ */
+typedef struct es8311_drc_config_t {
+    float max_level_db;      /* Output level limit, speaker protection */
+    float min_level_db;      /* Quiet signal is amplified up to this level, loudness */
+    uint8_t win_size;        /* Level detector window 0 - 15, the window doubles with each step */
+} es8311_drc_config_t;
+
 /**
  * @brief Initialize ES8311
  *
+ * Register values of the configuration are computed in advance and written in a single I2C transaction
+ * after the reset, without reading the registers back.
+ *
  * There are two ways of providing Master Clock (MCLK) signal to ES8311 in Slave Mode:
  * 1. From MCLK pin:
  *    For flexible scenarios. A clock signal from I2S master is routed to MCLK pin.
@@ -116,6 +163,21 @@ esp_err_t es8311_init(es8311_handle_t dev, const es8311_clock_config_t *const cl
  */
 esp_err_t es8311_voice_volume_set(es8311_handle_t dev, int volume, int *volume_set);
 
+/**
+ * @brief Set output volume later, from esp_timer task
+ *
+ * For frequent changes, e.g. from a UI slider. Only the latest volume is written, at most once per 20 ms,
+ * so the I2C bus is not flooded. Enable es8311_voice_fade() to get click-free changes ramped by ES8311.
+ *
+ * @param dev ES8311 handle
+ * @param[in] volume Set volume (0 ~ 100)
+ *
+ * @return
+ *     - ESP_OK success
+ *     - Else fail
+ */
+esp_err_t es8311_voice_volume_set_async(es8311_handle_t dev, int volume);
+
 /**
  * @brief Get output volume
  *
@@ -135,6 +197,21 @@ esp_err_t es8311_voice_volume_get(es8311_handle_t dev, int *volume);
  */
 void es8311_register_dump(es8311_handle_t dev);
 
+/**
+ * @brief Verify ES8311 registers written by the driver
+ *
+ * Configuration registers are read back in one bulk I2C read (auto-incremented register address)
+ * and compared with the values written by es8311_init() and other functions of this driver.
+ * Optional, e.g. after es8311_init() in production test.
+ *
+ * @param dev ES8311 handle
+ * @return
+ *     - ESP_OK success
+ *     - ESP_ERR_INVALID_RESPONSE a register differs from the written value
+ *     - Else I2C read error
+ */
+esp_err_t es8311_register_verify(es8311_handle_t dev);
+
 /**
  * @brief Mute ES8311 output
  *
@@ -173,6 +250,8 @@ esp_err_t es8311_microphone_config(es8311_handle_t dev, bool digital_mic);
  *
  * @note This function is called by es8311_init().
  *       Call this function explicitly only if you want to change sample frequency during runtime.
+ *       Only the clock divider registers that differ are written, without re-initialization of the codec.
+ *       Disable the I2S channel during the switch and reconfigure its clock to the new sample frequency.
  * @param dev ES8311 handle
  * @param[in] mclk_frequency   MCLK frequency in [Hz] (MCLK or SCLK pin, depending on bit register01[7])
  * @param[in] sample_frequency Required sample frequency in [Hz], e.g. 44100, 22050...
@@ -184,8 +263,9 @@ esp_err_t es8311_microphone_config(es8311_handle_t dev, bool digital_mic);
 esp_err_t es8311_sample_frequency_config(es8311_handle_t dev, int mclk_frequency, int sample_frequency);
 
 /**
- * @brief Configure fade in/out for ADC: voice
+ * @brief Configure fade in/out for DAC: voice
  *
+ * ES8311 ramps volume changes and mute of DAC by 0.25 dB per the selected number of LRCK periods.
  * @param dev ES8311 handle
  * @param[in] fade Fade ramp rate
  * @return
@@ -195,7 +275,7 @@ esp_err_t es8311_sample_frequency_config(es8311_handle_t dev, int mclk_frequency
 esp_err_t es8311_voice_fade(es8311_handle_t dev, const es8311_fade_t fade);
 
 /**
- * @brief Configure fade in/out for DAC: microphone
+ * @brief Configure fade in/out for ADC: microphone
  *
  * @param dev ES8311 handle
  * @param[in] fade Fade ramp rate
@@ -205,6 +285,86 @@ esp_err_t es8311_voice_fade(es8311_handle_t dev, const es8311_fade_t fade);
  */
 esp_err_t es8311_microphone_fade(es8311_handle_t dev, const es8311_fade_t fade);
 
+/**
+ * @brief Configure ADC equalizer
+ *
+ * One biquad applied to microphone signal by ES8311.
+ * The coefficients depend on sample frequency, set them again after es8311_sample_frequency_config().
+ *
+ * @note Call this function after es8311_init(), it resets the equalizer.
+ * @param dev ES8311 handle
+ * @param[in] biquad Filter coefficients, NULL bypasses the equalizer
+ * @return
+ *     - ESP_OK success
+ *     - ESP_ERR_INVALID_ARG coefficient out of range
+ *     - Else I2C read/write error
+ */
+esp_err_t es8311_adc_eq_config(es8311_handle_t dev, const es8311_biquad_t *biquad);
+
+/**
+ * @brief Configure DAC equalizer
+ *
+ * One first order section applied to output signal by ES8311, e.g. bass cut of a small speaker.
+ * The coefficients depend on sample frequency, set them again after es8311_sample_frequency_config().
+ *
+ * @note Call this function after es8311_init(), it resets the equalizer.
+ * @param dev ES8311 handle
+ * @param[in] filter Filter coefficients, NULL bypasses the equalizer
+ * @return
+ *     - ESP_OK success
+ *     - ESP_ERR_INVALID_ARG coefficient out of range
+ *     - Else I2C read/write error
+ */
+esp_err_t es8311_dac_eq_config(es8311_handle_t dev, const es8311_first_order_t *filter);
+
+/**
+ * @brief Configure DAC Dynamic Range Control
+ *
+ * @note Call this function after es8311_init(), it disables DRC.
+ * @param dev ES8311 handle
+ * @param[in] drc DRC configuration, NULL disables DRC
+ * @return
+ *     - ESP_OK success
+ *     - ESP_ERR_INVALID_ARG invalid window size or max level below min level
+ *     - Else I2C read/write error
+ */
+esp_err_t es8311_dac_drc_config(es8311_handle_t dev, const es8311_drc_config_t *drc);
+
+/**
+ * @brief Calculate biquad coefficients for ADC equalizer
+ *
+ * Audio EQ Cookbook (R. Bristow-Johnson) filters.
+ *
+ * @param[in]  type             Filter type
+ * @param[in]  sample_frequency Sample frequency in [Hz]
+ * @param[in]  frequency        Cutoff, center or shelf midpoint frequency in [Hz], below sample_frequency / 2
+ * @param[in]  gain_db          Gain of peaking and shelf filters in [dB], ignored otherwise
+ * @param[in]  q                Quality factor, 0.707 for Butterworth low and high pass and for shelves of slope 1
+ * @param[out] biquad           Calculated coefficients
+ * @return
+ *     - ESP_OK success
+ *     - ESP_ERR_INVALID_ARG invalid argument
+ */
+esp_err_t es8311_biquad_calc(es8311_filter_type_t type, int sample_frequency, float frequency, float gain_db, float q,
+                             es8311_biquad_t *biquad);
+
+/**
+ * @brief Calculate first order coefficients for DAC equalizer
+ *
+ * Bilinear transform of first order low/high pass and shelf filters.
+ *
+ * @param[in]  type             Filter type, ES8311_FILTER_PEAKING is not supported
+ * @param[in]  sample_frequency Sample frequency in [Hz]
+ * @param[in]  frequency        Cutoff or shelf corner frequency in [Hz], below sample_frequency / 2
+ * @param[in]  gain_db          Gain of shelf filters in [dB], ignored otherwise
+ * @param[out] filter           Calculated coefficients
+ * @return
+ *     - ESP_OK success
+ *     - ESP_ERR_INVALID_ARG invalid argument
+ */
+esp_err_t es8311_first_order_calc(es8311_filter_type_t type, int sample_frequency, float frequency, float gain_db,
+                                  es8311_first_order_t *filter);
+
 /**
  * @brief Create ES8311 object and return its handle
  *
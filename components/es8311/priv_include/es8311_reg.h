@@ -51,6 +51,11 @@
 #define ES8311_ADC_REG1A                0x1A /* ADC, alc automute */
 #define ES8311_ADC_REG1B                0x1B /* ADC, alc automute, adc hpf s1 */
 #define ES8311_ADC_REG1C                0x1C /* ADC, equalizer, hpf s2 */
+#define ES8311_ADCEQ_B0_REG1D           0x1D /* ADC, equalizer coefficient B0, REG1D - REG20 */
+#define ES8311_ADCEQ_A1_REG21           0x21 /* ADC, equalizer coefficient A1, REG21 - REG24 */
+#define ES8311_ADCEQ_A2_REG25           0x25 /* ADC, equalizer coefficient A2, REG25 - REG28 */
+#define ES8311_ADCEQ_B1_REG29           0x29 /* ADC, equalizer coefficient B1, REG29 - REG2C */
+#define ES8311_ADCEQ_B2_REG2D           0x2D /* ADC, equalizer coefficient B2, REG2D - REG30 */
 /*
  * DAC
  */
@@ -59,7 +64,10 @@
 #define ES8311_DAC_REG33                0x33 /* DAC, offset */
 #define ES8311_DAC_REG34                0x34 /* DAC, drc enable, drc winsize */
 #define ES8311_DAC_REG35                0x35 /* DAC, drc maxlevel, minilevel */
-#define ES8311_DAC_REG37                0x37 /* DAC, ramprate */
+#define ES8311_DAC_REG37                0x37 /* DAC, ramprate, equalizer bypass */
+#define ES8311_DACEQ_B0_REG38           0x38 /* DAC, equalizer coefficient B0, REG38 - REG3B */
+#define ES8311_DACEQ_B1_REG3C           0x3C /* DAC, equalizer coefficient B1, REG3C - REG3F */
+#define ES8311_DACEQ_A1_REG40           0x40 /* DAC, equalizer coefficient A1, REG40 - REG43 */
 /*
  *GPIO
  */
@@ -0,0 +1,344 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_audio_loop.h"
+
+static const char *TAG = "AUDIO_LOOP";
+
+#define AUDIO_LOOP_SAMPLE_RATE_DEFAULT  (16000)
+#ifdef CONFIG_BSP_I2S_DMA_FRAME_NUM
+#define AUDIO_LOOP_FRAME_DEFAULT        (CONFIG_BSP_I2S_DMA_FRAME_NUM)
+#else
+#define AUDIO_LOOP_FRAME_DEFAULT        (240)   /* I2S_CHANNEL_DEFAULT_CONFIG */
+#endif
+#ifdef CONFIG_BSP_I2S_DMA_DESC_NUM
+#define AUDIO_LOOP_DMA_BUFFERS_DEFAULT  (CONFIG_BSP_I2S_DMA_DESC_NUM)
+#else
+#define AUDIO_LOOP_DMA_BUFFERS_DEFAULT  (6)     /* I2S_CHANNEL_DEFAULT_CONFIG */
+#endif
+#define AUDIO_LOOP_PRIORITY_DEFAULT     (10)
+#define AUDIO_LOOP_STACK_DEFAULT        (4096)
+
+/* Latency measurement pulse */
+#define AUDIO_LOOP_PULSE_SAMPLES        (16)
+#define AUDIO_LOOP_PULSE_THRESHOLD      (INT16_MAX / 4)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef enum {
+    AUDIO_LOOP_MEASURE_OFF,
+    AUDIO_LOOP_MEASURE_EMIT,        /* Pulse is played in the next frame */
+    AUDIO_LOOP_MEASURE_DETECT,      /* Pulse is searched in the captured frames */
+} esp_audio_loop_measure_t;
+
+struct esp_audio_loop_s {
+    esp_codec_dev_handle_t  mic;
+    esp_codec_dev_handle_t  spk;
+    uint32_t                sample_rate;
+    uint8_t                 in_channels;
+    uint8_t                 out_channels;
+    uint32_t                frame_samples;
+    uint32_t                frame_us;
+    uint32_t                dma_buffers;
+    esp_audio_loop_process_cb_t process_cb;
+    void                    *user_ctx;
+    int16_t                 *in_buf;
+    int16_t                 *out_buf;
+    TaskHandle_t            task;
+    SemaphoreHandle_t       idle_sem;       /* Given, when the loop task stops */
+    volatile bool           running;
+    volatile bool           exit;
+    /* Latency measurement */
+    volatile esp_audio_loop_measure_t measure;
+    SemaphoreHandle_t       measure_sem;
+    uint32_t                measure_frame;  /* Frame with the pulse */
+    /* Statistics */
+    portMUX_TYPE            stats_lock;
+    esp_audio_loop_stats_t  stats;
+    uint64_t                process_sum_us;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void esp_audio_loop_task(void *arg);
+static void esp_audio_loop_free(esp_audio_loop_handle_t loop);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_audio_loop_new(const esp_audio_loop_config_t *config, esp_audio_loop_handle_t *ret_loop)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_loop && config->mic && config->spk, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_audio_loop_handle_t loop = calloc(1, sizeof(struct esp_audio_loop_s));
+    ESP_RETURN_ON_FALSE(loop, ESP_ERR_NO_MEM, TAG, "Not enough memory for audio loop allocation!");
+    loop->mic = config->mic;
+    loop->spk = config->spk;
+    loop->sample_rate = (config->sample_rate ? config->sample_rate : AUDIO_LOOP_SAMPLE_RATE_DEFAULT);
+    loop->in_channels = (config->in_channels ? config->in_channels : 1);
+    loop->out_channels = (config->out_channels ? config->out_channels : 1);
+    loop->frame_samples = (config->frame_samples ? config->frame_samples : AUDIO_LOOP_FRAME_DEFAULT);
+    loop->frame_us = (uint32_t)((uint64_t)loop->frame_samples * 1000000 / loop->sample_rate);
+    loop->dma_buffers = (config->dma_buffers ? config->dma_buffers : AUDIO_LOOP_DMA_BUFFERS_DEFAULT);
+    loop->process_cb = config->process_cb;
+    loop->user_ctx = config->user_ctx;
+    portMUX_INITIALIZE(&loop->stats_lock);
+    loop->stats.frame_us = loop->frame_us;
+
+    loop->in_buf = malloc(loop->frame_samples * loop->in_channels * sizeof(int16_t));
+    loop->out_buf = malloc(loop->frame_samples * loop->out_channels * sizeof(int16_t));
+    loop->idle_sem = xSemaphoreCreateBinary();
+    loop->measure_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(loop->in_buf && loop->out_buf && loop->idle_sem && loop->measure_sem, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for audio loop!");
+
+    const UBaseType_t priority = (config->task_priority ? config->task_priority : AUDIO_LOOP_PRIORITY_DEFAULT);
+    const uint32_t stack = (config->task_stack ? config->task_stack : AUDIO_LOOP_STACK_DEFAULT);
+    BaseType_t res = xTaskCreate(esp_audio_loop_task, "audio_loop", stack, loop, priority, &loop->task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create audio loop task fail!");
+
+    *ret_loop = loop;
+    return ESP_OK;
+
+err:
+    esp_audio_loop_free(loop);
+    return ret;
+}
+
+esp_err_t esp_audio_loop_start(esp_audio_loop_handle_t loop)
+{
+    ESP_RETURN_ON_FALSE(loop, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!loop->running, ESP_ERR_INVALID_STATE, TAG, "Audio loop is running");
+
+    /* Same sample rate in both directions, the shared I2S clock is not changed */
+    esp_codec_dev_sample_info_t fs = {
+        .sample_rate = loop->sample_rate,
+        .channel = loop->in_channels,
+        .bits_per_sample = 16,
+    };
+    ESP_RETURN_ON_FALSE(esp_codec_dev_open(loop->mic, &fs) == ESP_CODEC_DEV_OK, ESP_FAIL, TAG, "Microphone open failed");
+    fs.channel = loop->out_channels;
+    if (esp_codec_dev_open(loop->spk, &fs) != ESP_CODEC_DEV_OK) {
+        esp_codec_dev_close(loop->mic);
+        ESP_LOGE(TAG, "Speaker open failed");
+        return ESP_FAIL;
+    }
+
+    loop->running = true;
+    xTaskNotifyGive(loop->task);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_loop_stop(esp_audio_loop_handle_t loop)
+{
+    ESP_RETURN_ON_FALSE(loop, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!loop->running) {
+        return ESP_OK;
+    }
+
+    loop->running = false;
+    xSemaphoreTake(loop->idle_sem, portMAX_DELAY);
+    esp_codec_dev_close(loop->spk);
+    esp_codec_dev_close(loop->mic);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_loop_measure_latency(esp_audio_loop_handle_t loop, uint32_t timeout_ms, uint32_t *latency_us)
+{
+    ESP_RETURN_ON_FALSE(loop && latency_us, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(loop->running, ESP_ERR_INVALID_STATE, TAG, "Audio loop is not running");
+
+    xSemaphoreTake(loop->measure_sem, 0);
+    loop->measure = AUDIO_LOOP_MEASURE_EMIT;
+    if (xSemaphoreTake(loop->measure_sem, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        loop->measure = AUDIO_LOOP_MEASURE_OFF;
+        /* The pulse could be detected just now */
+        if (xSemaphoreTake(loop->measure_sem, 0) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+
+    portENTER_CRITICAL(&loop->stats_lock);
+    *latency_us = loop->stats.measured_latency_us;
+    portEXIT_CRITICAL(&loop->stats_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_loop_get_stats(esp_audio_loop_handle_t loop, esp_audio_loop_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(loop && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&loop->stats_lock);
+    *stats = loop->stats;
+    if (loop->stats.frames > 0) {
+        stats->avg_process_us = (uint32_t)(loop->process_sum_us / loop->stats.frames);
+    }
+    /* One frame is captured, before it is processed, then it waits behind the queued playback DMA buffers */
+    stats->latency_us = loop->frame_us * (1 + loop->dma_buffers) + stats->avg_process_us;
+    if (reset) {
+        loop->stats.frames = 0;
+        loop->stats.dropped = 0;
+        loop->stats.late = 0;
+        loop->stats.max_process_us = 0;
+        loop->process_sum_us = 0;
+    }
+    portEXIT_CRITICAL(&loop->stats_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_loop_del(esp_audio_loop_handle_t loop)
+{
+    ESP_RETURN_ON_FALSE(loop, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_audio_loop_stop(loop);
+    esp_audio_loop_free(loop);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void esp_audio_loop_free(esp_audio_loop_handle_t loop)
+{
+    if (loop->task) {
+        loop->exit = true;
+        xTaskNotifyGive(loop->task);
+        xSemaphoreTake(loop->idle_sem, portMAX_DELAY);
+    }
+    if (loop->idle_sem) {
+        vSemaphoreDelete(loop->idle_sem);
+    }
+    if (loop->measure_sem) {
+        vSemaphoreDelete(loop->measure_sem);
+    }
+    free(loop->in_buf);
+    free(loop->out_buf);
+    free(loop);
+}
+
+static void esp_audio_loop_measure(esp_audio_loop_handle_t loop, uint32_t frame)
+{
+    if (loop->measure == AUDIO_LOOP_MEASURE_DETECT) {
+        for (uint32_t i = 0; i < loop->frame_samples; i++) {
+            if (abs(loop->in_buf[i * loop->in_channels]) > AUDIO_LOOP_PULSE_THRESHOLD) {
+                /* The pulse was sent after capture of frame measure_frame, its start is the captured sample latency_us ago */
+                const uint32_t latency_us = (frame - loop->measure_frame) * loop->frame_us + (uint32_t)((uint64_t)i * 1000000 / loop->sample_rate);
+                portENTER_CRITICAL(&loop->stats_lock);
+                loop->stats.measured_latency_us = latency_us;
+                portEXIT_CRITICAL(&loop->stats_lock);
+                loop->measure = AUDIO_LOOP_MEASURE_OFF;
+                xSemaphoreGive(loop->measure_sem);
+                break;
+            }
+        }
+    }
+
+    /* Output is muted during the measurement, only the pulse is played */
+    memset(loop->out_buf, 0, loop->frame_samples * loop->out_channels * sizeof(int16_t));
+    if (loop->measure == AUDIO_LOOP_MEASURE_EMIT) {
+        for (uint32_t i = 0; i < MIN(AUDIO_LOOP_PULSE_SAMPLES, loop->frame_samples) * loop->out_channels; i++) {
+            loop->out_buf[i] = INT16_MAX;
+        }
+        loop->measure_frame = frame;
+        loop->measure = AUDIO_LOOP_MEASURE_DETECT;
+    }
+}
+
+static void esp_audio_loop_task(void *arg)
+{
+    esp_audio_loop_handle_t loop = (esp_audio_loop_handle_t)arg;
+    const size_t in_size = loop->frame_samples * loop->in_channels * sizeof(int16_t);
+    const size_t out_size = loop->frame_samples * loop->out_channels * sizeof(int16_t);
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (loop->exit) {
+            break;
+        }
+
+        /* Drop old captured frames: the read waits for a new frame, when the RX DMA buffers are empty */
+        int64_t sync_time = 0;
+        for (uint32_t i = 0; i <= loop->dma_buffers; i++) {
+            const int64_t start = esp_timer_get_time();
+            esp_codec_dev_read(loop->mic, loop->in_buf, in_size);
+            sync_time = esp_timer_get_time();
+            if (sync_time - start > loop->frame_us / 2) {
+                break;
+            }
+        }
+
+        uint32_t frame = 0;
+        uint32_t frames_since_sync = 0;
+        while (loop->running) {
+            const int64_t read_start = esp_timer_get_time();
+            esp_codec_dev_read(loop->mic, loop->in_buf, in_size);
+            const int64_t now = esp_timer_get_time();
+            if (now - read_start > loop->frame_us / 2) {
+                /* The read waited for the frame, there is no backlog */
+                sync_time = now;
+                frames_since_sync = 0;
+            } else {
+                frames_since_sync++;
+                /* More complete frames are waiting: the processing was late, drop one frame */
+                if ((uint32_t)((now - sync_time) / loop->frame_us) > frames_since_sync) {
+                    portENTER_CRITICAL(&loop->stats_lock);
+                    loop->stats.dropped++;
+                    portEXIT_CRITICAL(&loop->stats_lock);
+                    frame++;
+                    continue;
+                }
+            }
+
+            const int64_t process_start = esp_timer_get_time();
+            if (loop->process_cb) {
+                loop->process_cb(loop->in_buf, loop->out_buf, loop->frame_samples, loop->user_ctx);
+            } else {
+                for (uint32_t i = 0; i < loop->frame_samples; i++) {
+                    for (uint8_t ch = 0; ch < loop->out_channels; ch++) {
+                        loop->out_buf[i * loop->out_channels + ch] = loop->in_buf[i * loop->in_channels];
+                    }
+                }
+            }
+            if (loop->measure != AUDIO_LOOP_MEASURE_OFF) {
+                esp_audio_loop_measure(loop, frame);
+            }
+            const uint32_t process_us = (uint32_t)(esp_timer_get_time() - process_start);
+
+            esp_codec_dev_write(loop->spk, loop->out_buf, out_size);
+            frame++;
+
+            portENTER_CRITICAL(&loop->stats_lock);
+            loop->stats.frames++;
+            loop->process_sum_us += process_us;
+            loop->stats.max_process_us = MAX(loop->stats.max_process_us, process_us);
+            if (process_us > loop->frame_us) {
+                loop->stats.late++;
+            }
+            portEXIT_CRITICAL(&loop->stats_lock);
+        }
+
+        loop->measure = AUDIO_LOOP_MEASURE_OFF;
+        xSemaphoreGive(loop->idle_sem);
+    }
+
+    xSemaphoreGive(loop->idle_sem);
+    vTaskDelete(NULL);
+}
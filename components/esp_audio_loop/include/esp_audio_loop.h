@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Low latency full-duplex audio loop
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_codec_dev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Audio loop handle
+ */
+typedef struct esp_audio_loop_s *esp_audio_loop_handle_t;
+
+/**
+ * @brief Callback for processing one frame (e.g. AEC, beamforming), called from the loop task
+ *
+ * @param in        captured frame (samples * in_channels, 16 bit interleaved)
+ * @param out       frame for playback (samples * out_channels, 16 bit interleaved)
+ * @param samples   samples per channel in the frame
+ * @param user_ctx  user context
+ */
+typedef void (*esp_audio_loop_process_cb_t)(const int16_t *in, int16_t *out, size_t samples, void *user_ctx);
+
+/**
+ * @brief Configuration of the audio loop
+ *
+ * @note Microphone and speaker codecs should share one I2S peripheral in full-duplex mode (all BSPs with
+ *       bsp_audio_codec_speaker_init and bsp_audio_codec_microphone_init), so both directions run from one clock.
+ */
+typedef struct {
+    esp_codec_dev_handle_t  mic;            /*!< Input codec device (bsp_audio_codec_microphone_init) */
+    esp_codec_dev_handle_t  spk;            /*!< Output codec device (bsp_audio_codec_speaker_init) */
+    uint32_t                sample_rate;    /*!< Sample rate of both directions (0: 16 kHz) */
+    uint8_t                 in_channels;    /*!< Captured channels (0: 1) */
+    uint8_t                 out_channels;   /*!< Played channels (0: 1) */
+    uint32_t                frame_samples;  /*!< Samples per channel in one frame, it should match I2S DMA frame (0: CONFIG_BSP_I2S_DMA_FRAME_NUM or 240) */
+    uint32_t                dma_buffers;    /*!< Number of I2S DMA buffers, used for latency estimation (0: CONFIG_BSP_I2S_DMA_DESC_NUM or 6) */
+    esp_audio_loop_process_cb_t process_cb; /*!< Frame processing (NULL: the first input channel is copied to all output channels) */
+    void                    *user_ctx;      /*!< User context of the process callback */
+    UBaseType_t             task_priority;  /*!< Priority of the loop task (0: 10) */
+    uint32_t                task_stack;     /*!< Stack of the loop task (0: 4096), the process callback runs in it */
+} esp_audio_loop_config_t;
+
+/**
+ * @brief Audio loop statistics
+ */
+typedef struct {
+    uint32_t frames;            /*!< Processed frames */
+    uint32_t dropped;           /*!< Captured frames dropped to keep the latency bounded (processing was late) */
+    uint32_t late;              /*!< Frames processed longer than the frame duration */
+    uint32_t frame_us;          /*!< Duration of one frame */
+    uint32_t avg_process_us;    /*!< Average duration of the process callback */
+    uint32_t max_process_us;    /*!< Longest duration of the process callback */
+    uint32_t latency_us;        /*!< Estimated end-to-end latency: capture of one frame, processing and playback DMA buffers */
+    uint32_t measured_latency_us; /*!< Result of the last esp_audio_loop_measure_latency (0: not measured) */
+} esp_audio_loop_stats_t;
+
+/**
+ * @brief Create audio loop
+ *
+ * @param config    loop configuration
+ * @param ret_loop  output loop handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if configuration is wrong
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_audio_loop_new(const esp_audio_loop_config_t *config, esp_audio_loop_handle_t *ret_loop);
+
+/**
+ * @brief Open the codecs and start the loop
+ *
+ * Old captured frames are dropped, before the first frame is processed.
+ *
+ * @param loop      loop handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the loop is running
+ *      - ESP_FAIL                  if the codecs cannot be opened
+ */
+esp_err_t esp_audio_loop_start(esp_audio_loop_handle_t loop);
+
+/**
+ * @brief Stop the loop and close the codecs
+ *
+ * @note It waits for the end of the current frame.
+ *
+ * @param loop      loop handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_audio_loop_stop(esp_audio_loop_handle_t loop);
+
+/**
+ * @brief Measure the end-to-end latency with a pulse
+ *
+ * A pulse is played instead of the processed output and it is detected in the captured frames (first channel).
+ * The speaker must be audible by the microphone (or the output wired to the input). The output is muted during the measurement.
+ *
+ * @param loop      loop handle
+ * @param timeout_ms maximal time to wait for the pulse
+ * @param latency_us output latency from capture to playback of the same sample
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the loop is not running
+ *      - ESP_ERR_TIMEOUT           if the pulse was not detected
+ */
+esp_err_t esp_audio_loop_measure_latency(esp_audio_loop_handle_t loop, uint32_t timeout_ms, uint32_t *latency_us);
+
+/**
+ * @brief Get loop statistics
+ *
+ * @param loop      loop handle
+ * @param stats     output statistics
+ * @param reset     reset the counters after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_audio_loop_get_stats(esp_audio_loop_handle_t loop, esp_audio_loop_stats_t *stats, bool reset);
+
+/**
+ * @brief Delete audio loop
+ *
+ * @note The loop is stopped. The codec devices are not deleted.
+ *
+ * @param loop      loop handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_audio_loop_del(esp_audio_loop_handle_t loop);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,504 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/stream_buffer.h"
+#include "esp_audio_mixer.h"
+
+static const char *TAG = "AUDIO_MIXER";
+
+#define AUDIO_MIXER_SAMPLE_RATE_DEFAULT (16000)
+#ifdef CONFIG_BSP_I2S_DMA_FRAME_NUM
+#define AUDIO_MIXER_FRAME_DEFAULT       (CONFIG_BSP_I2S_DMA_FRAME_NUM)
+#else
+#define AUDIO_MIXER_FRAME_DEFAULT       (240)   /* I2S_CHANNEL_DEFAULT_CONFIG */
+#endif
+#ifdef CONFIG_BSP_I2S_DMA_DESC_NUM
+#define AUDIO_MIXER_DMA_BUFFERS_DEFAULT (CONFIG_BSP_I2S_DMA_DESC_NUM)
+#else
+#define AUDIO_MIXER_DMA_BUFFERS_DEFAULT (6)     /* I2S_CHANNEL_DEFAULT_CONFIG */
+#endif
+#define AUDIO_MIXER_VOICES_DEFAULT      (4)
+#define AUDIO_MIXER_PRIORITY_DEFAULT    (8)
+#define AUDIO_MIXER_STACK               (3072)
+#define AUDIO_MIXER_STREAM_FRAMES       (4)     /* Default ring buffer of streams in frames */
+/* 128-bit vectors of 8 samples */
+#define AUDIO_MIXER_ALIGN               (16)
+#define AUDIO_MIXER_VECTOR_SAMPLES      (8)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct esp_audio_mixer_sound_s {
+    int16_t         *data;          /* Samples in mixer format, aligned to vectors */
+    size_t          len;            /* Samples of all channels */
+    uint8_t         voices;         /* Voices playing the sound */
+};
+
+typedef struct {
+    esp_audio_mixer_sound_handle_t sound;   /* NULL: free voice */
+    size_t          pos;
+    int16_t         gain;
+} esp_audio_mixer_voice_t;
+
+struct esp_audio_mixer_stream_s {
+    esp_audio_mixer_handle_t mixer;
+    StreamBufferHandle_t ring;
+    volatile int16_t gain;
+    volatile bool   active;         /* Samples were written, missing samples are underruns */
+    struct esp_audio_mixer_stream_s *next;
+};
+
+struct esp_audio_mixer_s {
+    esp_codec_dev_handle_t  codec;
+    uint32_t                sample_rate;
+    uint8_t                 channels;
+    int                     mclk_multiple;
+    size_t                  frame_len;      /* Samples of all channels in one frame */
+    uint32_t                frame_us;
+    uint32_t                dma_buffers;
+    int16_t                 *mix_buf;
+    int16_t                 *stream_buf;
+    esp_audio_mixer_voice_t *voices;
+    uint8_t                 max_voices;
+    uint16_t                sounds;         /* Loaded sounds */
+    struct esp_audio_mixer_stream_s *streams;
+    SemaphoreHandle_t       streams_lock;
+    TaskHandle_t            task;
+    SemaphoreHandle_t       idle_sem;       /* Given, when the mixer task stops */
+    volatile bool           running;
+    volatile bool           exit;
+    /* Voices and statistics */
+    portMUX_TYPE            lock;
+    esp_audio_mixer_stats_t stats;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void esp_audio_mixer_task(void *arg);
+static void esp_audio_mixer_free(esp_audio_mixer_handle_t mixer);
+
+#if CONFIG_IDF_TARGET_ESP32S3
+extern void esp_audio_mixer_mac_q15_esp32s3(int16_t *acc, const int16_t *src, int16_t gain, size_t len);
+#endif
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_audio_mixer_new(const esp_audio_mixer_config_t *config, esp_audio_mixer_handle_t *ret_mixer)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_mixer && config->codec && config->channels <= 2, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_audio_mixer_handle_t mixer = calloc(1, sizeof(struct esp_audio_mixer_s));
+    ESP_RETURN_ON_FALSE(mixer, ESP_ERR_NO_MEM, TAG, "Not enough memory for audio mixer allocation!");
+    mixer->codec = config->codec;
+    mixer->sample_rate = (config->sample_rate ? config->sample_rate : AUDIO_MIXER_SAMPLE_RATE_DEFAULT);
+    mixer->channels = (config->channels ? config->channels : 1);
+    mixer->mclk_multiple = config->mclk_multiple;
+    const uint32_t frame_samples = (config->frame_samples ? config->frame_samples : AUDIO_MIXER_FRAME_DEFAULT);
+    mixer->frame_len = frame_samples * mixer->channels;
+    mixer->frame_us = (uint32_t)((uint64_t)frame_samples * 1000000 / mixer->sample_rate);
+    mixer->dma_buffers = (config->dma_buffers ? config->dma_buffers : AUDIO_MIXER_DMA_BUFFERS_DEFAULT);
+    mixer->max_voices = (config->max_voices ? config->max_voices : AUDIO_MIXER_VOICES_DEFAULT);
+    portMUX_INITIALIZE(&mixer->lock);
+    mixer->stats.frame_us = mixer->frame_us;
+
+    /* Frame buffers are aligned for vector loads */
+    const size_t frame_size = mixer->frame_len * sizeof(int16_t);
+    mixer->mix_buf = heap_caps_aligned_alloc(AUDIO_MIXER_ALIGN, frame_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    mixer->stream_buf = heap_caps_aligned_alloc(AUDIO_MIXER_ALIGN, frame_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    mixer->voices = calloc(mixer->max_voices, sizeof(esp_audio_mixer_voice_t));
+    mixer->streams_lock = xSemaphoreCreateMutex();
+    mixer->idle_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(mixer->mix_buf && mixer->stream_buf && mixer->voices && mixer->streams_lock && mixer->idle_sem,
+                      ESP_ERR_NO_MEM, err, TAG, "Not enough memory for audio mixer!");
+
+    const UBaseType_t priority = (config->task_priority ? config->task_priority : AUDIO_MIXER_PRIORITY_DEFAULT);
+    BaseType_t res = xTaskCreate(esp_audio_mixer_task, "audio_mixer", AUDIO_MIXER_STACK, mixer, priority, &mixer->task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create audio mixer task fail!");
+
+    *ret_mixer = mixer;
+    return ESP_OK;
+
+err:
+    esp_audio_mixer_free(mixer);
+    return ret;
+}
+
+esp_err_t esp_audio_mixer_start(esp_audio_mixer_handle_t mixer)
+{
+    ESP_RETURN_ON_FALSE(mixer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!mixer->running, ESP_ERR_INVALID_STATE, TAG, "Audio mixer is running");
+
+    esp_codec_dev_sample_info_t fs = {
+        .sample_rate = mixer->sample_rate,
+        .channel = mixer->channels,
+        .bits_per_sample = 16,
+        .mclk_multiple = mixer->mclk_multiple,
+    };
+    ESP_RETURN_ON_FALSE(esp_codec_dev_open(mixer->codec, &fs) == ESP_CODEC_DEV_OK, ESP_FAIL, TAG, "Codec open failed");
+
+    mixer->running = true;
+    xTaskNotifyGive(mixer->task);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_mixer_stop(esp_audio_mixer_handle_t mixer)
+{
+    ESP_RETURN_ON_FALSE(mixer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!mixer->running) {
+        return ESP_OK;
+    }
+
+    mixer->running = false;
+    xSemaphoreTake(mixer->idle_sem, portMAX_DELAY);
+    esp_codec_dev_close(mixer->codec);
+
+    portENTER_CRITICAL(&mixer->lock);
+    for (int i = 0; i < mixer->max_voices; i++) {
+        if (mixer->voices[i].sound) {
+            mixer->voices[i].sound->voices--;
+            mixer->voices[i].sound = NULL;
+        }
+    }
+    portEXIT_CRITICAL(&mixer->lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_mixer_sound_load(esp_audio_mixer_handle_t mixer, const esp_audio_mixer_pcm_t *pcm, esp_audio_mixer_sound_handle_t *ret_sound)
+{
+    ESP_RETURN_ON_FALSE(mixer && pcm && pcm->data && pcm->samples && ret_sound, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(pcm->sample_rate > 0 && pcm->channels >= 1 && pcm->channels <= 2, ESP_ERR_INVALID_ARG, TAG, "Unsupported format");
+
+    /* Resampled once here, the mixer only adds samples */
+    const size_t samples = (size_t)((uint64_t)pcm->samples * mixer->sample_rate / pcm->sample_rate);
+    ESP_RETURN_ON_FALSE(samples > 0, ESP_ERR_INVALID_ARG, TAG, "Sound is too short");
+    const size_t len = samples * mixer->channels;
+
+    esp_audio_mixer_sound_handle_t sound = calloc(1, sizeof(struct esp_audio_mixer_sound_s));
+    ESP_RETURN_ON_FALSE(sound, ESP_ERR_NO_MEM, TAG, "Not enough memory for sound allocation!");
+    sound->data = heap_caps_aligned_alloc(AUDIO_MIXER_ALIGN, len * sizeof(int16_t), MALLOC_CAP_DEFAULT);
+    if (sound->data == NULL) {
+        free(sound);
+        ESP_LOGE(TAG, "Not enough memory for sound data!");
+        return ESP_ERR_NO_MEM;
+    }
+    sound->len = len;
+
+    /* Linear interpolation in 16.16 fixed point */
+    const uint64_t step = ((uint64_t)pcm->sample_rate << 16) / mixer->sample_rate;
+    uint64_t pos = 0;
+    for (size_t i = 0; i < samples; i++, pos += step) {
+        const size_t idx0 = MIN((size_t)(pos >> 16), pcm->samples - 1);
+        const size_t idx1 = MIN(idx0 + 1, pcm->samples - 1);
+        const int32_t frac = (int32_t)(pos & 0xFFFF);
+        const int16_t *in0 = &pcm->data[idx0 * pcm->channels];
+        const int16_t *in1 = &pcm->data[idx1 * pcm->channels];
+        for (uint8_t ch = 0; ch < mixer->channels; ch++) {
+            int32_t s0, s1;
+            if (pcm->channels == mixer->channels || pcm->channels == 1) {
+                const uint8_t src_ch = (pcm->channels == 1 ? 0 : ch);
+                s0 = in0[src_ch];
+                s1 = in1[src_ch];
+            } else {
+                /* Stereo to mono */
+                s0 = (in0[0] + in0[1]) / 2;
+                s1 = (in1[0] + in1[1]) / 2;
+            }
+            sound->data[i * mixer->channels + ch] = (int16_t)(s0 + (((s1 - s0) * frac) >> 16));
+        }
+    }
+
+    portENTER_CRITICAL(&mixer->lock);
+    mixer->sounds++;
+    portEXIT_CRITICAL(&mixer->lock);
+
+    *ret_sound = sound;
+    return ESP_OK;
+}
+
+static int16_t esp_audio_mixer_gain_q15(float gain)
+{
+    return (int16_t)(MIN(MAX(gain, 0.0f), 1.0f) * INT16_MAX);
+}
+
+esp_err_t esp_audio_mixer_sound_play(esp_audio_mixer_handle_t mixer, esp_audio_mixer_sound_handle_t sound, float gain)
+{
+    ESP_RETURN_ON_FALSE(mixer && sound, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    bool played = false;
+
+    portENTER_CRITICAL(&mixer->lock);
+    for (int i = 0; i < mixer->max_voices; i++) {
+        if (mixer->voices[i].sound == NULL) {
+            mixer->voices[i] = (esp_audio_mixer_voice_t) {
+                .sound = sound,
+                .pos = 0,
+                .gain = esp_audio_mixer_gain_q15(gain),
+            };
+            sound->voices++;
+            played = true;
+            break;
+        }
+    }
+    if (played) {
+        mixer->stats.played++;
+    } else {
+        mixer->stats.rejected++;
+    }
+    portEXIT_CRITICAL(&mixer->lock);
+
+    return (played ? ESP_OK : ESP_ERR_NO_MEM);
+}
+
+esp_err_t esp_audio_mixer_sound_del(esp_audio_mixer_handle_t mixer, esp_audio_mixer_sound_handle_t sound)
+{
+    ESP_RETURN_ON_FALSE(mixer && sound, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&mixer->lock);
+    const bool playing = (sound->voices > 0);
+    if (!playing) {
+        mixer->sounds--;
+    }
+    portEXIT_CRITICAL(&mixer->lock);
+    ESP_RETURN_ON_FALSE(!playing, ESP_ERR_INVALID_STATE, TAG, "Sound is playing");
+
+    heap_caps_free(sound->data);
+    free(sound);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_mixer_stream_new(esp_audio_mixer_handle_t mixer, const esp_audio_mixer_stream_config_t *config, esp_audio_mixer_stream_handle_t *ret_stream)
+{
+    ESP_RETURN_ON_FALSE(mixer && config && ret_stream, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_audio_mixer_stream_handle_t stream = calloc(1, sizeof(struct esp_audio_mixer_stream_s));
+    ESP_RETURN_ON_FALSE(stream, ESP_ERR_NO_MEM, TAG, "Not enough memory for stream allocation!");
+    const size_t ring_size = (config->ring_size ? config->ring_size : AUDIO_MIXER_STREAM_FRAMES * mixer->frame_len * sizeof(int16_t));
+    stream->ring = xStreamBufferCreate(ring_size, 1);
+    if (stream->ring == NULL) {
+        free(stream);
+        ESP_LOGE(TAG, "Not enough memory for stream ring buffer!");
+        return ESP_ERR_NO_MEM;
+    }
+    stream->mixer = mixer;
+    stream->gain = esp_audio_mixer_gain_q15(config->gain);
+
+    xSemaphoreTake(mixer->streams_lock, portMAX_DELAY);
+    stream->next = mixer->streams;
+    mixer->streams = stream;
+    xSemaphoreGive(mixer->streams_lock);
+
+    *ret_stream = stream;
+    return ESP_OK;
+}
+
+size_t esp_audio_mixer_stream_write(esp_audio_mixer_stream_handle_t stream, const void *data, size_t len, TickType_t timeout)
+{
+    assert(stream && data);
+    const size_t written = xStreamBufferSend(stream->ring, data, len, timeout);
+    if (written > 0) {
+        stream->active = true;
+    }
+    return written;
+}
+
+esp_err_t esp_audio_mixer_stream_set_gain(esp_audio_mixer_stream_handle_t stream, float gain)
+{
+    ESP_RETURN_ON_FALSE(stream, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    stream->gain = esp_audio_mixer_gain_q15(gain);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_mixer_stream_del(esp_audio_mixer_stream_handle_t stream)
+{
+    ESP_RETURN_ON_FALSE(stream, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_audio_mixer_handle_t mixer = stream->mixer;
+
+    /* The mixer task does not use the stream after it */
+    xSemaphoreTake(mixer->streams_lock, portMAX_DELAY);
+    for (struct esp_audio_mixer_stream_s **it = &mixer->streams; *it; it = &(*it)->next) {
+        if (*it == stream) {
+            *it = stream->next;
+            break;
+        }
+    }
+    xSemaphoreGive(mixer->streams_lock);
+
+    vStreamBufferDelete(stream->ring);
+    free(stream);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_mixer_get_stats(esp_audio_mixer_handle_t mixer, esp_audio_mixer_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(mixer && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&mixer->lock);
+    *stats = mixer->stats;
+    if (reset) {
+        memset(&mixer->stats, 0, sizeof(mixer->stats));
+        mixer->stats.frame_us = mixer->frame_us;
+    }
+    portEXIT_CRITICAL(&mixer->lock);
+    stats->latency_us = mixer->frame_us * (1 + mixer->dma_buffers);
+    return ESP_OK;
+}
+
+esp_err_t esp_audio_mixer_del(esp_audio_mixer_handle_t mixer)
+{
+    ESP_RETURN_ON_FALSE(mixer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(mixer->streams == NULL && mixer->sounds == 0, ESP_ERR_INVALID_STATE, TAG, "Sounds or streams are not deleted");
+    esp_audio_mixer_stop(mixer);
+    esp_audio_mixer_free(mixer);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void esp_audio_mixer_free(esp_audio_mixer_handle_t mixer)
+{
+    if (mixer->task) {
+        mixer->exit = true;
+        xTaskNotifyGive(mixer->task);
+        xSemaphoreTake(mixer->idle_sem, portMAX_DELAY);
+    }
+    if (mixer->idle_sem) {
+        vSemaphoreDelete(mixer->idle_sem);
+    }
+    if (mixer->streams_lock) {
+        vSemaphoreDelete(mixer->streams_lock);
+    }
+    heap_caps_free(mixer->mix_buf);
+    heap_caps_free(mixer->stream_buf);
+    free(mixer->voices);
+    free(mixer);
+}
+
+/* acc = saturate(acc + src * gain), gain in Q15 */
+static void esp_audio_mixer_mac(int16_t *acc, const int16_t *src, int16_t gain, size_t len)
+{
+#if CONFIG_IDF_TARGET_ESP32S3
+    /* Whole vectors from aligned buffers, the rest is mixed below */
+    if ((((uintptr_t)acc | (uintptr_t)src) & (AUDIO_MIXER_ALIGN - 1)) == 0) {
+        const size_t simd_len = len - (len % AUDIO_MIXER_VECTOR_SAMPLES);
+        if (simd_len > 0) {
+            esp_audio_mixer_mac_q15_esp32s3(acc, src, gain, simd_len);
+            acc += simd_len;
+            src += simd_len;
+            len -= simd_len;
+        }
+    }
+#endif
+    for (size_t i = 0; i < len; i++) {
+        const int32_t sample = acc[i] + ((src[i] * gain) >> 15);
+        acc[i] = (int16_t)MIN(MAX(sample, INT16_MIN), INT16_MAX);
+    }
+}
+
+static void esp_audio_mixer_mix_voices(esp_audio_mixer_handle_t mixer)
+{
+    for (int i = 0; i < mixer->max_voices; i++) {
+        portENTER_CRITICAL(&mixer->lock);
+        const esp_audio_mixer_voice_t voice = mixer->voices[i];
+        portEXIT_CRITICAL(&mixer->lock);
+        if (voice.sound == NULL) {
+            continue;
+        }
+
+        const size_t len = MIN(mixer->frame_len, voice.sound->len - voice.pos);
+        esp_audio_mixer_mac(mixer->mix_buf, &voice.sound->data[voice.pos], voice.gain, len);
+
+        portENTER_CRITICAL(&mixer->lock);
+        mixer->voices[i].pos += len;
+        if (mixer->voices[i].pos >= voice.sound->len) {
+            voice.sound->voices--;
+            mixer->voices[i].sound = NULL;
+        }
+        portEXIT_CRITICAL(&mixer->lock);
+    }
+}
+
+static void esp_audio_mixer_mix_streams(esp_audio_mixer_handle_t mixer)
+{
+    const size_t frame_size = mixer->frame_len * sizeof(int16_t);
+    const size_t sample_frame = mixer->channels * sizeof(int16_t);
+    uint32_t underruns = 0;
+
+    xSemaphoreTake(mixer->streams_lock, portMAX_DELAY);
+    for (struct esp_audio_mixer_stream_s *stream = mixer->streams; stream; stream = stream->next) {
+        /* Whole samples of all channels only, the channels stay in order */
+        size_t available = MIN(xStreamBufferBytesAvailable(stream->ring), frame_size);
+        available -= available % sample_frame;
+        const size_t len = (available > 0 ? xStreamBufferReceive(stream->ring, mixer->stream_buf, available, 0) : 0);
+        if (len < frame_size && stream->active) {
+            underruns++;
+            /* Stream without samples is paused, until it is written again */
+            if (len == 0) {
+                stream->active = false;
+            }
+        }
+        if (len > 0) {
+            esp_audio_mixer_mac(mixer->mix_buf, mixer->stream_buf, stream->gain, len / sizeof(int16_t));
+        }
+    }
+    xSemaphoreGive(mixer->streams_lock);
+
+    if (underruns) {
+        portENTER_CRITICAL(&mixer->lock);
+        mixer->stats.underruns += underruns;
+        portEXIT_CRITICAL(&mixer->lock);
+    }
+}
+
+static void esp_audio_mixer_task(void *arg)
+{
+    esp_audio_mixer_handle_t mixer = (esp_audio_mixer_handle_t)arg;
+    const size_t frame_size = mixer->frame_len * sizeof(int16_t);
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (mixer->exit) {
+            break;
+        }
+
+        while (mixer->running) {
+            const int64_t mix_start = esp_timer_get_time();
+            memset(mixer->mix_buf, 0, frame_size);
+            esp_audio_mixer_mix_streams(mixer);
+            esp_audio_mixer_mix_voices(mixer);
+            const uint32_t mix_us = (uint32_t)(esp_timer_get_time() - mix_start);
+
+            /* Blocks on I2S DMA, one frame is mixed ahead */
+            esp_codec_dev_write(mixer->codec, mixer->mix_buf, frame_size);
+
+            portENTER_CRITICAL(&mixer->lock);
+            mixer->stats.frames++;
+            mixer->stats.max_mix_us = MAX(mixer->stats.max_mix_us, mix_us);
+            portEXIT_CRITICAL(&mixer->lock);
+        }
+        xSemaphoreGive(mixer->idle_sem);
+    }
+
+    xSemaphoreGive(mixer->idle_sem);
+    vTaskDelete(NULL);
+}
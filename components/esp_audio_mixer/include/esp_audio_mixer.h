@@ -0,0 +1,245 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Audio mixer of PCM sounds and streams into one codec output
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_codec_dev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Audio mixer handle
+ */
+typedef struct esp_audio_mixer_s *esp_audio_mixer_handle_t;
+
+/**
+ * @brief Sound loaded into the mixer (e.g. UI click), it can be played many times at once
+ */
+typedef struct esp_audio_mixer_sound_s *esp_audio_mixer_sound_handle_t;
+
+/**
+ * @brief Stream of PCM samples written by application (e.g. background music from decoder)
+ */
+typedef struct esp_audio_mixer_stream_s *esp_audio_mixer_stream_handle_t;
+
+/**
+ * @brief Configuration of the audio mixer
+ *
+ * The output is 16 bit PCM, all sounds and streams are mixed in this format.
+ */
+typedef struct {
+    esp_codec_dev_handle_t  codec;          /*!< Output codec device (bsp_audio_codec_speaker_init) */
+    uint32_t                sample_rate;    /*!< Output sample rate (0: 16 kHz) */
+    uint8_t                 channels;       /*!< Output channels, 1 or 2 (0: 1) */
+    uint32_t                frame_samples;  /*!< Samples per channel in one mixed frame, it should match I2S DMA frame (0: CONFIG_BSP_I2S_DMA_FRAME_NUM or 240) */
+    uint32_t                dma_buffers;    /*!< Number of I2S DMA buffers, used for latency estimation (0: CONFIG_BSP_I2S_DMA_DESC_NUM or 6) */
+    uint8_t                 max_voices;     /*!< Sounds played at once (0: 4), next plays are rejected */
+    int                     mclk_multiple;  /*!< MCLK multiple of the sample rate (0: default of the codec) */
+    UBaseType_t             task_priority;  /*!< Priority of the mixer task (0: 8), it should be higher than UI tasks */
+} esp_audio_mixer_config_t;
+
+/**
+ * @brief PCM data of a sound
+ */
+typedef struct {
+    const int16_t   *data;          /*!< 16 bit interleaved samples */
+    size_t          samples;        /*!< Samples per channel */
+    uint32_t        sample_rate;    /*!< Sample rate, it is resampled to the mixer rate at load */
+    uint8_t         channels;       /*!< Channels, 1 or 2 (the other count is converted at load) */
+} esp_audio_mixer_pcm_t;
+
+/**
+ * @brief Configuration of a stream
+ */
+typedef struct {
+    size_t          ring_size;      /*!< Size of the ring buffer in bytes (0: 4 frames), it adds latency of the stream only */
+    float           gain;           /*!< Gain of the stream, 0.0 to 1.0 */
+} esp_audio_mixer_stream_config_t;
+
+/**
+ * @brief Mixer statistics
+ */
+typedef struct {
+    uint32_t frames;            /*!< Mixed frames */
+    uint32_t played;            /*!< Played sounds */
+    uint32_t rejected;          /*!< Sounds rejected without free voice */
+    uint32_t underruns;         /*!< Frames of running streams, which were not filled in time */
+    uint32_t max_mix_us;        /*!< Longest mixing of one frame */
+    uint32_t frame_us;          /*!< Duration of one frame */
+    uint32_t latency_us;        /*!< Latency of sounds: one frame and the playback DMA buffers */
+} esp_audio_mixer_stats_t;
+
+/**
+ * @brief Create audio mixer
+ *
+ * @param config     mixer configuration
+ * @param ret_mixer  output mixer handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if configuration is wrong
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_audio_mixer_new(const esp_audio_mixer_config_t *config, esp_audio_mixer_handle_t *ret_mixer);
+
+/**
+ * @brief Open the codec and start mixing
+ *
+ * The codec is fed all the time (with silence when nothing plays), so the latency is fixed.
+ *
+ * @param mixer      mixer handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the mixer is running
+ *      - ESP_FAIL                  if the codec cannot be opened
+ */
+esp_err_t esp_audio_mixer_start(esp_audio_mixer_handle_t mixer);
+
+/**
+ * @brief Stop mixing and close the codec
+ *
+ * @note It waits for the end of the current frame. Playing sounds are stopped.
+ *
+ * @param mixer      mixer handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_audio_mixer_stop(esp_audio_mixer_handle_t mixer);
+
+/**
+ * @brief Load sound
+ *
+ * The sound is converted to the mixer format (sample rate and channels) once, the PCM data can be freed after it.
+ *
+ * @param mixer      mixer handle
+ * @param pcm        PCM data of the sound
+ * @param ret_sound  output sound handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or the format is not supported
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_audio_mixer_sound_load(esp_audio_mixer_handle_t mixer, const esp_audio_mixer_pcm_t *pcm, esp_audio_mixer_sound_handle_t *ret_sound);
+
+/**
+ * @brief Play sound
+ *
+ * The sound is mixed from the next frame. It can be called from any task, it does not wait for the end of the sound.
+ *
+ * @param mixer      mixer handle
+ * @param sound      sound handle
+ * @param gain       gain of this play, 0.0 to 1.0
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NO_MEM            if all voices are playing
+ */
+esp_err_t esp_audio_mixer_sound_play(esp_audio_mixer_handle_t mixer, esp_audio_mixer_sound_handle_t sound, float gain);
+
+/**
+ * @brief Delete sound
+ *
+ * @param mixer      mixer handle
+ * @param sound      sound handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the sound is playing
+ */
+esp_err_t esp_audio_mixer_sound_del(esp_audio_mixer_handle_t mixer, esp_audio_mixer_sound_handle_t sound);
+
+/**
+ * @brief Create stream
+ *
+ * The samples must be in the mixer format (sample rate, channels, 16 bit).
+ *
+ * @param mixer      mixer handle
+ * @param config     stream configuration
+ * @param ret_stream output stream handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_audio_mixer_stream_new(esp_audio_mixer_handle_t mixer, const esp_audio_mixer_stream_config_t *config, esp_audio_mixer_stream_handle_t *ret_stream);
+
+/**
+ * @brief Write samples into stream
+ *
+ * It blocks, while the ring buffer of the stream is full. Missing samples are filled with silence (underrun).
+ *
+ * @param stream     stream handle
+ * @param data       16 bit interleaved samples
+ * @param len        length of data in bytes
+ * @param timeout    maximal time to wait for the ring buffer
+ * @return bytes written into the stream
+ */
+size_t esp_audio_mixer_stream_write(esp_audio_mixer_stream_handle_t stream, const void *data, size_t len, TickType_t timeout);
+
+/**
+ * @brief Set gain of stream
+ *
+ * @param stream     stream handle
+ * @param gain       gain of the stream, 0.0 to 1.0
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_audio_mixer_stream_set_gain(esp_audio_mixer_stream_handle_t stream, float gain);
+
+/**
+ * @brief Delete stream
+ *
+ * @note It must not be called, while another task writes into the stream.
+ *
+ * @param stream     stream handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_audio_mixer_stream_del(esp_audio_mixer_stream_handle_t stream);
+
+/**
+ * @brief Get mixer statistics
+ *
+ * @param mixer      mixer handle
+ * @param stats      output statistics
+ * @param reset      reset the counters after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_audio_mixer_get_stats(esp_audio_mixer_handle_t mixer, esp_audio_mixer_stats_t *stats, bool reset);
+
+/**
+ * @brief Delete audio mixer
+ *
+ * @note The mixer is stopped. The codec device is not deleted. Sounds and streams must be deleted before.
+ *
+ * @param mixer      mixer handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if some streams are not deleted
+ */
+esp_err_t esp_audio_mixer_del(esp_audio_mixer_handle_t mixer);
+
+#ifdef __cplusplus
+}
+#endif
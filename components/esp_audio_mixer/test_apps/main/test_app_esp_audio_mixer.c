@@ -0,0 +1,222 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_audio_mixer.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+/* Mono frames of whole vectors, so the vector kernel is used on ESP32-S3 */
+#define TEST_FRAME_SAMPLES  (64)
+#define TEST_RECORD_FRAMES  (8)
+#define TEST_RECORD_LEN     (TEST_FRAME_SAMPLES * TEST_RECORD_FRAMES)
+/* Sounds end inside a frame, the rest is mixed without vectors */
+#define TEST_SOUND_LEN      (TEST_FRAME_SAMPLES + 36)
+
+/*
+ * Fake codec device: -Wl,--wrap replaces the codec functions called by the mixer.
+ * First frames after the open are recorded, one write takes one tick like the I2S DMA.
+ */
+static int test_codec;
+static int16_t test_record[TEST_RECORD_LEN];
+static volatile size_t test_record_pos;
+static volatile uint32_t test_codec_closes;
+
+int __wrap_esp_codec_dev_open(esp_codec_dev_handle_t codec, esp_codec_dev_sample_info_t *fs)
+{
+    assert(codec == (esp_codec_dev_handle_t)&test_codec && fs->bits_per_sample == 16 && fs->channel == 1);
+    test_record_pos = 0;
+    return ESP_CODEC_DEV_OK;
+}
+
+int __wrap_esp_codec_dev_write(esp_codec_dev_handle_t codec, void *data, int len)
+{
+    const size_t samples = MIN(len / sizeof(int16_t), TEST_RECORD_LEN - test_record_pos);
+    memcpy(&test_record[test_record_pos], data, samples * sizeof(int16_t));
+    test_record_pos += samples;
+    vTaskDelay(1);
+    return ESP_CODEC_DEV_OK;
+}
+
+int __wrap_esp_codec_dev_close(esp_codec_dev_handle_t codec)
+{
+    test_codec_closes++;
+    return ESP_CODEC_DEV_OK;
+}
+
+static void test_mixer_new(uint8_t max_voices, esp_audio_mixer_handle_t *mixer)
+{
+    const esp_audio_mixer_config_t cfg = {
+        .codec = (esp_codec_dev_handle_t)&test_codec,
+        .sample_rate = 16000,
+        .channels = 1,
+        .frame_samples = TEST_FRAME_SAMPLES,
+        .max_voices = max_voices,
+    };
+    test_codec_closes = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_new(&cfg, mixer));
+}
+
+/* Sound of one sample value in the mixer format */
+static void test_sound_load(esp_audio_mixer_handle_t mixer, int16_t value, size_t samples, esp_audio_mixer_sound_handle_t *sound)
+{
+    int16_t *data = malloc(samples * sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(data);
+    for (size_t i = 0; i < samples; i++) {
+        data[i] = value;
+    }
+    const esp_audio_mixer_pcm_t pcm = {
+        .data = data,
+        .samples = samples,
+        .sample_rate = 16000,
+        .channels = 1,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_load(mixer, &pcm, sound));
+    /* Converted copy is kept by the mixer */
+    free(data);
+}
+
+/* Plays and streams queued before the start are mixed from the first frame */
+static void test_record_frames(esp_audio_mixer_handle_t mixer)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_start(mixer));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_audio_mixer_start(mixer));
+    for (int i = 0; i < 100 && test_record_pos < TEST_RECORD_LEN; i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_stop(mixer));
+    TEST_ASSERT_EQUAL(TEST_RECORD_LEN, test_record_pos);
+}
+
+static void test_check_record(size_t from, size_t to, int16_t expected)
+{
+    for (size_t i = from; i < to; i++) {
+        /* Q15 products are rounded down, up to 1 per mixed voice or stream */
+        TEST_ASSERT_INT_WITHIN(4, expected, test_record[i]);
+    }
+}
+
+TEST_CASE("Mixer saturates the sum of voices", "[audio_mixer]")
+{
+    esp_audio_mixer_handle_t mixer;
+    esp_audio_mixer_sound_handle_t loud, quiet, negative;
+    test_mixer_new(4, &mixer);
+    test_sound_load(mixer, 30000, TEST_SOUND_LEN, &loud);
+    test_sound_load(mixer, 1000, TEST_SOUND_LEN / 2, &quiet);
+    test_sound_load(mixer, -30000, TEST_SOUND_LEN * 2, &negative);
+
+    /* Voice added to the saturated sum does not wrap around */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_play(mixer, loud, 1.0f));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_play(mixer, loud, 1.0f));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_play(mixer, quiet, 1.0f));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_audio_mixer_sound_del(mixer, loud));
+    test_record_frames(mixer);
+
+    for (size_t i = 0; i < TEST_SOUND_LEN; i++) {
+        TEST_ASSERT_EQUAL(INT16_MAX, test_record[i]);
+    }
+    test_check_record(TEST_SOUND_LEN, TEST_RECORD_LEN, 0);
+
+    /* Negative overflow */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_play(mixer, negative, 1.0f));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_play(mixer, negative, 1.0f));
+    test_record_frames(mixer);
+
+    for (size_t i = 0; i < TEST_SOUND_LEN * 2; i++) {
+        TEST_ASSERT_EQUAL(INT16_MIN, test_record[i]);
+    }
+    test_check_record(TEST_SOUND_LEN * 2, TEST_RECORD_LEN, 0);
+    TEST_ASSERT_EQUAL(2, test_codec_closes);
+
+    esp_audio_mixer_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_get_stats(mixer, &stats, true));
+    TEST_ASSERT_EQUAL(5, stats.played);
+    TEST_ASSERT_EQUAL(0, stats.rejected);
+    TEST_ASSERT_GREATER_OR_EQUAL(TEST_RECORD_FRAMES * 2, stats.frames);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_del(mixer, loud));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_del(mixer, quiet));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_del(mixer, negative));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_del(mixer));
+}
+
+TEST_CASE("Mixer applies gain of plays and streams", "[audio_mixer]")
+{
+    esp_audio_mixer_handle_t mixer;
+    esp_audio_mixer_sound_handle_t half, small;
+    esp_audio_mixer_stream_handle_t stream;
+    int16_t stream_data[TEST_FRAME_SAMPLES * 2];
+    test_mixer_new(3, &mixer);
+    test_sound_load(mixer, 16384, TEST_SOUND_LEN, &half);
+    test_sound_load(mixer, 1000, TEST_SOUND_LEN, &small);
+    const esp_audio_mixer_stream_config_t stream_cfg = {
+        .gain = 0.25f,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_stream_new(mixer, &stream_cfg, &stream));
+
+    /* Gain out of range is limited to 0.0 to 1.0 */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_play(mixer, half, 0.5f));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_play(mixer, small, -1.0f));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_play(mixer, small, 4.0f));
+    /* All voices are playing */
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, esp_audio_mixer_sound_play(mixer, half, 1.0f));
+    for (size_t i = 0; i < TEST_FRAME_SAMPLES * 2; i++) {
+        stream_data[i] = 20000;
+    }
+    TEST_ASSERT_EQUAL(sizeof(stream_data), esp_audio_mixer_stream_write(stream, stream_data, sizeof(stream_data), 0));
+    test_record_frames(mixer);
+
+    /* 16384 * 0.5 + 1000 * 0.0 + 1000 * 1.0 + 20000 * 0.25 */
+    test_check_record(0, TEST_SOUND_LEN, 8192 + 1000 + 5000);
+    test_check_record(TEST_SOUND_LEN, TEST_FRAME_SAMPLES * 2, 5000);
+    test_check_record(TEST_FRAME_SAMPLES * 2, TEST_RECORD_LEN, 0);
+
+    esp_audio_mixer_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_get_stats(mixer, &stats, true));
+    TEST_ASSERT_EQUAL(3, stats.played);
+    TEST_ASSERT_EQUAL(1, stats.rejected);
+    /* Stream is paused after the first frame without samples */
+    TEST_ASSERT_EQUAL(1, stats.underruns);
+    TEST_ASSERT_EQUAL(TEST_FRAME_SAMPLES * 1000000 / 16000, stats.frame_us);
+
+    /* Changed gain of the stream */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_stream_set_gain(stream, 1.0f));
+    TEST_ASSERT_EQUAL(sizeof(stream_data), esp_audio_mixer_stream_write(stream, stream_data, sizeof(stream_data), 0));
+    test_record_frames(mixer);
+    test_check_record(0, TEST_FRAME_SAMPLES * 2, 20000);
+    test_check_record(TEST_FRAME_SAMPLES * 2, TEST_RECORD_LEN, 0);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_audio_mixer_del(mixer));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_stream_del(stream));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_del(mixer, half));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_sound_del(mixer, small));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_audio_mixer_del(mixer));
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (200)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    /* Deleted tasks are freed by the idle task */
+    vTaskDelay(pdMS_TO_TICKS(10));
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
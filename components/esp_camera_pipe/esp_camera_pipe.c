@@ -0,0 +1,458 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_camera_pipe.h"
+
+static const char *TAG = "CAMERA_PIPE";
+
+#define CAMERA_PIPE_OUT_COUNT_DEFAULT   (2)
+#define CAMERA_PIPE_PRIORITY_DEFAULT    (5)
+#define CAMERA_PIPE_STACK_DEFAULT       (3072)
+#define CAMERA_PIPE_CONSUMERS_MAX       (4)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    esp_camera_pipe_frame_t frame;  /* Must be first, consumers get pointer to it */
+    camera_fb_t     *fb;            /* Returned to camera driver on the last release (NULL: output buffer) */
+    uint8_t         *out_buf;       /* Output buffer of the slot (NULL: camera frame buffers are delivered) */
+    int             refs;           /* Consumers holding the frame and the capture task (0: free slot) */
+    int64_t         deliver_us;
+} camera_pipe_slot_t;
+
+struct esp_camera_pipe_consumer_s {
+    esp_camera_pipe_handle_t pipe;
+    esp_camera_pipe_frame_cb_t frame_cb;
+    void            *user_ctx;
+    uint8_t         max_frames;
+    uint8_t         held;           /* Frames held now */
+    esp_camera_pipe_consumer_stats_t stats;
+    uint64_t        hold_sum_us;
+};
+
+struct esp_camera_pipe_s {
+    esp_camera_pipe_rect_t crop;
+    uint16_t        out_width;
+    uint16_t        out_height;
+    size_t          bpp;            /* Bytes per pixel of converted formats */
+    bool            convert;        /* Crop or scale into output buffers */
+    camera_pipe_slot_t *slots;
+    uint8_t         slot_num;
+    struct esp_camera_pipe_consumer_s *consumers[CAMERA_PIPE_CONSUMERS_MAX];
+    uint8_t         consumer_num;
+    uint32_t        seq;
+    TaskHandle_t    task;
+    SemaphoreHandle_t idle_sem;     /* Given, when the capture task stops */
+    volatile bool   running;
+    volatile bool   exit;
+    bool            camera_init;
+    /* Frame slots and statistics */
+    portMUX_TYPE    lock;
+    esp_camera_pipe_stats_t stats;
+    uint64_t        capture_sum_us;
+    uint64_t        convert_sum_us;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void esp_camera_pipe_task(void *arg);
+static void esp_camera_pipe_free(esp_camera_pipe_handle_t pipe);
+static void esp_camera_pipe_unref(esp_camera_pipe_handle_t pipe, camera_pipe_slot_t *slot);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_camera_pipe_new(const esp_camera_pipe_config_t *config, esp_camera_pipe_handle_t *ret_pipe)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_pipe && config->camera, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    const camera_config_t *camera = config->camera;
+    const uint16_t frame_width = resolution[camera->frame_size].width;
+    const uint16_t frame_height = resolution[camera->frame_size].height;
+    esp_camera_pipe_rect_t crop = config->crop;
+    if (crop.width == 0 || crop.height == 0) {
+        crop = (esp_camera_pipe_rect_t) {
+            .x = 0, .y = 0, .width = frame_width, .height = frame_height
+        };
+    }
+    ESP_RETURN_ON_FALSE(crop.x + crop.width <= frame_width && crop.y + crop.height <= frame_height, ESP_ERR_INVALID_ARG, TAG, "crop out of the frame");
+
+    esp_camera_pipe_handle_t pipe = calloc(1, sizeof(struct esp_camera_pipe_s));
+    ESP_RETURN_ON_FALSE(pipe, ESP_ERR_NO_MEM, TAG, "Not enough memory for camera pipeline allocation!");
+    pipe->crop = crop;
+    pipe->out_width = (config->out_width ? config->out_width : crop.width);
+    pipe->out_height = (config->out_height ? config->out_height : crop.height);
+    pipe->convert = (crop.width != frame_width || crop.height != frame_height || pipe->out_width != crop.width || pipe->out_height != crop.height);
+    portMUX_INITIALIZE(&pipe->lock);
+
+    camera_config_t camera_cfg = *camera;
+    if (config->fb_count) {
+        camera_cfg.fb_count = config->fb_count;
+    }
+
+    if (pipe->convert) {
+        /* Nearest neighbour needs whole pixels */
+        ESP_GOTO_ON_FALSE(camera->pixel_format == PIXFORMAT_RGB565 || camera->pixel_format == PIXFORMAT_GRAYSCALE, ESP_ERR_NOT_SUPPORTED, err, TAG, "Crop and scale need RGB565 or grayscale");
+        pipe->bpp = (camera->pixel_format == PIXFORMAT_RGB565 ? 2 : 1);
+        pipe->slot_num = (config->out_count ? config->out_count : CAMERA_PIPE_OUT_COUNT_DEFAULT);
+    } else {
+        /* Every camera frame buffer can be delivered at once */
+        pipe->slot_num = camera_cfg.fb_count;
+    }
+    pipe->slots = calloc(pipe->slot_num, sizeof(camera_pipe_slot_t));
+    ESP_GOTO_ON_FALSE(pipe->slots, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for frame slots!");
+    if (pipe->convert) {
+        /* Internal DMA memory is faster to show, PSRAM is used when it does not fit */
+        const size_t out_len = (size_t)pipe->out_width * pipe->out_height * pipe->bpp;
+        for (int i = 0; i < pipe->slot_num; i++) {
+            pipe->slots[i].out_buf = heap_caps_malloc_prefer(out_len, 2, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA, MALLOC_CAP_SPIRAM);
+            ESP_GOTO_ON_FALSE(pipe->slots[i].out_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for output buffers!");
+        }
+    }
+
+    ESP_GOTO_ON_ERROR(esp_camera_init(&camera_cfg), err, TAG, "Camera init failed");
+    pipe->camera_init = true;
+
+    pipe->idle_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(pipe->idle_sem, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for camera pipeline!");
+
+    const UBaseType_t priority = (config->task_priority ? config->task_priority : CAMERA_PIPE_PRIORITY_DEFAULT);
+    const uint32_t stack = (config->task_stack ? config->task_stack : CAMERA_PIPE_STACK_DEFAULT);
+    BaseType_t res = xTaskCreatePinnedToCore(esp_camera_pipe_task, "camera_pipe", stack, pipe, priority, &pipe->task, config->task_core);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create camera pipeline task fail!");
+
+    *ret_pipe = pipe;
+    return ESP_OK;
+
+err:
+    esp_camera_pipe_free(pipe);
+    return ret;
+}
+
+esp_err_t esp_camera_pipe_add_consumer(esp_camera_pipe_handle_t pipe, const esp_camera_pipe_consumer_config_t *config, esp_camera_pipe_consumer_handle_t *ret_consumer)
+{
+    ESP_RETURN_ON_FALSE(pipe && config && config->frame_cb && ret_consumer, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!pipe->running, ESP_ERR_INVALID_STATE, TAG, "Camera pipeline is running");
+    ESP_RETURN_ON_FALSE(pipe->consumer_num < CAMERA_PIPE_CONSUMERS_MAX, ESP_ERR_NO_MEM, TAG, "Too many consumers");
+
+    esp_camera_pipe_consumer_handle_t consumer = calloc(1, sizeof(struct esp_camera_pipe_consumer_s));
+    ESP_RETURN_ON_FALSE(consumer, ESP_ERR_NO_MEM, TAG, "Not enough memory for consumer allocation!");
+    consumer->pipe = pipe;
+    consumer->frame_cb = config->frame_cb;
+    consumer->user_ctx = config->user_ctx;
+    consumer->max_frames = (config->max_frames ? config->max_frames : 1);
+    pipe->consumers[pipe->consumer_num++] = consumer;
+
+    *ret_consumer = consumer;
+    return ESP_OK;
+}
+
+void esp_camera_pipe_release(esp_camera_pipe_consumer_handle_t consumer, const esp_camera_pipe_frame_t *frame)
+{
+    assert(consumer && frame);
+    esp_camera_pipe_handle_t pipe = consumer->pipe;
+    camera_pipe_slot_t *slot = (camera_pipe_slot_t *)frame;
+    const uint32_t hold_us = (uint32_t)(esp_timer_get_time() - slot->deliver_us);
+
+    portENTER_CRITICAL(&pipe->lock);
+    consumer->held--;
+    consumer->hold_sum_us += hold_us;
+    if (hold_us > consumer->stats.max_hold_us) {
+        consumer->stats.max_hold_us = hold_us;
+    }
+    portEXIT_CRITICAL(&pipe->lock);
+
+    esp_camera_pipe_unref(pipe, slot);
+}
+
+esp_err_t esp_camera_pipe_start(esp_camera_pipe_handle_t pipe)
+{
+    ESP_RETURN_ON_FALSE(pipe, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!pipe->running, ESP_ERR_INVALID_STATE, TAG, "Camera pipeline is running");
+
+    pipe->running = true;
+    xTaskNotifyGive(pipe->task);
+    return ESP_OK;
+}
+
+esp_err_t esp_camera_pipe_stop(esp_camera_pipe_handle_t pipe)
+{
+    ESP_RETURN_ON_FALSE(pipe, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!pipe->running) {
+        return ESP_OK;
+    }
+
+    pipe->running = false;
+    xSemaphoreTake(pipe->idle_sem, portMAX_DELAY);
+    return ESP_OK;
+}
+
+esp_err_t esp_camera_pipe_get_stats(esp_camera_pipe_handle_t pipe, esp_camera_pipe_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(pipe && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&pipe->lock);
+    *stats = pipe->stats;
+    if (pipe->stats.frames > 0) {
+        stats->avg_capture_us = (uint32_t)(pipe->capture_sum_us / pipe->stats.frames);
+        stats->avg_convert_us = (uint32_t)(pipe->convert_sum_us / pipe->stats.frames);
+    }
+    if (reset) {
+        memset(&pipe->stats, 0, sizeof(pipe->stats));
+        pipe->capture_sum_us = 0;
+        pipe->convert_sum_us = 0;
+    }
+    portEXIT_CRITICAL(&pipe->lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_camera_pipe_get_consumer_stats(esp_camera_pipe_consumer_handle_t consumer, esp_camera_pipe_consumer_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(consumer && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_camera_pipe_handle_t pipe = consumer->pipe;
+
+    portENTER_CRITICAL(&pipe->lock);
+    *stats = consumer->stats;
+    /* Held frames are not counted in the average */
+    const uint32_t released = consumer->stats.delivered - consumer->held;
+    if (released > 0) {
+        stats->avg_hold_us = (uint32_t)(consumer->hold_sum_us / released);
+    }
+    if (reset) {
+        memset(&consumer->stats, 0, sizeof(consumer->stats));
+        consumer->stats.delivered = consumer->held;
+        consumer->hold_sum_us = 0;
+    }
+    portEXIT_CRITICAL(&pipe->lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_camera_pipe_del(esp_camera_pipe_handle_t pipe)
+{
+    ESP_RETURN_ON_FALSE(pipe, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_camera_pipe_stop(pipe);
+
+    bool held = false;
+    portENTER_CRITICAL(&pipe->lock);
+    for (int i = 0; i < pipe->slot_num; i++) {
+        held |= (pipe->slots[i].refs > 0);
+    }
+    portEXIT_CRITICAL(&pipe->lock);
+    ESP_RETURN_ON_FALSE(!held, ESP_ERR_INVALID_STATE, TAG, "Frames are not released");
+
+    esp_camera_pipe_free(pipe);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void esp_camera_pipe_free(esp_camera_pipe_handle_t pipe)
+{
+    if (pipe->task) {
+        pipe->exit = true;
+        xTaskNotifyGive(pipe->task);
+        xSemaphoreTake(pipe->idle_sem, portMAX_DELAY);
+    }
+    if (pipe->idle_sem) {
+        vSemaphoreDelete(pipe->idle_sem);
+    }
+    if (pipe->camera_init) {
+        esp_camera_deinit();
+    }
+    if (pipe->slots) {
+        for (int i = 0; i < pipe->slot_num; i++) {
+            free(pipe->slots[i].out_buf);
+        }
+        free(pipe->slots);
+    }
+    for (int i = 0; i < pipe->consumer_num; i++) {
+        free(pipe->consumers[i]);
+    }
+    free(pipe);
+}
+
+static void esp_camera_pipe_unref(esp_camera_pipe_handle_t pipe, camera_pipe_slot_t *slot)
+{
+    camera_fb_t *fb = NULL;
+
+    portENTER_CRITICAL(&pipe->lock);
+    if (--slot->refs == 0) {
+        fb = slot->fb;
+        slot->fb = NULL;
+    }
+    portEXIT_CRITICAL(&pipe->lock);
+
+    if (fb) {
+        esp_camera_fb_return(fb);
+    }
+}
+
+/* Crop and nearest neighbour scale in 16.16 fixed point */
+static void esp_camera_pipe_convert(esp_camera_pipe_handle_t pipe, const camera_fb_t *fb, uint8_t *out)
+{
+    const uint32_t step_x = ((uint32_t)pipe->crop.width << 16) / pipe->out_width;
+    const uint32_t step_y = ((uint32_t)pipe->crop.height << 16) / pipe->out_height;
+    const size_t out_stride = (size_t)pipe->out_width * pipe->bpp;
+    uint32_t sy = 0;
+
+    for (int y = 0; y < pipe->out_height; y++, sy += step_y) {
+        const uint8_t *src = fb->buf + ((size_t)(pipe->crop.y + (sy >> 16)) * fb->width + pipe->crop.x) * pipe->bpp;
+        if (step_x == (1 << 16)) {
+            memcpy(out, src, out_stride);
+        } else if (pipe->bpp == 2) {
+            const uint16_t *src16 = (const uint16_t *)src;
+            uint16_t *out16 = (uint16_t *)out;
+            for (uint32_t x = 0, sx = 0; x < pipe->out_width; x++, sx += step_x) {
+                out16[x] = src16[sx >> 16];
+            }
+        } else {
+            for (uint32_t x = 0, sx = 0; x < pipe->out_width; x++, sx += step_x) {
+                out[x] = src[sx >> 16];
+            }
+        }
+        out += out_stride;
+    }
+}
+
+static camera_pipe_slot_t *esp_camera_pipe_get_slot(esp_camera_pipe_handle_t pipe)
+{
+    camera_pipe_slot_t *slot = NULL;
+
+    portENTER_CRITICAL(&pipe->lock);
+    for (int i = 0; i < pipe->slot_num; i++) {
+        if (pipe->slots[i].refs == 0) {
+            slot = &pipe->slots[i];
+            /* Reference of the capture task */
+            slot->refs = 1;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&pipe->lock);
+    return slot;
+}
+
+static void esp_camera_pipe_process(esp_camera_pipe_handle_t pipe, camera_fb_t *fb)
+{
+    struct timeval now_tv;
+    gettimeofday(&now_tv, NULL);
+    const int64_t now = esp_timer_get_time();
+    const int64_t capture_us = ((int64_t)now_tv.tv_sec - fb->timestamp.tv_sec) * 1000000 + (now_tv.tv_usec - fb->timestamp.tv_usec);
+    uint32_t convert_us = 0;
+
+    camera_pipe_slot_t *slot = esp_camera_pipe_get_slot(pipe);
+    /* All output buffers are held, or not complete frame */
+    if (slot == NULL || (pipe->convert && (fb->width < pipe->crop.x + pipe->crop.width || fb->height < pipe->crop.y + pipe->crop.height))) {
+        esp_camera_fb_return(fb);
+        if (slot) {
+            esp_camera_pipe_unref(pipe, slot);
+        }
+        portENTER_CRITICAL(&pipe->lock);
+        pipe->stats.dropped++;
+        portEXIT_CRITICAL(&pipe->lock);
+        return;
+    }
+
+    esp_camera_pipe_frame_t *frame = &slot->frame;
+    frame->format = fb->format;
+    frame->seq = pipe->seq++;
+    frame->timestamp_us = now;
+    if (pipe->convert) {
+        esp_camera_pipe_convert(pipe, fb, slot->out_buf);
+        /* The camera gets its buffer back right away */
+        esp_camera_fb_return(fb);
+        slot->fb = NULL;
+        frame->buf = slot->out_buf;
+        frame->width = pipe->out_width;
+        frame->height = pipe->out_height;
+        frame->len = (size_t)pipe->out_width * pipe->out_height * pipe->bpp;
+        convert_us = (uint32_t)(esp_timer_get_time() - now);
+    } else {
+        slot->fb = fb;
+        frame->buf = fb->buf;
+        frame->width = fb->width;
+        frame->height = fb->height;
+        frame->len = fb->len;
+    }
+
+    portENTER_CRITICAL(&pipe->lock);
+    pipe->stats.frames++;
+    pipe->capture_sum_us += (capture_us > 0 ? capture_us : 0);
+    if (capture_us > pipe->stats.max_capture_us) {
+        pipe->stats.max_capture_us = (uint32_t)capture_us;
+    }
+    pipe->convert_sum_us += convert_us;
+    if (convert_us > pipe->stats.max_convert_us) {
+        pipe->stats.max_convert_us = convert_us;
+    }
+    portEXIT_CRITICAL(&pipe->lock);
+
+    slot->deliver_us = esp_timer_get_time();
+    for (int i = 0; i < pipe->consumer_num; i++) {
+        esp_camera_pipe_consumer_handle_t consumer = pipe->consumers[i];
+        bool deliver = false;
+
+        portENTER_CRITICAL(&pipe->lock);
+        if (consumer->held < consumer->max_frames) {
+            consumer->held++;
+            consumer->stats.delivered++;
+            slot->refs++;
+            deliver = true;
+        } else {
+            consumer->stats.skipped++;
+        }
+        portEXIT_CRITICAL(&pipe->lock);
+
+        if (deliver) {
+            consumer->frame_cb(consumer, frame, consumer->user_ctx);
+        }
+    }
+
+    /* Without consumers holding it, the frame is freed here */
+    esp_camera_pipe_unref(pipe, slot);
+}
+
+static void esp_camera_pipe_task(void *arg)
+{
+    esp_camera_pipe_handle_t pipe = (esp_camera_pipe_handle_t)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (pipe->exit) {
+            break;
+        }
+
+        while (pipe->running) {
+            camera_fb_t *fb = esp_camera_fb_get();
+            if (fb == NULL) {
+                ESP_LOGW(TAG, "Get frame failed");
+                continue;
+            }
+            esp_camera_pipe_process(pipe, fb);
+        }
+        xSemaphoreGive(pipe->idle_sem);
+    }
+
+    xSemaphoreGive(pipe->idle_sem);
+    vTaskDelete(NULL);
+}
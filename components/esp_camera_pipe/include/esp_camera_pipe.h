@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Camera capture pipeline
+ *
+ * One capture task gets the camera frames, optionally crops and downscales them and delivers them to all consumers
+ * (e.g. display and ML) without copies. Every consumer holds its frames until it releases them, the frame buffer
+ * is returned to the camera driver after the last release. A consumer, which still holds its maximum of frames,
+ * skips the new ones, so a slow consumer never stops the capture nor the other consumers.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_camera.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Camera pipeline handle
+ */
+typedef struct esp_camera_pipe_s *esp_camera_pipe_handle_t;
+
+/**
+ * @brief Consumer handle
+ */
+typedef struct esp_camera_pipe_consumer_s *esp_camera_pipe_consumer_handle_t;
+
+/**
+ * @brief Frame delivered to consumers (read only)
+ */
+typedef struct {
+    const uint8_t   *buf;           /*!< Pixels (camera frame buffer or scaled output buffer) */
+    size_t          len;            /*!< Length of buf in bytes */
+    uint16_t        width;          /*!< Width in pixels */
+    uint16_t        height;         /*!< Height in pixels */
+    pixformat_t     format;         /*!< Pixel format (same as camera) */
+    uint32_t        seq;            /*!< Sequence number of the captured frame */
+    int64_t         timestamp_us;   /*!< Time of getting the frame from camera driver (esp_timer_get_time) */
+} esp_camera_pipe_frame_t;
+
+/**
+ * @brief Callback with a new frame, called from the capture task
+ *
+ * The consumer owns the frame until it calls esp_camera_pipe_release() (from any task). The callback should not
+ * block, the processing (e.g. ML inference) should run in another task.
+ */
+typedef void (*esp_camera_pipe_frame_cb_t)(esp_camera_pipe_consumer_handle_t consumer, const esp_camera_pipe_frame_t *frame, void *user_ctx);
+
+/**
+ * @brief Rectangle of the camera frame
+ */
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;     /*!< 0: whole frame */
+    uint16_t height;    /*!< 0: whole frame */
+} esp_camera_pipe_rect_t;
+
+/**
+ * @brief Configuration of the camera pipeline
+ */
+typedef struct {
+    const camera_config_t   *camera;        /*!< Camera configuration (e.g. BSP_CAMERA_DEFAULT_CONFIG), esp_camera_init is called by the pipeline */
+    uint8_t                 fb_count;       /*!< Camera frame buffers in the ring (0: camera->fb_count), consumers can hold all but one */
+    esp_camera_pipe_rect_t  crop;           /*!< Part of the camera frame delivered to consumers (RGB565 and grayscale only) */
+    uint16_t                out_width;      /*!< Width of the delivered frames, the crop is scaled to it (0: crop width) */
+    uint16_t                out_height;     /*!< Height of the delivered frames (0: crop height) */
+    uint8_t                 out_count;      /*!< Output buffers of cropped or scaled frames (0: 2) */
+    UBaseType_t             task_priority;  /*!< Priority of the capture task (0: 5) */
+    uint32_t                task_stack;     /*!< Stack of the capture task (0: 3072), the frame callbacks run in it */
+    BaseType_t              task_core;      /*!< Core of the capture task (tskNO_AFFINITY: any) */
+} esp_camera_pipe_config_t;
+
+/**
+ * @brief Configuration of a consumer
+ */
+typedef struct {
+    esp_camera_pipe_frame_cb_t frame_cb;    /*!< Called with every delivered frame */
+    void            *user_ctx;              /*!< Passed to frame_cb */
+    uint8_t         max_frames;             /*!< Frames held by the consumer at once, next frames are skipped (0: 1) */
+} esp_camera_pipe_consumer_config_t;
+
+/**
+ * @brief Statistics of the pipeline
+ */
+typedef struct {
+    uint32_t frames;            /*!< Captured frames */
+    uint32_t dropped;           /*!< Captured frames without a free output buffer */
+    uint32_t avg_capture_us;    /*!< Average time from the frame capture (camera timestamp) to the pipeline */
+    uint32_t max_capture_us;
+    uint32_t avg_convert_us;    /*!< Average time of crop and scale */
+    uint32_t max_convert_us;
+} esp_camera_pipe_stats_t;
+
+/**
+ * @brief Statistics of a consumer
+ */
+typedef struct {
+    uint32_t delivered;         /*!< Delivered frames */
+    uint32_t skipped;           /*!< Frames skipped while the consumer held max_frames */
+    uint32_t avg_hold_us;       /*!< Average time from the delivery to the release (e.g. display latency) */
+    uint32_t max_hold_us;
+} esp_camera_pipe_consumer_stats_t;
+
+#define ESP_CAMERA_PIPE_DEFAULT_CONFIG(camera_cfg)  \
+    {                                           \
+        .camera = (camera_cfg),                 \
+        .fb_count = 3,                          \
+        .crop = {0},                            \
+        .out_width = 0,                         \
+        .out_height = 0,                        \
+        .out_count = 2,                         \
+        .task_priority = 5,                     \
+        .task_stack = 3072,                     \
+        .task_core = (portNUM_PROCESSORS - 1),  \
+    }
+
+/**
+ * @brief Initialize camera and create pipeline
+ *
+ * @param config    pipeline configuration
+ * @param ret_pipe  output pipeline handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or crop is out of the frame
+ *      - ESP_ERR_NOT_SUPPORTED     if crop or scale is used with other pixel format than RGB565 or grayscale
+ *      - ESP_ERR_NO_MEM            if there is no memory
+ *      - error of esp_camera_init
+ */
+esp_err_t esp_camera_pipe_new(const esp_camera_pipe_config_t *config, esp_camera_pipe_handle_t *ret_pipe);
+
+/**
+ * @brief Add consumer of frames
+ *
+ * @note Consumers can be added only while the pipeline is stopped.
+ *
+ * @param pipe          pipeline handle
+ * @param config        consumer configuration
+ * @param ret_consumer  output consumer handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the pipeline is running
+ *      - ESP_ERR_NO_MEM            if there is no memory
+ */
+esp_err_t esp_camera_pipe_add_consumer(esp_camera_pipe_handle_t pipe, const esp_camera_pipe_consumer_config_t *config, esp_camera_pipe_consumer_handle_t *ret_consumer);
+
+/**
+ * @brief Release frame delivered to consumer
+ *
+ * Can be called from any task.
+ *
+ * @param consumer  consumer handle
+ * @param frame     frame from frame_cb
+ */
+void esp_camera_pipe_release(esp_camera_pipe_consumer_handle_t consumer, const esp_camera_pipe_frame_t *frame);
+
+/**
+ * @brief Start capturing
+ *
+ * @param pipe  pipeline handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the pipeline is running
+ */
+esp_err_t esp_camera_pipe_start(esp_camera_pipe_handle_t pipe);
+
+/**
+ * @brief Stop capturing, after the current frame is delivered
+ *
+ * Frames held by consumers stay valid until they are released.
+ *
+ * @param pipe  pipeline handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_camera_pipe_stop(esp_camera_pipe_handle_t pipe);
+
+/**
+ * @brief Get statistics of the pipeline
+ *
+ * @param pipe      pipeline handle
+ * @param stats     output statistics
+ * @param reset     reset the statistics after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_camera_pipe_get_stats(esp_camera_pipe_handle_t pipe, esp_camera_pipe_stats_t *stats, bool reset);
+
+/**
+ * @brief Get statistics of a consumer
+ *
+ * @param consumer  consumer handle
+ * @param stats     output statistics
+ * @param reset     reset the statistics after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_camera_pipe_get_consumer_stats(esp_camera_pipe_consumer_handle_t consumer, esp_camera_pipe_consumer_stats_t *stats, bool reset);
+
+/**
+ * @brief Stop capturing, delete pipeline and deinitialize camera
+ *
+ * @note All frames must be released by consumers before.
+ *
+ * @param pipe  pipeline handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if some frames are not released
+ */
+esp_err_t esp_camera_pipe_del(esp_camera_pipe_handle_t pipe);
+
+#ifdef __cplusplus
+}
+#endif
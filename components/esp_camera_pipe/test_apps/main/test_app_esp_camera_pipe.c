@@ -0,0 +1,338 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <sys/time.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "esp_camera_pipe.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+static const char *TAG = "camera pipe test";
+
+#define TEST_FRAME_SIZE     FRAMESIZE_96X96
+#define TEST_WIDTH          (96)
+#define TEST_HEIGHT         (96)
+#define TEST_FB_MAX         (4)
+#define TEST_FRAME_MS       (5)
+
+/*******************************************************************************
+* Fake camera driver (esp_camera functions are wrapped by the linker)
+*******************************************************************************/
+
+/* Frame functions and consumer callbacks run in the capture task, where Unity asserts cannot be used */
+
+/* Frame buffers of RGB565 pixels, value of each pixel is its index (y * width + x) */
+static struct {
+    camera_fb_t fbs[TEST_FB_MAX];
+    bool out[TEST_FB_MAX];      /* Frame buffer is given to the pipeline */
+    int fb_count;
+    SemaphoreHandle_t free_sem;
+    bool init;
+} test_camera;
+
+esp_err_t __wrap_esp_camera_init(const camera_config_t *config)
+{
+    TEST_ASSERT_EQUAL(PIXFORMAT_RGB565, config->pixel_format);
+    TEST_ASSERT_EQUAL(TEST_FRAME_SIZE, config->frame_size);
+    TEST_ASSERT_LESS_OR_EQUAL(TEST_FB_MAX, config->fb_count);
+
+    test_camera.fb_count = config->fb_count;
+    for (int i = 0; i < test_camera.fb_count; i++) {
+        camera_fb_t *fb = &test_camera.fbs[i];
+        fb->len = TEST_WIDTH * TEST_HEIGHT * sizeof(uint16_t);
+        fb->buf = malloc(fb->len);
+        TEST_ASSERT_NOT_NULL(fb->buf);
+        fb->width = TEST_WIDTH;
+        fb->height = TEST_HEIGHT;
+        fb->format = PIXFORMAT_RGB565;
+        uint16_t *px = (uint16_t *)fb->buf;
+        for (int j = 0; j < TEST_WIDTH * TEST_HEIGHT; j++) {
+            px[j] = j;
+        }
+        test_camera.out[i] = false;
+    }
+    test_camera.free_sem = xSemaphoreCreateCounting(test_camera.fb_count, test_camera.fb_count);
+    TEST_ASSERT_NOT_NULL(test_camera.free_sem);
+    test_camera.init = true;
+    return ESP_OK;
+}
+
+esp_err_t __wrap_esp_camera_deinit(void)
+{
+    for (int i = 0; i < test_camera.fb_count; i++) {
+        TEST_ASSERT_FALSE(test_camera.out[i]);
+        free(test_camera.fbs[i].buf);
+        test_camera.fbs[i].buf = NULL;
+    }
+    vSemaphoreDelete(test_camera.free_sem);
+    test_camera.init = false;
+    return ESP_OK;
+}
+
+camera_fb_t *__wrap_esp_camera_fb_get(void)
+{
+    vTaskDelay(pdMS_TO_TICKS(TEST_FRAME_MS));
+    /* Camera driver waits for a returned frame buffer */
+    if (xSemaphoreTake(test_camera.free_sem, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return NULL;
+    }
+    for (int i = 0; i < test_camera.fb_count; i++) {
+        if (!test_camera.out[i]) {
+            test_camera.out[i] = true;
+            gettimeofday(&test_camera.fbs[i].timestamp, NULL);
+            return &test_camera.fbs[i];
+        }
+    }
+    assert(false && "No free frame buffer");
+    return NULL;
+}
+
+void __wrap_esp_camera_fb_return(camera_fb_t *fb)
+{
+    const int i = fb - test_camera.fbs;
+    assert(i >= 0 && i < test_camera.fb_count && test_camera.out[i]);
+    test_camera.out[i] = false;
+    xSemaphoreGive(test_camera.free_sem);
+}
+
+/* Index of camera frame buffer with the pixels, -1 if it is not a camera frame buffer */
+static int test_camera_fb_index(const uint8_t *buf)
+{
+    for (int i = 0; i < test_camera.fb_count; i++) {
+        if (test_camera.fbs[i].buf == buf) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int test_camera_fbs_out(void)
+{
+    int out = 0;
+    for (int i = 0; i < test_camera.fb_count; i++) {
+        out += test_camera.out[i];
+    }
+    return out;
+}
+
+/*******************************************************************************
+* Consumers
+*******************************************************************************/
+
+/* Releases every frame in the callback */
+typedef struct {
+    uint32_t frames;
+    uint32_t next_seq;
+    bool seq_ok;                /* All frames had consecutive sequence numbers */
+    bool zero_copy;             /* All frames were camera frame buffers */
+} test_fast_t;
+
+static void test_fast_frame_cb(esp_camera_pipe_consumer_handle_t consumer, const esp_camera_pipe_frame_t *frame, void *user_ctx)
+{
+    test_fast_t *fast = user_ctx;
+    if (fast->frames > 0) {
+        fast->seq_ok &= (frame->seq == fast->next_seq);
+    }
+    fast->next_seq = frame->seq + 1;
+    fast->zero_copy &= (test_camera_fb_index(frame->buf) >= 0);
+    fast->frames++;
+    esp_camera_pipe_release(consumer, frame);
+}
+
+/* Holds the frames until the test releases them (e.g. display or ML task) */
+static void test_slow_frame_cb(esp_camera_pipe_consumer_handle_t consumer, const esp_camera_pipe_frame_t *frame, void *user_ctx)
+{
+    QueueHandle_t queue = user_ctx;
+    /* The queue is as long as max_frames */
+    xQueueSend(queue, &frame, 0);
+}
+
+static camera_config_t test_camera_config(void)
+{
+    const camera_config_t camera_cfg = {
+        .pixel_format = PIXFORMAT_RGB565,
+        .frame_size = TEST_FRAME_SIZE,
+        .fb_count = 3,
+    };
+    return camera_cfg;
+}
+
+TEST_CASE("Frames are handed off to all consumers without copy", "[camera_pipe]")
+{
+    const camera_config_t camera_cfg = test_camera_config();
+    const esp_camera_pipe_config_t pipe_cfg = ESP_CAMERA_PIPE_DEFAULT_CONFIG(&camera_cfg);
+    esp_camera_pipe_handle_t pipe = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_new(&pipe_cfg, &pipe));
+    TEST_ASSERT_TRUE(test_camera.init);
+
+    test_fast_t fast = {.seq_ok = true, .zero_copy = true};
+    QueueHandle_t slow_queue = xQueueCreate(2, sizeof(const esp_camera_pipe_frame_t *));
+    TEST_ASSERT_NOT_NULL(slow_queue);
+    esp_camera_pipe_consumer_handle_t fast_consumer = NULL;
+    esp_camera_pipe_consumer_handle_t slow_consumer = NULL;
+    const esp_camera_pipe_consumer_config_t fast_cfg = {
+        .frame_cb = test_fast_frame_cb,
+        .user_ctx = &fast,
+    };
+    const esp_camera_pipe_consumer_config_t slow_cfg = {
+        .frame_cb = test_slow_frame_cb,
+        .user_ctx = slow_queue,
+        .max_frames = 1,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_add_consumer(pipe, &fast_cfg, &fast_consumer));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_add_consumer(pipe, &slow_cfg, &slow_consumer));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_start(pipe));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_camera_pipe_start(pipe));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_camera_pipe_add_consumer(pipe, &fast_cfg, &fast_consumer));
+
+    /* Slow consumer holds one frame, the fast one gets all frames meanwhile */
+    const esp_camera_pipe_frame_t *held = NULL;
+    TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(slow_queue, &held, pdMS_TO_TICKS(100)));
+    vTaskDelay(pdMS_TO_TICKS(TEST_FRAME_MS * 20));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_stop(pipe));
+    ESP_LOGI(TAG, "Fast consumer got %"PRIu32" frames", fast.frames);
+    TEST_ASSERT_GREATER_THAN(10, fast.frames);
+    TEST_ASSERT_TRUE(fast.seq_ok);
+    TEST_ASSERT_TRUE(fast.zero_copy);
+
+    esp_camera_pipe_consumer_stats_t consumer_stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_get_consumer_stats(slow_consumer, &consumer_stats, false));
+    TEST_ASSERT_EQUAL(1, consumer_stats.delivered);
+    TEST_ASSERT_GREATER_THAN(10, consumer_stats.skipped);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_get_consumer_stats(fast_consumer, &consumer_stats, false));
+    TEST_ASSERT_EQUAL(fast.frames, consumer_stats.delivered);
+    TEST_ASSERT_EQUAL(0, consumer_stats.skipped);
+
+    /* The held frame is the camera buffer itself, it is not returned to the camera and not overwritten */
+    const int fb_index = test_camera_fb_index(held->buf);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fb_index);
+    TEST_ASSERT_TRUE(test_camera.out[fb_index]);
+    TEST_ASSERT_EQUAL(1, test_camera_fbs_out());
+    TEST_ASSERT_EQUAL(TEST_WIDTH, held->width);
+    TEST_ASSERT_EQUAL(TEST_HEIGHT, held->height);
+    TEST_ASSERT_EQUAL(TEST_WIDTH * TEST_HEIGHT * 2, held->len);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_camera_pipe_del(pipe));
+
+    /* The last release returns it */
+    esp_camera_pipe_release(slow_consumer, held);
+    TEST_ASSERT_FALSE(test_camera.out[fb_index]);
+    TEST_ASSERT_EQUAL(0, test_camera_fbs_out());
+
+    esp_camera_pipe_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_get_stats(pipe, &stats, true));
+    TEST_ASSERT_EQUAL(fast.frames, stats.frames);
+    TEST_ASSERT_EQUAL(0, stats.dropped);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_get_stats(pipe, &stats, false));
+    TEST_ASSERT_EQUAL(0, stats.frames);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_del(pipe));
+    TEST_ASSERT_FALSE(test_camera.init);
+    vQueueDelete(slow_queue);
+}
+
+TEST_CASE("Cropped and scaled frames release the camera buffer at once", "[camera_pipe]")
+{
+    const camera_config_t camera_cfg = test_camera_config();
+    esp_camera_pipe_config_t pipe_cfg = ESP_CAMERA_PIPE_DEFAULT_CONFIG(&camera_cfg);
+    pipe_cfg.crop = (esp_camera_pipe_rect_t) {
+        .x = 16, .y = 8, .width = 64, .height = 48
+    };
+    pipe_cfg.out_width = 32;
+    pipe_cfg.out_height = 24;
+    pipe_cfg.out_count = 2;
+    esp_camera_pipe_handle_t pipe = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_new(&pipe_cfg, &pipe));
+
+    QueueHandle_t queue = xQueueCreate(2, sizeof(const esp_camera_pipe_frame_t *));
+    TEST_ASSERT_NOT_NULL(queue);
+    esp_camera_pipe_consumer_handle_t consumer = NULL;
+    const esp_camera_pipe_consumer_config_t consumer_cfg = {
+        .frame_cb = test_slow_frame_cb,
+        .user_ctx = queue,
+        .max_frames = 2,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_add_consumer(pipe, &consumer_cfg, &consumer));
+
+    /* The consumer holds both output buffers, next frames are dropped */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_start(pipe));
+    vTaskDelay(pdMS_TO_TICKS(TEST_FRAME_MS * 20));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_stop(pipe));
+    TEST_ASSERT_EQUAL(0, test_camera_fbs_out());
+
+    esp_camera_pipe_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_get_stats(pipe, &stats, false));
+    TEST_ASSERT_EQUAL(2, stats.frames);
+    TEST_ASSERT_GREATER_THAN(0, stats.dropped);
+
+    for (int i = 0; i < 2; i++) {
+        const esp_camera_pipe_frame_t *frame = NULL;
+        TEST_ASSERT_EQUAL(pdTRUE, xQueueReceive(queue, &frame, 0));
+        TEST_ASSERT_EQUAL(-1, test_camera_fb_index(frame->buf));
+        TEST_ASSERT_EQUAL(i, frame->seq);
+        TEST_ASSERT_EQUAL(32, frame->width);
+        TEST_ASSERT_EQUAL(24, frame->height);
+        TEST_ASSERT_EQUAL(32 * 24 * 2, frame->len);
+        TEST_ASSERT_EQUAL(PIXFORMAT_RGB565, frame->format);
+        /* Every second pixel of the crop */
+        const uint16_t *px = (const uint16_t *)frame->buf;
+        for (int y = 0; y < 24; y++) {
+            for (int x = 0; x < 32; x++) {
+                TEST_ASSERT_EQUAL((8 + y * 2) * TEST_WIDTH + 16 + x * 2, px[y * 32 + x]);
+            }
+        }
+        esp_camera_pipe_release(consumer, frame);
+    }
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_camera_pipe_del(pipe));
+    vQueueDelete(queue);
+}
+
+TEST_CASE("Camera pipe checks the configuration", "[camera_pipe]")
+{
+    camera_config_t camera_cfg = test_camera_config();
+    esp_camera_pipe_config_t pipe_cfg = ESP_CAMERA_PIPE_DEFAULT_CONFIG(&camera_cfg);
+    esp_camera_pipe_handle_t pipe = NULL;
+
+    pipe_cfg.crop = (esp_camera_pipe_rect_t) {
+        .x = 64, .y = 0, .width = 64, .height = 48
+    };
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_camera_pipe_new(&pipe_cfg, &pipe));
+
+    /* JPEG cannot be cropped */
+    camera_cfg.pixel_format = PIXFORMAT_JPEG;
+    pipe_cfg.crop.x = 0;
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_camera_pipe_new(&pipe_cfg, &pipe));
+    TEST_ASSERT_FALSE(test_camera.init);
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (200)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    /* Deleted capture task is freed by the idle task */
+    vTaskDelay(pdMS_TO_TICKS(10));
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
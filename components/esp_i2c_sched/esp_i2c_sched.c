@@ -0,0 +1,318 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_i2c_sched.h"
+
+static const char *TAG = "I2C_SCHED";
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct esp_i2c_sched_s {
+    portMUX_TYPE                lock;       /* Lock of the scheduler state and device statistics */
+    esp_i2c_sched_dev_handle_t  owner;      /* Device holding the bus (NULL: bus is free) */
+    esp_i2c_sched_dev_handle_t  wait_head[ESP_I2C_SCHED_PRIO_NUM]; /* Waiting devices of each class (FIFO) */
+    esp_i2c_sched_dev_handle_t  wait_tail[ESP_I2C_SCHED_PRIO_NUM];
+    uint32_t                    devices;    /* Count of added devices */
+};
+
+struct esp_i2c_sched_dev_s {
+    esp_i2c_sched_handle_t      sched;
+    esp_i2c_sched_dev_config_t  config;
+    SemaphoreHandle_t           grant;      /* Given, when the bus is passed to this device */
+    esp_i2c_sched_dev_handle_t  next;       /* Next waiting device of the same class */
+    int64_t                     lock_time;  /* Time of getting the bus */
+    uint32_t                    wait_us;    /* Wait for the bus of the current transaction */
+    /* Statistics */
+    uint32_t                    transactions;
+    uint32_t                    overruns;
+    uint32_t                    timeouts;
+    uint64_t                    total_time_us;
+    uint32_t                    max_time_us;
+    uint64_t                    total_wait_us;
+    uint32_t                    max_wait_us;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void i2c_sched_enqueue(esp_i2c_sched_handle_t sched, esp_i2c_sched_dev_handle_t dev);
+static void i2c_sched_dequeue(esp_i2c_sched_handle_t sched, esp_i2c_sched_dev_handle_t dev);
+static esp_i2c_sched_dev_handle_t i2c_sched_pop_next(esp_i2c_sched_handle_t sched);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_i2c_sched_new(esp_i2c_sched_handle_t *ret_sched)
+{
+    ESP_RETURN_ON_FALSE(ret_sched, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_i2c_sched_handle_t sched = calloc(1, sizeof(struct esp_i2c_sched_s));
+    ESP_RETURN_ON_FALSE(sched, ESP_ERR_NO_MEM, TAG, "Not enough memory for scheduler");
+    portMUX_INITIALIZE(&sched->lock);
+
+    *ret_sched = sched;
+    return ESP_OK;
+}
+
+esp_err_t esp_i2c_sched_del(esp_i2c_sched_handle_t sched)
+{
+    ESP_RETURN_ON_FALSE(sched, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(sched->devices == 0, ESP_ERR_INVALID_STATE, TAG, "Devices must be removed first");
+
+    free(sched);
+    return ESP_OK;
+}
+
+esp_err_t esp_i2c_sched_add_device(esp_i2c_sched_handle_t sched, const esp_i2c_sched_dev_config_t *config, esp_i2c_sched_dev_handle_t *ret_dev)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(sched && config && ret_dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->prio < ESP_I2C_SCHED_PRIO_NUM, ESP_ERR_INVALID_ARG, TAG, "Unknown priority class");
+
+    esp_i2c_sched_dev_handle_t dev = calloc(1, sizeof(struct esp_i2c_sched_dev_s));
+    ESP_RETURN_ON_FALSE(dev, ESP_ERR_NO_MEM, TAG, "Not enough memory for device");
+    dev->sched = sched;
+    dev->config = *config;
+    dev->grant = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(dev->grant, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for device semaphore");
+
+    portENTER_CRITICAL(&sched->lock);
+    sched->devices++;
+    portEXIT_CRITICAL(&sched->lock);
+
+    *ret_dev = dev;
+    return ESP_OK;
+
+err:
+    free(dev);
+    return ret;
+}
+
+esp_err_t esp_i2c_sched_remove_device(esp_i2c_sched_dev_handle_t dev)
+{
+    ESP_RETURN_ON_FALSE(dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_i2c_sched_handle_t sched = dev->sched;
+
+    portENTER_CRITICAL(&sched->lock);
+    const bool locked = (sched->owner == dev);
+    if (!locked) {
+        sched->devices--;
+    }
+    portEXIT_CRITICAL(&sched->lock);
+    ESP_RETURN_ON_FALSE(!locked, ESP_ERR_INVALID_STATE, TAG, "Device is locked");
+
+    vSemaphoreDelete(dev->grant);
+    free(dev);
+    return ESP_OK;
+}
+
+esp_err_t esp_i2c_sched_lock(esp_i2c_sched_dev_handle_t dev, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_i2c_sched_handle_t sched = dev->sched;
+    const int64_t start = esp_timer_get_time();
+    bool granted = false;
+
+    portENTER_CRITICAL(&sched->lock);
+    if (sched->owner == NULL) {
+        sched->owner = dev;
+        granted = true;
+    } else {
+        i2c_sched_enqueue(sched, dev);
+    }
+    portEXIT_CRITICAL(&sched->lock);
+
+    if (!granted) {
+        const TickType_t ticks = (timeout_ms < 0 ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms));
+        if (xSemaphoreTake(dev->grant, ticks) != pdTRUE) {
+            portENTER_CRITICAL(&sched->lock);
+            /* The bus can be passed just after the timeout */
+            granted = (sched->owner == dev);
+            if (!granted) {
+                i2c_sched_dequeue(sched, dev);
+                dev->timeouts++;
+            }
+            portEXIT_CRITICAL(&sched->lock);
+
+            if (!granted) {
+                ESP_LOGD(TAG, "%s: bus timeout", dev->config.name ? dev->config.name : "");
+                return ESP_ERR_TIMEOUT;
+            }
+            /* Take the grant given after the owner change */
+            xSemaphoreTake(dev->grant, portMAX_DELAY);
+        }
+    }
+
+    dev->lock_time = esp_timer_get_time();
+    dev->wait_us = (uint32_t)(dev->lock_time - start);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_i2c_sched_unlock(esp_i2c_sched_dev_handle_t dev)
+{
+    ESP_RETURN_ON_FALSE(dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_i2c_sched_handle_t sched = dev->sched;
+    const uint32_t time_us = (uint32_t)(esp_timer_get_time() - dev->lock_time);
+    const bool overrun = (dev->config.budget_us > 0 && time_us > dev->config.budget_us);
+    esp_i2c_sched_dev_handle_t next = NULL;
+
+    portENTER_CRITICAL(&sched->lock);
+    if (sched->owner != dev) {
+        portEXIT_CRITICAL(&sched->lock);
+        ESP_LOGE(TAG, "Device is not locked");
+        return ESP_ERR_INVALID_STATE;
+    }
+    dev->transactions++;
+    dev->overruns += overrun;
+    dev->total_time_us += time_us;
+    dev->max_time_us = (time_us > dev->max_time_us ? time_us : dev->max_time_us);
+    dev->total_wait_us += dev->wait_us;
+    dev->max_wait_us = (dev->wait_us > dev->max_wait_us ? dev->wait_us : dev->max_wait_us);
+    /* Pass the bus to the waiting device of the highest class */
+    next = i2c_sched_pop_next(sched);
+    sched->owner = next;
+    portEXIT_CRITICAL(&sched->lock);
+
+    if (overrun) {
+        ESP_LOGD(TAG, "%s: transaction %"PRIu32" us over budget %"PRIu32" us", dev->config.name ? dev->config.name : "", time_us, dev->config.budget_us);
+    }
+    if (next) {
+        xSemaphoreGive(next->grant);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t esp_i2c_sched_transmit(esp_i2c_sched_dev_handle_t dev, const uint8_t *write_buffer, size_t write_size, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(dev && dev->config.i2c_dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_ERROR(esp_i2c_sched_lock(dev, timeout_ms), TAG, "Bus lock failed");
+
+    esp_err_t ret = i2c_master_transmit(dev->config.i2c_dev, write_buffer, write_size, timeout_ms);
+    esp_i2c_sched_unlock(dev);
+
+    return ret;
+}
+
+esp_err_t esp_i2c_sched_receive(esp_i2c_sched_dev_handle_t dev, uint8_t *read_buffer, size_t read_size, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(dev && dev->config.i2c_dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_ERROR(esp_i2c_sched_lock(dev, timeout_ms), TAG, "Bus lock failed");
+
+    esp_err_t ret = i2c_master_receive(dev->config.i2c_dev, read_buffer, read_size, timeout_ms);
+    esp_i2c_sched_unlock(dev);
+
+    return ret;
+}
+
+esp_err_t esp_i2c_sched_transmit_receive(esp_i2c_sched_dev_handle_t dev, const uint8_t *write_buffer, size_t write_size,
+        uint8_t *read_buffer, size_t read_size, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(dev && dev->config.i2c_dev, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_ERROR(esp_i2c_sched_lock(dev, timeout_ms), TAG, "Bus lock failed");
+
+    esp_err_t ret = i2c_master_transmit_receive(dev->config.i2c_dev, write_buffer, write_size, read_buffer, read_size, timeout_ms);
+    esp_i2c_sched_unlock(dev);
+
+    return ret;
+}
+
+esp_err_t esp_i2c_sched_get_stats(esp_i2c_sched_dev_handle_t dev, esp_i2c_sched_dev_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(dev && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_i2c_sched_handle_t sched = dev->sched;
+
+    portENTER_CRITICAL(&sched->lock);
+    stats->transactions = dev->transactions;
+    stats->overruns = dev->overruns;
+    stats->timeouts = dev->timeouts;
+    stats->avg_time_us = (dev->transactions ? (uint32_t)(dev->total_time_us / dev->transactions) : 0);
+    stats->max_time_us = dev->max_time_us;
+    stats->avg_wait_us = (dev->transactions ? (uint32_t)(dev->total_wait_us / dev->transactions) : 0);
+    stats->max_wait_us = dev->max_wait_us;
+    if (reset) {
+        dev->transactions = 0;
+        dev->overruns = 0;
+        dev->timeouts = 0;
+        dev->total_time_us = 0;
+        dev->max_time_us = 0;
+        dev->total_wait_us = 0;
+        dev->max_wait_us = 0;
+    }
+    portEXIT_CRITICAL(&sched->lock);
+
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void i2c_sched_enqueue(esp_i2c_sched_handle_t sched, esp_i2c_sched_dev_handle_t dev)
+{
+    const esp_i2c_sched_prio_t prio = dev->config.prio;
+
+    dev->next = NULL;
+    if (sched->wait_tail[prio]) {
+        sched->wait_tail[prio]->next = dev;
+    } else {
+        sched->wait_head[prio] = dev;
+    }
+    sched->wait_tail[prio] = dev;
+}
+
+static void i2c_sched_dequeue(esp_i2c_sched_handle_t sched, esp_i2c_sched_dev_handle_t dev)
+{
+    const esp_i2c_sched_prio_t prio = dev->config.prio;
+    esp_i2c_sched_dev_handle_t prev = NULL;
+
+    for (esp_i2c_sched_dev_handle_t it = sched->wait_head[prio]; it != NULL; prev = it, it = it->next) {
+        if (it != dev) {
+            continue;
+        }
+        if (prev) {
+            prev->next = it->next;
+        } else {
+            sched->wait_head[prio] = it->next;
+        }
+        if (sched->wait_tail[prio] == it) {
+            sched->wait_tail[prio] = prev;
+        }
+        break;
+    }
+    dev->next = NULL;
+}
+
+static esp_i2c_sched_dev_handle_t i2c_sched_pop_next(esp_i2c_sched_handle_t sched)
+{
+    for (int prio = ESP_I2C_SCHED_PRIO_NUM - 1; prio >= 0; prio--) {
+        esp_i2c_sched_dev_handle_t dev = sched->wait_head[prio];
+        if (dev) {
+            sched->wait_head[prio] = dev->next;
+            if (sched->wait_head[prio] == NULL) {
+                sched->wait_tail[prio] = NULL;
+            }
+            dev->next = NULL;
+            return dev;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,196 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Priority scheduler of transactions on a shared I2C bus
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "driver/i2c_master.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Scheduler handle (one per I2C bus)
+ */
+typedef struct esp_i2c_sched_s *esp_i2c_sched_handle_t;
+
+/**
+ * @brief Device handle of the scheduler
+ */
+typedef struct esp_i2c_sched_dev_s *esp_i2c_sched_dev_handle_t;
+
+/**
+ * @brief Priority classes, the waiting device of the highest class gets the bus first
+ */
+typedef enum {
+    ESP_I2C_SCHED_PRIO_SENSOR = 0,  /*!< Sensors, IMU, IO expander (lowest) */
+    ESP_I2C_SCHED_PRIO_CODEC,       /*!< Audio codec control */
+    ESP_I2C_SCHED_PRIO_TOUCH,       /*!< Touch controller (highest) */
+    ESP_I2C_SCHED_PRIO_NUM,         /*!< Number of priority classes */
+} esp_i2c_sched_prio_t;
+
+/**
+ * @brief Configuration of one device
+ */
+typedef struct {
+    const char              *name;      /*!< Device name (for logs) */
+    esp_i2c_sched_prio_t    prio;       /*!< Priority class */
+    uint32_t                budget_us;  /*!< Maximal expected bus time of one transaction, longer transactions are counted as overruns (0: no budget) */
+    i2c_master_dev_handle_t i2c_dev;    /*!< I2C device for esp_i2c_sched_transmit/receive (NULL: only esp_i2c_sched_lock is used) */
+} esp_i2c_sched_dev_config_t;
+
+/**
+ * @brief Statistics of one device
+ */
+typedef struct {
+    uint32_t transactions;      /*!< Finished transactions (lock and unlock) */
+    uint32_t overruns;          /*!< Transactions longer than budget_us */
+    uint32_t timeouts;          /*!< Lock timeouts (bus held by other devices) */
+    uint32_t avg_time_us;       /*!< Average bus time of one transaction */
+    uint32_t max_time_us;       /*!< Longest bus time of one transaction */
+    uint32_t avg_wait_us;       /*!< Average wait for the bus */
+    uint32_t max_wait_us;       /*!< Longest wait for the bus */
+} esp_i2c_sched_dev_stats_t;
+
+/**
+ * @brief Create scheduler of one I2C bus
+ *
+ * @param ret_sched output scheduler handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_i2c_sched_new(esp_i2c_sched_handle_t *ret_sched);
+
+/**
+ * @brief Delete scheduler
+ *
+ * @note All devices must be removed before.
+ *
+ * @param sched     scheduler handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if some device was not removed
+ */
+esp_err_t esp_i2c_sched_del(esp_i2c_sched_handle_t sched);
+
+/**
+ * @brief Add device to the scheduler
+ *
+ * @param sched     scheduler handle
+ * @param config    device configuration
+ * @param ret_dev   output device handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or priority is unknown
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_i2c_sched_add_device(esp_i2c_sched_handle_t sched, const esp_i2c_sched_dev_config_t *config, esp_i2c_sched_dev_handle_t *ret_dev);
+
+/**
+ * @brief Remove device from the scheduler
+ *
+ * @param dev       device handle (not locked)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_i2c_sched_remove_device(esp_i2c_sched_dev_handle_t dev);
+
+/**
+ * @brief Get the bus for one transaction of the device
+ *
+ * The bus is given to the waiting device of the highest priority class (in order of waiting within one class),
+ * so one long transaction of a low priority device delays a touch read at most by its own duration.
+ * Drivers, which access the bus by other components (e.g. esp_lcd_panel_io, esp_codec_dev), wrap their calls by lock and unlock.
+ *
+ * @note One device handle must not be locked from more tasks at once. Not callable from ISR.
+ *
+ * @param dev        device handle
+ * @param timeout_ms maximal wait for the bus (-1: wait forever)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_TIMEOUT           if the bus was not free in time
+ */
+esp_err_t esp_i2c_sched_lock(esp_i2c_sched_dev_handle_t dev, int timeout_ms);
+
+/**
+ * @brief Release the bus after the transaction and update device statistics
+ *
+ * @param dev       device handle (locked)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the device is not locked
+ */
+esp_err_t esp_i2c_sched_unlock(esp_i2c_sched_dev_handle_t dev);
+
+/**
+ * @brief Scheduled i2c_master_transmit of the device
+ *
+ * @param dev        device handle (with i2c_dev)
+ * @param write_buffer data to write
+ * @param write_size size of data to write
+ * @param timeout_ms maximal wait for the bus and the transfer (-1: wait forever)
+ * @return
+ *      - ESP_OK on success, otherwise error of esp_i2c_sched_lock or i2c_master_transmit
+ */
+esp_err_t esp_i2c_sched_transmit(esp_i2c_sched_dev_handle_t dev, const uint8_t *write_buffer, size_t write_size, int timeout_ms);
+
+/**
+ * @brief Scheduled i2c_master_receive of the device
+ *
+ * @param dev        device handle (with i2c_dev)
+ * @param read_buffer buffer for read data
+ * @param read_size  size of data to read
+ * @param timeout_ms maximal wait for the bus and the transfer (-1: wait forever)
+ * @return
+ *      - ESP_OK on success, otherwise error of esp_i2c_sched_lock or i2c_master_receive
+ */
+esp_err_t esp_i2c_sched_receive(esp_i2c_sched_dev_handle_t dev, uint8_t *read_buffer, size_t read_size, int timeout_ms);
+
+/**
+ * @brief Scheduled i2c_master_transmit_receive of the device
+ *
+ * @param dev        device handle (with i2c_dev)
+ * @param write_buffer data to write
+ * @param write_size size of data to write
+ * @param read_buffer buffer for read data
+ * @param read_size  size of data to read
+ * @param timeout_ms maximal wait for the bus and the transfer (-1: wait forever)
+ * @return
+ *      - ESP_OK on success, otherwise error of esp_i2c_sched_lock or i2c_master_transmit_receive
+ */
+esp_err_t esp_i2c_sched_transmit_receive(esp_i2c_sched_dev_handle_t dev, const uint8_t *write_buffer, size_t write_size,
+        uint8_t *read_buffer, size_t read_size, int timeout_ms);
+
+/**
+ * @brief Get device statistics
+ *
+ * @param dev       device handle
+ * @param stats     output statistics
+ * @param reset     reset the counters after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_i2c_sched_get_stats(esp_i2c_sched_dev_handle_t dev, esp_i2c_sched_dev_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
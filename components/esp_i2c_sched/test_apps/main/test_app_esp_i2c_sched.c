@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "unity.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_i2c_sched.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#define TEST_WAITERS        (3)
+/* Time for a waiter task to be queued in the scheduler */
+#define TEST_QUEUE_MS       (20)
+
+/* Bus grants in order, written by the waiter tasks while they hold the bus */
+typedef struct {
+    SemaphoreHandle_t done;
+    int order[TEST_WAITERS];
+    volatile int count;
+} test_grants_t;
+
+typedef struct {
+    esp_i2c_sched_dev_handle_t dev;
+    int id;
+    test_grants_t *grants;
+} test_waiter_t;
+
+static void test_waiter_task(void *arg)
+{
+    test_waiter_t *waiter = arg;
+    if (esp_i2c_sched_lock(waiter->dev, -1) == ESP_OK) {
+        waiter->grants->order[waiter->grants->count++] = waiter->id;
+        esp_i2c_sched_unlock(waiter->dev);
+    }
+    xSemaphoreGive(waiter->grants->done);
+    vTaskDelete(NULL);
+}
+
+/* Devices of the classes wait one after another for the bus held by other device, the grants are returned in order */
+static void test_grant_order(const esp_i2c_sched_prio_t prio[TEST_WAITERS], int order[TEST_WAITERS])
+{
+    esp_i2c_sched_handle_t sched = NULL;
+    esp_i2c_sched_dev_handle_t holder = NULL;
+    test_waiter_t waiters[TEST_WAITERS] = {0};
+    test_grants_t grants = {0};
+    grants.done = xSemaphoreCreateCounting(TEST_WAITERS, 0);
+    TEST_ASSERT_NOT_NULL(grants.done);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_new(&sched));
+    const esp_i2c_sched_dev_config_t holder_cfg = {
+        .name = "holder",
+        .prio = ESP_I2C_SCHED_PRIO_SENSOR,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_add_device(sched, &holder_cfg, &holder));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_lock(holder, -1));
+
+    for (int i = 0; i < TEST_WAITERS; i++) {
+        const esp_i2c_sched_dev_config_t cfg = {
+            .name = "waiter",
+            .prio = prio[i],
+        };
+        TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_add_device(sched, &cfg, &waiters[i].dev));
+        waiters[i].id = i;
+        waiters[i].grants = &grants;
+        TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(test_waiter_task, "waiter", 2048, &waiters[i], 5, NULL));
+        vTaskDelay(pdMS_TO_TICKS(TEST_QUEUE_MS));
+    }
+    /* Nobody gets the bus from its holder */
+    TEST_ASSERT_EQUAL(0, grants.count);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_i2c_sched_remove_device(holder));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_unlock(holder));
+    for (int i = 0; i < TEST_WAITERS; i++) {
+        TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(grants.done, pdMS_TO_TICKS(1000)));
+    }
+    TEST_ASSERT_EQUAL(TEST_WAITERS, grants.count);
+    for (int i = 0; i < TEST_WAITERS; i++) {
+        order[i] = grants.order[i];
+    }
+
+    for (int i = 0; i < TEST_WAITERS; i++) {
+        esp_i2c_sched_dev_stats_t stats;
+        TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_get_stats(waiters[i].dev, &stats, false));
+        TEST_ASSERT_EQUAL(1, stats.transactions);
+        TEST_ASSERT_EQUAL(0, stats.timeouts);
+        /* Waiting from the creation of the task until the holder unlock */
+        TEST_ASSERT_GREATER_OR_EQUAL((TEST_WAITERS - i - 1) * TEST_QUEUE_MS * 1000, stats.max_wait_us);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_remove_device(waiters[i].dev));
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_i2c_sched_del(sched));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_remove_device(holder));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_del(sched));
+    vSemaphoreDelete(grants.done);
+}
+
+TEST_CASE("Bus is granted by priority class", "[i2c_sched]")
+{
+    /* Lowest class waits first */
+    const esp_i2c_sched_prio_t prio[TEST_WAITERS] = {ESP_I2C_SCHED_PRIO_SENSOR, ESP_I2C_SCHED_PRIO_CODEC, ESP_I2C_SCHED_PRIO_TOUCH};
+    int order[TEST_WAITERS];
+    test_grant_order(prio, order);
+    TEST_ASSERT_EQUAL(2, order[0]);
+    TEST_ASSERT_EQUAL(1, order[1]);
+    TEST_ASSERT_EQUAL(0, order[2]);
+}
+
+TEST_CASE("Bus is granted in order of waiting within one class", "[i2c_sched]")
+{
+    const esp_i2c_sched_prio_t prio[TEST_WAITERS] = {ESP_I2C_SCHED_PRIO_TOUCH, ESP_I2C_SCHED_PRIO_TOUCH, ESP_I2C_SCHED_PRIO_TOUCH};
+    int order[TEST_WAITERS];
+    test_grant_order(prio, order);
+    TEST_ASSERT_EQUAL(0, order[0]);
+    TEST_ASSERT_EQUAL(1, order[1]);
+    TEST_ASSERT_EQUAL(2, order[2]);
+}
+
+TEST_CASE("Waiting for the bus times out", "[i2c_sched]")
+{
+    esp_i2c_sched_handle_t sched = NULL;
+    esp_i2c_sched_dev_handle_t holder = NULL, touch = NULL, codec = NULL;
+    const esp_i2c_sched_dev_config_t holder_cfg = {
+        .name = "holder",
+        .prio = ESP_I2C_SCHED_PRIO_SENSOR,
+    };
+    const esp_i2c_sched_dev_config_t touch_cfg = {
+        .name = "touch",
+        .prio = ESP_I2C_SCHED_PRIO_TOUCH,
+    };
+    const esp_i2c_sched_dev_config_t codec_cfg = {
+        .name = "codec",
+        .prio = ESP_I2C_SCHED_PRIO_CODEC,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_new(&sched));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_add_device(sched, &holder_cfg, &holder));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_add_device(sched, &touch_cfg, &touch));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_add_device(sched, &codec_cfg, &codec));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_i2c_sched_unlock(touch));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_lock(holder, -1));
+    const int64_t start = esp_timer_get_time();
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, esp_i2c_sched_lock(touch, 50));
+    TEST_ASSERT_GREATER_OR_EQUAL(49 * 1000, esp_timer_get_time() - start);
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, esp_i2c_sched_lock(codec, 0));
+
+    /* Timed out devices are not waiting anymore, the bus is free after the unlock */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_unlock(holder));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_lock(codec, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_i2c_sched_unlock(touch));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_unlock(codec));
+
+    esp_i2c_sched_dev_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_get_stats(touch, &stats, true));
+    TEST_ASSERT_EQUAL(0, stats.transactions);
+    TEST_ASSERT_EQUAL(1, stats.timeouts);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_get_stats(touch, &stats, false));
+    TEST_ASSERT_EQUAL(0, stats.timeouts);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_get_stats(codec, &stats, false));
+    TEST_ASSERT_EQUAL(1, stats.transactions);
+    TEST_ASSERT_EQUAL(1, stats.timeouts);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_remove_device(holder));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_remove_device(touch));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_remove_device(codec));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_i2c_sched_del(sched));
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (200)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    /* Deleted tasks are freed by the idle task */
+    vTaskDelay(pdMS_TO_TICKS(10));
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
@@ -15,6 +15,7 @@
 #include "esp_log.h"
 #include "lvgl.h"
 #include "esp_lvgl_port.h"
+#include "esp_lcd_panel_io_async.h"
 
 #if CONFIG_EXAMPLE_LCD_CONTROLLER_SH1107
 #include "esp_lcd_sh1107.h"
@@ -83,6 +84,11 @@ void app_main(void)
     };
     ESP_ERROR_CHECK(esp_lcd_new_panel_io_i2c(i2c_bus, &io_config, &io_handle));
 
+    // I2C transfers are sent from a task, so LVGL can render next frame meanwhile
+    ESP_LOGI(TAG, "Install async panel IO");
+    const esp_lcd_panel_io_async_config_t async_config = ESP_LCD_PANEL_IO_ASYNC_CONFIG();
+    ESP_ERROR_CHECK(esp_lcd_new_panel_io_async(io_handle, &async_config, &io_handle));
+
     esp_lcd_panel_handle_t panel_handle = NULL;
     esp_lcd_panel_dev_config_t panel_config = {
         .bits_per_pixel = 1,
@@ -12,12 +12,30 @@
 #pragma once
 
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "lvgl.h"
 #include "esp_lvgl_port_disp.h"
 #include "esp_lvgl_port_touch.h"
 #include "esp_lvgl_port_knob.h"
 #include "esp_lvgl_port_button.h"
 #include "esp_lvgl_port_usbhid.h"
+#include "esp_lvgl_port_video.h"
+#include "esp_lvgl_port_fs.h"
+#include "esp_lvgl_port_mem.h"
+#include "esp_lvgl_port_image.h"
+#include "esp_lvgl_port_font.h"
+#include "esp_lvgl_port_layer_cache.h"
+#include "esp_lvgl_port_chart.h"
+#include "esp_lvgl_port_jpeg.h"
+#include "esp_lvgl_port_cimage.h"
+#include "esp_lvgl_port_preload.h"
+#include "esp_lvgl_port_latency.h"
+#include "esp_lvgl_port_trace.h"
+#include "esp_lvgl_port_heatmap.h"
+#include "esp_lvgl_port_quality.h"
+#include "esp_lvgl_port_remote.h"
+#include "esp_lvgl_port_simd.h"
 
 #if LVGL_VERSION_MAJOR == 8
 #include "esp_lvgl_port_compatibility.h"
@@ -36,6 +54,35 @@ typedef enum {
     LVGL_PORT_EVENT_USER    = 99,
 } lvgl_port_event_type_t;
 
+/**
+ * @brief Number of bins in LVGL lock histograms
+ *
+ * Bin i counts durations shorter than 16 us * 4^i, the last bin counts the longer ones
+ * (<16us, <64us, <256us, <1ms, <4ms, <16ms, <65ms, longer).
+ */
+#define LVGL_PORT_LOCK_HIST_BINS    8
+
+/**
+ * @brief LVGL lock statistics
+ */
+typedef struct {
+    uint32_t locks;                                 /*!< Number of the outermost lock takes */
+    uint32_t contended;                             /*!< Number of lock takes, which had to wait for other task */
+    uint32_t timeouts;                              /*!< Number of lock takes, which timed out */
+    uint32_t wait_hist[LVGL_PORT_LOCK_HIST_BINS];   /*!< Histogram of waiting time for the lock */
+    uint32_t hold_hist[LVGL_PORT_LOCK_HIST_BINS];   /*!< Histogram of holding time of the lock */
+    uint32_t max_wait_us;                           /*!< Maximum waiting time for the lock */
+    uint32_t max_hold_us;                           /*!< Maximum holding time of the lock */
+    TaskHandle_t max_wait_task;                     /*!< Task which waited for the lock for the maximum time */
+    TaskHandle_t max_hold_task;                     /*!< Task which held the lock for the maximum time */
+    TaskHandle_t owner;                             /*!< Task holding the lock now (NULL if not locked) */
+} lvgl_port_lock_stats_t;
+
+/**
+ * @brief Callback executed in LVGL task (see lvgl_port_async_call)
+ */
+typedef void (*lvgl_port_async_cb_t)(void *user_data);
+
 /**
  * @brief LVGL Port task events
  */
@@ -52,7 +99,15 @@ typedef struct {
     int task_stack;         /*!< LVGL task stack size */
     int task_affinity;      /*!< LVGL task pinned to core (-1 is no affinity) */
     int task_max_sleep_ms;  /*!< Maximum sleep in LVGL task */
+    int task_yield_budget_ms; /*!< Maximum time of LVGL task running without sleep, then it sleeps one tick (0 is default 10 ms, LVGL 9 only) */
     int timer_period_ms;    /*!< LVGL timer tick period in ms */
+    int draw_task_affinity; /*!< LVGL draw tasks pinned to core (-1 is no affinity), only for LVGL 9 with esp_lvgl_port OS layer (CONFIG_LV_OS_CUSTOM) */
+    int target_fps;         /*!< Maximum refresh rate of displays (0 is LVGL default LV_DEF_REFR_PERIOD), LVGL 9 only */
+    int idle_fps;           /*!< Refresh and input read rate when the UI is idle (0 is disabled), LVGL 9 only */
+    int idle_timeout_ms;    /*!< Time without invalidation and input events, after which the UI is idle (0 is default 3000 ms) */
+    const lvgl_port_simd_cfg_t *simd; /*!< Selection of assembly blend kernels (NULL: all used), only for LVGL 9.1 with CONFIG_LV_DRAW_SW_ASM_CUSTOM or LVGL 8 with CONFIG_LVGL_PORT_LVGL8_SIMD */
+    int image_cache_size;   /*!< Size of decoded image cache in bytes, least recently used images are evicted (0 is LVGL default LV_CACHE_DEF_SIZE, -1 is 1/8 of PSRAM), LVGL 9.1 and newer */
+    int glyph_cache_size;   /*!< Size of glyph bitmap cache of fonts added by lvgl_port_font_cache_add() in bytes (0 is 64 kB, -1 is 1/16 of PSRAM), LVGL 9.2 and newer */
 } lvgl_port_cfg_t;
 
 /**
@@ -66,6 +121,7 @@ typedef struct {
         .task_affinity = -1,      \
         .task_max_sleep_ms = 500, \
         .timer_period_ms = 5,     \
+        .draw_task_affinity = -1, \
     }
 
 /**
@@ -121,6 +177,7 @@ void lvgl_port_flush_ready(lv_display_t *disp);
 /**
  * @brief Stop lvgl timer
  *
+ * @note In tickless mode (CONFIG_LVGL_PORT_TICKLESS), only LVGL timers are paused
  *
  * @return
  *      - ESP_OK on success
@@ -131,6 +188,7 @@ esp_err_t lvgl_port_stop(void);
 /**
  * @brief Resume lvgl timer
  *
+ * @note In tickless mode (CONFIG_LVGL_PORT_TICKLESS), only LVGL timers are resumed
  *
  * @return
  *      - ESP_OK on success
@@ -148,10 +206,44 @@ esp_err_t lvgl_port_resume(void);
  * @return
  *      - ESP_OK on success
  *      - ESP_ERR_NOT_SUPPORTED if it is not implemented
- *      - ESP_ERR_INVALID_STATE if queue is not initialized (can be returned after LVGL deinit)
+ *      - ESP_ERR_INVALID_STATE if LVGL task is not running (can be returned after LVGL deinit)
  */
 esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param);
 
+/**
+ * @brief Execute callback in LVGL task with LVGL lock taken
+ *
+ * The callback is queued and the caller does not wait for the LVGL lock. Queued callbacks are executed in order,
+ * before the next LVGL timer handling. It can be called from ISR.
+ *
+ * @note Queue length is set by CONFIG_LVGL_PORT_ASYNC_QUEUE_LEN
+ *
+ * @param cb        callback executed in LVGL task
+ * @param user_data parameter of the callback
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if callback is NULL
+ *      - ESP_ERR_NO_MEM if the queue is full
+ *      - ESP_ERR_NOT_SUPPORTED if it is not implemented
+ *      - ESP_ERR_INVALID_STATE if LVGL task is not running
+ */
+esp_err_t lvgl_port_async_call(lvgl_port_async_cb_t cb, void *user_data);
+
+/**
+ * @brief Get LVGL lock statistics
+ *
+ * @note Statistics are collected only with CONFIG_LVGL_PORT_ENABLE_LOCK_STATS
+ *
+ * @param stats     output statistics
+ * @param reset     reset statistics after read
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ *      - ESP_ERR_NOT_SUPPORTED if statistics are disabled or not implemented
+ *      - ESP_ERR_INVALID_STATE if LVGL port is not initialized
+ */
+esp_err_t lvgl_port_get_lock_stats(lvgl_port_lock_stats_t *stats, bool reset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,175 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port chart with ring buffer series and incremental rendering (LVGL 9.1 and newer)
+ *
+ * Unlike lv_chart, added points do not shift the series arrays and do not redraw all lines. The plot is kept
+ * in a pixel buffer (RGB565) used as a ring of columns, every added point renders only its own column into it.
+ * Only the strip of the new column (sweep mode) is invalidated, or the plot is drawn by two copies of the ring
+ * buffer (scroll mode), so plots of fast sensors (e.g. IMU at 100 Hz) do not load the CPU by redrawing.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+
+/**
+ * @brief Maximal count of series in one chart
+ */
+#define LVGL_PORT_CHART_SERIES_MAX      (4)
+
+/**
+ * @brief Value of a missing point (gap in the line)
+ */
+#define LVGL_PORT_CHART_POINT_NONE      (INT32_MAX)
+
+/**
+ * @brief Handle of chart
+ */
+typedef struct lvgl_port_chart_s *lvgl_port_chart_handle_t;
+
+/**
+ * @brief Movement of the plot, when a point is added
+ */
+typedef enum {
+    LVGL_PORT_CHART_MODE_SWEEP = 0,     /*!< New point overwrites the oldest one at the cursor moving to the right (oscilloscope),
+                                             only the strip of the cursor is redrawn */
+    LVGL_PORT_CHART_MODE_SCROLL,        /*!< New point is on the right edge and the older ones move to the left,
+                                             whole plot is redrawn by a copy of the buffer */
+} lvgl_port_chart_mode_t;
+
+/**
+ * @brief Configuration of chart
+ */
+typedef struct {
+    lv_obj_t                *parent;        /*!< Parent of the chart object */
+    lvgl_port_chart_mode_t  mode;           /*!< Movement of the plot */
+    uint16_t                point_num;      /*!< Count of points of each series (columns of the plot) */
+    uint8_t                 column_w;       /*!< Width of one point in pixels (0 is 1), the chart is point_num * column_w wide */
+    uint16_t                height;         /*!< Height of the chart in pixels */
+    int32_t                 min;            /*!< Value on the bottom edge */
+    int32_t                 max;            /*!< Value on the top edge */
+    uint8_t                 series_num;     /*!< Count of series (up to LVGL_PORT_CHART_SERIES_MAX) */
+    lv_color_t              series_color[LVGL_PORT_CHART_SERIES_MAX];   /*!< Color of the line of each series */
+    uint8_t                 line_width;     /*!< Width of the lines (0 is 1) */
+    lv_color_t              bg_color;       /*!< Background of the plot */
+    lv_color_t              grid_color;     /*!< Color of the horizontal division lines */
+    uint8_t                 hdiv_num;       /*!< Count of horizontal division lines (0: none) */
+    struct {
+        unsigned int buff_spiram: 1;        /*!< Pixel buffer is allocated in PSRAM */
+    } flags;
+} lvgl_port_chart_cfg_t;
+
+/**
+ * @brief Information about chart
+ */
+typedef struct {
+    uint32_t    points;             /*!< Count of added points (one for all series) */
+    uint32_t    renders;            /*!< Count of full renderings of the plot (creation, range change, clear) */
+    size_t      buf_size;           /*!< Size of the pixel buffer in bytes */
+} lvgl_port_chart_info_t;
+
+/**
+ * @brief Create chart
+ *
+ * @note The chart object can be positioned or hidden by LVGL functions (lvgl_port_chart_get_obj),
+ *       it must not be resized. When the chart object is deleted (e.g. with its screen), the chart is deleted too.
+ *
+ * @param[in]  cfg          Configuration
+ * @param[out] ret_handle   Handle of chart
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if an argument is NULL or invalid
+ *      - ESP_ERR_INVALID_STATE  if LVGL lock cannot be taken
+ *      - ESP_ERR_NO_MEM         if memory allocation fails
+ *      - ESP_ERR_NOT_SUPPORTED  if LVGL is older than 9.1
+ */
+esp_err_t lvgl_port_chart_create(const lvgl_port_chart_cfg_t *cfg, lvgl_port_chart_handle_t *ret_handle);
+
+/**
+ * @brief Delete chart with its object
+ *
+ * @param handle    Handle of chart
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if handle is NULL
+ *      - ESP_ERR_INVALID_STATE  if LVGL lock cannot be taken
+ */
+esp_err_t lvgl_port_chart_delete(lvgl_port_chart_handle_t handle);
+
+/**
+ * @brief Add one point to every series
+ *
+ * Only the column of the new point (and the column of the oldest point on the left edge in scroll mode)
+ * is rendered into the pixel buffer. Points added between two refreshes
+ * of the display are drawn together in one refresh.
+ *
+ * @param handle    Handle of chart
+ * @param values    Values of the point, one for each series (LVGL_PORT_CHART_POINT_NONE: missing)
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if handle or values is NULL
+ *      - ESP_ERR_INVALID_STATE  if LVGL lock cannot be taken
+ */
+esp_err_t lvgl_port_chart_add_point(lvgl_port_chart_handle_t handle, const int32_t *values);
+
+/**
+ * @brief Set range of values and render the plot again
+ *
+ * @param handle    Handle of chart
+ * @param min       Value on the bottom edge
+ * @param max       Value on the top edge
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if handle is NULL or min is not less than max
+ *      - ESP_ERR_INVALID_STATE  if LVGL lock cannot be taken
+ */
+esp_err_t lvgl_port_chart_set_range(lvgl_port_chart_handle_t handle, int32_t min, int32_t max);
+
+/**
+ * @brief Remove all points
+ *
+ * @param handle    Handle of chart
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if handle is NULL
+ *      - ESP_ERR_INVALID_STATE  if LVGL lock cannot be taken
+ */
+esp_err_t lvgl_port_chart_clear(lvgl_port_chart_handle_t handle);
+
+/**
+ * @brief Get chart object
+ *
+ * @param handle    Handle of chart
+ * @return Chart object (e.g. for alignment or hiding)
+ */
+lv_obj_t *lvgl_port_chart_get_obj(lvgl_port_chart_handle_t handle);
+
+/**
+ * @brief Get information about chart
+ *
+ * @param[in]  handle   Handle of chart
+ * @param[out] info     Output information
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if handle or info is NULL
+ */
+esp_err_t lvgl_port_chart_get_info(lvgl_port_chart_handle_t handle, lvgl_port_chart_info_t *info);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
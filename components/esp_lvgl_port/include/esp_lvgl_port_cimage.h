@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port image decoder of RLE/LZ4 compressed C array images (LVGL 9.2 and newer)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Statistics of compressed image decoder
+ */
+typedef struct {
+    uint32_t bands;             /*!< Decoded bands of rows */
+    uint32_t errors;            /*!< Corrupted bands */
+    uint64_t read_bytes;        /*!< Compressed bytes read from the images (flash) */
+    uint64_t decoded_bytes;     /*!< Decoded bytes of pixels */
+    uint32_t avg_band_us;       /*!< Average time of decoding of one band in microseconds */
+} lvgl_port_cimage_stats_t;
+
+/**
+ * @brief Register LVGL image decoder of compressed C array images
+ *
+ * The images are generated by lvgl_port_create_c_image_compressed() in CMake (tools/image_compress.py).
+ * Rows of the image are compressed (RLE or LZ4) in independent bands, only the bands of the drawn area
+ * are decoded straight into a band sized draw buffer and drawn, so the whole image is never
+ * decompressed into RAM and less data is read from flash than with raw pixels.
+ * Runs of repeated pixels are expanded by 128-bit vector stores on ESP32-S3.
+ *
+ * @note It must be called after lvgl_port_init() with LVGL lock (lvgl_port_lock()).
+ *       Images up to CONFIG_LVGL_PORT_CIMAGE_CACHE_MAX_KB are decoded whole into LVGL image cache
+ *       (see image_cache_size in lvgl_port_cfg_t), it is needed for rotated or scaled images.
+ *
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_STATE  if the decoder is already registered
+ *      - ESP_ERR_NO_MEM         if memory allocation fails
+ *      - ESP_ERR_NOT_SUPPORTED  if LVGL is older than 9.2
+ */
+esp_err_t lvgl_port_cimage_decoder_init(void);
+
+/**
+ * @brief Unregister compressed image decoder
+ *
+ * @note It must be called with LVGL lock. All images are dropped from LVGL image cache.
+ *
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_STATE  if the decoder is not registered
+ *      - ESP_ERR_NOT_SUPPORTED  if LVGL is older than 9.2
+ */
+esp_err_t lvgl_port_cimage_decoder_deinit(void);
+
+/**
+ * @brief Get statistics of compressed image decoder
+ *
+ * @param[out] stats    Output statistics
+ * @param      reset    Reset the statistics after reading
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if stats is NULL
+ *      - ESP_ERR_NOT_SUPPORTED  if LVGL is older than 9.2
+ */
+esp_err_t lvgl_port_cimage_decoder_get_stats(lvgl_port_cimage_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -33,6 +33,33 @@ typedef struct {
     bool mirror_y; /*!< LCD Screen mirrored Y (in esp_lcd driver) */
 } lvgl_port_rotation_cfg_t;
 
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Memory of display provided by the application (static allocation)
+ *
+ * Sizes of the buffers are returned by lvgl_port_disp_get_static_size(). They can be placed by the linker
+ * (e.g. DMA_ATTR or EXT_RAM_BSS_ATTR arrays), the port never frees them.
+ */
+typedef struct {
+    void *ctx;              /*!< Display context (ctx_size bytes, 4-byte aligned, internal RAM with CONFIG_LVGL_PORT_CACHE_SAFE) */
+    void *buf1;             /*!< First draw buffer (buf_size bytes, DMA capable with buff_dma, not used with avoid_tearing) */
+    void *buf2;             /*!< Second draw buffer (buf_size bytes, only with double_buffer, not used with avoid_tearing) */
+    void *rotate_buf;       /*!< Rotation buffer (rotate_buf_size bytes, only with sw_rotate, DMA capable and aligned to `align` for PPA) */
+    void *oled_buf;         /*!< Buffer of I1 monochrome pages (oled_buf_size bytes, only with monochrome in I1) */
+} lvgl_port_disp_static_mem_t;
+
+/**
+ * @brief Sizes of the memory of display (lvgl_port_disp_get_static_size)
+ */
+typedef struct {
+    size_t ctx_size;        /*!< Size of the display context */
+    size_t buf_size;        /*!< Size of each draw buffer */
+    size_t rotate_buf_size; /*!< Size of the rotation buffer (0: not used) */
+    size_t oled_buf_size;   /*!< Size of the I1 monochrome buffer (0: not used) */
+    size_t align;           /*!< Alignment of the rotation buffer */
+} lvgl_port_disp_static_size_t;
+#endif
+
 /**
  * @brief Configuration display structure
  */
@@ -53,6 +80,10 @@ typedef struct {
     lvgl_port_rotation_cfg_t rotation;      /*!< Default values of the screen rotation (Only HW state. Not supported for default SW rotation!) */
 #if LVGL_VERSION_MAJOR >= 9
     lv_color_format_t        color_format;  /*!< The color format of the display */
+    lv_color_format_t        panel_color_format; /*!< Color format sent to the LCD, when it differs from color_format (0: same as color_format). Only RGB565 or RGB888 (3 bytes per pixel, 18/24-bit COLMOD) from RGB888/XRGB8888/ARGB8888 and RGB565 from L8 (palette), converted with swap_bytes in two DMA buffers (trans_size pixels each, only with lvgl_port_add_disp) */
+    uint32_t                 refresh_period_ms; /*!< Refresh period of this display (0 is LVGL default LV_DEF_REFR_PERIOD), it is not faster than target_fps */
+    int                      te_gpio_num;   /*!< GPIO connected to tearing effect (TE) output of LCD controller (only with te_sync) */
+    const lvgl_port_disp_static_mem_t *static_mem; /*!< Context and buffers provided by the application, nothing is allocated for them (NULL: allocated by the port) */
 #endif
     struct {
         unsigned int buff_dma: 1;    /*!< Allocated LVGL buffer will be DMA capable */
@@ -60,6 +91,12 @@ typedef struct {
         unsigned int sw_rotate: 1;   /*!< Use software rotation (slower) or PPA if available */
 #if LVGL_VERSION_MAJOR >= 9
         unsigned int swap_bytes: 1;  /*!< Swap bytes in RGB656 (16-bit) color format before send to LCD driver */
+        unsigned int sw_rotate_stripes: 1; /*!< Rotate in stripes into two buffers (trans_size pixels each), overlapping the rotation with the LCD transfer (only with sw_rotate and lvgl_port_add_disp) */
+        unsigned int sw_rotate_tiled: 1; /*!< Use cache friendly tiled rotation kernel instead of LVGL rotation (faster with buffers in PSRAM, only with sw_rotate) */
+        unsigned int coalesce_flush: 1; /*!< Merge vertically adjacent flushed areas with the same x-span into one LCD window transfer, the areas are copied into two buffers (trans_size pixels each, only in partial mode with lvgl_port_add_disp) */
+        unsigned int flush_task: 1;  /*!< Transfer the flushed areas to LCD in own task, LVGL task continues with other displays meanwhile (useful for slow I2C displays with double_buffer, only with lvgl_port_add_disp) */
+        unsigned int te_sync: 1;     /*!< Start the flush of each frame on TE edge (te_gpio_num) and pace rendering by TE, limited by target_fps (SPI/I8080 with lvgl_port_add_disp only, TE is turned on by LCD_CMD_TEON) */
+        unsigned int round_mask: 1;  /*!< Round display (hres == vres): invalidated areas are reduced to the visible circle and only visible spans of the flushed rows are transferred (only with lvgl_port_add_disp, not in direct mode) */
 #endif
         unsigned int full_refresh: 1;/*!< 1: Always make the whole screen redrawn */
         unsigned int direct_mode: 1; /*!< 1: Use screen-sized buffers and draw to absolute coordinates */
@@ -73,7 +110,12 @@ typedef struct {
     struct {
         unsigned int bb_mode: 1;        /*!< 1: Use bounce buffer mode */
         unsigned int avoid_tearing: 1;  /*!< 1: Use internal RGB buffers as a LVGL draw buffers to avoid tearing effect, enabling this option requires over two LCD buffers and may reduce the frame rate */
+        unsigned int triple_buffer: 1;  /*!< 1: Use three internal RGB buffers, LVGL renders into the free one while the panel waits for vsync (only with avoid_tearing and full_refresh or direct_mode, requires num_fbs = 3 in RGB panel) */
+        unsigned int frame_skip: 1;     /*!< 1: Drop the oldest not displayed frame when the rendering is faster than the panel, 0: Block until the previous frame is displayed (only with triple_buffer) */
+        unsigned int vsync_pacing: 1;   /*!< 1: Start rendering of the invalidated screen on panel vsync, limited by target_fps (LVGL 9 only) */
+        unsigned int pan: 1;            /*!< 1: Scan out the panel from virtual frame buffer of the port by bounce buffers, hardware scroll pans it on vsync (only with bb_mode in partial mode without rotation, RGB panel must be created with no_fb, LVGL 9 only) */
     } flags;
+    uint32_t virtual_height;            /*!< Lines of the virtual frame buffer with pan, the lines over vertical resolution hold the newly exposed lines until the pan (0: vertical resolution) */
 } lvgl_port_display_rgb_cfg_t;
 
 /**
@@ -82,9 +124,96 @@ typedef struct {
 typedef struct {
     struct {
         unsigned int avoid_tearing: 1;  /*!< 1: Use internal MIPI-DSI buffers as a LVGL draw buffers to avoid tearing effect, enabling this option requires over two LCD buffers and may reduce the frame rate */
+        unsigned int triple_buffer: 1;  /*!< 1: Use three internal MIPI-DSI buffers, LVGL renders into the free one while the panel waits for vsync (only with avoid_tearing and full_refresh or direct_mode, requires num_fbs = 3 in DPI panel) */
+        unsigned int frame_skip: 1;     /*!< 1: Drop the oldest not displayed frame when the rendering is faster than the panel, 0: Block until the previous frame is displayed (only with triple_buffer) */
+        unsigned int vsync_pacing: 1;   /*!< 1: Start rendering of the invalidated screen on panel refresh done, limited by target_fps (LVGL 9 only) */
     } flags;
 } lvgl_port_display_dsi_cfg_t;
 
+/**
+ * @brief Display render statistics counters
+ *
+ * @note With LVGL 8, the rotation is done by LVGL during rendering and the colors are swapped by LV_COLOR_16_SWAP,
+ *       rotate_us, monochrome_us and swap_us stay zero (monochrome pixels are set during rendering).
+ */
+typedef struct {
+    uint32_t frames;            /*!< Count of rendered frames (refreshes of the display) */
+    uint32_t flushes;           /*!< Count of flush callbacks */
+    uint64_t pixels;            /*!< Count of flushed pixels */
+    uint64_t render_us;         /*!< Time of LVGL rendering */
+    uint64_t rotate_us;         /*!< Time of SW/PPA rotation */
+    uint64_t monochrome_us;     /*!< Time of monochrome transform */
+    uint64_t swap_us;           /*!< Time of byte swapping (and conversion to panel_color_format) */
+    uint64_t trans_wait_us;     /*!< Time of waiting for LCD transfer (vsync or free transfer buffer) */
+    uint32_t vsync_waits;       /*!< Count of waits for vsync */
+    uint32_t max_flush_us;      /*!< Maximum duration of one flush callback */
+} lvgl_port_disp_counters_t;
+
+/**
+ * @brief Display render statistics
+ */
+typedef struct {
+    lvgl_port_disp_counters_t total;    /*!< Cumulative counters from display add */
+    lvgl_port_disp_counters_t window;   /*!< Counters of the last finished window (CONFIG_LVGL_PORT_STATS_WINDOW_MS) */
+} lvgl_port_disp_stats_t;
+
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Hardware scroll functions of LCD driver
+ *
+ * Vertical scrolling area of LCD controller (e.g. esp_lcd_ili9341_set_scroll_area and esp_lcd_ili9341_set_scroll_start)
+ * or block copy in its frame memory (e.g. esp_lcd_ra8875_copy_rect).
+ */
+typedef struct {
+    esp_err_t (*set_scroll_area)(esp_lcd_panel_handle_t panel, uint16_t top_fixed, uint16_t scroll_height); /*!< Define vertical scrolling area */
+    esp_err_t (*set_scroll_start)(esp_lcd_panel_handle_t panel, uint16_t line);  /*!< Set the line shown at the top of vertical scrolling area */
+    esp_err_t (*copy_rect)(esp_lcd_panel_handle_t panel, int src_x, int src_y, int dst_x, int dst_y, int width, int height); /*!< Copy block in frame memory, used when set_scroll_area is NULL */
+} lvgl_port_hw_scroll_cfg_t;
+
+/**
+ * @brief Fill of rectangle by LCD controller (e.g. esp_lcd_ra8875_fill_rect), end is exclusive, color is RGB565
+ */
+typedef esp_err_t (*lvgl_port_hw_fill_cb_t)(esp_lcd_panel_handle_t panel, int x_start, int y_start, int x_end, int y_end, uint16_t color);
+
+/**
+ * @brief Mirror panel showing the same content as the display
+ */
+typedef struct {
+    esp_lcd_panel_handle_t panel_handle;    /*!< MIPI-DSI (DPI) panel with one frame buffer, e.g. HDMI output of esp_lcd_lt8912b */
+    uint32_t hres;                          /*!< Horizontal resolution of the mirror panel */
+    uint32_t vres;                          /*!< Vertical resolution of the mirror panel */
+    lv_color_format_t color_format;         /*!< Color format of the mirror frame buffer, RGB565 or RGB888 (0: color format of the display) */
+    lv_display_rotation_t rotation;         /*!< Rotation of the content on the mirror panel (counter-clockwise, same as LVGL) */
+    float scale;                            /*!< Scale of the content, rounded down to 1/16 (0: the largest fitting the mirror panel) */
+} lvgl_port_disp_mirror_cfg_t;
+
+/**
+ * @brief Ambient mode of the display (static screen with stopped LVGL task)
+ */
+typedef struct {
+    esp_err_t (*set_idle_mode)(esp_lcd_panel_handle_t panel, bool enable); /*!< Idle Mode (8 colors) of LCD driver, e.g. esp_lcd_ili9341_set_idle_mode (NULL: not used) */
+    esp_err_t (*set_partial_area)(esp_lcd_panel_handle_t panel, uint16_t start_line, uint16_t lines); /*!< Partial Mode of LCD driver, e.g. esp_lcd_ili9341_set_partial_area (NULL: not used) */
+    lv_obj_t    *screen;            /*!< Screen shown in ambient mode (e.g. clock face) */
+    uint16_t    partial_start;      /*!< First shown line of the panel (in the vertical direction of the frame memory) */
+    uint16_t    partial_lines;      /*!< Shown lines of the panel (0: all lines) */
+    uint32_t    update_period_ms;   /*!< Period of the screen update (0: screen is rendered only once) */
+    void (*update_cb)(lv_obj_t *screen, void *user_ctx); /*!< Called before each rendering of the screen (e.g. to set the time), optional */
+    void        *user_ctx;          /*!< User context of the update callback */
+} lvgl_port_disp_ambient_cfg_t;
+
+/**
+ * @brief New panel and resolution of the display (lvgl_port_disp_reconfigure)
+ */
+typedef struct {
+    esp_lcd_panel_io_handle_t io_handle;    /*!< LCD panel IO handle of the new panel (required for I2C/SPI/I8080 panel) */
+    esp_lcd_panel_handle_t panel_handle;    /*!< New LCD panel handle (NULL: panel is not changed) */
+    esp_lcd_panel_handle_t control_handle;  /*!< LCD panel control handle of the new panel (NULL: panel_handle) */
+    uint32_t    hres;                       /*!< New horizontal resolution */
+    uint32_t    vres;                       /*!< New vertical resolution */
+    uint32_t    buffer_size;                /*!< Size of the draw buffer in pixels in partial mode (0: the same lines as before) */
+} lvgl_port_disp_reconfig_t;
+#endif
+
 /**
  * @brief Add I2C/SPI/I8080 display handling to LVGL
  *
@@ -127,6 +256,204 @@ lv_display_t *lvgl_port_add_disp_rgb(const lvgl_port_display_cfg_t *disp_cfg, co
  */
 esp_err_t lvgl_port_remove_disp(lv_display_t *disp);
 
+/**
+ * @brief Get display render statistics
+ *
+ * @note Statistics are collected only when CONFIG_LVGL_PORT_ENABLE_STATS is enabled.
+ *
+ * @param disp  LVGL display handle
+ * @param stats Output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments
+ *      - ESP_ERR_NOT_SUPPORTED     if statistics are disabled in Kconfig
+ */
+esp_err_t lvgl_port_get_disp_stats(lv_display_t *disp, lvgl_port_disp_stats_t *stats);
+
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Scroll full width LVGL object by hardware scroll of LCD controller
+ *
+ * Vertical scroll of the object moves its lines in LCD controller (vertical scrolling area or block copy), only the newly
+ * exposed lines are redrawn and transferred. Scrollbar of the object is turned off (it would move with the content).
+ *
+ * RGB displays with pan (lvgl_port_display_rgb_cfg_t) are scrolled by the scan-out offset of their virtual frame buffer,
+ * it is changed on vsync after the exposed lines are rendered into the off-screen lines (cfg is not used). Scroll steps up to
+ * the off-screen lines (virtual_height - vertical resolution) are not torn.
+ *
+ * @note Only I2C/SPI/I8080 displays and RGB displays with pan, without rotation (also rotation config without swap_xy and mirror_y),
+ *       SW rotation, flush coalescing, flush task, monochrome, direct mode and full refresh.
+ * @note The object must cover the whole width of the display and keep its position and size. Floating children of the object
+ *       are not supported. Rotating the display turns the hardware scroll off.
+ * @note Call with LVGL lock taken.
+ *
+ * @param disp  LVGL display handle
+ * @param obj   LVGL object scrolled by hardware (NULL: turn off)
+ * @param cfg   Hardware scroll functions of LCD driver (only when obj is set, NULL for RGB display with pan)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments or the object is not full width
+ *      - ESP_ERR_NOT_SUPPORTED     if the display configuration does not allow hardware scroll
+ *      - Otherwise error of LCD driver
+ */
+esp_err_t lvgl_port_disp_set_hw_scroll(lv_display_t *disp, lv_obj_t *obj, const lvgl_port_hw_scroll_cfg_t *cfg);
+
+/**
+ * @brief Fill solid flushed areas by LCD controller instead of transferring their pixels
+ *
+ * Flushed areas are split into bands of rows. Bands of one color with at least min_pixels are filled by LCD controller,
+ * the other rows are sent (the check of each row stops on its first different pixel). Useful for slow interfaces and
+ * LCD controllers with drawing engine (e.g. RA8875), e.g. flat backgrounds above and below widgets are not sent.
+ *
+ * @note Only I2C/SPI/I8080 displays with RGB565 color format, without rotation stripes, flush coalescing and flush task.
+ *
+ * @param disp       LVGL display handle
+ * @param fill_rect  Fill function of LCD driver (NULL: turn off)
+ * @param min_pixels Minimal size of filled area in pixels
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments
+ *      - ESP_ERR_NOT_SUPPORTED     if the display configuration does not allow hardware fill
+ */
+esp_err_t lvgl_port_disp_set_hw_fill(lv_display_t *disp, lvgl_port_hw_fill_cb_t fill_rect, uint32_t min_pixels);
+
+/**
+ * @brief Change color format of the converted areas sent to the LCD
+ *
+ * Switches between RGB565 and packed 24-bit pixels (18-bit or 24-bit COLMOD) in runtime, e.g. 16-bit for
+ * fast animations and 18-bit for smooth gradients. It waits for the end of transfers of converted areas.
+ *
+ * @note Call it with LVGL lock and change the COLMOD of the LCD controller before unlocking
+ *       (e.g. esp_lcd_ili9341_set_bits_per_pixel()). Conversion buffers are not reallocated,
+ *       the areas are sent in more transfers with the bigger pixels.
+ *
+ * @param disp               LVGL display handle
+ * @param panel_color_format LV_COLOR_FORMAT_RGB565 or LV_COLOR_FORMAT_RGB888
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments
+ *      - ESP_ERR_INVALID_SIZE      if one line does not fit in the conversion buffer
+ *      - ESP_ERR_NOT_SUPPORTED     if the display was created without panel_color_format conversion
+ */
+esp_err_t lvgl_port_disp_set_panel_color_format(lv_display_t *disp, lv_color_format_t panel_color_format);
+
+/**
+ * @brief Set colors of L8 values of display rendered in L8 (color_format LV_COLOR_FORMAT_L8)
+ *
+ * L8 areas are expanded to RGB565 through the palette in the flush callback. The default palette is grayscale,
+ * a gradient from black to one color (lv_color_mix()) gives monochrome themed UI in one color.
+ *
+ * @note Call it with LVGL lock. Already shown areas are not redrawn.
+ *
+ * @param disp      LVGL display handle
+ * @param palette   256 colors (NULL is grayscale)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments
+ *      - ESP_ERR_NOT_SUPPORTED     if the display is not rendered in L8
+ */
+esp_err_t lvgl_port_disp_set_l8_palette(lv_display_t *disp, const lv_color_t *palette);
+
+/**
+ * @brief Mirror the display to another panel from the same rendering
+ *
+ * Each flushed area is also scaled, rotated and converted by PPA into the frame buffer of the mirror panel, before it is
+ * flushed to the display. LVGL renders the content once for both panels. The content is centered on the mirror panel,
+ * the rest of it is black. Whole display is invalidated, so the mirror gets all of it.
+ *
+ * @note Only ESP32-P4 (PPA) with MIPI-DSI mirror panel. The mirror frame buffer is written while it is scanned out
+ *       (no avoid tearing). Areas of fractional scales can be one pixel off from each other.
+ * @note Call with LVGL lock taken.
+ *
+ * @param disp  LVGL display handle
+ * @param cfg   Mirror panel (NULL: turn off)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments or the mirror panel has no frame buffer
+ *      - ESP_ERR_NOT_SUPPORTED     if there is no PPA or the color format of the display cannot be converted by it
+ */
+esp_err_t lvgl_port_disp_set_mirror(lv_display_t *disp, const lvgl_port_disp_mirror_cfg_t *cfg);
+
+/**
+ * @brief Get sizes of the memory of display for static_mem of display configuration
+ *
+ * With static_mem, the display context, draw buffers, rotation buffer and I1 monochrome buffer are not allocated
+ * and the semaphore of avoid tearing is static. Features with own buffers or tasks (rotation stripes, panel color
+ * format conversion, flush coalescing, flush task, round mask, TE synchronization and RGB pan) cannot be used with it
+ * and the OLED shadow is not used (whole pages are sent). LVGL objects are allocated by LVGL (a static pool with
+ * LV_USE_BUILTIN_MALLOC).
+ *
+ * @param disp_cfg  Display configuration (as for lvgl_port_add_disp)
+ * @param size      Output sizes
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments
+ */
+esp_err_t lvgl_port_disp_get_static_size(const lvgl_port_display_cfg_t *disp_cfg, lvgl_port_disp_static_size_t *size);
+
+/**
+ * @brief Enter ambient mode: show a static screen with reduced panel power and stop LVGL task
+ *
+ * The screen is loaded and rendered at once, then the panel is switched to Partial Mode and Idle Mode, if the LCD driver
+ * provides them, and LVGL timers are stopped (lvgl_port_stop()). Every update period, the screen is updated by the callback
+ * and only its invalidated areas are rendered; the esp_timer only queues the update to LVGL task, which handles queued
+ * callbacks also when stopped. Input devices are not read in ambient mode.
+ *
+ * @note In Idle Mode, the panel shows only the most significant bit of each color channel, so draw the screen in 8 colors
+ *       (black, white, red, green, blue, cyan, magenta and yellow).
+ * @note Only I2C/SPI/I8080 displays. Call with LVGL lock taken.
+ *
+ * @param disp  LVGL display handle
+ * @param cfg   Ambient mode configuration
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments
+ *      - ESP_ERR_INVALID_STATE     if the display is already in ambient mode
+ *      - ESP_ERR_NOT_SUPPORTED     if the display is not I2C/SPI/I8080
+ *      - ESP_ERR_NO_MEM            if the update timer cannot be created
+ */
+esp_err_t lvgl_port_disp_enter_ambient(lv_display_t *disp, const lvgl_port_disp_ambient_cfg_t *cfg);
+
+/**
+ * @brief Exit ambient mode: restore the panel modes and the previous screen and resume LVGL task
+ *
+ * @note LVGL timers are resumed only if they were stopped by the entry to ambient mode.
+ * @note Call with LVGL lock taken (e.g. from a touch or button wake up handled in a task).
+ *
+ * @param disp  LVGL display handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments
+ *      - ESP_ERR_INVALID_STATE     if the display is not in ambient mode
+ */
+esp_err_t lvgl_port_disp_exit_ambient(lv_display_t *disp);
+
+/**
+ * @brief Change panel and resolution of the display without removing it
+ *
+ * Own draw buffers are reallocated (heap_caps_realloc()) with the memory of the display configuration, RGB displays with
+ * avoid tearing get the frame buffers of the new panel. The resolution of LVGL display is changed, its screens and objects
+ * are kept: their layout is updated and the display is redrawn by the next refresh. Input devices of the display stay
+ * assigned to it (a touch of the new panel is added by lvgl_port_add_touch()).
+ *
+ * @note Call with LVGL lock taken, after the old panel was deleted and the new one was initialized
+ *       (e.g. a panel of another size on the same bus). It waits for the transfer in progress.
+ * @note Only RGB and I2C/SPI/I8080 displays. Display with static memory, monochrome display and the features with buffers
+ *       sized by the resolution (SW rotation, panel color format conversion, flush coalescing, flush task,
+ *       round mask and RGB pan) are not supported. Hardware scroll is turned off.
+ *
+ * @param disp  LVGL display handle
+ * @param cfg   New panel and resolution
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if invalid arguments
+ *      - ESP_ERR_INVALID_STATE     if the display is in ambient mode
+ *      - ESP_ERR_NOT_SUPPORTED     if the display configuration does not allow the change
+ *      - ESP_ERR_NO_MEM            if the draw buffers cannot be reallocated (the previous panel and resolution are kept)
+ */
+esp_err_t lvgl_port_disp_reconfigure(lv_display_t *disp, const lvgl_port_disp_reconfig_t *cfg);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port glyph bitmap cache of scalable fonts (LVGL 9.2 and newer)
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Statistics of glyph bitmap cache
+ */
+typedef struct {
+    uint32_t hits;              /*!< Glyph bitmaps found in the cache */
+    uint32_t misses;            /*!< Glyph bitmaps rendered by the font */
+    uint32_t evictions;         /*!< Least recently used glyph bitmaps dropped */
+    uint32_t uncached;          /*!< Rendered glyph bitmaps, which did not fit into the cache (all glyphs in use or no memory) */
+    uint32_t entries;           /*!< Glyph bitmaps in the cache */
+    size_t   used_size;         /*!< Bytes used by the cache */
+    size_t   max_used_size;     /*!< Maximum bytes used by the cache */
+    size_t   cache_size;        /*!< Size of the cache (glyph_cache_size in lvgl_port_cfg_t) */
+} lvgl_port_font_cache_stats_t;
+
+/**
+ * @brief Create font, which keeps rendered glyph bitmaps of another font in the cache
+ *
+ * @note Scalable fonts (TinyTTF, FreeType) rasterize a glyph each time it is drawn. The returned font
+ *       uses glyph metrics of the source font, but its bitmaps are rendered only once and kept
+ *       in the cache (in PSRAM when available) shared by all cached fonts. The least recently used
+ *       bitmaps are evicted, when the cache is full (see glyph_cache_size in lvgl_port_cfg_t).
+ *       Only bitmap glyphs (A1-A8) are cached, vector and image glyphs are drawn by the source font.
+ *       The source font must be valid until lvgl_port_font_cache_remove(). Its fallback is used also
+ *       by the returned font.
+ *       It must be called after lvgl_port_init() with LVGL lock (lvgl_port_lock()).
+ *
+ * @param[in]  font      Source font (e.g. from lv_tiny_ttf_create_data())
+ * @param[out] ret_font  Cached font to be used in styles instead of the source font
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if font or ret_font is NULL
+ *      - ESP_ERR_NO_MEM         if memory allocation fails
+ *      - ESP_ERR_NOT_SUPPORTED  if LVGL is older than 9.2
+ */
+esp_err_t lvgl_port_font_cache_add(const lv_font_t *font, lv_font_t **ret_font);
+
+/**
+ * @brief Delete cached font and drop its glyph bitmaps from the cache
+ *
+ * @note It must be called with LVGL lock, when the font is not used by any object.
+ *
+ * @param font      Cached font (from lvgl_port_font_cache_add())
+ */
+void lvgl_port_font_cache_remove(lv_font_t *font);
+
+/**
+ * @brief Get statistics of glyph bitmap cache
+ *
+ * @param[out] stats    Output statistics
+ * @param      reset    Reset the counters (hits, misses, evictions, uncached and max_used_size) after reading
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if stats is NULL
+ *      - ESP_ERR_NOT_SUPPORTED  if LVGL is older than 9.2
+ */
+esp_err_t lvgl_port_font_cache_get_stats(lvgl_port_font_cache_stats_t *stats, bool reset);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port file system driver with block cache
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Configuration of LVGL file system driver
+ */
+typedef struct {
+    char        letter;             /*!< LVGL drive letter, e.g. 'S' for "S:/image.png" */
+    const char  *path;              /*!< VFS mount point, e.g. "/sdcard" */
+    size_t      block_size;         /*!< Size of cached block in bytes, file is read in whole blocks (0 is 4096) */
+    uint8_t     block_count;        /*!< Number of cached blocks of each open file (0 is 8) */
+    uint8_t     read_ahead;         /*!< Number of blocks read at once in sequential reading, at most block_count (0 is 4) */
+    struct {
+        unsigned int buff_spiram: 1;    /*!< Cache of open files is allocated in PSRAM */
+    } flags;
+} lvgl_port_fs_cfg_t;
+
+/**
+ * @brief Statistics of LVGL file system driver
+ */
+typedef struct {
+    uint32_t hits;                  /*!< Reads served from the cache */
+    uint32_t misses;                /*!< Reads of blocks from the file system */
+    uint32_t direct;                /*!< Large reads passed to the file system without the cache */
+} lvgl_port_fs_stats_t;
+
+/**
+ * @brief Register read-only LVGL file system driver for a VFS mount point
+ *
+ * Small reads of LVGL image decoders (e.g. PNG chunks, JPEG markers) are served from a block cache of the open file.
+ * In sequential reading, read_ahead blocks are read by one VFS call. Reads of whole blocks bypass the cache.
+ * Files are opened for reading only.
+ *
+ * @note LVGL must be initialized (lvgl_port_init). The driver cannot be unregistered in LVGL,
+ *       calling this function with the same letter again changes its configuration instead.
+ *
+ * @param cfg driver configuration
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if parameter is invalid
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_fs_add(const lvgl_port_fs_cfg_t *cfg);
+
+/**
+ * @brief Disable LVGL file system driver, e.g. before unmounting the file system
+ *
+ * @note Files already open stay usable until closed, they must be closed before unmount.
+ *
+ * @param letter LVGL drive letter
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_FOUND         if the driver was not added
+ */
+esp_err_t lvgl_port_fs_remove(char letter);
+
+/**
+ * @brief Get statistics of LVGL file system driver
+ *
+ * @param letter LVGL drive letter
+ * @param stats  output statistics
+ * @param reset  reset the statistics after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if stats is NULL
+ *      - ESP_ERR_NOT_FOUND         if the driver was not added
+ */
+esp_err_t lvgl_port_fs_get_stats(char letter, lvgl_port_fs_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port invalidation and flush heatmap (CONFIG_LVGL_PORT_HEATMAP, LVGL 9)
+ *
+ * Each display is divided into tiles of CONFIG_LVGL_PORT_HEATMAP_TILE pixels. Invalidated areas (as requested by widgets,
+ * before LVGL joins them) and flushed areas are counted per tile, together with totals of each frame.
+ * The heatmap can be printed (e.g. over UART console) or shown as an overlay over the display.
+ *
+ * @note All functions must be called with LVGL lock (lvgl_port_lock).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+
+/**
+ * @brief Totals of one frame
+ */
+typedef struct {
+    uint32_t invalidations;     /*!< Count of invalidated areas */
+    uint32_t invalidated_px;    /*!< Sum of invalidated areas (overlapping areas are counted more times) */
+    uint32_t flushes;           /*!< Count of flushed areas */
+    uint32_t flushed_px;        /*!< Sum of flushed areas */
+} lvgl_port_heatmap_frame_t;
+
+/**
+ * @brief Heatmap statistics of a display
+ */
+typedef struct {
+    uint32_t frames;                    /*!< Count of counted frames */
+    uint32_t skipped;                   /*!< Count of frames redrawn for the overlay (not counted in the tiles) */
+    lvgl_port_heatmap_frame_t last;     /*!< Totals of the last frame */
+    lvgl_port_heatmap_frame_t max;      /*!< Maximum of each total in one frame */
+    uint64_t flushed_px;                /*!< Flushed pixels of all counted frames */
+    uint16_t tile_size;                 /*!< Size of tile in pixels */
+    uint16_t cols;                      /*!< Count of tile columns */
+    uint16_t rows;                      /*!< Count of tile rows */
+} lvgl_port_heatmap_stats_t;
+
+/**
+ * @brief Get heatmap statistics of the display
+ *
+ * @param disp  LVGL display handle
+ * @param stats output statistics
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if disp or stats is NULL
+ *      - ESP_ERR_NOT_FOUND if the display is not added by esp_lvgl_port
+ *      - ESP_ERR_NOT_SUPPORTED if the heatmap is disabled (CONFIG_LVGL_PORT_HEATMAP)
+ */
+esp_err_t lvgl_port_heatmap_get_stats(lv_display_t *disp, lvgl_port_heatmap_stats_t *stats);
+
+/**
+ * @brief Print the heatmap of the display
+ *
+ * Totals are followed by two grids of tiles (rows of the display from the top): counts of invalidated areas touching
+ * the tile and redraws of the tile (flushed pixels of the tile divided by its size).
+ *
+ * @param disp  LVGL display handle
+ * @param out   output stream (e.g. stdout for UART console)
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if disp or out is NULL
+ *      - ESP_ERR_NOT_FOUND if the display is not added by esp_lvgl_port
+ *      - ESP_ERR_NOT_SUPPORTED if the heatmap is disabled (CONFIG_LVGL_PORT_HEATMAP)
+ */
+esp_err_t lvgl_port_heatmap_dump(lv_display_t *disp, FILE *out);
+
+/**
+ * @brief Clear the heatmap and the statistics of the display
+ *
+ * @param disp  LVGL display handle
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if disp is NULL
+ *      - ESP_ERR_NOT_FOUND if the display is not added by esp_lvgl_port
+ *      - ESP_ERR_NOT_SUPPORTED if the heatmap is disabled (CONFIG_LVGL_PORT_HEATMAP)
+ */
+esp_err_t lvgl_port_heatmap_reset(lv_display_t *disp);
+
+/**
+ * @brief Show or hide the heatmap overlay
+ *
+ * Tiles are colored by their redraws from blue (least) to red (most) on the system layer of the display.
+ * The overlay is redrawn every CONFIG_LVGL_PORT_HEATMAP_OVERLAY_PERIOD_MS, these frames are not counted in the heatmap.
+ *
+ * @param disp  LVGL display handle
+ * @param show  show the overlay
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if disp is NULL
+ *      - ESP_ERR_NOT_FOUND if the display is not added by esp_lvgl_port
+ *      - ESP_ERR_NO_MEM if the overlay cannot be created
+ *      - ESP_ERR_NOT_SUPPORTED if the heatmap is disabled (CONFIG_LVGL_PORT_HEATMAP)
+ */
+esp_err_t lvgl_port_heatmap_show_overlay(lv_display_t *disp, bool show);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port decoded image cache, prefetch and pinning (LVGL 9.1 and newer)
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Handle of pinned image
+ */
+typedef struct lvgl_port_image_pin_s *lvgl_port_image_pin_handle_t;
+
+/**
+ * @brief Decode images into LVGL image cache in background
+ *
+ * @note The images are decoded one by one in prefetch task with low priority, pinned to the other core
+ *       than LVGL task (when LVGL task has affinity). It takes LVGL lock for each image, so the rendering
+ *       waits during the decoding. Images already in the cache are skipped by LVGL decoder.
+ *       Source pointers (file path or lv_image_dsc_t) must be valid until they are decoded.
+ *       The decoded images stay in the cache until evicted by newer images (least recently used first),
+ *       see image_cache_size in lvgl_port_cfg_t.
+ *
+ * @param srcs      Array of image sources (as in lv_image_set_src())
+ * @param count     Number of image sources
+ * @return
+ *      - ESP_OK                 on success, all images were queued
+ *      - ESP_ERR_INVALID_ARG    if srcs is NULL
+ *      - ESP_ERR_NO_MEM         if the prefetch task cannot be created
+ *      - ESP_ERR_TIMEOUT        if the prefetch queue is full (CONFIG_LVGL_PORT_IMAGE_PREFETCH_QUEUE_LEN), the rest is not queued
+ *      - ESP_ERR_NOT_SUPPORTED  if LVGL is older than 9.1
+ */
+esp_err_t lvgl_port_image_prefetch(const void *const *srcs, size_t count);
+
+/**
+ * @brief Decode image and keep it in LVGL image cache until unpinned
+ *
+ * @note Pinned image is not evicted, but its size is counted in the cache size.
+ *
+ * @param[in]  src      Image source (as in lv_image_set_src())
+ * @param[out] ret_pin  Handle of pinned image
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if src or ret_pin is NULL
+ *      - ESP_ERR_NO_MEM         if memory allocation fails
+ *      - ESP_FAIL               if the image cannot be decoded
+ *      - ESP_ERR_NOT_SUPPORTED  if LVGL is older than 9.1
+ */
+esp_err_t lvgl_port_image_pin(const void *src, lvgl_port_image_pin_handle_t *ret_pin);
+
+/**
+ * @brief Release pinned image, it can be evicted from LVGL image cache
+ *
+ * @param pin       Handle of pinned image
+ */
+void lvgl_port_image_unpin(lvgl_port_image_pin_handle_t pin);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port image decoder using hardware JPEG decoder (ESP32-P4, LVGL 9.2 and newer)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Statistics of hardware JPEG image decoder
+ */
+typedef struct {
+    uint32_t decoded;           /*!< Images decoded by hardware */
+    uint32_t fallbacks;         /*!< JPEG images left to other (software) decoders, e.g. progressive or 4:1:1 subsampled */
+    uint32_t errors;            /*!< Images failed to read, allocate or decode */
+    uint32_t avg_decode_us;     /*!< Average time of reading and decoding of one image in microseconds */
+    uint32_t max_decode_us;     /*!< Longest time of reading and decoding of one image in microseconds */
+} lvgl_port_jpeg_stats_t;
+
+/**
+ * @brief Register LVGL image decoder backed by hardware JPEG decoder
+ *
+ * JPEG images (files with .jpg/.jpeg extension or lv_image_dsc_t with JPEG data) are decoded in one pass into
+ * cache line aligned DMA capable draw buffers in native color format (RGB565 or RGB888). The decoder is tried
+ * before the other LVGL decoders. Baseline images with 4:4:4, 4:2:2 or 4:2:0 subsampling are decoded
+ * by hardware, other JPEG images (progressive, grayscale, other subsampling) are left to the software
+ * decoder (CONFIG_LV_USE_TJPGD), when it is enabled.
+ *
+ * @note It must be called after lvgl_port_init() with LVGL lock (lvgl_port_lock()).
+ *       The decoded images are stored in LVGL image cache (see image_cache_size in lvgl_port_cfg_t).
+ *       Draw buffers are padded to whole MCUs (16 pixels for 4:2:0), the padding is not drawn.
+ *
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_STATE  if the decoder is already registered
+ *      - ESP_ERR_NO_MEM         if memory allocation fails
+ *      - ESP_ERR_NOT_SUPPORTED  if the chip has no JPEG decoder, esp_driver_jpeg is not in the build or LVGL is older than 9.2
+ */
+esp_err_t lvgl_port_jpeg_decoder_init(void);
+
+/**
+ * @brief Unregister hardware JPEG image decoder
+ *
+ * @note It must be called with LVGL lock. All images are dropped from LVGL image cache.
+ *
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_STATE  if the decoder is not registered
+ *      - ESP_ERR_NOT_SUPPORTED  if the hardware decoder is not supported
+ */
+esp_err_t lvgl_port_jpeg_decoder_deinit(void);
+
+/**
+ * @brief Get statistics of hardware JPEG image decoder
+ *
+ * @param[out] stats    Output statistics
+ * @param      reset    Reset the statistics after reading
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if stats is NULL
+ *      - ESP_ERR_NOT_SUPPORTED  if the hardware decoder is not supported
+ */
+esp_err_t lvgl_port_jpeg_decoder_get_stats(lvgl_port_jpeg_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
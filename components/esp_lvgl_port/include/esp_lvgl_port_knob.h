@@ -39,6 +39,10 @@ typedef struct {
     lv_display_t *disp;    /*!< LVGL display handle (returned from lvgl_port_add_disp) */
     const knob_config_t *encoder_a_b;
     const button_config_t *encoder_enter;  /*!< Navigation button for enter */
+    struct {
+        uint16_t speed_ms;  /*!< Detents closer than this interval are accelerated (0: acceleration disabled) */
+        uint8_t max_gain;   /*!< Steps reported for one detent at the highest speed (gain grows linearly with the speed) */
+    } accel;                /*!< Velocity based acceleration of fast spins (LVGL 9) */
 } lvgl_port_encoder_cfg_t;
 
 /**
@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port touch-to-display latency (CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS, LVGL 9)
+ *
+ * One touch event at a time is followed from the touch interrupt (or the changed LVGL read without interrupt)
+ * through the LVGL read, the first invalidation of its display and the rendering to the end of the transfer
+ * of the frame to the panel. Touch events, which did not invalidate anything before the next rendering, are dropped.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Stages of touch-to-display latency
+ */
+typedef enum {
+    LVGL_PORT_LATENCY_INPUT,        /*!< Touch interrupt to LVGL read of the touch */
+    LVGL_PORT_LATENCY_INVALIDATE,   /*!< LVGL read to the first invalidation of the display */
+    LVGL_PORT_LATENCY_REFR_WAIT,    /*!< Invalidation to the start of rendering (refresh timer, vsync pacing) */
+    LVGL_PORT_LATENCY_RENDER,       /*!< Rendering and flushing of all areas of the frame */
+    LVGL_PORT_LATENCY_TRANSFER,     /*!< End of rendering to the end of the last transfer (SPI/I80/I2C, MIPI-DSI) or the vsync showing the frame (RGB, MIPI-DSI frame buffers) */
+    LVGL_PORT_LATENCY_TOTAL,        /*!< Touch interrupt to the end of transfer */
+    LVGL_PORT_LATENCY_STAGES,
+} lvgl_port_latency_stage_t;
+
+/**
+ * @brief Percentiles of one latency stage
+ */
+typedef struct {
+    uint32_t p50_us;    /*!< Median */
+    uint32_t p90_us;    /*!< 90th percentile */
+    uint32_t p99_us;    /*!< 99th percentile */
+    uint32_t max_us;    /*!< Maximum */
+} lvgl_port_latency_percentiles_t;
+
+/**
+ * @brief Touch-to-display latency statistics
+ */
+typedef struct {
+    uint32_t measured;  /*!< Number of touch events followed to the panel */
+    uint32_t dropped;   /*!< Number of touch events without invalidation or not finished in time */
+    uint32_t samples;   /*!< Number of the last measured events in the percentiles (up to CONFIG_LVGL_PORT_LATENCY_SAMPLES) */
+    lvgl_port_latency_percentiles_t stage[LVGL_PORT_LATENCY_STAGES]; /*!< Percentiles of the stages */
+} lvgl_port_latency_stats_t;
+
+/**
+ * @brief Get touch-to-display latency statistics
+ *
+ * @note Statistics are collected only with CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+ *
+ * @param stats     output statistics
+ * @param reset     reset statistics after read
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ *      - ESP_ERR_NO_MEM if there is no memory for sorting of the samples
+ *      - ESP_ERR_NOT_SUPPORTED if statistics are disabled
+ */
+esp_err_t lvgl_port_get_latency_stats(lvgl_port_latency_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port cache of rendered static widget subtrees (LVGL 9.2 and newer)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Handle of cached widget subtree
+ */
+typedef struct lvgl_port_layer_cache_s *lvgl_port_layer_cache_handle_t;
+
+/**
+ * @brief Configuration of cached widget subtree
+ */
+typedef struct {
+    lv_obj_t            *obj;       /*!< Root object of the static subtree */
+    lv_color_format_t   cf;         /*!< Color format of the cache (0 is ARGB8888, RGB565 for opaque subtrees saves half of the memory) */
+    struct {
+        unsigned int buff_spiram: 1;    /*!< Cache is allocated in PSRAM */
+    } flags;
+} lvgl_port_layer_cache_cfg_t;
+
+/**
+ * @brief Information about cached widget subtree
+ */
+typedef struct {
+    uint32_t    renders;            /*!< Number of renderings of the subtree into the cache */
+    uint32_t    last_render_us;     /*!< Duration of the last rendering */
+    size_t      buf_size;           /*!< Size of the cache in bytes */
+} lvgl_port_layer_cache_info_t;
+
+/**
+ * @brief Render widget subtree once into the cache and draw only the cached pixels
+ *
+ * @note The object is replaced in its parent by a placeholder of the same size and position, which draws
+ *       the cache (including shadows and outlines out of the object). The object with its children is moved
+ *       to a private display without refreshing, where all their changes (styles, values, text, size, ...)
+ *       are tracked by LVGL invalidation. Changed subtree is rendered again before the next refresh of the display
+ *       and only the invalidated part of the placeholder is redrawn.
+ *       The subtree does not receive input events, it is meant for static panels (gauge faces, backgrounds).
+ *       When the placeholder is deleted (e.g. with its screen), the subtree is deleted too.
+ *       Snapshot must be enabled (CONFIG_LV_USE_SNAPSHOT).
+ *
+ * @param[in]  cfg          Configuration
+ * @param[out] ret_handle   Handle of cached subtree
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if cfg, obj or ret_handle is NULL or obj is a screen
+ *      - ESP_ERR_INVALID_STATE  if LVGL lock cannot be taken
+ *      - ESP_ERR_NO_MEM         if memory allocation fails
+ *      - ESP_ERR_NOT_SUPPORTED  if LVGL is older than 9.2 or snapshot is disabled
+ */
+esp_err_t lvgl_port_layer_cache_create(const lvgl_port_layer_cache_cfg_t *cfg, lvgl_port_layer_cache_handle_t *ret_handle);
+
+/**
+ * @brief Delete the cache and move the subtree back to the place of placeholder
+ *
+ * @param handle    Handle of cached subtree
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if handle is NULL
+ *      - ESP_ERR_INVALID_STATE  if LVGL lock cannot be taken
+ */
+esp_err_t lvgl_port_layer_cache_delete(lvgl_port_layer_cache_handle_t handle);
+
+/**
+ * @brief Render the subtree again before the next refresh
+ *
+ * @note Changes of objects in the subtree are tracked automatically, it is needed only for external
+ *       sources drawn by the subtree (e.g. image buffer changed in place).
+ *
+ * @param handle    Handle of cached subtree
+ */
+void lvgl_port_layer_cache_invalidate(lvgl_port_layer_cache_handle_t handle);
+
+/**
+ * @brief Get placeholder object, which is drawn in place of the subtree
+ *
+ * @param handle    Handle of cached subtree
+ * @return Placeholder object (e.g. for alignment of other objects or hiding)
+ */
+lv_obj_t *lvgl_port_layer_cache_get_obj(lvgl_port_layer_cache_handle_t handle);
+
+/**
+ * @brief Get information about cached subtree
+ *
+ * @param[in]  handle   Handle of cached subtree
+ * @param[out] info     Output information
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if handle or info is NULL
+ */
+esp_err_t lvgl_port_layer_cache_get_info(lvgl_port_layer_cache_handle_t handle, lvgl_port_layer_cache_info_t *info);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
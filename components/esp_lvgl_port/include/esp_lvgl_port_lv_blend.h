@@ -18,6 +18,8 @@ extern "C" {
 #warning "esp_lvgl_port_lv_blend.h included, but CONFIG_LV_DRAW_SW_ASM_CUSTOM not set. Assembly rendering not used"
 #else
 
+#include "esp_lvgl_port_simd.h"
+
 /*********************
  *      DEFINES
  *********************/
@@ -37,6 +39,96 @@ extern "C" {
     _lv_rgb565_blend_normal_to_rgb565_esp(dsc)
 #endif
 
+/* Per pixel blending (opa, mask, alpha) is implemented only for Xtensa targets (esp32, esp32s3) */
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA(dsc) \
+    _lv_color_blend_to_argb8888_with_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK(dsc) \
+    _lv_color_blend_to_argb8888_with_mask_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA(dsc) \
+    _lv_color_blend_to_argb8888_mix_mask_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    _lv_color_blend_to_rgb565_with_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) \
+    _lv_color_blend_to_rgb565_with_mask_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) \
+    _lv_color_blend_to_rgb565_mix_mask_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) \
+    _lv_rgb565_blend_normal_to_rgb565_with_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc) \
+    _lv_rgb565_blend_normal_to_rgb565_with_mask_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc) \
+    _lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565(dsc, src_px_size) \
+    _lv_rgb888_blend_normal_to_rgb565_esp(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc, src_px_size) \
+    _lv_rgb888_blend_normal_to_rgb565_with_opa_esp(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc, src_px_size) \
+    _lv_rgb888_blend_normal_to_rgb565_with_mask_esp(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc, src_px_size) \
+    _lv_rgb888_blend_normal_to_rgb565_mix_mask_opa_esp(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc) \
+    _lv_argb8888_blend_normal_to_rgb565_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc) \
+    _lv_argb8888_blend_normal_to_rgb565_with_opa_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888(dsc) \
+    _lv_argb8888_blend_normal_to_argb8888_esp(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc) \
+    _lv_argb8888_blend_normal_to_argb8888_with_opa_esp(dsc)
+#endif
+
+#endif // CONFIG_IDF_TARGET_ARCH_XTENSA
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -61,6 +153,10 @@ extern int lv_color_blend_to_argb8888_esp(asm_dsc_t *asm_dsc);
 
 static inline lv_result_t _lv_color_blend_to_argb8888_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
 {
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_FILL_ARGB8888, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
     asm_dsc_t asm_dsc = {
         .dst_buf = dsc->dest_buf,
         .dst_w = dsc->dest_w,
@@ -72,10 +168,74 @@ static inline lv_result_t _lv_color_blend_to_argb8888_esp(_lv_draw_sw_blend_fill
     return lv_color_blend_to_argb8888_esp(&asm_dsc);
 }
 
+extern int lv_color_blend_to_argb8888_mix_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_color_blend_to_argb8888_with_opa_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_FILL_ARGB8888_MIX, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = &dsc->color,
+    };
+
+    return lv_color_blend_to_argb8888_mix_esp(&asm_dsc);
+}
+
+static inline lv_result_t _lv_color_blend_to_argb8888_with_mask_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_FILL_ARGB8888_MIX, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = LV_OPA_COVER,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = &dsc->color,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+    };
+
+    return lv_color_blend_to_argb8888_mix_esp(&asm_dsc);
+}
+
+static inline lv_result_t _lv_color_blend_to_argb8888_mix_mask_opa_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_FILL_ARGB8888_MIX, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = &dsc->color,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+    };
+
+    return lv_color_blend_to_argb8888_mix_esp(&asm_dsc);
+}
+
 extern int lv_color_blend_to_rgb565_esp(asm_dsc_t *asm_dsc);
 
 static inline lv_result_t _lv_color_blend_to_rgb565_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
 {
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_FILL_RGB565, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
     asm_dsc_t asm_dsc = {
         .dst_buf = dsc->dest_buf,
         .dst_w = dsc->dest_w,
@@ -87,10 +247,74 @@ static inline lv_result_t _lv_color_blend_to_rgb565_esp(_lv_draw_sw_blend_fill_d
     return lv_color_blend_to_rgb565_esp(&asm_dsc);
 }
 
+extern int lv_color_blend_to_rgb565_mix_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_color_blend_to_rgb565_with_opa_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_FILL_RGB565_MIX, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = &dsc->color,
+    };
+
+    return lv_color_blend_to_rgb565_mix_esp(&asm_dsc);
+}
+
+static inline lv_result_t _lv_color_blend_to_rgb565_with_mask_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_FILL_RGB565_MIX, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = LV_OPA_COVER,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = &dsc->color,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+    };
+
+    return lv_color_blend_to_rgb565_mix_esp(&asm_dsc);
+}
+
+static inline lv_result_t _lv_color_blend_to_rgb565_mix_mask_opa_esp(_lv_draw_sw_blend_fill_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_FILL_RGB565_MIX, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = &dsc->color,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+    };
+
+    return lv_color_blend_to_rgb565_mix_esp(&asm_dsc);
+}
+
 extern int lv_rgb565_blend_normal_to_rgb565_esp(asm_dsc_t *asm_dsc);
 
 static inline lv_result_t _lv_rgb565_blend_normal_to_rgb565_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
 {
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_RGB565, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
     asm_dsc_t asm_dsc = {
         .dst_buf = dsc->dest_buf,
         .dst_w = dsc->dest_w,
@@ -103,6 +327,231 @@ static inline lv_result_t _lv_rgb565_blend_normal_to_rgb565_esp(_lv_draw_sw_blen
     return lv_rgb565_blend_normal_to_rgb565_esp(&asm_dsc);
 }
 
+extern int lv_rgb565_blend_normal_to_rgb565_mix_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_rgb565_blend_normal_to_rgb565_with_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_RGB565_MIX, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride
+    };
+
+    return lv_rgb565_blend_normal_to_rgb565_mix_esp(&asm_dsc);
+}
+
+static inline lv_result_t _lv_rgb565_blend_normal_to_rgb565_with_mask_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_RGB565_MIX, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = LV_OPA_COVER,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_rgb565_blend_normal_to_rgb565_mix_esp(&asm_dsc);
+}
+
+static inline lv_result_t _lv_rgb565_blend_normal_to_rgb565_mix_mask_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_RGB565_MIX, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride
+    };
+
+    return lv_rgb565_blend_normal_to_rgb565_mix_esp(&asm_dsc);
+}
+
+extern int lv_rgb888_blend_normal_to_rgb565_esp(asm_dsc_t *asm_dsc, uint32_t src_px_size);
+
+static inline lv_result_t _lv_rgb888_blend_normal_to_rgb565_esp(_lv_draw_sw_blend_image_dsc_t *dsc, uint32_t src_px_size)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_RGB888_TO_RGB565, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = LV_OPA_COVER,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride
+    };
+
+    return lv_rgb888_blend_normal_to_rgb565_esp(&asm_dsc, src_px_size);
+}
+
+static inline lv_result_t _lv_rgb888_blend_normal_to_rgb565_with_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc, uint32_t src_px_size)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_RGB888_TO_RGB565, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride
+    };
+
+    return lv_rgb888_blend_normal_to_rgb565_esp(&asm_dsc, src_px_size);
+}
+
+static inline lv_result_t _lv_rgb888_blend_normal_to_rgb565_with_mask_esp(_lv_draw_sw_blend_image_dsc_t *dsc, uint32_t src_px_size)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_RGB888_TO_RGB565, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = LV_OPA_COVER,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+    };
+
+    return lv_rgb888_blend_normal_to_rgb565_esp(&asm_dsc, src_px_size);
+}
+
+static inline lv_result_t _lv_rgb888_blend_normal_to_rgb565_mix_mask_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc, uint32_t src_px_size)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_RGB888_TO_RGB565, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask_buf = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+    };
+
+    return lv_rgb888_blend_normal_to_rgb565_esp(&asm_dsc, src_px_size);
+}
+
+extern int lv_argb8888_blend_normal_to_rgb565_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_ARGB8888_TO_RGB565, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = LV_OPA_COVER,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride
+    };
+
+    return lv_argb8888_blend_normal_to_rgb565_esp(&asm_dsc);
+}
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_rgb565_with_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_ARGB8888_TO_RGB565, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride
+    };
+
+    return lv_argb8888_blend_normal_to_rgb565_esp(&asm_dsc);
+}
+
+extern int lv_argb8888_blend_normal_to_argb8888_esp(asm_dsc_t *asm_dsc);
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_argb8888_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_ARGB8888_TO_ARGB8888, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = LV_OPA_COVER,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride
+    };
+
+    return lv_argb8888_blend_normal_to_argb8888_esp(&asm_dsc);
+}
+
+static inline lv_result_t _lv_argb8888_blend_normal_to_argb8888_with_opa_esp(_lv_draw_sw_blend_image_dsc_t *dsc)
+{
+    if (!lvgl_port_simd_use(LVGL_PORT_SIMD_IMAGE_ARGB8888_TO_ARGB8888, dsc->dest_w, dsc->dest_h)) {
+        return LV_RESULT_INVALID;
+    }
+
+    asm_dsc_t asm_dsc = {
+        .opa = dsc->opa,
+        .dst_buf = dsc->dest_buf,
+        .dst_w = dsc->dest_w,
+        .dst_h = dsc->dest_h,
+        .dst_stride = dsc->dest_stride,
+        .src_buf = dsc->src_buf,
+        .src_stride = dsc->src_stride
+    };
+
+    return lv_argb8888_blend_normal_to_argb8888_esp(&asm_dsc);
+}
+
 #endif // CONFIG_LV_DRAW_SW_ASM_CUSTOM
 
 #ifdef __cplusplus
@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port memory pools (LV_STDLIB_CUSTOM, LVGL 9)
+ *
+ * Set CONFIG_LV_USE_CUSTOM_MALLOC and CONFIG_LVGL_PORT_MEM_POOL for using it.
+ * LVGL and the port contexts allocate from TLSF heaps in two regions reserved once in lv_init():
+ * internal RAM for small (hot) objects and PSRAM for large allocations like images and caches.
+ *
+ * With CONFIG_LVGL_PORT_MEM_ACCOUNTING, each allocation is accounted to the screen active at the time of allocation
+ * (or set by lvgl_port_mem_set_screen), with its high-water mark. Objects of the active screens are counted by class.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Memory pool of LVGL
+ */
+typedef enum {
+    LVGL_PORT_MEM_POOL_INTERNAL,    /*!< Pool in internal RAM (allocations smaller than CONFIG_LVGL_PORT_MEM_POOL_SPIRAM_THRESHOLD) */
+    LVGL_PORT_MEM_POOL_SPIRAM,      /*!< Pool in PSRAM (larger allocations) */
+} lvgl_port_mem_pool_t;
+
+/**
+ * @brief Statistics of LVGL memory pool
+ */
+typedef struct {
+    size_t      total_size;         /*!< Size of the pool in bytes */
+    size_t      free_size;          /*!< Free bytes */
+    size_t      largest_free_block; /*!< Largest free block, a bigger allocation fails even with enough free bytes */
+    size_t      max_used;           /*!< High-water mark of used bytes since the pool was created */
+    uint32_t    used_blocks;        /*!< Number of allocated blocks */
+    uint32_t    failed;             /*!< Number of allocations not satisfied by this pool (also not by the other pool) */
+} lvgl_port_mem_stats_t;
+
+/**
+ * @brief Get statistics of LVGL memory pool
+ *
+ * @note It can be called from any task, the pools are protected by a spinlock.
+ *
+ * @param[in]  pool     Memory pool
+ * @param[out] stats    Statistics
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if stats is NULL or unknown pool
+ *      - ESP_ERR_INVALID_STATE  if the pool was not created (LVGL not initialized, no PSRAM or size 0)
+ */
+esp_err_t lvgl_port_mem_get_stats(lvgl_port_mem_pool_t pool, lvgl_port_mem_stats_t *stats);
+
+/**
+ * @brief LVGL memory accounted to one screen (CONFIG_LVGL_PORT_MEM_ACCOUNTING)
+ */
+typedef struct {
+    const lv_obj_t  *screen;        /*!< Screen (NULL: without screen, e.g. before the first display, or over CONFIG_LVGL_PORT_MEM_ACCOUNTING_SCREENS) */
+    size_t          used;           /*!< Allocated bytes (without headers of the pools) */
+    size_t          max_used;       /*!< High-water mark of allocated bytes */
+    uint32_t        blocks;         /*!< Number of allocated blocks */
+} lvgl_port_mem_screen_stats_t;
+
+/**
+ * @brief Objects of one class in a screen (CONFIG_LVGL_PORT_MEM_ACCOUNTING)
+ */
+typedef struct {
+    const lv_obj_class_t *class_p;  /*!< Object class */
+    const char      *name;          /*!< Name of the class (NULL before LVGL 9.2) */
+    uint32_t        objects;        /*!< Number of objects */
+    size_t          bytes;          /*!< Bytes of the object instances (without styles and other allocations of the objects) */
+} lvgl_port_mem_class_stats_t;
+
+/**
+ * @brief Set the screen, which the following LVGL allocations are accounted to
+ *
+ * By default, allocations are accounted to the active screen of the default display. Screens created
+ * before they are loaded (e.g. preloaded) are accounted correctly, when they are set here while being created.
+ *
+ * @note Must be called with LVGL lock.
+ *
+ * @param screen    Accounted screen (NULL: active screen of the default display)
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_NOT_SUPPORTED  if the accounting is disabled (CONFIG_LVGL_PORT_MEM_ACCOUNTING)
+ */
+esp_err_t lvgl_port_mem_set_screen(const lv_obj_t *screen);
+
+/**
+ * @brief Get LVGL memory accounted to screens
+ *
+ * The first entry is the memory without screen. Entries of deleted screens are kept until all their memory is freed.
+ *
+ * @note It can be called from any task (e.g. periodic telemetry).
+ *
+ * @param[out] stats    Array of statistics
+ * @param[in]  max      Length of the array
+ * @param[out] count    Number of written entries
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if stats or count is NULL
+ *      - ESP_ERR_NOT_SUPPORTED  if the accounting is disabled (CONFIG_LVGL_PORT_MEM_ACCOUNTING)
+ */
+esp_err_t lvgl_port_mem_get_screen_stats(lvgl_port_mem_screen_stats_t *stats, size_t max, size_t *count);
+
+/**
+ * @brief Count objects of the screen by class
+ *
+ * @note Must be called with LVGL lock.
+ *
+ * @param[in]  screen   Screen (or any object, its children are counted too)
+ * @param[out] stats    Array of statistics, sorted by bytes from the largest
+ * @param[in]  max      Length of the array (classes over it are not counted)
+ * @param[out] count    Number of written entries
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if any argument is NULL
+ *      - ESP_ERR_NOT_SUPPORTED  if the accounting is disabled (CONFIG_LVGL_PORT_MEM_ACCOUNTING)
+ */
+esp_err_t lvgl_port_mem_get_class_stats(lv_obj_t *screen, lvgl_port_mem_class_stats_t *stats, size_t max, size_t *count);
+
+/**
+ * @brief Print LVGL memory by pools, screens and object classes of the active screens
+ *
+ * @note Must be called with LVGL lock.
+ *
+ * @param out   output stream (e.g. stdout for UART console)
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if out is NULL
+ *      - ESP_ERR_NOT_SUPPORTED  if the accounting is disabled (CONFIG_LVGL_PORT_MEM_ACCOUNTING)
+ */
+esp_err_t lvgl_port_mem_dump(FILE *out);
+
+#ifdef __cplusplus
+}
+#endif
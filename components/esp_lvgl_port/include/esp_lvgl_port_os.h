@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port OS layer (LV_OS_CUSTOM)
+ *
+ * Set CONFIG_LV_OS_CUSTOM and CONFIG_LV_OS_CUSTOM_INCLUDE="esp_lvgl_port_os.h" for using it.
+ * LVGL draw threads (CONFIG_LV_DRAW_SW_DRAW_UNIT_CNT) are pinned to the core set in lvgl_port_cfg_t.draw_task_affinity.
+ */
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if !CONFIG_LV_OS_CUSTOM
+#warning "esp_lvgl_port_os.h included, but CONFIG_LV_OS_CUSTOM not set. OS layer not used"
+#else
+
+/* Used by esp_lvgl_port for detecting, that this OS layer is used */
+#define LVGL_PORT_OS_CUSTOM 1
+
+/**
+ * @brief LVGL thread
+ */
+typedef struct {
+    TaskHandle_t task;              /*!< FreeRTOS task handle */
+    void (*callback)(void *);       /*!< Thread function */
+    void *user_data;                /*!< Thread function argument */
+} lv_thread_t;
+
+/**
+ * @brief LVGL mutex
+ */
+typedef struct {
+    SemaphoreHandle_t mux;          /*!< FreeRTOS recursive mutex */
+} lv_mutex_t;
+
+/**
+ * @brief LVGL thread synchronization
+ */
+typedef struct {
+    SemaphoreHandle_t sem;          /*!< FreeRTOS binary semaphore */
+} lv_thread_sync_t;
+
+#endif /*CONFIG_LV_OS_CUSTOM*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port time-sliced building of screens in LVGL task idle time (LVGL 9)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+
+/**
+ * @brief Handle of preloaded screen
+ */
+typedef struct lvgl_port_preload_s *lvgl_port_preload_handle_t;
+
+/**
+ * @brief Build step of preloaded screen, called in LVGL task with LVGL lock
+ *
+ * It should create a small part of the screen (e.g. one widget or one list row) and return.
+ *
+ * @param screen    screen created by esp_lvgl_port (lv_obj_create(NULL)), it is not active
+ * @param step      number of the step (0, 1, 2, ...)
+ * @param user_ctx  user context from configuration
+ * @return true, when the screen is complete (no more steps)
+ */
+typedef bool (*lvgl_port_preload_step_cb_t)(lv_obj_t *screen, uint32_t step, void *user_ctx);
+
+/**
+ * @brief Callback called in LVGL task with LVGL lock, when the screen is complete
+ *
+ * The screen can be loaded here by lv_screen_load() or lv_screen_load_anim().
+ */
+typedef void (*lvgl_port_preload_ready_cb_t)(lvgl_port_preload_handle_t handle, lv_obj_t *screen, void *user_ctx);
+
+/**
+ * @brief Configuration of preloaded screen
+ */
+typedef struct {
+    lvgl_port_preload_step_cb_t  step_cb;       /*!< Build step (required) */
+    lvgl_port_preload_ready_cb_t ready_cb;      /*!< Called when the screen is complete (optional) */
+    void                         *user_ctx;     /*!< User context of the callbacks */
+    lv_display_t                 *disp;         /*!< Display of the screen (NULL: default display) */
+    uint32_t                     slice_budget_ms; /*!< Maximum time of build steps in one LVGL task cycle (0: 5 ms) */
+} lvgl_port_preload_cfg_t;
+
+/**
+ * @brief Start building of a screen in background
+ *
+ * Build steps are called in LVGL task after lv_timer_handler(), only in the time left to the next LVGL timer
+ * (refresh, animations, input reads) and at most slice_budget_ms in one cycle. At least one step is called in each cycle.
+ * When all steps are done, the layout of the screen is updated in the next slice and ready_cb is called.
+ * More screens are built one after the other in the order of this call.
+ *
+ * @note Objects of inactive screen are not rendered, the build steps do not invalidate the displays.
+ *
+ * @param[in]  cfg          configuration
+ * @param[out] ret_handle   handle of preloaded screen
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if cfg, step_cb or ret_handle is NULL
+ *      - ESP_ERR_NO_MEM         if memory allocation fails
+ *      - ESP_ERR_INVALID_STATE  if LVGL port is not initialized
+ */
+esp_err_t lvgl_port_preload_start(const lvgl_port_preload_cfg_t *cfg, lvgl_port_preload_handle_t *ret_handle);
+
+/**
+ * @brief Check, if the preloaded screen is complete
+ *
+ * @param handle    handle of preloaded screen
+ * @return true, if all steps are done and the layout is updated
+ */
+bool lvgl_port_preload_is_ready(lvgl_port_preload_handle_t handle);
+
+/**
+ * @brief Get preloaded screen
+ *
+ * @param handle    handle of preloaded screen
+ * @return the screen, when it is complete, otherwise NULL
+ */
+lv_obj_t *lvgl_port_preload_get_screen(lvgl_port_preload_handle_t handle);
+
+/**
+ * @brief Delete handle of preloaded screen
+ *
+ * @note Unfinished building is cancelled and the partial screen is deleted.
+ *       It can be called from ready_cb.
+ *
+ * @param handle        handle of preloaded screen
+ * @param del_screen    delete also complete screen (it must not be active)
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_ARG    if handle is NULL
+ */
+esp_err_t lvgl_port_preload_delete(lvgl_port_preload_handle_t handle, bool del_screen);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port adaptive render quality (CONFIG_LVGL_PORT_QUALITY, LVGL 9)
+ *
+ * Average render time of one frame is read from the display render statistics in each window
+ * (CONFIG_LVGL_PORT_STATS_WINDOW_MS). When it is over the frame budget, the quality is lowered by one level,
+ * when it falls well below the budget, the quality is raised by one level. Each level keeps the steps of the lower levels.
+ *
+ * @note All functions must be called with LVGL lock (lvgl_port_lock) or from LVGL task.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+
+/**
+ * @brief Render quality level
+ */
+typedef enum {
+    LVGL_PORT_QUALITY_FULL = 0,         /*!< All features */
+    LVGL_PORT_QUALITY_LARGE_BUFFERS,    /*!< Rendering into the larger draw buffers (fewer areas and flushes), skipped without them */
+    LVGL_PORT_QUALITY_NO_SHADOWS,       /*!< Shadows of registered styles are off */
+    LVGL_PORT_QUALITY_NO_ANTIALIAS,     /*!< Anti-aliasing of the display is off */
+    LVGL_PORT_QUALITY_LOW_ANIM_RATE,    /*!< Animations run at lower frame rate */
+} lvgl_port_quality_level_t;
+
+/**
+ * @brief Callback of changed quality level
+ *
+ * @param disp      LVGL display handle
+ * @param level     new level
+ * @param frame_us  average render time of one frame in the last window
+ * @param user_ctx  user context
+ */
+typedef void (*lvgl_port_quality_cb_t)(lv_display_t *disp, lvgl_port_quality_level_t level, uint32_t frame_us, void *user_ctx);
+
+/**
+ * @brief Configuration of adaptive render quality
+ */
+typedef struct {
+    uint32_t    frame_budget_us;    /*!< Render time of one frame, over which the quality is lowered (0: LV_DEF_REFR_PERIOD) */
+    uint8_t     restore_percent;    /*!< The quality is raised below this percentage of the budget (0: 60) */
+    uint8_t     hold_windows;       /*!< Windows over (or below) the threshold before each change of the level (0: 2) */
+    lvgl_port_quality_level_t max_level; /*!< Lowest quality used (0: LVGL_PORT_QUALITY_LOW_ANIM_RATE) */
+    uint32_t    anim_period_ms;     /*!< Period of animation timer in LVGL_PORT_QUALITY_LOW_ANIM_RATE (0: twice LV_DEF_REFR_PERIOD) */
+    void        *large_buf1;        /*!< Larger draw buffer of LVGL_PORT_QUALITY_LARGE_BUFFERS (NULL: level is skipped) */
+    void        *large_buf2;        /*!< Second larger draw buffer, needed by double buffered display */
+    uint32_t    large_buf_size;     /*!< Size of one larger draw buffer in bytes */
+    lvgl_port_quality_cb_t changed_cb; /*!< Called after change of the level (optional) */
+    void        *user_ctx;          /*!< User context of the callback */
+} lvgl_port_quality_cfg_t;
+
+/**
+ * @brief Start adaptive render quality of the display
+ *
+ * @note Larger draw buffers can be used only by partial mode display without intermediate buffers of rotation,
+ *       color conversion or flush coalescing. They must stay allocated until lvgl_port_quality_stop().
+ *
+ * @param disp  LVGL display handle
+ * @param cfg   configuration
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if disp or cfg is NULL or the configuration is invalid
+ *      - ESP_ERR_INVALID_STATE if it is already started or LVGL lock cannot be taken
+ *      - ESP_ERR_NO_MEM        if the timer cannot be created
+ *      - ESP_ERR_NOT_SUPPORTED if it is disabled (CONFIG_LVGL_PORT_QUALITY)
+ */
+esp_err_t lvgl_port_quality_start(lv_display_t *disp, const lvgl_port_quality_cfg_t *cfg);
+
+/**
+ * @brief Stop adaptive render quality and restore the full quality
+ *
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_STATE if it is not started or LVGL lock cannot be taken
+ *      - ESP_ERR_NOT_SUPPORTED if it is disabled (CONFIG_LVGL_PORT_QUALITY)
+ */
+esp_err_t lvgl_port_quality_stop(void);
+
+/**
+ * @brief Register style, whose shadow is turned off in LVGL_PORT_QUALITY_NO_SHADOWS
+ *
+ * @note Styles can be registered before start. Shadow width of the style must not be changed by the application
+ *       while it is registered.
+ *
+ * @param style LVGL style
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if style is NULL
+ *      - ESP_ERR_INVALID_STATE if LVGL lock cannot be taken
+ *      - ESP_ERR_NO_MEM        if there is not enough memory
+ *      - ESP_ERR_NOT_SUPPORTED if it is disabled (CONFIG_LVGL_PORT_QUALITY)
+ */
+esp_err_t lvgl_port_quality_add_style(lv_style_t *style);
+
+/**
+ * @brief Unregister style and restore its shadow
+ *
+ * @note It must be called before the style is reset or freed.
+ *
+ * @param style LVGL style
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if style is NULL
+ *      - ESP_ERR_INVALID_STATE if LVGL lock cannot be taken
+ *      - ESP_ERR_NOT_FOUND     if the style is not registered
+ *      - ESP_ERR_NOT_SUPPORTED if it is disabled (CONFIG_LVGL_PORT_QUALITY)
+ */
+esp_err_t lvgl_port_quality_remove_style(lv_style_t *style);
+
+/**
+ * @brief Get current render quality level
+ *
+ * @return Current level (LVGL_PORT_QUALITY_FULL, when it is not started)
+ */
+lvgl_port_quality_level_t lvgl_port_quality_get_level(void);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port remote view of displays (CONFIG_LVGL_PORT_REMOTE_VIEW, LVGL 9)
+ *
+ * Flushed areas are copied into a shadow of the display (RGB565, PSRAM if available) and queued as dirty rectangles.
+ * A low priority task compresses the queued rectangles (QOI-like coding of RGB565 pixels) and sends them to a stream
+ * socket. Flushing never waits for the network: when the queue is full, new areas are merged into the queued
+ * rectangles, so a slow connection receives fewer and larger updates, but the shadow is always sent in its latest state.
+ * The stream is decoded by tools/remote_view.py.
+ *
+ * @note All functions must be called with LVGL lock (lvgl_port_lock).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+
+/**
+ * @brief Configuration of remote view
+ */
+typedef struct {
+    int      sock;                  /*!< Connected stream socket (e.g. TCP), it is not closed by the port */
+    uint32_t max_bytes_per_sec;     /*!< Bandwidth limit of the stream (0: only limited by the socket) */
+    uint16_t max_rects;             /*!< Length of the queue of dirty rectangles (0: 16) */
+    uint32_t buffer_size;           /*!< Buffer of compressed pixels, larger rectangles are sent in bands of rows (0: 16 kB) */
+    int      task_priority;         /*!< Priority of the compression task (0: 1, below LVGL task) */
+    int      task_stack;            /*!< Stack size of the compression task (0: 3072) */
+    int      task_affinity;         /*!< Compression task pinned to core (-1 is no affinity), e.g. the core without LVGL task */
+} lvgl_port_remote_cfg_t;
+
+/**
+ * @brief Statistics of remote view
+ */
+typedef struct {
+    uint32_t updates;               /*!< Flushed areas copied into the shadow */
+    uint32_t merged;                /*!< Flushed areas merged into an overlapping queued rectangle */
+    uint32_t dropped;               /*!< Flushed areas not queued alone, because the queue was full (merged into the nearest rectangle) */
+    uint32_t rects;                 /*!< Sent rectangles (bands of rows) */
+    uint64_t raw_bytes;             /*!< Sent pixels before compression (2 bytes per pixel) */
+    uint64_t sent_bytes;            /*!< Bytes sent to the socket */
+    uint32_t bytes_per_sec;         /*!< Bandwidth of the stream in the last second */
+    uint32_t send_waits;            /*!< Waits for the socket (full send buffer) or for the bandwidth limit */
+    bool     connected;             /*!< The stream is sent (false after send error) */
+} lvgl_port_remote_stats_t;
+
+/**
+ * @brief Start remote view of the display
+ *
+ * Stream header is sent first, then the whole display is invalidated, so the remote side gets all of it.
+ *
+ * @param disp  LVGL display handle
+ * @param cfg   configuration
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if disp or cfg is NULL or the socket is invalid
+ *      - ESP_ERR_INVALID_STATE if the remote view is already started
+ *      - ESP_ERR_NOT_FOUND if the display is not added by esp_lvgl_port
+ *      - ESP_ERR_NO_MEM if out of memory for the shadow, queue or task
+ *      - ESP_ERR_NOT_SUPPORTED if the color format is not RGB565/RGB888/XRGB8888/ARGB8888 or the remote view is disabled (CONFIG_LVGL_PORT_REMOTE_VIEW)
+ */
+esp_err_t lvgl_port_remote_start(lv_display_t *disp, const lvgl_port_remote_cfg_t *cfg);
+
+/**
+ * @brief Stop remote view of the display
+ *
+ * Waits for the compression task to end (at most the socket poll period of 100 ms). The socket is not closed.
+ *
+ * @param disp  LVGL display handle
+ * @return
+ *      - ESP_OK on success (also when not started)
+ *      - ESP_ERR_INVALID_ARG if disp is NULL
+ *      - ESP_ERR_NOT_FOUND if the display is not added by esp_lvgl_port
+ *      - ESP_ERR_NOT_SUPPORTED if the remote view is disabled (CONFIG_LVGL_PORT_REMOTE_VIEW)
+ */
+esp_err_t lvgl_port_remote_stop(lv_display_t *disp);
+
+/**
+ * @brief Get statistics of remote view of the display
+ *
+ * @param disp  LVGL display handle
+ * @param stats output statistics (since the start)
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if disp or stats is NULL
+ *      - ESP_ERR_NOT_FOUND if the display is not added by esp_lvgl_port
+ *      - ESP_ERR_NOT_SUPPORTED if the remote view is disabled (CONFIG_LVGL_PORT_REMOTE_VIEW)
+ */
+esp_err_t lvgl_port_remote_get_stats(lv_display_t *disp, lvgl_port_remote_stats_t *stats);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
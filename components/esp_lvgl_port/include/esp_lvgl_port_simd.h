@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port selection of assembly blend kernels
+ *
+ * Assembly blend kernels (LVGL 9.1 with CONFIG_LV_DRAW_SW_ASM_CUSTOM) are selected at build time by the target.
+ * This table allows disabling one kernel or using it only for large enough areas at runtime,
+ * smaller areas (and disabled kernels) are blended by the ANSI C implementation of LVGL.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Assembly blend kernels
+ */
+typedef enum {
+    LVGL_PORT_SIMD_FILL_ARGB8888 = 0,           /*!< Simple fill of ARGB8888 */
+    LVGL_PORT_SIMD_FILL_ARGB8888_MIX,           /*!< ARGB8888 fill with opa and/or mask (Xtensa only) */
+    LVGL_PORT_SIMD_FILL_RGB565,                 /*!< Simple fill of RGB565 */
+    LVGL_PORT_SIMD_FILL_RGB565_MIX,             /*!< RGB565 fill with opa and/or mask (Xtensa only) */
+    LVGL_PORT_SIMD_IMAGE_RGB565,                /*!< RGB565 image copy to RGB565 */
+    LVGL_PORT_SIMD_IMAGE_RGB565_MIX,            /*!< RGB565 image blend to RGB565 with opa and/or mask (Xtensa only) */
+    LVGL_PORT_SIMD_IMAGE_RGB888_TO_RGB565,      /*!< RGB888/XRGB8888 image blend to RGB565 (Xtensa only) */
+    LVGL_PORT_SIMD_IMAGE_ARGB8888_TO_RGB565,    /*!< ARGB8888 image blend to RGB565 (Xtensa only) */
+    LVGL_PORT_SIMD_IMAGE_ARGB8888_TO_ARGB8888,  /*!< ARGB8888 image blend to ARGB8888 (Xtensa only) */
+    LVGL_PORT_SIMD_KERNEL_NUM,                  /*!< Number of the kernels */
+} lvgl_port_simd_kernel_t;
+
+/**
+ * @brief Selection of one assembly blend kernel
+ *
+ * @note Zero initialized structure selects the assembly kernel for all the areas
+ */
+typedef struct {
+    bool disabled;          /*!< Use the ANSI C implementation for all the areas */
+    uint16_t min_w;         /*!< Areas narrower than min_w pixels use the ANSI C implementation (0: no limit) */
+    uint32_t min_px;        /*!< Areas with less than min_px pixels use the ANSI C implementation (0: no limit) */
+} lvgl_port_simd_kernel_cfg_t;
+
+/**
+ * @brief Selection of all assembly blend kernels (see lvgl_port_cfg_t.simd)
+ */
+typedef struct {
+    lvgl_port_simd_kernel_cfg_t kernel[LVGL_PORT_SIMD_KERNEL_NUM];  /*!< Selection of each kernel, indexed by lvgl_port_simd_kernel_t */
+} lvgl_port_simd_cfg_t;
+
+/**
+ * @brief Dispatch table of assembly blend kernels
+ *
+ * @note Read by the blend hooks (esp_lvgl_port_lv_blend.h), use lvgl_port_simd_set_kernel for changing it
+ */
+extern lvgl_port_simd_kernel_cfg_t lvgl_port_simd_kernels[LVGL_PORT_SIMD_KERNEL_NUM];
+
+/**
+ * @brief Set selection of one assembly blend kernel
+ *
+ * The selection is used from the next blended area, it can be changed at any time (e.g. for A/B testing).
+ *
+ * @param kernel    assembly blend kernel
+ * @param cfg       selection of the kernel
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if the kernel is unknown or cfg is NULL
+ */
+esp_err_t lvgl_port_simd_set_kernel(lvgl_port_simd_kernel_t kernel, const lvgl_port_simd_kernel_cfg_t *cfg);
+
+/**
+ * @brief Get selection of one assembly blend kernel
+ *
+ * @param kernel    assembly blend kernel
+ * @param cfg       output selection of the kernel
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if the kernel is unknown or cfg is NULL
+ */
+esp_err_t lvgl_port_simd_get_kernel(lvgl_port_simd_kernel_t kernel, lvgl_port_simd_kernel_cfg_t *cfg);
+
+/**
+ * @brief Check, if the assembly blend kernel is used for the area
+ *
+ * @param kernel    assembly blend kernel
+ * @param w         area width in pixels
+ * @param h         area height in pixels
+ * @return true, if the assembly kernel is used, false for the ANSI C implementation
+ */
+static inline bool lvgl_port_simd_use(lvgl_port_simd_kernel_t kernel, int32_t w, int32_t h)
+{
+    const lvgl_port_simd_kernel_cfg_t *cfg = &lvgl_port_simd_kernels[kernel];
+    return !cfg->disabled && w >= cfg->min_w && (uint32_t)(w * h) >= cfg->min_px;
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
@@ -17,6 +17,10 @@
 #if __has_include ("esp_lcd_touch.h")
 #include "esp_lcd_touch.h"
 #define ESP_LVGL_PORT_TOUCH_COMPONENT 1
+#if __has_include ("esp_lcd_touch_gesture.h")
+#include "esp_lcd_touch_gesture.h"
+#define ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT 1
+#endif
 #endif
 
 #if LVGL_VERSION_MAJOR == 8
@@ -34,6 +38,16 @@ extern "C" {
 typedef struct {
     lv_display_t *disp;    /*!< LVGL display handle (returned from lvgl_port_add_disp) */
     esp_lcd_touch_handle_t   handle;   /*!< LCD touch IO handle */
+    uint16_t sample_period_ms;         /*!< Read the touch controller in own task at most every period (on interrupt, polled while pressed), LVGL reads only the samples (0: read in LVGL task), LVGL 9 only */
+    uint8_t smooth;                    /*!< IIR smoothing of sampled coordinates, weight of the previous position in 1/256 (0: disabled), only with sample_period_ms */
+    uint32_t sleep_timeout_ms;         /*!< Without activity for this time, set the touch to monitor power mode and stop LVGL (lvgl_port_stop), touch interrupt resumes it (0: disabled), needs interrupt pin, LVGL 9 only */
+    void *static_ctx;                  /*!< Touch context provided by the application (lvgl_port_touch_get_ctx_size() bytes, 4-byte aligned), it is not freed, not with sample_period_ms or gesture (NULL: allocated), LVGL 9 only */
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+    const esp_lcd_touch_gesture_config_t *gesture; /*!< Recognize gestures from touch samples and send them to LVGL objects (NULL: disabled), LVGL 9 only */
+#endif
+    struct {
+        unsigned int median: 1;        /*!< 3-sample median filter of sampled coordinates (removes single spikes), only with sample_period_ms */
+    } flags;
 } lvgl_port_touch_cfg_t;
 
 /**
@@ -55,6 +69,53 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg);
  *      - ESP_OK                    on success
  */
 esp_err_t lvgl_port_remove_touch(lv_indev_t *touch);
+
+/**
+ * @brief Get size of the touch context for static_ctx of touch configuration (LVGL 9)
+ *
+ * @return Size of the touch context in bytes
+ */
+size_t lvgl_port_touch_get_ctx_size(void);
+
+/**
+ * @brief Suspend LVGL until the next touch (LVGL 9)
+ *
+ * The touch is set to monitor power mode (when supported by the driver) and LVGL is stopped (lvgl_port_stop).
+ * The touch interrupt restores the active power mode, resumes LVGL and triggers display activity,
+ * as after sleep_timeout_ms of lvgl_port_touch_cfg_t.
+ *
+ * @note Must be called with LVGL lock.
+ *
+ * @param touch LVGL touch input device (returned from lvgl_port_add_touch)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if the input device is not a touch of LVGL port
+ *      - ESP_ERR_NOT_SUPPORTED     if the touch has no interrupt pin
+ *      - ESP_ERR_INVALID_STATE     if LVGL timer is not running
+ */
+esp_err_t lvgl_port_touch_suspend(lv_indev_t *touch);
+
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+/**
+ * @brief Get LVGL event code of touch gestures (LVGL 9)
+ *
+ * Gestures are sent to the object under the gesture point (center of two fingers), or to the active screen.
+ * The recognized gesture is got by lvgl_port_touch_get_gesture() in the event handler.
+ *
+ * @note Must be called with LVGL lock, the code is registered by the first call.
+ *
+ * @return LVGL event code
+ */
+uint32_t lvgl_port_touch_get_gesture_event(void);
+
+/**
+ * @brief Get gesture of the event (LVGL 9)
+ *
+ * @param e LVGL event (code from lvgl_port_touch_get_gesture_event)
+ * @return Recognized gesture (valid only in the event handler)
+ */
+const esp_lcd_touch_gesture_t *lvgl_port_touch_get_gesture(lv_event_t *e);
+#endif
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port trace events (CONFIG_LVGL_PORT_TRACE, LVGL 9)
+ *
+ * Begin/end events of LVGL task cycles, LVGL lock waits, rendering, flushes, LCD transfers and touch reads
+ * are sent to SEGGER SystemView (user events with the IDs below) or stored in a ring buffer,
+ * which can be dumped in Chrome trace JSON format (opened by Perfetto UI or chrome://tracing).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief IDs of trace events
+ */
+typedef enum {
+    LVGL_PORT_TRACE_TASK,           /*!< LVGL task cycle with LVGL lock (input reads, timers, rendering) */
+    LVGL_PORT_TRACE_LOCK_WAIT,      /*!< Waiting for LVGL lock (lvgl_port_lock) */
+    LVGL_PORT_TRACE_RENDER,         /*!< Rendering of a display frame */
+    LVGL_PORT_TRACE_FLUSH,          /*!< Flush callback of one area */
+    LVGL_PORT_TRACE_TRANSFER,       /*!< LCD transfer from the start to the transfer done callback (asynchronous) */
+    LVGL_PORT_TRACE_VSYNC,          /*!< Vsync of RGB/MIPI-DSI display (instant) */
+    LVGL_PORT_TRACE_TOUCH_IRQ,      /*!< Touch interrupt (instant) */
+    LVGL_PORT_TRACE_TOUCH_READ,     /*!< Reading of touch controller */
+    LVGL_PORT_TRACE_USER = 16,      /*!< First ID of application events */
+} lvgl_port_trace_id_t;
+
+/**
+ * @brief Begin of traced event
+ *
+ * @note It can be called from any task or ISR, events of one ID must not be nested in one task.
+ *
+ * @param id    event ID (LVGL_PORT_TRACE_USER and higher for application events)
+ */
+void lvgl_port_trace_begin(uint8_t id);
+
+/**
+ * @brief End of traced event
+ *
+ * @param id    event ID
+ */
+void lvgl_port_trace_end(uint8_t id);
+
+/**
+ * @brief Instant traced event
+ *
+ * @param id    event ID
+ * @param arg   value stored with the event
+ */
+void lvgl_port_trace_instant(uint8_t id, uint32_t arg);
+
+/**
+ * @brief Write events in the ring buffer as Chrome trace JSON
+ *
+ * @note Recording is paused during the dump. Events are printed from the oldest one,
+ *       timestamps are in microseconds of esp_timer. Events of ISRs are shown in threads "ISR core N".
+ *
+ * @param out   output stream (e.g. stdout for UART console)
+ * @param clear remove the dumped events
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if out is NULL
+ *      - ESP_ERR_NOT_SUPPORTED if the ring buffer is not selected (CONFIG_LVGL_PORT_TRACE_RING)
+ */
+esp_err_t lvgl_port_trace_dump(FILE *out, bool clear);
+
+#ifdef __cplusplus
+}
+#endif
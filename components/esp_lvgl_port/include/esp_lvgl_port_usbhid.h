@@ -43,6 +43,16 @@ typedef struct {
     lv_display_t *disp;        /*!< LVGL display handle (returned from lvgl_port_add_disp) */
 } lvgl_port_hid_keyboard_cfg_t;
 
+/**
+ * @brief Statistics of the USB HID input
+ */
+typedef struct {
+    uint32_t mouse_reports;    /*!< Received mouse reports */
+    uint32_t kb_reports;       /*!< Received keyboard reports */
+    uint32_t kb_dropped;       /*!< Pressed keys dropped, keyboard FIFO was full */
+    uint32_t short_reports;    /*!< Reports dropped, shorter than boot protocol report */
+} lvgl_port_usb_hid_stats_t;
+
 /**
  * @brief Add USB HID mouse as an input device
  *
@@ -72,6 +82,19 @@ lv_indev_t *lvgl_port_add_usb_hid_keyboard_input(const lvgl_port_hid_keyboard_cf
  *      - ESP_OK                    on success
  */
 esp_err_t lvgl_port_remove_usb_hid_input(lv_indev_t *hid);
+
+/**
+ * @brief Get statistics of the USB HID input (LVGL 9)
+ *
+ * @note Mouse motion is accumulated and keys are queued in HID callback, LVGL reads them at once.
+ *
+ * @param stats output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if stats is NULL
+ *      - ESP_ERR_INVALID_STATE     if USB HID input is not added
+ */
+esp_err_t lvgl_port_usb_hid_get_stats(lvgl_port_usb_hid_stats_t *stats);
 #endif
 
 
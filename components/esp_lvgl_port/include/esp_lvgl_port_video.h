@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port video layer
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Callback for releasing the frame, when it is not used anymore (e.g. esp_camera_fb_return)
+ *
+ * @note It is called from LVGL task or from lvgl_port_video_push
+ */
+typedef void (*lvgl_port_video_release_cb_t)(void *frame, void *user_ctx);
+
+/**
+ * @brief Video layer handle
+ */
+typedef struct lvgl_port_video_s *lvgl_port_video_handle_t;
+
+/**
+ * @brief Configuration of the video layer
+ */
+typedef struct {
+    lv_display_t *disp;         /*!< LVGL display handle (returned from lvgl_port_add_disp) */
+    lv_obj_t     *parent;       /*!< Parent of the video image object (NULL is active screen of the display, not used in direct mode) */
+    uint32_t     hres;          /*!< Horizontal resolution of the frames */
+    uint32_t     vres;          /*!< Vertical resolution of the frames */
+    lv_color_format_t color_format; /*!< Color format of the frames (0 is RGB565) */
+    int32_t      x;             /*!< Position of the frames on the LCD (only in direct mode) */
+    int32_t      y;
+    lvgl_port_video_release_cb_t release_cb; /*!< Callback for releasing the frames (optional) */
+    void         *user_ctx;     /*!< User context of the release callback */
+    struct {
+        unsigned int direct: 1; /*!< 1: Frames are sent directly to the LCD, without LVGL rendering (byte order of the frames must match the LCD, only with lvgl_port_add_disp), 0: Frames are source of LVGL image */
+    } flags;
+} lvgl_port_video_cfg_t;
+
+/**
+ * @brief Create video layer showing externally owned frame buffers without copying
+ *
+ * @note In image mode, the frame is the source of LVGL image object and LVGL draws it (swap of bytes is done by display swap_bytes).
+ *       In direct mode, the frame is sent to the LCD by esp_lcd_panel_draw_bitmap from LVGL task and it is not rotated.
+ *
+ * @param cfg       video layer configuration
+ * @param ret_video output video layer handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if configuration is wrong
+ *      - ESP_ERR_NOT_SUPPORTED     if direct mode is not supported by the display or LVGL is older than 9.1
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t lvgl_port_video_create(const lvgl_port_video_cfg_t *cfg, lvgl_port_video_handle_t *ret_video);
+
+/**
+ * @brief Show new frame
+ *
+ * The frame is held until the next frame is shown, then it is released by release callback.
+ * When the previous pushed frame was not shown yet, it is dropped (released) immediately.
+ * This function does not wait for LVGL lock.
+ *
+ * @param video     video layer handle
+ * @param data      frame data (hres * vres pixels in color_format)
+ * @param frame     frame handle passed to release callback (e.g. camera_fb_t)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NO_MEM            if LVGL async queue is full (the frame is released)
+ */
+esp_err_t lvgl_port_video_push(lvgl_port_video_handle_t video, const void *data, void *frame);
+
+/**
+ * @brief Send part of the frame directly to the LCD (only in direct mode)
+ *
+ * It is intended for frames produced in parts (e.g. JPEG decoded in MCU rows), the whole frame is never needed in RAM.
+ * Unlike lvgl_port_video_push, the parts are not dropped: this function blocks, while the previous parts are waiting for LVGL task.
+ * The part is held until the next frame or part is shown, then it is released by release callback.
+ *
+ * @note Must not be called from LVGL task.
+ *
+ * @param video     video layer handle
+ * @param area      area of the part relative to the video position (inclusive coordinates, inside hres * vres)
+ * @param data      part data (width * height of the area pixels in color_format)
+ * @param frame     frame handle passed to release callback
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or area is out of the video
+ *      - ESP_ERR_NOT_SUPPORTED     if the video layer is not in direct mode
+ */
+esp_err_t lvgl_port_video_push_area(lvgl_port_video_handle_t video, const lv_area_t *area, const void *data, void *frame);
+
+/**
+ * @brief Get LVGL image object of the video layer
+ *
+ * @param video     video layer handle
+ * @return Pointer to LVGL image object or NULL in direct mode
+ */
+lv_obj_t *lvgl_port_video_get_obj(lvgl_port_video_handle_t video);
+
+/**
+ * @brief Delete video layer
+ *
+ * @note The video layer is deleted in LVGL task and all held frames are released. Handle must not be used after this call.
+ *
+ * @param video     video layer handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NO_MEM            if LVGL async queue is full
+ */
+esp_err_t lvgl_port_video_delete(lvgl_port_video_handle_t video);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -11,6 +11,9 @@
 
 #pragma once
 
+#include "esp_lvgl_port_simd.h"
+#include "esp_lvgl_port_trace.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,6 +32,9 @@ typedef enum {
  */
 typedef struct {
     unsigned int avoid_tearing: 1;    /*!< Use internal RGB buffers as a LVGL draw buffers to avoid tearing effect */
+    unsigned int triple_buffer: 1;    /*!< Use three internal RGB buffers, render into the free one while waiting for vsync */
+    unsigned int frame_skip: 1;       /*!< Drop the oldest not displayed frame instead of blocking (triple buffer only) */
+    unsigned int vsync_pacing: 1;     /*!< Start rendering on panel vsync */
 } lvgl_port_disp_priv_cfg_t;
 
 /**
@@ -42,6 +48,344 @@ typedef struct {
  */
 bool lvgl_port_task_notify(uint32_t value);
 
+/**
+ * @brief Get state of LVGL timers
+ *
+ * @return
+ *      - true, if LVGL timers are stopped by lvgl_port_stop
+ */
+bool lvgl_port_is_stopped(void);
+
+/**
+ * @brief Notify LVGL task about vsync of the display with requested frame
+ *
+ * @note It is called from RGB vsync and MIPI-DSI refresh done interrupts
+ *
+ * @param disp      LVGL display handle
+ * @return
+ *      - true, whether a high priority task has been waken up by this function
+ */
+bool lvgl_port_task_frame_sync(lv_display_t *disp);
+
+/**
+ * @brief Start refresh of the vsync paced display, if the frame period elapsed
+ *
+ * @note It is called from LVGL task with LVGL lock
+ *
+ * @param disp              LVGL display handle
+ * @param frame_period_ms   minimal period between frames (0 is no limit)
+ */
+void lvgl_port_disp_frame_sync(lv_display_t *disp, uint32_t frame_period_ms);
+
+/**
+ * @brief Execute the callback in LVGL task (same as lvgl_port_async_call), wait for free space in the queue
+ *
+ * @note It must not be called from ISR and from LVGL task, which empties the queue
+ *
+ * @param cb            callback
+ * @param user_data     user data of the callback
+ * @param timeout       maximal time to wait for free space in the queue
+ * @return
+ *      - ESP_OK                 on success
+ *      - ESP_ERR_INVALID_STATE  if LVGL task is not running
+ *      - ESP_ERR_TIMEOUT        if the queue is full after the timeout
+ */
+esp_err_t lvgl_port_async_call_wait(lvgl_port_async_cb_t cb, void *user_data, TickType_t timeout);
+
+/**
+ * @brief Callback of external transfer done (called from ISR)
+ */
+typedef bool (*lvgl_port_disp_ext_done_cb_t)(void *user_ctx);
+
+/**
+ * @brief Send externally owned buffer to the LCD area, bypassing LVGL rendering
+ *
+ * @note It is called from LVGL task with LVGL lock. It waits for the LVGL transfer in progress.
+ *       With data NULL, it only checks, if the display supports it.
+ *
+ * @param disp      LVGL display handle
+ * @param x1        start of the area in LCD coordinates
+ * @param y1        start of the area in LCD coordinates
+ * @param x2        end of the area in LCD coordinates (exclusive)
+ * @param y2        end of the area in LCD coordinates (exclusive)
+ * @param data      buffer to send
+ * @param done_cb   called when the transfer is done
+ * @param user_ctx  user context of the done callback
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_NOT_SUPPORTED if the display does not support it
+ */
+esp_err_t lvgl_port_disp_draw_external(lv_display_t *disp, int x1, int y1, int x2, int y2, const void *data, lvgl_port_disp_ext_done_cb_t done_cb, void *user_ctx);
+
+/**
+ * @brief Set refresh period of the display (vsync paced displays are not changed)
+ *
+ * @note It is called from LVGL task with LVGL lock
+ *
+ * @param disp      LVGL display handle
+ * @param period_ms refresh timer period
+ */
+void lvgl_port_disp_set_refr_period(lv_display_t *disp, uint32_t period_ms);
+
+/**
+ * @brief Replace draw buffers of the partial mode display
+ *
+ * @note It is called from LVGL task with LVGL lock, between refreshes. Replaced buffers must stay valid
+ *       until the next refresh (the last flush may be in progress).
+ *
+ * @param disp      LVGL display handle
+ * @param buf1      first draw buffer (NULL: buffers of the display configuration)
+ * @param buf2      second draw buffer (NULL: single buffer)
+ * @param buf_size  size of one buffer in bytes
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if invalid arguments
+ *      - ESP_ERR_NOT_SUPPORTED if the display is not in partial mode or has buffers sized by the draw buffers
+ */
+esp_err_t lvgl_port_disp_set_draw_buffers(lv_display_t *disp, void *buf1, void *buf2, uint32_t buf_size);
+
+/**
+ * @brief Configure display flush tasks (flush_task flag)
+ *
+ * @param lvgl_task_affinity    core of LVGL task (-1 is no affinity), flush tasks are pinned to the same core
+ */
+void lvgl_port_disp_task_config(int lvgl_task_affinity);
+
+/**
+ * @brief Configure LVGL threads created by esp_lvgl_port OS layer (LV_OS_CUSTOM)
+ *
+ * @note It must be called before lv_init()
+ *
+ * @param priority  priority of LVGL draw threads
+ * @param affinity  LVGL draw threads pinned to core (-1 is no affinity)
+ */
+void lvgl_port_os_config(int priority, int affinity);
+
+/**
+ * @brief Configure selection of assembly blend kernels
+ *
+ * @param cfg       selection of the kernels (NULL: all kernels used for all the areas)
+ */
+void lvgl_port_simd_config(const lvgl_port_simd_cfg_t *cfg);
+
+#if LVGL_VERSION_MAJOR == 8
+/**
+ * @brief Use assembly blend kernels in SW renderer of the display (CONFIG_LVGL_PORT_LVGL8_SIMD)
+ *
+ * @note It must be called before lv_disp_drv_register()
+ *
+ * @param drv       LVGL display driver
+ */
+void lvgl_port_blend_init(lv_disp_drv_t *drv);
+#endif
+
+/**
+ * @brief Create LVGL draw unit offloading large fills and image copies to DMA (CONFIG_LVGL_PORT_DRAW_DMA)
+ *
+ * @note It must be called from LVGL task after lv_init(), the worker task has the same priority
+ */
+void lvgl_port_draw_dma_init(void);
+
+/**
+ * @brief Configure LVGL image cache and prefetch task
+ *
+ * @note It must be called before lv_init()
+ *
+ * @param cache_size            size of decoded image cache in bytes (0 is LVGL default, -1 is part of PSRAM)
+ * @param lvgl_task_affinity    core of LVGL task (-1 is no affinity), prefetch task is pinned to the other core
+ */
+void lvgl_port_image_config(int cache_size, int lvgl_task_affinity);
+
+/**
+ * @brief Resize LVGL image cache
+ *
+ * @note It must be called from LVGL task after lv_init()
+ */
+void lvgl_port_image_cache_init(void);
+
+/**
+ * @brief Delete image prefetch task
+ */
+void lvgl_port_image_deinit(void);
+
+/**
+ * @brief Configure glyph bitmap cache of fonts
+ *
+ * @param cache_size            size of glyph cache in bytes (0 is default, -1 is part of PSRAM)
+ */
+void lvgl_port_font_config(int cache_size);
+
+/**
+ * @brief Free all glyph bitmaps in the cache
+ */
+void lvgl_port_font_deinit(void);
+
+/**
+ * @brief Call build steps of preloaded screens
+ *
+ * @note It is called from LVGL task with LVGL lock after lv_timer_handler()
+ *
+ * @param idle_ms   time to the next LVGL timer
+ * @return time to sleep, shorter when more steps are pending
+ */
+uint32_t lvgl_port_preload_run(uint32_t idle_ms);
+
+/**
+ * @brief Delete unfinished preloaded screens
+ */
+void lvgl_port_preload_deinit(void);
+
+/**
+ * @brief End of transfer of the frame rendered for the followed touch event
+ */
+typedef enum {
+    LVGL_PORT_LATENCY_DONE_NOW,     /*!< Transferred at the end of rendering (flush waited for vsync) */
+    LVGL_PORT_LATENCY_DONE_TRANS,   /*!< After the transfer done callback of the last transfer */
+    LVGL_PORT_LATENCY_DONE_VSYNC,   /*!< On the next vsync */
+} lvgl_port_latency_done_t;
+
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+/**
+ * @brief Touch interrupt came (called from ISR)
+ */
+void lvgl_port_latency_touch_irq(void);
+
+/**
+ * @brief Touch was read by LVGL
+ *
+ * @param indev     LVGL input device
+ * @param data      data returned to LVGL
+ */
+void lvgl_port_latency_touch_read(lv_indev_t *indev, const lv_indev_data_t *data);
+
+/**
+ * @brief Area of the display was invalidated (called with LVGL lock)
+ */
+void lvgl_port_latency_invalidate(lv_display_t *disp);
+
+/**
+ * @brief Rendering of the display started (called with LVGL lock)
+ */
+void lvgl_port_latency_render_start(lv_display_t *disp);
+
+/**
+ * @brief All areas of the frame were flushed (called with LVGL lock)
+ *
+ * @param disp          LVGL display handle
+ * @param done_mode     how the end of transfer is detected
+ * @param trans_target  count of started transfers of the display
+ * @param trans_done    count of finished transfers of the display (updated from ISR)
+ */
+void lvgl_port_latency_render_ready(lv_display_t *disp, lvgl_port_latency_done_t done_mode, uint32_t trans_target, const volatile uint32_t *trans_done);
+
+/**
+ * @brief Transfer of the display finished (called from ISR)
+ *
+ * @param disp          LVGL display handle
+ * @param trans_done    count of finished transfers of the display
+ */
+void lvgl_port_latency_trans_done(lv_display_t *disp, uint32_t trans_done);
+
+/**
+ * @brief Vsync of the display (called from ISR)
+ */
+void lvgl_port_latency_vsync(lv_display_t *disp);
+#endif
+
+#if CONFIG_LVGL_PORT_HEATMAP
+/**
+ * @brief Invalidation and flush heatmap of a display
+ */
+typedef struct lvgl_port_heatmap_s lvgl_port_heatmap_t;
+
+/**
+ * @brief Create heatmap of the display (called with LVGL lock)
+ *
+ * @note Invalidations and frames are followed by display events, the heatmap must be created
+ *       before other invalidation callbacks changing the area.
+ *
+ * @param disp  LVGL display handle
+ * @return Heatmap or NULL if out of memory
+ */
+lvgl_port_heatmap_t *lvgl_port_heatmap_create(lv_display_t *disp);
+
+/**
+ * @brief Delete heatmap, after its display was removed
+ */
+void lvgl_port_heatmap_delete(lvgl_port_heatmap_t *hm);
+
+/**
+ * @brief Area was flushed by LVGL (called with LVGL lock)
+ */
+void lvgl_port_heatmap_flush(lvgl_port_heatmap_t *hm, const lv_area_t *area);
+#endif
+
+#if CONFIG_LVGL_PORT_REMOTE_VIEW
+/**
+ * @brief Remote view of a display
+ */
+typedef struct lvgl_port_remote_s lvgl_port_remote_t;
+
+/**
+ * @brief Create remote view of the display, it is started by lvgl_port_remote_start() (called with LVGL lock)
+ *
+ * @param disp  LVGL display handle
+ * @return Remote view or NULL if out of memory
+ */
+lvgl_port_remote_t *lvgl_port_remote_create(lv_display_t *disp);
+
+/**
+ * @brief Stop and delete remote view (called with LVGL lock)
+ */
+void lvgl_port_remote_delete(lvgl_port_remote_t *rv);
+
+/**
+ * @brief Area was flushed by LVGL, it is copied into the shadow when the remote view is started (called with LVGL lock)
+ *
+ * @param rv        Remote view
+ * @param area      Flushed area
+ * @param color_map Rendered pixels of the area (whole display in direct mode)
+ * @param direct    Display is in direct mode
+ */
+void lvgl_port_remote_flush(lvgl_port_remote_t *rv, const lv_area_t *area, const uint8_t *color_map, bool direct);
+#endif
+
+/* Trace events (CONFIG_LVGL_PORT_TRACE) */
+#if CONFIG_LVGL_PORT_TRACE_RING || CONFIG_LVGL_PORT_TRACE_SYSVIEW
+#define LVGL_PORT_TRACE 1
+#define LVGL_PORT_TRACE_BEGIN(id)           lvgl_port_trace_begin(id)
+#define LVGL_PORT_TRACE_END(id)             lvgl_port_trace_end(id)
+#define LVGL_PORT_TRACE_INSTANT(id, arg)    lvgl_port_trace_instant((id), (arg))
+#define LVGL_PORT_TRACE_TRANS_START(disp)   lvgl_port_trace_trans_start(disp)
+#define LVGL_PORT_TRACE_TRANS_DONE(disp)    lvgl_port_trace_trans_done(disp)
+
+/**
+ * @brief Transfer of the display started (asynchronous event ended by lvgl_port_trace_trans_done)
+ */
+void lvgl_port_trace_trans_start(lv_display_t *disp);
+
+/**
+ * @brief Transfer of the display done (called from ISR), transfers of one display are done in order
+ */
+void lvgl_port_trace_trans_done(lv_display_t *disp);
+#else
+#define LVGL_PORT_TRACE 0
+#define LVGL_PORT_TRACE_BEGIN(id)
+#define LVGL_PORT_TRACE_END(id)
+#define LVGL_PORT_TRACE_INSTANT(id, arg)
+#define LVGL_PORT_TRACE_TRANS_START(disp)
+#define LVGL_PORT_TRACE_TRANS_DONE(disp)
+#endif
+
+/* Port contexts are allocated from LVGL memory pools (CONFIG_LVGL_PORT_MEM_POOL) */
+#if CONFIG_LVGL_PORT_MEM_POOL
+#define LVGL_PORT_CTX_CALLOC(size)  lv_calloc(1, (size))
+#define LVGL_PORT_CTX_FREE(ptr)     lv_free(ptr)
+#else
+#define LVGL_PORT_CTX_CALLOC(size)  calloc(1, (size))
+#define LVGL_PORT_CTX_FREE(ptr)     free(ptr)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port software rotation and color conversion kernels
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Rotation of the kernel (same values as lv_display_rotation_t)
+ */
+typedef enum {
+    LVGL_PORT_ROTATE_0 = 0,
+    LVGL_PORT_ROTATE_90,
+    LVGL_PORT_ROTATE_180,
+    LVGL_PORT_ROTATE_270,
+} lvgl_port_rotate_t;
+
+/**
+ * @brief Rotate image using cache friendly tiles
+ *
+ * @note Source is read and destination is written in small square tiles, so the both stay in cache.
+ *       This is faster than row-major walk, when the buffers are in PSRAM.
+ * @note Destination layout matches the area returned by lvgl_port_rotate_area().
+ *       For 90 and 270 degrees the destination has src_height columns and src_width rows.
+ *
+ * @param src           Source buffer
+ * @param dest          Destination buffer
+ * @param src_width     Source width in pixels
+ * @param src_height    Source height in pixels
+ * @param src_stride    Source stride in bytes
+ * @param dest_stride   Destination stride in bytes
+ * @param rotation      Rotation
+ * @param px_size       Size of one pixel in bytes (2, 3 or 4)
+ * @param swap_bytes    Swap bytes of RGB565 pixels during the rotation (only for px_size 2)
+ */
+void lvgl_port_rotate_tiled(const void *src, void *dest, int32_t src_width, int32_t src_height, int32_t src_stride, int32_t dest_stride, lvgl_port_rotate_t rotation, uint32_t px_size, bool swap_bytes);
+
+/**
+ * @brief Copy RGB565 image and swap bytes of each pixel in one pass
+ *
+ * @note Source and destination can be the same buffer (with the same stride).
+ *
+ * @param src           Source buffer
+ * @param dest          Destination buffer
+ * @param width         Width in pixels
+ * @param height        Height in pixels
+ * @param src_stride    Source stride in bytes
+ * @param dest_stride   Destination stride in bytes
+ */
+void lvgl_port_copy_swap_rgb565(const void *src, void *dest, int32_t width, int32_t height, int32_t src_stride, int32_t dest_stride);
+
+/**
+ * @brief Convert RGB888/XRGB8888 image to RGB565 in one pass
+ *
+ * @note Source pixels are in LVGL byte order (blue, green, red[, alpha]), alpha is ignored.
+ *
+ * @param src           Source buffer
+ * @param dest          Destination buffer
+ * @param width         Width in pixels
+ * @param height        Height in pixels
+ * @param src_stride    Source stride in bytes
+ * @param dest_stride   Destination stride in bytes
+ * @param src_px_size   Size of one source pixel in bytes (3 or 4)
+ * @param swap_bytes    Swap bytes of RGB565 pixels during the conversion
+ */
+void lvgl_port_convert_to_rgb565(const void *src, void *dest, int32_t width, int32_t height, int32_t src_stride, int32_t dest_stride, uint32_t src_px_size, bool swap_bytes);
+
+/**
+ * @brief Convert RGB888/XRGB8888 image to packed 24-bit pixels (RGB666/RGB888 COLMOD of SPI/I80 panels)
+ *
+ * @note Source pixels are in LVGL byte order (blue, green, red[, alpha]), alpha is ignored.
+ *       Panels in 18-bit mode use the upper 6 bits of each byte.
+ *
+ * @param src           Source buffer
+ * @param dest          Destination buffer (3 bytes per pixel)
+ * @param width         Width in pixels
+ * @param height        Height in pixels
+ * @param src_stride    Source stride in bytes
+ * @param dest_stride   Destination stride in bytes
+ * @param src_px_size   Size of one source pixel in bytes (3 or 4)
+ * @param swap_bytes    Reverse bytes of pixels to panel byte order (red, green, blue)
+ */
+void lvgl_port_convert_to_rgb888(const void *src, void *dest, int32_t width, int32_t height, int32_t src_stride, int32_t dest_stride, uint32_t src_px_size, bool swap_bytes);
+
+/**
+ * @brief Expand L8 (8-bit luminance/index) image to RGB565 through a 256-entry table
+ *
+ * @param src           Source buffer
+ * @param dest          Destination buffer
+ * @param width         Width in pixels
+ * @param height        Height in pixels
+ * @param src_stride    Source stride in bytes
+ * @param dest_stride   Destination stride in bytes
+ * @param lut           RGB565 color of each L8 value (in the byte order sent to the panel)
+ */
+void lvgl_port_convert_l8_to_rgb565(const void *src, void *dest, int32_t width, int32_t height, int32_t src_stride, int32_t dest_stride, const uint16_t *lut);
+
+/**
+ * @brief Transform 8-pixel aligned area to pages of monochrome display (SSD1306, SH1107 layout)
+ *
+ * @note The page is 8 pixels high column of bytes (along X, or along Y when swap_xy), bit 0 is the top pixel.
+ *       Whole output bytes are written, no read-modify-write of single bits.
+ * @note x1, y1 must be multiples of 8 and x2 + 1, y2 + 1 as well.
+ *
+ * @param src           Source buffer: I1 bitmap without palette (bit 7 is the first pixel, lit pixel is 0) or RGB565 (pixel is lit, when blue > 16)
+ * @param dest          Destination pages, hor_res bytes per page (ver_res bytes, when swap_xy)
+ * @param src_i1        Source is I1 bitmap, otherwise RGB565
+ * @param swap_xy       Swap X and Y axes (90 and 270 degrees rotation)
+ * @param hor_res       Physical horizontal resolution
+ * @param ver_res       Physical vertical resolution
+ * @param x1            First column of the area
+ * @param x2            Last column of the area
+ * @param y1            First row of the area
+ * @param y2            Last row of the area
+ */
+void lvgl_port_monochrome_pages(const void *src, void *dest, bool src_i1, bool swap_xy, uint16_t hor_res, uint16_t ver_res, int32_t x1, int32_t x2, int32_t y1, int32_t y2);
+
+#ifdef __cplusplus
+}
+#endif
@@ -67,6 +67,67 @@ function(lvgl_port_create_c_image image_path output_path color_format compressio
 
 endfunction()
 
+# lvgl_port_create_c_image_compressed
+#
+# Create RLE or LZ4 compressed C array of image for esp_lvgl_port compressed image decoder (LVGL 9.2)
+# Older LVGL versions get not compressed image from lvgl_port_create_c_image()
+function(lvgl_port_create_c_image_compressed image_path output_path color_format compression)
+    cmake_parse_arguments(IMAGE "" "BAND_ROWS" "" ${ARGN})
+
+    #Get Python
+    idf_build_get_property(python PYTHON)
+
+    #Get LVGL version and path of this component
+    idf_build_get_property(build_components BUILD_COMPONENTS)
+    if(lvgl IN_LIST build_components)
+        set(lvgl_ver $ENV{LVGL_VERSION}) # Get the version from env variable (set from LVGL v9.2)
+    else()
+        idf_component_get_property(lvgl_ver lvgl__lvgl COMPONENT_VERSION) # Get the version from esp-idf build system
+    endif()
+    if("${lvgl_ver}" STREQUAL "")
+        message("Could not determine LVGL version, assuming v9.x")
+        set(lvgl_ver "9.0.0")
+    endif()
+    if(lvgl_ver VERSION_LESS "9.2.0")
+        lvgl_port_create_c_image(${image_path} ${output_path} ${color_format} "NONE")
+        return()
+    endif()
+    if(esp_lvgl_port IN_LIST build_components)
+        set(port_name esp_lvgl_port) # Local component
+    else()
+        set(port_name espressif__esp_lvgl_port) # Managed component
+    endif()
+    idf_component_get_property(port_dir ${port_name} COMPONENT_DIR)
+
+    get_filename_component(image_full_path ${image_path} ABSOLUTE)
+    get_filename_component(output_full_path ${output_path} ABSOLUTE)
+    if(NOT EXISTS ${image_full_path})
+        message(FATAL_ERROR "Input image (${image_full_path}) not exists!")
+    endif()
+    if(NOT IMAGE_BAND_ROWS)
+        set(IMAGE_BAND_ROWS 8)
+    endif()
+
+    message(STATUS "Generating compressed C array image: ${image_path}")
+
+    #Install dependencies
+    execute_process(COMMAND ${python} -m pip install pypng lz4 OUTPUT_QUIET)
+
+    execute_process(COMMAND ${python} "${port_dir}/tools/image_compress.py"
+            ${image_full_path}
+            ${output_full_path}
+            --cf ${color_format}
+            --compress ${compression}
+            --band-rows ${IMAGE_BAND_ROWS}
+            RESULT_VARIABLE image_result)
+    if(NOT image_result EQUAL 0)
+        message(FATAL_ERROR "Image compression failed: ${image_path}")
+    endif()
+
+    #Generate again, when the image is changed
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${image_full_path})
+endfunction()
+
 # lvgl_port_add_images
 #
 # Add all images to build
@@ -76,3 +137,80 @@ function(lvgl_port_add_images component output_path)
     target_sources(${component} PRIVATE ${IMAGE_SOURCES})
     idf_build_set_property(COMPILE_OPTIONS "-DLV_LVGL_H_INCLUDE_SIMPLE=1" APPEND)
 endfunction()
+
+# lvgl_port_create_c_font
+#
+# Pre-render glyphs of TTF/OTF font used in texts to LVGL bitmap fonts (C arrays), one per size
+#
+# lvgl_port_create_c_font(font_path output_path name SIZES <sizes> [BPP <1|2|4>]
+#                         [TEXT_FILES <files>] [SYMBOLS <chars>] [RANGES <first-last>])
+function(lvgl_port_create_c_font font_path output_path name)
+    cmake_parse_arguments(FONT "" "BPP;SYMBOLS" "SIZES;TEXT_FILES;RANGES" ${ARGN})
+
+    #Get Python
+    idf_build_get_property(python PYTHON)
+
+    #Get path of this component
+    idf_build_get_property(build_components BUILD_COMPONENTS)
+    if(esp_lvgl_port IN_LIST build_components)
+        set(port_name esp_lvgl_port) # Local component
+    else()
+        set(port_name espressif__esp_lvgl_port) # Managed component
+    endif()
+    idf_component_get_property(port_dir ${port_name} COMPONENT_DIR)
+
+    get_filename_component(font_full_path ${font_path} ABSOLUTE)
+    get_filename_component(output_full_path ${output_path} ABSOLUTE)
+    if(NOT EXISTS ${font_full_path})
+        message(FATAL_ERROR "Input font (${font_full_path}) not exists!")
+    endif()
+    if(NOT FONT_SIZES)
+        message(FATAL_ERROR "Font sizes are not set (SIZES)!")
+    endif()
+    if(NOT FONT_BPP)
+        set(FONT_BPP 4)
+    endif()
+
+    set(font_args --name ${name} --sizes ${FONT_SIZES} --bpp ${FONT_BPP})
+    set(text_files "")
+    foreach(text_file ${FONT_TEXT_FILES})
+        get_filename_component(text_full_path ${text_file} ABSOLUTE)
+        list(APPEND text_files ${text_full_path})
+    endforeach()
+    if(text_files)
+        list(APPEND font_args --text-files ${text_files})
+    endif()
+    if(FONT_SYMBOLS)
+        list(APPEND font_args "--symbols=${FONT_SYMBOLS}")
+    endif()
+    if(FONT_RANGES)
+        list(APPEND font_args --range ${FONT_RANGES})
+    endif()
+
+    message(STATUS "Generating C array fonts: ${name} (${FONT_SIZES})")
+
+    #Install dependencies
+    execute_process(COMMAND ${python} -m pip install freetype-py OUTPUT_QUIET)
+
+    execute_process(COMMAND ${python} "${port_dir}/tools/font_atlas.py"
+            ${font_full_path}
+            ${output_full_path}
+            ${font_args}
+            RESULT_VARIABLE font_result)
+    if(NOT font_result EQUAL 0)
+        message(FATAL_ERROR "Font generation failed: ${name}")
+    endif()
+
+    #Generate again, when the font or the texts are changed
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${font_full_path} ${text_files})
+endfunction()
+
+# lvgl_port_add_fonts
+#
+# Add all fonts to build
+function(lvgl_port_add_fonts component output_path)
+    #Add fonts to sources
+    file(GLOB_RECURSE FONT_SOURCES ${output_path}*.c)
+    target_sources(${component} PRIVATE ${FONT_SOURCES})
+    idf_build_set_property(COMPILE_OPTIONS "-DLV_LVGL_H_INCLUDE_SIMPLE=1" APPEND)
+endfunction()
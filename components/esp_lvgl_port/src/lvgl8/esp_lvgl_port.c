@@ -61,6 +61,9 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
 
     /* LVGL init */
     lv_init();
+#if CONFIG_LVGL_PORT_LVGL8_SIMD
+    lvgl_port_simd_config(cfg->simd);
+#endif
     /* Tick init */
     lvgl_port_ctx.timer_period_ms = cfg->timer_period_ms;
     ESP_RETURN_ON_ERROR(lvgl_port_tick_init(), TAG, "");
@@ -162,6 +165,17 @@ esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param)
     return ESP_ERR_NOT_SUPPORTED;
 }
 
+esp_err_t lvgl_port_async_call(lvgl_port_async_cb_t cb, void *user_data)
+{
+    ESP_LOGE(TAG, "Async call is not supported, when used LVGL8!");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_get_lock_stats(lvgl_port_lock_stats_t *stats, bool reset)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
 IRAM_ATTR bool lvgl_port_task_notify(uint32_t value)
 {
     BaseType_t need_yield = pdFALSE;
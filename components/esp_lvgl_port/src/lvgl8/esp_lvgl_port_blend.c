@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Blending of LVGL 8 SW renderer by the assembly kernels of LVGL 9 port (src/lvgl9/simd).
+ * The kernels work with RGB565 destination, other cases are blended by lv_draw_sw_blend_basic().
+ */
+
+#include "sdkconfig.h"
+#include "lvgl.h"
+#include "esp_lvgl_port_priv.h"
+
+#if LV_COLOR_DEPTH != 16 || LV_COLOR_16_SWAP || LV_COLOR_SCREEN_TRANSP
+#error "CONFIG_LVGL_PORT_LVGL8_SIMD requires LV_COLOR_DEPTH 16 without LV_COLOR_16_SWAP and LV_COLOR_SCREEN_TRANSP"
+#endif
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+/* Same layout as asm_dsc_t in esp_lvgl_port_lv_blend.h, strides are in bytes */
+typedef struct {
+    uint32_t opa;
+    void *dst_buf;
+    uint32_t dst_w;
+    uint32_t dst_h;
+    uint32_t dst_stride;
+    const void *src_buf;
+    uint32_t src_stride;
+    const lv_opa_t *mask_buf;
+    uint32_t mask_stride;
+} lvgl_port_asm_dsc_t;
+
+extern int lv_color_blend_to_rgb565_esp(lvgl_port_asm_dsc_t *asm_dsc);
+extern int lv_rgb565_blend_normal_to_rgb565_esp(lvgl_port_asm_dsc_t *asm_dsc);
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+extern int lv_color_blend_to_rgb565_mix_esp(lvgl_port_asm_dsc_t *asm_dsc);
+extern int lv_rgb565_blend_normal_to_rgb565_mix_esp(lvgl_port_asm_dsc_t *asm_dsc);
+#endif
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void lvgl_port_draw_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx);
+static void lvgl_port_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+
+/*******************************************************************************
+* Private API functions
+*******************************************************************************/
+
+void lvgl_port_blend_init(lv_disp_drv_t *drv)
+{
+    assert(drv);
+    /* Set px callback (monochrome) writes the pixels one by one */
+    if (drv->set_px_cb == NULL) {
+        drv->draw_ctx_init = lvgl_port_draw_ctx_init;
+        drv->draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+        drv->draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+    }
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void lvgl_port_draw_ctx_init(lv_disp_drv_t *drv, lv_draw_ctx_t *draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+    ((lv_draw_sw_ctx_t *)draw_ctx)->blend = lvgl_port_blend;
+}
+
+static void lvgl_port_blend(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc)
+{
+    lv_area_t blend_area;
+    if (!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) {
+        return;
+    }
+
+    const lv_opa_t *mask = (dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER) ? NULL : dsc->mask_buf;
+    const bool mix = (mask != NULL || dsc->opa < LV_OPA_MAX);
+    const int32_t w = lv_area_get_width(&blend_area);
+    const int32_t h = lv_area_get_height(&blend_area);
+    lvgl_port_simd_kernel_t kernel;
+
+    if (dsc->blend_mode != LV_BLEND_MODE_NORMAL) {
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+    if (dsc->src_buf == NULL) {
+        kernel = mix ? LVGL_PORT_SIMD_FILL_RGB565_MIX : LVGL_PORT_SIMD_FILL_RGB565;
+    } else {
+        kernel = mix ? LVGL_PORT_SIMD_IMAGE_RGB565_MIX : LVGL_PORT_SIMD_IMAGE_RGB565;
+    }
+#if !CONFIG_IDF_TARGET_ARCH_XTENSA
+    /* Per pixel blending is implemented only for Xtensa targets */
+    if (mix) {
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+#endif
+    if (!lvgl_port_simd_use(kernel, w, h)) {
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    const int32_t dest_w = lv_area_get_width(draw_ctx->buf_area);
+    lv_color_t *dest_buf = (lv_color_t *)draw_ctx->buf;
+    dest_buf += dest_w * (blend_area.y1 - draw_ctx->buf_area->y1) + (blend_area.x1 - draw_ctx->buf_area->x1);
+
+    lvgl_port_asm_dsc_t asm_dsc = {
+        .opa = mix ? dsc->opa : LV_OPA_COVER,
+        .dst_buf = dest_buf,
+        .dst_w = w,
+        .dst_h = h,
+        .dst_stride = dest_w * sizeof(lv_color_t),
+    };
+    if (mask) {
+        const int32_t mask_w = lv_area_get_width(dsc->mask_area);
+        asm_dsc.mask_buf = mask + mask_w * (blend_area.y1 - dsc->mask_area->y1) + (blend_area.x1 - dsc->mask_area->x1);
+        asm_dsc.mask_stride = mask_w;
+    }
+
+    /* The fill kernels take the color in RGB888 (blue, green, red) of LVGL 9 */
+    lv_color32_t color32;
+    if (dsc->src_buf == NULL) {
+        color32.full = lv_color_to32(dsc->color);
+        asm_dsc.src_buf = &color32;
+    } else {
+        const int32_t src_w = lv_area_get_width(dsc->blend_area);
+        asm_dsc.src_buf = dsc->src_buf + src_w * (blend_area.y1 - dsc->blend_area->y1) + (blend_area.x1 - dsc->blend_area->x1);
+        asm_dsc.src_stride = src_w * sizeof(lv_color_t);
+    }
+
+    switch (kernel) {
+    case LVGL_PORT_SIMD_FILL_RGB565:
+        lv_color_blend_to_rgb565_esp(&asm_dsc);
+        break;
+    case LVGL_PORT_SIMD_IMAGE_RGB565:
+        lv_rgb565_blend_normal_to_rgb565_esp(&asm_dsc);
+        break;
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+    case LVGL_PORT_SIMD_FILL_RGB565_MIX:
+        lv_color_blend_to_rgb565_mix_esp(&asm_dsc);
+        break;
+    case LVGL_PORT_SIMD_IMAGE_RGB565_MIX:
+        lv_rgb565_blend_normal_to_rgb565_mix_esp(&asm_dsc);
+        break;
+#endif
+    default:
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        break;
+    }
+}
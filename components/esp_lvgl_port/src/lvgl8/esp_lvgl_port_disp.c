@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -10,6 +10,7 @@
 #include "esp_check.h"
 #include "esp_heap_caps.h"
 #include "esp_idf_version.h"
+#include "esp_timer.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lvgl_port.h"
@@ -32,6 +33,16 @@
 #define LVGL_PORT_HANDLE_FLUSH_READY 1
 #endif
 
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+#define LVGL_PORT_STATS_START(name)             int64_t name = esp_timer_get_time()
+#define LVGL_PORT_STATS_ADD(ctx, field, start)  ((ctx)->stats_cur.field += (esp_timer_get_time() - (start)))
+#define LVGL_PORT_STATS_INC(ctx, field)         ((ctx)->stats_cur.field++)
+#else
+#define LVGL_PORT_STATS_START(name)
+#define LVGL_PORT_STATS_ADD(ctx, field, start)
+#define LVGL_PORT_STATS_INC(ctx, field)
+#endif
+
 static const char *TAG = "LVGL";
 
 /*******************************************************************************
@@ -45,9 +56,17 @@ typedef struct {
     esp_lcd_panel_handle_t    control_handle; /* LCD panel control handle */
     lvgl_port_rotation_cfg_t  rotation;     /* Default values of the screen rotation */
     lv_disp_drv_t             disp_drv;     /* LVGL display driver */
-    lv_color_t                *trans_buf;   /* Buffer send to driver */
+    lv_color_t                *trans_buf[2]; /* Bounce buffers send to driver, one is filled while the other is transmitted */
+    uint8_t                   trans_idx;    /* Index of the next bounce buffer */
     uint32_t                  trans_size;   /* Maximum size for one transport */
-    SemaphoreHandle_t         trans_sem;    /* Idle transfer mutex */
+    SemaphoreHandle_t         trans_sem;    /* Idle transfer mutex (counting semaphore of free bounce buffers with trans_size) */
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+    lvgl_port_disp_counters_t stats_total;    /* Cumulative counters of finished windows */
+    lvgl_port_disp_counters_t stats_window;   /* Counters of the last finished window */
+    lvgl_port_disp_counters_t stats_cur;      /* Counters of the current window */
+    int64_t                   stats_window_start; /* Start of the current window */
+    int64_t                   stats_render_start; /* Start of the current LVGL rendering */
+#endif
 } lvgl_port_display_ctx_t;
 
 /*******************************************************************************
@@ -67,7 +86,14 @@ static bool lvgl_port_flush_dpi_vsync_ready_callback(esp_lcd_panel_handle_t pane
 #endif
 static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
 static void lvgl_port_update_callback(lv_disp_drv_t *drv);
+static void lvgl_port_sync_direct_buffers(lv_disp_drv_t *drv, const lv_color_t *color_map);
 static void lvgl_port_pix_monochrome_callback(lv_disp_drv_t *drv, uint8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa);
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+static void lvgl_port_flush_stats_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
+static void lvgl_port_stats_render_start_callback(lv_disp_drv_t *drv);
+static void lvgl_port_stats_accumulate(lvgl_port_disp_counters_t *dest, const lvgl_port_disp_counters_t *src);
+static void lvgl_port_stats_update_window(lvgl_port_display_ctx_t *disp_ctx, int64_t now);
+#endif
 
 /*******************************************************************************
 * Public API functions
@@ -171,8 +197,18 @@ esp_err_t lvgl_port_remove_disp(lv_disp_t *disp)
     assert(disp_drv);
     lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)disp_drv->user_data;
     if (disp_ctx->trans_sem) {
+        if (disp_ctx->trans_size) {
+            /* Wait for the last transfers from the bounce buffers */
+            xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+            xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+        }
         vSemaphoreDelete(disp_ctx->trans_sem);
     }
+    for (int i = 0; i < 2; i++) {
+        if (disp_ctx->trans_buf[i]) {
+            free(disp_ctx->trans_buf[i]);
+        }
+    }
 
     lv_disp_remove(disp);
 
@@ -203,6 +239,26 @@ void lvgl_port_flush_ready(lv_disp_t *disp)
     lv_disp_flush_ready(disp->driver);
 }
 
+esp_err_t lvgl_port_get_disp_stats(lv_disp_t *disp, lvgl_port_disp_stats_t *stats)
+{
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+    ESP_RETURN_ON_FALSE(disp && disp->driver && stats, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments!");
+    lvgl_port_display_ctx_t *disp_ctx = lvgl_port_get_display_ctx(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "Invalid display!");
+
+    lvgl_port_lock(0);
+    lvgl_port_stats_update_window(disp_ctx, esp_timer_get_time());
+    stats->window = disp_ctx->stats_window;
+    stats->total = disp_ctx->stats_total;
+    lvgl_port_stats_accumulate(&stats->total, &disp_ctx->stats_cur);
+    lvgl_port_unlock();
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
@@ -223,6 +279,7 @@ static lv_disp_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp_cf
     lv_color_t *buf1 = NULL;
     lv_color_t *buf2 = NULL;
     lv_color_t *buf3 = NULL;
+    lv_color_t *buf4 = NULL;
     uint32_t buffer_size = 0;
     SemaphoreHandle_t trans_sem = NULL;
     assert(disp_cfg != NULL);
@@ -271,9 +328,13 @@ static lv_disp_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp_cf
         if (disp_cfg->trans_size) {
             buf3 = heap_caps_malloc(disp_cfg->trans_size * sizeof(lv_color_t), MALLOC_CAP_DMA);
             ESP_GOTO_ON_FALSE(buf3, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for buffer(transport) allocation!");
-            disp_ctx->trans_buf = buf3;
+            disp_ctx->trans_buf[0] = buf3;
+            buf4 = heap_caps_malloc(disp_cfg->trans_size * sizeof(lv_color_t), MALLOC_CAP_DMA);
+            ESP_GOTO_ON_FALSE(buf4, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for buffer(transport) allocation!");
+            disp_ctx->trans_buf[1] = buf4;
 
-            trans_sem = xSemaphoreCreateCounting(1, 0);
+            /* Both bounce buffers are free */
+            trans_sem = xSemaphoreCreateCounting(2, 2);
             ESP_GOTO_ON_FALSE(trans_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create transport counting Semaphore");
             disp_ctx->trans_sem = trans_sem;
         }
@@ -326,6 +387,16 @@ static lv_disp_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp_cf
         disp_ctx->disp_drv.full_refresh = 1;
     }
 
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+    disp_ctx->stats_window_start = esp_timer_get_time();
+    disp_ctx->disp_drv.flush_cb = lvgl_port_flush_stats_callback;
+    disp_ctx->disp_drv.render_start_cb = lvgl_port_stats_render_start_callback;
+#endif
+#if CONFIG_LVGL_PORT_LVGL8_SIMD
+    /* Assembly kernels for the blending of SW renderer */
+    lvgl_port_blend_init(&disp_ctx->disp_drv);
+#endif
+
     disp = lv_disp_drv_register(&disp_ctx->disp_drv);
 
     /* Apply rotation from initial display configuration */
@@ -342,6 +413,9 @@ err:
         if (buf3) {
             free(buf3);
         }
+        if (buf4) {
+            free(buf4);
+        }
         if (trans_sem) {
             vSemaphoreDelete(trans_sem);
         }
@@ -362,13 +436,15 @@ static bool lvgl_port_flush_io_ready_callback(esp_lcd_panel_io_handle_t panel_io
     assert(disp_drv != NULL);
     lvgl_port_display_ctx_t *disp_ctx = disp_drv->user_data;
     assert(disp_ctx != NULL);
-    lv_disp_flush_ready(disp_drv);
 
     if (disp_ctx->trans_size && disp_ctx->trans_sem) {
+        /* Bounce buffer is free, the LVGL buffer was released at the end of flush */
         xSemaphoreGiveFromISR(disp_ctx->trans_sem, &taskAwake);
+    } else {
+        lv_disp_flush_ready(disp_drv);
     }
 
-    return false;
+    return (taskAwake == pdTRUE);
 }
 
 #if (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
@@ -380,13 +456,15 @@ static bool lvgl_port_flush_dpi_panel_ready_callback(esp_lcd_panel_handle_t pane
     assert(disp_drv != NULL);
     lvgl_port_display_ctx_t *disp_ctx = disp_drv->user_data;
     assert(disp_ctx != NULL);
-    lv_disp_flush_ready(disp_drv);
 
     if (disp_ctx->trans_size && disp_ctx->trans_sem) {
+        /* Bounce buffer is free, the LVGL buffer was released at the end of flush */
         xSemaphoreGiveFromISR(disp_ctx->trans_sem, &taskAwake);
+    } else {
+        lv_disp_flush_ready(disp_drv);
     }
 
-    return false;
+    return (taskAwake == pdTRUE);
 }
 
 static bool lvgl_port_flush_dpi_vsync_ready_callback(esp_lcd_panel_handle_t panel_io, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx)
@@ -459,8 +537,15 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
                 /* If the interface is I80 or SPI, this step cannot be used for drawing. */
                 esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, x_start, y_start, x_end + 1, y_end + 1, color_map);
                 /* Waiting for the last frame buffer to complete transmission */
+                LVGL_PORT_STATS_START(wait_start);
                 xSemaphoreTake(disp_ctx->trans_sem, 0);
                 xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+                LVGL_PORT_STATS_ADD(disp_ctx, trans_wait_us, wait_start);
+                LVGL_PORT_STATS_INC(disp_ctx, vsync_waits);
+                /* Only invalidated areas are redrawn in direct mode, copy them into the other frame buffer */
+                if (drv->direct_mode) {
+                    lvgl_port_sync_direct_buffers(drv, color_map);
+                }
             }
         } else {
             esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, x_start, y_start, x_end + 1, y_end + 1, color_map);
@@ -470,6 +555,7 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
             lv_disp_flush_ready(drv);
         }
     } else {
+        /* Ping-pong bounce buffers: a chunk is copied while the previous one is transmitted */
         y_start_tmp = y_start;
         max_line = ((disp_ctx->trans_size / width) > height) ? (height) : (disp_ctx->trans_size / width);
         trans_count = height / max_line + (height % max_line ? (1) : (0));
@@ -478,12 +564,14 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
             trans_line = (y_end - y_start_tmp + 1) > max_line ? max_line : (y_end - y_start_tmp + 1);
             y_end_tmp = (y_end - y_start_tmp + 1) > max_line ? (y_start_tmp + max_line - 1) : y_end;
 
-            to = disp_ctx->trans_buf;
-            for (int y = 0; y < trans_line; y++) {
-                for (int x = 0; x < width; x++) {
-                    *(to + y * (width) + x) = *(from + y * (width) + x);
-                }
-            }
+            /* Wait for a free bounce buffer */
+            LVGL_PORT_STATS_START(wait_start);
+            xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+            LVGL_PORT_STATS_ADD(disp_ctx, trans_wait_us, wait_start);
+            to = disp_ctx->trans_buf[disp_ctx->trans_idx];
+            disp_ctx->trans_idx ^= 1;
+            /* The lines of the area follow each other in LVGL buffer */
+            memcpy(to, from, trans_line * width * sizeof(lv_color_t));
             x_draw_start = x_start;
             x_draw_end = x_end;
             y_draw_start = y_start_tmp;
@@ -492,7 +580,31 @@ static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area,
 
             from += max_line * width;
             y_start_tmp += max_line;
-            xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+        }
+        /* The whole area is in the bounce buffers or sent, LVGL can render into its buffer while the last chunks are transmitted */
+        lv_disp_flush_ready(drv);
+    }
+}
+
+static void lvgl_port_sync_direct_buffers(lv_disp_drv_t *drv, const lv_color_t *color_map)
+{
+    lv_disp_draw_buf_t *draw_buf = drv->draw_buf;
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    if (draw_buf->buf2 == NULL || disp == NULL) {
+        return;
+    }
+
+    /* The other buffer is not displayed after vsync, LVGL renders into it the next frame */
+    lv_color_t *other = (color_map == draw_buf->buf1 ? draw_buf->buf2 : draw_buf->buf1);
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+        if (disp->inv_area_joined[i]) {
+            continue;
+        }
+        const lv_area_t *inv = &disp->inv_areas[i];
+        const uint32_t len = lv_area_get_width(inv) * sizeof(lv_color_t);
+        for (lv_coord_t y = inv->y1; y <= inv->y2; y++) {
+            const uint32_t offset = y * drv->hor_res + inv->x1;
+            memcpy(other + offset, color_map + offset, len);
         }
     }
 }
@@ -537,6 +649,68 @@ static void lvgl_port_update_callback(lv_disp_drv_t *drv)
     }
 }
 
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+static void lvgl_port_stats_accumulate(lvgl_port_disp_counters_t *dest, const lvgl_port_disp_counters_t *src)
+{
+    dest->frames += src->frames;
+    dest->flushes += src->flushes;
+    dest->pixels += src->pixels;
+    dest->render_us += src->render_us;
+    dest->rotate_us += src->rotate_us;
+    dest->monochrome_us += src->monochrome_us;
+    dest->swap_us += src->swap_us;
+    dest->trans_wait_us += src->trans_wait_us;
+    dest->vsync_waits += src->vsync_waits;
+    dest->max_flush_us = LV_MAX(dest->max_flush_us, src->max_flush_us);
+}
+
+static void lvgl_port_stats_update_window(lvgl_port_display_ctx_t *disp_ctx, int64_t now)
+{
+    if (now - disp_ctx->stats_window_start < (int64_t)CONFIG_LVGL_PORT_STATS_WINDOW_MS * 1000) {
+        return;
+    }
+
+    /* Finish current window */
+    lvgl_port_stats_accumulate(&disp_ctx->stats_total, &disp_ctx->stats_cur);
+    disp_ctx->stats_window = disp_ctx->stats_cur;
+    memset(&disp_ctx->stats_cur, 0, sizeof(lvgl_port_disp_counters_t));
+    disp_ctx->stats_window_start = now;
+}
+
+/* LVGL 8 has no render ready event, the rendering of an area ends with its flush */
+static void lvgl_port_stats_render_start_callback(lv_disp_drv_t *drv)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+    disp_ctx->stats_render_start = esp_timer_get_time();
+}
+
+static void lvgl_port_flush_stats_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
+    assert(disp_ctx != NULL);
+
+    int64_t start = esp_timer_get_time();
+    if (disp_ctx->stats_render_start) {
+        disp_ctx->stats_cur.render_us += start - disp_ctx->stats_render_start;
+        disp_ctx->stats_render_start = 0;
+    }
+    lvgl_port_stats_update_window(disp_ctx, start);
+    disp_ctx->stats_cur.flushes++;
+    disp_ctx->stats_cur.pixels += lv_area_get_size(area);
+    if (lv_disp_flush_is_last(drv)) {
+        disp_ctx->stats_cur.frames++;
+    }
+
+    lvgl_port_flush_callback(drv, area, color_map);
+
+    uint32_t flush_us = esp_timer_get_time() - start;
+    if (flush_us > disp_ctx->stats_cur.max_flush_us) {
+        disp_ctx->stats_cur.max_flush_us = flush_us;
+    }
+}
+#endif
+
 static void lvgl_port_pix_monochrome_callback(lv_disp_drv_t *drv, uint8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa)
 {
     if (drv->rotated == LV_DISP_ROT_90 || drv->rotated == LV_DISP_ROT_270) {
@@ -0,0 +1,366 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_fs.h"
+
+static const char *TAG = "LVGL";
+
+#define LVGL_PORT_FS_BLOCK_SIZE_DEFAULT     (4096)
+#define LVGL_PORT_FS_BLOCK_COUNT_DEFAULT    (8)
+#define LVGL_PORT_FS_READ_AHEAD_DEFAULT     (4)
+#define LVGL_PORT_FS_PATH_MAX               (256)
+#define LVGL_PORT_FS_MOUNT_MAX              (32)
+#define LVGL_PORT_FS_NO_BLOCK               (UINT32_MAX)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct lvgl_port_fs_s {
+    lv_fs_drv_t             drv;            /* LVGL driver, registered once and never freed */
+    char                    path[LVGL_PORT_FS_MOUNT_MAX];   /* VFS mount point */
+    size_t                  block_size;
+    uint8_t                 block_count;
+    uint8_t                 read_ahead;
+    uint32_t                caps;           /* Memory capabilities of the cache */
+    bool                    enabled;
+    lvgl_port_fs_stats_t    stats;
+    struct lvgl_port_fs_s   *next;
+} lvgl_port_fs_t;
+
+typedef struct {
+    lvgl_port_fs_t  *fs;
+    int             fd;
+    uint32_t        size;           /* File size */
+    uint32_t        pos;            /* Position of LVGL */
+    uint32_t        fd_pos;         /* Position of the file descriptor */
+    uint32_t        next_block;     /* Block after the last read from the file system, for sequential detection */
+    uint8_t         next_slot;      /* Next cache slot to fill */
+    uint8_t         *buf;           /* Cache slots, block_count * block_size */
+    uint32_t        *slot_block;    /* Block in each slot */
+    uint32_t        *slot_len;      /* Valid bytes in each slot */
+} lvgl_port_fs_file_t;
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static lvgl_port_fs_t *lvgl_port_fs_list = NULL;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void *lvgl_port_fs_open(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode);
+static lv_fs_res_t lvgl_port_fs_close(lv_fs_drv_t *drv, void *file_p);
+static lv_fs_res_t lvgl_port_fs_read(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br);
+static lv_fs_res_t lvgl_port_fs_seek(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence);
+static lv_fs_res_t lvgl_port_fs_tell(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_fs_add(const lvgl_port_fs_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(cfg && cfg->path && strlen(cfg->path) < LVGL_PORT_FS_MOUNT_MAX && cfg->letter >= 'A' && cfg->letter <= 'Z',
+                        ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    const size_t block_size = cfg->block_size ? cfg->block_size : LVGL_PORT_FS_BLOCK_SIZE_DEFAULT;
+    const uint8_t block_count = cfg->block_count ? cfg->block_count : LVGL_PORT_FS_BLOCK_COUNT_DEFAULT;
+    uint8_t read_ahead = cfg->read_ahead ? cfg->read_ahead : LVGL_PORT_FS_READ_AHEAD_DEFAULT;
+    if (read_ahead > block_count) {
+        read_ahead = block_count;
+    }
+
+    lvgl_port_lock(0);
+    lvgl_port_fs_t *fs = lvgl_port_fs_list;
+    while (fs && fs->drv.letter != cfg->letter) {
+        fs = fs->next;
+    }
+    if (fs == NULL) {
+        fs = calloc(1, sizeof(lvgl_port_fs_t));
+        if (fs == NULL) {
+            lvgl_port_unlock();
+            ESP_LOGE(TAG, "Not enough memory for file system driver");
+            return ESP_ERR_NO_MEM;
+        }
+        lv_fs_drv_init(&fs->drv);
+        fs->drv.letter = cfg->letter;
+        fs->drv.cache_size = 0;     /* Cached by this driver */
+        fs->drv.open_cb = lvgl_port_fs_open;
+        fs->drv.close_cb = lvgl_port_fs_close;
+        fs->drv.read_cb = lvgl_port_fs_read;
+        fs->drv.seek_cb = lvgl_port_fs_seek;
+        fs->drv.tell_cb = lvgl_port_fs_tell;
+        fs->drv.user_data = fs;
+        lv_fs_drv_register(&fs->drv);
+        fs->next = lvgl_port_fs_list;
+        lvgl_port_fs_list = fs;
+    }
+    snprintf(fs->path, sizeof(fs->path), "%s", cfg->path);
+    fs->block_size = block_size;
+    fs->block_count = block_count;
+    fs->read_ahead = read_ahead;
+    fs->caps = cfg->flags.buff_spiram ? MALLOC_CAP_SPIRAM : MALLOC_CAP_DEFAULT;
+    fs->enabled = true;
+    lvgl_port_unlock();
+
+    ESP_LOGD(TAG, "File system %c: on %s, %u x %zu B blocks", cfg->letter, cfg->path, block_count, block_size);
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_fs_remove(char letter)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    lvgl_port_lock(0);
+    for (lvgl_port_fs_t *fs = lvgl_port_fs_list; fs; fs = fs->next) {
+        if (fs->drv.letter == letter) {
+            fs->enabled = false;
+            ret = ESP_OK;
+            break;
+        }
+    }
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_fs_get_stats(char letter, lvgl_port_fs_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    lvgl_port_lock(0);
+    for (lvgl_port_fs_t *fs = lvgl_port_fs_list; fs; fs = fs->next) {
+        if (fs->drv.letter == letter) {
+            *stats = fs->stats;
+            if (reset) {
+                memset(&fs->stats, 0, sizeof(lvgl_port_fs_stats_t));
+            }
+            ret = ESP_OK;
+            break;
+        }
+    }
+    lvgl_port_unlock();
+    return ret;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void *lvgl_port_fs_open(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode)
+{
+    lvgl_port_fs_t *fs = (lvgl_port_fs_t *)drv->user_data;
+    if (!fs->enabled || mode != LV_FS_MODE_RD) {
+        return NULL;
+    }
+
+    char full_path[LVGL_PORT_FS_PATH_MAX];
+    const int len = snprintf(full_path, sizeof(full_path), "%s%s%s", fs->path, (path[0] == '/') ? "" : "/", path);
+    if (len < 0 || len >= (int)sizeof(full_path)) {
+        return NULL;
+    }
+
+    /* Bookkeeping of slots is small, in internal RAM */
+    lvgl_port_fs_file_t *file = calloc(1, sizeof(lvgl_port_fs_file_t) + fs->block_count * 2 * sizeof(uint32_t));
+    if (file == NULL) {
+        return NULL;
+    }
+    file->buf = heap_caps_malloc(fs->block_count * fs->block_size, fs->caps);
+    if (file->buf == NULL) {
+        ESP_LOGW(TAG, "Not enough memory for file cache");
+        free(file);
+        return NULL;
+    }
+    file->fd = open(full_path, O_RDONLY);
+    struct stat st;
+    if (file->fd < 0 || fstat(file->fd, &st) != 0) {
+        if (file->fd >= 0) {
+            close(file->fd);
+        }
+        free(file->buf);
+        free(file);
+        return NULL;
+    }
+
+    file->fs = fs;
+    file->size = st.st_size;
+    file->slot_block = (uint32_t *)(file + 1);
+    file->slot_len = file->slot_block + fs->block_count;
+    for (int i = 0; i < fs->block_count; i++) {
+        file->slot_block[i] = LVGL_PORT_FS_NO_BLOCK;
+    }
+    /* Reading from the start is sequential */
+    file->next_block = 0;
+    return file;
+}
+
+static lv_fs_res_t lvgl_port_fs_close(lv_fs_drv_t *drv, void *file_p)
+{
+    lvgl_port_fs_file_t *file = (lvgl_port_fs_file_t *)file_p;
+    close(file->fd);
+    free(file->buf);
+    free(file);
+    return LV_FS_RES_OK;
+}
+
+static bool lvgl_port_fs_fd_seek(lvgl_port_fs_file_t *file, uint32_t pos)
+{
+    if (file->fd_pos != pos) {
+        if (lseek(file->fd, pos, SEEK_SET) != (off_t)pos) {
+            return false;
+        }
+        file->fd_pos = pos;
+    }
+    return true;
+}
+
+/* Read blocks from the file system to the cache, returns the slot of the first one or -1 */
+static int lvgl_port_fs_fetch(lvgl_port_fs_file_t *file, uint32_t block)
+{
+    lvgl_port_fs_t *fs = file->fs;
+    const uint32_t block_num = (file->size + fs->block_size - 1) / fs->block_size;
+
+    /* Read ahead only in sequential reading, the blocks are in adjacent slots */
+    uint32_t count = (block == file->next_block) ? fs->read_ahead : 1;
+    if (count > block_num - block) {
+        count = block_num - block;
+    }
+    if (file->next_slot + count > fs->block_count) {
+        file->next_slot = 0;
+    }
+
+    const int slot = file->next_slot;
+    for (uint32_t i = 0; i < count; i++) {
+        file->slot_block[slot + i] = LVGL_PORT_FS_NO_BLOCK;
+    }
+    if (!lvgl_port_fs_fd_seek(file, block * fs->block_size)) {
+        return -1;
+    }
+    const ssize_t len = read(file->fd, file->buf + slot * fs->block_size, count * fs->block_size);
+    if (len <= 0) {
+        return -1;
+    }
+    file->fd_pos += len;
+    fs->stats.misses++;
+
+    size_t left = len;
+    for (uint32_t i = 0; i < count && left > 0; i++) {
+        file->slot_block[slot + i] = block + i;
+        file->slot_len[slot + i] = (left < fs->block_size) ? left : fs->block_size;
+        left -= file->slot_len[slot + i];
+    }
+    file->next_slot = (slot + count) % fs->block_count;
+    file->next_block = block + count;
+    return slot;
+}
+
+static lv_fs_res_t lvgl_port_fs_read(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br)
+{
+    lvgl_port_fs_file_t *file = (lvgl_port_fs_file_t *)file_p;
+    lvgl_port_fs_t *fs = file->fs;
+    uint8_t *out = buf;
+    *br = 0;
+
+    if (file->pos >= file->size) {
+        return LV_FS_RES_OK;
+    }
+    if (btr > file->size - file->pos) {
+        btr = file->size - file->pos;
+    }
+
+    while (btr > 0) {
+        const uint32_t block = file->pos / fs->block_size;
+        const uint32_t offset = file->pos % fs->block_size;
+
+        int slot = -1;
+        for (int i = 0; i < fs->block_count; i++) {
+            if (file->slot_block[i] == block) {
+                slot = i;
+                break;
+            }
+        }
+
+        if (slot < 0 && offset == 0 && btr >= fs->block_size) {
+            /* Whole blocks are read directly to the output */
+            const uint32_t len = btr - btr % fs->block_size;
+            if (!lvgl_port_fs_fd_seek(file, file->pos)) {
+                return LV_FS_RES_FS_ERR;
+            }
+            const ssize_t got = read(file->fd, out, len);
+            if (got <= 0) {
+                return (*br > 0) ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+            }
+            fs->stats.direct++;
+            file->fd_pos += got;
+            file->pos += got;
+            file->next_block = file->pos / fs->block_size;
+            out += got;
+            *br += got;
+            btr -= got;
+            continue;
+        }
+
+        if (slot < 0) {
+            slot = lvgl_port_fs_fetch(file, block);
+            if (slot < 0) {
+                return (*br > 0) ? LV_FS_RES_OK : LV_FS_RES_FS_ERR;
+            }
+        } else {
+            fs->stats.hits++;
+        }
+
+        if (offset >= file->slot_len[slot]) {
+            break;  /* File is shorter than at open */
+        }
+        uint32_t len = file->slot_len[slot] - offset;
+        if (len > btr) {
+            len = btr;
+        }
+        memcpy(out, file->buf + slot * fs->block_size + offset, len);
+        file->pos += len;
+        out += len;
+        *br += len;
+        btr -= len;
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t lvgl_port_fs_seek(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    lvgl_port_fs_file_t *file = (lvgl_port_fs_file_t *)file_p;
+    switch (whence) {
+    case LV_FS_SEEK_SET:
+        file->pos = pos;
+        break;
+    case LV_FS_SEEK_CUR:
+        file->pos += pos;
+        break;
+    case LV_FS_SEEK_END:
+        file->pos = file->size + pos;
+        break;
+    default:
+        return LV_FS_RES_INV_PARAM;
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t lvgl_port_fs_tell(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p)
+{
+    lvgl_port_fs_file_t *file = (lvgl_port_fs_file_t *)file_p;
+    *pos_p = file->pos;
+    return LV_FS_RES_OK;
+}
@@ -14,27 +14,79 @@
 #include "freertos/portmacro.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
 #include "esp_lvgl_port.h"
 #include "esp_lvgl_port_priv.h"
 #include "lvgl.h"
 
+#if CONFIG_LVGL_PORT_TICKLESS && CONFIG_PM_ENABLE
+#include "esp_pm.h"
+#define LVGL_PORT_PM_LOCK   1
+#endif
+
 static const char *TAG = "LVGL";
 
 #define ESP_LVGL_PORT_TASK_MUX_DELAY_MS    10000
+#define ESP_LVGL_PORT_TASK_YIELD_BUDGET_MS 10
+#define ESP_LVGL_PORT_IDLE_TIMEOUT_MS      3000
+
+/* LVGL task notification bits */
+#define LVGL_PORT_NOTIFY_DISPLAY    (1 << 0)
+#define LVGL_PORT_NOTIFY_TOUCH      (1 << 1)
+#define LVGL_PORT_NOTIFY_USER       (1 << 2)
+#define LVGL_PORT_NOTIFY_VSYNC      (1 << 3)
+#define LVGL_PORT_NOTIFY_ASYNC      (1 << 4)
+
+/* Number of different input devices/displays remembered between two loops of LVGL task, more are handled all */
+#define LVGL_PORT_PENDING_MAX       (4)
 
 /*******************************************************************************
 * Types definitions
 *******************************************************************************/
 
+typedef struct {
+    lvgl_port_async_cb_t cb;
+    void                 *user_data;
+} lvgl_port_async_item_t;
+
+/* Set of input devices or displays, which signalled since the last loop of LVGL task */
+typedef struct {
+    void                *items[LVGL_PORT_PENDING_MAX];
+    uint8_t             count;
+    bool                all;            /* Signalled without handle or too many, all are handled */
+} lvgl_port_pending_t;
+
 typedef struct lvgl_port_ctx_s {
     TaskHandle_t        lvgl_task;
     SemaphoreHandle_t   lvgl_mux;
     SemaphoreHandle_t   timer_mux;
-    QueueHandle_t       lvgl_queue;
     SemaphoreHandle_t   task_init_mux;
+    QueueHandle_t       async_queue;    /* Queue of callbacks executed in LVGL task */
     esp_timer_handle_t  tick_timer;
+#if LVGL_PORT_PM_LOCK
+    esp_pm_lock_handle_t pm_lock;       /* CPU frequency lock held while LVGL task is awake */
+#endif
+    portMUX_TYPE        event_lock;     /* Lock of pending events */
+    uint32_t            pending;        /* Events (LVGL_PORT_NOTIFY_*) since the last loop, taken at once by LVGL task */
+    uint32_t            notified;       /* Pending events, which already woke LVGL task */
+    lvgl_port_pending_t touch_pending;  /* Input devices to read */
+    lvgl_port_pending_t sync_pending;   /* Displays with vsync */
+    uint32_t            frame_period_ms; /* Refresh period of displays (0 is not changed) */
+    uint32_t            idle_period_ms; /* Refresh and input read period in idle (0 is disabled) */
+    uint32_t            idle_timeout_ms; /* Time without events, after which the UI is idle */
+    int64_t             activity_time;  /* Time of the last invalidation or input event */
+    bool                idle;           /* UI is idle, timers are slowed down */
+#if CONFIG_LVGL_PORT_ENABLE_LOCK_STATS
+    portMUX_TYPE        stats_lock;     /* Lock of LVGL lock statistics */
+    lvgl_port_lock_stats_t lock_stats;  /* LVGL lock statistics */
+    volatile TaskHandle_t lock_owner;   /* Task holding LVGL lock */
+    uint32_t            lock_depth;     /* Recursion depth of LVGL lock (changed only by the owner) */
+    int64_t             lock_start;     /* Time of the outermost LVGL lock take */
+#endif
     bool                running;
+    volatile bool       stopped;        /* Stopped by lvgl_port_stop, the task waits for events only */
     int                 task_max_sleep_ms;
+    int                 task_yield_budget_ms;
     int                 timer_period_ms;
 } lvgl_port_ctx_t;
 
@@ -49,6 +101,12 @@ static lvgl_port_ctx_t lvgl_port_ctx;
 static void lvgl_port_task(void *arg);
 static esp_err_t lvgl_port_tick_init(void);
 static void lvgl_port_task_deinit(void);
+static void lvgl_port_pacing_update(uint32_t events);
+static inline __attribute__((always_inline)) void lvgl_port_pending_add(lvgl_port_pending_t *pending, void *item);
+#if CONFIG_LVGL_PORT_ENABLE_LOCK_STATS
+static bool lvgl_port_lock_take_stats(TickType_t timeout_ticks);
+static void lvgl_port_lock_give_stats(void);
+#endif
 
 /*******************************************************************************
 * Public API functions
@@ -69,18 +127,48 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     if (lvgl_port_ctx.task_max_sleep_ms == 0) {
         lvgl_port_ctx.task_max_sleep_ms = 500;
     }
+    lvgl_port_ctx.task_yield_budget_ms = cfg->task_yield_budget_ms;
+    if (lvgl_port_ctx.task_yield_budget_ms == 0) {
+        lvgl_port_ctx.task_yield_budget_ms = ESP_LVGL_PORT_TASK_YIELD_BUDGET_MS;
+    }
+    portMUX_INITIALIZE(&lvgl_port_ctx.event_lock);
+    /* Frame pacing */
+    ESP_GOTO_ON_FALSE(cfg->target_fps >= 0 && cfg->idle_fps >= 0, ESP_ERR_INVALID_ARG, err, TAG, "Bad FPS value!");
+    lvgl_port_ctx.frame_period_ms = (cfg->target_fps > 0 ? LV_MAX(1000 / cfg->target_fps, 1) : 0);
+    lvgl_port_ctx.idle_period_ms = (cfg->idle_fps > 0 ? LV_MAX(1000 / cfg->idle_fps, 1) : 0);
+    lvgl_port_ctx.idle_timeout_ms = (cfg->idle_timeout_ms > 0 ? cfg->idle_timeout_ms : ESP_LVGL_PORT_IDLE_TIMEOUT_MS);
+#if LVGL_PORT_PM_LOCK
+    /* Run LVGL on maximum frequency, allow light sleep when the task is sleeping */
+    ESP_GOTO_ON_ERROR(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "LVGL", &lvgl_port_ctx.pm_lock), err, TAG, "Create PM lock fail!");
+#endif
+#if !CONFIG_LVGL_PORT_TICKLESS
     /* Timer semaphore */
     lvgl_port_ctx.timer_mux = xSemaphoreCreateMutex();
     ESP_GOTO_ON_FALSE(lvgl_port_ctx.timer_mux, ESP_ERR_NO_MEM, err, TAG, "Create timer mutex fail!");
+#endif
     /* LVGL semaphore */
     lvgl_port_ctx.lvgl_mux = xSemaphoreCreateRecursiveMutex();
     ESP_GOTO_ON_FALSE(lvgl_port_ctx.lvgl_mux, ESP_ERR_NO_MEM, err, TAG, "Create LVGL mutex fail!");
     /* Task init semaphore */
     lvgl_port_ctx.task_init_mux = xSemaphoreCreateMutex();
     ESP_GOTO_ON_FALSE(lvgl_port_ctx.task_init_mux, ESP_ERR_NO_MEM, err, TAG, "Create LVGL task sem fail!");
-    /* Task queue */
-    lvgl_port_ctx.lvgl_queue = xQueueCreate(100, sizeof(lvgl_port_event_t));
-    ESP_GOTO_ON_FALSE(lvgl_port_ctx.lvgl_queue, ESP_ERR_NO_MEM, err, TAG, "Create LVGL queue fail!");
+    /* Async call queue */
+    lvgl_port_ctx.async_queue = xQueueCreate(CONFIG_LVGL_PORT_ASYNC_QUEUE_LEN, sizeof(lvgl_port_async_item_t));
+    ESP_GOTO_ON_FALSE(lvgl_port_ctx.async_queue, ESP_ERR_NO_MEM, err, TAG, "Create LVGL async queue fail!");
+#if CONFIG_LVGL_PORT_ENABLE_LOCK_STATS
+    portMUX_INITIALIZE(&lvgl_port_ctx.stats_lock);
+#endif
+    /* LVGL draw threads (created in lv_init) */
+    ESP_GOTO_ON_FALSE(cfg->draw_task_affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, err, TAG, "Bad core number for draw task! Maximum core number is %d", (configNUM_CORES - 1));
+    lvgl_port_os_config(cfg->task_priority, cfg->draw_task_affinity);
+    /* Assembly blend kernels (used from lv_init) */
+    lvgl_port_simd_config(cfg->simd);
+    /* Display flush tasks on the core of LVGL task */
+    lvgl_port_disp_task_config(cfg->task_affinity);
+    /* Image cache (resized after lv_init) and prefetch task */
+    lvgl_port_image_config(cfg->image_cache_size, cfg->task_affinity);
+    /* Glyph cache (created with the first cached font) */
+    lvgl_port_font_config(cfg->glyph_cache_size);
 
     BaseType_t res;
     if (cfg->task_affinity < 0) {
@@ -107,11 +195,25 @@ esp_err_t lvgl_port_resume(void)
 {
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
+#if CONFIG_LVGL_PORT_TICKLESS
+    /* No periodic timer, LVGL tick is read from esp_timer */
+    if (lvgl_port_ctx.running) {
+        lv_timer_enable(true);
+        ret = ESP_OK;
+    }
+#endif
+
     if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(true);
         ret = esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_ctx.timer_period_ms * 1000);
     }
 
+    /* Wake the task from waiting without timeout */
+    if (ret == ESP_OK && lvgl_port_ctx.stopped) {
+        lvgl_port_ctx.stopped = false;
+        xTaskNotify(lvgl_port_ctx.lvgl_task, LVGL_PORT_NOTIFY_USER, eSetBits);
+    }
+
     return ret;
 }
 
@@ -119,16 +221,34 @@ esp_err_t lvgl_port_stop(void)
 {
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
+#if CONFIG_LVGL_PORT_TICKLESS
+    if (lvgl_port_ctx.running) {
+        lv_timer_enable(false);
+        ret = ESP_OK;
+    }
+#endif
+
     if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(false);
         ret = esp_timer_stop(lvgl_port_ctx.tick_timer);
     }
 
+    if (ret == ESP_OK) {
+        lvgl_port_ctx.stopped = true;
+    }
+
     return ret;
 }
 
 esp_err_t lvgl_port_deinit(void)
 {
+    /* Image prefetch task uses LVGL lock */
+    lvgl_port_image_deinit();
+    /* Glyphs of cached fonts */
+    lvgl_port_font_deinit();
+    /* Unfinished preloaded screens */
+    lvgl_port_preload_deinit();
+
     /* Stop and delete timer */
     if (lvgl_port_ctx.tick_timer != NULL) {
         esp_timer_stop(lvgl_port_ctx.tick_timer);
@@ -139,6 +259,8 @@ esp_err_t lvgl_port_deinit(void)
     /* Stop running task */
     if (lvgl_port_ctx.running) {
         lvgl_port_ctx.running = false;
+        /* Wake up the task from sleep */
+        xTaskNotify(lvgl_port_ctx.lvgl_task, LVGL_PORT_NOTIFY_USER, eSetBits);
     }
 
     /* Wait for stop task */
@@ -158,39 +280,163 @@ bool lvgl_port_lock(uint32_t timeout_ms)
     assert(lvgl_port_ctx.lvgl_mux && "lvgl_port_init must be called first");
 
     const TickType_t timeout_ticks = (timeout_ms == 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
-    return xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE;
+    LVGL_PORT_TRACE_BEGIN(LVGL_PORT_TRACE_LOCK_WAIT);
+#if CONFIG_LVGL_PORT_ENABLE_LOCK_STATS
+    const bool ret = lvgl_port_lock_take_stats(timeout_ticks);
+#else
+    const bool ret = (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE);
+#endif
+    LVGL_PORT_TRACE_END(LVGL_PORT_TRACE_LOCK_WAIT);
+    return ret;
 }
 
 void lvgl_port_unlock(void)
 {
     assert(lvgl_port_ctx.lvgl_mux && "lvgl_port_init must be called first");
+#if CONFIG_LVGL_PORT_ENABLE_LOCK_STATS
+    lvgl_port_lock_give_stats();
+#endif
     xSemaphoreGiveRecursive(lvgl_port_ctx.lvgl_mux);
 }
 
 esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param)
 {
-    if (!lvgl_port_ctx.lvgl_queue) {
+    if (!lvgl_port_ctx.lvgl_task || !lvgl_port_ctx.running) {
         return ESP_ERR_INVALID_STATE;
     }
 
-    lvgl_port_event_t ev = {
-        .type = event,
-        .param = param,
+    uint32_t bits = LVGL_PORT_NOTIFY_USER;
+    if (event == LVGL_PORT_EVENT_DISPLAY) {
+        bits = LVGL_PORT_NOTIFY_DISPLAY;
+    } else if (event == LVGL_PORT_EVENT_TOUCH) {
+        bits = LVGL_PORT_NOTIFY_TOUCH;
+    }
+
+    /* Events from LVGL task itself (invalidations in LVGL timers and animations) are taken in its next loop */
+    const bool in_isr = (xPortInIsrContext() == pdTRUE);
+    const bool from_lvgl_task = !in_isr && (xTaskGetCurrentTaskHandle() == lvgl_port_ctx.lvgl_task);
+
+    portENTER_CRITICAL_SAFE(&lvgl_port_ctx.event_lock);
+    if (event == LVGL_PORT_EVENT_TOUCH) {
+        lvgl_port_pending_add(&lvgl_port_ctx.touch_pending, param);
+    }
+    lvgl_port_ctx.pending |= bits;
+    /* Repeated events wake the task only once, until it takes them */
+    const bool notify = !from_lvgl_task && (lvgl_port_ctx.notified & bits) != bits;
+    if (notify) {
+        lvgl_port_ctx.notified |= bits;
+    }
+    portEXIT_CRITICAL_SAFE(&lvgl_port_ctx.event_lock);
+
+    if (!notify) {
+        return ESP_OK;
+    }
+    if (in_isr) {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        xTaskNotifyFromISR(lvgl_port_ctx.lvgl_task, bits, eSetBits, &xHigherPriorityTaskWoken);
+        if (xHigherPriorityTaskWoken) {
+            portYIELD_FROM_ISR( );
+        }
+    } else {
+        xTaskNotify(lvgl_port_ctx.lvgl_task, bits, eSetBits);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_async_call(lvgl_port_async_cb_t cb, void *user_data)
+{
+    ESP_RETURN_ON_FALSE(cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!lvgl_port_ctx.async_queue || !lvgl_port_ctx.running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const lvgl_port_async_item_t item = {
+        .cb = cb,
+        .user_data = user_data,
     };
 
     if (xPortInIsrContext() == pdTRUE) {
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        xQueueSendFromISR(lvgl_port_ctx.lvgl_queue, &ev, &xHigherPriorityTaskWoken);
+        if (xQueueSendFromISR(lvgl_port_ctx.async_queue, &item, &xHigherPriorityTaskWoken) != pdTRUE) {
+            return ESP_ERR_NO_MEM;
+        }
+        xTaskNotifyFromISR(lvgl_port_ctx.lvgl_task, LVGL_PORT_NOTIFY_ASYNC, eSetBits, &xHigherPriorityTaskWoken);
         if (xHigherPriorityTaskWoken) {
             portYIELD_FROM_ISR( );
         }
     } else {
-        xQueueSend(lvgl_port_ctx.lvgl_queue, &ev, 0);
+        if (xQueueSend(lvgl_port_ctx.async_queue, &item, 0) != pdTRUE) {
+            return ESP_ERR_NO_MEM;
+        }
+        xTaskNotify(lvgl_port_ctx.lvgl_task, LVGL_PORT_NOTIFY_ASYNC, eSetBits);
     }
 
     return ESP_OK;
 }
 
+esp_err_t lvgl_port_async_call_wait(lvgl_port_async_cb_t cb, void *user_data, TickType_t timeout)
+{
+    ESP_RETURN_ON_FALSE(cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (!lvgl_port_ctx.async_queue || !lvgl_port_ctx.running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    assert(xPortInIsrContext() == pdFALSE && xTaskGetCurrentTaskHandle() != lvgl_port_ctx.lvgl_task);
+
+    const lvgl_port_async_item_t item = {
+        .cb = cb,
+        .user_data = user_data,
+    };
+    if (xQueueSend(lvgl_port_ctx.async_queue, &item, timeout) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    xTaskNotify(lvgl_port_ctx.lvgl_task, LVGL_PORT_NOTIFY_ASYNC, eSetBits);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_get_lock_stats(lvgl_port_lock_stats_t *stats, bool reset)
+{
+#if CONFIG_LVGL_PORT_ENABLE_LOCK_STATS
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(lvgl_port_ctx.lvgl_mux, ESP_ERR_INVALID_STATE, TAG, "LVGL port is not initialized");
+
+    portENTER_CRITICAL(&lvgl_port_ctx.stats_lock);
+    *stats = lvgl_port_ctx.lock_stats;
+    if (reset) {
+        memset(&lvgl_port_ctx.lock_stats, 0, sizeof(lvgl_port_ctx.lock_stats));
+    }
+    portEXIT_CRITICAL(&lvgl_port_ctx.stats_lock);
+    stats->owner = lvgl_port_ctx.lock_owner;
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+IRAM_ATTR bool lvgl_port_task_frame_sync(lv_display_t *disp)
+{
+    BaseType_t need_yield = pdFALSE;
+
+    if (!lvgl_port_ctx.lvgl_task || !lvgl_port_ctx.running) {
+        return false;
+    }
+
+    portENTER_CRITICAL_ISR(&lvgl_port_ctx.event_lock);
+    lvgl_port_pending_add(&lvgl_port_ctx.sync_pending, disp);
+    lvgl_port_ctx.pending |= LVGL_PORT_NOTIFY_VSYNC;
+    const bool notify = !(lvgl_port_ctx.notified & LVGL_PORT_NOTIFY_VSYNC);
+    lvgl_port_ctx.notified |= LVGL_PORT_NOTIFY_VSYNC;
+    portEXIT_CRITICAL_ISR(&lvgl_port_ctx.event_lock);
+
+    if (notify) {
+        xTaskNotifyFromISR(lvgl_port_ctx.lvgl_task, LVGL_PORT_NOTIFY_VSYNC, eSetBits, &need_yield);
+    }
+
+    return (need_yield == pdTRUE);
+}
+
 IRAM_ATTR bool lvgl_port_task_notify(uint32_t value)
 {
     BaseType_t need_yield = pdFALSE;
@@ -205,16 +451,41 @@ IRAM_ATTR bool lvgl_port_task_notify(uint32_t value)
     return (need_yield == pdTRUE);
 }
 
+bool lvgl_port_is_stopped(void)
+{
+    return lvgl_port_ctx.stopped;
+}
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
 
+/* Called from ISR (vsync), must be inlined into IRAM functions */
+static inline __attribute__((always_inline)) void lvgl_port_pending_add(lvgl_port_pending_t *pending, void *item)
+{
+    if (pending->all) {
+        return;
+    }
+    if (item == NULL || pending->count >= LVGL_PORT_PENDING_MAX) {
+        pending->all = true;
+        return;
+    }
+    for (int i = 0; i < pending->count; i++) {
+        if (pending->items[i] == item) {
+            return;
+        }
+    }
+    pending->items[pending->count++] = item;
+}
+
 static void lvgl_port_task(void *arg)
 {
     TaskHandle_t task_to_notify = (TaskHandle_t)arg;
-    lvgl_port_event_t event;
+    uint32_t events = 0;
     uint32_t task_delay_ms = 0;
     lv_indev_t *indev = NULL;
+    lv_display_t *disp = NULL;
+    int64_t busy_start = esp_timer_get_time();
 
     /* Take the task semaphore */
     if (xSemaphoreTake(lvgl_port_ctx.task_init_mux, 0) != pdTRUE) {
@@ -225,25 +496,75 @@ static void lvgl_port_task(void *arg)
 
     /* LVGL init */
     lv_init();
+    /* DMA draw unit (CONFIG_LVGL_PORT_DRAW_DMA) */
+    lvgl_port_draw_dma_init();
+    /* Image cache size (lvgl_port_cfg_t.image_cache_size) */
+    lvgl_port_image_cache_init();
     /* LVGL is initialized, notify lvgl_port_init() function about it */
     xTaskNotifyGive(task_to_notify);
     /* Tick init */
     lvgl_port_tick_init();
 
     ESP_LOGI(TAG, "Starting LVGL task");
+#if LVGL_PORT_PM_LOCK
+    esp_pm_lock_acquire(lvgl_port_ctx.pm_lock);
+#endif
+    lvgl_port_ctx.activity_time = esp_timer_get_time();
     lvgl_port_ctx.running = true;
     while (lvgl_port_ctx.running) {
-        /* Wait for queue or timeout (sleep task) */
-        TickType_t wait = (pdMS_TO_TICKS(task_delay_ms) >= 1 ? pdMS_TO_TICKS(task_delay_ms) : 1);
-        xQueueReceive(lvgl_port_ctx.lvgl_queue, &event, wait);
+        /* Running for too long without sleep (events all the time), let other tasks run */
+        if (esp_timer_get_time() - busy_start >= (int64_t)lvgl_port_ctx.task_yield_budget_ms * 1000) {
+            vTaskDelay(1);
+            busy_start = esp_timer_get_time();
+        }
+
+        /* Sleep until the next LVGL timer is due (rounded up to ticks) or until an event is notified, only events when stopped */
+        TickType_t wait = (task_delay_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+        if (lvgl_port_ctx.stopped) {
+            wait = portMAX_DELAY;
+        }
+        /* Events from this task did not notify */
+        portENTER_CRITICAL(&lvgl_port_ctx.event_lock);
+        if (lvgl_port_ctx.pending & ~lvgl_port_ctx.notified) {
+            wait = 0;
+        }
+        portEXIT_CRITICAL(&lvgl_port_ctx.event_lock);
+#if LVGL_PORT_PM_LOCK
+        esp_pm_lock_release(lvgl_port_ctx.pm_lock);
+#endif
+        events = 0;
+        if (xTaskNotifyWait(0, UINT32_MAX, &events, wait) == pdFALSE && wait > 0) {
+            busy_start = esp_timer_get_time();
+        }
+#if LVGL_PORT_PM_LOCK
+        esp_pm_lock_acquire(lvgl_port_ctx.pm_lock);
+#endif
+
+        /* Take all pending events at once, the next events wake the task again */
+        portENTER_CRITICAL(&lvgl_port_ctx.event_lock);
+        events |= lvgl_port_ctx.pending;
+        lvgl_port_ctx.pending = 0;
+        lvgl_port_ctx.notified = 0;
+        lvgl_port_pending_t touch = lvgl_port_ctx.touch_pending;
+        lvgl_port_ctx.touch_pending.count = 0;
+        lvgl_port_ctx.touch_pending.all = false;
+        lvgl_port_pending_t sync = lvgl_port_ctx.sync_pending;
+        lvgl_port_ctx.sync_pending.count = 0;
+        lvgl_port_ctx.sync_pending.all = false;
+        portEXIT_CRITICAL(&lvgl_port_ctx.event_lock);
 
         if (lv_display_get_default() && lvgl_port_lock(0)) {
+            LVGL_PORT_TRACE_BEGIN(LVGL_PORT_TRACE_TASK);
 
-            /* Call read input devices */
-            if (event.type == LVGL_PORT_EVENT_TOUCH) {
+            /* Read input devices, which signalled */
+            if (touch.all || touch.count > 0) {
+#if !CONFIG_LVGL_PORT_TICKLESS
                 xSemaphoreTake(lvgl_port_ctx.timer_mux, portMAX_DELAY);
-                if (event.param != NULL) {
-                    lv_indev_read(event.param);
+#endif
+                if (!touch.all) {
+                    for (int i = 0; i < touch.count; i++) {
+                        lv_indev_read(touch.items[i]);
+                    }
                 } else {
                     indev = lv_indev_get_next(NULL);
                     while (indev != NULL) {
@@ -251,24 +572,55 @@ static void lvgl_port_task(void *arg)
                         indev = lv_indev_get_next(indev);
                     }
                 }
+#if !CONFIG_LVGL_PORT_TICKLESS
                 xSemaphoreGive(lvgl_port_ctx.timer_mux);
+#endif
+            }
+
+            /* Execute queued callbacks (limited by queue length, new callbacks wait for the next cycle) */
+            lvgl_port_async_item_t item;
+            for (int i = 0; i < CONFIG_LVGL_PORT_ASYNC_QUEUE_LEN && xQueueReceive(lvgl_port_ctx.async_queue, &item, 0) == pdTRUE; i++) {
+                item.cb(item.user_data);
+            }
+
+            /* Start refresh of vsync paced displays */
+            if (sync.all || sync.count > 0) {
+                if (!sync.all) {
+                    for (int i = 0; i < sync.count; i++) {
+                        lvgl_port_disp_frame_sync(sync.items[i], lvgl_port_ctx.frame_period_ms);
+                    }
+                } else {
+                    disp = lv_display_get_next(NULL);
+                    while (disp != NULL) {
+                        lvgl_port_disp_frame_sync(disp, lvgl_port_ctx.frame_period_ms);
+                        disp = lv_display_get_next(disp);
+                    }
+                }
             }
 
+            lvgl_port_pacing_update(events);
+
             /* Handle LVGL */
             task_delay_ms = lv_timer_handler();
+            if (task_delay_ms == LV_NO_TIMER_READY) {
+                task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
+            }
+
+            /* Build preloaded screens in the time left to the next LVGL timer */
+            if (!lvgl_port_ctx.stopped) {
+                task_delay_ms = lvgl_port_preload_run(task_delay_ms);
+            }
+            LVGL_PORT_TRACE_END(LVGL_PORT_TRACE_TASK);
             lvgl_port_unlock();
         } else {
             task_delay_ms = 1; /*Keep trying*/
         }
-
-        if (task_delay_ms == LV_NO_TIMER_READY) {
-            task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
-        }
-
-        /* Minimal dealy for the task. When there is too much events, it takes time for other tasks and interrupts. */
-        vTaskDelay(1);
     }
 
+#if LVGL_PORT_PM_LOCK
+    esp_pm_lock_release(lvgl_port_ctx.pm_lock);
+#endif
+
     /* Give semaphore back */
     xSemaphoreGive(lvgl_port_ctx.task_init_mux);
 
@@ -276,6 +628,122 @@ static void lvgl_port_task(void *arg)
     vTaskDelete( NULL );
 }
 
+static void lvgl_port_pacing_update(uint32_t events)
+{
+    if (lvgl_port_ctx.frame_period_ms == 0 && lvgl_port_ctx.idle_period_ms == 0) {
+        return;
+    }
+
+    /* UI is idle after idle_timeout_ms without invalidation and input events */
+    const int64_t now = esp_timer_get_time();
+    bool idle = lvgl_port_ctx.idle;
+    if (events & (LVGL_PORT_NOTIFY_DISPLAY | LVGL_PORT_NOTIFY_TOUCH)) {
+        lvgl_port_ctx.activity_time = now;
+        idle = false;
+    } else if (lvgl_port_ctx.idle_period_ms > 0 && now - lvgl_port_ctx.activity_time >= (int64_t)lvgl_port_ctx.idle_timeout_ms * 1000) {
+        idle = true;
+    }
+
+    /* Refresh period (displays can be added anytime) */
+    uint32_t period_ms = (lvgl_port_ctx.frame_period_ms > 0 ? lvgl_port_ctx.frame_period_ms : LV_DEF_REFR_PERIOD);
+    if (idle) {
+        period_ms = lvgl_port_ctx.idle_period_ms;
+    }
+    lv_display_t *disp = lv_display_get_next(NULL);
+    while (disp != NULL) {
+        lvgl_port_disp_set_refr_period(disp, period_ms);
+        disp = lv_display_get_next(disp);
+    }
+
+    /* Input read period, changed only on idle state change */
+    if (idle != lvgl_port_ctx.idle) {
+        lv_indev_t *indev = lv_indev_get_next(NULL);
+        while (indev != NULL) {
+            lv_timer_t *read_timer = lv_indev_get_read_timer(indev);
+            if (read_timer) {
+                lv_timer_set_period(read_timer, idle ? lvgl_port_ctx.idle_period_ms : LV_DEF_REFR_PERIOD);
+            }
+            indev = lv_indev_get_next(indev);
+        }
+        lvgl_port_ctx.idle = idle;
+    }
+}
+
+#if CONFIG_LVGL_PORT_ENABLE_LOCK_STATS
+static inline uint32_t lvgl_port_lock_hist_bin(uint32_t us)
+{
+    /* Bins of 16 us * 4^i */
+    uint32_t bin = 0;
+    us >>= 4;
+    while (us > 0 && bin < LVGL_PORT_LOCK_HIST_BINS - 1) {
+        us >>= 2;
+        bin++;
+    }
+    return bin;
+}
+
+static bool lvgl_port_lock_take_stats(TickType_t timeout_ticks)
+{
+    const int64_t start = esp_timer_get_time();
+    bool contended = false;
+
+    /* Try without waiting first, to count the contention */
+    if (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, 0) != pdTRUE) {
+        contended = true;
+        if (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) != pdTRUE) {
+            portENTER_CRITICAL(&lvgl_port_ctx.stats_lock);
+            lvgl_port_ctx.lock_stats.timeouts++;
+            portEXIT_CRITICAL(&lvgl_port_ctx.stats_lock);
+            return false;
+        }
+    }
+
+    /* Only the outermost take of recursive lock is counted */
+    if (lvgl_port_ctx.lock_depth++ == 0) {
+        const int64_t now = esp_timer_get_time();
+        const uint32_t wait_us = (uint32_t)(now - start);
+        const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+        lvgl_port_ctx.lock_start = now;
+        lvgl_port_ctx.lock_owner = task;
+
+        portENTER_CRITICAL(&lvgl_port_ctx.stats_lock);
+        lvgl_port_lock_stats_t *stats = &lvgl_port_ctx.lock_stats;
+        stats->locks++;
+        if (contended) {
+            stats->contended++;
+        }
+        stats->wait_hist[lvgl_port_lock_hist_bin(wait_us)]++;
+        if (wait_us > stats->max_wait_us) {
+            stats->max_wait_us = wait_us;
+            stats->max_wait_task = task;
+        }
+        portEXIT_CRITICAL(&lvgl_port_ctx.stats_lock);
+    }
+
+    return true;
+}
+
+static void lvgl_port_lock_give_stats(void)
+{
+    assert(lvgl_port_ctx.lock_depth > 0 && "lvgl_port_unlock called without lvgl_port_lock");
+
+    if (--lvgl_port_ctx.lock_depth == 0) {
+        const uint32_t hold_us = (uint32_t)(esp_timer_get_time() - lvgl_port_ctx.lock_start);
+        const TaskHandle_t task = lvgl_port_ctx.lock_owner;
+        lvgl_port_ctx.lock_owner = NULL;
+
+        portENTER_CRITICAL(&lvgl_port_ctx.stats_lock);
+        lvgl_port_lock_stats_t *stats = &lvgl_port_ctx.lock_stats;
+        stats->hold_hist[lvgl_port_lock_hist_bin(hold_us)]++;
+        if (hold_us > stats->max_hold_us) {
+            stats->max_hold_us = hold_us;
+            stats->max_hold_task = task;
+        }
+        portEXIT_CRITICAL(&lvgl_port_ctx.stats_lock);
+    }
+}
+#endif
+
 static void lvgl_port_task_deinit(void)
 {
     if (lvgl_port_ctx.timer_mux) {
@@ -287,9 +755,14 @@ static void lvgl_port_task_deinit(void)
     if (lvgl_port_ctx.task_init_mux) {
         vSemaphoreDelete(lvgl_port_ctx.task_init_mux);
     }
-    if (lvgl_port_ctx.lvgl_queue) {
-        vQueueDelete(lvgl_port_ctx.lvgl_queue);
+    if (lvgl_port_ctx.async_queue) {
+        vQueueDelete(lvgl_port_ctx.async_queue);
     }
+#if LVGL_PORT_PM_LOCK
+    if (lvgl_port_ctx.pm_lock) {
+        esp_pm_lock_delete(lvgl_port_ctx.pm_lock);
+    }
+#endif
     memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
 #if LV_ENABLE_GC || !LV_MEM_CUSTOM
     /* Deinitialize LVGL */
@@ -297,6 +770,19 @@ static void lvgl_port_task_deinit(void)
 #endif
 }
 
+#if CONFIG_LVGL_PORT_TICKLESS
+static uint32_t lvgl_port_tick_get_cb(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+static esp_err_t lvgl_port_tick_init(void)
+{
+    // Tick interface for LVGL (LVGL reads the time from esp_timer, no periodic interrupt)
+    lv_tick_set_cb(lvgl_port_tick_get_cb);
+    return ESP_OK;
+}
+#else
 static void lvgl_port_tick_increment(void *arg)
 {
     xSemaphoreTake(lvgl_port_ctx.timer_mux, portMAX_DELAY);
@@ -315,3 +801,4 @@ static esp_err_t lvgl_port_tick_init(void)
     ESP_RETURN_ON_ERROR(esp_timer_create(&lvgl_tick_timer_args, &lvgl_port_ctx.tick_timer), TAG, "Creating LVGL timer filed!");
     return esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_ctx.timer_period_ms * 1000);
 }
+#endif
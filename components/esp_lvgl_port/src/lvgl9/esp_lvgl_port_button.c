@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -9,6 +9,12 @@
 #include "esp_check.h"
 #include "esp_lvgl_port.h"
 
+#if CONFIG_LVGL_PORT_NAV_BUTTONS_GPIO_ISR
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+#endif
+
 static const char *TAG = "LVGL";
 
 /*******************************************************************************
@@ -28,6 +34,11 @@ typedef struct {
     bool btn_prev; /* Button prev state */
     bool btn_next; /* Button next state */
     bool btn_enter; /* Button enter state */
+#if CONFIG_LVGL_PORT_NAV_BUTTONS_GPIO_ISR
+    int gpio_num[LVGL_PORT_NAV_BTN_CNT];        /* GPIO of buttons read by interrupt (-1: iot_button or not used) */
+    uint8_t active_level[LVGL_PORT_NAV_BTN_CNT];
+    TimerHandle_t debounce_timer;               /* One-shot, restarted by every edge */
+#endif
 } lvgl_port_nav_btns_ctx_t;
 
 /*******************************************************************************
@@ -37,6 +48,13 @@ typedef struct {
 static void lvgl_port_navigation_buttons_read(lv_indev_t *indev_drv, lv_indev_data_t *data);
 static void lvgl_port_btn_down_handler(void *arg, void *arg2);
 static void lvgl_port_btn_up_handler(void *arg, void *arg2);
+#if CONFIG_LVGL_PORT_NAV_BUTTONS_GPIO_ISR
+static esp_err_t lvgl_port_btn_gpio_init(lvgl_port_nav_btns_ctx_t *ctx, int idx, const button_config_t *cfg);
+static void lvgl_port_btn_gpio_deinit(lvgl_port_nav_btns_ctx_t *ctx);
+static void lvgl_port_btn_gpio_isr(void *arg);
+static void lvgl_port_btn_debounce_cb(TimerHandle_t timer);
+#endif
+static esp_err_t lvgl_port_btn_create(lvgl_port_nav_btns_ctx_t *ctx, int idx, const button_config_t *cfg);
 
 /*******************************************************************************
 * Public API functions
@@ -50,34 +68,30 @@ lv_indev_t *lvgl_port_add_navigation_buttons(const lvgl_port_nav_btns_cfg_t *but
     assert(buttons_cfg->disp != NULL);
 
     /* Touch context */
-    lvgl_port_nav_btns_ctx_t *buttons_ctx = malloc(sizeof(lvgl_port_nav_btns_ctx_t));
+    lvgl_port_nav_btns_ctx_t *buttons_ctx = calloc(1, sizeof(lvgl_port_nav_btns_ctx_t));
     if (buttons_ctx == NULL) {
         ESP_LOGE(TAG, "Not enough memory for buttons context allocation!");
         return NULL;
     }
+#if CONFIG_LVGL_PORT_NAV_BUTTONS_GPIO_ISR
+    for (int i = 0; i < LVGL_PORT_NAV_BTN_CNT; i++) {
+        buttons_ctx->gpio_num[i] = -1;
+    }
+#endif
 
     /* Previous button */
     if (buttons_cfg->button_prev != NULL) {
-        buttons_ctx->btn[LVGL_PORT_NAV_BTN_PREV] = iot_button_create(buttons_cfg->button_prev);
-        ESP_GOTO_ON_FALSE(buttons_ctx->btn[LVGL_PORT_NAV_BTN_PREV], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for button create!");
+        ESP_GOTO_ON_ERROR(lvgl_port_btn_create(buttons_ctx, LVGL_PORT_NAV_BTN_PREV, buttons_cfg->button_prev), err, TAG, "Button create fail!");
     }
 
     /* Next button */
     if (buttons_cfg->button_next != NULL) {
-        buttons_ctx->btn[LVGL_PORT_NAV_BTN_NEXT] = iot_button_create(buttons_cfg->button_next);
-        ESP_GOTO_ON_FALSE(buttons_ctx->btn[LVGL_PORT_NAV_BTN_NEXT], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for button create!");
+        ESP_GOTO_ON_ERROR(lvgl_port_btn_create(buttons_ctx, LVGL_PORT_NAV_BTN_NEXT, buttons_cfg->button_next), err, TAG, "Button create fail!");
     }
 
     /* Enter button */
     if (buttons_cfg->button_enter != NULL) {
-        buttons_ctx->btn[LVGL_PORT_NAV_BTN_ENTER] = iot_button_create(buttons_cfg->button_enter);
-        ESP_GOTO_ON_FALSE(buttons_ctx->btn[LVGL_PORT_NAV_BTN_ENTER], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for button create!");
-    }
-
-    /* Button handlers */
-    for (int i = 0; i < LVGL_PORT_NAV_BTN_CNT; i++) {
-        ESP_ERROR_CHECK(iot_button_register_cb(buttons_ctx->btn[i], BUTTON_PRESS_DOWN, lvgl_port_btn_down_handler, buttons_ctx));
-        ESP_ERROR_CHECK(iot_button_register_cb(buttons_ctx->btn[i], BUTTON_PRESS_UP, lvgl_port_btn_up_handler, buttons_ctx));
+        ESP_GOTO_ON_ERROR(lvgl_port_btn_create(buttons_ctx, LVGL_PORT_NAV_BTN_ENTER, buttons_cfg->button_enter), err, TAG, "Button create fail!");
     }
 
     buttons_ctx->btn_prev = false;
@@ -100,6 +114,9 @@ lv_indev_t *lvgl_port_add_navigation_buttons(const lvgl_port_nav_btns_cfg_t *but
 
 err:
     if (ret != ESP_OK) {
+#if CONFIG_LVGL_PORT_NAV_BUTTONS_GPIO_ISR
+        lvgl_port_btn_gpio_deinit(buttons_ctx);
+#endif
         for (int i = 0; i < LVGL_PORT_NAV_BTN_CNT; i++) {
             if (buttons_ctx->btn[i] != NULL) {
                 iot_button_delete(buttons_ctx->btn[i]);
@@ -119,6 +136,17 @@ esp_err_t lvgl_port_remove_navigation_buttons(lv_indev_t *buttons)
     assert(buttons);
     lvgl_port_nav_btns_ctx_t *buttons_ctx = (lvgl_port_nav_btns_ctx_t *)lv_indev_get_driver_data(buttons);
 
+    if (buttons_ctx) {
+#if CONFIG_LVGL_PORT_NAV_BUTTONS_GPIO_ISR
+        lvgl_port_btn_gpio_deinit(buttons_ctx);
+#endif
+        for (int i = 0; i < LVGL_PORT_NAV_BTN_CNT; i++) {
+            if (buttons_ctx->btn[i] != NULL) {
+                iot_button_delete(buttons_ctx->btn[i]);
+            }
+        }
+    }
+
     lvgl_port_lock(0);
     /* Remove input device driver */
     lv_indev_delete(buttons);
@@ -135,6 +163,108 @@ esp_err_t lvgl_port_remove_navigation_buttons(lv_indev_t *buttons)
 * Private functions
 *******************************************************************************/
 
+static esp_err_t lvgl_port_btn_create(lvgl_port_nav_btns_ctx_t *ctx, int idx, const button_config_t *cfg)
+{
+#if CONFIG_LVGL_PORT_NAV_BUTTONS_GPIO_ISR
+    /* GPIO buttons are read by interrupt, the others (ADC, custom) are scanned by button component */
+    if (cfg->type == BUTTON_TYPE_GPIO) {
+        return lvgl_port_btn_gpio_init(ctx, idx, cfg);
+    }
+#endif
+    ctx->btn[idx] = iot_button_create(cfg);
+    ESP_RETURN_ON_FALSE(ctx->btn[idx], ESP_ERR_NO_MEM, TAG, "Not enough memory for button create!");
+    ESP_RETURN_ON_ERROR(iot_button_register_cb(ctx->btn[idx], BUTTON_PRESS_DOWN, lvgl_port_btn_down_handler, ctx), TAG, "Button callback fail!");
+    ESP_RETURN_ON_ERROR(iot_button_register_cb(ctx->btn[idx], BUTTON_PRESS_UP, lvgl_port_btn_up_handler, ctx), TAG, "Button callback fail!");
+    return ESP_OK;
+}
+
+#if CONFIG_LVGL_PORT_NAV_BUTTONS_GPIO_ISR
+static esp_err_t lvgl_port_btn_gpio_init(lvgl_port_nav_btns_ctx_t *ctx, int idx, const button_config_t *cfg)
+{
+    const int gpio_num = cfg->gpio_button_config.gpio_num;
+    const uint8_t active_level = cfg->gpio_button_config.active_level ? 1 : 0;
+
+    if (ctx->debounce_timer == NULL) {
+        const TickType_t debounce_ticks = pdMS_TO_TICKS(CONFIG_LVGL_PORT_NAV_BUTTONS_DEBOUNCE_MS);
+        ctx->debounce_timer = xTimerCreate("lvgl_btn", (debounce_ticks > 0 ? debounce_ticks : 1), pdFALSE, ctx, lvgl_port_btn_debounce_cb);
+        ESP_RETURN_ON_FALSE(ctx->debounce_timer, ESP_ERR_NO_MEM, TAG, "Not enough memory for debounce timer!");
+    }
+
+    /* Pull to the released level, every edge restarts the debounce timer */
+    const gpio_config_t btn_conf = {
+        .pin_bit_mask = BIT64(gpio_num),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = active_level ? GPIO_PULLUP_DISABLE : GPIO_PULLUP_ENABLE,
+        .pull_down_en = active_level ? GPIO_PULLDOWN_ENABLE : GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_ANYEDGE,
+    };
+    ESP_RETURN_ON_ERROR(gpio_config(&btn_conf), TAG, "Button GPIO config fail");
+    /* ISR service can be installed already (by application or other component) */
+    esp_err_t ret = gpio_install_isr_service(0);
+    ESP_RETURN_ON_FALSE(ret == ESP_OK || ret == ESP_ERR_INVALID_STATE, ret, TAG, "GPIO ISR service install fail");
+    ESP_RETURN_ON_ERROR(gpio_isr_handler_add(gpio_num, lvgl_port_btn_gpio_isr, ctx), TAG, "Button GPIO ISR add fail");
+
+    ctx->gpio_num[idx] = gpio_num;
+    ctx->active_level[idx] = active_level;
+    return ESP_OK;
+}
+
+static void lvgl_port_btn_gpio_deinit(lvgl_port_nav_btns_ctx_t *ctx)
+{
+    for (int i = 0; i < LVGL_PORT_NAV_BTN_CNT; i++) {
+        if (ctx->gpio_num[i] >= 0) {
+            gpio_isr_handler_remove(ctx->gpio_num[i]);
+            gpio_reset_pin(ctx->gpio_num[i]);
+            ctx->gpio_num[i] = -1;
+        }
+    }
+    if (ctx->debounce_timer) {
+        xTimerDelete(ctx->debounce_timer, portMAX_DELAY);
+        ctx->debounce_timer = NULL;
+    }
+}
+
+static void IRAM_ATTR lvgl_port_btn_gpio_isr(void *arg)
+{
+    BaseType_t need_yield = pdFALSE;
+    lvgl_port_nav_btns_ctx_t *ctx = (lvgl_port_nav_btns_ctx_t *)arg;
+
+    /* Levels are read, when the contacts stop bouncing */
+    xTimerResetFromISR(ctx->debounce_timer, &need_yield);
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/* In timer task, after CONFIG_LVGL_PORT_NAV_BUTTONS_DEBOUNCE_MS without edge */
+static void lvgl_port_btn_debounce_cb(TimerHandle_t timer)
+{
+    lvgl_port_nav_btns_ctx_t *ctx = (lvgl_port_nav_btns_ctx_t *)pvTimerGetTimerID(timer);
+    bool *state[LVGL_PORT_NAV_BTN_CNT] = {
+        [LVGL_PORT_NAV_BTN_PREV] = &ctx->btn_prev,
+        [LVGL_PORT_NAV_BTN_NEXT] = &ctx->btn_next,
+        [LVGL_PORT_NAV_BTN_ENTER] = &ctx->btn_enter,
+    };
+    bool changed = false;
+
+    for (int i = 0; i < LVGL_PORT_NAV_BTN_CNT; i++) {
+        if (ctx->gpio_num[i] < 0) {
+            continue;
+        }
+        const bool pressed = (gpio_get_level(ctx->gpio_num[i]) == ctx->active_level[i]);
+        if (*state[i] != pressed) {
+            *state[i] = pressed;
+            changed = true;
+        }
+    }
+
+    /* Wake LVGL task only on change */
+    if (changed) {
+        lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, ctx->indev);
+    }
+}
+#endif
+
 
 static void lvgl_port_navigation_buttons_read(lv_indev_t *indev_drv, lv_indev_data_t *data)
 {
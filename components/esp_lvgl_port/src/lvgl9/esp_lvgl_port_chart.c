@@ -0,0 +1,410 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_chart.h"
+#include "esp_lvgl_port_priv.h"
+#include "lvgl.h"
+
+static const char *TAG = "LVGL";
+
+/* Image header with stride of a part of the buffer and image cache drop are from LVGL 9.1 */
+#if LV_VERSION_CHECK(9, 1, 0)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct lvgl_port_chart_s {
+    lv_obj_t                *obj;           /* Chart object, NULL when deleted */
+    lvgl_port_chart_cfg_t   cfg;            /* Configuration with resolved defaults */
+    int32_t                 w;              /* Size of the plot in pixels */
+    int32_t                 h;
+    int32_t                 *values;        /* Ring of points, series_num values per point */
+    uint16_t                head;           /* Index of the next point */
+    uint16_t                *buf;           /* Plot in RGB565, one column (column_w pixels) per point */
+    size_t                  buf_size;
+    uint16_t                *row_color;     /* Background of each row of the plot with division lines */
+    uint16_t                series_color[LVGL_PORT_CHART_SERIES_MAX];
+    lv_image_dsc_t          img[2];         /* Older and newer part of the ring in scroll mode */
+    lvgl_port_chart_info_t  info;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void lvgl_port_chart_render(lvgl_port_chart_handle_t chart);
+static void lvgl_port_chart_render_column(lvgl_port_chart_handle_t chart, uint16_t point);
+static void lvgl_port_chart_clear_column(lvgl_port_chart_handle_t chart, uint16_t point);
+static void lvgl_port_chart_update_images(lvgl_port_chart_handle_t chart);
+static void lvgl_port_chart_free(lvgl_port_chart_handle_t chart);
+static void lvgl_port_chart_event_cb(lv_event_t *e);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_chart_create(const lvgl_port_chart_cfg_t *cfg, lvgl_port_chart_handle_t *ret_handle)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(cfg && cfg->parent && ret_handle && cfg->point_num > 1 && cfg->height > 1 && cfg->min < cfg->max &&
+                        cfg->series_num > 0 && cfg->series_num <= LVGL_PORT_CHART_SERIES_MAX, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    lvgl_port_chart_handle_t chart = LVGL_PORT_CTX_CALLOC(sizeof(struct lvgl_port_chart_s));
+    ESP_GOTO_ON_FALSE(chart, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for chart allocation!");
+    chart->cfg = *cfg;
+    chart->cfg.column_w = LV_MAX(cfg->column_w, 1);
+    chart->cfg.line_width = LV_MAX(cfg->line_width, 1);
+    chart->w = cfg->point_num * chart->cfg.column_w;
+    chart->h = cfg->height;
+
+    /* Plot buffer is the only big allocation, points and row colors are small */
+    const uint32_t caps = cfg->flags.buff_spiram ? MALLOC_CAP_SPIRAM : (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    chart->buf_size = chart->w * chart->h * sizeof(uint16_t);
+    chart->buf = heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, chart->buf_size, caps);
+    chart->values = heap_caps_malloc(cfg->point_num * cfg->series_num * sizeof(int32_t), caps);
+    chart->row_color = heap_caps_malloc(chart->h * sizeof(uint16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_GOTO_ON_FALSE(chart->buf && chart->values && chart->row_color, ESP_ERR_NO_MEM, err, TAG,
+                      "Not enough memory for chart buffer (%u bytes)!", (unsigned)chart->buf_size);
+    for (int i = 0; i < cfg->point_num * cfg->series_num; i++) {
+        chart->values[i] = LVGL_PORT_CHART_POINT_NONE;
+    }
+
+    /* Colors of the buffer, division lines are evenly spaced between the edges */
+    const uint16_t bg = lv_color_to_u16(cfg->bg_color);
+    const uint16_t grid = lv_color_to_u16(cfg->grid_color);
+    for (int32_t y = 0; y < chart->h; y++) {
+        chart->row_color[y] = bg;
+    }
+    for (int i = 1; i <= cfg->hdiv_num; i++) {
+        chart->row_color[i * (chart->h - 1) / (cfg->hdiv_num + 1)] = grid;
+    }
+    for (int s = 0; s < cfg->series_num; s++) {
+        chart->series_color[s] = lv_color_to_u16(cfg->series_color[s]);
+    }
+
+    for (int i = 0; i < 2; i++) {
+        chart->img[i].header.magic = LV_IMAGE_HEADER_MAGIC;
+        chart->img[i].header.cf = LV_COLOR_FORMAT_RGB565;
+        chart->img[i].header.h = chart->h;
+        chart->img[i].header.stride = chart->w * sizeof(uint16_t);
+    }
+
+    chart->obj = lv_obj_create(cfg->parent);
+    ESP_GOTO_ON_FALSE(chart->obj, ESP_ERR_NO_MEM, err, TAG, "Create chart object fail!");
+    lv_obj_remove_style_all(chart->obj);
+    lv_obj_remove_flag(chart->obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(chart->obj, chart->w, chart->h);
+    lv_obj_add_event_cb(chart->obj, lvgl_port_chart_event_cb, LV_EVENT_ALL, chart);
+
+    lvgl_port_chart_render(chart);
+    *ret_handle = chart;
+    lvgl_port_unlock();
+    return ESP_OK;
+
+err:
+    if (chart) {
+        if (chart->obj) {
+            lv_obj_remove_event_cb_with_user_data(chart->obj, lvgl_port_chart_event_cb, chart);
+            lv_obj_delete(chart->obj);
+        }
+        lvgl_port_chart_free(chart);
+    }
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_chart_delete(lvgl_port_chart_handle_t chart)
+{
+    ESP_RETURN_ON_FALSE(chart, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    lv_obj_remove_event_cb_with_user_data(chart->obj, lvgl_port_chart_event_cb, chart);
+    lv_obj_delete(chart->obj);
+    lvgl_port_chart_free(chart);
+
+    lvgl_port_unlock();
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_chart_add_point(lvgl_port_chart_handle_t chart, const int32_t *values)
+{
+    ESP_RETURN_ON_FALSE(chart && values, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uint16_t point = chart->head;
+    memcpy(&chart->values[point * chart->cfg.series_num], values, chart->cfg.series_num * sizeof(int32_t));
+    chart->head = (point + 1 < chart->cfg.point_num) ? (point + 1) : 0;
+    lvgl_port_chart_render_column(chart, point);
+    chart->info.points++;
+
+    if (chart->cfg.mode == LVGL_PORT_CHART_MODE_SWEEP) {
+        /* Cursor erases the oldest point, only the new column and the cursor are redrawn */
+        lvgl_port_chart_clear_column(chart, chart->head);
+        lv_image_cache_drop(&chart->img[0]);
+
+        lv_area_t coords;
+        lv_obj_get_coords(chart->obj, &coords);
+        const int32_t cw = chart->cfg.column_w;
+        lv_area_t area = {
+            .x1 = coords.x1 + point * cw,
+            .y1 = coords.y1,
+            .x2 = coords.x1 + (point + (chart->head ? 2 : 1)) * cw - 1,
+            .y2 = coords.y2,
+        };
+        lv_obj_invalidate_area(chart->obj, &area);
+        if (chart->head == 0) {
+            area.x1 = coords.x1;
+            area.x2 = coords.x1 + cw - 1;
+            lv_obj_invalidate_area(chart->obj, &area);
+        }
+    } else {
+        /* The next column is the oldest point on the left edge now, without the segment from the overwritten point */
+        lvgl_port_chart_render_column(chart, chart->head);
+        /* Columns are not moved in the buffer, only the split of the ring moves */
+        lvgl_port_chart_update_images(chart);
+        lv_obj_invalidate(chart->obj);
+    }
+
+    lvgl_port_unlock();
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_chart_set_range(lvgl_port_chart_handle_t chart, int32_t min, int32_t max)
+{
+    ESP_RETURN_ON_FALSE(chart && min < max, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (min != chart->cfg.min || max != chart->cfg.max) {
+        chart->cfg.min = min;
+        chart->cfg.max = max;
+        lvgl_port_chart_render(chart);
+    }
+
+    lvgl_port_unlock();
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_chart_clear(lvgl_port_chart_handle_t chart)
+{
+    ESP_RETURN_ON_FALSE(chart, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int i = 0; i < chart->cfg.point_num * chart->cfg.series_num; i++) {
+        chart->values[i] = LVGL_PORT_CHART_POINT_NONE;
+    }
+    chart->head = 0;
+    lvgl_port_chart_render(chart);
+
+    lvgl_port_unlock();
+    return ESP_OK;
+}
+
+lv_obj_t *lvgl_port_chart_get_obj(lvgl_port_chart_handle_t chart)
+{
+    return chart ? chart->obj : NULL;
+}
+
+esp_err_t lvgl_port_chart_get_info(lvgl_port_chart_handle_t chart, lvgl_port_chart_info_t *info)
+{
+    ESP_RETURN_ON_FALSE(chart && info, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    *info = chart->info;
+    info->buf_size = chart->buf_size;
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Row of the value, the top row is the maximum */
+static int32_t lvgl_port_chart_value_to_y(lvgl_port_chart_handle_t chart, int32_t value)
+{
+    const int32_t v = LV_CLAMP(chart->cfg.min, value, chart->cfg.max);
+    return (chart->h - 1) - (int32_t)((int64_t)(v - chart->cfg.min) * (chart->h - 1) / ((int64_t)chart->cfg.max - chart->cfg.min));
+}
+
+static void lvgl_port_chart_clear_column(lvgl_port_chart_handle_t chart, uint16_t point)
+{
+    const int32_t cw = chart->cfg.column_w;
+    uint16_t *px = chart->buf + point * cw;
+    for (int32_t y = 0; y < chart->h; y++, px += chart->w) {
+        for (int32_t k = 0; k < cw; k++) {
+            px[k] = chart->row_color[y];
+        }
+    }
+}
+
+/*
+ * Column of the point with the line segments from the previous point (previous in the ring is the older one,
+ * except of the oldest point in scroll mode, which is on the left edge and whose ring predecessor is the newest point)
+ */
+static void lvgl_port_chart_render_column(lvgl_port_chart_handle_t chart, uint16_t point)
+{
+    const int32_t cw = chart->cfg.column_w;
+    const int32_t lw = chart->cfg.line_width;
+    const uint8_t series_num = chart->cfg.series_num;
+    const uint16_t prev = (point > 0) ? (point - 1) : (chart->cfg.point_num - 1);
+    const bool oldest = (chart->cfg.mode == LVGL_PORT_CHART_MODE_SCROLL && point == chart->head);
+    const int32_t x0 = point * cw;
+
+    lvgl_port_chart_clear_column(chart, point);
+    for (int s = 0; s < series_num; s++) {
+        const int32_t cur_value = chart->values[point * series_num + s];
+        const int32_t prev_value = oldest ? LVGL_PORT_CHART_POINT_NONE : chart->values[prev * series_num + s];
+        if (cur_value == LVGL_PORT_CHART_POINT_NONE) {
+            continue;
+        }
+        const int32_t yc = lvgl_port_chart_value_to_y(chart, cur_value);
+        const int32_t yp = (prev_value == LVGL_PORT_CHART_POINT_NONE) ? yc : lvgl_port_chart_value_to_y(chart, prev_value);
+
+        /* Vertical spans between linearly interpolated rows of each pixel column */
+        for (int32_t k = 0; k < cw; k++) {
+            const int32_t ya = yp + (yc - yp) * k / cw;
+            const int32_t yb = yp + (yc - yp) * (k + 1) / cw;
+            const int32_t y1 = LV_MAX(LV_MIN(ya, yb) - lw / 2, 0);
+            const int32_t y2 = LV_MIN(LV_MAX(ya, yb) + (lw - 1) / 2, chart->h - 1);
+            uint16_t *px = chart->buf + y1 * chart->w + x0 + k;
+            for (int32_t y = y1; y <= y2; y++, px += chart->w) {
+                *px = chart->series_color[s];
+            }
+        }
+    }
+}
+
+/* Images drawn from the buffer: whole buffer in sweep mode, older and newer part of the ring in scroll mode */
+static void lvgl_port_chart_update_images(lvgl_port_chart_handle_t chart)
+{
+    const int32_t split = (chart->cfg.mode == LVGL_PORT_CHART_MODE_SCROLL) ? chart->head * chart->cfg.column_w : 0;
+    const uint32_t stride = chart->img[0].header.stride;
+    uint8_t *data = (uint8_t *)chart->buf;
+
+    chart->img[0].header.w = chart->w - split;
+    chart->img[0].data = data + split * sizeof(uint16_t);
+    chart->img[0].data_size = chart->buf_size - split * sizeof(uint16_t);
+    chart->img[1].header.w = split;
+    chart->img[1].data = data;
+    chart->img[1].data_size = stride * (chart->h - 1) + split * sizeof(uint16_t);
+    /* Decoded headers of the images must not be reused */
+    lv_image_cache_drop(&chart->img[0]);
+    lv_image_cache_drop(&chart->img[1]);
+}
+
+static void lvgl_port_chart_render(lvgl_port_chart_handle_t chart)
+{
+    for (uint16_t i = 0; i < chart->cfg.point_num; i++) {
+        lvgl_port_chart_render_column(chart, i);
+    }
+    if (chart->cfg.mode == LVGL_PORT_CHART_MODE_SWEEP) {
+        lvgl_port_chart_clear_column(chart, chart->head);
+    }
+    lvgl_port_chart_update_images(chart);
+    chart->info.renders++;
+    lv_obj_invalidate(chart->obj);
+}
+
+static void lvgl_port_chart_free(lvgl_port_chart_handle_t chart)
+{
+    heap_caps_free(chart->buf);
+    heap_caps_free(chart->values);
+    heap_caps_free(chart->row_color);
+    LVGL_PORT_CTX_FREE(chart);
+}
+
+static void lvgl_port_chart_event_cb(lv_event_t *e)
+{
+    lvgl_port_chart_handle_t chart = lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_current_target(e);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_DRAW_MAIN: {
+        lv_area_t area;
+        lv_obj_get_coords(obj, &area);
+        area.x2 = area.x1 - 1;
+        for (int i = 0; i < 2; i++) {
+            if (chart->img[i].header.w == 0) {
+                continue;
+            }
+            lv_draw_image_dsc_t dsc;
+            lv_draw_image_dsc_init(&dsc);
+            dsc.src = &chart->img[i];
+            area.x1 = area.x2 + 1;
+            area.x2 = area.x1 + chart->img[i].header.w - 1;
+            lv_draw_image(lv_event_get_layer(e), &dsc, &area);
+        }
+        break;
+    }
+    case LV_EVENT_DELETE:
+        /* Deleted with its parent */
+        lv_image_cache_drop(&chart->img[0]);
+        lv_image_cache_drop(&chart->img[1]);
+        lvgl_port_chart_free(chart);
+        break;
+    default:
+        break;
+    }
+}
+
+#else
+
+esp_err_t lvgl_port_chart_create(const lvgl_port_chart_cfg_t *cfg, lvgl_port_chart_handle_t *ret_handle)
+{
+    ESP_LOGE(TAG, "Chart needs LVGL 9.1");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_chart_delete(lvgl_port_chart_handle_t handle)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_chart_add_point(lvgl_port_chart_handle_t handle, const int32_t *values)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_chart_set_range(lvgl_port_chart_handle_t handle, int32_t min, int32_t max)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_chart_clear(lvgl_port_chart_handle_t handle)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+lv_obj_t *lvgl_port_chart_get_obj(lvgl_port_chart_handle_t handle)
+{
+    return NULL;
+}
+
+esp_err_t lvgl_port_chart_get_info(lvgl_port_chart_handle_t handle, lvgl_port_chart_info_t *info)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
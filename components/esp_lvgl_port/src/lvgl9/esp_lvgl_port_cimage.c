@@ -0,0 +1,520 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+#include "esp_lvgl_port_cimage.h"
+#include "lvgl.h"
+
+static const char *TAG = "LVGL";
+
+/* Image decoder with get_area_cb and draw buffer init from LVGL 9.2 */
+#if LV_VERSION_CHECK(9, 2, 0)
+
+/*
+ * Layout of compressed image data (generated by tools/image_compress.py, little endian):
+ *   0  magic "LPCI"
+ *   4  method (LVGL_PORT_CIMAGE_RLE, LVGL_PORT_CIMAGE_LZ4)
+ *   5  color format of pixels (lv_color_format_t)
+ *   6  rows in one band (uint16_t)
+ *   8  width (uint16_t)
+ *  10  height (uint16_t)
+ *  12  stride in bytes (uint32_t)
+ *  16  offsets of bands from the start of data (uint32_t, number of bands + 1)
+ *      compressed bands, each band is decoded independently
+ */
+#define LVGL_PORT_CIMAGE_MAGIC          "LPCI"
+#define LVGL_PORT_CIMAGE_HEADER_SIZE    (16)
+#define LVGL_PORT_CIMAGE_RLE            (1)
+#define LVGL_PORT_CIMAGE_LZ4            (2)
+
+#ifdef CONFIG_LVGL_PORT_CIMAGE_CACHE_MAX_KB
+#define LVGL_PORT_CIMAGE_CACHE_MAX      (CONFIG_LVGL_PORT_CIMAGE_CACHE_MAX_KB * 1024)
+#else
+#define LVGL_PORT_CIMAGE_CACHE_MAX      (0)
+#endif
+
+/* Runs of repeated pixels are expanded by vector stores of ESP32-S3 (esp_lvgl_port_cimage_esp32s3.S) */
+#if CONFIG_IDF_TARGET_ESP32S3
+#define LVGL_PORT_CIMAGE_ASM            1
+/* Shorter runs are faster in C */
+#define LVGL_PORT_CIMAGE_ASM_MIN        (32)
+#endif
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    uint8_t     method;
+    uint8_t     cf;
+    uint8_t     px_size;        /* Bytes of one pixel (RLE block) */
+    uint16_t    band_h;
+    uint16_t    w;
+    uint16_t    h;
+    uint32_t    stride;
+    uint32_t    bands;
+} lvgl_port_cimage_header_t;
+
+/* Streamed image, bands are decoded on demand */
+typedef struct {
+    lvgl_port_cimage_header_t   header;
+    const lv_image_dsc_t        *img_dsc;
+    lv_draw_buf_t               *band_buf;  /* Decoded band */
+    int32_t                     band;       /* Index of decoded band (-1 is none) */
+    lv_draw_buf_t               rows;       /* Decoded rows of the band, given to LVGL */
+} lvgl_port_cimage_dec_t;
+
+typedef struct {
+    lv_image_decoder_t          *decoder;
+    portMUX_TYPE                stats_lock;
+    lvgl_port_cimage_stats_t    stats;
+    uint64_t                    total_us;
+} lvgl_port_cimage_ctx_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static lv_result_t lvgl_port_cimage_info(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc, lv_image_header_t *header);
+static lv_result_t lvgl_port_cimage_open(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc);
+static lv_result_t lvgl_port_cimage_get_area(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc,
+        const lv_area_t *full_area, lv_area_t *decoded_area);
+static void lvgl_port_cimage_close(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc);
+#if LVGL_PORT_CIMAGE_ASM
+extern void lvgl_port_cimage_fill32_esp(uint8_t *out, uint32_t pattern, uint32_t bytes);
+#endif
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static lvgl_port_cimage_ctx_t lvgl_port_cimage_ctx = {
+    .stats_lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_cimage_decoder_init(void)
+{
+    lvgl_port_cimage_ctx_t *ctx = &lvgl_port_cimage_ctx;
+    ESP_RETURN_ON_FALSE(ctx->decoder == NULL, ESP_ERR_INVALID_STATE, TAG, "Compressed image decoder already registered");
+
+    /* Newest decoder is tried first */
+    ctx->decoder = lv_image_decoder_create();
+    ESP_RETURN_ON_FALSE(ctx->decoder, ESP_ERR_NO_MEM, TAG, "Create LVGL image decoder fail!");
+    lv_image_decoder_set_info_cb(ctx->decoder, lvgl_port_cimage_info);
+    lv_image_decoder_set_open_cb(ctx->decoder, lvgl_port_cimage_open);
+    lv_image_decoder_set_get_area_cb(ctx->decoder, lvgl_port_cimage_get_area);
+    lv_image_decoder_set_close_cb(ctx->decoder, lvgl_port_cimage_close);
+    ctx->decoder->name = "CIMAGE";
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_cimage_decoder_deinit(void)
+{
+    lvgl_port_cimage_ctx_t *ctx = &lvgl_port_cimage_ctx;
+    ESP_RETURN_ON_FALSE(ctx->decoder, ESP_ERR_INVALID_STATE, TAG, "Compressed image decoder not registered");
+
+    /* Cached images reference the decoder */
+    lv_image_cache_drop(NULL);
+    lv_image_decoder_delete(ctx->decoder);
+    ctx->decoder = NULL;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_cimage_decoder_get_stats(lvgl_port_cimage_stats_t *stats, bool reset)
+{
+    lvgl_port_cimage_ctx_t *ctx = &lvgl_port_cimage_ctx;
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    portENTER_CRITICAL(&ctx->stats_lock);
+    *stats = ctx->stats;
+    stats->avg_band_us = (ctx->stats.bands ? (uint32_t)(ctx->total_us / ctx->stats.bands) : 0);
+    if (reset) {
+        memset(&ctx->stats, 0, sizeof(ctx->stats));
+        ctx->total_us = 0;
+    }
+    portEXIT_CRITICAL(&ctx->stats_lock);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline uint32_t lvgl_port_cimage_read32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint16_t lvgl_port_cimage_read16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static bool lvgl_port_cimage_parse(const lv_image_decoder_dsc_t *dsc, lvgl_port_cimage_header_t *header)
+{
+    if (dsc->src_type != LV_IMAGE_SRC_VARIABLE) {
+        return false;
+    }
+    const lv_image_dsc_t *img_dsc = dsc->src;
+    const uint8_t *data = img_dsc->data;
+    if ((img_dsc->header.cf != LV_COLOR_FORMAT_RAW && img_dsc->header.cf != LV_COLOR_FORMAT_RAW_ALPHA) ||
+            img_dsc->data_size < LVGL_PORT_CIMAGE_HEADER_SIZE || memcmp(data, LVGL_PORT_CIMAGE_MAGIC, 4) != 0) {
+        return false;
+    }
+
+    header->method = data[4];
+    header->cf = data[5];
+    header->band_h = lvgl_port_cimage_read16(data + 6);
+    header->w = lvgl_port_cimage_read16(data + 8);
+    header->h = lvgl_port_cimage_read16(data + 10);
+    header->stride = lvgl_port_cimage_read32(data + 12);
+    const uint32_t bpp = lv_color_format_get_bpp(header->cf);
+    header->px_size = bpp / 8;
+    if ((header->method != LVGL_PORT_CIMAGE_RLE && header->method != LVGL_PORT_CIMAGE_LZ4) || bpp == 0 || (bpp % 8) != 0 ||
+            header->band_h == 0 || header->w == 0 || header->h == 0 || header->stride < header->w * header->px_size) {
+        ESP_LOGE(TAG, "Unsupported compressed image (method %u, color format %u)", header->method, header->cf);
+        return false;
+    }
+    header->bands = (header->h + header->band_h - 1) / header->band_h;
+    const uint32_t table_end = LVGL_PORT_CIMAGE_HEADER_SIZE + (header->bands + 1) * sizeof(uint32_t);
+    if (img_dsc->data_size < table_end ||
+            lvgl_port_cimage_read32(data + table_end - sizeof(uint32_t)) > img_dsc->data_size) {
+        ESP_LOGE(TAG, "Truncated compressed image");
+        return false;
+    }
+    return true;
+}
+
+static inline void lvgl_port_cimage_fill32(uint8_t *out, uint32_t pattern, uint32_t bytes)
+{
+#if LVGL_PORT_CIMAGE_ASM
+    if (bytes >= LVGL_PORT_CIMAGE_ASM_MIN) {
+        lvgl_port_cimage_fill32_esp(out, pattern, bytes);
+        return;
+    }
+#endif
+    uint32_t *out32 = (uint32_t *)out;
+    for (uint32_t i = 0; i < bytes / 4; i++) {
+        out32[i] = pattern;
+    }
+}
+
+/* Repeat one pixel, the output is aligned to the pixel size (band starts aligned, rows are whole pixels) */
+static inline void lvgl_port_cimage_fill(uint8_t *out, const uint8_t *px, uint32_t count, uint8_t px_size)
+{
+    switch (px_size) {
+    case 1:
+        memset(out, px[0], count);
+        break;
+    case 2: {
+        const uint16_t value = lvgl_port_cimage_read16(px);
+        if (((uintptr_t)out & 0x2) && count > 0) {
+            *(uint16_t *)out = value;
+            out += 2;
+            count--;
+        }
+        lvgl_port_cimage_fill32(out, value | ((uint32_t)value << 16), (count & ~1) * 2);
+        if (count & 1) {
+            *(uint16_t *)(out + (count - 1) * 2) = value;
+        }
+        break;
+    }
+    case 4:
+        lvgl_port_cimage_fill32(out, lvgl_port_cimage_read32(px), count * 4);
+        break;
+    default:
+        for (uint32_t i = 0; i < count; i++) {
+            memcpy(out, px, px_size);
+            out += px_size;
+        }
+        break;
+    }
+}
+
+/* LVGL RLE: control byte with bit 7 set is followed by (ctrl & 0x7F) literal pixels, otherwise one pixel is repeated ctrl times */
+static bool lvgl_port_cimage_rle(const uint8_t *in, uint32_t in_size, uint8_t *out, uint32_t out_size, uint8_t px_size)
+{
+    const uint8_t *in_end = in + in_size;
+    const uint8_t *out_end = out + out_size;
+
+    while (in < in_end) {
+        const uint8_t ctrl = *in++;
+        const uint32_t bytes = (ctrl & 0x7F) * px_size;
+        if (bytes > (uint32_t)(out_end - out)) {
+            return false;
+        }
+        if (ctrl & 0x80) {
+            if (bytes > (uint32_t)(in_end - in)) {
+                return false;
+            }
+            memcpy(out, in, bytes);
+            in += bytes;
+        } else {
+            if (px_size > (uint32_t)(in_end - in)) {
+                return false;
+            }
+            lvgl_port_cimage_fill(out, in, ctrl, px_size);
+            in += px_size;
+        }
+        out += bytes;
+    }
+    return (out == out_end);
+}
+
+/* LZ4 block: token (literal and match length), literals, 16-bit match offset, the last sequence has literals only */
+static bool lvgl_port_cimage_lz4(const uint8_t *in, uint32_t in_size, uint8_t *out, uint32_t out_size)
+{
+    const uint8_t *in_end = in + in_size;
+    uint8_t *const out_start = out;
+    const uint8_t *out_end = out + out_size;
+
+    while (in < in_end) {
+        const uint8_t token = *in++;
+        uint32_t len = token >> 4;
+        if (len == 15) {
+            uint8_t b;
+            do {
+                if (in >= in_end) {
+                    return false;
+                }
+                b = *in++;
+                len += b;
+            } while (b == 255);
+        }
+        if (len > (uint32_t)(in_end - in) || len > (uint32_t)(out_end - out)) {
+            return false;
+        }
+        memcpy(out, in, len);
+        in += len;
+        out += len;
+        if (in >= in_end) {
+            break;
+        }
+
+        if (in_end - in < 2) {
+            return false;
+        }
+        const uint32_t offset = lvgl_port_cimage_read16(in);
+        in += 2;
+        len = token & 0x0F;
+        if (len == 15) {
+            uint8_t b;
+            do {
+                if (in >= in_end) {
+                    return false;
+                }
+                b = *in++;
+                len += b;
+            } while (b == 255);
+        }
+        len += 4;
+        if (offset == 0 || offset > (uint32_t)(out - out_start) || len > (uint32_t)(out_end - out)) {
+            return false;
+        }
+        const uint8_t *match = out - offset;
+        if (offset >= len) {
+            memcpy(out, match, len);
+            out += len;
+        } else {
+            /* Overlapping match repeats the last bytes */
+            while (len--) {
+                *out++ = *match++;
+            }
+        }
+    }
+    return (out == out_end);
+}
+
+static bool lvgl_port_cimage_decode_band(const lvgl_port_cimage_header_t *header, const lv_image_dsc_t *img_dsc, uint32_t band, uint8_t *out)
+{
+    const int64_t start = esp_timer_get_time();
+    const uint8_t *offsets = img_dsc->data + LVGL_PORT_CIMAGE_HEADER_SIZE + band * sizeof(uint32_t);
+    const uint32_t in_start = lvgl_port_cimage_read32(offsets);
+    const uint32_t in_end = lvgl_port_cimage_read32(offsets + sizeof(uint32_t));
+    const uint32_t rows = LV_MIN(header->band_h, header->h - band * header->band_h);
+    const uint32_t out_size = rows * header->stride;
+
+    bool ok = (in_start <= in_end && in_end <= img_dsc->data_size);
+    if (ok && header->method == LVGL_PORT_CIMAGE_RLE) {
+        ok = lvgl_port_cimage_rle(img_dsc->data + in_start, in_end - in_start, out, out_size, header->px_size);
+    } else if (ok) {
+        ok = lvgl_port_cimage_lz4(img_dsc->data + in_start, in_end - in_start, out, out_size);
+    }
+
+    const uint32_t time_us = (uint32_t)(esp_timer_get_time() - start);
+    portENTER_CRITICAL(&lvgl_port_cimage_ctx.stats_lock);
+    if (ok) {
+        lvgl_port_cimage_ctx.stats.bands++;
+        lvgl_port_cimage_ctx.stats.read_bytes += in_end - in_start;
+        lvgl_port_cimage_ctx.stats.decoded_bytes += out_size;
+        lvgl_port_cimage_ctx.total_us += time_us;
+    } else {
+        lvgl_port_cimage_ctx.stats.errors++;
+    }
+    portEXIT_CRITICAL(&lvgl_port_cimage_ctx.stats_lock);
+
+    if (!ok) {
+        ESP_LOGE(TAG, "Corrupted band %u of compressed image", (unsigned)band);
+    }
+    return ok;
+}
+
+static lv_result_t lvgl_port_cimage_info(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc, lv_image_header_t *header)
+{
+    lvgl_port_cimage_header_t cimage;
+    if (!lvgl_port_cimage_parse(dsc, &cimage)) {
+        return LV_RESULT_INVALID;
+    }
+
+    header->cf = cimage.cf;
+    header->w = cimage.w;
+    header->h = cimage.h;
+    header->stride = cimage.stride;
+    return LV_RESULT_OK;
+}
+
+/* Whole image into LVGL image cache (small, rotated or scaled images) */
+static lv_result_t lvgl_port_cimage_open_cached(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc, const lvgl_port_cimage_header_t *header)
+{
+    lv_draw_buf_t *decoded = lv_draw_buf_create(header->w, header->h, header->cf, header->stride);
+    if (decoded == NULL) {
+        ESP_LOGE(TAG, "Not enough memory for decoded image %ux%u!", header->w, header->h);
+        return LV_RESULT_INVALID;
+    }
+    for (uint32_t band = 0; band < header->bands; band++) {
+        if (!lvgl_port_cimage_decode_band(header, dsc->src, band, decoded->data + band * header->band_h * header->stride)) {
+            lv_draw_buf_destroy(decoded);
+            return LV_RESULT_INVALID;
+        }
+    }
+
+    lv_image_cache_data_t search_key = {
+        .src_type = dsc->src_type,
+        .src = dsc->src,
+        .slot.size = decoded->data_size,
+    };
+    lv_cache_entry_t *entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
+    if (entry == NULL) {
+        lv_draw_buf_destroy(decoded);
+        return LV_RESULT_INVALID;
+    }
+    dsc->decoded = decoded;
+    dsc->cache_entry = entry;
+    return LV_RESULT_OK;
+}
+
+static lv_result_t lvgl_port_cimage_open(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    lvgl_port_cimage_header_t header;
+    if (!lvgl_port_cimage_parse(dsc, &header)) {
+        return LV_RESULT_INVALID;
+    }
+
+    if (header.stride * header.h <= LVGL_PORT_CIMAGE_CACHE_MAX && !dsc->args.no_cache && lv_image_cache_is_enabled()) {
+        return lvgl_port_cimage_open_cached(decoder, dsc, &header);
+    }
+
+    /* Streamed, LVGL draws the image by bands from lvgl_port_cimage_get_area() */
+    lvgl_port_cimage_dec_t *dec = lv_malloc_zeroed(sizeof(lvgl_port_cimage_dec_t));
+    if (dec == NULL) {
+        return LV_RESULT_INVALID;
+    }
+    dec->band_buf = lv_draw_buf_create(header.w, LV_MIN(header.band_h, header.h), header.cf, header.stride);
+    if (dec->band_buf == NULL) {
+        ESP_LOGE(TAG, "Not enough memory for band of compressed image (%u rows)!", header.band_h);
+        lv_free(dec);
+        return LV_RESULT_INVALID;
+    }
+    dec->header = header;
+    dec->img_dsc = dsc->src;
+    dec->band = -1;
+    dsc->user_data = dec;
+    dsc->decoded = NULL;
+    return LV_RESULT_OK;
+}
+
+static lv_result_t lvgl_port_cimage_get_area(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc,
+        const lv_area_t *full_area, lv_area_t *decoded_area)
+{
+    lvgl_port_cimage_dec_t *dec = dsc->user_data;
+    if (dec == NULL) {
+        /* Whole image was decoded */
+        return LV_RESULT_INVALID;
+    }
+    const lvgl_port_cimage_header_t *header = &dec->header;
+
+    /* The next rows of the area, whole rows are decoded */
+    int32_t y = (decoded_area->y1 == LV_COORD_MIN ? full_area->y1 : decoded_area->y2 + 1);
+    y = LV_MAX(y, 0);
+    const int32_t last = LV_MIN(full_area->y2, header->h - 1);
+    if (y > last) {
+        return LV_RESULT_INVALID;
+    }
+
+    const int32_t band = y / header->band_h;
+    if (band != dec->band) {
+        if (!lvgl_port_cimage_decode_band(header, dec->img_dsc, band, dec->band_buf->data)) {
+            dec->band = -1;
+            return LV_RESULT_INVALID;
+        }
+        dec->band = band;
+    }
+
+    const int32_t band_y = band * header->band_h;
+    const int32_t y2 = LV_MIN(band_y + header->band_h - 1, last);
+    const uint32_t rows = y2 - y + 1;
+    lv_draw_buf_init(&dec->rows, header->w, rows, header->cf, header->stride,
+                     dec->band_buf->data + (y - band_y) * header->stride, rows * header->stride);
+
+    decoded_area->x1 = 0;
+    decoded_area->x2 = header->w - 1;
+    decoded_area->y1 = y;
+    decoded_area->y2 = y2;
+    dsc->decoded = &dec->rows;
+    return LV_RESULT_OK;
+}
+
+static void lvgl_port_cimage_close(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    lvgl_port_cimage_dec_t *dec = dsc->user_data;
+    if (dec) {
+        lv_draw_buf_destroy(dec->band_buf);
+        lv_free(dec);
+        dsc->user_data = NULL;
+        dsc->decoded = NULL;
+    }
+    /* Cached images are freed on eviction */
+}
+
+#else
+
+esp_err_t lvgl_port_cimage_decoder_init(void)
+{
+    ESP_LOGW(TAG, "Compressed image decoder requires LVGL 9.2 or newer");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_cimage_decoder_deinit(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_cimage_decoder_get_stats(lvgl_port_cimage_stats_t *stats, bool reset)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
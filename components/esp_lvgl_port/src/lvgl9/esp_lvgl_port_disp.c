@@ -5,18 +5,25 @@
  */
 
 #include <string.h>
+#include <math.h>
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_check.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
 #include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
 #include "esp_idf_version.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
+#include "esp_lcd_panel_commands.h"
+#include "driver/gpio.h"
 #include "esp_lvgl_port.h"
 #include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_rotate.h"
+#include "esp_timer.h"
 
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
 #include "esp_lcd_panel_rgb.h"
@@ -26,18 +33,140 @@
 #include "esp_lcd_mipi_dsi.h"
 #endif
 
+#if CONFIG_SOC_PPA_SUPPORTED && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+#include "driver/ppa.h"
+#define LVGL_PORT_PPA 1
+/* PPA output buffer must be aligned to the (L2) cache line */
+#define LVGL_PORT_PPA_ALIGNMENT (128)
+#else
+#define LVGL_PORT_PPA 0
+#endif
+
+/* Mirror panel is written by PPA into its DPI frame buffer */
+#if LVGL_PORT_PPA && CONFIG_IDF_TARGET_ESP32P4
+#include "esp_cache.h"
+#define LVGL_PORT_MIRROR 1
+#else
+#define LVGL_PORT_MIRROR 0
+#endif
+
 #if (ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(4, 4, 4)) || (ESP_IDF_VERSION == ESP_IDF_VERSION_VAL(5, 0, 0))
 #define LVGL_PORT_HANDLE_FLUSH_READY 0
 #else
 #define LVGL_PORT_HANDLE_FLUSH_READY 1
 #endif
 
+#if LV_VERSION_CHECK(9, 1, 0) && ((CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)) || (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)))
+#define LVGL_PORT_TRIPLE_BUFFER 1
+#else
+#define LVGL_PORT_TRIPLE_BUFFER 0
+#endif
+
+/* Scan-out of RGB panel from virtual frame buffer by bounce buffers (on_bounce_empty of panel without frame buffer) */
+#if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2)
+#define LVGL_PORT_RGB_PAN 1
+#else
+#define LVGL_PORT_RGB_PAN 0
+#endif
+
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+#define LVGL_PORT_STATS_START(name)             int64_t name = esp_timer_get_time()
+#define LVGL_PORT_STATS_ADD(ctx, field, start)  ((ctx)->stats_cur.field += (esp_timer_get_time() - (start)))
+#define LVGL_PORT_STATS_INC(ctx, field)         ((ctx)->stats_cur.field++)
+#else
+#define LVGL_PORT_STATS_START(name)
+#define LVGL_PORT_STATS_ADD(ctx, field, start)
+#define LVGL_PORT_STATS_INC(ctx, field)
+#endif
+
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+/* Started transfer, which calls the transfer done callback (end of frame for touch-to-display latency) */
+#define LVGL_PORT_LATENCY_TRANS(ctx)            ((ctx)->latency_trans_issued++)
+#else
+#define LVGL_PORT_LATENCY_TRANS(ctx)
+#endif
+
+/* Start of transfer, which calls the transfer done callback */
+#define LVGL_PORT_TRANS_START(ctx)  do { LVGL_PORT_LATENCY_TRANS(ctx); LVGL_PORT_TRACE_TRANS_START((ctx)->disp_drv); } while (0)
+
+/* Flush functions specialized for the display configuration and the generic one, which is dropped when it cannot be selected */
+#if CONFIG_LVGL_PORT_FLUSH_PATH_GENERIC
+#define LVGL_PORT_FLUSH_SPECIALIZED 0
+#define LVGL_PORT_FLUSH_GENERIC     1
+#elif CONFIG_LVGL_PORT_FLUSH_PATH_SPECIALIZED
+#define LVGL_PORT_FLUSH_SPECIALIZED 1
+#define LVGL_PORT_FLUSH_GENERIC     0
+#else
+#define LVGL_PORT_FLUSH_SPECIALIZED 1
+#define LVGL_PORT_FLUSH_GENERIC     1
+#endif
+
+#if CONFIG_LVGL_PORT_FLUSH_IN_IRAM
+#define LVGL_PORT_FLUSH_ATTR        IRAM_ATTR
+#else
+#define LVGL_PORT_FLUSH_ATTR
+#endif
+
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+/* Transfer done and vsync callbacks run with disabled cache, the display context they read is in internal RAM */
+#define LVGL_PORT_ISR_ATTR                  IRAM_ATTR
+#define LVGL_PORT_DISP_CTX_CALLOC(size)     heap_caps_calloc(1, (size), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define LVGL_PORT_DISP_CTX_FREE(ptr)        heap_caps_free(ptr)
+/* Ready task only calls flush ready of LVGL (in flash), it must preempt LVGL task busy waiting for it */
+#define LVGL_PORT_READY_TASK_PRIORITY       (configMAX_PRIORITIES - 1)
+#define LVGL_PORT_READY_TASK_STACK          (2048)
+/* Each display has at most one flush waiting for ready */
+#define LVGL_PORT_READY_QUEUE_LEN           (8)
+#else
+#define LVGL_PORT_ISR_ATTR
+#define LVGL_PORT_DISP_CTX_CALLOC(size)     LVGL_PORT_CTX_CALLOC(size)
+#define LVGL_PORT_DISP_CTX_FREE(ptr)        LVGL_PORT_CTX_FREE(ptr)
+#endif
+
 static const char *TAG = "LVGL";
 
+/* Refresh period of vsync paced display, when vsync wake up is missed */
+#define LVGL_PORT_VSYNC_PACING_FALLBACK_MS  (200)
+/* Tolerance of the frame period with vsync pacing (jitter of LVGL task wake up) */
+#define LVGL_PORT_VSYNC_PACING_TOLERANCE_US (2000)
+
+/* Flushed areas are seen by the heatmap or remote view, before the flush function */
+#define LVGL_PORT_FLUSH_TAP                 (CONFIG_LVGL_PORT_HEATMAP || CONFIG_LVGL_PORT_REMOTE_VIEW)
+
+/* Maximal wait for TE edge before the flush of a frame (TE is not coming, e.g. not enabled in LCD controller) */
+#define LVGL_PORT_TE_TIMEOUT_MS             (40)
+
+/* Number of stripes per full draw buffer, when trans_size is not set */
+#define LVGL_PORT_ROTATE_STRIPES_DEFAULT    (4)
+
+/* Rows of round display are sent in one LCD window, while their visible spans differ at most by this (pixels at each side),
+   the few invisible pixels are cheaper than the commands of the next window */
+#define LVGL_PORT_ROUND_RUN_SLACK_PX        (16)
+
+/* Flushed area is split into at most this many bands of rows (filled or sent), the rest is sent in the last band */
+#define LVGL_PORT_HW_FILL_MAX_BANDS         (8)
+
 /*******************************************************************************
 * Types definitions
 *******************************************************************************/
 
+typedef struct {
+    int                       x1;             /* Area in LCD coordinates (end exclusive) */
+    int                       y1;
+    int                       x2;
+    int                       y2;
+    const void                *color_map;     /* Data to send, NULL stops the flush task */
+} lvgl_port_flush_job_t;
+
+/* Lines of the scrolling area are in ring lines of the virtual frame buffer from its top, they are shown from offset
+   (wrapped around) and the lines below the area follow the ring */
+typedef struct {
+    int32_t                   top;            /* First line of the scrolling area */
+    int32_t                   height;         /* Panel lines of the scrolling area */
+    int32_t                   ring;           /* Frame buffer lines of the scrolling area (height and off-screen lines) */
+    int32_t                   offset;         /* First shown line of the ring (0 .. ring - 1) */
+} lvgl_port_pan_map_t;
+
 typedef struct {
     lvgl_port_disp_type_t     disp_type;    /* Display type */
     esp_lcd_panel_io_handle_t io_handle;      /* LCD panel IO handle */
@@ -45,27 +174,176 @@ typedef struct {
     esp_lcd_panel_handle_t    control_handle; /* LCD panel control handle */
     lvgl_port_rotation_cfg_t  rotation;       /* Default values of the screen rotation */
     lv_color_t                *draw_buffs[3]; /* Display draw buffers */
+    uint32_t                  draw_buff_size; /* Size of one of the partial draw buffers in bytes (0: not partial mode) */
+    uint32_t                  draw_buff_caps; /* Memory capabilities of own draw buffers */
     uint8_t                   *oled_buffer;
+    uint8_t                   *oled_shadow;   /* Pages last sent to monochrome display (copy of its RAM), NULL if not used */
+    bool                      oled_shadow_valid; /* Shadow matches the display RAM */
     lv_display_t              *disp_drv;      /* LVGL display driver */
+    lv_display_flush_cb_t     flush_cb;       /* Flush function selected for the display configuration (called by stats and trace wrappers) */
     lv_display_rotation_t     current_rotation;
     SemaphoreHandle_t         trans_sem;      /* Idle transfer mutex */
+    lv_color_t                *rotate_buffs[2]; /* Rotation stripe buffers (pipelined SW rotation) */
+    uint32_t                  rotate_buff_size; /* Size of one rotation stripe buffer in pixels */
+    SemaphoreHandle_t         rotate_sem;     /* Counting semaphore of free rotation stripe buffers */
+    uint8_t                   rotate_idx;     /* Index of the next rotation stripe buffer */
+    uint8_t                   *convert_buffs[2]; /* Color conversion buffers (panel_color_format) */
+    uint32_t                  convert_buff_size; /* Size of one color conversion buffer in bytes */
+    lv_color_format_t         panel_color_format; /* Current color format of the conversion buffers */
+    uint16_t                  *convert_lut;   /* RGB565 colors of L8 values (L8 rendering, in panel byte order) */
+    uint8_t                   convert_idx;    /* Index of the next color conversion buffer */
+    SemaphoreHandle_t         convert_sem;    /* Counting semaphore of free color conversion buffers */
+    uint8_t                   *coalesce_buffs[2]; /* Flush coalescing buffers */
+    uint32_t                  coalesce_buff_size; /* Size of one flush coalescing buffer in bytes */
+    uint32_t                  coalesce_len;   /* Used bytes in the current flush coalescing buffer */
+    uint8_t                   coalesce_idx;   /* Index of the current flush coalescing buffer */
+    lv_area_t                 coalesce_area;  /* Merged area in the current flush coalescing buffer */
+    SemaphoreHandle_t         coalesce_sem;   /* Counting semaphore of free flush coalescing buffers */
+    QueueHandle_t             flush_queue;    /* Areas sent by flush task */
+    SemaphoreHandle_t         flush_done_sem; /* Transfer of flush task done */
+    SemaphoreHandle_t         flush_task_sem; /* Flush task stopped */
+    uint32_t                  refr_period_ms; /* Refresh period of this display (0 is default) */
+    volatile bool             flush_busy;     /* LVGL area is being transferred (external transfers wait for it) */
+    volatile bool             ext_busy;       /* External buffer is being transferred (video layer) */
+    lvgl_port_disp_ext_done_cb_t ext_done_cb; /* Callback of external transfer done */
+    void                      *ext_ctx;       /* User context of external transfer done callback */
+    volatile bool             vsync_armed;    /* Frame is requested, wake LVGL task on the next vsync (vsync pacing) */
+    bool                      fb_wait_pending; /* Flushed frame buffer is shown from the next vsync, drawing into the other one waits for it (double buffering) */
+    struct {
+        lvgl_port_hw_fill_cb_t fill_rect;     /* Fill of solid areas by LCD controller, NULL if not used */
+        uint32_t              min_pixels;     /* Smaller solid bands are transferred */
+    } hw_fill;
+    volatile uint16_t         flush_parts;    /* Transfers of the flushed area (hardware scroll remap, round mask), flush ready after the last one */
+    uint16_t                  *round_x1;      /* First visible pixel of each row of round display (last is round_size - 1 - first), NULL if not used */
+    int32_t                   round_size;     /* Diameter of round display */
+    struct {
+        lv_obj_t              *obj;           /* Object scrolled by hardware, NULL if not used */
+        lvgl_port_hw_scroll_cfg_t cfg;        /* Hardware scroll functions of LCD driver */
+        int32_t               top;            /* First line of the vertical scrolling area */
+        int32_t               height;         /* Lines of the vertical scrolling area */
+        int32_t               ring;           /* Lines of the scrolling area in frame memory, more than height with off-screen lines of panned RGB */
+        int32_t               offset;         /* Lines scrolled by hardware (0 .. ring - 1) */
+        int32_t               scroll_x;       /* Last scroll position of the object */
+        int32_t               scroll_y;
+        lv_area_t             exposed;        /* Lines exposed by the last scroll, the invalidation of the object is reduced to them */
+        bool                  exposed_pending;
+        bool                  dirty;          /* Area in the scrolling area invalidated (not redrawn yet) */
+    } hw_scroll;
+    struct {
+        lvgl_port_disp_ambient_cfg_t cfg;
+        lv_obj_t              *prev_screen;   /* Screen shown before ambient mode */
+        esp_timer_handle_t    timer;          /* Update of the screen (created on the first use) */
+        volatile bool         active;
+        bool                  stopped;        /* LVGL timers were stopped by entry to ambient mode */
+    } ambient;
+    struct {
+        uint8_t               *fb;            /* Virtual frame buffer of panned RGB display, NULL if not used */
+        uint32_t              lines;          /* Lines of the virtual frame buffer (panel lines and off-screen lines) */
+        uint32_t              stride;         /* Bytes of one line */
+        uint32_t              px_size;        /* Bytes of one pixel */
+        int32_t               hres;           /* Panel resolution */
+        int32_t               vres;
+        lvgl_port_pan_map_t   next;           /* Mapping of the rendered lines, scanned out from the next frame */
+        lvgl_port_pan_map_t   cur;            /* Mapping of the scanned frame */
+        portMUX_TYPE          lock;           /* Lock of the next mapping (shared with bounce buffer ISR) */
+    } pan;
+    int64_t                   frame_start;    /* Start of the last vsync paced frame */
+    int                       te_gpio_num;    /* Tearing effect output of LCD controller (only with te_sem) */
+    SemaphoreHandle_t         te_sem;         /* TE edge came (TE synchronized flush) */
+    bool                      te_wait;        /* Wait for TE edge before the first flush of the frame */
+#if LVGL_PORT_PPA
+    ppa_client_handle_t       ppa_handle;     /* PPA client for rotation (scale-rotate-mirror) */
+    uint32_t                  ppa_buff_size;  /* Size of the aligned rotation buffer in bytes */
+    void                      *ppa_fb;        /* MIPI-DSI frame buffer, PPA writes rotated areas into it directly */
+#endif
+#if LVGL_PORT_MIRROR
+    struct {
+        lvgl_port_disp_mirror_cfg_t cfg;      /* Mirror panel (panel_handle NULL: no mirror) */
+        ppa_client_handle_t   ppa;            /* PPA client of the mirror (scale-rotate-mirror) */
+        void                  *fb;            /* Frame buffer of the mirror panel */
+        ppa_srm_color_mode_t  out_cm;
+        uint32_t              px_size;        /* Pixel size in the mirror frame buffer */
+        float                 scale;          /* Scale in steps of PPA */
+        int32_t               offset_x;       /* Position of the content on the mirror panel */
+        int32_t               offset_y;
+        lv_display_flush_cb_t flush_cb;       /* Flush of the display itself */
+    } mirror;
+#endif
+#if LVGL_PORT_TRIPLE_BUFFER
+    void                      *fbs[3];        /* RGB/DSI frame buffers (triple buffering) */
+    lv_draw_buf_t             fb_draw_bufs[2]; /* LVGL draw buffers, pointing to the frame buffers which are not displayed */
+    volatile int8_t           fb_displayed;   /* Index of displayed frame buffer */
+    volatile int8_t           fb_pending;     /* Index of frame buffer waiting for vsync, -1 if none */
+    volatile uint32_t         fb_vsyncs;      /* Count of vsyncs (swap of frame buffer is racing with vsync) */
+    lv_area_t                 fb_missing[3];  /* Area, which is not up to date in the frame buffer (direct mode) */
+    lv_area_t                 frame_dirty;    /* Area redrawn in the current frame (direct mode) */
+    portMUX_TYPE              fb_lock;        /* Frame buffer state lock (shared with vsync ISR) */
+#endif
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+    lvgl_port_disp_counters_t stats_total;    /* Cumulative counters of finished windows */
+    lvgl_port_disp_counters_t stats_window;   /* Counters of the last finished window */
+    lvgl_port_disp_counters_t stats_cur;      /* Counters of the current window */
+    int64_t                   stats_window_start; /* Start of the current window */
+    int64_t                   stats_render_start; /* Start of the current LVGL rendering */
+#endif
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    uint32_t                  latency_trans_issued; /* Count of started transfers */
+    volatile uint32_t         latency_trans_done;   /* Count of finished transfers (updated from ISR) */
+#endif
+#if CONFIG_LVGL_PORT_HEATMAP
+    lvgl_port_heatmap_t       *heatmap;       /* Invalidation and flush heatmap */
+#endif
+#if CONFIG_LVGL_PORT_REMOTE_VIEW
+    lvgl_port_remote_t        *remote;        /* Remote view */
+#endif
     struct {
         unsigned int monochrome: 1;  /* True, if display is monochrome and using 1bit for 1px */
         unsigned int swap_bytes: 1;  /* Swap bytes in RGB656 (16-bit) before send to LCD driver */
         unsigned int full_refresh: 1;   /* Always make the whole screen redrawn */
         unsigned int direct_mode: 1;    /* Use screen-sized buffers and draw to absolute coordinates */
         unsigned int sw_rotate: 1;    /* Use software rotation (slower) or PPA if available */
+        unsigned int sw_rotate_stripes: 1; /* Rotate in stripes overlapped with the LCD transfer */
+        unsigned int sw_rotate_tiled: 1; /* Use tiled rotation kernel */
+        unsigned int triple_buffer: 1;  /* Render into the third frame buffer, while waiting for vsync */
+        unsigned int frame_skip: 1;     /* Drop the not displayed frame instead of blocking */
+        unsigned int vsync_pacing: 1;   /* Start rendering on panel vsync */
+        unsigned int static_mem: 1;     /* Context and buffers are provided by the application (not freed) */
+        unsigned int bb_mode: 1;        /* RGB panel in bounce buffer mode (frame end is signaled by bounce frame finish) */
     } flags;
+    StaticSemaphore_t         trans_sem_buf;  /* Transport semaphore with static memory */
+    SemaphoreHandle_t         idle_sem;       /* Given by transfer done callback, when flush_busy or ext_busy is cleared */
+    StaticSemaphore_t         idle_sem_buf;
 } lvgl_port_display_ctx_t;
 
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+typedef struct {
+    QueueHandle_t             queue;          /* Displays with transfer done in ISR, NULL stops the task */
+    SemaphoreHandle_t         stopped_sem;    /* Ready task stopped */
+    uint32_t                  users;          /* Count of displays */
+} lvgl_port_ready_ctx_t;
+#endif
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+static lvgl_port_ready_ctx_t lvgl_port_ready_ctx;
+/* Core of flush tasks, the same as LVGL task (-1 is no affinity) */
+static int lvgl_port_flush_task_affinity = -1;
+#endif
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
 static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp_cfg, const lvgl_port_disp_priv_cfg_t *priv_cfg);
+static void lvgl_port_disp_static_size(const lvgl_port_display_cfg_t *disp_cfg, lvgl_port_disp_static_size_t *size);
+static void lvgl_port_disp_wait_idle(lvgl_port_display_ctx_t *disp_ctx);
 #if LVGL_PORT_HANDLE_FLUSH_READY
 static bool lvgl_port_flush_io_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
 static bool lvgl_port_flush_rgb_vsync_ready_callback(esp_lcd_panel_handle_t panel_io, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx);
+static esp_err_t lvgl_port_disp_rgb_register_callbacks(lvgl_port_display_ctx_t *disp_ctx);
 #endif
 #if (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
 static bool lvgl_port_flush_dpi_panel_ready_callback(esp_lcd_panel_handle_t panel_io, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx);
@@ -73,9 +351,72 @@ static bool lvgl_port_flush_dpi_vsync_ready_callback(esp_lcd_panel_handle_t pane
 #endif
 #endif
 static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_flush_direct(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_flush_direct_swap(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_flush_fb(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static esp_err_t lvgl_port_flush_update(lvgl_port_display_ctx_t *disp_ctx);
+static void lvgl_port_flush_monochrome_pages(lv_display_t *drv, const lv_area_t *area, const uint8_t *pages);
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+static void lvgl_port_flush_stats_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_stats_render_callback(lv_event_t *e);
+static void lvgl_port_stats_accumulate(lvgl_port_disp_counters_t *dest, const lvgl_port_disp_counters_t *src);
+static void lvgl_port_stats_update_window(lvgl_port_display_ctx_t *disp_ctx, int64_t now);
+#endif
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+static void lvgl_port_latency_render_callback(lv_event_t *e);
+#endif
+#if LVGL_PORT_TRACE
+static void lvgl_port_flush_trace_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_trace_render_callback(lv_event_t *e);
+#endif
+#if LVGL_PORT_FLUSH_TAP
+static void lvgl_port_flush_tap_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+#endif
+static void lvgl_port_flush_rotate_stripes(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_flush_convert(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_disp_fill_lut(lvgl_port_display_ctx_t *disp_ctx, const lv_color_t *palette);
+static void lvgl_port_flush_coalesce(lv_display_t *drv, int x1, int y1, int x2, int y2, uint8_t *color_map);
+static void lvgl_port_flush_triple(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_fb_wait_callback(lv_event_t *e);
+#if LVGL_PORT_PPA
+static bool lvgl_port_ppa_rotate(lv_display_t *drv, lv_area_t *area, uint8_t *color_map);
+static bool lvgl_port_ppa_done_callback(ppa_client_handle_t ppa_client, ppa_event_data_t *event_data, void *user_data);
+#endif
+#if LVGL_PORT_MIRROR
+static void lvgl_port_mirror_update(lvgl_port_display_ctx_t *disp_ctx);
+static void lvgl_port_flush_mirror_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+#endif
 static void lvgl_port_disp_size_update_callback(lv_event_t *e);
 static void lvgl_port_disp_rotation_update(lvgl_port_display_ctx_t *disp_ctx);
 static void lvgl_port_display_invalidate_callback(lv_event_t *e);
+static void lvgl_port_flush_task(void *arg);
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+static esp_err_t lvgl_port_ready_task_start(void);
+static void lvgl_port_ready_task_stop(void);
+#endif
+static void lvgl_port_flush_wait_callback(lv_display_t *drv);
+static void lvgl_port_flush_hw_scroll(lv_display_t *drv, int x1, int y1, int x2, int y2, uint8_t *color_map);
+static bool lvgl_port_flush_hw_fill(lv_display_t *drv, int x1, int y1, int x2, int y2, const uint8_t *color_map);
+static void lvgl_port_hw_scroll_callback(lv_event_t *e);
+static void lvgl_port_hw_scroll_refr_callback(lv_event_t *e);
+static void lvgl_port_hw_scroll_invalidate(lvgl_port_display_ctx_t *disp_ctx, lv_area_t *area);
+static void lvgl_port_ambient_timer_cb(void *arg);
+static void lvgl_port_ambient_update(void *arg);
+static void lvgl_port_hw_scroll_disable(lvgl_port_display_ctx_t *disp_ctx, bool obj_deleted);
+static void lvgl_port_pan_draw(lvgl_port_display_ctx_t *disp_ctx, int x1, int y1, int x2, int y2, const uint8_t *color_map, uint32_t stride);
+#if LVGL_PORT_RGB_PAN
+static esp_err_t lvgl_port_pan_init(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_rgb_cfg_t *rgb_cfg);
+static bool lvgl_port_pan_bounce_callback(esp_lcd_panel_handle_t panel, void *bounce_buf, int pos_px, int len_bytes, void *user_ctx);
+static void lvgl_port_pan_refr_callback(lv_event_t *e);
+#endif
+static esp_err_t lvgl_port_round_init(lvgl_port_display_ctx_t *disp_ctx, int32_t size);
+static void lvgl_port_round_invalidate(lvgl_port_display_ctx_t *disp_ctx, lv_area_t *area);
+static void lvgl_port_flush_round(lv_display_t *drv, int x1, int y1, int x2, int y2, uint8_t *color_map);
+#if LVGL_PORT_HANDLE_FLUSH_READY
+static esp_err_t lvgl_port_disp_te_init(lvgl_port_display_ctx_t *disp_ctx, int te_gpio_num);
+static void lvgl_port_te_isr(void *arg);
+static void lvgl_port_te_render_callback(lv_event_t *e);
+#endif
 
 /*******************************************************************************
 * Public API functions
@@ -98,7 +439,7 @@ lv_display_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
             .on_color_trans_done = lvgl_port_flush_io_ready_callback,
         };
         /* Register done callback */
-        esp_lcd_panel_io_register_event_callbacks(disp_ctx->io_handle, &cbs, disp);
+        esp_lcd_panel_io_register_event_callbacks(disp_ctx->io_handle, &cbs, disp_ctx);
 #endif
 
         /* Apply rotation from initial display configuration */
@@ -114,6 +455,9 @@ lv_display_t *lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t *disp_cfg, co
     assert(dsi_cfg != NULL);
     const lvgl_port_disp_priv_cfg_t priv_cfg = {
         .avoid_tearing = dsi_cfg->flags.avoid_tearing,
+        .triple_buffer = dsi_cfg->flags.triple_buffer,
+        .frame_skip = dsi_cfg->flags.frame_skip,
+        .vsync_pacing = dsi_cfg->flags.vsync_pacing,
     };
     lvgl_port_lock(0);
     lv_disp_t *disp = lvgl_port_add_disp_priv(disp_cfg, &priv_cfg);
@@ -129,9 +473,26 @@ lv_display_t *lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t *disp_cfg, co
             cbs.on_refresh_done = lvgl_port_flush_dpi_vsync_ready_callback;
         } else {
             cbs.on_color_trans_done = lvgl_port_flush_dpi_panel_ready_callback;
+            if (dsi_cfg->flags.vsync_pacing) {
+                cbs.on_refresh_done = lvgl_port_flush_dpi_vsync_ready_callback;
+            }
         }
         /* Register done callback */
-        esp_lcd_dpi_panel_register_event_callbacks(disp_ctx->panel_handle, &cbs, disp);
+        esp_lcd_dpi_panel_register_event_callbacks(disp_ctx->panel_handle, &cbs, disp_ctx);
+
+#if LVGL_PORT_PPA
+        if (disp_ctx->ppa_handle && !dsi_cfg->flags.avoid_tearing) {
+            /* PPA rotates directly into the frame buffer, the flush is done in PPA done callback */
+            const ppa_event_callbacks_t ppa_cbs = {
+                .on_trans_done = lvgl_port_ppa_done_callback,
+            };
+            if (esp_lcd_dpi_panel_get_frame_buffer(disp_ctx->panel_handle, 1, &disp_ctx->ppa_fb) == ESP_OK) {
+                ppa_client_register_event_callbacks(disp_ctx->ppa_handle, &ppa_cbs);
+            } else {
+                disp_ctx->ppa_fb = NULL;
+            }
+        }
+#endif
 
         /* Apply rotation from initial display configuration */
         lvgl_port_disp_rotation_update(disp_ctx);
@@ -150,6 +511,9 @@ lv_display_t *lvgl_port_add_disp_rgb(const lvgl_port_display_cfg_t *disp_cfg, co
     assert(rgb_cfg != NULL);
     const lvgl_port_disp_priv_cfg_t priv_cfg = {
         .avoid_tearing = rgb_cfg->flags.avoid_tearing,
+        .triple_buffer = rgb_cfg->flags.triple_buffer,
+        .frame_skip = rgb_cfg->flags.frame_skip,
+        .vsync_pacing = rgb_cfg->flags.vsync_pacing,
     };
     lv_disp_t *disp = lvgl_port_add_disp_priv(disp_cfg, &priv_cfg);
 
@@ -159,22 +523,23 @@ lv_display_t *lvgl_port_add_disp_rgb(const lvgl_port_display_cfg_t *disp_cfg, co
         disp_ctx->disp_type = LVGL_PORT_DISP_TYPE_RGB;
 
 #if (CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0))
-        /* Register done callback */
-        const esp_lcd_rgb_panel_event_callbacks_t vsync_cbs = {
-            .on_vsync = lvgl_port_flush_rgb_vsync_ready_callback,
-        };
-
-        const esp_lcd_rgb_panel_event_callbacks_t bb_cbs = {
-#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2)
-            .on_bounce_frame_finish = lvgl_port_flush_rgb_vsync_ready_callback,
+        disp_ctx->flags.bb_mode = rgb_cfg->flags.bb_mode;
+        if (rgb_cfg->flags.pan) {
+#if LVGL_PORT_RGB_PAN
+            const esp_err_t ret = lvgl_port_pan_init(disp_ctx, rgb_cfg);
+#else
+            const esp_err_t ret = ESP_ERR_NOT_SUPPORTED;
 #endif
-        };
-
-        if (rgb_cfg->flags.bb_mode && (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2))) {
-            ESP_ERROR_CHECK(esp_lcd_rgb_panel_register_event_callbacks(disp_ctx->panel_handle, &bb_cbs, disp_ctx->disp_drv));
-        } else {
-            ESP_ERROR_CHECK(esp_lcd_rgb_panel_register_event_callbacks(disp_ctx->panel_handle, &vsync_cbs, disp_ctx->disp_drv));
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "Pan of RGB display init failed: %s", esp_err_to_name(ret));
+                lvgl_port_unlock();
+                lvgl_port_remove_disp(disp);
+                return NULL;
+            }
         }
+
+        /* Register done callback */
+        ESP_ERROR_CHECK(lvgl_port_disp_rgb_register_callbacks(disp_ctx));
 #else
         ESP_RETURN_ON_FALSE(false, NULL, TAG, "RGB is supported only on ESP32S3 and from IDF 5.0!");
 #endif
@@ -192,31 +557,147 @@ esp_err_t lvgl_port_remove_disp(lv_display_t *disp)
     assert(disp);
     lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
 
+    if (disp_ctx->flush_queue) {
+        /* Stop flush task, after the pending transfer */
+        const lvgl_port_flush_job_t stop = {0};
+        xQueueSend(disp_ctx->flush_queue, &stop, portMAX_DELAY);
+        xSemaphoreTake(disp_ctx->flush_task_sem, portMAX_DELAY);
+        vQueueDelete(disp_ctx->flush_queue);
+        vSemaphoreDelete(disp_ctx->flush_task_sem);
+        vSemaphoreDelete(disp_ctx->flush_done_sem);
+    }
+
     lvgl_port_lock(0);
+    lvgl_port_hw_scroll_disable(disp_ctx, false);
+    if (disp_ctx->ambient.timer) {
+        disp_ctx->ambient.active = false;
+        esp_timer_stop(disp_ctx->ambient.timer);
+        esp_timer_delete(disp_ctx->ambient.timer);
+    }
+#if CONFIG_LVGL_PORT_REMOTE_VIEW
+    lvgl_port_remote_delete(disp_ctx->remote);
+#endif
     lv_disp_remove(disp);
+#if CONFIG_LVGL_PORT_HEATMAP
+    lvgl_port_heatmap_delete(disp_ctx->heatmap);
+#endif
     lvgl_port_unlock();
 
-    if (disp_ctx->draw_buffs[0]) {
-        free(disp_ctx->draw_buffs[0]);
+#if LVGL_PORT_RGB_PAN
+    if (disp_ctx->pan.fb) {
+        /* Bounce buffers are not filled from the freed virtual frame buffer */
+        const esp_lcd_rgb_panel_event_callbacks_t cbs = {0};
+        esp_lcd_rgb_panel_register_event_callbacks(disp_ctx->panel_handle, &cbs, NULL);
+        heap_caps_free(disp_ctx->pan.fb);
     }
+#endif
 
-    if (disp_ctx->draw_buffs[1]) {
-        free(disp_ctx->draw_buffs[1]);
-    }
+    if (!disp_ctx->flags.static_mem) {
+        if (disp_ctx->draw_buffs[0]) {
+            free(disp_ctx->draw_buffs[0]);
+        }
+
+        if (disp_ctx->draw_buffs[1]) {
+            free(disp_ctx->draw_buffs[1]);
+        }
+
+        if (disp_ctx->draw_buffs[2]) {
+            free(disp_ctx->draw_buffs[2]);
+        }
 
-    if (disp_ctx->draw_buffs[2]) {
-        free(disp_ctx->draw_buffs[2]);
+        if (disp_ctx->oled_buffer) {
+            free(disp_ctx->oled_buffer);
+        }
     }
 
-    if (disp_ctx->oled_buffer) {
-        free(disp_ctx->oled_buffer);
+    if (disp_ctx->oled_shadow) {
+        free(disp_ctx->oled_shadow);
     }
 
     if (disp_ctx->trans_sem) {
         vSemaphoreDelete(disp_ctx->trans_sem);
     }
 
-    free(disp_ctx);
+    if (disp_ctx->idle_sem) {
+        vSemaphoreDelete(disp_ctx->idle_sem);
+    }
+
+    if (disp_ctx->te_sem) {
+        gpio_isr_handler_remove(disp_ctx->te_gpio_num);
+        gpio_reset_pin(disp_ctx->te_gpio_num);
+        vSemaphoreDelete(disp_ctx->te_sem);
+    }
+
+#if LVGL_PORT_PPA
+    if (disp_ctx->ppa_handle) {
+        ppa_unregister_client(disp_ctx->ppa_handle);
+    }
+#endif
+#if LVGL_PORT_MIRROR
+    if (disp_ctx->mirror.ppa) {
+        ppa_unregister_client(disp_ctx->mirror.ppa);
+    }
+#endif
+
+    if (disp_ctx->rotate_sem) {
+        /* Wait for all in-flight rotation stripes */
+        xSemaphoreTake(disp_ctx->rotate_sem, portMAX_DELAY);
+        xSemaphoreTake(disp_ctx->rotate_sem, portMAX_DELAY);
+        vSemaphoreDelete(disp_ctx->rotate_sem);
+    }
+
+    if (disp_ctx->rotate_buffs[0]) {
+        free(disp_ctx->rotate_buffs[0]);
+    }
+
+    if (disp_ctx->rotate_buffs[1]) {
+        free(disp_ctx->rotate_buffs[1]);
+    }
+
+    if (disp_ctx->convert_sem) {
+        /* Wait for all in-flight converted stripes */
+        xSemaphoreTake(disp_ctx->convert_sem, portMAX_DELAY);
+        xSemaphoreTake(disp_ctx->convert_sem, portMAX_DELAY);
+        vSemaphoreDelete(disp_ctx->convert_sem);
+    }
+
+    if (disp_ctx->convert_buffs[0]) {
+        free(disp_ctx->convert_buffs[0]);
+    }
+
+    if (disp_ctx->convert_buffs[1]) {
+        free(disp_ctx->convert_buffs[1]);
+    }
+
+    if (disp_ctx->convert_lut) {
+        free(disp_ctx->convert_lut);
+    }
+
+    if (disp_ctx->coalesce_sem) {
+        /* Wait for all in-flight coalesced transfers */
+        xSemaphoreTake(disp_ctx->coalesce_sem, portMAX_DELAY);
+        xSemaphoreTake(disp_ctx->coalesce_sem, portMAX_DELAY);
+        vSemaphoreDelete(disp_ctx->coalesce_sem);
+    }
+
+    if (disp_ctx->coalesce_buffs[0]) {
+        free(disp_ctx->coalesce_buffs[0]);
+    }
+
+    if (disp_ctx->coalesce_buffs[1]) {
+        free(disp_ctx->coalesce_buffs[1]);
+    }
+
+    if (disp_ctx->round_x1) {
+        free(disp_ctx->round_x1);
+    }
+
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+    lvgl_port_ready_task_stop();
+#endif
+    if (!disp_ctx->flags.static_mem) {
+        LVGL_PORT_DISP_CTX_FREE(disp_ctx);
+    }
 
     return ESP_OK;
 }
@@ -227,10 +708,67 @@ void lvgl_port_flush_ready(lv_display_t *disp)
     lv_disp_flush_ready(disp);
 }
 
+esp_err_t lvgl_port_get_disp_stats(lv_display_t *disp, lvgl_port_disp_stats_t *stats)
+{
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+    ESP_RETURN_ON_FALSE(disp && stats, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments!");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "Invalid display!");
+
+    lvgl_port_lock(0);
+    lvgl_port_stats_update_window(disp_ctx, esp_timer_get_time());
+    stats->window = disp_ctx->stats_window;
+    stats->total = disp_ctx->stats_total;
+    lvgl_port_stats_accumulate(&stats->total, &disp_ctx->stats_cur);
+    lvgl_port_unlock();
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
 
+/* Wait for LVGL or external transfer in progress (I2C/SPI/I8080), the task is blocked until its transfer done callback */
+static void lvgl_port_disp_wait_idle(lvgl_port_display_ctx_t *disp_ctx)
+{
+    bool waited = false;
+    /* Semaphore given by an earlier transfer done is taken without waiting, the flags are checked again */
+    while (disp_ctx->flush_busy || disp_ctx->ext_busy) {
+        xSemaphoreTake(disp_ctx->idle_sem, portMAX_DELAY);
+        waited = true;
+    }
+    if (waited) {
+        /* Other task waiting for the same transfer (LVGL task and reconfiguration) is woken too */
+        xSemaphoreGive(disp_ctx->idle_sem);
+    }
+}
+
+/* Sizes of the buffers allocated in lvgl_port_add_disp_priv */
+static void lvgl_port_disp_static_size(const lvgl_port_display_cfg_t *disp_cfg, lvgl_port_disp_static_size_t *size)
+{
+    const lv_color_format_t cf = (disp_cfg->color_format != 0 ? disp_cfg->color_format : LV_COLOR_FORMAT_RGB565);
+    const uint32_t buffer_px_size = (cf == LV_COLOR_FORMAT_L8 ? 1 : sizeof(lv_color_t));
+
+    memset(size, 0, sizeof(lvgl_port_disp_static_size_t));
+    size->ctx_size = sizeof(lvgl_port_display_ctx_t);
+    size->buf_size = disp_cfg->buffer_size * buffer_px_size;
+    size->align = sizeof(uint32_t);
+    if (disp_cfg->flags.sw_rotate) {
+        size->rotate_buf_size = disp_cfg->buffer_size * sizeof(lv_color_t);
+#if LVGL_PORT_PPA
+        size->align = LVGL_PORT_PPA_ALIGNMENT;
+        size->rotate_buf_size = (size->rotate_buf_size + LVGL_PORT_PPA_ALIGNMENT - 1) & ~(LVGL_PORT_PPA_ALIGNMENT - 1);
+#endif
+    }
+    if (disp_cfg->monochrome && cf == LV_COLOR_FORMAT_I1) {
+        size->oled_buf_size = disp_cfg->buffer_size;
+    }
+}
+
 static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp_cfg, const lvgl_port_disp_priv_cfg_t *priv_cfg)
 {
     esp_err_t ret = ESP_OK;
@@ -248,23 +786,61 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
     buffer_size = disp_cfg->buffer_size;
 
     /* Check supported display color formats */
-    ESP_RETURN_ON_FALSE(disp_cfg->color_format == 0 || disp_cfg->color_format == LV_COLOR_FORMAT_RGB565 || disp_cfg->color_format == LV_COLOR_FORMAT_RGB888 || disp_cfg->color_format == LV_COLOR_FORMAT_XRGB8888 || disp_cfg->color_format == LV_COLOR_FORMAT_ARGB8888 || disp_cfg->color_format == LV_COLOR_FORMAT_I1, NULL, TAG, "Not supported display color format!");
+    ESP_RETURN_ON_FALSE(disp_cfg->color_format == 0 || disp_cfg->color_format == LV_COLOR_FORMAT_RGB565 || disp_cfg->color_format == LV_COLOR_FORMAT_RGB888 || disp_cfg->color_format == LV_COLOR_FORMAT_XRGB8888 || disp_cfg->color_format == LV_COLOR_FORMAT_ARGB8888 || disp_cfg->color_format == LV_COLOR_FORMAT_I1 || disp_cfg->color_format == LV_COLOR_FORMAT_L8, NULL, TAG, "Not supported display color format!");
 
     lv_color_format_t display_color_format = (disp_cfg->color_format != 0 ? disp_cfg->color_format : LV_COLOR_FORMAT_RGB565);
+    /* Conversion of 24/32-bit rendered areas to RGB565 or packed 24-bit (RGB666/RGB888) panel,
+       RGB888 rendering to RGB888 panel with swap_bytes changes only the byte order (blue, green, red -> red, green, blue) */
+    const bool convert = (disp_cfg->panel_color_format != 0 && (disp_cfg->panel_color_format != display_color_format ||
+                          (disp_cfg->panel_color_format == LV_COLOR_FORMAT_RGB888 && disp_cfg->flags.swap_bytes)));
+    if (convert) {
+        ESP_RETURN_ON_FALSE(((disp_cfg->panel_color_format == LV_COLOR_FORMAT_RGB565 || disp_cfg->panel_color_format == LV_COLOR_FORMAT_RGB888) &&
+                             (display_color_format == LV_COLOR_FORMAT_RGB888 || display_color_format == LV_COLOR_FORMAT_XRGB8888 || display_color_format == LV_COLOR_FORMAT_ARGB8888)) ||
+                            (disp_cfg->panel_color_format == LV_COLOR_FORMAT_RGB565 && display_color_format == LV_COLOR_FORMAT_L8),
+                            NULL, TAG, "Only RGB888/XRGB8888/ARGB8888 to RGB565/RGB888 or L8 to RGB565 panel color format conversion is supported!");
+        ESP_RETURN_ON_FALSE(LVGL_PORT_HANDLE_FLUSH_READY && priv_cfg == NULL, NULL, TAG, "Panel color format conversion can be used only with lvgl_port_add_disp!");
+        ESP_RETURN_ON_FALSE(!disp_cfg->monochrome && !disp_cfg->flags.sw_rotate && !disp_cfg->flags.coalesce_flush && !disp_cfg->flags.flush_task,
+                            NULL, TAG, "Panel color format conversion cannot be used with monochrome, SW rotation, flush coalescing or flush task!");
+    }
     if (disp_cfg->flags.swap_bytes) {
-        /* Swap bytes can be used only in RGB565 color format */
-        ESP_RETURN_ON_FALSE(display_color_format == LV_COLOR_FORMAT_RGB565, NULL, TAG, "Swap bytes can be used only in display color format RGB565!");
+        /* Swap bytes can be used only in RGB565 color format (or with conversion to it) */
+        ESP_RETURN_ON_FALSE(display_color_format == LV_COLOR_FORMAT_RGB565 || convert, NULL, TAG, "Swap bytes can be used only in display color format RGB565!");
     }
 
+    /* L8 is rendered only for expanding to RGB565 panel */
+    ESP_RETURN_ON_FALSE(display_color_format != LV_COLOR_FORMAT_L8 || convert, NULL, TAG, "Display color format L8 can be used only with panel color format RGB565!");
+    /* Allocated draw buffers: one byte per pixel in L8 (twice as many lines as RGB565 in the same memory) */
+    const uint32_t buffer_px_size = (display_color_format == LV_COLOR_FORMAT_L8 ? 1 : sizeof(lv_color_t));
+
     if (disp_cfg->flags.buff_dma) {
         /* DMA buffer can be used only in RGB565 color format */
         ESP_RETURN_ON_FALSE(display_color_format == LV_COLOR_FORMAT_RGB565, NULL, TAG, "DMA buffer can be used only in display color format RGB565 (not alligned copy)!");
     }
 
+    /* Memory provided by the application, the features allocating own buffers or tasks are not available */
+    const lvgl_port_disp_static_mem_t *static_mem = disp_cfg->static_mem;
+    if (static_mem) {
+        ESP_RETURN_ON_FALSE(static_mem->ctx && ((uintptr_t)static_mem->ctx & 3) == 0, NULL, TAG, "Invalid static display context!");
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+        ESP_RETURN_ON_FALSE(esp_ptr_internal(static_mem->ctx), NULL, TAG, "Static display context must be in internal RAM with cache safe callbacks!");
+#endif
+        ESP_RETURN_ON_FALSE(!disp_cfg->flags.sw_rotate_stripes && !convert && !disp_cfg->flags.coalesce_flush && !disp_cfg->flags.flush_task &&
+                            !disp_cfg->flags.round_mask && !disp_cfg->flags.te_sync, NULL, TAG,
+                            "Rotation stripes, panel color format conversion, flush coalescing, flush task, round mask or TE synchronization cannot be used with static memory!");
+    }
+
     /* Display context */
-    lvgl_port_display_ctx_t *disp_ctx = malloc(sizeof(lvgl_port_display_ctx_t));
+    lvgl_port_display_ctx_t *disp_ctx = NULL;
+    if (static_mem) {
+        disp_ctx = static_mem->ctx;
+        memset(disp_ctx, 0, sizeof(lvgl_port_display_ctx_t));
+        disp_ctx->flags.static_mem = 1;
+    } else {
+        disp_ctx = LVGL_PORT_DISP_CTX_CALLOC(sizeof(lvgl_port_display_ctx_t));
+    }
     ESP_GOTO_ON_FALSE(disp_ctx, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for display context allocation!");
-    memset(disp_ctx, 0, sizeof(lvgl_port_display_ctx_t));
+    /* In the context, no allocation (also with static memory) */
+    disp_ctx->idle_sem = xSemaphoreCreateBinaryStatic(&disp_ctx->idle_sem_buf);
     disp_ctx->io_handle = disp_cfg->io_handle;
     disp_ctx->panel_handle = disp_cfg->panel_handle;
     disp_ctx->control_handle = disp_cfg->control_handle;
@@ -273,6 +849,7 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
     disp_ctx->rotation.mirror_y = disp_cfg->rotation.mirror_y;
     disp_ctx->flags.swap_bytes = disp_cfg->flags.swap_bytes;
     disp_ctx->flags.sw_rotate = disp_cfg->flags.sw_rotate;
+    disp_ctx->flags.sw_rotate_tiled = disp_cfg->flags.sw_rotate_tiled;
     disp_ctx->current_rotation = LV_DISPLAY_ROTATION_0;
 
     uint32_t buff_caps = 0;
@@ -290,27 +867,61 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
     if (buff_caps == 0) {
         buff_caps |= MALLOC_CAP_DEFAULT;
     }
+    disp_ctx->draw_buff_caps = buff_caps;
 
     /* Use RGB internal buffers for avoid tearing effect */
     if (priv_cfg && priv_cfg->avoid_tearing) {
+        if (priv_cfg->triple_buffer) {
+#if LVGL_PORT_TRIPLE_BUFFER
+            ESP_GOTO_ON_FALSE(disp_cfg->flags.full_refresh || disp_cfg->flags.direct_mode, ESP_ERR_INVALID_ARG, err, TAG, "Triple buffer can be used only with full_refresh or direct_mode!");
+            ESP_GOTO_ON_FALSE(!disp_cfg->flags.sw_rotate, ESP_ERR_INVALID_ARG, err, TAG, "Triple buffer cannot be used with SW rotation!");
+            buffer_size = disp_cfg->hres * disp_cfg->vres;
+#if CONFIG_IDF_TARGET_ESP32S3
+            ESP_GOTO_ON_ERROR(esp_lcd_rgb_panel_get_frame_buffer(disp_cfg->panel_handle, 3, &disp_ctx->fbs[0], &disp_ctx->fbs[1], &disp_ctx->fbs[2]), err, TAG, "Get RGB buffers failed");
+#else
+            ESP_GOTO_ON_ERROR(esp_lcd_dpi_panel_get_frame_buffer(disp_cfg->panel_handle, 3, &disp_ctx->fbs[0], &disp_ctx->fbs[1], &disp_ctx->fbs[2]), err, TAG, "Get RGB buffers failed");
+#endif
+            /* The first frame buffer is displayed after init, LVGL renders into the other two */
+            buf1 = disp_ctx->fbs[1];
+            buf2 = disp_ctx->fbs[2];
+            disp_ctx->fb_displayed = 0;
+            disp_ctx->fb_pending = -1;
+            portMUX_INITIALIZE(&disp_ctx->fb_lock);
+            for (int i = 0; i < 3; i++) {
+                lv_area_set(&disp_ctx->fb_missing[i], 0, 0, -1, -1);
+            }
+            lv_area_set(&disp_ctx->frame_dirty, 0, 0, -1, -1);
+            disp_ctx->flags.triple_buffer = 1;
+            disp_ctx->flags.frame_skip = priv_cfg->frame_skip;
+#else
+            ESP_GOTO_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, err, TAG, "Triple buffer is supported only on ESP32S3 (from IDF 5.0) and ESP32P4 (from IDF 5.3) with LVGL 9.1 or newer!");
+#endif
+        } else {
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
-        buffer_size = disp_cfg->hres * disp_cfg->vres;
-        ESP_GOTO_ON_ERROR(esp_lcd_rgb_panel_get_frame_buffer(disp_cfg->panel_handle, 2, (void *)&buf1, (void *)&buf2), err, TAG, "Get RGB buffers failed");
+            buffer_size = disp_cfg->hres * disp_cfg->vres;
+            ESP_GOTO_ON_ERROR(esp_lcd_rgb_panel_get_frame_buffer(disp_cfg->panel_handle, 2, (void *)&buf1, (void *)&buf2), err, TAG, "Get RGB buffers failed");
 #elif CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
-        buffer_size = disp_cfg->hres * disp_cfg->vres;
-        ESP_GOTO_ON_ERROR(esp_lcd_dpi_panel_get_frame_buffer(disp_cfg->panel_handle, 2, (void *)&buf1, (void *)&buf2), err, TAG, "Get RGB buffers failed");
+            buffer_size = disp_cfg->hres * disp_cfg->vres;
+            ESP_GOTO_ON_ERROR(esp_lcd_dpi_panel_get_frame_buffer(disp_cfg->panel_handle, 2, (void *)&buf1, (void *)&buf2), err, TAG, "Get RGB buffers failed");
 #endif
+        }
 
-        trans_sem = xSemaphoreCreateCounting(1, 0);
+        trans_sem = (static_mem ? xSemaphoreCreateCountingStatic(1, 0, &disp_ctx->trans_sem_buf) : xSemaphoreCreateCounting(1, 0));
         ESP_GOTO_ON_FALSE(trans_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create transport counting Semaphore");
         disp_ctx->trans_sem = trans_sem;
+    } else if (static_mem) {
+        buf1 = static_mem->buf1;
+        buf2 = (disp_cfg->double_buffer ? static_mem->buf2 : NULL);
+        ESP_GOTO_ON_FALSE(buf1 && (buf2 || !disp_cfg->double_buffer), ESP_ERR_INVALID_ARG, err, TAG, "Missing static LVGL buffer!");
+        disp_ctx->draw_buffs[0] = buf1;
+        disp_ctx->draw_buffs[1] = buf2;
     } else {
         /* alloc draw buffers used by LVGL */
         /* it's recommended to choose the size of the draw buffer(s) to be at least 1/10 screen sized */
-        buf1 = heap_caps_malloc(buffer_size * sizeof(lv_color_t), buff_caps);
+        buf1 = heap_caps_malloc(buffer_size * buffer_px_size, buff_caps);
         ESP_GOTO_ON_FALSE(buf1, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf1) allocation!");
         if (disp_cfg->double_buffer) {
-            buf2 = heap_caps_malloc(buffer_size * sizeof(lv_color_t), buff_caps);
+            buf2 = heap_caps_malloc(buffer_size * buffer_px_size, buff_caps);
             ESP_GOTO_ON_FALSE(buf2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf2) allocation!");
         }
 
@@ -341,57 +952,297 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
         if (display_color_format == LV_COLOR_FORMAT_I1) {
             /* OLED monochrome buffer */
             // To use LV_COLOR_FORMAT_I1, we need an extra buffer to hold the converted data
-            disp_ctx->oled_buffer = heap_caps_malloc(buffer_size, buff_caps);
+            disp_ctx->oled_buffer = (static_mem ? static_mem->oled_buf : heap_caps_malloc(buffer_size, buff_caps));
             ESP_GOTO_ON_FALSE(disp_ctx->oled_buffer, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (OLED buffer) allocation!");
         }
 
+        if (LVGL_PORT_HANDLE_FLUSH_READY && priv_cfg == NULL && !disp_cfg->flags.flush_task && !static_mem) {
+            /* Shadow of display RAM, only changed columns of each page are transferred (pages along the longer side, when rotated) */
+            const uint32_t shadow_size = LV_MAX(disp_cfg->hres * ((disp_cfg->vres + 7) / 8), disp_cfg->vres * ((disp_cfg->hres + 7) / 8));
+            disp_ctx->oled_shadow = malloc(shadow_size);
+            ESP_GOTO_ON_FALSE(disp_ctx->oled_shadow, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for OLED shadow allocation!");
+        }
+
     } else if (disp_cfg->flags.direct_mode) {
         /* When using direct_mode, there must be used full bufer! */
         ESP_GOTO_ON_FALSE((disp_cfg->hres * disp_cfg->vres == buffer_size), ESP_ERR_INVALID_ARG, err, TAG, "Direct mode must using full buffer!");
 
         disp_ctx->flags.direct_mode = 1;
-        lv_display_set_buffers(disp, buf1, buf2, buffer_size * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_DIRECT);
+        lv_display_set_buffers(disp, buf1, buf2, buffer_size * buffer_px_size, LV_DISPLAY_RENDER_MODE_DIRECT);
     } else if (disp_cfg->flags.full_refresh) {
         /* When using full_refresh, there must be used full bufer! */
         ESP_GOTO_ON_FALSE((disp_cfg->hres * disp_cfg->vres == buffer_size), ESP_ERR_INVALID_ARG, err, TAG, "Full refresh must using full buffer!");
 
         disp_ctx->flags.full_refresh = 1;
-        lv_display_set_buffers(disp, buf1, buf2, buffer_size * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_FULL);
+        lv_display_set_buffers(disp, buf1, buf2, buffer_size * buffer_px_size, LV_DISPLAY_RENDER_MODE_FULL);
     } else {
-        lv_display_set_buffers(disp, buf1, buf2, buffer_size * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_PARTIAL);
+        disp_ctx->draw_buff_size = buffer_size * buffer_px_size;
+        lv_display_set_buffers(disp, buf1, buf2, disp_ctx->draw_buff_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
     }
 
-    lv_display_set_flush_cb(disp, lvgl_port_flush_callback);
+#if LVGL_PORT_TRIPLE_BUFFER
+    if (disp_ctx->flags.triple_buffer) {
+        /* Own draw buffers, the frame buffer behind them is changed after each frame */
+        uint32_t stride = lv_draw_buf_width_to_stride(disp_cfg->hres, display_color_format);
+        lv_draw_buf_init(&disp_ctx->fb_draw_bufs[0], disp_cfg->hres, disp_cfg->vres, display_color_format, stride, buf1, stride * disp_cfg->vres);
+        lv_draw_buf_init(&disp_ctx->fb_draw_bufs[1], disp_cfg->hres, disp_cfg->vres, display_color_format, stride, buf2, stride * disp_cfg->vres);
+        lv_display_set_draw_buffers(disp, &disp_ctx->fb_draw_bufs[0], &disp_ctx->fb_draw_bufs[1]);
+    }
+#endif
+
+    if (disp_ctx->trans_sem && !disp_ctx->flags.triple_buffer) {
+        /* Direct mode copies the areas of the previous frame into the draw buffer already at refresh start */
+        lv_display_add_event_cb(disp, lvgl_port_fb_wait_callback, disp_cfg->flags.direct_mode ? LV_EVENT_REFR_START : LV_EVENT_RENDER_START, disp_ctx);
+    }
+#if CONFIG_LVGL_PORT_HEATMAP
+    /* Before the invalidation callback below, which changes the areas of hardware scroll and rounding */
+    disp_ctx->heatmap = lvgl_port_heatmap_create(disp);
+    ESP_GOTO_ON_FALSE(disp_ctx->heatmap, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for heatmap!");
+#endif
+#if CONFIG_LVGL_PORT_REMOTE_VIEW
+    disp_ctx->remote = lvgl_port_remote_create(disp);
+    ESP_GOTO_ON_FALSE(disp_ctx->remote, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for remote view!");
+#endif
+#if LVGL_PORT_FLUSH_TAP && !CONFIG_LVGL_PORT_ENABLE_STATS && !LVGL_PORT_TRACE
+    lv_display_set_flush_cb(disp, lvgl_port_flush_tap_callback);
+#endif
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+    disp_ctx->stats_window_start = esp_timer_get_time();
+    lv_display_set_flush_cb(disp, lvgl_port_flush_stats_callback);
+    lv_display_add_event_cb(disp, lvgl_port_stats_render_callback, LV_EVENT_RENDER_START, disp_ctx);
+    lv_display_add_event_cb(disp, lvgl_port_stats_render_callback, LV_EVENT_RENDER_READY, disp_ctx);
+#endif
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    lv_display_add_event_cb(disp, lvgl_port_latency_render_callback, LV_EVENT_RENDER_START, disp_ctx);
+    lv_display_add_event_cb(disp, lvgl_port_latency_render_callback, LV_EVENT_RENDER_READY, disp_ctx);
+#endif
+#if LVGL_PORT_TRACE
+    lv_display_set_flush_cb(disp, lvgl_port_flush_trace_callback);
+    lv_display_add_event_cb(disp, lvgl_port_trace_render_callback, LV_EVENT_RENDER_START, disp_ctx);
+    lv_display_add_event_cb(disp, lvgl_port_trace_render_callback, LV_EVENT_RENDER_READY, disp_ctx);
+#endif
     lv_display_add_event_cb(disp, lvgl_port_disp_size_update_callback, LV_EVENT_RESOLUTION_CHANGED, disp_ctx);
     lv_display_add_event_cb(disp, lvgl_port_display_invalidate_callback, LV_EVENT_INVALIDATE_AREA, disp_ctx);
     lv_display_add_event_cb(disp, lvgl_port_display_invalidate_callback, LV_EVENT_REFR_REQUEST, disp_ctx);
+    if (priv_cfg && priv_cfg->vsync_pacing) {
+        /* Refresh is started from vsync, the refresh timer is only a fallback */
+        disp_ctx->flags.vsync_pacing = 1;
+        lv_timer_set_period(lv_display_get_refr_timer(disp), LVGL_PORT_VSYNC_PACING_FALLBACK_MS);
+    } else if (disp_cfg->refresh_period_ms > 0) {
+        /* Own refresh period of this display */
+        disp_ctx->refr_period_ms = disp_cfg->refresh_period_ms;
+        lv_timer_set_period(lv_display_get_refr_timer(disp), disp_cfg->refresh_period_ms);
+    }
 
     lv_display_set_driver_data(disp, disp_ctx);
     disp_ctx->disp_drv = disp;
 
     /* Use SW rotation */
-    if (disp_cfg->flags.sw_rotate) {
-        disp_ctx->draw_buffs[2] = heap_caps_malloc(buffer_size * sizeof(lv_color_t), buff_caps);
+    if (disp_cfg->flags.sw_rotate && disp_cfg->flags.sw_rotate_stripes && LVGL_PORT_HANDLE_FLUSH_READY && priv_cfg == NULL) {
+        /* Two DMA capable stripe buffers, one is rotated while the other one is transmitted (I2C/SPI/I8080 only) */
+        ESP_GOTO_ON_FALSE(!disp_cfg->monochrome, ESP_ERR_INVALID_ARG, err, TAG, "Rotation stripes cannot be used with monochromatic display!");
+        disp_ctx->rotate_buff_size = (disp_cfg->trans_size ? disp_cfg->trans_size : buffer_size / LVGL_PORT_ROTATE_STRIPES_DEFAULT);
+        ESP_GOTO_ON_FALSE(disp_ctx->rotate_buff_size >= disp_cfg->hres && disp_ctx->rotate_buff_size >= disp_cfg->vres, ESP_ERR_INVALID_ARG, err, TAG, "Rotation stripe must hold at least one line!");
+        disp_ctx->rotate_buffs[0] = heap_caps_malloc(disp_ctx->rotate_buff_size * sizeof(lv_color_t), MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(disp_ctx->rotate_buffs[0], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (rotation stripe 0) allocation!");
+        disp_ctx->rotate_buffs[1] = heap_caps_malloc(disp_ctx->rotate_buff_size * sizeof(lv_color_t), MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(disp_ctx->rotate_buffs[1], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (rotation stripe 1) allocation!");
+        disp_ctx->rotate_sem = xSemaphoreCreateCounting(2, 2);
+        ESP_GOTO_ON_FALSE(disp_ctx->rotate_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create rotation counting Semaphore");
+        disp_ctx->flags.sw_rotate_stripes = 1;
+    } else if (disp_cfg->flags.sw_rotate) {
+        void *rotate_buf = (static_mem ? static_mem->rotate_buf : NULL);
+        ESP_GOTO_ON_FALSE(rotate_buf || !static_mem, ESP_ERR_INVALID_ARG, err, TAG, "Missing static LVGL buffer (rotation buffer)!");
+#if LVGL_PORT_PPA
+        /* Rotation by PPA, when the color format is supported (and the static buffer is aligned for it) */
+        const ppa_client_config_t ppa_cfg = {
+            .oper_type = PPA_OPERATION_SRM,
+            .max_pending_trans_num = 1,
+        };
+        if (!disp_cfg->monochrome && display_color_format != LV_COLOR_FORMAT_I1 && ((uintptr_t)rotate_buf & (LVGL_PORT_PPA_ALIGNMENT - 1)) == 0 &&
+                ppa_register_client(&ppa_cfg, &disp_ctx->ppa_handle) == ESP_OK) {
+            disp_ctx->ppa_buff_size = (buffer_size * sizeof(lv_color_t) + LVGL_PORT_PPA_ALIGNMENT - 1) & ~(LVGL_PORT_PPA_ALIGNMENT - 1);
+            disp_ctx->draw_buffs[2] = (rotate_buf ? memset(rotate_buf, 0, disp_ctx->ppa_buff_size) :
+                                       heap_caps_aligned_calloc(LVGL_PORT_PPA_ALIGNMENT, 1, disp_ctx->ppa_buff_size, buff_caps | MALLOC_CAP_DMA));
+        } else
+#endif
+        {
+            disp_ctx->draw_buffs[2] = (rotate_buf ? rotate_buf : heap_caps_malloc(buffer_size * sizeof(lv_color_t), buff_caps));
+        }
         ESP_GOTO_ON_FALSE(disp_ctx->draw_buffs[2], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (rotation buffer) allocation!");
     }
 
+    /* Panel color format conversion */
+    if (convert) {
+        /* Two DMA capable buffers, one is converted while the other one is transmitted (I2C/SPI/I8080 only) */
+        const uint32_t convert_px = (disp_cfg->trans_size ? disp_cfg->trans_size : buffer_size / LVGL_PORT_ROTATE_STRIPES_DEFAULT);
+        ESP_GOTO_ON_FALSE(convert_px >= disp_cfg->hres && convert_px >= disp_cfg->vres, ESP_ERR_INVALID_ARG, err, TAG, "Conversion buffer must hold at least one line!");
+        disp_ctx->panel_color_format = disp_cfg->panel_color_format;
+        disp_ctx->convert_buff_size = convert_px * lv_color_format_get_size(disp_ctx->panel_color_format);
+        disp_ctx->convert_buffs[0] = heap_caps_malloc(disp_ctx->convert_buff_size, MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(disp_ctx->convert_buffs[0], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (conversion buffer 0) allocation!");
+        disp_ctx->convert_buffs[1] = heap_caps_malloc(disp_ctx->convert_buff_size, MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(disp_ctx->convert_buffs[1], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (conversion buffer 1) allocation!");
+        disp_ctx->convert_sem = xSemaphoreCreateCounting(2, 2);
+        ESP_GOTO_ON_FALSE(disp_ctx->convert_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create conversion counting Semaphore");
+        if (display_color_format == LV_COLOR_FORMAT_L8) {
+            /* Grayscale palette by default */
+            disp_ctx->convert_lut = malloc(256 * sizeof(uint16_t));
+            ESP_GOTO_ON_FALSE(disp_ctx->convert_lut, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for L8 palette allocation!");
+            lvgl_port_disp_fill_lut(disp_ctx, NULL);
+        }
+    }
+
+    /* Flush coalescing */
+    if (disp_cfg->flags.coalesce_flush && LVGL_PORT_HANDLE_FLUSH_READY && priv_cfg == NULL) {
+        /* Two DMA capable buffers, merged areas are collected in one while the other one is transmitted (I2C/SPI/I8080 only) */
+        ESP_GOTO_ON_FALSE(!disp_cfg->monochrome && !disp_cfg->flags.full_refresh && !disp_cfg->flags.direct_mode, ESP_ERR_INVALID_ARG, err, TAG, "Flush coalescing can be used only in partial mode!");
+        ESP_GOTO_ON_FALSE(!disp_ctx->flags.sw_rotate_stripes, ESP_ERR_INVALID_ARG, err, TAG, "Flush coalescing cannot be used with rotation stripes!");
+        disp_ctx->coalesce_buff_size = (disp_cfg->trans_size ? disp_cfg->trans_size : buffer_size) * sizeof(lv_color_t);
+        disp_ctx->coalesce_buffs[0] = heap_caps_malloc(disp_ctx->coalesce_buff_size, MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(disp_ctx->coalesce_buffs[0], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (coalescing buffer 0) allocation!");
+        disp_ctx->coalesce_buffs[1] = heap_caps_malloc(disp_ctx->coalesce_buff_size, MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(disp_ctx->coalesce_buffs[1], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (coalescing buffer 1) allocation!");
+        disp_ctx->coalesce_sem = xSemaphoreCreateCounting(2, 2);
+        ESP_GOTO_ON_FALSE(disp_ctx->coalesce_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create coalescing counting Semaphore");
+    }
+
+    /* Flush task */
+    if (disp_cfg->flags.flush_task) {
+        ESP_GOTO_ON_FALSE(LVGL_PORT_HANDLE_FLUSH_READY && priv_cfg == NULL, ESP_ERR_INVALID_ARG, err, TAG, "Flush task can be used only with lvgl_port_add_disp!");
+        ESP_GOTO_ON_FALSE(!disp_ctx->flags.sw_rotate_stripes && !disp_ctx->coalesce_sem, ESP_ERR_INVALID_ARG, err, TAG, "Flush task cannot be used with rotation stripes or flush coalescing!");
+        /* LVGL does not call flush again before the previous one is done, one pending area is enough */
+        disp_ctx->flush_queue = xQueueCreate(1, sizeof(lvgl_port_flush_job_t));
+        ESP_GOTO_ON_FALSE(disp_ctx->flush_queue, ESP_ERR_NO_MEM, err, TAG, "Failed to create flush queue");
+        disp_ctx->flush_done_sem = xSemaphoreCreateBinary();
+        ESP_GOTO_ON_FALSE(disp_ctx->flush_done_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create flush done Semaphore");
+        disp_ctx->flush_task_sem = xSemaphoreCreateBinary();
+        ESP_GOTO_ON_FALSE(disp_ctx->flush_task_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create flush task Semaphore");
+        BaseType_t res;
+        if (lvgl_port_flush_task_affinity < 0) {
+            res = xTaskCreate(lvgl_port_flush_task, "taskLVGLflush", CONFIG_LVGL_PORT_FLUSH_TASK_STACK, disp_ctx, CONFIG_LVGL_PORT_FLUSH_TASK_PRIORITY, NULL);
+        } else {
+            res = xTaskCreatePinnedToCore(lvgl_port_flush_task, "taskLVGLflush", CONFIG_LVGL_PORT_FLUSH_TASK_STACK, disp_ctx, CONFIG_LVGL_PORT_FLUSH_TASK_PRIORITY, NULL, lvgl_port_flush_task_affinity);
+        }
+        ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create flush task fail!");
+        /* Block LVGL task instead of busy waiting for the transfer */
+        lv_display_set_flush_wait_cb(disp, lvgl_port_flush_wait_callback);
+    }
+
+    /* Round display mask */
+    if (disp_cfg->flags.round_mask) {
+        ESP_GOTO_ON_FALSE(LVGL_PORT_HANDLE_FLUSH_READY && priv_cfg == NULL, ESP_ERR_INVALID_ARG, err, TAG, "Round mask can be used only with lvgl_port_add_disp!");
+        ESP_GOTO_ON_FALSE(disp_cfg->hres == disp_cfg->vres, ESP_ERR_INVALID_ARG, err, TAG, "Round mask can be used only with square resolution!");
+        ESP_GOTO_ON_FALSE(!disp_cfg->monochrome && !disp_cfg->flags.direct_mode, ESP_ERR_INVALID_ARG, err, TAG, "Round mask cannot be used with monochrome display or in direct mode!");
+        ESP_GOTO_ON_FALSE(!disp_ctx->flags.sw_rotate_stripes && !disp_ctx->convert_sem && !disp_ctx->coalesce_sem && !disp_ctx->flush_queue, ESP_ERR_INVALID_ARG, err, TAG,
+                          "Round mask cannot be used with rotation stripes, panel color format conversion, flush coalescing or flush task!");
+        ESP_GOTO_ON_ERROR(lvgl_port_round_init(disp_ctx, disp_cfg->hres), err, TAG, "Round mask init fail!");
+    }
+
+    /* Flush synchronized with tearing effect output of LCD controller */
+    if (disp_cfg->flags.te_sync) {
+#if LVGL_PORT_HANDLE_FLUSH_READY
+        ESP_GOTO_ON_FALSE(priv_cfg == NULL, ESP_ERR_INVALID_ARG, err, TAG, "TE synchronization can be used only with lvgl_port_add_disp!");
+        ESP_GOTO_ON_FALSE(GPIO_IS_VALID_GPIO(disp_cfg->te_gpio_num), ESP_ERR_INVALID_ARG, err, TAG, "Invalid TE GPIO!");
+        ESP_GOTO_ON_ERROR(lvgl_port_disp_te_init(disp_ctx, disp_cfg->te_gpio_num), err, TAG, "TE synchronization init fail!");
+        /* Frames are paced by TE like by vsync, the refresh timer is only a fallback */
+        disp_ctx->flags.vsync_pacing = 1;
+        lv_timer_set_period(lv_display_get_refr_timer(disp), LVGL_PORT_VSYNC_PACING_FALLBACK_MS);
+        lv_display_add_event_cb(disp, lvgl_port_te_render_callback, LV_EVENT_RENDER_START, disp_ctx);
+#else
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, err, TAG, "TE synchronization is not supported in this ESP-IDF version!");
+#endif
+    }
+
+    /* Flush function is selected, when all features of the display are set up */
+    ESP_GOTO_ON_ERROR(lvgl_port_flush_update(disp_ctx), err, TAG, "Flush function selection fail!");
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+    /* Last step, nothing can fail after it */
+    ESP_GOTO_ON_ERROR(lvgl_port_ready_task_start(), err, TAG, "Flush ready task start fail!");
+#endif
 
 err:
     if (ret != ESP_OK) {
-        if (disp_ctx->draw_buffs[0]) {
-            free(disp_ctx->draw_buffs[0]);
+        if (!disp_ctx->flags.static_mem) {
+            if (disp_ctx->draw_buffs[0]) {
+                free(disp_ctx->draw_buffs[0]);
+            }
+            if (disp_ctx->draw_buffs[1]) {
+                free(disp_ctx->draw_buffs[1]);
+            }
+            if (disp_ctx->draw_buffs[2]) {
+                free(disp_ctx->draw_buffs[2]);
+            }
+            if (disp_ctx->oled_buffer) {
+                free(disp_ctx->oled_buffer);
+            }
         }
-        if (disp_ctx->draw_buffs[1]) {
-            free(disp_ctx->draw_buffs[1]);
+        if (disp_ctx->oled_shadow) {
+            free(disp_ctx->oled_shadow);
         }
-        if (disp_ctx->draw_buffs[2]) {
-            free(disp_ctx->draw_buffs[2]);
+        if (disp_ctx->rotate_buffs[0]) {
+            free(disp_ctx->rotate_buffs[0]);
         }
-        if (disp_ctx->oled_buffer) {
-            free(disp_ctx->oled_buffer);
+        if (disp_ctx->rotate_buffs[1]) {
+            free(disp_ctx->rotate_buffs[1]);
         }
-        if (disp_ctx) {
-            free(disp_ctx);
+        if (disp_ctx->rotate_sem) {
+            vSemaphoreDelete(disp_ctx->rotate_sem);
+        }
+        if (disp_ctx->convert_buffs[0]) {
+            free(disp_ctx->convert_buffs[0]);
+        }
+        if (disp_ctx->convert_buffs[1]) {
+            free(disp_ctx->convert_buffs[1]);
+        }
+        if (disp_ctx->convert_lut) {
+            free(disp_ctx->convert_lut);
+        }
+        if (disp_ctx->convert_sem) {
+            vSemaphoreDelete(disp_ctx->convert_sem);
+        }
+#if LVGL_PORT_PPA
+        if (disp_ctx->ppa_handle) {
+            ppa_unregister_client(disp_ctx->ppa_handle);
+        }
+#endif
+        if (disp_ctx->coalesce_buffs[0]) {
+            free(disp_ctx->coalesce_buffs[0]);
+        }
+        if (disp_ctx->coalesce_buffs[1]) {
+            free(disp_ctx->coalesce_buffs[1]);
+        }
+        if (disp_ctx->coalesce_sem) {
+            vSemaphoreDelete(disp_ctx->coalesce_sem);
+        }
+        if (disp_ctx->flush_queue) {
+            vQueueDelete(disp_ctx->flush_queue);
+        }
+        if (disp_ctx->flush_done_sem) {
+            vSemaphoreDelete(disp_ctx->flush_done_sem);
+        }
+        if (disp_ctx->flush_task_sem) {
+            vSemaphoreDelete(disp_ctx->flush_task_sem);
+        }
+        if (disp_ctx->te_sem) {
+            gpio_isr_handler_remove(disp_ctx->te_gpio_num);
+            gpio_reset_pin(disp_ctx->te_gpio_num);
+            vSemaphoreDelete(disp_ctx->te_sem);
+        }
+        if (disp_ctx->round_x1) {
+            free(disp_ctx->round_x1);
+        }
+#if CONFIG_LVGL_PORT_HEATMAP
+        lvgl_port_heatmap_delete(disp_ctx->heatmap);
+#endif
+#if CONFIG_LVGL_PORT_REMOTE_VIEW
+        lvgl_port_remote_delete(disp_ctx->remote);
+#endif
+        if (disp_ctx && disp_ctx->idle_sem) {
+            vSemaphoreDelete(disp_ctx->idle_sem);
+        }
+        if (disp_ctx && !disp_ctx->flags.static_mem) {
+            LVGL_PORT_DISP_CTX_FREE(disp_ctx);
         }
         if (trans_sem) {
             vSemaphoreDelete(trans_sem);
@@ -402,59 +1253,264 @@ err:
 }
 
 #if LVGL_PORT_HANDLE_FLUSH_READY
-static bool lvgl_port_flush_io_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
-{
-    lv_display_t *disp_drv = (lv_display_t *)user_ctx;
-    assert(disp_drv != NULL);
-    lv_disp_flush_ready(disp_drv);
-    return false;
-}
-
-#if (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
-static bool lvgl_port_flush_dpi_panel_ready_callback(esp_lcd_panel_handle_t panel_io, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx)
+/* Flush ready from ISR, it returns true when higher priority task was woken */
+static inline bool LVGL_PORT_ISR_ATTR lvgl_port_flush_ready_from_isr(lvgl_port_display_ctx_t *disp_ctx)
 {
-    lv_display_t *disp_drv = (lv_display_t *)user_ctx;
-    assert(disp_drv != NULL);
-    lv_disp_flush_ready(disp_drv);
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+    if (disp_ctx->flush_done_sem) {
+        /* Flush task, LVGL task waits for flush_done_sem and calls flush ready itself */
+        return false;
+    }
+    /* LVGL is in flash, flush ready is called by the ready task */
+    BaseType_t need_yield = pdFALSE;
+    xQueueSendFromISR(lvgl_port_ready_ctx.queue, &disp_ctx->disp_drv, &need_yield);
+    return (need_yield == pdTRUE);
+#else
+    lv_disp_flush_ready(disp_ctx->disp_drv);
     return false;
+#endif
 }
 
-static bool lvgl_port_flush_dpi_vsync_ready_callback(esp_lcd_panel_handle_t panel_io, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx)
+static bool LVGL_PORT_ISR_ATTR lvgl_port_flush_io_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
 {
     BaseType_t need_yield = pdFALSE;
+    bool ready_yield = false;
 
-    lv_display_t *disp_drv = (lv_display_t *)user_ctx;
-    assert(disp_drv != NULL);
-    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp_drv);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)user_ctx;
     assert(disp_ctx != NULL);
 
-    if (disp_ctx->trans_sem) {
-        xSemaphoreGiveFromISR(disp_ctx->trans_sem, &need_yield);
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    if (!disp_ctx->ext_busy) {
+        lvgl_port_latency_trans_done(disp_ctx->disp_drv, ++disp_ctx->latency_trans_done);
     }
-
-    return (need_yield == pdTRUE);
+#endif
+#if LVGL_PORT_TRACE
+    if (!disp_ctx->ext_busy) {
+        LVGL_PORT_TRACE_TRANS_DONE(disp_ctx->disp_drv);
+    }
+#endif
+
+    if (disp_ctx->ext_busy) {
+        /* External buffer transferred, transfers are done in order */
+        disp_ctx->ext_busy = false;
+        xSemaphoreGiveFromISR(disp_ctx->idle_sem, &need_yield);
+        if (disp_ctx->ext_done_cb && disp_ctx->ext_done_cb(disp_ctx->ext_ctx)) {
+            need_yield = pdTRUE;
+        }
+    } else if (disp_ctx->rotate_sem && uxSemaphoreGetCountFromISR(disp_ctx->rotate_sem) < 2) {
+        /* One rotation stripe was transmitted, its buffer is free (LVGL buffer was released in flush callback) */
+        xSemaphoreGiveFromISR(disp_ctx->rotate_sem, &need_yield);
+    } else if (disp_ctx->convert_sem && uxSemaphoreGetCountFromISR(disp_ctx->convert_sem) < 2) {
+        /* One converted stripe was transmitted, its buffer is free (LVGL buffer was released in flush callback) */
+        xSemaphoreGiveFromISR(disp_ctx->convert_sem, &need_yield);
+    } else if (disp_ctx->coalesce_sem && uxSemaphoreGetCountFromISR(disp_ctx->coalesce_sem) < 2) {
+        /* Coalesced transfer done, its buffer is free (LVGL buffers were released in flush callback) */
+        xSemaphoreGiveFromISR(disp_ctx->coalesce_sem, &need_yield);
+    } else if (disp_ctx->flush_parts > 1) {
+        /* Part of the flushed area (hardware scroll remap, round mask run or band between filled bands), flush ready after the last part */
+        disp_ctx->flush_parts--;
+    } else {
+        disp_ctx->flush_busy = false;
+        xSemaphoreGiveFromISR(disp_ctx->idle_sem, &need_yield);
+        if (disp_ctx->flush_done_sem) {
+            xSemaphoreGiveFromISR(disp_ctx->flush_done_sem, &need_yield);
+        }
+        ready_yield = lvgl_port_flush_ready_from_isr(disp_ctx);
+    }
+
+    return (need_yield == pdTRUE) || ready_yield;
+}
+
+/* Wake LVGL task on vsync, when the frame is requested (vsync pacing) */
+static inline bool LVGL_PORT_ISR_ATTR lvgl_port_vsync_pacing(lvgl_port_display_ctx_t *disp_ctx)
+{
+    if (disp_ctx->flags.vsync_pacing && disp_ctx->vsync_armed) {
+        disp_ctx->vsync_armed = false;
+        return lvgl_port_task_frame_sync(disp_ctx->disp_drv);
+    }
+    return false;
+}
+
+#if (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
+static bool LVGL_PORT_ISR_ATTR lvgl_port_flush_dpi_panel_ready_callback(esp_lcd_panel_handle_t panel_io, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)user_ctx;
+    assert(disp_ctx != NULL);
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    lvgl_port_latency_trans_done(disp_ctx->disp_drv, ++disp_ctx->latency_trans_done);
+#endif
+    LVGL_PORT_TRACE_TRANS_DONE(disp_ctx->disp_drv);
+    return lvgl_port_flush_ready_from_isr(disp_ctx);
+}
+
+static bool LVGL_PORT_ISR_ATTR lvgl_port_flush_dpi_vsync_ready_callback(esp_lcd_panel_handle_t panel_io, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx)
+{
+    BaseType_t need_yield = pdFALSE;
+
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)user_ctx;
+    assert(disp_ctx != NULL);
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    lv_display_t *disp_drv = disp_ctx->disp_drv;
+#endif
+
+#if LVGL_PORT_TRIPLE_BUFFER
+    if (disp_ctx->flags.triple_buffer) {
+        /* Pending frame buffer is displayed from now */
+        portENTER_CRITICAL_ISR(&disp_ctx->fb_lock);
+        if (disp_ctx->fb_pending >= 0) {
+            disp_ctx->fb_displayed = disp_ctx->fb_pending;
+            disp_ctx->fb_pending = -1;
+        }
+        disp_ctx->fb_vsyncs++;
+        portEXIT_CRITICAL_ISR(&disp_ctx->fb_lock);
+    }
+#endif
+
+    if (disp_ctx->trans_sem) {
+        xSemaphoreGiveFromISR(disp_ctx->trans_sem, &need_yield);
+    }
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    lvgl_port_latency_vsync(disp_drv);
+#endif
+    LVGL_PORT_TRACE_INSTANT(LVGL_PORT_TRACE_VSYNC, 0);
+
+    const bool sync_yield = lvgl_port_vsync_pacing(disp_ctx);
+
+    return (need_yield == pdTRUE) || sync_yield;
 }
 #endif
 
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
-static bool lvgl_port_flush_rgb_vsync_ready_callback(esp_lcd_panel_handle_t panel_io, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx)
+static bool LVGL_PORT_ISR_ATTR lvgl_port_flush_rgb_vsync_ready_callback(esp_lcd_panel_handle_t panel_io, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx)
 {
     BaseType_t need_yield = pdFALSE;
 
-    lv_display_t *disp_drv = (lv_display_t *)user_ctx;
-    assert(disp_drv != NULL);
-    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp_drv);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)user_ctx;
     assert(disp_ctx != NULL);
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    lv_display_t *disp_drv = disp_ctx->disp_drv;
+#endif
+
+#if LVGL_PORT_TRIPLE_BUFFER
+    if (disp_ctx->flags.triple_buffer) {
+        /* Pending frame buffer is displayed from now */
+        portENTER_CRITICAL_ISR(&disp_ctx->fb_lock);
+        if (disp_ctx->fb_pending >= 0) {
+            disp_ctx->fb_displayed = disp_ctx->fb_pending;
+            disp_ctx->fb_pending = -1;
+        }
+        disp_ctx->fb_vsyncs++;
+        portEXIT_CRITICAL_ISR(&disp_ctx->fb_lock);
+    }
+#endif
 
     if (disp_ctx->trans_sem) {
         xSemaphoreGiveFromISR(disp_ctx->trans_sem, &need_yield);
     }
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    lvgl_port_latency_vsync(disp_drv);
+#endif
+    LVGL_PORT_TRACE_INSTANT(LVGL_PORT_TRACE_VSYNC, 0);
 
-    return (need_yield == pdTRUE);
+    const bool sync_yield = lvgl_port_vsync_pacing(disp_ctx);
+
+    return (need_yield == pdTRUE) || sync_yield;
+}
+
+/* Frame end callbacks of RGB panel (display add and change of the panel) */
+static esp_err_t lvgl_port_disp_rgb_register_callbacks(lvgl_port_display_ctx_t *disp_ctx)
+{
+    const esp_lcd_rgb_panel_event_callbacks_t vsync_cbs = {
+        .on_vsync = lvgl_port_flush_rgb_vsync_ready_callback,
+    };
+
+    const esp_lcd_rgb_panel_event_callbacks_t bb_cbs = {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2)
+        .on_bounce_frame_finish = lvgl_port_flush_rgb_vsync_ready_callback,
+#endif
+#if LVGL_PORT_RGB_PAN
+        /* Panel without frame buffer, the bounce buffers are filled from the virtual frame buffer */
+        .on_bounce_empty = (disp_ctx->pan.fb ? lvgl_port_pan_bounce_callback : NULL),
+#endif
+    };
+
+    if (disp_ctx->flags.bb_mode && (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2))) {
+        return esp_lcd_rgb_panel_register_event_callbacks(disp_ctx->panel_handle, &bb_cbs, disp_ctx);
+    }
+    return esp_lcd_rgb_panel_register_event_callbacks(disp_ctx->panel_handle, &vsync_cbs, disp_ctx);
 }
 #endif
 #endif
 
+/* Changed columns of the page against the shadow, false if the page is not changed */
+static bool lvgl_port_monochrome_page_diff(const lvgl_port_display_ctx_t *disp_ctx, const uint8_t *page, const uint8_t *shadow, int32_t col1, int32_t col2,
+        int32_t *first, int32_t *last)
+{
+    if (!disp_ctx->oled_shadow_valid) {
+        *first = col1;
+        *last = col2;
+        return true;
+    }
+
+    int32_t c1 = col1;
+    while (c1 <= col2 && page[c1] == shadow[c1]) {
+        c1++;
+    }
+    if (c1 > col2) {
+        return false;
+    }
+    int32_t c2 = col2;
+    while (page[c2] == shadow[c2]) {
+        c2--;
+    }
+    *first = c1;
+    *last = c2;
+    return true;
+}
+
+static void lvgl_port_flush_monochrome_pages(lv_display_t *drv, const lv_area_t *area, const uint8_t *pages)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    const bool swap_xy = (lv_display_get_rotation(drv) == LV_DISPLAY_ROTATION_90 || lv_display_get_rotation(drv) == LV_DISPLAY_ROTATION_270);
+    /* Page is 8 pixels high column of bytes (along X, or along Y when swapped), same mapping as in _lvgl_port_transform_monochrome() */
+    const int32_t cols = (swap_xy ? lv_display_get_physical_vertical_resolution(drv) : lv_display_get_physical_horizontal_resolution(drv));
+    const int32_t page1 = (swap_xy ? area->x1 : area->y1) >> 3;
+    const int32_t page2 = (swap_xy ? area->x2 : area->y2) >> 3;
+    const int32_t col1 = (swap_xy ? area->y1 : area->x1);
+    const int32_t col2 = (swap_xy ? area->y2 : area->x2);
+    int32_t first, last;
+    uint16_t cnt = 0;
+
+    /* Count the changed pages first, flush ready is called after the last transfer */
+    for (int32_t p = page1; p <= page2; p++) {
+        if (lvgl_port_monochrome_page_diff(disp_ctx, pages + p * cols, disp_ctx->oled_shadow + p * cols, col1, col2, &first, &last)) {
+            cnt++;
+        }
+    }
+    if (cnt == 0) {
+        lv_disp_flush_ready(drv);
+        return;
+    }
+
+    disp_ctx->flush_parts = cnt;
+    disp_ctx->flush_busy = true;
+    for (int32_t p = page1; p <= page2; p++) {
+        const uint8_t *page = pages + p * cols;
+        uint8_t *shadow = disp_ctx->oled_shadow + p * cols;
+        if (!lvgl_port_monochrome_page_diff(disp_ctx, page, shadow, col1, col2, &first, &last)) {
+            continue;
+        }
+        memcpy(shadow + first, page + first, last - first + 1);
+        LVGL_PORT_TRANS_START(disp_ctx);
+        if (swap_xy) {
+            esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, p * 8, first, p * 8 + 8, last + 1, page + first);
+        } else {
+            esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, first, p * 8, last + 1, p * 8 + 8, page + first);
+        }
+    }
+    disp_ctx->oled_shadow_valid = true;
+}
+
 static void _lvgl_port_transform_monochrome(lv_display_t *display, const lv_area_t *area, uint8_t **color_map)
 {
     assert(color_map);
@@ -481,6 +1537,12 @@ static void _lvgl_port_transform_monochrome(lv_display_t *display, const lv_area
         *color_map = disp_ctx->oled_buffer;
     }
 
+    /* Fast path: whole pages (full refresh area is aligned, when resolution is a multiple of 8) */
+    if (((x1 | y1 | (x2 + 1) | (y2 + 1)) & 0x7) == 0) {
+        lvgl_port_monochrome_pages(src, *color_map, (color_format == LV_COLOR_FORMAT_I1), swap_xy, hor_res, ver_res, x1, x2, y1, y2);
+        return;
+    }
+
     int out_x, out_y;
     for (int y = y1; y <= y2; y++) {
         for (int x = x1; x <= x2; x++) {
@@ -553,6 +1615,18 @@ void lvgl_port_rotate_area(lv_display_t *disp, lv_area_t *area)
     }
 }
 
+static void lvgl_port_flush_te_wait(lvgl_port_display_ctx_t *disp_ctx)
+{
+    disp_ctx->te_wait = false;
+    LVGL_PORT_STATS_START(te_start);
+    xSemaphoreTake(disp_ctx->te_sem, 0);
+    if (xSemaphoreTake(disp_ctx->te_sem, pdMS_TO_TICKS(LVGL_PORT_TE_TIMEOUT_MS)) != pdTRUE) {
+        ESP_LOGD(TAG, "TE edge missed");
+    }
+    LVGL_PORT_STATS_ADD(disp_ctx, trans_wait_us, te_start);
+    LVGL_PORT_STATS_INC(disp_ctx, vsync_waits);
+}
+
 static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
 {
     assert(drv != NULL);
@@ -566,8 +1640,40 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
     int offsety1 = area->y1;
     int offsety2 = area->y2;
 
+    /* First transfer of the frame starts on TE edge, so it runs behind the scan of LCD controller */
+    if (disp_ctx->te_wait) {
+        lvgl_port_flush_te_wait(disp_ctx);
+    }
+
+    /* SW rotation in stripes, it releases the LVGL buffer itself */
+    if (disp_ctx->flags.sw_rotate_stripes && disp_ctx->current_rotation > LV_DISPLAY_ROTATION_0) {
+        lvgl_port_flush_rotate_stripes(drv, area, color_map);
+        return;
+    }
+
+    /* Conversion to panel color format in stripes, it releases the LVGL buffer itself */
+    if (disp_ctx->convert_sem) {
+        lvgl_port_flush_convert(drv, area, color_map);
+        return;
+    }
+
+    LVGL_PORT_STATS_START(stage_start);
     /* SW rotation enabled */
-    if (disp_ctx->flags.sw_rotate && (disp_ctx->current_rotation > LV_DISPLAY_ROTATION_0 || disp_ctx->flags.swap_bytes)) {
+    if (disp_ctx->flags.sw_rotate && !disp_ctx->flags.sw_rotate_stripes && (disp_ctx->current_rotation > LV_DISPLAY_ROTATION_0 || disp_ctx->flags.swap_bytes)) {
+#if LVGL_PORT_PPA
+        /* PPA rotation, the rotated area is sent asynchronously, when written directly into the frame buffer */
+        if (disp_ctx->ppa_handle && lvgl_port_ppa_rotate(drv, (lv_area_t *)area, color_map)) {
+            if (disp_ctx->ppa_fb) {
+                LVGL_PORT_STATS_ADD(disp_ctx, rotate_us, stage_start);
+                return;
+            }
+            color_map = (uint8_t *)disp_ctx->draw_buffs[2];
+            offsetx1 = area->x1;
+            offsetx2 = area->x2;
+            offsety1 = area->y1;
+            offsety2 = area->y2;
+        } else
+#endif
         /* SW rotation */
         if (disp_ctx->draw_buffs[2]) {
             int32_t ww = lv_area_get_width(area);
@@ -575,7 +1681,11 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
             lv_color_format_t cf = lv_display_get_color_format(drv);
             uint32_t w_stride = lv_draw_buf_width_to_stride(ww, cf);
             uint32_t h_stride = lv_draw_buf_width_to_stride(hh, cf);
-            if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
+            if (disp_ctx->flags.sw_rotate_tiled || disp_ctx->flags.swap_bytes) {
+                /* Tiled kernel swaps the bytes in the same pass (copy only, when not rotated) */
+                uint32_t dest_stride = (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_0 || disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180 ? w_stride : h_stride);
+                lvgl_port_rotate_tiled(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, dest_stride, (lvgl_port_rotate_t)disp_ctx->current_rotation, lv_color_format_get_size(cf), disp_ctx->flags.swap_bytes);
+            } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_180) {
                 lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], hh, ww, h_stride, h_stride, LV_DISPLAY_ROTATION_180, cf);
             } else if (disp_ctx->current_rotation == LV_DISPLAY_ROTATION_90) {
                 lv_draw_sw_rotate(color_map, disp_ctx->draw_buffs[2], ww, hh, w_stride, h_stride, LV_DISPLAY_ROTATION_90, cf);
@@ -589,25 +1699,70 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
             offsety1 = area->y1;
             offsety2 = area->y2;
         }
+        LVGL_PORT_STATS_ADD(disp_ctx, rotate_us, stage_start);
     } else if (disp_ctx->flags.swap_bytes) {
         size_t len = lv_area_get_size(area);
         lv_draw_sw_rgb565_swap(color_map, len);
+        LVGL_PORT_STATS_ADD(disp_ctx, swap_us, stage_start);
     }
 
     /* Transfer data in buffer for monochromatic screen */
     if (disp_ctx->flags.monochrome) {
+        LVGL_PORT_STATS_START(mono_start);
         _lvgl_port_transform_monochrome(drv, area, &color_map);
+        LVGL_PORT_STATS_ADD(disp_ctx, monochrome_us, mono_start);
+        if (disp_ctx->oled_shadow) {
+            /* Only changed columns of each page are transferred */
+            lvgl_port_flush_monochrome_pages(drv, area, color_map);
+            return;
+        }
     }
 
     if ((disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI) && (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh)) {
-        if (lv_disp_flush_is_last(drv)) {
+        if (disp_ctx->flags.triple_buffer) {
+            /* Swap on vsync without waiting, it releases the LVGL buffer itself */
+            lvgl_port_flush_triple(drv, area, color_map);
+            return;
+        } else if (lv_disp_flush_is_last(drv)) {
             /* If the interface is I80 or SPI, this step cannot be used for drawing. */
             esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, 0, 0, lv_disp_get_hor_res(drv), lv_disp_get_ver_res(drv), color_map);
-            /* Waiting for the last frame buffer to complete transmission */
+            /* The other frame buffer is displayed until the next vsync, LVGL waits for it only before drawing into it
+               (timers, input and layout run meanwhile) */
             xSemaphoreTake(disp_ctx->trans_sem, 0);
-            xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+            disp_ctx->fb_wait_pending = true;
         }
+    } else if (disp_ctx->coalesce_sem) {
+        /* Merge with adjacent areas, it releases the LVGL buffer itself */
+        lvgl_port_flush_coalesce(drv, offsetx1, offsety1, offsetx2, offsety2, color_map);
+        return;
+    } else if (disp_ctx->flush_queue) {
+        /* Sent by flush task, flush ready is called from the transfer done callback */
+        const lvgl_port_flush_job_t job = {
+            .x1 = offsetx1,
+            .y1 = offsety1,
+            .x2 = offsetx2 + 1,
+            .y2 = offsety2 + 1,
+            .color_map = color_map,
+        };
+        xSemaphoreTake(disp_ctx->flush_done_sem, 0);
+        LVGL_PORT_TRANS_START(disp_ctx);
+        xQueueSend(disp_ctx->flush_queue, &job, portMAX_DELAY);
+        return;
+    } else if (disp_ctx->hw_fill.fill_rect && lvgl_port_flush_hw_fill(drv, offsetx1, offsety1, offsetx2, offsety2, color_map)) {
+        /* Solid bands were filled by LCD controller, it sends the other rows and releases the LVGL buffer itself */
+    } else if (disp_ctx->hw_scroll.obj && (disp_ctx->hw_scroll.cfg.set_scroll_area || disp_ctx->pan.fb)) {
+        /* Lines in the vertical scrolling area are moved by hardware scroll */
+        lvgl_port_flush_hw_scroll(drv, offsetx1, offsety1, offsetx2, offsety2, color_map);
+    } else if (disp_ctx->round_x1) {
+        /* Only the visible spans of round display are transferred */
+        lvgl_port_flush_round(drv, offsetx1, offsety1, offsetx2, offsety2, color_map);
+    } else if (disp_ctx->pan.fb) {
+        /* Panned RGB display without hardware scroll, the lines are at their place in the virtual frame buffer */
+        lvgl_port_pan_draw(disp_ctx, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map,
+                           lv_draw_buf_width_to_stride(offsetx2 - offsetx1 + 1, lv_display_get_color_format(drv)));
     } else {
+        disp_ctx->flush_busy = (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_OTHER);
+        LVGL_PORT_TRANS_START(disp_ctx);
         esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
     }
 
@@ -616,61 +1771,1968 @@ static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, u
     }
 }
 
-static void lvgl_port_disp_rotation_update(lvgl_port_display_ctx_t *disp_ctx)
+/* Specialized flush of SPI/I2C/I8080 panels: the area is sent as it is (bytes of RGB565 swapped in place) */
+static inline __attribute__((always_inline)) void lvgl_port_flush_direct_impl(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map, bool swap_bytes)
 {
+    assert(drv != NULL);
+    assert(area != NULL);
+    assert(color_map != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
     assert(disp_ctx != NULL);
 
-    disp_ctx->current_rotation = lv_display_get_rotation(disp_ctx->disp_drv);
-    if (disp_ctx->flags.sw_rotate) {
+    if (disp_ctx->te_wait) {
+        lvgl_port_flush_te_wait(disp_ctx);
+    }
+    if (swap_bytes) {
+        LVGL_PORT_STATS_START(stage_start);
+        lv_draw_sw_rgb565_swap(color_map, lv_area_get_size(area));
+        LVGL_PORT_STATS_ADD(disp_ctx, swap_us, stage_start);
+    }
+    disp_ctx->flush_busy = true;
+    LVGL_PORT_TRANS_START(disp_ctx);
+    esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, area->x1, area->y1, area->x2 + 1, area->y2 + 1, color_map);
+}
+
+static void LVGL_PORT_FLUSH_ATTR lvgl_port_flush_direct(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_flush_direct_impl(drv, area, color_map, false);
+}
+
+static void LVGL_PORT_FLUSH_ATTR lvgl_port_flush_direct_swap(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_flush_direct_impl(drv, area, color_map, true);
+}
+
+/* Specialized flush of RGB/MIPI-DSI frame buffers in direct mode or full refresh (double buffering) */
+static void LVGL_PORT_FLUSH_ATTR lvgl_port_flush_fb(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    assert(drv != NULL);
+    assert(color_map != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+    if (lv_disp_flush_is_last(drv)) {
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, 0, 0, lv_disp_get_hor_res(drv), lv_disp_get_ver_res(drv), color_map);
+        /* The other frame buffer is displayed until the next vsync, LVGL waits for it only before drawing into it */
+        xSemaphoreTake(disp_ctx->trans_sem, 0);
+        disp_ctx->fb_wait_pending = true;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+/* Specialized flush function of the current display configuration, NULL if only the generic one handles it */
+static lv_display_flush_cb_t lvgl_port_flush_select(const lvgl_port_display_ctx_t *disp_ctx)
+{
+    /* Features with own flush path (they change the transferred areas or release the LVGL buffer themselves) */
+    if (disp_ctx->flags.monochrome || disp_ctx->flags.sw_rotate || disp_ctx->flags.triple_buffer || disp_ctx->convert_sem || disp_ctx->coalesce_sem ||
+            disp_ctx->flush_queue || disp_ctx->hw_fill.fill_rect || disp_ctx->hw_scroll.obj || disp_ctx->round_x1 || disp_ctx->pan.fb) {
+        return NULL;
+    }
+
+    if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI) {
+        if ((disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh) && !disp_ctx->flags.swap_bytes && disp_ctx->te_sem == NULL) {
+            return lvgl_port_flush_fb;
+        }
+        return NULL;
+    }
+    return (disp_ctx->flags.swap_bytes ? lvgl_port_flush_direct_swap : lvgl_port_flush_direct);
+}
+
+/* Select flush function after change of the display configuration */
+static esp_err_t lvgl_port_flush_update(lvgl_port_display_ctx_t *disp_ctx)
+{
+    lv_display_flush_cb_t flush_cb = (LVGL_PORT_FLUSH_SPECIALIZED ? lvgl_port_flush_select(disp_ctx) : NULL);
+    if (flush_cb == NULL) {
+        flush_cb = (LVGL_PORT_FLUSH_GENERIC ? lvgl_port_flush_callback : NULL);
+    }
+    ESP_RETURN_ON_FALSE(flush_cb, ESP_ERR_NOT_SUPPORTED, TAG, "Display configuration needs generic flush (CONFIG_LVGL_PORT_FLUSH_PATH)!");
+
+#if LVGL_PORT_MIRROR
+    if (disp_ctx->mirror.cfg.panel_handle) {
+        /* Area is drawn into the mirror, before the flush changes it (e.g. swapped bytes) */
+        disp_ctx->mirror.flush_cb = flush_cb;
+        flush_cb = lvgl_port_flush_mirror_callback;
+    }
+#endif
+
+    disp_ctx->flush_cb = flush_cb;
+#if !CONFIG_LVGL_PORT_ENABLE_STATS && !LVGL_PORT_TRACE && !LVGL_PORT_FLUSH_TAP
+    /* Without wrappers LVGL calls it directly */
+    lv_display_set_flush_cb(disp_ctx->disp_drv, flush_cb);
+#endif
+    return ESP_OK;
+}
+
+#if LVGL_PORT_TRIPLE_BUFFER
+static void lvgl_port_area_join(lv_area_t *dest, const lv_area_t *area)
+{
+    if (dest->x2 < dest->x1) {
+        *dest = *area;
+    } else {
+        dest->x1 = LV_MIN(dest->x1, area->x1);
+        dest->y1 = LV_MIN(dest->y1, area->y1);
+        dest->x2 = LV_MAX(dest->x2, area->x2);
+        dest->y2 = LV_MAX(dest->y2, area->y2);
+    }
+}
+
+static void lvgl_port_fb_copy_area(const uint8_t *src, uint8_t *dest, const lv_area_t *area, uint32_t stride, uint32_t px_size)
+{
+    const uint32_t offset = area->y1 * stride + area->x1 * px_size;
+    const uint32_t len = lv_area_get_width(area) * px_size;
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(dest + offset + (y - area->y1) * stride, src + offset + (y - area->y1) * stride, len);
+    }
+}
+#endif
+
+static void lvgl_port_flush_triple(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+#if LVGL_PORT_TRIPLE_BUFFER
+    if (disp_ctx->flags.direct_mode) {
+        lvgl_port_area_join(&disp_ctx->frame_dirty, area);
+    }
+
+    if (!lv_disp_flush_is_last(drv)) {
+        lv_disp_flush_ready(drv);
         return;
     }
 
-    esp_lcd_panel_handle_t control_handle = (disp_ctx->control_handle ? disp_ctx->control_handle : disp_ctx->panel_handle);
-    /* Solve rotation screen and touch */
-    switch (lv_display_get_rotation(disp_ctx->disp_drv)) {
-    case LV_DISPLAY_ROTATION_0:
-        /* Rotate LCD display */
-        esp_lcd_panel_swap_xy(control_handle, disp_ctx->rotation.swap_xy);
-        esp_lcd_panel_mirror(control_handle, disp_ctx->rotation.mirror_x, disp_ctx->rotation.mirror_y);
-        break;
-    case LV_DISPLAY_ROTATION_90:
-        /* Rotate LCD display */
-        esp_lcd_panel_swap_xy(control_handle, !disp_ctx->rotation.swap_xy);
-        if (disp_ctx->rotation.swap_xy) {
-            esp_lcd_panel_mirror(control_handle, !disp_ctx->rotation.mirror_x, disp_ctx->rotation.mirror_y);
-        } else {
-            esp_lcd_panel_mirror(control_handle, disp_ctx->rotation.mirror_x, !disp_ctx->rotation.mirror_y);
+    const int8_t rendered = (color_map == disp_ctx->fbs[0] ? 0 : (color_map == disp_ctx->fbs[1] ? 1 : 2));
+    assert(color_map == disp_ctx->fbs[rendered]);
+
+    if (!disp_ctx->flags.frame_skip) {
+        /* Block until the previous frame is displayed */
+        while (disp_ctx->fb_pending >= 0) {
+            LVGL_PORT_STATS_START(wait_start);
+            xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+            LVGL_PORT_STATS_ADD(disp_ctx, trans_wait_us, wait_start);
+            LVGL_PORT_STATS_INC(disp_ctx, vsync_waits);
         }
-        break;
-    case LV_DISPLAY_ROTATION_180:
-        /* Rotate LCD display */
-        esp_lcd_panel_swap_xy(control_handle, disp_ctx->rotation.swap_xy);
-        esp_lcd_panel_mirror(control_handle, !disp_ctx->rotation.mirror_x, !disp_ctx->rotation.mirror_y);
-        break;
-    case LV_DISPLAY_ROTATION_270:
-        /* Rotate LCD display */
-        esp_lcd_panel_swap_xy(control_handle, !disp_ctx->rotation.swap_xy);
-        if (disp_ctx->rotation.swap_xy) {
-            esp_lcd_panel_mirror(control_handle, disp_ctx->rotation.mirror_x, !disp_ctx->rotation.mirror_y);
-        } else {
-            esp_lcd_panel_mirror(control_handle, !disp_ctx->rotation.mirror_x, disp_ctx->rotation.mirror_y);
+    }
+
+    portENTER_CRITICAL(&disp_ctx->fb_lock);
+    const uint32_t vsyncs = disp_ctx->fb_vsyncs;
+    portEXIT_CRITICAL(&disp_ctx->fb_lock);
+
+    /* Switched in the next vsync */
+    esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, 0, 0, lv_disp_get_hor_res(drv), lv_disp_get_ver_res(drv), color_map);
+
+    /* Not displayed pending frame is dropped (replaced by the new one), so it is free now */
+    portENTER_CRITICAL(&disp_ctx->fb_lock);
+    const bool swap_vsync = (disp_ctx->fb_vsyncs != vsyncs);
+    disp_ctx->fb_pending = rendered;
+    int8_t free_fb = 3 - disp_ctx->fb_displayed - rendered;
+    portEXIT_CRITICAL(&disp_ctx->fb_lock);
+
+    if (swap_vsync) {
+        /* Vsync came during the swap, the new frame can be displayed already and the displayed index is not known.
+           After the next vsync, the new frame is displayed and both other frame buffers are free. */
+        while (disp_ctx->fb_pending >= 0) {
+            xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
         }
-        break;
+        free_fb = (rendered + 1) % 3;
     }
 
-    /* Wake LVGL task, if needed */
-    lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, disp_ctx->disp_drv);
+    if (disp_ctx->flags.direct_mode) {
+        /* Only redrawn areas are rendered, update the free frame buffer with areas from older frames.
+           Areas of this frame are copied into the next draw buffer (the free frame buffer) by LVGL itself. */
+        for (int i = 0; i < 3; i++) {
+            if (i != rendered && i != free_fb) {
+                lvgl_port_area_join(&disp_ctx->fb_missing[i], &disp_ctx->frame_dirty);
+            }
+        }
+        lv_area_set(&disp_ctx->frame_dirty, 0, 0, -1, -1);
+
+        if (disp_ctx->fb_missing[free_fb].x2 >= disp_ctx->fb_missing[free_fb].x1) {
+            lv_color_format_t cf = lv_display_get_color_format(drv);
+            uint32_t stride = lv_draw_buf_width_to_stride(lv_disp_get_hor_res(drv), cf);
+            lvgl_port_fb_copy_area(color_map, disp_ctx->fbs[free_fb], &disp_ctx->fb_missing[free_fb], stride, lv_color_format_get_size(cf));
+            lv_area_set(&disp_ctx->fb_missing[free_fb], 0, 0, -1, -1);
+        }
+    }
+
+    /* LVGL renders the next frame into the other draw buffer */
+    lv_draw_buf_t *next = (lv_display_get_buf_active(drv) == &disp_ctx->fb_draw_bufs[0] ? &disp_ctx->fb_draw_bufs[1] : &disp_ctx->fb_draw_bufs[0]);
+    next->data = disp_ctx->fbs[free_fb];
+    next->unaligned_data = disp_ctx->fbs[free_fb];
+#endif
+
+    lv_disp_flush_ready(drv);
 }
 
-static void lvgl_port_disp_size_update_callback(lv_event_t *e)
+/* Drawing into the frame buffer waits, until it is not displayed (double buffering) */
+static void lvgl_port_fb_wait_callback(lv_event_t *e)
 {
-    assert(e);
     lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
-    lvgl_port_disp_rotation_update(disp_ctx);
+    assert(disp_ctx != NULL);
+
+    if (disp_ctx->fb_wait_pending) {
+        LVGL_PORT_STATS_START(wait_start);
+        xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+        LVGL_PORT_STATS_ADD(disp_ctx, trans_wait_us, wait_start);
+        LVGL_PORT_STATS_INC(disp_ctx, vsync_waits);
+        disp_ctx->fb_wait_pending = false;
+    }
 }
 
-static void lvgl_port_display_invalidate_callback(lv_event_t *e)
+#if LVGL_PORT_PPA
+static bool LVGL_PORT_ISR_ATTR lvgl_port_ppa_done_callback(ppa_client_handle_t ppa_client, ppa_event_data_t *event_data, void *user_data)
 {
-    /* Wake LVGL task, if needed */
-    lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)user_data;
+    assert(disp_ctx != NULL);
+    return lvgl_port_flush_ready_from_isr(disp_ctx);
 }
+
+static bool lvgl_port_ppa_color_mode(lv_color_format_t cf, ppa_srm_color_mode_t *cm)
+{
+    switch (cf) {
+    case LV_COLOR_FORMAT_RGB565:
+        *cm = PPA_SRM_COLOR_MODE_RGB565;
+        return true;
+    case LV_COLOR_FORMAT_RGB888:
+        *cm = PPA_SRM_COLOR_MODE_RGB888;
+        return true;
+    case LV_COLOR_FORMAT_XRGB8888:
+    case LV_COLOR_FORMAT_ARGB8888:
+        *cm = PPA_SRM_COLOR_MODE_ARGB8888;
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* PPA rotates counter-clockwise, same as LVGL */
+static ppa_srm_rotation_angle_t lvgl_port_ppa_angle(lv_display_rotation_t rotation)
+{
+    switch (rotation) {
+    case LV_DISPLAY_ROTATION_90:
+        return PPA_SRM_ROTATION_ANGLE_90;
+    case LV_DISPLAY_ROTATION_180:
+        return PPA_SRM_ROTATION_ANGLE_180;
+    case LV_DISPLAY_ROTATION_270:
+        return PPA_SRM_ROTATION_ANGLE_270;
+    default:
+        return PPA_SRM_ROTATION_ANGLE_0;
+    }
+}
+
+static bool lvgl_port_ppa_rotate(lv_display_t *drv, lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+    ppa_srm_color_mode_t cm;
+    lv_color_format_t cf = lv_display_get_color_format(drv);
+    if (!lvgl_port_ppa_color_mode(cf, &cm)) {
+        /* Not supported by PPA, use SW rotation */
+        return false;
+    }
+    const ppa_srm_rotation_angle_t angle = lvgl_port_ppa_angle(disp_ctx->current_rotation);
+
+    const int32_t ww = lv_area_get_width(area);
+    const int32_t hh = lv_area_get_height(area);
+    const uint32_t px_size = lv_color_format_get_size(cf);
+    const bool swap_xy = (angle == PPA_SRM_ROTATION_ANGLE_90 || angle == PPA_SRM_ROTATION_ANGLE_270);
+
+    ppa_srm_oper_config_t srm_cfg = {
+        .in = {
+            .buffer = color_map,
+            .pic_w = lv_draw_buf_width_to_stride(ww, cf) / px_size,
+            .pic_h = hh,
+            .block_w = ww,
+            .block_h = hh,
+            .block_offset_x = 0,
+            .block_offset_y = 0,
+            .srm_cm = cm,
+        },
+        .out = {
+            .srm_cm = cm,
+        },
+        .rotation_angle = angle,
+        .scale_x = 1.0,
+        .scale_y = 1.0,
+        .byte_swap = disp_ctx->flags.swap_bytes,
+        .user_data = disp_ctx,
+    };
+
+    /* Area in the panel coordinates */
+    const lv_area_t orig_area = *area;
+    lvgl_port_rotate_area(drv, area);
+
+    if (disp_ctx->ppa_fb) {
+        /* Directly into the frame buffer, flush is done in PPA callback */
+        const uint32_t hres = lv_display_get_physical_horizontal_resolution(drv);
+        const uint32_t vres = lv_display_get_physical_vertical_resolution(drv);
+        srm_cfg.out.buffer = disp_ctx->ppa_fb;
+        srm_cfg.out.buffer_size = hres * vres * px_size;
+        srm_cfg.out.pic_w = hres;
+        srm_cfg.out.pic_h = vres;
+        srm_cfg.out.block_offset_x = area->x1;
+        srm_cfg.out.block_offset_y = area->y1;
+        srm_cfg.mode = PPA_TRANS_MODE_NON_BLOCKING;
+    } else {
+        srm_cfg.out.buffer = disp_ctx->draw_buffs[2];
+        srm_cfg.out.buffer_size = disp_ctx->ppa_buff_size;
+        srm_cfg.out.pic_w = (swap_xy ? hh : ww);
+        srm_cfg.out.pic_h = (swap_xy ? ww : hh);
+        srm_cfg.mode = PPA_TRANS_MODE_BLOCKING;
+    }
+
+    if (ppa_do_scale_rotate_mirror(disp_ctx->ppa_handle, &srm_cfg) != ESP_OK) {
+        ESP_LOGE(TAG, "PPA rotation failed!");
+        /* Use SW rotation (also with frame buffer output, the area is sent by draw_bitmap then) */
+        *area = orig_area;
+        return false;
+    }
+
+    return true;
+}
+#endif
+
+#if LVGL_PORT_MIRROR
+/* Scale and position of the content on the mirror panel, after change of the display resolution (rotation) */
+static void lvgl_port_mirror_update(lvgl_port_display_ctx_t *disp_ctx)
+{
+    const lvgl_port_disp_mirror_cfg_t *cfg = &disp_ctx->mirror.cfg;
+    const bool swap_xy = (cfg->rotation == LV_DISPLAY_ROTATION_90 || cfg->rotation == LV_DISPLAY_ROTATION_270);
+    const int32_t w = (swap_xy ? lv_display_get_vertical_resolution(disp_ctx->disp_drv) : lv_display_get_horizontal_resolution(disp_ctx->disp_drv));
+    const int32_t h = (swap_xy ? lv_display_get_horizontal_resolution(disp_ctx->disp_drv) : lv_display_get_vertical_resolution(disp_ctx->disp_drv));
+
+    /* PPA scales in steps of 1/16 */
+    float scale = cfg->scale;
+    if (scale <= 0.0f) {
+        scale = LV_MIN((float)cfg->hres / w, (float)cfg->vres / h);
+    }
+    scale = floorf(scale * 16.0f) / 16.0f;
+    scale = LV_MIN(scale, LV_MIN((float)cfg->hres / w, (float)cfg->vres / h));
+    scale = LV_MAX(scale, 1.0f / 16.0f);
+    disp_ctx->mirror.scale = scale;
+    disp_ctx->mirror.offset_x = ((int32_t)cfg->hres - (int32_t)(w * scale)) / 2;
+    disp_ctx->mirror.offset_y = ((int32_t)cfg->vres - (int32_t)(h * scale)) / 2;
+
+    /* Borders around the content are black, the content is drawn again after invalidation */
+    const size_t fb_size = cfg->hres * cfg->vres * disp_ctx->mirror.px_size;
+    memset(disp_ctx->mirror.fb, 0, fb_size);
+    esp_cache_msync(disp_ctx->mirror.fb, fb_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+}
+
+/* Area of the display rotated on the mirror panel (w and h is the display resolution) */
+static void lvgl_port_mirror_rotate_area(lv_area_t *area, lv_display_rotation_t rotation, int32_t w, int32_t h)
+{
+    const lv_area_t a = *area;
+    switch (rotation) {
+    case LV_DISPLAY_ROTATION_90:
+        lv_area_set(area, a.y1, w - 1 - a.x2, a.y2, w - 1 - a.x1);
+        break;
+    case LV_DISPLAY_ROTATION_180:
+        lv_area_set(area, w - 1 - a.x2, h - 1 - a.y2, w - 1 - a.x1, h - 1 - a.y1);
+        break;
+    case LV_DISPLAY_ROTATION_270:
+        lv_area_set(area, h - 1 - a.y2, a.x1, h - 1 - a.y1, a.x2);
+        break;
+    default:
+        break;
+    }
+}
+
+static void lvgl_port_mirror_draw(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, const uint8_t *color_map)
+{
+    lv_display_t *disp = disp_ctx->disp_drv;
+    const lv_color_format_t cf = lv_display_get_color_format(disp);
+    ppa_srm_color_mode_t in_cm;
+    if (!lvgl_port_ppa_color_mode(cf, &in_cm)) {
+        return;
+    }
+    const int32_t hres = lv_display_get_horizontal_resolution(disp);
+    const int32_t vres = lv_display_get_vertical_resolution(disp);
+    lv_area_t a;
+    if (!lv_area_intersect(&a, area, &(lv_area_t) { 0, 0, hres - 1, vres - 1 })) {
+        return;
+    }
+
+    /* In direct mode, the buffer is the whole display */
+    const bool direct = disp_ctx->flags.direct_mode;
+    const uint32_t px_size = lv_color_format_get_size(cf);
+    const lvgl_port_disp_mirror_cfg_t *cfg = &disp_ctx->mirror.cfg;
+    const float scale = disp_ctx->mirror.scale;
+    lv_area_t out = a;
+    lvgl_port_mirror_rotate_area(&out, cfg->rotation, hres, vres);
+
+    ppa_srm_oper_config_t srm_cfg = {
+        .in = {
+            .buffer = color_map,
+            .pic_w = lv_draw_buf_width_to_stride(direct ? hres : lv_area_get_width(area), cf) / px_size,
+            .pic_h = (direct ? vres : lv_area_get_height(area)),
+            .block_w = lv_area_get_width(&a),
+            .block_h = lv_area_get_height(&a),
+            .block_offset_x = (direct ? a.x1 : a.x1 - area->x1),
+            .block_offset_y = (direct ? a.y1 : a.y1 - area->y1),
+            .srm_cm = in_cm,
+        },
+        .out = {
+            .buffer = disp_ctx->mirror.fb,
+            .buffer_size = cfg->hres * cfg->vres * disp_ctx->mirror.px_size,
+            .pic_w = cfg->hres,
+            .pic_h = cfg->vres,
+            .block_offset_x = disp_ctx->mirror.offset_x + (uint32_t)(out.x1 * scale),
+            .block_offset_y = disp_ctx->mirror.offset_y + (uint32_t)(out.y1 * scale),
+            .srm_cm = disp_ctx->mirror.out_cm,
+        },
+        .rotation_angle = lvgl_port_ppa_angle(cfg->rotation),
+        .scale_x = scale,
+        .scale_y = scale,
+        .mode = PPA_TRANS_MODE_BLOCKING,
+    };
+    /* PPA does the work, LVGL task only waits for it */
+    if (ppa_do_scale_rotate_mirror(disp_ctx->mirror.ppa, &srm_cfg) != ESP_OK) {
+        ESP_LOGE(TAG, "PPA mirror failed!");
+    }
+}
+
+static void lvgl_port_flush_mirror_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+    lvgl_port_mirror_draw(disp_ctx, area, color_map);
+    disp_ctx->mirror.flush_cb(drv, area, color_map);
+}
+#endif
+
+static inline void lvgl_port_flush_coalesce_send(lvgl_port_display_ctx_t *disp_ctx)
+{
+    const lv_area_t *ca = &disp_ctx->coalesce_area;
+    LVGL_PORT_TRANS_START(disp_ctx);
+    esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, ca->x1, ca->y1, ca->x2 + 1, ca->y2 + 1, disp_ctx->coalesce_buffs[disp_ctx->coalesce_idx]);
+    disp_ctx->coalesce_idx ^= 1;
+    disp_ctx->coalesce_len = 0;
+}
+
+static void lvgl_port_flush_coalesce(lv_display_t *drv, int x1, int y1, int x2, int y2, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+    const bool last = lv_disp_flush_is_last(drv);
+    const uint32_t len = (x2 - x1 + 1) * (y2 - y1 + 1) * lv_color_format_get_size(lv_display_get_color_format(drv));
+    lv_area_t *ca = &disp_ctx->coalesce_area;
+
+    /* Send pending area, when this one cannot be appended (rows of the same x-span are contiguous in memory) */
+    if (disp_ctx->coalesce_len > 0) {
+        bool mergeable = (ca->x1 == x1 && ca->x2 == x2 && ca->y2 + 1 == y1 && disp_ctx->coalesce_len + len <= disp_ctx->coalesce_buff_size);
+        if (!mergeable) {
+            lvgl_port_flush_coalesce_send(disp_ctx);
+        }
+    }
+
+    /* Too big area, send it directly from LVGL buffer (released in done callback) */
+    if (len > disp_ctx->coalesce_buff_size) {
+        LVGL_PORT_TRANS_START(disp_ctx);
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, x1, y1, x2 + 1, y2 + 1, color_map);
+        return;
+    }
+
+    if (disp_ctx->coalesce_len == 0) {
+        /* Wait for free buffer */
+        LVGL_PORT_STATS_START(wait_start);
+        xSemaphoreTake(disp_ctx->coalesce_sem, portMAX_DELAY);
+        LVGL_PORT_STATS_ADD(disp_ctx, trans_wait_us, wait_start);
+        ca->x1 = x1;
+        ca->y1 = y1;
+        ca->x2 = x2;
+    }
+    ca->y2 = y2;
+    memcpy(disp_ctx->coalesce_buffs[disp_ctx->coalesce_idx] + disp_ctx->coalesce_len, color_map, len);
+    disp_ctx->coalesce_len += len;
+
+    /* LVGL buffer is not used anymore */
+    lv_disp_flush_ready(drv);
+
+    if (last) {
+        lvgl_port_flush_coalesce_send(disp_ctx);
+    }
+}
+
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+static void lvgl_port_stats_accumulate(lvgl_port_disp_counters_t *dest, const lvgl_port_disp_counters_t *src)
+{
+    dest->frames += src->frames;
+    dest->flushes += src->flushes;
+    dest->pixels += src->pixels;
+    dest->render_us += src->render_us;
+    dest->rotate_us += src->rotate_us;
+    dest->monochrome_us += src->monochrome_us;
+    dest->swap_us += src->swap_us;
+    dest->trans_wait_us += src->trans_wait_us;
+    dest->vsync_waits += src->vsync_waits;
+    dest->max_flush_us = LV_MAX(dest->max_flush_us, src->max_flush_us);
+}
+
+static void lvgl_port_stats_update_window(lvgl_port_display_ctx_t *disp_ctx, int64_t now)
+{
+    if (now - disp_ctx->stats_window_start < (int64_t)CONFIG_LVGL_PORT_STATS_WINDOW_MS * 1000) {
+        return;
+    }
+
+    /* Finish current window */
+    lvgl_port_stats_accumulate(&disp_ctx->stats_total, &disp_ctx->stats_cur);
+    disp_ctx->stats_window = disp_ctx->stats_cur;
+    memset(&disp_ctx->stats_cur, 0, sizeof(lvgl_port_disp_counters_t));
+    disp_ctx->stats_window_start = now;
+}
+
+static void lvgl_port_stats_render_callback(lv_event_t *e)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
+    assert(disp_ctx != NULL);
+
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        disp_ctx->stats_render_start = esp_timer_get_time();
+    } else if (disp_ctx->stats_render_start) {
+        LVGL_PORT_STATS_ADD(disp_ctx, render_us, disp_ctx->stats_render_start);
+        LVGL_PORT_STATS_INC(disp_ctx, frames);
+        disp_ctx->stats_render_start = 0;
+    }
+}
+
+static void lvgl_port_flush_stats_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+    int64_t start = esp_timer_get_time();
+    lvgl_port_stats_update_window(disp_ctx, start);
+    disp_ctx->stats_cur.flushes++;
+    disp_ctx->stats_cur.pixels += lv_area_get_size(area);
+
+#if LVGL_PORT_FLUSH_TAP
+    lvgl_port_flush_tap_callback(drv, area, color_map);
+#else
+    disp_ctx->flush_cb(drv, area, color_map);
+#endif
+
+    uint32_t flush_us = esp_timer_get_time() - start;
+    if (flush_us > disp_ctx->stats_cur.max_flush_us) {
+        disp_ctx->stats_cur.max_flush_us = flush_us;
+    }
+}
+#endif
+
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+static void lvgl_port_latency_render_callback(lv_event_t *e)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
+    assert(disp_ctx != NULL);
+
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        lvgl_port_latency_render_start(disp_ctx->disp_drv);
+        return;
+    }
+
+    /* RGB/MIPI-DSI frame buffers are shown on vsync */
+    lvgl_port_latency_done_t done_mode = LVGL_PORT_LATENCY_DONE_TRANS;
+    if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI && (disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh))) {
+        done_mode = LVGL_PORT_LATENCY_DONE_VSYNC;
+    }
+#if LVGL_PORT_PPA
+    /* PPA writes into the frame buffer directly, without transfer done callback */
+    if (disp_ctx->ppa_fb) {
+        done_mode = LVGL_PORT_LATENCY_DONE_NOW;
+    }
+#endif
+    lvgl_port_latency_render_ready(disp_ctx->disp_drv, done_mode, disp_ctx->latency_trans_issued, &disp_ctx->latency_trans_done);
+}
+#endif
+
+#if LVGL_PORT_TRACE
+static void lvgl_port_trace_render_callback(lv_event_t *e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        LVGL_PORT_TRACE_BEGIN(LVGL_PORT_TRACE_RENDER);
+    } else {
+        LVGL_PORT_TRACE_END(LVGL_PORT_TRACE_RENDER);
+    }
+}
+
+static void lvgl_port_flush_trace_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    LVGL_PORT_TRACE_BEGIN(LVGL_PORT_TRACE_FLUSH);
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+    lvgl_port_flush_stats_callback(drv, area, color_map);
+#elif LVGL_PORT_FLUSH_TAP
+    lvgl_port_flush_tap_callback(drv, area, color_map);
+#else
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+    disp_ctx->flush_cb(drv, area, color_map);
+#endif
+    LVGL_PORT_TRACE_END(LVGL_PORT_TRACE_FLUSH);
+}
+#endif
+
+#if LVGL_PORT_FLUSH_TAP
+static void lvgl_port_flush_tap_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+#if CONFIG_LVGL_PORT_HEATMAP
+    lvgl_port_heatmap_flush(disp_ctx->heatmap, area);
+#endif
+#if CONFIG_LVGL_PORT_REMOTE_VIEW
+    /* Copied before the flush function swaps bytes or rotates the pixels in place */
+    lvgl_port_remote_flush(disp_ctx->remote, area, color_map, disp_ctx->flags.direct_mode);
+#endif
+    disp_ctx->flush_cb(drv, area, color_map);
+}
+#endif
+
+static inline void lvgl_port_rotate_stripe(lvgl_port_display_ctx_t *disp_ctx, const uint8_t *src, uint8_t *dest, int32_t w, int32_t h, uint32_t src_stride, uint32_t dest_stride, lv_color_format_t cf)
+{
+    if (disp_ctx->flags.sw_rotate_tiled || disp_ctx->flags.swap_bytes) {
+        /* Rotate and swap bytes in one pass */
+        lvgl_port_rotate_tiled(src, dest, w, h, src_stride, dest_stride, (lvgl_port_rotate_t)disp_ctx->current_rotation, lv_color_format_get_size(cf), disp_ctx->flags.swap_bytes);
+    } else {
+        lv_draw_sw_rotate(src, dest, w, h, src_stride, dest_stride, disp_ctx->current_rotation, cf);
+    }
+}
+
+static void lvgl_port_flush_rotate_stripes(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+    const lv_display_rotation_t rotation = disp_ctx->current_rotation;
+    const lv_color_format_t cf = lv_display_get_color_format(drv);
+    const uint32_t px_size = lv_color_format_get_size(cf);
+    const int32_t ww = lv_area_get_width(area);
+    const int32_t hh = lv_area_get_height(area);
+    const uint32_t w_stride = lv_draw_buf_width_to_stride(ww, cf);
+    const uint32_t h_stride = lv_draw_buf_width_to_stride(hh, cf);
+    const uint32_t stripe_bytes = disp_ctx->rotate_buff_size * sizeof(lv_color_t);
+
+    /* 90/270: stripe is a group of source columns, 180: stripe is a group of source rows */
+    const bool by_columns = (rotation == LV_DISPLAY_ROTATION_90 || rotation == LV_DISPLAY_ROTATION_270);
+    const int32_t total = (by_columns ? ww : hh);
+    int32_t step = stripe_bytes / (by_columns ? h_stride : w_stride);
+    if (step > total) {
+        step = total;
+    }
+    assert(step > 0);
+
+    for (int32_t pos = 0; pos < total; pos += step) {
+        const int32_t count = (total - pos > step ? step : total - pos);
+        /* Buffers alternate across flushes, the last stripe of the previous flush may still be on the wire */
+        uint8_t *dest = (uint8_t *)disp_ctx->rotate_buffs[disp_ctx->rotate_idx];
+        disp_ctx->rotate_idx ^= 1;
+        lv_area_t stripe_area = *area;
+
+        /* Wait for free stripe buffer (transmitted two stripes ago) */
+        LVGL_PORT_STATS_START(wait_start);
+        xSemaphoreTake(disp_ctx->rotate_sem, portMAX_DELAY);
+        LVGL_PORT_STATS_ADD(disp_ctx, trans_wait_us, wait_start);
+
+        LVGL_PORT_STATS_START(rotate_start);
+        if (by_columns) {
+            stripe_area.x1 = area->x1 + pos;
+            stripe_area.x2 = stripe_area.x1 + count - 1;
+            lvgl_port_rotate_stripe(disp_ctx, color_map + pos * px_size, dest, count, hh, w_stride, h_stride, cf);
+        } else {
+            stripe_area.y1 = area->y1 + pos;
+            stripe_area.y2 = stripe_area.y1 + count - 1;
+            lvgl_port_rotate_stripe(disp_ctx, color_map + pos * w_stride, dest, ww, count, w_stride, w_stride, cf);
+        }
+        LVGL_PORT_STATS_ADD(disp_ctx, rotate_us, rotate_start);
+
+        /* Queue the stripe, the next one is rotated while this one is on the wire */
+        lvgl_port_rotate_area(drv, &stripe_area);
+        LVGL_PORT_TRANS_START(disp_ctx);
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, stripe_area.x1, stripe_area.y1, stripe_area.x2 + 1, stripe_area.y2 + 1, dest);
+    }
+
+    /* Whole area was copied out of the LVGL buffer, LVGL can render the next area */
+    lv_disp_flush_ready(drv);
+}
+
+static void lvgl_port_disp_fill_lut(lvgl_port_display_ctx_t *disp_ctx, const lv_color_t *palette)
+{
+    for (int i = 0; i < 256; i++) {
+        const lv_color_t c = (palette ? palette[i] : lv_color_make(i, i, i));
+        const uint16_t v = lv_color_to_u16(c);
+        disp_ctx->convert_lut[i] = (disp_ctx->flags.swap_bytes ? __builtin_bswap16(v) : v);
+    }
+}
+
+static void lvgl_port_flush_convert(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+    const lv_color_format_t cf = lv_display_get_color_format(drv);
+    const int32_t ww = lv_area_get_width(area);
+    const int32_t hh = lv_area_get_height(area);
+    const uint32_t src_stride = lv_draw_buf_width_to_stride(ww, cf);
+    const lv_color_format_t panel_cf = disp_ctx->panel_color_format;
+    const uint32_t dest_stride = ww * lv_color_format_get_size(panel_cf);
+    int32_t step = disp_ctx->convert_buff_size / dest_stride;
+    if (step > hh) {
+        step = hh;
+    }
+    assert(step > 0);
+
+    for (int32_t y = 0; y < hh; y += step) {
+        const int32_t lines = (hh - y > step ? step : hh - y);
+        uint8_t *dest = disp_ctx->convert_buffs[disp_ctx->convert_idx];
+        disp_ctx->convert_idx ^= 1;
+
+        /* Wait for free conversion buffer (transmitted two stripes ago) */
+        LVGL_PORT_STATS_START(wait_start);
+        xSemaphoreTake(disp_ctx->convert_sem, portMAX_DELAY);
+        LVGL_PORT_STATS_ADD(disp_ctx, trans_wait_us, wait_start);
+
+        LVGL_PORT_STATS_START(convert_start);
+        if (cf == LV_COLOR_FORMAT_L8) {
+            lvgl_port_convert_l8_to_rgb565(color_map + y * src_stride, dest, ww, lines, src_stride, dest_stride, disp_ctx->convert_lut);
+        } else if (panel_cf == LV_COLOR_FORMAT_RGB565) {
+            lvgl_port_convert_to_rgb565(color_map + y * src_stride, dest, ww, lines, src_stride, dest_stride, lv_color_format_get_size(cf), disp_ctx->flags.swap_bytes);
+        } else {
+            lvgl_port_convert_to_rgb888(color_map + y * src_stride, dest, ww, lines, src_stride, dest_stride, lv_color_format_get_size(cf), disp_ctx->flags.swap_bytes);
+        }
+        LVGL_PORT_STATS_ADD(disp_ctx, swap_us, convert_start);
+
+        /* Queue the stripe, the next one is converted while this one is on the wire */
+        LVGL_PORT_TRANS_START(disp_ctx);
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, area->x1, area->y1 + y, area->x2 + 1, area->y1 + y + lines, dest);
+    }
+
+    /* Whole area was converted out of the LVGL buffer, LVGL can render the next area */
+    lv_disp_flush_ready(drv);
+}
+
+static void lvgl_port_disp_rotation_update(lvgl_port_display_ctx_t *disp_ctx)
+{
+    assert(disp_ctx != NULL);
+
+    disp_ctx->current_rotation = lv_display_get_rotation(disp_ctx->disp_drv);
+    /* Pages of monochrome display are mapped differently */
+    disp_ctx->oled_shadow_valid = false;
+    if (disp_ctx->current_rotation != LV_DISPLAY_ROTATION_0) {
+        /* Hardware scroll moves the lines of not rotated display only */
+        lvgl_port_hw_scroll_disable(disp_ctx, false);
+    }
+    if (disp_ctx->flags.sw_rotate) {
+        return;
+    }
+
+    esp_lcd_panel_handle_t control_handle = (disp_ctx->control_handle ? disp_ctx->control_handle : disp_ctx->panel_handle);
+    /* Solve rotation screen and touch */
+    switch (lv_display_get_rotation(disp_ctx->disp_drv)) {
+    case LV_DISPLAY_ROTATION_0:
+        /* Rotate LCD display */
+        esp_lcd_panel_swap_xy(control_handle, disp_ctx->rotation.swap_xy);
+        esp_lcd_panel_mirror(control_handle, disp_ctx->rotation.mirror_x, disp_ctx->rotation.mirror_y);
+        break;
+    case LV_DISPLAY_ROTATION_90:
+        /* Rotate LCD display */
+        esp_lcd_panel_swap_xy(control_handle, !disp_ctx->rotation.swap_xy);
+        if (disp_ctx->rotation.swap_xy) {
+            esp_lcd_panel_mirror(control_handle, !disp_ctx->rotation.mirror_x, disp_ctx->rotation.mirror_y);
+        } else {
+            esp_lcd_panel_mirror(control_handle, disp_ctx->rotation.mirror_x, !disp_ctx->rotation.mirror_y);
+        }
+        break;
+    case LV_DISPLAY_ROTATION_180:
+        /* Rotate LCD display */
+        esp_lcd_panel_swap_xy(control_handle, disp_ctx->rotation.swap_xy);
+        esp_lcd_panel_mirror(control_handle, !disp_ctx->rotation.mirror_x, !disp_ctx->rotation.mirror_y);
+        break;
+    case LV_DISPLAY_ROTATION_270:
+        /* Rotate LCD display */
+        esp_lcd_panel_swap_xy(control_handle, !disp_ctx->rotation.swap_xy);
+        if (disp_ctx->rotation.swap_xy) {
+            esp_lcd_panel_mirror(control_handle, disp_ctx->rotation.mirror_x, !disp_ctx->rotation.mirror_y);
+        } else {
+            esp_lcd_panel_mirror(control_handle, !disp_ctx->rotation.mirror_x, disp_ctx->rotation.mirror_y);
+        }
+        break;
+    }
+
+    /* Wake LVGL task, if needed */
+    lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, disp_ctx->disp_drv);
+}
+
+static void lvgl_port_disp_size_update_callback(lv_event_t *e)
+{
+    assert(e);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
+    lvgl_port_disp_rotation_update(disp_ctx);
+#if LVGL_PORT_MIRROR
+    if (disp_ctx->mirror.cfg.panel_handle) {
+        lvgl_port_mirror_update(disp_ctx);
+    }
+#endif
+}
+
+static void lvgl_port_display_invalidate_callback(lv_event_t *e)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
+    if (disp_ctx->flags.vsync_pacing) {
+        disp_ctx->vsync_armed = true;
+    }
+    if (disp_ctx->hw_scroll.obj && lv_event_get_code(e) == LV_EVENT_INVALIDATE_AREA) {
+        lvgl_port_hw_scroll_invalidate(disp_ctx, (lv_area_t *)lv_event_get_param(e));
+    }
+    if (disp_ctx->round_x1 && lv_event_get_code(e) == LV_EVENT_INVALIDATE_AREA) {
+        lvgl_port_round_invalidate(disp_ctx, (lv_area_t *)lv_event_get_param(e));
+    }
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    if (lv_event_get_code(e) == LV_EVENT_INVALIDATE_AREA) {
+        lvgl_port_latency_invalidate(disp_ctx->disp_drv);
+    }
+#endif
+
+    /* Wake LVGL task, if needed */
+    lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, NULL);
+}
+
+void lvgl_port_disp_task_config(int lvgl_task_affinity)
+{
+    lvgl_port_flush_task_affinity = lvgl_task_affinity;
+}
+
+void lvgl_port_disp_frame_sync(lv_display_t *disp, uint32_t frame_period_ms)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    if (disp_ctx == NULL || !disp_ctx->flags.vsync_pacing) {
+        return;
+    }
+
+    const int64_t now = esp_timer_get_time();
+    if (frame_period_ms > 0 && now - disp_ctx->frame_start < (int64_t)frame_period_ms * 1000 - LVGL_PORT_VSYNC_PACING_TOLERANCE_US) {
+        /* Frame rate limit, wait for the next vsync */
+        disp_ctx->vsync_armed = true;
+        return;
+    }
+
+    disp_ctx->frame_start = now;
+    lv_timer_t *refr_timer = lv_display_get_refr_timer(disp);
+    if (refr_timer) {
+        lv_timer_ready(refr_timer);
+    }
+}
+
+esp_err_t lvgl_port_disp_draw_external(lv_display_t *disp, int x1, int y1, int x2, int y2, const void *data, lvgl_port_disp_ext_done_cb_t done_cb, void *user_ctx)
+{
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    /* Only displays with simple transfer done callback (SPI/I2C/I8080), without own transfer pipelines */
+    if (disp_ctx->disp_type != LVGL_PORT_DISP_TYPE_OTHER || disp_ctx->flags.sw_rotate_stripes || disp_ctx->coalesce_sem || disp_ctx->flush_queue || disp_ctx->convert_sem) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (data == NULL) {
+        return ESP_OK;
+    }
+
+    /* Wait for the transfer in progress, then the transfer done callbacks are in order of sending */
+    lvgl_port_disp_wait_idle(disp_ctx);
+
+    disp_ctx->ext_done_cb = done_cb;
+    disp_ctx->ext_ctx = user_ctx;
+    disp_ctx->ext_busy = true;
+    esp_err_t ret = esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, x1, y1, x2, y2, data);
+    if (ret != ESP_OK) {
+        disp_ctx->ext_busy = false;
+    }
+    return ret;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t lvgl_port_disp_set_hw_scroll(lv_display_t *disp, lv_obj_t *obj, const lvgl_port_hw_scroll_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+
+    lvgl_port_hw_scroll_disable(disp_ctx, false);
+    if (obj == NULL) {
+        return ESP_OK;
+    }
+    /* Panned RGB display is scrolled by the scan-out offset of its virtual frame buffer */
+    const bool pan = (disp_ctx->pan.fb != NULL);
+    ESP_RETURN_ON_FALSE(pan || (cfg && ((cfg->set_scroll_area && cfg->set_scroll_start) || cfg->copy_rect)), ESP_ERR_INVALID_ARG, TAG, "invalid hardware scroll functions");
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    /* Only simple transfers of not rotated areas (SPI/I2C/I8080 or panned RGB), the flushed lines are remapped before sending */
+    if (!LVGL_PORT_FLUSH_GENERIC || (disp_ctx->disp_type != LVGL_PORT_DISP_TYPE_OTHER && !pan) || disp_ctx->flags.sw_rotate || disp_ctx->coalesce_sem || disp_ctx->flush_queue || disp_ctx->convert_sem ||
+            disp_ctx->flags.monochrome || disp_ctx->flags.direct_mode || disp_ctx->flags.full_refresh ||
+            disp_ctx->current_rotation != LV_DISPLAY_ROTATION_0 || disp_ctx->rotation.swap_xy || disp_ctx->rotation.mirror_y) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+
+    /* Vertical scrolling area is the visible part of full width object */
+    const int32_t hres = lv_display_get_horizontal_resolution(disp);
+    const int32_t vres = lv_display_get_vertical_resolution(disp);
+    lv_area_t coords;
+    lv_obj_update_layout(obj);
+    lv_obj_get_coords(obj, &coords);
+    const int32_t top = LV_MAX(coords.y1, 0);
+    const int32_t bottom = LV_MIN(coords.y2, vres - 1);
+    ESP_RETURN_ON_FALSE(coords.x1 <= 0 && coords.x2 >= hres - 1 && bottom >= top, ESP_ERR_INVALID_ARG, TAG, "object must be visible in full width");
+
+    if (!pan && cfg->set_scroll_area) {
+        ESP_RETURN_ON_ERROR(cfg->set_scroll_area(disp_ctx->panel_handle, top, bottom - top + 1), TAG, "set scroll area failed");
+        ESP_RETURN_ON_ERROR(cfg->set_scroll_start(disp_ctx->panel_handle, top), TAG, "set scroll start failed");
+    }
+
+    /* Scrollbar would move with the content */
+    lv_obj_set_scrollbar_mode(obj, LV_SCROLLBAR_MODE_OFF);
+
+    disp_ctx->hw_scroll.cfg = (pan ? (lvgl_port_hw_scroll_cfg_t) {0} : *cfg);
+    disp_ctx->hw_scroll.top = top;
+    disp_ctx->hw_scroll.height = bottom - top + 1;
+    /* Off-screen lines of the virtual frame buffer are in the ring of the scrolling area */
+    disp_ctx->hw_scroll.ring = disp_ctx->hw_scroll.height + (pan ? (int32_t)disp_ctx->pan.lines - vres : 0);
+    disp_ctx->hw_scroll.offset = 0;
+    disp_ctx->hw_scroll.scroll_x = lv_obj_get_scroll_x(obj);
+    disp_ctx->hw_scroll.scroll_y = lv_obj_get_scroll_y(obj);
+    disp_ctx->hw_scroll.exposed_pending = false;
+    disp_ctx->hw_scroll.dirty = true;   /* Areas invalidated before are not known */
+    disp_ctx->hw_scroll.obj = obj;
+    lv_obj_add_event_cb(obj, lvgl_port_hw_scroll_callback, LV_EVENT_SCROLL, disp_ctx);
+    lv_obj_add_event_cb(obj, lvgl_port_hw_scroll_callback, LV_EVENT_DELETE, disp_ctx);
+    lv_display_add_event_cb(disp, lvgl_port_hw_scroll_refr_callback, LV_EVENT_REFR_READY, disp_ctx);
+
+    if (pan && bottom < vres - 1) {
+        /* Lines below the scrolling area follow the ring in the virtual frame buffer */
+        const lv_area_t below = { .x1 = 0, .y1 = bottom + 1, .x2 = hres - 1, .y2 = vres - 1 };
+        lv_inv_area(disp, &below);
+    }
+
+    return lvgl_port_flush_update(disp_ctx);
+}
+
+esp_err_t lvgl_port_disp_set_hw_fill(lv_display_t *disp, lvgl_port_hw_fill_cb_t fill_rect, uint32_t min_pixels)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+
+    if (fill_rect == NULL) {
+        disp_ctx->hw_fill.fill_rect = NULL;
+        return lvgl_port_flush_update(disp_ctx);
+    }
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    /* Only simple transfers of RGB565 areas (SPI/I2C/I8080), the area is filled instead of sending */
+    if (!LVGL_PORT_FLUSH_GENERIC || disp_ctx->disp_type != LVGL_PORT_DISP_TYPE_OTHER || disp_ctx->flags.sw_rotate_stripes || disp_ctx->coalesce_sem || disp_ctx->flush_queue ||
+            disp_ctx->flags.monochrome || lv_display_get_color_format(disp) != LV_COLOR_FORMAT_RGB565) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+
+    disp_ctx->hw_fill.min_pixels = min_pixels;
+    disp_ctx->hw_fill.fill_rect = fill_rect;
+    return lvgl_port_flush_update(disp_ctx);
+}
+
+esp_err_t lvgl_port_disp_set_mirror(lv_display_t *disp, const lvgl_port_disp_mirror_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+
+#if LVGL_PORT_MIRROR
+    if (disp_ctx->mirror.ppa) {
+        ppa_unregister_client(disp_ctx->mirror.ppa);
+    }
+    memset(&disp_ctx->mirror, 0, sizeof(disp_ctx->mirror));
+    if (cfg == NULL) {
+        return lvgl_port_flush_update(disp_ctx);
+    }
+
+    ESP_RETURN_ON_FALSE(cfg->panel_handle && cfg->hres && cfg->vres, ESP_ERR_INVALID_ARG, TAG, "invalid mirror panel");
+    ppa_srm_color_mode_t cm;
+    ESP_RETURN_ON_FALSE(!disp_ctx->flags.monochrome && lvgl_port_ppa_color_mode(lv_display_get_color_format(disp), &cm), ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Color format of the display cannot be mirrored by PPA!");
+    const lv_color_format_t out_cf = (cfg->color_format ? cfg->color_format : lv_display_get_color_format(disp));
+    ESP_RETURN_ON_FALSE(out_cf == LV_COLOR_FORMAT_RGB565 || out_cf == LV_COLOR_FORMAT_RGB888, ESP_ERR_INVALID_ARG, TAG, "Mirror panel must be RGB565 or RGB888!");
+    void *fb = NULL;
+    ESP_RETURN_ON_FALSE(esp_lcd_dpi_panel_get_frame_buffer(cfg->panel_handle, 1, &fb) == ESP_OK && fb, ESP_ERR_INVALID_ARG, TAG,
+                        "Mirror panel must be MIPI-DSI panel with frame buffer!");
+    const ppa_client_config_t ppa_cfg = {
+        .oper_type = PPA_OPERATION_SRM,
+    };
+    ESP_RETURN_ON_ERROR(ppa_register_client(&ppa_cfg, &disp_ctx->mirror.ppa), TAG, "PPA client of mirror register failed");
+
+    disp_ctx->mirror.cfg = *cfg;
+    disp_ctx->mirror.fb = fb;
+    lvgl_port_ppa_color_mode(out_cf, &disp_ctx->mirror.out_cm);
+    disp_ctx->mirror.px_size = lv_color_format_get_size(out_cf);
+    lvgl_port_mirror_update(disp_ctx);
+
+    const esp_err_t ret = lvgl_port_flush_update(disp_ctx);
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    return ret;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t lvgl_port_disp_get_static_size(const lvgl_port_display_cfg_t *disp_cfg, lvgl_port_disp_static_size_t *size)
+{
+    ESP_RETURN_ON_FALSE(disp_cfg && size && disp_cfg->buffer_size > 0, ESP_ERR_INVALID_ARG, TAG, "Invalid arguments!");
+    lvgl_port_disp_static_size(disp_cfg, size);
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_enter_ambient(lv_display_t *disp, const lvgl_port_disp_ambient_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(disp && cfg && cfg->screen, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    ESP_RETURN_ON_FALSE(lv_obj_get_display(cfg->screen) == disp && lv_obj_get_parent(cfg->screen) == NULL, ESP_ERR_INVALID_ARG, TAG, "Ambient screen must be a screen of the display!");
+    ESP_RETURN_ON_FALSE(disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_OTHER, ESP_ERR_NOT_SUPPORTED, TAG, "Ambient mode is only for I2C/SPI/I8080 displays!");
+    ESP_RETURN_ON_FALSE(!disp_ctx->ambient.active, ESP_ERR_INVALID_STATE, TAG, "Display is already in ambient mode!");
+
+    if (cfg->update_period_ms && disp_ctx->ambient.timer == NULL) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = lvgl_port_ambient_timer_cb,
+            .arg = disp,
+            .name = "LVGL ambient",
+        };
+        ESP_RETURN_ON_ERROR(esp_timer_create(&timer_args, &disp_ctx->ambient.timer), TAG, "Creating ambient update timer failed!");
+    }
+
+    disp_ctx->ambient.cfg = *cfg;
+    disp_ctx->ambient.prev_screen = lv_display_get_screen_active(disp);
+    lv_screen_load(cfg->screen);
+    if (cfg->update_cb) {
+        cfg->update_cb(cfg->screen, cfg->user_ctx);
+    }
+    lv_refr_now(disp);
+
+    /* Commands are queued behind the last transfer of the screen */
+    if (cfg->set_partial_area && cfg->partial_lines) {
+        ESP_RETURN_ON_ERROR(cfg->set_partial_area(disp_ctx->panel_handle, cfg->partial_start, cfg->partial_lines), TAG, "Partial mode failed!");
+    }
+    if (cfg->set_idle_mode) {
+        ESP_RETURN_ON_ERROR(cfg->set_idle_mode(disp_ctx->panel_handle, true), TAG, "Idle mode failed!");
+    }
+
+    disp_ctx->ambient.active = true;
+    /* Timers stopped before by the application are not resumed on exit */
+    disp_ctx->ambient.stopped = false;
+    if (!lvgl_port_is_stopped()) {
+        if (lvgl_port_stop() == ESP_OK) {
+            disp_ctx->ambient.stopped = true;
+        } else {
+            ESP_LOGW(TAG, "LVGL timers are not stopped");
+        }
+    }
+    if (cfg->update_period_ms) {
+        esp_timer_start_periodic(disp_ctx->ambient.timer, (uint64_t)cfg->update_period_ms * 1000);
+    }
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_exit_ambient(lv_display_t *disp)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    ESP_RETURN_ON_FALSE(disp_ctx->ambient.active, ESP_ERR_INVALID_STATE, TAG, "Display is not in ambient mode!");
+
+    /* Queued update finds the mode inactive */
+    disp_ctx->ambient.active = false;
+    if (disp_ctx->ambient.timer) {
+        esp_timer_stop(disp_ctx->ambient.timer);
+    }
+
+    const lvgl_port_disp_ambient_cfg_t *cfg = &disp_ctx->ambient.cfg;
+    if (cfg->set_idle_mode) {
+        cfg->set_idle_mode(disp_ctx->panel_handle, false);
+    }
+    if (cfg->set_partial_area && cfg->partial_lines) {
+        cfg->set_partial_area(disp_ctx->panel_handle, 0, 0);
+    }
+
+    if (disp_ctx->ambient.prev_screen && disp_ctx->ambient.prev_screen != cfg->screen) {
+        lv_screen_load(disp_ctx->ambient.prev_screen);
+    }
+    disp_ctx->ambient.prev_screen = NULL;
+    if (disp_ctx->ambient.stopped) {
+        disp_ctx->ambient.stopped = false;
+        lvgl_port_resume();
+    }
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_reconfigure(lv_display_t *disp, const lvgl_port_disp_reconfig_t *cfg)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(disp && cfg && cfg->hres > 0 && cfg->vres > 0, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    ESP_RETURN_ON_FALSE(disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB || disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_OTHER, ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Only RGB and I2C/SPI/I8080 displays can be reconfigured!");
+    ESP_RETURN_ON_FALSE(!cfg->panel_handle || cfg->io_handle || disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB, ESP_ERR_INVALID_ARG, TAG, "Missing panel IO handle!");
+    /* Buffers and tasks sized by the resolution of the display add */
+    ESP_RETURN_ON_FALSE(!disp_ctx->flags.static_mem && !disp_ctx->flags.monochrome && !disp_ctx->flags.sw_rotate && !disp_ctx->convert_sem &&
+                        !disp_ctx->coalesce_sem && !disp_ctx->flush_queue && !disp_ctx->round_x1 && !disp_ctx->pan.fb, ESP_ERR_NOT_SUPPORTED, TAG,
+                        "Static memory, monochrome, SW rotation, panel color format conversion, flush coalescing, flush task, round mask or pan cannot be reconfigured!");
+    ESP_RETURN_ON_FALSE(!disp_ctx->ambient.active, ESP_ERR_INVALID_STATE, TAG, "Display is in ambient mode!");
+
+    /* Transfer in progress reads the draw buffer (I2C/SPI/I8080), RGB areas are copied in the flush */
+    lvgl_port_disp_wait_idle(disp_ctx);
+    lvgl_port_hw_scroll_disable(disp_ctx, false);
+
+    const lv_display_render_mode_t render_mode = (disp_ctx->flags.direct_mode ? LV_DISPLAY_RENDER_MODE_DIRECT :
+            (disp_ctx->flags.full_refresh ? LV_DISPLAY_RENDER_MODE_FULL : LV_DISPLAY_RENDER_MODE_PARTIAL));
+    const esp_lcd_panel_io_handle_t prev_io = disp_ctx->io_handle;
+    const esp_lcd_panel_handle_t prev_panel = disp_ctx->panel_handle;
+    const esp_lcd_panel_handle_t prev_control = disp_ctx->control_handle;
+    /* Avoid tearing renders into the frame buffers of the panel, the other displays into own buffers */
+    const bool own_buffs = (disp_ctx->trans_sem == NULL);
+    void *fbs[3] = {NULL};
+    uint32_t old_size = 0;
+    uint32_t new_size = 0;
+
+    if (own_buffs) {
+        /* Same size of pixel as allocated by lvgl_port_add_disp */
+        const uint32_t buffer_px_size = (lv_display_get_color_format(disp) == LV_COLOR_FORMAT_L8 ? 1 : sizeof(lv_color_t));
+        if (disp_ctx->draw_buff_size) {
+            old_size = disp_ctx->draw_buff_size;
+            new_size = (cfg->buffer_size ? cfg->buffer_size * buffer_px_size : old_size / lv_display_get_physical_horizontal_resolution(disp) * cfg->hres);
+        } else {
+            old_size = lv_display_get_physical_horizontal_resolution(disp) * lv_display_get_physical_vertical_resolution(disp) * buffer_px_size;
+            new_size = cfg->hres * cfg->vres * buffer_px_size;
+        }
+        ESP_RETURN_ON_FALSE(new_size >= cfg->hres * buffer_px_size, ESP_ERR_INVALID_ARG, TAG, "Draw buffer must hold at least one line!");
+
+        /* Growing can fail, the buffers hold at least the previous size then. Shrinking is done after the last step, which can fail. */
+        for (int i = 0; i < 2 && disp_ctx->draw_buffs[i] && new_size > old_size; i++) {
+            void *buf = heap_caps_realloc(disp_ctx->draw_buffs[i], new_size, disp_ctx->draw_buff_caps);
+            ESP_GOTO_ON_FALSE(buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf%d) reallocation!", i + 1);
+            disp_ctx->draw_buffs[i] = buf;
+        }
+    } else {
+#if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        esp_lcd_panel_handle_t panel = (cfg->panel_handle ? cfg->panel_handle : disp_ctx->panel_handle);
+        if (disp_ctx->flags.triple_buffer) {
+            ESP_GOTO_ON_ERROR(esp_lcd_rgb_panel_get_frame_buffer(panel, 3, &fbs[0], &fbs[1], &fbs[2]), err, TAG, "Get RGB buffers failed");
+        } else {
+            ESP_GOTO_ON_ERROR(esp_lcd_rgb_panel_get_frame_buffer(panel, 2, &fbs[1], &fbs[2]), err, TAG, "Get RGB buffers failed");
+        }
+#endif
+    }
+
+    if (cfg->panel_handle) {
+        disp_ctx->io_handle = cfg->io_handle;
+        disp_ctx->panel_handle = cfg->panel_handle;
+        disp_ctx->control_handle = cfg->control_handle;
+        if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB) {
+#if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+            ret = lvgl_port_disp_rgb_register_callbacks(disp_ctx);
+#endif
+        } else {
+#if LVGL_PORT_HANDLE_FLUSH_READY
+            const esp_lcd_panel_io_callbacks_t cbs = {
+                .on_color_trans_done = lvgl_port_flush_io_ready_callback,
+            };
+            ret = esp_lcd_panel_io_register_event_callbacks(disp_ctx->io_handle, &cbs, disp_ctx);
+#endif
+        }
+        if (ret != ESP_OK) {
+            disp_ctx->io_handle = prev_io;
+            disp_ctx->panel_handle = prev_panel;
+            disp_ctx->control_handle = prev_control;
+        }
+        ESP_GOTO_ON_ERROR(ret, err, TAG, "Register callbacks of the new panel failed");
+    }
+
+    /* Layout of all objects is updated and the screens are redrawn by the next refresh */
+    lv_display_set_resolution(disp, cfg->hres, cfg->vres);
+    if (own_buffs) {
+        /* Shrinking in place, a buffer is kept bigger if it fails */
+        for (int i = 0; i < 2 && disp_ctx->draw_buffs[i] && new_size < old_size; i++) {
+            void *buf = heap_caps_realloc(disp_ctx->draw_buffs[i], new_size, disp_ctx->draw_buff_caps);
+            if (buf) {
+                disp_ctx->draw_buffs[i] = buf;
+            }
+        }
+        if (disp_ctx->draw_buff_size) {
+            disp_ctx->draw_buff_size = new_size;
+        }
+        lv_display_set_buffers(disp, disp_ctx->draw_buffs[0], disp_ctx->draw_buffs[1], new_size, render_mode);
+    } else {
+        /* Frame end of the old panel does not come, the new panel shows its first frame buffer */
+        xSemaphoreTake(disp_ctx->trans_sem, 0);
+        disp_ctx->fb_wait_pending = false;
+        const lv_color_format_t cf = lv_display_get_color_format(disp);
+#if LVGL_PORT_TRIPLE_BUFFER
+        if (disp_ctx->flags.triple_buffer) {
+            for (int i = 0; i < 3; i++) {
+                disp_ctx->fbs[i] = fbs[i];
+                lv_area_set(&disp_ctx->fb_missing[i], 0, 0, -1, -1);
+            }
+            disp_ctx->fb_displayed = 0;
+            disp_ctx->fb_pending = -1;
+            lv_area_set(&disp_ctx->frame_dirty, 0, 0, -1, -1);
+            const uint32_t stride = lv_draw_buf_width_to_stride(cfg->hres, cf);
+            lv_draw_buf_init(&disp_ctx->fb_draw_bufs[0], cfg->hres, cfg->vres, cf, stride, fbs[1], stride * cfg->vres);
+            lv_draw_buf_init(&disp_ctx->fb_draw_bufs[1], cfg->hres, cfg->vres, cf, stride, fbs[2], stride * cfg->vres);
+            lv_display_set_draw_buffers(disp, &disp_ctx->fb_draw_bufs[0], &disp_ctx->fb_draw_bufs[1]);
+        } else
+#endif
+        {
+            lv_display_set_buffers(disp, fbs[1], fbs[2], cfg->hres * cfg->vres * lv_color_format_get_size(cf), render_mode);
+        }
+    }
+
+    /* Rotation of the new panel (resolution change calls it only when the size differs) */
+    lvgl_port_disp_rotation_update(disp_ctx);
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+
+err:
+    if (ret != ESP_OK && own_buffs) {
+        /* Resolution is not changed, the buffers are not smaller than before (only grown) and set with the previous size */
+        lv_display_set_buffers(disp, disp_ctx->draw_buffs[0], disp_ctx->draw_buffs[1], old_size, render_mode);
+    }
+    return ret;
+}
+
+esp_err_t lvgl_port_disp_set_panel_color_format(lv_display_t *disp, lv_color_format_t panel_color_format)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    ESP_RETURN_ON_FALSE(panel_color_format == LV_COLOR_FORMAT_RGB565 || panel_color_format == LV_COLOR_FORMAT_RGB888, ESP_ERR_INVALID_ARG, TAG, "Only RGB565 and RGB888 panel color formats are supported!");
+    /* Only displays created with conversion buffers */
+    ESP_RETURN_ON_FALSE(disp_ctx->convert_sem, ESP_ERR_NOT_SUPPORTED, TAG, "Panel color format conversion is not enabled!");
+    ESP_RETURN_ON_FALSE(disp_ctx->convert_lut == NULL || panel_color_format == LV_COLOR_FORMAT_RGB565, ESP_ERR_NOT_SUPPORTED, TAG, "L8 is expanded only to RGB565!");
+
+    /* Whole line must fit in the conversion buffer (allocated for the initial panel color format) */
+    const uint32_t line = LV_MAX(lv_display_get_physical_horizontal_resolution(disp), lv_display_get_physical_vertical_resolution(disp)) * lv_color_format_get_size(panel_color_format);
+    ESP_RETURN_ON_FALSE(disp_ctx->convert_buff_size >= line, ESP_ERR_INVALID_SIZE, TAG, "Conversion buffer is too small for one line!");
+
+    /* Wait for all in-flight converted stripes, next flush sends the new format */
+    xSemaphoreTake(disp_ctx->convert_sem, portMAX_DELAY);
+    xSemaphoreTake(disp_ctx->convert_sem, portMAX_DELAY);
+    disp_ctx->panel_color_format = panel_color_format;
+    xSemaphoreGive(disp_ctx->convert_sem);
+    xSemaphoreGive(disp_ctx->convert_sem);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_set_l8_palette(lv_display_t *disp, const lv_color_t *palette)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    ESP_RETURN_ON_FALSE(disp_ctx->convert_lut, ESP_ERR_NOT_SUPPORTED, TAG, "Display is not rendered in L8!");
+
+    /* Table is read during conversion of the stripes, which are done in flush callback (with LVGL lock) */
+    lvgl_port_disp_fill_lut(disp_ctx, palette);
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_set_draw_buffers(lv_display_t *disp, void *buf1, void *buf2, uint32_t buf_size)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid display");
+    /* Intermediate buffers of rotation, conversion and coalescing are sized by the draw buffers */
+    ESP_RETURN_ON_FALSE(disp_ctx->draw_buff_size && !disp_ctx->draw_buffs[2] && !disp_ctx->rotate_buffs[0] &&
+                        !disp_ctx->convert_sem && !disp_ctx->coalesce_buff_size, ESP_ERR_NOT_SUPPORTED, TAG, "Draw buffers of the display cannot be changed!");
+    ESP_RETURN_ON_FALSE(!buf1 || !disp_ctx->draw_buffs[1] || buf2, ESP_ERR_INVALID_ARG, TAG, "Double buffered display needs two buffers!");
+    if (buf1 == NULL) {
+        buf1 = disp_ctx->draw_buffs[0];
+        buf2 = disp_ctx->draw_buffs[1];
+        buf_size = disp_ctx->draw_buff_size;
+    }
+
+    /* Buffer in flight stays valid (it is owned by the caller), LVGL waits for its flush before rendering */
+    lv_display_set_buffers(disp, buf1, buf2, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    return ESP_OK;
+}
+
+void lvgl_port_disp_set_refr_period(lv_display_t *disp, uint32_t period_ms)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp);
+    lv_timer_t *refr_timer = lv_display_get_refr_timer(disp);
+    if ((disp_ctx && disp_ctx->flags.vsync_pacing) || refr_timer == NULL) {
+        return;
+    }
+
+    /* Own period of the display, limited by the common period */
+    if (disp_ctx && disp_ctx->refr_period_ms > period_ms) {
+        period_ms = disp_ctx->refr_period_ms;
+    }
+
+    lv_timer_set_period(refr_timer, period_ms);
+}
+
+/* Runs in esp_timer task, the update and rendering are done in LVGL task (it handles queued callbacks when stopped too) */
+static void lvgl_port_ambient_timer_cb(void *arg)
+{
+    /* Display is not accessed here, it could be removed meanwhile; a full queue skips this update */
+    lvgl_port_async_call(lvgl_port_ambient_update, arg);
+}
+
+/* Called from LVGL task with LVGL lock */
+static void lvgl_port_ambient_update(void *arg)
+{
+    lv_display_t *disp = (lv_display_t *)arg;
+
+    /* Display could be removed (the queued update is not cancelled) */
+    lv_display_t *d = lv_display_get_next(NULL);
+    while (d && d != disp) {
+        d = lv_display_get_next(d);
+    }
+    lvgl_port_display_ctx_t *disp_ctx = (d ? (lvgl_port_display_ctx_t *)lv_display_get_driver_data(disp) : NULL);
+    if (disp_ctx && disp_ctx->ambient.active) {
+        if (disp_ctx->ambient.cfg.update_cb) {
+            disp_ctx->ambient.cfg.update_cb(disp_ctx->ambient.cfg.screen, disp_ctx->ambient.cfg.user_ctx);
+        }
+        lv_refr_now(disp);
+    }
+}
+
+static void lvgl_port_flush_task(void *arg)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)arg;
+    lvgl_port_flush_job_t job;
+
+    while (xQueueReceive(disp_ctx->flush_queue, &job, portMAX_DELAY) == pdTRUE && job.color_map != NULL) {
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, job.x1, job.y1, job.x2, job.y2, job.color_map);
+    }
+
+    xSemaphoreGive(disp_ctx->flush_task_sem);
+    vTaskDelete(NULL);
+}
+
+static void lvgl_port_flush_wait_callback(lv_display_t *drv)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    assert(disp_ctx != NULL);
+
+    /* Wait for the transfer done callback (it calls flush ready too) */
+    xSemaphoreTake(disp_ctx->flush_done_sem, portMAX_DELAY);
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+    /* Transfer done callback cannot call LVGL */
+    lv_disp_flush_ready(drv);
+#endif
+}
+
+#if CONFIG_LVGL_PORT_CACHE_SAFE
+static void lvgl_port_ready_task(void *arg)
+{
+    lv_display_t *disp = NULL;
+
+    while (xQueueReceive(lvgl_port_ready_ctx.queue, &disp, portMAX_DELAY) == pdTRUE && disp != NULL) {
+        lv_disp_flush_ready(disp);
+    }
+    xSemaphoreGive(lvgl_port_ready_ctx.stopped_sem);
+    vTaskDelete(NULL);
+}
+
+/* Ready task is shared by all displays, it is started with the first one */
+static esp_err_t lvgl_port_ready_task_start(void)
+{
+    esp_err_t ret = ESP_OK;
+
+    if (lvgl_port_ready_ctx.users > 0) {
+        ESP_RETURN_ON_FALSE(lvgl_port_ready_ctx.users < LVGL_PORT_READY_QUEUE_LEN, ESP_ERR_NO_MEM, TAG, "Too many displays for flush ready queue!");
+        lvgl_port_ready_ctx.users++;
+        return ESP_OK;
+    }
+
+    lvgl_port_ready_ctx.queue = xQueueCreate(LVGL_PORT_READY_QUEUE_LEN, sizeof(lv_display_t *));
+    ESP_GOTO_ON_FALSE(lvgl_port_ready_ctx.queue, ESP_ERR_NO_MEM, err, TAG, "Failed to create flush ready queue");
+    lvgl_port_ready_ctx.stopped_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(lvgl_port_ready_ctx.stopped_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create flush ready Semaphore");
+    ESP_GOTO_ON_FALSE(xTaskCreate(lvgl_port_ready_task, "taskLVGLready", LVGL_PORT_READY_TASK_STACK, NULL, LVGL_PORT_READY_TASK_PRIORITY, NULL) == pdPASS,
+                      ESP_ERR_NO_MEM, err, TAG, "Create flush ready task fail!");
+    lvgl_port_ready_ctx.users = 1;
+
+err:
+    if (ret != ESP_OK) {
+        if (lvgl_port_ready_ctx.queue) {
+            vQueueDelete(lvgl_port_ready_ctx.queue);
+            lvgl_port_ready_ctx.queue = NULL;
+        }
+        if (lvgl_port_ready_ctx.stopped_sem) {
+            vSemaphoreDelete(lvgl_port_ready_ctx.stopped_sem);
+            lvgl_port_ready_ctx.stopped_sem = NULL;
+        }
+    }
+    return ret;
+}
+
+static void lvgl_port_ready_task_stop(void)
+{
+    if (lvgl_port_ready_ctx.users == 0 || --lvgl_port_ready_ctx.users > 0) {
+        return;
+    }
+
+    /* Pending flush ready calls are done before the stop */
+    lv_display_t *stop = NULL;
+    xQueueSend(lvgl_port_ready_ctx.queue, &stop, portMAX_DELAY);
+    xSemaphoreTake(lvgl_port_ready_ctx.stopped_sem, portMAX_DELAY);
+    vQueueDelete(lvgl_port_ready_ctx.queue);
+    vSemaphoreDelete(lvgl_port_ready_ctx.stopped_sem);
+    lvgl_port_ready_ctx.queue = NULL;
+    lvgl_port_ready_ctx.stopped_sem = NULL;
+}
+#endif
+
+static void lvgl_port_flush_hw_scroll(lv_display_t *drv, int x1, int y1, int x2, int y2, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    const int top = disp_ctx->hw_scroll.top;
+    const int height = disp_ctx->hw_scroll.height;
+    const int bottom = top + height;
+    const int ring = disp_ctx->hw_scroll.ring;
+    const uint32_t stride = lv_draw_buf_width_to_stride(x2 - x1 + 1, lv_display_get_color_format(drv));
+    struct {
+        int y;      /* First line in the area */
+        int lcd_y;  /* First line in LCD frame memory */
+        int lines;
+    } parts[4];
+    uint8_t cnt = 0;
+
+    /* Lines above/below the scrolling area are sent as they are, lines in it are moved by offset and wrapped around (max. 4 parts) */
+    for (int y = y1; y <= y2; y += parts[cnt++].lines) {
+        parts[cnt].y = y;
+        if (y < top) {
+            parts[cnt].lcd_y = y;
+            parts[cnt].lines = LV_MIN(y2 + 1, top) - y;
+        } else if (y >= bottom) {
+            parts[cnt].lcd_y = y + ring - height;
+            parts[cnt].lines = y2 + 1 - y;
+        } else {
+            const int pos = (y - top + disp_ctx->hw_scroll.offset) % ring;
+            parts[cnt].lcd_y = top + pos;
+            parts[cnt].lines = LV_MIN(LV_MIN(y2 + 1, bottom) - y, ring - pos);
+        }
+    }
+
+    if (disp_ctx->pan.fb) {
+        /* Copied into the virtual frame buffer, the generic flush calls flush ready */
+        for (uint8_t i = 0; i < cnt; i++) {
+            lvgl_port_pan_draw(disp_ctx, x1, parts[i].lcd_y, x2 + 1, parts[i].lcd_y + parts[i].lines, color_map + (parts[i].y - y1) * stride, stride);
+        }
+        return;
+    }
+
+    disp_ctx->flush_parts = cnt;
+    disp_ctx->flush_busy = true;
+    for (uint8_t i = 0; i < cnt; i++) {
+        LVGL_PORT_TRANS_START(disp_ctx);
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, x1, parts[i].lcd_y, x2 + 1, parts[i].lcd_y + parts[i].lines,
+                                  color_map + (parts[i].y - y1) * stride);
+    }
+}
+
+/* Color of the row, false if it is not solid */
+static inline bool lvgl_port_hw_fill_row_color(const uint16_t *px, int32_t w, uint16_t *color)
+{
+    *color = px[0];
+    for (int32_t i = 1; i < w; i++) {
+        if (px[i] != *color) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool lvgl_port_flush_hw_fill(lv_display_t *drv, int x1, int y1, int x2, int y2, const uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    const int32_t w = x2 - x1 + 1;
+    const size_t len = w * (y2 - y1 + 1);
+    if (len < disp_ctx->hw_fill.min_pixels || lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565) != w * sizeof(uint16_t)) {
+        return false;
+    }
+    /* Remapped lines of hardware scroll are not one rectangle */
+    if (disp_ctx->hw_scroll.obj && disp_ctx->hw_scroll.cfg.set_scroll_area && disp_ctx->hw_scroll.offset != 0 &&
+            y2 >= disp_ctx->hw_scroll.top && y1 < disp_ctx->hw_scroll.top + disp_ctx->hw_scroll.height) {
+        return false;
+    }
+
+    /* Bands of solid rows with one color (filled) and of the other rows (sent). Reading the buffer is much faster than
+       sending it, the check of each row stops on its first different pixel. */
+    struct {
+        int32_t y1;
+        int32_t y2;
+        uint16_t color;
+        bool fill;
+    } bands[LVGL_PORT_HW_FILL_MAX_BANDS];
+    const uint16_t *px = (const uint16_t *)color_map;
+    const int32_t min_rows = LV_MAX(1, (int32_t)((disp_ctx->hw_fill.min_pixels + w - 1) / w));
+    int cnt = 0;
+    int fills = 0;
+    uint16_t cur_color;
+    bool cur_solid = lvgl_port_hw_fill_row_color(px, w, &cur_color);
+    int32_t cur_y1 = y1;
+    for (int32_t y = y1 + 1; y <= y2 + 1; y++) {
+        uint16_t color = 0;
+        bool solid = false;
+        if (y <= y2) {
+            solid = lvgl_port_hw_fill_row_color(px + (y - y1) * w, w, &color);
+            if (solid == cur_solid && (!solid || color == cur_color)) {
+                continue;
+            }
+        }
+        /* Band of rows cur_y1 .. y - 1 ended, short solid bands are sent with their neighbours, the last band takes the rest */
+        const bool fill = cur_solid && (y - cur_y1 >= min_rows) && (cnt < LVGL_PORT_HW_FILL_MAX_BANDS - 1);
+        if (cnt > 0 && !fill && !bands[cnt - 1].fill) {
+            bands[cnt - 1].y2 = y - 1;
+        } else {
+            bands[cnt].y1 = cur_y1;
+            bands[cnt].y2 = y - 1;
+            bands[cnt].color = cur_color;
+            bands[cnt].fill = fill;
+            cnt++;
+            fills += fill;
+        }
+        cur_y1 = y;
+        cur_solid = solid;
+        cur_color = color;
+    }
+    /* Round mask sends only the visible spans of the rows, it is used for areas which are not filled whole */
+    if (fills == 0 || (disp_ctx->round_x1 && cnt > 1)) {
+        return false;
+    }
+
+    uint16_t parts = 0;
+    for (int i = 0; i < cnt; i++) {
+        if (bands[i].fill) {
+            /* Bytes could be swapped for LCD, fill is in RGB565 */
+            const uint16_t color = bands[i].color;
+            const uint16_t rgb565 = (disp_ctx->flags.swap_bytes ? (uint16_t)((color >> 8) | (color << 8)) : color);
+            if (disp_ctx->hw_fill.fill_rect(disp_ctx->panel_handle, x1, bands[i].y1, x2 + 1, bands[i].y2 + 1, rgb565) != ESP_OK) {
+                /* Send the pixels instead */
+                bands[i].fill = false;
+            }
+        }
+        parts += !bands[i].fill;
+    }
+    if (parts == 0) {
+        lv_disp_flush_ready(drv);
+        return true;
+    }
+
+    /* Flush ready is called after the last sent band */
+    disp_ctx->flush_parts = parts;
+    disp_ctx->flush_busy = true;
+    for (int i = 0; i < cnt; i++) {
+        if (!bands[i].fill) {
+            LVGL_PORT_TRANS_START(disp_ctx);
+            esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, x1, bands[i].y1, x2 + 1, bands[i].y2 + 1, color_map + (bands[i].y1 - y1) * w * sizeof(uint16_t));
+        }
+    }
+    return true;
+}
+
+static void lvgl_port_hw_scroll_callback(lv_event_t *e)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
+    if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+        lvgl_port_hw_scroll_disable(disp_ctx, true);
+        return;
+    }
+
+    const int32_t top = disp_ctx->hw_scroll.top;
+    const int32_t height = disp_ctx->hw_scroll.height;
+    const int32_t scroll_x = lv_obj_get_scroll_x(disp_ctx->hw_scroll.obj);
+    const int32_t scroll_y = lv_obj_get_scroll_y(disp_ctx->hw_scroll.obj);
+    const int32_t dx = scroll_x - disp_ctx->hw_scroll.scroll_x;
+    const int32_t dy = scroll_y - disp_ctx->hw_scroll.scroll_y;
+    disp_ctx->hw_scroll.scroll_x = scroll_x;
+    disp_ctx->hw_scroll.scroll_y = scroll_y;
+    disp_ctx->hw_scroll.exposed_pending = false;
+    if (dy == 0) {
+        return;
+    }
+    const bool exposed_only = (dx == 0 && !disp_ctx->hw_scroll.dirty && LV_ABS(dy) < height);
+
+    if (disp_ctx->hw_scroll.cfg.set_scroll_area == NULL && disp_ctx->pan.fb == NULL) {
+        /* Block copy in frame memory, only when the exposed lines are redrawn (otherwise the whole area is redrawn) */
+        if (!exposed_only) {
+            return;
+        }
+        const int32_t hres = lv_display_get_horizontal_resolution(disp_ctx->disp_drv);
+        const int32_t src_y = (dy > 0 ? top + dy : top);
+        const int32_t dst_y = (dy > 0 ? top : top - dy);
+        if (disp_ctx->hw_scroll.cfg.copy_rect(disp_ctx->panel_handle, 0, src_y, 0, dst_y, hres, height - LV_ABS(dy)) != ESP_OK) {
+            ESP_LOGE(TAG, "copy rect failed");
+            return;
+        }
+    } else {
+        /* Content moved up by dy, so the lines are shown from dy lines further in frame memory.
+           Panned RGB display shows them from the vsync after the exposed lines are rendered (lvgl_port_pan_refr_callback). */
+        const int32_t ring = disp_ctx->hw_scroll.ring;
+        const int32_t offset = ((disp_ctx->hw_scroll.offset + dy) % ring + ring) % ring;
+        if (disp_ctx->pan.fb == NULL && disp_ctx->hw_scroll.cfg.set_scroll_start(disp_ctx->panel_handle, top + offset) != ESP_OK) {
+            ESP_LOGE(TAG, "set scroll start failed");
+            return;
+        }
+        disp_ctx->hw_scroll.offset = offset;
+    }
+
+    /* Only the exposed lines are redrawn, when the rest of the scrolling area is up to date and moved as a whole */
+    if (exposed_only) {
+        disp_ctx->hw_scroll.exposed.x1 = 0;
+        disp_ctx->hw_scroll.exposed.x2 = lv_display_get_horizontal_resolution(disp_ctx->disp_drv) - 1;
+        disp_ctx->hw_scroll.exposed.y1 = (dy > 0 ? top + height - dy : top);
+        disp_ctx->hw_scroll.exposed.y2 = (dy > 0 ? top + height - 1 : top - dy - 1);
+        disp_ctx->hw_scroll.exposed_pending = true;
+    }
+}
+
+static void lvgl_port_hw_scroll_refr_callback(lv_event_t *e)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
+
+    /* Invalidated areas were redrawn */
+    disp_ctx->hw_scroll.dirty = false;
+    disp_ctx->hw_scroll.exposed_pending = false;
+}
+
+static void lvgl_port_hw_scroll_invalidate(lvgl_port_display_ctx_t *disp_ctx, lv_area_t *area)
+{
+    const int32_t top = disp_ctx->hw_scroll.top;
+    const int32_t bottom = top + disp_ctx->hw_scroll.height - 1;
+    if (area == NULL) {
+        return;
+    }
+
+    /* Invalidation of the scrolled object (the whole scrolling area) right after the scroll */
+    if (disp_ctx->hw_scroll.exposed_pending && area->y1 == top && area->y2 == bottom) {
+        *area = disp_ctx->hw_scroll.exposed;
+        disp_ctx->hw_scroll.exposed_pending = false;
+    }
+
+    /* Invalidated areas in the scrolling area would be moved by the next scroll */
+    if (area->y1 <= bottom && area->y2 >= top) {
+        disp_ctx->hw_scroll.dirty = true;
+    }
+}
+
+static void lvgl_port_hw_scroll_disable(lvgl_port_display_ctx_t *disp_ctx, bool obj_deleted)
+{
+    lv_obj_t *obj = disp_ctx->hw_scroll.obj;
+    if (obj == NULL) {
+        return;
+    }
+
+    disp_ctx->hw_scroll.obj = NULL;
+    lvgl_port_flush_update(disp_ctx);
+    if (!obj_deleted) {
+        lv_obj_remove_event_cb_with_user_data(obj, lvgl_port_hw_scroll_callback, disp_ctx);
+    }
+    lv_display_remove_event_cb_with_user_data(disp_ctx->disp_drv, lvgl_port_hw_scroll_refr_callback, disp_ctx);
+
+    /* Frame memory is shown without scroll, redraw the lines moved by hardware */
+    if (disp_ctx->hw_scroll.cfg.set_scroll_area) {
+        disp_ctx->hw_scroll.cfg.set_scroll_area(disp_ctx->panel_handle, 0, lv_display_get_vertical_resolution(disp_ctx->disp_drv));
+        disp_ctx->hw_scroll.cfg.set_scroll_start(disp_ctx->panel_handle, 0);
+    }
+    /* Lines of panned RGB display return to their place in the virtual frame buffer */
+    if (disp_ctx->hw_scroll.offset != 0 || disp_ctx->pan.fb) {
+        lv_obj_invalidate(lv_display_get_screen_active(disp_ctx->disp_drv));
+    }
+}
+
+/* Copy of the area into the virtual frame buffer of panned RGB display, y is the line of the frame buffer, end is exclusive */
+static void lvgl_port_pan_draw(lvgl_port_display_ctx_t *disp_ctx, int x1, int y1, int x2, int y2, const uint8_t *color_map, uint32_t stride)
+{
+    const uint32_t len = (x2 - x1) * disp_ctx->pan.px_size;
+    uint8_t *dest = disp_ctx->pan.fb + y1 * disp_ctx->pan.stride + x1 * disp_ctx->pan.px_size;
+    for (int y = y1; y < y2; y++) {
+        memcpy(dest, color_map, len);
+        dest += disp_ctx->pan.stride;
+        color_map += stride;
+    }
+}
+
+#if LVGL_PORT_RGB_PAN
+static esp_err_t lvgl_port_pan_init(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_rgb_cfg_t *rgb_cfg)
+{
+    lv_display_t *disp = disp_ctx->disp_drv;
+    const lv_color_format_t cf = lv_display_get_color_format(disp);
+    /* Rendered areas are copied as they are, the panel scans out the virtual frame buffer in its pixel format */
+    ESP_RETURN_ON_FALSE(rgb_cfg->flags.bb_mode && !rgb_cfg->flags.avoid_tearing && !disp_ctx->flags.direct_mode && !disp_ctx->flags.full_refresh,
+                        ESP_ERR_NOT_SUPPORTED, TAG, "Pan needs bounce buffer mode and partial rendering!");
+    ESP_RETURN_ON_FALSE(!disp_ctx->flags.static_mem, ESP_ERR_NOT_SUPPORTED, TAG, "Pan cannot be used with static memory!");
+    ESP_RETURN_ON_FALSE((cf == LV_COLOR_FORMAT_RGB565 || cf == LV_COLOR_FORMAT_RGB888) && !disp_ctx->convert_sem && !disp_ctx->flags.swap_bytes && !disp_ctx->flags.monochrome,
+                        ESP_ERR_NOT_SUPPORTED, TAG, "Pan needs RGB565 or RGB888 rendering without conversion!");
+
+    /* Not rotated yet, the resolution is the panel one */
+    const int32_t hres = lv_display_get_horizontal_resolution(disp);
+    const int32_t vres = lv_display_get_vertical_resolution(disp);
+    const uint32_t lines = (rgb_cfg->virtual_height ? rgb_cfg->virtual_height : (uint32_t)vres);
+    ESP_RETURN_ON_FALSE(lines >= vres, ESP_ERR_INVALID_ARG, TAG, "Virtual frame buffer must not be shorter than the panel!");
+
+    disp_ctx->pan.px_size = lv_color_format_get_size(cf);
+    disp_ctx->pan.stride = hres * disp_ctx->pan.px_size;
+    disp_ctx->pan.fb = heap_caps_calloc(1, lines * disp_ctx->pan.stride, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(disp_ctx->pan.fb, ESP_ERR_NO_MEM, TAG, "Not enough memory for virtual frame buffer!");
+    disp_ctx->pan.lines = lines;
+    disp_ctx->pan.hres = hres;
+    disp_ctx->pan.vres = vres;
+    portMUX_INITIALIZE(&disp_ctx->pan.lock);
+    disp_ctx->pan.next = (lvgl_port_pan_map_t) {
+        .top = 0,
+        .height = vres,
+        .ring = vres,
+        .offset = 0,
+    };
+    disp_ctx->pan.cur = disp_ctx->pan.next;
+
+    lv_display_add_event_cb(disp, lvgl_port_pan_refr_callback, LV_EVENT_REFR_READY, disp_ctx);
+    return lvgl_port_flush_update(disp_ctx);
+}
+
+/* Line of the virtual frame buffer shown on panel line y */
+static inline __attribute__((always_inline)) int32_t lvgl_port_pan_line(const lvgl_port_pan_map_t *map, int32_t y)
+{
+    if (y < map->top) {
+        return y;
+    } else if (y >= map->top + map->height) {
+        return y + map->ring - map->height;
+    }
+    return map->top + (y - map->top + map->offset) % map->ring;
+}
+
+static bool LVGL_PORT_ISR_ATTR lvgl_port_pan_bounce_callback(esp_lcd_panel_handle_t panel, void *bounce_buf, int pos_px, int len_bytes, void *user_ctx)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)user_ctx;
+    const int32_t hres = disp_ctx->pan.hres;
+    const int32_t px_size = disp_ctx->pan.px_size;
+
+    /* The mapping is taken at the start of the frame (vsync), one frame is not scanned with two offsets */
+    if (pos_px == 0) {
+        portENTER_CRITICAL_ISR(&disp_ctx->pan.lock);
+        disp_ctx->pan.cur = disp_ctx->pan.next;
+        portEXIT_CRITICAL_ISR(&disp_ctx->pan.lock);
+    }
+
+    uint8_t *dest = (uint8_t *)bounce_buf;
+    int32_t y = pos_px / hres;
+    int32_t x = pos_px % hres;
+    while (len_bytes > 0) {
+        const int32_t len = LV_MIN(len_bytes, (hres - x) * px_size);
+        const int32_t fb_y = lvgl_port_pan_line(&disp_ctx->pan.cur, y);
+        memcpy(dest, disp_ctx->pan.fb + fb_y * disp_ctx->pan.stride + x * px_size, len);
+        dest += len;
+        len_bytes -= len;
+        y++;
+        x = 0;
+    }
+    return false;
+}
+
+/* Lines rendered in this refresh are scanned out from the next frame */
+static void lvgl_port_pan_refr_callback(lv_event_t *e)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
+    lvgl_port_pan_map_t map = {
+        .top = 0,
+        .height = disp_ctx->pan.vres,
+        .ring = disp_ctx->pan.vres,
+        .offset = 0,
+    };
+    if (disp_ctx->hw_scroll.obj) {
+        map.top = disp_ctx->hw_scroll.top;
+        map.height = disp_ctx->hw_scroll.height;
+        map.ring = disp_ctx->hw_scroll.ring;
+        map.offset = disp_ctx->hw_scroll.offset;
+    }
+
+    portENTER_CRITICAL(&disp_ctx->pan.lock);
+    disp_ctx->pan.next = map;
+    portEXIT_CRITICAL(&disp_ctx->pan.lock);
+}
+#endif
+
+static esp_err_t lvgl_port_round_init(lvgl_port_display_ctx_t *disp_ctx, int32_t size)
+{
+    disp_ctx->round_x1 = malloc(size * sizeof(uint16_t));
+    ESP_RETURN_ON_FALSE(disp_ctx->round_x1, ESP_ERR_NO_MEM, TAG, "Not enough memory for round mask allocation!");
+    disp_ctx->round_size = size;
+
+    /* Pixel is visible, when its center is in the circle inscribed in the display */
+    const float r = size / 2.0f;
+    for (int32_t y = 0; y < size; y++) {
+        const float dy = y + 0.5f - r;
+        if (dy * dy >= r * r) {
+            disp_ctx->round_x1[y] = size;
+            continue;
+        }
+        const int32_t first = (int32_t)ceilf(r - sqrtf(r * r - dy * dy) - 0.5f);
+        disp_ctx->round_x1[y] = LV_MAX(first, 0);
+    }
+    return ESP_OK;
+}
+
+/* Visible span of the row in x1..x2, false if there is none */
+static inline bool lvgl_port_round_span(const lvgl_port_display_ctx_t *disp_ctx, int32_t y, int32_t x1, int32_t x2, int32_t *span_x1, int32_t *span_x2)
+{
+    const int32_t first = disp_ctx->round_x1[y];
+    *span_x1 = LV_MAX(x1, first);
+    *span_x2 = LV_MIN(x2, disp_ctx->round_size - 1 - first);
+    return (*span_x1 <= *span_x2);
+}
+
+static void lvgl_port_round_invalidate(lvgl_port_display_ctx_t *disp_ctx, lv_area_t *area)
+{
+    if (area == NULL) {
+        return;
+    }
+
+    /* Bounding box of the visible part of the area, the corners out of the circle are not rendered */
+    lv_area_t visible = { .x1 = area->x2 + 1, .y1 = -1, .x2 = area->x1 - 1, .y2 = -1 };
+    const int32_t y2 = LV_MIN(area->y2, disp_ctx->round_size - 1);
+    for (int32_t y = LV_MAX(area->y1, 0); y <= y2; y++) {
+        int32_t span_x1, span_x2;
+        if (!lvgl_port_round_span(disp_ctx, y, area->x1, area->x2, &span_x1, &span_x2)) {
+            continue;
+        }
+        if (visible.y1 < 0) {
+            visible.y1 = y;
+        }
+        visible.y2 = y;
+        visible.x1 = LV_MIN(visible.x1, span_x1);
+        visible.x2 = LV_MAX(visible.x2, span_x2);
+    }
+
+    if (visible.y1 < 0) {
+        /* Invalidation cannot be dropped, only one pixel (nearest to the center) is redrawn */
+        const int32_t center = disp_ctx->round_size / 2;
+        area->x1 = area->x2 = LV_CLAMP(area->x1, center, area->x2);
+        area->y1 = area->y2 = LV_CLAMP(area->y1, center, area->y2);
+        return;
+    }
+    *area = visible;
+}
+
+/* Next run of rows from *y, which have visible spans differing at most LVGL_PORT_ROUND_RUN_SLACK_PX, false if there is none */
+static bool lvgl_port_round_next_run(const lvgl_port_display_ctx_t *disp_ctx, int x1, int x2, int y2, int *y, lv_area_t *run)
+{
+    int32_t span_x1, span_x2;
+    while (*y <= y2 && !lvgl_port_round_span(disp_ctx, *y, x1, x2, &span_x1, &span_x2)) {
+        (*y)++;
+    }
+    if (*y > y2) {
+        return false;
+    }
+
+    int32_t min_x1 = span_x1, max_x1 = span_x1, min_x2 = span_x2, max_x2 = span_x2;
+    run->y1 = *y;
+    for ((*y)++; *y <= y2; (*y)++) {
+        if (!lvgl_port_round_span(disp_ctx, *y, x1, x2, &span_x1, &span_x2) ||
+                LV_MAX(max_x1, span_x1) - LV_MIN(min_x1, span_x1) > LVGL_PORT_ROUND_RUN_SLACK_PX ||
+                LV_MAX(max_x2, span_x2) - LV_MIN(min_x2, span_x2) > LVGL_PORT_ROUND_RUN_SLACK_PX) {
+            break;
+        }
+        min_x1 = LV_MIN(min_x1, span_x1);
+        max_x1 = LV_MAX(max_x1, span_x1);
+        min_x2 = LV_MIN(min_x2, span_x2);
+        max_x2 = LV_MAX(max_x2, span_x2);
+    }
+    run->y2 = *y - 1;
+    run->x1 = min_x1;
+    run->x2 = max_x2;
+    return true;
+}
+
+static void lvgl_port_flush_round(lv_display_t *drv, int x1, int y1, int x2, int y2, uint8_t *color_map)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_driver_data(drv);
+    const lv_color_format_t cf = lv_display_get_color_format(drv);
+    const uint32_t px_size = lv_color_format_get_size(cf);
+    const uint32_t stride = lv_draw_buf_width_to_stride(x2 - x1 + 1, cf);
+    lv_area_t run;
+    uint16_t cnt = 0;
+
+    /* Count the runs first, flush ready is called after the last transfer */
+    for (int y = y1; lvgl_port_round_next_run(disp_ctx, x1, x2, y2, &y, &run);) {
+        cnt++;
+    }
+    if (cnt == 0) {
+        lv_disp_flush_ready(drv);
+        return;
+    }
+
+    disp_ctx->flush_parts = cnt;
+    disp_ctx->flush_busy = true;
+    for (int y = y1; lvgl_port_round_next_run(disp_ctx, x1, x2, y2, &y, &run);) {
+        uint8_t *data = color_map + (run.y1 - y1) * stride;
+        const uint32_t len = lv_area_get_width(&run) * px_size;
+        if (len != stride) {
+            /* Visible spans of the run are packed in place, the rows of the next runs are behind them */
+            for (int32_t row = run.y1; row <= run.y2; row++) {
+                memmove(data + (row - run.y1) * len, color_map + (row - y1) * stride + (run.x1 - x1) * px_size, len);
+            }
+        }
+        LVGL_PORT_TRANS_START(disp_ctx);
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, run.x1, run.y1, run.x2 + 1, run.y2 + 1, data);
+    }
+}
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+static esp_err_t lvgl_port_disp_te_init(lvgl_port_display_ctx_t *disp_ctx, int te_gpio_num)
+{
+    disp_ctx->te_sem = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(disp_ctx->te_sem, ESP_ERR_NO_MEM, TAG, "Failed to create TE Semaphore");
+    disp_ctx->te_gpio_num = te_gpio_num;
+
+    /* TE output only in vertical blanking */
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(disp_ctx->io_handle, LCD_CMD_TEON, (uint8_t[]) {
+        0
+    }, 1), TAG, "TE on command fail");
+
+    const gpio_config_t te_conf = {
+        .pin_bit_mask = BIT64(te_gpio_num),
+        .mode = GPIO_MODE_INPUT,
+        .intr_type = GPIO_INTR_POSEDGE,
+    };
+    ESP_RETURN_ON_ERROR(gpio_config(&te_conf), TAG, "TE GPIO config fail");
+    /* ISR service can be installed already (by application or other component) */
+    esp_err_t ret = gpio_install_isr_service(0);
+    ESP_RETURN_ON_FALSE(ret == ESP_OK || ret == ESP_ERR_INVALID_STATE, ret, TAG, "GPIO ISR service install fail");
+    return gpio_isr_handler_add(te_gpio_num, lvgl_port_te_isr, disp_ctx);
+}
+
+static void IRAM_ATTR lvgl_port_te_isr(void *arg)
+{
+    BaseType_t need_yield = pdFALSE;
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)arg;
+
+    xSemaphoreGiveFromISR(disp_ctx->te_sem, &need_yield);
+    /* Start rendering of the requested frame (TE works as vsync) */
+    if (lvgl_port_vsync_pacing(disp_ctx) || need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void lvgl_port_te_render_callback(lv_event_t *e)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_event_get_user_data(e);
+    disp_ctx->te_wait = true;
+}
+#endif
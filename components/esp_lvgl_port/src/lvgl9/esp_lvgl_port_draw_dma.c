@@ -0,0 +1,487 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_idf_version.h"
+#include "esp_attr.h"
+#include "esp_memory_utils.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_lvgl_port_priv.h"
+#include "lvgl.h"
+
+/* DMA draw unit implements LVGL 9.1 draw unit API (same as assembly rendering) */
+#if CONFIG_LVGL_PORT_DRAW_DMA && LV_VERSION_CHECK(9, 1, 0) && !LV_VERSION_CHECK(9, 2, 0)
+
+#include "src/draw/sw/lv_draw_sw.h"
+
+#if CONFIG_SOC_PPA_SUPPORTED && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+#include "driver/ppa.h"
+#define LVGL_PORT_DRAW_DMA_PPA 1
+/* PPA output buffer must be aligned to the (L2) cache line */
+#define LVGL_PORT_DRAW_DMA_ALIGNMENT (128)
+#elif CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+#include "esp_async_memcpy.h"
+#define LVGL_PORT_DRAW_DMA_GDMA 1
+/* GDMA copies whole words from internal memory */
+#define LVGL_PORT_DRAW_DMA_ALIGNMENT (4)
+/* Maximum number of queued row copies */
+#define LVGL_PORT_DRAW_DMA_BACKLOG (16)
+#endif
+
+#endif
+
+#if LVGL_PORT_DRAW_DMA_PPA || LVGL_PORT_DRAW_DMA_GDMA
+
+/* Unique ID of the draw unit (LVGL units use IDs below 10 and 100 for SDL) */
+#define LVGL_PORT_DRAW_DMA_UNIT_ID      (80)
+/* Lower than the score of SW draw unit (100), so SW unit does not take the task */
+#define LVGL_PORT_DRAW_DMA_SCORE        (70)
+/* Worker task renders by CPU the tasks with buffers not usable by DMA (same as LVGL draw threads) */
+#define LVGL_PORT_DRAW_DMA_STACK        (8 * 1024)
+
+static const char *TAG = "LVGL";
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    lv_draw_unit_t          base_unit;      /* LVGL draw unit, must be the first member */
+    lv_draw_task_t *volatile task_act;      /* Task in progress (NULL: the unit is idle) */
+    TaskHandle_t            task;           /* Worker task, waiting for the DMA transfers */
+    volatile bool           exit;           /* The worker task should exit */
+    SemaphoreHandle_t       exit_done;      /* Given by the worker task, when it exits */
+#if LVGL_PORT_DRAW_DMA_PPA
+    ppa_client_handle_t     fill_handle;    /* PPA client for fills */
+    ppa_client_handle_t     srm_handle;     /* PPA client for image copies (scale-rotate-mirror without transformation) */
+#else
+    async_memcpy_handle_t   mcp_handle;     /* GDMA memory copy driver */
+    SemaphoreHandle_t       mcp_done;       /* Given by ISR callback for every finished copy */
+#endif
+} lvgl_port_draw_dma_unit_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static int32_t lvgl_port_draw_dma_evaluate(lv_draw_unit_t *draw_unit, lv_draw_task_t *task);
+static int32_t lvgl_port_draw_dma_dispatch(lv_draw_unit_t *draw_unit, lv_layer_t *layer);
+static int32_t lvgl_port_draw_dma_delete(lv_draw_unit_t *draw_unit);
+static void lvgl_port_draw_dma_task(void *arg);
+static bool lvgl_port_draw_dma_run(lvgl_port_draw_dma_unit_t *u, lv_draw_task_t *t);
+
+/*******************************************************************************
+* Private API functions
+*******************************************************************************/
+
+void lvgl_port_draw_dma_init(void)
+{
+    esp_err_t ret = ESP_OK;
+    lvgl_port_draw_dma_unit_t *u = lv_draw_create_unit(sizeof(lvgl_port_draw_dma_unit_t));
+    ESP_GOTO_ON_FALSE(u, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for DMA draw unit!");
+    u->base_unit.evaluate_cb = lvgl_port_draw_dma_evaluate;
+    u->base_unit.dispatch_cb = lvgl_port_draw_dma_dispatch;
+    u->base_unit.delete_cb = lvgl_port_draw_dma_delete;
+
+#if LVGL_PORT_DRAW_DMA_PPA
+    const ppa_client_config_t fill_cfg = {
+        .oper_type = PPA_OPERATION_FILL,
+    };
+    const ppa_client_config_t srm_cfg = {
+        .oper_type = PPA_OPERATION_SRM,
+    };
+    ESP_GOTO_ON_ERROR(ppa_register_client(&fill_cfg, &u->fill_handle), err, TAG, "PPA fill client register fail!");
+    ESP_GOTO_ON_ERROR(ppa_register_client(&srm_cfg, &u->srm_handle), err, TAG, "PPA SRM client register fail!");
+#else
+    async_memcpy_config_t mcp_cfg = ASYNC_MEMCPY_DEFAULT_CONFIG();
+    mcp_cfg.backlog = LVGL_PORT_DRAW_DMA_BACKLOG;
+    u->mcp_done = xSemaphoreCreateCounting(LVGL_PORT_DRAW_DMA_BACKLOG, 0);
+    ESP_GOTO_ON_FALSE(u->mcp_done, ESP_ERR_NO_MEM, err, TAG, "Create DMA draw semaphore fail!");
+    ESP_GOTO_ON_ERROR(esp_async_memcpy_install(&mcp_cfg, &u->mcp_handle), err, TAG, "Async memcpy install fail!");
+#endif
+    u->exit_done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(u->exit_done, ESP_ERR_NO_MEM, err, TAG, "Create DMA draw semaphore fail!");
+
+    /* Worker task has the same priority as LVGL task (lvgl_port_draw_dma_init is called from LVGL task) */
+    BaseType_t res = xTaskCreate(lvgl_port_draw_dma_task, "taskLVGLDMA", LVGL_PORT_DRAW_DMA_STACK, u, uxTaskPriorityGet(NULL), &u->task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_FAIL, err, TAG, "Create DMA draw task fail!");
+    return;
+
+err:
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "DMA draw unit not used (%s)", esp_err_to_name(ret));
+    }
+    if (u) {
+        /* The unit stays registered in LVGL, but without worker task it never takes any task */
+        lvgl_port_draw_dma_delete(&u->base_unit);
+    }
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Image source of opaque RGB565 copy or NULL, when it is not a simple copy */
+static const lv_image_dsc_t *lvgl_port_draw_dma_get_copy_src(const lv_draw_task_t *t)
+{
+    const lv_draw_image_dsc_t *dsc = t->draw_dsc;
+    if (lv_image_src_get_type(dsc->src) != LV_IMAGE_SRC_VARIABLE) {
+        return NULL;
+    }
+    const lv_image_dsc_t *img = dsc->src;
+    if (img->header.cf != LV_COLOR_FORMAT_RGB565 || (img->header.flags & LV_IMAGE_FLAGS_COMPRESSED) || img->data == NULL) {
+        return NULL;
+    }
+    if (dsc->opa < LV_OPA_MAX || dsc->recolor_opa > LV_OPA_MIN || dsc->blend_mode != LV_BLEND_MODE_NORMAL || dsc->tile || dsc->bitmap_mask_src) {
+        return NULL;
+    }
+    if (dsc->rotation != 0 || dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE || dsc->skew_x != 0 || dsc->skew_y != 0) {
+        return NULL;
+    }
+    /* Image is drawn 1:1 into its area */
+    if (lv_area_get_width(&t->area) != img->header.w || lv_area_get_height(&t->area) != img->header.h) {
+        return NULL;
+    }
+    return img;
+}
+
+static int32_t lvgl_port_draw_dma_evaluate(lv_draw_unit_t *draw_unit, lv_draw_task_t *task)
+{
+    lvgl_port_draw_dma_unit_t *u = (lvgl_port_draw_dma_unit_t *)draw_unit;
+    lv_area_t area;
+    if (u->task == NULL || !_lv_area_intersect(&area, &task->area, &task->clip_area) || lv_area_get_size(&area) < CONFIG_LVGL_PORT_DRAW_DMA_MIN_PX) {
+        return 0;
+    }
+
+    bool supported = false;
+    if (task->type == LV_DRAW_TASK_TYPE_FILL) {
+        const lv_draw_fill_dsc_t *dsc = task->draw_dsc;
+        supported = (dsc->opa >= LV_OPA_MAX && dsc->radius == 0 && dsc->grad.dir == LV_GRAD_DIR_NONE);
+    } else if (task->type == LV_DRAW_TASK_TYPE_IMAGE) {
+        supported = (lvgl_port_draw_dma_get_copy_src(task) != NULL);
+    }
+
+    if (supported && task->preference_score > LVGL_PORT_DRAW_DMA_SCORE) {
+        task->preference_score = LVGL_PORT_DRAW_DMA_SCORE;
+        task->preferred_draw_unit_id = LVGL_PORT_DRAW_DMA_UNIT_ID;
+    }
+    return 0;
+}
+
+static int32_t lvgl_port_draw_dma_dispatch(lv_draw_unit_t *draw_unit, lv_layer_t *layer)
+{
+    lvgl_port_draw_dma_unit_t *u = (lvgl_port_draw_dma_unit_t *)draw_unit;
+
+    /* Busy with the previous task */
+    if (u->task_act) {
+        return 0;
+    }
+
+    /* Tasks without preferred unit are left for SW draw unit */
+    lv_draw_task_t *t = NULL;
+    do {
+        t = lv_draw_get_next_available_task(layer, t, LVGL_PORT_DRAW_DMA_UNIT_ID);
+    } while (t && t->preferred_draw_unit_id != LVGL_PORT_DRAW_DMA_UNIT_ID);
+    if (t == NULL) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+    if (lv_draw_layer_alloc_buf(layer) == NULL) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    u->base_unit.target_layer = layer;
+    u->base_unit.clip_area = &t->clip_area;
+    u->task_act = t;
+    xTaskNotifyGive(u->task);
+    return 1;
+}
+
+static int32_t lvgl_port_draw_dma_delete(lv_draw_unit_t *draw_unit)
+{
+    lvgl_port_draw_dma_unit_t *u = (lvgl_port_draw_dma_unit_t *)draw_unit;
+
+    if (u->task) {
+        u->exit = true;
+        xTaskNotifyGive(u->task);
+        xSemaphoreTake(u->exit_done, portMAX_DELAY);
+        u->task = NULL;
+    }
+    if (u->exit_done) {
+        vSemaphoreDelete(u->exit_done);
+        u->exit_done = NULL;
+    }
+#if LVGL_PORT_DRAW_DMA_PPA
+    if (u->fill_handle) {
+        ppa_unregister_client(u->fill_handle);
+        u->fill_handle = NULL;
+    }
+    if (u->srm_handle) {
+        ppa_unregister_client(u->srm_handle);
+        u->srm_handle = NULL;
+    }
+#else
+    if (u->mcp_handle) {
+        esp_async_memcpy_uninstall(u->mcp_handle);
+        u->mcp_handle = NULL;
+    }
+    if (u->mcp_done) {
+        vSemaphoreDelete(u->mcp_done);
+        u->mcp_done = NULL;
+    }
+#endif
+    return 0;
+}
+
+static void lvgl_port_draw_dma_task(void *arg)
+{
+    lvgl_port_draw_dma_unit_t *u = (lvgl_port_draw_dma_unit_t *)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (u->exit) {
+            break;
+        }
+        lv_draw_task_t *t = u->task_act;
+        if (t == NULL) {
+            continue;
+        }
+
+        /* Buffers not usable by DMA are rendered by CPU in this task, LVGL continues with other tasks meanwhile */
+        if (!lvgl_port_draw_dma_run(u, t)) {
+            if (t->type == LV_DRAW_TASK_TYPE_FILL) {
+                lv_draw_sw_fill(&u->base_unit, t->draw_dsc, &t->area);
+            } else {
+                lv_draw_sw_image(&u->base_unit, t->draw_dsc, &t->area);
+            }
+        }
+
+        t->state = LV_DRAW_TASK_STATE_READY;
+        u->task_act = NULL;
+        lv_draw_dispatch_request();
+    }
+
+    xSemaphoreGive(u->exit_done);
+    vTaskDelete(NULL);
+}
+
+/* True, if the rows [x, x + w) of the buffer part are in DMA accessible memory and the DMA does not share cache lines with other areas */
+static bool lvgl_port_draw_dma_buf_ok(const uint8_t *buf, uint32_t stride, uint32_t x_bytes, uint32_t w_bytes, uint32_t h)
+{
+    const uint32_t align = LVGL_PORT_DRAW_DMA_ALIGNMENT;
+#if LVGL_PORT_DRAW_DMA_PPA
+    if (!esp_ptr_internal(buf) && !esp_ptr_external_ram(buf)) {
+        return false;
+    }
+    /* PPA writes back and invalidates the whole output picture, it must start and end on the cache line */
+    if (((uintptr_t)buf % align) || ((stride * h) % align)) {
+        return false;
+    }
+    /* Contiguous rows or all rows starting and ending on the cache line */
+    return (w_bytes == stride) || ((stride % align) == 0 && (x_bytes % align) == 0 && (w_bytes % align) == 0);
+#else
+    /* GDMA reads and writes internal memory only (no cache) */
+    if (!esp_ptr_dma_capable(buf) || !esp_ptr_dma_capable(buf + stride * (h - 1) + x_bytes + w_bytes - 1)) {
+        return false;
+    }
+    return (((uintptr_t)buf + x_bytes) % align) == 0 && (stride % align) == 0 && (w_bytes % align) == 0;
+#endif
+}
+
+#if LVGL_PORT_DRAW_DMA_GDMA
+static IRAM_ATTR bool lvgl_port_draw_dma_mcp_done(async_memcpy_handle_t mcp_hdl, async_memcpy_event_t *event, void *cb_args)
+{
+    BaseType_t need_yield = pdFALSE;
+    xSemaphoreGiveFromISR((SemaphoreHandle_t)cb_args, &need_yield);
+    return (need_yield == pdTRUE);
+}
+
+/* Queue one copy, when the queue is full, wait for the oldest one */
+static bool lvgl_port_draw_dma_mcp(lvgl_port_draw_dma_unit_t *u, void *dst, const void *src, size_t len, uint32_t *pending)
+{
+    while (esp_async_memcpy(u->mcp_handle, dst, (void *)src, len, lvgl_port_draw_dma_mcp_done, u->mcp_done) != ESP_OK) {
+        if (*pending == 0) {
+            return false;
+        }
+        xSemaphoreTake(u->mcp_done, portMAX_DELAY);
+        (*pending)--;
+    }
+    (*pending)++;
+    return true;
+}
+
+static void lvgl_port_draw_dma_mcp_wait(lvgl_port_draw_dma_unit_t *u, uint32_t *pending)
+{
+    while (*pending) {
+        xSemaphoreTake(u->mcp_done, portMAX_DELAY);
+        (*pending)--;
+    }
+}
+
+/* Copy rows, contiguous rows are copied at once */
+static bool lvgl_port_draw_dma_mcp_rows(lvgl_port_draw_dma_unit_t *u, uint8_t *dst, uint32_t dst_stride, const uint8_t *src, uint32_t src_stride, uint32_t w_bytes, uint32_t h)
+{
+    uint32_t pending = 0;
+    bool ok = true;
+    if (dst_stride == w_bytes && src_stride == w_bytes) {
+        ok = lvgl_port_draw_dma_mcp(u, dst, src, w_bytes * h, &pending);
+        h = 0;
+    }
+    for (uint32_t y = 0; y < h && ok; y++) {
+        ok = lvgl_port_draw_dma_mcp(u, dst + y * dst_stride, src + y * src_stride, w_bytes, &pending);
+    }
+    lvgl_port_draw_dma_mcp_wait(u, &pending);
+    return ok;
+}
+#endif
+
+static bool lvgl_port_draw_dma_run(lvgl_port_draw_dma_unit_t *u, lv_draw_task_t *t)
+{
+    lv_layer_t *layer = u->base_unit.target_layer;
+    lv_draw_buf_t *draw_buf = layer->draw_buf;
+    const lv_color_format_t cf = draw_buf->header.cf;
+    const uint32_t px_size = lv_color_format_get_size(cf);
+    const uint32_t stride = draw_buf->header.stride;
+
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, &t->area, &t->clip_area)) {
+        return true;
+    }
+    const uint32_t w = lv_area_get_width(&area);
+    const uint32_t h = lv_area_get_height(&area);
+    /* Area relative to the layer buffer */
+    const uint32_t x = area.x1 - layer->buf_area.x1;
+    const uint32_t y = area.y1 - layer->buf_area.y1;
+    uint8_t *rows = (uint8_t *)draw_buf->data + y * stride;
+
+    if (!lvgl_port_draw_dma_buf_ok(rows, stride, x * px_size, w * px_size, h)) {
+        return false;
+    }
+
+    if (t->type == LV_DRAW_TASK_TYPE_FILL) {
+        const lv_draw_fill_dsc_t *dsc = t->draw_dsc;
+#if LVGL_PORT_DRAW_DMA_PPA
+        ppa_fill_color_mode_t cm;
+        switch (cf) {
+        case LV_COLOR_FORMAT_RGB565:
+            cm = PPA_FILL_COLOR_MODE_RGB565;
+            break;
+        case LV_COLOR_FORMAT_RGB888:
+            cm = PPA_FILL_COLOR_MODE_RGB888;
+            break;
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_ARGB8888:
+            cm = PPA_FILL_COLOR_MODE_ARGB8888;
+            break;
+        default:
+            return false;
+        }
+        ppa_fill_oper_config_t fill_cfg = {
+            .out = {
+                .buffer = rows,
+                .buffer_size = stride * h,
+                .pic_w = stride / px_size,
+                .pic_h = h,
+                .block_offset_x = x,
+                .block_offset_y = 0,
+                .fill_cm = cm,
+            },
+            .fill_block_w = w,
+            .fill_block_h = h,
+            .mode = PPA_TRANS_MODE_BLOCKING,
+        };
+        fill_cfg.fill_argb_color.val = lv_color_to_u32(dsc->color);
+        return (ppa_do_fill(u->fill_handle, &fill_cfg) == ESP_OK);
+#else
+        /* The first row is filled by CPU, the other rows are copies of it */
+        uint8_t *first = rows + x * px_size;
+        if (cf == LV_COLOR_FORMAT_RGB565) {
+            const uint16_t c16 = lv_color_to_u16(dsc->color);
+            for (uint32_t i = 0; i < w; i++) {
+                ((uint16_t *)first)[i] = c16;
+            }
+        } else if (cf == LV_COLOR_FORMAT_XRGB8888 || cf == LV_COLOR_FORMAT_ARGB8888) {
+            const uint32_t c32 = lv_color_to_u32(dsc->color);
+            for (uint32_t i = 0; i < w; i++) {
+                ((uint32_t *)first)[i] = c32;
+            }
+        } else if (cf == LV_COLOR_FORMAT_RGB888) {
+            for (uint32_t i = 0; i < w; i++) {
+                first[i * 3 + 0] = dsc->color.blue;
+                first[i * 3 + 1] = dsc->color.green;
+                first[i * 3 + 2] = dsc->color.red;
+            }
+        } else {
+            return false;
+        }
+        bool ok = true;
+        uint32_t pending = 0;
+        for (uint32_t i = 1; i < h && ok; i++) {
+            ok = lvgl_port_draw_dma_mcp(u, first + i * stride, first, w * px_size, &pending);
+        }
+        lvgl_port_draw_dma_mcp_wait(u, &pending);
+        return ok;
+#endif
+    }
+
+    /* Opaque RGB565 image copy */
+    const lv_image_dsc_t *img = lvgl_port_draw_dma_get_copy_src(t);
+    if (img == NULL || cf != LV_COLOR_FORMAT_RGB565) {
+        return false;
+    }
+    const uint32_t src_stride = img->header.stride ? img->header.stride : lv_draw_buf_width_to_stride(img->header.w, LV_COLOR_FORMAT_RGB565);
+#if LVGL_PORT_DRAW_DMA_PPA
+    if (!esp_ptr_internal(img->data) && !esp_ptr_external_ram(img->data)) {
+        return false;
+    }
+    ppa_srm_oper_config_t srm_cfg = {
+        .in = {
+            .buffer = img->data,
+            .pic_w = src_stride / px_size,
+            .pic_h = img->header.h,
+            .block_w = w,
+            .block_h = h,
+            .block_offset_x = area.x1 - t->area.x1,
+            .block_offset_y = area.y1 - t->area.y1,
+            .srm_cm = PPA_SRM_COLOR_MODE_RGB565,
+        },
+        .out = {
+            .buffer = rows,
+            .buffer_size = stride * h,
+            .pic_w = stride / px_size,
+            .pic_h = h,
+            .block_offset_x = x,
+            .block_offset_y = 0,
+            .srm_cm = PPA_SRM_COLOR_MODE_RGB565,
+        },
+        .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
+        .scale_x = 1.0,
+        .scale_y = 1.0,
+        .mode = PPA_TRANS_MODE_BLOCKING,
+    };
+    return (ppa_do_scale_rotate_mirror(u->srm_handle, &srm_cfg) == ESP_OK);
+#else
+    const uint8_t *src = img->data + (area.y1 - t->area.y1) * src_stride + (area.x1 - t->area.x1) * px_size;
+    if (!lvgl_port_draw_dma_buf_ok(src, src_stride, 0, w * px_size, h)) {
+        return false;
+    }
+    return lvgl_port_draw_dma_mcp_rows(u, rows + x * px_size, stride, src, src_stride, w * px_size, h);
+#endif
+}
+
+#else
+
+void lvgl_port_draw_dma_init(void)
+{
+    /* DMA draw unit is not supported (disabled, LVGL version or target) */
+}
+
+#endif
@@ -0,0 +1,433 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "lvgl.h"
+
+/* Glyph bitmaps in draw buffers and glyph IDs are from LVGL 9.2 */
+#if LV_VERSION_CHECK(9, 2, 0)
+
+static const char *TAG = "LVGL";
+
+/* Cache size with glyph_cache_size 0 */
+#define LVGL_PORT_GLYPH_CACHE_DEF_SIZE  (64 * 1024)
+/* Part of PSRAM used for glyph cache with glyph_cache_size -1 */
+#define LVGL_PORT_GLYPH_CACHE_PSRAM_DIV (16)
+/* Number of hash buckets (power of 2) */
+#define LVGL_PORT_GLYPH_HASH_SIZE       (256)
+/* Marks glyphs of this cache in lv_font_glyph_dsc_t.entry */
+#define LVGL_PORT_GLYPH_MAGIC           (0x4C504759)
+/* Bitmap data follows the aligned glyph header */
+#define LVGL_PORT_GLYPH_HDR_SIZE        ((sizeof(lvgl_port_glyph_t) + LV_DRAW_BUF_ALIGN - 1) & ~(LV_DRAW_BUF_ALIGN - 1))
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct lvgl_port_glyph_s lvgl_port_glyph_t;
+
+struct lvgl_port_glyph_s {
+    uint32_t            magic;          /* LVGL_PORT_GLYPH_MAGIC */
+    lvgl_port_glyph_t   *hash_next;     /* Next glyph in hash bucket */
+    lvgl_port_glyph_t   *newer;         /* LRU list, towards the most recently used */
+    lvgl_port_glyph_t   *older;         /* LRU list, towards the least recently used */
+    const lv_font_t     *font;          /* Cached font */
+    uint32_t            gid;            /* Glyph index in the source font */
+    size_t              size;           /* Allocated bytes (header and bitmap) */
+    uint32_t            refs;           /* Glyph bitmap is drawn now, it cannot be evicted */
+    lv_draw_buf_t       buf;            /* Glyph bitmap (data after the header) */
+};
+
+typedef struct {
+    int                 cfg_size;       /* Requested cache size (0 default, -1 part of PSRAM) */
+    SemaphoreHandle_t   mux;            /* Draw units render glyphs in parallel */
+    lvgl_port_glyph_t   **hash;         /* Hash buckets by font and glyph index */
+    lvgl_port_glyph_t   *newest;        /* Most recently used glyph */
+    lvgl_port_glyph_t   *oldest;        /* Least recently used glyph, evicted first */
+    lvgl_port_font_cache_stats_t stats;
+} lvgl_port_font_ctx_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static esp_err_t lvgl_port_font_cache_init(void);
+static bool lvgl_port_font_get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *g_dsc, uint32_t letter, uint32_t letter_next);
+static const void *lvgl_port_font_get_glyph_bitmap(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf);
+static void lvgl_port_font_release_glyph(const lv_font_t *font, lv_font_glyph_dsc_t *g_dsc);
+static lvgl_port_glyph_t *lvgl_port_font_glyph_find(const lv_font_t *font, uint32_t gid);
+static lvgl_port_glyph_t *lvgl_port_font_glyph_insert(const lv_font_t *font, uint32_t gid, const lv_draw_buf_t *bitmap);
+static void lvgl_port_font_glyph_delete(lvgl_port_glyph_t *glyph);
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static lvgl_port_font_ctx_t lvgl_port_font_ctx;
+
+/*******************************************************************************
+* Private API functions
+*******************************************************************************/
+
+void lvgl_port_font_config(int cache_size)
+{
+    lvgl_port_font_ctx.cfg_size = cache_size;
+}
+
+void lvgl_port_font_deinit(void)
+{
+    while (lvgl_port_font_ctx.oldest) {
+        lvgl_port_font_glyph_delete(lvgl_port_font_ctx.oldest);
+    }
+    if (lvgl_port_font_ctx.hash) {
+        free(lvgl_port_font_ctx.hash);
+        lvgl_port_font_ctx.hash = NULL;
+    }
+    if (lvgl_port_font_ctx.mux) {
+        vSemaphoreDelete(lvgl_port_font_ctx.mux);
+        lvgl_port_font_ctx.mux = NULL;
+    }
+    memset(&lvgl_port_font_ctx.stats, 0, sizeof(lvgl_port_font_ctx.stats));
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_font_cache_add(const lv_font_t *font, lv_font_t **ret_font)
+{
+    ESP_RETURN_ON_FALSE(font && ret_font && font->get_glyph_dsc && font->get_glyph_bitmap, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    ESP_RETURN_ON_ERROR(lvgl_port_font_cache_init(), TAG, "Glyph cache init fail!");
+
+    lv_font_t *cached = LVGL_PORT_CTX_CALLOC(sizeof(lv_font_t));
+    ESP_RETURN_ON_FALSE(cached, ESP_ERR_NO_MEM, TAG, "Not enough memory for cached font allocation!");
+
+    /* Metrics and fallback of the source font, glyphs through the cache */
+    cached->get_glyph_dsc = lvgl_port_font_get_glyph_dsc;
+    cached->get_glyph_bitmap = lvgl_port_font_get_glyph_bitmap;
+    cached->release_glyph = lvgl_port_font_release_glyph;
+    cached->line_height = font->line_height;
+    cached->base_line = font->base_line;
+    cached->subpx = font->subpx;
+    cached->kerning = font->kerning;
+    cached->underline_position = font->underline_position;
+    cached->underline_thickness = font->underline_thickness;
+    cached->fallback = font->fallback;
+    cached->user_data = font->user_data;
+    cached->dsc = font;
+
+    *ret_font = cached;
+    return ESP_OK;
+}
+
+void lvgl_port_font_cache_remove(lv_font_t *font)
+{
+    if (font == NULL || font->get_glyph_bitmap != lvgl_port_font_get_glyph_bitmap) {
+        return;
+    }
+
+    xSemaphoreTake(lvgl_port_font_ctx.mux, portMAX_DELAY);
+    lvgl_port_glyph_t *glyph = lvgl_port_font_ctx.oldest;
+    while (glyph) {
+        lvgl_port_glyph_t *next = glyph->newer;
+        if (glyph->font == font) {
+            if (glyph->refs) {
+                ESP_LOGW(TAG, "Removed font glyph %"PRIu32" is drawn now", glyph->gid);
+            }
+            lvgl_port_font_glyph_delete(glyph);
+        }
+        glyph = next;
+    }
+    xSemaphoreGive(lvgl_port_font_ctx.mux);
+
+    LVGL_PORT_CTX_FREE(font);
+}
+
+esp_err_t lvgl_port_font_cache_get_stats(lvgl_port_font_cache_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    if (lvgl_port_font_ctx.mux == NULL) {
+        memset(stats, 0, sizeof(lvgl_port_font_cache_stats_t));
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(lvgl_port_font_ctx.mux, portMAX_DELAY);
+    *stats = lvgl_port_font_ctx.stats;
+    if (reset) {
+        lvgl_port_font_ctx.stats.hits = 0;
+        lvgl_port_font_ctx.stats.misses = 0;
+        lvgl_port_font_ctx.stats.evictions = 0;
+        lvgl_port_font_ctx.stats.uncached = 0;
+        lvgl_port_font_ctx.stats.max_used_size = lvgl_port_font_ctx.stats.used_size;
+    }
+    xSemaphoreGive(lvgl_port_font_ctx.mux);
+
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static esp_err_t lvgl_port_font_cache_init(void)
+{
+    if (lvgl_port_font_ctx.mux) {
+        return ESP_OK;
+    }
+
+    size_t size = LVGL_PORT_GLYPH_CACHE_DEF_SIZE;
+    if (lvgl_port_font_ctx.cfg_size > 0) {
+        size = lvgl_port_font_ctx.cfg_size;
+    } else if (lvgl_port_font_ctx.cfg_size < 0 && heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0) {
+        size = heap_caps_get_total_size(MALLOC_CAP_SPIRAM) / LVGL_PORT_GLYPH_CACHE_PSRAM_DIV;
+    }
+
+    lvgl_port_font_ctx.hash = calloc(LVGL_PORT_GLYPH_HASH_SIZE, sizeof(lvgl_port_glyph_t *));
+    ESP_RETURN_ON_FALSE(lvgl_port_font_ctx.hash, ESP_ERR_NO_MEM, TAG, "Not enough memory for glyph cache allocation!");
+    lvgl_port_font_ctx.mux = xSemaphoreCreateMutex();
+    if (lvgl_port_font_ctx.mux == NULL) {
+        free(lvgl_port_font_ctx.hash);
+        lvgl_port_font_ctx.hash = NULL;
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_NO_MEM, TAG, "Create glyph cache mutex fail!");
+    }
+    lvgl_port_font_ctx.stats.cache_size = size;
+    ESP_LOGI(TAG, "Glyph cache %u kB", (unsigned)(size / 1024));
+
+    return ESP_OK;
+}
+
+static inline uint32_t lvgl_port_font_hash(const lv_font_t *font, uint32_t gid)
+{
+    return ((((uint32_t)(uintptr_t)font >> 2) ^ gid) * 2654435761u >> 16) & (LVGL_PORT_GLYPH_HASH_SIZE - 1);
+}
+
+static bool lvgl_port_font_get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *g_dsc, uint32_t letter, uint32_t letter_next)
+{
+    const lv_font_t *src = font->dsc;
+    /* Metrics are not rasterized, resolved_font is set to the cached font by LVGL */
+    return src->get_glyph_dsc(src, g_dsc, letter, letter_next);
+}
+
+static const void *lvgl_port_font_get_glyph_bitmap(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf)
+{
+    const lv_font_t *font = g_dsc->resolved_font;
+    const lv_font_t *src = font->dsc;
+    uint32_t gid = g_dsc->gid.index;
+
+    /* Glyphs not stored in the cache are drawn and released by the source font */
+    g_dsc->resolved_font = src;
+    if (g_dsc->format == LV_FONT_GLYPH_FORMAT_NONE || g_dsc->format > LV_FONT_GLYPH_FORMAT_A8) {
+        return src->get_glyph_bitmap(g_dsc, draw_buf);
+    }
+
+    xSemaphoreTake(lvgl_port_font_ctx.mux, portMAX_DELAY);
+    lvgl_port_glyph_t *glyph = lvgl_port_font_glyph_find(font, gid);
+    if (glyph) {
+        lvgl_port_font_ctx.stats.hits++;
+    } else {
+        lvgl_port_font_ctx.stats.misses++;
+    }
+    xSemaphoreGive(lvgl_port_font_ctx.mux);
+
+    if (glyph == NULL) {
+        /* Rasterized without the lock, other draw units can use the cache meanwhile */
+        const lv_draw_buf_t *bitmap = src->get_glyph_bitmap(g_dsc, draw_buf);
+        if (bitmap == NULL) {
+            return NULL;
+        }
+        glyph = lvgl_port_font_glyph_insert(font, gid, bitmap);
+        if (glyph == NULL) {
+            return bitmap;
+        }
+        if (src->release_glyph) {
+            src->release_glyph(src, g_dsc);
+        }
+    }
+
+    g_dsc->resolved_font = font;
+    g_dsc->entry = (lv_cache_entry_t *)glyph;
+    return &glyph->buf;
+}
+
+static void lvgl_port_font_release_glyph(const lv_font_t *font, lv_font_glyph_dsc_t *g_dsc)
+{
+    lvgl_port_glyph_t *glyph = (lvgl_port_glyph_t *)g_dsc->entry;
+    if (glyph == NULL || glyph->magic != LVGL_PORT_GLYPH_MAGIC) {
+        const lv_font_t *src = font->dsc;
+        if (src->release_glyph) {
+            src->release_glyph(src, g_dsc);
+        }
+        return;
+    }
+
+    xSemaphoreTake(lvgl_port_font_ctx.mux, portMAX_DELAY);
+    assert(glyph->refs > 0);
+    glyph->refs--;
+    xSemaphoreGive(lvgl_port_font_ctx.mux);
+    g_dsc->entry = NULL;
+}
+
+/* Glyph is referenced and moved to the front of LRU list, it is called with the cache lock */
+static lvgl_port_glyph_t *lvgl_port_font_glyph_find(const lv_font_t *font, uint32_t gid)
+{
+    lvgl_port_glyph_t *glyph = lvgl_port_font_ctx.hash[lvgl_port_font_hash(font, gid)];
+    while (glyph && (glyph->font != font || glyph->gid != gid)) {
+        glyph = glyph->hash_next;
+    }
+    if (glyph == NULL) {
+        return NULL;
+    }
+
+    glyph->refs++;
+    if (glyph != lvgl_port_font_ctx.newest) {
+        /* Unlink */
+        glyph->newer->older = glyph->older;
+        if (glyph->older) {
+            glyph->older->newer = glyph->newer;
+        } else {
+            lvgl_port_font_ctx.oldest = glyph->newer;
+        }
+        /* Link as newest */
+        glyph->newer = NULL;
+        glyph->older = lvgl_port_font_ctx.newest;
+        lvgl_port_font_ctx.newest->newer = glyph;
+        lvgl_port_font_ctx.newest = glyph;
+    }
+    return glyph;
+}
+
+static lvgl_port_glyph_t *lvgl_port_font_glyph_insert(const lv_font_t *font, uint32_t gid, const lv_draw_buf_t *bitmap)
+{
+    const size_t data_size = bitmap->header.stride * bitmap->header.h;
+    const size_t size = LVGL_PORT_GLYPH_HDR_SIZE + data_size;
+    lvgl_port_font_cache_stats_t *stats = &lvgl_port_font_ctx.stats;
+
+    xSemaphoreTake(lvgl_port_font_ctx.mux, portMAX_DELAY);
+
+    /* Rendered by another draw unit meanwhile */
+    lvgl_port_glyph_t *glyph = lvgl_port_font_glyph_find(font, gid);
+    if (glyph) {
+        goto end;
+    }
+
+    /* Evict least recently used glyphs, which are not drawn now */
+    lvgl_port_glyph_t *victim = lvgl_port_font_ctx.oldest;
+    while (victim && stats->used_size + size > stats->cache_size) {
+        lvgl_port_glyph_t *next = victim->newer;
+        if (victim->refs == 0) {
+            lvgl_port_font_glyph_delete(victim);
+            stats->evictions++;
+        }
+        victim = next;
+    }
+    if (stats->used_size + size > stats->cache_size) {
+        stats->uncached++;
+        goto end;
+    }
+
+    glyph = heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (glyph == NULL) {
+        glyph = heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, size, MALLOC_CAP_DEFAULT);
+    }
+    if (glyph == NULL) {
+        stats->uncached++;
+        goto end;
+    }
+
+    memset(glyph, 0, sizeof(lvgl_port_glyph_t));
+    uint8_t *data = (uint8_t *)glyph + LVGL_PORT_GLYPH_HDR_SIZE;
+    memcpy(data, bitmap->data, data_size);
+    lv_draw_buf_init(&glyph->buf, bitmap->header.w, bitmap->header.h, bitmap->header.cf, bitmap->header.stride, data, data_size);
+    glyph->magic = LVGL_PORT_GLYPH_MAGIC;
+    glyph->font = font;
+    glyph->gid = gid;
+    glyph->size = size;
+    glyph->refs = 1;
+
+    /* Link as newest */
+    const uint32_t h = lvgl_port_font_hash(font, gid);
+    glyph->hash_next = lvgl_port_font_ctx.hash[h];
+    lvgl_port_font_ctx.hash[h] = glyph;
+    glyph->older = lvgl_port_font_ctx.newest;
+    if (lvgl_port_font_ctx.newest) {
+        lvgl_port_font_ctx.newest->newer = glyph;
+    } else {
+        lvgl_port_font_ctx.oldest = glyph;
+    }
+    lvgl_port_font_ctx.newest = glyph;
+
+    stats->entries++;
+    stats->used_size += size;
+    if (stats->used_size > stats->max_used_size) {
+        stats->max_used_size = stats->used_size;
+    }
+
+end:
+    xSemaphoreGive(lvgl_port_font_ctx.mux);
+    return glyph;
+}
+
+/* It is called with the cache lock */
+static void lvgl_port_font_glyph_delete(lvgl_port_glyph_t *glyph)
+{
+    lvgl_port_glyph_t **link = &lvgl_port_font_ctx.hash[lvgl_port_font_hash(glyph->font, glyph->gid)];
+    while (*link != glyph) {
+        link = &(*link)->hash_next;
+    }
+    *link = glyph->hash_next;
+
+    if (glyph->newer) {
+        glyph->newer->older = glyph->older;
+    } else {
+        lvgl_port_font_ctx.newest = glyph->older;
+    }
+    if (glyph->older) {
+        glyph->older->newer = glyph->newer;
+    } else {
+        lvgl_port_font_ctx.oldest = glyph->newer;
+    }
+
+    lvgl_port_font_ctx.stats.entries--;
+    lvgl_port_font_ctx.stats.used_size -= glyph->size;
+    glyph->magic = 0;
+    heap_caps_free(glyph);
+}
+
+#else
+
+void lvgl_port_font_config(int cache_size)
+{
+}
+
+void lvgl_port_font_deinit(void)
+{
+}
+
+esp_err_t lvgl_port_font_cache_add(const lv_font_t *font, lv_font_t **ret_font)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void lvgl_port_font_cache_remove(lv_font_t *font)
+{
+}
+
+esp_err_t lvgl_port_font_cache_get_stats(lvgl_port_font_cache_stats_t *stats, bool reset)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
@@ -0,0 +1,409 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_err.h"
+#include "esp_check.h"
+#include "lvgl.h"
+#include "esp_lvgl_port_heatmap.h"
+#include "esp_lvgl_port_priv.h"
+
+#if CONFIG_LVGL_PORT_HEATMAP
+
+static const char *TAG = "LVGL";
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    uint32_t invalidations;     /* Count of invalidated areas touching the tile */
+    uint32_t flushed_px;        /* Flushed pixels of the tile */
+} lvgl_port_heatmap_tile_t;
+
+struct lvgl_port_heatmap_s {
+    lv_display_t                *disp;
+    lvgl_port_heatmap_t         *next;
+    int32_t                     hres;           /* Resolution of the tiles (rotated) */
+    int32_t                     vres;
+    uint16_t                    cols;
+    uint16_t                    rows;
+    lvgl_port_heatmap_tile_t    *tiles;
+    lvgl_port_heatmap_frame_t   frame;          /* Totals of the current frame */
+    lvgl_port_heatmap_stats_t   stats;
+    /* Overlay */
+    lv_obj_t                    *overlay;
+    lv_timer_t                  *overlay_timer;
+    bool                        overlay_inv;    /* Invalidation of the overlay in progress */
+    bool                        overlay_frame;  /* Current frame is redrawn for the overlay */
+};
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+/* Heatmaps of all displays, only accessed with LVGL lock */
+static lvgl_port_heatmap_t *lvgl_port_heatmaps = NULL;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void lvgl_port_heatmap_event_callback(lv_event_t *e);
+static void lvgl_port_heatmap_overlay_timer_cb(lv_timer_t *t);
+static void lvgl_port_heatmap_overlay_draw(lv_event_t *e);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+/* Redraws of the tile in tenths (flushed pixels divided by the size of the tile, tiles on the right and bottom edge can be smaller) */
+static uint32_t lvgl_port_heatmap_redraws10(const lvgl_port_heatmap_t *hm, uint32_t i)
+{
+    const int32_t w = LV_MIN(CONFIG_LVGL_PORT_HEATMAP_TILE, hm->hres - (int32_t)(i % hm->cols) * CONFIG_LVGL_PORT_HEATMAP_TILE);
+    const int32_t h = LV_MIN(CONFIG_LVGL_PORT_HEATMAP_TILE, hm->vres - (int32_t)(i / hm->cols) * CONFIG_LVGL_PORT_HEATMAP_TILE);
+    return (uint32_t)((uint64_t)hm->tiles[i].flushed_px * 10 / (w * h));
+}
+
+static lvgl_port_heatmap_t *lvgl_port_heatmap_find(lv_display_t *disp)
+{
+    for (lvgl_port_heatmap_t *hm = lvgl_port_heatmaps; hm; hm = hm->next) {
+        if (hm->disp == disp) {
+            return hm;
+        }
+    }
+    return NULL;
+}
+
+esp_err_t lvgl_port_heatmap_get_stats(lv_display_t *disp, lvgl_port_heatmap_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(disp && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_heatmap_t *hm = lvgl_port_heatmap_find(disp);
+    ESP_RETURN_ON_FALSE(hm, ESP_ERR_NOT_FOUND, TAG, "display without heatmap");
+
+    *stats = hm->stats;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_heatmap_dump(lv_display_t *disp, FILE *out)
+{
+    ESP_RETURN_ON_FALSE(disp && out, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_heatmap_t *hm = lvgl_port_heatmap_find(disp);
+    ESP_RETURN_ON_FALSE(hm, ESP_ERR_NOT_FOUND, TAG, "display without heatmap");
+    const lvgl_port_heatmap_stats_t *s = &hm->stats;
+
+    fprintf(out, "heatmap %"PRId32"x%"PRId32", tiles %ux%u of %u px, frames %"PRIu32" (skipped %"PRIu32"), flushed %"PRIu64" px\n",
+            hm->hres, hm->vres, s->cols, s->rows, s->tile_size, s->frames, s->skipped, s->flushed_px);
+    fprintf(out, "last frame: invalidations %"PRIu32" (%"PRIu32" px), flushes %"PRIu32" (%"PRIu32" px)\n",
+            s->last.invalidations, s->last.invalidated_px, s->last.flushes, s->last.flushed_px);
+    fprintf(out, "max in frame: invalidations %"PRIu32" (%"PRIu32" px), flushes %"PRIu32" (%"PRIu32" px)\n",
+            s->max.invalidations, s->max.invalidated_px, s->max.flushes, s->max.flushed_px);
+
+    fprintf(out, "invalidations per tile:\n");
+    for (int r = 0; r < hm->rows; r++) {
+        for (int c = 0; c < hm->cols; c++) {
+            fprintf(out, "%6"PRIu32, hm->tiles[r * hm->cols + c].invalidations);
+        }
+        fprintf(out, "\n");
+    }
+    fprintf(out, "redraws per tile:\n");
+    for (int r = 0; r < hm->rows; r++) {
+        for (int c = 0; c < hm->cols; c++) {
+            const uint32_t redraws10 = lvgl_port_heatmap_redraws10(hm, r * hm->cols + c);
+            fprintf(out, "%4"PRIu32".%"PRIu32, redraws10 / 10, redraws10 % 10);
+        }
+        fprintf(out, "\n");
+    }
+    fflush(out);
+
+    return ESP_OK;
+}
+
+static void lvgl_port_heatmap_clear(lvgl_port_heatmap_t *hm)
+{
+    if (hm->tiles) {
+        memset(hm->tiles, 0, sizeof(lvgl_port_heatmap_tile_t) * hm->cols * hm->rows);
+    }
+    memset(&hm->frame, 0, sizeof(hm->frame));
+    memset(&hm->stats, 0, sizeof(hm->stats));
+    hm->stats.tile_size = CONFIG_LVGL_PORT_HEATMAP_TILE;
+    hm->stats.cols = hm->cols;
+    hm->stats.rows = hm->rows;
+}
+
+esp_err_t lvgl_port_heatmap_reset(lv_display_t *disp)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_heatmap_t *hm = lvgl_port_heatmap_find(disp);
+    ESP_RETURN_ON_FALSE(hm, ESP_ERR_NOT_FOUND, TAG, "display without heatmap");
+
+    lvgl_port_heatmap_clear(hm);
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_heatmap_show_overlay(lv_display_t *disp, bool show)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_heatmap_t *hm = lvgl_port_heatmap_find(disp);
+    ESP_RETURN_ON_FALSE(hm, ESP_ERR_NOT_FOUND, TAG, "display without heatmap");
+    if ((hm->overlay != NULL) == show) {
+        return ESP_OK;
+    }
+
+    /* Invalidations of the overlay are not counted and the next frame is skipped */
+    hm->overlay_inv = true;
+    hm->overlay_frame = true;
+    if (show) {
+        hm->overlay = lv_obj_create(lv_display_get_layer_sys(disp));
+        ESP_GOTO_ON_FALSE(hm->overlay, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for heatmap overlay");
+        lv_obj_remove_style_all(hm->overlay);
+        lv_obj_set_size(hm->overlay, LV_PCT(100), LV_PCT(100));
+        lv_obj_remove_flag(hm->overlay, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_event_cb(hm->overlay, lvgl_port_heatmap_overlay_draw, LV_EVENT_DRAW_MAIN, hm);
+        hm->overlay_timer = lv_timer_create(lvgl_port_heatmap_overlay_timer_cb, CONFIG_LVGL_PORT_HEATMAP_OVERLAY_PERIOD_MS, hm);
+        ESP_GOTO_ON_FALSE(hm->overlay_timer, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for heatmap overlay timer");
+        lv_obj_invalidate(hm->overlay);
+    } else {
+        lv_timer_delete(hm->overlay_timer);
+        hm->overlay_timer = NULL;
+        lv_obj_delete(hm->overlay);
+        hm->overlay = NULL;
+    }
+
+err:
+    if (ret != ESP_OK && hm->overlay) {
+        lv_obj_delete(hm->overlay);
+        hm->overlay = NULL;
+    }
+    hm->overlay_inv = false;
+    return ret;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Tiles follow the resolution of the rotated display, they are cleared after change of it */
+static void lvgl_port_heatmap_resize(lvgl_port_heatmap_t *hm)
+{
+    const int32_t hres = lv_display_get_horizontal_resolution(hm->disp);
+    const int32_t vres = lv_display_get_vertical_resolution(hm->disp);
+    const uint16_t cols = (hres + CONFIG_LVGL_PORT_HEATMAP_TILE - 1) / CONFIG_LVGL_PORT_HEATMAP_TILE;
+    const uint16_t rows = (vres + CONFIG_LVGL_PORT_HEATMAP_TILE - 1) / CONFIG_LVGL_PORT_HEATMAP_TILE;
+
+    if (hm->tiles == NULL || cols * rows != hm->cols * hm->rows) {
+        free(hm->tiles);
+        hm->tiles = calloc(cols * rows, sizeof(lvgl_port_heatmap_tile_t));
+        if (hm->tiles == NULL) {
+            ESP_LOGE(TAG, "Not enough memory for heatmap tiles");
+        }
+    }
+    hm->hres = hres;
+    hm->vres = vres;
+    hm->cols = (hm->tiles ? cols : 0);
+    hm->rows = (hm->tiles ? rows : 0);
+    lvgl_port_heatmap_clear(hm);
+}
+
+lvgl_port_heatmap_t *lvgl_port_heatmap_create(lv_display_t *disp)
+{
+    lvgl_port_heatmap_t *hm = calloc(1, sizeof(lvgl_port_heatmap_t));
+    if (hm == NULL) {
+        return NULL;
+    }
+    hm->disp = disp;
+    lvgl_port_heatmap_resize(hm);
+    if (hm->tiles == NULL) {
+        free(hm);
+        return NULL;
+    }
+
+    lv_display_add_event_cb(disp, lvgl_port_heatmap_event_callback, LV_EVENT_INVALIDATE_AREA, hm);
+    lv_display_add_event_cb(disp, lvgl_port_heatmap_event_callback, LV_EVENT_RENDER_READY, hm);
+    lv_display_add_event_cb(disp, lvgl_port_heatmap_event_callback, LV_EVENT_RESOLUTION_CHANGED, hm);
+
+    hm->next = lvgl_port_heatmaps;
+    lvgl_port_heatmaps = hm;
+    return hm;
+}
+
+void lvgl_port_heatmap_delete(lvgl_port_heatmap_t *hm)
+{
+    if (hm == NULL) {
+        return;
+    }
+
+    for (lvgl_port_heatmap_t **p = &lvgl_port_heatmaps; *p; p = &(*p)->next) {
+        if (*p == hm) {
+            *p = hm->next;
+            break;
+        }
+    }
+    /* The overlay is deleted with its display */
+    if (hm->overlay_timer) {
+        lv_timer_delete(hm->overlay_timer);
+    }
+    free(hm->tiles);
+    free(hm);
+}
+
+/* Clip the area to the tiles, returns false outside of them */
+static bool lvgl_port_heatmap_clip(const lvgl_port_heatmap_t *hm, const lv_area_t *area, lv_area_t *clipped)
+{
+    clipped->x1 = LV_MAX(area->x1, 0);
+    clipped->y1 = LV_MAX(area->y1, 0);
+    clipped->x2 = LV_MIN(area->x2, hm->hres - 1);
+    clipped->y2 = LV_MIN(area->y2, hm->vres - 1);
+    return (hm->tiles && clipped->x1 <= clipped->x2 && clipped->y1 <= clipped->y2);
+}
+
+void lvgl_port_heatmap_flush(lvgl_port_heatmap_t *hm, const lv_area_t *area)
+{
+    lv_area_t a;
+    if (hm->overlay_frame || !lvgl_port_heatmap_clip(hm, area, &a)) {
+        return;
+    }
+
+    hm->frame.flushes++;
+    hm->frame.flushed_px += lv_area_get_size(&a);
+    for (int32_t ty = a.y1 / CONFIG_LVGL_PORT_HEATMAP_TILE; ty <= a.y2 / CONFIG_LVGL_PORT_HEATMAP_TILE; ty++) {
+        const int32_t ty1 = ty * CONFIG_LVGL_PORT_HEATMAP_TILE;
+        const int32_t h = LV_MIN(a.y2, ty1 + CONFIG_LVGL_PORT_HEATMAP_TILE - 1) - LV_MAX(a.y1, ty1) + 1;
+        for (int32_t tx = a.x1 / CONFIG_LVGL_PORT_HEATMAP_TILE; tx <= a.x2 / CONFIG_LVGL_PORT_HEATMAP_TILE; tx++) {
+            const int32_t tx1 = tx * CONFIG_LVGL_PORT_HEATMAP_TILE;
+            const int32_t w = LV_MIN(a.x2, tx1 + CONFIG_LVGL_PORT_HEATMAP_TILE - 1) - LV_MAX(a.x1, tx1) + 1;
+            hm->tiles[ty * hm->cols + tx].flushed_px += w * h;
+        }
+    }
+}
+
+static void lvgl_port_heatmap_invalidate(lvgl_port_heatmap_t *hm, const lv_area_t *area)
+{
+    lv_area_t a;
+    if (hm->overlay_inv || area == NULL || !lvgl_port_heatmap_clip(hm, area, &a)) {
+        return;
+    }
+
+    hm->frame.invalidations++;
+    hm->frame.invalidated_px += lv_area_get_size(&a);
+    for (int32_t ty = a.y1 / CONFIG_LVGL_PORT_HEATMAP_TILE; ty <= a.y2 / CONFIG_LVGL_PORT_HEATMAP_TILE; ty++) {
+        for (int32_t tx = a.x1 / CONFIG_LVGL_PORT_HEATMAP_TILE; tx <= a.x2 / CONFIG_LVGL_PORT_HEATMAP_TILE; tx++) {
+            hm->tiles[ty * hm->cols + tx].invalidations++;
+        }
+    }
+}
+
+static void lvgl_port_heatmap_render_ready(lvgl_port_heatmap_t *hm)
+{
+    lvgl_port_heatmap_stats_t *s = &hm->stats;
+
+    if (hm->overlay_frame) {
+        hm->overlay_frame = false;
+        s->skipped++;
+    } else {
+        s->frames++;
+        s->last = hm->frame;
+        s->max.invalidations = LV_MAX(s->max.invalidations, hm->frame.invalidations);
+        s->max.invalidated_px = LV_MAX(s->max.invalidated_px, hm->frame.invalidated_px);
+        s->max.flushes = LV_MAX(s->max.flushes, hm->frame.flushes);
+        s->max.flushed_px = LV_MAX(s->max.flushed_px, hm->frame.flushed_px);
+        s->flushed_px += hm->frame.flushed_px;
+    }
+    memset(&hm->frame, 0, sizeof(hm->frame));
+}
+
+static void lvgl_port_heatmap_event_callback(lv_event_t *e)
+{
+    lvgl_port_heatmap_t *hm = (lvgl_port_heatmap_t *)lv_event_get_user_data(e);
+    assert(hm != NULL);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_INVALIDATE_AREA:
+        lvgl_port_heatmap_invalidate(hm, (const lv_area_t *)lv_event_get_param(e));
+        break;
+    case LV_EVENT_RENDER_READY:
+        lvgl_port_heatmap_render_ready(hm);
+        break;
+    case LV_EVENT_RESOLUTION_CHANGED:
+        lvgl_port_heatmap_resize(hm);
+        break;
+    default:
+        break;
+    }
+}
+
+static void lvgl_port_heatmap_overlay_timer_cb(lv_timer_t *t)
+{
+    lvgl_port_heatmap_t *hm = (lvgl_port_heatmap_t *)lv_timer_get_user_data(t);
+
+    /* Redraw of the overlay is not counted */
+    hm->overlay_inv = true;
+    lv_obj_invalidate(hm->overlay);
+    hm->overlay_inv = false;
+    hm->overlay_frame = true;
+}
+
+static void lvgl_port_heatmap_overlay_draw(lv_event_t *e)
+{
+    lvgl_port_heatmap_t *hm = (lvgl_port_heatmap_t *)lv_event_get_user_data(e);
+    lv_layer_t *layer = lv_event_get_layer(e);
+    const uint32_t n = hm->cols * hm->rows;
+    uint32_t max = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        max = LV_MAX(max, lvgl_port_heatmap_redraws10(hm, i));
+    }
+    if (max == 0) {
+        return;
+    }
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_opa = LV_OPA_50;
+    for (uint32_t i = 0; i < n; i++) {
+        const uint32_t redraws10 = lvgl_port_heatmap_redraws10(hm, i);
+        if (redraws10 == 0) {
+            continue;
+        }
+        /* Hue from blue (least redrawn) to red (most redrawn) */
+        const uint16_t hue = 240 - (uint16_t)(redraws10 * 240 / max);
+        dsc.bg_color = lv_color_hsv_to_rgb(hue, 100, 100);
+        const lv_area_t tile = {
+            .x1 = (i % hm->cols) * CONFIG_LVGL_PORT_HEATMAP_TILE,
+            .y1 = (i / hm->cols) * CONFIG_LVGL_PORT_HEATMAP_TILE,
+            .x2 = (i % hm->cols) * CONFIG_LVGL_PORT_HEATMAP_TILE + CONFIG_LVGL_PORT_HEATMAP_TILE - 1,
+            .y2 = (i / hm->cols) * CONFIG_LVGL_PORT_HEATMAP_TILE + CONFIG_LVGL_PORT_HEATMAP_TILE - 1,
+        };
+        lv_draw_rect(layer, &dsc, &tile);
+    }
+}
+
+#else
+
+esp_err_t lvgl_port_heatmap_get_stats(lv_display_t *disp, lvgl_port_heatmap_stats_t *stats)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_heatmap_dump(lv_display_t *disp, FILE *out)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_heatmap_reset(lv_display_t *disp)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_heatmap_show_overlay(lv_display_t *disp, bool show)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
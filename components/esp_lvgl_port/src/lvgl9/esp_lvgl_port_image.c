@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "lvgl.h"
+
+/* Image cache resizing and decoder arguments are from LVGL 9.1 */
+#if LV_VERSION_CHECK(9, 1, 0)
+
+static const char *TAG = "LVGL";
+
+/* Part of PSRAM used for image cache with image_cache_size -1 */
+#define LVGL_PORT_IMAGE_CACHE_PSRAM_DIV (8)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct lvgl_port_image_pin_s {
+    lv_image_decoder_dsc_t dsc;     /* Open decoder keeps the cache entry referenced */
+};
+
+typedef struct {
+    int             cache_size;     /* Requested cache size (0 default, -1 part of PSRAM) */
+    int             affinity;       /* Core of prefetch task (-1 is no affinity) */
+    QueueHandle_t   queue;          /* Queue of image sources to prefetch */
+    TaskHandle_t    task;           /* Prefetch task */
+} lvgl_port_image_ctx_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void lvgl_port_image_task(void *arg);
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static lvgl_port_image_ctx_t lvgl_port_image_ctx = {
+    .affinity = -1,
+};
+
+/*******************************************************************************
+* Private API functions
+*******************************************************************************/
+
+void lvgl_port_image_config(int cache_size, int lvgl_task_affinity)
+{
+    lvgl_port_image_ctx.cache_size = cache_size;
+    /* Decode on the other core, when LVGL task is pinned */
+    lvgl_port_image_ctx.affinity = (lvgl_task_affinity >= 0 && configNUM_CORES > 1) ? (lvgl_task_affinity == 0 ? 1 : 0) : -1;
+}
+
+void lvgl_port_image_cache_init(void)
+{
+    uint32_t size = 0;
+    if (lvgl_port_image_ctx.cache_size > 0) {
+        size = lvgl_port_image_ctx.cache_size;
+    } else if (lvgl_port_image_ctx.cache_size < 0) {
+        size = heap_caps_get_total_size(MALLOC_CAP_SPIRAM) / LVGL_PORT_IMAGE_CACHE_PSRAM_DIV;
+    }
+    if (size > 0) {
+        lv_image_cache_resize(size, false);
+        ESP_LOGI(TAG, "Image cache %"PRIu32" kB", size / 1024);
+    }
+}
+
+void lvgl_port_image_deinit(void)
+{
+    if (lvgl_port_image_ctx.task) {
+        /* The task does not hold LVGL lock, while it is deleted */
+        lvgl_port_lock(0);
+        vTaskDelete(lvgl_port_image_ctx.task);
+        lvgl_port_image_ctx.task = NULL;
+        lvgl_port_unlock();
+    }
+    if (lvgl_port_image_ctx.queue) {
+        vQueueDelete(lvgl_port_image_ctx.queue);
+        lvgl_port_image_ctx.queue = NULL;
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_image_prefetch(const void *const *srcs, size_t count)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(srcs, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    /* Prefetch task is created with the first request */
+    lvgl_port_lock(0);
+    if (lvgl_port_image_ctx.queue == NULL) {
+        lvgl_port_image_ctx.queue = xQueueCreate(CONFIG_LVGL_PORT_IMAGE_PREFETCH_QUEUE_LEN, sizeof(const void *));
+        ESP_GOTO_ON_FALSE(lvgl_port_image_ctx.queue, ESP_ERR_NO_MEM, err, TAG, "Create image prefetch queue fail!");
+    }
+    if (lvgl_port_image_ctx.task == NULL) {
+        BaseType_t res;
+        if (lvgl_port_image_ctx.affinity < 0) {
+            res = xTaskCreate(lvgl_port_image_task, "LVGL prefetch", CONFIG_LVGL_PORT_IMAGE_PREFETCH_TASK_STACK, NULL, tskIDLE_PRIORITY + 1, &lvgl_port_image_ctx.task);
+        } else {
+            res = xTaskCreatePinnedToCore(lvgl_port_image_task, "LVGL prefetch", CONFIG_LVGL_PORT_IMAGE_PREFETCH_TASK_STACK, NULL, tskIDLE_PRIORITY + 1, &lvgl_port_image_ctx.task, lvgl_port_image_ctx.affinity);
+        }
+        ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create image prefetch task fail!");
+    }
+    lvgl_port_unlock();
+
+    for (size_t i = 0; i < count; i++) {
+        ESP_RETURN_ON_FALSE(xQueueSend(lvgl_port_image_ctx.queue, &srcs[i], 0) == pdTRUE, ESP_ERR_TIMEOUT, TAG, "Image prefetch queue full");
+    }
+    return ESP_OK;
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_image_pin(const void *src, lvgl_port_image_pin_handle_t *ret_pin)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(src && ret_pin, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    lvgl_port_lock(0);
+    lvgl_port_image_pin_handle_t pin = LVGL_PORT_CTX_CALLOC(sizeof(struct lvgl_port_image_pin_s));
+    ESP_GOTO_ON_FALSE(pin, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for pinned image allocation!");
+    if (lv_image_decoder_open(&pin->dsc, src, NULL) != LV_RESULT_OK) {
+        LVGL_PORT_CTX_FREE(pin);
+        ESP_GOTO_ON_FALSE(false, ESP_FAIL, err, TAG, "Image decoding failed");
+    }
+    *ret_pin = pin;
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+void lvgl_port_image_unpin(lvgl_port_image_pin_handle_t pin)
+{
+    if (pin == NULL) {
+        return;
+    }
+    lvgl_port_lock(0);
+    lv_image_decoder_close(&pin->dsc);
+    LVGL_PORT_CTX_FREE(pin);
+    lvgl_port_unlock();
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void lvgl_port_image_task(void *arg)
+{
+    const void *src = NULL;
+    while (1) {
+        xQueueReceive(lvgl_port_image_ctx.queue, &src, portMAX_DELAY);
+        /* Decoded image is added to the cache and it stays there after close */
+        lvgl_port_lock(0);
+        lv_image_decoder_dsc_t dsc;
+        if (lv_image_decoder_open(&dsc, src, NULL) == LV_RESULT_OK) {
+            lv_image_decoder_close(&dsc);
+        } else {
+            ESP_LOGW(TAG, "Image prefetch failed");
+        }
+        lvgl_port_unlock();
+    }
+}
+
+#else
+
+void lvgl_port_image_config(int cache_size, int lvgl_task_affinity)
+{
+}
+
+void lvgl_port_image_cache_init(void)
+{
+}
+
+void lvgl_port_image_deinit(void)
+{
+}
+
+esp_err_t lvgl_port_image_prefetch(const void *const *srcs, size_t count)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_image_pin(const void *src, lvgl_port_image_pin_handle_t *ret_pin)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void lvgl_port_image_unpin(lvgl_port_image_pin_handle_t pin)
+{
+}
+
+#endif
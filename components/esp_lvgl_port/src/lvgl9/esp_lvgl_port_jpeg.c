@@ -0,0 +1,425 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <strings.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_idf_version.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "soc/soc_caps.h"
+#include "esp_lvgl_port_jpeg.h"
+#include "lvgl.h"
+
+/* LVGL_PORT_HW_JPEG is defined by CMake, when esp_driver_jpeg is in the build. Draw buffer handlers are from LVGL 9.2. */
+#if LVGL_PORT_HW_JPEG && SOC_JPEG_DECODE_SUPPORTED && (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)) && LV_VERSION_CHECK(9, 2, 0)
+#define LVGL_PORT_JPEG  1
+#include "driver/jpeg_decode.h"
+#endif
+
+static const char *TAG = "LVGL";
+
+#if LVGL_PORT_JPEG
+
+#define LVGL_PORT_JPEG_TIMEOUT_MS   (1000)
+/* Limit of markers before the frame header (APPn, DQT, DHT, ...) */
+#define LVGL_PORT_JPEG_MAX_SEGMENTS (64)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    uint16_t    width;
+    uint16_t    height;
+    uint8_t     mcu_w;          /* MCU size in pixels, the decoder writes whole MCUs */
+    uint8_t     mcu_h;
+} lvgl_port_jpeg_info_t;
+
+typedef struct {
+    lv_image_decoder_t      *decoder;
+    jpeg_decoder_handle_t   engine;
+    SemaphoreHandle_t       mutex;      /* Decoding from more LVGL draw threads */
+    uint8_t                 *in_buf;    /* Cache aligned input buffer, it grows with the largest image */
+    size_t                  in_buf_size;
+    lv_draw_buf_handlers_t  handlers;   /* Default handlers with cache aligned DMA allocation */
+    portMUX_TYPE            stats_lock;
+    lvgl_port_jpeg_stats_t  stats;
+    uint64_t                total_us;
+} lvgl_port_jpeg_ctx_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static lv_result_t lvgl_port_jpeg_info(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc, lv_image_header_t *header);
+static lv_result_t lvgl_port_jpeg_open(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc);
+static void lvgl_port_jpeg_close(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc);
+static void *lvgl_port_jpeg_buf_malloc(size_t size, lv_color_format_t color_format);
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static lvgl_port_jpeg_ctx_t lvgl_port_jpeg_ctx = {
+    .stats_lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_jpeg_decoder_init(void)
+{
+    esp_err_t ret = ESP_OK;
+    lvgl_port_jpeg_ctx_t *ctx = &lvgl_port_jpeg_ctx;
+    ESP_RETURN_ON_FALSE(ctx->decoder == NULL, ESP_ERR_INVALID_STATE, TAG, "JPEG decoder already registered");
+
+    const jpeg_decode_engine_cfg_t engine_cfg = {
+        .timeout_ms = LVGL_PORT_JPEG_TIMEOUT_MS,
+    };
+    ESP_RETURN_ON_ERROR(jpeg_new_decoder_engine(&engine_cfg, &ctx->engine), TAG, "JPEG decoder engine init failed");
+    ctx->mutex = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(ctx->mutex, ESP_ERR_NO_MEM, err, TAG, "Create JPEG decoder mutex fail!");
+
+    /* Newest decoder is tried first */
+    ctx->decoder = lv_image_decoder_create();
+    ESP_GOTO_ON_FALSE(ctx->decoder, ESP_ERR_NO_MEM, err, TAG, "Create LVGL image decoder fail!");
+    lv_image_decoder_set_info_cb(ctx->decoder, lvgl_port_jpeg_info);
+    lv_image_decoder_set_open_cb(ctx->decoder, lvgl_port_jpeg_open);
+    lv_image_decoder_set_close_cb(ctx->decoder, lvgl_port_jpeg_close);
+    ctx->decoder->name = "JPEG_HW";
+
+    ctx->handlers = *lv_draw_buf_get_handlers();
+    ctx->handlers.buf_malloc_cb = lvgl_port_jpeg_buf_malloc;
+    ctx->handlers.buf_free_cb = free;
+
+    return ESP_OK;
+
+err:
+    if (ctx->mutex) {
+        vSemaphoreDelete(ctx->mutex);
+        ctx->mutex = NULL;
+    }
+    jpeg_del_decoder_engine(ctx->engine);
+    ctx->engine = NULL;
+    return ret;
+}
+
+esp_err_t lvgl_port_jpeg_decoder_deinit(void)
+{
+    lvgl_port_jpeg_ctx_t *ctx = &lvgl_port_jpeg_ctx;
+    ESP_RETURN_ON_FALSE(ctx->decoder, ESP_ERR_INVALID_STATE, TAG, "JPEG decoder not registered");
+
+    /* Cached images are freed by handlers of their draw buffers, the decoder must not be referenced */
+    lv_image_cache_drop(NULL);
+    lv_image_decoder_delete(ctx->decoder);
+    ctx->decoder = NULL;
+
+    jpeg_del_decoder_engine(ctx->engine);
+    ctx->engine = NULL;
+    vSemaphoreDelete(ctx->mutex);
+    ctx->mutex = NULL;
+    free(ctx->in_buf);
+    ctx->in_buf = NULL;
+    ctx->in_buf_size = 0;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_jpeg_decoder_get_stats(lvgl_port_jpeg_stats_t *stats, bool reset)
+{
+    lvgl_port_jpeg_ctx_t *ctx = &lvgl_port_jpeg_ctx;
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    portENTER_CRITICAL(&ctx->stats_lock);
+    *stats = ctx->stats;
+    stats->avg_decode_us = (ctx->stats.decoded ? (uint32_t)(ctx->total_us / ctx->stats.decoded) : 0);
+    if (reset) {
+        memset(&ctx->stats, 0, sizeof(ctx->stats));
+        ctx->total_us = 0;
+    }
+    portEXIT_CRITICAL(&ctx->stats_lock);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void *lvgl_port_jpeg_buf_malloc(size_t size, lv_color_format_t color_format)
+{
+    const jpeg_decode_memory_alloc_cfg_t mem_cfg = {
+        .buffer_direction = JPEG_DEC_ALLOC_OUTPUT_BUFFER,
+    };
+    size_t allocated = 0;
+    return jpeg_alloc_decoder_mem(size, &mem_cfg, &allocated);
+}
+
+static bool lvgl_port_jpeg_read(lv_image_decoder_dsc_t *dsc, uint32_t offset, void *buf, uint32_t len)
+{
+    if (dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t *img_dsc = dsc->src;
+        if (offset + len > img_dsc->data_size) {
+            return false;
+        }
+        memcpy(buf, img_dsc->data + offset, len);
+        return true;
+    }
+
+    uint32_t rn = 0;
+    return (lv_fs_seek(&dsc->file, offset, LV_FS_SEEK_SET) == LV_FS_RES_OK &&
+            lv_fs_read(&dsc->file, buf, len, &rn) == LV_FS_RES_OK && rn == len);
+}
+
+/* Walk the markers to the frame header, only baseline images with subsampling supported by hardware are accepted */
+static lv_result_t lvgl_port_jpeg_parse(lv_image_decoder_dsc_t *dsc, lvgl_port_jpeg_info_t *info, bool *supported)
+{
+    uint8_t buf[9];
+    uint32_t offset = 2;
+
+    *supported = false;
+    if (!lvgl_port_jpeg_read(dsc, 0, buf, 2) || buf[0] != 0xFF || buf[1] != 0xD8) {
+        return LV_RESULT_INVALID;
+    }
+
+    for (int i = 0; i < LVGL_PORT_JPEG_MAX_SEGMENTS; i++) {
+        if (!lvgl_port_jpeg_read(dsc, offset, buf, 4) || buf[0] != 0xFF) {
+            return LV_RESULT_INVALID;
+        }
+        const uint8_t marker = buf[1];
+        if (marker == 0xFF) {
+            /* Fill byte */
+            offset++;
+            continue;
+        }
+        if (marker == 0xDA || marker == 0xD9) {
+            /* Scan or end without frame header */
+            return LV_RESULT_INVALID;
+        }
+        const bool sof = (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC);
+        if (sof) {
+            /* Precision, height, width, components, then ID, sampling factors and table of each component */
+            if (!lvgl_port_jpeg_read(dsc, offset + 4, buf, 6)) {
+                return LV_RESULT_INVALID;
+            }
+            info->height = (buf[1] << 8) | buf[2];
+            info->width = (buf[3] << 8) | buf[4];
+            if ((marker != 0xC0 && marker != 0xC1) || buf[0] != 8 || buf[5] != 3 || info->width == 0 || info->height == 0) {
+                return LV_RESULT_OK;
+            }
+            if (!lvgl_port_jpeg_read(dsc, offset + 4 + 6, buf, 9)) {
+                return LV_RESULT_INVALID;
+            }
+            /* Chroma components are not subsampled, luma sampling factors select the MCU */
+            const uint8_t y_sampling = buf[1];
+            if (buf[4] != 0x11 || buf[7] != 0x11) {
+                return LV_RESULT_OK;
+            }
+            switch (y_sampling) {
+            case 0x11: /* 4:4:4 */
+                info->mcu_w = 8;
+                info->mcu_h = 8;
+                break;
+            case 0x21: /* 4:2:2 */
+                info->mcu_w = 16;
+                info->mcu_h = 8;
+                break;
+            case 0x22: /* 4:2:0 */
+                info->mcu_w = 16;
+                info->mcu_h = 16;
+                break;
+            default:
+                return LV_RESULT_OK;
+            }
+            *supported = true;
+            return LV_RESULT_OK;
+        }
+        offset += 2 + ((buf[2] << 8) | buf[3]);
+    }
+    return LV_RESULT_INVALID;
+}
+
+static bool lvgl_port_jpeg_is_source(lv_image_decoder_dsc_t *dsc)
+{
+    if (dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t *img_dsc = dsc->src;
+        return (img_dsc->data_size > 2 && img_dsc->data[0] == 0xFF && img_dsc->data[1] == 0xD8);
+    }
+    if (dsc->src_type == LV_IMAGE_SRC_FILE) {
+        const char *ext = lv_fs_get_ext(dsc->src);
+        return (strcasecmp(ext, "jpg") == 0 || strcasecmp(ext, "jpeg") == 0);
+    }
+    return false;
+}
+
+static uint32_t lvgl_port_jpeg_stride(uint32_t width, uint8_t mcu_w)
+{
+    return LV_ALIGN_UP(width, mcu_w) * lv_color_format_get_size(LV_COLOR_FORMAT_NATIVE);
+}
+
+static lv_result_t lvgl_port_jpeg_info(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc, lv_image_header_t *header)
+{
+    lvgl_port_jpeg_info_t info;
+    bool supported = false;
+
+    if (!lvgl_port_jpeg_is_source(dsc)) {
+        return LV_RESULT_INVALID;
+    }
+    const lv_result_t res = lvgl_port_jpeg_parse(dsc, &info, &supported);
+    if (dsc->src_type == LV_IMAGE_SRC_FILE) {
+        lv_fs_seek(&dsc->file, 0, LV_FS_SEEK_SET);
+    }
+    if (res != LV_RESULT_OK) {
+        return LV_RESULT_INVALID;
+    }
+    if (!supported) {
+        /* Software decoder is tried next */
+        portENTER_CRITICAL(&lvgl_port_jpeg_ctx.stats_lock);
+        lvgl_port_jpeg_ctx.stats.fallbacks++;
+        portEXIT_CRITICAL(&lvgl_port_jpeg_ctx.stats_lock);
+        return LV_RESULT_INVALID;
+    }
+
+    header->cf = LV_COLOR_FORMAT_NATIVE;
+    header->w = info.width;
+    header->h = info.height;
+    header->stride = lvgl_port_jpeg_stride(info.width, info.mcu_w);
+    return LV_RESULT_OK;
+}
+
+/* Read the whole stream into the input buffer (called with mutex) */
+static uint32_t lvgl_port_jpeg_load(lvgl_port_jpeg_ctx_t *ctx, lv_image_decoder_dsc_t *dsc)
+{
+    uint32_t size = 0;
+    if (dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        size = ((const lv_image_dsc_t *)dsc->src)->data_size;
+    } else if (lv_fs_seek(&dsc->file, 0, LV_FS_SEEK_END) != LV_FS_RES_OK || lv_fs_tell(&dsc->file, &size) != LV_FS_RES_OK) {
+        return 0;
+    }
+
+    if (size > ctx->in_buf_size) {
+        const jpeg_decode_memory_alloc_cfg_t mem_cfg = {
+            .buffer_direction = JPEG_DEC_ALLOC_INPUT_BUFFER,
+        };
+        free(ctx->in_buf);
+        ctx->in_buf_size = 0;
+        ctx->in_buf = jpeg_alloc_decoder_mem(size, &mem_cfg, &ctx->in_buf_size);
+        if (ctx->in_buf == NULL) {
+            ESP_LOGE(TAG, "Not enough memory for JPEG input buffer (%u bytes)!", (unsigned)size);
+            ctx->in_buf_size = 0;
+            return 0;
+        }
+    }
+    return (lvgl_port_jpeg_read(dsc, 0, ctx->in_buf, size) ? size : 0);
+}
+
+static lv_result_t lvgl_port_jpeg_open(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    lvgl_port_jpeg_ctx_t *ctx = &lvgl_port_jpeg_ctx;
+    lvgl_port_jpeg_info_t info;
+    bool supported = false;
+
+    if (lvgl_port_jpeg_parse(dsc, &info, &supported) != LV_RESULT_OK || !supported) {
+        return LV_RESULT_INVALID;
+    }
+
+    const int64_t start = esp_timer_get_time();
+    /* Whole MCUs are written, the padding is below and right of the image */
+    const uint32_t stride = lvgl_port_jpeg_stride(info.width, info.mcu_w);
+    lv_draw_buf_t *decoded = lv_draw_buf_create_ex(&ctx->handlers, info.width, LV_ALIGN_UP(info.height, info.mcu_h),
+                             LV_COLOR_FORMAT_NATIVE, stride);
+    if (decoded == NULL) {
+        ESP_LOGE(TAG, "Not enough memory for decoded JPEG %ux%u!", info.width, info.height);
+        goto err;
+    }
+
+    const jpeg_decode_cfg_t decode_cfg = {
+#if LV_COLOR_DEPTH == 16
+        .output_format = JPEG_DECODE_OUT_FORMAT_RGB565,
+#else
+        .output_format = JPEG_DECODE_OUT_FORMAT_RGB888,
+#endif
+        .rgb_order = JPEG_DEC_RGB_ELEMENT_ORDER_BGR,
+        .conv_std = JPEG_YUV_RGB_CONV_STD_BT601,
+    };
+    uint32_t out_size = 0;
+    esp_err_t err = ESP_FAIL;
+    xSemaphoreTake(ctx->mutex, portMAX_DELAY);
+    const uint32_t in_size = lvgl_port_jpeg_load(ctx, dsc);
+    if (in_size > 0) {
+        err = jpeg_decoder_process(ctx->engine, &decode_cfg, ctx->in_buf, in_size, decoded->data, decoded->data_size, &out_size);
+    }
+    xSemaphoreGive(ctx->mutex);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "JPEG decoding failed (%s)", esp_err_to_name(err));
+        lv_draw_buf_destroy(decoded);
+        goto err;
+    }
+    /* Padding rows are not drawn, the buffer size is kept */
+    decoded->header.h = info.height;
+
+    const uint32_t time_us = (uint32_t)(esp_timer_get_time() - start);
+    portENTER_CRITICAL(&ctx->stats_lock);
+    ctx->stats.decoded++;
+    ctx->total_us += time_us;
+    ctx->stats.max_decode_us = LV_MAX(ctx->stats.max_decode_us, time_us);
+    portEXIT_CRITICAL(&ctx->stats_lock);
+
+    dsc->decoded = decoded;
+    if (dsc->args.no_cache || !lv_image_cache_is_enabled()) {
+        return LV_RESULT_OK;
+    }
+
+    lv_image_cache_data_t search_key = {
+        .src_type = dsc->src_type,
+        .src = dsc->src,
+        .slot.size = decoded->data_size,
+    };
+    lv_cache_entry_t *entry = lv_image_decoder_add_to_cache(decoder, &search_key, decoded, NULL);
+    if (entry == NULL) {
+        lv_draw_buf_destroy(decoded);
+        dsc->decoded = NULL;
+        return LV_RESULT_INVALID;
+    }
+    dsc->cache_entry = entry;
+    return LV_RESULT_OK;
+
+err:
+    portENTER_CRITICAL(&ctx->stats_lock);
+    ctx->stats.errors++;
+    portEXIT_CRITICAL(&ctx->stats_lock);
+    return LV_RESULT_INVALID;
+}
+
+static void lvgl_port_jpeg_close(lv_image_decoder_t *decoder, lv_image_decoder_dsc_t *dsc)
+{
+    /* Cached images are freed on eviction */
+    if (dsc->args.no_cache || !lv_image_cache_is_enabled()) {
+        lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+    }
+}
+
+#else
+
+esp_err_t lvgl_port_jpeg_decoder_init(void)
+{
+    ESP_LOGW(TAG, "Hardware JPEG decoder is not supported");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_jpeg_decoder_deinit(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_jpeg_decoder_get_stats(lvgl_port_jpeg_stats_t *stats, bool reset)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
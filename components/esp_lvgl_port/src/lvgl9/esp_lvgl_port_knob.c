@@ -7,6 +7,7 @@
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_check.h"
+#include "esp_timer.h"
 #include "esp_lvgl_port.h"
 
 static const char *TAG = "LVGL";
@@ -20,6 +21,12 @@ typedef struct {
     button_handle_t btn_handle;     /* Encoder button handlers */
     lv_indev_t      *indev;         /* LVGL input device driver */
     bool btn_enter;                 /* Encoder button enter state */
+    portMUX_TYPE    lock;           /* Lock of the accumulated steps */
+    int32_t         diff;           /* Steps accumulated between LVGL reads */
+    int8_t          last_dir;       /* Direction of the last detent */
+    int64_t         last_time;      /* Time of the last detent [us] */
+    uint32_t        accel_speed_us; /* Detents closer than this interval are accelerated (0: disabled) */
+    uint8_t         accel_max_gain; /* Maximal steps of one detent */
 } lvgl_port_encoder_ctx_t;
 
 /*******************************************************************************
@@ -43,7 +50,7 @@ lv_indev_t *lvgl_port_add_encoder(const lvgl_port_encoder_cfg_t *encoder_cfg)
     assert(encoder_cfg->disp != NULL);
 
     /* Encoder context */
-    lvgl_port_encoder_ctx_t *encoder_ctx = malloc(sizeof(lvgl_port_encoder_ctx_t));
+    lvgl_port_encoder_ctx_t *encoder_ctx = calloc(1, sizeof(lvgl_port_encoder_ctx_t));
     if (encoder_ctx == NULL) {
         ESP_LOGE(TAG, "Not enough memory for encoder context allocation!");
         return NULL;
@@ -68,6 +75,9 @@ lv_indev_t *lvgl_port_add_encoder(const lvgl_port_encoder_cfg_t *encoder_cfg)
     ESP_ERROR_CHECK(iot_button_register_cb(encoder_ctx->btn_handle, BUTTON_PRESS_UP, lvgl_port_encoder_btn_up_handler, encoder_ctx));
 
     encoder_ctx->btn_enter = false;
+    portMUX_INITIALIZE(&encoder_ctx->lock);
+    encoder_ctx->accel_speed_us = encoder_cfg->accel.speed_ms * 1000;
+    encoder_ctx->accel_max_gain = (encoder_cfg->accel.max_gain > 1 ? encoder_cfg->accel.max_gain : 1);
 
     lvgl_port_lock(0);
     /* Register a encoder input device */
@@ -130,20 +140,24 @@ esp_err_t lvgl_port_remove_encoder(lv_indev_t *encoder)
 
 static void lvgl_port_encoder_read(lv_indev_t *indev_drv, lv_indev_data_t *data)
 {
-    static int32_t last_v = 0;
     assert(indev_drv);
     lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *)lv_indev_get_driver_data(indev_drv);
     assert(ctx);
 
-    int32_t invd = iot_knob_get_count_value(ctx->knob_handle);
-    knob_event_t event = iot_knob_get_event(ctx->knob_handle);
-
-    if (last_v ^ invd) {
-        last_v = invd;
-        data->enc_diff = (KNOB_LEFT == event) ? (-1) : ((KNOB_RIGHT == event) ? (1) : (0));
-    } else {
-        data->enc_diff = 0;
+    /* All the steps since the last read are reported at once */
+    portENTER_CRITICAL(&ctx->lock);
+    int32_t diff = ctx->diff;
+    if (diff > INT16_MAX) {
+        diff = INT16_MAX;
+    } else if (diff < INT16_MIN) {
+        diff = INT16_MIN;
     }
+    ctx->diff -= diff;
+    portEXIT_CRITICAL(&ctx->lock);
+
+    data->enc_diff = diff;
+    /* Rest of the steps (out of enc_diff range) in the next read */
+    data->continue_reading = (ctx->diff != 0);
     data->state = (true == ctx->btn_enter) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
 }
 
@@ -180,6 +194,34 @@ static void lvgl_port_encoder_btn_up_handler(void *arg, void *arg2)
 static void lvgl_port_encoder_knob_handler(void *arg, void *arg2)
 {
     lvgl_port_encoder_ctx_t *ctx = (lvgl_port_encoder_ctx_t *) arg2;
+    knob_handle_t knob = (knob_handle_t)arg;
+    assert(ctx);
+
+    knob_event_t event = iot_knob_get_event(knob);
+    int8_t dir = (KNOB_LEFT == event) ? (-1) : ((KNOB_RIGHT == event) ? (1) : (0));
+    if (dir == 0) {
+        return;
+    }
+
+    /* Acceleration: gain grows linearly with speed of the detents in the same direction */
+    int32_t steps = 1;
+    int64_t now = esp_timer_get_time();
+    if (ctx->accel_speed_us && dir == ctx->last_dir) {
+        int64_t dt = now - ctx->last_time;
+        if (dt > 0 && dt < ctx->accel_speed_us) {
+            steps = ctx->accel_speed_us / dt;
+            if (steps > ctx->accel_max_gain) {
+                steps = ctx->accel_max_gain;
+            }
+        }
+    }
+    ctx->last_dir = dir;
+    ctx->last_time = now;
+
+    portENTER_CRITICAL(&ctx->lock);
+    ctx->diff += dir * steps;
+    portEXIT_CRITICAL(&ctx->lock);
+
     /* Wake LVGL task, if needed */
     lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, ctx->indev);
 }
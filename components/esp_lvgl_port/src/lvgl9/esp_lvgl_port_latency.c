@@ -0,0 +1,281 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "lvgl.h"
+#include "esp_lvgl_port_latency.h"
+#include "esp_lvgl_port_priv.h"
+
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+
+static const char *TAG = "LVGL";
+
+/* Touch event not finished in this time is dropped by the next one */
+#define LVGL_PORT_LATENCY_TIMEOUT_US    (1000 * 1000)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef enum {
+    LATENCY_STATE_IDLE,         /* Waiting for touch */
+    LATENCY_STATE_IRQ,          /* Touch interrupt came, waiting for LVGL read */
+    LATENCY_STATE_READ,         /* Read by LVGL, waiting for invalidation */
+    LATENCY_STATE_INVALIDATED,  /* Waiting for rendering */
+    LATENCY_STATE_RENDERING,    /* Waiting for end of rendering */
+    LATENCY_STATE_TRANSFER,     /* Waiting for end of transfer */
+} lvgl_port_latency_state_t;
+
+/* Timestamps of the followed touch event */
+typedef enum {
+    LATENCY_TS_IRQ,
+    LATENCY_TS_READ,
+    LATENCY_TS_INVALIDATE,
+    LATENCY_TS_RENDER_START,
+    LATENCY_TS_RENDER_READY,
+    LATENCY_TS_DONE,
+    LATENCY_TS_MAX,
+} lvgl_port_latency_ts_t;
+
+typedef struct {
+    portMUX_TYPE                lock;
+    lvgl_port_latency_state_t   state;
+    lv_display_t                *disp;          /* Display of the touch */
+    int64_t                     ts[LATENCY_TS_MAX];
+    lvgl_port_latency_done_t    done_mode;      /* End of transfer of the rendered frame */
+    uint32_t                    trans_target;   /* Transfer count of the display at the end of rendering */
+    /* Last LVGL read, the change of it starts the measure without interrupt */
+    lv_indev_state_t            last_state;
+    lv_point_t                  last_point;
+    /* Ring of the last measured events */
+    uint32_t                    measured;
+    uint32_t                    dropped;
+    uint32_t                    samples[LVGL_PORT_LATENCY_STAGES][CONFIG_LVGL_PORT_LATENCY_SAMPLES];
+} lvgl_port_latency_ctx_t;
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static lvgl_port_latency_ctx_t lvgl_port_latency_ctx = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+static int lvgl_port_latency_cmp(const void *a, const void *b)
+{
+    const uint32_t va = *(const uint32_t *)a;
+    const uint32_t vb = *(const uint32_t *)b;
+    return (va > vb) - (va < vb);
+}
+
+esp_err_t lvgl_port_get_latency_stats(lvgl_port_latency_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_latency_ctx_t *ctx = &lvgl_port_latency_ctx;
+
+    /* Samples are sorted in a copy, the ring is written from interrupts */
+    uint32_t *sorted = malloc(sizeof(ctx->samples));
+    ESP_RETURN_ON_FALSE(sorted, ESP_ERR_NO_MEM, TAG, "Not enough memory for latency samples");
+
+    memset(stats, 0, sizeof(lvgl_port_latency_stats_t));
+    portENTER_CRITICAL(&ctx->lock);
+    stats->measured = ctx->measured;
+    stats->dropped = ctx->dropped;
+    memcpy(sorted, ctx->samples, sizeof(ctx->samples));
+    if (reset) {
+        ctx->measured = 0;
+        ctx->dropped = 0;
+    }
+    portEXIT_CRITICAL(&ctx->lock);
+
+    const uint32_t n = LV_MIN(stats->measured, CONFIG_LVGL_PORT_LATENCY_SAMPLES);
+    stats->samples = n;
+    for (int i = 0; i < LVGL_PORT_LATENCY_STAGES && n > 0; i++) {
+        uint32_t *stage = &sorted[i * CONFIG_LVGL_PORT_LATENCY_SAMPLES];
+        qsort(stage, n, sizeof(uint32_t), lvgl_port_latency_cmp);
+        /* Nearest rank */
+        stats->stage[i].p50_us = stage[(n * 50 + 99) / 100 - 1];
+        stats->stage[i].p90_us = stage[(n * 90 + 99) / 100 - 1];
+        stats->stage[i].p99_us = stage[(n * 99 + 99) / 100 - 1];
+        stats->stage[i].max_us = stage[n - 1];
+    }
+    free(sorted);
+
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Drop the followed event, which is not finished in time (called in critical section) */
+static inline bool IRAM_ATTR lvgl_port_latency_busy(lvgl_port_latency_ctx_t *ctx, int64_t now)
+{
+    if (ctx->state == LATENCY_STATE_IDLE) {
+        return false;
+    }
+    if (now - ctx->ts[LATENCY_TS_IRQ] < LVGL_PORT_LATENCY_TIMEOUT_US) {
+        return true;
+    }
+    ctx->dropped++;
+    ctx->state = LATENCY_STATE_IDLE;
+    return false;
+}
+
+/* Store the stages of the finished event (called in critical section) */
+static void IRAM_ATTR lvgl_port_latency_finish(lvgl_port_latency_ctx_t *ctx, int64_t now)
+{
+    ctx->ts[LATENCY_TS_DONE] = now;
+    const uint32_t idx = ctx->measured % CONFIG_LVGL_PORT_LATENCY_SAMPLES;
+    for (int i = 0; i < LVGL_PORT_LATENCY_TOTAL; i++) {
+        ctx->samples[i][idx] = (uint32_t)(ctx->ts[i + 1] - ctx->ts[i]);
+    }
+    ctx->samples[LVGL_PORT_LATENCY_TOTAL][idx] = (uint32_t)(now - ctx->ts[LATENCY_TS_IRQ]);
+    ctx->measured++;
+    ctx->state = LATENCY_STATE_IDLE;
+}
+
+void IRAM_ATTR lvgl_port_latency_touch_irq(void)
+{
+    lvgl_port_latency_ctx_t *ctx = &lvgl_port_latency_ctx;
+    const int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL_SAFE(&ctx->lock);
+    if (!lvgl_port_latency_busy(ctx, now)) {
+        ctx->ts[LATENCY_TS_IRQ] = now;
+        ctx->state = LATENCY_STATE_IRQ;
+    }
+    portEXIT_CRITICAL_SAFE(&ctx->lock);
+}
+
+void lvgl_port_latency_touch_read(lv_indev_t *indev, const lv_indev_data_t *data)
+{
+    lvgl_port_latency_ctx_t *ctx = &lvgl_port_latency_ctx;
+    const int64_t now = esp_timer_get_time();
+    /* Press, release or move while pressed */
+    const bool changed = (data->state != ctx->last_state ||
+                          (data->state == LV_INDEV_STATE_PRESSED && (data->point.x != ctx->last_point.x || data->point.y != ctx->last_point.y)));
+    ctx->last_state = data->state;
+    ctx->last_point = data->point;
+    if (!changed) {
+        return;
+    }
+    lv_display_t *disp = lv_indev_get_display(indev);
+
+    portENTER_CRITICAL(&ctx->lock);
+    const bool busy = lvgl_port_latency_busy(ctx, now);
+    if (!busy || ctx->state == LATENCY_STATE_IRQ) {
+        if (ctx->state == LATENCY_STATE_IDLE) {
+            /* Polled touch, the measure starts at the read */
+            ctx->ts[LATENCY_TS_IRQ] = now;
+        }
+        ctx->ts[LATENCY_TS_READ] = now;
+        ctx->disp = disp;
+        ctx->state = LATENCY_STATE_READ;
+    }
+    portEXIT_CRITICAL(&ctx->lock);
+}
+
+void lvgl_port_latency_invalidate(lv_display_t *disp)
+{
+    lvgl_port_latency_ctx_t *ctx = &lvgl_port_latency_ctx;
+
+    /* Called for each area, only the first one after the read is followed */
+    if (ctx->state != LATENCY_STATE_READ || ctx->disp != disp) {
+        return;
+    }
+    portENTER_CRITICAL(&ctx->lock);
+    if (ctx->state == LATENCY_STATE_READ && ctx->disp == disp) {
+        ctx->ts[LATENCY_TS_INVALIDATE] = esp_timer_get_time();
+        ctx->state = LATENCY_STATE_INVALIDATED;
+    }
+    portEXIT_CRITICAL(&ctx->lock);
+}
+
+void lvgl_port_latency_render_start(lv_display_t *disp)
+{
+    lvgl_port_latency_ctx_t *ctx = &lvgl_port_latency_ctx;
+
+    portENTER_CRITICAL(&ctx->lock);
+    if (ctx->disp == disp) {
+        if (ctx->state == LATENCY_STATE_INVALIDATED) {
+            ctx->ts[LATENCY_TS_RENDER_START] = esp_timer_get_time();
+            ctx->state = LATENCY_STATE_RENDERING;
+        } else if (ctx->state == LATENCY_STATE_READ) {
+            /* The touch did not change the screen */
+            ctx->dropped++;
+            ctx->state = LATENCY_STATE_IDLE;
+        }
+    }
+    portEXIT_CRITICAL(&ctx->lock);
+}
+
+void lvgl_port_latency_render_ready(lv_display_t *disp, lvgl_port_latency_done_t done_mode, uint32_t trans_target, const volatile uint32_t *trans_done)
+{
+    lvgl_port_latency_ctx_t *ctx = &lvgl_port_latency_ctx;
+
+    portENTER_CRITICAL(&ctx->lock);
+    if (ctx->state == LATENCY_STATE_RENDERING && ctx->disp == disp) {
+        const int64_t now = esp_timer_get_time();
+        ctx->ts[LATENCY_TS_RENDER_READY] = now;
+        ctx->done_mode = done_mode;
+        ctx->trans_target = trans_target;
+        ctx->state = LATENCY_STATE_TRANSFER;
+        /* Already transferred (or nothing to transfer) */
+        if (done_mode == LVGL_PORT_LATENCY_DONE_NOW || (done_mode == LVGL_PORT_LATENCY_DONE_TRANS && (int32_t)(*trans_done - trans_target) >= 0)) {
+            lvgl_port_latency_finish(ctx, now);
+        }
+    }
+    portEXIT_CRITICAL(&ctx->lock);
+}
+
+void IRAM_ATTR lvgl_port_latency_trans_done(lv_display_t *disp, uint32_t trans_done)
+{
+    lvgl_port_latency_ctx_t *ctx = &lvgl_port_latency_ctx;
+
+    if (ctx->state != LATENCY_STATE_TRANSFER || ctx->disp != disp) {
+        return;
+    }
+    portENTER_CRITICAL_SAFE(&ctx->lock);
+    if (ctx->state == LATENCY_STATE_TRANSFER && ctx->disp == disp && ctx->done_mode == LVGL_PORT_LATENCY_DONE_TRANS &&
+            (int32_t)(trans_done - ctx->trans_target) >= 0) {
+        lvgl_port_latency_finish(ctx, esp_timer_get_time());
+    }
+    portEXIT_CRITICAL_SAFE(&ctx->lock);
+}
+
+void IRAM_ATTR lvgl_port_latency_vsync(lv_display_t *disp)
+{
+    lvgl_port_latency_ctx_t *ctx = &lvgl_port_latency_ctx;
+
+    if (ctx->state != LATENCY_STATE_TRANSFER || ctx->disp != disp) {
+        return;
+    }
+    portENTER_CRITICAL_SAFE(&ctx->lock);
+    if (ctx->state == LATENCY_STATE_TRANSFER && ctx->disp == disp && ctx->done_mode == LVGL_PORT_LATENCY_DONE_VSYNC) {
+        lvgl_port_latency_finish(ctx, esp_timer_get_time());
+    }
+    portEXIT_CRITICAL_SAFE(&ctx->lock);
+}
+
+#else
+
+esp_err_t lvgl_port_get_latency_stats(lvgl_port_latency_stats_t *stats, bool reset)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
@@ -0,0 +1,347 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "lvgl.h"
+
+static const char *TAG = "LVGL";
+
+/* Snapshot into given draw buffer and displays without refresh timer are from LVGL 9.2 */
+#if LV_VERSION_CHECK(9, 2, 0) && LV_USE_SNAPSHOT
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct lvgl_port_layer_cache_s {
+    lv_obj_t            *obj;           /* Root of the subtree (on private display), NULL when deleted */
+    lv_obj_t            *placeholder;   /* Draws the cache in place of the subtree */
+    lv_display_t        *disp;          /* Private display of the subtree, it is never refreshed */
+    lv_display_t        *parent_disp;   /* Display of the placeholder */
+    lv_color_format_t   cf;
+    bool                spiram;
+    bool                dirty;          /* Subtree was invalidated after the last rendering */
+    int32_t             ext;            /* Ext draw size of the root object (shadow, outline) */
+    lv_draw_buf_t       buf;            /* Rendered subtree with its ext draw area */
+    void                *buf_data;
+    size_t              buf_size;
+    lvgl_port_layer_cache_info_t info;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static esp_err_t lvgl_port_layer_cache_render(lvgl_port_layer_cache_handle_t cache);
+static void lvgl_port_layer_cache_free(lvgl_port_layer_cache_handle_t cache);
+static void lvgl_port_layer_cache_placeholder_cb(lv_event_t *e);
+static void lvgl_port_layer_cache_obj_delete_cb(lv_event_t *e);
+static void lvgl_port_layer_cache_invalidate_cb(lv_event_t *e);
+static void lvgl_port_layer_cache_refr_start_cb(lv_event_t *e);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_layer_cache_create(const lvgl_port_layer_cache_cfg_t *cfg, lvgl_port_layer_cache_handle_t *ret_handle)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(cfg && cfg->obj && ret_handle, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    lv_obj_t *obj = cfg->obj;
+    lv_obj_t *parent = lv_obj_get_parent(obj);
+    lvgl_port_layer_cache_handle_t cache = NULL;
+    ESP_GOTO_ON_FALSE(parent, ESP_ERR_INVALID_ARG, err, TAG, "Screen cannot be cached");
+
+    cache = LVGL_PORT_CTX_CALLOC(sizeof(struct lvgl_port_layer_cache_s));
+    ESP_GOTO_ON_FALSE(cache, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for layer cache allocation!");
+    cache->cf = (cfg->cf != LV_COLOR_FORMAT_UNKNOWN) ? cfg->cf : LV_COLOR_FORMAT_ARGB8888;
+    cache->spiram = cfg->flags.buff_spiram;
+    cache->ext = -1;
+
+    /* Placeholder takes the place of the object in the parent (position and size as laid out now) */
+    lv_obj_update_layout(obj);
+    const int32_t x = lv_obj_get_x(obj);
+    const int32_t y = lv_obj_get_y(obj);
+    const int32_t w = lv_obj_get_width(obj);
+    const int32_t h = lv_obj_get_height(obj);
+    lv_obj_t *placeholder = lv_obj_create(parent);
+    ESP_GOTO_ON_FALSE(placeholder, ESP_ERR_NO_MEM, err, TAG, "Create placeholder fail!");
+    cache->placeholder = placeholder;
+    lv_obj_remove_style_all(placeholder);
+    lv_obj_remove_flag(placeholder, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_IGNORE_LAYOUT)) {
+        lv_obj_add_flag(placeholder, LV_OBJ_FLAG_IGNORE_LAYOUT);
+    }
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_FLOATING)) {
+        lv_obj_add_flag(placeholder, LV_OBJ_FLAG_FLOATING);
+    }
+    lv_obj_set_style_flex_grow(placeholder, lv_obj_get_style_flex_grow(obj, LV_PART_MAIN), LV_PART_MAIN);
+    lv_obj_set_pos(placeholder, x, y);
+    lv_obj_set_size(placeholder, w, h);
+    lv_obj_move_to_index(placeholder, lv_obj_get_index(obj));
+    lv_obj_add_event_cb(placeholder, lvgl_port_layer_cache_placeholder_cb, LV_EVENT_ALL, cache);
+
+    /* Private display, invalidations of the subtree are only tracked there */
+    cache->disp = lv_display_create(w > 0 ? w : 1, h > 0 ? h : 1);
+    ESP_GOTO_ON_FALSE(cache->disp, ESP_ERR_NO_MEM, err, TAG, "Create private display fail!");
+    lv_display_delete_refr_timer(cache->disp);
+    lv_display_add_event_cb(cache->disp, lvgl_port_layer_cache_invalidate_cb, LV_EVENT_INVALIDATE_AREA, cache);
+
+    /* Sizes relative to the parent are resolved */
+    if (LV_COORD_IS_PCT(lv_obj_get_style_width(obj, LV_PART_MAIN))) {
+        lv_obj_set_width(obj, w);
+    }
+    if (LV_COORD_IS_PCT(lv_obj_get_style_height(obj, LV_PART_MAIN))) {
+        lv_obj_set_height(obj, h);
+    }
+    lv_obj_set_parent(obj, lv_display_get_screen_active(cache->disp));
+    lv_obj_add_event_cb(obj, lvgl_port_layer_cache_obj_delete_cb, LV_EVENT_DELETE, cache);
+    cache->obj = obj;
+
+    /* Changed subtree is rendered at the start of the display refresh */
+    cache->parent_disp = lv_obj_get_display(placeholder);
+    lv_display_add_event_cb(cache->parent_disp, lvgl_port_layer_cache_refr_start_cb, LV_EVENT_REFR_START, cache);
+
+    ESP_GOTO_ON_ERROR(lvgl_port_layer_cache_render(cache), err, TAG, "Layer cache rendering fail!");
+    *ret_handle = cache;
+    lvgl_port_unlock();
+    return ESP_OK;
+
+err:
+    if (cache) {
+        if (cache->obj) {
+            /* Back to the original parent */
+            lv_obj_remove_event_cb_with_user_data(cache->obj, lvgl_port_layer_cache_obj_delete_cb, cache);
+            lv_obj_set_parent(cache->obj, parent);
+            lv_obj_move_to_index(cache->obj, lv_obj_get_index(cache->placeholder));
+            cache->obj = NULL;
+        }
+        if (cache->placeholder) {
+            lv_obj_remove_event_cb_with_user_data(cache->placeholder, lvgl_port_layer_cache_placeholder_cb, cache);
+            lv_obj_delete(cache->placeholder);
+        }
+        lvgl_port_layer_cache_free(cache);
+    }
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_layer_cache_delete(lvgl_port_layer_cache_handle_t cache)
+{
+    ESP_RETURN_ON_FALSE(cache, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    lv_obj_t *placeholder = cache->placeholder;
+    lv_obj_remove_event_cb_with_user_data(placeholder, lvgl_port_layer_cache_placeholder_cb, cache);
+    if (cache->obj) {
+        /* Subtree is moved back to the position of placeholder, the original alignment is not restored */
+        lv_display_remove_event_cb_with_user_data(cache->disp, lvgl_port_layer_cache_invalidate_cb, cache);
+        lv_obj_remove_event_cb_with_user_data(cache->obj, lvgl_port_layer_cache_obj_delete_cb, cache);
+        lv_obj_set_parent(cache->obj, lv_obj_get_parent(placeholder));
+        lv_obj_move_to_index(cache->obj, lv_obj_get_index(placeholder));
+        lv_obj_align(cache->obj, LV_ALIGN_TOP_LEFT, lv_obj_get_x(placeholder), lv_obj_get_y(placeholder));
+        cache->obj = NULL;
+    }
+    lv_obj_delete(placeholder);
+    lvgl_port_layer_cache_free(cache);
+
+    lvgl_port_unlock();
+    return ESP_OK;
+}
+
+void lvgl_port_layer_cache_invalidate(lvgl_port_layer_cache_handle_t cache)
+{
+    if (cache == NULL) {
+        return;
+    }
+    lvgl_port_lock(0);
+    cache->dirty = true;
+    lv_obj_invalidate(cache->placeholder);
+    lvgl_port_unlock();
+}
+
+lv_obj_t *lvgl_port_layer_cache_get_obj(lvgl_port_layer_cache_handle_t cache)
+{
+    return cache ? cache->placeholder : NULL;
+}
+
+esp_err_t lvgl_port_layer_cache_get_info(lvgl_port_layer_cache_handle_t cache, lvgl_port_layer_cache_info_t *info)
+{
+    ESP_RETURN_ON_FALSE(cache && info, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    *info = cache->info;
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static esp_err_t lvgl_port_layer_cache_render(lvgl_port_layer_cache_handle_t cache)
+{
+    lv_obj_t *obj = cache->obj;
+    const int64_t start = esp_timer_get_time();
+
+    /* Private display has no refresh timer, which would update the layout */
+    lv_obj_update_layout(obj);
+    const int32_t ext = lv_obj_get_ext_draw_size(obj);
+    const int32_t w = lv_obj_get_width(obj) + 2 * ext;
+    const int32_t h = lv_obj_get_height(obj) + 2 * ext;
+    if (w <= 0 || h <= 0) {
+        cache->dirty = false;
+        return ESP_OK;
+    }
+
+    /* Private display covers the object with ext draw area, its coordinates are the coordinates of the cache */
+    if (ext != cache->ext || w != lv_display_get_horizontal_resolution(cache->disp) || h != lv_display_get_vertical_resolution(cache->disp)) {
+        lv_display_set_resolution(cache->disp, w, h);
+        lv_obj_align(obj, LV_ALIGN_TOP_LEFT, ext, ext);
+        lv_obj_update_layout(obj);
+        cache->ext = ext;
+        lv_obj_refresh_ext_draw_size(cache->placeholder);
+        lv_obj_invalidate(cache->placeholder);
+    }
+
+    const uint32_t stride = lv_draw_buf_width_to_stride(w, cache->cf);
+    const size_t size = stride * h;
+    if (size > cache->buf_size) {
+        heap_caps_free(cache->buf_data);
+        cache->buf_size = 0;
+        const uint32_t caps = cache->spiram ? MALLOC_CAP_SPIRAM : (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        cache->buf_data = heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, size, caps);
+        ESP_RETURN_ON_FALSE(cache->buf_data, ESP_ERR_NO_MEM, TAG, "Not enough memory for layer cache buffer (%u bytes)!", (unsigned)size);
+        cache->buf_size = size;
+    }
+    lv_draw_buf_init(&cache->buf, w, h, cache->cf, stride, cache->buf_data, cache->buf_size);
+
+    cache->dirty = false;
+    ESP_RETURN_ON_FALSE(lv_snapshot_take_to_draw_buf(obj, cache->cf, &cache->buf) == LV_RESULT_OK, ESP_FAIL, TAG, "Snapshot of cached layer fail!");
+    /* Cache is drawn as image source, its decoded header must not be reused */
+    lv_image_cache_drop(&cache->buf);
+
+    cache->info.renders++;
+    cache->info.last_render_us = (uint32_t)(esp_timer_get_time() - start);
+    cache->info.buf_size = cache->buf_size;
+    ESP_LOGD(TAG, "Layer cache %"PRIi32"x%"PRIi32" rendered in %"PRIu32" us", w, h, cache->info.last_render_us);
+    return ESP_OK;
+}
+
+static void lvgl_port_layer_cache_free(lvgl_port_layer_cache_handle_t cache)
+{
+    if (cache->parent_disp) {
+        lv_display_remove_event_cb_with_user_data(cache->parent_disp, lvgl_port_layer_cache_refr_start_cb, cache);
+    }
+    if (cache->disp) {
+        /* The subtree is deleted with the private display, invalidations are not tracked anymore */
+        lv_display_remove_event_cb_with_user_data(cache->disp, lvgl_port_layer_cache_invalidate_cb, cache);
+        if (cache->obj) {
+            lv_obj_remove_event_cb_with_user_data(cache->obj, lvgl_port_layer_cache_obj_delete_cb, cache);
+        }
+        lv_display_delete(cache->disp);
+    }
+    heap_caps_free(cache->buf_data);
+    LVGL_PORT_CTX_FREE(cache);
+}
+
+static void lvgl_port_layer_cache_placeholder_cb(lv_event_t *e)
+{
+    lvgl_port_layer_cache_handle_t cache = lv_event_get_user_data(e);
+    lv_obj_t *placeholder = lv_event_get_current_target(e);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_REFR_EXT_DRAW_SIZE:
+        lv_event_set_ext_draw_size(e, LV_MAX(cache->ext, 0));
+        break;
+    case LV_EVENT_DRAW_MAIN:
+        if (cache->obj && cache->buf_size) {
+            lv_draw_image_dsc_t dsc;
+            lv_draw_image_dsc_init(&dsc);
+            dsc.src = &cache->buf;
+            lv_area_t area;
+            lv_obj_get_coords(placeholder, &area);
+            lv_area_increase(&area, cache->ext, cache->ext);
+            lv_draw_image(lv_event_get_layer(e), &dsc, &area);
+        }
+        break;
+    case LV_EVENT_DELETE:
+        /* Deleted with its parent, the subtree is deleted too */
+        lvgl_port_layer_cache_free(cache);
+        break;
+    default:
+        break;
+    }
+}
+
+static void lvgl_port_layer_cache_obj_delete_cb(lv_event_t *e)
+{
+    lvgl_port_layer_cache_handle_t cache = lv_event_get_user_data(e);
+    cache->obj = NULL;
+    lv_obj_invalidate(cache->placeholder);
+}
+
+static void lvgl_port_layer_cache_invalidate_cb(lv_event_t *e)
+{
+    lvgl_port_layer_cache_handle_t cache = lv_event_get_user_data(e);
+    const lv_area_t *area = lv_event_get_param(e);
+    cache->dirty = true;
+
+    /* Only the changed part of the placeholder is redrawn */
+    lv_area_t coords;
+    lv_obj_get_coords(cache->placeholder, &coords);
+    lv_area_t inv = *area;
+    lv_area_move(&inv, coords.x1 - LV_MAX(cache->ext, 0), coords.y1 - LV_MAX(cache->ext, 0));
+    lv_obj_invalidate_area(cache->placeholder, &inv);
+}
+
+static void lvgl_port_layer_cache_refr_start_cb(lv_event_t *e)
+{
+    lvgl_port_layer_cache_handle_t cache = lv_event_get_user_data(e);
+    if (cache->dirty && cache->obj) {
+        lvgl_port_layer_cache_render(cache);
+    }
+}
+
+#else
+
+esp_err_t lvgl_port_layer_cache_create(const lvgl_port_layer_cache_cfg_t *cfg, lvgl_port_layer_cache_handle_t *ret_handle)
+{
+    ESP_LOGE(TAG, "Layer cache needs LVGL 9.2 and CONFIG_LV_USE_SNAPSHOT");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_layer_cache_delete(lvgl_port_layer_cache_handle_t handle)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+void lvgl_port_layer_cache_invalidate(lvgl_port_layer_cache_handle_t handle)
+{
+}
+
+lv_obj_t *lvgl_port_layer_cache_get_obj(lvgl_port_layer_cache_handle_t handle)
+{
+    return NULL;
+}
+
+esp_err_t lvgl_port_layer_cache_get_info(lvgl_port_layer_cache_handle_t handle, lvgl_port_layer_cache_info_t *info)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
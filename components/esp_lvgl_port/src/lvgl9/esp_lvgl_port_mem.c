@@ -0,0 +1,533 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "multi_heap.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_lvgl_port_mem.h"
+#include "lvgl.h"
+
+/* LVGL allocator implementation, when LV_STDLIB_CUSTOM is set with CONFIG_LVGL_PORT_MEM_POOL */
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM && CONFIG_LVGL_PORT_MEM_POOL
+
+#define LVGL_PORT_MEM_ACCOUNTING    CONFIG_LVGL_PORT_MEM_ACCOUNTING
+
+#ifndef CONFIG_LVGL_PORT_MEM_POOL_SPIRAM_KB
+#define CONFIG_LVGL_PORT_MEM_POOL_SPIRAM_KB         (0)
+#define CONFIG_LVGL_PORT_MEM_POOL_SPIRAM_THRESHOLD  (0)
+#endif
+
+#if LVGL_PORT_MEM_ACCOUNTING
+#if LV_VERSION_CHECK(9, 2, 0)
+/* Name of object class */
+#include "src/core/lv_obj_class_private.h"
+#endif
+/* Header before each block, it keeps 8-byte alignment of the blocks */
+#define LVGL_PORT_MEM_HDR_SIZE      (8)
+/* Entry 0 is for allocations without screen */
+#define LVGL_PORT_MEM_SCREENS       (CONFIG_LVGL_PORT_MEM_ACCOUNTING_SCREENS + 1)
+/* Classes printed for each active screen */
+#define LVGL_PORT_MEM_DUMP_CLASSES  (32)
+#else
+#define LVGL_PORT_MEM_HDR_SIZE      (0)
+#endif
+
+static const char *TAG = "LVGL";
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    void                *region;    /* Memory reserved from system heap */
+    size_t              size;       /* Size of the region */
+    multi_heap_handle_t heap;       /* TLSF heap in the region */
+    uint32_t            failed;     /* Allocations not satisfied */
+} lvgl_port_mem_ctx_t;
+
+#if LVGL_PORT_MEM_ACCOUNTING
+typedef struct {
+    uint32_t            size;       /* Requested size of the block */
+    uint32_t            screen;     /* Index of the accounted screen */
+} lvgl_port_mem_hdr_t;
+
+_Static_assert(sizeof(lvgl_port_mem_hdr_t) == LVGL_PORT_MEM_HDR_SIZE, "Header of LVGL memory block must keep its alignment");
+
+typedef struct {
+    lvgl_port_mem_class_stats_t *stats;
+    size_t              max;
+    size_t              count;
+} lvgl_port_mem_walk_t;
+#endif
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static lvgl_port_mem_ctx_t lvgl_port_mem[2];
+static portMUX_TYPE lvgl_port_mem_lock = portMUX_INITIALIZER_UNLOCKED;
+#if LVGL_PORT_MEM_ACCOUNTING
+static lvgl_port_mem_screen_stats_t lvgl_port_mem_screens[LVGL_PORT_MEM_SCREENS];
+static const lv_obj_t *volatile lvgl_port_mem_screen;  /* Set by lvgl_port_mem_set_screen */
+#endif
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static esp_err_t lvgl_port_mem_create(lvgl_port_mem_ctx_t *mem, size_t size, uint32_t caps)
+{
+    mem->region = heap_caps_malloc(size, caps);
+    ESP_RETURN_ON_FALSE(mem->region, ESP_ERR_NO_MEM, TAG, "Not enough memory for LVGL pool (%u bytes) allocation!", (unsigned)size);
+    mem->heap = multi_heap_register(mem->region, size);
+    if (mem->heap == NULL) {
+        heap_caps_free(mem->region);
+        mem->region = NULL;
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_SIZE, TAG, "LVGL pool registration failed");
+    }
+    mem->size = size;
+    return ESP_OK;
+}
+
+static lvgl_port_mem_ctx_t *lvgl_port_mem_owner(const void *p)
+{
+    for (int i = 0; i < 2; i++) {
+        const uint8_t *start = lvgl_port_mem[i].region;
+        if (start && (const uint8_t *)p >= start && (const uint8_t *)p < start + lvgl_port_mem[i].size) {
+            return &lvgl_port_mem[i];
+        }
+    }
+    return NULL;
+}
+
+/* Preferred pool by size, the other one is used when the preferred is full */
+static void *lvgl_port_mem_alloc(size_t size)
+{
+    const int first = (size >= CONFIG_LVGL_PORT_MEM_POOL_SPIRAM_THRESHOLD && lvgl_port_mem[LVGL_PORT_MEM_POOL_SPIRAM].heap) ?
+                      LVGL_PORT_MEM_POOL_SPIRAM : LVGL_PORT_MEM_POOL_INTERNAL;
+    void *p = NULL;
+
+    portENTER_CRITICAL(&lvgl_port_mem_lock);
+    for (int i = 0; i < 2 && p == NULL; i++) {
+        lvgl_port_mem_ctx_t *mem = &lvgl_port_mem[first ^ i];
+        if (mem->heap) {
+            p = multi_heap_malloc(mem->heap, size);
+        }
+    }
+    if (p == NULL) {
+        lvgl_port_mem[first].failed++;
+    }
+    portEXIT_CRITICAL(&lvgl_port_mem_lock);
+
+    return p;
+}
+
+#if LVGL_PORT_MEM_ACCOUNTING
+static const lv_obj_t *lvgl_port_mem_current_screen(void)
+{
+    const lv_obj_t *screen = lvgl_port_mem_screen;
+    if (screen == NULL && lv_display_get_default()) {
+        screen = lv_display_get_screen_active(NULL);
+    }
+    return screen;
+}
+
+/* Entry of the screen, a new one replaces an entry without blocks (called with the lock) */
+static uint32_t lvgl_port_mem_screen_index(const lv_obj_t *screen)
+{
+    if (screen == NULL) {
+        return 0;
+    }
+    uint32_t unused = 0;
+    for (uint32_t i = 1; i < LVGL_PORT_MEM_SCREENS; i++) {
+        if (lvgl_port_mem_screens[i].screen == screen) {
+            return i;
+        }
+        if (unused == 0 && lvgl_port_mem_screens[i].blocks == 0) {
+            unused = i;
+        }
+    }
+    if (unused) {
+        memset(&lvgl_port_mem_screens[unused], 0, sizeof(lvgl_port_mem_screen_stats_t));
+        lvgl_port_mem_screens[unused].screen = screen;
+    }
+    return unused;
+}
+
+/* Fill the header of allocated block and account it (called with the lock) */
+static void *lvgl_port_mem_account(void *raw, size_t size, uint32_t screen)
+{
+    lvgl_port_mem_hdr_t *hdr = raw;
+    hdr->size = size;
+    hdr->screen = screen;
+    lvgl_port_mem_screen_stats_t *stats = &lvgl_port_mem_screens[screen];
+    stats->used += size;
+    stats->blocks++;
+    if (stats->used > stats->max_used) {
+        stats->max_used = stats->used;
+    }
+    return (uint8_t *)raw + LVGL_PORT_MEM_HDR_SIZE;
+}
+
+static void lvgl_port_mem_unaccount(const void *raw)
+{
+    const lvgl_port_mem_hdr_t *hdr = raw;
+    lvgl_port_mem_screen_stats_t *stats = &lvgl_port_mem_screens[hdr->screen];
+    stats->used -= hdr->size;
+    stats->blocks--;
+}
+
+/* Requested size of LVGL block, 0 if it is not from the pools */
+static size_t lvgl_port_mem_block_size(const void *p)
+{
+    const uint8_t *raw = (const uint8_t *)p - LVGL_PORT_MEM_HDR_SIZE;
+    if (lvgl_port_mem_owner(raw) == NULL) {
+        return 0;
+    }
+    return ((const lvgl_port_mem_hdr_t *)raw)->size;
+}
+
+static lv_obj_tree_walk_res_t lvgl_port_mem_class_walk_cb(lv_obj_t *obj, void *user_data)
+{
+    lvgl_port_mem_walk_t *walk = user_data;
+    const lv_obj_class_t *class_p = lv_obj_get_class(obj);
+    size_t i = 0;
+    while (i < walk->count && walk->stats[i].class_p != class_p) {
+        i++;
+    }
+    if (i == walk->count) {
+        if (walk->count == walk->max) {
+            return LV_OBJ_TREE_WALK_NEXT;
+        }
+        memset(&walk->stats[i], 0, sizeof(lvgl_port_mem_class_stats_t));
+        walk->stats[i].class_p = class_p;
+#if LV_VERSION_CHECK(9, 2, 0)
+        walk->stats[i].name = class_p->name;
+#endif
+        walk->count++;
+    }
+    walk->stats[i].objects++;
+    walk->stats[i].bytes += lvgl_port_mem_block_size(obj);
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+static void lvgl_port_mem_dump_pool(FILE *out, const char *name, lvgl_port_mem_pool_t pool)
+{
+    lvgl_port_mem_stats_t stats;
+    if (lvgl_port_mem_get_stats(pool, &stats) == ESP_OK) {
+        fprintf(out, "pool %s: used %u of %u, max used %u, largest free %u, blocks %"PRIu32", failed %"PRIu32"\n", name,
+                (unsigned)(stats.total_size - stats.free_size), (unsigned)stats.total_size, (unsigned)stats.max_used,
+                (unsigned)stats.largest_free_block, stats.used_blocks, stats.failed);
+    }
+}
+#endif
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_mem_get_stats(lvgl_port_mem_pool_t pool, lvgl_port_mem_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats && (pool == LVGL_PORT_MEM_POOL_INTERNAL || pool == LVGL_PORT_MEM_POOL_SPIRAM), ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    lvgl_port_mem_ctx_t *mem = &lvgl_port_mem[pool];
+    multi_heap_info_t info;
+
+    portENTER_CRITICAL(&lvgl_port_mem_lock);
+    if (mem->heap == NULL) {
+        portEXIT_CRITICAL(&lvgl_port_mem_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    multi_heap_get_info(mem->heap, &info);
+    stats->failed = mem->failed;
+    portEXIT_CRITICAL(&lvgl_port_mem_lock);
+
+    /* Heap metadata is counted as used */
+    stats->total_size = mem->size;
+    stats->free_size = info.total_free_bytes;
+    stats->largest_free_block = info.largest_free_block;
+    stats->max_used = mem->size - info.minimum_free_bytes;
+    stats->used_blocks = info.allocated_blocks;
+    return ESP_OK;
+}
+
+#if LVGL_PORT_MEM_ACCOUNTING
+esp_err_t lvgl_port_mem_set_screen(const lv_obj_t *screen)
+{
+    lvgl_port_mem_screen = screen;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_mem_get_screen_stats(lvgl_port_mem_screen_stats_t *stats, size_t max, size_t *count)
+{
+    ESP_RETURN_ON_FALSE(stats && count, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    size_t n = 0;
+
+    portENTER_CRITICAL(&lvgl_port_mem_lock);
+    for (uint32_t i = 0; i < LVGL_PORT_MEM_SCREENS && n < max; i++) {
+        if (i == 0 || lvgl_port_mem_screens[i].screen) {
+            stats[n++] = lvgl_port_mem_screens[i];
+        }
+    }
+    portEXIT_CRITICAL(&lvgl_port_mem_lock);
+
+    *count = n;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_mem_get_class_stats(lv_obj_t *screen, lvgl_port_mem_class_stats_t *stats, size_t max, size_t *count)
+{
+    ESP_RETURN_ON_FALSE(screen && stats && count, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    lvgl_port_mem_walk_t walk = {
+        .stats = stats,
+        .max = max,
+    };
+    lv_obj_tree_walk(screen, lvgl_port_mem_class_walk_cb, &walk);
+
+    /* Largest first */
+    for (size_t i = 1; i < walk.count; i++) {
+        const lvgl_port_mem_class_stats_t tmp = stats[i];
+        size_t j = i;
+        for (; j > 0 && stats[j - 1].bytes < tmp.bytes; j--) {
+            stats[j] = stats[j - 1];
+        }
+        stats[j] = tmp;
+    }
+    *count = walk.count;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_mem_dump(FILE *out)
+{
+    ESP_RETURN_ON_FALSE(out, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    static lvgl_port_mem_screen_stats_t screens[LVGL_PORT_MEM_SCREENS];
+    static lvgl_port_mem_class_stats_t classes[LVGL_PORT_MEM_DUMP_CLASSES];
+    size_t count;
+
+    lvgl_port_mem_dump_pool(out, "internal", LVGL_PORT_MEM_POOL_INTERNAL);
+    lvgl_port_mem_dump_pool(out, "PSRAM", LVGL_PORT_MEM_POOL_SPIRAM);
+
+    fprintf(out, "screens (used, max used, blocks):\n");
+    lvgl_port_mem_get_screen_stats(screens, LVGL_PORT_MEM_SCREENS, &count);
+    for (size_t i = 0; i < count; i++) {
+        if (screens[i].screen) {
+            fprintf(out, "  %p: %u, %u, %"PRIu32"\n", screens[i].screen, (unsigned)screens[i].used, (unsigned)screens[i].max_used, screens[i].blocks);
+        } else {
+            fprintf(out, "  no screen: %u, %u, %"PRIu32"\n", (unsigned)screens[i].used, (unsigned)screens[i].max_used, screens[i].blocks);
+        }
+    }
+
+    for (lv_display_t *disp = lv_display_get_next(NULL); disp; disp = lv_display_get_next(disp)) {
+        lv_obj_t *screen = lv_display_get_screen_active(disp);
+        if (screen == NULL) {
+            continue;
+        }
+        fprintf(out, "active screen %p of display %p (objects, bytes):\n", screen, disp);
+        lvgl_port_mem_get_class_stats(screen, classes, LVGL_PORT_MEM_DUMP_CLASSES, &count);
+        for (size_t i = 0; i < count; i++) {
+            if (classes[i].name) {
+                fprintf(out, "  %s: %"PRIu32", %u\n", classes[i].name, classes[i].objects, (unsigned)classes[i].bytes);
+            } else {
+                fprintf(out, "  class %p: %"PRIu32", %u\n", classes[i].class_p, classes[i].objects, (unsigned)classes[i].bytes);
+            }
+        }
+    }
+    fflush(out);
+
+    return ESP_OK;
+}
+#endif
+
+/*******************************************************************************
+* LVGL memory API functions
+*******************************************************************************/
+
+void lv_mem_init(void)
+{
+    ESP_ERROR_CHECK(lvgl_port_mem_create(&lvgl_port_mem[LVGL_PORT_MEM_POOL_INTERNAL], CONFIG_LVGL_PORT_MEM_POOL_INTERNAL_KB * 1024,
+                                         MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+#if CONFIG_LVGL_PORT_MEM_POOL_SPIRAM_KB > 0
+    if (heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0) {
+        /* Without PSRAM pool, all allocations go to the internal pool */
+        lvgl_port_mem_create(&lvgl_port_mem[LVGL_PORT_MEM_POOL_SPIRAM], CONFIG_LVGL_PORT_MEM_POOL_SPIRAM_KB * 1024, MALLOC_CAP_SPIRAM);
+    }
+#endif
+    ESP_LOGI(TAG, "Memory pools: internal %u kB, PSRAM %u kB", (unsigned)(lvgl_port_mem[0].size / 1024), (unsigned)(lvgl_port_mem[1].size / 1024));
+}
+
+void lv_mem_deinit(void)
+{
+    for (int i = 0; i < 2; i++) {
+        if (lvgl_port_mem[i].region) {
+            heap_caps_free(lvgl_port_mem[i].region);
+        }
+    }
+    memset(lvgl_port_mem, 0, sizeof(lvgl_port_mem));
+#if LVGL_PORT_MEM_ACCOUNTING
+    memset(lvgl_port_mem_screens, 0, sizeof(lvgl_port_mem_screens));
+    lvgl_port_mem_screen = NULL;
+#endif
+}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes)
+{
+    /* Size of the pools is fixed by Kconfig */
+    ESP_LOGW(TAG, "Adding LVGL memory pool is not supported");
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool)
+{
+}
+
+void *lv_malloc_core(size_t size)
+{
+#if LVGL_PORT_MEM_ACCOUNTING
+    /* Screen is read before the lock, it can call LVGL */
+    const lv_obj_t *screen = lvgl_port_mem_current_screen();
+    void *raw = lvgl_port_mem_alloc(size + LVGL_PORT_MEM_HDR_SIZE);
+    if (raw == NULL) {
+        return NULL;
+    }
+    portENTER_CRITICAL(&lvgl_port_mem_lock);
+    void *p = lvgl_port_mem_account(raw, size, lvgl_port_mem_screen_index(screen));
+    portEXIT_CRITICAL(&lvgl_port_mem_lock);
+    return p;
+#else
+    return lvgl_port_mem_alloc(size);
+#endif
+}
+
+void *lv_realloc_core(void *p, size_t new_size)
+{
+    lvgl_port_mem_ctx_t *mem = (p ? lvgl_port_mem_owner((uint8_t *)p - LVGL_PORT_MEM_HDR_SIZE) : NULL);
+    if (mem == NULL) {
+        return lv_malloc_core(new_size);
+    }
+    void *raw = (uint8_t *)p - LVGL_PORT_MEM_HDR_SIZE;
+
+    /* Resize in place, when it fits the same pool */
+    portENTER_CRITICAL(&lvgl_port_mem_lock);
+#if LVGL_PORT_MEM_ACCOUNTING
+    const lvgl_port_mem_hdr_t hdr = *(const lvgl_port_mem_hdr_t *)raw;
+    const size_t old_size = hdr.size;
+#else
+    const size_t old_size = multi_heap_get_allocated_size(mem->heap, p);
+#endif
+    void *new_raw = multi_heap_realloc(mem->heap, raw, new_size + LVGL_PORT_MEM_HDR_SIZE);
+    void *new_p = NULL;
+    if (new_raw) {
+#if LVGL_PORT_MEM_ACCOUNTING
+        /* Header is moved with the block, the block stays accounted to its screen */
+        lvgl_port_mem_unaccount(&hdr);
+        new_p = lvgl_port_mem_account(new_raw, new_size, hdr.screen);
+#else
+        new_p = new_raw;
+#endif
+    }
+    portEXIT_CRITICAL(&lvgl_port_mem_lock);
+    if (new_p) {
+        return new_p;
+    }
+
+    /* Move into the other pool */
+    new_p = lv_malloc_core(new_size);
+    if (new_p) {
+        memcpy(new_p, p, (old_size < new_size) ? old_size : new_size);
+        lv_free_core(p);
+    }
+    return new_p;
+}
+
+void lv_free_core(void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+    void *raw = (uint8_t *)p - LVGL_PORT_MEM_HDR_SIZE;
+    lvgl_port_mem_ctx_t *mem = lvgl_port_mem_owner(raw);
+    if (mem == NULL) {
+        return;
+    }
+    portENTER_CRITICAL(&lvgl_port_mem_lock);
+#if LVGL_PORT_MEM_ACCOUNTING
+    lvgl_port_mem_unaccount(raw);
+#endif
+    multi_heap_free(mem->heap, raw);
+    portEXIT_CRITICAL(&lvgl_port_mem_lock);
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p)
+{
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    size_t min_free = 0;
+    for (int i = 0; i < 2; i++) {
+        lvgl_port_mem_stats_t stats;
+        if (lvgl_port_mem_get_stats(i, &stats) != ESP_OK) {
+            continue;
+        }
+        mon_p->total_size += stats.total_size;
+        mon_p->free_size += stats.free_size;
+        mon_p->used_cnt += stats.used_blocks;
+        min_free += stats.total_size - stats.max_used;
+        if (stats.largest_free_block > mon_p->free_biggest_size) {
+            mon_p->free_biggest_size = stats.largest_free_block;
+        }
+    }
+    mon_p->max_used = mon_p->total_size - min_free;
+    if (mon_p->total_size > 0) {
+        mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
+    }
+    if (mon_p->free_size > 0) {
+        mon_p->frag_pct = 100 - (100U * mon_p->free_biggest_size) / mon_p->free_size;
+    }
+}
+
+lv_result_t lv_mem_test_core(void)
+{
+    bool ok = true;
+    portENTER_CRITICAL(&lvgl_port_mem_lock);
+    for (int i = 0; i < 2 && ok; i++) {
+        if (lvgl_port_mem[i].heap) {
+            ok = multi_heap_check(lvgl_port_mem[i].heap, false);
+        }
+    }
+    portEXIT_CRITICAL(&lvgl_port_mem_lock);
+    return ok ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+#else
+esp_err_t lvgl_port_mem_get_stats(lvgl_port_mem_pool_t pool, lvgl_port_mem_stats_t *stats)
+{
+    return ESP_ERR_INVALID_STATE;
+}
+#endif
+
+#if !(LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM && CONFIG_LVGL_PORT_MEM_POOL && CONFIG_LVGL_PORT_MEM_ACCOUNTING)
+esp_err_t lvgl_port_mem_set_screen(const lv_obj_t *screen)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_mem_get_screen_stats(lvgl_port_mem_screen_stats_t *stats, size_t max, size_t *count)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_mem_get_class_stats(lv_obj_t *screen, lvgl_port_mem_class_stats_t *stats, size_t max, size_t *count)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_mem_dump(FILE *out)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+#endif
@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_lvgl_port_priv.h"
+#include "lvgl.h"
+
+/* LVGL OS layer implementation, when LV_OS_CUSTOM is set with esp_lvgl_port_os.h */
+#if LV_USE_OS == LV_OS_CUSTOM && defined(LVGL_PORT_OS_CUSTOM)
+
+static const char *TAG = "LVGL";
+
+/* Draw threads configuration (from lvgl_port_init) */
+static int lvgl_port_os_priority = 4;
+static int lvgl_port_os_affinity = -1;
+
+/*******************************************************************************
+* Private API functions
+*******************************************************************************/
+
+void lvgl_port_os_config(int priority, int affinity)
+{
+    lvgl_port_os_priority = priority;
+    lvgl_port_os_affinity = affinity;
+}
+
+/*******************************************************************************
+* LVGL OS API functions
+*******************************************************************************/
+
+static void lvgl_port_os_thread(void *arg)
+{
+    lv_thread_t *thread = (lv_thread_t *)arg;
+    thread->callback(thread->user_data);
+    /* Thread function returned (deleted by LVGL) */
+    vTaskDelete(NULL);
+}
+
+#if LV_VERSION_CHECK(9, 3, 0)
+lv_result_t lv_thread_init(lv_thread_t *thread, const char *const name, lv_thread_prio_t prio, void (*callback)(void *), size_t stack_size, void *user_data)
+#else
+lv_result_t lv_thread_init(lv_thread_t *thread, lv_thread_prio_t prio, void (*callback)(void *), size_t stack_size, void *user_data)
+#endif
+{
+    BaseType_t res;
+#if LV_VERSION_CHECK(9, 3, 0)
+    const char *task_name = (name ? name : "taskLVGLDraw");
+#else
+    const char *task_name = "taskLVGLDraw";
+#endif
+    thread->callback = callback;
+    thread->user_data = user_data;
+
+    /* Draw threads are running with the same priority as LVGL task on selected core */
+    if (lvgl_port_os_affinity < 0) {
+        res = xTaskCreate(lvgl_port_os_thread, task_name, stack_size, thread, lvgl_port_os_priority, &thread->task);
+    } else {
+        res = xTaskCreatePinnedToCore(lvgl_port_os_thread, task_name, stack_size, thread, lvgl_port_os_priority, &thread->task, lvgl_port_os_affinity);
+    }
+    if (res != pdPASS) {
+        ESP_LOGE(TAG, "Create LVGL draw task fail!");
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_delete(lv_thread_t *thread)
+{
+    /* LVGL signals the thread to exit, the task is deleted after its function returns */
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_mutex_init(lv_mutex_t *mutex)
+{
+    mutex->mux = xSemaphoreCreateRecursiveMutex();
+    return (mutex->mux ? LV_RESULT_OK : LV_RESULT_INVALID);
+}
+
+lv_result_t lv_mutex_lock(lv_mutex_t *mutex)
+{
+    return (xSemaphoreTakeRecursive(mutex->mux, portMAX_DELAY) == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID);
+}
+
+lv_result_t lv_mutex_lock_isr(lv_mutex_t *mutex)
+{
+    /* Mutex cannot be taken from ISR */
+    return LV_RESULT_INVALID;
+}
+
+lv_result_t lv_mutex_unlock(lv_mutex_t *mutex)
+{
+    return (xSemaphoreGiveRecursive(mutex->mux) == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID);
+}
+
+lv_result_t lv_mutex_delete(lv_mutex_t *mutex)
+{
+    vSemaphoreDelete(mutex->mux);
+    mutex->mux = NULL;
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_init(lv_thread_sync_t *sync)
+{
+    sync->sem = xSemaphoreCreateBinary();
+    return (sync->sem ? LV_RESULT_OK : LV_RESULT_INVALID);
+}
+
+lv_result_t lv_thread_sync_wait(lv_thread_sync_t *sync)
+{
+    return (xSemaphoreTake(sync->sem, portMAX_DELAY) == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID);
+}
+
+lv_result_t lv_thread_sync_signal(lv_thread_sync_t *sync)
+{
+    xSemaphoreGive(sync->sem);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_signal_isr(lv_thread_sync_t *sync)
+{
+    BaseType_t need_yield = pdFALSE;
+    xSemaphoreGiveFromISR(sync->sem, &need_yield);
+    if (need_yield) {
+        portYIELD_FROM_ISR();
+    }
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_delete(lv_thread_sync_t *sync)
+{
+    vSemaphoreDelete(sync->sem);
+    sync->sem = NULL;
+    return LV_RESULT_OK;
+}
+
+uint32_t lv_os_get_idle_percent(void)
+{
+#if configGENERATE_RUN_TIME_STATS
+    return ulTaskGetIdleRunTimePercent();
+#else
+    return 0;
+#endif
+}
+
+#else
+
+void lvgl_port_os_config(int priority, int affinity)
+{
+    /* LVGL threads are not created by esp_lvgl_port */
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "lvgl.h"
+
+static const char *TAG = "LVGL";
+
+#define LVGL_PORT_PRELOAD_SLICE_MS_DEFAULT  (5)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef enum {
+    LVGL_PORT_PRELOAD_BUILD,        /* Build steps are called */
+    LVGL_PORT_PRELOAD_LAYOUT,       /* Steps are done, layout is updated in the next slice */
+    LVGL_PORT_PRELOAD_READY,
+} lvgl_port_preload_state_t;
+
+struct lvgl_port_preload_s {
+    lvgl_port_preload_cfg_t     cfg;
+    lv_obj_t                    *screen;    /* Created in the first slice */
+    uint32_t                    step;
+    lvgl_port_preload_state_t   state;
+    struct lvgl_port_preload_s  *next;      /* Next screen in the queue */
+};
+
+typedef struct {
+    lvgl_port_preload_handle_t  head;       /* Queue of screens in building (protected by LVGL lock) */
+} lvgl_port_preload_ctx_t;
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static lvgl_port_preload_ctx_t lvgl_port_preload_ctx;
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_preload_start(const lvgl_port_preload_cfg_t *cfg, lvgl_port_preload_handle_t *ret_handle)
+{
+    ESP_RETURN_ON_FALSE(cfg && cfg->step_cb && ret_handle, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    lvgl_port_preload_handle_t preload = LVGL_PORT_CTX_CALLOC(sizeof(struct lvgl_port_preload_s));
+    if (preload == NULL) {
+        lvgl_port_unlock();
+        ESP_LOGE(TAG, "Not enough memory for preloaded screen allocation!");
+        return ESP_ERR_NO_MEM;
+    }
+    preload->cfg = *cfg;
+    if (preload->cfg.slice_budget_ms == 0) {
+        preload->cfg.slice_budget_ms = LVGL_PORT_PRELOAD_SLICE_MS_DEFAULT;
+    }
+
+    /* Screens are built in order */
+    lvgl_port_preload_handle_t *last = &lvgl_port_preload_ctx.head;
+    while (*last) {
+        last = &(*last)->next;
+    }
+    *last = preload;
+    *ret_handle = preload;
+    lvgl_port_unlock();
+
+    /* LVGL task may sleep until the next timer */
+    lvgl_port_task_wake(LVGL_PORT_EVENT_USER, NULL);
+    return ESP_OK;
+}
+
+bool lvgl_port_preload_is_ready(lvgl_port_preload_handle_t handle)
+{
+    return (handle && handle->state == LVGL_PORT_PRELOAD_READY);
+}
+
+lv_obj_t *lvgl_port_preload_get_screen(lvgl_port_preload_handle_t handle)
+{
+    return (lvgl_port_preload_is_ready(handle) ? handle->screen : NULL);
+}
+
+esp_err_t lvgl_port_preload_delete(lvgl_port_preload_handle_t handle, bool del_screen)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    lvgl_port_lock(0);
+    for (lvgl_port_preload_handle_t *item = &lvgl_port_preload_ctx.head; *item; item = &(*item)->next) {
+        if (*item == handle) {
+            *item = handle->next;
+            break;
+        }
+    }
+    if (handle->screen && (del_screen || handle->state != LVGL_PORT_PRELOAD_READY)) {
+        lv_obj_delete(handle->screen);
+    }
+    LVGL_PORT_CTX_FREE(handle);
+    lvgl_port_unlock();
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private API functions
+*******************************************************************************/
+
+uint32_t lvgl_port_preload_run(uint32_t idle_ms)
+{
+    lvgl_port_preload_ctx_t *ctx = &lvgl_port_preload_ctx;
+    lvgl_port_preload_handle_t preload = ctx->head;
+    if (preload == NULL) {
+        return idle_ms;
+    }
+
+    const uint32_t budget_ms = LV_MIN(preload->cfg.slice_budget_ms, idle_ms);
+    const int64_t start = esp_timer_get_time();
+    do {
+        if (preload->screen == NULL) {
+            /* lv_obj_create(NULL) creates the screen on the default display */
+            lv_display_t *def_disp = lv_display_get_default();
+            if (preload->cfg.disp) {
+                lv_display_set_default(preload->cfg.disp);
+            }
+            preload->screen = lv_obj_create(NULL);
+            lv_display_set_default(def_disp);
+            if (preload->screen == NULL) {
+                ESP_LOGE(TAG, "Create preloaded screen fail!");
+                break;
+            }
+        }
+
+        if (preload->state == LVGL_PORT_PRELOAD_BUILD) {
+            if (preload->cfg.step_cb(preload->screen, preload->step++, preload->cfg.user_ctx)) {
+                preload->state = LVGL_PORT_PRELOAD_LAYOUT;
+                break;
+            }
+        } else {
+            /* Layout in its own slice, it is not done by the first refresh after lv_screen_load */
+            lv_obj_update_layout(preload->screen);
+            preload->state = LVGL_PORT_PRELOAD_READY;
+            ctx->head = preload->next;
+            preload->next = NULL;
+            /* The handle may be deleted in the callback */
+            if (preload->cfg.ready_cb) {
+                preload->cfg.ready_cb(preload, preload->screen, preload->cfg.user_ctx);
+            }
+            break;
+        }
+    } while (esp_timer_get_time() - start < (int64_t)budget_ms * 1000);
+
+    const uint32_t elapsed_ms = (uint32_t)((esp_timer_get_time() - start) / 1000);
+    const uint32_t left_ms = (idle_ms > elapsed_ms ? idle_ms - elapsed_ms : 0);
+    /* Pause between slices is the slice budget, when there is more to build */
+    if (ctx->head) {
+        return LV_MIN(left_ms, ctx->head->cfg.slice_budget_ms);
+    }
+    return left_ms;
+}
+
+void lvgl_port_preload_deinit(void)
+{
+    lvgl_port_preload_ctx_t *ctx = &lvgl_port_preload_ctx;
+    lvgl_port_lock(0);
+    while (ctx->head) {
+        lvgl_port_preload_handle_t preload = ctx->head;
+        ctx->head = preload->next;
+        if (preload->screen) {
+            lv_obj_delete(preload->screen);
+        }
+        LVGL_PORT_CTX_FREE(preload);
+    }
+    lvgl_port_unlock();
+}
@@ -0,0 +1,322 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_quality.h"
+#include "lvgl.h"
+
+static const char *TAG = "LVGL";
+
+#if CONFIG_LVGL_PORT_QUALITY
+
+#define LVGL_PORT_QUALITY_RESTORE_DEFAULT   (60)
+#define LVGL_PORT_QUALITY_HOLD_DEFAULT      (2)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+/* Registered style with its own shadow width */
+typedef struct {
+    lv_style_t          *style;
+    int32_t             shadow_width;   /* Shadow width set in the style */
+    bool                has_shadow;     /* Style sets shadow width */
+} lvgl_port_quality_style_t;
+
+typedef struct {
+    lv_display_t        *disp;          /* Controlled display, NULL when stopped */
+    lvgl_port_quality_cfg_t cfg;
+    lv_timer_t          *timer;         /* Check of each stats window */
+    lvgl_port_quality_level_t level;
+    lvgl_port_disp_counters_t last;     /* Last evaluated window */
+    uint8_t             over;           /* Consecutive windows over the budget */
+    uint8_t             under;          /* Consecutive windows below the restore threshold */
+    bool                antialiasing;   /* Anti-aliasing of the display before start */
+    bool                no_shadows;     /* Shadows of registered styles are off */
+    lvgl_port_quality_style_t *styles;
+    uint32_t            style_count;
+} lvgl_port_quality_ctx_t;
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static lvgl_port_quality_ctx_t lvgl_port_quality;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void lvgl_port_quality_apply(lvgl_port_quality_level_t level);
+static void lvgl_port_quality_style_shadow(lvgl_port_quality_style_t *entry, bool off);
+static void lvgl_port_quality_timer_cb(lv_timer_t *timer);
+static void lvgl_port_quality_disp_delete_cb(lv_event_t *e);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_quality_start(lv_display_t *disp, const lvgl_port_quality_cfg_t *cfg)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(disp && cfg, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    ESP_RETURN_ON_FALSE(!cfg->large_buf1 || cfg->large_buf_size, ESP_ERR_INVALID_ARG, TAG, "Size of larger draw buffers is missing!");
+    ESP_RETURN_ON_FALSE(cfg->max_level <= LVGL_PORT_QUALITY_LOW_ANIM_RATE, ESP_ERR_INVALID_ARG, TAG, "invalid level");
+
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    lvgl_port_quality_ctx_t *ctx = &lvgl_port_quality;
+    ESP_GOTO_ON_FALSE(ctx->disp == NULL, ESP_ERR_INVALID_STATE, err, TAG, "Adaptive render quality already started");
+
+    ctx->cfg = *cfg;
+    if (ctx->cfg.frame_budget_us == 0) {
+        ctx->cfg.frame_budget_us = LV_DEF_REFR_PERIOD * 1000;
+    }
+    if (ctx->cfg.restore_percent == 0) {
+        ctx->cfg.restore_percent = LVGL_PORT_QUALITY_RESTORE_DEFAULT;
+    }
+    if (ctx->cfg.hold_windows == 0) {
+        ctx->cfg.hold_windows = LVGL_PORT_QUALITY_HOLD_DEFAULT;
+    }
+    if (ctx->cfg.max_level == LVGL_PORT_QUALITY_FULL) {
+        ctx->cfg.max_level = LVGL_PORT_QUALITY_LOW_ANIM_RATE;
+    }
+    if (ctx->cfg.anim_period_ms == 0) {
+        ctx->cfg.anim_period_ms = LV_DEF_REFR_PERIOD * 2;
+    }
+
+    ctx->timer = lv_timer_create(lvgl_port_quality_timer_cb, CONFIG_LVGL_PORT_STATS_WINDOW_MS, ctx);
+    ESP_GOTO_ON_FALSE(ctx->timer, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for adaptive render quality timer!");
+    ctx->disp = disp;
+    ctx->level = LVGL_PORT_QUALITY_FULL;
+    ctx->over = 0;
+    ctx->under = 0;
+    ctx->antialiasing = lv_display_get_antialiasing(disp);
+    memset(&ctx->last, 0, sizeof(ctx->last));
+    lv_display_add_event_cb(disp, lvgl_port_quality_disp_delete_cb, LV_EVENT_DELETE, ctx);
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_quality_stop(void)
+{
+    esp_err_t ret = ESP_OK;
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    lvgl_port_quality_ctx_t *ctx = &lvgl_port_quality;
+    ESP_GOTO_ON_FALSE(ctx->disp, ESP_ERR_INVALID_STATE, err, TAG, "Adaptive render quality not started");
+
+    lvgl_port_quality_apply(LVGL_PORT_QUALITY_FULL);
+    lv_display_remove_event_cb_with_user_data(ctx->disp, lvgl_port_quality_disp_delete_cb, ctx);
+    lv_timer_delete(ctx->timer);
+    ctx->timer = NULL;
+    ctx->disp = NULL;
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_quality_add_style(lv_style_t *style)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(style, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    lvgl_port_quality_ctx_t *ctx = &lvgl_port_quality;
+    for (uint32_t i = 0; i < ctx->style_count; i++) {
+        if (ctx->styles[i].style == style) {
+            goto err;
+        }
+    }
+
+    lvgl_port_quality_style_t *styles = lv_realloc(ctx->styles, (ctx->style_count + 1) * sizeof(lvgl_port_quality_style_t));
+    ESP_GOTO_ON_FALSE(styles, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for style registration!");
+    ctx->styles = styles;
+
+    lvgl_port_quality_style_t *entry = &styles[ctx->style_count++];
+    lv_style_value_t value = { 0 };
+    entry->style = style;
+    entry->has_shadow = (lv_style_get_prop(style, LV_STYLE_SHADOW_WIDTH, &value) == LV_STYLE_RES_FOUND);
+    entry->shadow_width = value.num;
+    if (ctx->no_shadows) {
+        lvgl_port_quality_style_shadow(entry, true);
+    }
+
+err:
+    lvgl_port_unlock();
+    return ret;
+}
+
+esp_err_t lvgl_port_quality_remove_style(lv_style_t *style)
+{
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    ESP_RETURN_ON_FALSE(style, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    if (!lvgl_port_lock(0)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    lvgl_port_quality_ctx_t *ctx = &lvgl_port_quality;
+    for (uint32_t i = 0; i < ctx->style_count; i++) {
+        if (ctx->styles[i].style == style) {
+            lvgl_port_quality_style_shadow(&ctx->styles[i], false);
+            ctx->styles[i] = ctx->styles[--ctx->style_count];
+            ret = ESP_OK;
+            break;
+        }
+    }
+    if (ctx->style_count == 0) {
+        lv_free(ctx->styles);
+        ctx->styles = NULL;
+    }
+
+    lvgl_port_unlock();
+    return ret;
+}
+
+lvgl_port_quality_level_t lvgl_port_quality_get_level(void)
+{
+    return lvgl_port_quality.level;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void lvgl_port_quality_style_shadow(lvgl_port_quality_style_t *entry, bool off)
+{
+    if (!entry->has_shadow || entry->shadow_width == 0) {
+        return;
+    }
+    lv_style_set_shadow_width(entry->style, off ? 0 : entry->shadow_width);
+    lv_obj_report_style_change(entry->style);
+}
+
+static void lvgl_port_quality_apply(lvgl_port_quality_level_t level)
+{
+    lvgl_port_quality_ctx_t *ctx = &lvgl_port_quality;
+
+    if (ctx->cfg.large_buf1 && (level >= LVGL_PORT_QUALITY_LARGE_BUFFERS) != (ctx->level >= LVGL_PORT_QUALITY_LARGE_BUFFERS)) {
+        const bool large = (level >= LVGL_PORT_QUALITY_LARGE_BUFFERS);
+        if (lvgl_port_disp_set_draw_buffers(ctx->disp, large ? ctx->cfg.large_buf1 : NULL, ctx->cfg.large_buf2, ctx->cfg.large_buf_size) != ESP_OK) {
+            ESP_LOGW(TAG, "Larger draw buffers are not used");
+            ctx->cfg.large_buf1 = NULL;
+        }
+    }
+
+    const bool no_shadows = (level >= LVGL_PORT_QUALITY_NO_SHADOWS);
+    if (no_shadows != ctx->no_shadows) {
+        ctx->no_shadows = no_shadows;
+        for (uint32_t i = 0; i < ctx->style_count; i++) {
+            lvgl_port_quality_style_shadow(&ctx->styles[i], no_shadows);
+        }
+    }
+
+    lv_display_set_antialiasing(ctx->disp, (level >= LVGL_PORT_QUALITY_NO_ANTIALIAS) ? false : ctx->antialiasing);
+
+    lv_timer_t *anim_timer = lv_anim_get_timer();
+    if (anim_timer) {
+        lv_timer_set_period(anim_timer, (level >= LVGL_PORT_QUALITY_LOW_ANIM_RATE) ? ctx->cfg.anim_period_ms : LV_DEF_REFR_PERIOD);
+    }
+
+    ctx->level = level;
+}
+
+static void lvgl_port_quality_timer_cb(lv_timer_t *timer)
+{
+    lvgl_port_quality_ctx_t *ctx = (lvgl_port_quality_ctx_t *)lv_timer_get_user_data(timer);
+    lvgl_port_disp_stats_t stats;
+    if (lvgl_port_get_disp_stats(ctx->disp, &stats) != ESP_OK || memcmp(&stats.window, &ctx->last, sizeof(ctx->last)) == 0) {
+        return;
+    }
+    ctx->last = stats.window;
+
+    /* Window without frames is an idle UI */
+    const uint32_t frame_us = (stats.window.frames ? (uint32_t)(stats.window.render_us / stats.window.frames) : 0);
+    const uint32_t restore_us = (uint32_t)((uint64_t)ctx->cfg.frame_budget_us * ctx->cfg.restore_percent / 100);
+    lvgl_port_quality_level_t level = ctx->level;
+
+    if (frame_us > ctx->cfg.frame_budget_us) {
+        ctx->under = 0;
+        if (++ctx->over >= ctx->cfg.hold_windows && level < ctx->cfg.max_level) {
+            level++;
+        }
+    } else if (frame_us < restore_us) {
+        ctx->over = 0;
+        if (++ctx->under >= ctx->cfg.hold_windows && level > LVGL_PORT_QUALITY_FULL) {
+            level--;
+        }
+    } else {
+        ctx->over = 0;
+        ctx->under = 0;
+    }
+    /* Level of larger buffers does nothing without them */
+    if (level == LVGL_PORT_QUALITY_LARGE_BUFFERS && !ctx->cfg.large_buf1) {
+        level = (level > ctx->level) ? LV_MIN(LVGL_PORT_QUALITY_NO_SHADOWS, ctx->cfg.max_level) : LVGL_PORT_QUALITY_FULL;
+    }
+    if (level == ctx->level) {
+        return;
+    }
+
+    ESP_LOGD(TAG, "Render quality level %d (frame %"PRIu32" us, budget %"PRIu32" us)", (int)level, frame_us, ctx->cfg.frame_budget_us);
+    ctx->over = 0;
+    ctx->under = 0;
+    lvgl_port_quality_apply(level);
+    if (ctx->cfg.changed_cb) {
+        ctx->cfg.changed_cb(ctx->disp, level, frame_us, ctx->cfg.user_ctx);
+    }
+}
+
+static void lvgl_port_quality_disp_delete_cb(lv_event_t *e)
+{
+    lvgl_port_quality_ctx_t *ctx = (lvgl_port_quality_ctx_t *)lv_event_get_user_data(e);
+
+    /* Styles and animations are shared with other displays */
+    ctx->cfg.large_buf1 = NULL;
+    lvgl_port_quality_apply(LVGL_PORT_QUALITY_FULL);
+    lv_timer_delete(ctx->timer);
+    ctx->timer = NULL;
+    ctx->disp = NULL;
+}
+
+#else
+
+esp_err_t lvgl_port_quality_start(lv_display_t *disp, const lvgl_port_quality_cfg_t *cfg)
+{
+    ESP_LOGE(TAG, "Adaptive render quality is disabled (CONFIG_LVGL_PORT_QUALITY)");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_quality_stop(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_quality_add_style(lv_style_t *style)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_quality_remove_style(lv_style_t *style)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+lvgl_port_quality_level_t lvgl_port_quality_get_level(void)
+{
+    return LVGL_PORT_QUALITY_FULL;
+}
+
+#endif
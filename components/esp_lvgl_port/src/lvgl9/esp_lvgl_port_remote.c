@@ -0,0 +1,580 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "lvgl.h"
+#include "esp_lvgl_port_remote.h"
+#include "esp_lvgl_port_priv.h"
+
+#if CONFIG_LVGL_PORT_REMOTE_VIEW
+#include "lwip/sockets.h"
+
+static const char *TAG = "LVGL";
+
+#define LVGL_PORT_REMOTE_DEF_RECTS      (16)
+#define LVGL_PORT_REMOTE_DEF_BUFFER     (16 * 1024)
+#define LVGL_PORT_REMOTE_DEF_STACK      (3072)
+/* Period of checking the stop request, while the task waits for the socket */
+#define LVGL_PORT_REMOTE_POLL_MS        (100)
+
+/* Stream: magic, version, pixel format, then messages of header and payload */
+#define LVGL_PORT_REMOTE_MAGIC          "LPRV"
+#define LVGL_PORT_REMOTE_VERSION        (1)
+#define LVGL_PORT_REMOTE_FORMAT_RGB565  (1)
+#define LVGL_PORT_REMOTE_MSG_RECT       (1)     /* Compressed pixels of x, y, w, h */
+#define LVGL_PORT_REMOTE_MSG_RESOLUTION (2)     /* New resolution w, h (display rotated) */
+/* Type, reserved, x, y, w, h (16 bits), payload length (32 bits), little endian */
+#define LVGL_PORT_REMOTE_MSG_HEADER     (14)
+
+/* Pixel codes, state is reset in each message */
+#define LVGL_PORT_REMOTE_OP_INDEX       (0x00)  /* 00iiiiii: pixel from the table of recent pixels */
+#define LVGL_PORT_REMOTE_OP_DIFF        (0x40)  /* 01rrggbb: difference -2..1 of each component from previous pixel */
+#define LVGL_PORT_REMOTE_OP_LUMA        (0x80)  /* 10gggggg rrrrbbbb: green -32..31, red and blue -8..7 */
+#define LVGL_PORT_REMOTE_OP_RUN         (0xC0)  /* 11nnnnnn: previous pixel repeated 1..62 times */
+#define LVGL_PORT_REMOTE_OP_RAW         (0xFE)  /* Pixel follows (2 bytes) */
+#define LVGL_PORT_REMOTE_MAX_RUN        (62)
+/* Each pixel is coded in at most 3 bytes */
+#define LVGL_PORT_REMOTE_MAX_PX_BYTES   (3)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct lvgl_port_remote_s {
+    lv_display_t                *disp;
+    lvgl_port_remote_t          *next;
+    lvgl_port_remote_cfg_t      cfg;
+    bool                        active;         /* Flushed areas are copied (changed with LVGL lock) */
+    uint16_t                    *shadow;        /* RGB565 copy of the display, rows of hres pixels */
+    uint32_t                    shadow_px;
+    uint8_t                     *buf;           /* Message header and compressed pixels */
+    TaskHandle_t                task;
+    SemaphoreHandle_t           done;           /* Given by the task at its end */
+    volatile bool               stop;
+    /* Shared with the task */
+    portMUX_TYPE                lock;
+    int32_t                     hres;           /* Resolution of the shadow (rotated) */
+    int32_t                     vres;
+    bool                        resized;        /* Resolution not sent yet */
+    lv_area_t                   *rects;         /* Queue of dirty rectangles */
+    uint16_t                    count;
+    lvgl_port_remote_stats_t    stats;
+    /* Used only by the task */
+    int64_t                     next_send_us;   /* Bandwidth limit */
+    int64_t                     window_start;
+    uint32_t                    window_bytes;
+};
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+/* Remote views of all displays, only accessed with LVGL lock */
+static lvgl_port_remote_t *lvgl_port_remotes = NULL;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void lvgl_port_remote_task(void *arg);
+static void lvgl_port_remote_event_callback(lv_event_t *e);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+static lvgl_port_remote_t *lvgl_port_remote_find(lv_display_t *disp)
+{
+    for (lvgl_port_remote_t *rv = lvgl_port_remotes; rv; rv = rv->next) {
+        if (rv->disp == disp) {
+            return rv;
+        }
+    }
+    return NULL;
+}
+
+static void lvgl_port_remote_free(lvgl_port_remote_t *rv)
+{
+    if (rv->done) {
+        vSemaphoreDelete(rv->done);
+        rv->done = NULL;
+    }
+    heap_caps_free(rv->shadow);
+    rv->shadow = NULL;
+    free(rv->rects);
+    rv->rects = NULL;
+    free(rv->buf);
+    rv->buf = NULL;
+}
+
+esp_err_t lvgl_port_remote_start(lv_display_t *disp, const lvgl_port_remote_cfg_t *cfg)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(disp && cfg && cfg->sock >= 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(cfg->task_affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, TAG, "Bad core number for remote view task!");
+    lvgl_port_remote_t *rv = lvgl_port_remote_find(disp);
+    ESP_RETURN_ON_FALSE(rv, ESP_ERR_NOT_FOUND, TAG, "display without remote view");
+    ESP_RETURN_ON_FALSE(rv->task == NULL, ESP_ERR_INVALID_STATE, TAG, "remote view already started");
+    const lv_color_format_t cf = lv_display_get_color_format(disp);
+    ESP_RETURN_ON_FALSE(cf == LV_COLOR_FORMAT_RGB565 || cf == LV_COLOR_FORMAT_RGB888 || cf == LV_COLOR_FORMAT_XRGB8888 || cf == LV_COLOR_FORMAT_ARGB8888,
+                        ESP_ERR_NOT_SUPPORTED, TAG, "Remote view of this color format is not supported!");
+
+    rv->cfg = *cfg;
+    if (rv->cfg.max_rects == 0) {
+        rv->cfg.max_rects = LVGL_PORT_REMOTE_DEF_RECTS;
+    }
+    if (rv->cfg.buffer_size == 0) {
+        rv->cfg.buffer_size = LVGL_PORT_REMOTE_DEF_BUFFER;
+    }
+    if (rv->cfg.task_priority == 0) {
+        rv->cfg.task_priority = tskIDLE_PRIORITY + 1;
+    }
+    if (rv->cfg.task_stack == 0) {
+        rv->cfg.task_stack = LVGL_PORT_REMOTE_DEF_STACK;
+    }
+    const int32_t hres = lv_display_get_horizontal_resolution(disp);
+    const int32_t vres = lv_display_get_vertical_resolution(disp);
+    ESP_RETURN_ON_FALSE(rv->cfg.buffer_size >= LVGL_PORT_REMOTE_MSG_HEADER + hres * LVGL_PORT_REMOTE_MAX_PX_BYTES, ESP_ERR_INVALID_ARG, TAG,
+                        "Remote view buffer must fit one row!");
+
+    /* Shadow of the whole display is large, PSRAM is preferred */
+    rv->shadow_px = hres * vres;
+    rv->shadow = heap_caps_calloc(rv->shadow_px, sizeof(uint16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (rv->shadow == NULL) {
+        rv->shadow = heap_caps_calloc(rv->shadow_px, sizeof(uint16_t), MALLOC_CAP_DEFAULT);
+    }
+    ESP_GOTO_ON_FALSE(rv->shadow, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for remote view shadow!");
+    rv->rects = calloc(rv->cfg.max_rects, sizeof(lv_area_t));
+    ESP_GOTO_ON_FALSE(rv->rects, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for remote view queue!");
+    rv->buf = malloc(rv->cfg.buffer_size);
+    ESP_GOTO_ON_FALSE(rv->buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for remote view buffer!");
+    rv->done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(rv->done, ESP_ERR_NO_MEM, err, TAG, "Create remote view semaphore fail!");
+
+    rv->hres = hres;
+    rv->vres = vres;
+    rv->resized = true;
+    rv->count = 0;
+    memset(&rv->stats, 0, sizeof(rv->stats));
+    rv->stats.connected = true;
+    rv->stop = false;
+
+    BaseType_t res;
+    if (rv->cfg.task_affinity < 0) {
+        res = xTaskCreate(lvgl_port_remote_task, "LVGL remote", rv->cfg.task_stack, rv, rv->cfg.task_priority, &rv->task);
+    } else {
+        res = xTaskCreatePinnedToCore(lvgl_port_remote_task, "LVGL remote", rv->cfg.task_stack, rv, rv->cfg.task_priority, &rv->task, rv->cfg.task_affinity);
+    }
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create remote view task fail!");
+
+    /* All of the display is rendered into the shadow */
+    rv->active = true;
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    return ESP_OK;
+
+err:
+    rv->task = NULL;
+    lvgl_port_remote_free(rv);
+    return ret;
+}
+
+esp_err_t lvgl_port_remote_stop(lv_display_t *disp)
+{
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_remote_t *rv = lvgl_port_remote_find(disp);
+    ESP_RETURN_ON_FALSE(rv, ESP_ERR_NOT_FOUND, TAG, "display without remote view");
+    if (rv->task == NULL) {
+        return ESP_OK;
+    }
+
+    /* The task does not take LVGL lock, it ends after its current wait for the socket */
+    rv->active = false;
+    rv->stop = true;
+    xTaskNotifyGive(rv->task);
+    xSemaphoreTake(rv->done, portMAX_DELAY);
+    rv->task = NULL;
+    lvgl_port_remote_free(rv);
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_remote_get_stats(lv_display_t *disp, lvgl_port_remote_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(disp && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_remote_t *rv = lvgl_port_remote_find(disp);
+    ESP_RETURN_ON_FALSE(rv, ESP_ERR_NOT_FOUND, TAG, "display without remote view");
+    portENTER_CRITICAL(&rv->lock);
+    *stats = rv->stats;
+    portEXIT_CRITICAL(&rv->lock);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+lvgl_port_remote_t *lvgl_port_remote_create(lv_display_t *disp)
+{
+    lvgl_port_remote_t *rv = calloc(1, sizeof(lvgl_port_remote_t));
+    if (rv == NULL) {
+        return NULL;
+    }
+    rv->disp = disp;
+    portMUX_INITIALIZE(&rv->lock);
+    lv_display_add_event_cb(disp, lvgl_port_remote_event_callback, LV_EVENT_RESOLUTION_CHANGED, rv);
+    rv->next = lvgl_port_remotes;
+    lvgl_port_remotes = rv;
+    return rv;
+}
+
+void lvgl_port_remote_delete(lvgl_port_remote_t *rv)
+{
+    if (rv == NULL) {
+        return;
+    }
+    lvgl_port_remote_stop(rv->disp);
+    for (lvgl_port_remote_t **p = &lvgl_port_remotes; *p; p = &(*p)->next) {
+        if (*p == rv) {
+            *p = rv->next;
+            break;
+        }
+    }
+    free(rv);
+}
+
+/* Areas overlap or touch, so their union does not cover much more */
+static inline bool lvgl_port_remote_adjacent(const lv_area_t *a, const lv_area_t *b)
+{
+    return (a->x1 <= b->x2 + 1 && b->x1 <= a->x2 + 1 && a->y1 <= b->y2 + 1 && b->y1 <= a->y2 + 1);
+}
+
+static inline void lvgl_port_remote_join(lv_area_t *dest, const lv_area_t *area)
+{
+    dest->x1 = LV_MIN(dest->x1, area->x1);
+    dest->y1 = LV_MIN(dest->y1, area->y1);
+    dest->x2 = LV_MAX(dest->x2, area->x2);
+    dest->y2 = LV_MAX(dest->y2, area->y2);
+}
+
+/* Called with the lock, it never waits for the task */
+static void lvgl_port_remote_queue(lvgl_port_remote_t *rv, const lv_area_t *area)
+{
+    rv->stats.updates++;
+    for (uint16_t i = 0; i < rv->count; i++) {
+        if (lvgl_port_remote_adjacent(&rv->rects[i], area)) {
+            lvgl_port_remote_join(&rv->rects[i], area);
+            rv->stats.merged++;
+            return;
+        }
+    }
+    if (rv->count < rv->cfg.max_rects) {
+        rv->rects[rv->count++] = *area;
+        return;
+    }
+
+    /* Queue is full, the area is sent with the rectangle growing the least */
+    uint16_t best = 0;
+    uint32_t best_growth = UINT32_MAX;
+    for (uint16_t i = 0; i < rv->count; i++) {
+        lv_area_t joined = rv->rects[i];
+        lvgl_port_remote_join(&joined, area);
+        const uint32_t growth = lv_area_get_size(&joined) - lv_area_get_size(&rv->rects[i]);
+        if (growth < best_growth) {
+            best_growth = growth;
+            best = i;
+        }
+    }
+    lvgl_port_remote_join(&rv->rects[best], area);
+    rv->stats.dropped++;
+}
+
+void lvgl_port_remote_flush(lvgl_port_remote_t *rv, const lv_area_t *area, const uint8_t *color_map, bool direct)
+{
+    if (rv == NULL || !rv->active || !rv->stats.connected) {
+        return;
+    }
+    const int32_t hres = rv->hres;
+    lv_area_t a = {
+        .x1 = LV_MAX(area->x1, 0),
+        .y1 = LV_MAX(area->y1, 0),
+        .x2 = LV_MIN(area->x2, hres - 1),
+        .y2 = LV_MIN(area->y2, rv->vres - 1),
+    };
+    if (a.x1 > a.x2 || a.y1 > a.y2) {
+        return;
+    }
+
+    /* In direct mode, the buffer is the whole display */
+    const lv_color_format_t cf = lv_display_get_color_format(rv->disp);
+    const uint32_t px_size = lv_color_format_get_size(cf);
+    const uint32_t stride = lv_draw_buf_width_to_stride(direct ? hres : lv_area_get_width(area), cf);
+    const uint8_t *src = color_map + (direct ? a.y1 * stride + a.x1 * px_size : (a.y1 - area->y1) * stride + (a.x1 - area->x1) * px_size);
+    const int32_t w = lv_area_get_width(&a);
+    uint16_t *dest = rv->shadow + a.y1 * hres + a.x1;
+    for (int32_t y = a.y1; y <= a.y2; y++) {
+        if (cf == LV_COLOR_FORMAT_RGB565) {
+            memcpy(dest, src, w * sizeof(uint16_t));
+        } else {
+            /* Blue, green, red (and alpha) bytes */
+            const uint8_t *px = src;
+            for (int32_t x = 0; x < w; x++) {
+                dest[x] = ((px[2] & 0xF8) << 8) | ((px[1] & 0xFC) << 3) | (px[0] >> 3);
+                px += px_size;
+            }
+        }
+        src += stride;
+        dest += hres;
+    }
+
+    /* Queued after the copy, the task reads the shadow after it takes the rectangle */
+    portENTER_CRITICAL(&rv->lock);
+    lvgl_port_remote_queue(rv, &a);
+    portEXIT_CRITICAL(&rv->lock);
+    xTaskNotifyGive(rv->task);
+}
+
+static void lvgl_port_remote_event_callback(lv_event_t *e)
+{
+    lvgl_port_remote_t *rv = (lvgl_port_remote_t *)lv_event_get_user_data(e);
+    if (rv->task == NULL) {
+        return;
+    }
+    /* Rotation keeps the size of the shadow, the display is redrawn whole after it */
+    int32_t hres = lv_display_get_horizontal_resolution(rv->disp);
+    int32_t vres = lv_display_get_vertical_resolution(rv->disp);
+    if ((uint32_t)(hres * vres) > rv->shadow_px) {
+        ESP_LOGW(TAG, "Remote view shadow is smaller than new resolution, the display is not sent");
+        hres = 0;
+        vres = 0;
+    }
+    portENTER_CRITICAL(&rv->lock);
+    rv->hres = hres;
+    rv->vres = vres;
+    rv->resized = true;
+    rv->count = 0;
+    portEXIT_CRITICAL(&rv->lock);
+    xTaskNotifyGive(rv->task);
+}
+
+static inline void lvgl_port_remote_put16(uint8_t *p, uint16_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void lvgl_port_remote_header(uint8_t *p, uint8_t type, const lv_area_t *area, uint32_t len)
+{
+    p[0] = type;
+    p[1] = 0;
+    lvgl_port_remote_put16(&p[2], area->x1);
+    lvgl_port_remote_put16(&p[4], area->y1);
+    lvgl_port_remote_put16(&p[6], lv_area_get_width(area));
+    lvgl_port_remote_put16(&p[8], lv_area_get_height(area));
+    lvgl_port_remote_put16(&p[10], len & 0xFFFF);
+    lvgl_port_remote_put16(&p[12], len >> 16);
+}
+
+/* QOI-like coding of RGB565 pixels: runs, recent pixels and small differences from the previous pixel */
+static size_t lvgl_port_remote_encode(const uint16_t *src, uint32_t stride_px, int32_t w, int32_t h, uint8_t *out)
+{
+    uint16_t index[64] = {0};
+    uint16_t prev = 0;
+    uint32_t run = 0;
+    uint8_t *p = out;
+    for (int32_t y = 0; y < h; y++) {
+        const uint16_t *row = src + y * stride_px;
+        for (int32_t x = 0; x < w; x++) {
+            const uint16_t px = row[x];
+            if (px == prev) {
+                if (++run == LVGL_PORT_REMOTE_MAX_RUN) {
+                    *p++ = LVGL_PORT_REMOTE_OP_RUN | (run - 1);
+                    run = 0;
+                }
+                continue;
+            }
+            if (run) {
+                *p++ = LVGL_PORT_REMOTE_OP_RUN | (run - 1);
+                run = 0;
+            }
+
+            const uint8_t r = px >> 11;
+            const uint8_t g = (px >> 5) & 0x3F;
+            const uint8_t b = px & 0x1F;
+            const uint8_t hash = (r * 3 + g * 5 + b * 7) & 0x3F;
+            if (index[hash] == px) {
+                *p++ = LVGL_PORT_REMOTE_OP_INDEX | hash;
+            } else {
+                index[hash] = px;
+                /* Differences wrap around, like in the decoder */
+                const int dr = ((r - (prev >> 11) + 16) & 0x1F) - 16;
+                const int dg = ((g - ((prev >> 5) & 0x3F) + 32) & 0x3F) - 32;
+                const int db = ((b - (prev & 0x1F) + 16) & 0x1F) - 16;
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    *p++ = LVGL_PORT_REMOTE_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2);
+                } else if (dr >= -8 && dr <= 7 && db >= -8 && db <= 7) {
+                    *p++ = LVGL_PORT_REMOTE_OP_LUMA | (dg + 32);
+                    *p++ = ((dr + 8) << 4) | (db + 8);
+                } else {
+                    *p++ = LVGL_PORT_REMOTE_OP_RAW;
+                    lvgl_port_remote_put16(p, px);
+                    p += 2;
+                }
+            }
+            prev = px;
+        }
+    }
+    if (run) {
+        *p++ = LVGL_PORT_REMOTE_OP_RUN | (run - 1);
+    }
+    return p - out;
+}
+
+/* Returns false on error of the socket or stop request */
+static bool lvgl_port_remote_send(lvgl_port_remote_t *rv, const uint8_t *data, size_t len)
+{
+    int64_t now = esp_timer_get_time();
+    if (rv->cfg.max_bytes_per_sec) {
+        /* Bytes are sent after the time of the previous bytes at the limit */
+        if (rv->next_send_us > now) {
+            rv->stats.send_waits++;
+        }
+        while (rv->next_send_us > now && !rv->stop) {
+            vTaskDelay(pdMS_TO_TICKS(LV_MIN((rv->next_send_us - now) / 1000, LVGL_PORT_REMOTE_POLL_MS)) + 1);
+            now = esp_timer_get_time();
+        }
+        rv->next_send_us = LV_MAX(rv->next_send_us, now) + (int64_t)len * 1000000 / rv->cfg.max_bytes_per_sec;
+    }
+
+    while (len > 0) {
+        if (rv->stop) {
+            return false;
+        }
+        const ssize_t sent = send(rv->cfg.sock, data, len, MSG_DONTWAIT);
+        if (sent > 0) {
+            data += sent;
+            len -= sent;
+            portENTER_CRITICAL(&rv->lock);
+            rv->stats.sent_bytes += sent;
+            portEXIT_CRITICAL(&rv->lock);
+            rv->window_bytes += sent;
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            /* Socket buffer is full, flushing goes on meanwhile */
+            rv->stats.send_waits++;
+            fd_set wfds;
+            FD_ZERO(&wfds);
+            FD_SET(rv->cfg.sock, &wfds);
+            struct timeval tv = {
+                .tv_sec = 0,
+                .tv_usec = LVGL_PORT_REMOTE_POLL_MS * 1000,
+            };
+            select(rv->cfg.sock + 1, NULL, &wfds, NULL, &tv);
+            continue;
+        }
+        ESP_LOGE(TAG, "Remote view send failed (errno %d), the stream is stopped", errno);
+        rv->stats.connected = false;
+        return false;
+    }
+
+    now = esp_timer_get_time();
+    if (now - rv->window_start >= 1000000) {
+        rv->stats.bytes_per_sec = (uint32_t)((int64_t)rv->window_bytes * 1000000 / (now - rv->window_start));
+        rv->window_start = now;
+        rv->window_bytes = 0;
+    }
+    return true;
+}
+
+static void lvgl_port_remote_task(void *arg)
+{
+    lvgl_port_remote_t *rv = (lvgl_port_remote_t *)arg;
+    rv->next_send_us = 0;
+    rv->window_start = esp_timer_get_time();
+    rv->window_bytes = 0;
+
+    uint8_t *buf = rv->buf;
+    memcpy(buf, LVGL_PORT_REMOTE_MAGIC, 4);
+    buf[4] = LVGL_PORT_REMOTE_VERSION;
+    buf[5] = LVGL_PORT_REMOTE_FORMAT_RGB565;
+    bool ok = lvgl_port_remote_send(rv, buf, 6);
+
+    while (ok && !rv->stop) {
+        /* Oldest rectangle (with the areas merged into it) */
+        lv_area_t area;
+        bool have_area = false;
+        portENTER_CRITICAL(&rv->lock);
+        const bool resized = rv->resized;
+        rv->resized = false;
+        const int32_t hres = rv->hres;
+        const int32_t vres = rv->vres;
+        if (rv->count > 0) {
+            area = rv->rects[0];
+            rv->count--;
+            memmove(&rv->rects[0], &rv->rects[1], rv->count * sizeof(lv_area_t));
+            have_area = true;
+        }
+        portEXIT_CRITICAL(&rv->lock);
+
+        if (resized) {
+            const lv_area_t res_area = { .x1 = 0, .y1 = 0, .x2 = hres - 1, .y2 = vres - 1 };
+            lvgl_port_remote_header(buf, LVGL_PORT_REMOTE_MSG_RESOLUTION, &res_area, 0);
+            ok = lvgl_port_remote_send(rv, buf, LVGL_PORT_REMOTE_MSG_HEADER);
+            continue;
+        }
+        if (!have_area) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        /* Bands of rows fitting the buffer in the worst case */
+        const int32_t w = lv_area_get_width(&area);
+        const int32_t band_rows = LV_MAX(1, (int32_t)((rv->cfg.buffer_size - LVGL_PORT_REMOTE_MSG_HEADER) / (w * LVGL_PORT_REMOTE_MAX_PX_BYTES)));
+        for (int32_t y = area.y1; ok && y <= area.y2; y += band_rows) {
+            const lv_area_t band = { .x1 = area.x1, .y1 = y, .x2 = area.x2, .y2 = LV_MIN(area.y2, y + band_rows - 1) };
+            const int32_t h = lv_area_get_height(&band);
+            const size_t len = lvgl_port_remote_encode(rv->shadow + y * hres + band.x1, hres, w, h, buf + LVGL_PORT_REMOTE_MSG_HEADER);
+            lvgl_port_remote_header(buf, LVGL_PORT_REMOTE_MSG_RECT, &band, len);
+            ok = lvgl_port_remote_send(rv, buf, LVGL_PORT_REMOTE_MSG_HEADER + len);
+            portENTER_CRITICAL(&rv->lock);
+            rv->stats.rects++;
+            rv->stats.raw_bytes += w * h * sizeof(uint16_t);
+            portEXIT_CRITICAL(&rv->lock);
+        }
+    }
+
+    /* Send error, wait for stop */
+    while (!rv->stop) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    xSemaphoreGive(rv->done);
+    vTaskDelete(NULL);
+}
+
+#else
+esp_err_t lvgl_port_remote_start(lv_display_t *disp, const lvgl_port_remote_cfg_t *cfg)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_remote_stop(lv_display_t *disp)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t lvgl_port_remote_get_stats(lv_display_t *disp, lvgl_port_remote_stats_t *stats)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+#endif
@@ -0,0 +1,333 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "esp_lvgl_port_rotate.h"
+
+/* Tile size in pixels, 16x16 tile of RGB565 (512 B) and 8x8 tile of 24/32-bit pixels stays in cache */
+#define LVGL_PORT_ROTATE_TILE_16BIT  (16)
+#define LVGL_PORT_ROTATE_TILE_OTHER  (8)
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Transpose 8x8 bit matrix: byte r of the input is row r (bit 7 is the first pixel), byte (7 - c) of the output is column c (bit r is row r) */
+static inline uint64_t lvgl_port_transpose_8x8(uint64_t x)
+{
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+static inline uint8_t lvgl_port_reverse_bits(uint8_t b)
+{
+    b = ((b & 0xF0) >> 4) | ((b & 0x0F) << 4);
+    b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+    b = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+    return b;
+}
+
+/* Same test as blue channel of lv_color16_t > 16 (blue is in the lowest 5 bits) */
+static inline bool lvgl_port_mono_lit(uint16_t px)
+{
+    return (px & 0x1F) > 16;
+}
+
+static inline __attribute__((always_inline)) void lvgl_port_copy_px(uint8_t *dst, const uint8_t *src, const uint32_t px_size, const bool swap)
+{
+    if (px_size == 2 && swap) {
+        *(uint16_t *)dst = __builtin_bswap16(*(const uint16_t *)src);
+    } else if (px_size == 2) {
+        *(uint16_t *)dst = *(const uint16_t *)src;
+    } else if (px_size == 4) {
+        *(uint32_t *)dst = *(const uint32_t *)src;
+    } else {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+    }
+}
+
+static inline __attribute__((always_inline)) void lvgl_port_convert_rows(const uint8_t *src, uint8_t *dest, int32_t w, int32_t h, int32_t src_stride, int32_t dest_stride, const uint32_t src_px_size, const bool swap)
+{
+    for (int32_t y = 0; y < h; y++) {
+        const uint8_t *s = src + y * src_stride;
+        uint16_t *d = (uint16_t *)(dest + y * dest_stride);
+        for (int32_t x = 0; x < w; x++) {
+            uint16_t c;
+            if (src_px_size == 4) {
+                /* 0xAARRGGBB */
+                const uint32_t v = ((const uint32_t *)s)[x];
+                c = ((v >> 8) & 0xF800) | ((v >> 5) & 0x07E0) | ((v >> 3) & 0x001F);
+            } else {
+                const uint8_t *px = s + x * 3;
+                c = ((px[2] & 0xF8) << 8) | ((px[1] & 0xFC) << 3) | (px[0] >> 3);
+            }
+            d[x] = (swap ? __builtin_bswap16(c) : c);
+        }
+    }
+}
+
+/* Output in LVGL byte order (blue, green, red), swapped output is in panel byte order (red, green, blue) */
+static inline __attribute__((always_inline)) void lvgl_port_convert_rows_rgb888(const uint8_t *src, uint8_t *dest, int32_t w, int32_t h, int32_t src_stride, int32_t dest_stride, const uint32_t src_px_size, const bool swap)
+{
+    for (int32_t y = 0; y < h; y++) {
+        const uint8_t *s = src + y * src_stride;
+        uint8_t *d = dest + y * dest_stride;
+        for (int32_t x = 0; x < w; x++) {
+            if (swap) {
+                d[0] = s[2];
+                d[1] = s[1];
+                d[2] = s[0];
+            } else {
+                d[0] = s[0];
+                d[1] = s[1];
+                d[2] = s[2];
+            }
+            s += src_px_size;
+            d += 3;
+        }
+    }
+}
+
+static inline __attribute__((always_inline)) void lvgl_port_rotate_tiled_px(const uint8_t *src, uint8_t *dest, int32_t w, int32_t h, int32_t src_stride, int32_t dest_stride, lvgl_port_rotate_t rotation, const uint32_t px_size, const bool swap, const int32_t tile)
+{
+    /* 180: both buffers are walked row-major, no tiles needed */
+    if (rotation == LVGL_PORT_ROTATE_180) {
+        for (int32_t y = 0; y < h; y++) {
+            const uint8_t *s = src + y * src_stride;
+            uint8_t *d = dest + (h - 1 - y) * dest_stride + (w - 1) * px_size;
+            for (int32_t x = 0; x < w; x++) {
+                lvgl_port_copy_px(d, s, px_size, swap);
+                s += px_size;
+                d -= px_size;
+            }
+        }
+        return;
+    }
+
+    /* 90: src(x, y) -> dest(y, w - 1 - x), 270: src(x, y) -> dest(h - 1 - y, x) */
+    const int32_t d_step = (rotation == LVGL_PORT_ROTATE_90 ? -dest_stride : dest_stride);
+    for (int32_t ty = 0; ty < h; ty += tile) {
+        const int32_t ty_end = (ty + tile < h ? ty + tile : h);
+        for (int32_t tx = 0; tx < w; tx += tile) {
+            const int32_t tw = (tx + tile < w ? tile : w - tx);
+            for (int32_t y = ty; y < ty_end; y++) {
+                const uint8_t *s = src + y * src_stride + tx * px_size;
+                uint8_t *d;
+                if (rotation == LVGL_PORT_ROTATE_90) {
+                    d = dest + (w - 1 - tx) * dest_stride + y * px_size;
+                } else {
+                    d = dest + tx * dest_stride + (h - 1 - y) * px_size;
+                }
+                for (int32_t x = 0; x < tw; x++) {
+                    lvgl_port_copy_px(d, s, px_size, swap);
+                    s += px_size;
+                    d += d_step;
+                }
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_rotate_tiled(const void *src, void *dest, int32_t src_width, int32_t src_height, int32_t src_stride, int32_t dest_stride, lvgl_port_rotate_t rotation, uint32_t px_size, bool swap_bytes)
+{
+    assert(src != NULL);
+    assert(dest != NULL);
+    swap_bytes = (swap_bytes && px_size == 2);
+
+    if (rotation == LVGL_PORT_ROTATE_0 && swap_bytes) {
+        lvgl_port_copy_swap_rgb565(src, dest, src_width, src_height, src_stride, dest_stride);
+        return;
+    } else if (rotation == LVGL_PORT_ROTATE_0) {
+        for (int32_t y = 0; y < src_height; y++) {
+            memcpy((uint8_t *)dest + y * dest_stride, (const uint8_t *)src + y * src_stride, src_width * px_size);
+        }
+        return;
+    }
+
+    /* Constant pixel size lets the compiler specialize the inner loops */
+    switch (px_size) {
+    case 2:
+        if (swap_bytes) {
+            lvgl_port_rotate_tiled_px(src, dest, src_width, src_height, src_stride, dest_stride, rotation, 2, true, LVGL_PORT_ROTATE_TILE_16BIT);
+        } else {
+            lvgl_port_rotate_tiled_px(src, dest, src_width, src_height, src_stride, dest_stride, rotation, 2, false, LVGL_PORT_ROTATE_TILE_16BIT);
+        }
+        break;
+    case 3:
+        lvgl_port_rotate_tiled_px(src, dest, src_width, src_height, src_stride, dest_stride, rotation, 3, false, LVGL_PORT_ROTATE_TILE_OTHER);
+        break;
+    case 4:
+        lvgl_port_rotate_tiled_px(src, dest, src_width, src_height, src_stride, dest_stride, rotation, 4, false, LVGL_PORT_ROTATE_TILE_OTHER);
+        break;
+    default:
+        assert(false && "Not supported pixel size");
+        break;
+    }
+}
+
+void lvgl_port_copy_swap_rgb565(const void *src, void *dest, int32_t width, int32_t height, int32_t src_stride, int32_t dest_stride)
+{
+    assert(src != NULL);
+    assert(dest != NULL);
+
+    for (int32_t y = 0; y < height; y++) {
+        const uint16_t *s = (const uint16_t *)((const uint8_t *)src + y * src_stride);
+        uint16_t *d = (uint16_t *)((uint8_t *)dest + y * dest_stride);
+        int32_t x = 0;
+
+        /* Two pixels per 32-bit word, when both rows are word aligned in the same way */
+        if ((((uintptr_t)s ^ (uintptr_t)d) & 0x3) == 0) {
+            if (((uintptr_t)s & 0x3) && x < width) {
+                *d++ = __builtin_bswap16(*s++);
+                x++;
+            }
+            const uint32_t *s32 = (const uint32_t *)s;
+            uint32_t *d32 = (uint32_t *)d;
+            for (; x + 1 < width; x += 2) {
+                const uint32_t v = *s32++;
+                *d32++ = ((v & 0x00FF00FF) << 8) | ((v >> 8) & 0x00FF00FF);
+            }
+            s = (const uint16_t *)s32;
+            d = (uint16_t *)d32;
+        }
+        for (; x < width; x++) {
+            *d++ = __builtin_bswap16(*s++);
+        }
+    }
+}
+
+void lvgl_port_convert_to_rgb565(const void *src, void *dest, int32_t width, int32_t height, int32_t src_stride, int32_t dest_stride, uint32_t src_px_size, bool swap_bytes)
+{
+    assert(src != NULL);
+    assert(dest != NULL);
+
+    /* Constant pixel size and swap, each variant is compiled without branches in the loop */
+    if (src_px_size == 4 && swap_bytes) {
+        lvgl_port_convert_rows(src, dest, width, height, src_stride, dest_stride, 4, true);
+    } else if (src_px_size == 4) {
+        lvgl_port_convert_rows(src, dest, width, height, src_stride, dest_stride, 4, false);
+    } else if (src_px_size == 3 && swap_bytes) {
+        lvgl_port_convert_rows(src, dest, width, height, src_stride, dest_stride, 3, true);
+    } else if (src_px_size == 3) {
+        lvgl_port_convert_rows(src, dest, width, height, src_stride, dest_stride, 3, false);
+    } else {
+        assert(false && "Not supported pixel size");
+    }
+}
+
+void lvgl_port_convert_to_rgb888(const void *src, void *dest, int32_t width, int32_t height, int32_t src_stride, int32_t dest_stride, uint32_t src_px_size, bool swap_bytes)
+{
+    assert(src != NULL);
+    assert(dest != NULL);
+
+    if (src_px_size == 4 && swap_bytes) {
+        lvgl_port_convert_rows_rgb888(src, dest, width, height, src_stride, dest_stride, 4, true);
+    } else if (src_px_size == 4) {
+        lvgl_port_convert_rows_rgb888(src, dest, width, height, src_stride, dest_stride, 4, false);
+    } else if (src_px_size == 3 && swap_bytes) {
+        lvgl_port_convert_rows_rgb888(src, dest, width, height, src_stride, dest_stride, 3, true);
+    } else if (src_px_size == 3) {
+        lvgl_port_convert_rows_rgb888(src, dest, width, height, src_stride, dest_stride, 3, false);
+    } else {
+        assert(false && "Not supported pixel size");
+    }
+}
+
+void lvgl_port_convert_l8_to_rgb565(const void *src, void *dest, int32_t width, int32_t height, int32_t src_stride, int32_t dest_stride, const uint16_t *lut)
+{
+    assert(src != NULL);
+    assert(dest != NULL);
+    assert(lut != NULL);
+
+    for (int32_t y = 0; y < height; y++) {
+        const uint8_t *s = (const uint8_t *)src + y * src_stride;
+        uint16_t *d = (uint16_t *)((uint8_t *)dest + y * dest_stride);
+        int32_t x = 0;
+        /* Four pixels per iteration, LUT entries are already in panel byte order */
+        for (; x + 4 <= width; x += 4) {
+            d[x] = lut[s[x]];
+            d[x + 1] = lut[s[x + 1]];
+            d[x + 2] = lut[s[x + 2]];
+            d[x + 3] = lut[s[x + 3]];
+        }
+        for (; x < width; x++) {
+            d[x] = lut[s[x]];
+        }
+    }
+}
+
+void lvgl_port_monochrome_pages(const void *src, void *dest, bool src_i1, bool swap_xy, uint16_t hor_res, uint16_t ver_res, int32_t x1, int32_t x2, int32_t y1, int32_t y2)
+{
+    assert(src != NULL);
+    assert(dest != NULL);
+
+    const uint8_t *src_i1_buf = (const uint8_t *)src;
+    const uint16_t *color = (const uint16_t *)src;
+    uint8_t *out = (uint8_t *)dest;
+    const uint32_t src_stride = (hor_res >> 3);
+
+    if (src_i1 && !swap_xy) {
+        /* 8 source rows of one byte column -> 8 output columns of one page */
+        for (int32_t y = y1; y <= y2; y += 8) {
+            uint8_t *page = out + hor_res * (y >> 3);
+            for (int32_t bx = (x1 >> 3); bx <= (x2 >> 3); bx++) {
+                uint64_t m = 0;
+                for (int r = 0; r < 8; r++) {
+                    m |= (uint64_t)src_i1_buf[src_stride * (y + r) + bx] << (8 * r);
+                }
+                /* Lit pixel is 0 in LVGL buffer */
+                m = ~lvgl_port_transpose_8x8(m);
+                for (int c = 0; c < 8; c++) {
+                    page[8 * bx + c] = (uint8_t)(m >> (8 * (7 - c)));
+                }
+            }
+        }
+    } else if (src_i1) {
+        /* Swapped XY: one source byte is one output byte in reversed bit order */
+        for (int32_t y = y1; y <= y2; y++) {
+            for (int32_t bx = (x1 >> 3); bx <= (x2 >> 3); bx++) {
+                out[ver_res * bx + y] = ~lvgl_port_reverse_bits(src_i1_buf[src_stride * y + bx]);
+            }
+        }
+    } else if (!swap_xy) {
+        /* Collect 8 vertical pixels into one output byte */
+        for (int32_t y = y1; y <= y2; y += 8) {
+            uint8_t *page = out + hor_res * (y >> 3);
+            for (int32_t x = x1; x <= x2; x++) {
+                uint8_t byte = 0;
+                for (int r = 0; r < 8; r++) {
+                    byte |= (lvgl_port_mono_lit(color[hor_res * (y + r) + x]) ? 0 : 1) << r;
+                }
+                page[x] = byte;
+            }
+        }
+    } else {
+        /* Collect 8 horizontal pixels into one output byte */
+        for (int32_t y = y1; y <= y2; y++) {
+            for (int32_t x = x1; x <= x2; x += 8) {
+                uint8_t byte = 0;
+                for (int r = 0; r < 8; r++) {
+                    byte |= (lvgl_port_mono_lit(color[hor_res * y + x + r]) ? 0 : 1) << r;
+                }
+                out[ver_res * (x >> 3) + y] = byte;
+            }
+        }
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_check.h"
+#include "esp_lvgl_port_simd.h"
+
+static const char *TAG = "LVGL";
+
+/* All the assembly kernels are used for all the areas by default */
+lvgl_port_simd_kernel_cfg_t lvgl_port_simd_kernels[LVGL_PORT_SIMD_KERNEL_NUM];
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_simd_set_kernel(lvgl_port_simd_kernel_t kernel, const lvgl_port_simd_kernel_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(kernel < LVGL_PORT_SIMD_KERNEL_NUM && cfg, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_simd_kernels[kernel] = *cfg;
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_simd_get_kernel(lvgl_port_simd_kernel_t kernel, lvgl_port_simd_kernel_cfg_t *cfg)
+{
+    ESP_RETURN_ON_FALSE(kernel < LVGL_PORT_SIMD_KERNEL_NUM && cfg, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    *cfg = lvgl_port_simd_kernels[kernel];
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private API functions
+*******************************************************************************/
+
+void lvgl_port_simd_config(const lvgl_port_simd_cfg_t *cfg)
+{
+    if (cfg) {
+        memcpy(lvgl_port_simd_kernels, cfg->kernel, sizeof(lvgl_port_simd_kernels));
+    } else {
+        memset(lvgl_port_simd_kernels, 0, sizeof(lvgl_port_simd_kernels));
+    }
+}
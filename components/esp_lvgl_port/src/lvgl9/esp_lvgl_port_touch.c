@@ -4,21 +4,65 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <stdatomic.h>
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_lcd_touch.h"
 #include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
 
 static const char *TAG = "LVGL";
 
+/* Number of samples in the ring between sampler task and LVGL (power of 2) */
+#define LVGL_PORT_TOUCH_RING_LEN    (8)
+/* Maximum period of checking the inactivity for sleep_timeout_ms */
+#define LVGL_PORT_TOUCH_SLEEP_CHECK_MS  (1000)
+/* Number of gestures in the ring between sampler task and LVGL (power of 2) */
+#define LVGL_PORT_TOUCH_GESTURE_RING_LEN    (8)
+
 /*******************************************************************************
 * Types definitions
 *******************************************************************************/
 
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    bool pressed;
+} lvgl_port_touch_sample_t;
+
 typedef struct {
     esp_lcd_touch_handle_t  handle;     /* LCD touch IO handle */
     lv_indev_t              *indev;     /* LVGL input device driver */
+    /* Sampler task (sample_period_ms) */
+    TaskHandle_t            task;           /* Sampler task, reading the touch controller */
+    SemaphoreHandle_t       task_sem;       /* Sampler task stopped */
+    volatile bool           task_exit;      /* Sampler task should exit */
+    TickType_t              period;         /* Minimal period of reading the touch controller */
+    uint8_t                 smooth;         /* IIR weight of the previous position (1/256) */
+    bool                    median;         /* 3-sample median filter */
+    /* Single producer (sampler task), single consumer (LVGL read) ring */
+    lvgl_port_touch_sample_t ring[LVGL_PORT_TOUCH_RING_LEN];
+    atomic_uint             head;           /* Count of written samples */
+    uint32_t                tail;           /* Count of read samples */
+    lvgl_port_touch_sample_t last;          /* Last sample reported to LVGL */
+    /* Sleep on inactivity (sleep_timeout_ms) */
+    uint32_t                sleep_timeout_ms; /* Inactivity time before sleep */
+    lv_timer_t              *sleep_timer;   /* Checking the inactivity */
+    bool                    static_ctx;     /* Context is provided by the application (not freed) */
+    volatile bool           sleeping;       /* Touch is in monitor mode and LVGL is stopped */
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+    /* Gesture recognizer (gesture), gestures are sent to LVGL in the read callback */
+    esp_lcd_touch_gesture_handle_t gesture;
+    esp_lcd_touch_gesture_t gesture_ring[LVGL_PORT_TOUCH_GESTURE_RING_LEN];
+    atomic_uint             gesture_head;   /* Count of recognized gestures */
+    uint32_t                gesture_tail;   /* Count of sent gestures */
+#endif
 } lvgl_port_touch_ctx_t;
 
 /*******************************************************************************
@@ -26,7 +70,22 @@ typedef struct {
 *******************************************************************************/
 
 static void lvgl_port_touchpad_read(lv_indev_t *indev_drv, lv_indev_data_t *data);
+static void lvgl_port_touchpad_read_sample(lv_indev_t *indev_drv, lv_indev_data_t *data);
 static void lvgl_port_touch_interrupt_callback(esp_lcd_touch_handle_t tp);
+static void lvgl_port_touch_task(void *arg);
+static void lvgl_port_touch_sleep_timer_cb(lv_timer_t *timer);
+static void lvgl_port_touch_wake_cb(void *arg);
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+static void lvgl_port_touch_gesture_process(lvgl_port_touch_ctx_t *touch_ctx, const uint16_t *x, const uint16_t *y, uint8_t point_num);
+static void lvgl_port_touch_gesture_send(lvgl_port_touch_ctx_t *touch_ctx);
+#endif
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+static uint32_t lvgl_port_touch_gesture_event_code;
+#endif
 
 /*******************************************************************************
 * Public API functions
@@ -41,37 +100,109 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg)
     assert(touch_cfg->handle != NULL);
 
     /* Touch context */
-    lvgl_port_touch_ctx_t *touch_ctx = malloc(sizeof(lvgl_port_touch_ctx_t));
+    lvgl_port_touch_ctx_t *touch_ctx = NULL;
+    if (touch_cfg->static_ctx) {
+        /* Nothing is allocated by the port, the sampler task and gesture recognizer would be */
+        bool gesture = false;
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+        gesture = (touch_cfg->gesture != NULL);
+#endif
+        ESP_RETURN_ON_FALSE(((uintptr_t)touch_cfg->static_ctx & 3) == 0 && !touch_cfg->sample_period_ms && !gesture, NULL, TAG,
+                            "Static touch context must be aligned and cannot be used with sample_period_ms or gesture!");
+        touch_ctx = touch_cfg->static_ctx;
+        memset(touch_ctx, 0, sizeof(lvgl_port_touch_ctx_t));
+        touch_ctx->static_ctx = true;
+    } else {
+        touch_ctx = LVGL_PORT_CTX_CALLOC(sizeof(lvgl_port_touch_ctx_t));
+    }
     if (touch_ctx == NULL) {
         ESP_LOGE(TAG, "Not enough memory for touch context allocation!");
         return NULL;
     }
     touch_ctx->handle = touch_cfg->handle;
+    touch_ctx->smooth = touch_cfg->smooth;
+    touch_ctx->median = touch_cfg->flags.median;
+    atomic_init(&touch_ctx->head, 0);
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+    atomic_init(&touch_ctx->gesture_head, 0);
+    if (touch_cfg->gesture) {
+        ESP_GOTO_ON_ERROR(esp_lcd_touch_gesture_new(touch_cfg->gesture, &touch_ctx->gesture), err, TAG, "Gesture recognizer create failed");
+    }
+#endif
 
-    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
-        /* Register touch interrupt callback */
-        ret = esp_lcd_touch_register_interrupt_callback_with_data(touch_ctx->handle, lvgl_port_touch_interrupt_callback, touch_ctx);
-        ESP_GOTO_ON_ERROR(ret, err, TAG, "Error in register touch interrupt.");
+    if (touch_cfg->sample_period_ms) {
+        touch_ctx->period = pdMS_TO_TICKS(touch_cfg->sample_period_ms);
+        if (touch_ctx->period == 0) {
+            touch_ctx->period = 1;
+        }
+        touch_ctx->task_sem = xSemaphoreCreateBinary();
+        ESP_GOTO_ON_FALSE(touch_ctx->task_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create touch task Semaphore");
     }
 
     lvgl_port_lock(0);
     /* Register a touchpad input device */
     indev = lv_indev_create();
     lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
-    /* Event mode can be set only, when touch interrupt enabled */
-    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+    /* Event mode can be set only, when touch interrupt enabled or sampler task wakes LVGL */
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC || touch_ctx->period) {
         lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
     }
-    lv_indev_set_read_cb(indev, lvgl_port_touchpad_read);
+    lv_indev_set_read_cb(indev, touch_ctx->period ? lvgl_port_touchpad_read_sample : lvgl_port_touchpad_read);
     lv_indev_set_disp(indev, touch_cfg->disp);
     lv_indev_set_driver_data(indev, touch_ctx);
     touch_ctx->indev = indev;
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+    /* Event code is registered before the first gesture */
+    lvgl_port_touch_get_gesture_event();
+#endif
+    /* Sleep on inactivity, the touch interrupt wakes up */
+    if (touch_cfg->sleep_timeout_ms) {
+        if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+            touch_ctx->sleep_timeout_ms = touch_cfg->sleep_timeout_ms;
+            touch_ctx->sleep_timer = lv_timer_create(lvgl_port_touch_sleep_timer_cb, LV_MIN(touch_cfg->sleep_timeout_ms, LVGL_PORT_TOUCH_SLEEP_CHECK_MS), touch_ctx);
+        } else {
+            ESP_LOGW(TAG, "Touch sleep needs interrupt pin, sleep_timeout_ms is ignored");
+        }
+    }
     lvgl_port_unlock();
 
+    if (touch_ctx->period) {
+        ESP_GOTO_ON_FALSE(xTaskCreate(lvgl_port_touch_task, "taskLVGLtouch", CONFIG_LVGL_PORT_TOUCH_TASK_STACK, touch_ctx, CONFIG_LVGL_PORT_TOUCH_TASK_PRIORITY, &touch_ctx->task) == pdPASS,
+                          ESP_ERR_NO_MEM, err, TAG, "Failed to create touch task");
+    }
+
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+        /* Register touch interrupt callback */
+        ret = esp_lcd_touch_register_interrupt_callback_with_data(touch_ctx->handle, lvgl_port_touch_interrupt_callback, touch_ctx);
+        ESP_GOTO_ON_ERROR(ret, err, TAG, "Error in register touch interrupt.");
+    }
+
 err:
     if (ret != ESP_OK) {
-        if (touch_ctx) {
-            free(touch_ctx);
+        if (touch_ctx->task) {
+            touch_ctx->task_exit = true;
+            xTaskNotifyGive(touch_ctx->task);
+            xSemaphoreTake(touch_ctx->task_sem, portMAX_DELAY);
+        }
+        if (indev) {
+            lvgl_port_lock(0);
+            if (touch_ctx->sleep_timer) {
+                lv_timer_delete(touch_ctx->sleep_timer);
+            }
+            lv_indev_delete(indev);
+            lvgl_port_unlock();
+            indev = NULL;
+        }
+        if (touch_ctx->task_sem) {
+            vSemaphoreDelete(touch_ctx->task_sem);
+        }
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+        if (touch_ctx->gesture) {
+            esp_lcd_touch_gesture_del(touch_ctx->gesture);
+        }
+#endif
+        if (!touch_ctx->static_ctx) {
+            LVGL_PORT_CTX_FREE(touch_ctx);
         }
     }
 
@@ -83,23 +214,82 @@ esp_err_t lvgl_port_remove_touch(lv_indev_t *touch)
     assert(touch);
     lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)lv_indev_get_driver_data(touch);
 
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+        /* Unregister touch interrupt callback */
+        esp_lcd_touch_register_interrupt_callback(touch_ctx->handle, NULL);
+    }
+
+    if (touch_ctx->task) {
+        /* Stop sampler task, after the pending read */
+        touch_ctx->task_exit = true;
+        xTaskNotifyGive(touch_ctx->task);
+        xSemaphoreTake(touch_ctx->task_sem, portMAX_DELAY);
+        vSemaphoreDelete(touch_ctx->task_sem);
+    }
+
     lvgl_port_lock(0);
+    if (touch_ctx->sleep_timer) {
+        lv_timer_delete(touch_ctx->sleep_timer);
+    }
+    /* Resume LVGL stopped by this touch */
+    lvgl_port_touch_wake_cb(touch_ctx);
     /* Remove input device driver */
     lv_indev_delete(touch);
     lvgl_port_unlock();
 
-    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
-        /* Unregister touch interrupt callback */
-        esp_lcd_touch_register_interrupt_callback(touch_ctx->handle, NULL);
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+    if (touch_ctx->gesture) {
+        esp_lcd_touch_gesture_del(touch_ctx->gesture);
     }
-
-    if (touch_ctx) {
-        free(touch_ctx);
+#endif
+    if (touch_ctx && !touch_ctx->static_ctx) {
+        LVGL_PORT_CTX_FREE(touch_ctx);
     }
 
     return ESP_OK;
 }
 
+size_t lvgl_port_touch_get_ctx_size(void)
+{
+    return sizeof(lvgl_port_touch_ctx_t);
+}
+
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+uint32_t lvgl_port_touch_get_gesture_event(void)
+{
+    if (lvgl_port_touch_gesture_event_code == 0) {
+        lvgl_port_touch_gesture_event_code = lv_event_register_id();
+    }
+    return lvgl_port_touch_gesture_event_code;
+}
+
+const esp_lcd_touch_gesture_t *lvgl_port_touch_get_gesture(lv_event_t *e)
+{
+    assert(e);
+    return (const esp_lcd_touch_gesture_t *)lv_event_get_param(e);
+}
+#endif
+
+esp_err_t lvgl_port_touch_suspend(lv_indev_t *touch)
+{
+    ESP_RETURN_ON_FALSE(touch, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)lv_indev_get_driver_data(touch);
+    ESP_RETURN_ON_FALSE(touch_ctx, ESP_ERR_INVALID_ARG, TAG, "invalid touch");
+    ESP_RETURN_ON_FALSE(touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC, ESP_ERR_NOT_SUPPORTED, TAG, "Touch suspend needs interrupt pin");
+
+    if (touch_ctx->sleeping) {
+        return ESP_OK;
+    }
+
+    /* Active touch interrupts too, the monitor mode only saves power */
+    if (esp_lcd_touch_set_power_mode(touch_ctx->handle, ESP_LCD_TOUCH_POWER_MODE_MONITOR) != ESP_OK) {
+        ESP_LOGD(TAG, "Touch monitor mode not supported, touch stays active");
+    }
+
+    touch_ctx->sleeping = true;
+    return lvgl_port_stop();
+}
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
@@ -111,15 +301,31 @@ static void lvgl_port_touchpad_read(lv_indev_t *indev_drv, lv_indev_data_t *data
     assert(touch_ctx);
     assert(touch_ctx->handle);
 
-    uint16_t touchpad_x[1] = {0};
-    uint16_t touchpad_y[1] = {0};
+    uint16_t touchpad_x[2] = {0};
+    uint16_t touchpad_y[2] = {0};
     uint8_t touchpad_cnt = 0;
+    uint8_t touchpad_max = 1;
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+    /* Second point for two finger gestures */
+    if (touch_ctx->gesture) {
+        touchpad_max = 2;
+    }
+#endif
 
     /* Read data from touch controller into memory */
+    LVGL_PORT_TRACE_BEGIN(LVGL_PORT_TRACE_TOUCH_READ);
     esp_lcd_touch_read_data(touch_ctx->handle);
+    LVGL_PORT_TRACE_END(LVGL_PORT_TRACE_TOUCH_READ);
 
     /* Read data from touch controller */
-    bool touchpad_pressed = esp_lcd_touch_get_coordinates(touch_ctx->handle, touchpad_x, touchpad_y, NULL, &touchpad_cnt, 1);
+    bool touchpad_pressed = esp_lcd_touch_get_coordinates(touch_ctx->handle, touchpad_x, touchpad_y, NULL, &touchpad_cnt, touchpad_max);
+
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+    if (touch_ctx->gesture) {
+        lvgl_port_touch_gesture_process(touch_ctx, touchpad_x, touchpad_y, touchpad_pressed ? touchpad_cnt : 0);
+        lvgl_port_touch_gesture_send(touch_ctx);
+    }
+#endif
 
     if (touchpad_pressed && touchpad_cnt > 0) {
         data->point.x = touchpad_x[0];
@@ -128,12 +334,303 @@ static void lvgl_port_touchpad_read(lv_indev_t *indev_drv, lv_indev_data_t *data
     } else {
         data->state = LV_INDEV_STATE_RELEASED;
     }
+
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    lvgl_port_latency_touch_read(indev_drv, data);
+#endif
 }
 
+static void lvgl_port_touchpad_read_sample(lv_indev_t *indev_drv, lv_indev_data_t *data)
+{
+    assert(indev_drv);
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)lv_indev_get_driver_data(indev_drv);
+    assert(touch_ctx);
+
+    uint32_t head;
+    uint32_t tail;
+    uint32_t first;
+    lvgl_port_touch_sample_t sample = touch_ctx->last;
+    do {
+        head = atomic_load_explicit(&touch_ctx->head, memory_order_acquire);
+        tail = touch_ctx->tail;
+        /* LVGL was not reading for a long time, the oldest samples were overwritten. The oldest slot is skipped too,
+         * it is the next one written by the sampler task. */
+        if (head - tail >= LVGL_PORT_TOUCH_RING_LEN) {
+            tail = head - LVGL_PORT_TOUCH_RING_LEN + 1;
+        }
+        first = tail;
+
+        if (tail != head) {
+            /* Movement is reduced to the latest position, but every press and release is reported */
+            while (tail + 1 != head &&
+                    touch_ctx->ring[tail % LVGL_PORT_TOUCH_RING_LEN].pressed == touch_ctx->ring[(tail + 1) % LVGL_PORT_TOUCH_RING_LEN].pressed) {
+                tail++;
+            }
+            sample = touch_ctx->ring[tail % LVGL_PORT_TOUCH_RING_LEN];
+            tail++;
+        }
+        /* Seqlock: the copied slots were not overwritten, if the sampler task did not write the slot of the first one meanwhile */
+        atomic_thread_fence(memory_order_acquire);
+    } while (atomic_load_explicit(&touch_ctx->head, memory_order_relaxed) - first >= LVGL_PORT_TOUCH_RING_LEN);
+    touch_ctx->last = sample;
+    touch_ctx->tail = tail;
+
+    data->point.x = touch_ctx->last.x;
+    data->point.y = touch_ctx->last.y;
+    data->state = (touch_ctx->last.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED);
+    data->continue_reading = (tail != head);
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    lvgl_port_latency_touch_read(indev_drv, data);
+#endif
+
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+    if (touch_ctx->gesture) {
+        lvgl_port_touch_gesture_send(touch_ctx);
+    }
+#endif
+}
+
+static inline uint16_t lvgl_port_touch_median3(uint16_t a, uint16_t b, uint16_t c)
+{
+    if (a > b) {
+        const uint16_t t = a;
+        a = b;
+        b = t;
+    }
+    return (c <= a ? a : (c >= b ? b : c));
+}
+
+static void lvgl_port_touch_task(void *arg)
+{
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)arg;
+    const bool use_irq = (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC);
+    uint16_t raw_x[3] = {0};
+    uint16_t raw_y[3] = {0};
+    uint32_t raw_cnt = 0;
+    int32_t iir_x = 0;
+    int32_t iir_y = 0;
+    bool pressed = false;
+    TickType_t last_read = xTaskGetTickCount();
+
+    while (!touch_ctx->task_exit) {
+        /* Rate limit, interrupts during the period are merged into one read */
+        xTaskDelayUntil(&last_read, touch_ctx->period);
+        if (use_irq && !pressed) {
+            /* Released, wait for the touch interrupt */
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            last_read = xTaskGetTickCount();
+        } else {
+            /* Pressed (or without interrupt), polled every period */
+            ulTaskNotifyTake(pdTRUE, 0);
+        }
+        if (touch_ctx->task_exit) {
+            break;
+        }
+
+        uint16_t touchpad_x[2] = {0};
+        uint16_t touchpad_y[2] = {0};
+        uint8_t touchpad_cnt = 0;
+        uint8_t touchpad_max = 1;
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+        if (touch_ctx->gesture) {
+            touchpad_max = 2;
+        }
+#endif
+        LVGL_PORT_TRACE_BEGIN(LVGL_PORT_TRACE_TOUCH_READ);
+        esp_lcd_touch_read_data(touch_ctx->handle);
+        LVGL_PORT_TRACE_END(LVGL_PORT_TRACE_TOUCH_READ);
+        const bool now_pressed = esp_lcd_touch_get_coordinates(touch_ctx->handle, touchpad_x, touchpad_y, NULL, &touchpad_cnt, touchpad_max) && touchpad_cnt > 0;
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+        /* Raw points, gestures are sent with the next LVGL read */
+        if (touch_ctx->gesture) {
+            lvgl_port_touch_gesture_process(touch_ctx, touchpad_x, touchpad_y, now_pressed ? touchpad_cnt : 0);
+        }
+#endif
+
+        lvgl_port_touch_sample_t sample = {
+            .pressed = now_pressed,
+        };
+        if (now_pressed) {
+            /* Filters start from the first point of every press */
+            if (!pressed) {
+                raw_cnt = 0;
+                iir_x = touchpad_x[0] << 8;
+                iir_y = touchpad_y[0] << 8;
+            }
+            raw_x[raw_cnt % 3] = touchpad_x[0];
+            raw_y[raw_cnt % 3] = touchpad_y[0];
+            raw_cnt++;
+            uint16_t x = touchpad_x[0];
+            uint16_t y = touchpad_y[0];
+            if (touch_ctx->median && raw_cnt >= 3) {
+                x = lvgl_port_touch_median3(raw_x[0], raw_x[1], raw_x[2]);
+                y = lvgl_port_touch_median3(raw_y[0], raw_y[1], raw_y[2]);
+            }
+            /* Fixed point with 8 fractional bits */
+            iir_x = ((int64_t)iir_x * touch_ctx->smooth + ((int64_t)x << 8) * (256 - touch_ctx->smooth)) >> 8;
+            iir_y = ((int64_t)iir_y * touch_ctx->smooth + ((int64_t)y << 8) * (256 - touch_ctx->smooth)) >> 8;
+            sample.x = (iir_x + 128) >> 8;
+            sample.y = (iir_y + 128) >> 8;
+        } else {
+            /* Release is reported on the last pressed position */
+            const uint32_t prev = atomic_load_explicit(&touch_ctx->head, memory_order_relaxed) - 1;
+            sample.x = touch_ctx->ring[prev % LVGL_PORT_TOUCH_RING_LEN].x;
+            sample.y = touch_ctx->ring[prev % LVGL_PORT_TOUCH_RING_LEN].y;
+        }
+
+        /* Still released, nothing to report */
+        if (!now_pressed && !pressed) {
+            continue;
+        }
+        pressed = now_pressed;
+
+        /* Slot is published by head after it is written, the published head is ordered before the write (LVGL read checks it after its copy) */
+        const uint32_t head = atomic_load_explicit(&touch_ctx->head, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        touch_ctx->ring[head % LVGL_PORT_TOUCH_RING_LEN] = sample;
+        atomic_store_explicit(&touch_ctx->head, head + 1, memory_order_release);
+
+        lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, touch_ctx->indev);
+    }
+
+    xSemaphoreGive(touch_ctx->task_sem);
+    vTaskDelete(NULL);
+}
+
+static void lvgl_port_touch_sleep_timer_cb(lv_timer_t *timer)
+{
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)lv_timer_get_user_data(timer);
+
+    if (touch_ctx->sleeping || lv_display_get_inactive_time(lv_indev_get_display(touch_ctx->indev)) < touch_ctx->sleep_timeout_ms) {
+        return;
+    }
+
+    /* Without monitor mode, a touch may not wake up */
+    if (esp_lcd_touch_set_power_mode(touch_ctx->handle, ESP_LCD_TOUCH_POWER_MODE_MONITOR) != ESP_OK) {
+        ESP_LOGW(TAG, "Touch monitor mode not supported, sleep disabled");
+        lv_timer_delete(timer);
+        touch_ctx->sleep_timer = NULL;
+        return;
+    }
+
+    touch_ctx->sleeping = true;
+    lvgl_port_stop();
+}
+
+static void lvgl_port_touch_wake_cb(void *arg)
+{
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)arg;
+
+    /* More interrupts can be queued */
+    if (!touch_ctx->sleeping) {
+        return;
+    }
+    touch_ctx->sleeping = false;
+
+    esp_lcd_touch_power_mode_t mode = ESP_LCD_TOUCH_POWER_MODE_ACTIVE;
+    esp_lcd_touch_get_power_mode(touch_ctx->handle, &mode);
+    if (mode != ESP_LCD_TOUCH_POWER_MODE_ACTIVE && esp_lcd_touch_set_power_mode(touch_ctx->handle, ESP_LCD_TOUCH_POWER_MODE_ACTIVE) != ESP_OK) {
+        ESP_LOGE(TAG, "Touch wake up failed");
+    }
+    lvgl_port_resume();
+    lv_display_trigger_activity(lv_indev_get_display(touch_ctx->indev));
+}
+
+#ifdef ESP_LVGL_PORT_TOUCH_GESTURE_COMPONENT
+static void lvgl_port_touch_gesture_process(lvgl_port_touch_ctx_t *touch_ctx, const uint16_t *x, const uint16_t *y, uint8_t point_num)
+{
+    esp_lcd_touch_gesture_t events[4];
+    int64_t timestamp = 0;
+
+    if (esp_lcd_touch_get_timestamp(touch_ctx->handle, &timestamp) != ESP_OK) {
+        timestamp = esp_timer_get_time();
+    }
+    const uint8_t cnt = esp_lcd_touch_gesture_process_points(touch_ctx->gesture, x, y, point_num, timestamp, events, 4);
+
+    /* Single producer ring, the oldest gestures are overwritten when LVGL does not read */
+    uint32_t head = atomic_load_explicit(&touch_ctx->gesture_head, memory_order_relaxed);
+    for (int i = 0; i < cnt; i++) {
+        touch_ctx->gesture_ring[head % LVGL_PORT_TOUCH_GESTURE_RING_LEN] = events[i];
+        head++;
+    }
+    atomic_store_explicit(&touch_ctx->gesture_head, head, memory_order_release);
+}
+
+static void lvgl_port_touch_gesture_send(lvgl_port_touch_ctx_t *touch_ctx)
+{
+    /* Swipe direction on rotated display (LEFT, RIGHT, UP, DOWN) */
+    static const esp_lcd_touch_gesture_type_t swipe_rot[4][4] = {
+        [LV_DISPLAY_ROTATION_0] = {ESP_LCD_TOUCH_GESTURE_SWIPE_LEFT, ESP_LCD_TOUCH_GESTURE_SWIPE_RIGHT, ESP_LCD_TOUCH_GESTURE_SWIPE_UP, ESP_LCD_TOUCH_GESTURE_SWIPE_DOWN},
+        [LV_DISPLAY_ROTATION_90] = {ESP_LCD_TOUCH_GESTURE_SWIPE_UP, ESP_LCD_TOUCH_GESTURE_SWIPE_DOWN, ESP_LCD_TOUCH_GESTURE_SWIPE_RIGHT, ESP_LCD_TOUCH_GESTURE_SWIPE_LEFT},
+        [LV_DISPLAY_ROTATION_180] = {ESP_LCD_TOUCH_GESTURE_SWIPE_RIGHT, ESP_LCD_TOUCH_GESTURE_SWIPE_LEFT, ESP_LCD_TOUCH_GESTURE_SWIPE_DOWN, ESP_LCD_TOUCH_GESTURE_SWIPE_UP},
+        [LV_DISPLAY_ROTATION_270] = {ESP_LCD_TOUCH_GESTURE_SWIPE_DOWN, ESP_LCD_TOUCH_GESTURE_SWIPE_UP, ESP_LCD_TOUCH_GESTURE_SWIPE_LEFT, ESP_LCD_TOUCH_GESTURE_SWIPE_RIGHT},
+    };
+    const uint32_t head = atomic_load_explicit(&touch_ctx->gesture_head, memory_order_acquire);
+    uint32_t tail = touch_ctx->gesture_tail;
+    if (head - tail > LVGL_PORT_TOUCH_GESTURE_RING_LEN) {
+        tail = head - LVGL_PORT_TOUCH_GESTURE_RING_LEN;
+    }
+    if (tail == head) {
+        return;
+    }
+
+    lv_display_t *disp = lv_indev_get_display(touch_ctx->indev);
+    const lv_display_rotation_t rotation = lv_display_get_rotation(disp);
+    const int32_t hor_res = lv_display_get_physical_horizontal_resolution(disp);
+    const int32_t ver_res = lv_display_get_physical_vertical_resolution(disp);
+    lv_obj_t *screen = lv_display_get_screen_active(disp);
+
+    for (; tail != head; tail++) {
+        esp_lcd_touch_gesture_t gesture = touch_ctx->gesture_ring[tail % LVGL_PORT_TOUCH_GESTURE_RING_LEN];
+
+        /* Same rotation as LVGL does with the pointer coordinates */
+        lv_point_t point = {.x = gesture.x, .y = gesture.y};
+        if (rotation == LV_DISPLAY_ROTATION_180 || rotation == LV_DISPLAY_ROTATION_270) {
+            point.x = hor_res - point.x - 1;
+            point.y = ver_res - point.y - 1;
+        }
+        if (rotation == LV_DISPLAY_ROTATION_90 || rotation == LV_DISPLAY_ROTATION_270) {
+            const int32_t tmp = point.y;
+            point.y = point.x;
+            point.x = ver_res - tmp - 1;
+        }
+        gesture.x = point.x;
+        gesture.y = point.y;
+        if (gesture.type <= ESP_LCD_TOUCH_GESTURE_SWIPE_DOWN) {
+            gesture.type = swipe_rot[rotation][gesture.type];
+        }
+
+        lv_obj_t *obj = lv_indev_search_obj(screen, &point);
+        lv_obj_send_event(obj ? obj : screen, lvgl_port_touch_gesture_event_code, &gesture);
+    }
+    touch_ctx->gesture_tail = tail;
+}
+#endif
+
 static void IRAM_ATTR lvgl_port_touch_interrupt_callback(esp_lcd_touch_handle_t tp)
 {
     lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *) tp->config.user_data;
 
+#if CONFIG_LVGL_PORT_ENABLE_LATENCY_STATS
+    lvgl_port_latency_touch_irq();
+#endif
+    LVGL_PORT_TRACE_INSTANT(LVGL_PORT_TRACE_TOUCH_IRQ, 0);
+
+    /* Resume LVGL (in LVGL task), the touch is read as usual */
+    if (touch_ctx->sleeping) {
+        lvgl_port_async_call(lvgl_port_touch_wake_cb, touch_ctx);
+    }
+
+    if (touch_ctx->task) {
+        /* Wake sampler task, it wakes LVGL task after the read */
+        BaseType_t need_yield = pdFALSE;
+        vTaskNotifyGiveFromISR(touch_ctx->task, &need_yield);
+        if (need_yield) {
+            portYIELD_FROM_ISR();
+        }
+        return;
+    }
+
     /* Wake LVGL task, if needed */
     lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, touch_ctx->indev);
 }
@@ -0,0 +1,270 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <inttypes.h>
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lvgl.h"
+#include "esp_lvgl_port_trace.h"
+#include "esp_lvgl_port_priv.h"
+
+#if CONFIG_LVGL_PORT_TRACE_SYSVIEW
+#include "SEGGER_SYSVIEW.h"
+#endif
+
+#if CONFIG_LVGL_PORT_TRACE_RING
+static const char *TAG = "LVGL";
+#endif
+
+/* Displays with numbered transfers (transfers of one display are done in order) */
+#define LVGL_PORT_TRACE_DISPLAYS    (4)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef enum {
+    LVGL_PORT_TRACE_PHASE_BEGIN,
+    LVGL_PORT_TRACE_PHASE_END,
+    LVGL_PORT_TRACE_PHASE_INSTANT,
+    LVGL_PORT_TRACE_PHASE_ASYNC_BEGIN,
+    LVGL_PORT_TRACE_PHASE_ASYNC_END,
+} lvgl_port_trace_phase_t;
+
+#if CONFIG_LVGL_PORT_TRACE_RING
+/* Number of tasks with stored names */
+#define LVGL_PORT_TRACE_TASKS       (16)
+
+typedef struct {
+    uint32_t    ts;         /* Time in microseconds (esp_timer) */
+    uint32_t    arg;        /* Instant value or transfer number */
+    TaskHandle_t task;      /* NULL in ISR */
+    uint8_t     id;
+    uint8_t     phase;
+    uint8_t     core;
+} lvgl_port_trace_event_t;
+
+typedef struct {
+    TaskHandle_t task;
+    char        name[configMAX_TASK_NAME_LEN];
+} lvgl_port_trace_task_t;
+#endif
+
+typedef struct {
+    portMUX_TYPE            lock;
+    lv_display_t            *disps[LVGL_PORT_TRACE_DISPLAYS];
+    uint32_t                trans_started[LVGL_PORT_TRACE_DISPLAYS];
+    uint32_t                trans_done[LVGL_PORT_TRACE_DISPLAYS];
+#if CONFIG_LVGL_PORT_TRACE_RING
+    bool                    paused;         /* Dump in progress */
+    uint32_t                head;           /* Count of written events */
+    uint32_t                tail;           /* Count of cleared events */
+    lvgl_port_trace_event_t events[CONFIG_LVGL_PORT_TRACE_EVENTS];
+    lvgl_port_trace_task_t  tasks[LVGL_PORT_TRACE_TASKS];
+#endif
+} lvgl_port_trace_ctx_t;
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+#if LVGL_PORT_TRACE
+static lvgl_port_trace_ctx_t lvgl_port_trace_ctx = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+#if CONFIG_LVGL_PORT_TRACE_RING
+static const char *const lvgl_port_trace_names[] = {
+    [LVGL_PORT_TRACE_TASK] = "lvgl_task",
+    [LVGL_PORT_TRACE_LOCK_WAIT] = "lock_wait",
+    [LVGL_PORT_TRACE_RENDER] = "render",
+    [LVGL_PORT_TRACE_FLUSH] = "flush",
+    [LVGL_PORT_TRACE_TRANSFER] = "transfer",
+    [LVGL_PORT_TRACE_VSYNC] = "vsync",
+    [LVGL_PORT_TRACE_TOUCH_IRQ] = "touch_irq",
+    [LVGL_PORT_TRACE_TOUCH_READ] = "touch_read",
+};
+#endif
+#endif
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+#if LVGL_PORT_TRACE
+#if CONFIG_LVGL_PORT_TRACE_RING
+/* Name of the task is copied, the task may not exist in the dump (called in critical section) */
+static void lvgl_port_trace_add_task(lvgl_port_trace_ctx_t *ctx, TaskHandle_t task)
+{
+    for (int i = 0; i < LVGL_PORT_TRACE_TASKS; i++) {
+        if (ctx->tasks[i].task == task) {
+            return;
+        }
+        if (ctx->tasks[i].task == NULL) {
+            ctx->tasks[i].task = task;
+            strlcpy(ctx->tasks[i].name, pcTaskGetName(task), sizeof(ctx->tasks[i].name));
+            return;
+        }
+    }
+}
+#endif
+
+static void IRAM_ATTR lvgl_port_trace_record(uint8_t id, lvgl_port_trace_phase_t phase, uint32_t arg)
+{
+#if CONFIG_LVGL_PORT_TRACE_SYSVIEW
+    if (phase == LVGL_PORT_TRACE_PHASE_BEGIN || phase == LVGL_PORT_TRACE_PHASE_ASYNC_BEGIN) {
+        SEGGER_SYSVIEW_OnUserStart(id);
+    } else if (phase == LVGL_PORT_TRACE_PHASE_END || phase == LVGL_PORT_TRACE_PHASE_ASYNC_END) {
+        SEGGER_SYSVIEW_OnUserStop(id);
+    } else {
+        SEGGER_SYSVIEW_OnUserStart(id);
+        SEGGER_SYSVIEW_OnUserStop(id);
+    }
+#else
+    lvgl_port_trace_ctx_t *ctx = &lvgl_port_trace_ctx;
+    const bool isr = xPortInIsrContext();
+    lvgl_port_trace_event_t event = {
+        .ts = (uint32_t)esp_timer_get_time(),
+        .arg = arg,
+        .task = isr ? NULL : xTaskGetCurrentTaskHandle(),
+        .id = id,
+        .phase = phase,
+        .core = xPortGetCoreID(),
+    };
+
+    portENTER_CRITICAL_SAFE(&ctx->lock);
+    if (!ctx->paused) {
+        ctx->events[ctx->head % CONFIG_LVGL_PORT_TRACE_EVENTS] = event;
+        ctx->head++;
+        if (event.task) {
+            lvgl_port_trace_add_task(ctx, event.task);
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&ctx->lock);
+#endif
+}
+
+/* Number of the transfer of the display, upper byte is the display */
+static inline uint32_t IRAM_ATTR lvgl_port_trace_trans_id(lv_display_t *disp, bool done)
+{
+    lvgl_port_trace_ctx_t *ctx = &lvgl_port_trace_ctx;
+    uint32_t id = 0;
+
+    portENTER_CRITICAL_SAFE(&ctx->lock);
+    for (int i = 0; i < LVGL_PORT_TRACE_DISPLAYS; i++) {
+        if (ctx->disps[i] == NULL && !done) {
+            ctx->disps[i] = disp;
+        }
+        if (ctx->disps[i] == disp) {
+            uint32_t *cnt = (done ? &ctx->trans_done[i] : &ctx->trans_started[i]);
+            id = ((uint32_t)i << 24) | ((*cnt)++ & 0xFFFFFF);
+            break;
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&ctx->lock);
+
+    return id;
+}
+
+void lvgl_port_trace_trans_start(lv_display_t *disp)
+{
+    lvgl_port_trace_record(LVGL_PORT_TRACE_TRANSFER, LVGL_PORT_TRACE_PHASE_ASYNC_BEGIN, lvgl_port_trace_trans_id(disp, false));
+}
+
+void IRAM_ATTR lvgl_port_trace_trans_done(lv_display_t *disp)
+{
+    lvgl_port_trace_record(LVGL_PORT_TRACE_TRANSFER, LVGL_PORT_TRACE_PHASE_ASYNC_END, lvgl_port_trace_trans_id(disp, true));
+}
+#endif
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void IRAM_ATTR lvgl_port_trace_begin(uint8_t id)
+{
+#if LVGL_PORT_TRACE
+    lvgl_port_trace_record(id, LVGL_PORT_TRACE_PHASE_BEGIN, 0);
+#endif
+}
+
+void IRAM_ATTR lvgl_port_trace_end(uint8_t id)
+{
+#if LVGL_PORT_TRACE
+    lvgl_port_trace_record(id, LVGL_PORT_TRACE_PHASE_END, 0);
+#endif
+}
+
+void IRAM_ATTR lvgl_port_trace_instant(uint8_t id, uint32_t arg)
+{
+#if LVGL_PORT_TRACE
+    lvgl_port_trace_record(id, LVGL_PORT_TRACE_PHASE_INSTANT, arg);
+#endif
+}
+
+esp_err_t lvgl_port_trace_dump(FILE *out, bool clear)
+{
+#if CONFIG_LVGL_PORT_TRACE_RING
+    ESP_RETURN_ON_FALSE(out, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lvgl_port_trace_ctx_t *ctx = &lvgl_port_trace_ctx;
+    static const char phases[] = {'B', 'E', 'i', 'b', 'e'};
+
+    /* Events are not overwritten while printing */
+    portENTER_CRITICAL(&ctx->lock);
+    ctx->paused = true;
+    const uint32_t head = ctx->head;
+    uint32_t tail = ctx->tail;
+    portEXIT_CRITICAL(&ctx->lock);
+    if (head - tail > CONFIG_LVGL_PORT_TRACE_EVENTS) {
+        tail = head - CONFIG_LVGL_PORT_TRACE_EVENTS;
+    }
+
+    fprintf(out, "{\"traceEvents\":[\n");
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"ISR core %d\"}},\n", core, core);
+    }
+    for (int i = 0; i < LVGL_PORT_TRACE_TASKS && ctx->tasks[i].task; i++) {
+        fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%"PRIu32",\"args\":{\"name\":\"%s\"}},\n",
+                (uint32_t)(uintptr_t)ctx->tasks[i].task, ctx->tasks[i].name);
+    }
+    for (uint32_t i = tail; i != head; i++) {
+        const lvgl_port_trace_event_t *event = &ctx->events[i % CONFIG_LVGL_PORT_TRACE_EVENTS];
+        char user_name[16];
+        const char *name = (event->id < sizeof(lvgl_port_trace_names) / sizeof(lvgl_port_trace_names[0])) ? lvgl_port_trace_names[event->id] : NULL;
+        if (name == NULL) {
+            snprintf(user_name, sizeof(user_name), "user_%u", event->id);
+            name = user_name;
+        }
+        fprintf(out, "{\"name\":\"%s\",\"cat\":\"lvgl_port\",\"ph\":\"%c\",\"ts\":%"PRIu32",\"pid\":1,\"tid\":%"PRIu32, name,
+                phases[event->phase], event->ts, event->task ? (uint32_t)(uintptr_t)event->task : event->core);
+        if (event->phase == LVGL_PORT_TRACE_PHASE_ASYNC_BEGIN || event->phase == LVGL_PORT_TRACE_PHASE_ASYNC_END) {
+            fprintf(out, ",\"id\":\"0x%08"PRIx32"\"", event->arg);
+        } else if (event->phase == LVGL_PORT_TRACE_PHASE_INSTANT) {
+            fprintf(out, ",\"s\":\"t\",\"args\":{\"value\":%"PRIu32"}", event->arg);
+        }
+        fprintf(out, "},\n");
+    }
+    /* Metadata event at the end, JSON does not allow trailing comma */
+    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"esp_lvgl_port\"}}\n]}\n");
+    fflush(out);
+
+    portENTER_CRITICAL(&ctx->lock);
+    if (clear) {
+        ctx->tail = head;
+    }
+    ctx->paused = false;
+    portEXIT_CRITICAL(&ctx->lock);
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
@@ -5,6 +5,7 @@
  */
 
 #include <string.h>
+#include <stdatomic.h>
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_check.h"
@@ -17,6 +18,9 @@
 #include "usb/hid_usage_keyboard.h"
 #include "usb/hid_usage_mouse.h"
 
+/* Size of keyboard FIFO (power of two) */
+#define LVGL_PORT_USB_HID_KB_FIFO_SIZE  (16)
+
 /* LVGL image of cursor */
 LV_IMG_DECLARE(img_cursor)
 
@@ -33,15 +37,28 @@ typedef struct {
     struct {
         lv_indev_t  *indev;     /* LVGL mouse input device driver */
         uint8_t sensitivity;    /* Mouse sensitivity (cannot be zero) */
-        int16_t x;              /* Mouse X coordinate */
-        int16_t y;              /* Mouse Y coordinate */
-        bool left_button;       /* Mouse left button state */
+        int32_t x;              /* Mouse X coordinate (LVGL task only) */
+        int32_t y;              /* Mouse Y coordinate (LVGL task only) */
+        atomic_int dx;          /* X motion accumulated between reads */
+        atomic_int dy;          /* Y motion accumulated between reads */
+        atomic_bool left_button;    /* Mouse left button state */
+        atomic_uint presses;    /* Count of left button presses (edges) */
+        uint32_t presses_read;  /* Count of presses reported to LVGL */
+        bool reported_pressed;  /* State reported to LVGL */
+        atomic_uint reports;    /* Received reports */
     } mouse;
     struct {
         lv_indev_t  *indev;     /* LVGL keyboard input device driver */
-        uint32_t last_key;
-        bool     pressed;
+        uint32_t fifo[LVGL_PORT_USB_HID_KB_FIFO_SIZE];  /* Pressed keys (written by HID task, read by LVGL task) */
+        atomic_uint head;       /* Write index of FIFO */
+        atomic_uint tail;       /* Read index of FIFO */
+        uint8_t prev_keys[HID_KEYBOARD_KEY_MAX];   /* Keys of the previous report */
+        uint32_t key;           /* Key reported to LVGL */
+        bool     pressed;       /* State reported to LVGL */
+        atomic_uint reports;    /* Received reports */
+        atomic_uint dropped;    /* Keys dropped, FIFO was full */
     } kb;
+    atomic_uint short_reports;  /* Reports dropped, too short */
 } lvgl_port_usb_hid_ctx_t;
 
 typedef struct {
@@ -156,13 +173,25 @@ esp_err_t lvgl_port_remove_usb_hid_input(lv_indev_t *hid)
     }
 
     /* If all hid input devices are removed, stop task and clean all */
-    if (lvgl_hid_ctx.mouse.indev == NULL && lvgl_hid_ctx.kb.indev) {
+    if (lvgl_hid_ctx.mouse.indev == NULL && lvgl_hid_ctx.kb.indev == NULL) {
         hid_ctx->running = false;
     }
 
     return ESP_OK;
 }
 
+esp_err_t lvgl_port_usb_hid_get_stats(lvgl_port_usb_hid_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(lvgl_hid_ctx.task, ESP_ERR_INVALID_STATE, TAG, "USB HID is not initialized");
+
+    stats->mouse_reports = atomic_load(&lvgl_hid_ctx.mouse.reports);
+    stats->kb_reports = atomic_load(&lvgl_hid_ctx.kb.reports);
+    stats->kb_dropped = atomic_load(&lvgl_hid_ctx.kb.dropped);
+    stats->short_reports = atomic_load(&lvgl_hid_ctx.short_reports);
+    return ESP_OK;
+}
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
@@ -289,10 +318,13 @@ static void lvgl_port_usb_hid_host_interface_callback(hid_host_device_handle_t h
         if (dev.proto == HID_PROTOCOL_KEYBOARD) {
             hid_keyboard_input_report_boot_t *keyboard = (hid_keyboard_input_report_boot_t *)data;
             if (data_length < sizeof(hid_keyboard_input_report_boot_t)) {
+                atomic_fetch_add(&hid_ctx->short_reports, 1);
                 return;
             }
+            atomic_fetch_add(&hid_ctx->kb.reports, 1);
             for (int i = 0; i < HID_KEYBOARD_KEY_MAX; i++) {
-                if (keyboard->key[i] > HID_KEY_ERROR_UNDEFINED) {
+                /* Only newly pressed keys, held keys stay in the following reports */
+                if (keyboard->key[i] > HID_KEY_ERROR_UNDEFINED && memchr(hid_ctx->kb.prev_keys, keyboard->key[i], HID_KEYBOARD_KEY_MAX) == NULL) {
                     char key = 0;
 
                     /* LVGL special keys */
@@ -325,22 +357,38 @@ static void lvgl_port_usb_hid_host_interface_callback(hid_host_device_handle_t h
 
                     if (key == 0) {
                         ESP_LOGI(TAG, "Not recognized key: %c (%d)", keyboard->key[i], keyboard->key[i]);
+                        continue;
+                    }
+                    /* Single producer FIFO, the LVGL task only moves the tail */
+                    unsigned int head = atomic_load_explicit(&hid_ctx->kb.head, memory_order_relaxed);
+                    if (head - atomic_load_explicit(&hid_ctx->kb.tail, memory_order_acquire) < LVGL_PORT_USB_HID_KB_FIFO_SIZE) {
+                        hid_ctx->kb.fifo[head % LVGL_PORT_USB_HID_KB_FIFO_SIZE] = key;
+                        atomic_store_explicit(&hid_ctx->kb.head, head + 1, memory_order_release);
+                    } else {
+                        atomic_fetch_add(&hid_ctx->kb.dropped, 1);
                     }
-                    hid_ctx->kb.last_key = key;
-                    hid_ctx->kb.pressed = true;
                 }
             }
+            memcpy(hid_ctx->kb.prev_keys, keyboard->key, HID_KEYBOARD_KEY_MAX);
 
             /* Wake LVGL task, if needed */
             lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, hid_ctx->kb.indev);
         } else if (dev.proto == HID_PROTOCOL_MOUSE) {
             hid_mouse_input_report_boot_t *mouse = (hid_mouse_input_report_boot_t *)data;
             if (data_length < sizeof(hid_mouse_input_report_boot_t)) {
+                atomic_fetch_add(&hid_ctx->short_reports, 1);
                 break;
             }
-            hid_ctx->mouse.left_button = mouse->buttons.button1;
-            hid_ctx->mouse.x += mouse->x_displacement;
-            hid_ctx->mouse.y += mouse->y_displacement;
+            atomic_fetch_add(&hid_ctx->mouse.reports, 1);
+            /* Motion is accumulated until LVGL reads it, reports are not queued */
+            atomic_fetch_add_explicit(&hid_ctx->mouse.dx, mouse->x_displacement, memory_order_relaxed);
+            atomic_fetch_add_explicit(&hid_ctx->mouse.dy, mouse->y_displacement, memory_order_relaxed);
+            bool left_button = mouse->buttons.button1;
+            if (left_button && !atomic_load_explicit(&hid_ctx->mouse.left_button, memory_order_relaxed)) {
+                /* Press edge is kept even if the button is released before LVGL read */
+                atomic_fetch_add(&hid_ctx->mouse.presses, 1);
+            }
+            atomic_store(&hid_ctx->mouse.left_button, left_button);
 
             /* Wake LVGL task, if needed */
             lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, hid_ctx->mouse.indev);
@@ -421,6 +469,10 @@ static void lvgl_port_usb_hid_read_mouse(lv_indev_t *indev_drv, lv_indev_data_t
         height = lv_display_get_physical_horizontal_resolution(disp);
     }
 
+    /* Take all the motion since the last read */
+    ctx->mouse.x += atomic_exchange_explicit(&ctx->mouse.dx, 0, memory_order_relaxed);
+    ctx->mouse.y += atomic_exchange_explicit(&ctx->mouse.dy, 0, memory_order_relaxed);
+
     /* Screen borders */
     if (ctx->mouse.x < 0) {
         ctx->mouse.x = 0;
@@ -453,11 +505,17 @@ static void lvgl_port_usb_hid_read_mouse(lv_indev_t *indev_drv, lv_indev_data_t
         break;
     }
 
-    if (ctx->mouse.left_button) {
-        data->state = LV_INDEV_STATE_PRESSED;
-    } else {
-        data->state = LV_INDEV_STATE_RELEASED;
+    /* Button edges: short click between two reads is reported as press and release */
+    uint32_t presses = atomic_load(&ctx->mouse.presses);
+    bool left_button = atomic_load(&ctx->mouse.left_button);
+    if (!ctx->mouse.reported_pressed && ctx->mouse.presses_read != presses) {
+        ctx->mouse.presses_read++;
+        ctx->mouse.reported_pressed = true;
+    } else if (ctx->mouse.reported_pressed && (!left_button || ctx->mouse.presses_read != presses)) {
+        ctx->mouse.reported_pressed = false;
     }
+    data->state = (ctx->mouse.reported_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED);
+    data->continue_reading = (ctx->mouse.reported_pressed != left_button) || (ctx->mouse.presses_read != presses);
 }
 
 static void lvgl_port_usb_hid_read_kb(lv_indev_t *indev_drv, lv_indev_data_t *data)
@@ -466,14 +524,22 @@ static void lvgl_port_usb_hid_read_kb(lv_indev_t *indev_drv, lv_indev_data_t *da
     lvgl_port_usb_hid_ctx_t *ctx = (lvgl_port_usb_hid_ctx_t *)lv_indev_get_driver_data(indev_drv);
     assert(ctx);
 
-    data->key = ctx->kb.last_key;
-    if (ctx->kb.pressed) {
+    unsigned int tail = atomic_load_explicit(&ctx->kb.tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&ctx->kb.head, memory_order_acquire);
+
+    /* Every key from FIFO is reported as press and release */
+    if (!ctx->kb.pressed && tail != head) {
+        ctx->kb.key = ctx->kb.fifo[tail % LVGL_PORT_USB_HID_KB_FIFO_SIZE];
+        atomic_store_explicit(&ctx->kb.tail, tail + 1, memory_order_release);
+        ctx->kb.pressed = true;
         data->state = LV_INDEV_STATE_PRESSED;
-        ctx->kb.pressed = false;
+        data->continue_reading = true;
     } else {
+        ctx->kb.pressed = false;
         data->state = LV_INDEV_STATE_RELEASED;
-        ctx->kb.last_key = 0;
+        data->continue_reading = (tail != head);
     }
+    data->key = ctx->kb.key;
 }
 
 static void lvgl_port_usb_hid_callback(hid_host_device_handle_t hid_device_handle, const hid_host_driver_event_t event, void *arg)
@@ -0,0 +1,326 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_video.h"
+#include "esp_lvgl_port_priv.h"
+
+static const char *TAG = "LVGL";
+
+/* Image cache of LVGL must be dropped, when the frame data changes (lv_image_cache_drop from LVGL 9.1) */
+#define LVGL_PORT_VIDEO_SUPPORTED   (LVGL_VERSION_MAJOR > 9 || LVGL_VERSION_MINOR >= 1)
+
+/* Number of frame parts waiting for LVGL task (direct mode) */
+#define LVGL_PORT_VIDEO_AREA_QUEUE_LEN  (2)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    lv_area_t   area;                   /* LCD area (exclusive end coordinates) */
+    const void  *data;
+    void        *frame;
+} lvgl_port_video_area_t;
+
+struct lvgl_port_video_s {
+    lv_display_t        *disp;          /* LVGL display */
+    lv_obj_t            *img;           /* LVGL image object (image mode) */
+    lv_image_dsc_t      dsc;            /* Image descriptor pointing to the shown frame (image mode) */
+    lv_area_t           area;           /* LCD area (direct mode) */
+    bool                direct;         /* Frames are sent directly to the LCD */
+    lvgl_port_video_release_cb_t release_cb;
+    void                *user_ctx;
+    portMUX_TYPE        lock;           /* Lock of the pending frame */
+    const void          *pending_data;  /* Pushed frame, waiting for LVGL task */
+    void                *pending_frame;
+    bool                pending;
+    bool                update_queued;  /* Update is in LVGL async queue */
+    void                *shown_frame;   /* Frame used by LVGL image or being transferred */
+    bool                shown;
+    SemaphoreHandle_t   done_sem;       /* Direct transfer done */
+    QueueHandle_t       area_queue;     /* Frame parts waiting for LVGL task (direct mode) */
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+#if LVGL_PORT_VIDEO_SUPPORTED
+static void lvgl_port_video_update(void *arg);
+static void lvgl_port_video_update_areas(void *arg);
+static void lvgl_port_video_draw(lvgl_port_video_handle_t video, const lv_area_t *area, const void *data, void *frame);
+static void lvgl_port_video_free(void *arg);
+static bool lvgl_port_video_done_callback(void *user_ctx);
+#endif
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_video_create(const lvgl_port_video_cfg_t *cfg, lvgl_port_video_handle_t *ret_video)
+{
+#if LVGL_PORT_VIDEO_SUPPORTED
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(cfg && ret_video && cfg->disp, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(cfg->hres > 0 && cfg->vres > 0, ESP_ERR_INVALID_ARG, TAG, "invalid video resolution");
+
+    lvgl_port_video_handle_t video = calloc(1, sizeof(struct lvgl_port_video_s));
+    ESP_RETURN_ON_FALSE(video, ESP_ERR_NO_MEM, TAG, "Not enough memory for video layer allocation!");
+    video->disp = cfg->disp;
+    video->direct = cfg->flags.direct;
+    video->release_cb = cfg->release_cb;
+    video->user_ctx = cfg->user_ctx;
+    portMUX_INITIALIZE(&video->lock);
+
+    lvgl_port_lock(0);
+    if (video->direct) {
+        ESP_GOTO_ON_FALSE(cfg->x >= 0 && cfg->y >= 0, ESP_ERR_INVALID_ARG, err, TAG, "invalid video position");
+        ESP_GOTO_ON_ERROR(lvgl_port_disp_draw_external(cfg->disp, 0, 0, 0, 0, NULL, NULL, NULL), err, TAG, "Direct video is not supported by the display!");
+        lv_area_set(&video->area, cfg->x, cfg->y, cfg->x + cfg->hres, cfg->y + cfg->vres);
+        video->done_sem = xSemaphoreCreateBinary();
+        ESP_GOTO_ON_FALSE(video->done_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create video Semaphore");
+        video->area_queue = xQueueCreate(LVGL_PORT_VIDEO_AREA_QUEUE_LEN, sizeof(lvgl_port_video_area_t));
+        ESP_GOTO_ON_FALSE(video->area_queue, ESP_ERR_NO_MEM, err, TAG, "Failed to create video queue");
+    } else {
+        const lv_color_format_t cf = (cfg->color_format != 0 ? cfg->color_format : LV_COLOR_FORMAT_RGB565);
+        video->dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+        video->dsc.header.cf = cf;
+        video->dsc.header.w = cfg->hres;
+        video->dsc.header.h = cfg->vres;
+        video->dsc.header.stride = lv_draw_buf_width_to_stride(cfg->hres, cf);
+        video->dsc.data_size = video->dsc.header.stride * cfg->vres;
+        video->img = lv_image_create(cfg->parent ? cfg->parent : lv_display_get_screen_active(cfg->disp));
+        ESP_GOTO_ON_FALSE(video->img, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for video image!");
+        lv_obj_set_size(video->img, cfg->hres, cfg->vres);
+    }
+    lvgl_port_unlock();
+
+    *ret_video = video;
+    return ESP_OK;
+
+err:
+    lvgl_port_unlock();
+    if (video->done_sem) {
+        vSemaphoreDelete(video->done_sem);
+    }
+    if (video->area_queue) {
+        vQueueDelete(video->area_queue);
+    }
+    free(video);
+    return ret;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t lvgl_port_video_push(lvgl_port_video_handle_t video, const void *data, void *frame)
+{
+#if LVGL_PORT_VIDEO_SUPPORTED
+    ESP_RETURN_ON_FALSE(video && data, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    /* Replace the pending frame, it is dropped */
+    portENTER_CRITICAL(&video->lock);
+    const bool dropped = video->pending;
+    void *dropped_frame = video->pending_frame;
+    video->pending_data = data;
+    video->pending_frame = frame;
+    video->pending = true;
+    const bool queue = !video->update_queued;
+    video->update_queued = true;
+    portEXIT_CRITICAL(&video->lock);
+
+    if (dropped && video->release_cb) {
+        video->release_cb(dropped_frame, video->user_ctx);
+    }
+
+    if (queue) {
+        esp_err_t ret = lvgl_port_async_call(lvgl_port_video_update, video);
+        if (ret != ESP_OK) {
+            portENTER_CRITICAL(&video->lock);
+            video->pending = false;
+            video->update_queued = false;
+            portEXIT_CRITICAL(&video->lock);
+            if (video->release_cb) {
+                video->release_cb(frame, video->user_ctx);
+            }
+            return ret;
+        }
+    }
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t lvgl_port_video_push_area(lvgl_port_video_handle_t video, const lv_area_t *area, const void *data, void *frame)
+{
+#if LVGL_PORT_VIDEO_SUPPORTED
+    ESP_RETURN_ON_FALSE(video && area && data, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(video->direct, ESP_ERR_NOT_SUPPORTED, TAG, "Frame parts are supported only in direct mode!");
+    ESP_RETURN_ON_FALSE(area->x1 >= 0 && area->y1 >= 0 && area->x1 <= area->x2 && area->y1 <= area->y2 &&
+                        area->x2 < video->area.x2 - video->area.x1 && area->y2 < video->area.y2 - video->area.y1,
+                        ESP_ERR_INVALID_ARG, TAG, "area is out of the video");
+
+    lvgl_port_video_area_t item = {
+        .data = data,
+        .frame = frame,
+    };
+    lv_area_set(&item.area, video->area.x1 + area->x1, video->area.y1 + area->y1, video->area.x1 + area->x2 + 1, video->area.y1 + area->y2 + 1);
+    xQueueSend(video->area_queue, &item, portMAX_DELAY);
+
+    /* The part is queued already, wait for free space in LVGL async queue */
+    return lvgl_port_async_call_wait(lvgl_port_video_update_areas, video, portMAX_DELAY);
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+lv_obj_t *lvgl_port_video_get_obj(lvgl_port_video_handle_t video)
+{
+    assert(video);
+    return video->img;
+}
+
+esp_err_t lvgl_port_video_delete(lvgl_port_video_handle_t video)
+{
+#if LVGL_PORT_VIDEO_SUPPORTED
+    ESP_RETURN_ON_FALSE(video, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    /* Queued after the pending update, so it is freed last */
+    return lvgl_port_async_call(lvgl_port_video_free, video);
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+#if LVGL_PORT_VIDEO_SUPPORTED
+static bool lvgl_port_video_done_callback(void *user_ctx)
+{
+    BaseType_t need_yield = pdFALSE;
+    lvgl_port_video_handle_t video = (lvgl_port_video_handle_t)user_ctx;
+    xSemaphoreGiveFromISR(video->done_sem, &need_yield);
+    return (need_yield == pdTRUE);
+}
+
+/* Called in LVGL task */
+static void lvgl_port_video_update(void *arg)
+{
+    lvgl_port_video_handle_t video = (lvgl_port_video_handle_t)arg;
+
+    portENTER_CRITICAL(&video->lock);
+    const bool pending = video->pending;
+    const void *data = video->pending_data;
+    void *frame = video->pending_frame;
+    video->pending = false;
+    video->update_queued = false;
+    portEXIT_CRITICAL(&video->lock);
+
+    if (!pending) {
+        return;
+    }
+
+    if (video->direct) {
+        lvgl_port_video_draw(video, &video->area, data, frame);
+        return;
+    }
+
+    const bool shown = video->shown;
+    void *shown_frame = video->shown_frame;
+
+    /* LVGL draws the image in LVGL task, the previous frame is not referenced after the source change */
+    video->dsc.data = data;
+    lv_image_cache_drop(&video->dsc);
+    lv_image_set_src(video->img, &video->dsc);
+    lv_obj_invalidate(video->img);
+    video->shown = true;
+    video->shown_frame = frame;
+
+    if (shown && video->release_cb) {
+        video->release_cb(shown_frame, video->user_ctx);
+    }
+}
+
+/* Called in LVGL task */
+static void lvgl_port_video_update_areas(void *arg)
+{
+    lvgl_port_video_handle_t video = (lvgl_port_video_handle_t)arg;
+    lvgl_port_video_area_t item;
+
+    /* All queued parts, the next async calls may find the queue empty */
+    while (xQueueReceive(video->area_queue, &item, 0) == pdTRUE) {
+        lvgl_port_video_draw(video, &item.area, item.data, item.frame);
+    }
+}
+
+/* Called in LVGL task */
+static void lvgl_port_video_draw(lvgl_port_video_handle_t video, const lv_area_t *area, const void *data, void *frame)
+{
+    const bool shown = video->shown;
+    void *shown_frame = video->shown_frame;
+
+    /* The previous frame can be released, when its transfer is done */
+    if (shown) {
+        xSemaphoreTake(video->done_sem, portMAX_DELAY);
+    }
+    video->shown = (lvgl_port_disp_draw_external(video->disp, area->x1, area->y1, area->x2, area->y2, data,
+                    lvgl_port_video_done_callback, video) == ESP_OK);
+    if (!video->shown) {
+        ESP_LOGE(TAG, "Video frame send failed!");
+        if (video->release_cb) {
+            video->release_cb(frame, video->user_ctx);
+        }
+    }
+    video->shown_frame = frame;
+
+    if (shown && video->release_cb) {
+        video->release_cb(shown_frame, video->user_ctx);
+    }
+}
+
+/* Called in LVGL task */
+static void lvgl_port_video_free(void *arg)
+{
+    lvgl_port_video_handle_t video = (lvgl_port_video_handle_t)arg;
+
+    if (video->img) {
+        lv_obj_delete(video->img);
+    }
+    if (video->direct && video->shown) {
+        xSemaphoreTake(video->done_sem, portMAX_DELAY);
+    }
+    if (video->shown && video->release_cb) {
+        video->release_cb(video->shown_frame, video->user_ctx);
+    }
+    if (video->pending && video->release_cb) {
+        video->release_cb(video->pending_frame, video->user_ctx);
+    }
+    if (video->area_queue) {
+        lvgl_port_video_area_t item;
+        while (xQueueReceive(video->area_queue, &item, 0) == pdTRUE) {
+            if (video->release_cb) {
+                video->release_cb(item.frame, video->user_ctx);
+            }
+        }
+        vQueueDelete(video->area_queue);
+    }
+    if (video->done_sem) {
+        vSemaphoreDelete(video->done_sem);
+    }
+    free(video);
+}
+#endif
@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_lvgl_port.h"
+#include "lvgl.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+/* One pixel per point and per value, the display is the chart */
+#define TEST_POINTS     (16)
+#define TEST_HEIGHT     (32)
+#define TEST_MAX        (TEST_HEIGHT - 1)
+/* Ring wraps around */
+#define TEST_ADDED      (TEST_POINTS + 4)
+/* Point with missing value (gap in the line) */
+#define TEST_GAP        (10)
+
+#define TEST_LINE_COLOR (0xffff)
+
+static uint16_t test_draw_buf[TEST_POINTS * TEST_HEIGHT] __attribute__((aligned(64)));
+static uint16_t test_frame[TEST_POINTS * TEST_HEIGHT];
+static lv_display_t *test_disp;
+
+static void test_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    /* Full render mode, whole frame at once */
+    memcpy(test_frame, px_map, sizeof(test_frame));
+    lv_display_flush_ready(disp);
+}
+
+static void test_disp_new(void)
+{
+    const lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_init(&lvgl_cfg));
+    TEST_ASSERT_TRUE(lvgl_port_lock(0));
+    test_disp = lv_display_create(TEST_POINTS, TEST_HEIGHT);
+    assert(test_disp);
+    lv_display_set_color_format(test_disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(test_disp, test_draw_buf, NULL, sizeof(test_draw_buf), LV_DISPLAY_RENDER_MODE_FULL);
+    lv_display_set_flush_cb(test_disp, test_flush_cb);
+    lvgl_port_unlock();
+}
+
+static void test_disp_del(void)
+{
+    TEST_ASSERT_TRUE(lvgl_port_lock(0));
+    lv_display_delete(test_disp);
+    lvgl_port_unlock();
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_deinit());
+}
+
+static int32_t test_value(int i)
+{
+    return (i == TEST_GAP) ? LVGL_PORT_CHART_POINT_NONE : (i * 7) % (TEST_MAX + 1);
+}
+
+static int32_t test_value_to_y(int32_t value, int32_t max)
+{
+    return TEST_MAX - value * TEST_MAX / max;
+}
+
+/*
+ * Compare the displayed chart with the points added until now: column of each point has the segment from
+ * the previous added point, if it is displayed. Only the newest points are displayed, the oldest is on the left
+ * edge (scroll mode) or the newest overwrite the oldest at the empty cursor column (sweep mode).
+ */
+static void test_check_frame(lvgl_port_chart_mode_t mode, int added, int32_t max)
+{
+    TEST_ASSERT_TRUE(lvgl_port_lock(0));
+    lv_refr_now(test_disp);
+    lvgl_port_unlock();
+
+    for (int x = 0; x < TEST_POINTS; x++) {
+        int point = -1;
+        bool segment = true;
+        if (mode == LVGL_PORT_CHART_MODE_SCROLL) {
+            point = added - TEST_POINTS + x;
+            segment = (x > 0);
+        } else if (x != added % TEST_POINTS && added > x) {
+            point = x + TEST_POINTS * ((added - 1 - x) / TEST_POINTS);
+        }
+        int32_t y1 = TEST_HEIGHT;
+        int32_t y2 = -1;
+        if (point >= 0 && test_value(point) != LVGL_PORT_CHART_POINT_NONE) {
+            y1 = y2 = test_value_to_y(test_value(point), max);
+            if (segment && point > 0 && test_value(point - 1) != LVGL_PORT_CHART_POINT_NONE) {
+                const int32_t yp = test_value_to_y(test_value(point - 1), max);
+                y1 = LV_MIN(y1, yp);
+                y2 = LV_MAX(y2, yp);
+            }
+        }
+        for (int32_t y = 0; y < TEST_HEIGHT; y++) {
+            const bool line = (test_frame[y * TEST_POINTS + x] == TEST_LINE_COLOR);
+            if (line != (y >= y1 && y <= y2)) {
+                TEST_FAIL_MESSAGE("Wrong pixel of the line");
+            }
+        }
+    }
+}
+
+static void test_chart_mode(lvgl_port_chart_mode_t mode)
+{
+    lvgl_port_chart_handle_t chart = NULL;
+    test_disp_new();
+    lvgl_port_chart_cfg_t cfg = {
+        .parent = lv_display_get_screen_active(test_disp),
+        .mode = mode,
+        .point_num = TEST_POINTS,
+        .height = TEST_HEIGHT,
+        .min = 0,
+        .max = TEST_MAX,
+        .series_num = 1,
+        .series_color = {lv_color_white()},
+        .bg_color = lv_color_black(),
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_chart_create(&cfg, &chart));
+    test_check_frame(mode, 0, TEST_MAX);
+
+    /* Incremental rendering of added points, before and after the wraparound of the ring */
+    for (int i = 0; i < TEST_ADDED; i++) {
+        const int32_t value = test_value(i);
+        TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_chart_add_point(chart, &value));
+        test_check_frame(mode, i + 1, TEST_MAX);
+    }
+
+    /* Full rendering of the wrapped ring is the same as the incremental one */
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_chart_set_range(chart, 0, TEST_MAX * 2));
+    test_check_frame(mode, TEST_ADDED, TEST_MAX * 2);
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_chart_set_range(chart, 0, TEST_MAX));
+    test_check_frame(mode, TEST_ADDED, TEST_MAX);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, lvgl_port_chart_set_range(chart, TEST_MAX, 0));
+
+    lvgl_port_chart_info_t info;
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_chart_get_info(chart, &info));
+    TEST_ASSERT_EQUAL(TEST_ADDED, info.points);
+    TEST_ASSERT_EQUAL(3, info.renders);
+    TEST_ASSERT_EQUAL(TEST_POINTS * TEST_HEIGHT * sizeof(uint16_t), info.buf_size);
+
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_chart_clear(chart));
+    test_check_frame(mode, 0, TEST_MAX);
+
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_chart_delete(chart));
+    test_disp_del();
+}
+
+TEST_CASE("Chart in scroll mode", "[chart]")
+{
+    test_chart_mode(LVGL_PORT_CHART_MODE_SCROLL);
+}
+
+TEST_CASE("Chart in sweep mode", "[chart]")
+{
+    test_chart_mode(LVGL_PORT_CHART_MODE_SWEEP);
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (300)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    /* Deleted LVGL task is freed by the idle task */
+    vTaskDelay(pdMS_TO_TICKS(10));
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
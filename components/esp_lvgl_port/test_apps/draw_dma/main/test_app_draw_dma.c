@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_lvgl_port.h"
+#include "lvgl.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#if !(CONFIG_LVGL_PORT_DRAW_DMA && LV_VERSION_CHECK(9, 1, 0) && !LV_VERSION_CHECK(9, 2, 0))
+#error "DMA draw unit is used only with CONFIG_LVGL_PORT_DRAW_DMA and LVGL 9.1"
+#endif
+
+/* IDs of the DMA draw unit (esp_lvgl_port_draw_dma.c) and SW draw unit (lv_draw_sw.c) */
+#define TEST_DMA_UNIT_ID    (80)
+#define TEST_SW_UNIT_ID     (1)
+
+#define TEST_HOR_RES        (128)
+#define TEST_VER_RES        (96)
+/* Rows of the canvas start on the PPA cache line (ESP32-P4) and on the word (ESP32-S3) */
+#define TEST_BUF_ALIGN      (128)
+#define TEST_BUF_SIZE       (TEST_HOR_RES * TEST_VER_RES * sizeof(uint16_t))
+
+#define TEST_IMG_W          (64)
+#define TEST_IMG_H          (48)
+
+/* Canvas rendered by the draw units and the reference canvas rendered only by SW draw unit */
+#define TEST_CANVAS_DMA     (0)
+#define TEST_CANVAS_SW      (1)
+#define TEST_CANVASES       (2)
+
+/* Same tasks are drawn into both canvases */
+typedef struct {
+    lv_display_t *disp;
+    uint16_t *buf[TEST_CANVASES];
+    lv_obj_t *canvas[TEST_CANVASES];
+    lv_layer_t layer[TEST_CANVASES];
+    uint32_t wrong_units;   /* Tasks taken by other unit than expected */
+} test_scene_t;
+
+static void test_scene_new(test_scene_t *scene)
+{
+    memset(scene, 0, sizeof(test_scene_t));
+    const lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_init(&lvgl_cfg));
+    for (int i = 0; i < TEST_CANVASES; i++) {
+        scene->buf[i] = heap_caps_aligned_alloc(TEST_BUF_ALIGN, TEST_BUF_SIZE, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        TEST_ASSERT_NOT_NULL(scene->buf[i]);
+        memset(scene->buf[i], 0x5a, TEST_BUF_SIZE);
+    }
+
+    /* Private display without refresh, the canvases are rendered only by lv_canvas_finish_layer() */
+    TEST_ASSERT_TRUE(lvgl_port_lock(0));
+    scene->disp = lv_display_create(TEST_HOR_RES, TEST_VER_RES);
+    assert(scene->disp);
+    lv_display_delete_refr_timer(scene->disp);
+    for (int i = 0; i < TEST_CANVASES; i++) {
+        scene->canvas[i] = lv_canvas_create(lv_display_get_screen_active(scene->disp));
+        assert(scene->canvas[i]);
+        lv_canvas_set_buffer(scene->canvas[i], scene->buf[i], TEST_HOR_RES, TEST_VER_RES, LV_COLOR_FORMAT_RGB565);
+        lv_canvas_init_layer(scene->canvas[i], &scene->layer[i]);
+    }
+}
+
+static lv_draw_task_t *test_last_task(lv_layer_t *layer)
+{
+    lv_draw_task_t *t = layer->draw_task_head;
+    while (t && t->next) {
+        t = t->next;
+    }
+    return t;
+}
+
+/* Check the unit chosen for the last task of DMA canvas, the last task of the reference is given to SW draw unit */
+static void test_scene_check_unit(test_scene_t *scene, lv_draw_task_type_t type, bool dma)
+{
+    lv_draw_task_t *t = test_last_task(&scene->layer[TEST_CANVAS_DMA]);
+    if (t == NULL || t->type != type || (t->preferred_draw_unit_id == TEST_DMA_UNIT_ID) != dma) {
+        scene->wrong_units++;
+    }
+    t = test_last_task(&scene->layer[TEST_CANVAS_SW]);
+    if (t) {
+        t->preferred_draw_unit_id = TEST_SW_UNIT_ID;
+        t->preference_score = 100;
+    }
+}
+
+/* dma: the task is taken by DMA draw unit (rendered by DMA or by CPU, when the area is not usable by DMA) */
+static void test_scene_fill(test_scene_t *scene, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color, lv_opa_t opa, int32_t radius, bool dma)
+{
+    const lv_area_t area = {x1, y1, x2, y2};
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_hex(color);
+    dsc.bg_opa = opa;
+    dsc.radius = radius;
+    for (int i = 0; i < TEST_CANVASES; i++) {
+        lv_draw_rect(&scene->layer[i], &dsc, &area);
+    }
+    test_scene_check_unit(scene, LV_DRAW_TASK_TYPE_FILL, dma);
+}
+
+static void test_scene_image(test_scene_t *scene, const lv_image_dsc_t *img, int32_t x, int32_t y, lv_opa_t opa, bool dma)
+{
+    const lv_area_t area = {x, y, x + img->header.w - 1, y + img->header.h - 1};
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = img;
+    dsc.opa = opa;
+    for (int i = 0; i < TEST_CANVASES; i++) {
+        lv_draw_image(&scene->layer[i], &dsc, &area);
+    }
+    test_scene_check_unit(scene, LV_DRAW_TASK_TYPE_IMAGE, dma);
+}
+
+/* Render all tasks (DMA and CPU in parallel) and compare the canvas with the SW rendered reference */
+static void test_scene_render(test_scene_t *scene)
+{
+    for (int i = 0; i < TEST_CANVASES; i++) {
+        lv_canvas_finish_layer(scene->canvas[i], &scene->layer[i]);
+    }
+    lvgl_port_unlock();
+
+    TEST_ASSERT_EQUAL(0, scene->wrong_units);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(scene->buf[TEST_CANVAS_SW], scene->buf[TEST_CANVAS_DMA], TEST_HOR_RES * TEST_VER_RES);
+}
+
+static uint16_t test_scene_pixel(const test_scene_t *scene, int32_t x, int32_t y)
+{
+    return scene->buf[TEST_CANVAS_DMA][y * TEST_HOR_RES + x];
+}
+
+static void test_scene_del(test_scene_t *scene)
+{
+    TEST_ASSERT_TRUE(lvgl_port_lock(0));
+    lv_display_delete(scene->disp);
+    lvgl_port_unlock();
+    for (int i = 0; i < TEST_CANVASES; i++) {
+        heap_caps_free(scene->buf[i]);
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_deinit());
+}
+
+TEST_CASE("DMA draw unit fills match SW renderer", "[draw_dma]")
+{
+    test_scene_t scene;
+    test_scene_new(&scene);
+
+    /* Whole canvas and whole rows */
+    test_scene_fill(&scene, 0, 0, TEST_HOR_RES - 1, TEST_VER_RES - 1, 0x203040, LV_OPA_COVER, 0, true);
+    test_scene_fill(&scene, 0, 84, TEST_HOR_RES - 1, TEST_VER_RES - 1, 0x40ff40, LV_OPA_COVER, 0, true);
+    /* Rows aligned to the cache line */
+    test_scene_fill(&scene, 64, 8, 127, 39, 0xff8000, LV_OPA_COVER, 0, true);
+    /* Unaligned start, odd width and clipped by the canvas, these are rendered by CPU in the DMA draw unit task */
+    test_scene_fill(&scene, 3, 10, 100, 50, 0x00c0ff, LV_OPA_COVER, 0, true);
+    test_scene_fill(&scene, 4, 60, 36, 80, 0xc000c0, LV_OPA_COVER, 0, true);
+    test_scene_fill(&scene, -16, 20, 40, 70, 0xffff00, LV_OPA_COVER, 0, true);
+    /* Small, rounded and transparent fills are left for SW draw unit */
+    test_scene_fill(&scene, 110, 50, 119, 59, 0xffffff, LV_OPA_COVER, 0, false);
+    test_scene_fill(&scene, 40, 30, 90, 70, 0x800000, LV_OPA_COVER, 10, false);
+    test_scene_fill(&scene, 50, 0, 120, 60, 0x0000ff, LV_OPA_50, 0, false);
+    test_scene_render(&scene);
+
+    /* The canvas is rendered (not only equal) */
+    TEST_ASSERT_EQUAL_HEX16(lv_color_to_u16(lv_color_hex(0x40ff40)), test_scene_pixel(&scene, 100, 90));
+    TEST_ASSERT_EQUAL_HEX16(lv_color_to_u16(lv_color_hex(0x00c0ff)), test_scene_pixel(&scene, 45, 12));
+
+    test_scene_del(&scene);
+}
+
+TEST_CASE("DMA draw unit image copies match SW renderer", "[draw_dma]")
+{
+    test_scene_t scene;
+    uint16_t *img_buf = heap_caps_aligned_alloc(TEST_BUF_ALIGN, TEST_IMG_W * TEST_IMG_H * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(img_buf);
+    /* Every pixel differs from its neighbors, wrong offsets of rows or columns are visible */
+    for (uint32_t i = 0; i < TEST_IMG_W * TEST_IMG_H; i++) {
+        img_buf[i] = (uint16_t)((i * 2654435761u) >> 16);
+    }
+    const lv_image_dsc_t img = {
+        .header = {
+            .magic = LV_IMAGE_HEADER_MAGIC,
+            .cf = LV_COLOR_FORMAT_RGB565,
+            .w = TEST_IMG_W,
+            .h = TEST_IMG_H,
+            .stride = TEST_IMG_W * sizeof(uint16_t),
+        },
+        .data_size = TEST_IMG_W * TEST_IMG_H * sizeof(uint16_t),
+        .data = (const uint8_t *)img_buf,
+    };
+    test_scene_new(&scene);
+
+    test_scene_fill(&scene, 0, 0, TEST_HOR_RES - 1, TEST_VER_RES - 1, 0x203040, LV_OPA_COVER, 0, true);
+    /* Transparent image is blended by SW draw unit */
+    test_scene_image(&scene, &img, 30, 20, LV_OPA_50, false);
+    /* Rows aligned to the cache line */
+    test_scene_image(&scene, &img, 0, 0, LV_OPA_COVER, true);
+    test_scene_image(&scene, &img, 64, 48, LV_OPA_COVER, true);
+    /* Unaligned destination, copied by CPU in the DMA draw unit task */
+    test_scene_image(&scene, &img, 7, 33, LV_OPA_COVER, true);
+    /* Clipped by the canvas, copied from the middle of the image */
+    test_scene_image(&scene, &img, -10, -6, LV_OPA_COVER, true);
+    test_scene_image(&scene, &img, 90, 70, LV_OPA_COVER, true);
+    test_scene_render(&scene);
+
+    /* The canvas is rendered (not only equal) */
+    TEST_ASSERT_EQUAL_HEX16(img_buf[10 * TEST_IMG_W + 10], test_scene_pixel(&scene, 100, 80));
+    TEST_ASSERT_EQUAL_HEX16(img_buf[2 * TEST_IMG_W + 11], test_scene_pixel(&scene, 75, 50));
+
+    test_scene_del(&scene);
+    heap_caps_free(img_buf);
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (300)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    /* Deleted LVGL and DMA draw unit tasks are freed by the idle task */
+    vTaskDelay(pdMS_TO_TICKS(10));
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "host_benchmark_report.h"
+
+void host_benchmark_report(const char *kernel, const char *bench_case, int32_t width, int32_t height, float ns_per_px,
+                           uint64_t bytes_per_frame, float bus_us_per_frame)
+{
+    // Plain printf, one line per result, it is collected from the test log
+    printf(HOST_BENCHMARK_REPORT_PREFIX ",%s,%s,%" PRIi32 ",%" PRIi32 ",%.3f,%" PRIu64 ",%.1f\n",
+           kernel, bench_case, width, height, ns_per_px, bytes_per_frame, bus_us_per_frame);
+}
@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Prefix of the machine readable benchmark report lines
+ *
+ * Every benchmark result is printed as one CSV line:
+ * HOST_BENCH,<kernel>,<case>,<width>,<height>,<ns_per_px>,<bytes_per_frame>,<bus_us_per_frame>
+ */
+#define HOST_BENCHMARK_REPORT_PREFIX "HOST_BENCH"
+
+// ------------------------------------------------ Function headers --------------------------------------------------
+
+/**
+ * @brief Print one benchmark result as a machine readable report line
+ *
+ * @param[in] kernel Kernel name (e.g. flush_rgb565_swap)
+ * @param[in] bench_case Benchmark case (e.g. rot90)
+ * @param[in] width Width of the frame in pixels
+ * @param[in] height Height of the frame in pixels
+ * @param[in] ns_per_px Host time of the transform per pixel in nanoseconds
+ * @param[in] bytes_per_frame Bytes sent to the mock panel per frame
+ * @param[in] bus_us_per_frame Modelled bus time of the mock panel per frame in microseconds
+ */
+void host_benchmark_report(const char *kernel, const char *bench_case, int32_t width, int32_t height, float ns_per_px,
+                           uint64_t bytes_per_frame, float bus_us_per_frame);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
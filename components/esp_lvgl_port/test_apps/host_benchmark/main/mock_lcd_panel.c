@@ -0,0 +1,52 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <time.h>
+#include "mock_lcd_panel.h"
+
+uint64_t mock_lcd_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+esp_err_t mock_lcd_panel_draw_bitmap(mock_lcd_panel_t *panel, int x_start, int y_start, int x_end, int y_end, const void *color_data)
+{
+    if (panel == NULL || color_data == NULL || x_start < 0 || y_start < 0 || x_start >= x_end || y_start >= y_end ||
+            x_end > panel->h_res || y_end > panel->v_res) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const uint64_t len = (uint64_t)(x_end - x_start) * (y_end - y_start) * panel->bits_per_pixel / 8;
+    panel->transfers++;
+    panel->bytes += len;
+    if (panel->bus_clock_hz > 0 && panel->bus_width > 0) {
+        panel->bus_ns += len * 8 * 1000000000ULL / ((uint64_t)panel->bus_clock_hz * panel->bus_width);
+    }
+
+    if (panel->frame_buffer && panel->bits_per_pixel >= 8) {
+        const uint64_t start = mock_lcd_time_ns();
+        const size_t px_size = panel->bits_per_pixel / 8;
+        const size_t row_len = (x_end - x_start) * px_size;
+        const uint8_t *src = (const uint8_t *)color_data;
+        for (int y = y_start; y < y_end; y++) {
+            memcpy(panel->frame_buffer + ((size_t)y * panel->h_res + x_start) * px_size, src, row_len);
+            src += row_len;
+        }
+        panel->copy_ns += mock_lcd_time_ns() - start;
+    }
+    return ESP_OK;
+}
+
+void mock_lcd_panel_reset(mock_lcd_panel_t *panel)
+{
+    panel->transfers = 0;
+    panel->bytes = 0;
+    panel->bus_ns = 0;
+    panel->copy_ns = 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Mock of LCD panel, it records the transfers instead of sending them
+ *
+ * The bus time is modelled from the transferred bytes, the clock and the width of the bus (e.g. SPI 40 MHz, 1 line).
+ */
+typedef struct {
+    int         h_res;              /*!< Horizontal resolution of the panel */
+    int         v_res;              /*!< Vertical resolution of the panel */
+    uint32_t    bits_per_pixel;     /*!< Bits per pixel (1 for monochrome pages, 16, 24) */
+    uint32_t    bus_clock_hz;       /*!< Modelled bus clock */
+    uint32_t    bus_width;          /*!< Modelled data lines of the bus */
+    uint8_t     *frame_buffer;      /*!< Copy of the transferred pixels (optional, only for bits_per_pixel >= 8) */
+
+    /* Recorded by mock_lcd_panel_draw_bitmap() */
+    uint32_t    transfers;          /*!< Count of draw_bitmap calls */
+    uint64_t    bytes;              /*!< Transferred bytes */
+    uint64_t    bus_ns;             /*!< Modelled bus time of the transfers */
+    uint64_t    copy_ns;            /*!< Time spent in draw_bitmap copying into frame_buffer */
+} mock_lcd_panel_t;
+
+// ------------------------------------------------ Function headers --------------------------------------------------
+
+/**
+ * @brief Monotonic time in nanoseconds
+ */
+uint64_t mock_lcd_time_ns(void);
+
+/**
+ * @brief Draw bitmap on the mock panel (same arguments as esp_lcd_panel_draw_bitmap)
+ *
+ * @param[in] panel Mock panel
+ * @param[in] x_start Start column (included)
+ * @param[in] y_start Start row (included)
+ * @param[in] x_end End column (excluded)
+ * @param[in] y_end End row (excluded)
+ * @param[in] color_data Pixels of the area
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if the area is out of the panel
+ */
+esp_err_t mock_lcd_panel_draw_bitmap(mock_lcd_panel_t *panel, int x_start, int y_start, int x_end, int y_end, const void *color_data);
+
+/**
+ * @brief Clear recorded transfers of the mock panel
+ *
+ * @param[in] panel Mock panel
+ */
+void mock_lcd_panel_reset(mock_lcd_panel_t *panel);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
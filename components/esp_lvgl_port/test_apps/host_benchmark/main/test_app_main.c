@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unity.h"
+
+void app_main(void)
+{
+    printf("LVGL port host benchmark\r\n");
+
+    /* No console on CI host: all the tests are run and the failures are the exit code */
+    UNITY_BEGIN();
+    unity_run_all_tests();
+    exit(UNITY_END());
+}
+
+/* setUp runs before every test */
+void setUp(void)
+{
+}
+
+/* tearDown runs after every test */
+void tearDown(void)
+{
+}
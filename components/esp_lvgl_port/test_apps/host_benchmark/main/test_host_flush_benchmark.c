@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "unity.h"
+#include "esp_lvgl_port_rotate.h"
+#include "mock_lcd_panel.h"
+#include "host_benchmark_report.h"
+
+/* Logical (rotated) display and draw buffer of 1/10 screen, flushed band by band as in the LVGL port */
+#define WIDTH 320
+#define HEIGHT 240
+#define BAND_HEIGHT 24
+#define BENCHMARK_FRAMES 50
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Flush path of the LVGL port
+ */
+typedef enum {
+    HOST_FLUSH_RGB565,              /*!< RGB565 rotated (or copied) with byte swap */
+    HOST_FLUSH_XRGB8888_TO_RGB565,  /*!< XRGB8888 converted to RGB565 with byte swap */
+    HOST_FLUSH_RGB888_TO_RGB888,    /*!< RGB888 converted to panel byte order */
+    HOST_FLUSH_L8_TO_RGB565,        /*!< L8 expanded through LUT */
+} host_flush_t;
+
+/**
+ * @brief Parameters of one flush test case
+ */
+typedef struct {
+    const char *kernel;             /*!< Name in the report */
+    host_flush_t flush;             /*!< Flush path */
+    lvgl_port_rotate_t rotation;    /*!< Rotation of the display */
+    uint32_t src_px_size;           /*!< Source pixel size in bytes */
+    uint32_t panel_px_size;         /*!< Panel pixel size in bytes */
+} host_flush_case_t;
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static uint16_t l8_lut[256];
+
+// ------------------------------------------------ Static functions ---------------------------------------------------
+
+/* Pixel of the panel for logical pixel (x, y), same mapping as lvgl_port_rotate_area() */
+static void host_flush_map_px(lvgl_port_rotate_t rotation, int32_t x, int32_t y, int32_t *px, int32_t *py)
+{
+    switch (rotation) {
+    case LVGL_PORT_ROTATE_90:
+        *px = y;
+        *py = WIDTH - 1 - x;
+        break;
+    case LVGL_PORT_ROTATE_180:
+        *px = WIDTH - 1 - x;
+        *py = HEIGHT - 1 - y;
+        break;
+    case LVGL_PORT_ROTATE_270:
+        *px = HEIGHT - 1 - y;
+        *py = x;
+        break;
+    default:
+        *px = x;
+        *py = y;
+        break;
+    }
+}
+
+/* Transform one band and send it to the panel, returns time of the transform */
+static uint64_t host_flush_band(const host_flush_case_t *tc, mock_lcd_panel_t *panel, const uint8_t *src, uint8_t *dest, int32_t y1)
+{
+    const int32_t w = WIDTH;
+    const int32_t h = BAND_HEIGHT;
+    const int32_t src_stride = w * tc->src_px_size;
+    const bool swap_xy = (tc->rotation == LVGL_PORT_ROTATE_90 || tc->rotation == LVGL_PORT_ROTATE_270);
+    const int32_t dest_stride = (swap_xy ? h : w) * tc->panel_px_size;
+
+    const uint64_t start = mock_lcd_time_ns();
+    switch (tc->flush) {
+    case HOST_FLUSH_RGB565:
+        lvgl_port_rotate_tiled(src, dest, w, h, src_stride, dest_stride, tc->rotation, 2, true);
+        break;
+    case HOST_FLUSH_XRGB8888_TO_RGB565:
+        lvgl_port_convert_to_rgb565(src, dest, w, h, src_stride, dest_stride, 4, true);
+        break;
+    case HOST_FLUSH_RGB888_TO_RGB888:
+        lvgl_port_convert_to_rgb888(src, dest, w, h, src_stride, dest_stride, 3, true);
+        break;
+    case HOST_FLUSH_L8_TO_RGB565:
+        lvgl_port_convert_l8_to_rgb565(src, dest, w, h, src_stride, dest_stride, l8_lut);
+        break;
+    }
+    const uint64_t elapsed = mock_lcd_time_ns() - start;
+
+    /* Area of the band on the panel: the corners mapped */
+    int32_t ax1, ay1, ax2, ay2;
+    host_flush_map_px(tc->rotation, 0, y1, &ax1, &ay1);
+    host_flush_map_px(tc->rotation, w - 1, y1 + h - 1, &ax2, &ay2);
+    const int32_t x_start = (ax1 < ax2 ? ax1 : ax2);
+    const int32_t y_start = (ay1 < ay2 ? ay1 : ay2);
+    TEST_ASSERT_EQUAL(ESP_OK, mock_lcd_panel_draw_bitmap(panel, x_start, y_start, x_start + abs(ax2 - ax1) + 1, y_start + abs(ay2 - ay1) + 1, dest));
+    return elapsed;
+}
+
+/* Expected panel pixel of the logical source pixel */
+static void host_flush_expected_px(const host_flush_case_t *tc, const uint8_t *s, uint8_t *out)
+{
+    uint16_t c = 0;
+    switch (tc->flush) {
+    case HOST_FLUSH_RGB565:
+        c = *(const uint16_t *)s;
+        break;
+    case HOST_FLUSH_XRGB8888_TO_RGB565:
+        c = ((s[2] & 0xF8) << 8) | ((s[1] & 0xFC) << 3) | (s[0] >> 3);
+        break;
+    case HOST_FLUSH_RGB888_TO_RGB888:
+        out[0] = s[2];
+        out[1] = s[1];
+        out[2] = s[0];
+        return;
+    case HOST_FLUSH_L8_TO_RGB565:
+        memcpy(out, &l8_lut[s[0]], 2);
+        return;
+    }
+    c = __builtin_bswap16(c);
+    memcpy(out, &c, 2);
+}
+
+static void host_flush_test(const host_flush_case_t *tc)
+{
+    const bool swap_xy = (tc->rotation == LVGL_PORT_ROTATE_90 || tc->rotation == LVGL_PORT_ROTATE_270);
+    const size_t src_len = (size_t)WIDTH * HEIGHT * tc->src_px_size;
+    const size_t fb_len = (size_t)WIDTH * HEIGHT * tc->panel_px_size;
+    uint8_t *src = malloc(src_len);
+    uint8_t *dest = malloc((size_t)WIDTH * BAND_HEIGHT * tc->panel_px_size);
+    uint8_t *fb = calloc(1, fb_len);
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(dest);
+    TEST_ASSERT_NOT_NULL(fb);
+
+    srand(1);
+    for (size_t i = 0; i < src_len; i++) {
+        src[i] = rand();
+    }
+    for (int i = 0; i < 256; i++) {
+        l8_lut[i] = __builtin_bswap16(((i & 0xF8) << 8) | ((i & 0xFC) << 3) | (i >> 3));
+    }
+
+    mock_lcd_panel_t panel = {
+        .h_res = (swap_xy ? HEIGHT : WIDTH),
+        .v_res = (swap_xy ? WIDTH : HEIGHT),
+        .bits_per_pixel = tc->panel_px_size * 8,
+        .bus_clock_hz = 40 * 1000 * 1000,
+        .bus_width = 1,
+        .frame_buffer = fb,
+    };
+
+    /* Functionality: one frame through the mock panel is compared with the per pixel mapping */
+    for (int32_t y = 0; y < HEIGHT; y += BAND_HEIGHT) {
+        host_flush_band(tc, &panel, src + (size_t)y * WIDTH * tc->src_px_size, dest, y);
+    }
+    TEST_ASSERT_EQUAL_UINT32(HEIGHT / BAND_HEIGHT, panel.transfers);
+    TEST_ASSERT_EQUAL_UINT64(fb_len, panel.bytes);
+    for (int32_t y = 0; y < HEIGHT; y++) {
+        for (int32_t x = 0; x < WIDTH; x++) {
+            int32_t px, py;
+            uint8_t expected[4];
+            host_flush_map_px(tc->rotation, x, y, &px, &py);
+            host_flush_expected_px(tc, src + ((size_t)y * WIDTH + x) * tc->src_px_size, expected);
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, fb + ((size_t)py * panel.h_res + px) * tc->panel_px_size, tc->panel_px_size);
+        }
+    }
+
+    /* Benchmark: frame buffer copy of the mock is left out, only the transform is timed */
+    panel.frame_buffer = NULL;
+    mock_lcd_panel_reset(&panel);
+    uint64_t transform_ns = 0;
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+        for (int32_t y = 0; y < HEIGHT; y += BAND_HEIGHT) {
+            transform_ns += host_flush_band(tc, &panel, src + (size_t)y * WIDTH * tc->src_px_size, dest, y);
+        }
+    }
+
+    const char *rotation_name[] = {"rot0", "rot90", "rot180", "rot270"};
+    host_benchmark_report(tc->kernel, rotation_name[tc->rotation], WIDTH, HEIGHT,
+                          (float)transform_ns / BENCHMARK_FRAMES / (WIDTH * HEIGHT),
+                          panel.bytes / BENCHMARK_FRAMES, (float)panel.bus_ns / BENCHMARK_FRAMES / 1000);
+
+    free(src);
+    free(dest);
+    free(fb);
+}
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Flush tests
+
+Purpose:
+    - Check that the pure C flush transforms of the port send the right pixels to the right area of the panel
+    - Measure the transforms on the host, so regressions are visible in CI without a board
+
+Procedure:
+    - Flush one 320x240 frame in 24 rows high bands through the mock panel, compare its frame buffer with per pixel mapping
+    - Flush the frame multiple times, while measuring time of the transforms
+    - Print the report line with time per pixel, bytes per frame and modelled bus time per frame (SPI 40 MHz)
+*/
+
+TEST_CASE("Host flush RGB565 with rotation", "[flush][benchmark][RGB565]")
+{
+    for (int rotation = LVGL_PORT_ROTATE_0; rotation <= LVGL_PORT_ROTATE_270; rotation++) {
+        const host_flush_case_t tc = {"flush_rgb565_swap", HOST_FLUSH_RGB565, rotation, 2, 2};
+        host_flush_test(&tc);
+    }
+}
+
+TEST_CASE("Host flush XRGB8888 to RGB565", "[flush][benchmark][XRGB8888]")
+{
+    const host_flush_case_t tc = {"flush_xrgb8888_to_rgb565", HOST_FLUSH_XRGB8888_TO_RGB565, LVGL_PORT_ROTATE_0, 4, 2};
+    host_flush_test(&tc);
+}
+
+TEST_CASE("Host flush RGB888 to panel RGB888", "[flush][benchmark][RGB888]")
+{
+    const host_flush_case_t tc = {"flush_rgb888_to_rgb888", HOST_FLUSH_RGB888_TO_RGB888, LVGL_PORT_ROTATE_0, 3, 3};
+    host_flush_test(&tc);
+}
+
+TEST_CASE("Host flush L8 to RGB565", "[flush][benchmark][L8]")
+{
+    const host_flush_case_t tc = {"flush_l8_to_rgb565", HOST_FLUSH_L8_TO_RGB565, LVGL_PORT_ROTATE_0, 1, 2};
+    host_flush_test(&tc);
+}
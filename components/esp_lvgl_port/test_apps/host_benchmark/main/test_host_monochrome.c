@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity.h"
+#include "esp_lvgl_port_rotate.h"
+#include "mock_lcd_panel.h"
+#include "host_benchmark_report.h"
+
+/* SSD1306 like panel */
+#define MONO_HOR_RES 128
+#define MONO_VER_RES 64
+#define BENCHMARK_FRAMES 1000
+
+// ------------------------------------------------ Static functions ---------------------------------------------------
+
+/* Bit by bit reference, same as the unaligned path of _lvgl_port_transform_monochrome() */
+static void mono_reference(const uint8_t *src, uint8_t *out, bool src_i1, bool swap_xy, uint16_t hor_res, uint16_t ver_res)
+{
+    const uint16_t *color = (const uint16_t *)src;
+    for (int y = 0; y < ver_res; y++) {
+        for (int x = 0; x < hor_res; x++) {
+            bool lit;
+            if (src_i1) {
+                lit = (src[(hor_res >> 3) * y + (x >> 3)] & 1 << (7 - x % 8));
+            } else {
+                lit = ((color[hor_res * y + x] & 0x1F) > 16);
+            }
+            const int out_x = (swap_xy ? y : x);
+            const int out_y = (swap_xy ? x : y);
+            uint8_t *outbuf = out + (swap_xy ? ver_res : hor_res) * (out_y >> 3) + out_x;
+            if (lit) {
+                (*outbuf) &= ~(1 << (out_y % 8));
+            } else {
+                (*outbuf) |= (1 << (out_y % 8));
+            }
+        }
+    }
+}
+
+static void mono_test(bool src_i1, bool swap_xy)
+{
+    const size_t src_len = (src_i1 ? MONO_HOR_RES / 8 : MONO_HOR_RES * 2) * MONO_VER_RES;
+    const size_t out_len = MONO_HOR_RES * MONO_VER_RES / 8;
+    uint8_t *src = malloc(src_len);
+    uint8_t *out = malloc(out_len);
+    uint8_t *expected = malloc(out_len);
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(out);
+    TEST_ASSERT_NOT_NULL(expected);
+
+    srand(2);
+    for (size_t i = 0; i < src_len; i++) {
+        src[i] = rand();
+    }
+
+    /* Different content of the output buffers, every byte must be written */
+    memset(out, 0x55, out_len);
+    memset(expected, 0xAA, out_len);
+    mono_reference(src, expected, src_i1, swap_xy, MONO_HOR_RES, MONO_VER_RES);
+    lvgl_port_monochrome_pages(src, out, src_i1, swap_xy, MONO_HOR_RES, MONO_VER_RES, 0, MONO_HOR_RES - 1, 0, MONO_VER_RES - 1);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, out, out_len);
+
+    /* Benchmark: whole frame transformed and sent page by page, as lvgl_port_flush_monochrome_pages() does */
+    const int cols = (swap_xy ? MONO_VER_RES : MONO_HOR_RES);
+    const int pages = (swap_xy ? MONO_HOR_RES : MONO_VER_RES) / 8;
+    mock_lcd_panel_t panel = {
+        .h_res = cols,
+        .v_res = pages * 8,
+        .bits_per_pixel = 1,
+        .bus_clock_hz = 400 * 1000,
+        .bus_width = 1,
+    };
+    uint64_t transform_ns = 0;
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+        const uint64_t start = mock_lcd_time_ns();
+        lvgl_port_monochrome_pages(src, out, src_i1, swap_xy, MONO_HOR_RES, MONO_VER_RES, 0, MONO_HOR_RES - 1, 0, MONO_VER_RES - 1);
+        transform_ns += mock_lcd_time_ns() - start;
+        for (int p = 0; p < pages; p++) {
+            TEST_ASSERT_EQUAL(ESP_OK, mock_lcd_panel_draw_bitmap(&panel, 0, p * 8, cols, p * 8 + 8, out + p * cols));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)out_len * BENCHMARK_FRAMES, panel.bytes);
+
+    host_benchmark_report(src_i1 ? "mono_pages_i1" : "mono_pages_rgb565", swap_xy ? "swap_xy" : "no_swap",
+                          MONO_HOR_RES, MONO_VER_RES, (float)transform_ns / BENCHMARK_FRAMES / (MONO_HOR_RES * MONO_VER_RES),
+                          panel.bytes / BENCHMARK_FRAMES, (float)panel.bus_ns / BENCHMARK_FRAMES / 1000);
+
+    free(src);
+    free(out);
+    free(expected);
+}
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Monochrome tests
+
+Purpose:
+    - Check that the page transform of monochrome displays gives the same pages as the bit by bit transform
+    - Measure the page transform on the host (I2C 400 kHz is modelled for the bus time)
+*/
+
+TEST_CASE("Host monochrome pages I1", "[monochrome][benchmark][I1]")
+{
+    mono_test(true, false);
+    mono_test(true, true);
+}
+
+TEST_CASE("Host monochrome pages RGB565", "[monochrome][benchmark][RGB565]")
+{
+    mono_test(false, false);
+    mono_test(false, true);
+}
@@ -0,0 +1,23 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "lv_benchmark_report.h"
+
+void lv_benchmark_report(const char *kernel, const char *impl, const char *bench_case, int32_t width, int32_t height,
+                         int32_t dest_stride, const void *dest_buf, float cycles_per_px)
+{
+    // Biggest power of 2 (up to 16), which divides the buffer address
+    unsigned int dest_align = 16;
+    while (dest_align > 1 && ((uintptr_t)dest_buf % dest_align) != 0) {
+        dest_align >>= 1;
+    }
+
+    // Plain printf, the line must not contain log colors and timestamps
+    printf(LV_BENCHMARK_REPORT_PREFIX ",%s,%s,%s,%"PRIi32",%"PRIi32",%"PRIi32",%u,%.3f\n",
+           kernel, impl, bench_case, width, height, dest_stride, dest_align, cycles_per_px);
+}
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Prefix of the machine readable benchmark report lines
+ *
+ * Every benchmark result is printed as one CSV line, which is collected by pytest_simd.py:
+ * SIMD_BENCH,<kernel>,<impl>,<case>,<width>,<height>,<dest_stride>,<dest_align>,<cycles_per_px>
+ */
+#define LV_BENCHMARK_REPORT_PREFIX "SIMD_BENCH"
+
+// ------------------------------------------------ Function headers --------------------------------------------------
+
+/**
+ * @brief Print one benchmark result as a machine readable report line
+ *
+ * @param[in] kernel Kernel name (e.g. fill_rgb565_mask)
+ * @param[in] impl Implementation (ASM or ANSI)
+ * @param[in] bench_case Benchmark case (ideal or corner)
+ * @param[in] width Width of the destination matrix in pixels
+ * @param[in] height Height of the destination matrix in pixels
+ * @param[in] dest_stride Stride of the destination matrix in bytes
+ * @param[in] dest_buf Destination buffer, its alignment is reported (1, 2, 4, 8 or 16 bytes)
+ * @param[in] cycles_per_px CPU cycles per pixel
+ */
+void lv_benchmark_report(const char *kernel, const char *impl, const char *bench_case, int32_t width, int32_t height,
+                         int32_t dest_stride, const void *dest_buf, float cycles_per_px);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
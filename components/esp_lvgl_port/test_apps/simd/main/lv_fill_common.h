@@ -8,6 +8,7 @@
 
 #include "esp_err.h"
 #include <stdint.h>
+#include <stdbool.h>
 #include "lv_color.h"
 #include "lv_draw_sw_blend.h"
 
@@ -51,6 +52,8 @@ typedef struct {
     unsigned int dest_h;                                    // Destination buffer height
     unsigned int dest_stride;                               // Destination buffer stride
     unsigned int unalign_byte;                              // Destination buffer memory unalignment
+    lv_opa_t opa;                                           // Opacity of the fill
+    bool use_mask;                                          // Use mask buffer (same stride as the destination buffer)
 } func_test_case_params_t;
 
 /**
@@ -66,8 +69,24 @@ typedef struct {
     void *array_align16;                                    // test array with 16 byte alignment - testing most ideal case
     void *array_align1;                                     // test array with 1 byte alignment - testing worst case
     void (*blend_api_func)(_lv_draw_sw_blend_fill_dsc_t *); // pointer to LVGL API function
+    lv_opa_t opa;                                           // Opacity of the fill
+    const lv_opa_t *mask_buf;                               // Mask buffer (NULL: no mask), mask stride is the width of the test array
+    const char *name;                                       // Kernel name used in the benchmark report
 } bench_test_case_params_t;
 
+/**
+ * @brief Benchmark parameters of narrow areas (scrollbars, text cursors)
+ *
+ * Every width from min_w to max_w is measured with every destination unalignment from 0 to max_unalign_byte
+ */
+typedef struct {
+    unsigned int min_w;                                     // Minimum width of the test array
+    unsigned int max_w;                                     // Maximum width of the test array
+    unsigned int height;                                    // Test array height
+    unsigned int max_unalign_byte;                          // Maximum amount of unaligned bytes of the destination array
+    unsigned int unalign_step;                              // Increment step in bytes unalignment of the destination array
+} bench_narrow_params_t;
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
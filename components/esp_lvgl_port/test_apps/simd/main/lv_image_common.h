@@ -23,6 +23,8 @@ extern "C" {
 typedef enum {
     OPERATION_FILL,
     OPERATION_FILL_WITH_OPA,
+    OPERATION_FILL_WITH_MASK,
+    OPERATION_FILL_WITH_MASK_OPA,
 } blend_operation_t;
 
 /**
@@ -104,6 +106,11 @@ typedef struct {
     void *dest_array_align16;                                 /*!< Destination test array with 16 byte alignment - testing most ideal case */
     void *dest_array_align1;                                  /*!< Destination test array with 1 byte alignment - testing worst case */
     void (*blend_api_func)(_lv_draw_sw_blend_image_dsc_t *);  /*!< pointer to LVGL API function */
+    lv_color_format_t src_color_format;                       /*!< LV color format of the source test array */
+    lv_opa_t opa;                                             /*!< Opacity of the blended image */
+    const lv_opa_t *mask_buf;                                 /*!< Mask buffer (NULL: no mask), mask stride is the width of the test array */
+    unsigned int mask_stride;                                 /*!< Mask buffer stride */
+    const char *name;                                         /*!< Kernel name used in the benchmark report */
 } bench_test_case_lv_image_params_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_lvgl_port_rotate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/* SSD1306 like panel */
+#define MONO_HOR_RES 128
+#define MONO_VER_RES 64
+
+// ------------------------------------------------- Reference implementation ------------------------------------------
+
+/**
+ * @brief ANSI reference of the monochrome transform
+ *
+ * - read-modify-write of single bits, as in the unaligned path of _lvgl_port_transform_monochrome()
+ * - this was the only path of the transform before lvgl_port_monochrome_pages()
+ * - source and destination layout is the same as for lvgl_port_monochrome_pages()
+ */
+static inline void lv_monochrome_ansi(const uint8_t *src, uint8_t *dest, bool src_i1, bool swap_xy, uint16_t hor_res, uint16_t ver_res, int32_t x1, int32_t x2, int32_t y1, int32_t y2)
+{
+    const uint16_t *color = (const uint16_t *)src;
+    for (int32_t y = y1; y <= y2; y++) {
+        for (int32_t x = x1; x <= x2; x++) {
+            bool lit;
+            if (src_i1) {
+                lit = (src[(hor_res >> 3) * y + (x >> 3)] & 1 << (7 - x % 8));
+            } else {
+                lit = ((color[hor_res * y + x] & 0x1F) > 16);
+            }
+            const int32_t out_x = (swap_xy ? y : x);
+            const int32_t out_y = (swap_xy ? x : y);
+            uint8_t *outbuf = dest + (swap_xy ? ver_res : hor_res) * (out_y >> 3) + out_x;
+            if (lit) {
+                (*outbuf) &= ~(1 << (out_y % 8));
+            } else {
+                (*outbuf) |= (1 << (out_y % 8));
+            }
+        }
+    }
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
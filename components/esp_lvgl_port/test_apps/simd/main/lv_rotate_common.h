@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_lvgl_port_rotate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ------------------------------------------------- Macros and Types --------------------------------------------------
+
+/**
+ * @brief Benchmark test case parameters for LV Rotate
+ */
+typedef struct {
+    unsigned int height;                                      /*!< Source test array height */
+    unsigned int width;                                       /*!< Source test array width */
+    unsigned int px_size;                                     /*!< Pixel size in bytes */
+    unsigned int benchmark_cycles;                            /*!< Count of benchmark cycles */
+    void *src_array;                                          /*!< Source test array */
+    void *dest_array;                                         /*!< Destination test array */
+} bench_test_case_lv_rotate_params_t;
+
+// ------------------------------------------------- Reference implementation ------------------------------------------
+
+/**
+ * @brief ANSI reference rotation
+ *
+ * - walks the source row-major and writes the destination column-major (same as lv_draw_sw_rotate)
+ * - destination layout is the same as for lvgl_port_rotate_tiled()
+ * - only 16-bit and 24-bit pixels are supported
+ */
+static inline void lv_rotate_ansi(const uint8_t *src, uint8_t *dest, int32_t w, int32_t h, int32_t src_stride, int32_t dest_stride, lvgl_port_rotate_t rotation, uint32_t px_size)
+{
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            int32_t dx = x;
+            int32_t dy = y;
+            if (rotation == LVGL_PORT_ROTATE_90) {
+                dx = y;
+                dy = w - 1 - x;
+            } else if (rotation == LVGL_PORT_ROTATE_180) {
+                dx = w - 1 - x;
+                dy = h - 1 - y;
+            } else if (rotation == LVGL_PORT_ROTATE_270) {
+                dx = h - 1 - y;
+                dy = x;
+            }
+            const uint8_t *s = src + y * src_stride + x * px_size;
+            uint8_t *d = dest + dy * dest_stride + dx * px_size;
+            if (px_size == 2) {
+                *(uint16_t *)d = *(const uint16_t *)s;
+            } else {
+                d[0] = s[0];
+                d[1] = s[1];
+                d[2] = s[2];
+            }
+        }
+    }
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
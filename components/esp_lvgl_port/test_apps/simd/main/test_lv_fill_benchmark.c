@@ -4,14 +4,16 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdio.h>
 #include <string.h>
 #include <malloc.h>
 #include <sdkconfig.h>
 
 #include "unity.h"
 #include "esp_log.h"
-#include "freertos/FreeRTOS.h"  // for xthal_get_ccount()
+#include "esp_cpu.h"              // for esp_cpu_get_cycle_count()
 #include "lv_fill_common.h"
+#include "lv_benchmark_report.h"
 #include "lv_draw_sw_blend.h"
 #include "lv_draw_sw_blend_to_argb8888.h"
 #include "lv_draw_sw_blend_to_rgb565.h"
@@ -21,6 +23,7 @@
 #define STRIDE WIDTH
 #define UNALIGN_BYTES 1
 #define BENCHMARK_CYCLES 1000
+#define BENCHMARK_OPA 100   // Opacity used by benchmarks with opa
 
 // ------------------------------------------------- Macros and Types --------------------------------------------------
 
@@ -32,6 +35,23 @@ static lv_color_t test_color = {
     .red = 0x12,
 };
 
+// Every width up to 16 pixels with every 2-byte (RGB565) or 4-byte (ARGB8888) aligned position in 16 bytes
+static const bench_narrow_params_t narrow_params_rgb565 = {
+    .min_w = 1,
+    .max_w = 16,
+    .height = 16,
+    .max_unalign_byte = 14,
+    .unalign_step = 2,
+};
+
+static const bench_narrow_params_t narrow_params_argb8888 = {
+    .min_w = 1,
+    .max_w = 16,
+    .height = 16,
+    .max_unalign_byte = 12,
+    .unalign_step = 4,
+};
+
 // ------------------------------------------------ Static function headers --------------------------------------------
 
 /**
@@ -44,6 +64,11 @@ static void lv_fill_benchmark_init(bench_test_case_params_t *test_params);
  */
 static float lv_fill_benchmark_run(bench_test_case_params_t *test_params, _lv_draw_sw_blend_fill_dsc_t *dsc);
 
+/**
+ * @brief Run the benchmark test of narrow areas, every width and destination unalignment is reported
+ */
+static void lv_fill_benchmark_narrow(const bench_narrow_params_t *narrow_params, bench_test_case_params_t *test_params);
+
 // ------------------------------------------------ Test cases ---------------------------------------------------------
 
 /*
@@ -84,6 +109,8 @@ TEST_CASE("LV Fill benchmark ARGB8888", "[fill][benchmark][ARGB8888]")
         .array_align16 = (void *)dest_array_align16,
         .array_align1 = (void *)dest_array_align1,
         .blend_api_func = &lv_draw_sw_blend_color_to_argb8888,
+        .opa = LV_OPA_MAX,
+        .name = "fill_argb8888",
     };
 
     ESP_LOGI(TAG_LV_FILL_BENCH, "running test for ARGB8888 color format");
@@ -91,6 +118,58 @@ TEST_CASE("LV Fill benchmark ARGB8888", "[fill][benchmark][ARGB8888]")
     free(dest_array_align16);
 }
 
+TEST_CASE("LV Fill benchmark ARGB8888 with opa and mask", "[fill][benchmark][ARGB8888]")
+{
+    uint32_t *dest_array_align16  = (uint32_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint32_t) + UNALIGN_BYTES);
+    lv_opa_t *mask_buf = (lv_opa_t *)malloc(STRIDE * HEIGHT);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array_align16);
+    TEST_ASSERT_NOT_EQUAL(NULL, mask_buf);
+
+    // A8 glyph like mask: transparent background with anti-aliased strokes
+    for (int i = 0; i < STRIDE * HEIGHT; i++) {
+        const int x = i % 16;
+        mask_buf[i] = (x < 4) ? 0x00 : ((x < 6) ? (x * 40) : ((x < 10) ? 0xFF : ((x < 12) ? 0x60 : 0x00)));
+    }
+
+    // Opaque destination (the usual draw buffer of a display)
+    memset(dest_array_align16, 0xFF, STRIDE * HEIGHT * sizeof(uint32_t) + UNALIGN_BYTES);
+
+    // Apply byte unalignment for the worst-case test scenario
+    uint32_t *dest_array_align1 = dest_array_align16 + UNALIGN_BYTES;
+
+    bench_test_case_params_t test_params = {
+        .height = HEIGHT,
+        .width = WIDTH,
+        .stride = STRIDE * sizeof(uint32_t),
+        .cc_height = HEIGHT - 1,
+        .cc_width = WIDTH - 1,
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .array_align16 = (void *)dest_array_align16,
+        .array_align1 = (void *)dest_array_align1,
+        .blend_api_func = &lv_draw_sw_blend_color_to_argb8888,
+        .opa = BENCHMARK_OPA,
+        .mask_buf = NULL,
+        .name = "fill_argb8888_opa",
+    };
+
+    ESP_LOGI(TAG_LV_FILL_BENCH, "running test for ARGB8888 color format with opa");
+    lv_fill_benchmark_init(&test_params);
+
+    test_params.opa = LV_OPA_MAX;
+    test_params.mask_buf = mask_buf;
+    test_params.name = "fill_argb8888_mask";
+    ESP_LOGI(TAG_LV_FILL_BENCH, "running test for ARGB8888 color format with mask");
+    lv_fill_benchmark_init(&test_params);
+
+    test_params.opa = BENCHMARK_OPA;
+    test_params.name = "fill_argb8888_mask_opa";
+    ESP_LOGI(TAG_LV_FILL_BENCH, "running test for ARGB8888 color format with mask and opa");
+    lv_fill_benchmark_init(&test_params);
+
+    free(dest_array_align16);
+    free(mask_buf);
+}
+
 TEST_CASE("LV Fill benchmark RGB565", "[fill][benchmark][RGB565]")
 {
     uint16_t *dest_array_align16  = (uint16_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint16_t) + UNALIGN_BYTES);
@@ -109,12 +188,101 @@ TEST_CASE("LV Fill benchmark RGB565", "[fill][benchmark][RGB565]")
         .array_align16 = (void *)dest_array_align16,
         .array_align1 = (void *)dest_array_align1,
         .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
+        .opa = LV_OPA_MAX,
+        .name = "fill_rgb565",
     };
 
     ESP_LOGI(TAG_LV_FILL_BENCH, "running test for RGB565 color format");
     lv_fill_benchmark_init(&test_params);
     free(dest_array_align16);
 }
+
+TEST_CASE("LV Fill benchmark RGB565 with opa and mask", "[fill][benchmark][RGB565]")
+{
+    uint16_t *dest_array_align16  = (uint16_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint16_t) + UNALIGN_BYTES);
+    lv_opa_t *mask_buf = (lv_opa_t *)malloc(STRIDE * HEIGHT);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array_align16);
+    TEST_ASSERT_NOT_EQUAL(NULL, mask_buf);
+
+    // Anti-aliased edges: mostly opaque or transparent mask with mixed values on the edges
+    for (int i = 0; i < STRIDE * HEIGHT; i++) {
+        const int x = i % STRIDE;
+        mask_buf[i] = (x < 8) ? (x * 32) : ((x < STRIDE - 8) ? 0xFF : 0x00);
+    }
+
+    // Apply byte unalignment for the worst-case test scenario
+    uint16_t *dest_array_align1 = dest_array_align16 + UNALIGN_BYTES;
+
+    bench_test_case_params_t test_params = {
+        .height = HEIGHT,
+        .width = WIDTH,
+        .stride = STRIDE * sizeof(uint16_t),
+        .cc_height = HEIGHT - 1,
+        .cc_width = WIDTH - 1,
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .array_align16 = (void *)dest_array_align16,
+        .array_align1 = (void *)dest_array_align1,
+        .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
+        .opa = BENCHMARK_OPA,
+        .mask_buf = NULL,
+        .name = "fill_rgb565_opa",
+    };
+
+    ESP_LOGI(TAG_LV_FILL_BENCH, "running test for RGB565 color format with opa");
+    lv_fill_benchmark_init(&test_params);
+
+    test_params.opa = LV_OPA_MAX;
+    test_params.mask_buf = mask_buf;
+    test_params.name = "fill_rgb565_mask";
+    ESP_LOGI(TAG_LV_FILL_BENCH, "running test for RGB565 color format with mask");
+    lv_fill_benchmark_init(&test_params);
+
+    test_params.opa = BENCHMARK_OPA;
+    test_params.name = "fill_rgb565_mask_opa";
+    ESP_LOGI(TAG_LV_FILL_BENCH, "running test for RGB565 color format with mask and opa");
+    lv_fill_benchmark_init(&test_params);
+
+    free(dest_array_align16);
+    free(mask_buf);
+}
+TEST_CASE("LV Fill benchmark narrow areas ARGB8888", "[fill][benchmark][ARGB8888]")
+{
+    uint32_t *dest_array_align16  = (uint32_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint32_t) + 16);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array_align16);
+
+    bench_test_case_params_t test_params = {
+        .stride = STRIDE * sizeof(uint32_t),
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .array_align16 = (void *)dest_array_align16,
+        .blend_api_func = &lv_draw_sw_blend_color_to_argb8888,
+        .opa = LV_OPA_MAX,
+        .name = "fill_argb8888_narrow",
+    };
+
+    ESP_LOGI(TAG_LV_FILL_BENCH, "running test of narrow areas for ARGB8888 color format");
+    lv_fill_benchmark_narrow(&narrow_params_argb8888, &test_params);
+    free(dest_array_align16);
+}
+
+TEST_CASE("LV Fill benchmark narrow areas RGB565", "[fill][benchmark][RGB565]")
+{
+    uint16_t *dest_array_align16  = (uint16_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint16_t) + 16);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array_align16);
+
+    bench_test_case_params_t test_params = {
+        .stride = STRIDE * sizeof(uint16_t),
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .array_align16 = (void *)dest_array_align16,
+        .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
+        .opa = LV_OPA_MAX,
+        .name = "fill_rgb565_narrow",
+    };
+
+    ESP_LOGI(TAG_LV_FILL_BENCH, "running test of narrow areas for RGB565 color format");
+    lv_fill_benchmark_narrow(&narrow_params_rgb565, &test_params);
+    free(dest_array_align16);
+}
+
 // ------------------------------------------------ Static test functions ----------------------------------------------
 
 static void lv_fill_benchmark_init(bench_test_case_params_t *test_params)
@@ -125,9 +293,10 @@ static void lv_fill_benchmark_init(bench_test_case_params_t *test_params)
         .dest_w = test_params->width,
         .dest_h = test_params->height,
         .dest_stride = test_params->stride,  // stride * sizeof()
-        .mask_buf = NULL,
+        .mask_buf = test_params->mask_buf,
+        .mask_stride = STRIDE,
         .color = test_color,
-        .opa = LV_OPA_MAX,
+        .opa = test_params->opa,
         .use_asm = true,
     };
 
@@ -146,12 +315,14 @@ static void lv_fill_benchmark_init(bench_test_case_params_t *test_params)
         float cycles = lv_fill_benchmark_run(test_params, &dsc);        // Call Benchmark cycle
         float per_sample = cycles / ((float)(dsc.dest_w * dsc.dest_h));
         ESP_LOGI(TAG_LV_FILL_BENCH, " %s ideal case: %.3f cycles for %"PRIi32"x%"PRIi32" matrix, %.3f cycles per sample", asm_ansi_func[i], cycles, dsc.dest_w, dsc.dest_h, per_sample);
+        lv_benchmark_report(test_params->name, asm_ansi_func[i], "ideal", dsc.dest_w, dsc.dest_h, dsc.dest_stride, dsc.dest_buf, per_sample);
 
         // Run benchmark with the corner case input parameters
         // Dest array is 1 byte aligned, dest_w and dest_h are not dividable by 4
         cycles = lv_fill_benchmark_run(test_params, &dsc_cc);           // Call Benchmark cycle
         per_sample = cycles / ((float)(dsc_cc.dest_w * dsc_cc.dest_h));
         ESP_LOGI(TAG_LV_FILL_BENCH, " %s corner case: %.3f cycles for %"PRIi32"x%"PRIi32" matrix, %.3f cycles per sample\n", asm_ansi_func[i], cycles, dsc_cc.dest_w, dsc_cc.dest_h, per_sample);
+        lv_benchmark_report(test_params->name, asm_ansi_func[i], "corner", dsc_cc.dest_w, dsc_cc.dest_h, dsc_cc.dest_stride, dsc_cc.dest_buf, per_sample);
 
         // change to ANSI
         dsc.use_asm = false;
@@ -164,13 +335,44 @@ static float lv_fill_benchmark_run(bench_test_case_params_t *test_params, _lv_dr
     // Call the DUT function for the first time to init the benchmark test
     test_params->blend_api_func(dsc);
 
-    const unsigned int start_b = xthal_get_ccount();
+    const unsigned int start_b = esp_cpu_get_cycle_count();
     for (int i = 0; i < test_params->benchmark_cycles; i++) {
         test_params->blend_api_func(dsc);
     }
-    const unsigned int end_b = xthal_get_ccount();
+    const unsigned int end_b = esp_cpu_get_cycle_count();
 
     const float total_b = end_b - start_b;
     const float cycles = total_b / (test_params->benchmark_cycles);
     return cycles;
 }
+
+static void lv_fill_benchmark_narrow(const bench_narrow_params_t *narrow_params, bench_test_case_params_t *test_params)
+{
+    char bench_case[32];
+    _lv_draw_sw_blend_fill_dsc_t dsc = {
+        .dest_h = narrow_params->height,
+        .dest_stride = test_params->stride,  // stride * sizeof()
+        .mask_buf = NULL,
+        .color = test_color,
+        .opa = test_params->opa,
+    };
+
+    for (unsigned int dest_w = narrow_params->min_w; dest_w <= narrow_params->max_w; dest_w++) {
+        float worst[2] = {0};
+        dsc.dest_w = dest_w;
+
+        for (unsigned int unalign_byte = 0; unalign_byte <= narrow_params->max_unalign_byte; unalign_byte += narrow_params->unalign_step) {
+            dsc.dest_buf = (uint8_t *)test_params->array_align16 + unalign_byte;
+            snprintf(bench_case, sizeof(bench_case), "narrow_w%u_off%u", dest_w, unalign_byte);
+
+            // First run using assembly, second run using ANSI
+            for (int i = 0; i < 2; i++) {
+                dsc.use_asm = (i == 0);
+                const float per_sample = lv_fill_benchmark_run(test_params, &dsc) / ((float)(dsc.dest_w * dsc.dest_h));
+                worst[i] = LV_MAX(worst[i], per_sample);
+                lv_benchmark_report(test_params->name, asm_ansi_func[i], bench_case, dsc.dest_w, dsc.dest_h, dsc.dest_stride, dsc.dest_buf, per_sample);
+            }
+        }
+        ESP_LOGI(TAG_LV_FILL_BENCH, " width %u: the slowest alignment %.3f (ASM) %.3f (ANSI) cycles per sample", dest_w, worst[0], worst[1]);
+    }
+}
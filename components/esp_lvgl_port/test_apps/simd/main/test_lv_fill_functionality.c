@@ -6,6 +6,7 @@
 
 #include <string.h>
 #include <malloc.h>
+#include <stdbool.h>
 #include <inttypes.h>
 #include "unity.h"
 #include "esp_log.h"
@@ -13,6 +14,7 @@
 #include "lv_draw_sw_blend.h"
 #include "lv_draw_sw_blend_to_argb8888.h"
 #include "lv_draw_sw_blend_to_rgb565.h"
+#include "esp_lvgl_port_simd.h"
 
 // ------------------------------------------------- Defines -----------------------------------------------------------
 
@@ -39,6 +41,14 @@ static lv_color_t test_color = {
     .red = 0x12,
 };
 
+// Mask values used for masked fills, to cover transparent, opaque and mixed pixels
+static const lv_opa_t test_mask[] = {0x00, 0xFF, 0xFF, 0x01, 0x80, 0xFE, 0x03, 0x0C, 0x00, 0x40, 0x7C, 0xC0, 0xFF, 0x02, 0xFD};
+
+// Alpha values used for ARGB8888 destination buffers, to cover all the branches of the blending
+static const uint8_t test_alpha[] = {0x00, 0xFF, 0x01, 0x02, 0x03, 0x80, 0xFC, 0xFD, 0xFE, 0x40, 0xC0};
+
+#define TEST_OPA 100                // Opacity used by functionality tests with opa
+
 // ------------------------------------------------ Static function headers --------------------------------------------
 
 /**
@@ -117,12 +127,46 @@ TEST_CASE("Test fill functionality ARGB8888", "[fill][functionality][ARGB8888]")
         .blend_api_func = &lv_draw_sw_blend_color_to_argb8888,
         .color_format = LV_COLOR_FORMAT_ARGB8888,
         .data_type_size = sizeof(uint32_t),
+        .opa = LV_OPA_MAX,
     };
 
     ESP_LOGI(TAG_LV_FILL_FUNC, "running test for ARGB8888 color format");
     functionality_test_matrix(&test_matrix, &test_case);
 }
 
+TEST_CASE("Test fill functionality ARGB8888 with opa and mask", "[fill][functionality][ARGB8888]")
+{
+    func_test_case_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_color_to_argb8888,
+        .color_format = LV_COLOR_FORMAT_ARGB8888,
+        .data_type_size = sizeof(uint32_t),
+    };
+
+    // Opacity only, masked with full opacity and masked with opacity
+    const struct {
+        lv_opa_t opa;
+        bool use_mask;
+    } variants[] = {{TEST_OPA, false}, {LV_OPA_MAX, true}, {TEST_OPA, true}};
+
+    for (int i = 0; i < sizeof(variants) / sizeof(variants[0]); i++) {
+        test_matrix_params_t test_matrix = {
+            .min_w = 1,
+            .min_h = 1,
+            .max_w = 24,
+            .max_h = 4,
+            .min_unalign_byte = 0,
+            .max_unalign_byte = 16,
+            .unalign_step = 4,      // ARGB8888 buffers are always 4-byte aligned
+            .dest_stride_step = 1,
+            .test_combinations_count = 0,
+        };
+        test_case.opa = variants[i].opa;
+        test_case.use_mask = variants[i].use_mask;
+        ESP_LOGI(TAG_LV_FILL_FUNC, "running test for ARGB8888 color format, opa %d%s", test_case.opa, test_case.use_mask ? ", with mask" : "");
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
 TEST_CASE("Test fill functionality RGB565", "[fill][functionality][RGB565]")
 {
     test_matrix_params_t test_matrix = {
@@ -141,12 +185,92 @@ TEST_CASE("Test fill functionality RGB565", "[fill][functionality][RGB565]")
         .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
         .color_format = LV_COLOR_FORMAT_RGB565,
         .data_type_size = sizeof(uint16_t),
+        .opa = LV_OPA_MAX,
     };
 
     ESP_LOGI(TAG_LV_FILL_FUNC, "running test for RGB565 color format");
     functionality_test_matrix(&test_matrix, &test_case);
 }
 
+TEST_CASE("Test fill functionality RGB565 with opa and mask", "[fill][functionality][RGB565]")
+{
+    func_test_case_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
+        .color_format = LV_COLOR_FORMAT_RGB565,
+        .data_type_size = sizeof(uint16_t),
+    };
+
+    // Opacity only, masked with full opacity and masked with opacity
+    const struct {
+        lv_opa_t opa;
+        bool use_mask;
+    } variants[] = {{TEST_OPA, false}, {LV_OPA_MAX, true}, {TEST_OPA, true}};
+
+    for (int i = 0; i < sizeof(variants) / sizeof(variants[0]); i++) {
+        test_matrix_params_t test_matrix = {
+            .min_w = 1,
+            .min_h = 1,
+            .max_w = 24,
+            .max_h = 4,
+            .min_unalign_byte = 0,
+            .max_unalign_byte = 16,
+            .unalign_step = 2,      // RGB565 buffers are always 2-byte aligned
+            .dest_stride_step = 1,
+            .test_combinations_count = 0,
+        };
+        test_case.opa = variants[i].opa;
+        test_case.use_mask = variants[i].use_mask;
+        ESP_LOGI(TAG_LV_FILL_FUNC, "running test for RGB565 color format, opa %d%s", test_case.opa, test_case.use_mask ? ", with mask" : "");
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
+TEST_CASE("Test fill functionality RGB565 with kernel selection", "[fill][functionality][RGB565]")
+{
+    lvgl_port_simd_kernel_cfg_t kernel_cfg = {0};
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, lvgl_port_simd_set_kernel(LVGL_PORT_SIMD_KERNEL_NUM, &kernel_cfg));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, lvgl_port_simd_set_kernel(LVGL_PORT_SIMD_FILL_RGB565, NULL));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, lvgl_port_simd_get_kernel(LVGL_PORT_SIMD_FILL_RGB565, NULL));
+
+    func_test_case_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_color_to_rgb565,
+        .color_format = LV_COLOR_FORMAT_RGB565,
+        .data_type_size = sizeof(uint16_t),
+        .opa = LV_OPA_MAX,
+    };
+
+    // Narrow or small areas by ANSI C, disabled kernel (all areas by ANSI C)
+    const lvgl_port_simd_kernel_cfg_t variants[] = {
+        {.min_w = 16},
+        {.min_px = 64},
+        {.disabled = true},
+    };
+
+    for (int i = 0; i < sizeof(variants) / sizeof(variants[0]); i++) {
+        test_matrix_params_t test_matrix = {
+            .min_w = 1,
+            .min_h = 1,
+            .max_w = 32,
+            .max_h = 4,
+            .min_unalign_byte = 0,
+            .max_unalign_byte = 16,
+            .unalign_step = 2,
+            .dest_stride_step = 1,
+            .test_combinations_count = 0,
+        };
+        TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_simd_set_kernel(LVGL_PORT_SIMD_FILL_RGB565, &variants[i]));
+        TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_simd_get_kernel(LVGL_PORT_SIMD_FILL_RGB565, &kernel_cfg));
+        TEST_ASSERT_EQUAL_MEMORY(&variants[i], &kernel_cfg, sizeof(kernel_cfg));
+        ESP_LOGI(TAG_LV_FILL_FUNC, "running test for RGB565 color format, kernel %s, min_w %d, min_px %"PRIu32,
+                 kernel_cfg.disabled ? "disabled" : "enabled", kernel_cfg.min_w, kernel_cfg.min_px);
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+
+    // Restore the default selection (assembly for all areas)
+    memset(&kernel_cfg, 0, sizeof(kernel_cfg));
+    TEST_ASSERT_EQUAL(ESP_OK, lvgl_port_simd_set_kernel(LVGL_PORT_SIMD_FILL_RGB565, &kernel_cfg));
+}
+
 // ------------------------------------------------ Static test functions ----------------------------------------------
 
 static void functionality_test_matrix(test_matrix_params_t *test_matrix, func_test_case_params_t *test_case)
@@ -178,15 +302,27 @@ static void lv_fill_functionality(func_test_case_params_t *test_case)
 {
     fill_test_bufs(test_case);
 
+    // Mask buffer with the same stride as the destination buffer
+    lv_opa_t *mask_buf = NULL;
+    if (test_case->use_mask) {
+        const size_t mask_len = test_case->dest_h * test_case->dest_stride;
+        mask_buf = malloc(mask_len);
+        TEST_ASSERT_NOT_NULL_MESSAGE(mask_buf, "Lack of memory");
+        for (int i = 0; i < mask_len; i++) {
+            mask_buf[i] = test_mask[i % sizeof(test_mask)];
+        }
+    }
+
     // Init structure for LVGL blend API, to call the Assembly API
     _lv_draw_sw_blend_fill_dsc_t dsc_asm = {
         .dest_buf = test_case->buf.p_asm,
         .dest_w = test_case->dest_w,
         .dest_h = test_case->dest_h,
         .dest_stride = test_case->dest_stride * test_case->data_type_size,  // stride * sizeof()
-        .mask_buf = NULL,
+        .mask_buf = mask_buf,
+        .mask_stride = test_case->dest_stride,
         .color = test_color,
-        .opa = LV_OPA_MAX,
+        .opa = test_case->opa,
         .use_asm = true,
     };
 
@@ -222,6 +358,7 @@ static void lv_fill_functionality(func_test_case_params_t *test_case)
 
     free(test_case->buf.p_asm_alloc);
     free(test_case->buf.p_ansi_alloc);
+    free(mask_buf);
 
 }
 
@@ -257,6 +394,16 @@ static void fill_test_bufs(func_test_case_params_t *test_case)
         dest_buf_ansi[i * data_type_size] = (uint8_t)(i % 255);
     }
 
+    // ARGB8888 destination gets various colors and alpha values, to take all the branches of the blending
+    if (test_case->color_format == LV_COLOR_FORMAT_ARGB8888) {
+        for (int i = CANARY_BYTES; i < active_buf_len + CANARY_BYTES; i++) {
+            dest_buf_asm[i * data_type_size + 1] = (uint8_t)(i * 37);
+            dest_buf_asm[i * data_type_size + 2] = (uint8_t)(i * 91);
+            dest_buf_asm[i * data_type_size + 3] = test_alpha[i % sizeof(test_alpha)];
+            memcpy(&dest_buf_ansi[i * data_type_size], &dest_buf_asm[i * data_type_size], data_type_size);
+        }
+    }
+
     // Shift array pointers by Canary Bytes amount
     dest_buf_asm += CANARY_BYTES * data_type_size;
     dest_buf_ansi += CANARY_BYTES * data_type_size;
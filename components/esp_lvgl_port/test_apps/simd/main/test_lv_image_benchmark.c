@@ -4,16 +4,20 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdio.h>
 #include <string.h>
 #include <malloc.h>
 #include <sdkconfig.h>
 
 #include "unity.h"
 #include "esp_log.h"
-#include "freertos/FreeRTOS.h"  // for xthal_get_ccount()
+#include "esp_cpu.h"              // for esp_cpu_get_cycle_count()
 #include "lv_image_common.h"
+#include "lv_fill_common.h"       // for bench_narrow_params_t
+#include "lv_benchmark_report.h"
 #include "lv_draw_sw_blend.h"
 #include "lv_draw_sw_blend_to_rgb565.h"
+#include "lv_draw_sw_blend_to_argb8888.h"
 
 #define COMMON_DIM 128      // Common matrix dimension 128x128 pixels
 #define WIDTH COMMON_DIM
@@ -21,12 +25,22 @@
 #define STRIDE WIDTH
 #define UNALIGN_BYTES 3
 #define BENCHMARK_CYCLES 1000
+#define BENCHMARK_OPA 100   // Opacity used by benchmarks with opa
 
 // ------------------------------------------------ Static variables ---------------------------------------------------
 
 static const char *TAG_LV_IMAGE_BENCH = "LV Image Benchmark";
 static const char *asm_ansi_func[] = {"ASM", "ANSI"};
 
+// Every width up to 16 pixels with every 2-byte aligned position of the destination in 16 bytes
+static const bench_narrow_params_t narrow_params_rgb565 = {
+    .min_w = 1,
+    .max_w = 16,
+    .height = 16,
+    .max_unalign_byte = 14,
+    .unalign_step = 2,
+};
+
 // ------------------------------------------------ Static function headers --------------------------------------------
 
 /**
@@ -39,6 +53,26 @@ static void lv_image_benchmark_init(bench_test_case_lv_image_params_t *test_para
  */
 static float lv_image_benchmark_run(bench_test_case_lv_image_params_t *test_params, _lv_draw_sw_blend_image_dsc_t *dsc);
 
+/**
+ * @brief Allocate and fill test arrays and run the benchmark test for an image blend with alpha
+ *
+ * @param[in] name Kernel name used in the benchmark report
+ * @param[in] src_color_format Color format of the source test array
+ * @param[in] src_px_size Pixel size of the source test array in bytes
+ * @param[in] dest_px_size Pixel size of the destination test array in bytes
+ * @param[in] opa Opacity of the blended image
+ * @param[in] blend_api_func LVGL API function
+ */
+static void lv_image_benchmark_alpha_blend(const char *name, lv_color_format_t src_color_format, size_t src_px_size, size_t dest_px_size, lv_opa_t opa,
+        void (*blend_api_func)(_lv_draw_sw_blend_image_dsc_t *));
+
+/**
+ * @brief Run the benchmark test of narrow areas, every width and destination unalignment is reported
+ *
+ * The source has the same 4-byte phase as the destination, or it is shifted by 2 bytes
+ */
+static void lv_image_benchmark_narrow(const bench_narrow_params_t *narrow_params, bench_test_case_lv_image_params_t *test_params);
+
 // ------------------------------------------------ Test cases ---------------------------------------------------------
 
 /*
@@ -101,6 +135,9 @@ TEST_CASE("LV Image benchmark RGB565 blend to RGB565", "[image][benchmark][RGB56
         .dest_array_align16 = (void *)dest_array_align16,
         .dest_array_align1 = (void *)dest_array_align1,
         .blend_api_func = &lv_draw_sw_blend_image_to_rgb565,
+        .src_color_format = LV_COLOR_FORMAT_RGB565,
+        .opa = LV_OPA_MAX,
+        .name = "image_rgb565_to_rgb565",
     };
 
     ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for RGB565 color format");
@@ -108,6 +145,185 @@ TEST_CASE("LV Image benchmark RGB565 blend to RGB565", "[image][benchmark][RGB56
     free(dest_array_align16);
     free(src_array_align16);
 }
+
+TEST_CASE("LV Image benchmark RGB565 blend to RGB565 with opa and mask", "[image][benchmark][RGB565]")
+{
+    uint16_t *dest_array_align16  = (uint16_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint16_t) + UNALIGN_BYTES);
+    uint16_t *src_array_align16  = (uint16_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint16_t) + UNALIGN_BYTES);
+    lv_opa_t *mask_buf = (lv_opa_t *)malloc(STRIDE * HEIGHT);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array_align16);
+    TEST_ASSERT_NOT_EQUAL(NULL, src_array_align16);
+    TEST_ASSERT_NOT_EQUAL(NULL, mask_buf);
+
+    // Anti-aliased edges: mostly opaque or transparent mask with mixed values on the edges
+    for (int i = 0; i < STRIDE * HEIGHT; i++) {
+        const int x = i % STRIDE;
+        mask_buf[i] = (x < 8) ? (x * 32) : ((x < STRIDE - 8) ? 0xFF : 0x00);
+    }
+
+    // Apply byte unalignment (different for each array) for the worst-case test scenario
+    uint16_t *dest_array_align1 = (uint16_t *)((uint8_t *)dest_array_align16 + UNALIGN_BYTES - 1);
+    uint16_t *src_array_align1 = (uint16_t *)((uint8_t *)src_array_align16 + UNALIGN_BYTES);
+
+    bench_test_case_lv_image_params_t test_params = {
+        .height = HEIGHT,
+        .width = WIDTH,
+        .dest_stride = STRIDE * sizeof(uint16_t),
+        .src_stride = STRIDE * sizeof(uint16_t),
+        .cc_height = HEIGHT,
+        .cc_width = WIDTH - 1,
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .src_array_align16 = (void *)src_array_align16,
+        .src_array_align1 = (void *)src_array_align1,
+        .dest_array_align16 = (void *)dest_array_align16,
+        .dest_array_align1 = (void *)dest_array_align1,
+        .blend_api_func = &lv_draw_sw_blend_image_to_rgb565,
+        .src_color_format = LV_COLOR_FORMAT_RGB565,
+        .opa = BENCHMARK_OPA,
+        .name = "image_rgb565_to_rgb565_opa",
+    };
+
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for RGB565 color format with opa");
+    lv_image_benchmark_init(&test_params);
+
+    test_params.opa = LV_OPA_MAX;
+    test_params.mask_buf = mask_buf;
+    test_params.mask_stride = STRIDE;
+    test_params.name = "image_rgb565_to_rgb565_mask";
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for RGB565 color format with mask");
+    lv_image_benchmark_init(&test_params);
+
+    test_params.opa = BENCHMARK_OPA;
+    test_params.name = "image_rgb565_to_rgb565_mask_opa";
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for RGB565 color format with mask and opa");
+    lv_image_benchmark_init(&test_params);
+
+    free(dest_array_align16);
+    free(src_array_align16);
+    free(mask_buf);
+}
+
+TEST_CASE("LV Image benchmark narrow areas RGB565 blend to RGB565", "[image][benchmark][RGB565]")
+{
+    uint16_t *dest_array_align16  = (uint16_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint16_t) + 16);
+    uint16_t *src_array_align16  = (uint16_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint16_t) + 16);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array_align16);
+    TEST_ASSERT_NOT_EQUAL(NULL, src_array_align16);
+
+    bench_test_case_lv_image_params_t test_params = {
+        .dest_stride = STRIDE * sizeof(uint16_t),
+        .src_stride = STRIDE * sizeof(uint16_t),
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .src_array_align16 = (void *)src_array_align16,
+        .dest_array_align16 = (void *)dest_array_align16,
+        .blend_api_func = &lv_draw_sw_blend_image_to_rgb565,
+        .src_color_format = LV_COLOR_FORMAT_RGB565,
+        .opa = LV_OPA_MAX,
+        .name = "image_rgb565_to_rgb565_narrow",
+    };
+
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test of narrow areas for RGB565 color format");
+    lv_image_benchmark_narrow(&narrow_params_rgb565, &test_params);
+    free(dest_array_align16);
+    free(src_array_align16);
+}
+
+/*
+Alpha blend benchmarks
+
+    - The alpha blend assembly implementations require naturally aligned buffers (2-byte for RGB565, 4-byte for ARGB8888),
+      otherwise they fall back to ANSI. The worst case is thus measured with the ANSI implementation for both runs
+    - Source arrays are filled with various alpha values, to take all the branches (transparent, opaque and mixed pixels)
+*/
+
+TEST_CASE("LV Image benchmark RGB888 blend to RGB565", "[image][benchmark][RGB888]")
+{
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for RGB888 color format");
+    lv_image_benchmark_alpha_blend("image_rgb888_to_rgb565", LV_COLOR_FORMAT_RGB888, 3, sizeof(uint16_t), LV_OPA_MAX, &lv_draw_sw_blend_image_to_rgb565);
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for RGB888 color format with opa");
+    lv_image_benchmark_alpha_blend("image_rgb888_to_rgb565_opa", LV_COLOR_FORMAT_RGB888, 3, sizeof(uint16_t), BENCHMARK_OPA, &lv_draw_sw_blend_image_to_rgb565);
+}
+
+/*
+Horizontal gradient benchmark
+
+    - LVGL draws horizontal gradients as RGB888 image blend: the source is the gradient color map (one row,
+      used for every row of the area) and the mask is the gradient opa map or the mask of rounded corners
+    - The color map is shared by all the rows (source stride 0), the mask has anti-aliased edges
+*/
+
+TEST_CASE("LV Image benchmark RGB888 horizontal gradient to RGB565", "[image][benchmark][RGB888]")
+{
+    uint16_t *dest_array_align16  = (uint16_t *)memalign(16, STRIDE * HEIGHT * sizeof(uint16_t) + UNALIGN_BYTES);
+    uint8_t *color_map = (uint8_t *)memalign(16, STRIDE * 3 + UNALIGN_BYTES);
+    lv_opa_t *mask_buf = (lv_opa_t *)malloc(STRIDE * HEIGHT);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array_align16);
+    TEST_ASSERT_NOT_EQUAL(NULL, color_map);
+    TEST_ASSERT_NOT_EQUAL(NULL, mask_buf);
+
+    // Gradient from blue to red, the same color map row is used for all the rows
+    memset(color_map, 0, STRIDE * 3 + UNALIGN_BYTES);
+    for (int x = 0; x < STRIDE; x++) {
+        color_map[x * 3 + 0] = 0xFF - (x * 0xFF) / STRIDE;  // blue
+        color_map[x * 3 + 1] = 0x40;                        // green
+        color_map[x * 3 + 2] = (x * 0xFF) / STRIDE;         // red
+    }
+
+    // Anti-aliased edges: mostly opaque or transparent mask with mixed values on the edges
+    for (int i = 0; i < STRIDE * HEIGHT; i++) {
+        const int x = i % STRIDE;
+        mask_buf[i] = (x < 8) ? (x * 32) : ((x < STRIDE - 8) ? 0xFF : 0x00);
+    }
+    memset(dest_array_align16, 0xA5, STRIDE * HEIGHT * sizeof(uint16_t) + UNALIGN_BYTES);
+
+    bench_test_case_lv_image_params_t test_params = {
+        .height = HEIGHT,
+        .width = WIDTH,
+        .dest_stride = STRIDE * sizeof(uint16_t),
+        .src_stride = 0,
+        .cc_height = HEIGHT,
+        .cc_width = WIDTH - 1,
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .src_array_align16 = (void *)color_map,
+        .src_array_align1 = (void *)(color_map + UNALIGN_BYTES),
+        .dest_array_align16 = (void *)dest_array_align16,
+        .dest_array_align1 = (void *)((uint8_t *)dest_array_align16 + UNALIGN_BYTES - 1),
+        .blend_api_func = &lv_draw_sw_blend_image_to_rgb565,
+        .src_color_format = LV_COLOR_FORMAT_RGB888,
+        .opa = LV_OPA_MAX,
+        .mask_buf = mask_buf,
+        .mask_stride = STRIDE,
+        .name = "gradient_rgb888_to_rgb565_mask",
+    };
+
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for RGB888 horizontal gradient with mask");
+    lv_image_benchmark_init(&test_params);
+
+    test_params.opa = BENCHMARK_OPA;
+    test_params.name = "gradient_rgb888_to_rgb565_mask_opa";
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for RGB888 horizontal gradient with mask and opa");
+    lv_image_benchmark_init(&test_params);
+
+    free(dest_array_align16);
+    free(color_map);
+    free(mask_buf);
+}
+
+TEST_CASE("LV Image benchmark ARGB8888 blend to RGB565", "[image][benchmark][ARGB8888]")
+{
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for ARGB8888 color format");
+    lv_image_benchmark_alpha_blend("image_argb8888_to_rgb565", LV_COLOR_FORMAT_ARGB8888, sizeof(uint32_t), sizeof(uint16_t), LV_OPA_MAX, &lv_draw_sw_blend_image_to_rgb565);
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for ARGB8888 color format with opa");
+    lv_image_benchmark_alpha_blend("image_argb8888_to_rgb565_opa", LV_COLOR_FORMAT_ARGB8888, sizeof(uint32_t), sizeof(uint16_t), BENCHMARK_OPA, &lv_draw_sw_blend_image_to_rgb565);
+}
+
+TEST_CASE("LV Image benchmark ARGB8888 blend to ARGB8888", "[image][benchmark][ARGB8888]")
+{
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for ARGB8888 color format to ARGB8888");
+    lv_image_benchmark_alpha_blend("image_argb8888_to_argb8888", LV_COLOR_FORMAT_ARGB8888, sizeof(uint32_t), sizeof(uint32_t), LV_OPA_MAX, &lv_draw_sw_blend_image_to_argb8888);
+    ESP_LOGI(TAG_LV_IMAGE_BENCH, "running test for ARGB8888 color format to ARGB8888 with opa");
+    lv_image_benchmark_alpha_blend("image_argb8888_to_argb8888_opa", LV_COLOR_FORMAT_ARGB8888, sizeof(uint32_t), sizeof(uint32_t), BENCHMARK_OPA, &lv_draw_sw_blend_image_to_argb8888);
+}
 // ------------------------------------------------ Static test functions ----------------------------------------------
 
 static void lv_image_benchmark_init(bench_test_case_lv_image_params_t *test_params)
@@ -118,11 +334,12 @@ static void lv_image_benchmark_init(bench_test_case_lv_image_params_t *test_para
         .dest_w = test_params->width,
         .dest_h = test_params->height,
         .dest_stride = test_params->dest_stride,  // stride * sizeof()
-        .mask_buf = NULL,
+        .mask_buf = test_params->mask_buf,
+        .mask_stride = test_params->mask_stride,
         .src_buf = test_params->src_array_align16,
         .src_stride = test_params->src_stride,
-        .src_color_format = LV_COLOR_FORMAT_RGB565,
-        .opa = LV_OPA_MAX,
+        .src_color_format = test_params->src_color_format,
+        .opa = test_params->opa,
         .blend_mode = LV_BLEND_MODE_NORMAL,
         .use_asm = true,
     };
@@ -142,11 +359,13 @@ static void lv_image_benchmark_init(bench_test_case_lv_image_params_t *test_para
         float cycles = lv_image_benchmark_run(test_params, &dsc);        // Call Benchmark cycle
         float per_sample = cycles / ((float)(dsc.dest_w * dsc.dest_h));
         ESP_LOGI(TAG_LV_IMAGE_BENCH, " %s ideal case: %.3f cycles for %"PRIi32"x%"PRIi32" matrix, %.3f cycles per sample", asm_ansi_func[i], cycles, dsc.dest_w, dsc.dest_h, per_sample);
+        lv_benchmark_report(test_params->name, asm_ansi_func[i], "ideal", dsc.dest_w, dsc.dest_h, dsc.dest_stride, dsc.dest_buf, per_sample);
 
         // Run benchmark with the corner case input parameters
         cycles = lv_image_benchmark_run(test_params, &dsc_cc);           // Call Benchmark cycle
         per_sample = cycles / ((float)(dsc_cc.dest_w * dsc_cc.dest_h));
         ESP_LOGI(TAG_LV_IMAGE_BENCH, " %s corner case: %.3f cycles for %"PRIi32"x%"PRIi32" matrix, %.3f cycles per sample\n", asm_ansi_func[i], cycles, dsc_cc.dest_w, dsc_cc.dest_h, per_sample);
+        lv_benchmark_report(test_params->name, asm_ansi_func[i], "corner", dsc_cc.dest_w, dsc_cc.dest_h, dsc_cc.dest_stride, dsc_cc.dest_buf, per_sample);
 
         // change to ANSI
         dsc.use_asm = false;
@@ -159,13 +378,95 @@ static float lv_image_benchmark_run(bench_test_case_lv_image_params_t *test_para
     // Call the DUT function for the first time to init the benchmark test
     test_params->blend_api_func(dsc);
 
-    const unsigned int start_b = xthal_get_ccount();
+    const unsigned int start_b = esp_cpu_get_cycle_count();
     for (int i = 0; i < test_params->benchmark_cycles; i++) {
         test_params->blend_api_func(dsc);
     }
-    const unsigned int end_b = xthal_get_ccount();
+    const unsigned int end_b = esp_cpu_get_cycle_count();
 
     const float total_b = end_b - start_b;
     const float cycles = total_b / (test_params->benchmark_cycles);
     return cycles;
 }
+
+static void lv_image_benchmark_alpha_blend(const char *name, lv_color_format_t src_color_format, size_t src_px_size, size_t dest_px_size, lv_opa_t opa,
+        void (*blend_api_func)(_lv_draw_sw_blend_image_dsc_t *))
+{
+    uint8_t *dest_array_align16 = (uint8_t *)memalign(16, STRIDE * HEIGHT * dest_px_size + UNALIGN_BYTES);
+    uint8_t *src_array_align16 = (uint8_t *)memalign(16, STRIDE * HEIGHT * src_px_size + UNALIGN_BYTES);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array_align16);
+    TEST_ASSERT_NOT_EQUAL(NULL, src_array_align16);
+
+    // Fill the arrays with known values, ARGB8888 source gets alpha values changing along the row
+    for (int i = 0; i < STRIDE * HEIGHT * src_px_size + UNALIGN_BYTES; i++) {
+        src_array_align16[i] = (i * 37 + 0x5A) & 0xFF;
+    }
+    if (src_color_format == LV_COLOR_FORMAT_ARGB8888) {
+        const uint8_t alpha_steps[] = {0x00, 0x00, 0x40, 0x80, 0xC0, 0xFF, 0xFF, 0xFF};
+        for (int i = 0; i < STRIDE * HEIGHT; i++) {
+            src_array_align16[i * src_px_size + 3] = alpha_steps[(i / 8) % sizeof(alpha_steps)];
+        }
+    }
+    memset(dest_array_align16, 0xA5, STRIDE * HEIGHT * dest_px_size + UNALIGN_BYTES);
+
+    bench_test_case_lv_image_params_t test_params = {
+        .height = HEIGHT,
+        .width = WIDTH,
+        .dest_stride = STRIDE * dest_px_size,
+        .src_stride = STRIDE * src_px_size,
+        .cc_height = HEIGHT,
+        .cc_width = WIDTH - 1,
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .src_array_align16 = (void *)src_array_align16,
+        .src_array_align1 = (void *)(src_array_align16 + UNALIGN_BYTES),
+        .dest_array_align16 = (void *)dest_array_align16,
+        .dest_array_align1 = (void *)(dest_array_align16 + UNALIGN_BYTES - 1),
+        .blend_api_func = blend_api_func,
+        .src_color_format = src_color_format,
+        .opa = opa,
+        .name = name,
+    };
+
+    lv_image_benchmark_init(&test_params);
+    free(dest_array_align16);
+    free(src_array_align16);
+}
+
+static void lv_image_benchmark_narrow(const bench_narrow_params_t *narrow_params, bench_test_case_lv_image_params_t *test_params)
+{
+    static const char *src_phase[] = {"same", "shift2"};
+    char bench_case[40];
+    _lv_draw_sw_blend_image_dsc_t dsc = {
+        .dest_h = narrow_params->height,
+        .dest_stride = test_params->dest_stride,  // stride * sizeof()
+        .mask_buf = NULL,
+        .src_stride = test_params->src_stride,
+        .src_color_format = test_params->src_color_format,
+        .opa = test_params->opa,
+        .blend_mode = LV_BLEND_MODE_NORMAL,
+    };
+
+    for (unsigned int dest_w = narrow_params->min_w; dest_w <= narrow_params->max_w; dest_w++) {
+        float worst[2] = {0};
+        dsc.dest_w = dest_w;
+
+        for (unsigned int unalign_byte = 0; unalign_byte <= narrow_params->max_unalign_byte; unalign_byte += narrow_params->unalign_step) {
+            dsc.dest_buf = (uint8_t *)test_params->dest_array_align16 + unalign_byte;
+
+            // Source with the same 4-byte phase as the destination and shifted by 2 bytes
+            for (int phase = 0; phase < 2; phase++) {
+                dsc.src_buf = (uint8_t *)test_params->src_array_align16 + ((unalign_byte + 2 * phase) & 0xF);
+                snprintf(bench_case, sizeof(bench_case), "narrow_w%u_off%u_%s", dest_w, unalign_byte, src_phase[phase]);
+
+                // First run using assembly, second run using ANSI
+                for (int i = 0; i < 2; i++) {
+                    dsc.use_asm = (i == 0);
+                    const float per_sample = lv_image_benchmark_run(test_params, &dsc) / ((float)(dsc.dest_w * dsc.dest_h));
+                    worst[i] = LV_MAX(worst[i], per_sample);
+                    lv_benchmark_report(test_params->name, asm_ansi_func[i], bench_case, dsc.dest_w, dsc.dest_h, dsc.dest_stride, dsc.dest_buf, per_sample);
+                }
+            }
+        }
+        ESP_LOGI(TAG_LV_IMAGE_BENCH, " width %u: the slowest alignment %.3f (ASM) %.3f (ANSI) cycles per sample", dest_w, worst[0], worst[1]);
+    }
+}
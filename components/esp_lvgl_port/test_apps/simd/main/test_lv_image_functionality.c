@@ -6,6 +6,7 @@
 
 #include <string.h>
 #include <malloc.h>
+#include <stdbool.h>
 #include <inttypes.h>
 #include "sdkconfig.h"
 #include "unity.h"
@@ -13,10 +14,12 @@
 #include "lv_image_common.h"
 #include "lv_draw_sw_blend.h"
 #include "lv_draw_sw_blend_to_rgb565.h"
+#include "lv_draw_sw_blend_to_argb8888.h"
 
 // ------------------------------------------------- Defines -----------------------------------------------------------
 
 #define DBG_PRINT_OUTPUT false
+#define TEST_OPA 100                // Opacity used by functionality tests with opa
 
 // ------------------------------------------------- Macros and Types --------------------------------------------------
 
@@ -39,9 +42,9 @@ static char test_msg_buf[200];
 
 static const test_matrix_lv_image_params_t default_test_matrix_image_rgb565_blend_rgb565 = {
 #if CONFIG_IDF_TARGET_ESP32S3
-    .min_w = 8,                   // 8 is the lower limit for the esp32s3 asm implementation, otherwise esp32 is executed
+    .min_w = 1,                   // Narrow rows (lower than 16 pixels) are copied without Q registers
     .min_h = 1,
-    .max_w = 24,
+    .max_w = 32,                  // All the head and tail combinations of the Q registers implementation
     .max_h = 2,
     .src_max_unalign_byte = 16,   // Use 16-byte boundary check for Xtensa PIE
     .dest_max_unalign_byte = 16,
@@ -66,6 +69,28 @@ static const test_matrix_lv_image_params_t default_test_matrix_image_rgb565_blen
     .test_combinations_count = 0,
 };
 
+static const test_matrix_lv_image_params_t default_test_matrix_image_alpha_blend = {
+    .min_w = 1,
+    .min_h = 1,
+    .max_w = 16,
+    .max_h = 2,
+    .src_max_unalign_byte = 4,    // Unaligned buffers fall back to ANSI, 4-byte boundary check covers both paths
+    .dest_max_unalign_byte = 4,
+    .dest_unalign_step = 1,
+    .src_unalign_step = 1,
+    .src_stride_step = 3,
+    .dest_stride_step = 3,
+    .src_min_unalign_byte = 0,
+    .dest_min_unalign_byte = 0,
+    .test_combinations_count = 0,
+};
+
+// Alpha values used for ARGB8888 test buffers, to cover all the branches of the blending
+static const uint8_t test_alpha[] = {0x00, 0xFF, 0x01, 0x02, 0x03, 0x80, 0xFC, 0xFD, 0xFE, 0x40, 0xC0};
+
+// Mask values used for masked blends, to cover transparent, opaque and mixed pixels
+static const lv_opa_t test_mask[] = {0x00, 0xFF, 0xFF, 0x01, 0x80, 0xFE, 0x03, 0x0C, 0x00, 0x40, 0x7C, 0xC0, 0xFF};
+
 // ------------------------------------------------ Static function headers --------------------------------------------
 
 /**
@@ -101,6 +126,13 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case);
  */
 static void test_eval_image_16bit_data(func_test_case_lv_image_params_t *test_case);
 
+/**
+ * @brief Evaluate results of LV Image functionality for 32bit data length
+ *
+ * @param[in] test_case Pointer ot structure defining functionality test case
+ */
+static void test_eval_image_32bit_data(func_test_case_lv_image_params_t *test_case);
+
 // ------------------------------------------------ Test cases ---------------------------------------------------------
 
 /*
@@ -137,6 +169,104 @@ TEST_CASE("LV Image functionality RGB565 blend to RGB565", "[image][functionalit
     functionality_test_matrix(&test_matrix, &test_case);
 }
 
+TEST_CASE("LV Image functionality RGB565 blend to RGB565 with opa and mask", "[image][functionality][RGB565]")
+{
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_image_to_rgb565,
+        .color_format = LV_COLOR_FORMAT_RGB565,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+        .src_data_type_size = sizeof(uint16_t),
+        .dest_data_type_size = sizeof(uint16_t),
+    };
+
+    const blend_operation_t operations[] = {OPERATION_FILL_WITH_OPA, OPERATION_FILL_WITH_MASK, OPERATION_FILL_WITH_MASK_OPA};
+    const char *operation_names[] = {"opa", "mask", "mask and opa"};
+    for (int i = 0; i < sizeof(operations) / sizeof(operations[0]); i++) {
+        test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_alpha_blend;
+        test_case.operation_type = operations[i];
+        ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for RGB565 color format with %s", operation_names[i]);
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
+TEST_CASE("LV Image functionality RGB888 blend to RGB565", "[image][functionality][RGB888]")
+{
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_image_to_rgb565,
+        .color_format = LV_COLOR_FORMAT_RGB888,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+        .src_data_type_size = 3,
+        .dest_data_type_size = sizeof(uint16_t),
+    };
+
+    const blend_operation_t operations[] = {OPERATION_FILL, OPERATION_FILL_WITH_OPA, OPERATION_FILL_WITH_MASK, OPERATION_FILL_WITH_MASK_OPA};
+    const char *operation_names[] = {"", " with opa", " with mask", " with mask and opa"};
+    for (int i = 0; i < sizeof(operations) / sizeof(operations[0]); i++) {
+        test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_alpha_blend;
+        test_case.operation_type = operations[i];
+        ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for RGB888 color format%s", operation_names[i]);
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
+TEST_CASE("LV Image functionality XRGB8888 blend to RGB565", "[image][functionality][XRGB8888]")
+{
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_image_to_rgb565,
+        .color_format = LV_COLOR_FORMAT_XRGB8888,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+        .src_data_type_size = sizeof(uint32_t),
+        .dest_data_type_size = sizeof(uint16_t),
+    };
+
+    const blend_operation_t operations[] = {OPERATION_FILL, OPERATION_FILL_WITH_OPA, OPERATION_FILL_WITH_MASK, OPERATION_FILL_WITH_MASK_OPA};
+    const char *operation_names[] = {"", " with opa", " with mask", " with mask and opa"};
+    for (int i = 0; i < sizeof(operations) / sizeof(operations[0]); i++) {
+        test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_alpha_blend;
+        test_case.operation_type = operations[i];
+        ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for XRGB8888 color format%s", operation_names[i]);
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
+TEST_CASE("LV Image functionality ARGB8888 blend to RGB565", "[image][functionality][ARGB8888]")
+{
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_image_to_rgb565,
+        .color_format = LV_COLOR_FORMAT_ARGB8888,
+        .canary_pixels = CANARY_PIXELS_RGB565,
+        .src_data_type_size = sizeof(uint32_t),
+        .dest_data_type_size = sizeof(uint16_t),
+    };
+
+    const blend_operation_t operations[] = {OPERATION_FILL, OPERATION_FILL_WITH_OPA};
+    for (int i = 0; i < sizeof(operations) / sizeof(operations[0]); i++) {
+        test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_alpha_blend;
+        test_case.operation_type = operations[i];
+        ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for ARGB8888 color format%s", (operations[i] == OPERATION_FILL_WITH_OPA) ? " with opa" : "");
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
+TEST_CASE("LV Image functionality ARGB8888 blend to ARGB8888", "[image][functionality][ARGB8888]")
+{
+    func_test_case_lv_image_params_t test_case = {
+        .blend_api_func = &lv_draw_sw_blend_image_to_argb8888,
+        .color_format = LV_COLOR_FORMAT_ARGB8888,
+        .canary_pixels = CANARY_PIXELS_ARGB8888,
+        .src_data_type_size = sizeof(uint32_t),
+        .dest_data_type_size = sizeof(uint32_t),
+    };
+
+    const blend_operation_t operations[] = {OPERATION_FILL, OPERATION_FILL_WITH_OPA};
+    for (int i = 0; i < sizeof(operations) / sizeof(operations[0]); i++) {
+        test_matrix_lv_image_params_t test_matrix = default_test_matrix_image_alpha_blend;
+        test_case.operation_type = operations[i];
+        ESP_LOGI(TAG_LV_IMAGE_FUNC, "running test for ARGB8888 color format to ARGB8888%s", (operations[i] == OPERATION_FILL_WITH_OPA) ? " with opa" : "");
+        functionality_test_matrix(&test_matrix, &test_case);
+    }
+}
+
 // ------------------------------------------------ Static test functions ----------------------------------------------
 
 static void functionality_test_matrix(test_matrix_lv_image_params_t *test_matrix, func_test_case_lv_image_params_t *test_case)
@@ -176,17 +306,31 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case)
 {
     fill_test_bufs(test_case);
 
+    const bool use_mask = (test_case->operation_type == OPERATION_FILL_WITH_MASK) || (test_case->operation_type == OPERATION_FILL_WITH_MASK_OPA);
+    const bool use_opa = (test_case->operation_type == OPERATION_FILL_WITH_OPA) || (test_case->operation_type == OPERATION_FILL_WITH_MASK_OPA);
+
+    // Mask buffer with the same stride as the destination buffer
+    lv_opa_t *mask_buf = NULL;
+    if (use_mask) {
+        const size_t mask_len = test_case->dest_h * test_case->dest_stride;
+        mask_buf = malloc(mask_len);
+        TEST_ASSERT_NOT_NULL_MESSAGE(mask_buf, "Lack of memory");
+        for (int i = 0; i < mask_len; i++) {
+            mask_buf[i] = test_mask[i % sizeof(test_mask)];
+        }
+    }
+
     _lv_draw_sw_blend_image_dsc_t dsc_asm = {
         .dest_buf = test_case->buf.p_dest_asm,
         .dest_w = test_case->dest_w,
         .dest_h = test_case->dest_h,
         .dest_stride = test_case->dest_stride * test_case->dest_data_type_size,  // dest_stride * sizeof(data_type)
-        .mask_buf = NULL,
-        .mask_stride = 0,
+        .mask_buf = mask_buf,
+        .mask_stride = use_mask ? test_case->dest_stride : 0,
         .src_buf = test_case->buf.p_src,
         .src_stride = test_case->src_stride * test_case->src_data_type_size,     // src_stride * sizeof(data_type)
         .src_color_format = test_case->color_format,
-        .opa = LV_OPA_MAX,
+        .opa = use_opa ? TEST_OPA : LV_OPA_MAX,
         .blend_mode = LV_BLEND_MODE_NORMAL,
         .use_asm = true,
     };
@@ -209,10 +353,13 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case)
 #if DBG_PRINT_OUTPUT
     printf("%s\n", test_msg_buf);
 #endif
-    switch (test_case->color_format) {
-    case LV_COLOR_FORMAT_RGB565:
+    switch (test_case->dest_data_type_size) {
+    case sizeof(uint16_t):
         test_eval_image_16bit_data(test_case);
         break;
+    case sizeof(uint32_t):
+        test_eval_image_32bit_data(test_case);
+        break;
     default:
         TEST_ASSERT_MESSAGE(false, "LV Color format not found");
         break;
@@ -222,6 +369,7 @@ static void lv_image_functionality(func_test_case_lv_image_params_t *test_case)
     free(test_case->buf.p_dest_asm_alloc);
     free(test_case->buf.p_dest_ansi_alloc);
     free(test_case->buf.p_src_alloc);
+    free(mask_buf);
 }
 
 static void fill_test_bufs(func_test_case_lv_image_params_t *test_case)
@@ -255,29 +403,57 @@ static void fill_test_bufs(func_test_case_lv_image_params_t *test_case)
 
     // Set the whole buffer to 0, including the Canary pixels part
     memset(src_buf_common, 0, src_buf_len * src_data_type_size);
-    memset(dest_buf_asm, 0, total_dest_buf_len * src_data_type_size);
-    memset(dest_buf_ansi, 0, total_dest_buf_len * src_data_type_size);
+    memset(dest_buf_asm, 0, total_dest_buf_len * dest_data_type_size);
+    memset(dest_buf_ansi, 0, total_dest_buf_len * dest_data_type_size);
 
     switch (test_case->operation_type) {
     case OPERATION_FILL:
+    case OPERATION_FILL_WITH_OPA:
+    case OPERATION_FILL_WITH_MASK:
+    case OPERATION_FILL_WITH_MASK_OPA:
         // Fill the actual part of the destination buffers with known values,
         // Values must be same, because of the stride
 
-        if (test_case->color_format == LV_COLOR_FORMAT_RGB565) {
+        if (dest_data_type_size == sizeof(uint16_t)) {
             uint16_t *dest_buf_asm_uint16 = (uint16_t *)dest_buf_asm;
             uint16_t *dest_buf_ansi_uint16 = (uint16_t *)dest_buf_ansi;
-            uint16_t *src_buf_uint16 = (uint16_t *)src_buf_common;
 
             // Fill destination buffers
             for (int i = 0; i < active_dest_buf_len; i++) {
                 dest_buf_asm_uint16[canary_pixels + i] = i + ((i & 1) ? 0x6699 : 0x9966);
                 dest_buf_ansi_uint16[canary_pixels + i] = dest_buf_asm_uint16[canary_pixels + i];
             }
+        } else {
+            uint32_t *dest_buf_asm_uint32 = (uint32_t *)dest_buf_asm;
+            uint32_t *dest_buf_ansi_uint32 = (uint32_t *)dest_buf_ansi;
+
+            // Fill destination buffers, including various alpha values
+            for (int i = 0; i < active_dest_buf_len; i++) {
+                const uint32_t alpha = test_alpha[(i / 3) % sizeof(test_alpha)];
+                dest_buf_asm_uint32[canary_pixels + i] = (alpha << 24) | ((i * 0x10305) & 0xFFFFFF) | 0x30A050;
+                dest_buf_ansi_uint32[canary_pixels + i] = dest_buf_asm_uint32[canary_pixels + i];
+            }
+        }
+
+        if (test_case->color_format == LV_COLOR_FORMAT_RGB565) {
+            uint16_t *src_buf_uint16 = (uint16_t *)src_buf_common;
 
             // Fill source buffer
             for (int i = 0; i < src_buf_len; i++) {
                 src_buf_uint16[i] = i + ((i & 1) ? 0x55AA : 0xAA55);
             }
+        } else {
+            // Fill source buffer byte by byte
+            for (int i = 0; i < src_buf_len * src_data_type_size; i++) {
+                src_buf_common[i] = (i * 37 + 0x5A) & 0xFF;
+            }
+
+            // Apply various alpha values to the ARGB8888 source buffer
+            if (test_case->color_format == LV_COLOR_FORMAT_ARGB8888) {
+                for (int i = 0; i < src_buf_len; i++) {
+                    src_buf_common[i * sizeof(uint32_t) + 3] = test_alpha[i % sizeof(test_alpha)];
+                }
+            }
         }
 
         break;
@@ -336,16 +512,42 @@ static void test_eval_image_16bit_data(func_test_case_lv_image_params_t *test_ca
     // dest_buf_asm and dest_buf_ansi must be equal
     TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE((uint16_t *)test_case->buf.p_dest_ansi + canary_pixels, (uint16_t *)test_case->buf.p_dest_asm + canary_pixels, test_case->active_dest_buf_len, test_msg_buf);
 
-    // Data part of the destination buffer and source buffer (not considering matrix padding) must be equal
-    uint16_t *dest_row_begin = (uint16_t *)test_case->buf.p_dest_asm + canary_pixels;
-    uint16_t *src_row_begin = (uint16_t *)test_case->buf.p_src;
-    for (int row = 0; row < test_case->dest_h; row++) {
-        TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(dest_row_begin, src_row_begin, test_case->dest_w, test_msg_buf);
-        dest_row_begin += test_case->dest_stride;   // Move pointer of the destination buffer to the next row
-        src_row_begin += test_case->src_stride;     // Move pointer of the source buffer to the next row
+    // Data part of the destination buffer and source buffer (not considering matrix padding) must be equal, for a plain copy
+    if (test_case->color_format == LV_COLOR_FORMAT_RGB565 && test_case->operation_type == OPERATION_FILL) {
+        uint16_t *dest_row_begin = (uint16_t *)test_case->buf.p_dest_asm + canary_pixels;
+        uint16_t *src_row_begin = (uint16_t *)test_case->buf.p_src;
+        for (int row = 0; row < test_case->dest_h; row++) {
+            TEST_ASSERT_EQUAL_UINT16_ARRAY_MESSAGE(dest_row_begin, src_row_begin, test_case->dest_w, test_msg_buf);
+            dest_row_begin += test_case->dest_stride;   // Move pointer of the destination buffer to the next row
+            src_row_begin += test_case->src_stride;     // Move pointer of the source buffer to the next row
+        }
     }
 
     // Canary pixels area must stay 0
     TEST_ASSERT_EACH_EQUAL_UINT16_MESSAGE(0, (uint16_t *)test_case->buf.p_dest_ansi + (test_case->total_dest_buf_len - canary_pixels), canary_pixels, test_msg_buf);
     TEST_ASSERT_EACH_EQUAL_UINT16_MESSAGE(0, (uint16_t *)test_case->buf.p_dest_asm + (test_case->total_dest_buf_len - canary_pixels), canary_pixels, test_msg_buf);
 }
+
+static void test_eval_image_32bit_data(func_test_case_lv_image_params_t *test_case)
+{
+    // Print results, 32bit data
+#if DBG_PRINT_OUTPUT
+    printf("\nEval\nDestination buffers fill:\n");
+    for (uint32_t i = 0; i < test_case->total_dest_buf_len; i++) {
+        printf("dest_buf[%"PRIi32"] %s ansi = %8"PRIx32" \t asm = %8"PRIx32"   %s \n", i, ((i < 10) ? (" ") : ("")), ((uint32_t *)test_case->buf.p_dest_ansi)[i], ((uint32_t *)test_case->buf.p_dest_asm)[i], (((uint32_t *)test_case->buf.p_dest_ansi)[i] == ((uint32_t *)test_case->buf.p_dest_asm)[i]) ? ("OK") : ("FAIL"));
+    }
+    printf("\n");
+#endif
+
+    // Canary pixels area must stay 0
+    const size_t canary_pixels = test_case->canary_pixels;
+    TEST_ASSERT_EACH_EQUAL_UINT32_MESSAGE(0, (uint32_t *)test_case->buf.p_dest_ansi, canary_pixels, test_msg_buf);
+    TEST_ASSERT_EACH_EQUAL_UINT32_MESSAGE(0, (uint32_t *)test_case->buf.p_dest_asm, canary_pixels, test_msg_buf);
+
+    // dest_buf_asm and dest_buf_ansi must be equal
+    TEST_ASSERT_EQUAL_UINT32_ARRAY_MESSAGE((uint32_t *)test_case->buf.p_dest_ansi + canary_pixels, (uint32_t *)test_case->buf.p_dest_asm + canary_pixels, test_case->active_dest_buf_len, test_msg_buf);
+
+    // Canary pixels area must stay 0
+    TEST_ASSERT_EACH_EQUAL_UINT32_MESSAGE(0, (uint32_t *)test_case->buf.p_dest_ansi + (test_case->total_dest_buf_len - canary_pixels), canary_pixels, test_msg_buf);
+    TEST_ASSERT_EACH_EQUAL_UINT32_MESSAGE(0, (uint32_t *)test_case->buf.p_dest_asm + (test_case->total_dest_buf_len - canary_pixels), canary_pixels, test_msg_buf);
+}
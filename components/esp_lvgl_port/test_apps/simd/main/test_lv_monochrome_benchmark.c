@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_cpu.h"              // for esp_cpu_get_cycle_count()
+#include "lv_monochrome_common.h"
+
+#define BENCHMARK_CYCLES 100
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_MONO_BENCH = "LV Monochrome Benchmark";
+static const char *pages_ansi_func[] = {"PAGES", "ANSI"};
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Run the page transform and the ANSI reference on a whole frame and compare the cycles
+ *
+ * @param[in] src_i1 Source is I1 bitmap, otherwise RGB565
+ * @param[in] swap_xy Swap X and Y axes
+ */
+static void lv_monochrome_benchmark(bool src_i1, bool swap_xy);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Benchmark tests
+
+Requires:
+    - To pass functionality tests first
+
+Purpose:
+    - Test that the page transform (whole output bytes) is faster than the bit by bit transform used before
+
+Procedure:
+    - Fill the source frame of a 128x64 panel with random pixels
+    - Run the page transform and the ANSI reference multiple times on the whole frame, while counting CPU cycles
+    - Compare the results
+*/
+
+TEST_CASE("LV Monochrome benchmark I1", "[monochrome][benchmark][I1]")
+{
+    ESP_LOGI(TAG_LV_MONO_BENCH, "running test for I1 color format");
+    lv_monochrome_benchmark(true, false);
+    lv_monochrome_benchmark(true, true);
+}
+
+TEST_CASE("LV Monochrome benchmark RGB565", "[monochrome][benchmark][RGB565]")
+{
+    ESP_LOGI(TAG_LV_MONO_BENCH, "running test for RGB565 color format");
+    lv_monochrome_benchmark(false, false);
+    lv_monochrome_benchmark(false, true);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void lv_monochrome_benchmark(bool src_i1, bool swap_xy)
+{
+    const size_t src_len = (src_i1 ? MONO_HOR_RES / 8 : MONO_HOR_RES * 2) * MONO_VER_RES;
+    uint8_t *src = malloc(src_len);
+    uint8_t *out = malloc(MONO_HOR_RES * MONO_VER_RES / 8);
+    TEST_ASSERT_NOT_EQUAL(NULL, src);
+    TEST_ASSERT_NOT_EQUAL(NULL, out);
+
+    srand(2);
+    for (size_t i = 0; i < src_len; i++) {
+        src[i] = rand();
+    }
+
+    float cycles[2];
+    // First run using page transform, second run using ANSI
+    for (int i = 0; i < 2; i++) {
+        const unsigned int start_b = esp_cpu_get_cycle_count();
+        for (int j = 0; j < BENCHMARK_CYCLES; j++) {
+            if (i == 0) {
+                lvgl_port_monochrome_pages(src, out, src_i1, swap_xy, MONO_HOR_RES, MONO_VER_RES, 0, MONO_HOR_RES - 1, 0, MONO_VER_RES - 1);
+            } else {
+                lv_monochrome_ansi(src, out, src_i1, swap_xy, MONO_HOR_RES, MONO_VER_RES, 0, MONO_HOR_RES - 1, 0, MONO_VER_RES - 1);
+            }
+        }
+        const unsigned int end_b = esp_cpu_get_cycle_count();
+        cycles[i] = (float)(end_b - start_b) / BENCHMARK_CYCLES;
+        const float per_sample = cycles[i] / (MONO_HOR_RES * MONO_VER_RES);
+        ESP_LOGI(TAG_LV_MONO_BENCH, " %s %s: %.3f cycles for %ux%u frame, %.3f cycles per sample", pages_ansi_func[i],
+                 swap_xy ? "swap_xy" : "no_swap", cycles[i], MONO_HOR_RES, MONO_VER_RES, per_sample);
+    }
+    printf("\n");
+    TEST_ASSERT_LESS_THAN_FLOAT(cycles[1], cycles[0]);
+
+    free(src);
+    free(out);
+}
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+
+#include "unity.h"
+#include "esp_log.h"
+#include "lv_monochrome_common.h"
+
+#define OUT_LEN (MONO_HOR_RES * MONO_VER_RES / 8)
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_MONO_FUNC = "LV Monochrome Functionality";
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Compare the page transform with the ANSI reference for all 8-pixel aligned areas
+ *
+ * @param[in] src_i1 Source is I1 bitmap, otherwise RGB565
+ * @param[in] swap_xy Swap X and Y axes
+ */
+static void lv_monochrome_functionality(bool src_i1, bool swap_xy);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Functionality tests
+
+Purpose:
+    - Test that the page transform of monochrome displays gives the same pages as the bit by bit transform
+
+Procedure:
+    - Fill the source frame with random pixels
+    - Run the ANSI reference and the page transform for every 8-pixel aligned area of the frame
+    - Compare the whole output buffers (bytes outside of the area must stay untouched)
+*/
+
+TEST_CASE("LV Monochrome functionality I1", "[monochrome][functionality][I1]")
+{
+    ESP_LOGI(TAG_LV_MONO_FUNC, "running test for I1 color format");
+    lv_monochrome_functionality(true, false);
+    lv_monochrome_functionality(true, true);
+}
+
+TEST_CASE("LV Monochrome functionality RGB565", "[monochrome][functionality][RGB565]")
+{
+    ESP_LOGI(TAG_LV_MONO_FUNC, "running test for RGB565 color format");
+    lv_monochrome_functionality(false, false);
+    lv_monochrome_functionality(false, true);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void lv_monochrome_functionality(bool src_i1, bool swap_xy)
+{
+    const size_t src_len = (src_i1 ? MONO_HOR_RES / 8 : MONO_HOR_RES * 2) * MONO_VER_RES;
+    uint8_t *src = malloc(src_len);
+    uint8_t *out = malloc(OUT_LEN);
+    uint8_t *expected = malloc(OUT_LEN);
+    TEST_ASSERT_NOT_EQUAL(NULL, src);
+    TEST_ASSERT_NOT_EQUAL(NULL, out);
+    TEST_ASSERT_NOT_EQUAL(NULL, expected);
+
+    srand(4);
+    for (size_t i = 0; i < src_len; i++) {
+        src[i] = rand();
+    }
+
+    int combinations = 0;
+    for (int32_t y1 = 0; y1 < MONO_VER_RES; y1 += 8) {
+        for (int32_t y2 = y1 + 7; y2 < MONO_VER_RES; y2 += 8) {
+            for (int32_t x1 = 0; x1 < MONO_HOR_RES; x1 += 8) {
+                for (int32_t x2 = x1 + 7; x2 < MONO_HOR_RES; x2 += 8) {
+                    memset(out, 0x5A, OUT_LEN);
+                    memset(expected, 0x5A, OUT_LEN);
+                    lv_monochrome_ansi(src, expected, src_i1, swap_xy, MONO_HOR_RES, MONO_VER_RES, x1, x2, y1, y2);
+                    lvgl_port_monochrome_pages(src, out, src_i1, swap_xy, MONO_HOR_RES, MONO_VER_RES, x1, x2, y1, y2);
+                    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, out, OUT_LEN);
+                    combinations++;
+                }
+            }
+        }
+    }
+    ESP_LOGI(TAG_LV_MONO_FUNC, "%s: test combinations: %d", swap_xy ? "swap_xy" : "no_swap", combinations);
+
+    free(src);
+    free(out);
+    free(expected);
+}
@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include <sdkconfig.h>
+
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_cpu.h"              // for esp_cpu_get_cycle_count()
+#include "lv_rotate_common.h"
+
+#define WIDTH 320
+#define HEIGHT 48
+#define BENCHMARK_CYCLES 20
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_ROTATE_BENCH = "LV Rotate Benchmark";
+static const char *tiled_ansi_func[] = {"TILED", "ANSI"};
+static const char *rotation_name[] = {"0", "90", "180", "270"};
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Allocate test buffers and run the benchmark test
+ *
+ * @param[in] px_size Pixel size in bytes
+ */
+static void lv_rotate_benchmark(uint32_t px_size);
+
+/**
+ * @brief Initialize the benchmark test
+ */
+static void lv_rotate_benchmark_init(bench_test_case_lv_rotate_params_t *test_params);
+
+/**
+ * @brief Run the benchmark test
+ */
+static float lv_rotate_benchmark_run(bench_test_case_lv_rotate_params_t *test_params, lvgl_port_rotate_t rotation, bool tiled);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Benchmark tests
+
+Requires:
+    - To pass functionality tests first
+
+Purpose:
+    - Test that the tiled rotation kernel is faster than the row-major ANSI rotation
+
+Procedure:
+    - Allocate source and destination buffers of a typical draw buffer size (320x48), in PSRAM if available
+    - Run the tiled kernel and the ANSI rotation multiple times for 90, 180 and 270 degrees, while counting CPU cycles
+    - Compare the results
+    - Free test arrays
+*/
+
+// ------------------------------------------------ Test cases stages --------------------------------------------------
+
+TEST_CASE("LV Rotate benchmark RGB565", "[rotate][benchmark][RGB565]")
+{
+    ESP_LOGI(TAG_LV_ROTATE_BENCH, "running test for RGB565 color format");
+    lv_rotate_benchmark(sizeof(uint16_t));
+}
+
+TEST_CASE("LV Rotate benchmark RGB888", "[rotate][benchmark][RGB888]")
+{
+    ESP_LOGI(TAG_LV_ROTATE_BENCH, "running test for RGB888 color format");
+    lv_rotate_benchmark(3);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void lv_rotate_benchmark(uint32_t px_size)
+{
+    const size_t buf_len = WIDTH * HEIGHT * px_size;
+    uint32_t caps = (heap_caps_get_free_size(MALLOC_CAP_SPIRAM) > 2 * buf_len ? MALLOC_CAP_SPIRAM : MALLOC_CAP_DEFAULT);
+    void *src_array = heap_caps_aligned_alloc(16, buf_len, caps);
+    void *dest_array = heap_caps_aligned_alloc(16, buf_len, caps);
+    TEST_ASSERT_NOT_EQUAL(NULL, src_array);
+    TEST_ASSERT_NOT_EQUAL(NULL, dest_array);
+    memset(src_array, 0x55, buf_len);
+
+    bench_test_case_lv_rotate_params_t test_params = {
+        .height = HEIGHT,
+        .width = WIDTH,
+        .px_size = px_size,
+        .benchmark_cycles = BENCHMARK_CYCLES,
+        .src_array = src_array,
+        .dest_array = dest_array,
+    };
+
+    ESP_LOGI(TAG_LV_ROTATE_BENCH, "buffers in %s", (caps == MALLOC_CAP_SPIRAM ? "PSRAM" : "SRAM"));
+    lv_rotate_benchmark_init(&test_params);
+    heap_caps_free(src_array);
+    heap_caps_free(dest_array);
+}
+
+static void lv_rotate_benchmark_init(bench_test_case_lv_rotate_params_t *test_params)
+{
+    for (lvgl_port_rotate_t rotation = LVGL_PORT_ROTATE_90; rotation <= LVGL_PORT_ROTATE_270; rotation++) {
+        float cycles[2];
+        // First run using tiled kernel, second run using ANSI
+        for (int i = 0; i < 2; i++) {
+            cycles[i] = lv_rotate_benchmark_run(test_params, rotation, (i == 0));
+            float per_sample = cycles[i] / ((float)(test_params->width * test_params->height));
+            ESP_LOGI(TAG_LV_ROTATE_BENCH, " %s %s deg: %.3f cycles for %ux%u matrix, %.3f cycles per sample", tiled_ansi_func[i], rotation_name[rotation], cycles[i], test_params->width, test_params->height, per_sample);
+        }
+        printf("\n");
+        // Tiled kernel shall not be slower than the ANSI rotation (180 deg is row-major in both cases)
+        if (rotation != LVGL_PORT_ROTATE_180) {
+            TEST_ASSERT_LESS_OR_EQUAL_FLOAT(cycles[1], cycles[0]);
+        }
+    }
+}
+
+static float lv_rotate_benchmark_run(bench_test_case_lv_rotate_params_t *test_params, lvgl_port_rotate_t rotation, bool tiled)
+{
+    const uint32_t px_size = test_params->px_size;
+    const int32_t src_stride = test_params->width * px_size;
+    const int32_t dest_stride = (rotation == LVGL_PORT_ROTATE_180 ? test_params->width : test_params->height) * px_size;
+
+    const unsigned int start_b = esp_cpu_get_cycle_count();
+    for (int i = 0; i < test_params->benchmark_cycles; i++) {
+        if (tiled) {
+            lvgl_port_rotate_tiled(test_params->src_array, test_params->dest_array, test_params->width, test_params->height, src_stride, dest_stride, rotation, px_size, false);
+        } else {
+            lv_rotate_ansi(test_params->src_array, test_params->dest_array, test_params->width, test_params->height, src_stride, dest_stride, rotation, px_size);
+        }
+    }
+    const unsigned int end_b = esp_cpu_get_cycle_count();
+
+    const float total_b = end_b - start_b;
+    const float cycles = total_b / (test_params->benchmark_cycles);
+    return cycles;
+}
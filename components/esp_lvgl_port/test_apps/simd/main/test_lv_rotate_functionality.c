@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <malloc.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "esp_log.h"
+#include "lv_rotate_common.h"
+
+// ------------------------------------------------- Defines -----------------------------------------------------------
+
+#define MAX_SIZE        37      // Maximum tested width and height (not a multiple of tile size)
+#define STRIDE_PADDING  6       // Padding in bytes added to the strides (keeps RGB565 rows 2-byte aligned)
+
+// ------------------------------------------------ Static variables ---------------------------------------------------
+
+static const char *TAG_LV_ROTATE_FUNC = "LV Rotate Functionality";
+static char test_msg_buf[128];
+
+// ------------------------------------------------ Static function headers --------------------------------------------
+
+/**
+ * @brief Run rotation functionality test for all sizes and rotations
+ *
+ * @param[in] px_size Pixel size in bytes
+ * @param[in] swap_bytes Swap bytes of RGB565 pixels during the rotation
+ */
+static void lv_rotate_functionality(uint32_t px_size, bool swap_bytes);
+
+// ------------------------------------------------ Test cases ---------------------------------------------------------
+
+/*
+Functionality tests
+
+Purpose:
+    - Test that the tiled rotation kernel achieves the same results as the ANSI reference rotation
+
+Procedure:
+    - Step width, height and rotation of the source test matrix
+    - Run the tiled rotation kernel and the ANSI reference rotation
+    - Compare the whole destination buffers, including padding
+*/
+
+// ------------------------------------------------ Test cases stages --------------------------------------------------
+
+TEST_CASE("LV Rotate functionality RGB565", "[rotate][functionality][RGB565]")
+{
+    ESP_LOGI(TAG_LV_ROTATE_FUNC, "running test for RGB565 color format");
+    lv_rotate_functionality(sizeof(uint16_t), false);
+}
+
+TEST_CASE("LV Rotate functionality RGB565 swap bytes", "[rotate][functionality][RGB565]")
+{
+    ESP_LOGI(TAG_LV_ROTATE_FUNC, "running test for RGB565 color format with swapped bytes");
+    lv_rotate_functionality(sizeof(uint16_t), true);
+}
+
+TEST_CASE("LV Rotate functionality RGB888", "[rotate][functionality][RGB888]")
+{
+    ESP_LOGI(TAG_LV_ROTATE_FUNC, "running test for RGB888 color format");
+    lv_rotate_functionality(3, false);
+}
+
+// ------------------------------------------------ Static test functions ----------------------------------------------
+
+static void lv_rotate_functionality(uint32_t px_size, bool swap_bytes)
+{
+    unsigned int test_combinations_count = 0;
+    const size_t buf_len = (MAX_SIZE * px_size + STRIDE_PADDING) * MAX_SIZE;
+    uint8_t *src = (uint8_t *)memalign(16, buf_len);
+    uint8_t *dest_tiled = (uint8_t *)memalign(16, buf_len);
+    uint8_t *dest_ansi = (uint8_t *)memalign(16, buf_len);
+    TEST_ASSERT_NOT_NULL_MESSAGE(src, "Lack of memory");
+    TEST_ASSERT_NOT_NULL_MESSAGE(dest_tiled, "Lack of memory");
+    TEST_ASSERT_NOT_NULL_MESSAGE(dest_ansi, "Lack of memory");
+
+    for (int i = 0; i < buf_len; i++) {
+        src[i] = i + ((i & 1) ? 0x55 : 0xAA);
+    }
+
+    for (lvgl_port_rotate_t rotation = LVGL_PORT_ROTATE_90; rotation <= LVGL_PORT_ROTATE_270; rotation++) {
+        for (int w = 1; w <= MAX_SIZE; w++) {
+            for (int h = 1; h <= MAX_SIZE; h++) {
+                const int32_t src_stride = w * px_size + STRIDE_PADDING;
+                const int32_t dest_w = (rotation == LVGL_PORT_ROTATE_180 ? w : h);
+                const int32_t dest_h = (rotation == LVGL_PORT_ROTATE_180 ? h : w);
+                const int32_t dest_stride = dest_w * px_size + STRIDE_PADDING;
+
+                memset(dest_tiled, 0, buf_len);
+                memset(dest_ansi, 0, buf_len);
+                lvgl_port_rotate_tiled(src, dest_tiled, w, h, src_stride, dest_stride, rotation, px_size, swap_bytes);
+                lv_rotate_ansi(src, dest_ansi, w, h, src_stride, dest_stride, rotation, px_size);
+                if (swap_bytes) {
+                    // Swap the reference result in a separate pass
+                    for (int i = 0; i + 1 < dest_h * dest_stride; i += 2) {
+                        uint8_t tmp = dest_ansi[i];
+                        dest_ansi[i] = dest_ansi[i + 1];
+                        dest_ansi[i + 1] = tmp;
+                    }
+                }
+
+                sprintf(test_msg_buf, "Test case: w = %d, h = %d, rotation = %d, px_size = %"PRIu32", swap = %d", w, h, rotation, px_size, swap_bytes);
+                TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(dest_ansi, dest_tiled, dest_h * dest_stride, test_msg_buf);
+                test_combinations_count++;
+            }
+        }
+    }
+    ESP_LOGI(TAG_LV_ROTATE_FUNC, "test combinations: %d\n", test_combinations_count);
+
+    free(src);
+    free(dest_tiled);
+    free(dest_ansi);
+}
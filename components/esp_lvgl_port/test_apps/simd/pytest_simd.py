@@ -0,0 +1,88 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+
+import csv
+import json
+import os
+import re
+
+import pytest
+from pytest_embedded import Dut
+
+# Stored ASM results (cycles per pixel) per target, kernel and benchmark case
+BASELINE_FILE = os.path.join(os.path.dirname(__file__), 'benchmark_baseline.json')
+# Allowed slowdown of the ASM version against the baseline (0.1 = 10 %)
+TOLERANCE = float(os.getenv('SIMD_BENCH_TOLERANCE', '0.1'))
+# Set to 1 to store the measured ASM results as the new baseline of the target
+UPDATE_BASELINE = os.getenv('SIMD_BENCH_UPDATE_BASELINE', '0') == '1'
+
+# Line printed by lv_benchmark_report()
+REPORT_RE = re.compile(rb'SIMD_BENCH,(\w+),(ASM|ANSI),(\w+),(\d+),(\d+),(\d+),(\d+),([\d.]+)')
+SUMMARY_RE = re.compile(rb'(\d+) Tests (\d+) Failures (\d+) Ignored')
+FIELDS = ['kernel', 'impl', 'case', 'width', 'height', 'dest_stride', 'dest_align', 'cycles_per_px']
+
+
+def run_benchmarks(dut: Dut) -> list:
+    dut.expect_exact('Press ENTER to see the list of tests.')
+    dut.write('[benchmark]')
+
+    results = []
+    while True:
+        match = dut.expect([REPORT_RE, SUMMARY_RE], timeout=300)
+        if not match.group(0).startswith(b'SIMD_BENCH'):
+            assert int(match.group(2)) == 0, 'Benchmark test cases failed'
+            return results
+        values = [group.decode() for group in match.groups()]
+        result = dict(zip(FIELDS, values))
+        for field in ('width', 'height', 'dest_stride', 'dest_align'):
+            result[field] = int(result[field])
+        result['cycles_per_px'] = float(result['cycles_per_px'])
+        results.append(result)
+
+
+def write_report(logdir: str, target: str, results: list) -> None:
+    with open(os.path.join(logdir, f'simd_benchmark_{target}.json'), 'w') as f:
+        json.dump({'target': target, 'results': results}, f, indent=4)
+    with open(os.path.join(logdir, f'simd_benchmark_{target}.csv'), 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=FIELDS)
+        writer.writeheader()
+        writer.writerows(results)
+
+
+def check_baseline(target: str, results: list) -> None:
+    baseline = {}
+    if os.path.exists(BASELINE_FILE):
+        with open(BASELINE_FILE) as f:
+            baseline = json.load(f)
+
+    measured = {}
+    for result in results:
+        if result['impl'] == 'ASM':
+            measured.setdefault(result['kernel'], {})[result['case']] = result['cycles_per_px']
+
+    if UPDATE_BASELINE:
+        baseline[target] = measured
+        with open(BASELINE_FILE, 'w') as f:
+            json.dump(baseline, f, indent=4, sort_keys=True)
+            f.write('\n')
+        return
+
+    regressions = []
+    for kernel, cases in measured.items():
+        for case, cycles in cases.items():
+            expected = baseline.get(target, {}).get(kernel, {}).get(case)
+            if expected is None:
+                print(f'{kernel} ({case}): no baseline for {target}, {cycles:.3f} cycles per pixel')
+            elif cycles > expected * (1 + TOLERANCE):
+                regressions.append(f'{kernel} ({case}): {cycles:.3f} > {expected:.3f} cycles per pixel')
+    assert not regressions, 'ASM regressions against the baseline:\n' + '\n'.join(regressions)
+
+
+@pytest.mark.esp32_s3_eye
+@pytest.mark.esp32_p4_function_ev_board
+@pytest.mark.esp_wrover_kit
+def test_simd_benchmark(dut: Dut) -> None:
+    results = run_benchmarks(dut)
+    assert results, 'No benchmark results'
+    write_report(dut.logdir, dut.target, results)
+    check_baseline(dut.target, results)
@@ -0,0 +1,259 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+"""
+Pre-render glyphs of a TTF/OTF font to LVGL bitmap fonts (C arrays), one per size.
+
+Usage: font_atlas.py <font.ttf> <output_dir> --name <name> --sizes 16 24 [--bpp 4]
+                     [--text-files <files>] [--symbols <chars>] [--range 0x20-0x7E]
+
+The glyph set is the union of all characters of the text files (e.g. translation tables,
+UI sources), symbols and ranges. Each size is written to <output_dir>/<name>_<size>.c
+as lv_font_t <name>_<size> in LVGL format (plain bitmaps, no kerning). Missing glyphs
+are skipped, they can be drawn by fallback font (lv_font_t.fallback) at runtime.
+"""
+import argparse
+import os
+import sys
+
+import freetype
+
+# Consecutive characters stored as one range, shorter runs are in sparse lists
+RUN_MIN = 4
+# Maximum span of one character map (16-bit offsets)
+SPAN_MAX = 0xFFFF
+
+TEMPLATE_HEAD = '''/*
+ * Generated by esp_lvgl_port/tools/font_atlas.py, do not edit.
+ * Font: {font}, size {size} px, {bpp} bpp, {count} glyphs
+ */
+
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+'''
+
+TEMPLATE_TAIL = '''
+#if LVGL_VERSION_MAJOR == 8
+static lv_font_fmt_txt_glyph_cache_t cache;
+#endif
+
+static const lv_font_fmt_txt_dsc_t font_dsc = {{
+    .glyph_bitmap = glyph_bitmap,
+    .glyph_dsc = glyph_dsc,
+    .cmaps = cmaps,
+    .kern_dsc = NULL,
+    .kern_scale = 0,
+    .cmap_num = {cmap_num},
+    .bpp = {bpp},
+    .kern_classes = 0,
+    .bitmap_format = 0,
+#if LVGL_VERSION_MAJOR == 8
+    .cache = &cache,
+#endif
+}};
+
+/* Not const, the fallback font can be set at runtime */
+lv_font_t {name} = {{
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,
+    .line_height = {line_height},
+    .base_line = {base_line},
+    .subpx = LV_FONT_SUBPX_NONE,
+    .underline_position = {underline_position},
+    .underline_thickness = {underline_thickness},
+    .dsc = &font_dsc,
+    .fallback = NULL,
+    .user_data = NULL,
+}};
+'''
+
+
+def parse_range(text):
+    first, _, last = text.partition('-')
+    first = int(first, 0)
+    last = int(last, 0) if last else first
+    if last < first:
+        raise argparse.ArgumentTypeError('bad range {}'.format(text))
+    return range(first, last + 1)
+
+
+def collect_chars(args):
+    chars = set()
+    for path in args.text_files:
+        with open(path, encoding='utf-8', errors='ignore') as f:
+            chars.update(ord(c) for c in f.read())
+    chars.update(ord(c) for c in args.symbols)
+    for r in args.range:
+        chars.update(r)
+    # Control characters are not drawn
+    return sorted(c for c in chars if c >= 0x20 and not 0x7F <= c < 0xA0)
+
+
+def pack_bitmap(bitmap, bpp):
+    """Pack gray levels MSB first, rows are continuous (LVGL plain bitmap format)"""
+    out = bytearray()
+    acc = 0
+    bits = 0
+    for y in range(bitmap.rows):
+        row = bitmap.buffer[y * bitmap.pitch:y * bitmap.pitch + bitmap.width]
+        for v in row:
+            acc = (acc << bpp) | (v >> (8 - bpp))
+            bits += bpp
+            if bits == 8:
+                out.append(acc)
+                acc = 0
+                bits = 0
+    if bits:
+        out.append(acc << (8 - bits))
+    return out
+
+
+def render_glyphs(face, chars, bpp):
+    glyphs = []
+    bitmap = bytearray()
+    for c in chars:
+        if face.get_char_index(c) == 0:
+            continue
+        face.load_char(chr(c), freetype.FT_LOAD_RENDER | freetype.FT_LOAD_TARGET_NORMAL)
+        g = face.glyph
+        box_w = g.bitmap.width
+        box_h = g.bitmap.rows
+        if box_w > 255 or box_h > 255:
+            sys.exit('Glyph U+{:04X} is larger than 255 px'.format(c))
+        glyphs.append({
+            'cp': c,
+            'bitmap_index': len(bitmap),
+            'adv_w': (g.advance.x + 2) // 4,   # 26.6 to 1/16 px
+            'box_w': box_w,
+            'box_h': box_h,
+            'ofs_x': g.bitmap_left,
+            'ofs_y': g.bitmap_top - box_h,
+        })
+        if box_w and box_h:
+            bitmap += pack_bitmap(g.bitmap, bpp)
+    if len(bitmap) >= (1 << 20):
+        sys.exit('Bitmaps of one size are larger than 1 MB, reduce the glyph set')
+    return glyphs, bitmap
+
+
+def build_cmaps(glyphs):
+    """Split sorted characters into non-overlapping ranges and sparse lists"""
+    cps = [g['cp'] for g in glyphs]
+    cmaps = []
+    sparse = []
+
+    def flush_sparse():
+        if sparse:
+            cmaps.append(('sparse', list(sparse)))
+            sparse.clear()
+
+    i = 0
+    while i < len(cps):
+        j = i
+        while j + 1 < len(cps) and cps[j + 1] == cps[j] + 1 and cps[j + 1] - cps[i] < SPAN_MAX:
+            j += 1
+        if j - i + 1 >= RUN_MIN:
+            flush_sparse()
+            cmaps.append(('range', list(range(i, j + 1))))
+        else:
+            for k in range(i, j + 1):
+                if sparse and cps[k] - cps[sparse[0]] >= SPAN_MAX:
+                    flush_sparse()
+                sparse.append(k)
+        i = j + 1
+    flush_sparse()
+    return cmaps
+
+
+def write_font(path, name, font_path, size, bpp, face, glyphs, bitmap):
+    cps = [g['cp'] for g in glyphs]
+    cmaps = build_cmaps(glyphs)
+    metrics = face.size
+    scale = size / face.units_per_EM
+
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write(TEMPLATE_HEAD.format(font=os.path.basename(font_path), size=size, bpp=bpp, count=len(glyphs)))
+
+        f.write('static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {\n')
+        for i in range(0, len(bitmap), 16):
+            f.write('    ' + ', '.join('0x{:02x}'.format(b) for b in bitmap[i:i + 16]) + ',\n')
+        if not bitmap:
+            f.write('    0x00,\n')
+        f.write('};\n\n')
+
+        f.write('static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {\n')
+        f.write('    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,\n')
+        for g in glyphs:
+            f.write('    {{.bitmap_index = {bitmap_index}, .adv_w = {adv_w}, .box_w = {box_w}, .box_h = {box_h}, '
+                    '.ofs_x = {ofs_x}, .ofs_y = {ofs_y}}} /* U+{cp:04X} */,\n'.format(**g))
+        f.write('};\n\n')
+
+        for n, (kind, idx) in enumerate(cmaps):
+            if kind == 'sparse':
+                f.write('static const uint16_t unicode_list_{}[] = {{\n'.format(n))
+                ofs = ['0x{:x}'.format(cps[k] - cps[idx[0]]) for k in idx]
+                for i in range(0, len(ofs), 12):
+                    f.write('    ' + ', '.join(ofs[i:i + 12]) + ',\n')
+                f.write('};\n\n')
+
+        f.write('static const lv_font_fmt_txt_cmap_t cmaps[] = {\n')
+        for n, (kind, idx) in enumerate(cmaps):
+            start = cps[idx[0]]
+            length = cps[idx[-1]] - start + 1
+            if kind == 'range':
+                f.write('    {{.range_start = {}, .range_length = {}, .glyph_id_start = {}, .unicode_list = NULL, '
+                        '.glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY}},\n'
+                        .format(start, length, idx[0] + 1))
+            else:
+                f.write('    {{.range_start = {}, .range_length = {}, .glyph_id_start = {}, .unicode_list = unicode_list_{}, '
+                        '.glyph_id_ofs_list = NULL, .list_length = {}, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY}},\n'
+                        .format(start, length, idx[0] + 1, n, len(idx)))
+        if not cmaps:
+            f.write('    {.range_start = 0, .range_length = 0, .glyph_id_start = 0, .unicode_list = NULL, '
+                    '.glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY},\n')
+        f.write('};\n')
+
+        f.write(TEMPLATE_TAIL.format(
+            name=name,
+            bpp=bpp,
+            cmap_num=len(cmaps),
+            line_height=(metrics.ascender - metrics.descender + 63) >> 6,
+            base_line=-metrics.descender >> 6,
+            underline_position=round(face.underline_position * scale),
+            underline_thickness=max(1, round(face.underline_thickness * scale)),
+        ))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Pre-render TTF/OTF font to LVGL bitmap fonts')
+    parser.add_argument('font', help='TTF/OTF font file')
+    parser.add_argument('output', help='Output directory')
+    parser.add_argument('--name', required=True, help='Name of fonts, size is appended (<name>_<size>)')
+    parser.add_argument('--sizes', type=int, nargs='+', required=True, help='Font sizes in pixels')
+    parser.add_argument('--bpp', type=int, choices=(1, 2, 4), default=4, help='Bits per pixel of glyph bitmaps')
+    parser.add_argument('--text-files', nargs='*', default=[], help='Files with the used texts (UTF-8)')
+    parser.add_argument('--symbols', default='', help='Additional characters')
+    parser.add_argument('--range', type=parse_range, nargs='*', default=[], help='Additional character ranges (e.g. 0x20-0x7E)')
+    args = parser.parse_args()
+
+    chars = collect_chars(args)
+    if not chars:
+        sys.exit('No characters, set --text-files, --symbols or --range')
+
+    os.makedirs(args.output, exist_ok=True)
+    face = freetype.Face(args.font)
+    for size in args.sizes:
+        face.set_pixel_sizes(0, size)
+        glyphs, bitmap = render_glyphs(face, chars, args.bpp)
+        name = '{}_{}'.format(args.name, size)
+        path = os.path.join(args.output, name + '.c')
+        write_font(path, name, args.font, size, args.bpp, face, glyphs, bitmap)
+        print('{}: {} of {} glyphs, {} bytes'.format(path, len(glyphs), len(chars), len(bitmap)))
+
+
+if __name__ == '__main__':
+    main()
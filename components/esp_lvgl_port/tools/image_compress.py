@@ -0,0 +1,170 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+"""
+Convert PNG image to RLE or LZ4 compressed C array for esp_lvgl_port compressed image decoder.
+
+Usage: image_compress.py <image.png> <output_dir> --cf ARGB8888 --compress RLE [--band-rows 8] [--name <name>]
+
+Rows of the image are compressed in independent bands, the decoder decodes only the bands
+of the drawn area (lvgl_port_cimage_decoder_init()). The image is written to
+<output_dir>/<name>.c as lv_image_dsc_t <name>, the name is the file name by default.
+"""
+import argparse
+import os
+import struct
+import sys
+
+import png
+
+MAGIC = b'LPCI'
+METHODS = {'RLE': 1, 'LZ4': 2}
+# Bytes per pixel and color format with alpha channel
+FORMATS = {
+    'L8': (1, False),
+    'A8': (1, True),
+    'RGB565': (2, False),
+    'RGB888': (3, False),
+    'ARGB8888': (4, True),
+    'XRGB8888': (4, False),
+}
+# RLE packet holds up to 127 pixels, shorter runs of the same pixel are stored as literals
+RLE_MAX = 127
+RLE_RUN_MIN = 3
+
+
+def convert_pixels(rows, cf):
+    """Convert RGBA8 rows to LVGL pixel format (little endian, BGR order)"""
+    out = []
+    for row in rows:
+        line = bytearray()
+        for i in range(0, len(row), 4):
+            r, g, b, a = row[i:i + 4]
+            if cf == 'L8':
+                line.append((r * 299 + g * 587 + b * 114) // 1000)
+            elif cf == 'A8':
+                line.append(a)
+            elif cf == 'RGB565':
+                line += struct.pack('<H', ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3))
+            elif cf == 'RGB888':
+                line += bytes((b, g, r))
+            elif cf == 'ARGB8888':
+                line += bytes((b, g, r, a))
+            else:
+                line += bytes((b, g, r, 0xFF))
+        out.append(bytes(line))
+    return out
+
+
+def rle_compress(data, px_size):
+    """LVGL RLE: control byte 0x80 | n followed by n literal pixels, or n followed by one repeated pixel"""
+    out = bytearray()
+    pixels = [data[i:i + px_size] for i in range(0, len(data), px_size)]
+    literals = []
+
+    def flush_literals():
+        while literals:
+            chunk = literals[:RLE_MAX]
+            del literals[:RLE_MAX]
+            out.append(0x80 | len(chunk))
+            for px in chunk:
+                out.extend(px)
+
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and run < RLE_MAX and pixels[i + run] == pixels[i]:
+            run += 1
+        if run >= RLE_RUN_MIN:
+            flush_literals()
+            out.append(run)
+            out += pixels[i]
+        else:
+            literals.extend(pixels[i:i + run])
+        i += run
+    flush_literals()
+    return bytes(out)
+
+
+def lz4_compress(data):
+    import lz4.block
+    return lz4.block.compress(data, mode='high_compression', store_size=False)
+
+
+def build_data(rows, cf, method, band_rows, width):
+    px_size = FORMATS[cf][0]
+    stride = width * px_size
+    bands = []
+    for y in range(0, len(rows), band_rows):
+        band = b''.join(rows[y:y + band_rows])
+        bands.append(rle_compress(band, px_size) if method == 'RLE' else lz4_compress(band))
+
+    table_size = (len(bands) + 1) * 4
+    offsets = []
+    offset = 16 + table_size
+    for band in bands:
+        offsets.append(offset)
+        offset += len(band)
+    offsets.append(offset)
+    header = struct.pack('<HHHI', band_rows, width, len(rows), stride)
+    table = b''.join(struct.pack('<I', o) for o in offsets)
+    return header, table, b''.join(bands), stride
+
+
+def write_bytes(f, data):
+    for i in range(0, len(data), 16):
+        f.write('    ' + ', '.join('0x{:02x}'.format(b) for b in data[i:i + 16]) + ',\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert PNG image to compressed C array for esp_lvgl_port')
+    parser.add_argument('image', help='PNG image')
+    parser.add_argument('output', help='Output directory')
+    parser.add_argument('--cf', choices=FORMATS.keys(), default='RGB565', help='Color format of pixels')
+    parser.add_argument('--compress', choices=METHODS.keys(), default='RLE', help='Compression of bands')
+    parser.add_argument('--band-rows', type=int, default=8, help='Rows in one band (decoded at once)')
+    parser.add_argument('--name', help='Name of lv_image_dsc_t (file name by default)')
+    args = parser.parse_args()
+
+    if not 1 <= args.band_rows <= 0xFFFF:
+        sys.exit('Bad number of band rows')
+    name = args.name or os.path.splitext(os.path.basename(args.image))[0]
+    width, height, rows, _ = png.Reader(filename=args.image).asRGBA8()
+    if width > 0xFFFF or height > 0xFFFF:
+        sys.exit('Image is too large')
+    rows = convert_pixels(rows, args.cf)
+
+    header, table, bands, stride = build_data(rows, args.cf, args.compress, args.band_rows, width)
+    raw_size = stride * height
+    data_size = 16 + len(table) + len(bands)
+
+    os.makedirs(args.output, exist_ok=True)
+    path = os.path.join(args.output, name + '.c')
+    with open(path, 'w', encoding='utf-8') as f:
+        f.write('/*\n * Generated by esp_lvgl_port/tools/image_compress.py, do not edit.\n')
+        f.write(' * Image: {}, {}x{} {}, {} compressed {} of {} bytes\n */\n\n'.format(
+            os.path.basename(args.image), width, height, args.cf, args.compress, data_size, raw_size))
+        f.write('#ifdef LV_LVGL_H_INCLUDE_SIMPLE\n#include "lvgl.h"\n#else\n#include "lvgl/lvgl.h"\n#endif\n\n')
+        f.write('#ifndef LV_ATTRIBUTE_MEM_ALIGN\n#define LV_ATTRIBUTE_MEM_ALIGN\n#endif\n\n')
+        f.write('static const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST uint8_t {}_map[] = {{\n'.format(name))
+        f.write('    /* Magic, method, color format, band rows, width, height, stride */\n')
+        magic = ', '.join("'{}'".format(c) for c in MAGIC.decode())
+        f.write('    {}, 0x{:02x}, LV_COLOR_FORMAT_{},\n'.format(magic, METHODS[args.compress], args.cf))
+        write_bytes(f, header)
+        f.write('    /* Offsets of bands */\n')
+        write_bytes(f, table)
+        f.write('    /* Bands */\n')
+        write_bytes(f, bands)
+        f.write('};\n\n')
+        f.write('const lv_image_dsc_t {} = {{\n'.format(name))
+        f.write('    .header.magic = LV_IMAGE_HEADER_MAGIC,\n')
+        f.write('    .header.cf = LV_COLOR_FORMAT_{},\n'.format('RAW_ALPHA' if FORMATS[args.cf][1] else 'RAW'))
+        f.write('    .header.w = {},\n    .header.h = {},\n'.format(width, height))
+        f.write('    .data_size = sizeof({}_map),\n'.format(name))
+        f.write('    .data = {}_map,\n'.format(name))
+        f.write('};\n')
+    print('{}: {} of {} bytes ({:.0%})'.format(path, data_size, raw_size, data_size / raw_size))
+
+
+if __name__ == '__main__':
+    main()
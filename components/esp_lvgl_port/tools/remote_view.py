@@ -0,0 +1,143 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+"""
+Receive remote view stream of esp_lvgl_port display (lvgl_port_remote_start()) and save it as PNG image.
+
+Usage: remote_view.py [--port 5000] [--output screen.png] [--period 1.0]
+
+The script listens for one TCP connection of the device. The image is written after the received
+updates at most once per period, the statistics of the stream are printed with it.
+"""
+import argparse
+import socket
+import struct
+import sys
+import time
+
+import png
+
+MAGIC = b'LPRV'
+VERSION = 1
+FORMAT_RGB565 = 1
+MSG_RECT = 1
+MSG_RESOLUTION = 2
+HEADER = struct.Struct('<BxHHHHI')
+
+
+def recv_exact(conn, size):
+    data = bytearray()
+    while len(data) < size:
+        chunk = conn.recv(size - len(data))
+        if not chunk:
+            raise EOFError
+        data += chunk
+    return bytes(data)
+
+
+def decode(payload, count):
+    """Decode QOI-like coded RGB565 pixels (state is reset in each message)"""
+    index = [0] * 64
+    prev = 0
+    out = []
+    i = 0
+    while len(out) < count:
+        op = payload[i]
+        i += 1
+        if op == 0xFE:
+            px = payload[i] | (payload[i + 1] << 8)
+            i += 2
+        elif op >= 0xC0:
+            out.extend([prev] * ((op & 0x3F) + 1))
+            continue
+        elif op < 0x40:
+            px = index[op]
+        else:
+            r, g, b = prev >> 11, (prev >> 5) & 0x3F, prev & 0x1F
+            if op < 0x80:
+                r = (r + ((op >> 4) & 3) - 2) & 0x1F
+                g = (g + ((op >> 2) & 3) - 2) & 0x3F
+                b = (b + (op & 3) - 2) & 0x1F
+            else:
+                second = payload[i]
+                i += 1
+                g = (g + (op & 0x3F) - 32) & 0x3F
+                r = (r + (second >> 4) - 8) & 0x1F
+                b = (b + (second & 0xF) - 8) & 0x1F
+            px = (r << 11) | (g << 5) | b
+        index[((px >> 11) * 3 + ((px >> 5) & 0x3F) * 5 + (px & 0x1F) * 7) & 0x3F] = px
+        out.append(px)
+        prev = px
+    if len(out) != count or i != len(payload):
+        raise ValueError('Bad rectangle payload')
+    return out
+
+
+def save(path, width, height, screen):
+    rows = []
+    for y in range(height):
+        row = bytearray()
+        for px in screen[y * width:(y + 1) * width]:
+            r, g, b = px >> 11, (px >> 5) & 0x3F, px & 0x1F
+            row += bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)))
+        rows.append(row)
+    with open(path, 'wb') as f:
+        png.Writer(width, height, greyscale=False).write(f, rows)
+
+
+def receive(conn, args):
+    if recv_exact(conn, 6) != MAGIC + bytes((VERSION, FORMAT_RGB565)):
+        sys.exit('Not a remote view stream of version {}'.format(VERSION))
+    width = height = 0
+    screen = []
+    dirty = False
+    start = last_save = time.time()
+    received = rects = 0
+    while True:
+        msg_type, x, y, w, h, length = HEADER.unpack(recv_exact(conn, HEADER.size))
+        payload = recv_exact(conn, length)
+        received += HEADER.size + length
+        if msg_type == MSG_RESOLUTION:
+            width, height = w, h
+            screen = [0] * (width * height)
+        elif msg_type == MSG_RECT:
+            if x + w > width or y + h > height:
+                raise ValueError('Rectangle out of the display')
+            pixels = decode(payload, w * h)
+            for row in range(h):
+                screen[(y + row) * width + x:(y + row) * width + x + w] = pixels[row * w:(row + 1) * w]
+            rects += 1
+            dirty = True
+        now = time.time()
+        if dirty and width and now - last_save >= args.period:
+            save(args.output, width, height, screen)
+            print('{}x{}: {} rectangles, {:.1f} kB/s'.format(width, height, rects, received / (now - start) / 1024))
+            last_save = now
+            dirty = False
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Receive remote view of esp_lvgl_port display')
+    parser.add_argument('--port', type=int, default=5000, help='TCP port to listen on')
+    parser.add_argument('--output', default='screen.png', help='Written PNG image')
+    parser.add_argument('--period', type=float, default=1.0, help='Minimum period of writing the image (s)')
+    args = parser.parse_args()
+
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(('', args.port))
+    server.listen(1)
+    print('Waiting for device on port {}'.format(args.port))
+    conn, addr = server.accept()
+    print('Connected from {}'.format(addr[0]))
+    try:
+        receive(conn, args)
+    except EOFError:
+        print('Connection closed')
+    finally:
+        conn.close()
+        server.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,838 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "soc/soc_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "esp_lvgl_port.h"
+#include "esp_mjpeg_player.h"
+
+#if SOC_JPEG_DECODE_SUPPORTED
+#include "driver/jpeg_decode.h"
+#else
+#include "jpeg_decoder.h"
+#endif
+
+#if LVGL_VERSION_MAJOR < 9
+#error "esp_mjpeg_player requires video layer of esp_lvgl_port (LVGL 9.1 or newer)"
+#endif
+
+static const char *TAG = "MJPEG";
+
+#define MJPEG_PLAYER_FPS_DEFAULT                (25)
+#define MJPEG_PLAYER_MAX_FRAME_SIZE_DEFAULT     (64 * 1024)
+#define MJPEG_PLAYER_FRAME_BUFFERS_DEFAULT      (3)
+#define MJPEG_PLAYER_READER_PRIORITY_DEFAULT    (5)
+#define MJPEG_PLAYER_DECODER_PRIORITY_DEFAULT   (6)
+#define MJPEG_PLAYER_READER_STACK               (3072)
+#define MJPEG_PLAYER_DECODER_STACK              (4096)
+/* Input buffers, one is read while the other one is decoded */
+#define MJPEG_PLAYER_INPUTS                     (2)
+/* Size of one file read of raw MJPEG files (frames are split by searching for EOI marker) */
+#define MJPEG_PLAYER_CHUNK_SIZE                 (4096)
+/* Timeout of blocking operations, when the stop flag is checked */
+#define MJPEG_PLAYER_STOP_CHECK_MS              (100)
+/* Timeout of releasing the frame buffers by LVGL task after the video layer is deleted */
+#define MJPEG_PLAYER_RELEASE_TIMEOUT_MS         (1000)
+#if SOC_JPEG_DECODE_SUPPORTED
+#define MJPEG_PLAYER_DECODE_TIMEOUT_MS          (100)
+#endif
+
+/* Event bits */
+#define MJPEG_PLAYER_READER_IDLE    (1 << 0)
+#define MJPEG_PLAYER_DECODER_IDLE   (1 << 1)
+#define MJPEG_PLAYER_READER_EXITED  (1 << 2)
+#define MJPEG_PLAYER_DECODER_EXITED (1 << 3)
+
+#define MJPEG_PLAYER_FOURCC(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+/* Header of RIFF chunk */
+typedef struct __attribute__((packed))
+{
+    uint32_t id;
+    uint32_t size;
+} esp_mjpeg_player_chunk_t;
+
+/* Main AVI header (only used fields) */
+typedef struct __attribute__((packed))
+{
+    uint32_t us_per_frame;
+    uint8_t ignore_0[28];
+    uint32_t width;
+    uint32_t height;
+} esp_mjpeg_player_avih_t;
+
+/* Read JPEG frame */
+typedef struct {
+    uint8_t     *data;
+    size_t      len;
+    /* Frame pushed by esp_mjpeg_player_stream_push */
+    esp_mjpeg_player_release_cb_t release_cb;
+    void        *release_ctx;
+    int64_t     push_us;
+} esp_mjpeg_player_input_t;
+
+struct esp_mjpeg_player_s {
+    lvgl_port_video_handle_t video;
+    uint32_t                hres;
+    uint32_t                vres;
+    uint32_t                default_frame_us;
+    size_t                  max_frame_size;
+    size_t                  frame_size;     /* Bytes of one RGB565 frame buffer */
+    uint8_t                 frame_buffers;
+    bool                    swap_bytes;
+    bool                    stream_only;
+    esp_mjpeg_player_done_cb_t done_cb;
+    void                    *user_ctx;
+    uint8_t                 *inputs[MJPEG_PLAYER_INPUTS];
+    uint8_t                 **frames;
+    QueueHandle_t           free_inputs;    /* Input buffers for reader */
+    QueueHandle_t           read_inputs;    /* Read frames for decoder */
+    QueueHandle_t           free_frames;    /* Frame buffers not used by LCD (released by video layer) */
+    uint8_t                 *chunk;         /* File read of raw MJPEG */
+    size_t                  chunk_pos;
+    size_t                  chunk_len;
+    TaskHandle_t            reader_task;
+    TaskHandle_t            decoder_task;
+    EventGroupHandle_t      events;
+    SemaphoreHandle_t       api_lock;
+#if SOC_JPEG_DECODE_SUPPORTED
+    jpeg_decoder_handle_t   jpeg;
+#endif
+    /* Playback */
+    FILE                    *file;
+    bool                    avi;
+    uint32_t                movi_start;     /* Offset of the first chunk in AVI 'movi' list */
+    uint32_t                movi_end;
+    uint32_t                avi_pos;        /* Offset of the next chunk */
+    uint32_t                frame_us;       /* Frame period */
+    volatile bool           repeat;
+    volatile bool           stop;
+    volatile bool           eof;            /* The whole file was read */
+    volatile bool           exit;
+    bool                    live;           /* Frames are pushed by esp_mjpeg_player_stream_push */
+    SemaphoreHandle_t       live_lock;      /* Push of frames against the end of the stream */
+    /* Statistics */
+    portMUX_TYPE            stats_lock;
+    esp_mjpeg_player_stats_t stats;
+    uint64_t                decode_sum_us;
+    uint32_t                decoded;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void esp_mjpeg_player_reader_task(void *arg);
+static void esp_mjpeg_player_decoder_task(void *arg);
+static void esp_mjpeg_player_stop_internal(esp_mjpeg_player_handle_t player);
+static void esp_mjpeg_player_free(esp_mjpeg_player_handle_t player);
+static esp_err_t esp_mjpeg_player_avi_open(esp_mjpeg_player_handle_t player);
+static void esp_mjpeg_player_release_frame(void *frame, void *user_ctx);
+static void *esp_mjpeg_player_alloc(size_t size, bool input, bool spiram, size_t *allocated);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_mjpeg_player_new(const esp_mjpeg_player_config_t *config, esp_mjpeg_player_handle_t *ret_player)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_player && config->disp, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->hres > 0 && config->vres > 0, ESP_ERR_INVALID_ARG, TAG, "invalid video resolution");
+    ESP_RETURN_ON_FALSE(config->frame_buffers == 0 || config->frame_buffers >= 2, ESP_ERR_INVALID_ARG, TAG, "At least two frame buffers are needed!");
+#if SOC_JPEG_DECODE_SUPPORTED
+    /* Hardware decoder writes whole MCUs (16x16 pixels in YUV420) */
+    ESP_RETURN_ON_FALSE((config->hres % 16) == 0 && (config->vres % 16) == 0, ESP_ERR_INVALID_SIZE, TAG, "Resolution must be multiple of 16!");
+#endif
+
+    esp_mjpeg_player_handle_t player = calloc(1, sizeof(struct esp_mjpeg_player_s));
+    ESP_RETURN_ON_FALSE(player, ESP_ERR_NO_MEM, TAG, "Not enough memory for player allocation!");
+    player->hres = config->hres;
+    player->vres = config->vres;
+    player->default_frame_us = 1000000 / (config->fps ? config->fps : MJPEG_PLAYER_FPS_DEFAULT);
+    player->max_frame_size = (config->max_frame_size ? config->max_frame_size : MJPEG_PLAYER_MAX_FRAME_SIZE_DEFAULT);
+    player->frame_buffers = (config->frame_buffers ? config->frame_buffers : MJPEG_PLAYER_FRAME_BUFFERS_DEFAULT);
+    player->swap_bytes = config->flags.swap_bytes;
+    player->stream_only = config->flags.stream_only;
+    player->done_cb = config->done_cb;
+    player->user_ctx = config->user_ctx;
+    portMUX_INITIALIZE(&player->stats_lock);
+
+#if SOC_JPEG_DECODE_SUPPORTED
+    const jpeg_decode_engine_cfg_t engine_cfg = {
+        .timeout_ms = MJPEG_PLAYER_DECODE_TIMEOUT_MS,
+    };
+    ESP_GOTO_ON_ERROR(jpeg_new_decoder_engine(&engine_cfg, &player->jpeg), err, TAG, "JPEG decoder init failed");
+#endif
+
+    player->events = xEventGroupCreate();
+    player->api_lock = xSemaphoreCreateMutex();
+    player->live_lock = xSemaphoreCreateMutex();
+    player->free_inputs = xQueueCreate(MJPEG_PLAYER_INPUTS, sizeof(uint8_t *));
+    player->read_inputs = xQueueCreate(MJPEG_PLAYER_INPUTS, sizeof(esp_mjpeg_player_input_t));
+    player->free_frames = xQueueCreate(player->frame_buffers, sizeof(uint8_t *));
+    player->frames = calloc(player->frame_buffers, sizeof(uint8_t *));
+    player->chunk = malloc(MJPEG_PLAYER_CHUNK_SIZE);
+    ESP_GOTO_ON_FALSE(player->events && player->api_lock && player->live_lock && player->free_inputs && player->read_inputs && player->free_frames && player->frames && player->chunk,
+                      ESP_ERR_NO_MEM, err, TAG, "Not enough memory for player!");
+
+    /* Pushed frames of live stream are decoded from the memory of the producer */
+    for (int i = 0; i < MJPEG_PLAYER_INPUTS && !player->stream_only; i++) {
+        size_t allocated = 0;
+        player->inputs[i] = esp_mjpeg_player_alloc(player->max_frame_size, true, config->flags.buff_spiram, &allocated);
+        ESP_GOTO_ON_FALSE(player->inputs[i], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for input buffer!");
+        player->max_frame_size = MIN(player->max_frame_size, allocated);
+        xQueueSend(player->free_inputs, &player->inputs[i], 0);
+    }
+    for (int i = 0; i < player->frame_buffers; i++) {
+        size_t allocated = 0;
+        player->frames[i] = esp_mjpeg_player_alloc(player->hres * player->vres * sizeof(uint16_t), false, config->flags.buff_spiram, &allocated);
+        ESP_GOTO_ON_FALSE(player->frames[i], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for frame buffer!");
+        player->frame_size = allocated;
+        xQueueSend(player->free_frames, &player->frames[i], 0);
+    }
+    xEventGroupSetBits(player->events, MJPEG_PLAYER_READER_IDLE | MJPEG_PLAYER_DECODER_IDLE);
+
+    /* Frames are sent directly to the LCD, LVGL does not compose them */
+    const lvgl_port_video_cfg_t video_cfg = {
+        .disp = config->disp,
+        .hres = config->hres,
+        .vres = config->vres,
+        .x = config->x,
+        .y = config->y,
+        .release_cb = esp_mjpeg_player_release_frame,
+        .user_ctx = player,
+        .flags = {
+            .direct = 1,
+        },
+    };
+    ESP_GOTO_ON_ERROR(lvgl_port_video_create(&video_cfg, &player->video), err, TAG, "Video layer create failed");
+
+    const UBaseType_t reader_priority = (config->reader_priority ? config->reader_priority : MJPEG_PLAYER_READER_PRIORITY_DEFAULT);
+    const UBaseType_t decoder_priority = (config->decoder_priority ? config->decoder_priority : MJPEG_PLAYER_DECODER_PRIORITY_DEFAULT);
+    BaseType_t res = pdPASS;
+    if (!player->stream_only) {
+        res = xTaskCreate(esp_mjpeg_player_reader_task, "mjpeg_reader", MJPEG_PLAYER_READER_STACK, player, reader_priority, &player->reader_task);
+        ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create reader task fail!");
+    }
+    res = xTaskCreate(esp_mjpeg_player_decoder_task, "mjpeg_decoder", MJPEG_PLAYER_DECODER_STACK, player, decoder_priority, &player->decoder_task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create decoder task fail!");
+
+    *ret_player = player;
+    return ESP_OK;
+
+err:
+    esp_mjpeg_player_free(player);
+    return ret;
+}
+
+esp_err_t esp_mjpeg_player_play(esp_mjpeg_player_handle_t player, const char *path, bool repeat)
+{
+    esp_err_t ret = ESP_OK;
+    uint32_t riff[3];
+    ESP_RETURN_ON_FALSE(player && path, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!player->stream_only, ESP_ERR_NOT_SUPPORTED, TAG, "Player was created only for streams");
+
+    xSemaphoreTake(player->api_lock, portMAX_DELAY);
+    esp_mjpeg_player_stop_internal(player);
+
+    player->file = fopen(path, "rb");
+    ESP_GOTO_ON_FALSE(player->file, ESP_ERR_NOT_FOUND, err, TAG, "%s file does not exist!", path);
+
+    /* AVI or raw MJPEG */
+    player->frame_us = player->default_frame_us;
+    player->avi = (fread(riff, 1, sizeof(riff), player->file) == sizeof(riff) &&
+                   riff[0] == MJPEG_PLAYER_FOURCC('R', 'I', 'F', 'F') && riff[2] == MJPEG_PLAYER_FOURCC('A', 'V', 'I', ' '));
+    if (player->avi) {
+        ESP_GOTO_ON_ERROR(esp_mjpeg_player_avi_open(player), err, TAG, "Unsupported AVI file");
+    } else {
+        fseek(player->file, 0, SEEK_SET);
+    }
+    player->chunk_pos = 0;
+    player->chunk_len = 0;
+    ESP_LOGI(TAG, "Playing %s: %s, %" PRIu32 "x%" PRIu32 ", %" PRIu32 " us per frame", path, player->avi ? "AVI" : "MJPEG",
+             player->hres, player->vres, player->frame_us);
+
+    player->repeat = repeat;
+    player->stop = false;
+    player->eof = false;
+
+    xEventGroupClearBits(player->events, MJPEG_PLAYER_READER_IDLE | MJPEG_PLAYER_DECODER_IDLE);
+    xTaskNotifyGive(player->reader_task);
+    xTaskNotifyGive(player->decoder_task);
+    xSemaphoreGive(player->api_lock);
+    return ESP_OK;
+
+err:
+    if (player->file) {
+        fclose(player->file);
+        player->file = NULL;
+    }
+    xSemaphoreGive(player->api_lock);
+    return ret;
+}
+
+esp_err_t esp_mjpeg_player_stream_start(esp_mjpeg_player_handle_t player)
+{
+    ESP_RETURN_ON_FALSE(player, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    xSemaphoreTake(player->api_lock, portMAX_DELAY);
+    esp_mjpeg_player_stop_internal(player);
+    ESP_LOGI(TAG, "Playing stream: %" PRIu32 "x%" PRIu32, player->hres, player->vres);
+
+    player->stop = false;
+    player->eof = false;
+    xSemaphoreTake(player->live_lock, portMAX_DELAY);
+    player->live = true;
+    xSemaphoreGive(player->live_lock);
+
+    /* Reader stays idle, frames are queued by the producer */
+    xEventGroupClearBits(player->events, MJPEG_PLAYER_DECODER_IDLE);
+    xTaskNotifyGive(player->decoder_task);
+    xSemaphoreGive(player->api_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_mjpeg_player_stream_push(esp_mjpeg_player_handle_t player, const uint8_t *data, size_t len,
+                                       esp_mjpeg_player_release_cb_t release_cb, void *release_ctx)
+{
+    ESP_RETURN_ON_FALSE(player && data && len && release_cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    const esp_mjpeg_player_input_t input = {
+        .data = (uint8_t *)data,
+        .len = len,
+        .release_cb = release_cb,
+        .release_ctx = release_ctx,
+        .push_us = esp_timer_get_time(),
+    };
+    esp_mjpeg_player_input_t oldest;
+    bool replaced = false;
+
+    xSemaphoreTake(player->live_lock, portMAX_DELAY);
+    if (!player->live) {
+        xSemaphoreGive(player->live_lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+    /* The newest frame wins, the oldest waiting one is dropped without decoding */
+    if (xQueueSend(player->read_inputs, &input, 0) != pdTRUE) {
+        replaced = (xQueueReceive(player->read_inputs, &oldest, 0) == pdTRUE);
+        xQueueSend(player->read_inputs, &input, 0);
+    }
+    xSemaphoreGive(player->live_lock);
+
+    if (replaced) {
+        oldest.release_cb(oldest.data, oldest.release_ctx);
+        portENTER_CRITICAL(&player->stats_lock);
+        player->stats.frames_dropped++;
+        portEXIT_CRITICAL(&player->stats_lock);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_mjpeg_player_stop(esp_mjpeg_player_handle_t player)
+{
+    ESP_RETURN_ON_FALSE(player, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    xSemaphoreTake(player->api_lock, portMAX_DELAY);
+    esp_mjpeg_player_stop_internal(player);
+    xSemaphoreGive(player->api_lock);
+    return ESP_OK;
+}
+
+bool esp_mjpeg_player_is_playing(esp_mjpeg_player_handle_t player)
+{
+    assert(player);
+    return ((xEventGroupGetBits(player->events) & MJPEG_PLAYER_DECODER_IDLE) == 0);
+}
+
+esp_err_t esp_mjpeg_player_get_stats(esp_mjpeg_player_handle_t player, esp_mjpeg_player_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(player && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    portENTER_CRITICAL(&player->stats_lock);
+    *stats = player->stats;
+    stats->avg_decode_us = (player->decoded ? (uint32_t)(player->decode_sum_us / player->decoded) : 0);
+    if (reset) {
+        memset(&player->stats, 0, sizeof(player->stats));
+        player->decode_sum_us = 0;
+        player->decoded = 0;
+    }
+    portEXIT_CRITICAL(&player->stats_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_mjpeg_player_del(esp_mjpeg_player_handle_t player)
+{
+    ESP_RETURN_ON_FALSE(player, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_mjpeg_player_stop(player);
+    esp_mjpeg_player_free(player);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Called from LVGL task, when the frame is not used by the LCD anymore */
+static void esp_mjpeg_player_release_frame(void *frame, void *user_ctx)
+{
+    esp_mjpeg_player_handle_t player = (esp_mjpeg_player_handle_t)user_ctx;
+    xQueueSend(player->free_frames, &frame, 0);
+}
+
+static void *esp_mjpeg_player_alloc(size_t size, bool input, bool spiram, size_t *allocated)
+{
+#if SOC_JPEG_DECODE_SUPPORTED
+    /* Buffers of hardware decoder are aligned to cache lines */
+    const jpeg_decode_memory_alloc_cfg_t mem_cfg = {
+        .buffer_direction = (input ? JPEG_DEC_ALLOC_INPUT_BUFFER : JPEG_DEC_ALLOC_OUTPUT_BUFFER),
+    };
+    (void)spiram;
+    return jpeg_alloc_decoder_mem(size, &mem_cfg, allocated);
+#else
+    void *buf = heap_caps_malloc(size, (spiram ? MALLOC_CAP_SPIRAM : (input ? MALLOC_CAP_DEFAULT : MALLOC_CAP_DMA)));
+    *allocated = (buf ? size : 0);
+    return buf;
+#endif
+}
+
+/* Return the input buffer to the reader or the pushed frame to its producer */
+static void esp_mjpeg_player_input_done(esp_mjpeg_player_handle_t player, const esp_mjpeg_player_input_t *input)
+{
+    if (input->release_cb) {
+        input->release_cb(input->data, input->release_ctx);
+    } else {
+        xQueueSend(player->free_inputs, &input->data, 0);
+    }
+}
+
+/* Called with API lock */
+static void esp_mjpeg_player_stop_internal(esp_mjpeg_player_handle_t player)
+{
+    player->stop = true;
+    /* Decoder is idle after the reader */
+    xEventGroupWaitBits(player->events, MJPEG_PLAYER_DECODER_IDLE, pdFALSE, pdTRUE, portMAX_DELAY);
+}
+
+static void esp_mjpeg_player_free(esp_mjpeg_player_handle_t player)
+{
+    EventBits_t exited = 0;
+    player->exit = true;
+    if (player->reader_task) {
+        exited |= MJPEG_PLAYER_READER_EXITED;
+        xTaskNotifyGive(player->reader_task);
+    }
+    if (player->decoder_task) {
+        exited |= MJPEG_PLAYER_DECODER_EXITED;
+        xTaskNotifyGive(player->decoder_task);
+    }
+    if (exited) {
+        xEventGroupWaitBits(player->events, exited, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+
+    /* The shown frame is released by LVGL task, when the video layer is deleted */
+    if (player->video && lvgl_port_video_delete(player->video) == ESP_OK) {
+        const TickType_t start = xTaskGetTickCount();
+        while (uxQueueMessagesWaiting(player->free_frames) < player->frame_buffers &&
+                xTaskGetTickCount() - start < pdMS_TO_TICKS(MJPEG_PLAYER_RELEASE_TIMEOUT_MS)) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+    }
+
+    if (player->frames) {
+        for (int i = 0; i < player->frame_buffers; i++) {
+            free(player->frames[i]);
+        }
+        free(player->frames);
+    }
+    for (int i = 0; i < MJPEG_PLAYER_INPUTS; i++) {
+        free(player->inputs[i]);
+    }
+#if SOC_JPEG_DECODE_SUPPORTED
+    if (player->jpeg) {
+        jpeg_del_decoder_engine(player->jpeg);
+    }
+#endif
+    if (player->free_inputs) {
+        vQueueDelete(player->free_inputs);
+    }
+    if (player->read_inputs) {
+        vQueueDelete(player->read_inputs);
+    }
+    if (player->free_frames) {
+        vQueueDelete(player->free_frames);
+    }
+    if (player->events) {
+        vEventGroupDelete(player->events);
+    }
+    if (player->api_lock) {
+        vSemaphoreDelete(player->api_lock);
+    }
+    if (player->live_lock) {
+        vSemaphoreDelete(player->live_lock);
+    }
+    free(player->chunk);
+    free(player);
+}
+
+/* Find 'movi' list, frame period and resolution in 'avih' header */
+static esp_err_t esp_mjpeg_player_avi_open(esp_mjpeg_player_handle_t player)
+{
+    esp_mjpeg_player_chunk_t chunk;
+    uint32_t pos = 12;
+
+    while (fread(&chunk, 1, sizeof(chunk), player->file) == sizeof(chunk)) {
+        pos += sizeof(chunk);
+        if (chunk.id == MJPEG_PLAYER_FOURCC('L', 'I', 'S', 'T')) {
+            uint32_t type;
+            ESP_RETURN_ON_FALSE(fread(&type, 1, sizeof(type), player->file) == sizeof(type), ESP_ERR_INVALID_RESPONSE, TAG, "Error in reading file");
+            pos += sizeof(type);
+            if (type == MJPEG_PLAYER_FOURCC('m', 'o', 'v', 'i')) {
+                player->movi_start = pos;
+                player->movi_end = pos + chunk.size - sizeof(type);
+                player->avi_pos = pos;
+                return ESP_OK;
+            }
+            if (type != MJPEG_PLAYER_FOURCC('h', 'd', 'r', 'l')) {
+                pos += chunk.size - sizeof(type) + (chunk.size & 1);
+            }
+            /* Chunks of header list are read one by one */
+        } else if (chunk.id == MJPEG_PLAYER_FOURCC('a', 'v', 'i', 'h')) {
+            esp_mjpeg_player_avih_t avih;
+            ESP_RETURN_ON_FALSE(chunk.size >= sizeof(avih) && fread(&avih, 1, sizeof(avih), player->file) == sizeof(avih),
+                                ESP_ERR_INVALID_RESPONSE, TAG, "Error in reading AVI header");
+            ESP_RETURN_ON_FALSE(avih.width == player->hres && avih.height == player->vres, ESP_ERR_INVALID_RESPONSE, TAG,
+                                "Resolution of the video %" PRIu32 "x%" PRIu32 " differs from the player", avih.width, avih.height);
+            if (avih.us_per_frame) {
+                player->frame_us = avih.us_per_frame;
+            }
+            pos += chunk.size + (chunk.size & 1);
+        } else {
+            pos += chunk.size + (chunk.size & 1);
+        }
+        fseek(player->file, pos, SEEK_SET);
+    }
+
+    ESP_LOGE(TAG, "AVI file without 'movi' list");
+    return ESP_ERR_INVALID_RESPONSE;
+}
+
+/* Read next compressed frame from AVI 'movi' list, ESP_ERR_NOT_FOUND at its end */
+static esp_err_t esp_mjpeg_player_avi_read(esp_mjpeg_player_handle_t player, uint8_t *dest, size_t *len)
+{
+    esp_mjpeg_player_chunk_t chunk;
+
+    while (player->avi_pos + sizeof(chunk) <= player->movi_end) {
+        if (fread(&chunk, 1, sizeof(chunk), player->file) != sizeof(chunk)) {
+            break;
+        }
+        player->avi_pos += sizeof(chunk);
+        const uint32_t padded = chunk.size + (chunk.size & 1);
+
+        if (chunk.id == MJPEG_PLAYER_FOURCC('L', 'I', 'S', 'T')) {
+            /* 'rec ' list, its chunks are read one by one */
+            uint32_t type;
+            if (fread(&type, 1, sizeof(type), player->file) != sizeof(type)) {
+                break;
+            }
+            player->avi_pos += sizeof(type);
+            continue;
+        }
+
+        /* Video stream chunks '##dc' (compressed) and '##db' */
+        const uint16_t kind = chunk.id >> 16;
+        if (kind == ('d' | ('c' << 8)) || kind == ('d' | ('b' << 8))) {
+            if (chunk.size > player->max_frame_size) {
+                ESP_LOGW(TAG, "Frame of %" PRIu32 " bytes does not fit the input buffer", chunk.size);
+                *len = 0;
+            } else {
+                *len = fread(dest, 1, chunk.size, player->file);
+            }
+            player->avi_pos += padded;
+            fseek(player->file, player->avi_pos, SEEK_SET);
+            return ESP_OK;
+        }
+
+        /* Audio and other chunks */
+        player->avi_pos += padded;
+        fseek(player->file, player->avi_pos, SEEK_SET);
+    }
+
+    return ESP_ERR_NOT_FOUND;
+}
+
+/* Read next JPEG image from raw MJPEG file (up to EOI marker), ESP_ERR_NOT_FOUND at the end of the file */
+static esp_err_t esp_mjpeg_player_raw_read(esp_mjpeg_player_handle_t player, uint8_t *dest, size_t *len)
+{
+    size_t n = 0;
+    uint8_t prev = 0;
+
+    while (1) {
+        if (player->chunk_pos == player->chunk_len) {
+            player->chunk_len = fread(player->chunk, 1, MJPEG_PLAYER_CHUNK_SIZE, player->file);
+            player->chunk_pos = 0;
+            if (player->chunk_len == 0) {
+                return ESP_ERR_NOT_FOUND;
+            }
+        }
+
+        /* EOI is 0xFF 0xD9, 0xFF may be the last byte of the previous chunk */
+        const uint8_t *s = player->chunk + player->chunk_pos;
+        const size_t avail = player->chunk_len - player->chunk_pos;
+        size_t span = avail;
+        bool found = false;
+        if (prev == 0xFF && s[0] == 0xD9) {
+            span = 1;
+            found = true;
+        } else {
+            const uint8_t *p = s;
+            while ((p = memchr(p, 0xD9, avail - (p - s))) != NULL) {
+                if (p > s && p[-1] == 0xFF) {
+                    span = p - s + 1;
+                    found = true;
+                    break;
+                }
+                p++;
+            }
+        }
+
+        if (n + span <= player->max_frame_size) {
+            memcpy(dest + n, s, span);
+        }
+        n += span;
+        prev = s[span - 1];
+        player->chunk_pos += span;
+
+        if (found) {
+            if (n > player->max_frame_size) {
+                ESP_LOGW(TAG, "Frame of %u bytes does not fit the input buffer", (unsigned)n);
+                n = 0;
+            }
+            *len = n;
+            return ESP_OK;
+        }
+    }
+}
+
+static void esp_mjpeg_player_rewind(esp_mjpeg_player_handle_t player)
+{
+    if (player->avi) {
+        player->avi_pos = player->movi_start;
+        fseek(player->file, player->movi_start, SEEK_SET);
+    } else {
+        player->chunk_pos = 0;
+        player->chunk_len = 0;
+        fseek(player->file, 0, SEEK_SET);
+    }
+}
+
+static void esp_mjpeg_player_reader_task(void *arg)
+{
+    esp_mjpeg_player_handle_t player = (esp_mjpeg_player_handle_t)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (player->exit) {
+            break;
+        }
+
+        while (!player->stop) {
+            esp_mjpeg_player_input_t input = {0};
+            if (xQueueReceive(player->free_inputs, &input.data, pdMS_TO_TICKS(MJPEG_PLAYER_STOP_CHECK_MS)) != pdTRUE) {
+                continue;
+            }
+
+            const int64_t start = esp_timer_get_time();
+            esp_err_t ret = (player->avi ? esp_mjpeg_player_avi_read(player, input.data, &input.len) : esp_mjpeg_player_raw_read(player, input.data, &input.len));
+            if (ret == ESP_ERR_NOT_FOUND && player->repeat) {
+                esp_mjpeg_player_rewind(player);
+                ret = (player->avi ? esp_mjpeg_player_avi_read(player, input.data, &input.len) : esp_mjpeg_player_raw_read(player, input.data, &input.len));
+            }
+            const uint32_t read_us = (uint32_t)(esp_timer_get_time() - start);
+
+            if (ret != ESP_OK) {
+                xQueueSend(player->free_inputs, &input.data, 0);
+                break;
+            }
+
+            portENTER_CRITICAL(&player->stats_lock);
+            player->stats.max_read_us = MAX(player->stats.max_read_us, read_us);
+            if (input.len == 0) {
+                player->stats.decode_errors++;
+            }
+            portEXIT_CRITICAL(&player->stats_lock);
+
+            if (input.len == 0) {
+                xQueueSend(player->free_inputs, &input.data, 0);
+                continue;
+            }
+            while (!player->stop && xQueueSend(player->read_inputs, &input, pdMS_TO_TICKS(MJPEG_PLAYER_STOP_CHECK_MS)) != pdTRUE) {
+            }
+            if (player->stop) {
+                xQueueSend(player->free_inputs, &input.data, 0);
+            }
+        }
+
+        player->eof = true;
+        xEventGroupSetBits(player->events, MJPEG_PLAYER_READER_IDLE);
+    }
+
+    xEventGroupSetBits(player->events, MJPEG_PLAYER_READER_EXITED);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t esp_mjpeg_player_decode(esp_mjpeg_player_handle_t player, const esp_mjpeg_player_input_t *input, uint8_t *frame)
+{
+#if SOC_JPEG_DECODE_SUPPORTED
+    jpeg_decode_picture_info_t info;
+    ESP_RETURN_ON_ERROR(jpeg_decoder_get_info(input->data, input->len, &info), TAG, "Invalid JPEG frame");
+    ESP_RETURN_ON_FALSE(info.width == player->hres && info.height == player->vres, ESP_ERR_INVALID_SIZE, TAG, "Invalid size of JPEG frame");
+
+    const jpeg_decode_cfg_t decode_cfg = {
+        .output_format = JPEG_DECODE_OUT_FORMAT_RGB565,
+        .rgb_order = JPEG_DEC_RGB_ELEMENT_ORDER_BGR,
+        .conv_std = JPEG_YUV_RGB_CONV_STD_BT601,
+    };
+    uint32_t out_size = 0;
+    return jpeg_decoder_process(player->jpeg, &decode_cfg, input->data, input->len, frame, player->frame_size, &out_size);
+#else
+    esp_jpeg_image_cfg_t jpeg_cfg = {
+        .indata = input->data,
+        .indata_size = input->len,
+        .outbuf = frame,
+        .outbuf_size = player->frame_size,
+        .out_format = JPEG_IMAGE_FORMAT_RGB565,
+        .out_scale = JPEG_IMAGE_SCALE_0,
+        .flags = {
+            .swap_color_bytes = player->swap_bytes,
+        },
+    };
+    esp_jpeg_image_output_t outimg;
+    ESP_RETURN_ON_ERROR(esp_jpeg_decode(&jpeg_cfg, &outimg), TAG, "Invalid JPEG frame");
+    ESP_RETURN_ON_FALSE(outimg.width == player->hres && outimg.height == player->vres, ESP_ERR_INVALID_SIZE, TAG, "Invalid size of JPEG frame");
+    return ESP_OK;
+#endif
+}
+
+static void esp_mjpeg_player_decoder_task(void *arg)
+{
+    esp_mjpeg_player_handle_t player = (esp_mjpeg_player_handle_t)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (player->exit) {
+            break;
+        }
+
+        int64_t start_us = 0;
+        uint32_t index = 0;
+        while (!player->stop) {
+            esp_mjpeg_player_input_t input;
+            if (xQueueReceive(player->read_inputs, &input, pdMS_TO_TICKS(MJPEG_PLAYER_STOP_CHECK_MS)) != pdTRUE) {
+                /* Reader sets EOF after its last frame was queued */
+                if (player->eof && uxQueueMessagesWaiting(player->read_inputs) == 0) {
+                    break;
+                }
+                continue;
+            }
+
+            /* Timeline starts with the first frame, frames late more than one period are not decoded */
+            int64_t now = esp_timer_get_time();
+            if (index == 0) {
+                start_us = now;
+            }
+            /* Pushed frames are shown as soon as they are decoded */
+            const int64_t frame_time = (player->live ? input.push_us : start_us + (int64_t)index * player->frame_us);
+            index++;
+            if (!player->live && now > frame_time + player->frame_us) {
+                esp_mjpeg_player_input_done(player, &input);
+                portENTER_CRITICAL(&player->stats_lock);
+                player->stats.frames_dropped++;
+                portEXIT_CRITICAL(&player->stats_lock);
+                continue;
+            }
+
+            /* Frame buffer released by LCD (shown two frames ago) */
+            uint8_t *frame = NULL;
+            while (!player->stop && xQueueReceive(player->free_frames, &frame, pdMS_TO_TICKS(MJPEG_PLAYER_STOP_CHECK_MS)) != pdTRUE) {
+            }
+            if (frame == NULL) {
+                esp_mjpeg_player_input_done(player, &input);
+                break;
+            }
+
+            const int64_t decode_start = esp_timer_get_time();
+            const esp_err_t ret = esp_mjpeg_player_decode(player, &input, frame);
+            const uint32_t decode_us = (uint32_t)(esp_timer_get_time() - decode_start);
+            esp_mjpeg_player_input_done(player, &input);
+            if (ret != ESP_OK) {
+                xQueueSend(player->free_frames, &frame, 0);
+                portENTER_CRITICAL(&player->stats_lock);
+                player->stats.decode_errors++;
+                portEXIT_CRITICAL(&player->stats_lock);
+                continue;
+            }
+
+            /* Present at the frame time */
+            now = esp_timer_get_time();
+            if (frame_time - now >= portTICK_PERIOD_MS * 1000) {
+                vTaskDelay((frame_time - now) / (portTICK_PERIOD_MS * 1000));
+                now = esp_timer_get_time();
+            }
+            const bool presented = (lvgl_port_video_push(player->video, frame, frame) == ESP_OK);
+
+            portENTER_CRITICAL(&player->stats_lock);
+            player->decode_sum_us += decode_us;
+            player->decoded++;
+            player->stats.max_decode_us = MAX(player->stats.max_decode_us, decode_us);
+            if (presented) {
+                player->stats.frames_presented++;
+                player->stats.max_present_late_us = MAX(player->stats.max_present_late_us, (uint32_t)MAX(now - frame_time, 0));
+            } else {
+                player->stats.frames_dropped++;
+            }
+            portEXIT_CRITICAL(&player->stats_lock);
+        }
+
+        /* Stopped reader does not use the file */
+        player->stop = true;
+        xEventGroupWaitBits(player->events, MJPEG_PLAYER_READER_IDLE, pdFALSE, pdTRUE, portMAX_DELAY);
+        xSemaphoreTake(player->live_lock, portMAX_DELAY);
+        player->live = false;
+        esp_mjpeg_player_input_t input;
+        while (xQueueReceive(player->read_inputs, &input, 0) == pdTRUE) {
+            esp_mjpeg_player_input_done(player, &input);
+        }
+        xSemaphoreGive(player->live_lock);
+        if (player->file) {
+            fclose(player->file);
+            player->file = NULL;
+        }
+        xEventGroupSetBits(player->events, MJPEG_PLAYER_DECODER_IDLE);
+
+        if (player->done_cb) {
+            player->done_cb(player, player->user_ctx);
+        }
+    }
+
+    xEventGroupSetBits(player->events, MJPEG_PLAYER_DECODER_EXITED);
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,199 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief MJPEG/AVI video player for esp_lvgl_port video layer
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief MJPEG player handle
+ */
+typedef struct esp_mjpeg_player_s *esp_mjpeg_player_handle_t;
+
+/**
+ * @brief Callback called from decoder task, when the playback ends or it is stopped
+ *
+ * @note The player is idle already, when it is called. It must not call esp_mjpeg_player_del.
+ */
+typedef void (*esp_mjpeg_player_done_cb_t)(esp_mjpeg_player_handle_t player, void *user_ctx);
+
+/**
+ * @brief Callback called from decoder task (or esp_mjpeg_player_stream_push), when the pushed frame is not used anymore
+ *
+ * @param data      JPEG data passed to esp_mjpeg_player_stream_push
+ * @param user_ctx  release context passed to esp_mjpeg_player_stream_push
+ */
+typedef void (*esp_mjpeg_player_release_cb_t)(const uint8_t *data, void *user_ctx);
+
+/**
+ * @brief Configuration of the MJPEG player
+ */
+typedef struct {
+    lv_display_t             *disp;         /*!< LVGL display (returned from lvgl_port_add_disp or BSP) */
+    uint32_t                 hres;          /*!< Horizontal resolution of the video (multiple of 16 on ESP32-P4) */
+    uint32_t                 vres;          /*!< Vertical resolution of the video (multiple of 16 on ESP32-P4) */
+    int32_t                  x;             /*!< Position of the video on the LCD */
+    int32_t                  y;
+    uint32_t                 fps;           /*!< Frame rate of raw MJPEG files and AVI files without header (0: 25) */
+    size_t                   max_frame_size; /*!< Size of one input buffer, the biggest JPEG frame in bytes (0: 64 kB) */
+    uint8_t                  frame_buffers; /*!< Number of decoded RGB565 frames (0: 3), one is shown, one is transferred and one is decoded */
+    UBaseType_t              reader_priority; /*!< Priority of the reader task (0: 5) */
+    UBaseType_t              decoder_priority; /*!< Priority of the decoder task (0: 6) */
+    esp_mjpeg_player_done_cb_t done_cb;     /*!< Callback called, when the playback ends (optional) */
+    void                     *user_ctx;     /*!< User context of the done callback */
+    struct {
+        unsigned int swap_bytes: 1;     /*!< Decode RGB565 in big-endian byte order (SPI/I8080 LCDs, only for esp_jpeg decoder) */
+        unsigned int buff_spiram: 1;    /*!< Allocate frame and input buffers in PSRAM */
+        unsigned int stream_only: 1;    /*!< Only live streams are played, the reader task and input buffers are not created */
+    } flags;
+} esp_mjpeg_player_config_t;
+
+/**
+ * @brief Playback statistics
+ */
+typedef struct {
+    uint32_t frames_presented;  /*!< Frames sent to the video layer */
+    uint32_t frames_dropped;    /*!< Frames skipped without decoding, because they were late more than one frame period (or replaced by a newer pushed frame) */
+    uint32_t decode_errors;     /*!< Frames, which were too big for the input buffer or failed to decode */
+    uint32_t avg_decode_us;     /*!< Average decoding time of one frame in microseconds */
+    uint32_t max_decode_us;     /*!< Longest decoding time of one frame in microseconds */
+    uint32_t max_read_us;       /*!< Longest file read of one frame in microseconds */
+    uint32_t max_present_late_us; /*!< Highest delay of the presentation after the frame time (after the push of stream frames) in microseconds */
+} esp_mjpeg_player_stats_t;
+
+/**
+ * @brief Create MJPEG player
+ *
+ * The reader task reads JPEG frames from the file into two input buffers. The decoder task decodes them into rotating
+ * RGB565 frame buffers (hardware JPEG decoder on ESP32-P4, esp_jpeg on other chips) and sends each frame at its time
+ * directly to the LCD by esp_lvgl_port video layer (without LVGL rendering). Late frames are dropped before decoding.
+ *
+ * @note Video layer of esp_lvgl_port requires LVGL 9.1 or newer and display added by lvgl_port_add_disp (or RGB/MIPI-DSI display).
+ *
+ * @param config     player configuration
+ * @param ret_player output player handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if configuration is wrong
+ *      - ESP_ERR_INVALID_SIZE      if the resolution is not supported by the hardware JPEG decoder
+ *      - ESP_ERR_NOT_SUPPORTED     if the display does not support the direct video layer
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_mjpeg_player_new(const esp_mjpeg_player_config_t *config, esp_mjpeg_player_handle_t *ret_player);
+
+/**
+ * @brief Start playing MJPEG file
+ *
+ * Raw MJPEG files (concatenated JPEG images) and AVI files with MJPEG video stream are supported.
+ * The previous playback is stopped. This function does not wait for the end of the playback.
+ *
+ * @param player     player handle
+ * @param path       path of the file (e.g. on SD card mounted by bsp_sdcard_mount)
+ * @param repeat     play the file repeatedly until esp_mjpeg_player_stop
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NOT_SUPPORTED     if the player was created with stream_only flag
+ *      - ESP_ERR_NOT_FOUND         if the file cannot be opened
+ *      - ESP_ERR_INVALID_RESPONSE  if the AVI file has no video stream or its resolution differs from the player
+ */
+esp_err_t esp_mjpeg_player_play(esp_mjpeg_player_handle_t player, const char *path, bool repeat);
+
+/**
+ * @brief Start playing a live stream of JPEG frames (e.g. from USB camera)
+ *
+ * The previous playback is stopped. Frames pushed by esp_mjpeg_player_stream_push are decoded directly from the memory
+ * of the producer (without a copy) and shown as soon as they are decoded, until esp_mjpeg_player_stop.
+ *
+ * @param player     player handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_mjpeg_player_stream_start(esp_mjpeg_player_handle_t player);
+
+/**
+ * @brief Push one JPEG frame of live stream
+ *
+ * It does not block. Up to two pushed frames wait for the decoder, when a frame is pushed into full queue, the oldest
+ * waiting frame is dropped (its release_cb is called from this function). So the producer must be able to hold three
+ * frames at least (two waiting and one being decoded).
+ *
+ * @note On ESP32-P4, the data must be accessible by DMA of the hardware JPEG decoder (internal RAM or PSRAM).
+ *
+ * @param player      player handle
+ * @param data        JPEG frame of player resolution, it must stay valid until release_cb is called
+ * @param len         length of the frame in bytes
+ * @param release_cb  called, when the frame is not used anymore
+ * @param release_ctx user context of release_cb
+ * @return
+ *      - ESP_OK                    on success, release_cb will be called
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the stream is not playing, the frame stays owned by the caller
+ */
+esp_err_t esp_mjpeg_player_stream_push(esp_mjpeg_player_handle_t player, const uint8_t *data, size_t len,
+                                       esp_mjpeg_player_release_cb_t release_cb, void *release_ctx);
+
+/**
+ * @brief Stop playing
+ *
+ * @note It waits until the reader and decoder tasks are idle (one frame at most). The last frame stays on the LCD.
+ *
+ * @param player     player handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_mjpeg_player_stop(esp_mjpeg_player_handle_t player);
+
+/**
+ * @brief Check, if the file is playing
+ *
+ * @param player     player handle
+ * @return true, if the file is playing
+ */
+bool esp_mjpeg_player_is_playing(esp_mjpeg_player_handle_t player);
+
+/**
+ * @brief Get playback statistics
+ *
+ * @param player     player handle
+ * @param stats      output statistics
+ * @param reset      reset the statistics after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_mjpeg_player_get_stats(esp_mjpeg_player_handle_t player, esp_mjpeg_player_stats_t *stats, bool reset);
+
+/**
+ * @brief Delete MJPEG player
+ *
+ * @note The playback is stopped and the video layer is deleted. It waits until LVGL task releases all frame buffers.
+ *
+ * @param player     player handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_mjpeg_player_del(esp_mjpeg_player_handle_t player);
+
+#ifdef __cplusplus
+}
+#endif
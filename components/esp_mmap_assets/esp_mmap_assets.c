@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_mmap_assets.h"
+
+static const char *TAG = "mmap_assets";
+
+#define ESP_MMAP_ASSETS_VERSION (1)
+
+struct esp_mmap_assets_s {
+    esp_partition_mmap_handle_t mmap_handle;
+    const uint8_t *base;
+    const esp_mmap_assets_entry_t *index;
+    size_t count;
+};
+
+static void esp_mmap_assets_fill(const struct esp_mmap_assets_s *assets, const esp_mmap_assets_entry_t *entry, esp_mmap_asset_t *asset)
+{
+    asset->name = entry->name;
+    asset->data = assets->base + entry->offset;
+    asset->size = entry->size;
+    asset->format = (esp_mmap_asset_format_t)entry->format;
+    asset->width = entry->width;
+    asset->height = entry->height;
+}
+
+esp_err_t esp_mmap_assets_new(const char *partition_label, esp_mmap_assets_handle_t *ret_assets)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(partition_label && ret_assets, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, partition_label);
+    ESP_RETURN_ON_FALSE(partition, ESP_ERR_NOT_FOUND, TAG, "Partition %s not found", partition_label);
+
+    /* The header is read first, not to map a partition of other content */
+    esp_mmap_assets_header_t header;
+    ESP_RETURN_ON_ERROR(esp_partition_read(partition, 0, &header, sizeof(header)), TAG, "Read header failed");
+    ESP_RETURN_ON_FALSE(header.magic == ESP_MMAP_ASSETS_MAGIC && header.version == ESP_MMAP_ASSETS_VERSION,
+                        ESP_ERR_INVALID_VERSION, TAG, "No assets in partition %s", partition_label);
+    ESP_RETURN_ON_FALSE(sizeof(header) + header.count * sizeof(esp_mmap_assets_entry_t) <= partition->size,
+                        ESP_ERR_INVALID_SIZE, TAG, "Index exceeds partition");
+
+    struct esp_mmap_assets_s *assets = calloc(1, sizeof(struct esp_mmap_assets_s));
+    ESP_RETURN_ON_FALSE(assets, ESP_ERR_NO_MEM, TAG, "Not enough memory for assets");
+
+    const void *base = NULL;
+    ESP_GOTO_ON_ERROR(esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &base, &assets->mmap_handle),
+                      err, TAG, "Mapping of partition failed");
+    assets->base = base;
+    assets->index = (const esp_mmap_assets_entry_t *)(assets->base + sizeof(header));
+    assets->count = header.count;
+
+    for (size_t i = 0; i < assets->count; i++) {
+        const esp_mmap_assets_entry_t *entry = &assets->index[i];
+        ESP_GOTO_ON_FALSE(memchr(entry->name, '\0', ESP_MMAP_ASSETS_NAME_LEN), ESP_ERR_INVALID_SIZE, unmap, TAG, "Name %zu too long", i);
+        ESP_GOTO_ON_FALSE(entry->offset <= partition->size && entry->size <= partition->size - entry->offset,
+                          ESP_ERR_INVALID_SIZE, unmap, TAG, "Asset %s exceeds partition", entry->name);
+    }
+
+    ESP_LOGD(TAG, "Mapped %zu assets of %s", assets->count, partition_label);
+    *ret_assets = assets;
+    return ESP_OK;
+
+unmap:
+    esp_partition_munmap(assets->mmap_handle);
+err:
+    free(assets);
+    return ret;
+}
+
+esp_err_t esp_mmap_assets_del(esp_mmap_assets_handle_t assets)
+{
+    ESP_RETURN_ON_FALSE(assets, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    esp_partition_munmap(assets->mmap_handle);
+    free(assets);
+    return ESP_OK;
+}
+
+size_t esp_mmap_assets_get_count(esp_mmap_assets_handle_t assets)
+{
+    return assets ? assets->count : 0;
+}
+
+esp_err_t esp_mmap_assets_get(esp_mmap_assets_handle_t assets, size_t index, esp_mmap_asset_t *asset)
+{
+    ESP_RETURN_ON_FALSE(assets && asset && index < assets->count, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    esp_mmap_assets_fill(assets, &assets->index[index], asset);
+    return ESP_OK;
+}
+
+esp_err_t esp_mmap_assets_find(esp_mmap_assets_handle_t assets, const char *name, esp_mmap_asset_t *asset)
+{
+    ESP_RETURN_ON_FALSE(assets && name && asset, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+
+    size_t low = 0;
+    size_t high = assets->count;
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const int cmp = strncmp(name, assets->index[mid].name, ESP_MMAP_ASSETS_NAME_LEN);
+        if (cmp == 0) {
+            esp_mmap_assets_fill(assets, &assets->index[mid], asset);
+            return ESP_OK;
+        } else if (cmp < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Read-only assets memory-mapped from a flash partition
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_MMAP_ASSETS_MAGIC       (0x54535341)    /*!< "ASST" at the start of the partition */
+#define ESP_MMAP_ASSETS_NAME_LEN    (24)            /*!< Maximal length of asset name including the terminating zero */
+
+/**
+ * @brief Format of asset (informative, the data are not converted)
+ */
+typedef enum {
+    ESP_MMAP_ASSET_FORMAT_RAW = 0,      /*!< Any data */
+    ESP_MMAP_ASSET_FORMAT_RGB565,       /*!< RGB565 pixels, width * height * 2 bytes */
+    ESP_MMAP_ASSET_FORMAT_RGB565A8,     /*!< RGB565 pixels followed by 8-bit alpha of each pixel */
+    ESP_MMAP_ASSET_FORMAT_JPEG,         /*!< JPEG file */
+    ESP_MMAP_ASSET_FORMAT_PNG,          /*!< PNG file */
+    ESP_MMAP_ASSET_FORMAT_FONT,         /*!< Font file (e.g. TTF for LVGL Tiny TTF) */
+    ESP_MMAP_ASSET_FORMAT_WAV,          /*!< WAV file */
+} esp_mmap_asset_format_t;
+
+/**
+ * @brief Index entry in the partition, little endian
+ *
+ * The partition starts with the header (magic, version, number of entries), the index follows and then the data.
+ */
+typedef struct __attribute__((packed)) {
+    char name[ESP_MMAP_ASSETS_NAME_LEN];    /*!< Zero terminated name */
+    uint32_t offset;                        /*!< Offset of the data from the start of the partition, 4-byte aligned */
+    uint32_t size;                          /*!< Size of the data in bytes */
+    uint8_t format;                         /*!< esp_mmap_asset_format_t */
+    uint8_t reserved[3];                    /*!< Zero */
+    uint16_t width;                         /*!< Width of image, 0 for other formats */
+    uint16_t height;                        /*!< Height of image, 0 for other formats */
+} esp_mmap_assets_entry_t;
+
+/**
+ * @brief Header of the partition, little endian
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;     /*!< ESP_MMAP_ASSETS_MAGIC */
+    uint16_t version;   /*!< Format version, 1 */
+    uint16_t count;     /*!< Number of index entries */
+} esp_mmap_assets_header_t;
+
+/**
+ * @brief One asset, the data are in the mapped flash
+ */
+typedef struct {
+    const char *name;                   /*!< Name (in the mapped flash) */
+    const void *data;                   /*!< Data (in the mapped flash) */
+    size_t size;                        /*!< Size of the data in bytes */
+    esp_mmap_asset_format_t format;     /*!< Format of the data */
+    uint16_t width;                     /*!< Width of image */
+    uint16_t height;                    /*!< Height of image */
+} esp_mmap_asset_t;
+
+/**
+ * @brief Handle of mapped assets
+ */
+typedef struct esp_mmap_assets_s *esp_mmap_assets_handle_t;
+
+/**
+ * @brief Map assets partition
+ *
+ * The whole partition is mapped to the data address space by esp_partition_mmap() and the index is validated.
+ * The data stay valid until esp_mmap_assets_del().
+ *
+ * @note The partition must be created by tools/pack_assets.py.
+ *
+ * @param[in]  partition_label Label of the data partition
+ * @param[out] ret_assets      Handle of mapped assets
+ * @return
+ *      - ESP_OK                On success
+ *      - ESP_ERR_INVALID_ARG   NULL pointer
+ *      - ESP_ERR_NOT_FOUND     Partition not found
+ *      - ESP_ERR_INVALID_VERSION Wrong magic or version of the partition
+ *      - ESP_ERR_INVALID_SIZE  Index or some asset exceeds the partition
+ *      - ESP_ERR_NO_MEM        No memory for the handle or no free MMU pages
+ */
+esp_err_t esp_mmap_assets_new(const char *partition_label, esp_mmap_assets_handle_t *ret_assets);
+
+/**
+ * @brief Unmap assets partition
+ *
+ * @param[in] assets Handle of mapped assets
+ * @return
+ *      - ESP_OK              On success
+ *      - ESP_ERR_INVALID_ARG NULL pointer
+ */
+esp_err_t esp_mmap_assets_del(esp_mmap_assets_handle_t assets);
+
+/**
+ * @brief Get number of assets
+ *
+ * @param[in] assets Handle of mapped assets
+ * @return Number of assets, 0 for NULL handle
+ */
+size_t esp_mmap_assets_get_count(esp_mmap_assets_handle_t assets);
+
+/**
+ * @brief Get asset by index
+ *
+ * @param[in]  assets Handle of mapped assets
+ * @param[in]  index  Index of the asset from 0 to esp_mmap_assets_get_count() - 1
+ * @param[out] asset  Asset
+ * @return
+ *      - ESP_OK              On success
+ *      - ESP_ERR_INVALID_ARG NULL pointer or index out of range
+ */
+esp_err_t esp_mmap_assets_get(esp_mmap_assets_handle_t assets, size_t index, esp_mmap_asset_t *asset);
+
+/**
+ * @brief Find asset by name
+ *
+ * The index is sorted by name, the asset is found by binary search.
+ *
+ * @param[in]  assets Handle of mapped assets
+ * @param[in]  name   Name of the asset
+ * @param[out] asset  Asset
+ * @return
+ *      - ESP_OK              On success
+ *      - ESP_ERR_INVALID_ARG NULL pointer
+ *      - ESP_ERR_NOT_FOUND   No asset of this name
+ */
+esp_err_t esp_mmap_assets_find(esp_mmap_assets_handle_t assets, const char *name, esp_mmap_asset_t *asset);
+
+#ifdef __cplusplus
+}
+#endif
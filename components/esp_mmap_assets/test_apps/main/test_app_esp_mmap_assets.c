@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_partition.h"
+#include "esp_mmap_assets.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#define TEST_PARTITION      "assets"
+#define TEST_ASSET_NUM      (3)
+
+/* Image of the partition as made by tools/pack_assets.py: header, index sorted by name, 4-byte aligned data */
+typedef struct __attribute__((packed)) {
+    esp_mmap_assets_header_t header;
+    esp_mmap_assets_entry_t index[TEST_ASSET_NUM];
+    uint8_t data[64];
+} test_image_t;
+
+static const uint8_t test_pixels[2 * 3 * 2] = {0x00, 0xf8, 0xe0, 0x07, 0x1f, 0x00, 0xff, 0xff, 0x00, 0x00, 0x55, 0xaa};
+static const char test_text[] = "hello";
+
+static void test_image_init(test_image_t *image)
+{
+    memset(image, 0, sizeof(test_image_t));
+    image->header.magic = ESP_MMAP_ASSETS_MAGIC;
+    image->header.version = 1;
+    image->header.count = TEST_ASSET_NUM;
+
+    const uint32_t data_offset = offsetof(test_image_t, data);
+    strcpy(image->index[0].name, "a.bin");
+    image->index[0].offset = data_offset;
+    image->index[0].size = sizeof(test_text);
+    image->index[0].format = ESP_MMAP_ASSET_FORMAT_RAW;
+    memcpy(&image->data[0], test_text, sizeof(test_text));
+
+    strcpy(image->index[1].name, "icon.rgb565");
+    image->index[1].offset = data_offset + 8;
+    image->index[1].size = sizeof(test_pixels);
+    image->index[1].format = ESP_MMAP_ASSET_FORMAT_RGB565;
+    image->index[1].width = 3;
+    image->index[1].height = 2;
+    memcpy(&image->data[8], test_pixels, sizeof(test_pixels));
+
+    strcpy(image->index[2].name, "z.bin");
+    image->index[2].offset = data_offset + 20;
+    image->index[2].size = 0;
+    image->index[2].format = ESP_MMAP_ASSET_FORMAT_RAW;
+}
+
+static void test_image_write(const test_image_t *image)
+{
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, TEST_PARTITION);
+    TEST_ASSERT_NOT_NULL(partition);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_partition_erase_range(partition, 0, partition->erase_size));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_partition_write(partition, 0, image, sizeof(test_image_t)));
+}
+
+TEST_CASE("Assets are found by name and index", "[mmap_assets]")
+{
+    test_image_t image;
+    test_image_init(&image);
+    test_image_write(&image);
+
+    esp_mmap_assets_handle_t assets = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mmap_assets_new(TEST_PARTITION, &assets));
+    TEST_ASSERT_EQUAL(TEST_ASSET_NUM, esp_mmap_assets_get_count(assets));
+
+    esp_mmap_asset_t asset;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mmap_assets_find(assets, "icon.rgb565", &asset));
+    TEST_ASSERT_EQUAL_STRING("icon.rgb565", asset.name);
+    TEST_ASSERT_EQUAL(ESP_MMAP_ASSET_FORMAT_RGB565, asset.format);
+    TEST_ASSERT_EQUAL(3, asset.width);
+    TEST_ASSERT_EQUAL(2, asset.height);
+    TEST_ASSERT_EQUAL(sizeof(test_pixels), asset.size);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(test_pixels, asset.data, sizeof(test_pixels));
+
+    /* Both ends of the binary search */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mmap_assets_find(assets, "a.bin", &asset));
+    TEST_ASSERT_EQUAL_STRING(test_text, asset.data);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mmap_assets_find(assets, "z.bin", &asset));
+    TEST_ASSERT_EQUAL(0, asset.size);
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_mmap_assets_find(assets, "b.bin", &asset));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_mmap_assets_find(assets, "", &asset));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mmap_assets_get(assets, 1, &asset));
+    TEST_ASSERT_EQUAL_STRING("icon.rgb565", asset.name);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_mmap_assets_get(assets, TEST_ASSET_NUM, &asset));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mmap_assets_del(assets));
+}
+
+TEST_CASE("Invalid partitions are not mapped", "[mmap_assets]")
+{
+    esp_mmap_assets_handle_t assets = NULL;
+    test_image_t image;
+
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_mmap_assets_new("missing", &assets));
+
+    /* Other content */
+    test_image_init(&image);
+    image.header.magic = 0xffffffff;
+    test_image_write(&image);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_VERSION, esp_mmap_assets_new(TEST_PARTITION, &assets));
+
+    test_image_init(&image);
+    image.header.version = 2;
+    test_image_write(&image);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_VERSION, esp_mmap_assets_new(TEST_PARTITION, &assets));
+
+    /* Index or data out of the partition */
+    test_image_init(&image);
+    image.header.count = 0xffff;
+    test_image_write(&image);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_mmap_assets_new(TEST_PARTITION, &assets));
+
+    test_image_init(&image);
+    image.index[1].size = 0xfffffff0;
+    test_image_write(&image);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_mmap_assets_new(TEST_PARTITION, &assets));
+
+    /* Name without terminating zero */
+    test_image_init(&image);
+    memset(image.index[0].name, 'a', ESP_MMAP_ASSETS_NAME_LEN);
+    test_image_write(&image);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, esp_mmap_assets_new(TEST_PARTITION, &assets));
+
+    TEST_ASSERT_NULL(assets);
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (200)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
@@ -0,0 +1,112 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+"""
+Pack files of a directory to an image of esp_mmap_assets partition.
+
+Usage: pack_assets.py <input_dir> <output.bin> [--size <partition size>]
+
+Format is given by extension: .jpg/.jpeg, .png, .ttf/.otf, .wav, .rgb565 and .rgb565a8,
+other files are raw. Width and height are read from JPEG and PNG headers,
+raw pixel files must be named <name>_<width>x<height>.rgb565(a8).
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x54535341
+VERSION = 1
+NAME_LEN = 24
+ENTRY = struct.Struct('<24sIIB3xHH')
+HEADER = struct.Struct('<IHH')
+
+FORMATS = {
+    '.rgb565': 1,
+    '.rgb565a8': 2,
+    '.jpg': 3,
+    '.jpeg': 3,
+    '.png': 4,
+    '.ttf': 5,
+    '.otf': 5,
+    '.wav': 6,
+}
+
+
+def png_size(data):
+    if data[:8] == b'\x89PNG\r\n\x1a\n':
+        return struct.unpack('>II', data[16:24])
+    return 0, 0
+
+
+def jpeg_size(data):
+    i = 2
+    while i + 9 < len(data):
+        if data[i] != 0xFF:
+            break
+        marker = data[i + 1]
+        length = struct.unpack('>H', data[i + 2:i + 4])[0]
+        if marker in (0xC0, 0xC1, 0xC2):
+            h, w = struct.unpack('>HH', data[i + 5:i + 9])
+            return w, h
+        i += 2 + length
+    return 0, 0
+
+
+def image_size(name, fmt, data):
+    if fmt == 3:
+        return jpeg_size(data)
+    if fmt == 4:
+        return png_size(data)
+    if fmt in (1, 2):
+        m = re.search(r'_(\d+)x(\d+)\.[^.]+$', name)
+        if not m:
+            sys.exit('{}: raw image name must end with _<width>x<height>'.format(name))
+        return int(m.group(1)), int(m.group(2))
+    return 0, 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('input_dir')
+    parser.add_argument('output')
+    parser.add_argument('--size', type=lambda x: int(x, 0), default=0, help='Partition size, the image is padded by 0xFF')
+    args = parser.parse_args()
+
+    files = []
+    for name in os.listdir(args.input_dir):
+        path = os.path.join(args.input_dir, name)
+        if os.path.isfile(path):
+            if len(name.encode()) >= NAME_LEN:
+                sys.exit('{}: name longer than {} bytes'.format(name, NAME_LEN - 1))
+            files.append((name.encode(), path))
+    # The firmware finds assets by binary search
+    files.sort()
+
+    offset = HEADER.size + ENTRY.size * len(files)
+    index = b''
+    blobs = b''
+    for name, path in files:
+        with open(path, 'rb') as f:
+            data = f.read()
+        offset = (offset + 3) & ~3
+        blobs += b'\xff' * (offset - HEADER.size - ENTRY.size * len(files) - len(blobs))
+        fmt = FORMATS.get(os.path.splitext(name.decode())[1].lower(), 0)
+        w, h = image_size(name.decode(), fmt, data)
+        index += ENTRY.pack(name, offset, len(data), fmt, w, h)
+        blobs += data
+        offset += len(data)
+
+    image = HEADER.pack(MAGIC, VERSION, len(files)) + index + blobs
+    if args.size:
+        if len(image) > args.size:
+            sys.exit('Assets of {} bytes do not fit to partition of {} bytes'.format(len(image), args.size))
+        image += b'\xff' * (args.size - len(image))
+    with open(args.output, 'wb') as f:
+        f.write(image)
+    print('Packed {} assets, {} bytes'.format(len(files), len(image)))
+
+
+if __name__ == '__main__':
+    main()
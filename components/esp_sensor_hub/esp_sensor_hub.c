@@ -0,0 +1,401 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_sensor_hub.h"
+
+static const char *TAG = "SENSOR_HUB";
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef enum {
+    SENSOR_STATE_IDLE,          /* Waiting for the next period (next_start) */
+    SENSOR_STATE_CONVERTING,    /* Waiting for the result (ready_time) */
+} sensor_state_t;
+
+typedef struct {
+    esp_sensor_hub_sensor_config_t config;
+    sensor_state_t state;
+    int64_t next_start;         /* Start of the next sample [us] */
+    int64_t ready_time;         /* Time of the next read [us] */
+    esp_sensor_hub_data_t data; /* Sample in progress */
+    esp_sensor_hub_sensor_stats_t stats;
+} sensor_t;
+
+struct esp_sensor_hub_sub_s {
+    uint32_t sensor_mask;
+    uint32_t size_mask;         /* Size of ring buffer - 1 */
+    atomic_uint head;           /* Written only by the hub task */
+    atomic_uint tail;           /* Written only by the subscriber */
+    atomic_uint dropped;
+    SemaphoreHandle_t signal;   /* Given after every new sample */
+    esp_sensor_hub_data_t *buf;
+};
+
+struct esp_sensor_hub_s {
+    esp_sensor_hub_config_t config;
+    portMUX_TYPE lock;          /* Lock of sensor statistics */
+    sensor_t *sensors;
+    uint8_t sensor_num;
+    esp_sensor_hub_sub_handle_t *subs;
+    uint8_t sub_num;
+    TaskHandle_t task;          /* NULL: stopped */
+    volatile bool stop;
+    SemaphoreHandle_t stopped;  /* Given by the task before exit */
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void sensor_hub_task(void *arg);
+static void sensor_hub_process(esp_sensor_hub_handle_t hub, sensor_t *sensor, int64_t now);
+static void sensor_hub_finish(esp_sensor_hub_handle_t hub, sensor_t *sensor, esp_err_t err, int64_t now);
+static void sensor_hub_publish(esp_sensor_hub_handle_t hub, const esp_sensor_hub_data_t *data);
+static void sensor_hub_sub_free(esp_sensor_hub_sub_handle_t sub);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_sensor_hub_new(const esp_sensor_hub_config_t *config, esp_sensor_hub_handle_t *ret_hub)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_hub, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->max_sensors > 0 && config->max_sensors <= ESP_SENSOR_HUB_SENSORS_MAX, ESP_ERR_INVALID_ARG, TAG, "invalid max_sensors");
+
+    esp_sensor_hub_handle_t hub = calloc(1, sizeof(struct esp_sensor_hub_s));
+    ESP_RETURN_ON_FALSE(hub, ESP_ERR_NO_MEM, TAG, "Not enough memory for sensor hub");
+    hub->config = *config;
+    portMUX_INITIALIZE(&hub->lock);
+
+    hub->sensors = calloc(config->max_sensors, sizeof(sensor_t));
+    hub->subs = calloc(config->max_subscribers ? config->max_subscribers : 1, sizeof(esp_sensor_hub_sub_handle_t));
+    hub->stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(hub->sensors && hub->subs && hub->stopped, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for sensor hub");
+
+    *ret_hub = hub;
+    return ESP_OK;
+
+err:
+    esp_sensor_hub_del(hub);
+    return ret;
+}
+
+esp_err_t esp_sensor_hub_del(esp_sensor_hub_handle_t hub)
+{
+    ESP_RETURN_ON_FALSE(hub, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    if (hub->task) {
+        esp_sensor_hub_stop(hub);
+    }
+    for (int i = 0; i < hub->sub_num; i++) {
+        sensor_hub_sub_free(hub->subs[i]);
+    }
+    if (hub->stopped) {
+        vSemaphoreDelete(hub->stopped);
+    }
+    free(hub->subs);
+    free(hub->sensors);
+    free(hub);
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_hub_add_sensor(esp_sensor_hub_handle_t hub, const esp_sensor_hub_sensor_config_t *config, uint8_t *ret_id)
+{
+    ESP_RETURN_ON_FALSE(hub && config && ret_id, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->ops && config->ops->read && config->period_ms > 0, ESP_ERR_INVALID_ARG, TAG, "invalid sensor config");
+    ESP_RETURN_ON_FALSE(hub->task == NULL, ESP_ERR_INVALID_STATE, TAG, "Hub is running");
+    ESP_RETURN_ON_FALSE(hub->sensor_num < hub->config.max_sensors, ESP_ERR_NO_MEM, TAG, "Too many sensors");
+
+    sensor_t *sensor = &hub->sensors[hub->sensor_num];
+    memset(sensor, 0, sizeof(sensor_t));
+    sensor->config = *config;
+
+    *ret_id = hub->sensor_num++;
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_hub_subscribe(esp_sensor_hub_handle_t hub, uint32_t sensor_mask, size_t queue_len, esp_sensor_hub_sub_handle_t *ret_sub)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(hub && ret_sub && sensor_mask && queue_len > 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(hub->task == NULL, ESP_ERR_INVALID_STATE, TAG, "Hub is running");
+    ESP_RETURN_ON_FALSE(hub->sub_num < hub->config.max_subscribers, ESP_ERR_NO_MEM, TAG, "Too many subscribers");
+
+    /* Power of two size, indexes are masked */
+    size_t size = 1;
+    while (size < queue_len) {
+        size <<= 1;
+    }
+
+    esp_sensor_hub_sub_handle_t sub = calloc(1, sizeof(struct esp_sensor_hub_sub_s));
+    ESP_RETURN_ON_FALSE(sub, ESP_ERR_NO_MEM, TAG, "Not enough memory for subscriber");
+    sub->sensor_mask = sensor_mask;
+    sub->size_mask = size - 1;
+    atomic_init(&sub->head, 0);
+    atomic_init(&sub->tail, 0);
+    atomic_init(&sub->dropped, 0);
+    sub->buf = calloc(size, sizeof(esp_sensor_hub_data_t));
+    sub->signal = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(sub->buf && sub->signal, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for subscriber");
+
+    hub->subs[hub->sub_num++] = sub;
+    *ret_sub = sub;
+    return ESP_OK;
+
+err:
+    sensor_hub_sub_free(sub);
+    return ret;
+}
+
+esp_err_t esp_sensor_hub_unsubscribe(esp_sensor_hub_handle_t hub, esp_sensor_hub_sub_handle_t sub)
+{
+    ESP_RETURN_ON_FALSE(hub && sub, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(hub->task == NULL, ESP_ERR_INVALID_STATE, TAG, "Hub is running");
+
+    int i = 0;
+    while (i < hub->sub_num && hub->subs[i] != sub) {
+        i++;
+    }
+    ESP_RETURN_ON_FALSE(i < hub->sub_num, ESP_ERR_NOT_FOUND, TAG, "Subscriber not found");
+
+    /* Slot is free for the next subscriber */
+    memmove(&hub->subs[i], &hub->subs[i + 1], (hub->sub_num - i - 1) * sizeof(esp_sensor_hub_sub_handle_t));
+    hub->sub_num--;
+    sensor_hub_sub_free(sub);
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_hub_start(esp_sensor_hub_handle_t hub)
+{
+    ESP_RETURN_ON_FALSE(hub, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(hub->task == NULL, ESP_ERR_INVALID_STATE, TAG, "Hub is running");
+
+    const int64_t now = esp_timer_get_time();
+    for (int i = 0; i < hub->sensor_num; i++) {
+        hub->sensors[i].state = SENSOR_STATE_IDLE;
+        hub->sensors[i].next_start = now;
+    }
+
+    hub->stop = false;
+    BaseType_t res;
+    if (hub->config.task_affinity < 0) {
+        res = xTaskCreate(sensor_hub_task, "sensor_hub", hub->config.task_stack, hub, hub->config.task_priority, &hub->task);
+    } else {
+        res = xTaskCreatePinnedToCore(sensor_hub_task, "sensor_hub", hub->config.task_stack, hub, hub->config.task_priority, &hub->task,
+                                      hub->config.task_affinity);
+    }
+    if (res != pdPASS) {
+        hub->task = NULL;
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_NO_MEM, TAG, "Create sensor hub task fail!");
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_hub_stop(esp_sensor_hub_handle_t hub)
+{
+    ESP_RETURN_ON_FALSE(hub, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(hub->task, ESP_ERR_INVALID_STATE, TAG, "Hub is not running");
+
+    hub->stop = true;
+    xTaskNotifyGive(hub->task);
+    xSemaphoreTake(hub->stopped, portMAX_DELAY);
+    hub->task = NULL;
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_hub_receive(esp_sensor_hub_sub_handle_t sub, esp_sensor_hub_data_t *data, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(sub && data, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t timeout = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    while (true) {
+        const unsigned int tail = atomic_load_explicit(&sub->tail, memory_order_relaxed);
+        const unsigned int head = atomic_load_explicit(&sub->head, memory_order_acquire);
+        if (tail != head) {
+            *data = sub->buf[tail & sub->size_mask];
+            atomic_store_explicit(&sub->tail, tail + 1, memory_order_release);
+            return ESP_OK;
+        }
+
+        /* Signal may be left from a sample already read, the buffer is checked again after every wake up */
+        TickType_t wait = portMAX_DELAY;
+        if (timeout != portMAX_DELAY) {
+            const TickType_t elapsed = xTaskGetTickCount() - start;
+            if (elapsed >= timeout) {
+                return ESP_ERR_TIMEOUT;
+            }
+            wait = timeout - elapsed;
+        }
+        if (xSemaphoreTake(sub->signal, wait) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+}
+
+uint32_t esp_sensor_hub_get_dropped(esp_sensor_hub_sub_handle_t sub)
+{
+    assert(sub);
+    return atomic_load(&sub->dropped);
+}
+
+esp_err_t esp_sensor_hub_get_stats(esp_sensor_hub_handle_t hub, uint8_t sensor_id, esp_sensor_hub_sensor_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE(hub && stats && sensor_id < hub->sensor_num, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&hub->lock);
+    *stats = hub->sensors[sensor_id].stats;
+    portEXIT_CRITICAL(&hub->lock);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void sensor_hub_task(void *arg)
+{
+    esp_sensor_hub_handle_t hub = (esp_sensor_hub_handle_t) arg;
+
+    while (!hub->stop) {
+        /* Earliest deadline first, every sensor waits either for its period or for its conversion */
+        sensor_t *next = NULL;
+        int64_t next_time = INT64_MAX;
+        for (int i = 0; i < hub->sensor_num; i++) {
+            sensor_t *sensor = &hub->sensors[i];
+            const int64_t time = (sensor->state == SENSOR_STATE_IDLE) ? sensor->next_start : sensor->ready_time;
+            if (time < next_time) {
+                next_time = time;
+                next = sensor;
+            }
+        }
+
+        const int64_t now = esp_timer_get_time();
+        if (next == NULL || next_time > now) {
+            /* Rounded up to whole ticks, stop request wakes up the task earlier */
+            TickType_t wait = portMAX_DELAY;
+            if (next != NULL) {
+                const int64_t tick_us = portTICK_PERIOD_MS * 1000;
+                wait = (TickType_t)((next_time - now + tick_us - 1) / tick_us);
+            }
+            ulTaskNotifyTake(pdTRUE, wait);
+            continue;
+        }
+
+        sensor_hub_process(hub, next, now);
+    }
+
+    xSemaphoreGive(hub->stopped);
+    vTaskDelete(NULL);
+}
+
+static void sensor_hub_process(esp_sensor_hub_handle_t hub, sensor_t *sensor, int64_t now)
+{
+    const esp_sensor_hub_sensor_ops_t *ops = sensor->config.ops;
+    uint32_t wait_us = 0;
+    esp_err_t err;
+
+    if (sensor->state == SENSOR_STATE_IDLE) {
+        memset(&sensor->data, 0, sizeof(esp_sensor_hub_data_t));
+        sensor->data.sensor_id = sensor - hub->sensors;
+        sensor->data.timestamp_us = now;
+        if (ops->trigger) {
+            err = ops->trigger(sensor->config.user_ctx, &wait_us);
+            if (err != ESP_OK) {
+                sensor_hub_finish(hub, sensor, err, now);
+                return;
+            }
+            sensor->state = SENSOR_STATE_CONVERTING;
+            sensor->ready_time = now + wait_us;
+            return;
+        }
+    }
+
+    err = ops->read(sensor->config.user_ctx, &sensor->data, &wait_us);
+    if (err == ESP_ERR_NOT_FINISHED) {
+        /* Next step of the sensor, other sensors are served meanwhile */
+        sensor->state = SENSOR_STATE_CONVERTING;
+        sensor->ready_time = esp_timer_get_time() + wait_us;
+        return;
+    }
+    sensor_hub_finish(hub, sensor, err, esp_timer_get_time());
+}
+
+static void sensor_hub_finish(esp_sensor_hub_handle_t hub, sensor_t *sensor, esp_err_t err, int64_t now)
+{
+    const int64_t period_us = (int64_t)sensor->config.period_ms * 1000;
+    uint32_t skipped = 0;
+
+    /* Keep the grid of periods, late sample starts right away, periods passed completely are skipped */
+    sensor->next_start += period_us;
+    while (sensor->next_start + period_us <= now) {
+        sensor->next_start += period_us;
+        skipped++;
+    }
+    sensor->state = SENSOR_STATE_IDLE;
+
+    portENTER_CRITICAL(&hub->lock);
+    sensor->stats.overruns += skipped;
+    if (err == ESP_OK) {
+        sensor->stats.samples++;
+    } else {
+        sensor->stats.errors++;
+    }
+    portEXIT_CRITICAL(&hub->lock);
+
+    if (err == ESP_OK) {
+        if (sensor->data.value_num > ESP_SENSOR_HUB_VALUES_MAX) {
+            sensor->data.value_num = ESP_SENSOR_HUB_VALUES_MAX;
+        }
+        sensor_hub_publish(hub, &sensor->data);
+    } else {
+        ESP_LOGD(TAG, "Sensor %s sample failed (%s)", sensor->config.name ? sensor->config.name : "", esp_err_to_name(err));
+    }
+}
+
+static void sensor_hub_publish(esp_sensor_hub_handle_t hub, const esp_sensor_hub_data_t *data)
+{
+    for (int i = 0; i < hub->sub_num; i++) {
+        esp_sensor_hub_sub_handle_t sub = hub->subs[i];
+        if (!(sub->sensor_mask & (1UL << data->sensor_id))) {
+            continue;
+        }
+
+        /* Single producer, single consumer ring, the hub task never waits for the subscriber */
+        const unsigned int head = atomic_load_explicit(&sub->head, memory_order_relaxed);
+        const unsigned int tail = atomic_load_explicit(&sub->tail, memory_order_acquire);
+        if (head - tail > sub->size_mask) {
+            atomic_fetch_add_explicit(&sub->dropped, 1, memory_order_relaxed);
+            continue;
+        }
+        sub->buf[head & sub->size_mask] = *data;
+        atomic_store_explicit(&sub->head, head + 1, memory_order_release);
+        xSemaphoreGive(sub->signal);
+    }
+}
+
+static void sensor_hub_sub_free(esp_sensor_hub_sub_handle_t sub)
+{
+    if (sub->signal) {
+        vSemaphoreDelete(sub->signal);
+    }
+    free(sub->buf);
+    free(sub);
+}
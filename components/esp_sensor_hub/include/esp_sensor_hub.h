@@ -0,0 +1,266 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sensor hub: scheduled sampling of more sensors by one task
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximal count of values in one sample
+ */
+#define ESP_SENSOR_HUB_VALUES_MAX   (4)
+
+/**
+ * @brief Maximal count of sensors in one hub (one bit of subscriber mask each)
+ */
+#define ESP_SENSOR_HUB_SENSORS_MAX  (32)
+
+/**
+ * @brief Sensor hub handle
+ */
+typedef struct esp_sensor_hub_s *esp_sensor_hub_handle_t;
+
+/**
+ * @brief Subscriber handle
+ */
+typedef struct esp_sensor_hub_sub_s *esp_sensor_hub_sub_handle_t;
+
+/**
+ * @brief One sample of a sensor
+ */
+typedef struct {
+    uint8_t  sensor_id;         /*!< Sensor ID returned by esp_sensor_hub_add_sensor */
+    uint8_t  value_num;         /*!< Count of valid values */
+    int64_t  timestamp_us;      /*!< Start of the measurement (esp_timer_get_time) */
+    float    values[ESP_SENSOR_HUB_VALUES_MAX]; /*!< Measured values (meaning and units are given by the sensor) */
+} esp_sensor_hub_data_t;
+
+/**
+ * @brief Operations of one sensor
+ *
+ * All operations are called from the hub task only, so the sensors of one hub never access the I2C bus at once.
+ * They must not wait for the conversion, the hub calls the next step after the returned wait and
+ * the other sensors are scheduled meanwhile.
+ */
+typedef struct {
+    /**
+     * @brief Start the measurement (NULL: sensor measures continuously, read is called right away)
+     *
+     * @param ctx       user_ctx of the sensor
+     * @param wait_us   output time of the conversion, read is called after it
+     * @return ESP_OK on success, otherwise the sample is skipped
+     */
+    esp_err_t (*trigger)(void *ctx, uint32_t *wait_us);
+
+    /**
+     * @brief Read the result
+     *
+     * Sensors with more steps (e.g. temperature and then pressure) start the next conversion,
+     * set wait_us and return ESP_ERR_NOT_FINISHED. The read is called again after wait_us.
+     *
+     * @param ctx       user_ctx of the sensor
+     * @param data      output values (value_num and values)
+     * @param wait_us   output time of the next step (only with ESP_ERR_NOT_FINISHED)
+     * @return
+     *      - ESP_OK                  data is valid
+     *      - ESP_ERR_NOT_FINISHED    call again after wait_us
+     *      - Others                  the sample is skipped
+     */
+    esp_err_t (*read)(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us);
+} esp_sensor_hub_sensor_ops_t;
+
+/**
+ * @brief Configuration of one sensor
+ */
+typedef struct {
+    const char *name;                           /*!< Sensor name (for logs) */
+    uint32_t period_ms;                         /*!< Period of samples (1 / ODR) */
+    const esp_sensor_hub_sensor_ops_t *ops;     /*!< Sensor operations (must stay valid) */
+    void *user_ctx;                             /*!< Passed to operations (e.g. driver handle) */
+} esp_sensor_hub_sensor_config_t;
+
+/**
+ * @brief Statistics of one sensor
+ */
+typedef struct {
+    uint32_t samples;       /*!< Published samples */
+    uint32_t errors;        /*!< Samples skipped due to an error of trigger or read */
+    uint32_t overruns;      /*!< Periods skipped, because the previous sample finished too late */
+} esp_sensor_hub_sensor_stats_t;
+
+/**
+ * @brief Sensor hub configuration
+ */
+typedef struct {
+    uint8_t  max_sensors;       /*!< Maximal count of sensors (up to ESP_SENSOR_HUB_SENSORS_MAX) */
+    uint8_t  max_subscribers;   /*!< Maximal count of subscribers */
+    uint32_t task_priority;     /*!< Priority of the hub task */
+    uint32_t task_stack;        /*!< Stack of the hub task (sensor operations run in it) */
+    int      task_affinity;     /*!< Core of the hub task (-1: no affinity) */
+} esp_sensor_hub_config_t;
+
+/**
+ * @brief Default sensor hub configuration
+ */
+#define ESP_SENSOR_HUB_DEFAULT_CONFIG() \
+    {                                   \
+        .max_sensors = 8,               \
+        .max_subscribers = 4,           \
+        .task_priority = 5,             \
+        .task_stack = 4096,             \
+        .task_affinity = -1,            \
+    }
+
+/**
+ * @brief Create sensor hub (not started)
+ *
+ * @param config        hub configuration
+ * @param ret_hub       output hub handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or invalid
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_sensor_hub_new(const esp_sensor_hub_config_t *config, esp_sensor_hub_handle_t *ret_hub);
+
+/**
+ * @brief Delete sensor hub and its subscribers (stopped before)
+ *
+ * @param hub           hub handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_sensor_hub_del(esp_sensor_hub_handle_t hub);
+
+/**
+ * @brief Add sensor to the hub
+ *
+ * @note Sensors are added while the hub is stopped.
+ *
+ * @param hub           hub handle
+ * @param config        sensor configuration
+ * @param ret_id        output sensor ID (bit of subscriber mask)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or invalid
+ *      - ESP_ERR_INVALID_STATE     if the hub is running
+ *      - ESP_ERR_NO_MEM            if max_sensors were added
+ */
+esp_err_t esp_sensor_hub_add_sensor(esp_sensor_hub_handle_t hub, const esp_sensor_hub_sensor_config_t *config, uint8_t *ret_id);
+
+/**
+ * @brief Subscribe to samples of selected sensors
+ *
+ * Samples are passed by a lock-free ring buffer, the hub task never waits for the subscriber.
+ * When the buffer is full, new samples are dropped.
+ *
+ * @note Subscribers are added while the hub is stopped. One subscriber is read by one task.
+ *
+ * @param hub           hub handle
+ * @param sensor_mask   bit mask of sensor IDs (BIT(id))
+ * @param queue_len     count of buffered samples (rounded up to power of two)
+ * @param ret_sub       output subscriber handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or invalid
+ *      - ESP_ERR_INVALID_STATE     if the hub is running
+ *      - ESP_ERR_NO_MEM            if there is not enough memory or max_subscribers were added
+ */
+esp_err_t esp_sensor_hub_subscribe(esp_sensor_hub_handle_t hub, uint32_t sensor_mask, size_t queue_len, esp_sensor_hub_sub_handle_t *ret_sub);
+
+/**
+ * @brief Remove and delete subscriber
+ *
+ * Its slot is free for a new subscriber. Subscribers left in the hub are deleted by esp_sensor_hub_del().
+ *
+ * @note Subscribers are removed while the hub is stopped. The subscriber must not be read anymore.
+ *
+ * @param hub           hub handle
+ * @param sub           subscriber handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the hub is running
+ *      - ESP_ERR_NOT_FOUND         if the subscriber is not in the hub
+ */
+esp_err_t esp_sensor_hub_unsubscribe(esp_sensor_hub_handle_t hub, esp_sensor_hub_sub_handle_t sub);
+
+/**
+ * @brief Start sampling
+ *
+ * First samples of all sensors are started right away, then every period_ms.
+ *
+ * @param hub           hub handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the hub is running
+ *      - ESP_ERR_NO_MEM            if the task cannot be created
+ */
+esp_err_t esp_sensor_hub_start(esp_sensor_hub_handle_t hub);
+
+/**
+ * @brief Stop sampling
+ *
+ * Waits for the running sensor operation, the started conversions are not read.
+ *
+ * @param hub           hub handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if the hub is not running
+ */
+esp_err_t esp_sensor_hub_stop(esp_sensor_hub_handle_t hub);
+
+/**
+ * @brief Receive the oldest sample of the subscriber
+ *
+ * @param sub           subscriber handle
+ * @param data          output sample
+ * @param timeout_ms    maximal wait for new sample (-1: wait forever)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_TIMEOUT           if no sample came in time
+ */
+esp_err_t esp_sensor_hub_receive(esp_sensor_hub_sub_handle_t sub, esp_sensor_hub_data_t *data, int timeout_ms);
+
+/**
+ * @brief Get count of samples dropped due to full buffer of the subscriber
+ *
+ * @param sub           subscriber handle
+ * @return count of dropped samples
+ */
+uint32_t esp_sensor_hub_get_dropped(esp_sensor_hub_sub_handle_t sub);
+
+/**
+ * @brief Get sensor statistics
+ *
+ * @param hub           hub handle
+ * @param sensor_id     sensor ID
+ * @param stats         output statistics
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or sensor_id is unknown
+ */
+esp_err_t esp_sensor_hub_get_stats(esp_sensor_hub_handle_t hub, uint8_t sensor_id, esp_sensor_hub_sensor_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,209 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "unity.h"
+#include "esp_bit_defs.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_sensor_hub.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+static const char *TAG = "sensor hub test";
+
+/* Fake sensor with conversion time and number of steps (e.g. temperature and pressure) */
+typedef struct {
+    uint32_t conversion_us;
+    uint8_t steps;
+    uint8_t step;
+    uint32_t reads;
+} test_sensor_t;
+
+static esp_err_t test_sensor_trigger(void *ctx, uint32_t *wait_us)
+{
+    test_sensor_t *sensor = ctx;
+    sensor->step = 0;
+    *wait_us = sensor->conversion_us;
+    return ESP_OK;
+}
+
+static esp_err_t test_sensor_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
+{
+    test_sensor_t *sensor = ctx;
+    if (++sensor->step < sensor->steps) {
+        *wait_us = sensor->conversion_us;
+        return ESP_ERR_NOT_FINISHED;
+    }
+    data->value_num = 1;
+    data->values[0] = ++sensor->reads;
+    return ESP_OK;
+}
+
+static const esp_sensor_hub_sensor_ops_t test_sensor_ops = {
+    .trigger = test_sensor_trigger,
+    .read = test_sensor_read,
+};
+
+TEST_CASE("Sensor hub overlaps conversions", "[sensor_hub]")
+{
+    esp_sensor_hub_handle_t hub = NULL;
+    esp_sensor_hub_sub_handle_t sub = NULL;
+    const esp_sensor_hub_config_t hub_cfg = ESP_SENSOR_HUB_DEFAULT_CONFIG();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_new(&hub_cfg, &hub));
+
+    /* Two slow sensors, serial sampling would give only 5 samples of each in 1 s */
+    test_sensor_t slow[2] = {
+        {.conversion_us = 100000, .steps = 1},
+        {.conversion_us = 50000, .steps = 2},
+    };
+    uint8_t ids[2];
+    for (int i = 0; i < 2; i++) {
+        const esp_sensor_hub_sensor_config_t sensor_cfg = {
+            .name = "slow",
+            .period_ms = 150,
+            .ops = &test_sensor_ops,
+            .user_ctx = &slow[i],
+        };
+        TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_add_sensor(hub, &sensor_cfg, &ids[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_subscribe(hub, BIT(ids[0]) | BIT(ids[1]), 32, &sub));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_start(hub));
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_stop(hub));
+
+    for (int i = 0; i < 2; i++) {
+        esp_sensor_hub_sensor_stats_t stats;
+        TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_get_stats(hub, ids[i], &stats));
+        ESP_LOGI(TAG, "sensor %d: samples %"PRIu32", overruns %"PRIu32, ids[i], stats.samples, stats.overruns);
+        TEST_ASSERT_INT_WITHIN(1, 7, stats.samples);
+        TEST_ASSERT_EQUAL(0, stats.overruns);
+        TEST_ASSERT_EQUAL(0, stats.errors);
+    }
+
+    /* Samples of one sensor come in order, one period apart */
+    esp_sensor_hub_data_t data;
+    int64_t last_timestamp[2] = {-1, -1};
+    int received = 0;
+    while (esp_sensor_hub_receive(sub, &data, 0) == ESP_OK) {
+        TEST_ASSERT_LESS_THAN(2, data.sensor_id);
+        TEST_ASSERT_EQUAL(1, data.value_num);
+        if (last_timestamp[data.sensor_id] >= 0) {
+            TEST_ASSERT_INT_WITHIN(5000, 150000, data.timestamp_us - last_timestamp[data.sensor_id]);
+        }
+        last_timestamp[data.sensor_id] = data.timestamp_us;
+        received++;
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL(12, received);
+    TEST_ASSERT_EQUAL(0, esp_sensor_hub_get_dropped(sub));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_del(hub));
+}
+
+TEST_CASE("Sensor hub receive and drop", "[sensor_hub]")
+{
+    esp_sensor_hub_handle_t hub = NULL;
+    esp_sensor_hub_sub_handle_t sub = NULL;
+    const esp_sensor_hub_config_t hub_cfg = ESP_SENSOR_HUB_DEFAULT_CONFIG();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_new(&hub_cfg, &hub));
+
+    /* Continuous sensor, read right away */
+    test_sensor_t fast = {.steps = 1};
+    const esp_sensor_hub_sensor_ops_t fast_ops = {
+        .read = test_sensor_read,
+    };
+    const esp_sensor_hub_sensor_config_t sensor_cfg = {
+        .name = "fast",
+        .period_ms = 10,
+        .ops = &fast_ops,
+        .user_ctx = &fast,
+    };
+    uint8_t id;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_add_sensor(hub, &sensor_cfg, &id));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_subscribe(hub, BIT(id), 4, &sub));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_sensor_hub_subscribe(hub, BIT(id), 0, &sub));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_start(hub));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_sensor_hub_add_sensor(hub, &sensor_cfg, &id));
+
+    esp_sensor_hub_data_t data;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_receive(sub, &data, 100));
+    TEST_ASSERT_EQUAL(1, (int)data.values[0]);
+
+    /* Not read subscriber drops the new samples */
+    vTaskDelay(pdMS_TO_TICKS(200));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_stop(hub));
+    TEST_ASSERT_GREATER_THAN(0, esp_sensor_hub_get_dropped(sub));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_receive(sub, &data, 0));
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, esp_sensor_hub_receive(sub, &data, 10));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_del(hub));
+}
+
+TEST_CASE("Sensor hub unsubscribe", "[sensor_hub]")
+{
+    esp_sensor_hub_handle_t hub = NULL;
+    esp_sensor_hub_sub_handle_t subs[2] = {NULL};
+    esp_sensor_hub_config_t hub_cfg = ESP_SENSOR_HUB_DEFAULT_CONFIG();
+    hub_cfg.max_subscribers = 2;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_new(&hub_cfg, &hub));
+
+    test_sensor_t fast = {.steps = 1};
+    const esp_sensor_hub_sensor_ops_t fast_ops = {
+        .read = test_sensor_read,
+    };
+    const esp_sensor_hub_sensor_config_t sensor_cfg = {
+        .name = "fast",
+        .period_ms = 10,
+        .ops = &fast_ops,
+        .user_ctx = &fast,
+    };
+    uint8_t id;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_add_sensor(hub, &sensor_cfg, &id));
+
+    /* Removed subscriber frees its slot, subscribe and unsubscribe can be repeated */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_subscribe(hub, BIT(id), 4, &subs[0]));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_subscribe(hub, BIT(id), 4, &subs[1]));
+        TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, esp_sensor_hub_subscribe(hub, BIT(id), 4, &subs[1]));
+        TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_unsubscribe(hub, subs[1]));
+    }
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_start(hub));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_sensor_hub_unsubscribe(hub, subs[0]));
+    esp_sensor_hub_data_t data;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_receive(subs[0], &data, 100));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_stop(hub));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_unsubscribe(hub, subs[0]));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_sensor_hub_unsubscribe(hub, subs[0]));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_del(hub));
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (200)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
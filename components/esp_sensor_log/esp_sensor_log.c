@@ -0,0 +1,747 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_sensor_log.h"
+
+static const char *TAG = "SENSOR_LOG";
+
+/* Longest wait for samples, flush and stop requests are served after it */
+#define LOG_POLL_MS                 (100)
+
+#define LOG_DATA_MAGIC              "ESLD"
+#define LOG_INDEX_MAGIC             "ESLI"
+#define LOG_PATH_EXT_LEN            (4)     /* ".bin", ".idx" */
+
+/* Requests in the queue of full blocks: fsync, fsync and exit of the writer */
+#define LOG_REQ_SYNC                ((uint8_t *)NULL)
+#define LOG_REQ_STOP                ((uint8_t *)&log_stop_req)
+
+static const uint8_t log_stop_req;
+
+_Static_assert(sizeof(esp_sensor_log_record_t) == 32, "Record must have fixed layout");
+_Static_assert(ESP_SENSOR_LOG_BLOCK_SIZE_MIN % sizeof(esp_sensor_log_record_t) == 0, "Blocks must hold whole records");
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+/* Header of data file (start of its first block) and index file */
+typedef struct {
+    char     magic[4];
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t block_size;
+    uint32_t reserved;
+    int64_t  created_us;        /* System time of the creation */
+} log_header_t;
+
+struct esp_sensor_log_s {
+    esp_sensor_log_config_t config;
+    char *data_path;
+    char *index_path;
+    int data_fd;
+    int index_fd;
+    uint32_t blocks;            /* Data blocks in the file (without header block) */
+    uint32_t index_entries;     /* Entries in the index file, entries of the next blocks wait for a failed one */
+    uint32_t unsynced;          /* Blocks written after the last fsync */
+    esp_sensor_hub_sub_handle_t sub;
+    uint8_t *buf;               /* block_num * block_size bytes */
+    QueueHandle_t free_queue;   /* Blocks for filling */
+    QueueHandle_t full_queue;   /* Blocks for writing and requests (LOG_REQ_SYNC, LOG_REQ_STOP) */
+    esp_sensor_log_record_t *block; /* Block in progress (NULL: none) */
+    uint32_t records;           /* Records in the block in progress */
+    int64_t time_offset_us;     /* System time - esp_timer time, taken with the first record of a block */
+    int64_t open_time;          /* Time of the first record in the block in progress */
+    uint32_t hub_dropped;       /* Last dropped count of the subscriber */
+    portMUX_TYPE lock;          /* Lock of statistics */
+    esp_sensor_log_stats_t stats;
+    int64_t stats_start;
+    TaskHandle_t task;
+    TaskHandle_t writer_task;
+    volatile bool stop;
+    volatile bool flush;
+    SemaphoreHandle_t synced;   /* Given by the writer task after fsync request */
+    SemaphoreHandle_t stopped;  /* Given by the task before exit */
+};
+
+struct esp_sensor_log_reader_s {
+    int fd;
+    uint32_t block_size;
+    uint32_t records_per_block;
+    uint32_t blocks;            /* Data blocks in the file */
+    int64_t *index;             /* First timestamp of every data block */
+    int64_t last_us;            /* Timestamp of the last record */
+    esp_sensor_log_record_t *buf; /* Loaded block */
+    int64_t loaded;             /* Loaded data block (-1: none) */
+    uint32_t block;             /* Current data block (0 based) */
+    uint32_t record;            /* Next record in the current block */
+    int64_t min_us;             /* Older records are skipped */
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void log_task(void *arg);
+static void log_writer_task(void *arg);
+static esp_err_t log_open_files(esp_sensor_log_handle_t log);
+static void log_add_sample(esp_sensor_log_handle_t log, const esp_sensor_hub_data_t *data);
+static void log_close_block(esp_sensor_log_handle_t log);
+static esp_err_t log_read_at(int fd, off_t offset, void *data, size_t len);
+static esp_err_t log_write_at(int fd, off_t offset, const void *data, size_t len);
+static esp_err_t log_write_index(esp_sensor_log_handle_t log, int64_t last_us);
+static esp_err_t log_check_header(const log_header_t *header, const char *magic);
+static esp_err_t reader_load(esp_sensor_log_reader_handle_t rd, uint32_t block);
+static int64_t log_system_time_us(void);
+static char *log_path(const char *path, const char *ext);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_sensor_log_new(const esp_sensor_log_config_t *config, esp_sensor_log_handle_t *ret_handle)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_handle && config->hub && config->path, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->block_size >= ESP_SENSOR_LOG_BLOCK_SIZE_MIN && config->block_size % ESP_SENSOR_LOG_BLOCK_SIZE_MIN == 0 &&
+                        config->block_num >= 2 && config->max_delay_ms > 0, ESP_ERR_INVALID_ARG, TAG, "invalid block config");
+
+    esp_sensor_log_handle_t log = calloc(1, sizeof(struct esp_sensor_log_s));
+    ESP_RETURN_ON_FALSE(log, ESP_ERR_NO_MEM, TAG, "Not enough memory for sensor log");
+    log->config = *config;
+    log->config.path = NULL;
+    log->data_fd = -1;
+    log->index_fd = -1;
+    portMUX_INITIALIZE(&log->lock);
+
+    log->data_path = log_path(config->path, ".bin");
+    log->index_path = log_path(config->path, ".idx");
+    log->buf = heap_caps_aligned_alloc(4, config->block_num * config->block_size, config->buffer_caps);
+    if (log->buf == NULL) {
+        ESP_LOGW(TAG, "Ring buffer with caps 0x%"PRIx32" not allocated, using internal RAM", config->buffer_caps);
+        log->buf = heap_caps_aligned_alloc(4, config->block_num * config->block_size, MALLOC_CAP_DEFAULT);
+    }
+    log->free_queue = xQueueCreate(config->block_num, sizeof(uint8_t *));
+    /* Room for all blocks and fsync requests of flush and stop */
+    log->full_queue = xQueueCreate(config->block_num + 2, sizeof(uint8_t *));
+    log->synced = xSemaphoreCreateBinary();
+    log->stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(log->data_path && log->index_path && log->buf && log->free_queue && log->full_queue && log->synced && log->stopped,
+                      ESP_ERR_NO_MEM, err, TAG, "Not enough memory for sensor log");
+    for (int i = 0; i < config->block_num; i++) {
+        uint8_t *block = log->buf + (size_t)i * config->block_size;
+        xQueueSend(log->free_queue, &block, 0);
+    }
+
+    ESP_GOTO_ON_ERROR(log_open_files(log), err, TAG, "open of %s fail", log->data_path);
+    ESP_GOTO_ON_ERROR(esp_sensor_hub_subscribe(config->hub, config->sensor_mask, config->queue_len, &log->sub), err, TAG, "subscribe fail");
+    log->stats_start = esp_timer_get_time();
+
+    /* Writer first, the receiving task needs it for exit */
+    BaseType_t res;
+    if (config->task_affinity < 0) {
+        res = xTaskCreate(log_writer_task, "sensor_logw", config->task_stack, log, config->task_priority, &log->writer_task);
+    } else {
+        res = xTaskCreatePinnedToCore(log_writer_task, "sensor_logw", config->task_stack, log, config->task_priority, &log->writer_task,
+                                      config->task_affinity);
+    }
+    if (res != pdPASS) {
+        log->writer_task = NULL;
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_NO_MEM, err, TAG, "Create sensor log task fail!");
+    }
+    if (config->task_affinity < 0) {
+        res = xTaskCreate(log_task, "sensor_log", config->task_stack, log, config->task_priority, &log->task);
+    } else {
+        res = xTaskCreatePinnedToCore(log_task, "sensor_log", config->task_stack, log, config->task_priority, &log->task,
+                                      config->task_affinity);
+    }
+    if (res != pdPASS) {
+        log->task = NULL;
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_NO_MEM, err, TAG, "Create sensor log task fail!");
+    }
+
+    *ret_handle = log;
+    return ESP_OK;
+
+err:
+    esp_sensor_log_del(log);
+    return ret;
+}
+
+esp_err_t esp_sensor_log_del(esp_sensor_log_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    if (handle->task) {
+        handle->stop = true;
+        xSemaphoreTake(handle->stopped, portMAX_DELAY);
+    } else if (handle->writer_task) {
+        /* Only writer was created */
+        const uint8_t *req = LOG_REQ_STOP;
+        xQueueSend(handle->full_queue, &req, portMAX_DELAY);
+        xSemaphoreTake(handle->synced, portMAX_DELAY);
+    }
+    if (handle->sub) {
+        /* Subscriber of the running hub stays in it until esp_sensor_hub_del() */
+        esp_sensor_hub_unsubscribe(handle->config.hub, handle->sub);
+    }
+    if (handle->data_fd >= 0) {
+        close(handle->data_fd);
+    }
+    if (handle->index_fd >= 0) {
+        close(handle->index_fd);
+    }
+    if (handle->stopped) {
+        vSemaphoreDelete(handle->stopped);
+    }
+    if (handle->synced) {
+        vSemaphoreDelete(handle->synced);
+    }
+    if (handle->full_queue) {
+        vQueueDelete(handle->full_queue);
+    }
+    if (handle->free_queue) {
+        vQueueDelete(handle->free_queue);
+    }
+    heap_caps_free(handle->buf);
+    free(handle->index_path);
+    free(handle->data_path);
+    free(handle);
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_log_flush(esp_sensor_log_handle_t handle, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    /* Possible late fsync of a timed out flush */
+    xSemaphoreTake(handle->synced, 0);
+    handle->flush = true;
+    ESP_RETURN_ON_FALSE(xSemaphoreTake(handle->synced, pdMS_TO_TICKS(timeout_ms)) == pdTRUE, ESP_ERR_TIMEOUT, TAG, "flush timeout");
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_log_get_stats(esp_sensor_log_handle_t handle, esp_sensor_log_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(handle && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&handle->lock);
+    *stats = handle->stats;
+    stats->period_ms = (uint32_t)((now - handle->stats_start) / 1000);
+    if (reset) {
+        memset(&handle->stats, 0, sizeof(handle->stats));
+        handle->stats_start = now;
+    }
+    portEXIT_CRITICAL(&handle->lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_log_reader_open(const char *path, esp_sensor_log_reader_handle_t *ret_reader)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(path && ret_reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    char *data_path = log_path(path, ".bin");
+    char *index_path = log_path(path, ".idx");
+    esp_sensor_log_reader_handle_t rd = calloc(1, sizeof(struct esp_sensor_log_reader_s));
+    int index_fd = -1;
+    ESP_GOTO_ON_FALSE(rd, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for sensor log reader");
+    rd->fd = -1;
+    ESP_GOTO_ON_FALSE(data_path && index_path, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for sensor log reader");
+    rd->loaded = -1;
+    rd->min_us = INT64_MIN;
+
+    rd->fd = open(data_path, O_RDONLY);
+    ESP_GOTO_ON_FALSE(rd->fd >= 0, ESP_ERR_NOT_FOUND, err, TAG, "%s not found", data_path);
+    log_header_t header;
+    ESP_GOTO_ON_ERROR(log_read_at(rd->fd, 0, &header, sizeof(header)), err, TAG, "header read fail");
+    ESP_GOTO_ON_ERROR(log_check_header(&header, LOG_DATA_MAGIC), err, TAG, "%s has other format", data_path);
+    rd->block_size = header.block_size;
+    rd->records_per_block = header.block_size / sizeof(esp_sensor_log_record_t);
+    struct stat st;
+    ESP_GOTO_ON_FALSE(fstat(rd->fd, &st) == 0, ESP_FAIL, err, TAG, "stat fail");
+    /* Partially written last block is not used */
+    rd->blocks = (st.st_size > (off_t)rd->block_size) ? (st.st_size / rd->block_size - 1) : 0;
+
+    rd->buf = heap_caps_aligned_alloc(4, rd->block_size, MALLOC_CAP_DEFAULT);
+    rd->index = heap_caps_malloc((rd->blocks ? rd->blocks : 1) * sizeof(int64_t), MALLOC_CAP_SPIRAM);
+    if (rd->index == NULL) {
+        rd->index = malloc((rd->blocks ? rd->blocks : 1) * sizeof(int64_t));
+    }
+    ESP_GOTO_ON_FALSE(rd->buf && rd->index, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for sensor log reader");
+
+    /* Index entries of the blocks written before the index, others are read from the blocks */
+    uint32_t entries = 0;
+    index_fd = open(index_path, O_RDONLY);
+    if (index_fd >= 0 && log_read_at(index_fd, 0, &header, sizeof(header)) == ESP_OK &&
+            log_check_header(&header, LOG_INDEX_MAGIC) == ESP_OK && header.block_size == rd->block_size && fstat(index_fd, &st) == 0) {
+        entries = (st.st_size - sizeof(header)) / sizeof(int64_t);
+        if (entries > rd->blocks) {
+            entries = rd->blocks;
+        }
+        if (entries && log_read_at(index_fd, sizeof(header), rd->index, entries * sizeof(int64_t)) != ESP_OK) {
+            entries = 0;
+        }
+    }
+    if (entries < rd->blocks) {
+        ESP_LOGW(TAG, "%"PRIu32" index entries of %s rebuilt", rd->blocks - entries, data_path);
+    }
+    for (uint32_t i = entries; i < rd->blocks; i++) {
+        int64_t ts;
+        ESP_GOTO_ON_ERROR(log_read_at(rd->fd, (off_t)(i + 1) * rd->block_size, &ts, sizeof(ts)), err, TAG, "block read fail");
+        rd->index[i] = ts;
+    }
+
+    /* Newest record of the last block */
+    rd->last_us = INT64_MIN;
+    if (rd->blocks) {
+        ESP_GOTO_ON_ERROR(reader_load(rd, rd->blocks - 1), err, TAG, "block read fail");
+        for (uint32_t i = 0; i < rd->records_per_block && rd->buf[i].sensor_id != ESP_SENSOR_LOG_ID_NONE; i++) {
+            if (rd->buf[i].timestamp_us > rd->last_us) {
+                rd->last_us = rd->buf[i].timestamp_us;
+            }
+        }
+    }
+
+    if (index_fd >= 0) {
+        close(index_fd);
+    }
+    free(index_path);
+    free(data_path);
+    *ret_reader = rd;
+    return ESP_OK;
+
+err:
+    if (index_fd >= 0) {
+        close(index_fd);
+    }
+    if (rd) {
+        if (rd->fd >= 0) {
+            close(rd->fd);
+        }
+        heap_caps_free(rd->buf);
+        free(rd->index);
+        free(rd);
+    }
+    free(index_path);
+    free(data_path);
+    return ret;
+}
+
+esp_err_t esp_sensor_log_reader_close(esp_sensor_log_reader_handle_t reader)
+{
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    close(reader->fd);
+    heap_caps_free(reader->buf);
+    free(reader->index);
+    free(reader);
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_log_reader_get_range(esp_sensor_log_reader_handle_t reader, int64_t *first_us, int64_t *last_us)
+{
+    ESP_RETURN_ON_FALSE(reader && first_us && last_us, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (reader->blocks == 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    *first_us = reader->index[0];
+    *last_us = reader->last_us;
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_log_reader_seek(esp_sensor_log_reader_handle_t reader, int64_t timestamp_us)
+{
+    ESP_RETURN_ON_FALSE(reader, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    /* Last block starting at or before the timestamp */
+    uint32_t lo = 0;
+    uint32_t hi = reader->blocks;
+    while (hi - lo > 1) {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        if (reader->index[mid] <= timestamp_us) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    /* Older samples of slow sensors can be at the end of the previous block */
+    reader->block = (lo > 0) ? lo - 1 : 0;
+    reader->record = 0;
+    reader->min_us = timestamp_us;
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_log_reader_next(esp_sensor_log_reader_handle_t reader, esp_sensor_log_record_t *record)
+{
+    ESP_RETURN_ON_FALSE(reader && record, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    while (reader->block < reader->blocks) {
+        if (reader->record >= reader->records_per_block) {
+            reader->block++;
+            reader->record = 0;
+            continue;
+        }
+        ESP_RETURN_ON_ERROR(reader_load(reader, reader->block), TAG, "block read fail");
+        const esp_sensor_log_record_t *r = &reader->buf[reader->record++];
+        if (r->sensor_id == ESP_SENSOR_LOG_ID_NONE) {
+            /* Padding up to the end of the block */
+            reader->record = reader->records_per_block;
+            continue;
+        }
+        if (r->timestamp_us >= reader->min_us) {
+            *record = *r;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t esp_sensor_log_reader_plot(esp_sensor_log_reader_handle_t reader, uint8_t sensor_id, uint8_t value_index,
+                                     int64_t start_us, int64_t end_us, float *points, size_t num)
+{
+    ESP_RETURN_ON_FALSE(reader && points && num > 0 && end_us > start_us && value_index < ESP_SENSOR_HUB_VALUES_MAX,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    const int64_t range = end_us - start_us;
+    for (size_t i = 0; i < num; i++) {
+        const int64_t from = start_us + range * (int64_t)i / (int64_t)num;
+        const int64_t to = start_us + range * (int64_t)(i + 1) / (int64_t)num;
+        ESP_RETURN_ON_ERROR(esp_sensor_log_reader_seek(reader, from), TAG, "seek fail");
+
+        /* Records of the interval in one block, the block of the previous point is usually loaded already */
+        float sum = 0;
+        uint32_t count = 0;
+        int64_t first_block = -1;
+        esp_sensor_log_record_t r;
+        esp_err_t ret;
+        while ((ret = esp_sensor_log_reader_next(reader, &r)) == ESP_OK && r.timestamp_us < to) {
+            if (first_block >= 0 && reader->block != first_block) {
+                break;
+            }
+            if (r.sensor_id == sensor_id && value_index < r.value_num) {
+                if (first_block < 0) {
+                    first_block = reader->block;
+                }
+                sum += r.values[value_index];
+                count++;
+            }
+        }
+        ESP_RETURN_ON_FALSE(ret == ESP_OK || ret == ESP_ERR_NOT_FOUND, ret, TAG, "read fail");
+        points[i] = count ? (sum / count) : NAN;
+    }
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static char *log_path(const char *path, const char *ext)
+{
+    const size_t len = strlen(path) + LOG_PATH_EXT_LEN + 1;
+    char *full = malloc(len);
+    if (full) {
+        snprintf(full, len, "%s%s", path, ext);
+    }
+    return full;
+}
+
+static int64_t log_system_time_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static esp_err_t log_read_at(int fd, off_t offset, void *data, size_t len)
+{
+    if (lseek(fd, offset, SEEK_SET) != offset || read(fd, data, len) != (ssize_t)len) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t log_write_at(int fd, off_t offset, const void *data, size_t len)
+{
+    if (lseek(fd, offset, SEEK_SET) != offset || write(fd, data, len) != (ssize_t)len) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t log_check_header(const log_header_t *header, const char *magic)
+{
+    if (memcmp(header->magic, magic, sizeof(header->magic)) != 0 || header->version != ESP_SENSOR_LOG_FORMAT_VERSION ||
+            header->record_size != sizeof(esp_sensor_log_record_t) || header->block_size < ESP_SENSOR_LOG_BLOCK_SIZE_MIN ||
+            header->block_size % ESP_SENSOR_LOG_BLOCK_SIZE_MIN != 0) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    return ESP_OK;
+}
+
+/* Open or create data and index file, the index is completed from the data blocks */
+static esp_err_t log_open_files(esp_sensor_log_handle_t log)
+{
+    const size_t block_size = log->config.block_size;
+    const log_header_t new_header = {
+        .version = ESP_SENSOR_LOG_FORMAT_VERSION,
+        .record_size = sizeof(esp_sensor_log_record_t),
+        .block_size = block_size,
+        .created_us = log_system_time_us(),
+    };
+    log_header_t header;
+    struct stat st;
+
+    log->data_fd = open(log->data_path, O_RDWR | O_CREAT, 0644);
+    ESP_RETURN_ON_FALSE(log->data_fd >= 0 && fstat(log->data_fd, &st) == 0, ESP_FAIL, TAG, "open %s fail", log->data_path);
+    if (st.st_size < (off_t)sizeof(header)) {
+        /* Header block, the first block of the ring is free yet */
+        uint8_t *block = log->buf;
+        memset(block, 0, block_size);
+        memcpy(block, &new_header, sizeof(new_header));
+        memcpy(block, LOG_DATA_MAGIC, sizeof(header.magic));
+        ESP_RETURN_ON_ERROR(log_write_at(log->data_fd, 0, block, block_size), TAG, "header write fail");
+        log->blocks = 0;
+    } else {
+        ESP_RETURN_ON_ERROR(log_read_at(log->data_fd, 0, &header, sizeof(header)), TAG, "header read fail");
+        ESP_RETURN_ON_ERROR(log_check_header(&header, LOG_DATA_MAGIC), TAG, "%s has other format", log->data_path);
+        ESP_RETURN_ON_FALSE(header.block_size == block_size, ESP_ERR_INVALID_VERSION, TAG, "%s has block size %"PRIu32, log->data_path, header.block_size);
+        /* Partially written last block is overwritten by the next one */
+        log->blocks = (st.st_size >= (off_t)(2 * block_size)) ? (st.st_size / block_size - 1) : 0;
+    }
+
+    uint32_t entries = 0;
+    log->index_fd = open(log->index_path, O_RDWR | O_CREAT, 0644);
+    ESP_RETURN_ON_FALSE(log->index_fd >= 0 && fstat(log->index_fd, &st) == 0, ESP_FAIL, TAG, "open %s fail", log->index_path);
+    if (st.st_size >= (off_t)sizeof(header) && log_read_at(log->index_fd, 0, &header, sizeof(header)) == ESP_OK &&
+            log_check_header(&header, LOG_INDEX_MAGIC) == ESP_OK && header.block_size == block_size) {
+        entries = (st.st_size - sizeof(header)) / sizeof(int64_t);
+    } else {
+        header = new_header;
+        memcpy(header.magic, LOG_INDEX_MAGIC, sizeof(header.magic));
+        ESP_RETURN_ON_ERROR(log_write_at(log->index_fd, 0, &header, sizeof(header)), TAG, "index header write fail");
+    }
+    if (entries < log->blocks) {
+        ESP_LOGW(TAG, "%"PRIu32" index entries of %s rebuilt", log->blocks - entries, log->data_path);
+    }
+    /* Entries over the blocks are overwritten by the next blocks */
+    for (uint32_t i = entries; i < log->blocks; i++) {
+        int64_t ts;
+        ESP_RETURN_ON_ERROR(log_read_at(log->data_fd, (off_t)(i + 1) * block_size, &ts, sizeof(ts)), TAG, "block read fail");
+        ESP_RETURN_ON_ERROR(log_write_at(log->index_fd, sizeof(header) + (off_t)i * sizeof(int64_t), &ts, sizeof(ts)), TAG, "index write fail");
+    }
+    log->index_entries = log->blocks;
+    ESP_LOGD(TAG, "%s: %"PRIu32" blocks of %d bytes", log->data_path, log->blocks, (int)block_size);
+    return ESP_OK;
+}
+
+static void log_add_sample(esp_sensor_log_handle_t log, const esp_sensor_hub_data_t *data)
+{
+    if (log->block == NULL) {
+        uint8_t *block = NULL;
+        if (xQueueReceive(log->free_queue, &block, 0) != pdTRUE) {
+            /* All blocks wait for writing */
+            portENTER_CRITICAL(&log->lock);
+            log->stats.records_dropped++;
+            portEXIT_CRITICAL(&log->lock);
+            return;
+        }
+        log->block = (esp_sensor_log_record_t *)block;
+        log->records = 0;
+        log->open_time = esp_timer_get_time();
+        /* System time can be set meanwhile (e.g. by SNTP) */
+        log->time_offset_us = log_system_time_us() - log->open_time;
+    }
+
+    esp_sensor_log_record_t *r = &log->block[log->records++];
+    memset(r, 0, sizeof(*r));
+    r->timestamp_us = data->timestamp_us + log->time_offset_us;
+    r->sensor_id = data->sensor_id;
+    r->value_num = (data->value_num > ESP_SENSOR_HUB_VALUES_MAX) ? ESP_SENSOR_HUB_VALUES_MAX : data->value_num;
+    memcpy(r->values, data->values, r->value_num * sizeof(float));
+
+    portENTER_CRITICAL(&log->lock);
+    log->stats.records++;
+    portEXIT_CRITICAL(&log->lock);
+
+    if (log->records * sizeof(esp_sensor_log_record_t) == log->config.block_size) {
+        log_close_block(log);
+    }
+}
+
+static void log_close_block(esp_sensor_log_handle_t log)
+{
+    if (log->block == NULL) {
+        return;
+    }
+    /* Padding records have ESP_SENSOR_LOG_ID_NONE */
+    const size_t used = log->records * sizeof(esp_sensor_log_record_t);
+    memset((uint8_t *)log->block + used, 0xFF, log->config.block_size - used);
+    xQueueSend(log->full_queue, &log->block, portMAX_DELAY);
+    log->block = NULL;
+}
+
+/* Index entries are written in order, so there is no hole in the index, entries of failed writes are read from the blocks */
+static esp_err_t log_write_index(esp_sensor_log_handle_t log, int64_t last_us)
+{
+    const size_t block_size = log->config.block_size;
+    while (log->index_entries < log->blocks) {
+        const uint32_t i = log->index_entries;
+        int64_t ts = last_us;
+        if (i + 1 < log->blocks) {
+            ESP_RETURN_ON_ERROR(log_read_at(log->data_fd, (off_t)(i + 1) * block_size, &ts, sizeof(ts)), TAG, "block read fail");
+        }
+        ESP_RETURN_ON_ERROR(log_write_at(log->index_fd, sizeof(log_header_t) + (off_t)i * sizeof(int64_t), &ts, sizeof(ts)), TAG, "index write fail");
+        log->index_entries++;
+    }
+    return ESP_OK;
+}
+
+static void log_sync(esp_sensor_log_handle_t log)
+{
+    fsync(log->data_fd);
+    fsync(log->index_fd);
+    log->unsynced = 0;
+}
+
+static void log_writer_task(void *arg)
+{
+    esp_sensor_log_handle_t log = arg;
+    const size_t block_size = log->config.block_size;
+
+    while (1) {
+        uint8_t *block = NULL;
+        xQueueReceive(log->full_queue, &block, portMAX_DELAY);
+        if (block == LOG_REQ_SYNC || block == LOG_REQ_STOP) {
+            log_sync(log);
+            if (block == LOG_REQ_STOP) {
+                break;
+            }
+            xSemaphoreGive(log->synced);
+            continue;
+        }
+
+        /* Block and then its index entry, a failed entry is written again before the entry of the next block */
+        const int64_t start = esp_timer_get_time();
+        const int64_t first_us = ((const esp_sensor_log_record_t *)block)->timestamp_us;
+        const esp_err_t data_ret = log_write_at(log->data_fd, (off_t)(log->blocks + 1) * block_size, block, block_size);
+        esp_err_t index_ret = ESP_FAIL;
+        if (data_ret == ESP_OK) {
+            log->blocks++;
+            index_ret = log_write_index(log, first_us);
+        }
+        const uint32_t write_us = (uint32_t)(esp_timer_get_time() - start);
+
+        portENTER_CRITICAL(&log->lock);
+        if (data_ret == ESP_OK) {
+            log->stats.blocks++;
+        } else {
+            uint32_t lost = 0;
+            const esp_sensor_log_record_t *r = (const esp_sensor_log_record_t *)block;
+            while (lost < block_size / sizeof(esp_sensor_log_record_t) && r[lost].sensor_id != ESP_SENSOR_LOG_ID_NONE) {
+                lost++;
+            }
+            log->stats.records_dropped += lost;
+        }
+        if (data_ret != ESP_OK || index_ret != ESP_OK) {
+            log->stats.write_errors++;
+        }
+        if (write_us > log->stats.max_write_us) {
+            log->stats.max_write_us = write_us;
+        }
+        portEXIT_CRITICAL(&log->lock);
+
+        xQueueSend(log->free_queue, &block, 0);
+        if (log->config.sync_blocks && ++log->unsynced >= log->config.sync_blocks) {
+            log_sync(log);
+        }
+    }
+
+    xSemaphoreGive(log->synced);
+    vTaskDelete(NULL);
+}
+
+static void log_task(void *arg)
+{
+    esp_sensor_log_handle_t log = arg;
+    const int64_t max_delay_us = (int64_t)log->config.max_delay_ms * 1000;
+    const uint8_t *req = LOG_REQ_SYNC;
+    ESP_LOGD(TAG, "Started, %d blocks of %d bytes", log->config.block_num, (int)log->config.block_size);
+
+    while (!log->stop) {
+        int timeout_ms = LOG_POLL_MS;
+        if (log->block) {
+            const int64_t left_us = log->open_time + max_delay_us - esp_timer_get_time();
+            timeout_ms = (left_us <= 0) ? 0 : (int)((left_us + 999) / 1000);
+            if (timeout_ms > LOG_POLL_MS) {
+                timeout_ms = LOG_POLL_MS;
+            }
+        }
+
+        /* All buffered samples are stored at once */
+        esp_sensor_hub_data_t data;
+        if (esp_sensor_hub_receive(log->sub, &data, timeout_ms) == ESP_OK) {
+            do {
+                log_add_sample(log, &data);
+            } while (esp_sensor_hub_receive(log->sub, &data, 0) == ESP_OK);
+        }
+
+        /* Time threshold */
+        if (log->block && (log->flush || esp_timer_get_time() - log->open_time >= max_delay_us)) {
+            log_close_block(log);
+        }
+        if (log->flush) {
+            log->flush = false;
+            xQueueSend(log->full_queue, &req, portMAX_DELAY);
+        }
+
+        const uint32_t hub_dropped = esp_sensor_hub_get_dropped(log->sub);
+        if (hub_dropped != log->hub_dropped) {
+            portENTER_CRITICAL(&log->lock);
+            log->stats.records_dropped += hub_dropped - log->hub_dropped;
+            portEXIT_CRITICAL(&log->lock);
+            log->hub_dropped = hub_dropped;
+        }
+    }
+
+    /* Writer exits after the last block and fsync */
+    log_close_block(log);
+    req = LOG_REQ_STOP;
+    xQueueSend(log->full_queue, &req, portMAX_DELAY);
+    xSemaphoreTake(log->synced, portMAX_DELAY);
+
+    xSemaphoreGive(log->stopped);
+    vTaskDelete(NULL);
+}
+
+static esp_err_t reader_load(esp_sensor_log_reader_handle_t rd, uint32_t block)
+{
+    if (rd->loaded == block) {
+        return ESP_OK;
+    }
+    rd->loaded = -1;
+    ESP_RETURN_ON_ERROR(log_read_at(rd->fd, (off_t)(block + 1) * rd->block_size, rd->buf, rd->block_size), TAG, "read fail");
+    rd->loaded = block;
+    return ESP_OK;
+}
@@ -0,0 +1,266 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sensor log: binary records of sensor hub samples written in blocks to a file with time index
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_sensor_hub.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Version of the file format (in the header of data and index file)
+ */
+#define ESP_SENSOR_LOG_FORMAT_VERSION   (1)
+
+/**
+ * @brief Sensor ID of padding records at the end of a partially filled block
+ */
+#define ESP_SENSOR_LOG_ID_NONE          (0xFF)
+
+/**
+ * @brief Minimal size of one block (the block size must be a multiple of it)
+ */
+#define ESP_SENSOR_LOG_BLOCK_SIZE_MIN   (512)
+
+/**
+ * @brief One record of the log (32 bytes, little endian)
+ */
+typedef struct {
+    int64_t  timestamp_us;      /*!< Time of the measurement [us], system time (gettimeofday) or time since boot, when it is not set */
+    uint8_t  sensor_id;         /*!< Sensor ID in the hub (ESP_SENSOR_LOG_ID_NONE: padding) */
+    uint8_t  value_num;         /*!< Count of valid values */
+    uint8_t  reserved[6];       /*!< Zero */
+    float    values[ESP_SENSOR_HUB_VALUES_MAX]; /*!< Measured values */
+} esp_sensor_log_record_t;
+
+/**
+ * @brief Sensor log writer handle
+ */
+typedef struct esp_sensor_log_s *esp_sensor_log_handle_t;
+
+/**
+ * @brief Sensor log reader handle
+ */
+typedef struct esp_sensor_log_reader_s *esp_sensor_log_reader_handle_t;
+
+/**
+ * @brief Sensor log writer configuration
+ */
+typedef struct {
+    esp_sensor_hub_handle_t hub;        /*!< Sensor hub (stopped, the writer subscribes to it) */
+    uint32_t sensor_mask;               /*!< Bit mask of logged sensor IDs (BIT(id)) */
+    size_t   queue_len;                 /*!< Count of samples buffered by the hub subscriber */
+    const char *path;                   /*!< Path of the log without extension, data are in path.bin and index in path.idx (copied) */
+    size_t   block_size;                /*!< Size of one write in bytes, multiple of ESP_SENSOR_LOG_BLOCK_SIZE_MIN (e.g. cluster size of FAT) */
+    uint8_t  block_num;                 /*!< Count of blocks in the ring buffer (one is filled, the others wait for writing) */
+    uint32_t buffer_caps;               /*!< Heap capabilities of the ring buffer (internal RAM is used, when it cannot be allocated) */
+    uint32_t max_delay_ms;              /*!< Maximal time from the first record of a block to its writing (partially filled block is padded) */
+    uint32_t sync_blocks;               /*!< Files are synchronized (fsync) after this count of blocks (0: only by flush and delete) */
+    uint32_t task_priority;             /*!< Priority of the writer tasks */
+    uint32_t task_stack;                /*!< Stack of the writer tasks */
+    int      task_affinity;             /*!< Core of the writer tasks (-1: no affinity) */
+} esp_sensor_log_config_t;
+
+/**
+ * @brief Default sensor log writer configuration (hub, sensor_mask and path must be filled)
+ */
+#define ESP_SENSOR_LOG_DEFAULT_CONFIG()         \
+    {                                           \
+        .queue_len = 32,                        \
+        .block_size = 4096,                     \
+        .block_num = 8,                         \
+        .buffer_caps = MALLOC_CAP_SPIRAM,       \
+        .max_delay_ms = 60000,                  \
+        .sync_blocks = 16,                      \
+        .task_priority = 3,                     \
+        .task_stack = 4096,                     \
+        .task_affinity = -1,                    \
+    }
+
+/**
+ * @brief Statistics of sensor log writer
+ */
+typedef struct {
+    uint32_t period_ms;             /*!< Time since the start or the last reset of statistics (for rates) */
+    uint32_t records;               /*!< Samples stored to blocks */
+    uint32_t blocks;                /*!< Blocks written to the file */
+    uint32_t records_dropped;       /*!< Samples lost in full subscriber buffer, without free block or in failed writes */
+    uint32_t write_errors;          /*!< Failed writes of blocks or index entries */
+    uint32_t max_write_us;          /*!< Longest write of one block with its index entry */
+} esp_sensor_log_stats_t;
+
+/**
+ * @brief Create sensor log writer and start its tasks
+ *
+ * Samples of the selected sensors are stored as fixed size records (esp_sensor_log_record_t) into blocks
+ * of a preallocated ring buffer (block_num * block_size bytes, in PSRAM by default). Full blocks are written
+ * by a second task, so the subscriber is served during slow writes of SD card. A block is written, when it is
+ * full or max_delay_ms after its first record (the rest is padded by records with ESP_SENSOR_LOG_ID_NONE).
+ * Samples are dropped, when all blocks wait for writing.
+ *
+ * Data file (path.bin) starts with a header block, then every block is one write at offset aligned to block_size.
+ * Index file (path.idx) has a header and timestamp of the first record (int64) of every data block.
+ * Existing log of the same format is appended, missing index entries are rebuilt from the data file.
+ *
+ * @note The hub must be stopped (writer subscribes to it). The file system must stay mounted until esp_sensor_log_del().
+ *
+ * @param config        writer configuration
+ * @param ret_handle    output writer handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or invalid
+ *      - ESP_ERR_INVALID_STATE     if the hub is running
+ *      - ESP_ERR_INVALID_VERSION   if the existing log has other format or block size
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ *      - ESP_FAIL                  if the files cannot be opened or written
+ */
+esp_err_t esp_sensor_log_new(const esp_sensor_log_config_t *config, esp_sensor_log_handle_t *ret_handle);
+
+/**
+ * @brief Stop and delete sensor log writer
+ *
+ * The block in progress and the waiting blocks are written and the files are synchronized and closed.
+ *
+ * @note It must be called before esp_sensor_hub_del(). The subscriber is removed from the stopped hub, the subscriber
+ *       of the running hub stays in it until esp_sensor_hub_del().
+ *
+ * @param handle        writer handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_sensor_log_del(esp_sensor_log_handle_t handle);
+
+/**
+ * @brief Write the block in progress and synchronize the files
+ *
+ * Records logged before the call can be read by a reader opened after it.
+ *
+ * @param handle        writer handle
+ * @param timeout_ms    maximal wait for the writing
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_TIMEOUT           if the blocks are not written in time
+ */
+esp_err_t esp_sensor_log_flush(esp_sensor_log_handle_t handle, int timeout_ms);
+
+/**
+ * @brief Get statistics of sensor log writer
+ *
+ * @param handle        writer handle
+ * @param stats         output statistics
+ * @param reset         reset the counters after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_sensor_log_get_stats(esp_sensor_log_handle_t handle, esp_sensor_log_stats_t *stats, bool reset);
+
+/**
+ * @brief Open sensor log for reading
+ *
+ * The index is read into memory (8 bytes per block, in PSRAM when available), so the seeks are binary searches
+ * in it and read only one block of data. Blocks written after the opening are not seen.
+ *
+ * @param path          path of the log without extension
+ * @param ret_reader    output reader handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NOT_FOUND         if the data file does not exist
+ *      - ESP_ERR_INVALID_VERSION   if the file has other format
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_sensor_log_reader_open(const char *path, esp_sensor_log_reader_handle_t *ret_reader);
+
+/**
+ * @brief Close sensor log reader
+ *
+ * @param reader        reader handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_sensor_log_reader_close(esp_sensor_log_reader_handle_t reader);
+
+/**
+ * @brief Get time range of the log
+ *
+ * @param reader        reader handle
+ * @param first_us      output timestamp of the first record
+ * @param last_us       output timestamp of the last record
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NOT_FOUND         if the log is empty
+ */
+esp_err_t esp_sensor_log_reader_get_range(esp_sensor_log_reader_handle_t reader, int64_t *first_us, int64_t *last_us);
+
+/**
+ * @brief Move the reader to the records at or after the timestamp
+ *
+ * Binary search in the index, the reading starts one block before the found one, because the samples of sensors
+ * with longer conversion can be logged after newer samples. Records older than timestamp_us are skipped by
+ * esp_sensor_log_reader_next().
+ *
+ * @param reader        reader handle
+ * @param timestamp_us  timestamp of the first returned record (INT64_MIN: start of the log)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_sensor_log_reader_seek(esp_sensor_log_reader_handle_t reader, int64_t timestamp_us);
+
+/**
+ * @brief Read the next record
+ *
+ * @param reader        reader handle
+ * @param record        output record
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NOT_FOUND         at the end of the log
+ *      - ESP_FAIL                  if the file cannot be read
+ */
+esp_err_t esp_sensor_log_reader_next(esp_sensor_log_reader_handle_t reader, esp_sensor_log_record_t *record);
+
+/**
+ * @brief Get points of a graph of one value
+ *
+ * Time range is divided into num intervals. Every point is the mean of the value in the records of the sensor
+ * in the first block of its interval, so at most one block is read per point, not the whole range.
+ *
+ * @param reader        reader handle
+ * @param sensor_id     sensor ID
+ * @param value_index   index of the value in the records
+ * @param start_us      start of the time range
+ * @param end_us        end of the time range
+ * @param points        output points (NAN: no record in the interval)
+ * @param num           count of points
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or invalid
+ *      - ESP_FAIL                  if the file cannot be read
+ */
+esp_err_t esp_sensor_log_reader_plot(esp_sensor_log_reader_handle_t reader, uint8_t sensor_id, uint8_t value_index,
+                                     int64_t start_us, int64_t end_us, float *points, size_t num);
+
+#ifdef __cplusplus
+}
+#endif
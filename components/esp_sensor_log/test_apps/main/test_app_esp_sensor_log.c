@@ -0,0 +1,225 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include "unity.h"
+#include "esp_bit_defs.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_vfs_fat.h"
+#include "esp_sensor_log.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+static const char *TAG = "sensor log test";
+
+#define TEST_MOUNT_POINT    "/data"
+#define TEST_LOG_PATH       TEST_MOUNT_POINT "/test"
+
+static wl_handle_t test_wl = WL_INVALID_HANDLE;
+
+static esp_err_t test_sensor_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
+{
+    uint32_t *reads = ctx;
+    data->value_num = 1;
+    data->values[0] = ++(*reads);
+    return ESP_OK;
+}
+
+static const esp_sensor_hub_sensor_ops_t test_sensor_ops = {
+    .read = test_sensor_read,
+};
+
+/* FAT in flash with the log files removed */
+static void test_mount(void)
+{
+    const esp_vfs_fat_mount_config_t mount_cfg = {
+        .format_if_mount_failed = true,
+        .max_files = 4,
+        .allocation_unit_size = 4096,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_vfs_fat_spiflash_mount_rw_wl(TEST_MOUNT_POINT, "storage", &mount_cfg, &test_wl));
+    unlink(TEST_LOG_PATH ".bin");
+    unlink(TEST_LOG_PATH ".idx");
+}
+
+static void test_unmount(void)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, esp_vfs_fat_spiflash_unmount_rw_wl(TEST_MOUNT_POINT, test_wl));
+    test_wl = WL_INVALID_HANDLE;
+}
+
+static void test_setup(uint32_t period_ms, uint32_t *reads, esp_sensor_hub_handle_t *hub, uint8_t *id)
+{
+    const esp_sensor_hub_config_t hub_cfg = ESP_SENSOR_HUB_DEFAULT_CONFIG();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_new(&hub_cfg, hub));
+    const esp_sensor_hub_sensor_config_t sensor_cfg = {
+        .name = "test",
+        .period_ms = period_ms,
+        .ops = &test_sensor_ops,
+        .user_ctx = reads,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_add_sensor(*hub, &sensor_cfg, id));
+}
+
+/* Log the sensor for run_ms, block of 512 B holds 16 records */
+static void test_log(esp_sensor_hub_handle_t hub, uint8_t id, uint32_t run_ms, esp_sensor_log_stats_t *stats)
+{
+    esp_sensor_log_handle_t log = NULL;
+    esp_sensor_log_config_t log_cfg = ESP_SENSOR_LOG_DEFAULT_CONFIG();
+    log_cfg.hub = hub;
+    log_cfg.sensor_mask = BIT(id);
+    log_cfg.path = TEST_LOG_PATH;
+    log_cfg.block_size = ESP_SENSOR_LOG_BLOCK_SIZE_MIN;
+    log_cfg.block_num = 16;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_new(&log_cfg, &log));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_start(hub));
+    vTaskDelay(pdMS_TO_TICKS(run_ms));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_stop(hub));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_flush(log, 1000));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_get_stats(log, stats, false));
+    ESP_LOGI(TAG, "%"PRIu32" ms: records %"PRIu32", blocks %"PRIu32", dropped %"PRIu32", errors %"PRIu32", max write %"PRIu32" us",
+             stats->period_ms, stats->records, stats->blocks, stats->records_dropped, stats->write_errors, stats->max_write_us);
+    TEST_ASSERT_EQUAL(0, stats->records_dropped);
+    TEST_ASSERT_EQUAL(0, stats->write_errors);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_del(log));
+}
+
+TEST_CASE("Sensor log writes, appends and reads records", "[sensor_log]")
+{
+    esp_sensor_hub_handle_t hub = NULL;
+    uint32_t reads = 0;
+    uint8_t id;
+    test_mount();
+    test_setup(5, &reads, &hub, &id);
+
+    esp_sensor_log_config_t log_cfg = ESP_SENSOR_LOG_DEFAULT_CONFIG();
+    esp_sensor_log_handle_t log = NULL;
+    log_cfg.hub = hub;
+    log_cfg.sensor_mask = BIT(id);
+    log_cfg.path = TEST_LOG_PATH;
+    log_cfg.block_size = 1000;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_sensor_log_new(&log_cfg, &log));
+
+    esp_sensor_log_stats_t stats;
+    test_log(hub, id, 500, &stats);
+    const uint32_t first_records = stats.records;
+    TEST_ASSERT_EQUAL(reads, first_records);
+    TEST_ASSERT_GREATER_THAN(5, stats.blocks);
+
+    /* Other block size does not match the existing log */
+    log_cfg.block_size = 2 * ESP_SENSOR_LOG_BLOCK_SIZE_MIN;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_VERSION, esp_sensor_log_new(&log_cfg, &log));
+
+    /* Deleted writer unsubscribes, more writers than max_subscribers of the hub are created one by one */
+    log_cfg.block_size = ESP_SENSOR_LOG_BLOCK_SIZE_MIN;
+    log_cfg.block_num = 16;
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_new(&log_cfg, &log));
+        TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_del(log));
+    }
+
+    test_log(hub, id, 500, &stats);
+    TEST_ASSERT_EQUAL(reads, first_records + stats.records);
+
+    esp_sensor_log_reader_handle_t rd = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_open(TEST_LOG_PATH, &rd));
+    int64_t first_us, last_us;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_get_range(rd, &first_us, &last_us));
+    TEST_ASSERT_LESS_THAN(last_us, first_us);
+
+    /* Values are the read counter, padding records are skipped */
+    esp_sensor_log_record_t rec;
+    uint32_t count = 0;
+    while (esp_sensor_log_reader_next(rd, &rec) == ESP_OK) {
+        count++;
+        TEST_ASSERT_EQUAL(id, rec.sensor_id);
+        TEST_ASSERT_EQUAL(1, rec.value_num);
+        TEST_ASSERT_EQUAL_FLOAT(count, rec.values[0]);
+    }
+    TEST_ASSERT_EQUAL(reads, count);
+    TEST_ASSERT_EQUAL(last_us, rec.timestamp_us);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_close(rd));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_del(hub));
+    test_unmount();
+}
+
+TEST_CASE("Sensor log seeks by time and plots", "[sensor_log]")
+{
+    esp_sensor_hub_handle_t hub = NULL;
+    uint32_t reads = 0;
+    uint8_t id;
+    test_mount();
+    test_setup(5, &reads, &hub, &id);
+
+    esp_sensor_log_stats_t stats;
+    test_log(hub, id, 1000, &stats);
+    TEST_ASSERT_EQUAL(reads, stats.records);
+
+    esp_sensor_log_reader_handle_t rd = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_open(TEST_LOG_PATH, &rd));
+    int64_t first_us, last_us;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_get_range(rd, &first_us, &last_us));
+
+    /* Records from the middle of the log, none of them is older */
+    const int64_t middle_us = first_us + (last_us - first_us) / 2;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_seek(rd, middle_us));
+    esp_sensor_log_record_t rec;
+    uint32_t count = 0;
+    float first_value = NAN;
+    while (esp_sensor_log_reader_next(rd, &rec) == ESP_OK) {
+        TEST_ASSERT_GREATER_OR_EQUAL(middle_us, rec.timestamp_us);
+        if (count++ == 0) {
+            first_value = rec.values[0];
+        }
+    }
+    TEST_ASSERT_INT_WITHIN(reads / 10, reads / 2, count);
+    TEST_ASSERT_EQUAL_FLOAT(reads - count + 1, first_value);
+
+    /* Seek after the end */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_seek(rd, last_us + 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_sensor_log_reader_next(rd, &rec));
+
+    /* Counter grows, so the points grow too */
+    float points[10];
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_sensor_log_reader_plot(rd, id, 0, last_us, first_us, points, 10));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_plot(rd, id, 0, first_us, last_us, points, 10));
+    for (int i = 1; i < 10; i++) {
+        TEST_ASSERT_FALSE(isnan(points[i]));
+        TEST_ASSERT_GREATER_THAN(points[i - 1], points[i]);
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_plot(rd, id + 1, 0, first_us, last_us, points, 10));
+    TEST_ASSERT_TRUE(isnan(points[0]));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_log_reader_close(rd));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_del(hub));
+    test_unmount();
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (400)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
@@ -0,0 +1,370 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_sensor_telemetry.h"
+
+static const char *TAG = "TELEMETRY";
+
+/* Longest wait for samples, flush and stop requests are served after it */
+#define TELEMETRY_POLL_MS           (100)
+
+/* CBOR major types (RFC 8949) */
+#define CBOR_UINT                   (0 << 5)
+#define CBOR_NINT                   (1 << 5)
+#define CBOR_ARRAY                  (4 << 5)
+#define CBOR_ARRAY_INDEF            (0x9F)
+#define CBOR_FLOAT32                (0xFA)
+#define CBOR_BREAK                  (0xFF)
+
+/* Frame header: array(3), version, t0 (up to uint64) and start of indefinite array */
+#define TELEMETRY_HEADER_MAX        (1 + 1 + 9 + 1)
+/* Sample: array, sensor ID, time offset (up to int64) and float32 values */
+#define TELEMETRY_SAMPLE_MAX        (1 + 2 + 9 + ESP_SENSOR_HUB_VALUES_MAX * 5)
+
+_Static_assert(TELEMETRY_HEADER_MAX + TELEMETRY_SAMPLE_MAX + 1 <= ESP_SENSOR_TELEMETRY_FRAME_SIZE_MIN, "Too small minimal frame");
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    size_t len;                 /* Encoded bytes */
+    uint32_t samples;           /* 0: frame is not open */
+} telemetry_frame_t;
+
+struct esp_sensor_telemetry_s {
+    esp_sensor_telemetry_config_t config;
+    char *topic;
+    esp_sensor_hub_sub_handle_t sub;
+    uint8_t *buf;               /* frame_num * frame_size bytes */
+    telemetry_frame_t *frames;
+    uint8_t head;               /* Frame in progress */
+    uint8_t tail;               /* Oldest complete frame */
+    uint8_t pending;            /* Complete frames from tail */
+    int64_t t0;                 /* Timestamp of the first sample in the frame in progress */
+    int64_t open_time;          /* Time of the first sample in the frame in progress */
+    uint32_t hub_dropped;       /* Last dropped count of the subscriber */
+    portMUX_TYPE lock;          /* Lock of statistics */
+    esp_sensor_telemetry_stats_t stats;
+    int64_t stats_start;
+    TaskHandle_t task;
+    volatile bool stop;
+    volatile bool flush;
+    SemaphoreHandle_t stopped;  /* Given by the task before exit */
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void telemetry_task(void *arg);
+static void telemetry_add_sample(esp_sensor_telemetry_handle_t tel, const esp_sensor_hub_data_t *data);
+static void telemetry_close_frame(esp_sensor_telemetry_handle_t tel);
+static void telemetry_publish(esp_sensor_telemetry_handle_t tel);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_sensor_telemetry_new(const esp_sensor_telemetry_config_t *config, esp_sensor_telemetry_handle_t *ret_handle)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_handle && config->hub && config->client && config->topic, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->frame_size >= ESP_SENSOR_TELEMETRY_FRAME_SIZE_MIN && config->frame_num >= 2 && config->max_delay_ms > 0,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid frame config");
+
+    esp_sensor_telemetry_handle_t tel = calloc(1, sizeof(struct esp_sensor_telemetry_s));
+    ESP_RETURN_ON_FALSE(tel, ESP_ERR_NO_MEM, TAG, "Not enough memory for telemetry");
+    tel->config = *config;
+    portMUX_INITIALIZE(&tel->lock);
+
+    tel->topic = strdup(config->topic);
+    tel->buf = malloc(config->frame_num * config->frame_size);
+    tel->frames = calloc(config->frame_num, sizeof(telemetry_frame_t));
+    tel->stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(tel->topic && tel->buf && tel->frames && tel->stopped, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for telemetry");
+    tel->config.topic = tel->topic;
+
+    ESP_GOTO_ON_ERROR(esp_sensor_hub_subscribe(config->hub, config->sensor_mask, config->queue_len, &tel->sub), err, TAG, "subscribe fail");
+    tel->stats_start = esp_timer_get_time();
+
+    BaseType_t res;
+    if (config->task_affinity < 0) {
+        res = xTaskCreate(telemetry_task, "telemetry", config->task_stack, tel, config->task_priority, &tel->task);
+    } else {
+        res = xTaskCreatePinnedToCore(telemetry_task, "telemetry", config->task_stack, tel, config->task_priority, &tel->task,
+                                      config->task_affinity);
+    }
+    if (res != pdPASS) {
+        tel->task = NULL;
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_NO_MEM, err, TAG, "Create telemetry task fail!");
+    }
+
+    *ret_handle = tel;
+    return ESP_OK;
+
+err:
+    esp_sensor_telemetry_del(tel);
+    return ret;
+}
+
+esp_err_t esp_sensor_telemetry_del(esp_sensor_telemetry_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    if (handle->task) {
+        handle->stop = true;
+        xSemaphoreTake(handle->stopped, portMAX_DELAY);
+    }
+    if (handle->stopped) {
+        vSemaphoreDelete(handle->stopped);
+    }
+    free(handle->frames);
+    free(handle->buf);
+    free(handle->topic);
+    free(handle);
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_telemetry_flush(esp_sensor_telemetry_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    handle->flush = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_sensor_telemetry_get_stats(esp_sensor_telemetry_handle_t handle, esp_sensor_telemetry_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(handle && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&handle->lock);
+    *stats = handle->stats;
+    stats->period_ms = (uint32_t)((now - handle->stats_start) / 1000);
+    if (reset) {
+        const uint8_t pending = handle->stats.frames_pending;
+        memset(&handle->stats, 0, sizeof(handle->stats));
+        handle->stats.frames_pending = pending;
+        handle->stats.frames_pending_max = pending;
+        handle->stats_start = now;
+    }
+    portEXIT_CRITICAL(&handle->lock);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static uint8_t *telemetry_frame_data(esp_sensor_telemetry_handle_t tel, uint8_t index)
+{
+    return tel->buf + (size_t)index * tel->config.frame_size;
+}
+
+/* Head of CBOR item with the shortest encoding of the argument */
+static size_t cbor_put_head(uint8_t *p, uint8_t major, uint64_t arg)
+{
+    if (arg < 24) {
+        p[0] = major | (uint8_t)arg;
+        return 1;
+    }
+    int bytes;
+    if (arg <= UINT8_MAX) {
+        p[0] = major | 24;
+        bytes = 1;
+    } else if (arg <= UINT16_MAX) {
+        p[0] = major | 25;
+        bytes = 2;
+    } else if (arg <= UINT32_MAX) {
+        p[0] = major | 26;
+        bytes = 4;
+    } else {
+        p[0] = major | 27;
+        bytes = 8;
+    }
+    /* Big endian */
+    for (int i = 0; i < bytes; i++) {
+        p[bytes - i] = (uint8_t)(arg >> (8 * i));
+    }
+    return 1 + bytes;
+}
+
+static size_t cbor_put_int(uint8_t *p, int64_t value)
+{
+    if (value < 0) {
+        return cbor_put_head(p, CBOR_NINT, (uint64_t)(-1 - value));
+    }
+    return cbor_put_head(p, CBOR_UINT, (uint64_t)value);
+}
+
+static size_t cbor_put_float(uint8_t *p, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    p[0] = CBOR_FLOAT32;
+    p[1] = (uint8_t)(bits >> 24);
+    p[2] = (uint8_t)(bits >> 16);
+    p[3] = (uint8_t)(bits >> 8);
+    p[4] = (uint8_t)bits;
+    return 5;
+}
+
+static void telemetry_add_sample(esp_sensor_telemetry_handle_t tel, const esp_sensor_hub_data_t *data)
+{
+    telemetry_frame_t *frame = &tel->frames[tel->head];
+    uint8_t *p = telemetry_frame_data(tel, tel->head);
+
+    if (frame->samples == 0) {
+        /* [version, t0, [_ ... */
+        frame->len = cbor_put_head(p, CBOR_ARRAY, 3);
+        frame->len += cbor_put_head(p + frame->len, CBOR_UINT, ESP_SENSOR_TELEMETRY_FORMAT_VERSION);
+        frame->len += cbor_put_int(p + frame->len, data->timestamp_us);
+        p[frame->len++] = CBOR_ARRAY_INDEF;
+        tel->t0 = data->timestamp_us;
+        tel->open_time = esp_timer_get_time();
+    }
+
+    /* Samples of sensors with longer conversion may be older than t0 */
+    const uint8_t value_num = (data->value_num > ESP_SENSOR_HUB_VALUES_MAX) ? ESP_SENSOR_HUB_VALUES_MAX : data->value_num;
+    frame->len += cbor_put_head(p + frame->len, CBOR_ARRAY, 2 + value_num);
+    frame->len += cbor_put_head(p + frame->len, CBOR_UINT, data->sensor_id);
+    frame->len += cbor_put_int(p + frame->len, data->timestamp_us - tel->t0);
+    for (int i = 0; i < value_num; i++) {
+        frame->len += cbor_put_float(p + frame->len, data->values[i]);
+    }
+    frame->samples++;
+
+    portENTER_CRITICAL(&tel->lock);
+    tel->stats.samples++;
+    portEXIT_CRITICAL(&tel->lock);
+
+    /* Size threshold: publish right away, when the next sample may not fit */
+    if (frame->len + TELEMETRY_SAMPLE_MAX + 1 > tel->config.frame_size) {
+        telemetry_close_frame(tel);
+    }
+}
+
+static void telemetry_close_frame(esp_sensor_telemetry_handle_t tel)
+{
+    telemetry_frame_t *frame = &tel->frames[tel->head];
+    if (frame->samples == 0) {
+        return;
+    }
+    telemetry_frame_data(tel, tel->head)[frame->len++] = CBOR_BREAK;
+    tel->head = (tel->head + 1) % tel->config.frame_num;
+    tel->pending++;
+
+    uint32_t lost = 0;
+    if (tel->pending == tel->config.frame_num) {
+        /* No free frame for the next samples, the oldest one is dropped */
+        lost = tel->frames[tel->tail].samples;
+        tel->frames[tel->tail].samples = 0;
+        tel->tail = (tel->tail + 1) % tel->config.frame_num;
+        tel->pending--;
+    }
+
+    portENTER_CRITICAL(&tel->lock);
+    if (lost) {
+        tel->stats.frames_dropped++;
+        tel->stats.samples_dropped += lost;
+    }
+    tel->stats.frames_pending = tel->pending;
+    if (tel->pending > tel->stats.frames_pending_max) {
+        tel->stats.frames_pending_max = tel->pending;
+    }
+    portEXIT_CRITICAL(&tel->lock);
+}
+
+static void telemetry_publish(esp_sensor_telemetry_handle_t tel)
+{
+    while (tel->pending) {
+        const int outbox = esp_mqtt_client_get_outbox_size(tel->config.client);
+        int msg_id = -1;
+        telemetry_frame_t *frame = &tel->frames[tel->tail];
+        if (tel->config.max_outbox_size == 0 || outbox <= tel->config.max_outbox_size) {
+            /* MQTT client copies the frame to its outbox */
+            msg_id = esp_mqtt_client_enqueue(tel->config.client, tel->config.topic, (const char *)telemetry_frame_data(tel, tel->tail),
+                                             frame->len, tel->config.qos, 0, true);
+        }
+
+        portENTER_CRITICAL(&tel->lock);
+        tel->stats.outbox_size = outbox;
+        if (msg_id < 0) {
+            tel->stats.backpressure++;
+        } else {
+            tel->stats.frames++;
+            tel->stats.bytes += frame->len;
+            tel->stats.frames_pending = tel->pending - 1;
+        }
+        portEXIT_CRITICAL(&tel->lock);
+
+        if (msg_id < 0) {
+            /* Frames wait in the ring buffer, next try after the next poll */
+            break;
+        }
+        frame->samples = 0;
+        tel->tail = (tel->tail + 1) % tel->config.frame_num;
+        tel->pending--;
+    }
+}
+
+static void telemetry_task(void *arg)
+{
+    esp_sensor_telemetry_handle_t tel = arg;
+    const int64_t max_delay_us = (int64_t)tel->config.max_delay_ms * 1000;
+    ESP_LOGD(TAG, "Started, %d frames of %d bytes", tel->config.frame_num, (int)tel->config.frame_size);
+
+    while (!tel->stop) {
+        const bool open = (tel->frames[tel->head].samples > 0);
+        int timeout_ms = TELEMETRY_POLL_MS;
+        if (open) {
+            const int64_t left_us = tel->open_time + max_delay_us - esp_timer_get_time();
+            timeout_ms = (left_us <= 0) ? 0 : (int)((left_us + 999) / 1000);
+            if (timeout_ms > TELEMETRY_POLL_MS) {
+                timeout_ms = TELEMETRY_POLL_MS;
+            }
+        }
+
+        /* All buffered samples are encoded at once */
+        esp_sensor_hub_data_t data;
+        if (esp_sensor_hub_receive(tel->sub, &data, timeout_ms) == ESP_OK) {
+            do {
+                telemetry_add_sample(tel, &data);
+            } while (esp_sensor_hub_receive(tel->sub, &data, 0) == ESP_OK);
+        }
+
+        /* Time threshold */
+        if (tel->frames[tel->head].samples > 0 && (tel->flush || esp_timer_get_time() - tel->open_time >= max_delay_us)) {
+            telemetry_close_frame(tel);
+        }
+        tel->flush = false;
+
+        const uint32_t hub_dropped = esp_sensor_hub_get_dropped(tel->sub);
+        if (hub_dropped != tel->hub_dropped) {
+            portENTER_CRITICAL(&tel->lock);
+            tel->stats.samples_dropped += hub_dropped - tel->hub_dropped;
+            portEXIT_CRITICAL(&tel->lock);
+            tel->hub_dropped = hub_dropped;
+        }
+
+        telemetry_publish(tel);
+    }
+
+    telemetry_close_frame(tel);
+    telemetry_publish(tel);
+
+    xSemaphoreGive(tel->stopped);
+    vTaskDelete(NULL);
+}
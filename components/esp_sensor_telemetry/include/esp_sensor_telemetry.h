@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sensor telemetry: batching of sensor hub samples to CBOR frames published by MQTT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "mqtt_client.h"
+#include "esp_sensor_hub.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Version of the frame format (the first item of every frame)
+ */
+#define ESP_SENSOR_TELEMETRY_FORMAT_VERSION (1)
+
+/**
+ * @brief Minimal size of one frame (header, one sample with all values and the end)
+ */
+#define ESP_SENSOR_TELEMETRY_FRAME_SIZE_MIN (64)
+
+/**
+ * @brief Telemetry publisher handle
+ */
+typedef struct esp_sensor_telemetry_s *esp_sensor_telemetry_handle_t;
+
+/**
+ * @brief Telemetry publisher configuration
+ */
+typedef struct {
+    esp_sensor_hub_handle_t hub;        /*!< Sensor hub (stopped, the publisher subscribes to it) */
+    uint32_t sensor_mask;               /*!< Bit mask of published sensor IDs (BIT(id)) */
+    size_t   queue_len;                 /*!< Count of samples buffered by the hub subscriber */
+    esp_mqtt_client_handle_t client;    /*!< MQTT client */
+    const char *topic;                  /*!< MQTT topic of the frames (copied) */
+    int      qos;                       /*!< QoS of the frames */
+    size_t   frame_size;                /*!< Maximal size of one frame in bytes, full frame is published (size threshold) */
+    uint8_t  frame_num;                 /*!< Count of frames in the ring buffer (one is filled, the others wait for publishing) */
+    uint32_t max_delay_ms;              /*!< Maximal time from the first sample of a frame to its publishing (time threshold) */
+    int      max_outbox_size;           /*!< Frames wait in the ring buffer while the MQTT outbox is bigger (0: no limit) */
+    uint32_t task_priority;             /*!< Priority of the publisher task */
+    uint32_t task_stack;                /*!< Stack of the publisher task */
+    int      task_affinity;             /*!< Core of the publisher task (-1: no affinity) */
+} esp_sensor_telemetry_config_t;
+
+/**
+ * @brief Default telemetry publisher configuration (hub, sensor_mask, client and topic must be filled)
+ */
+#define ESP_SENSOR_TELEMETRY_DEFAULT_CONFIG()   \
+    {                                           \
+        .queue_len = 32,                        \
+        .qos = 1,                               \
+        .frame_size = 1024,                     \
+        .frame_num = 4,                         \
+        .max_delay_ms = 5000,                   \
+        .max_outbox_size = 4096,                \
+        .task_priority = 4,                     \
+        .task_stack = 4096,                     \
+        .task_affinity = -1,                    \
+    }
+
+/**
+ * @brief Statistics of telemetry publisher
+ */
+typedef struct {
+    uint32_t period_ms;             /*!< Time since the start or the last reset of statistics (for rates) */
+    uint32_t samples;               /*!< Samples encoded to frames */
+    uint32_t frames;                /*!< Frames passed to MQTT client */
+    uint32_t bytes;                 /*!< Bytes of frames passed to MQTT client */
+    uint32_t samples_dropped;       /*!< Samples lost in full subscriber buffer or in dropped frames */
+    uint32_t frames_dropped;        /*!< Oldest frames dropped from full ring buffer */
+    uint32_t backpressure;          /*!< Publishing deferred due to full MQTT outbox or refused enqueue */
+    uint8_t  frames_pending;        /*!< Complete frames waiting in the ring buffer */
+    uint8_t  frames_pending_max;    /*!< Maximum of frames_pending */
+    int      outbox_size;           /*!< Size of MQTT outbox at the last publishing */
+} esp_sensor_telemetry_stats_t;
+
+/**
+ * @brief Create telemetry publisher and start its task
+ *
+ * Samples of the selected sensors are encoded right from the subscriber buffer into frames in a preallocated
+ * ring buffer (frame_num * frame_size bytes) and the frames are passed to esp_mqtt_client_enqueue() from there,
+ * there is no other allocation or copy in the publisher. A frame is published, when the next sample may not fit
+ * into it or max_delay_ms after its first sample. Frames wait in the ring buffer while the MQTT outbox is
+ * over max_outbox_size (e.g. disconnected broker), the oldest frame is dropped when the ring buffer is full.
+ *
+ * Frame is CBOR array [version, t0, [_ samples]], t0 is timestamp of the first sample in microseconds
+ * (esp_timer_get_time) and every sample is array [sensor_id, timestamp - t0 in microseconds, values...]
+ * with float32 values.
+ *
+ * @note The hub must be stopped (publisher subscribes to it).
+ *
+ * @param config        publisher configuration
+ * @param ret_handle    output publisher handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or invalid
+ *      - ESP_ERR_INVALID_STATE     if the hub is running
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_sensor_telemetry_new(const esp_sensor_telemetry_config_t *config, esp_sensor_telemetry_handle_t *ret_handle);
+
+/**
+ * @brief Stop and delete telemetry publisher
+ *
+ * The frame in progress is closed and passed to MQTT client together with waiting frames, while the outbox allows it.
+ *
+ * @note It must be called before esp_sensor_hub_del(), the subscriber stays in the hub until it.
+ *
+ * @param handle        publisher handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_sensor_telemetry_del(esp_sensor_telemetry_handle_t handle);
+
+/**
+ * @brief Publish the frame in progress without waiting for the thresholds
+ *
+ * @note The frame is closed by the publisher task within 100 ms.
+ *
+ * @param handle        publisher handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_sensor_telemetry_flush(esp_sensor_telemetry_handle_t handle);
+
+/**
+ * @brief Get statistics of telemetry publisher
+ *
+ * @param handle        publisher handle
+ * @param stats         output statistics
+ * @param reset         reset the counters after reading (frames_pending is kept)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_sensor_telemetry_get_stats(esp_sensor_telemetry_handle_t handle, esp_sensor_telemetry_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,201 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "unity.h"
+#include "esp_bit_defs.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "mqtt_client.h"
+#include "esp_sensor_telemetry.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+static const char *TAG = "telemetry test";
+
+static esp_err_t test_sensor_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
+{
+    uint32_t *reads = ctx;
+    data->value_num = 1;
+    data->values[0] = ++(*reads);
+    return ESP_OK;
+}
+
+static const esp_sensor_hub_sensor_ops_t test_sensor_ops = {
+    .read = test_sensor_read,
+};
+
+/* Client is not started, the frames stay in its outbox */
+static void test_setup(uint32_t period_ms, uint32_t *reads, esp_sensor_hub_handle_t *hub, uint8_t *id, esp_mqtt_client_handle_t *client)
+{
+    const esp_sensor_hub_config_t hub_cfg = ESP_SENSOR_HUB_DEFAULT_CONFIG();
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_new(&hub_cfg, hub));
+    const esp_sensor_hub_sensor_config_t sensor_cfg = {
+        .name = "test",
+        .period_ms = period_ms,
+        .ops = &test_sensor_ops,
+        .user_ctx = reads,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_add_sensor(*hub, &sensor_cfg, id));
+
+    const esp_mqtt_client_config_t mqtt_cfg = {
+        .broker.address.uri = "mqtt://127.0.0.1",
+    };
+    *client = esp_mqtt_client_init(&mqtt_cfg);
+    TEST_ASSERT_NOT_NULL(*client);
+}
+
+static void test_print_stats(const esp_sensor_telemetry_stats_t *stats)
+{
+    ESP_LOGI(TAG, "%"PRIu32" ms: samples %"PRIu32", frames %"PRIu32", bytes %"PRIu32", dropped %"PRIu32"/%"PRIu32", backpressure %"PRIu32", outbox %d",
+             stats->period_ms, stats->samples, stats->frames, stats->bytes, stats->samples_dropped, stats->frames_dropped,
+             stats->backpressure, stats->outbox_size);
+}
+
+TEST_CASE("Telemetry publishes full frames", "[telemetry]")
+{
+    esp_sensor_hub_handle_t hub = NULL;
+    esp_mqtt_client_handle_t client = NULL;
+    esp_sensor_telemetry_handle_t tel = NULL;
+    uint32_t reads = 0;
+    uint8_t id;
+    test_setup(10, &reads, &hub, &id, &client);
+
+    esp_sensor_telemetry_config_t tel_cfg = ESP_SENSOR_TELEMETRY_DEFAULT_CONFIG();
+    tel_cfg.hub = hub;
+    tel_cfg.sensor_mask = BIT(id);
+    tel_cfg.client = client;
+    tel_cfg.topic = "test/telemetry";
+    tel_cfg.max_outbox_size = 0;
+    tel_cfg.frame_size = 16;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_sensor_telemetry_new(&tel_cfg, &tel));
+    tel_cfg.frame_size = ESP_SENSOR_TELEMETRY_FRAME_SIZE_MIN;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_new(&tel_cfg, &tel));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_start(hub));
+    vTaskDelay(pdMS_TO_TICKS(500));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_stop(hub));
+    vTaskDelay(pdMS_TO_TICKS(200));
+
+    esp_sensor_telemetry_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_get_stats(tel, &stats, true));
+    test_print_stats(&stats);
+    TEST_ASSERT_EQUAL(reads, stats.samples);
+    TEST_ASSERT_GREATER_THAN(10, stats.frames);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.frames * ESP_SENSOR_TELEMETRY_FRAME_SIZE_MIN, stats.bytes);
+    TEST_ASSERT_EQUAL(0, stats.samples_dropped);
+    TEST_ASSERT_EQUAL(0, stats.backpressure);
+    /* Outbox keeps whole MQTT messages */
+    TEST_ASSERT_GREATER_THAN(stats.bytes, esp_mqtt_client_get_outbox_size(client));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_get_stats(tel, &stats, false));
+    TEST_ASSERT_EQUAL(0, stats.samples);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_del(tel));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_del(hub));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mqtt_client_destroy(client));
+}
+
+TEST_CASE("Telemetry publishes after max delay", "[telemetry]")
+{
+    esp_sensor_hub_handle_t hub = NULL;
+    esp_mqtt_client_handle_t client = NULL;
+    esp_sensor_telemetry_handle_t tel = NULL;
+    uint32_t reads = 0;
+    uint8_t id;
+    test_setup(50, &reads, &hub, &id, &client);
+
+    esp_sensor_telemetry_config_t tel_cfg = ESP_SENSOR_TELEMETRY_DEFAULT_CONFIG();
+    tel_cfg.hub = hub;
+    tel_cfg.sensor_mask = BIT(id);
+    tel_cfg.client = client;
+    tel_cfg.topic = "test/telemetry";
+    tel_cfg.max_outbox_size = 0;
+    tel_cfg.max_delay_ms = 200;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_new(&tel_cfg, &tel));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_start(hub));
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_stop(hub));
+
+    esp_sensor_telemetry_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_get_stats(tel, &stats, false));
+    test_print_stats(&stats);
+    TEST_ASSERT_INT_WITHIN(1, 5, stats.frames);
+
+    /* Flush publishes the frame in progress */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_flush(tel));
+    vTaskDelay(pdMS_TO_TICKS(200));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_get_stats(tel, &stats, false));
+    test_print_stats(&stats);
+    TEST_ASSERT_EQUAL(reads, stats.samples);
+    TEST_ASSERT_EQUAL(0, stats.frames_pending);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_del(tel));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_del(hub));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mqtt_client_destroy(client));
+}
+
+TEST_CASE("Telemetry backpressure drops oldest frames", "[telemetry]")
+{
+    esp_sensor_hub_handle_t hub = NULL;
+    esp_mqtt_client_handle_t client = NULL;
+    esp_sensor_telemetry_handle_t tel = NULL;
+    uint32_t reads = 0;
+    uint8_t id;
+    test_setup(10, &reads, &hub, &id, &client);
+
+    esp_sensor_telemetry_config_t tel_cfg = ESP_SENSOR_TELEMETRY_DEFAULT_CONFIG();
+    tel_cfg.hub = hub;
+    tel_cfg.sensor_mask = BIT(id);
+    tel_cfg.client = client;
+    tel_cfg.topic = "test/telemetry";
+    tel_cfg.frame_size = ESP_SENSOR_TELEMETRY_FRAME_SIZE_MIN;
+    tel_cfg.frame_num = 3;
+    /* Only the first frame fits to the outbox */
+    tel_cfg.max_outbox_size = 1;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_new(&tel_cfg, &tel));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_start(hub));
+    vTaskDelay(pdMS_TO_TICKS(500));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_stop(hub));
+    vTaskDelay(pdMS_TO_TICKS(200));
+
+    esp_sensor_telemetry_stats_t stats;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_get_stats(tel, &stats, false));
+    test_print_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.frames);
+    TEST_ASSERT_GREATER_THAN(0, stats.backpressure);
+    TEST_ASSERT_GREATER_THAN(0, stats.frames_dropped);
+    TEST_ASSERT_EQUAL(tel_cfg.frame_num - 1, stats.frames_pending);
+    TEST_ASSERT_EQUAL(tel_cfg.frame_num - 1, stats.frames_pending_max);
+    TEST_ASSERT_EQUAL(reads, stats.samples);
+    TEST_ASSERT_GREATER_THAN(0, stats.samples_dropped);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_telemetry_del(tel));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_sensor_hub_del(hub));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_mqtt_client_destroy(client));
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (400)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
@@ -0,0 +1,371 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_idf_version.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_task_monitor.h"
+
+static const char *TAG = "TASK_MONITOR";
+
+#define TASK_MONITOR_SUPPORTED          (CONFIG_FREERTOS_USE_TRACE_FACILITY && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
+
+#define TASK_MONITOR_PERIOD_DEFAULT     (5000)
+#define TASK_MONITOR_MAX_TASKS_DEFAULT  (32)
+#define TASK_MONITOR_PRIORITY_DEFAULT   (1)
+#define TASK_MONITOR_STACK_DEFAULT      (3072)
+/* Reserve of the snapshot array for tasks created between the count and the snapshot */
+#define TASK_MONITOR_TASKS_RESERVE      (4)
+/* Length of one line of the formatted report */
+#define TASK_MONITOR_LINE_LEN           (32 + configMAX_TASK_NAME_LEN)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+#ifdef configRUN_TIME_COUNTER_TYPE
+typedef configRUN_TIME_COUNTER_TYPE esp_task_monitor_counter_t;
+#else
+typedef uint32_t esp_task_monitor_counter_t;
+#endif
+
+/* Run time counter of one task in the previous snapshot */
+typedef struct {
+    TaskHandle_t                handle;
+    esp_task_monitor_counter_t  counter;
+} esp_task_monitor_prev_t;
+
+struct esp_task_monitor_s {
+    uint32_t                period_ms;
+    uint16_t                max_tasks;
+    esp_task_monitor_report_cb_t report_cb;
+    void                    *user_ctx;
+    bool                    log;
+    TaskHandle_t            task;
+    SemaphoreHandle_t       lock;       /* Protects the report */
+    SemaphoreHandle_t       done_sem;   /* Given by the task when it exits */
+    volatile bool           exit;
+
+#if TASK_MONITOR_SUPPORTED
+    TaskStatus_t            *status;    /* Snapshot of all tasks */
+    esp_task_monitor_prev_t *prev;      /* Counters of the previous snapshot */
+    esp_task_monitor_task_t *all;       /* All tasks of the period before sorting */
+    size_t                  capacity;   /* Length of the arrays above */
+    size_t                  prev_count;
+    esp_task_monitor_counter_t prev_total;
+    int64_t                 prev_time;
+    TaskHandle_t            idle[portNUM_PROCESSORS];
+#endif
+
+    esp_task_monitor_report_t report;   /* Last report */
+    esp_task_monitor_task_t *tasks;     /* Tasks of the last report (max_tasks) */
+    bool                    has_report;
+    char                    *log_buf;
+    size_t                  log_size;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void esp_task_monitor_task(void *arg);
+static esp_err_t esp_task_monitor_sample(esp_task_monitor_handle_t mon, bool report);
+static void esp_task_monitor_free(esp_task_monitor_handle_t mon);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_task_monitor_new(const esp_task_monitor_config_t *config, esp_task_monitor_handle_t *ret_mon)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_mon, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(TASK_MONITOR_SUPPORTED, ESP_ERR_NOT_SUPPORTED, TAG, "Enable CONFIG_FREERTOS_USE_TRACE_FACILITY and CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS");
+
+    esp_task_monitor_handle_t mon = calloc(1, sizeof(struct esp_task_monitor_s));
+    ESP_RETURN_ON_FALSE(mon, ESP_ERR_NO_MEM, TAG, "Not enough memory for task monitor allocation!");
+    mon->period_ms = (config->period_ms ? config->period_ms : TASK_MONITOR_PERIOD_DEFAULT);
+    mon->max_tasks = (config->max_tasks ? config->max_tasks : TASK_MONITOR_MAX_TASKS_DEFAULT);
+    mon->report_cb = config->report_cb;
+    mon->user_ctx = config->user_ctx;
+    mon->log = config->flags.log;
+
+    mon->tasks = calloc(mon->max_tasks, sizeof(esp_task_monitor_task_t));
+    mon->lock = xSemaphoreCreateMutex();
+    mon->done_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(mon->tasks && mon->lock && mon->done_sem, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for task monitor!");
+    if (mon->log) {
+        mon->log_size = (mon->max_tasks + 2) * TASK_MONITOR_LINE_LEN;
+        mon->log_buf = malloc(mon->log_size);
+        ESP_GOTO_ON_FALSE(mon->log_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for task monitor log!");
+    }
+
+#if TASK_MONITOR_SUPPORTED
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+        mon->idle[i] = xTaskGetIdleTaskHandleForCore(i);
+#else
+        mon->idle[i] = xTaskGetIdleTaskHandleForCPU(i);
+#endif
+    }
+#endif
+    /* Baseline of the first period */
+    ESP_GOTO_ON_ERROR(esp_task_monitor_sample(mon, false), err, TAG, "Task snapshot fail!");
+
+    const UBaseType_t priority = (config->task_priority ? config->task_priority : TASK_MONITOR_PRIORITY_DEFAULT);
+    const uint32_t stack = (config->task_stack ? config->task_stack : TASK_MONITOR_STACK_DEFAULT);
+    BaseType_t res = xTaskCreate(esp_task_monitor_task, "task_monitor", stack, mon, priority, &mon->task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create task monitor task fail!");
+
+    *ret_mon = mon;
+    return ESP_OK;
+
+err:
+    esp_task_monitor_free(mon);
+    return ret;
+}
+
+esp_err_t esp_task_monitor_get_report(esp_task_monitor_handle_t mon, esp_task_monitor_report_t *report, esp_task_monitor_task_t *tasks, size_t max)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(mon && report && (tasks || max == 0), ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    xSemaphoreTake(mon->lock, portMAX_DELAY);
+    ESP_GOTO_ON_FALSE(mon->has_report, ESP_ERR_INVALID_STATE, end, TAG, "No report yet");
+    *report = mon->report;
+    report->task_count = MIN(max, mon->report.task_count);
+    report->tasks = tasks;
+    if (report->task_count) {
+        memcpy(tasks, mon->tasks, report->task_count * sizeof(esp_task_monitor_task_t));
+    }
+end:
+    xSemaphoreGive(mon->lock);
+    return ret;
+}
+
+size_t esp_task_monitor_format(const esp_task_monitor_report_t *report, char *buf, size_t size, size_t max_tasks)
+{
+    if (!report || !buf || size == 0) {
+        return 0;
+    }
+
+    size_t len = 0;
+#define TASK_MONITOR_PRINT(...) do { \
+        if (len < size) { \
+            int n = snprintf(buf + len, size - len, __VA_ARGS__); \
+            len = (n < 0 ? len : MIN(size - 1, len + n)); \
+        } \
+    } while (0)
+
+    TASK_MONITOR_PRINT("Idle");
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        TASK_MONITOR_PRINT(" CPU%d %u.%u%%", i, report->idle_permille[i] / 10, report->idle_permille[i] % 10);
+    }
+    TASK_MONITOR_PRINT(", %"PRIu32" tasks in %"PRIu32" ms\n", report->total_tasks, report->period_us / 1000);
+    TASK_MONITOR_PRINT("%-*s    CPU Stack Prio Core\n", configMAX_TASK_NAME_LEN, "Task");
+
+    const size_t count = (max_tasks ? MIN(max_tasks, report->task_count) : report->task_count);
+    for (size_t i = 0; i < count; i++) {
+        const esp_task_monitor_task_t *t = &report->tasks[i];
+        TASK_MONITOR_PRINT("%-*s %3u.%u%% %5"PRIu32" %3u%c", configMAX_TASK_NAME_LEN, t->name,
+                           t->cpu_permille / 10, t->cpu_permille % 10, t->stack_free,
+                           (unsigned)t->priority, (t->priority != t->base_priority ? '*' : ' '));
+        if (t->core < 0) {
+            TASK_MONITOR_PRINT("    -\n");
+        } else {
+            TASK_MONITOR_PRINT(" %4d\n", t->core);
+        }
+    }
+#undef TASK_MONITOR_PRINT
+
+    return len;
+}
+
+esp_err_t esp_task_monitor_del(esp_task_monitor_handle_t mon)
+{
+    ESP_RETURN_ON_FALSE(mon, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_task_monitor_free(mon);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void esp_task_monitor_free(esp_task_monitor_handle_t mon)
+{
+    if (mon->task) {
+        mon->exit = true;
+        xTaskNotifyGive(mon->task);
+        xSemaphoreTake(mon->done_sem, portMAX_DELAY);
+    }
+    if (mon->lock) {
+        vSemaphoreDelete(mon->lock);
+    }
+    if (mon->done_sem) {
+        vSemaphoreDelete(mon->done_sem);
+    }
+#if TASK_MONITOR_SUPPORTED
+    free(mon->status);
+    free(mon->prev);
+    free(mon->all);
+#endif
+    free(mon->tasks);
+    free(mon->log_buf);
+    free(mon);
+}
+
+#if TASK_MONITOR_SUPPORTED
+static int esp_task_monitor_cmp(const void *a, const void *b)
+{
+    const esp_task_monitor_task_t *ta = a;
+    const esp_task_monitor_task_t *tb = b;
+    return (int)tb->cpu_permille - (int)ta->cpu_permille;
+}
+
+static uint16_t esp_task_monitor_permille(esp_task_monitor_counter_t part, esp_task_monitor_counter_t total)
+{
+    if (total == 0) {
+        return 0;
+    }
+    return (uint16_t)MIN(1000, (uint64_t)part * 1000 / total);
+}
+
+static esp_err_t esp_task_monitor_grow(esp_task_monitor_handle_t mon, size_t capacity)
+{
+    TaskStatus_t *status = realloc(mon->status, capacity * sizeof(TaskStatus_t));
+    if (status) {
+        mon->status = status;
+    }
+    esp_task_monitor_prev_t *prev = realloc(mon->prev, capacity * sizeof(esp_task_monitor_prev_t));
+    if (prev) {
+        mon->prev = prev;
+    }
+    esp_task_monitor_task_t *all = realloc(mon->all, capacity * sizeof(esp_task_monitor_task_t));
+    if (all) {
+        mon->all = all;
+    }
+    ESP_RETURN_ON_FALSE(status && prev && all, ESP_ERR_NO_MEM, TAG, "Not enough memory for task snapshot!");
+    mon->capacity = capacity;
+    return ESP_OK;
+}
+#endif
+
+static esp_err_t esp_task_monitor_sample(esp_task_monitor_handle_t mon, bool report)
+{
+#if TASK_MONITOR_SUPPORTED
+    esp_task_monitor_counter_t total = 0;
+    UBaseType_t count = 0;
+
+    /* The array is too small when tasks were created since the last snapshot */
+    while (true) {
+        if (mon->capacity) {
+            count = uxTaskGetSystemState(mon->status, mon->capacity, &total);
+        }
+        if (count) {
+            break;
+        }
+        ESP_RETURN_ON_ERROR(esp_task_monitor_grow(mon, uxTaskGetNumberOfTasks() + TASK_MONITOR_TASKS_RESERVE), TAG, "Task snapshot fail!");
+    }
+    const int64_t now = esp_timer_get_time();
+
+    if (report) {
+        const esp_task_monitor_counter_t total_delta = total - mon->prev_total;
+        esp_task_monitor_report_t rep = {
+            .period_us = (uint32_t)(now - mon->prev_time),
+            .total_tasks = count,
+        };
+
+        for (UBaseType_t i = 0; i < count; i++) {
+            const TaskStatus_t *s = &mon->status[i];
+            /* Task created in this period has its whole counter in it */
+            esp_task_monitor_counter_t delta = s->ulRunTimeCounter;
+            for (size_t j = 0; j < mon->prev_count; j++) {
+                if (mon->prev[j].handle == s->xHandle) {
+                    delta = s->ulRunTimeCounter - mon->prev[j].counter;
+                    break;
+                }
+            }
+
+            esp_task_monitor_task_t *t = &mon->all[i];
+            strlcpy(t->name, s->pcTaskName, sizeof(t->name));
+            t->handle = s->xHandle;
+            t->priority = s->uxCurrentPriority;
+            t->base_priority = s->uxBasePriority;
+            t->cpu_permille = esp_task_monitor_permille(delta, total_delta);
+            t->stack_free = s->usStackHighWaterMark * sizeof(StackType_t);
+            t->core = -1;
+#if CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID
+            if (s->xCoreID >= 0 && s->xCoreID < portNUM_PROCESSORS) {
+                t->core = s->xCoreID;
+            }
+#endif
+            for (int c = 0; c < portNUM_PROCESSORS; c++) {
+                if (s->xHandle == mon->idle[c]) {
+                    rep.idle_permille[c] = t->cpu_permille;
+                }
+            }
+        }
+        qsort(mon->all, count, sizeof(esp_task_monitor_task_t), esp_task_monitor_cmp);
+
+        xSemaphoreTake(mon->lock, portMAX_DELAY);
+        rep.task_count = MIN(count, mon->max_tasks);
+        rep.tasks = mon->tasks;
+        memcpy(mon->tasks, mon->all, rep.task_count * sizeof(esp_task_monitor_task_t));
+        mon->report = rep;
+        mon->has_report = true;
+        xSemaphoreGive(mon->lock);
+    }
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        mon->prev[i].handle = mon->status[i].xHandle;
+        mon->prev[i].counter = mon->status[i].ulRunTimeCounter;
+    }
+    mon->prev_count = count;
+    mon->prev_total = total;
+    mon->prev_time = now;
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+static void esp_task_monitor_task(void *arg)
+{
+    esp_task_monitor_handle_t mon = (esp_task_monitor_handle_t)arg;
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(mon->period_ms));
+        if (mon->exit) {
+            break;
+        }
+        if (esp_task_monitor_sample(mon, true) != ESP_OK) {
+            continue;
+        }
+        /* Only this task writes the report, so it is read here without the lock */
+        if (mon->log) {
+            esp_task_monitor_format(&mon->report, mon->log_buf, mon->log_size, 0);
+            ESP_LOGI(TAG, "\n%s", mon->log_buf);
+        }
+        if (mon->report_cb) {
+            mon->report_cb(&mon->report, mon->user_ctx);
+        }
+    }
+
+    xSemaphoreGive(mon->done_sem);
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Monitor of task CPU load and stack usage
+ *
+ * FreeRTOS run-time counters of all tasks are sampled periodically by a low priority task. Each report has the load
+ * of each task in the last period, idle time of each core and the stack high-water marks.
+ *
+ * @note Needs CONFIG_FREERTOS_USE_TRACE_FACILITY and CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS,
+ *       core of tasks is reported with CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Task monitor handle
+ */
+typedef struct esp_task_monitor_s *esp_task_monitor_handle_t;
+
+/**
+ * @brief One task in the report
+ */
+typedef struct {
+    char            name[configMAX_TASK_NAME_LEN]; /*!< Name of the task */
+    TaskHandle_t    handle;         /*!< Handle of the task */
+    UBaseType_t     priority;       /*!< Current priority (raised by priority inheritance, when it holds a mutex wanted by a higher priority task) */
+    UBaseType_t     base_priority;  /*!< Priority of the task */
+    int             core;           /*!< Core of the task (-1: no affinity or not known) */
+    uint16_t        cpu_permille;   /*!< Load of one core in the last period (1/1000, 1000 is a whole core) */
+    uint32_t        stack_free;     /*!< Stack high-water mark: minimum of free stack since the task start (bytes) */
+} esp_task_monitor_task_t;
+
+/**
+ * @brief Report of one period
+ */
+typedef struct {
+    uint32_t        period_us;      /*!< Duration of the period */
+    uint16_t        idle_permille[portNUM_PROCESSORS]; /*!< Idle time of each core (1/1000) */
+    uint32_t        total_tasks;    /*!< Number of tasks in the system */
+    size_t          task_count;     /*!< Number of tasks in the report (at most max_tasks), sorted by load from the highest */
+    const esp_task_monitor_task_t *tasks; /*!< Tasks in the report */
+} esp_task_monitor_report_t;
+
+/**
+ * @brief Callback with the report of each period, called from the monitor task
+ *
+ * @param report    report (valid only in the callback)
+ * @param user_ctx  user context
+ */
+typedef void (*esp_task_monitor_report_cb_t)(const esp_task_monitor_report_t *report, void *user_ctx);
+
+/**
+ * @brief Configuration of the task monitor
+ */
+typedef struct {
+    uint32_t        period_ms;      /*!< Report period (0: 5000 ms) */
+    uint16_t        max_tasks;      /*!< Tasks in the report, the ones with the highest load (0: 32) */
+    esp_task_monitor_report_cb_t report_cb; /*!< Callback with each report (NULL: not used) */
+    void            *user_ctx;      /*!< User context of the callback */
+    UBaseType_t     task_priority;  /*!< Priority of the monitor task (0: 1) */
+    uint32_t        task_stack;     /*!< Stack of the monitor task (0: 3072), the callback runs in it */
+    struct {
+        unsigned int log: 1;        /*!< Print each report to the log */
+    } flags;
+} esp_task_monitor_config_t;
+
+/**
+ * @brief Create and start the task monitor
+ *
+ * The first report is after one period.
+ *
+ * @param config    monitor configuration
+ * @param ret_mon   output monitor handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ *      - ESP_ERR_NOT_SUPPORTED     if FreeRTOS run-time statistics are disabled
+ */
+esp_err_t esp_task_monitor_new(const esp_task_monitor_config_t *config, esp_task_monitor_handle_t *ret_mon);
+
+/**
+ * @brief Get the last report
+ *
+ * @param mon       monitor handle
+ * @param report    output report, its tasks point to the array
+ * @param tasks     output array of tasks
+ * @param max       length of the array
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_INVALID_STATE     if there is no report yet
+ */
+esp_err_t esp_task_monitor_get_report(esp_task_monitor_handle_t mon, esp_task_monitor_report_t *report, esp_task_monitor_task_t *tasks, size_t max);
+
+/**
+ * @brief Format the report as text (a line of idle time of the cores, a table header and a line of each task)
+ *
+ * Priority raised by priority inheritance is marked by `*`.
+ *
+ * @param report    report
+ * @param buf       output text, it is always terminated
+ * @param size      size of the buffer
+ * @param max_tasks tasks in the text (0: all of the report)
+ * @return Length of the text
+ */
+size_t esp_task_monitor_format(const esp_task_monitor_report_t *report, char *buf, size_t size, size_t max_tasks);
+
+/**
+ * @brief Stop and delete the task monitor
+ *
+ * @note It waits for the end of the current report.
+ *
+ * @param mon       monitor handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_task_monitor_del(esp_task_monitor_handle_t mon);
+
+#ifdef __cplusplus
+}
+#endif
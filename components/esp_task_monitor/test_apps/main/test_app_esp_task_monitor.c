@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_task_monitor.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+static const char *TAG = "task monitor test";
+
+#define TEST_PERIOD_MS      (100)
+#define TEST_BUSY_CORE      (portNUM_PROCESSORS - 1)
+
+/* Results of the reports, written in the monitor task */
+typedef struct {
+    TaskHandle_t busy;
+    volatile uint32_t reports;
+    volatile uint16_t busy_permille;    /* Load of the busy task in the last report (0: not in the report) */
+    volatile uint16_t idle_permille;    /* Idle time of the core of the busy task in the last report */
+} test_reports_t;
+
+static volatile bool test_busy_stop;
+
+/* Task that never blocks, it stalls the idle task of its core */
+static void test_busy_task(void *arg)
+{
+    while (!test_busy_stop) {
+    }
+    vTaskDelete(NULL);
+}
+
+static void test_report_cb(const esp_task_monitor_report_t *report, void *user_ctx)
+{
+    test_reports_t *res = user_ctx;
+    uint16_t busy_permille = 0;
+    for (size_t i = 0; i < report->task_count; i++) {
+        if (report->tasks[i].handle == res->busy) {
+            busy_permille = report->tasks[i].cpu_permille;
+        }
+    }
+    res->busy_permille = busy_permille;
+    res->idle_permille = report->idle_permille[TEST_BUSY_CORE];
+    res->reports++;
+}
+
+TEST_CASE("Task monitor reports a task stalling its core", "[task_monitor]")
+{
+    test_reports_t res = {0};
+    esp_task_monitor_handle_t mon = NULL;
+    const esp_task_monitor_config_t cfg = {
+        .period_ms = TEST_PERIOD_MS,
+        .report_cb = test_report_cb,
+        .user_ctx = &res,
+        /* Above the busy task, to report also on single core */
+        .task_priority = 5,
+    };
+
+    test_busy_stop = false;
+    /* Priority of the test task, which shares the core on single core chips */
+    TEST_ASSERT_EQUAL(pdPASS, xTaskCreatePinnedToCore(test_busy_task, "busy", 2048, NULL, tskIDLE_PRIORITY + 1, &res.busy, TEST_BUSY_CORE));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_monitor_new(&cfg, &mon));
+
+    /* The first report is after one period, its baseline is taken with the busy task running */
+    vTaskDelay(pdMS_TO_TICKS(TEST_PERIOD_MS * 3 + TEST_PERIOD_MS / 2));
+    TEST_ASSERT_GREATER_OR_EQUAL(3, res.reports);
+    ESP_LOGI(TAG, "Busy task %u permille, idle of core %d %u permille", res.busy_permille, TEST_BUSY_CORE, res.idle_permille);
+    TEST_ASSERT_GREATER_THAN(900, res.busy_permille);
+    TEST_ASSERT_LESS_THAN(100, res.idle_permille);
+
+    /* Core is idle again */
+    test_busy_stop = true;
+    vTaskDelay(pdMS_TO_TICKS(TEST_PERIOD_MS * 2 + TEST_PERIOD_MS / 2));
+    TEST_ASSERT_EQUAL(0, res.busy_permille);
+    TEST_ASSERT_GREATER_THAN(900, res.idle_permille);
+
+    const uint32_t reports = res.reports;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_monitor_del(mon));
+    vTaskDelay(pdMS_TO_TICKS(TEST_PERIOD_MS * 2));
+    TEST_ASSERT_EQUAL(reports, res.reports);
+}
+
+TEST_CASE("Task monitor keeps the last report", "[task_monitor]")
+{
+    esp_task_monitor_handle_t mon = NULL;
+    const esp_task_monitor_config_t cfg = {
+        .period_ms = TEST_PERIOD_MS,
+        .max_tasks = 4,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_monitor_new(&cfg, &mon));
+
+    esp_task_monitor_report_t report;
+    esp_task_monitor_task_t tasks[8];
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_task_monitor_get_report(mon, &report, tasks, 8));
+
+    vTaskDelay(pdMS_TO_TICKS(TEST_PERIOD_MS + TEST_PERIOD_MS / 2));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_monitor_get_report(mon, &report, tasks, 8));
+    TEST_ASSERT_INT_WITHIN(TEST_PERIOD_MS * 200, TEST_PERIOD_MS * 1000, report.period_us);
+    TEST_ASSERT_GREATER_OR_EQUAL(portNUM_PROCESSORS + 2, report.total_tasks);
+    TEST_ASSERT_EQUAL(4, report.task_count);
+    TEST_ASSERT_EQUAL_PTR(tasks, report.tasks);
+    for (size_t i = 0; i < report.task_count; i++) {
+        TEST_ASSERT_GREATER_THAN(0, tasks[i].stack_free);
+        /* Sorted by load from the highest */
+        if (i > 0) {
+            TEST_ASSERT_GREATER_OR_EQUAL(tasks[i].cpu_permille, tasks[i - 1].cpu_permille);
+        }
+    }
+
+    /* Array shorter than the report */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_monitor_get_report(mon, &report, tasks, 2));
+    TEST_ASSERT_EQUAL(2, report.task_count);
+
+    char buf[512];
+    const size_t len = esp_task_monitor_format(&report, buf, sizeof(buf), 0);
+    printf("%s", buf);
+    TEST_ASSERT_EQUAL(strlen(buf), len);
+    TEST_ASSERT_EQUAL_STRING_LEN("Idle CPU0", buf, 9);
+    TEST_ASSERT_NOT_NULL(strstr(buf, tasks[0].name));
+    TEST_ASSERT_NOT_NULL(strstr(buf, tasks[1].name));
+
+    /* Truncated text is terminated */
+    TEST_ASSERT_EQUAL(15, esp_task_monitor_format(&report, buf, 16, 0));
+    TEST_ASSERT_EQUAL(15, strlen(buf));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_task_monitor_del(mon));
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (200)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    /* Deleted tasks are freed by the idle task */
+    vTaskDelay(pdMS_TO_TICKS(10));
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
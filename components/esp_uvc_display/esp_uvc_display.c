@@ -0,0 +1,328 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "usb/uvc_host.h"
+#include "esp_uvc_display.h"
+
+static const char *TAG = "UVC";
+
+#define UVC_DISPLAY_FPS_DEFAULT             (15)
+#define UVC_DISPLAY_FRAME_BUFFERS_DEFAULT   (5)
+/* Two frames wait for the decoder, one is decoded and one is pushed in place of the oldest waiting frame */
+#define UVC_DISPLAY_FRAMES_HELD             (4)
+#define UVC_DISPLAY_DRIVER_PRIORITY         (10)
+#define UVC_DISPLAY_DRIVER_STACK            (4096)
+#define UVC_DISPLAY_TASK_PRIORITY           (5)
+#define UVC_DISPLAY_TASK_STACK              (4096)
+#define UVC_DISPLAY_URBS                    (3)
+#define UVC_DISPLAY_URB_SIZE                (10 * 1024)
+/* Timeout of stream open, when the exit flag is checked */
+#define UVC_DISPLAY_OPEN_TIMEOUT_MS         (500)
+
+/* Event bits */
+#define UVC_DISPLAY_DISCONNECTED    (1 << 0)
+#define UVC_DISPLAY_EXIT            (1 << 1)
+#define UVC_DISPLAY_EXITED          (1 << 2)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct esp_uvc_display_s {
+    esp_mjpeg_player_handle_t player;
+    uvc_host_stream_config_t stream_config;
+    uvc_host_stream_hdl_t   stream;
+    esp_uvc_display_event_cb_t event_cb;
+    void                    *user_ctx;
+    TaskHandle_t            task;
+    EventGroupHandle_t      events;
+    bool                    driver_installed;
+    volatile bool           streaming;
+    /* Frames of the UVC driver pushed to the player, looked up by their data on release */
+    uint8_t                 frames_count;
+    uvc_host_frame_t        **frames;
+    portMUX_TYPE            lock;
+    /* Statistics */
+    uint32_t                frames_received;
+    uint32_t                stream_errors;
+    uint32_t                max_interval_us;
+    uint64_t                interval_sum_us;
+    uint32_t                intervals;
+    int64_t                 last_frame_us;
+};
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Called from decoder task of the player, when the frame was decoded or dropped */
+static void esp_uvc_display_frame_release(const uint8_t *data, void *user_ctx)
+{
+    esp_uvc_display_handle_t uvc = (esp_uvc_display_handle_t)user_ctx;
+    uvc_host_frame_t *frame = NULL;
+
+    portENTER_CRITICAL(&uvc->lock);
+    for (int i = 0; i < uvc->frames_count; i++) {
+        if (uvc->frames[i] && uvc->frames[i]->data == data) {
+            frame = uvc->frames[i];
+            uvc->frames[i] = NULL;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&uvc->lock);
+
+    if (frame) {
+        uvc_host_frame_return(uvc->stream, frame);
+    }
+}
+
+/* Called from the UVC driver, when a complete frame was received into its pool */
+static bool esp_uvc_display_frame_cb(const uvc_host_frame_t *frame, void *user_ctx)
+{
+    esp_uvc_display_handle_t uvc = (esp_uvc_display_handle_t)user_ctx;
+    const int64_t now = esp_timer_get_time();
+    bool held = false;
+
+    portENTER_CRITICAL(&uvc->lock);
+    uvc->frames_received++;
+    if (uvc->last_frame_us) {
+        const uint32_t interval_us = (uint32_t)(now - uvc->last_frame_us);
+        uvc->max_interval_us = MAX(uvc->max_interval_us, interval_us);
+        uvc->interval_sum_us += interval_us;
+        uvc->intervals++;
+    }
+    uvc->last_frame_us = now;
+    for (int i = 0; i < uvc->frames_count; i++) {
+        if (uvc->frames[i] == NULL) {
+            uvc->frames[i] = (uvc_host_frame_t *)frame;
+            held = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&uvc->lock);
+
+    if (!held) {
+        return true;
+    }
+    /* The player decodes the frame from the pool of the UVC driver, it is returned by the release callback */
+    if (esp_mjpeg_player_stream_push(uvc->player, frame->data, frame->data_len, esp_uvc_display_frame_release, uvc) != ESP_OK) {
+        portENTER_CRITICAL(&uvc->lock);
+        for (int i = 0; i < uvc->frames_count; i++) {
+            if (uvc->frames[i] == frame) {
+                uvc->frames[i] = NULL;
+                break;
+            }
+        }
+        portEXIT_CRITICAL(&uvc->lock);
+        return true;
+    }
+    return false;
+}
+
+static void esp_uvc_display_stream_cb(const uvc_host_stream_event_data_t *event, void *user_ctx)
+{
+    esp_uvc_display_handle_t uvc = (esp_uvc_display_handle_t)user_ctx;
+
+    switch (event->type) {
+    case UVC_HOST_TRANSFER_ERROR:
+    case UVC_HOST_FRAME_BUFFER_OVERFLOW:
+        portENTER_CRITICAL(&uvc->lock);
+        uvc->stream_errors++;
+        portEXIT_CRITICAL(&uvc->lock);
+        break;
+    case UVC_HOST_DEVICE_DISCONNECTED:
+        xEventGroupSetBits(uvc->events, UVC_DISPLAY_DISCONNECTED);
+        break;
+    default:
+        break;
+    }
+}
+
+/* Opens the stream of connected camera and closes it after disconnection */
+static void esp_uvc_display_task(void *arg)
+{
+    esp_uvc_display_handle_t uvc = (esp_uvc_display_handle_t)arg;
+
+    while ((xEventGroupGetBits(uvc->events) & UVC_DISPLAY_EXIT) == 0) {
+        if (uvc_host_stream_open(&uvc->stream_config, UVC_DISPLAY_OPEN_TIMEOUT_MS, &uvc->stream) != ESP_OK) {
+            continue;
+        }
+        xEventGroupClearBits(uvc->events, UVC_DISPLAY_DISCONNECTED);
+
+        ESP_LOGI(TAG, "Camera connected, streaming %" PRIu32 "x%" PRIu32 " MJPEG", (uint32_t)uvc->stream_config.vs_format.h_res,
+                 (uint32_t)uvc->stream_config.vs_format.v_res);
+        uvc->last_frame_us = 0;
+        if (esp_mjpeg_player_stream_start(uvc->player) == ESP_OK && uvc_host_stream_start(uvc->stream) == ESP_OK) {
+            uvc->streaming = true;
+            if (uvc->event_cb) {
+                uvc->event_cb(uvc, true, uvc->user_ctx);
+            }
+            xEventGroupWaitBits(uvc->events, UVC_DISPLAY_DISCONNECTED | UVC_DISPLAY_EXIT, pdFALSE, pdFALSE, portMAX_DELAY);
+            uvc->streaming = false;
+            if (uvc->event_cb) {
+                uvc->event_cb(uvc, false, uvc->user_ctx);
+            }
+        } else {
+            ESP_LOGE(TAG, "Stream start failed");
+        }
+
+        /* Frames held by the player are returned before the stream is closed */
+        esp_mjpeg_player_stop(uvc->player);
+        uvc_host_stream_close(uvc->stream);
+        uvc->stream = NULL;
+        ESP_LOGI(TAG, "Camera disconnected");
+    }
+
+    xEventGroupSetBits(uvc->events, UVC_DISPLAY_EXITED);
+    vTaskDelete(NULL);
+}
+
+static void esp_uvc_display_free(esp_uvc_display_handle_t uvc)
+{
+    if (uvc->task) {
+        xEventGroupSetBits(uvc->events, UVC_DISPLAY_EXIT);
+        xEventGroupWaitBits(uvc->events, UVC_DISPLAY_EXITED, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+    if (uvc->player) {
+        esp_mjpeg_player_del(uvc->player);
+    }
+    if (uvc->driver_installed) {
+        uvc_host_uninstall();
+    }
+    if (uvc->events) {
+        vEventGroupDelete(uvc->events);
+    }
+    free(uvc->frames);
+    free(uvc);
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_uvc_display_new(const esp_uvc_display_config_t *config, esp_uvc_display_handle_t *ret_uvc)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_uvc && config->disp, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->frame_buffers == 0 || config->frame_buffers > UVC_DISPLAY_FRAMES_HELD, ESP_ERR_INVALID_ARG, TAG,
+                        "At least %d frame buffers are needed!", UVC_DISPLAY_FRAMES_HELD + 1);
+
+    esp_uvc_display_handle_t uvc = calloc(1, sizeof(struct esp_uvc_display_s));
+    ESP_RETURN_ON_FALSE(uvc, ESP_ERR_NO_MEM, TAG, "Not enough memory for UVC display allocation!");
+    uvc->event_cb = config->event_cb;
+    uvc->user_ctx = config->user_ctx;
+    uvc->frames_count = UVC_DISPLAY_FRAMES_HELD;
+    portMUX_INITIALIZE(&uvc->lock);
+
+    uvc->events = xEventGroupCreate();
+    uvc->frames = calloc(uvc->frames_count, sizeof(uvc_host_frame_t *));
+    ESP_GOTO_ON_FALSE(uvc->events && uvc->frames, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for UVC display!");
+
+    const esp_mjpeg_player_config_t player_cfg = {
+        .disp = config->disp,
+        .hres = config->hres,
+        .vres = config->vres,
+        .x = config->x,
+        .y = config->y,
+        .frame_buffers = config->decoded_buffers,
+        .decoder_priority = config->decoder_priority,
+        .flags = {
+            .swap_bytes = config->flags.swap_bytes,
+            .buff_spiram = config->flags.buff_spiram,
+            .stream_only = 1,
+        },
+    };
+    ESP_GOTO_ON_ERROR(esp_mjpeg_player_new(&player_cfg, &uvc->player), err, TAG, "Player create failed");
+
+    const uvc_host_driver_config_t driver_config = {
+        .driver_task_stack_size = UVC_DISPLAY_DRIVER_STACK,
+        .driver_task_priority = UVC_DISPLAY_DRIVER_PRIORITY,
+        .xCoreID = tskNO_AFFINITY,
+        .create_background_task = true,
+    };
+    ESP_GOTO_ON_ERROR(uvc_host_install(&driver_config), err, TAG, "UVC host driver install failed");
+    uvc->driver_installed = true;
+
+    uvc->stream_config = (uvc_host_stream_config_t) {
+        .event_cb = esp_uvc_display_stream_cb,
+        .frame_cb = esp_uvc_display_frame_cb,
+        .user_ctx = uvc,
+        .usb = {
+            .vid = (config->vid ? config->vid : UVC_HOST_ANY_VID),
+            .pid = (config->pid ? config->pid : UVC_HOST_ANY_PID),
+            .uvc_stream_index = 0,
+        },
+        .vs_format = {
+            .h_res = config->hres,
+            .v_res = config->vres,
+            .fps = (config->fps ? config->fps : UVC_DISPLAY_FPS_DEFAULT),
+            .format = UVC_VS_FORMAT_MJPEG,
+        },
+        .advanced = {
+            .number_of_frame_buffers = (config->frame_buffers ? config->frame_buffers : UVC_DISPLAY_FRAME_BUFFERS_DEFAULT),
+            .frame_size = config->max_frame_size,
+            .frame_heap_caps = (config->flags.buff_spiram ? MALLOC_CAP_SPIRAM : MALLOC_CAP_DEFAULT),
+            .number_of_urbs = UVC_DISPLAY_URBS,
+            .urb_size = UVC_DISPLAY_URB_SIZE,
+        },
+    };
+
+    BaseType_t res = xTaskCreate(esp_uvc_display_task, "uvc_display", UVC_DISPLAY_TASK_STACK, uvc, UVC_DISPLAY_TASK_PRIORITY, &uvc->task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create UVC display task fail!");
+
+    *ret_uvc = uvc;
+    return ESP_OK;
+
+err:
+    esp_uvc_display_free(uvc);
+    return ret;
+}
+
+bool esp_uvc_display_is_streaming(esp_uvc_display_handle_t uvc)
+{
+    assert(uvc);
+    return uvc->streaming;
+}
+
+esp_err_t esp_uvc_display_get_stats(esp_uvc_display_handle_t uvc, esp_uvc_display_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(uvc && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_ERROR(esp_mjpeg_player_get_stats(uvc->player, &stats->player, reset), TAG, "Player stats failed");
+
+    portENTER_CRITICAL(&uvc->lock);
+    stats->frames_received = uvc->frames_received;
+    stats->stream_errors = uvc->stream_errors;
+    stats->max_frame_interval_us = uvc->max_interval_us;
+    stats->avg_frame_interval_us = (uvc->intervals ? (uint32_t)(uvc->interval_sum_us / uvc->intervals) : 0);
+    if (reset) {
+        uvc->frames_received = 0;
+        uvc->stream_errors = 0;
+        uvc->max_interval_us = 0;
+        uvc->interval_sum_us = 0;
+        uvc->intervals = 0;
+    }
+    portEXIT_CRITICAL(&uvc->lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_uvc_display_del(esp_uvc_display_handle_t uvc)
+{
+    ESP_RETURN_ON_FALSE(uvc, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_uvc_display_free(uvc);
+    return ESP_OK;
+}
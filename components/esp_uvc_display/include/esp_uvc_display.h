@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief USB camera (UVC) streaming to LCD
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "lvgl.h"
+#include "esp_mjpeg_player.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UVC display handle
+ */
+typedef struct esp_uvc_display_s *esp_uvc_display_handle_t;
+
+/**
+ * @brief Callback called from connection task, when the camera starts or stops streaming
+ *
+ * @param uvc        UVC display handle
+ * @param streaming  true, when the camera was connected and streams, false, when it was disconnected
+ * @param user_ctx   user context
+ */
+typedef void (*esp_uvc_display_event_cb_t)(esp_uvc_display_handle_t uvc, bool streaming, void *user_ctx);
+
+/**
+ * @brief Configuration of the UVC display
+ */
+typedef struct {
+    lv_display_t            *disp;          /*!< LVGL display (returned from lvgl_port_add_disp or BSP) */
+    uint32_t                hres;           /*!< Horizontal resolution of the MJPEG stream (multiple of 16 on ESP32-P4) */
+    uint32_t                vres;           /*!< Vertical resolution of the MJPEG stream (multiple of 16 on ESP32-P4) */
+    uint32_t                fps;            /*!< Frame rate requested from the camera (0: 15) */
+    int32_t                 x;              /*!< Position of the video on the LCD */
+    int32_t                 y;
+    uint16_t                vid;            /*!< USB Vendor ID of the camera (0: any) */
+    uint16_t                pid;            /*!< USB Product ID of the camera (0: any) */
+    uint8_t                 frame_buffers;  /*!< Number of MJPEG frames in the pool of the UVC driver (0: 5), four are held by the decoder at most */
+    size_t                  max_frame_size; /*!< Size of one MJPEG frame buffer in bytes (0: taken from the camera) */
+    uint8_t                 decoded_buffers; /*!< Number of decoded RGB565 frames (0: 3) */
+    UBaseType_t             decoder_priority; /*!< Priority of the decoder task (0: 6) */
+    esp_uvc_display_event_cb_t event_cb;    /*!< Callback called, when the camera is connected or disconnected (optional) */
+    void                    *user_ctx;      /*!< User context of the callback */
+    struct {
+        unsigned int swap_bytes: 1;     /*!< Decode RGB565 in big-endian byte order (SPI/I8080 LCDs, only for esp_jpeg decoder) */
+        unsigned int buff_spiram: 1;    /*!< Allocate MJPEG and decoded frames in PSRAM */
+    } flags;
+} esp_uvc_display_config_t;
+
+/**
+ * @brief Streaming statistics
+ */
+typedef struct {
+    esp_mjpeg_player_stats_t player;    /*!< Decoding and presentation, `max_present_late_us` is the latency from reception of the frame to the LCD */
+    uint32_t frames_received;           /*!< Complete MJPEG frames received from the camera */
+    uint32_t avg_frame_interval_us;     /*!< Average time between two received frames in microseconds */
+    uint32_t max_frame_interval_us;     /*!< Longest time between two received frames in microseconds */
+    uint32_t stream_errors;             /*!< Transfer errors and overflows of the frame buffers reported by the UVC driver */
+} esp_uvc_display_stats_t;
+
+/**
+ * @brief Create UVC display and start waiting for the camera
+ *
+ * The UVC host driver is installed and a connection task opens the MJPEG stream of the first matching camera.
+ * Frames are received by isochronous transfers into the frame pool of the UVC driver, decoded without a copy (hardware
+ * JPEG decoder on ESP32-P4, esp_jpeg on other chips) by esp_mjpeg_player and sent directly to the LCD by the video layer
+ * of esp_lvgl_port. When the camera is disconnected, the task waits for it again.
+ *
+ * @note USB Host Library must be installed before, e.g. by bsp_usb_host_start.
+ *
+ * @param config     UVC display configuration
+ * @param ret_uvc    output UVC display handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if configuration is wrong
+ *      - ESP_ERR_INVALID_STATE     if the UVC host driver is already installed
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ *      - errors of esp_mjpeg_player_new
+ */
+esp_err_t esp_uvc_display_new(const esp_uvc_display_config_t *config, esp_uvc_display_handle_t *ret_uvc);
+
+/**
+ * @brief Check, if the camera is streaming
+ *
+ * @param uvc        UVC display handle
+ * @return true, if the camera is connected and streams
+ */
+bool esp_uvc_display_is_streaming(esp_uvc_display_handle_t uvc);
+
+/**
+ * @brief Get streaming statistics
+ *
+ * @param uvc        UVC display handle
+ * @param stats      output statistics
+ * @param reset      reset the statistics after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_uvc_display_get_stats(esp_uvc_display_handle_t uvc, esp_uvc_display_stats_t *stats, bool reset);
+
+/**
+ * @brief Delete UVC display
+ *
+ * @note The stream is closed, the UVC host driver is uninstalled and the video layer is deleted.
+ *
+ * @param uvc        UVC display handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_uvc_display_del(esp_uvc_display_handle_t uvc);
+
+#ifdef __cplusplus
+}
+#endif
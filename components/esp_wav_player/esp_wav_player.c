@@ -0,0 +1,574 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/stream_buffer.h"
+#include "esp_wav_player.h"
+#include "esp_wav_resampler.h"
+
+static const char *TAG = "WAV";
+
+#define WAV_PLAYER_RING_SIZE_DEFAULT        (16 * 1024)
+#define WAV_PLAYER_CHUNK_SIZE_DEFAULT       (1024)
+#define WAV_PLAYER_READER_PRIORITY_DEFAULT  (5)
+#define WAV_PLAYER_WRITER_PRIORITY_DEFAULT  (7)
+#define WAV_PLAYER_TASK_STACK               (3072)
+#define WAV_PLAYER_CHANNELS_DEFAULT         (1)
+/* Frames converted to the output format at once */
+#define WAV_PLAYER_CONV_FRAMES              (256)
+/* Timeout of blocking operations, when the stop flag is checked */
+#define WAV_PLAYER_STOP_CHECK_MS            (100)
+
+/* Event bits */
+#define WAV_PLAYER_READER_IDLE      (1 << 0)
+#define WAV_PLAYER_WRITER_IDLE      (1 << 1)
+#define WAV_PLAYER_READER_EXITED    (1 << 2)
+#define WAV_PLAYER_WRITER_EXITED    (1 << 3)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+/* Very simple WAV header, ignores most fields */
+typedef struct __attribute__((packed))
+{
+    uint8_t ignore_0[22];
+    uint16_t num_channels;
+    uint32_t sample_rate;
+    uint8_t ignore_1[6];
+    uint16_t bits_per_sample;
+    uint8_t ignore_2[4];
+    uint32_t data_size;
+} esp_wav_player_header_t;
+
+struct esp_wav_player_s {
+    esp_codec_dev_handle_t  codec;
+    int                     mclk_multiple;
+    uint32_t                out_rate;       /* Fixed output sample rate, 0 when the codec follows the file */
+    uint8_t                 out_channels;
+    esp_wav_resampler_handle_t resampler;
+    int16_t                 *conv_buf;      /* Frames of the file in the output format */
+    int16_t                 *out_buf;       /* Resampled frames */
+    size_t                  out_frames;     /* Size of out_buf in frames */
+    bool                    codec_open;     /* The codec is kept open with fixed output sample rate */
+    esp_wav_player_done_cb_t done_cb;
+    void                    *user_ctx;
+    size_t                  chunk_size;
+    size_t                  ring_size;
+    StreamBufferHandle_t    ring;           /* Read-ahead of the file */
+    uint8_t                 *reader_buf;
+    uint8_t                 *writer_buf;
+    TaskHandle_t            reader_task;
+    TaskHandle_t            writer_task;
+    EventGroupHandle_t      events;
+    SemaphoreHandle_t       api_lock;
+    /* Playback */
+    FILE                    *file;
+    uint32_t                data_size;
+    size_t                  frame_size;     /* Bytes of one sample of all channels */
+    size_t                  write_size;     /* chunk_size aligned to frames */
+    uint16_t                bits_per_sample;
+    uint8_t                 channels;
+    bool                    convert;        /* The file is converted to the fixed output format */
+    bool                    resample;       /* The file is resampled to the fixed output sample rate */
+    TickType_t              fill_timeout;   /* Wait for the ring buffer before underrun */
+    uint8_t                 silence;
+    volatile bool           repeat;
+    volatile bool           stop;
+    volatile bool           eof;            /* The whole file is in the ring buffer */
+    volatile bool           exit;
+    /* Statistics */
+    portMUX_TYPE            stats_lock;
+    esp_wav_player_stats_t  stats;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void esp_wav_player_reader_task(void *arg);
+static void esp_wav_player_writer_task(void *arg);
+static void esp_wav_player_stop_internal(esp_wav_player_handle_t player);
+static void esp_wav_player_codec_close(esp_wav_player_handle_t player);
+static void esp_wav_player_free(esp_wav_player_handle_t player);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_wav_player_new(const esp_wav_player_config_t *config, esp_wav_player_handle_t *ret_player)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_player && config->codec && config->channels <= 2, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_wav_player_handle_t player = calloc(1, sizeof(struct esp_wav_player_s));
+    ESP_RETURN_ON_FALSE(player, ESP_ERR_NO_MEM, TAG, "Not enough memory for player allocation!");
+    player->codec = config->codec;
+    player->mclk_multiple = config->mclk_multiple;
+    player->out_rate = config->sample_rate;
+    player->out_channels = (config->channels ? config->channels : WAV_PLAYER_CHANNELS_DEFAULT);
+    player->done_cb = config->done_cb;
+    player->user_ctx = config->user_ctx;
+    player->chunk_size = (config->chunk_size ? config->chunk_size : WAV_PLAYER_CHUNK_SIZE_DEFAULT);
+    player->ring_size = (config->ring_size ? config->ring_size : WAV_PLAYER_RING_SIZE_DEFAULT);
+    portMUX_INITIALIZE(&player->stats_lock);
+    ESP_GOTO_ON_FALSE(player->ring_size >= 2 * player->chunk_size, ESP_ERR_INVALID_ARG, err, TAG, "Ring buffer must hold at least two chunks!");
+
+    player->ring = xStreamBufferCreate(player->ring_size, 1);
+    player->events = xEventGroupCreate();
+    player->api_lock = xSemaphoreCreateMutex();
+    player->reader_buf = malloc(player->chunk_size);
+    player->writer_buf = malloc(player->chunk_size);
+    ESP_GOTO_ON_FALSE(player->ring && player->events && player->api_lock && player->reader_buf && player->writer_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for player!");
+    if (player->out_rate) {
+        /* One codec write of resampled frames is at most one chunk */
+        player->out_frames = player->chunk_size / (player->out_channels * sizeof(int16_t));
+        ESP_GOTO_ON_FALSE(player->out_frames > 0, ESP_ERR_INVALID_ARG, err, TAG, "Chunk is smaller than one frame!");
+        ESP_GOTO_ON_ERROR(esp_wav_resampler_new(player->out_channels, &player->resampler), err, TAG, "Create resampler fail!");
+        player->conv_buf = malloc(WAV_PLAYER_CONV_FRAMES * player->out_channels * sizeof(int16_t));
+        player->out_buf = malloc(player->out_frames * player->out_channels * sizeof(int16_t));
+        ESP_GOTO_ON_FALSE(player->conv_buf && player->out_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for resampler buffers!");
+    }
+    xEventGroupSetBits(player->events, WAV_PLAYER_READER_IDLE | WAV_PLAYER_WRITER_IDLE);
+
+    const UBaseType_t reader_priority = (config->reader_priority ? config->reader_priority : WAV_PLAYER_READER_PRIORITY_DEFAULT);
+    const UBaseType_t writer_priority = (config->writer_priority ? config->writer_priority : WAV_PLAYER_WRITER_PRIORITY_DEFAULT);
+    BaseType_t res = xTaskCreate(esp_wav_player_reader_task, "wav_reader", WAV_PLAYER_TASK_STACK, player, reader_priority, &player->reader_task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create reader task fail!");
+    res = xTaskCreate(esp_wav_player_writer_task, "wav_writer", WAV_PLAYER_TASK_STACK, player, writer_priority, &player->writer_task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create writer task fail!");
+
+    *ret_player = player;
+    return ESP_OK;
+
+err:
+    esp_wav_player_free(player);
+    return ret;
+}
+
+esp_err_t esp_wav_player_play(esp_wav_player_handle_t player, const char *path, bool repeat)
+{
+    esp_err_t ret = ESP_OK;
+    esp_wav_player_header_t header;
+    ESP_RETURN_ON_FALSE(player && path, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    xSemaphoreTake(player->api_lock, portMAX_DELAY);
+    esp_wav_player_stop_internal(player);
+
+    player->file = fopen(path, "rb");
+    ESP_GOTO_ON_FALSE(player->file, ESP_ERR_NOT_FOUND, err, TAG, "%s file does not exist!", path);
+    ESP_GOTO_ON_FALSE(fread(&header, 1, sizeof(header), player->file) == sizeof(header), ESP_ERR_INVALID_RESPONSE, err, TAG, "Error in reading file");
+    ESP_GOTO_ON_FALSE(header.num_channels >= 1 && header.num_channels <= 2 && header.sample_rate > 0 && header.data_size > 0 &&
+                      (header.bits_per_sample == 8 || header.bits_per_sample == 16 || header.bits_per_sample == 24 || header.bits_per_sample == 32),
+                      ESP_ERR_INVALID_RESPONSE, err, TAG, "Unsupported WAV file");
+    ESP_LOGI(TAG, "Playing %s: %" PRIu16 " ch, %" PRIu16 " bit, %" PRIu32 " Hz, %" PRIu32 " bytes", path, header.num_channels,
+             header.bits_per_sample, header.sample_rate, header.data_size);
+
+    if (player->out_rate == 0) {
+        esp_codec_dev_sample_info_t fs = {
+            .sample_rate = header.sample_rate,
+            .channel = header.num_channels,
+            .bits_per_sample = header.bits_per_sample,
+            .mclk_multiple = player->mclk_multiple,
+        };
+        ESP_GOTO_ON_FALSE(esp_codec_dev_open(player->codec, &fs) == ESP_CODEC_DEV_OK, ESP_FAIL, err, TAG, "Codec open failed");
+    } else {
+        /* The codec is opened once with the fixed format, the files are converted to it */
+        if (!player->codec_open) {
+            esp_codec_dev_sample_info_t fs = {
+                .sample_rate = player->out_rate,
+                .channel = player->out_channels,
+                .bits_per_sample = 16,
+                .mclk_multiple = player->mclk_multiple,
+            };
+            ESP_GOTO_ON_FALSE(esp_codec_dev_open(player->codec, &fs) == ESP_CODEC_DEV_OK, ESP_FAIL, err, TAG, "Codec open failed");
+            player->codec_open = true;
+        }
+        player->resample = (header.sample_rate != player->out_rate);
+        player->convert = (player->resample || header.bits_per_sample != 16 || header.num_channels != player->out_channels);
+        if (player->resample) {
+            esp_wav_resampler_set_rate(player->resampler, header.sample_rate, player->out_rate);
+        }
+    }
+
+    /* Writes are aligned to frames, half of the write duration is waited for the data before underrun */
+    player->data_size = header.data_size;
+    player->frame_size = header.num_channels * header.bits_per_sample / 8;
+    player->bits_per_sample = header.bits_per_sample;
+    player->channels = header.num_channels;
+    player->write_size = player->chunk_size - (player->chunk_size % player->frame_size);
+    const uint32_t write_ms = player->write_size * 1000 / (header.sample_rate * player->frame_size);
+    player->fill_timeout = MAX(pdMS_TO_TICKS(write_ms / 2), 1);
+    player->silence = (header.bits_per_sample == 8 ? 0x80 : 0x00);
+    player->repeat = repeat;
+    player->stop = false;
+    player->eof = false;
+
+    portENTER_CRITICAL(&player->stats_lock);
+    player->stats.min_ring_level = player->ring_size;
+    portEXIT_CRITICAL(&player->stats_lock);
+
+    xEventGroupClearBits(player->events, WAV_PLAYER_READER_IDLE | WAV_PLAYER_WRITER_IDLE);
+    xTaskNotifyGive(player->reader_task);
+    xTaskNotifyGive(player->writer_task);
+    xSemaphoreGive(player->api_lock);
+    return ESP_OK;
+
+err:
+    if (player->file) {
+        fclose(player->file);
+        player->file = NULL;
+    }
+    xSemaphoreGive(player->api_lock);
+    return ret;
+}
+
+esp_err_t esp_wav_player_set_repeat(esp_wav_player_handle_t player, bool repeat)
+{
+    ESP_RETURN_ON_FALSE(player, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    player->repeat = repeat;
+    return ESP_OK;
+}
+
+esp_err_t esp_wav_player_stop(esp_wav_player_handle_t player)
+{
+    ESP_RETURN_ON_FALSE(player, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    xSemaphoreTake(player->api_lock, portMAX_DELAY);
+    esp_wav_player_stop_internal(player);
+    esp_wav_player_codec_close(player);
+    xSemaphoreGive(player->api_lock);
+    return ESP_OK;
+}
+
+bool esp_wav_player_is_playing(esp_wav_player_handle_t player)
+{
+    assert(player);
+    return ((xEventGroupGetBits(player->events) & WAV_PLAYER_WRITER_IDLE) == 0);
+}
+
+esp_err_t esp_wav_player_get_stats(esp_wav_player_handle_t player, esp_wav_player_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(player && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    portENTER_CRITICAL(&player->stats_lock);
+    *stats = player->stats;
+    if (reset) {
+        memset(&player->stats, 0, sizeof(player->stats));
+        player->stats.min_ring_level = player->ring_size;
+    }
+    portEXIT_CRITICAL(&player->stats_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_wav_player_del(esp_wav_player_handle_t player)
+{
+    ESP_RETURN_ON_FALSE(player, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_wav_player_stop(player);
+    esp_wav_player_free(player);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Called with API lock */
+static void esp_wav_player_stop_internal(esp_wav_player_handle_t player)
+{
+    player->stop = true;
+    /* Writer is idle after the reader */
+    xEventGroupWaitBits(player->events, WAV_PLAYER_WRITER_IDLE, pdFALSE, pdTRUE, portMAX_DELAY);
+}
+
+/* Called with API lock, when the writer is idle */
+static void esp_wav_player_codec_close(esp_wav_player_handle_t player)
+{
+    if (player->codec_open) {
+        esp_codec_dev_close(player->codec);
+        player->codec_open = false;
+    }
+}
+
+static void esp_wav_player_free(esp_wav_player_handle_t player)
+{
+    EventBits_t exited = 0;
+    player->exit = true;
+    if (player->reader_task) {
+        exited |= WAV_PLAYER_READER_EXITED;
+        xTaskNotifyGive(player->reader_task);
+    }
+    if (player->writer_task) {
+        exited |= WAV_PLAYER_WRITER_EXITED;
+        xTaskNotifyGive(player->writer_task);
+    }
+    if (exited) {
+        xEventGroupWaitBits(player->events, exited, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+
+    if (player->ring) {
+        vStreamBufferDelete(player->ring);
+    }
+    if (player->events) {
+        vEventGroupDelete(player->events);
+    }
+    if (player->api_lock) {
+        vSemaphoreDelete(player->api_lock);
+    }
+    esp_wav_resampler_del(player->resampler);
+    free(player->reader_buf);
+    free(player->writer_buf);
+    free(player->conv_buf);
+    free(player->out_buf);
+    free(player);
+}
+
+static void esp_wav_player_reader_task(void *arg)
+{
+    esp_wav_player_handle_t player = (esp_wav_player_handle_t)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (player->exit) {
+            break;
+        }
+
+        uint32_t remaining = player->data_size;
+        while (!player->stop) {
+            if (remaining == 0) {
+                if (!player->repeat) {
+                    break;
+                }
+                fseek(player->file, sizeof(esp_wav_player_header_t), SEEK_SET);
+                remaining = player->data_size;
+            }
+
+            const int64_t start = esp_timer_get_time();
+            const size_t len = fread(player->reader_buf, 1, MIN(player->chunk_size, remaining), player->file);
+            const uint32_t read_us = (uint32_t)(esp_timer_get_time() - start);
+            portENTER_CRITICAL(&player->stats_lock);
+            player->stats.max_read_us = MAX(player->stats.max_read_us, read_us);
+            portEXIT_CRITICAL(&player->stats_lock);
+
+            /* Data of the file is shorter than in the header */
+            if (len == 0) {
+                remaining = 0;
+                continue;
+            }
+            remaining -= len;
+
+            size_t sent = 0;
+            while (sent < len && !player->stop) {
+                sent += xStreamBufferSend(player->ring, player->reader_buf + sent, len - sent, pdMS_TO_TICKS(WAV_PLAYER_STOP_CHECK_MS));
+            }
+        }
+
+        player->eof = true;
+        xEventGroupSetBits(player->events, WAV_PLAYER_READER_IDLE);
+    }
+
+    xEventGroupSetBits(player->events, WAV_PLAYER_READER_EXITED);
+    vTaskDelete(NULL);
+}
+
+static inline bool esp_wav_player_is_drained(esp_wav_player_handle_t player)
+{
+    return (player->eof && xStreamBufferIsEmpty(player->ring));
+}
+
+/* Fill the write buffer from the ring buffer, it waits at most fill_timeout */
+static size_t esp_wav_player_fill(esp_wav_player_handle_t player)
+{
+    const TickType_t start = xTaskGetTickCount();
+    size_t filled = 0;
+
+    while (filled < player->write_size && !esp_wav_player_is_drained(player)) {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= player->fill_timeout) {
+            break;
+        }
+        filled += xStreamBufferReceive(player->ring, player->writer_buf + filled, player->write_size - filled, player->fill_timeout - elapsed);
+    }
+
+    /* Keep the frames aligned, the rest of the frame is just being written by reader */
+    while ((filled % player->frame_size) != 0 && !esp_wav_player_is_drained(player) && !player->stop) {
+        const size_t rest = player->frame_size - (filled % player->frame_size);
+        filled += xStreamBufferReceive(player->ring, player->writer_buf + filled, rest, pdMS_TO_TICKS(WAV_PLAYER_STOP_CHECK_MS));
+    }
+
+    return filled;
+}
+
+/* Sample of the file to 16 bits, 8 bit WAV is unsigned, the others are signed little endian */
+static inline int16_t esp_wav_player_sample(const uint8_t *p, uint16_t bits_per_sample)
+{
+    switch (bits_per_sample) {
+    case 8:
+        return (int16_t)((p[0] - 0x80) << 8);
+    case 24:
+        return (int16_t)(p[1] | (p[2] << 8));
+    case 32:
+        return (int16_t)(p[2] | (p[3] << 8));
+    default:
+        return (int16_t)(p[0] | (p[1] << 8));
+    }
+}
+
+/* Convert frames of the file to 16 bit frames with output channels in conv_buf */
+static void esp_wav_player_convert(esp_wav_player_handle_t player, const uint8_t *in, size_t frames)
+{
+    const size_t bytes = player->bits_per_sample / 8;
+    int16_t *out = player->conv_buf;
+    for (size_t i = 0; i < frames; i++, in += player->frame_size) {
+        const int16_t first = esp_wav_player_sample(in, player->bits_per_sample);
+        if (player->channels == player->out_channels) {
+            *out++ = first;
+            if (player->channels == 2) {
+                *out++ = esp_wav_player_sample(in + bytes, player->bits_per_sample);
+            }
+        } else if (player->channels == 1) {
+            /* Mono to stereo */
+            *out++ = first;
+            *out++ = first;
+        } else {
+            /* Stereo to mono */
+            *out++ = (int16_t)((first + esp_wav_player_sample(in + bytes, player->bits_per_sample)) / 2);
+        }
+    }
+}
+
+/* Write frames of the file to the codec opened with the fixed output format */
+static void esp_wav_player_write_converted(esp_wav_player_handle_t player, size_t len)
+{
+    const size_t out_frame_size = player->out_channels * sizeof(int16_t);
+    const uint8_t *in = player->writer_buf;
+    size_t frames = len / player->frame_size;
+    size_t out_len = 0;
+
+    while (frames > 0) {
+        const size_t conv_frames = MIN(frames, WAV_PLAYER_CONV_FRAMES);
+        esp_wav_player_convert(player, in, conv_frames);
+        in += conv_frames * player->frame_size;
+        frames -= conv_frames;
+        if (!player->resample) {
+            esp_codec_dev_write(player->codec, player->conv_buf, conv_frames * out_frame_size);
+            continue;
+        }
+
+        /* Resampled frames are collected into one codec write */
+        const int16_t *src = player->conv_buf;
+        size_t left = conv_frames;
+        while (left > 0) {
+            size_t taken = left;
+            out_len += esp_wav_resampler_process(player->resampler, src, &taken, &player->out_buf[out_len * player->out_channels], player->out_frames - out_len);
+            src += taken * player->out_channels;
+            left -= taken;
+            if (out_len == player->out_frames) {
+                esp_codec_dev_write(player->codec, player->out_buf, out_len * out_frame_size);
+                out_len = 0;
+            }
+        }
+    }
+
+    if (out_len > 0) {
+        esp_codec_dev_write(player->codec, player->out_buf, out_len * out_frame_size);
+    }
+}
+
+/* Write the rest of the resampled file, the frames still in the history of the resampler */
+static void esp_wav_player_write_resampler_rest(esp_wav_player_handle_t player)
+{
+    const size_t out_frame_size = player->out_channels * sizeof(int16_t);
+    size_t out_len = 0;
+    size_t produced;
+
+    do {
+        size_t taken = 0;
+        produced = esp_wav_resampler_process(player->resampler, NULL, &taken, &player->out_buf[out_len * player->out_channels], player->out_frames - out_len);
+        out_len += produced;
+        if (out_len == player->out_frames || (produced == 0 && out_len > 0)) {
+            esp_codec_dev_write(player->codec, player->out_buf, out_len * out_frame_size);
+            out_len = 0;
+        }
+    } while (produced > 0);
+}
+
+static void esp_wav_player_writer_task(void *arg)
+{
+    esp_wav_player_handle_t player = (esp_wav_player_handle_t)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (player->exit) {
+            break;
+        }
+
+        /* Pre-fill half of the ring buffer, before the codec is fed */
+        while (!player->stop && !player->eof && xStreamBufferBytesAvailable(player->ring) < player->ring_size / 2) {
+            vTaskDelay(1);
+        }
+
+        while (!player->stop) {
+            const size_t level = xStreamBufferBytesAvailable(player->ring);
+            size_t len = esp_wav_player_fill(player);
+            const bool drained = esp_wav_player_is_drained(player);
+            if (len == 0 && drained) {
+                if (player->resample) {
+                    esp_wav_player_write_resampler_rest(player);
+                }
+                break;
+            }
+
+            portENTER_CRITICAL(&player->stats_lock);
+            player->stats.min_ring_level = MIN(player->stats.min_ring_level, level);
+            player->stats.bytes_played += len;
+            if (len < player->write_size && !drained) {
+                /* The codec is kept fed with silence, DMA does not repeat old data */
+                player->stats.underruns++;
+                player->stats.underrun_bytes += player->write_size - len;
+            }
+            portEXIT_CRITICAL(&player->stats_lock);
+
+            if (len < player->write_size && !drained) {
+                memset(player->writer_buf + len, player->silence, player->write_size - len);
+                len = player->write_size;
+            }
+            if (player->convert) {
+                esp_wav_player_write_converted(player, len);
+            } else {
+                esp_codec_dev_write(player->codec, player->writer_buf, len);
+            }
+        }
+
+        /* Stopped reader does not use the file */
+        player->stop = true;
+        xEventGroupWaitBits(player->events, WAV_PLAYER_READER_IDLE, pdFALSE, pdTRUE, portMAX_DELAY);
+        /* With fixed output sample rate, the codec is not reconfigured between files */
+        if (player->out_rate == 0) {
+            esp_codec_dev_close(player->codec);
+        }
+        fclose(player->file);
+        player->file = NULL;
+        xStreamBufferReset(player->ring);
+        xEventGroupSetBits(player->events, WAV_PLAYER_WRITER_IDLE);
+
+        if (player->done_cb) {
+            player->done_cb(player, player->user_ctx);
+        }
+    }
+
+    xEventGroupSetBits(player->events, WAV_PLAYER_WRITER_EXITED);
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_wav_resampler.h"
+
+static const char *TAG = "WAV_RS";
+
+/* Taps of one phase (input samples under the filter), it is fixed for the vector kernel */
+#define WAV_RESAMPLER_TAPS          (16)
+#define WAV_RESAMPLER_MAX_PHASES    (256)
+/* Input frames taken into the history at once */
+#define WAV_RESAMPLER_BLOCK         (256)
+/* Cut-off frequency relative to the lower Nyquist frequency */
+#define WAV_RESAMPLER_ROLLOFF       (0.9f)
+#define WAV_RESAMPLER_ALIGN         (16)
+/* The vector kernel reads up to 16 bytes behind the last tap */
+#define WAV_RESAMPLER_SLACK         (8)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct esp_wav_resampler_s {
+    uint8_t     channels;
+    int16_t     *coeffs;        /* Phases of the filter, WAV_RESAMPLER_TAPS taps each, aligned */
+    int16_t     *hist[2];       /* History of each channel, aligned */
+    size_t      filled;         /* Samples in the history */
+    size_t      pos;            /* First sample under the filter */
+    size_t      pad;            /* Silence after the end of the stream */
+    uint32_t    up;             /* Reduced output rate (L) */
+    uint32_t    down;           /* Reduced input rate (M) */
+    uint32_t    phase;          /* Position between pos + TAPS / 2 - 1 and the next sample, in 1/L */
+    uint32_t    phases;         /* Phases in the table, L or WAV_RESAMPLER_MAX_PHASES */
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+#if CONFIG_IDF_TARGET_ESP32S3
+extern int32_t esp_wav_resampler_fir16_esp32s3(const int16_t *x, const int16_t *h);
+#endif
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_wav_resampler_new(uint8_t channels, esp_wav_resampler_handle_t *ret_rs)
+{
+    ESP_RETURN_ON_FALSE(ret_rs && channels >= 1 && channels <= 2, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_wav_resampler_handle_t rs = calloc(1, sizeof(struct esp_wav_resampler_s));
+    ESP_RETURN_ON_FALSE(rs, ESP_ERR_NO_MEM, TAG, "Not enough memory for resampler allocation!");
+    rs->channels = channels;
+    rs->coeffs = heap_caps_aligned_alloc(WAV_RESAMPLER_ALIGN, WAV_RESAMPLER_MAX_PHASES * WAV_RESAMPLER_TAPS * sizeof(int16_t),
+                                         MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    bool ok = (rs->coeffs != NULL);
+    const size_t hist_size = (WAV_RESAMPLER_TAPS + WAV_RESAMPLER_BLOCK + WAV_RESAMPLER_SLACK) * sizeof(int16_t);
+    for (uint8_t ch = 0; ch < channels; ch++) {
+        rs->hist[ch] = heap_caps_aligned_calloc(WAV_RESAMPLER_ALIGN, 1, hist_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        ok = ok && (rs->hist[ch] != NULL);
+    }
+    if (!ok) {
+        esp_wav_resampler_del(rs);
+        ESP_LOGE(TAG, "Not enough memory for resampler!");
+        return ESP_ERR_NO_MEM;
+    }
+
+    *ret_rs = rs;
+    return ESP_OK;
+}
+
+static uint32_t esp_wav_resampler_gcd(uint32_t a, uint32_t b)
+{
+    while (b) {
+        const uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+esp_err_t esp_wav_resampler_set_rate(esp_wav_resampler_handle_t rs, uint32_t in_rate, uint32_t out_rate)
+{
+    ESP_RETURN_ON_FALSE(rs && in_rate && out_rate, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    const uint32_t gcd = esp_wav_resampler_gcd(in_rate, out_rate);
+    rs->up = out_rate / gcd;
+    rs->down = in_rate / gcd;
+    rs->phases = MIN(rs->up, WAV_RESAMPLER_MAX_PHASES);
+    rs->phase = 0;
+
+    /* Blackman windowed sinc, each phase is normalized to unity gain, so DC passes without ripple */
+    const float fc = MIN(1.0f, (float)out_rate / in_rate) * WAV_RESAMPLER_ROLLOFF;
+    const float half = WAV_RESAMPLER_TAPS / 2.0f;
+    for (uint32_t p = 0; p < rs->phases; p++) {
+        float taps[WAV_RESAMPLER_TAPS];
+        float sum = 0.0f;
+        for (int j = 0; j < WAV_RESAMPLER_TAPS; j++) {
+            /* Distance of tap j from the output position */
+            const float t = (float)p / rs->phases + half - 1 - j;
+            const float x = (float)M_PI * fc * t;
+            const float sinc = (fabsf(x) < 1e-6f ? 1.0f : sinf(x) / x);
+            const float w = 0.42f + 0.5f * cosf((float)M_PI * t / half) + 0.08f * cosf(2.0f * (float)M_PI * t / half);
+            taps[j] = fc * sinc * MAX(w, 0.0f);
+            sum += taps[j];
+        }
+        for (int j = 0; j < WAV_RESAMPLER_TAPS; j++) {
+            const float q = roundf(taps[j] / sum * 32768.0f);
+            rs->coeffs[p * WAV_RESAMPLER_TAPS + j] = (int16_t)MIN(MAX(q, INT16_MIN), INT16_MAX);
+        }
+    }
+
+    /* Output starts at the first input sample, the samples before it are silence */
+    for (uint8_t ch = 0; ch < rs->channels; ch++) {
+        memset(rs->hist[ch], 0, WAV_RESAMPLER_TAPS * sizeof(int16_t));
+    }
+    rs->pos = 0;
+    rs->pad = 0;
+    rs->filled = WAV_RESAMPLER_TAPS / 2 - 1;
+    ESP_LOGD(TAG, "%" PRIu32 " -> %" PRIu32 " Hz: %" PRIu32 "/%" PRIu32 ", %" PRIu32 " phases", in_rate, out_rate, rs->up, rs->down, rs->phases);
+    return ESP_OK;
+}
+
+/* Sum of absolute taps is below 2.0, so 16 products do not overflow 32 bits */
+static inline int16_t esp_wav_resampler_fir(const int16_t *x, const int16_t *h)
+{
+#if CONFIG_IDF_TARGET_ESP32S3
+    return (int16_t)esp_wav_resampler_fir16_esp32s3(x, h);
+#else
+    int32_t acc = 0;
+    for (int j = 0; j < WAV_RESAMPLER_TAPS; j++) {
+        acc += x[j] * h[j];
+    }
+    acc >>= 15;
+    return (int16_t)MIN(MAX(acc, INT16_MIN), INT16_MAX);
+#endif
+}
+
+size_t esp_wav_resampler_process(esp_wav_resampler_handle_t rs, const int16_t *in, size_t *in_frames, int16_t *out, size_t out_frames)
+{
+    assert(rs && in_frames && (in || *in_frames == 0) && out);
+
+    /* Take the input into the history of each channel */
+    const size_t take = MIN(*in_frames, WAV_RESAMPLER_TAPS + WAV_RESAMPLER_BLOCK - rs->filled);
+    for (uint8_t ch = 0; ch < rs->channels; ch++) {
+        int16_t *dst = &rs->hist[ch][rs->filled];
+        for (size_t i = 0; i < take; i++) {
+            dst[i] = in[i * rs->channels + ch];
+        }
+    }
+    rs->filled += take;
+    *in_frames = take;
+
+    /* End of the stream, the last input samples are moved to the center of the filter by silence */
+    const size_t space = WAV_RESAMPLER_TAPS + WAV_RESAMPLER_BLOCK - rs->filled;
+    if (take > 0) {
+        rs->pad = 0;
+    } else if (rs->pad < WAV_RESAMPLER_TAPS / 2 && space > 0) {
+        const size_t zeros = MIN(WAV_RESAMPLER_TAPS / 2 - rs->pad, space);
+        for (uint8_t ch = 0; ch < rs->channels; ch++) {
+            memset(&rs->hist[ch][rs->filled], 0, zeros * sizeof(int16_t));
+        }
+        rs->filled += zeros;
+        rs->pad += zeros;
+    }
+
+    size_t produced = 0;
+    while (produced < out_frames && rs->pos + WAV_RESAMPLER_TAPS <= rs->filled) {
+        const uint32_t phase = (rs->phases == rs->up ? rs->phase : (uint32_t)((uint64_t)rs->phase * rs->phases / rs->up));
+        const int16_t *h = &rs->coeffs[phase * WAV_RESAMPLER_TAPS];
+        for (uint8_t ch = 0; ch < rs->channels; ch++) {
+            out[produced * rs->channels + ch] = esp_wav_resampler_fir(&rs->hist[ch][rs->pos], h);
+        }
+        produced++;
+
+        rs->phase += rs->down;
+        rs->pos += rs->phase / rs->up;
+        rs->phase %= rs->up;
+    }
+
+    /* Keep the samples under the filter at the beginning of the history */
+    if (rs->pos > 0) {
+        const size_t keep = (rs->pos < rs->filled ? rs->filled - rs->pos : 0);
+        for (uint8_t ch = 0; ch < rs->channels; ch++) {
+            memmove(rs->hist[ch], &rs->hist[ch][rs->pos], keep * sizeof(int16_t));
+        }
+        rs->pos -= rs->filled - keep;
+        rs->filled = keep;
+    }
+    return produced;
+}
+
+void esp_wav_resampler_del(esp_wav_resampler_handle_t rs)
+{
+    if (rs == NULL) {
+        return;
+    }
+    heap_caps_free(rs->coeffs);
+    heap_caps_free(rs->hist[0]);
+    heap_caps_free(rs->hist[1]);
+    free(rs);
+}
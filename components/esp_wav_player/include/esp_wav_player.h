@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief WAV file player with read-ahead ring buffer
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_codec_dev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief WAV player handle
+ */
+typedef struct esp_wav_player_s *esp_wav_player_handle_t;
+
+/**
+ * @brief Callback called from writer task, when the playback ends or it is stopped
+ *
+ * @note The player is idle already, when it is called. It must not call esp_wav_player_del.
+ */
+typedef void (*esp_wav_player_done_cb_t)(esp_wav_player_handle_t player, void *user_ctx);
+
+/**
+ * @brief Configuration of the WAV player
+ */
+typedef struct {
+    esp_codec_dev_handle_t   codec;         /*!< Output codec device (e.g. from bsp_audio_codec_speaker_init) */
+    size_t                   ring_size;     /*!< Size of the ring buffer between reader and writer in bytes (0: 16 kB) */
+    size_t                   chunk_size;    /*!< Size of one file read and one codec write in bytes (0: 1 kB) */
+    int                      mclk_multiple; /*!< MCLK multiple of the sample rate (0: default of the codec) */
+    uint32_t                 sample_rate;   /*!< Fixed output sample rate, the files are resampled to it and the codec is not reopened
+                                                 between files (0: the codec is opened with the format of each file) */
+    uint8_t                  channels;      /*!< Output channels with fixed sample rate, 1 or 2 (0: 1), the output is 16 bit */
+    UBaseType_t              reader_priority; /*!< Priority of the reader task (0: 5) */
+    UBaseType_t              writer_priority; /*!< Priority of the writer task (0: 7), it should be higher than UI tasks */
+    esp_wav_player_done_cb_t done_cb;       /*!< Callback called, when the playback ends (optional) */
+    void                     *user_ctx;     /*!< User context of the done callback */
+} esp_wav_player_config_t;
+
+/**
+ * @brief Playback statistics
+ */
+typedef struct {
+    uint32_t underruns;         /*!< Codec writes, which were not filled from the ring buffer in time */
+    uint32_t underrun_bytes;    /*!< Bytes of silence written after underruns */
+    uint32_t bytes_played;      /*!< Bytes of the file written to the codec */
+    uint32_t min_ring_level;    /*!< Lowest fill of the ring buffer during playback in bytes */
+    uint32_t max_read_us;       /*!< Longest file read in microseconds */
+} esp_wav_player_stats_t;
+
+/**
+ * @brief Create WAV player
+ *
+ * The reader task reads the file into the ring buffer and the writer task keeps the codec (I2S DMA) fed from it,
+ * so latency spikes of the file system are hidden by the ring buffer.
+ *
+ * @param config     player configuration
+ * @param ret_player output player handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if configuration is wrong
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_wav_player_new(const esp_wav_player_config_t *config, esp_wav_player_handle_t *ret_player);
+
+/**
+ * @brief Start playing WAV file
+ *
+ * The previous playback is stopped. This function does not wait for the end of the playback.
+ *
+ * With fixed output sample rate (sample_rate in esp_wav_player_config_t), the codec is opened by the first play
+ * and it stays open, when the playback ends or the next file is played. Files of other formats are converted
+ * and resampled by a fixed-point polyphase filter, so switching of the files does not reconfigure the codec.
+ *
+ * @param player     player handle
+ * @param path       path of the WAV file
+ * @param repeat     play the file repeatedly until esp_wav_player_stop
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ *      - ESP_ERR_NOT_FOUND         if the file cannot be opened
+ *      - ESP_ERR_INVALID_RESPONSE  if the file is not supported WAV file
+ *      - ESP_FAIL                  if the codec cannot be opened
+ */
+esp_err_t esp_wav_player_play(esp_wav_player_handle_t player, const char *path, bool repeat);
+
+/**
+ * @brief Enable or disable repeating of the played file
+ *
+ * @param player     player handle
+ * @param repeat     play the file repeatedly until esp_wav_player_stop
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_wav_player_set_repeat(esp_wav_player_handle_t player, bool repeat);
+
+/**
+ * @brief Stop playing
+ *
+ * @note It waits until the reader and writer tasks are idle (one codec write and one file read at most).
+ *       The codec is closed also with fixed output sample rate (e.g. before recording on the same I2S).
+ *
+ * @param player     player handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_wav_player_stop(esp_wav_player_handle_t player);
+
+/**
+ * @brief Check, if the file is playing
+ *
+ * @param player     player handle
+ * @return true, if the file is playing
+ */
+bool esp_wav_player_is_playing(esp_wav_player_handle_t player);
+
+/**
+ * @brief Get playback statistics
+ *
+ * @param player     player handle
+ * @param stats      output statistics
+ * @param reset      reset the statistics after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_wav_player_get_stats(esp_wav_player_handle_t player, esp_wav_player_stats_t *stats, bool reset);
+
+/**
+ * @brief Delete WAV player
+ *
+ * @note The playback is stopped. The codec device is not deleted.
+ *
+ * @param player     player handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_wav_player_del(esp_wav_player_handle_t player);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Streaming fixed-point polyphase resampler of 16 bit PCM
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Resampler handle
+ */
+typedef struct esp_wav_resampler_s *esp_wav_resampler_handle_t;
+
+/**
+ * @brief Create resampler
+ *
+ * @param channels   interleaved channels of input and output, 1 or 2
+ * @param ret_rs     output resampler handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is wrong
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_wav_resampler_new(uint8_t channels, esp_wav_resampler_handle_t *ret_rs);
+
+/**
+ * @brief Set input and output sample rate
+ *
+ * Filter of all phases is calculated and the history is cleared (the stream starts from silence).
+ * The rate ratio is exact, when the reduced output rate (out_rate / gcd) is up to 256. Otherwise
+ * the phase is rounded to 1/256 of the input sample.
+ *
+ * @param rs         resampler handle
+ * @param in_rate    input sample rate
+ * @param out_rate   output sample rate
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if a rate is 0
+ */
+esp_err_t esp_wav_resampler_set_rate(esp_wav_resampler_handle_t rs, uint32_t in_rate, uint32_t out_rate);
+
+/**
+ * @brief Resample a block of frames
+ *
+ * Input is taken in blocks into the history of the filter, so the call either takes input or produces output.
+ * It is called again with the rest of the input, until in_frames is 0.
+ *
+ * At the end of the stream, it is called with in_frames 0 until it returns 0. The history is padded with silence,
+ * so all input frames are output.
+ *
+ * @param rs         resampler handle
+ * @param in         interleaved input frames
+ * @param[in,out] in_frames  input frames, output is the number of taken frames
+ * @param out        output buffer of interleaved frames
+ * @param out_frames size of the output buffer in frames
+ * @return number of output frames
+ */
+size_t esp_wav_resampler_process(esp_wav_resampler_handle_t rs, const int16_t *in, size_t *in_frames, int16_t *out, size_t out_frames);
+
+/**
+ * @brief Delete resampler
+ *
+ * @param rs         resampler handle
+ */
+void esp_wav_resampler_del(esp_wav_resampler_handle_t rs);
+
+#ifdef __cplusplus
+}
+#endif
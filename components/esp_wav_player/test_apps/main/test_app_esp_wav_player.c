@@ -0,0 +1,145 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/param.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_random.h"
+#include "esp_wav_resampler.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#define TEST_TAPS           (16)
+/* Input and output blocks of the player */
+#define TEST_IN_FRAMES      (256)
+#define TEST_OUT_FRAMES     (200)
+#define TEST_DC_LEFT        (10000)
+#define TEST_DC_RIGHT       (-5000)
+
+#if CONFIG_IDF_TARGET_ESP32S3
+extern int32_t esp_wav_resampler_fir16_esp32s3(const int16_t *x, const int16_t *h);
+
+/* C implementation of the resampler FIR */
+static int32_t test_fir16(const int16_t *x, const int16_t *h)
+{
+    int32_t acc = 0;
+    for (int j = 0; j < TEST_TAPS; j++) {
+        acc += x[j] * h[j];
+    }
+    acc >>= 15;
+    return MIN(MAX(acc, INT16_MIN), INT16_MAX);
+}
+
+TEST_CASE("Resampler FIR with vector instructions", "[resampler]")
+{
+    /* Kernel reads up to 16 bytes behind the last tap */
+    static int16_t x[TEST_TAPS * 2 + 8] __attribute__((aligned(16)));
+    static int16_t h[TEST_TAPS] __attribute__((aligned(16)));
+
+    for (int i = 0; i < 1000; i++) {
+        for (size_t j = 0; j < sizeof(x) / sizeof(x[0]); j++) {
+            x[j] = (int16_t)esp_random();
+        }
+        /* Sum of 16 products fits 32 bits, the result is saturated sometimes */
+        for (int j = 0; j < TEST_TAPS; j++) {
+            h[j] = (int16_t)(esp_random() % 4096) - 2048;
+        }
+        /* Position under the filter is at any sample of the history */
+        for (int offset = 0; offset < 8; offset++) {
+            TEST_ASSERT_EQUAL_INT32(test_fir16(&x[offset], h), esp_wav_resampler_fir16_esp32s3(&x[offset], h));
+        }
+    }
+}
+#endif
+
+/* Constant passes with unity gain, except of the filter transient at the start and at the end */
+static void test_check_out(const int16_t *out, size_t frames, size_t pos, size_t total, size_t transient)
+{
+    for (size_t i = 0; i < frames; i++, pos++) {
+        if (pos >= transient && pos < total - transient) {
+            TEST_ASSERT_INT_WITHIN(2, TEST_DC_LEFT, out[i * 2]);
+            TEST_ASSERT_INT_WITHIN(2, TEST_DC_RIGHT, out[i * 2 + 1]);
+        }
+    }
+}
+
+/*
+ * Resample one second of constant stereo frames in the blocks of the player, the end of the stream is drained.
+ * All input frames are output, one second of output frames.
+ */
+static void test_resample(uint32_t in_rate, uint32_t out_rate)
+{
+    static int16_t in[TEST_IN_FRAMES * 2];
+    static int16_t out[TEST_OUT_FRAMES * 2];
+    const size_t transient = TEST_TAPS * out_rate / in_rate + 1;
+    esp_wav_resampler_handle_t rs = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_resampler_new(2, &rs));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_resampler_set_rate(rs, in_rate, out_rate));
+    for (int i = 0; i < TEST_IN_FRAMES; i++) {
+        in[i * 2] = TEST_DC_LEFT;
+        in[i * 2 + 1] = TEST_DC_RIGHT;
+    }
+
+    size_t out_len = 0;
+    for (size_t frames = 0; frames < in_rate; ) {
+        const int16_t *src = in;
+        size_t left = MIN(TEST_IN_FRAMES, in_rate - frames);
+        frames += left;
+        while (left > 0) {
+            size_t taken = left;
+            const size_t produced = esp_wav_resampler_process(rs, src, &taken, out, TEST_OUT_FRAMES);
+            test_check_out(out, produced, out_len, out_rate, transient);
+            out_len += produced;
+            src += taken * 2;
+            left -= taken;
+        }
+    }
+    size_t produced;
+    do {
+        size_t taken = 0;
+        produced = esp_wav_resampler_process(rs, NULL, &taken, out, TEST_OUT_FRAMES);
+        TEST_ASSERT_EQUAL(0, taken);
+        test_check_out(out, produced, out_len, out_rate, transient);
+        out_len += produced;
+    } while (produced > 0);
+    TEST_ASSERT_EQUAL(out_rate, out_len);
+
+    esp_wav_resampler_del(rs);
+}
+
+TEST_CASE("Resampler 8 kHz to 44.1 kHz (rounded phase)", "[resampler]")
+{
+    test_resample(8000, 44100);
+}
+
+TEST_CASE("Resampler 44.1 kHz to 48 kHz", "[resampler]")
+{
+    test_resample(44100, 48000);
+}
+
+TEST_CASE("Resampler 48 kHz to 16 kHz", "[resampler]")
+{
+    test_resample(48000, 16000);
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (200)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
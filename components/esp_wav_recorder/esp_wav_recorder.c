@@ -0,0 +1,450 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <sys/param.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_vfs_fat.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/stream_buffer.h"
+#include "esp_wav_recorder.h"
+
+static const char *TAG = "WAV_REC";
+
+#define WAV_RECORDER_RING_SIZE_DEFAULT          (64 * 1024)
+#define WAV_RECORDER_BLOCK_SIZE_DEFAULT         (8 * 1024)
+#define WAV_RECORDER_CHUNK_SIZE_DEFAULT         (1024)
+#define WAV_RECORDER_CAPTURE_PRIORITY_DEFAULT   (7)
+#define WAV_RECORDER_WRITER_PRIORITY_DEFAULT    (3)
+#define WAV_RECORDER_TASK_STACK                 (3072)
+/* File systems write whole sectors directly from the block buffer */
+#define WAV_RECORDER_SECTOR_SIZE                (512)
+/* Timeout of blocking operations, when the stop flag is checked */
+#define WAV_RECORDER_STOP_CHECK_MS              (100)
+
+/* Event bits */
+#define WAV_RECORDER_CAPTURE_IDLE   (1 << 0)
+#define WAV_RECORDER_WRITER_IDLE    (1 << 1)
+#define WAV_RECORDER_CAPTURE_EXITED (1 << 2)
+#define WAV_RECORDER_WRITER_EXITED  (1 << 3)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+/* Canonical 44 bytes PCM WAV header */
+typedef struct __attribute__((packed))
+{
+    char     riff_id[4];
+    uint32_t riff_size;
+    char     wave_id[4];
+    char     fmt_id[4];
+    uint32_t fmt_size;
+    uint16_t audio_format;
+    uint16_t num_channels;
+    uint32_t sample_rate;
+    uint32_t byte_rate;
+    uint16_t block_align;
+    uint16_t bits_per_sample;
+    char     data_id[4];
+    uint32_t data_size;
+} esp_wav_recorder_header_t;
+
+struct esp_wav_recorder_s {
+    esp_codec_dev_handle_t  codec;
+    int                     mclk_multiple;
+    esp_wav_recorder_done_cb_t done_cb;
+    void                    *user_ctx;
+    size_t                  chunk_size;
+    size_t                  block_size;
+    size_t                  ring_size;
+    StreamBufferHandle_t    ring;           /* Captured samples waiting for the file */
+    StaticStreamBuffer_t    ring_struct;
+    uint8_t                 *ring_storage;
+    uint8_t                 *capture_buf;
+    uint8_t                 *block_buf;     /* Internal DMA capable memory, written without copy */
+    TaskHandle_t            capture_task;
+    TaskHandle_t            writer_task;
+    EventGroupHandle_t      events;
+    SemaphoreHandle_t       api_lock;
+    /* Recording */
+    FILE                    *file;
+    esp_wav_recorder_header_t header;
+    bool                    raw;
+    bool                    preallocated;
+    uint32_t                max_bytes;      /* Captured bytes of the recording (0: unlimited) */
+    size_t                  read_size;      /* chunk_size aligned to frames */
+    volatile bool           stop;
+    volatile bool           exit;
+    /* Statistics */
+    portMUX_TYPE            stats_lock;
+    esp_wav_recorder_stats_t stats;
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void esp_wav_recorder_capture_task(void *arg);
+static void esp_wav_recorder_writer_task(void *arg);
+static void esp_wav_recorder_stop_internal(esp_wav_recorder_handle_t recorder);
+static void esp_wav_recorder_free(esp_wav_recorder_handle_t recorder);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_wav_recorder_new(const esp_wav_recorder_config_t *config, esp_wav_recorder_handle_t *ret_recorder)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_recorder && config->codec, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_wav_recorder_handle_t recorder = calloc(1, sizeof(struct esp_wav_recorder_s));
+    ESP_RETURN_ON_FALSE(recorder, ESP_ERR_NO_MEM, TAG, "Not enough memory for recorder allocation!");
+    recorder->codec = config->codec;
+    recorder->mclk_multiple = config->mclk_multiple;
+    recorder->done_cb = config->done_cb;
+    recorder->user_ctx = config->user_ctx;
+    recorder->chunk_size = (config->chunk_size ? config->chunk_size : WAV_RECORDER_CHUNK_SIZE_DEFAULT);
+    recorder->block_size = (config->block_size ? config->block_size : WAV_RECORDER_BLOCK_SIZE_DEFAULT);
+    recorder->ring_size = (config->ring_size ? config->ring_size : WAV_RECORDER_RING_SIZE_DEFAULT);
+    portMUX_INITIALIZE(&recorder->stats_lock);
+    ESP_GOTO_ON_FALSE((recorder->block_size % WAV_RECORDER_SECTOR_SIZE) == 0, ESP_ERR_INVALID_ARG, err, TAG, "Block size must be multiple of 512!");
+    ESP_GOTO_ON_FALSE(recorder->ring_size >= 2 * recorder->block_size, ESP_ERR_INVALID_ARG, err, TAG, "Ring buffer must hold at least two blocks!");
+
+    /* Big ring buffer is in PSRAM, blocks are written from internal memory */
+    recorder->ring_storage = heap_caps_malloc_prefer(recorder->ring_size + 1, 2, MALLOC_CAP_SPIRAM, MALLOC_CAP_DEFAULT);
+    recorder->block_buf = heap_caps_malloc(recorder->block_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    recorder->capture_buf = malloc(recorder->chunk_size);
+    recorder->events = xEventGroupCreate();
+    recorder->api_lock = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(recorder->ring_storage && recorder->block_buf && recorder->capture_buf && recorder->events && recorder->api_lock,
+                      ESP_ERR_NO_MEM, err, TAG, "Not enough memory for recorder!");
+    recorder->ring = xStreamBufferCreateStatic(recorder->ring_size, 1, recorder->ring_storage, &recorder->ring_struct);
+    xEventGroupSetBits(recorder->events, WAV_RECORDER_CAPTURE_IDLE | WAV_RECORDER_WRITER_IDLE);
+
+    const UBaseType_t capture_priority = (config->capture_priority ? config->capture_priority : WAV_RECORDER_CAPTURE_PRIORITY_DEFAULT);
+    const UBaseType_t writer_priority = (config->writer_priority ? config->writer_priority : WAV_RECORDER_WRITER_PRIORITY_DEFAULT);
+    BaseType_t res = xTaskCreate(esp_wav_recorder_capture_task, "wav_capture", WAV_RECORDER_TASK_STACK, recorder, capture_priority, &recorder->capture_task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create capture task fail!");
+    res = xTaskCreate(esp_wav_recorder_writer_task, "wav_rec_writer", WAV_RECORDER_TASK_STACK, recorder, writer_priority, &recorder->writer_task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create writer task fail!");
+
+    *ret_recorder = recorder;
+    return ESP_OK;
+
+err:
+    esp_wav_recorder_free(recorder);
+    return ret;
+}
+
+esp_err_t esp_wav_recorder_start(esp_wav_recorder_handle_t recorder, const esp_wav_recorder_file_t *file)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(recorder && file && file->path, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(file->channels >= 1 && file->channels <= 2 && file->sample_rate > 0 &&
+                        (file->bits_per_sample == 8 || file->bits_per_sample == 16 || file->bits_per_sample == 24 || file->bits_per_sample == 32),
+                        ESP_ERR_INVALID_ARG, TAG, "Unsupported format");
+
+    xSemaphoreTake(recorder->api_lock, portMAX_DELAY);
+    esp_wav_recorder_stop_internal(recorder);
+
+    const size_t frame_size = file->channels * file->bits_per_sample / 8;
+    const uint32_t prealloc = (file->prealloc_bytes ? file->prealloc_bytes : file->max_bytes);
+    recorder->raw = file->raw;
+    recorder->preallocated = false;
+    if (file->base_path && prealloc > 0) {
+        /* Clusters are allocated at once, so the writes do not search the FAT */
+        const uint32_t size = prealloc + (file->raw ? 0 : sizeof(esp_wav_recorder_header_t));
+        if (esp_vfs_fat_create_contiguous_file(file->base_path, file->path, size, true) == ESP_OK) {
+            recorder->preallocated = true;
+        } else {
+            ESP_LOGW(TAG, "Preallocation of %s failed", file->path);
+        }
+    }
+    recorder->file = fopen(file->path, recorder->preallocated ? "r+b" : "wb");
+    ESP_GOTO_ON_FALSE(recorder->file, ESP_ERR_NOT_FOUND, err, TAG, "%s file cannot be created!", file->path);
+    /* Blocks go directly to the file system */
+    setvbuf(recorder->file, NULL, _IONBF, 0);
+
+    recorder->header = (esp_wav_recorder_header_t) {
+        .riff_id = {'R', 'I', 'F', 'F'},
+        .wave_id = {'W', 'A', 'V', 'E'},
+        .fmt_id = {'f', 'm', 't', ' '},
+        .fmt_size = 16,
+        .audio_format = 1,
+        .num_channels = file->channels,
+        .sample_rate = file->sample_rate,
+        .byte_rate = file->sample_rate * frame_size,
+        .block_align = frame_size,
+        .bits_per_sample = file->bits_per_sample,
+        .data_id = {'d', 'a', 't', 'a'},
+    };
+
+    esp_codec_dev_sample_info_t fs = {
+        .sample_rate = file->sample_rate,
+        .channel = file->channels,
+        .bits_per_sample = file->bits_per_sample,
+        .mclk_multiple = recorder->mclk_multiple,
+    };
+    ESP_GOTO_ON_FALSE(esp_codec_dev_open(recorder->codec, &fs) == ESP_CODEC_DEV_OK, ESP_FAIL, err, TAG, "Codec open failed");
+    ESP_LOGI(TAG, "Recording %s: %" PRIu8 " ch, %" PRIu8 " bit, %" PRIu32 " Hz", file->path, file->channels,
+             file->bits_per_sample, file->sample_rate);
+
+    /* Reads and the length are aligned to frames */
+    recorder->read_size = recorder->chunk_size - (recorder->chunk_size % frame_size);
+    recorder->max_bytes = file->max_bytes - (file->max_bytes % frame_size);
+    recorder->stop = false;
+
+    xEventGroupClearBits(recorder->events, WAV_RECORDER_CAPTURE_IDLE | WAV_RECORDER_WRITER_IDLE);
+    xTaskNotifyGive(recorder->capture_task);
+    xTaskNotifyGive(recorder->writer_task);
+    xSemaphoreGive(recorder->api_lock);
+    return ESP_OK;
+
+err:
+    if (recorder->file) {
+        fclose(recorder->file);
+        recorder->file = NULL;
+    }
+    xSemaphoreGive(recorder->api_lock);
+    return ret;
+}
+
+esp_err_t esp_wav_recorder_stop(esp_wav_recorder_handle_t recorder)
+{
+    ESP_RETURN_ON_FALSE(recorder, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    xSemaphoreTake(recorder->api_lock, portMAX_DELAY);
+    esp_wav_recorder_stop_internal(recorder);
+    xSemaphoreGive(recorder->api_lock);
+    return ESP_OK;
+}
+
+bool esp_wav_recorder_is_recording(esp_wav_recorder_handle_t recorder)
+{
+    assert(recorder);
+    return ((xEventGroupGetBits(recorder->events) & WAV_RECORDER_WRITER_IDLE) == 0);
+}
+
+esp_err_t esp_wav_recorder_get_stats(esp_wav_recorder_handle_t recorder, esp_wav_recorder_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(recorder && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    portENTER_CRITICAL(&recorder->stats_lock);
+    *stats = recorder->stats;
+    if (reset) {
+        memset(&recorder->stats, 0, sizeof(recorder->stats));
+    }
+    portEXIT_CRITICAL(&recorder->stats_lock);
+    return ESP_OK;
+}
+
+esp_err_t esp_wav_recorder_del(esp_wav_recorder_handle_t recorder)
+{
+    ESP_RETURN_ON_FALSE(recorder, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_wav_recorder_stop(recorder);
+    esp_wav_recorder_free(recorder);
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Called with API lock */
+static void esp_wav_recorder_stop_internal(esp_wav_recorder_handle_t recorder)
+{
+    recorder->stop = true;
+    /* Writer is idle after the capture */
+    xEventGroupWaitBits(recorder->events, WAV_RECORDER_WRITER_IDLE, pdFALSE, pdTRUE, portMAX_DELAY);
+}
+
+static void esp_wav_recorder_free(esp_wav_recorder_handle_t recorder)
+{
+    EventBits_t exited = 0;
+    recorder->exit = true;
+    if (recorder->capture_task) {
+        exited |= WAV_RECORDER_CAPTURE_EXITED;
+        xTaskNotifyGive(recorder->capture_task);
+    }
+    if (recorder->writer_task) {
+        exited |= WAV_RECORDER_WRITER_EXITED;
+        xTaskNotifyGive(recorder->writer_task);
+    }
+    if (exited) {
+        xEventGroupWaitBits(recorder->events, exited, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+
+    if (recorder->ring) {
+        vStreamBufferDelete(recorder->ring);
+    }
+    if (recorder->events) {
+        vEventGroupDelete(recorder->events);
+    }
+    if (recorder->api_lock) {
+        vSemaphoreDelete(recorder->api_lock);
+    }
+    free(recorder->ring_storage);
+    free(recorder->block_buf);
+    free(recorder->capture_buf);
+    free(recorder);
+}
+
+static void esp_wav_recorder_capture_task(void *arg)
+{
+    esp_wav_recorder_handle_t recorder = (esp_wav_recorder_handle_t)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (recorder->exit) {
+            break;
+        }
+
+        uint32_t captured = 0;
+        while (!recorder->stop) {
+            size_t len = recorder->read_size;
+            if (recorder->max_bytes) {
+                len = MIN(len, recorder->max_bytes - captured);
+                if (len == 0) {
+                    break;
+                }
+            }
+            if (esp_codec_dev_read(recorder->codec, recorder->capture_buf, len) != ESP_CODEC_DEV_OK) {
+                ESP_LOGE(TAG, "Codec read failed");
+                break;
+            }
+            captured += len;
+
+            /* The codec is never blocked by the file, whole chunk is dropped to keep the frames aligned */
+            const bool fits = (xStreamBufferSpacesAvailable(recorder->ring) >= len);
+            if (fits) {
+                xStreamBufferSend(recorder->ring, recorder->capture_buf, len, 0);
+            }
+            const size_t level = xStreamBufferBytesAvailable(recorder->ring);
+            portENTER_CRITICAL(&recorder->stats_lock);
+            recorder->stats.max_ring_level = MAX(recorder->stats.max_ring_level, level);
+            if (!fits) {
+                recorder->stats.overruns++;
+                recorder->stats.overrun_bytes += len;
+            }
+            portEXIT_CRITICAL(&recorder->stats_lock);
+        }
+
+        esp_codec_dev_close(recorder->codec);
+        xEventGroupSetBits(recorder->events, WAV_RECORDER_CAPTURE_IDLE);
+    }
+
+    xEventGroupSetBits(recorder->events, WAV_RECORDER_CAPTURE_EXITED);
+    vTaskDelete(NULL);
+}
+
+static bool esp_wav_recorder_write(esp_wav_recorder_handle_t recorder, size_t len)
+{
+    const int64_t start = esp_timer_get_time();
+    const bool ok = (fwrite(recorder->block_buf, 1, len, recorder->file) == len);
+    const uint32_t write_us = (uint32_t)(esp_timer_get_time() - start);
+
+    portENTER_CRITICAL(&recorder->stats_lock);
+    recorder->stats.max_write_us = MAX(recorder->stats.max_write_us, write_us);
+    if (!ok) {
+        recorder->stats.write_errors++;
+    }
+    portEXIT_CRITICAL(&recorder->stats_lock);
+
+    if (!ok) {
+        ESP_LOGE(TAG, "Error in writing to file, recording stopped");
+        recorder->stop = true;
+    }
+    return ok;
+}
+
+static void esp_wav_recorder_close(esp_wav_recorder_handle_t recorder, uint32_t data_size)
+{
+    const uint32_t header_size = (recorder->raw ? 0 : sizeof(esp_wav_recorder_header_t));
+
+    if (!recorder->raw) {
+        recorder->header.data_size = data_size;
+        recorder->header.riff_size = data_size + sizeof(esp_wav_recorder_header_t) - 8;
+        fseek(recorder->file, 0, SEEK_SET);
+        fwrite(&recorder->header, 1, sizeof(recorder->header), recorder->file);
+    }
+    /* Unused preallocated clusters are freed */
+    if (recorder->preallocated) {
+        fflush(recorder->file);
+        ftruncate(fileno(recorder->file), header_size + data_size);
+    }
+    fclose(recorder->file);
+    recorder->file = NULL;
+}
+
+static void esp_wav_recorder_writer_task(void *arg)
+{
+    esp_wav_recorder_handle_t recorder = (esp_wav_recorder_handle_t)arg;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (recorder->exit) {
+            break;
+        }
+
+        /* The header is in the first block, so all blocks are aligned to sectors of the file */
+        size_t fill = 0;
+        if (!recorder->raw) {
+            memcpy(recorder->block_buf, &recorder->header, sizeof(recorder->header));
+            fill = sizeof(recorder->header);
+        }
+        const size_t header_size = fill;
+        uint32_t written = 0;
+        bool failed = false;
+
+        while (1) {
+            const bool captured = ((xEventGroupGetBits(recorder->events) & WAV_RECORDER_CAPTURE_IDLE) != 0);
+            const size_t len = xStreamBufferReceive(recorder->ring, recorder->block_buf + fill, recorder->block_size - fill,
+                                                    captured ? 0 : pdMS_TO_TICKS(WAV_RECORDER_STOP_CHECK_MS));
+            fill += len;
+            if (fill == recorder->block_size) {
+                if (!failed) {
+                    failed = !esp_wav_recorder_write(recorder, fill);
+                    written += (failed ? 0 : fill);
+                }
+                fill = 0;
+            } else if (captured && len == 0) {
+                break;
+            }
+        }
+        /* Last partial block */
+        if (fill > 0 && !failed) {
+            failed = !esp_wav_recorder_write(recorder, fill);
+            written += (failed ? 0 : fill);
+        }
+
+        const uint32_t data_size = (written > header_size ? written - header_size : 0);
+        esp_wav_recorder_close(recorder, data_size);
+        portENTER_CRITICAL(&recorder->stats_lock);
+        recorder->stats.bytes_recorded += data_size;
+        portEXIT_CRITICAL(&recorder->stats_lock);
+        ESP_LOGI(TAG, "Recording stop, length: %" PRIu32 " bytes", data_size);
+
+        xStreamBufferReset(recorder->ring);
+        xEventGroupSetBits(recorder->events, WAV_RECORDER_WRITER_IDLE);
+
+        if (recorder->done_cb) {
+            recorder->done_cb(recorder, recorder->user_ctx);
+        }
+    }
+
+    xEventGroupSetBits(recorder->events, WAV_RECORDER_WRITER_EXITED);
+    vTaskDelete(NULL);
+}
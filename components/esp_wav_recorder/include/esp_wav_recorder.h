@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief WAV/PCM file recorder with ring buffer and aligned block writes
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_codec_dev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief WAV recorder handle
+ */
+typedef struct esp_wav_recorder_s *esp_wav_recorder_handle_t;
+
+/**
+ * @brief Callback called from writer task, when the recording ends or it is stopped
+ *
+ * @note The file is closed already, when it is called. It must not call esp_wav_recorder_del.
+ */
+typedef void (*esp_wav_recorder_done_cb_t)(esp_wav_recorder_handle_t recorder, void *user_ctx);
+
+/**
+ * @brief Configuration of the WAV recorder
+ */
+typedef struct {
+    esp_codec_dev_handle_t   codec;         /*!< Input codec device (e.g. from bsp_audio_codec_microphone_init) */
+    size_t                   ring_size;     /*!< Size of the ring buffer between capture and writer in bytes (0: 64 kB), it is allocated in PSRAM when available */
+    size_t                   block_size;    /*!< Size of one file write in bytes, multiple of 512 (0: 8 kB) */
+    size_t                   chunk_size;    /*!< Size of one codec read in bytes (0: 1 kB) */
+    int                      mclk_multiple; /*!< MCLK multiple of the sample rate (0: default of the codec) */
+    UBaseType_t              capture_priority; /*!< Priority of the capture task (0: 7), it should be higher than UI tasks */
+    UBaseType_t              writer_priority;  /*!< Priority of the writer task (0: 3) */
+    esp_wav_recorder_done_cb_t done_cb;     /*!< Callback called, when the recording ends (optional) */
+    void                     *user_ctx;     /*!< User context of the done callback */
+} esp_wav_recorder_config_t;
+
+/**
+ * @brief Recorded file
+ */
+typedef struct {
+    const char  *path;              /*!< Path of the file, it is overwritten */
+    const char  *base_path;         /*!< Mount point of the FAT file system for preallocation (NULL: not preallocated, e.g. SPIFFS) */
+    uint32_t    sample_rate;        /*!< Sample rate in Hz */
+    uint8_t     channels;           /*!< Number of channels (1 or 2) */
+    uint8_t     bits_per_sample;    /*!< Bits per sample (8, 16, 24 or 32) */
+    uint32_t    max_bytes;          /*!< Recording ends after this many bytes of samples (0: until esp_wav_recorder_stop) */
+    uint32_t    prealloc_bytes;     /*!< Size of preallocated file (0: max_bytes), the file is truncated at close */
+    bool        raw;                /*!< Raw PCM file without WAV header */
+} esp_wav_recorder_file_t;
+
+/**
+ * @brief Recording statistics
+ */
+typedef struct {
+    uint32_t overruns;          /*!< Codec reads, which did not fit into the ring buffer */
+    uint32_t overrun_bytes;     /*!< Bytes of samples dropped by overruns */
+    uint32_t bytes_recorded;    /*!< Bytes of samples written to the file */
+    uint32_t max_ring_level;    /*!< Highest fill of the ring buffer in bytes */
+    uint32_t max_write_us;      /*!< Longest file write in microseconds */
+    uint32_t write_errors;      /*!< Failed file writes, the recording is stopped after it */
+} esp_wav_recorder_stats_t;
+
+/**
+ * @brief Create WAV recorder
+ *
+ * The capture task keeps reading the codec (I2S DMA) into the ring buffer and the writer task writes the ring buffer
+ * to the file in large blocks, so latency spikes of the file system are hidden by the ring buffer.
+ *
+ * @param config       recorder configuration
+ * @param ret_recorder output recorder handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if configuration is wrong
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t esp_wav_recorder_new(const esp_wav_recorder_config_t *config, esp_wav_recorder_handle_t *ret_recorder);
+
+/**
+ * @brief Start recording into file
+ *
+ * The previous recording is stopped. This function does not wait for the end of the recording.
+ *
+ * @param recorder   recorder handle
+ * @param file       recorded file
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL or format is not supported
+ *      - ESP_ERR_NOT_FOUND         if the file cannot be created
+ *      - ESP_FAIL                  if the codec cannot be opened
+ */
+esp_err_t esp_wav_recorder_start(esp_wav_recorder_handle_t recorder, const esp_wav_recorder_file_t *file);
+
+/**
+ * @brief Stop recording
+ *
+ * Captured samples in the ring buffer are written, WAV header is updated and the file is closed.
+ *
+ * @param recorder   recorder handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_wav_recorder_stop(esp_wav_recorder_handle_t recorder);
+
+/**
+ * @brief Check, if the recording is running
+ *
+ * @param recorder   recorder handle
+ * @return true, the file is not closed yet
+ */
+bool esp_wav_recorder_is_recording(esp_wav_recorder_handle_t recorder);
+
+/**
+ * @brief Get recording statistics
+ *
+ * @param recorder   recorder handle
+ * @param stats      output statistics
+ * @param reset      reset the statistics after reading
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_wav_recorder_get_stats(esp_wav_recorder_handle_t recorder, esp_wav_recorder_stats_t *stats, bool reset);
+
+/**
+ * @brief Delete WAV recorder
+ *
+ * @note The recording is stopped. The codec device is not deleted.
+ *
+ * @param recorder   recorder handle
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if argument is NULL
+ */
+esp_err_t esp_wav_recorder_del(esp_wav_recorder_handle_t recorder);
+
+#ifdef __cplusplus
+}
+#endif
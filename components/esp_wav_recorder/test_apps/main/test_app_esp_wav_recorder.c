@@ -0,0 +1,338 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_vfs_fat.h"
+#include "esp_wav_recorder.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#define TEST_MOUNT_POINT    "/data"
+#define TEST_WAV_PATH       TEST_MOUNT_POINT "/test.wav"
+#define TEST_RAW_PATH       TEST_MOUNT_POINT "/test.pcm"
+#define TEST_CHUNK_SIZE     (512)
+#define TEST_BLOCK_SIZE     (2048)
+#define TEST_RING_SIZE      (8192)
+#define TEST_DONE_TIMEOUT   pdMS_TO_TICKS(2000)
+
+/* Canonical 44 bytes PCM WAV header */
+typedef struct __attribute__((packed))
+{
+    char     riff_id[4];
+    uint32_t riff_size;
+    char     wave_id[4];
+    char     fmt_id[4];
+    uint32_t fmt_size;
+    uint16_t audio_format;
+    uint16_t num_channels;
+    uint32_t sample_rate;
+    uint32_t byte_rate;
+    uint16_t block_align;
+    uint16_t bits_per_sample;
+    char     data_id[4];
+    uint32_t data_size;
+} test_wav_header_t;
+
+static wl_handle_t test_wl = WL_INVALID_HANDLE;
+
+/*
+ * Fake codec device: -Wl,--wrap replaces the codec functions called by the recorder.
+ * Samples are counting bytes from the open, one read takes one tick like the I2S DMA.
+ */
+static int test_codec;
+static esp_codec_dev_sample_info_t test_codec_fs;
+static int test_codec_open_ret;
+static volatile uint32_t test_codec_opens;
+static volatile uint32_t test_codec_closes;
+static uint8_t test_codec_next;
+
+int __wrap_esp_codec_dev_open(esp_codec_dev_handle_t codec, esp_codec_dev_sample_info_t *fs)
+{
+    assert(codec == (esp_codec_dev_handle_t)&test_codec);
+    test_codec_fs = *fs;
+    test_codec_next = 0;
+    test_codec_opens++;
+    return test_codec_open_ret;
+}
+
+int __wrap_esp_codec_dev_read(esp_codec_dev_handle_t codec, void *data, int len)
+{
+    uint8_t *buf = data;
+    for (int i = 0; i < len; i++) {
+        buf[i] = test_codec_next++;
+    }
+    vTaskDelay(1);
+    return ESP_CODEC_DEV_OK;
+}
+
+int __wrap_esp_codec_dev_close(esp_codec_dev_handle_t codec)
+{
+    test_codec_closes++;
+    return ESP_CODEC_DEV_OK;
+}
+
+static void test_done_cb(esp_wav_recorder_handle_t recorder, void *user_ctx)
+{
+    xSemaphoreGive((SemaphoreHandle_t)user_ctx);
+}
+
+/* FAT in flash with the recorded files removed */
+static void test_mount(void)
+{
+    const esp_vfs_fat_mount_config_t mount_cfg = {
+        .format_if_mount_failed = true,
+        .max_files = 4,
+        .allocation_unit_size = 4096,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_vfs_fat_spiflash_mount_rw_wl(TEST_MOUNT_POINT, "storage", &mount_cfg, &test_wl));
+    unlink(TEST_WAV_PATH);
+    unlink(TEST_RAW_PATH);
+}
+
+static void test_unmount(void)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, esp_vfs_fat_spiflash_unmount_rw_wl(TEST_MOUNT_POINT, test_wl));
+    test_wl = WL_INVALID_HANDLE;
+}
+
+static void test_setup(SemaphoreHandle_t *done, esp_wav_recorder_handle_t *recorder)
+{
+    test_codec_open_ret = ESP_CODEC_DEV_OK;
+    test_codec_opens = 0;
+    test_codec_closes = 0;
+    test_mount();
+
+    *done = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(*done);
+    const esp_wav_recorder_config_t cfg = {
+        .codec = (esp_codec_dev_handle_t)&test_codec,
+        .ring_size = TEST_RING_SIZE,
+        .block_size = TEST_BLOCK_SIZE,
+        .chunk_size = TEST_CHUNK_SIZE,
+        .done_cb = test_done_cb,
+        .user_ctx = *done,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_new(&cfg, recorder));
+}
+
+static void test_teardown(SemaphoreHandle_t done, esp_wav_recorder_handle_t recorder)
+{
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_del(recorder));
+    vSemaphoreDelete(done);
+    test_unmount();
+}
+
+static size_t test_file_size(const char *path)
+{
+    struct stat st;
+    TEST_ASSERT_EQUAL(0, stat(path, &st));
+    return st.st_size;
+}
+
+/* Header of the file and the counting samples after it */
+static void test_check_wav(const char *path, const test_wav_header_t *expected)
+{
+    FILE *f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    test_wav_header_t header;
+    TEST_ASSERT_EQUAL(sizeof(header), fread(&header, 1, sizeof(header), f));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, &header, sizeof(header));
+
+    uint8_t buf[256];
+    uint32_t pos = 0;
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), f)) > 0) {
+        for (size_t i = 0; i < len; i++, pos++) {
+            TEST_ASSERT_EQUAL_HEX8((uint8_t)pos, buf[i]);
+        }
+    }
+    fclose(f);
+    TEST_ASSERT_EQUAL(expected->data_size, pos);
+}
+
+static void test_wav_header_init(test_wav_header_t *header, uint8_t channels, uint8_t bits, uint32_t rate, uint32_t data_size)
+{
+    const uint16_t frame_size = channels * bits / 8;
+    *header = (test_wav_header_t) {
+        .riff_id = {'R', 'I', 'F', 'F'},
+        .riff_size = data_size + sizeof(test_wav_header_t) - 8,
+        .wave_id = {'W', 'A', 'V', 'E'},
+        .fmt_id = {'f', 'm', 't', ' '},
+        .fmt_size = 16,
+        .audio_format = 1,
+        .num_channels = channels,
+        .sample_rate = rate,
+        .byte_rate = rate * frame_size,
+        .block_align = frame_size,
+        .bits_per_sample = bits,
+        .data_id = {'d', 'a', 't', 'a'},
+        .data_size = data_size,
+    };
+}
+
+TEST_CASE("WAV header describes the recorded samples", "[wav_recorder]")
+{
+    SemaphoreHandle_t done;
+    esp_wav_recorder_handle_t recorder;
+    test_wav_header_t expected;
+    esp_wav_recorder_stats_t stats;
+    test_setup(&done, &recorder);
+
+    /* Length is not multiple of the block, the last block is partial */
+    esp_wav_recorder_file_t file = {
+        .path = TEST_WAV_PATH,
+        .sample_rate = 16000,
+        .channels = 2,
+        .bits_per_sample = 16,
+        .max_bytes = 10000,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_start(recorder, &file));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done, TEST_DONE_TIMEOUT));
+    TEST_ASSERT_FALSE(esp_wav_recorder_is_recording(recorder));
+    TEST_ASSERT_EQUAL(16000, test_codec_fs.sample_rate);
+    TEST_ASSERT_EQUAL(2, test_codec_fs.channel);
+    TEST_ASSERT_EQUAL(16, test_codec_fs.bits_per_sample);
+    TEST_ASSERT_EQUAL(1, test_codec_closes);
+
+    test_wav_header_init(&expected, 2, 16, 16000, 10000);
+    test_check_wav(TEST_WAV_PATH, &expected);
+    TEST_ASSERT_EQUAL(sizeof(test_wav_header_t) + 10000, test_file_size(TEST_WAV_PATH));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_get_stats(recorder, &stats, true));
+    TEST_ASSERT_EQUAL(10000, stats.bytes_recorded);
+    TEST_ASSERT_EQUAL(0, stats.overruns);
+    TEST_ASSERT_EQUAL(0, stats.write_errors);
+
+    /* Length is aligned to frames of 3 bytes, preallocated file is truncated at close */
+    file.sample_rate = 8000;
+    file.channels = 1;
+    file.bits_per_sample = 24;
+    file.max_bytes = 1000;
+    file.base_path = TEST_MOUNT_POINT;
+    file.prealloc_bytes = 32 * 1024;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_start(recorder, &file));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done, TEST_DONE_TIMEOUT));
+    test_wav_header_init(&expected, 1, 24, 8000, 999);
+    test_check_wav(TEST_WAV_PATH, &expected);
+    TEST_ASSERT_EQUAL(sizeof(test_wav_header_t) + 999, test_file_size(TEST_WAV_PATH));
+
+    /* Raw PCM has no header */
+    file.path = TEST_RAW_PATH;
+    file.raw = true;
+    file.base_path = NULL;
+    file.prealloc_bytes = 0;
+    file.max_bytes = 3000;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_start(recorder, &file));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done, TEST_DONE_TIMEOUT));
+    TEST_ASSERT_EQUAL(3000, test_file_size(TEST_RAW_PATH));
+
+    test_teardown(done, recorder);
+}
+
+TEST_CASE("WAV recorder state follows start and stop", "[wav_recorder]")
+{
+    SemaphoreHandle_t done;
+    esp_wav_recorder_handle_t recorder;
+    test_wav_header_t expected;
+    esp_wav_recorder_stats_t stats;
+    test_setup(&done, &recorder);
+    TEST_ASSERT_FALSE(esp_wav_recorder_is_recording(recorder));
+
+    esp_wav_recorder_file_t file = {
+        .path = TEST_WAV_PATH,
+        .sample_rate = 16000,
+        .channels = 1,
+        .bits_per_sample = 16,
+    };
+
+    /* Unsupported formats and errors do not start the recording */
+    file.channels = 3;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_wav_recorder_start(recorder, &file));
+    file.channels = 1;
+    file.bits_per_sample = 12;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_wav_recorder_start(recorder, &file));
+    file.bits_per_sample = 16;
+    file.path = TEST_MOUNT_POINT "/missing/test.wav";
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, esp_wav_recorder_start(recorder, &file));
+    file.path = TEST_WAV_PATH;
+    test_codec_open_ret = ESP_CODEC_DEV_DRV_ERR;
+    TEST_ASSERT_EQUAL(ESP_FAIL, esp_wav_recorder_start(recorder, &file));
+    test_codec_open_ret = ESP_CODEC_DEV_OK;
+    TEST_ASSERT_FALSE(esp_wav_recorder_is_recording(recorder));
+    TEST_ASSERT_EQUAL(0, test_codec_closes);
+    TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(done, 0));
+
+    /* Without max_bytes it records until stopped */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_start(recorder, &file));
+    vTaskDelay(pdMS_TO_TICKS(100));
+    TEST_ASSERT_TRUE(esp_wav_recorder_is_recording(recorder));
+    TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(done, 0));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_stop(recorder));
+    TEST_ASSERT_FALSE(esp_wav_recorder_is_recording(recorder));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done, TEST_DONE_TIMEOUT));
+    TEST_ASSERT_EQUAL(1, test_codec_closes);
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_get_stats(recorder, &stats, true));
+    TEST_ASSERT_GREATER_THAN(0, stats.bytes_recorded);
+    TEST_ASSERT_EQUAL(0, stats.bytes_recorded % 2);
+    TEST_ASSERT_EQUAL(0, stats.overruns);
+    TEST_ASSERT_EQUAL(0, stats.write_errors);
+    test_wav_header_init(&expected, 1, 16, 16000, stats.bytes_recorded);
+    test_check_wav(TEST_WAV_PATH, &expected);
+
+    /* Stopped recorder is stopped again without waiting */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_stop(recorder));
+    TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(done, 0));
+
+    /* New recording stops the running one */
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_start(recorder, &file));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    file.path = TEST_RAW_PATH;
+    file.raw = true;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_start(recorder, &file));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done, TEST_DONE_TIMEOUT));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_get_stats(recorder, &stats, true));
+    TEST_ASSERT_EQUAL(sizeof(test_wav_header_t) + stats.bytes_recorded, test_file_size(TEST_WAV_PATH));
+    TEST_ASSERT_TRUE(esp_wav_recorder_is_recording(recorder));
+    /* Failed codec open is not closed */
+    TEST_ASSERT_EQUAL(4, test_codec_opens);
+    TEST_ASSERT_EQUAL(2, test_codec_closes);
+
+    /* Deleting the recorder stops the recording */
+    vTaskDelay(pdMS_TO_TICKS(50));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_wav_recorder_del(recorder));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done, TEST_DONE_TIMEOUT));
+    TEST_ASSERT_EQUAL(test_codec_opens - 1, test_codec_closes);
+    TEST_ASSERT_GREATER_THAN(0, test_file_size(TEST_RAW_PATH));
+    vSemaphoreDelete(done);
+    test_unmount();
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (200)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    /* Deleted tasks are freed by the idle task */
+    vTaskDelay(pdMS_TO_TICKS(10));
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
@@ -5,9 +5,17 @@
  */
 
 #include <stdio.h>
-#include "driver/i2c.h"
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_timer.h"
 #include "fbm320.h"
 
+#define I2C_CLK_SPEED  400000
+#define I2C_TIMEOUT_MS 1000
+
 // FBM320 registers
 #define FBM320_WHO_AM_I                0x6Bu
 #define FBM320_CONFIG_REG              0xF4u
@@ -17,75 +25,86 @@
 #define FBM320_CALIBRATION_DATA_2      0xF1u // 1 byte
 #define FBM320_CALIBRATION_DATA_LEN    20u   // 20 bytes together
 
+#define FBM320_SAMPLER_TASK_STACK      3072
+
+// Fixed point (Q28) of the altitude calculation
+#define FBM320_Q                       28
+#define FBM320_Q_ONE                   ((int64_t)1 << FBM320_Q)
+#define FBM320_BARO_EXP_Q30            204293341   // 0.190263 (1 / 5.25588) in Q30
+#define FBM320_LN2_Q30                 744261118   // ln(2) in Q30
+#define FBM320_BARO_HEIGHT_CM          4433077     // 44330.77 m
+
 typedef struct {
     int32_t C0, C1, C2, C3, C4, C5, C6, C7, C8, C9, C10, C11, C12, C13;
 } fbm320_calibration_data_t;
 
+static const char *TAG = "FBM320";
+
 typedef struct {
-    i2c_port_t bus;
-    uint16_t dev_addr;
+    i2c_master_dev_handle_t i2c_handle;
     bool initialized;
     fbm320_calibration_data_t calibration_data;
+
+    // sampler
+    TaskHandle_t sampler_task;
+    TaskHandle_t sampler_stop_task;
+    volatile bool sampler_running;
+    fbm320_sampler_config_t sampler_config;
 } fbm320_dev_t;
 
 static esp_err_t fbm320_write(fbm320_handle_t sensor, const uint8_t reg_start_addr, const uint8_t *const data_buf, const uint8_t data_len)
 {
     fbm320_dev_t *sens = (fbm320_dev_t *) sensor;
-    esp_err_t  ret;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_WRITE, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, reg_start_addr, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write(cmd, data_buf, data_len, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_stop(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_cmd_begin(sens->bus, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
 
-    return ret;
+    assert(data_len < 4);
+    uint8_t write_buff[4] = {reg_start_addr};
+    memcpy(&write_buff[1], data_buf, data_len);
+    return i2c_master_transmit(sens->i2c_handle, write_buff, data_len + 1, I2C_TIMEOUT_MS);
 }
 
 static esp_err_t fbm320_read(fbm320_handle_t sensor, const uint8_t reg_start_addr, uint8_t *const data_buf, const uint8_t data_len)
 {
     fbm320_dev_t *sens = (fbm320_dev_t *) sensor;
-    esp_err_t ret;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_WRITE, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, reg_start_addr, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_READ, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_read(cmd, data_buf, data_len, I2C_MASTER_LAST_NACK);
-    assert(ESP_OK == ret);
-    ret = i2c_master_stop(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_cmd_begin(sens->bus, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
+    const uint8_t reg_buff[] = {reg_start_addr};
 
-    return ret;
+    return i2c_master_transmit_receive(sens->i2c_handle, reg_buff, sizeof(reg_buff), data_buf, data_len, I2C_TIMEOUT_MS);
 }
 
-fbm320_handle_t fbm320_create(i2c_port_t port, const uint16_t dev_addr)
+esp_err_t fbm320_create(i2c_master_bus_handle_t i2c_bus, const uint8_t dev_addr, fbm320_handle_t *handle_ret)
 {
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(i2c_bus && handle_ret, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
     fbm320_dev_t *sensor = (fbm320_dev_t *) calloc(1, sizeof(fbm320_dev_t));
-    sensor->bus = port;
-    sensor->dev_addr = dev_addr << 1;
+    ESP_RETURN_ON_FALSE(sensor, ESP_ERR_NO_MEM, TAG, "Not enough memory");
     sensor->initialized = false;
-    return (fbm320_handle_t) sensor;
+
+    // Add new I2C device
+    const i2c_device_config_t i2c_dev_cfg = {
+        .device_address = dev_addr,
+        .scl_speed_hz = I2C_CLK_SPEED,
+    };
+    ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(i2c_bus, &i2c_dev_cfg, &sensor->i2c_handle), err, TAG, "Failed to add new I2C device");
+
+    *handle_ret = sensor;
+    return ESP_OK;
+
+err:
+    fbm320_delete(sensor);
+    return ret;
 }
 
 void fbm320_delete(fbm320_handle_t sensor)
 {
     fbm320_dev_t *sens = (fbm320_dev_t *) sensor;
+
+    if (sens->sampler_task) {
+        fbm320_sampler_stop(sensor);
+    }
+
+    if (sens->i2c_handle) {
+        i2c_master_bus_rm_device(sens->i2c_handle);
+    }
     free(sens);
 }
 
@@ -147,41 +166,38 @@ static esp_err_t fbm320_read_result(fbm320_handle_t sensor, int32_t *const resul
     return ret;
 }
 
-esp_err_t fbm320_get_data(fbm320_handle_t sensor, const fbm320_measure_mode_t meas_mode, int32_t *const temperature, int32_t *const pressure)
+esp_err_t fbm320_start_temperature(fbm320_handle_t sensor)
 {
-    esp_err_t ret;
     fbm320_dev_t *sens = (fbm320_dev_t *) sensor;
     if (!sens->initialized) {
         return ESP_ERR_INVALID_STATE;
     }
 
-    int32_t temperature_raw, pressure_raw;
-
-    // trigger TEMPERATURE measurement and wait for result
     uint8_t cmd = 0x2e;
-    ret = fbm320_write(sensor, FBM320_CONFIG_REG, &cmd, 1);
-    if (ESP_OK != ret) {
-        return ret;
-    }
-    vTaskDelay(10 / portTICK_PERIOD_MS);
-    ret = fbm320_read_result(sensor, &temperature_raw);
-    if (ESP_OK != ret) {
-        return ret;
-    }
+    return fbm320_write(sensor, FBM320_CONFIG_REG, &cmd, 1);
+}
 
-    // trigger PRESSURE  measurement and wait for result
-    ret = fbm320_write(sensor, FBM320_CONFIG_REG, (uint8_t *)&meas_mode, 1);
-    if (ESP_OK != ret) {
-        return ret;
-    }
-    if (meas_mode == FBM320_MEAS_PRESS_OSR_8192) {
-        vTaskDelay(20 / portTICK_PERIOD_MS);
-    } else {
-        vTaskDelay(10 / portTICK_PERIOD_MS);
+esp_err_t fbm320_start_pressure(fbm320_handle_t sensor, const fbm320_measure_mode_t meas_mode)
+{
+    fbm320_dev_t *sens = (fbm320_dev_t *) sensor;
+    if (!sens->initialized) {
+        return ESP_ERR_INVALID_STATE;
     }
-    ret = fbm320_read_result(sensor, &pressure_raw);
-    if (ESP_OK != ret) {
-        return ret;
+
+    return fbm320_write(sensor, FBM320_CONFIG_REG, (uint8_t *)&meas_mode, 1);
+}
+
+esp_err_t fbm320_get_raw(fbm320_handle_t sensor, int32_t *const raw)
+{
+    return fbm320_read_result(sensor, raw);
+}
+
+esp_err_t fbm320_compensate(fbm320_handle_t sensor, const int32_t temperature_raw, const int32_t pressure_raw,
+                            int32_t *const temperature, int32_t *const pressure)
+{
+    fbm320_dev_t *sens = (fbm320_dev_t *) sensor;
+    if (!sens->initialized) {
+        return ESP_ERR_INVALID_STATE;
     }
 
     int32_t X01, X02, X03, X11, X12, X13, X21, X22, X23, X24, X25, X26, X31, X32;
@@ -216,5 +232,170 @@ esp_err_t fbm320_get_data(fbm320_handle_t sensor, const fbm320_measure_mode_t me
     X32 = (((((CF * cal_data->C11) >> 15) * PP4) >> 18) * PP4);
     *pressure = ((X31 + X32) >> 15) + PP4 + 99880;
 
-    return ret;
+    return ESP_OK;
+}
+
+static void fbm320_wait_us(const uint32_t wait_us)
+{
+    // vTaskDelay(n) waits from n - 1 to n ticks
+    vTaskDelay(((uint64_t)wait_us * configTICK_RATE_HZ + 999999) / 1000000 + 1);
+}
+
+static esp_err_t fbm320_measure_temperature(fbm320_handle_t sensor, int32_t *const temperature_raw)
+{
+    ESP_RETURN_ON_ERROR(fbm320_start_temperature(sensor), TAG, "start temperature failed");
+    fbm320_wait_us(FBM320_TEMPERATURE_WAIT_US);
+    return fbm320_read_result(sensor, temperature_raw);
+}
+
+static esp_err_t fbm320_measure_pressure(fbm320_handle_t sensor, const fbm320_measure_mode_t meas_mode, int32_t *const pressure_raw)
+{
+    ESP_RETURN_ON_ERROR(fbm320_start_pressure(sensor, meas_mode), TAG, "start pressure failed");
+    fbm320_wait_us(FBM320_PRESSURE_WAIT_US(meas_mode));
+    return fbm320_read_result(sensor, pressure_raw);
+}
+
+esp_err_t fbm320_get_data(fbm320_handle_t sensor, const fbm320_measure_mode_t meas_mode, int32_t *const temperature, int32_t *const pressure)
+{
+    esp_err_t ret;
+    int32_t temperature_raw, pressure_raw;
+
+    ret = fbm320_measure_temperature(sensor, &temperature_raw);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+
+    ret = fbm320_measure_pressure(sensor, meas_mode, &pressure_raw);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+
+    return fbm320_compensate(sensor, temperature_raw, pressure_raw, temperature, pressure);
+}
+
+esp_err_t fbm320_get_altitude(const int32_t pressure, const int32_t reference_pressure, int32_t *const altitude)
+{
+    if (pressure <= 0 || reference_pressure <= 0 || altitude == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // h = 44330.77 * (1 - (p / p0) ^ 0.190263), the power is calculated as exp(0.190263 * ln(2) * log2(p / p0))
+    int64_t ratio = ((int64_t)pressure << FBM320_Q) / reference_pressure;
+    int64_t log2_ratio = 0;
+    while (ratio < FBM320_Q_ONE) {
+        ratio <<= 1;
+        log2_ratio -= FBM320_Q_ONE;
+    }
+    while (ratio >= 2 * FBM320_Q_ONE) {
+        ratio >>= 1;
+        log2_ratio += FBM320_Q_ONE;
+    }
+    // fractional bits of log2 by repeated squaring
+    for (int64_t bit = FBM320_Q_ONE >> 1; bit > (FBM320_Q_ONE >> 26); bit >>= 1) {
+        ratio = (ratio * ratio) >> FBM320_Q;
+        if (ratio >= 2 * FBM320_Q_ONE) {
+            ratio >>= 1;
+            log2_ratio += bit;
+        }
+    }
+
+    // exp(x) by Taylor series, |x| < 0.2 for the whole range of the sensor
+    const int64_t x = (((log2_ratio * FBM320_BARO_EXP_Q30) >> 30) * FBM320_LN2_Q30) >> 30;
+    int64_t term = FBM320_Q_ONE;
+    int64_t power = FBM320_Q_ONE;
+    for (int n = 1; n <= 6; n++) {
+        term = ((term * x) >> FBM320_Q) / n;
+        power += term;
+    }
+
+    *altitude = (int32_t)((FBM320_BARO_HEIGHT_CM * (FBM320_Q_ONE - power)) >> FBM320_Q);
+    return ESP_OK;
+}
+
+static void fbm320_sampler_task(void *args)
+{
+    fbm320_dev_t *sens = (fbm320_dev_t *)args;
+    const fbm320_sampler_config_t *config = &sens->sampler_config;
+    const TickType_t period = pdMS_TO_TICKS(config->period_ms) ? pdMS_TO_TICKS(config->period_ms) : 1;
+    TickType_t next_wake = xTaskGetTickCount();
+    uint32_t count = 0;
+    int32_t temperature_raw = 0;
+    int32_t pressure_raw;
+    fbm320_sample_t sample;
+
+    while (sens->sampler_running) {
+        esp_err_t ret = ESP_OK;
+        if (count == 0) {
+            ret = fbm320_measure_temperature(sens, &temperature_raw);
+        }
+        if (ESP_OK == ret) {
+            sample.timestamp_us = esp_timer_get_time();
+            ret = fbm320_measure_pressure(sens, config->meas_mode, &pressure_raw);
+        }
+        if (ESP_OK == ret) {
+            ret = fbm320_compensate(sens, temperature_raw, pressure_raw, &sample.temperature, &sample.pressure);
+        }
+        if (ESP_OK == ret) {
+            ret = fbm320_get_altitude(sample.pressure, config->reference_pressure, &sample.altitude);
+        }
+        if (ESP_OK == ret) {
+            config->callback(sens, &sample, config->user_ctx);
+            count = (count + 1) % config->temperature_divider;
+        } else {
+            ESP_LOGW(TAG, "sample failed (%s)", esp_err_to_name(ret));
+            count = 0; // measure temperature again
+        }
+
+        // keep the period, skip the missed periods
+        next_wake += period;
+        const TickType_t now = xTaskGetTickCount();
+        if ((int32_t)(next_wake - now) <= 0) {
+            next_wake = now;
+        } else {
+            ulTaskNotifyTake(pdTRUE, next_wake - now); // woken up by fbm320_sampler_stop
+        }
+    }
+
+    TaskHandle_t stop_task = sens->sampler_stop_task;
+    sens->sampler_task = NULL;
+    xTaskNotifyGive(stop_task);
+    vTaskDelete(NULL);
+}
+
+esp_err_t fbm320_sampler_start(fbm320_handle_t sensor, const fbm320_sampler_config_t *config)
+{
+    fbm320_dev_t *sens = (fbm320_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens && config && config->callback && config->period_ms, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(sens->initialized && !sens->sampler_task, ESP_ERR_INVALID_STATE, TAG, "not initialized or sampler running");
+
+    sens->sampler_config = *config;
+    if (sens->sampler_config.temperature_divider == 0) {
+        sens->sampler_config.temperature_divider = 1;
+    }
+    if (sens->sampler_config.reference_pressure == 0) {
+        sens->sampler_config.reference_pressure = FBM320_SEA_LEVEL_PRESSURE;
+    }
+
+    sens->sampler_running = true;
+    BaseType_t res = xTaskCreate(fbm320_sampler_task, "FBM320 sampler", FBM320_SAMPLER_TASK_STACK, sens, config->task_priority, &sens->sampler_task);
+    if (pdPASS != res) {
+        sens->sampler_running = false;
+        sens->sampler_task = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t fbm320_sampler_stop(fbm320_handle_t sensor)
+{
+    fbm320_dev_t *sens = (fbm320_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(sens->sampler_task, ESP_ERR_INVALID_STATE, TAG, "sampler not running");
+
+    sens->sampler_stop_task = xTaskGetCurrentTaskHandle();
+    sens->sampler_running = false;
+    xTaskNotifyGive(sens->sampler_task);
+    // wait for the end of the running sample
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return ESP_OK;
 }
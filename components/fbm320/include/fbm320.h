@@ -15,7 +15,8 @@
 extern "C" {
 #endif
 
-#include "driver/i2c.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/i2c_master.h"
 
 /**
  * @brief FMB320 configurable I2C address
@@ -35,19 +36,71 @@ typedef enum {
     FBM320_MEAS_PRESS_OSR_8192  = 0xF4  /* 11ms wait for measurement */
 } fbm320_measure_mode_t;
 
+/**
+ * @brief Wait for the result of measurement started by fbm320_start_temperature / fbm320_start_pressure
+ *
+ * Conversion times of the datasheet with 10% margin.
+ */
+#define FBM320_TEMPERATURE_WAIT_US          (2750)
+#define FBM320_PRESSURE_WAIT_US(meas_mode)  ((meas_mode) == FBM320_MEAS_PRESS_OSR_8192 ? 12100 : \
+                                             (meas_mode) == FBM320_MEAS_PRESS_OSR_4096 ? 6600 : \
+                                             (meas_mode) == FBM320_MEAS_PRESS_OSR_2048 ? 4070 : 2750)
+#define FBM320_TEMPERATURE_WAIT_MS          ((FBM320_TEMPERATURE_WAIT_US + 999) / 1000)
+#define FBM320_PRESSURE_WAIT_MS(meas_mode)  ((FBM320_PRESSURE_WAIT_US(meas_mode) + 999) / 1000)
+
+/**
+ * @brief Standard pressure at sea level in [Pa]
+ */
+#define FBM320_SEA_LEVEL_PRESSURE   (101325)
+
 typedef void *fbm320_handle_t;
 
 /**
- * @brief Create sensor object and return a sensor handle
+ * @brief One sample of the sampler
+ */
+typedef struct {
+    int64_t timestamp_us;   /*!< Start of the pressure measurement (esp_timer_get_time) */
+    int32_t temperature;    /*!< Temperature in 0.01[deg C] */
+    int32_t pressure;       /*!< Pressure in [Pa] */
+    int32_t altitude;       /*!< Altitude above the reference pressure in [cm] */
+} fbm320_sample_t;
+
+/**
+ * @brief Callback of the sampler (called from the sampler task)
+ *
+ * @param sensor object handle of FBM320
+ * @param[in] sample New sample
+ * @param[in] user_ctx User context of the sampler configuration
+ */
+typedef void (*fbm320_sample_callback_t)(fbm320_handle_t sensor, const fbm320_sample_t *sample, void *user_ctx);
+
+/**
+ * @brief Configuration of the sampler
+ */
+typedef struct {
+    fbm320_measure_mode_t meas_mode;    /*!< Oversampling ratio of pressure measurement */
+    uint32_t period_ms;                 /*!< Period of samples (e.g. 20 for 50 Hz) */
+    uint32_t temperature_divider;       /*!< Temperature is measured with every N-th sample (0 or 1: every sample) */
+    int32_t reference_pressure;         /*!< Reference pressure of altitude in [Pa] (0: FBM320_SEA_LEVEL_PRESSURE) */
+    fbm320_sample_callback_t callback;  /*!< Callback of new sample */
+    void *user_ctx;                     /*!< User context passed to the callback */
+    UBaseType_t task_priority;          /*!< Priority of the sampler task */
+} fbm320_sampler_config_t;
+
+/**
+ * @brief Create sensor object
  *
- * @param     port     I2C port number
- * @param[in] dev_addr I2C device address of sensor
+ * @param[in]  i2c_bus    I2C bus handle. Obtained from i2c_new_master_bus()
+ * @param[in]  dev_addr   I2C device address of sensor. Can be FBM320_I2C_ADDRESS_0 or FBM320_I2C_ADDRESS_1
+ * @param[out] handle_ret Handle to created FBM320 driver object
  *
  * @return
- *     - NULL Fail
- *     - Others Success
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ *     - ESP_ERR_NO_MEM Not enough memory for the driver
+ *     - Others Error from underlying I2C driver
  */
-fbm320_handle_t fbm320_create(i2c_port_t port, const uint16_t dev_addr);
+esp_err_t fbm320_create(i2c_master_bus_handle_t i2c_bus, const uint8_t dev_addr, fbm320_handle_t *handle_ret);
 
 /**
  * @brief Delete and release a sensor object
@@ -98,6 +151,111 @@ esp_err_t fbm320_init(fbm320_handle_t sensor);
  */
 esp_err_t fbm320_get_data(fbm320_handle_t sensor, const fbm320_measure_mode_t meas_mode, int32_t *const temperature, int32_t *const pressure);
 
+/**
+ * @brief Start temperature measurement
+ *
+ * Non-blocking alternative of fbm320_get_data (e.g. for a scheduler of more sensors):
+ * start temperature, fbm320_get_raw after FBM320_TEMPERATURE_WAIT_US, start pressure,
+ * fbm320_get_raw after FBM320_PRESSURE_WAIT_US and fbm320_compensate.
+ *
+ * @param sensor
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE Sensor is not initialized
+ *     - ESP_FAIL Fail
+ */
+esp_err_t fbm320_start_temperature(fbm320_handle_t sensor);
+
+/**
+ * @brief Start pressure measurement
+ *
+ * @param sensor
+ * @param[in] meas_mode Oversampling ratio of pressure measurement
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE Sensor is not initialized
+ *     - ESP_FAIL Fail
+ */
+esp_err_t fbm320_start_pressure(fbm320_handle_t sensor, const fbm320_measure_mode_t meas_mode);
+
+/**
+ * @brief Read raw result of the last finished measurement
+ *
+ * @param sensor
+ * @param[out] raw Raw temperature or pressure
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_FAIL Fail
+ */
+esp_err_t fbm320_get_raw(fbm320_handle_t sensor, int32_t *const raw);
+
+/**
+ * @brief Calculate real pressure and temperature from raw measurements and calibration constants
+ *
+ * @param sensor
+ * @param[in] temperature_raw Raw temperature
+ * @param[in] pressure_raw Raw pressure
+ * @param[out] temperature Measured temperature in 0.01[deg C]
+ * @param[out] pressure Measured pressure in [Pa]
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE Sensor is not initialized
+ */
+esp_err_t fbm320_compensate(fbm320_handle_t sensor, const int32_t temperature_raw, const int32_t pressure_raw,
+                            int32_t *const temperature, int32_t *const pressure);
+
+/**
+ * @brief Calculate altitude from pressure
+ *
+ * Barometric formula of the standard atmosphere, calculated in fixed point (error below 1 cm from 300 to 1100 hPa).
+ *
+ * @param[in] pressure Measured pressure in [Pa]
+ * @param[in] reference_pressure Pressure at the reference altitude (e.g. FBM320_SEA_LEVEL_PRESSURE) in [Pa]
+ * @param[out] altitude Altitude above the reference in [cm]
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Pressure is not positive
+ */
+esp_err_t fbm320_get_altitude(const int32_t pressure, const int32_t reference_pressure, int32_t *const altitude);
+
+/**
+ * @brief Start periodic sampling of pressure, temperature and altitude
+ *
+ * The sampler task measures a sample every period_ms and passes it to the callback.
+ * Temperature changes slowly, measure it with every N-th sample only (temperature_divider) to shorten the samples.
+ *
+ * @note The waits for conversions are rounded up to FreeRTOS ticks, use CONFIG_FREERTOS_HZ=1000 for short periods.
+ * @note Other functions of the sensor must not be called while the sampler is running.
+ *
+ * @param sensor object handle of FBM320
+ * @param[in] config Sampler configuration
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid configuration
+ *     - ESP_ERR_INVALID_STATE Sensor is not initialized or the sampler is running
+ *     - ESP_ERR_NO_MEM Failed to create the sampler task
+ */
+esp_err_t fbm320_sampler_start(fbm320_handle_t sensor, const fbm320_sampler_config_t *config);
+
+/**
+ * @brief Stop the sampler
+ *
+ * Waits for the end of the running sample.
+ *
+ * @param sensor object handle of FBM320
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE Sampler is not running
+ */
+esp_err_t fbm320_sampler_stop(fbm320_handle_t sensor);
+
 #ifdef __cplusplus
 }
 #endif
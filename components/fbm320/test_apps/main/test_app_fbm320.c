@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "unity.h"
+#include "driver/i2c_master.h"
+#include "fbm320.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define I2C_MASTER_SCL_IO 26      /*!< gpio number for I2C master clock */
+#define I2C_MASTER_SDA_IO 25      /*!< gpio number for I2C master data  */
+#define I2C_MASTER_NUM I2C_NUM_0  /*!< I2C port number for master dev */
+
+static const char *TAG = "fbm320 test";
+static fbm320_handle_t fbm320 = NULL;
+static i2c_master_bus_handle_t i2c_handle = NULL;
+
+/**
+ * @brief i2c master initialization
+ */
+static void i2c_bus_init(void)
+{
+    const i2c_master_bus_config_t bus_config = {
+        .i2c_port = I2C_MASTER_NUM,
+        .sda_io_num = I2C_MASTER_SDA_IO,
+        .scl_io_num = I2C_MASTER_SCL_IO,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .flags.enable_internal_pullup = true,
+    };
+
+    esp_err_t ret = i2c_new_master_bus(&bus_config, &i2c_handle);
+    TEST_ASSERT_EQUAL_MESSAGE(ESP_OK, ret, "I2C install returned error");
+}
+
+/**
+ * @brief i2c master initialization
+ */
+static void i2c_sensor_fbm320_init(void)
+{
+    i2c_bus_init();
+    esp_err_t ret = fbm320_create(i2c_handle, FBM320_I2C_ADDRESS_1, &fbm320);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_NOT_NULL_MESSAGE(fbm320, "FBM320 create returned NULL");
+}
+
+TEST_CASE("Sensor fbm320 test", "[fbm320][iot][sensor]")
+{
+    esp_err_t ret;
+    uint8_t fbm320_deviceid;
+    int32_t temperature, pressure;
+
+    i2c_sensor_fbm320_init();
+
+    ret = fbm320_get_deviceid(fbm320, &fbm320_deviceid);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(FBM320_WHO_AM_I_VAL, fbm320_deviceid, "Who Am I register does not contain expected data");
+
+    ret = fbm320_init(fbm320);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    ret = fbm320_get_data(fbm320, FBM320_MEAS_PRESS_OSR_1024, &temperature, &pressure);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    ESP_LOGI(TAG, "pressure: %.1f kPa, temperature: %.1f degC", (float)pressure / 1000, (float)temperature / 100);
+
+    fbm320_delete(fbm320);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(10); // Give FreeRTOS some time to free its resources
+}
+
+TEST_CASE("Sensor fbm320 altitude test", "[fbm320][altitude]")
+{
+    int32_t altitude;
+
+    TEST_ASSERT_EQUAL(ESP_OK, fbm320_get_altitude(FBM320_SEA_LEVEL_PRESSURE, FBM320_SEA_LEVEL_PRESSURE, &altitude));
+    TEST_ASSERT_EQUAL(0, altitude);
+    // standard atmosphere: 1000 m at 89875 Pa, 5000 m at 54020 Pa
+    TEST_ASSERT_EQUAL(ESP_OK, fbm320_get_altitude(89875, FBM320_SEA_LEVEL_PRESSURE, &altitude));
+    TEST_ASSERT_INT32_WITHIN(100, 100000, altitude);
+    TEST_ASSERT_EQUAL(ESP_OK, fbm320_get_altitude(54020, FBM320_SEA_LEVEL_PRESSURE, &altitude));
+    TEST_ASSERT_INT32_WITHIN(100, 500000, altitude);
+    // below the reference
+    TEST_ASSERT_EQUAL(ESP_OK, fbm320_get_altitude(102000, FBM320_SEA_LEVEL_PRESSURE, &altitude));
+    TEST_ASSERT_LESS_THAN(0, altitude);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, fbm320_get_altitude(0, FBM320_SEA_LEVEL_PRESSURE, &altitude));
+}
+
+static void sampler_callback(fbm320_handle_t sensor, const fbm320_sample_t *sample, void *user_ctx)
+{
+    uint32_t *count = (uint32_t *)user_ctx;
+    if (*count % 10 == 0) {
+        ESP_LOGI(TAG, "pressure: %"PRIi32" Pa, temperature: %.2f degC, altitude: %.2f m",
+                 sample->pressure, (float)sample->temperature / 100, (float)sample->altitude / 100);
+    }
+    (*count)++;
+}
+
+TEST_CASE("Sensor fbm320 sampler test", "[fbm320][sampler]")
+{
+    esp_err_t ret;
+    uint32_t count = 0;
+
+    i2c_sensor_fbm320_init();
+    ret = fbm320_init(fbm320);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    const fbm320_sampler_config_t sampler_cfg = {
+        .meas_mode = FBM320_MEAS_PRESS_OSR_4096,
+        .period_ms = 20,
+        .temperature_divider = 10,
+        .callback = sampler_callback,
+        .user_ctx = &count,
+        .task_priority = 5,
+    };
+    ret = fbm320_sampler_start(fbm320, &sampler_cfg);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, fbm320_sampler_start(fbm320, &sampler_cfg));
+
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    ret = fbm320_sampler_stop(fbm320);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ESP_LOGI(TAG, "samples in 1 s: %"PRIu32, count);
+    TEST_ASSERT_UINT32_WITHIN(3, 50, count);
+
+    fbm320_delete(fbm320);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(10); // Give FreeRTOS some time to free its resources
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (500)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
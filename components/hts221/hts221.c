@@ -5,6 +5,8 @@
  */
 
 #include <stdio.h>
+#include <string.h>
+#include "esp_check.h"
 #include "hts221.h"
 #include "hts221_reg.h"
 
@@ -12,10 +14,14 @@
 #include "freertos/task.h"
 
 #define HTS221_I2C_ADDRESS    ((uint8_t)0x5F) // HTS221 constant address
+#define HTS221_AUTO_INCREMENT 0x80            // enable sequential read/write
+#define I2C_CLK_SPEED         400000
+#define I2C_TIMEOUT_MS        1000
+
+static const char *TAG = "HTS221";
 
 typedef struct {
-    i2c_port_t bus;
-    uint16_t dev_addr;
+    i2c_master_dev_handle_t i2c_handle;
     bool initialized;
 
     // Data-ready (DRDY) related variables
@@ -37,6 +43,10 @@ typedef struct {
         int16_t h1_rh;
         int16_t h0_t0_out;
         int16_t h1_t0_out;
+
+        // linear interpolation precomputed at hts221_init: value = offset + (out - out0) * gain
+        int32_t t_gain_q16;
+        int32_t h_gain_q16;
     } calibration_data;
 } hts221_dev_t;
 
@@ -68,13 +78,13 @@ static void drdy_task(void *args)
 
     // perform dummy read to reset DRDY status
     int16_t temperature, humidity;
-    hts221_get_humidity(args, &humidity);
-    hts221_get_temperature(args, &temperature);
+    hts221_get_data(args, &humidity, &temperature);
 
     while (1) {
         ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Wait for new data from ISR
-        hts221_get_humidity(args, &humidity);
-        hts221_get_temperature(args, &temperature);
+        if (hts221_get_data(args, &humidity, &temperature) != ESP_OK) {
+            continue;
+        }
         if (sens->drdy_callback != NULL) {
             sens->drdy_callback(humidity, temperature);
         }
@@ -85,22 +95,11 @@ static void drdy_task(void *args)
 static esp_err_t hts221_write(hts221_handle_t sensor, const uint8_t reg_start_addr, const uint8_t *const data_buf, const uint8_t data_len)
 {
     hts221_dev_t *sens = (hts221_dev_t *) sensor;
-    esp_err_t  ret;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_WRITE, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, reg_start_addr | 0x80, true); // enable sequential write
-    assert(ESP_OK == ret);
-    ret = i2c_master_write(cmd, data_buf, data_len, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_stop(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_cmd_begin(sens->bus, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
 
-    return ret;
+    assert(data_len < 4);
+    uint8_t write_buff[4] = {reg_start_addr | HTS221_AUTO_INCREMENT};
+    memcpy(&write_buff[1], data_buf, data_len);
+    return i2c_master_transmit(sens->i2c_handle, write_buff, data_len + 1, I2C_TIMEOUT_MS);
 }
 
 static inline esp_err_t hts221_write_byte(hts221_handle_t sensor, uint8_t const reg_addr, const uint8_t data)
@@ -111,26 +110,9 @@ static inline esp_err_t hts221_write_byte(hts221_handle_t sensor, uint8_t const
 static esp_err_t hts221_read(hts221_handle_t sensor, const uint8_t reg_start_addr, uint8_t *const data_buf, const uint8_t data_len)
 {
     hts221_dev_t *sens = (hts221_dev_t *) sensor;
-    esp_err_t ret;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_WRITE, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, reg_start_addr | 0x80, true); // enable sequential write
-    assert(ESP_OK == ret);
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_READ, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_read(cmd, data_buf, data_len, I2C_MASTER_LAST_NACK);
-    assert(ESP_OK == ret);
-    ret = i2c_master_stop(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_cmd_begin(sens->bus, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
+    const uint8_t reg_buff[] = {reg_start_addr | HTS221_AUTO_INCREMENT};
 
-    return ret;
+    return i2c_master_transmit_receive(sens->i2c_handle, reg_buff, sizeof(reg_buff), data_buf, data_len, I2C_TIMEOUT_MS);
 }
 
 static inline esp_err_t hts221_read_byte(hts221_handle_t sensor, const uint8_t reg, uint8_t *const data)
@@ -212,6 +194,12 @@ esp_err_t hts221_init(hts221_handle_t sensor, const hts221_config_t *const hts22
         return ESP_FAIL;
     }
 
+    // slopes of temperature and humidity in 0.1 units per LSB (Q16)
+    dev->calibration_data.t_gain_q16 = (((int32_t)(dev->calibration_data.t1_degc - dev->calibration_data.t0_degc) * 10) << 16) /
+                                       (int32_t)(dev->calibration_data.t1_out - dev->calibration_data.t0_out);
+    dev->calibration_data.h_gain_q16 = (((int32_t)(dev->calibration_data.h1_rh - dev->calibration_data.h0_rh) * 10) << 16) /
+                                       (int32_t)(dev->calibration_data.h1_t0_out - dev->calibration_data.h0_t0_out);
+
     // configure and activate it
     ret = hts221_set_config(sensor, hts221_config);
     assert(ESP_OK == ret);
@@ -297,6 +285,24 @@ esp_err_t hts221_start_oneshot(hts221_handle_t sensor)
     return hts221_set_reg_field(sensor, HTS221_CTRL_REG2, HTS221_ONE_SHOT_MASK, 0, 1);
 }
 
+static int16_t hts221_calc_humidity(const hts221_dev_t *dev, const int16_t h_out)
+{
+    int32_t humidity = dev->calibration_data.h0_rh * 10 +
+                       (int32_t)(((int64_t)(h_out - dev->calibration_data.h0_t0_out) * dev->calibration_data.h_gain_q16) >> 16);
+    if (humidity > 1000) {
+        humidity = 1000;
+    } else if (humidity < 0) {
+        humidity = 0;
+    }
+    return (int16_t)humidity;
+}
+
+static int16_t hts221_calc_temperature(const hts221_dev_t *dev, const int16_t t_out)
+{
+    return (int16_t)(dev->calibration_data.t0_degc * 10 +
+                     (int32_t)(((int64_t)(t_out - dev->calibration_data.t0_out) * dev->calibration_data.t_gain_q16) >> 16));
+}
+
 esp_err_t hts221_get_humidity(hts221_handle_t sensor, int16_t *const humidity)
 {
     esp_err_t ret;
@@ -308,15 +314,11 @@ esp_err_t hts221_get_humidity(hts221_handle_t sensor, int16_t *const humidity)
     }
 
     ret = hts221_read(sensor, HTS221_HR_OUT_L_REG, buffer, 2);
-    assert(ESP_OK == ret);
-    int16_t h_out = (int16_t)(((uint16_t)buffer[1]) << 8) | (uint16_t)buffer[0];
-
-    int32_t tmp_32 = ((int32_t)(h_out - dev->calibration_data.h0_t0_out)) * ((int32_t)(dev->calibration_data.h1_rh - dev->calibration_data.h0_rh) * 10);
-    *humidity = tmp_32 / (int32_t)(dev->calibration_data.h1_t0_out - dev->calibration_data.h0_t0_out)  + dev->calibration_data.h0_rh * 10;
-    if (*humidity > 1000) {
-        *humidity = 1000;
+    if (ESP_OK != ret) {
+        return ret;
     }
-    return ret;
+    *humidity = hts221_calc_humidity(dev, (int16_t)(((uint16_t)buffer[1] << 8) | buffer[0]));
+    return ESP_OK;
 }
 
 esp_err_t hts221_get_temperature(hts221_handle_t sensor, int16_t *const temperature)
@@ -330,12 +332,31 @@ esp_err_t hts221_get_temperature(hts221_handle_t sensor, int16_t *const temperat
     }
 
     ret = hts221_read(sensor, HTS221_TEMP_OUT_L_REG, buffer, 2);
-    assert(ESP_OK == ret);
-    int16_t t_out = (((uint16_t)buffer[1]) << 8) | (uint16_t)buffer[0];
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    *temperature = hts221_calc_temperature(dev, (int16_t)(((uint16_t)buffer[1] << 8) | buffer[0]));
+    return ESP_OK;
+}
 
-    int32_t tmp_32 = ((int32_t)(t_out - dev->calibration_data.t0_out)) * ((int32_t)(dev->calibration_data.t1_degc - dev->calibration_data.t0_degc) * 10);
-    *temperature = tmp_32 / (int32_t)(dev->calibration_data.t1_out - dev->calibration_data.t0_out) + dev->calibration_data.t0_degc * 10;
-    return ret;
+esp_err_t hts221_get_data(hts221_handle_t sensor, int16_t *const humidity, int16_t *const temperature)
+{
+    esp_err_t ret;
+    hts221_dev_t *dev = (hts221_dev_t *)sensor;
+    uint8_t buffer[4];
+
+    if (!dev->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // humidity and temperature output registers follow each other, read them in one transfer
+    ret = hts221_read(sensor, HTS221_HR_OUT_L_REG, buffer, sizeof(buffer));
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    *humidity = hts221_calc_humidity(dev, (int16_t)(((uint16_t)buffer[1] << 8) | buffer[0]));
+    *temperature = hts221_calc_temperature(dev, (int16_t)(((uint16_t)buffer[3] << 8) | buffer[2]));
+    return ESP_OK;
 }
 
 esp_err_t hts221_drdy_enable(hts221_handle_t sensor, const hts221_drdy_config_t *const config)
@@ -391,14 +412,29 @@ esp_err_t hts221_drdy_disable(hts221_handle_t sensor)
     }
 }
 
-hts221_handle_t hts221_create(const i2c_port_t port)
+esp_err_t hts221_create(i2c_master_bus_handle_t i2c_bus, hts221_handle_t *handle_ret)
 {
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(i2c_bus && handle_ret, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
     hts221_dev_t *sensor = (hts221_dev_t *) calloc(1, sizeof(hts221_dev_t));
-    sensor->bus = port;
-    sensor->dev_addr = HTS221_I2C_ADDRESS  << 1;
+    ESP_RETURN_ON_FALSE(sensor, ESP_ERR_NO_MEM, TAG, "Not enough memory");
     sensor->initialized = false;
     sensor->drdy_task_handle = NULL;
-    return (hts221_handle_t) sensor;
+
+    // Add new I2C device
+    const i2c_device_config_t i2c_dev_cfg = {
+        .device_address = HTS221_I2C_ADDRESS,
+        .scl_speed_hz = I2C_CLK_SPEED,
+    };
+    ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(i2c_bus, &i2c_dev_cfg, &sensor->i2c_handle), err, TAG, "Failed to add new I2C device");
+
+    *handle_ret = sensor;
+    return ESP_OK;
+
+err:
+    hts221_delete(sensor);
+    return ret;
 }
 
 void hts221_delete(hts221_handle_t sensor)
@@ -409,5 +445,8 @@ void hts221_delete(hts221_handle_t sensor)
     if (sens->drdy_task_handle != NULL) {
         hts221_drdy_disable(sensor);
     }
+    if (sens->i2c_handle) {
+        i2c_master_bus_rm_device(sens->i2c_handle);
+    }
     free(sens);
 }
@@ -15,7 +15,8 @@
 extern "C" {
 #endif
 
-#include "driver/i2c.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/i2c_master.h"
 #include "driver/gpio.h"
 
 /**
@@ -258,15 +259,32 @@ esp_err_t hts221_get_humidity(hts221_handle_t sensor, int16_t *const humidity);
 esp_err_t hts221_get_temperature(hts221_handle_t sensor, int16_t *const temperature);
 
 /**
- * @brief Create sensor object and return a sensor handle
+ * @brief Read HTS221 humidity and temperature output registers in one transfer, and calculate both values
  *
- * @param port     I2C port object handle
+ * @param sensor object handle of hts221
+ * @param[out] humidity pointer to the returned humidity value that must be divided by 10 to get the value in [%]
+ * @param[out] temperature pointer to the returned temperature value that must be divided by 10 to get the value in ['C]
  *
  * @return
- *     - NULL Fail
- *     - Others Success
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE Driver is not initialized
+ *     - ESP_FAIL Fail
+ */
+esp_err_t hts221_get_data(hts221_handle_t sensor, int16_t *const humidity, int16_t *const temperature);
+
+/**
+ * @brief Create sensor object
+ *
+ * @param[in]  i2c_bus    I2C bus handle. Obtained from i2c_new_master_bus()
+ * @param[out] handle_ret Handle to created HTS221 driver object
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ *     - ESP_ERR_NO_MEM Not enough memory for the driver
+ *     - Others Error from underlying I2C driver
  */
-hts221_handle_t hts221_create(const i2c_port_t port);
+esp_err_t hts221_create(i2c_master_bus_handle_t i2c_bus, hts221_handle_t *handle_ret);
 
 /**
  * @brief Init HTS221 sensor object
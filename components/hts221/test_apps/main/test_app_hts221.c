@@ -6,37 +6,38 @@
 
 #include <stdio.h>
 #include "unity.h"
-#include "driver/i2c.h"
+#include "driver/i2c_master.h"
 #include "hts221.h"
 #include "esp_system.h"
 #include "esp_log.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 #define I2C_MASTER_SCL_IO 26      /*!< gpio number for I2C master clock */
 #define I2C_MASTER_SDA_IO 25      /*!< gpio number for I2C master data  */
 #define I2C_MASTER_NUM I2C_NUM_0  /*!< I2C port number for master dev */
-#define I2C_MASTER_FREQ_HZ 100000 /*!< I2C master clock frequency */
 
 static const char *TAG = "hts221 test";
 static hts221_handle_t hts221 = NULL;
+static i2c_master_bus_handle_t i2c_handle = NULL;
 
 /**
  * @brief i2c master initialization
  */
 static void i2c_bus_init(void)
 {
-    i2c_config_t conf;
-    conf.mode = I2C_MODE_MASTER;
-    conf.sda_io_num = (gpio_num_t)I2C_MASTER_SDA_IO;
-    conf.sda_pullup_en = GPIO_PULLUP_ENABLE;
-    conf.scl_io_num = (gpio_num_t)I2C_MASTER_SCL_IO;
-    conf.scl_pullup_en = GPIO_PULLUP_ENABLE;
-    conf.master.clk_speed = I2C_MASTER_FREQ_HZ;
-    conf.clk_flags = I2C_SCLK_SRC_FLAG_FOR_NOMAL;
-
-    esp_err_t ret = i2c_param_config(I2C_MASTER_NUM, &conf);
-    TEST_ASSERT_EQUAL_MESSAGE(ESP_OK, ret, "I2C config returned error");
-
-    ret = i2c_driver_install(I2C_MASTER_NUM, conf.mode, 0, 0, 0);
+    const i2c_master_bus_config_t bus_config = {
+        .i2c_port = I2C_MASTER_NUM,
+        .sda_io_num = I2C_MASTER_SDA_IO,
+        .scl_io_num = I2C_MASTER_SCL_IO,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .flags.enable_internal_pullup = true,
+    };
+
+    esp_err_t ret = i2c_new_master_bus(&bus_config, &i2c_handle);
     TEST_ASSERT_EQUAL_MESSAGE(ESP_OK, ret, "I2C install returned error");
 }
 
@@ -46,7 +47,8 @@ static void i2c_bus_init(void)
 static void i2c_sensor_hts221_init(void)
 {
     i2c_bus_init();
-    hts221 = hts221_create(I2C_MASTER_NUM);
+    esp_err_t ret = hts221_create(i2c_handle, &hts221);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
     TEST_ASSERT_NOT_NULL_MESSAGE(hts221, "HTS221 create returned NULL");
 }
 
@@ -90,7 +92,32 @@ TEST_CASE("Sensor hts221 test", "[hts221][iot][sensor]")
     TEST_ASSERT_EQUAL(ESP_OK, ret);
     ESP_LOGI(TAG, "temperature value is: %2.2f degC", (float)temperature / 10);
 
+    int16_t humidity_both, temperature_both;
+    ret = hts221_get_data(hts221, &humidity_both, &temperature_both);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_INT16_WITHIN(50, humidity, humidity_both);
+    TEST_ASSERT_INT16_WITHIN(10, temperature, temperature_both);
+
     hts221_delete(hts221);
-    ret = i2c_driver_delete(I2C_MASTER_NUM);
+    ret = i2c_del_master_bus(i2c_handle);
     TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(10); // Give FreeRTOS some time to free its resources
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (500)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
 }
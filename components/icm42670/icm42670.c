@@ -11,6 +11,10 @@
 #include <sys/time.h>
 #include "esp_system.h"
 #include "esp_check.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "icm42670.h"
 
 #define I2C_CLK_SPEED 400000
@@ -30,6 +34,65 @@
 #define ICM42670_TEMP_DATA      0x09
 #define ICM42670_ACCEL_DATA     0x0B
 #define ICM42670_GYRO_DATA      0x11
+#define ICM42670_SIGNAL_PATH_RESET  0x02
+#define ICM42670_INT_CONFIG     0x06
+#define ICM42670_FIFO_CONFIG1   0x28
+#define ICM42670_FIFO_CONFIG2   0x29
+#define ICM42670_APEX_CONFIG0   0x25
+#define ICM42670_APEX_CONFIG1   0x26
+#define ICM42670_WOM_CONFIG     0x27
+#define ICM42670_INT_SOURCE0    0x2B
+#define ICM42670_INT_SOURCE1    0x2C
+#define ICM42670_INT_SOURCE4    0x2E
+#define ICM42670_APEX_DATA0     0x31
+#define ICM42670_INT_STATUS2    0x3B
+#define ICM42670_FIFO_COUNTH    0x3D
+#define ICM42670_FIFO_DATA      0x3F
+#define ICM42670_BLK_SEL_W      0x79
+#define ICM42670_MADDR_W        0x7A
+#define ICM42670_M_W            0x7B
+
+/* ICM42670 MREG1 register */
+#define ICM42670_MREG1_FIFO_CONFIG5 0x01
+#define ICM42670_MREG1_INT_SOURCE6  0x2F
+#define ICM42670_MREG1_INT_SOURCE7  0x30
+#define ICM42670_MREG1_WOM_X_THR    0x4B
+#define ICM42670_MREG1_WOM_Y_THR    0x4C
+#define ICM42670_MREG1_WOM_Z_THR    0x4D
+
+/* Register bits */
+#define ICM42670_PWR_MGMT0_IDLE             (1 << 4)
+#define ICM42670_SIGNAL_PATH_FIFO_FLUSH     (1 << 2)
+#define ICM42670_INT1_PUSH_PULL_HIGH        0x03    /* Pulsed, push-pull, active high */
+#define ICM42670_FIFO_BYPASS                (1 << 0)
+#define ICM42670_INT_SOURCE0_FIFO_THS       (1 << 2)
+#define ICM42670_FIFO_CONFIG5_WM_GT_TH      (1 << 5)
+#define ICM42670_FIFO_CONFIG5_GYRO_EN       (1 << 1)
+#define ICM42670_FIFO_CONFIG5_ACCEL_EN      (1 << 0)
+#define ICM42670_FIFO_HEADER_EMPTY          (1 << 7)
+#define ICM42670_FIFO_HEADER_ACCEL          (1 << 6)
+#define ICM42670_FIFO_HEADER_GYRO           (1 << 5)
+#define ICM42670_FIFO_HEADER_TMST           (1 << 3)
+#define ICM42670_INT_CONFIG_LATCHED_HIGH    0x07    /* Latched, push-pull, active high (INT1 bits, INT2 is shifted by 3) */
+#define ICM42670_APEX_CONFIG0_POWER_SAVE    (1 << 3)
+#define ICM42670_APEX_CONFIG0_DMP_INIT      (1 << 2)
+#define ICM42670_APEX_CONFIG0_MEM_RESET     (1 << 0)
+#define ICM42670_APEX_CONFIG1_SMD           (1 << 6)
+#define ICM42670_APEX_CONFIG1_TILT          (1 << 4)
+#define ICM42670_APEX_CONFIG1_PED           (1 << 3)
+#define ICM42670_WOM_CONFIG_EN              (1 << 0)
+#define ICM42670_WOM_CONFIG_PREVIOUS        (1 << 1)
+#define ICM42670_WOM_CONFIG_AND             (1 << 2)
+#define ICM42670_INT_SOURCE1_SMD            (1 << 3)
+#define ICM42670_INT_SOURCE1_WOM            (0x07)
+#define ICM42670_INT_SOURCE6_STEP_DET       (1 << 5)
+#define ICM42670_INT_SOURCE6_STEP_CNT_OVF   (1 << 4)
+#define ICM42670_INT_SOURCE6_TILT           (1 << 3)
+
+#define ICM42670_FIFO_PACKET_SIZE_1     8   /* Header, one sensor, temperature */
+#define ICM42670_FIFO_PACKET_SIZE_2     16  /* Header, accelerometer, gyroscope, temperature, timestamp */
+#define ICM42670_FIFO_READ_PACKETS      64  /* Packets read in one I2C transaction */
+#define ICM42670_FIFO_WM_MAX            0xFFF
 
 /* Sensitivity of the gyroscope */
 #define GYRO_FS_2000_SENSITIVITY (16.4)
@@ -52,6 +115,15 @@ typedef struct {
     uint32_t counter;
     float dt;  /*!< delay time between two measurements, dt should be small (ms level) */
     struct timeval *timer;
+    uint8_t *fifo_buf;          /*!< Buffer of one FIFO burst read (NULL: FIFO not configured) */
+    uint8_t fifo_packet_size;   /*!< Size of FIFO packet [bytes] */
+    uint32_t fifo_period_us;    /*!< Period of FIFO packets (ODR) */
+    uint16_t apex_odr_hz;       /*!< Rate of APEX algorithms (0: APEX not configured) */
+    bool scale_valid;           /*!< Sensitivities below match the full scale ranges of the sensor */
+    float acce_sensitivity;     /*!< Accelerometer sensitivity [LSB/g] */
+    float gyro_sensitivity;     /*!< Gyroscope sensitivity [LSB/dps] */
+    float acce_scale;           /*!< Reciprocal of accelerometer sensitivity */
+    float gyro_scale;           /*!< Reciprocal of gyroscope sensitivity */
 } icm42670_dev_t;
 
 /*******************************************************************************
@@ -60,7 +132,14 @@ typedef struct {
 static esp_err_t icm42670_write(icm42670_handle_t sensor, const uint8_t reg_start_addr, const uint8_t *data_buf, const uint8_t data_len);
 static esp_err_t icm42670_read(icm42670_handle_t sensor, const uint8_t reg_start_addr, uint8_t *data_buf, const uint8_t data_len);
 
+static esp_err_t icm42670_read_fifo_data(icm42670_handle_t sensor, uint8_t *data_buf, size_t data_len);
+static esp_err_t icm42670_write_mreg1(icm42670_handle_t sensor, uint8_t reg, uint8_t value);
+
 static esp_err_t icm42670_get_raw_value(icm42670_handle_t sensor, uint8_t reg, icm42670_raw_value_t *value);
+static esp_err_t icm42670_load_scale(icm42670_handle_t sensor);
+static void icm42670_set_scale(icm42670_handle_t sensor, uint8_t gyro_config0, uint8_t accel_config0);
+static uint32_t icm42670_odr_period_us(uint8_t odr);
+static esp_err_t icm42670_route_int(icm42670_handle_t sensor, icm42670_int_pin_t pin, uint8_t source1_mask, uint8_t source1_bits);
 
 /*******************************************************************************
 * Local variables
@@ -115,6 +194,10 @@ void icm42670_delete(icm42670_handle_t sensor)
         free(sens->timer);
     }
 
+    if (sens->fifo_buf) {
+        free(sens->fifo_buf);
+    }
+
     free(sens);
 }
 
@@ -142,7 +225,15 @@ esp_err_t icm42670_config(icm42670_handle_t sensor, const icm42670_cfg_t *config
     /* Accelerometer */
     data[1] = ((config->acce_fs & 0x03) << 5) | (config->acce_odr & 0x0F);
 
-    return icm42670_write(sensor, ICM42670_GYRO_CONFIG0, data, sizeof(data));
+    esp_err_t ret = icm42670_write(sensor, ICM42670_GYRO_CONFIG0, data, sizeof(data));
+    if (ret == ESP_OK) {
+        icm42670_set_scale(sensor, data[0], data[1]);
+    } else {
+        /* The registers may be written partially, they are read at the next conversion */
+        ((icm42670_dev_t *) sensor)->scale_valid = false;
+    }
+
+    return ret;
 }
 
 esp_err_t icm42670_acce_set_pwr(icm42670_handle_t sensor, icm42670_acce_pwr_t state)
@@ -177,64 +268,28 @@ esp_err_t icm42670_gyro_set_pwr(icm42670_handle_t sensor, icm42670_gyro_pwr_t st
 
 esp_err_t icm42670_get_acce_sensitivity(icm42670_handle_t sensor, float *sensitivity)
 {
-    esp_err_t ret = ESP_FAIL;
-    uint8_t acce_fs;
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
 
     assert(sensitivity != NULL);
 
     *sensitivity = 0;
+    ESP_RETURN_ON_ERROR(icm42670_load_scale(sensor), TAG, "Read full scale error!");
+    *sensitivity = sens->acce_sensitivity;
 
-    ret = icm42670_read(sensor, ICM42670_ACCEL_CONFIG0, &acce_fs, 1);
-    if (ret == ESP_OK) {
-        acce_fs = (acce_fs >> 5) & 0x03;
-        switch (acce_fs) {
-        case ACCE_FS_16G:
-            *sensitivity = ACCE_FS_16G_SENSITIVITY;
-            break;
-        case ACCE_FS_8G:
-            *sensitivity = ACCE_FS_8G_SENSITIVITY;
-            break;
-        case ACCE_FS_4G:
-            *sensitivity = ACCE_FS_4G_SENSITIVITY;
-            break;
-        case ACCE_FS_2G:
-            *sensitivity = ACCE_FS_2G_SENSITIVITY;
-            break;
-        }
-    }
-
-    return ret;
+    return ESP_OK;
 }
 
 esp_err_t icm42670_get_gyro_sensitivity(icm42670_handle_t sensor, float *sensitivity)
 {
-    esp_err_t ret = ESP_FAIL;
-    uint8_t gyro_fs;
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
 
     assert(sensitivity != NULL);
 
     *sensitivity = 0;
+    ESP_RETURN_ON_ERROR(icm42670_load_scale(sensor), TAG, "Read full scale error!");
+    *sensitivity = sens->gyro_sensitivity;
 
-    ret = icm42670_read(sensor, ICM42670_GYRO_CONFIG0, &gyro_fs, 1);
-    if (ret == ESP_OK) {
-        gyro_fs = (gyro_fs >> 5) & 0x03;
-        switch (gyro_fs) {
-        case GYRO_FS_2000DPS:
-            *sensitivity = GYRO_FS_2000_SENSITIVITY;
-            break;
-        case GYRO_FS_1000DPS:
-            *sensitivity = GYRO_FS_1000_SENSITIVITY;
-            break;
-        case GYRO_FS_500DPS:
-            *sensitivity = GYRO_FS_500_SENSITIVITY;
-            break;
-        case GYRO_FS_250DPS:
-            *sensitivity = GYRO_FS_250_SENSITIVITY;
-            break;
-        }
-    }
-
-    return ret;
+    return ESP_OK;
 }
 
 esp_err_t icm42670_get_temp_raw_value(icm42670_handle_t sensor, uint16_t *value)
@@ -266,8 +321,7 @@ esp_err_t icm42670_get_gyro_raw_value(icm42670_handle_t sensor, icm42670_raw_val
 
 esp_err_t icm42670_get_acce_value(icm42670_handle_t sensor, icm42670_value_t *value)
 {
-    esp_err_t ret;
-    float sensitivity;
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
     icm42670_raw_value_t raw_value;
 
     assert(value != NULL);
@@ -276,23 +330,19 @@ esp_err_t icm42670_get_acce_value(icm42670_handle_t sensor, icm42670_value_t *va
     value->y = 0;
     value->z = 0;
 
-    ret = icm42670_get_acce_sensitivity(sensor, &sensitivity);
-    ESP_RETURN_ON_ERROR(ret, TAG, "Get sensitivity error!");
-
-    ret = icm42670_get_acce_raw_value(sensor, &raw_value);
-    ESP_RETURN_ON_ERROR(ret, TAG, "Get raw value error!");
+    ESP_RETURN_ON_ERROR(icm42670_load_scale(sensor), TAG, "Get sensitivity error!");
+    ESP_RETURN_ON_ERROR(icm42670_get_acce_raw_value(sensor, &raw_value), TAG, "Get raw value error!");
 
-    value->x = raw_value.x / sensitivity;
-    value->y = raw_value.y / sensitivity;
-    value->z = raw_value.z / sensitivity;
+    value->x = raw_value.x * sens->acce_scale;
+    value->y = raw_value.y * sens->acce_scale;
+    value->z = raw_value.z * sens->acce_scale;
 
     return ESP_OK;
 }
 
 esp_err_t icm42670_get_gyro_value(icm42670_handle_t sensor, icm42670_value_t *value)
 {
-    esp_err_t ret;
-    float sensitivity;
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
     icm42670_raw_value_t raw_value;
 
     assert(value != NULL);
@@ -301,15 +351,37 @@ esp_err_t icm42670_get_gyro_value(icm42670_handle_t sensor, icm42670_value_t *va
     value->y = 0;
     value->z = 0;
 
-    ret = icm42670_get_gyro_sensitivity(sensor, &sensitivity);
-    ESP_RETURN_ON_ERROR(ret, TAG, "Get sensitivity error!");
+    ESP_RETURN_ON_ERROR(icm42670_load_scale(sensor), TAG, "Get sensitivity error!");
+    ESP_RETURN_ON_ERROR(icm42670_get_gyro_raw_value(sensor, &raw_value), TAG, "Get raw value error!");
 
-    ret = icm42670_get_gyro_raw_value(sensor, &raw_value);
-    ESP_RETURN_ON_ERROR(ret, TAG, "Get raw value error!");
+    value->x = raw_value.x * sens->gyro_scale;
+    value->y = raw_value.y * sens->gyro_scale;
+    value->z = raw_value.z * sens->gyro_scale;
 
-    value->x = raw_value.x / sensitivity;
-    value->y = raw_value.y / sensitivity;
-    value->z = raw_value.z / sensitivity;
+    return ESP_OK;
+}
+
+esp_err_t icm42670_get_acce_gyro_value(icm42670_handle_t sensor, icm42670_value_t *acce_value, icm42670_value_t *gyro_value)
+{
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
+    uint8_t data[12];
+
+    assert(acce_value != NULL);
+    assert(gyro_value != NULL);
+
+    memset(acce_value, 0, sizeof(icm42670_value_t));
+    memset(gyro_value, 0, sizeof(icm42670_value_t));
+
+    ESP_RETURN_ON_ERROR(icm42670_load_scale(sensor), TAG, "Get sensitivity error!");
+    /* Accelerometer and gyroscope registers follow each other, one read gives a consistent sample */
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_ACCEL_DATA, data, sizeof(data)), TAG, "Get raw value error!");
+
+    acce_value->x = (int16_t)((data[0] << 8) + data[1]) * sens->acce_scale;
+    acce_value->y = (int16_t)((data[2] << 8) + data[3]) * sens->acce_scale;
+    acce_value->z = (int16_t)((data[4] << 8) + data[5]) * sens->acce_scale;
+    gyro_value->x = (int16_t)((data[6] << 8) + data[7]) * sens->gyro_scale;
+    gyro_value->y = (int16_t)((data[8] << 8) + data[9]) * sens->gyro_scale;
+    gyro_value->z = (int16_t)((data[10] << 8) + data[11]) * sens->gyro_scale;
 
     return ESP_OK;
 }
@@ -331,10 +403,395 @@ esp_err_t icm42670_get_temp_value(icm42670_handle_t sensor, float *value)
     return ESP_OK;
 }
 
+esp_err_t icm42670_fifo_config(icm42670_handle_t sensor, const icm42670_fifo_cfg_t *config)
+{
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
+    uint8_t data[2];
+
+    assert(sens);
+    assert(config != NULL);
+
+    /* FIFO is stopped while the packets are changed */
+    data[0] = ICM42670_FIFO_BYPASS;
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_FIFO_CONFIG1, data, 1), TAG, "FIFO bypass error!");
+    free(sens->fifo_buf);
+    sens->fifo_buf = NULL;
+
+    uint8_t fifo_config5 = ICM42670_FIFO_CONFIG5_WM_GT_TH;
+    fifo_config5 |= config->acce ? ICM42670_FIFO_CONFIG5_ACCEL_EN : 0;
+    fifo_config5 |= config->gyro ? ICM42670_FIFO_CONFIG5_GYRO_EN : 0;
+    ESP_RETURN_ON_ERROR(icm42670_write_mreg1(sensor, ICM42670_MREG1_FIFO_CONFIG5, fifo_config5), TAG, "FIFO packet config error!");
+
+    /* Interrupt on watermark */
+    uint8_t int_source0;
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_INT_SOURCE0, &int_source0, 1), TAG, "Read interrupt sources error!");
+    if (config->int1_watermark) {
+        data[0] = ICM42670_INT1_PUSH_PULL_HIGH;
+        ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_INT_CONFIG, data, 1), TAG, "INT1 config error!");
+        int_source0 |= ICM42670_INT_SOURCE0_FIFO_THS;
+    } else {
+        int_source0 &= ~ICM42670_INT_SOURCE0_FIFO_THS;
+    }
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_INT_SOURCE0, &int_source0, 1), TAG, "Write interrupt sources error!");
+
+    if (!config->acce && !config->gyro) {
+        return ESP_OK;
+    }
+
+    sens->fifo_packet_size = (config->acce && config->gyro) ? ICM42670_FIFO_PACKET_SIZE_2 : ICM42670_FIFO_PACKET_SIZE_1;
+    sens->fifo_buf = malloc(ICM42670_FIFO_READ_PACKETS * sens->fifo_packet_size);
+    ESP_RETURN_ON_FALSE(sens->fifo_buf, ESP_ERR_NO_MEM, TAG, "Not enough memory");
+
+    /* Packets of both sensors come with the faster ODR (smaller value) */
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_GYRO_CONFIG0, data, 2), TAG, "Read ODR error!");
+    const uint8_t gyro_odr = data[0] & 0x0F;
+    const uint8_t acce_odr = data[1] & 0x0F;
+    if (config->acce && config->gyro) {
+        sens->fifo_period_us = icm42670_odr_period_us(gyro_odr < acce_odr ? gyro_odr : acce_odr);
+    } else {
+        sens->fifo_period_us = icm42670_odr_period_us(config->acce ? acce_odr : gyro_odr);
+    }
+
+    /* Watermark is counted in bytes */
+    uint32_t watermark = (uint32_t)config->watermark * sens->fifo_packet_size;
+    if (watermark > ICM42670_FIFO_WM_MAX) {
+        watermark = ICM42670_FIFO_WM_MAX;
+    }
+    data[0] = watermark & 0xFF;
+    data[1] = (watermark >> 8) & 0x0F;
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_FIFO_CONFIG2, data, 2), TAG, "FIFO watermark error!");
+
+    data[0] = ICM42670_SIGNAL_PATH_FIFO_FLUSH;
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_SIGNAL_PATH_RESET, data, 1), TAG, "FIFO flush error!");
+    /* Stream mode */
+    data[0] = 0;
+    return icm42670_write(sensor, ICM42670_FIFO_CONFIG1, data, 1);
+}
+
+esp_err_t icm42670_fifo_get_count(icm42670_handle_t sensor, uint16_t *count)
+{
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
+    uint8_t data[2];
+
+    assert(sens);
+    assert(count != NULL);
+
+    *count = 0;
+    ESP_RETURN_ON_FALSE(sens->fifo_buf, ESP_ERR_INVALID_STATE, TAG, "FIFO not configured");
+
+    /* Count is in bytes, big endian */
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_FIFO_COUNTH, data, sizeof(data)), TAG, "Read FIFO count error!");
+    *count = ((data[0] << 8) | data[1]) / sens->fifo_packet_size;
+
+    return ESP_OK;
+}
+
+esp_err_t icm42670_fifo_read(icm42670_handle_t sensor, icm42670_fifo_sample_t *samples, size_t max_samples, size_t *read_samples)
+{
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
+    uint16_t count;
+
+    assert(sens);
+    assert(samples != NULL || max_samples == 0);
+    assert(read_samples != NULL);
+
+    *read_samples = 0;
+    ESP_RETURN_ON_ERROR(icm42670_fifo_get_count(sensor, &count), TAG, "Get FIFO count error!");
+    if (count > max_samples) {
+        count = max_samples;
+    }
+
+    while (count > 0) {
+        const size_t packets = (count < ICM42670_FIFO_READ_PACKETS) ? count : ICM42670_FIFO_READ_PACKETS;
+        ESP_RETURN_ON_ERROR(icm42670_read_fifo_data(sensor, sens->fifo_buf, packets * sens->fifo_packet_size), TAG, "Read FIFO error!");
+        const int64_t read_time = esp_timer_get_time();
+
+        /* The last packet of the burst is the newest sample, older ones are dated back by timestamp or ODR */
+        const bool has_tmst = (sens->fifo_packet_size == ICM42670_FIFO_PACKET_SIZE_2);
+        const uint8_t *last = &sens->fifo_buf[(packets - 1) * sens->fifo_packet_size];
+        const uint16_t last_tmst = has_tmst ? ((last[14] << 8) | last[15]) : 0;
+        size_t stored = 0;
+        for (size_t i = 0; i < packets; i++) {
+            const uint8_t *packet = &sens->fifo_buf[i * sens->fifo_packet_size];
+            const uint8_t header = packet[0];
+            if (header & ICM42670_FIFO_HEADER_EMPTY) {
+                continue;
+            }
+
+            icm42670_fifo_sample_t *sample = &samples[*read_samples + stored];
+            memset(sample, 0, sizeof(*sample));
+            const uint8_t *data = &packet[1];
+            if (header & ICM42670_FIFO_HEADER_ACCEL) {
+                sample->has_acce = true;
+                sample->acce.x = (int16_t)((data[0] << 8) | data[1]);
+                sample->acce.y = (int16_t)((data[2] << 8) | data[3]);
+                sample->acce.z = (int16_t)((data[4] << 8) | data[5]);
+                data += 6;
+            }
+            if (header & ICM42670_FIFO_HEADER_GYRO) {
+                sample->has_gyro = true;
+                sample->gyro.x = (int16_t)((data[0] << 8) | data[1]);
+                sample->gyro.y = (int16_t)((data[2] << 8) | data[3]);
+                sample->gyro.z = (int16_t)((data[4] << 8) | data[5]);
+                data += 6;
+            }
+            sample->temp_raw = (int8_t)data[0];
+
+            if (has_tmst && (header & ICM42670_FIFO_HEADER_TMST)) {
+                /* 16-bit timestamp [us], the difference is correct over one wrap */
+                const uint16_t tmst = (packet[14] << 8) | packet[15];
+                sample->timestamp_us = read_time - (uint16_t)(last_tmst - tmst);
+            } else {
+                sample->timestamp_us = read_time - (int64_t)(packets - 1 - i) * sens->fifo_period_us;
+            }
+            stored++;
+        }
+
+        *read_samples += stored;
+        count -= packets;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t icm42670_wom_config(icm42670_handle_t sensor, const icm42670_wom_cfg_t *config)
+{
+    uint8_t data;
+
+    assert(config != NULL);
+
+    /* WoM is stopped while the thresholds are changed */
+    data = 0;
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_WOM_CONFIG, &data, 1), TAG, "WoM disable error!");
+    if (!config->enable) {
+        return icm42670_route_int(sensor, ICM42670_INT_NONE, ICM42670_INT_SOURCE1_WOM, 0);
+    }
+
+    ESP_RETURN_ON_ERROR(icm42670_write_mreg1(sensor, ICM42670_MREG1_WOM_X_THR, config->threshold_x), TAG, "WoM threshold error!");
+    ESP_RETURN_ON_ERROR(icm42670_write_mreg1(sensor, ICM42670_MREG1_WOM_Y_THR, config->threshold_y), TAG, "WoM threshold error!");
+    ESP_RETURN_ON_ERROR(icm42670_write_mreg1(sensor, ICM42670_MREG1_WOM_Z_THR, config->threshold_z), TAG, "WoM threshold error!");
+    esp_rom_delay_us(1000);
+
+    /* Axes with zero threshold would trigger on any sample, their interrupts are not enabled */
+    uint8_t wom_int = 0;
+    wom_int |= config->threshold_x ? (1 << 0) : 0;
+    wom_int |= config->threshold_y ? (1 << 1) : 0;
+    wom_int |= config->threshold_z ? (1 << 2) : 0;
+    ESP_RETURN_ON_ERROR(icm42670_route_int(sensor, config->int_pin, ICM42670_INT_SOURCE1_WOM, wom_int), TAG, "WoM interrupt error!");
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    data = ICM42670_WOM_CONFIG_EN | ((config->duration & 0x03) << 3);
+    data |= config->compare_previous ? ICM42670_WOM_CONFIG_PREVIOUS : 0;
+    data |= config->all_axes ? ICM42670_WOM_CONFIG_AND : 0;
+    return icm42670_write(sensor, ICM42670_WOM_CONFIG, &data, 1);
+}
+
+esp_err_t icm42670_apex_config(icm42670_handle_t sensor, const icm42670_apex_cfg_t *config)
+{
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
+    static const uint16_t odr_hz[] = {25, 400, 50, 100};
+    uint8_t data;
+
+    assert(sens);
+    assert(config != NULL);
+
+    /* Features are stopped while DMP is initialized */
+    data = config->odr & 0x03;
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_APEX_CONFIG1, &data, 1), TAG, "APEX disable error!");
+    sens->apex_odr_hz = 0;
+    if (!config->pedometer && !config->tilt && !config->smd) {
+        ESP_RETURN_ON_ERROR(icm42670_write_mreg1(sensor, ICM42670_MREG1_INT_SOURCE6, 0), TAG, "APEX interrupt error!");
+        ESP_RETURN_ON_ERROR(icm42670_write_mreg1(sensor, ICM42670_MREG1_INT_SOURCE7, 0), TAG, "APEX interrupt error!");
+        return icm42670_route_int(sensor, ICM42670_INT_NONE, ICM42670_INT_SOURCE1_SMD, 0);
+    }
+
+    data = ICM42670_APEX_CONFIG0_MEM_RESET;
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_APEX_CONFIG0, &data, 1), TAG, "DMP memory reset error!");
+    esp_rom_delay_us(1000);
+
+    /* Default parameters of the algorithms (APEX_CONFIG2..9 after reset), DMP loads them at init */
+    data = ICM42670_APEX_CONFIG0_DMP_INIT | (config->power_save ? ICM42670_APEX_CONFIG0_POWER_SAVE : 0);
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_APEX_CONFIG0, &data, 1), TAG, "DMP init error!");
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    /* Significant motion is detected from steps, it needs pedometer */
+    data = config->odr & 0x03;
+    data |= (config->pedometer || config->smd) ? ICM42670_APEX_CONFIG1_PED : 0;
+    data |= config->tilt ? ICM42670_APEX_CONFIG1_TILT : 0;
+    data |= config->smd ? ICM42670_APEX_CONFIG1_SMD : 0;
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_APEX_CONFIG1, &data, 1), TAG, "APEX enable error!");
+    sens->apex_odr_hz = odr_hz[config->odr & 0x03];
+
+    uint8_t source6 = 0;
+    source6 |= config->pedometer ? (ICM42670_INT_SOURCE6_STEP_DET | ICM42670_INT_SOURCE6_STEP_CNT_OVF) : 0;
+    source6 |= config->tilt ? ICM42670_INT_SOURCE6_TILT : 0;
+    ESP_RETURN_ON_ERROR(icm42670_write_mreg1(sensor, ICM42670_MREG1_INT_SOURCE6, config->int_pin == ICM42670_INT1 ? source6 : 0), TAG, "APEX interrupt error!");
+    ESP_RETURN_ON_ERROR(icm42670_write_mreg1(sensor, ICM42670_MREG1_INT_SOURCE7, config->int_pin == ICM42670_INT2 ? source6 : 0), TAG, "APEX interrupt error!");
+    return icm42670_route_int(sensor, config->int_pin, ICM42670_INT_SOURCE1_SMD, config->smd ? ICM42670_INT_SOURCE1_SMD : 0);
+}
+
+esp_err_t icm42670_get_events(icm42670_handle_t sensor, uint16_t *events)
+{
+    uint8_t data[2];
+
+    assert(events != NULL);
+
+    *events = 0;
+    /* INT_STATUS2 (WoM, SMD) and INT_STATUS3 (pedometer, tilt), both are cleared by the read */
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_INT_STATUS2, data, sizeof(data)), TAG, "Read interrupt status error!");
+    *events = (data[0] & 0x0F) | ((data[1] & 0x38) << 8);
+
+    return ESP_OK;
+}
+
+esp_err_t icm42670_apex_get_pedometer(icm42670_handle_t sensor, icm42670_pedometer_t *pedometer)
+{
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
+    uint8_t data[4];
+
+    assert(sens);
+    assert(pedometer != NULL);
+
+    memset(pedometer, 0, sizeof(icm42670_pedometer_t));
+    ESP_RETURN_ON_FALSE(sens->apex_odr_hz, ESP_ERR_INVALID_STATE, TAG, "APEX not configured");
+
+    /* APEX_DATA0..3: step count (little endian), cadence (samples between steps, u6.2), activity class */
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_APEX_DATA0, data, sizeof(data)), TAG, "Read APEX data error!");
+    pedometer->step_count = data[0] | (data[1] << 8);
+    if (data[2] > 0) {
+        pedometer->steps_per_second = sens->apex_odr_hz * 4.0f / data[2];
+    }
+    pedometer->activity = (icm42670_activity_t)(data[3] & 0x03);
+
+    return ESP_OK;
+}
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
 
+/* Route interrupt sources of INT_SOURCE1 (WoM, SMD) to one pin, the pin is latched active high */
+static esp_err_t icm42670_route_int(icm42670_handle_t sensor, icm42670_int_pin_t pin, uint8_t source1_mask, uint8_t source1_bits)
+{
+    uint8_t source[3];
+    uint8_t int_config;
+
+    /* INT_SOURCE1 (INT1), INT_SOURCE3, INT_SOURCE4 (INT2) */
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_INT_SOURCE1, source, sizeof(source)), TAG, "Read interrupt sources error!");
+    source[0] = (source[0] & ~source1_mask) | (pin == ICM42670_INT1 ? source1_bits : 0);
+    source[2] = (source[2] & ~source1_mask) | (pin == ICM42670_INT2 ? source1_bits : 0);
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_INT_SOURCE1, &source[0], 1), TAG, "Write interrupt sources error!");
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_INT_SOURCE4, &source[2], 1), TAG, "Write interrupt sources error!");
+    if (pin == ICM42670_INT_NONE) {
+        return ESP_OK;
+    }
+
+    /* Latched pin stays high until the status is read, it can wake up the host by level */
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_INT_CONFIG, &int_config, 1), TAG, "Read INT config error!");
+    if (pin == ICM42670_INT1) {
+        int_config = (int_config & ~0x07) | ICM42670_INT_CONFIG_LATCHED_HIGH;
+    } else {
+        int_config = (int_config & ~(0x07 << 3)) | (ICM42670_INT_CONFIG_LATCHED_HIGH << 3);
+    }
+    return icm42670_write(sensor, ICM42670_INT_CONFIG, &int_config, 1);
+}
+
+static void icm42670_set_scale(icm42670_handle_t sensor, uint8_t gyro_config0, uint8_t accel_config0)
+{
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
+
+    switch ((accel_config0 >> 5) & 0x03) {
+    case ACCE_FS_16G:
+        sens->acce_sensitivity = ACCE_FS_16G_SENSITIVITY;
+        break;
+    case ACCE_FS_8G:
+        sens->acce_sensitivity = ACCE_FS_8G_SENSITIVITY;
+        break;
+    case ACCE_FS_4G:
+        sens->acce_sensitivity = ACCE_FS_4G_SENSITIVITY;
+        break;
+    default:
+        sens->acce_sensitivity = ACCE_FS_2G_SENSITIVITY;
+        break;
+    }
+
+    switch ((gyro_config0 >> 5) & 0x03) {
+    case GYRO_FS_2000DPS:
+        sens->gyro_sensitivity = GYRO_FS_2000_SENSITIVITY;
+        break;
+    case GYRO_FS_1000DPS:
+        sens->gyro_sensitivity = GYRO_FS_1000_SENSITIVITY;
+        break;
+    case GYRO_FS_500DPS:
+        sens->gyro_sensitivity = GYRO_FS_500_SENSITIVITY;
+        break;
+    default:
+        sens->gyro_sensitivity = GYRO_FS_250_SENSITIVITY;
+        break;
+    }
+
+    /* Samples are scaled by multiplication, no float division per sample */
+    sens->acce_scale = 1.0f / sens->acce_sensitivity;
+    sens->gyro_scale = 1.0f / sens->gyro_sensitivity;
+    sens->scale_valid = true;
+}
+
+static esp_err_t icm42670_load_scale(icm42670_handle_t sensor)
+{
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
+    uint8_t data[2];
+
+    assert(sens);
+
+    /* Full scale ranges are read once (sensor configured before create), then they follow icm42670_config() */
+    if (sens->scale_valid) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_GYRO_CONFIG0, data, sizeof(data)), TAG, "Read config error!");
+    icm42670_set_scale(sensor, data[0], data[1]);
+
+    return ESP_OK;
+}
+
+static uint32_t icm42670_odr_period_us(uint8_t odr)
+{
+    /* ODR 5 is 1.6 kHz, every next value halves the rate */
+    if (odr < ACCE_ODR_1600HZ || odr > ACCE_ODR_1_5625HZ) {
+        odr = ACCE_ODR_1600HZ;
+    }
+    return 625u << (odr - ACCE_ODR_1600HZ);
+}
+
+static esp_err_t icm42670_write_mreg1(icm42670_handle_t sensor, uint8_t reg, uint8_t value)
+{
+    uint8_t pwr_mgmt0;
+    uint8_t data;
+
+    /* MREG registers are accessed with running internal oscillator */
+    ESP_RETURN_ON_ERROR(icm42670_read(sensor, ICM42670_PWR_MGMT0, &pwr_mgmt0, 1), TAG, "Read power error!");
+    data = pwr_mgmt0 | ICM42670_PWR_MGMT0_IDLE;
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_PWR_MGMT0, &data, 1), TAG, "Write power error!");
+    esp_rom_delay_us(100);
+
+    data = 0x00; /* MREG1 */
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_BLK_SEL_W, &data, 1), TAG, "Select MREG error!");
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_MADDR_W, &reg, 1), TAG, "Write MREG address error!");
+    ESP_RETURN_ON_ERROR(icm42670_write(sensor, ICM42670_M_W, &value, 1), TAG, "Write MREG error!");
+    esp_rom_delay_us(10);
+
+    return icm42670_write(sensor, ICM42670_PWR_MGMT0, &pwr_mgmt0, 1);
+}
+
+static esp_err_t icm42670_read_fifo_data(icm42670_handle_t sensor, uint8_t *data_buf, size_t data_len)
+{
+    uint8_t reg_buff[] = {ICM42670_FIFO_DATA};
+    icm42670_dev_t *sens = (icm42670_dev_t *) sensor;
+    assert(sens);
+
+    /* FIFO_DATA register is not incremented, all packets are read in one transaction */
+    return i2c_master_transmit_receive(sens->i2c_handle, reg_buff, sizeof(reg_buff), data_buf, data_len, -1);
+}
+
 static esp_err_t icm42670_get_raw_value(icm42670_handle_t sensor, uint8_t reg, icm42670_raw_value_t *value)
 {
     esp_err_t ret = ESP_FAIL;
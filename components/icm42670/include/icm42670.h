@@ -10,6 +10,9 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include "driver/i2c_master.h"
 
 #define ICM42670_I2C_ADDRESS         0x68 /*!< I2C address with AD0 pin low */
@@ -91,6 +94,108 @@ typedef struct {
     float pitch;
 } complimentary_angle_t;
 
+/**
+ * @brief FIFO configuration
+ *
+ * Packets with accelerometer and gyroscope have 16 bytes (with timestamp), packets with one sensor have 8 bytes.
+ */
+typedef struct {
+    bool     acce;              /*!< Store accelerometer samples */
+    bool     gyro;              /*!< Store gyroscope samples */
+    uint16_t watermark;         /*!< FIFO_THS interrupt, when FIFO has more packets than watermark */
+    bool     int1_watermark;    /*!< Route FIFO_THS interrupt to INT1 pin (push-pull, active high pulse) */
+} icm42670_fifo_cfg_t;
+
+/**
+ * @brief One sample read from FIFO
+ */
+typedef struct {
+    icm42670_raw_value_t acce;  /*!< Raw accelerometer measurements (if has_acce) */
+    icm42670_raw_value_t gyro;  /*!< Raw gyroscope measurements (if has_gyro) */
+    int64_t timestamp_us;       /*!< Estimated time of the sample (esp_timer_get_time) */
+    int8_t   temp_raw;          /*!< Raw temperature (temp = raw / 2 + 25) */
+    bool     has_acce;          /*!< Packet contains accelerometer sample */
+    bool     has_gyro;          /*!< Packet contains gyroscope sample */
+} icm42670_fifo_sample_t;
+
+/**
+ * @brief Interrupt pin of the sensor
+ */
+typedef enum {
+    ICM42670_INT_NONE = 0,  /*!< Interrupt is not routed, the events are only polled (icm42670_get_events) */
+    ICM42670_INT1,          /*!< INT1 pin */
+    ICM42670_INT2,          /*!< INT2 pin */
+} icm42670_int_pin_t;
+
+/**
+ * @brief Wake on motion configuration
+ *
+ * @note Accelerometer must be powered on (ACCE_PWR_LOWPOWER is enough), WoM compares its samples.
+ */
+typedef struct {
+    bool     enable;            /*!< Enable wake on motion */
+    uint8_t  threshold_x;       /*!< Threshold of X axis [1/256 g] (0: axis not used) */
+    uint8_t  threshold_y;       /*!< Threshold of Y axis [1/256 g] (0: axis not used) */
+    uint8_t  threshold_z;       /*!< Threshold of Z axis [1/256 g] (0: axis not used) */
+    bool     compare_previous;  /*!< Compare with the previous sample, otherwise with the first sample after enable */
+    bool     all_axes;          /*!< Event, when all the used axes exceed the threshold (otherwise any axis) */
+    uint8_t  duration;          /*!< Event after 1 to 4 exceeding samples (0 - 3) */
+    icm42670_int_pin_t int_pin; /*!< Interrupt pin of the event */
+} icm42670_wom_cfg_t;
+
+/**
+ * @brief Rate of APEX algorithms
+ */
+typedef enum {
+    ICM42670_APEX_ODR_25HZ  = 0,    /*!< 25 Hz */
+    ICM42670_APEX_ODR_400HZ = 1,    /*!< 400 Hz */
+    ICM42670_APEX_ODR_50HZ  = 2,    /*!< 50 Hz, recommended for pedometer and tilt */
+    ICM42670_APEX_ODR_100HZ = 3,    /*!< 100 Hz */
+} icm42670_apex_odr_t;
+
+/**
+ * @brief APEX (on-chip motion processor) configuration
+ *
+ * @note Accelerometer must be powered on with ODR not lower than the APEX rate, low power mode is recommended.
+ */
+typedef struct {
+    icm42670_apex_odr_t odr;    /*!< Rate of the algorithms */
+    bool     pedometer;         /*!< Step counter and step detection events */
+    bool     tilt;              /*!< Tilt detection events (tilt held for ~4 s) */
+    bool     smd;               /*!< Significant motion detection events, it runs the pedometer as well */
+    bool     power_save;        /*!< Motion processor sleeps until WoM detects motion (WoM must be configured) */
+    icm42670_int_pin_t int_pin; /*!< Interrupt pin of the events */
+} icm42670_apex_cfg_t;
+
+/**
+ * @brief Events returned by icm42670_get_events
+ */
+#define ICM42670_EVENT_WOM_X        (1 << 0)    /*!< Wake on motion of X axis */
+#define ICM42670_EVENT_WOM_Y        (1 << 1)    /*!< Wake on motion of Y axis */
+#define ICM42670_EVENT_WOM_Z        (1 << 2)    /*!< Wake on motion of Z axis */
+#define ICM42670_EVENT_SMD          (1 << 3)    /*!< Significant motion */
+#define ICM42670_EVENT_TILT         (1 << 11)   /*!< Tilt detected */
+#define ICM42670_EVENT_STEP_CNT_OVF (1 << 12)   /*!< Step counter overflowed */
+#define ICM42670_EVENT_STEP         (1 << 13)   /*!< Step detected */
+
+/**
+ * @brief Activity recognized by pedometer
+ */
+typedef enum {
+    ICM42670_ACTIVITY_UNKNOWN = 0,  /*!< Unknown activity */
+    ICM42670_ACTIVITY_WALK = 1,     /*!< Walking */
+    ICM42670_ACTIVITY_RUN = 2,      /*!< Running */
+} icm42670_activity_t;
+
+/**
+ * @brief Pedometer results
+ */
+typedef struct {
+    uint16_t step_count;            /*!< Steps since APEX configuration (ICM42670_EVENT_STEP_CNT_OVF on wrap) */
+    float    steps_per_second;      /*!< Cadence of the last steps */
+    icm42670_activity_t activity;   /*!< Recognized activity */
+} icm42670_pedometer_t;
+
 typedef void *icm42670_handle_t;
 
 /**
@@ -166,6 +271,9 @@ esp_err_t icm42670_config(icm42670_handle_t sensor, const icm42670_cfg_t *config
 /**
  * @brief Get accelerometer sensitivity
  *
+ * @note Full scale ranges are read from the sensor once and then cached in the handle, icm42670_config() updates them.
+ *       Registers written directly (outside of this driver) are not noticed.
+ *
  * @param sensor object handle of icm42670
  * @param sensitivity accelerometer sensitivity
  *
@@ -247,6 +355,21 @@ esp_err_t icm42670_get_acce_value(icm42670_handle_t sensor, icm42670_value_t *va
  */
 esp_err_t icm42670_get_gyro_value(icm42670_handle_t sensor, icm42670_value_t *value);
 
+/**
+ * @brief Read accelerometer and gyroscope values in one I2C transaction
+ *
+ * The values are scaled by the cached full scale ranges, no register is read for the sensitivity.
+ *
+ * @param sensor object handle of icm42670
+ * @param acce_value accelerometer measurements [g]
+ * @param gyro_value gyroscope measurements [dps]
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_FAIL Fail
+ */
+esp_err_t icm42670_get_acce_gyro_value(icm42670_handle_t sensor, icm42670_value_t *acce_value, icm42670_value_t *gyro_value);
+
 /**
  * @brief Read temperature value
  *
@@ -259,6 +382,109 @@ esp_err_t icm42670_get_gyro_value(icm42670_handle_t sensor, icm42670_value_t *va
  */
 esp_err_t icm42670_get_temp_value(icm42670_handle_t sensor, float *value);
 
+/**
+ * @brief Configure FIFO
+ *
+ * FIFO is flushed and started in stream mode. When neither accelerometer nor gyroscope is selected, FIFO is bypassed.
+ *
+ * @note Sensors must be powered on (and the ODR set by icm42670_config) before, the sample times are estimated from the ODR.
+ *
+ * @param sensor object handle of icm42670
+ * @param config FIFO configuration
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_NO_MEM Not enough memory for the read buffer
+ *     - ESP_FAIL Fail
+ */
+esp_err_t icm42670_fifo_config(icm42670_handle_t sensor, const icm42670_fifo_cfg_t *config);
+
+/**
+ * @brief Get count of packets waiting in FIFO
+ *
+ * @param sensor object handle of icm42670
+ * @param count count of packets
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_FAIL Fail
+ */
+esp_err_t icm42670_fifo_get_count(icm42670_handle_t sensor, uint16_t *count);
+
+/**
+ * @brief Read samples waiting in FIFO
+ *
+ * Packets are read in bursts (up to 64 packets in one I2C transaction), the oldest sample is the first one.
+ *
+ * @param sensor object handle of icm42670
+ * @param samples buffer for samples
+ * @param max_samples size of the buffer
+ * @param read_samples count of read samples
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE FIFO not configured
+ *     - ESP_FAIL Fail
+ */
+esp_err_t icm42670_fifo_read(icm42670_handle_t sensor, icm42670_fifo_sample_t *samples, size_t max_samples, size_t *read_samples);
+
+/**
+ * @brief Configure wake on motion
+ *
+ * The interrupt pin is latched (push-pull, active high) until icm42670_get_events() reads the status,
+ * the host can sleep and wake up by level of the pin.
+ *
+ * @param sensor object handle of icm42670
+ * @param config WoM configuration, WoM is disabled, when config->enable is false
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_FAIL Fail
+ */
+esp_err_t icm42670_wom_config(icm42670_handle_t sensor, const icm42670_wom_cfg_t *config);
+
+/**
+ * @brief Configure APEX motion processor (pedometer, tilt, significant motion)
+ *
+ * The motion processor is reset and initialized with default parameters of the algorithms, the step count starts from 0.
+ * The events are routed to the interrupt pin (latched, push-pull, active high).
+ *
+ * @param sensor object handle of icm42670
+ * @param config APEX configuration, APEX is disabled, when no algorithm is selected
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_FAIL Fail
+ */
+esp_err_t icm42670_apex_config(icm42670_handle_t sensor, const icm42670_apex_cfg_t *config);
+
+/**
+ * @brief Read and clear WoM and APEX events
+ *
+ * @note Reading the events releases the latched interrupt pin.
+ *
+ * @param sensor object handle of icm42670
+ * @param events ICM42670_EVENT_* bits
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_FAIL Fail
+ */
+esp_err_t icm42670_get_events(icm42670_handle_t sensor, uint16_t *events);
+
+/**
+ * @brief Read pedometer results
+ *
+ * @param sensor object handle of icm42670
+ * @param pedometer step count, cadence and activity
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE APEX not configured
+ *     - ESP_FAIL Fail
+ */
+esp_err_t icm42670_apex_get_pedometer(icm42670_handle_t sensor, icm42670_pedometer_t *pedometer);
+
 /**
  * @brief use complimentory filter to caculate roll and pitch
  *
@@ -85,6 +85,113 @@ TEST_CASE("Sensor icm42670 test", "[icm42670]")
                  acc.x, acc.y, acc.z, gyro.x, gyro.y, gyro.z, temperature);
     }
 
+    /* Sensitivity is cached from icm42670_config() */
+    float sensitivity;
+    ret = icm42670_get_acce_sensitivity(icm42670, &sensitivity);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_EQUAL_FLOAT(16384, sensitivity);
+    ret = icm42670_get_acce_gyro_value(icm42670, &acc, &gyro);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ESP_LOGI(TAG, "acc_z:%.2f, gyro_z:%.2f (one transaction)", acc.z, gyro.z);
+
+    icm42670_delete(icm42670);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(10); // Give FreeRTOS some time to free its resources
+}
+
+TEST_CASE("Sensor icm42670 FIFO test", "[icm42670][fifo]")
+{
+    esp_err_t ret;
+    icm42670_fifo_sample_t samples[32];
+    size_t read = 0;
+
+    i2c_sensor_icm42670_init();
+
+    ret = icm42670_acce_set_pwr(icm42670, ACCE_PWR_LOWNOISE);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = icm42670_gyro_set_pwr(icm42670, GYRO_PWR_LOWNOISE);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    const icm42670_fifo_cfg_t fifo_cfg = {
+        .acce = true,
+        .gyro = true,
+        .watermark = 16,
+    };
+    ret = icm42670_fifo_config(icm42670, &fifo_cfg);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    /* 400 Hz ODR, 50 ms gives about 20 samples */
+    for (int i = 0; i < 10; i++) {
+        vTaskDelay(pdMS_TO_TICKS(50));
+        ret = icm42670_fifo_read(icm42670, samples, 32, &read);
+        TEST_ASSERT_EQUAL(ESP_OK, ret);
+        TEST_ASSERT_GREATER_THAN(0, read);
+        for (size_t j = 1; j < read; j++) {
+            TEST_ASSERT_TRUE(samples[j].has_acce && samples[j].has_gyro);
+            TEST_ASSERT_GREATER_OR_EQUAL(samples[j - 1].timestamp_us, samples[j].timestamp_us);
+        }
+        ESP_LOGI(TAG, "FIFO samples: %d, acc_x:%d, gyro_x:%d", (int)read, samples[0].acce.x, samples[0].gyro.x);
+    }
+
+    icm42670_delete(icm42670);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(10); // Give FreeRTOS some time to free its resources
+}
+
+TEST_CASE("Sensor icm42670 APEX test", "[icm42670][apex]")
+{
+    esp_err_t ret;
+    uint16_t events;
+    icm42670_pedometer_t pedometer;
+
+    i2c_sensor_icm42670_init();
+
+    /* Motion processing runs on the sensor, accelerometer in low power mode is enough */
+    ret = icm42670_acce_set_pwr(icm42670, ACCE_PWR_LOWPOWER);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    ret = icm42670_apex_get_pedometer(icm42670, &pedometer);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, ret);
+
+    const icm42670_wom_cfg_t wom_cfg = {
+        .enable = true,
+        .threshold_x = 98,  /* ~0.38 g */
+        .threshold_y = 98,
+        .threshold_z = 98,
+        .compare_previous = true,
+        .int_pin = ICM42670_INT1,
+    };
+    ret = icm42670_wom_config(icm42670, &wom_cfg);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    const icm42670_apex_cfg_t apex_cfg = {
+        .odr = ICM42670_APEX_ODR_50HZ,
+        .pedometer = true,
+        .tilt = true,
+        .int_pin = ICM42670_INT1,
+    };
+    ret = icm42670_apex_config(icm42670, &apex_cfg);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    for (int i = 0; i < 10; i++) {
+        vTaskDelay(pdMS_TO_TICKS(100));
+        ret = icm42670_get_events(icm42670, &events);
+        TEST_ASSERT_EQUAL(ESP_OK, ret);
+        ret = icm42670_apex_get_pedometer(icm42670, &pedometer);
+        TEST_ASSERT_EQUAL(ESP_OK, ret);
+        ESP_LOGI(TAG, "events:0x%04x, steps:%u, cadence:%.2f, activity:%d", events, pedometer.step_count, pedometer.steps_per_second, pedometer.activity);
+    }
+
+    /* Disable APEX and WoM */
+    const icm42670_apex_cfg_t apex_off = {0};
+    ret = icm42670_apex_config(icm42670, &apex_off);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    const icm42670_wom_cfg_t wom_off = {0};
+    ret = icm42670_wom_config(icm42670, &wom_off);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
     icm42670_delete(icm42670);
     ret = i2c_del_master_bus(i2c_handle);
     TEST_ASSERT_EQUAL(ESP_OK, ret);
@@ -0,0 +1,423 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include "esp_check.h"
+#include "imu_fusion.h"
+
+static const char *TAG = "IMU_FUSION";
+
+#define RAD_TO_DEG          57.29577951f
+#define DEG_TO_RAD          0.01745329252f
+
+#define DT_MAX_US           (1000000)   /* Longer gaps between timestamps use the sample period */
+
+/* Fixed point angles [1/65536 deg] */
+#define Q16_DEG(deg)        ((int32_t)(deg) << 16)
+#define GYRO_K_SHIFT        (24)        /* Fraction bits of gyroscope scale */
+
+/* atan(z) ~ 45 z + z (1 - z) (14.0204 + 3.7987 z) deg on 0..1 (error < 0.1 deg) */
+#define ATAN_K1_Q16         (918836)
+#define ATAN_K2_Q16         (248951)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct imu_fusion_s {
+    imu_fusion_config_t config;
+    bool started;               /* Orientation was set from the first sample */
+    int64_t last_timestamp;     /* Timestamp of the last sample [us] */
+    /* Complementary */
+    float roll;                 /* [deg] */
+    float pitch;
+    /* Complementary Q15 */
+    int32_t roll_q16;           /* [1/65536 deg] */
+    int32_t pitch_q16;
+    int32_t acce_weight_q15;    /* 1 - alpha */
+    uint32_t gyro_k;            /* [1/65536 deg] per (LSB * us), GYRO_K_SHIFT fraction bits */
+    /* Mahony and Madgwick */
+    float q[4];                 /* Quaternion w, x, y, z */
+    float integral[3];          /* Mahony integral feedback */
+    float gyro_rad;             /* Gyroscope [rad/s] per LSB */
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t fusion_dt_us(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample);
+static void fusion_start(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample);
+static void fusion_complementary(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample, uint32_t dt_us);
+static void fusion_complementary_q15(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample, uint32_t dt_us);
+static void fusion_mahony(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample, uint32_t dt_us);
+static void fusion_madgwick(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample, uint32_t dt_us);
+static int32_t atan2_q16(int32_t y, int32_t x);
+static uint32_t isqrt(uint32_t value);
+static int32_t wrap_q16(int32_t angle);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t imu_fusion_new(const imu_fusion_config_t *config, imu_fusion_handle_t *ret_fusion)
+{
+    ESP_RETURN_ON_FALSE(config && ret_fusion, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->algo <= IMU_FUSION_MADGWICK, ESP_ERR_INVALID_ARG, TAG, "unknown algorithm");
+    ESP_RETURN_ON_FALSE(config->gyro_sensitivity > 0 && config->sample_period_us > 0, ESP_ERR_INVALID_ARG, TAG,
+                        "invalid sensitivity or period");
+    ESP_RETURN_ON_FALSE(config->alpha >= 0 && config->alpha <= 1, ESP_ERR_INVALID_ARG, TAG, "invalid alpha");
+
+    imu_fusion_handle_t fusion = calloc(1, sizeof(struct imu_fusion_s));
+    ESP_RETURN_ON_FALSE(fusion, ESP_ERR_NO_MEM, TAG, "no mem for fusion");
+    fusion->config = *config;
+    /* Constants of the fixed point filter are prepared here, the update has no float */
+    fusion->acce_weight_q15 = lroundf((1.0f - config->alpha) * 32768.0f);
+    fusion->gyro_k = lroundf(65536.0f * (float)(1 << GYRO_K_SHIFT) / (config->gyro_sensitivity * 1000000.0f));
+    fusion->gyro_rad = DEG_TO_RAD / config->gyro_sensitivity;
+
+    *ret_fusion = fusion;
+    return ESP_OK;
+}
+
+esp_err_t imu_fusion_del(imu_fusion_handle_t fusion)
+{
+    ESP_RETURN_ON_FALSE(fusion, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(fusion);
+    return ESP_OK;
+}
+
+void imu_fusion_reset(imu_fusion_handle_t fusion)
+{
+    assert(fusion);
+    fusion->started = false;
+}
+
+void imu_fusion_update(imu_fusion_handle_t fusion, const imu_fusion_sample_t *samples, size_t count)
+{
+    assert(fusion);
+    assert(count == 0 || samples);
+
+    for (size_t i = 0; i < count; i++) {
+        const imu_fusion_sample_t *sample = &samples[i];
+        if (!fusion->started) {
+            fusion_start(fusion, sample);
+            continue;
+        }
+
+        const uint32_t dt_us = fusion_dt_us(fusion, sample);
+        switch (fusion->config.algo) {
+        case IMU_FUSION_COMPLEMENTARY:
+            fusion_complementary(fusion, sample, dt_us);
+            break;
+        case IMU_FUSION_COMPLEMENTARY_Q15:
+            fusion_complementary_q15(fusion, sample, dt_us);
+            break;
+        case IMU_FUSION_MAHONY:
+            fusion_mahony(fusion, sample, dt_us);
+            break;
+        case IMU_FUSION_MADGWICK:
+            fusion_madgwick(fusion, sample, dt_us);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void imu_fusion_get_angle(imu_fusion_handle_t fusion, imu_fusion_angle_t *angle)
+{
+    assert(fusion);
+    assert(angle);
+
+    memset(angle, 0, sizeof(*angle));
+    switch (fusion->config.algo) {
+    case IMU_FUSION_COMPLEMENTARY:
+        angle->roll = fusion->roll;
+        angle->pitch = fusion->pitch;
+        break;
+    case IMU_FUSION_COMPLEMENTARY_Q15:
+        angle->roll = fusion->roll_q16 / 65536.0f;
+        angle->pitch = fusion->pitch_q16 / 65536.0f;
+        break;
+    default: {
+        const float *q = fusion->q;
+        float sinp = 2.0f * (q[0] * q[2] - q[3] * q[1]);
+        sinp = (sinp > 1.0f) ? 1.0f : ((sinp < -1.0f) ? -1.0f : sinp);
+        angle->roll = atan2f(2.0f * (q[0] * q[1] + q[2] * q[3]), 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2])) * RAD_TO_DEG;
+        angle->pitch = asinf(sinp) * RAD_TO_DEG;
+        angle->yaw = atan2f(2.0f * (q[0] * q[3] + q[1] * q[2]), 1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3])) * RAD_TO_DEG;
+        break;
+    }
+    }
+}
+
+esp_err_t imu_fusion_get_angle_q16(imu_fusion_handle_t fusion, int32_t *roll, int32_t *pitch)
+{
+    ESP_RETURN_ON_FALSE(fusion && roll && pitch, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(fusion->config.algo == IMU_FUSION_COMPLEMENTARY_Q15, ESP_ERR_INVALID_STATE, TAG, "not fixed point filter");
+
+    *roll = fusion->roll_q16;
+    *pitch = fusion->pitch_q16;
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static uint32_t fusion_dt_us(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample)
+{
+    uint32_t dt_us = fusion->config.sample_period_us;
+
+    if (sample->timestamp_us != 0 && fusion->last_timestamp != 0) {
+        const int64_t dt = sample->timestamp_us - fusion->last_timestamp;
+        if (dt > 0 && dt <= DT_MAX_US) {
+            dt_us = dt;
+        }
+    }
+    fusion->last_timestamp = sample->timestamp_us;
+
+    return dt_us;
+}
+
+static void fusion_start(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample)
+{
+    const float ax = sample->acce_x;
+    const float ay = sample->acce_y;
+    const float az = sample->acce_z;
+
+    /* Pitch is positive for rotation around +Y (the direction of gyroscope) */
+    const float roll = atan2f(ay, az);
+    const float pitch = atan2f(-ax, sqrtf(ay * ay + az * az));
+
+    fusion->roll = roll * RAD_TO_DEG;
+    fusion->pitch = pitch * RAD_TO_DEG;
+    fusion->roll_q16 = atan2_q16(sample->acce_y, sample->acce_z);
+    fusion->pitch_q16 = atan2_q16(-sample->acce_x, isqrt((uint32_t)(ay * ay + az * az)));
+
+    /* Quaternion of roll and pitch (yaw 0) */
+    const float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+    const float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+    fusion->q[0] = cr * cp;
+    fusion->q[1] = sr * cp;
+    fusion->q[2] = cr * sp;
+    fusion->q[3] = -sr * sp;
+    memset(fusion->integral, 0, sizeof(fusion->integral));
+
+    fusion->last_timestamp = sample->timestamp_us;
+    fusion->started = true;
+}
+
+static void fusion_complementary(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample, uint32_t dt_us)
+{
+    const float ax = sample->acce_x;
+    const float ay = sample->acce_y;
+    const float az = sample->acce_z;
+    const float dt = dt_us / 1000000.0f;
+    const float alpha = fusion->config.alpha;
+
+    const float acce_roll = atan2f(ay, az) * RAD_TO_DEG;
+    const float acce_pitch = atan2f(-ax, sqrtf(ay * ay + az * az)) * RAD_TO_DEG;
+    const float gyro_roll = fusion->roll + sample->gyro_x / fusion->config.gyro_sensitivity * dt;
+    const float gyro_pitch = fusion->pitch + sample->gyro_y / fusion->config.gyro_sensitivity * dt;
+
+    fusion->roll = alpha * gyro_roll + (1.0f - alpha) * acce_roll;
+    fusion->pitch = alpha * gyro_pitch + (1.0f - alpha) * acce_pitch;
+}
+
+static void fusion_complementary_q15(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample, uint32_t dt_us)
+{
+    const int32_t ay = sample->acce_y;
+    const int32_t az = sample->acce_z;
+
+    const int32_t acce_roll = atan2_q16(ay, az);
+    const int32_t acce_pitch = atan2_q16(-sample->acce_x, isqrt((uint32_t)(ay * ay) + (uint32_t)(az * az)));
+
+    /* Gyroscope integration, rate [LSB] * dt [us] * gyro_k */
+    const int64_t gyro_dt = (int64_t)dt_us * fusion->gyro_k;
+    int32_t roll = fusion->roll_q16 + (int32_t)((sample->gyro_x * gyro_dt) >> GYRO_K_SHIFT);
+    int32_t pitch = fusion->pitch_q16 + (int32_t)((sample->gyro_y * gyro_dt) >> GYRO_K_SHIFT);
+
+    /* Correction from accelerometer by the shorter way around the circle */
+    roll += (int32_t)(((int64_t)wrap_q16(acce_roll - roll) * fusion->acce_weight_q15) >> 15);
+    pitch += (int32_t)(((int64_t)wrap_q16(acce_pitch - pitch) * fusion->acce_weight_q15) >> 15);
+
+    fusion->roll_q16 = wrap_q16(roll);
+    fusion->pitch_q16 = wrap_q16(pitch);
+}
+
+static void fusion_mahony(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample, uint32_t dt_us)
+{
+    float *q = fusion->q;
+    const float dt = dt_us / 1000000.0f;
+    float gx = sample->gyro_x * fusion->gyro_rad;
+    float gy = sample->gyro_y * fusion->gyro_rad;
+    float gz = sample->gyro_z * fusion->gyro_rad;
+    float ax = sample->acce_x;
+    float ay = sample->acce_y;
+    float az = sample->acce_z;
+
+    const float norm = ax * ax + ay * ay + az * az;
+    if (norm > 0.0f) {
+        const float recip_norm = 1.0f / sqrtf(norm);
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+
+        /* Error between estimated and measured direction of gravity */
+        const float halfvx = q[1] * q[3] - q[0] * q[2];
+        const float halfvy = q[0] * q[1] + q[2] * q[3];
+        const float halfvz = q[0] * q[0] - 0.5f + q[3] * q[3];
+        const float halfex = ay * halfvz - az * halfvy;
+        const float halfey = az * halfvx - ax * halfvz;
+        const float halfez = ax * halfvy - ay * halfvx;
+
+        if (fusion->config.ki > 0.0f) {
+            fusion->integral[0] += 2.0f * fusion->config.ki * halfex * dt;
+            fusion->integral[1] += 2.0f * fusion->config.ki * halfey * dt;
+            fusion->integral[2] += 2.0f * fusion->config.ki * halfez * dt;
+            gx += fusion->integral[0];
+            gy += fusion->integral[1];
+            gz += fusion->integral[2];
+        }
+        gx += 2.0f * fusion->config.kp * halfex;
+        gy += 2.0f * fusion->config.kp * halfey;
+        gz += 2.0f * fusion->config.kp * halfez;
+    }
+
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    const float qa = q[0], qb = q[1], qc = q[2];
+    q[0] += -qb * gx - qc * gy - q[3] * gz;
+    q[1] += qa * gx + qc * gz - q[3] * gy;
+    q[2] += qa * gy - qb * gz + q[3] * gx;
+    q[3] += qa * gz + qb * gy - qc * gx;
+
+    const float recip_norm = 1.0f / sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int i = 0; i < 4; i++) {
+        q[i] *= recip_norm;
+    }
+}
+
+static void fusion_madgwick(imu_fusion_handle_t fusion, const imu_fusion_sample_t *sample, uint32_t dt_us)
+{
+    float *q = fusion->q;
+    const float dt = dt_us / 1000000.0f;
+    const float gx = sample->gyro_x * fusion->gyro_rad;
+    const float gy = sample->gyro_y * fusion->gyro_rad;
+    const float gz = sample->gyro_z * fusion->gyro_rad;
+    float ax = sample->acce_x;
+    float ay = sample->acce_y;
+    float az = sample->acce_z;
+
+    /* Rate of change of quaternion from gyroscope */
+    float q_dot[4] = {
+        0.5f * (-q[1] * gx - q[2] * gy - q[3] * gz),
+        0.5f * (q[0] * gx + q[2] * gz - q[3] * gy),
+        0.5f * (q[0] * gy - q[1] * gz + q[3] * gx),
+        0.5f * (q[0] * gz + q[1] * gy - q[2] * gx),
+    };
+
+    const float norm = ax * ax + ay * ay + az * az;
+    if (norm > 0.0f) {
+        const float recip_norm = 1.0f / sqrtf(norm);
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+
+        /* Gradient descent step of the gravity direction error */
+        const float _2q0 = 2.0f * q[0], _2q1 = 2.0f * q[1], _2q2 = 2.0f * q[2], _2q3 = 2.0f * q[3];
+        const float _4q0 = 4.0f * q[0], _4q1 = 4.0f * q[1], _4q2 = 4.0f * q[2];
+        const float _8q1 = 8.0f * q[1], _8q2 = 8.0f * q[2];
+        const float q0q0 = q[0] * q[0], q1q1 = q[1] * q[1], q2q2 = q[2] * q[2], q3q3 = q[3] * q[3];
+        float s[4] = {
+            _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay,
+            _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q[1] - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az,
+            4.0f * q0q0 * q[2] + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az,
+            4.0f * q1q1 * q[3] - _2q1 * ax + 4.0f * q2q2 * q[3] - _2q2 * ay,
+        };
+        const float s_norm = s[0] * s[0] + s[1] * s[1] + s[2] * s[2] + s[3] * s[3];
+        if (s_norm > 0.0f) {
+            const float recip_s_norm = 1.0f / sqrtf(s_norm);
+            for (int i = 0; i < 4; i++) {
+                q_dot[i] -= fusion->config.beta * s[i] * recip_s_norm;
+            }
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        q[i] += q_dot[i] * dt;
+    }
+    const float recip_norm = 1.0f / sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int i = 0; i < 4; i++) {
+        q[i] *= recip_norm;
+    }
+}
+
+/**
+ * @brief atan2 in fixed point
+ *
+ * @return angle [1/65536 deg] in (-180, 180]
+ */
+static int32_t atan2_q16(int32_t y, int32_t x)
+{
+    const uint32_t abs_x = (x < 0) ? -x : x;
+    const uint32_t abs_y = (y < 0) ? -y : y;
+
+    if (abs_x == 0 && abs_y == 0) {
+        return 0;
+    }
+
+    /* First octant by the ratio of the smaller and the bigger value */
+    const bool swap = abs_y > abs_x;
+    const uint32_t z = ((uint64_t)(swap ? abs_x : abs_y) << 16) / (swap ? abs_y : abs_x);
+    const int64_t poly = ATAN_K1_Q16 + (((int64_t)ATAN_K2_Q16 * z) >> 16);
+    int32_t angle = Q16_DEG(45) * (int64_t)z / 65536 + (int32_t)((((int64_t)z * (65536 - z)) >> 16) * poly >> 16);
+
+    if (swap) {
+        angle = Q16_DEG(90) - angle;
+    }
+    if (x < 0) {
+        angle = Q16_DEG(180) - angle;
+    }
+    return (y < 0) ? -angle : angle;
+}
+
+static uint32_t isqrt(uint32_t value)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= res + bit) {
+            value -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+static int32_t wrap_q16(int32_t angle)
+{
+    if (angle > Q16_DEG(180)) {
+        angle -= Q16_DEG(360);
+    } else if (angle <= -Q16_DEG(180)) {
+        angle += Q16_DEG(360);
+    }
+    return angle;
+}
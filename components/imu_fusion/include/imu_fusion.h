@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Orientation from accelerometer and gyroscope samples (complementary, Mahony and Madgwick filters)
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fusion handle
+ */
+typedef struct imu_fusion_s *imu_fusion_handle_t;
+
+/**
+ * @brief Fusion algorithm
+ */
+typedef enum {
+    IMU_FUSION_COMPLEMENTARY,       /*!< Complementary filter of roll and pitch (float) */
+    IMU_FUSION_COMPLEMENTARY_Q15,   /*!< Complementary filter of roll and pitch in fixed point (no float in update, for chips without FPU) */
+    IMU_FUSION_MAHONY,              /*!< Mahony filter, quaternion with PI feedback from accelerometer (float) */
+    IMU_FUSION_MADGWICK,            /*!< Madgwick filter, quaternion with gradient descent from accelerometer (float) */
+} imu_fusion_algo_t;
+
+/**
+ * @brief Raw sample of accelerometer and gyroscope
+ *
+ * Raw register values of both drivers can be used directly (e.g. icm42670_fifo_sample_t, mpu6050_raw_acce_value_t).
+ */
+typedef struct {
+    int16_t acce_x;         /*!< Raw accelerometer (any sensitivity, only the direction is used) */
+    int16_t acce_y;
+    int16_t acce_z;
+    int16_t gyro_x;         /*!< Raw gyroscope [1/gyro_sensitivity dps] */
+    int16_t gyro_y;
+    int16_t gyro_z;
+    int64_t timestamp_us;   /*!< Sample time (0: samples come every sample_period_us) */
+} imu_fusion_sample_t;
+
+/**
+ * @brief Orientation
+ */
+typedef struct {
+    float roll;             /*!< Rotation around X [deg] */
+    float pitch;            /*!< Rotation around Y [deg] */
+    float yaw;              /*!< Rotation around Z from the start [deg] (only Mahony and Madgwick, it drifts without magnetometer) */
+} imu_fusion_angle_t;
+
+/**
+ * @brief Fusion configuration
+ */
+typedef struct {
+    imu_fusion_algo_t algo;         /*!< Fusion algorithm */
+    float gyro_sensitivity;         /*!< Gyroscope sensitivity [LSB/dps] (e.g. 16.4 for +/- 2000 dps) */
+    uint32_t sample_period_us;      /*!< Period of samples without timestamp */
+    float alpha;                    /*!< Complementary: weight of gyroscope (0..1) */
+    float kp;                       /*!< Mahony: proportional gain */
+    float ki;                       /*!< Mahony: integral gain */
+    float beta;                     /*!< Madgwick: gain of accelerometer correction */
+} imu_fusion_config_t;
+
+/**
+ * @brief Default fusion configuration
+ */
+#define IMU_FUSION_DEFAULT_CONFIG(fusion_algo, sensitivity, period_us)   \
+    {                                                                   \
+        .algo = fusion_algo,                                            \
+        .gyro_sensitivity = sensitivity,                                \
+        .sample_period_us = period_us,                                  \
+        .alpha = 0.98f,                                                 \
+        .kp = 1.0f,                                                     \
+        .ki = 0.0f,                                                     \
+        .beta = 0.1f,                                                   \
+    }
+
+/**
+ * @brief Create fusion filter
+ *
+ * @note Only this function allocates memory, the updates work on the state of the handle.
+ *
+ * @param config: Fusion configuration
+ * @param ret_fusion: Output fusion handle
+ *
+ * @return
+ *     - ESP_OK                 on success
+ *     - ESP_ERR_INVALID_ARG    parameter error
+ *     - ESP_ERR_NO_MEM         not enough memory
+ */
+esp_err_t imu_fusion_new(const imu_fusion_config_t *config, imu_fusion_handle_t *ret_fusion);
+
+/**
+ * @brief Delete fusion filter
+ *
+ * @param fusion: Fusion handle
+ *
+ * @return
+ *     - ESP_OK                 on success
+ *     - ESP_ERR_INVALID_ARG    parameter error
+ */
+esp_err_t imu_fusion_del(imu_fusion_handle_t fusion);
+
+/**
+ * @brief Start again from the orientation of the next accelerometer sample
+ *
+ * @param fusion: Fusion handle
+ */
+void imu_fusion_reset(imu_fusion_handle_t fusion);
+
+/**
+ * @brief Process samples in order (e.g. one FIFO read)
+ *
+ * The first sample after create or reset sets the orientation from the accelerometer.
+ *
+ * @param fusion: Fusion handle
+ * @param samples: Samples, the oldest first
+ * @param count: Count of samples
+ */
+void imu_fusion_update(imu_fusion_handle_t fusion, const imu_fusion_sample_t *samples, size_t count);
+
+/**
+ * @brief Get orientation after the last processed sample
+ *
+ * @param fusion: Fusion handle
+ * @param angle: Output orientation
+ */
+void imu_fusion_get_angle(imu_fusion_handle_t fusion, imu_fusion_angle_t *angle);
+
+/**
+ * @brief Get roll and pitch of fixed point complementary filter without float conversion
+ *
+ * @param fusion: Fusion handle (IMU_FUSION_COMPLEMENTARY_Q15)
+ * @param roll: Output roll [1/65536 deg]
+ * @param pitch: Output pitch [1/65536 deg]
+ *
+ * @return
+ *     - ESP_OK                 on success
+ *     - ESP_ERR_INVALID_STATE  other algorithm
+ */
+esp_err_t imu_fusion_get_angle_q16(imu_fusion_handle_t fusion, int32_t *roll, int32_t *pitch);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "unity.h"
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "imu_fusion.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#define TEST_SAMPLE_PERIOD_US   (2000)  /* 500 Hz */
+#define TEST_SAMPLES            (500)
+#define TEST_ACCE_1G            (16384) /* +/- 2 g */
+#define TEST_GYRO_SENSITIVITY   (16.4f) /* +/- 2000 dps */
+
+static const char *TAG = "imu_fusion test";
+static const char *algo_names[] = {"complementary", "complementary Q15", "Mahony", "Madgwick"};
+static imu_fusion_sample_t samples[TEST_SAMPLES];
+
+/* Rotation around X with constant rate, accelerometer follows the gravity */
+static void test_samples_roll(float rate_dps)
+{
+    for (int i = 0; i < TEST_SAMPLES; i++) {
+        const float roll = rate_dps * i * TEST_SAMPLE_PERIOD_US / 1000000.0f * (float)M_PI / 180.0f;
+        samples[i] = (imu_fusion_sample_t) {
+            .acce_y = sinf(roll) * TEST_ACCE_1G,
+            .acce_z = cosf(roll) * TEST_ACCE_1G,
+            .gyro_x = (i == 0) ? 0 : rate_dps * TEST_GYRO_SENSITIVITY,
+        };
+    }
+}
+
+TEST_CASE("IMU fusion static tilt", "[imu_fusion]")
+{
+    const float roll = 30.0f * (float)M_PI / 180.0f;
+    const float pitch = -20.0f * (float)M_PI / 180.0f;
+    for (int i = 0; i < TEST_SAMPLES; i++) {
+        samples[i] = (imu_fusion_sample_t) {
+            .acce_x = -sinf(pitch) * TEST_ACCE_1G,
+            .acce_y = cosf(pitch) * sinf(roll) * TEST_ACCE_1G,
+            .acce_z = cosf(pitch) * cosf(roll) * TEST_ACCE_1G,
+        };
+    }
+
+    for (imu_fusion_algo_t algo = IMU_FUSION_COMPLEMENTARY; algo <= IMU_FUSION_MADGWICK; algo++) {
+        imu_fusion_handle_t fusion = NULL;
+        const imu_fusion_config_t cfg = IMU_FUSION_DEFAULT_CONFIG(algo, TEST_GYRO_SENSITIVITY, TEST_SAMPLE_PERIOD_US);
+        TEST_ASSERT_EQUAL(ESP_OK, imu_fusion_new(&cfg, &fusion));
+
+        imu_fusion_angle_t angle;
+        imu_fusion_update(fusion, samples, TEST_SAMPLES);
+        imu_fusion_get_angle(fusion, &angle);
+        ESP_LOGI(TAG, "%s: roll %.2f, pitch %.2f, yaw %.2f", algo_names[algo], angle.roll, angle.pitch, angle.yaw);
+        TEST_ASSERT_FLOAT_WITHIN(0.2f, 30.0f, angle.roll);
+        TEST_ASSERT_FLOAT_WITHIN(0.2f, -20.0f, angle.pitch);
+        TEST_ASSERT_FLOAT_WITHIN(0.2f, 0.0f, angle.yaw);
+
+        TEST_ASSERT_EQUAL(ESP_OK, imu_fusion_del(fusion));
+    }
+}
+
+TEST_CASE("IMU fusion rotation", "[imu_fusion]")
+{
+    test_samples_roll(90.0f);
+
+    for (imu_fusion_algo_t algo = IMU_FUSION_COMPLEMENTARY; algo <= IMU_FUSION_MADGWICK; algo++) {
+        imu_fusion_handle_t fusion = NULL;
+        const imu_fusion_config_t cfg = IMU_FUSION_DEFAULT_CONFIG(algo, TEST_GYRO_SENSITIVITY, TEST_SAMPLE_PERIOD_US);
+        TEST_ASSERT_EQUAL(ESP_OK, imu_fusion_new(&cfg, &fusion));
+
+        /* 1 s at 90 dps, processed in batches of FIFO size */
+        imu_fusion_angle_t angle;
+        for (int i = 0; i < TEST_SAMPLES; i += 50) {
+            imu_fusion_update(fusion, &samples[i], 50);
+        }
+        imu_fusion_get_angle(fusion, &angle);
+        ESP_LOGI(TAG, "%s: roll %.2f, pitch %.2f", algo_names[algo], angle.roll, angle.pitch);
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, 90.0f * (TEST_SAMPLES - 1) / TEST_SAMPLES, angle.roll);
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, angle.pitch);
+
+        TEST_ASSERT_EQUAL(ESP_OK, imu_fusion_del(fusion));
+    }
+}
+
+TEST_CASE("IMU fusion benchmark", "[imu_fusion][benchmark]")
+{
+    test_samples_roll(45.0f);
+
+    for (imu_fusion_algo_t algo = IMU_FUSION_COMPLEMENTARY; algo <= IMU_FUSION_MADGWICK; algo++) {
+        imu_fusion_handle_t fusion = NULL;
+        const imu_fusion_config_t cfg = IMU_FUSION_DEFAULT_CONFIG(algo, TEST_GYRO_SENSITIVITY, TEST_SAMPLE_PERIOD_US);
+        TEST_ASSERT_EQUAL(ESP_OK, imu_fusion_new(&cfg, &fusion));
+
+        /* The first sample only starts the filter */
+        imu_fusion_update(fusion, samples, 1);
+        const uint32_t start = esp_cpu_get_cycle_count();
+        imu_fusion_update(fusion, &samples[1], TEST_SAMPLES - 1);
+        const uint32_t cycles = esp_cpu_get_cycle_count() - start;
+        ESP_LOGI(TAG, "%s: %"PRIu32" cycles per sample", algo_names[algo], cycles / (TEST_SAMPLES - 1));
+
+        TEST_ASSERT_EQUAL(ESP_OK, imu_fusion_del(fusion));
+    }
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (200)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
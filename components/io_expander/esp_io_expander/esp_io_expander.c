@@ -7,6 +7,11 @@
 #include <inttypes.h>
 #include <stdlib.h>
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "driver/gpio.h"
 #include "esp_bit_defs.h"
 #include "esp_check.h"
 #include "esp_log.h"
@@ -14,6 +19,8 @@
 #include "esp_io_expander.h"
 
 #define VALID_IO_COUNT(handle)      ((handle)->config.io_count <= IO_COUNT_MAX ? (handle)->config.io_count : IO_COUNT_MAX)
+#define INTR_READ_COUNT_MAX         (4)     /* Reads of one interrupt, when INT stays low */
+#define SEQ_CHUNK_LEN               (32)    /* Register values of one sequence write */
 
 /**
  * @brief Register type
@@ -25,10 +32,65 @@ typedef enum {
     REG_DIRECTION,
 } reg_type_t;
 
+/**
+ * @brief State of input change notification
+ *
+ */
+struct esp_io_expander_intr_s {
+    esp_io_expander_handle_t handle;
+    esp_io_expander_intr_config_t config;
+    TaskHandle_t task;
+    SemaphoreHandle_t exit_sem;     /* Given by the task when it finished */
+    uint32_t input_levels;          /* Last input levels (1: high) */
+    bool gpio_configured;
+    volatile bool stop;
+};
+
+/**
+ * @brief Request of the async worker
+ *
+ */
+typedef struct {
+    enum {
+        ASYNC_REQ_NONE = 0,
+        ASYNC_REQ_LEVEL,            /* Level change */
+        ASYNC_REQ_FLUSH,            /* Give done_sem after the previous requests */
+        ASYNC_REQ_STOP,             /* Finish the worker */
+    } type;
+    uint32_t high_mask;
+    uint32_t low_mask;
+    uint32_t seq;                   /* Number of flush request */
+} async_req_t;
+
+/**
+ * @brief State of asynchronous output requests
+ *
+ */
+struct esp_io_expander_async_s {
+    esp_io_expander_handle_t handle;
+    QueueHandle_t queue;
+    TaskHandle_t task;
+    SemaphoreHandle_t flush_mutex;  /* One flush at a time */
+    SemaphoreHandle_t done_sem;     /* Given by the task for flush and stop requests */
+    uint32_t flush_seq;             /* Number of the last posted flush */
+    volatile uint32_t done_seq;     /* Number of the last finished flush */
+    volatile bool exited;           /* Task finished by stop request */
+    esp_err_t err;                  /* First failed write since the last flush */
+};
+
 static char *TAG = "io_expander";
 
 static esp_err_t write_reg(esp_io_expander_handle_t handle, reg_type_t reg, uint32_t value);
 static esp_err_t read_reg(esp_io_expander_handle_t handle, reg_type_t reg, uint32_t *value);
+static esp_err_t check_output_dir(esp_io_expander_handle_t handle, uint32_t pin_num_mask);
+static esp_err_t update_output(esp_io_expander_handle_t handle, uint32_t high_mask, uint32_t low_mask);
+static esp_err_t read_input_levels(esp_io_expander_handle_t handle, uint32_t *levels);
+static void intr_isr(void *arg);
+static void intr_task(void *arg);
+static esp_err_t async_post(struct esp_io_expander_async_s *async, const async_req_t *req, TickType_t timeout);
+static void async_delete(struct esp_io_expander_async_s *async);
+static TickType_t async_remaining(TickType_t start, TickType_t timeout);
+static void async_task(void *arg);
 
 esp_err_t esp_io_expander_set_dir(esp_io_expander_handle_t handle, uint32_t pin_num_mask, esp_io_expander_dir_t direction)
 {
@@ -61,45 +123,79 @@ esp_err_t esp_io_expander_set_dir(esp_io_expander_handle_t handle, uint32_t pin_
 esp_err_t esp_io_expander_set_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level)
 {
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
-    if (pin_num_mask >= BIT64(VALID_IO_COUNT(handle))) {
-        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
-    }
 
-    uint32_t dir_reg, dir_bit;
-    ESP_RETURN_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), TAG, "Read direction reg failed");
+    return level ? update_output(handle, pin_num_mask, 0) : update_output(handle, 0, pin_num_mask);
+}
 
-    uint8_t io_count = VALID_IO_COUNT(handle);
-    /* Check every target pin's direction, must be in output mode */
-    for (int i = 0; i < io_count; i++) {
-        if (pin_num_mask & BIT(i)) {
-            dir_bit = dir_reg & BIT(i);
-            /* Check whether it is in input mode */
-            if ((dir_bit && handle->config.flags.dir_out_bit_zero) || (!dir_bit && !handle->config.flags.dir_out_bit_zero)) {
-                /* 1. 1 && Set 1 to input */
-                /* 2. 0 && Set 0 to input */
-                ESP_LOGE(TAG, "Pin[%d] can't set level in input mode", i);
-                return ESP_ERR_INVALID_STATE;
-            }
-        }
-    }
+esp_err_t esp_io_expander_write_masked(esp_io_expander_handle_t handle, uint32_t set_mask, uint32_t clear_mask)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(!(set_mask & clear_mask), ESP_ERR_INVALID_ARG, TAG, "Pin can't be set and cleared at once");
 
-    uint32_t output_reg, temp;
-    /* Read the current output level */
+    return update_output(handle, set_mask, clear_mask);
+}
+
+esp_err_t esp_io_expander_batch_begin(esp_io_expander_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(!handle->batch.active, ESP_ERR_INVALID_STATE, TAG, "Batch already started");
+
+    /* Changes are accumulated from the current output value */
+    ESP_RETURN_ON_ERROR(read_reg(handle, REG_OUTPUT, &handle->batch.output), TAG, "Read Output reg failed");
+    handle->batch.active = 1;
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_batch_commit(esp_io_expander_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(handle->batch.active, ESP_ERR_INVALID_STATE, TAG, "Batch not started");
+
+    handle->batch.active = 0;
+    uint32_t output_reg;
     ESP_RETURN_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), TAG, "Read Output reg failed");
-    temp = output_reg;
-    /* Set expected output level */
-    if ((level && !handle->config.flags.output_high_bit_zero) || (!level && handle->config.flags.output_high_bit_zero)) {
-        /* 1. High level && Set 1 to output high */
-        /* 2. Low level && Set 1 to output low */
-        output_reg |= pin_num_mask;
-    } else {
-        /* 3. High level && Set 0 to output high */
-        /* 4. Low level && Set 0 to output low */
-        output_reg &= ~pin_num_mask;
-    }
     /* Write to reg only when different */
-    if (output_reg != temp) {
-        ESP_RETURN_ON_ERROR(write_reg(handle, REG_OUTPUT, output_reg), TAG, "Write Output reg failed");
+    if (handle->batch.output != output_reg) {
+        ESP_RETURN_ON_ERROR(write_reg(handle, REG_OUTPUT, handle->batch.output), TAG, "Write Output reg failed");
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_write_sequence(esp_io_expander_handle_t handle, uint32_t pin_num_mask, const uint32_t *levels, size_t count)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE(levels || !count, ESP_ERR_INVALID_ARG, TAG, "Invalid levels");
+    ESP_RETURN_ON_FALSE(!handle->batch.active, ESP_ERR_INVALID_STATE, TAG, "Sequence can't be written in batch");
+    ESP_RETURN_ON_ERROR(check_output_dir(handle, pin_num_mask), TAG, "Check direction failed");
+
+    uint32_t output_reg;
+    ESP_RETURN_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), TAG, "Read Output reg failed");
+    const uint32_t other_pins = output_reg & ~pin_num_mask;
+    const uint32_t invert = handle->config.flags.output_high_bit_zero ? pin_num_mask : 0;
+
+    uint32_t values[SEQ_CHUNK_LEN];
+    while (count > 0) {
+        const size_t len = (count < SEQ_CHUNK_LEN) ? count : SEQ_CHUNK_LEN;
+        for (size_t i = 0; i < len; i++) {
+            values[i] = other_pins | ((levels[i] ^ invert) & pin_num_mask);
+        }
+        if (handle->write_output_seq) {
+            /* The driver streams all values in one transaction */
+            ESP_RETURN_ON_ERROR(handle->write_output_seq(handle, values, len), TAG, "Write output sequence failed");
+            output_reg = values[len - 1];
+            handle->shadow.output = output_reg;
+            handle->shadow.output_valid = handle->shadow.enable;
+        } else {
+            for (size_t i = 0; i < len; i++) {
+                /* Write to reg only when different */
+                if (values[i] != output_reg) {
+                    ESP_RETURN_ON_ERROR(write_reg(handle, REG_OUTPUT, values[i]), TAG, "Write Output reg failed");
+                    output_reg = values[i];
+                }
+            }
+        }
+        levels += len;
+        count -= len;
     }
 
     return ESP_OK;
@@ -161,14 +257,202 @@ esp_err_t esp_io_expander_reset(esp_io_expander_handle_t handle)
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
     ESP_RETURN_ON_FALSE(handle->reset, ESP_ERR_NOT_SUPPORTED, TAG, "reset isn't implemented");
 
+    /* Registers have default values after reset (also when it failed halfway), read them again */
+    handle->shadow.output_valid = 0;
+    handle->shadow.direction_valid = 0;
     return handle->reset(handle);
 }
 
+esp_err_t esp_io_expander_set_shadow_regs(esp_io_expander_handle_t handle, bool enable)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+
+    /* The copy is loaded by the first read */
+    handle->shadow.enable = enable;
+    handle->shadow.output_valid = 0;
+    handle->shadow.direction_valid = 0;
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_enable_intr(esp_io_expander_handle_t handle, const esp_io_expander_intr_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(handle && config && config->callback, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(GPIO_IS_VALID_GPIO(config->int_gpio_num), ESP_ERR_INVALID_ARG, TAG, "Invalid INT GPIO");
+    ESP_RETURN_ON_FALSE(handle->intr == NULL, ESP_ERR_INVALID_STATE, TAG, "Interrupt already enabled");
+
+    esp_err_t ret = ESP_OK;
+    struct esp_io_expander_intr_s *intr = calloc(1, sizeof(struct esp_io_expander_intr_s));
+    ESP_RETURN_ON_FALSE(intr, ESP_ERR_NO_MEM, TAG, "Malloc failed");
+    intr->handle = handle;
+    intr->config = *config;
+    intr->exit_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(intr->exit_sem, ESP_ERR_NO_MEM, err, TAG, "Create semaphore failed");
+
+    /* Reading of the input register clears pending INT, changes are counted from here */
+    ESP_GOTO_ON_ERROR(read_input_levels(handle, &intr->input_levels), err, TAG, "Read input reg failed");
+
+    BaseType_t res = xTaskCreate(intr_task, "io_exp_intr", config->task_stack, intr, config->task_priority, &intr->task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create task failed");
+    intr->gpio_configured = true;
+
+    /* INT is open-drain active low */
+    const gpio_config_t int_gpio_cfg = {
+        .mode = GPIO_MODE_INPUT,
+        .intr_type = GPIO_INTR_NEGEDGE,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pin_bit_mask = BIT64(config->int_gpio_num),
+    };
+    ESP_GOTO_ON_ERROR(gpio_config(&int_gpio_cfg), err, TAG, "Configure INT GPIO failed");
+    ret = gpio_install_isr_service(0);
+    /* ISR service can be installed from user before, then it returns invalid state */
+    ESP_GOTO_ON_FALSE(ret == ESP_OK || ret == ESP_ERR_INVALID_STATE, ret, err, TAG, "GPIO ISR install failed");
+    ESP_GOTO_ON_ERROR(gpio_isr_handler_add(config->int_gpio_num, intr_isr, intr), err, TAG, "Add GPIO ISR handler failed");
+    handle->intr = intr;
+
+    /* INT may have fallen before the ISR was added */
+    xTaskNotifyGive(intr->task);
+    return ESP_OK;
+
+err:
+    if (intr->gpio_configured) {
+        gpio_reset_pin(config->int_gpio_num);
+    }
+    if (intr->task) {
+        intr->stop = true;
+        xTaskNotifyGive(intr->task);
+        xSemaphoreTake(intr->exit_sem, portMAX_DELAY);
+    }
+    if (intr->exit_sem) {
+        vSemaphoreDelete(intr->exit_sem);
+    }
+    free(intr);
+    return ret;
+}
+
+esp_err_t esp_io_expander_disable_intr(esp_io_expander_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    struct esp_io_expander_intr_s *intr = handle->intr;
+    ESP_RETURN_ON_FALSE(intr, ESP_ERR_INVALID_STATE, TAG, "Interrupt not enabled");
+    ESP_RETURN_ON_FALSE(xTaskGetCurrentTaskHandle() != intr->task, ESP_ERR_INVALID_STATE, TAG, "Can't be called from callback");
+
+    gpio_isr_handler_remove(intr->config.int_gpio_num);
+    gpio_reset_pin(intr->config.int_gpio_num);
+
+    /* Task finishes the running callback first */
+    intr->stop = true;
+    xTaskNotifyGive(intr->task);
+    xSemaphoreTake(intr->exit_sem, portMAX_DELAY);
+    vSemaphoreDelete(intr->exit_sem);
+    handle->intr = NULL;
+    free(intr);
+    return ESP_OK;
+}
+
+esp_err_t esp_io_expander_async_start(esp_io_expander_handle_t handle, const esp_io_expander_async_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(handle && config && config->queue_len, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(handle->async == NULL, ESP_ERR_INVALID_STATE, TAG, "Async already started");
+
+    esp_err_t ret = ESP_OK;
+    struct esp_io_expander_async_s *async = calloc(1, sizeof(struct esp_io_expander_async_s));
+    ESP_RETURN_ON_FALSE(async, ESP_ERR_NO_MEM, TAG, "Malloc failed");
+    async->handle = handle;
+    async->queue = xQueueCreate(config->queue_len, sizeof(async_req_t));
+    ESP_GOTO_ON_FALSE(async->queue, ESP_ERR_NO_MEM, err, TAG, "Create queue failed");
+    async->flush_mutex = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(async->flush_mutex, ESP_ERR_NO_MEM, err, TAG, "Create mutex failed");
+    async->done_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(async->done_sem, ESP_ERR_NO_MEM, err, TAG, "Create semaphore failed");
+
+    BaseType_t res = xTaskCreate(async_task, "io_exp_async", config->task_stack, async, config->task_priority, &async->task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create task failed");
+    handle->async = async;
+    return ESP_OK;
+
+err:
+    async_delete(async);
+    return ret;
+}
+
+esp_err_t esp_io_expander_async_stop(esp_io_expander_handle_t handle)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    struct esp_io_expander_async_s *async = handle->async;
+    ESP_RETURN_ON_FALSE(async, ESP_ERR_INVALID_STATE, TAG, "Async not started");
+
+    /* Requests in the queue are written before the task finishes */
+    const async_req_t req = {
+        .type = ASYNC_REQ_STOP,
+    };
+    ESP_RETURN_ON_ERROR(async_post(async, &req, portMAX_DELAY), TAG, "Post stop request failed");
+    /* Semaphore can be given also by a timed out flush before */
+    while (!async->exited) {
+        xSemaphoreTake(async->done_sem, portMAX_DELAY);
+    }
+    const esp_err_t err = async->err;
+    handle->async = NULL;
+    async_delete(async);
+    return err;
+}
+
+esp_err_t esp_io_expander_set_level_async(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level)
+{
+    ESP_RETURN_ON_FALSE_ISR(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    ESP_RETURN_ON_FALSE_ISR(handle->async, ESP_ERR_INVALID_STATE, TAG, "Async not started");
+
+    const async_req_t req = {
+        .type = ASYNC_REQ_LEVEL,
+        .high_mask = level ? pin_num_mask : 0,
+        .low_mask = level ? 0 : pin_num_mask,
+    };
+    return async_post(handle->async, &req, 0);
+}
+
+esp_err_t esp_io_expander_async_flush(esp_io_expander_handle_t handle, int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
+    struct esp_io_expander_async_s *async = handle->async;
+    ESP_RETURN_ON_FALSE(async, ESP_ERR_INVALID_STATE, TAG, "Async not started");
+
+    const TickType_t timeout = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    const TickType_t start = xTaskGetTickCount();
+    ESP_RETURN_ON_FALSE(xSemaphoreTake(async->flush_mutex, timeout) == pdTRUE, ESP_ERR_TIMEOUT, TAG, "Flush timeout");
+
+    esp_err_t ret = ESP_OK;
+    const async_req_t req = {
+        .type = ASYNC_REQ_FLUSH,
+        .seq = ++async->flush_seq,
+    };
+    ESP_GOTO_ON_ERROR(async_post(async, &req, async_remaining(start, timeout)), out, TAG, "Post flush request failed");
+    /* Semaphore can be given also by a timed out flush before */
+    while (async->done_seq != req.seq) {
+        if (xSemaphoreTake(async->done_sem, async_remaining(start, timeout)) != pdTRUE) {
+            ret = ESP_ERR_TIMEOUT;
+            goto out;
+        }
+    }
+    ret = async->err;
+    async->err = ESP_OK;
+
+out:
+    xSemaphoreGive(async->flush_mutex);
+    return ret;
+}
+
 esp_err_t esp_io_expander_del(esp_io_expander_handle_t handle)
 {
     ESP_RETURN_ON_FALSE(handle, ESP_ERR_INVALID_ARG, TAG, "Invalid handle");
     ESP_RETURN_ON_FALSE(handle->del, ESP_ERR_NOT_SUPPORTED, TAG, "del isn't implemented");
 
+    if (handle->intr) {
+        ESP_RETURN_ON_ERROR(esp_io_expander_disable_intr(handle), TAG, "Disable interrupt failed");
+    }
+    if (handle->async) {
+        /* Write error is not a reason to keep the device */
+        esp_io_expander_async_stop(handle);
+    }
+
     return handle->del(handle);
 }
 
@@ -186,10 +470,16 @@ static esp_err_t write_reg(esp_io_expander_handle_t handle, reg_type_t reg, uint
     switch (reg) {
     case REG_OUTPUT:
         ESP_RETURN_ON_FALSE(handle->write_output_reg, ESP_ERR_NOT_SUPPORTED, TAG, "write_output_reg isn't implemented");
-        return handle->write_output_reg(handle, value);
+        ESP_RETURN_ON_ERROR(handle->write_output_reg(handle, value), TAG, "Write output reg failed");
+        handle->shadow.output = value;
+        handle->shadow.output_valid = handle->shadow.enable;
+        return ESP_OK;
     case REG_DIRECTION:
         ESP_RETURN_ON_FALSE(handle->write_direction_reg, ESP_ERR_NOT_SUPPORTED, TAG, "write_direction_reg isn't implemented");
-        return handle->write_direction_reg(handle, value);
+        ESP_RETURN_ON_ERROR(handle->write_direction_reg(handle, value), TAG, "Write direction reg failed");
+        handle->shadow.direction = value;
+        handle->shadow.direction_valid = handle->shadow.enable;
+        return ESP_OK;
     default:
         return ESP_ERR_NOT_SUPPORTED;
     }
@@ -215,14 +505,261 @@ static esp_err_t read_reg(esp_io_expander_handle_t handle, reg_type_t reg, uint3
         ESP_RETURN_ON_FALSE(handle->read_input_reg, ESP_ERR_NOT_SUPPORTED, TAG, "read_input_reg isn't implemented");
         return handle->read_input_reg(handle, value);
     case REG_OUTPUT:
+        if (handle->shadow.output_valid) {
+            *value = handle->shadow.output;
+            return ESP_OK;
+        }
         ESP_RETURN_ON_FALSE(handle->read_output_reg, ESP_ERR_NOT_SUPPORTED, TAG, "read_output_reg isn't implemented");
-        return handle->read_output_reg(handle, value);
+        ESP_RETURN_ON_ERROR(handle->read_output_reg(handle, value), TAG, "Read output reg failed");
+        handle->shadow.output = *value;
+        handle->shadow.output_valid = handle->shadow.enable;
+        return ESP_OK;
     case REG_DIRECTION:
+        if (handle->shadow.direction_valid) {
+            *value = handle->shadow.direction;
+            return ESP_OK;
+        }
         ESP_RETURN_ON_FALSE(handle->read_direction_reg, ESP_ERR_NOT_SUPPORTED, TAG, "read_direction_reg isn't implemented");
-        return handle->read_direction_reg(handle, value);
+        ESP_RETURN_ON_ERROR(handle->read_direction_reg(handle, value), TAG, "Read direction reg failed");
+        handle->shadow.direction = *value;
+        handle->shadow.direction_valid = handle->shadow.enable;
+        return ESP_OK;
     default:
         return ESP_ERR_NOT_SUPPORTED;
     }
 
     return ESP_OK;
 }
+
+/**
+ * @brief Check that all target IOs are in output mode
+ *
+ * @param handle: IO Expander handle
+ * @param pin_num_mask: Target IOs
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Some IO is in input mode
+ */
+static esp_err_t check_output_dir(esp_io_expander_handle_t handle, uint32_t pin_num_mask)
+{
+    uint32_t dir_reg, dir_bit;
+    ESP_RETURN_ON_ERROR(read_reg(handle, REG_DIRECTION, &dir_reg), TAG, "Read direction reg failed");
+
+    uint8_t io_count = VALID_IO_COUNT(handle);
+    /* Check every target pin's direction, must be in output mode (the pins are checked one by one only for the log) */
+    const uint32_t out_mask = handle->config.flags.dir_out_bit_zero ? ~dir_reg : dir_reg;
+    for (int i = 0; i < io_count && (pin_num_mask & ~out_mask); i++) {
+        if (pin_num_mask & BIT(i)) {
+            dir_bit = dir_reg & BIT(i);
+            /* Check whether it is in input mode */
+            if ((dir_bit && handle->config.flags.dir_out_bit_zero) || (!dir_bit && !handle->config.flags.dir_out_bit_zero)) {
+                /* 1. 1 && Set 1 to input */
+                /* 2. 0 && Set 0 to input */
+                ESP_LOGE(TAG, "Pin[%d] can't set level in input mode", i);
+                return ESP_ERR_INVALID_STATE;
+            }
+        }
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Set output levels of target IOs by one write (or into the started batch)
+ *
+ * @param handle: IO Expander handle
+ * @param high_mask: IOs set to high level
+ * @param low_mask: IOs set to low level
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+static esp_err_t update_output(esp_io_expander_handle_t handle, uint32_t high_mask, uint32_t low_mask)
+{
+    const uint32_t pin_num_mask = high_mask | low_mask;
+    if (pin_num_mask >= BIT64(VALID_IO_COUNT(handle))) {
+        ESP_LOGW(TAG, "Pin num mask out of range, bit higher than %d won't work", VALID_IO_COUNT(handle) - 1);
+    }
+
+    ESP_RETURN_ON_ERROR(check_output_dir(handle, pin_num_mask), TAG, "Check direction failed");
+
+    uint32_t output_reg, temp;
+    /* Read the current output level (or the pending one of the batch) */
+    if (handle->batch.active) {
+        output_reg = handle->batch.output;
+    } else {
+        ESP_RETURN_ON_ERROR(read_reg(handle, REG_OUTPUT, &output_reg), TAG, "Read Output reg failed");
+    }
+    temp = output_reg;
+    /* Set expected output level */
+    if (!handle->config.flags.output_high_bit_zero) {
+        /* Set 1 to output high */
+        output_reg = (output_reg | high_mask) & ~low_mask;
+    } else {
+        /* Set 1 to output low */
+        output_reg = (output_reg | low_mask) & ~high_mask;
+    }
+    if (handle->batch.active) {
+        handle->batch.output = output_reg;
+    } else if (output_reg != temp) {
+        /* Write to reg only when different */
+        ESP_RETURN_ON_ERROR(write_reg(handle, REG_OUTPUT, output_reg), TAG, "Write Output reg failed");
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Read input levels of all IOs
+ *
+ * @param handle: IO Expander handle
+ * @param levels: Bitwise OR of IOs in high level
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+static esp_err_t read_input_levels(esp_io_expander_handle_t handle, uint32_t *levels)
+{
+    uint32_t input_reg;
+    ESP_RETURN_ON_ERROR(read_reg(handle, REG_INPUT, &input_reg), TAG, "Read input reg failed");
+    *levels = handle->config.flags.input_high_bit_zero ? ~input_reg : input_reg;
+    return ESP_OK;
+}
+
+static void IRAM_ATTR intr_isr(void *arg)
+{
+    struct esp_io_expander_intr_s *intr = (struct esp_io_expander_intr_s *)arg;
+    BaseType_t need_yield = pdFALSE;
+
+    vTaskNotifyGiveFromISR(intr->task, &need_yield);
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void intr_task(void *arg)
+{
+    struct esp_io_expander_intr_s *intr = (struct esp_io_expander_intr_s *)arg;
+    esp_io_expander_handle_t handle = intr->handle;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (intr->stop) {
+            break;
+        }
+        /* INT stays low when inputs changed again during the read, no falling edge comes then */
+        int reads = 0;
+        do {
+            uint32_t levels;
+            if (read_input_levels(handle, &levels) != ESP_OK) {
+                break;
+            }
+            const uint32_t changed = (levels ^ intr->input_levels) & intr->config.pin_num_mask;
+            intr->input_levels = levels;
+            if (changed) {
+                intr->config.callback(handle, changed & levels, changed & ~levels, intr->config.user_ctx);
+            }
+        } while (!intr->stop && ++reads < INTR_READ_COUNT_MAX && gpio_get_level(intr->config.int_gpio_num) == 0);
+    }
+
+    xSemaphoreGive(intr->exit_sem);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Post request to the async worker (from task or ISR)
+ *
+ * @param async: Async state
+ * @param req: Request
+ * @param timeout: Maximal wait for space in the queue (only from task)
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_TIMEOUT: Queue is full
+ */
+static esp_err_t async_post(struct esp_io_expander_async_s *async, const async_req_t *req, TickType_t timeout)
+{
+    if (xPortInIsrContext()) {
+        BaseType_t need_yield = pdFALSE;
+        if (xQueueSendFromISR(async->queue, req, &need_yield) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+        if (need_yield == pdTRUE) {
+            portYIELD_FROM_ISR();
+        }
+        return ESP_OK;
+    }
+
+    ESP_RETURN_ON_FALSE(xQueueSend(async->queue, req, timeout) == pdTRUE, ESP_ERR_TIMEOUT, TAG, "Async queue full");
+    return ESP_OK;
+}
+
+/**
+ * @brief Remaining part of timeout
+ *
+ * @param start: Tick count at start of the wait
+ * @param timeout: Whole timeout (portMAX_DELAY: forever)
+ * @return
+ *      - Ticks to wait
+ */
+static TickType_t async_remaining(TickType_t start, TickType_t timeout)
+{
+    if (timeout == portMAX_DELAY) {
+        return portMAX_DELAY;
+    }
+    const TickType_t elapsed = xTaskGetTickCount() - start;
+    return (elapsed < timeout) ? timeout - elapsed : 0;
+}
+
+/**
+ * @brief Free async state (the task must be finished)
+ *
+ * @param async: Async state
+ */
+static void async_delete(struct esp_io_expander_async_s *async)
+{
+    if (async->done_sem) {
+        vSemaphoreDelete(async->done_sem);
+    }
+    if (async->flush_mutex) {
+        vSemaphoreDelete(async->flush_mutex);
+    }
+    if (async->queue) {
+        vQueueDelete(async->queue);
+    }
+    free(async);
+}
+
+static void async_task(void *arg)
+{
+    struct esp_io_expander_async_s *async = (struct esp_io_expander_async_s *)arg;
+    esp_io_expander_handle_t handle = async->handle;
+    async_req_t req;
+
+    while (1) {
+        xQueueReceive(async->queue, &req, portMAX_DELAY);
+        /* Level changes waiting in the queue are merged, the later one wins */
+        uint32_t high_mask = 0, low_mask = 0;
+        while (req.type == ASYNC_REQ_LEVEL) {
+            high_mask = (high_mask & ~req.low_mask) | req.high_mask;
+            low_mask = (low_mask & ~req.high_mask) | req.low_mask;
+            if (xQueueReceive(async->queue, &req, 0) != pdTRUE) {
+                req.type = ASYNC_REQ_NONE;
+            }
+        }
+        if (high_mask | low_mask) {
+            esp_err_t err = update_output(handle, high_mask, low_mask);
+            if (err != ESP_OK && async->err == ESP_OK) {
+                async->err = err;
+            }
+        }
+
+        if (req.type == ASYNC_REQ_FLUSH) {
+            async->done_seq = req.seq;
+            xSemaphoreGive(async->done_sem);
+        } else if (req.type == ASYNC_REQ_STOP) {
+            break;
+        }
+    }
+
+    async->exited = true;
+    xSemaphoreGive(async->done_sem);
+    vTaskDelete(NULL);
+}
@@ -13,6 +13,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
 
 #include "esp_err.h"
 
@@ -88,9 +89,64 @@ typedef struct {
         uint8_t input_high_bit_zero : 1;    /*!< If the input level of IO is high, the corresponding bit of the input register is 0 */
         uint8_t output_high_bit_zero : 1;   /*!< If the output level of IO is high, the corresponding bit of the output register is 0 */
     } flags;
-    /* Don't support with interrupt mode yet, will be added soon */
 } esp_io_expander_config_t;
 
+/**
+ * @brief Callback of input changes
+ *
+ * @note Called from the interrupt task of the expander, it can read/write the expander
+ *
+ * @param handle: IO Expander handle
+ * @param rising_mask: Bitwise OR of pins changed from low to high level
+ * @param falling_mask: Bitwise OR of pins changed from high to low level
+ * @param user_ctx: User context of the configuration
+ */
+typedef void (*esp_io_expander_intr_cb_t)(esp_io_expander_handle_t handle, uint32_t rising_mask, uint32_t falling_mask, void *user_ctx);
+
+/**
+ * @brief Configuration of input change notification
+ */
+typedef struct {
+    int int_gpio_num;                       /*!< GPIO connected to INT output of the expander (active low) */
+    uint32_t pin_num_mask;                  /*!< Bitwise OR of reported pins */
+    esp_io_expander_intr_cb_t callback;     /*!< Callback of input changes */
+    void *user_ctx;                         /*!< User context passed to the callback */
+    int task_priority;                      /*!< Priority of the interrupt task */
+    uint32_t task_stack;                    /*!< Stack size of the interrupt task */
+} esp_io_expander_intr_config_t;
+
+/**
+ * @brief Default configuration of input change notification
+ */
+#define ESP_IO_EXPANDER_INTR_DEFAULT_CONFIG(gpio, pin_mask, cb) \
+    {                                                           \
+        .int_gpio_num = gpio,                                   \
+        .pin_num_mask = pin_mask,                               \
+        .callback = cb,                                         \
+        .user_ctx = NULL,                                       \
+        .task_priority = 5,                                     \
+        .task_stack = 3072,                                     \
+    }
+
+/**
+ * @brief Configuration of asynchronous output requests
+ */
+typedef struct {
+    uint32_t queue_len;                     /*!< Maximal count of waiting requests */
+    int task_priority;                      /*!< Priority of the worker task */
+    uint32_t task_stack;                    /*!< Stack size of the worker task */
+} esp_io_expander_async_config_t;
+
+/**
+ * @brief Default configuration of asynchronous output requests
+ */
+#define ESP_IO_EXPANDER_ASYNC_DEFAULT_CONFIG()  \
+    {                                           \
+        .queue_len = 16,                        \
+        .task_priority = 5,                     \
+        .task_stack = 3072,                     \
+    }
+
 struct esp_io_expander_s {
 
     /**
@@ -187,10 +243,55 @@ struct esp_io_expander_s {
      */
     esp_err_t (*del)(esp_io_expander_handle_t handle);
 
+    /**
+     * @brief Write more values to output register in one bus transaction (optional)
+     *
+     * @note The outputs must follow the values in order, e.g. I2C expanders without auto-increment latch each
+     *       data byte written after one command byte.
+     * @note If not implemented, `esp_io_expander_write_sequence` uses `write_output_reg` for every value.
+     *
+     * @param handle: IO Expander handle
+     * @param values: Register's values
+     * @param count: Count of values (at least 1)
+     *
+     * @return
+     *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*write_output_seq)(esp_io_expander_handle_t handle, const uint32_t *values, size_t count);
+
     /**
      * @brief Configuration structure
      */
     esp_io_expander_config_t config;
+
+    /**
+     * @brief Shadow copy of output and direction registers (managed by `esp_io_expander_set_shadow_regs`, drivers don't touch it)
+     */
+    struct {
+        uint32_t output;                    /*!< Last value of output register */
+        uint32_t direction;                 /*!< Last value of direction register */
+        uint8_t enable : 1;                 /*!< Registers are read from the copy */
+        uint8_t output_valid : 1;           /*!< Output copy matches the device */
+        uint8_t direction_valid : 1;        /*!< Direction copy matches the device */
+    } shadow;
+
+    /**
+     * @brief Pending output changes (managed by `esp_io_expander_batch_begin/commit`, drivers don't touch it)
+     */
+    struct {
+        uint32_t output;                    /*!< Output register value written by commit */
+        uint8_t active : 1;                 /*!< Output changes are accumulated */
+    } batch;
+
+    /**
+     * @brief State of input change notification (managed by `esp_io_expander_enable_intr`, drivers don't touch it)
+     */
+    struct esp_io_expander_intr_s *intr;
+
+    /**
+     * @brief State of asynchronous output requests (managed by `esp_io_expander_async_start`, drivers don't touch it)
+     */
+    struct esp_io_expander_async_s *async;
 };
 
 /**
@@ -219,6 +320,66 @@ esp_err_t esp_io_expander_set_dir(esp_io_expander_handle_t handle, uint32_t pin_
  */
 esp_err_t esp_io_expander_set_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level);
 
+/**
+ * @brief Set the output levels of two sets of target IOs by one register write
+ *
+ * @note All target IOs must be in output mode first, otherwise this function will return the error `ESP_ERR_INVALID_STATE`
+ *
+ * @param handle: IO Exapnder handle
+ * @param set_mask: Bitwise OR of pins set to high level
+ * @param clear_mask: Bitwise OR of pins set to low level (must not overlap with `set_mask`)
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_write_masked(esp_io_expander_handle_t handle, uint32_t set_mask, uint32_t clear_mask);
+
+/**
+ * @brief Start accumulating output changes
+ *
+ * Following `esp_io_expander_set_level` and `esp_io_expander_write_masked` only update the pending output value,
+ * which is written by `esp_io_expander_batch_commit` at once.
+ *
+ * @note One batch of one handle can be used by one task at a time
+ *
+ * @param handle: IO Exapnder handle
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Batch already started
+ */
+esp_err_t esp_io_expander_batch_begin(esp_io_expander_handle_t handle);
+
+/**
+ * @brief Write the accumulated output changes by one register write and finish the batch
+ *
+ * @param handle: IO Exapnder handle
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Batch not started
+ */
+esp_err_t esp_io_expander_batch_commit(esp_io_expander_handle_t handle);
+
+/**
+ * @brief Output a sequence of levels on target IOs (e.g. bit-banged serial signals)
+ *
+ * Other IOs keep their levels. Drivers implementing `write_output_seq` send the whole sequence in a few bus
+ * transactions, otherwise every changed value is one register write.
+ *
+ * @note Target IOs must be in output mode
+ *
+ * @param handle: IO Exapnder handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param levels: Levels one after another. For each bit, 0 - Low level, 1 - High level (only bits of `pin_num_mask` are used)
+ * @param count: Count of levels
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Batch started or some IO is in input mode
+ */
+esp_err_t esp_io_expander_write_sequence(esp_io_expander_handle_t handle, uint32_t pin_num_mask, const uint32_t *levels, size_t count);
+
 /**
  * @brief Get the intput level of a set of target IOs
  *
@@ -233,6 +394,96 @@ esp_err_t esp_io_expander_set_level(esp_io_expander_handle_t handle, uint32_t pi
  */
 esp_err_t esp_io_expander_get_level(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint32_t *level_mask);
 
+/**
+ * @brief Report input changes of target IOs on INT signal of the expander (instead of polling)
+ *
+ * Falling edge of INT wakes a task, which reads the input register (this clears INT of the expander) and calls
+ * the callback with the changed pins.
+ *
+ * @note Supported by expanders with open-drain INT output (e.g. TCA9554, TCA95xx, HT8574/PCF8574). GPIO ISR service is installed, when it isn't yet.
+ *
+ * @param handle: IO Expander handle
+ * @param config: Notification configuration
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_INVALID_STATE: Notification already enabled
+ *      - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t esp_io_expander_enable_intr(esp_io_expander_handle_t handle, const esp_io_expander_intr_config_t *config);
+
+/**
+ * @brief Stop input change notification
+ *
+ * @note Don't call from the callback
+ *
+ * @param handle: IO Expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_disable_intr(esp_io_expander_handle_t handle);
+
+/**
+ * @brief Start the worker task of asynchronous output requests
+ *
+ * Level changes posted by `esp_io_expander_set_level_async` are written by the worker task, so the caller doesn't wait
+ * for the bus. Changes waiting in the queue are merged into one register write.
+ *
+ * @note Output levels of the async pins should not be changed by other functions at the same time
+ *
+ * @param handle: IO Expander handle
+ * @param config: Worker configuration
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_INVALID_STATE: Worker already started
+ *      - ESP_ERR_NO_MEM: Not enough memory
+ */
+esp_err_t esp_io_expander_async_start(esp_io_expander_handle_t handle, const esp_io_expander_async_config_t *config);
+
+/**
+ * @brief Write all posted requests and stop the worker task
+ *
+ * @param handle: IO Expander handle
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_async_stop(esp_io_expander_handle_t handle);
+
+/**
+ * @brief Post a level change of a set of target IOs without waiting for the bus
+ *
+ * @note Can be called from ISR
+ *
+ * @param handle: IO Expander handle
+ * @param pin_num_mask: Bitwise OR of allowed pin num with type of `esp_io_expander_pin_num_t`
+ * @param level: 0 - Low level, 1 - High level
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Worker not started
+ *      - ESP_ERR_TIMEOUT: Queue is full
+ */
+esp_err_t esp_io_expander_set_level_async(esp_io_expander_handle_t handle, uint32_t pin_num_mask, uint8_t level);
+
+/**
+ * @brief Wait until all requests posted before are written
+ *
+ * @param handle: IO Expander handle
+ * @param timeout_ms: Maximal wait (-1: wait forever)
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_STATE: Worker not started
+ *      - ESP_ERR_TIMEOUT: Requests not written in time
+ *      - Otherwise: Error of the first failed write since the last flush
+ */
+esp_err_t esp_io_expander_async_flush(esp_io_expander_handle_t handle, int timeout_ms);
+
 /**
  * @brief Print the current status of each IO of the device, including direction, input level and output level
  *
@@ -255,6 +506,22 @@ esp_err_t esp_io_expander_print_state(esp_io_expander_handle_t handle);
  */
 esp_err_t esp_io_expander_reset(esp_io_expander_handle_t handle);
 
+/**
+ * @brief Keep a copy of output and direction registers in RAM (write-through)
+ *
+ * With the copy, `esp_io_expander_set_level` and `esp_io_expander_set_dir` only write the register and check the direction in RAM.
+ * Useful for drivers which read the registers back from the device. The copy is reloaded after `esp_io_expander_reset`.
+ *
+ * @note The registers must not be changed by other means than this component (e.g. by the driver directly)
+ *
+ * @param handle: IO Expander handle
+ * @param enable: Enable or disable the copy
+ *
+ * @return
+ *      - ESP_OK: Success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_io_expander_set_shadow_regs(esp_io_expander_handle_t handle, bool enable);
+
 /**
  * @brief Delete device
  *
@@ -18,6 +18,7 @@
 #define I2C_CLK_SPEED           (400000)
 
 #define IO_COUNT                (8)
+#define SEQ_LEN_MAX             (32)    /* Output values of one I2C transaction */
 
 /* Default register value on power-up */
 #define DIR_REG_DEFAULT_VAL     (0xff)
@@ -40,6 +41,7 @@ static char *TAG = "ht8574";
 
 static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value);
 static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t write_output_seq(esp_io_expander_handle_t handle, const uint32_t *values, size_t count);
 static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value);
 static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value);
 static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
@@ -67,6 +69,7 @@ esp_err_t esp_io_expander_new_i2c_ht8574(i2c_master_bus_handle_t i2c_bus, uint32
     ht8574->base.config.flags.dir_out_bit_zero = 1;
     ht8574->base.read_input_reg = read_input_reg;
     ht8574->base.write_output_reg = write_output_reg;
+    ht8574->base.write_output_seq = write_output_seq;
     ht8574->base.read_output_reg = read_output_reg;
     ht8574->base.write_direction_reg = write_direction_reg;
     ht8574->base.read_direction_reg = read_direction_reg;
@@ -105,6 +108,25 @@ static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t valu
     return ESP_OK;
 }
 
+static esp_err_t write_output_seq(esp_io_expander_handle_t handle, const uint32_t *values, size_t count)
+{
+    esp_io_expander_ht8574_t *ht8574 = (esp_io_expander_ht8574_t *)__containerof(handle, esp_io_expander_ht8574_t, base);
+
+    /* Every data byte of one write is latched to the outputs */
+    uint8_t data[SEQ_LEN_MAX];
+    while (count > 0) {
+        const size_t len = (count < SEQ_LEN_MAX) ? count : SEQ_LEN_MAX;
+        for (size_t i = 0; i < len; i++) {
+            data[i] = values[i] & 0xff;
+        }
+        ESP_RETURN_ON_ERROR(i2c_master_transmit(ht8574->i2c_handle, data, len, I2C_TIMEOUT_MS), TAG, "Write output reg failed");
+        ht8574->regs.output = data[len - 1];
+        values += len;
+        count -= len;
+    }
+    return ESP_OK;
+}
+
 static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value)
 {
     esp_io_expander_ht8574_t *ht8574 = (esp_io_expander_ht8574_t *)__containerof(handle, esp_io_expander_ht8574_t, base);
@@ -18,6 +18,7 @@
 #define I2C_CLK_SPEED           (400000)
 
 #define IO_COUNT                (8)
+#define SEQ_LEN_MAX             (32)    /* Output values of one I2C transaction */
 
 /* Register address */
 #define INPUT_REG_ADDR          (0x00)
@@ -45,6 +46,7 @@ static char *TAG = "tca9554";
 
 static esp_err_t read_input_reg(esp_io_expander_handle_t handle, uint32_t *value);
 static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t value);
+static esp_err_t write_output_seq(esp_io_expander_handle_t handle, const uint32_t *values, size_t count);
 static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value);
 static esp_err_t write_direction_reg(esp_io_expander_handle_t handle, uint32_t value);
 static esp_err_t read_direction_reg(esp_io_expander_handle_t handle, uint32_t *value);
@@ -71,6 +73,7 @@ esp_err_t esp_io_expander_new_i2c_tca9554(i2c_master_bus_handle_t i2c_bus, uint3
     tca9554->base.config.flags.dir_out_bit_zero = 1;
     tca9554->base.read_input_reg = read_input_reg;
     tca9554->base.write_output_reg = write_output_reg;
+    tca9554->base.write_output_seq = write_output_seq;
     tca9554->base.read_output_reg = read_output_reg;
     tca9554->base.write_direction_reg = write_direction_reg;
     tca9554->base.read_direction_reg = read_direction_reg;
@@ -110,6 +113,25 @@ static esp_err_t write_output_reg(esp_io_expander_handle_t handle, uint32_t valu
     return ESP_OK;
 }
 
+static esp_err_t write_output_seq(esp_io_expander_handle_t handle, const uint32_t *values, size_t count)
+{
+    esp_io_expander_tca9554_t *tca9554 = (esp_io_expander_tca9554_t *)__containerof(handle, esp_io_expander_tca9554_t, base);
+
+    /* Output register is not auto-incremented, every data byte after the command byte is latched to the outputs */
+    uint8_t data[1 + SEQ_LEN_MAX] = {OUTPUT_REG_ADDR};
+    while (count > 0) {
+        const size_t len = (count < SEQ_LEN_MAX) ? count : SEQ_LEN_MAX;
+        for (size_t i = 0; i < len; i++) {
+            data[1 + i] = values[i] & 0xff;
+        }
+        ESP_RETURN_ON_ERROR(i2c_master_transmit(tca9554->i2c_handle, data, 1 + len, I2C_TIMEOUT_MS), TAG, "Write output reg failed");
+        tca9554->regs.output = data[len];
+        values += len;
+        count -= len;
+    }
+    return ESP_OK;
+}
+
 static esp_err_t read_output_reg(esp_io_expander_handle_t handle, uint32_t *value)
 {
     esp_io_expander_tca9554_t *tca9554 = (esp_io_expander_tca9554_t *)__containerof(handle, esp_io_expander_tca9554_t, base);
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -21,6 +21,16 @@
 
 static const char *TAG = "gc9a01";
 
+// Init timing of the datasheet, the delays run while other work is done
+#define GC9A01_RESET_CMD_DELAY_MS       (5)     // Reset to the next command
+#define GC9A01_RESET_SLPOUT_DELAY_MS    (20)    // Reset to LCD_CMD_SLPOUT
+#define GC9A01_SLPOUT_CMD_DELAY_MS      (5)     // LCD_CMD_SLPOUT to the next command
+#define GC9A01_SLPOUT_DISPON_DELAY_MS   (100)   // LCD_CMD_SLPOUT to LCD_CMD_DISPON
+
+// QSPI framing, the command is sent in the address phase after the opcode
+#define GC9A01_QSPI_OPCODE_WRITE_CMD    (0x02)
+#define GC9A01_QSPI_OPCODE_WRITE_COLOR  (0x32)
+
 static esp_err_t panel_gc9a01_del(esp_lcd_panel_t *panel);
 static esp_err_t panel_gc9a01_reset(esp_lcd_panel_t *panel);
 static esp_err_t panel_gc9a01_init(esp_lcd_panel_t *panel);
@@ -43,8 +53,21 @@ typedef struct {
     uint8_t colmod_val; // save current value of LCD_CMD_COLMOD register
     const gc9a01_lcd_init_cmd_t *init_cmds;
     uint16_t init_cmds_size;
+    TickType_t cmd_tick;    // Earliest time of the next init command
+    TickType_t slpout_tick; // Earliest time of LCD_CMD_SLPOUT after reset
+    TickType_t dispon_tick; // Earliest time of LCD_CMD_DISPON after LCD_CMD_SLPOUT
+    bool reset_pending;     // Reset timing applies to the next init
+    bool dispon_pending;    // Sleep out timing applies to the next LCD_CMD_DISPON
+    struct {
+        unsigned int use_qspi_interface: 1;
+    } flags;
 } gc9a01_panel_t;
 
+static void panel_gc9a01_wait_until(TickType_t tick);
+static esp_err_t panel_gc9a01_tx_param(gc9a01_panel_t *gc9a01, int cmd, const void *param, size_t param_size);
+static esp_err_t panel_gc9a01_tx_color(gc9a01_panel_t *gc9a01, int cmd, const void *color, size_t color_size);
+static esp_err_t panel_gc9a01_tx_init_cmd(gc9a01_panel_t *gc9a01, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms);
+
 esp_err_t esp_lcd_new_panel_gc9a01(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel)
 {
     esp_err_t ret = ESP_OK;
@@ -108,6 +131,7 @@ esp_err_t esp_lcd_new_panel_gc9a01(const esp_lcd_panel_io_handle_t io, const esp
     if (panel_dev_config->vendor_config) {
         gc9a01->init_cmds = ((gc9a01_vendor_config_t *)panel_dev_config->vendor_config)->init_cmds;
         gc9a01->init_cmds_size = ((gc9a01_vendor_config_t *)panel_dev_config->vendor_config)->init_cmds_size;
+        gc9a01->flags.use_qspi_interface = ((gc9a01_vendor_config_t *)panel_dev_config->vendor_config)->flags.use_qspi_interface;
     }
     gc9a01->base.del = panel_gc9a01_del;
     gc9a01->base.reset = panel_gc9a01_reset;
@@ -155,19 +179,73 @@ static esp_err_t panel_gc9a01_del(esp_lcd_panel_t *panel)
 static esp_err_t panel_gc9a01_reset(esp_lcd_panel_t *panel)
 {
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
-    esp_lcd_panel_io_handle_t io = gc9a01->io;
 
     // perform hardware reset
     if (gc9a01->reset_gpio_num >= 0) {
         gpio_set_level(gc9a01->reset_gpio_num, gc9a01->reset_level);
         vTaskDelay(pdMS_TO_TICKS(10));
         gpio_set_level(gc9a01->reset_gpio_num, !gc9a01->reset_level);
-        vTaskDelay(pdMS_TO_TICKS(10));
     } else { // perform software reset
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SWRESET, NULL, 0), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(20)); // spec, wait at least 5ms before sending new command
+        ESP_RETURN_ON_ERROR(panel_gc9a01_tx_param(gc9a01, LCD_CMD_SWRESET, NULL, 0), TAG, "send command failed");
+    }
+    // spec, wait before sending new command and before sleep out, init waits only for the rest
+    const TickType_t now = xTaskGetTickCount();
+    gc9a01->cmd_tick = now + pdMS_TO_TICKS(GC9A01_RESET_CMD_DELAY_MS);
+    gc9a01->slpout_tick = now + pdMS_TO_TICKS(GC9A01_RESET_SLPOUT_DELAY_MS);
+    gc9a01->reset_pending = true;
+
+    return ESP_OK;
+}
+
+static void panel_gc9a01_wait_until(TickType_t tick)
+{
+    const TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(tick - now) > 0) {
+        vTaskDelay(tick - now);
+    }
+}
+
+static esp_err_t panel_gc9a01_tx_param(gc9a01_panel_t *gc9a01, int cmd, const void *param, size_t param_size)
+{
+    if (gc9a01->flags.use_qspi_interface) {
+        cmd &= 0xff;
+        cmd <<= 8;
+        cmd |= GC9A01_QSPI_OPCODE_WRITE_CMD << 24;
     }
+    return esp_lcd_panel_io_tx_param(gc9a01->io, cmd, param, param_size);
+}
 
+static esp_err_t panel_gc9a01_tx_color(gc9a01_panel_t *gc9a01, int cmd, const void *color, size_t color_size)
+{
+    if (gc9a01->flags.use_qspi_interface) {
+        cmd &= 0xff;
+        cmd <<= 8;
+        cmd |= GC9A01_QSPI_OPCODE_WRITE_COLOR << 24;
+    }
+    return esp_lcd_panel_io_tx_color(gc9a01->io, cmd, color, color_size);
+}
+
+static esp_err_t panel_gc9a01_tx_init_cmd(gc9a01_panel_t *gc9a01, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms)
+{
+    panel_gc9a01_wait_until(gc9a01->cmd_tick);
+    if (cmd == LCD_CMD_SLPOUT) {
+        panel_gc9a01_wait_until(gc9a01->slpout_tick);
+    } else if ((cmd == LCD_CMD_DISPON) && gc9a01->dispon_pending) {
+        panel_gc9a01_wait_until(gc9a01->dispon_tick);
+        gc9a01->dispon_pending = false;
+    }
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_param(gc9a01, cmd, data, data_bytes), TAG, "send command failed");
+
+    // The delay is waited only before the next command
+    const TickType_t now = xTaskGetTickCount();
+    gc9a01->cmd_tick = now + pdMS_TO_TICKS(delay_ms);
+    if (cmd == LCD_CMD_SLPOUT) {
+        if (delay_ms < GC9A01_SLPOUT_CMD_DELAY_MS) {
+            gc9a01->cmd_tick = now + pdMS_TO_TICKS(GC9A01_SLPOUT_CMD_DELAY_MS);
+        }
+        gc9a01->dispon_tick = now + pdMS_TO_TICKS(GC9A01_SLPOUT_DISPON_DELAY_MS);
+        gc9a01->dispon_pending = true;
+    }
     return ESP_OK;
 }
 
@@ -222,17 +300,21 @@ static const gc9a01_lcd_init_cmd_t vendor_specific_init_default[] = {
 static esp_err_t panel_gc9a01_init(esp_lcd_panel_t *panel)
 {
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
-    esp_lcd_panel_io_handle_t io = gc9a01->io;
+
+    // Reset timing applies only right after panel_gc9a01_reset()
+    if (!gc9a01->reset_pending) {
+        gc9a01->cmd_tick = gc9a01->slpout_tick = xTaskGetTickCount();
+    }
+    gc9a01->reset_pending = false;
 
     // LCD goes into sleep mode and display will be turned off after power on reset, exit sleep mode first
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SLPOUT, NULL, 0), TAG, "send command failed");
-    vTaskDelay(pdMS_TO_TICKS(100));
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_init_cmd(gc9a01, LCD_CMD_SLPOUT, NULL, 0, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_init_cmd(gc9a01, LCD_CMD_MADCTL, (uint8_t[]) {
         gc9a01->madctl_val,
-    }, 1), TAG, "send command failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_COLMOD, (uint8_t[]) {
+    }, 1, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_init_cmd(gc9a01, LCD_CMD_COLMOD, (uint8_t[]) {
         gc9a01->colmod_val,
-    }, 1), TAG, "send command failed");
+    }, 1, 0), TAG, "send command failed");
 
     const gc9a01_lcd_init_cmd_t *init_cmds = NULL;
     uint16_t init_cmds_size = 0;
@@ -265,9 +347,11 @@ static esp_err_t panel_gc9a01_init(esp_lcd_panel_t *panel)
             ESP_LOGW(TAG, "The %02Xh command has been used and will be overwritten by external initialization sequence", init_cmds[i].cmd);
         }
 
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        ESP_RETURN_ON_ERROR(panel_gc9a01_tx_init_cmd(gc9a01, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes, init_cmds[i].delay_ms), TAG,
+                            "send command failed");
     }
+    // Delay of the last command
+    panel_gc9a01_wait_until(gc9a01->cmd_tick);
     ESP_LOGD(TAG, "send init commands success");
 
     return ESP_OK;
@@ -277,7 +361,6 @@ static esp_err_t panel_gc9a01_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
 {
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
     assert((x_start < x_end) && (y_start < y_end) && "start position must be smaller than end position");
-    esp_lcd_panel_io_handle_t io = gc9a01->io;
 
     x_start += gc9a01->x_gap;
     x_end += gc9a01->x_gap;
@@ -285,13 +368,13 @@ static esp_err_t panel_gc9a01_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
     y_end += gc9a01->y_gap;
 
     // define an area of frame memory where MCU can access
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_CASET, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_param(gc9a01, LCD_CMD_CASET, (uint8_t[]) {
         (x_start >> 8) & 0xFF,
         x_start & 0xFF,
         ((x_end - 1) >> 8) & 0xFF,
         (x_end - 1) & 0xFF,
     }, 4), TAG, "send command failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_RASET, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_param(gc9a01, LCD_CMD_RASET, (uint8_t[]) {
         (y_start >> 8) & 0xFF,
         y_start & 0xFF,
         ((y_end - 1) >> 8) & 0xFF,
@@ -299,7 +382,7 @@ static esp_err_t panel_gc9a01_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
     }, 4), TAG, "send command failed");
     // transfer frame buffer
     size_t len = (x_end - x_start) * (y_end - y_start) * gc9a01->fb_bits_per_pixel / 8;
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_color(io, LCD_CMD_RAMWR, color_data, len), TAG, "send color failed");
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_color(gc9a01, LCD_CMD_RAMWR, color_data, len), TAG, "send color failed");
 
     return ESP_OK;
 }
@@ -307,21 +390,19 @@ static esp_err_t panel_gc9a01_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
 static esp_err_t panel_gc9a01_invert_color(esp_lcd_panel_t *panel, bool invert_color_data)
 {
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
-    esp_lcd_panel_io_handle_t io = gc9a01->io;
     int command = 0;
     if (invert_color_data) {
         command = LCD_CMD_INVON;
     } else {
         command = LCD_CMD_INVOFF;
     }
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, command, NULL, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_param(gc9a01, command, NULL, 0), TAG, "send command failed");
     return ESP_OK;
 }
 
 static esp_err_t panel_gc9a01_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool mirror_y)
 {
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
-    esp_lcd_panel_io_handle_t io = gc9a01->io;
     if (mirror_x) {
         gc9a01->madctl_val |= LCD_CMD_MX_BIT;
     } else {
@@ -332,7 +413,7 @@ static esp_err_t panel_gc9a01_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool
     } else {
         gc9a01->madctl_val &= ~LCD_CMD_MY_BIT;
     }
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_param(gc9a01, LCD_CMD_MADCTL, (uint8_t[]) {
         gc9a01->madctl_val
     }, 1), TAG, "send command failed");
     return ESP_OK;
@@ -341,13 +422,12 @@ static esp_err_t panel_gc9a01_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool
 static esp_err_t panel_gc9a01_swap_xy(esp_lcd_panel_t *panel, bool swap_axes)
 {
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
-    esp_lcd_panel_io_handle_t io = gc9a01->io;
     if (swap_axes) {
         gc9a01->madctl_val |= LCD_CMD_MV_BIT;
     } else {
         gc9a01->madctl_val &= ~LCD_CMD_MV_BIT;
     }
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_param(gc9a01, LCD_CMD_MADCTL, (uint8_t[]) {
         gc9a01->madctl_val
     }, 1), TAG, "send command failed");
     return ESP_OK;
@@ -364,7 +444,6 @@ static esp_err_t panel_gc9a01_set_gap(esp_lcd_panel_t *panel, int x_gap, int y_g
 static esp_err_t panel_gc9a01_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
 {
     gc9a01_panel_t *gc9a01 = __containerof(panel, gc9a01_panel_t, base);
-    esp_lcd_panel_io_handle_t io = gc9a01->io;
     int command = 0;
 
 #if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
@@ -376,6 +455,11 @@ static esp_err_t panel_gc9a01_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
     } else {
         command = LCD_CMD_DISPOFF;
     }
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, command, NULL, 0), TAG, "send command failed");
+    // Sleep out must settle before display on
+    if ((command == LCD_CMD_DISPON) && gc9a01->dispon_pending) {
+        panel_gc9a01_wait_until(gc9a01->dispon_tick);
+        gc9a01->dispon_pending = false;
+    }
+    ESP_RETURN_ON_ERROR(panel_gc9a01_tx_param(gc9a01, command, NULL, 0), TAG, "send command failed");
     return ESP_OK;
 }
@@ -39,6 +39,10 @@ typedef struct {
                                                  *   Please refer to `vendor_specific_init_default` in source file.
                                                  */
     uint16_t init_cmds_size;                    /*<! Number of commands in above array */
+    struct {
+        unsigned int use_qspi_interface: 1;     /*<! Set to 1 if the panel IO is QSPI (`GC9A01_PANEL_IO_QSPI_CONFIG`), commands are
+                                                 *   framed by the 0x02 (command) and 0x32 (color) opcodes of QSPI modules */
+    } flags;
 } gc9a01_vendor_config_t;
 
 /**
@@ -104,6 +108,60 @@ esp_err_t esp_lcd_new_panel_gc9a01(const esp_lcd_panel_io_handle_t io, const esp
         .flags = {}                                                 \
     }
 
+/**
+ * @brief LCD panel bus configuration structure for QSPI modules
+ *
+ * @param[in] sclk SPI clock pin number
+ * @param[in] d0 SPI data 0 pin number
+ * @param[in] d1 SPI data 1 pin number
+ * @param[in] d2 SPI data 2 pin number
+ * @param[in] d3 SPI data 3 pin number
+ * @param[in] max_trans_sz Maximum transfer size in bytes
+ *
+ */
+#define GC9A01_PANEL_BUS_QSPI_CONFIG(sclk, d0, d1, d2, d3, max_trans_sz)    \
+    {                                                                       \
+        .data0_io_num = d0,                                                 \
+        .data1_io_num = d1,                                                 \
+        .sclk_io_num = sclk,                                                \
+        .data2_io_num = d2,                                                 \
+        .data3_io_num = d3,                                                 \
+        .data4_io_num = -1,                                                 \
+        .data5_io_num = -1,                                                 \
+        .data6_io_num = -1,                                                 \
+        .data7_io_num = -1,                                                 \
+        .max_transfer_sz = max_trans_sz,                                    \
+        .flags = 0,                                                         \
+        .isr_cpu_id = ESP_INTR_CPU_AFFINITY_AUTO,                           \
+        .intr_flags = 0                                                     \
+    }
+
+/**
+ * @brief LCD panel IO configuration structure for QSPI modules
+ *
+ * @note  The command is sent in the 32-bit address phase, so `flags.use_qspi_interface` of `gc9a01_vendor_config_t` must be set.
+ *
+ * @param[in] cs SPI chip select pin number
+ * @param[in] cb Callback function when SPI transfer is done
+ * @param[in] cb_ctx Callback function context
+ *
+ */
+#define GC9A01_PANEL_IO_QSPI_CONFIG(cs, callback, callback_ctx) \
+    {                                                           \
+        .cs_gpio_num = cs,                                      \
+        .dc_gpio_num = -1,                                      \
+        .spi_mode = 0,                                          \
+        .pclk_hz = 40 * 1000 * 1000,                            \
+        .trans_queue_depth = 10,                                \
+        .on_color_trans_done = callback,                        \
+        .user_ctx = callback_ctx,                               \
+        .lcd_cmd_bits = 32,                                     \
+        .lcd_param_bits = 8,                                    \
+        .flags = {                                              \
+            .quad_mode = true,                                  \
+        },                                                      \
+    }
+
 #ifdef __cplusplus
 }
 #endif
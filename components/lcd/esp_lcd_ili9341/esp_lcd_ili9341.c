@@ -21,6 +21,15 @@
 
 static const char *TAG = "ili9341";
 
+// Init timing of the datasheet, the delays run while other work is done
+#define ILI9341_RESET_CMD_DELAY_MS       (5)     // Reset to the next command
+#define ILI9341_RESET_SLPOUT_DELAY_MS    (20)    // Reset to LCD_CMD_SLPOUT
+#define ILI9341_SLPOUT_CMD_DELAY_MS      (5)     // LCD_CMD_SLPOUT to the next command
+#define ILI9341_SLPOUT_DISPON_DELAY_MS   (100)   // LCD_CMD_SLPOUT to LCD_CMD_DISPON
+
+// Lines of the frame memory, vertical scrolling area definition must cover all of them
+#define ILI9341_FRAME_MEMORY_LINES       (320)
+
 static esp_err_t panel_ili9341_del(esp_lcd_panel_t *panel);
 static esp_err_t panel_ili9341_reset(esp_lcd_panel_t *panel);
 static esp_err_t panel_ili9341_init(esp_lcd_panel_t *panel);
@@ -43,8 +52,16 @@ typedef struct {
     uint8_t colmod_val; // save current value of LCD_CMD_COLMOD register
     const ili9341_lcd_init_cmd_t *init_cmds;
     uint16_t init_cmds_size;
+    TickType_t cmd_tick;    // Earliest time of the next init command
+    TickType_t slpout_tick; // Earliest time of LCD_CMD_SLPOUT after reset
+    TickType_t dispon_tick; // Earliest time of LCD_CMD_DISPON after LCD_CMD_SLPOUT
+    bool reset_pending;     // Reset timing applies to the next init
+    bool dispon_pending;    // Sleep out timing applies to the next LCD_CMD_DISPON
 } ili9341_panel_t;
 
+static void panel_ili9341_wait_until(TickType_t tick);
+static esp_err_t panel_ili9341_tx_init_cmd(ili9341_panel_t *ili9341, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms);
+
 esp_err_t esp_lcd_new_panel_ili9341(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel)
 {
     esp_err_t ret = ESP_OK;
@@ -140,6 +157,89 @@ err:
     return ret;
 }
 
+esp_err_t esp_lcd_ili9341_set_scroll_area(esp_lcd_panel_handle_t panel, uint16_t top_fixed, uint16_t scroll_height)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ili9341_del, ESP_ERR_INVALID_ARG, TAG, "invalid ili9341 panel");
+    ili9341_panel_t *ili9341 = __containerof(panel, ili9341_panel_t, base);
+    const int top = top_fixed + ili9341->y_gap;
+    ESP_RETURN_ON_FALSE(scroll_height > 0 && top + scroll_height <= ILI9341_FRAME_MEMORY_LINES, ESP_ERR_INVALID_ARG, TAG,
+                        "scroll area out of frame memory");
+
+    // Top fixed area, vertical scrolling area and bottom fixed area, sum must be the lines of frame memory
+    const int bottom = ILI9341_FRAME_MEMORY_LINES - top - scroll_height;
+    return esp_lcd_panel_io_tx_param(ili9341->io, LCD_CMD_VSCRDEF, (uint8_t[]) {
+        (top >> 8) & 0xFF, top & 0xFF,
+        (scroll_height >> 8) & 0xFF, scroll_height & 0xFF,
+        (bottom >> 8) & 0xFF, bottom & 0xFF,
+    }, 6);
+}
+
+esp_err_t esp_lcd_ili9341_set_scroll_start(esp_lcd_panel_handle_t panel, uint16_t line)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ili9341_del, ESP_ERR_INVALID_ARG, TAG, "invalid ili9341 panel");
+    ili9341_panel_t *ili9341 = __containerof(panel, ili9341_panel_t, base);
+    const int start = line + ili9341->y_gap;
+    ESP_RETURN_ON_FALSE(start < ILI9341_FRAME_MEMORY_LINES, ESP_ERR_INVALID_ARG, TAG, "scroll start out of frame memory");
+
+    return esp_lcd_panel_io_tx_param(ili9341->io, LCD_CMD_VSCSAD, (uint8_t[]) {
+        (start >> 8) & 0xFF, start & 0xFF,
+    }, 2);
+}
+
+esp_err_t esp_lcd_ili9341_set_bits_per_pixel(esp_lcd_panel_handle_t panel, uint8_t bits_per_pixel)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ili9341_del, ESP_ERR_INVALID_ARG, TAG, "invalid ili9341 panel");
+    ili9341_panel_t *ili9341 = __containerof(panel, ili9341_panel_t, base);
+    uint8_t colmod_val;
+    uint8_t fb_bits_per_pixel;
+    switch (bits_per_pixel) {
+    case 16: // RGB565
+        colmod_val = 0x55;
+        fb_bits_per_pixel = 16;
+        break;
+    case 18: // RGB666, 3 bytes per pixel
+        colmod_val = 0x66;
+        fb_bits_per_pixel = 24;
+        break;
+    default:
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, TAG, "unsupported pixel width");
+    }
+
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(ili9341->io, LCD_CMD_COLMOD, (uint8_t[]) {
+        colmod_val,
+    }, 1), TAG, "send command failed");
+    ili9341->colmod_val = colmod_val;
+    ili9341->fb_bits_per_pixel = fb_bits_per_pixel;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_ili9341_set_idle_mode(esp_lcd_panel_handle_t panel, bool enable)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ili9341_del, ESP_ERR_INVALID_ARG, TAG, "invalid ili9341 panel");
+    ili9341_panel_t *ili9341 = __containerof(panel, ili9341_panel_t, base);
+
+    return esp_lcd_panel_io_tx_param(ili9341->io, enable ? LCD_CMD_IDMON : LCD_CMD_IDMOFF, NULL, 0);
+}
+
+esp_err_t esp_lcd_ili9341_set_partial_area(esp_lcd_panel_handle_t panel, uint16_t start_line, uint16_t lines)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ili9341_del, ESP_ERR_INVALID_ARG, TAG, "invalid ili9341 panel");
+    ili9341_panel_t *ili9341 = __containerof(panel, ili9341_panel_t, base);
+    if (lines == 0) {
+        return esp_lcd_panel_io_tx_param(ili9341->io, LCD_CMD_NORON, NULL, 0);
+    }
+
+    const int start = start_line + ili9341->y_gap;
+    const int end = start + lines - 1;
+    ESP_RETURN_ON_FALSE(end < ILI9341_FRAME_MEMORY_LINES, ESP_ERR_INVALID_ARG, TAG, "partial area out of frame memory");
+    // Lines out of the area are not driven (shown in the color of the non-display area), frame memory is kept
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(ili9341->io, LCD_CMD_PTLAR, (uint8_t[]) {
+        (start >> 8) & 0xFF, start & 0xFF,
+        (end >> 8) & 0xFF, end & 0xFF,
+    }, 4), TAG, "send command failed");
+    return esp_lcd_panel_io_tx_param(ili9341->io, LCD_CMD_PTLON, NULL, 0);
+}
+
 static esp_err_t panel_ili9341_del(esp_lcd_panel_t *panel)
 {
     ili9341_panel_t *ili9341 = __containerof(panel, ili9341_panel_t, base);
@@ -162,12 +262,47 @@ static esp_err_t panel_ili9341_reset(esp_lcd_panel_t *panel)
         gpio_set_level(ili9341->reset_gpio_num, ili9341->reset_level);
         vTaskDelay(pdMS_TO_TICKS(10));
         gpio_set_level(ili9341->reset_gpio_num, !ili9341->reset_level);
-        vTaskDelay(pdMS_TO_TICKS(10));
     } else { // perform software reset
         ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SWRESET, NULL, 0), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(20)); // spec, wait at least 5ms before sending new command
     }
+    // spec, wait before sending new command and before sleep out, init waits only for the rest
+    const TickType_t now = xTaskGetTickCount();
+    ili9341->cmd_tick = now + pdMS_TO_TICKS(ILI9341_RESET_CMD_DELAY_MS);
+    ili9341->slpout_tick = now + pdMS_TO_TICKS(ILI9341_RESET_SLPOUT_DELAY_MS);
+    ili9341->reset_pending = true;
+
+    return ESP_OK;
+}
+
+static void panel_ili9341_wait_until(TickType_t tick)
+{
+    const TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(tick - now) > 0) {
+        vTaskDelay(tick - now);
+    }
+}
 
+static esp_err_t panel_ili9341_tx_init_cmd(ili9341_panel_t *ili9341, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms)
+{
+    panel_ili9341_wait_until(ili9341->cmd_tick);
+    if (cmd == LCD_CMD_SLPOUT) {
+        panel_ili9341_wait_until(ili9341->slpout_tick);
+    } else if ((cmd == LCD_CMD_DISPON) && ili9341->dispon_pending) {
+        panel_ili9341_wait_until(ili9341->dispon_tick);
+        ili9341->dispon_pending = false;
+    }
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(ili9341->io, cmd, data, data_bytes), TAG, "send command failed");
+
+    // The delay is waited only before the next command
+    const TickType_t now = xTaskGetTickCount();
+    ili9341->cmd_tick = now + pdMS_TO_TICKS(delay_ms);
+    if (cmd == LCD_CMD_SLPOUT) {
+        if (delay_ms < ILI9341_SLPOUT_CMD_DELAY_MS) {
+            ili9341->cmd_tick = now + pdMS_TO_TICKS(ILI9341_SLPOUT_CMD_DELAY_MS);
+        }
+        ili9341->dispon_tick = now + pdMS_TO_TICKS(ILI9341_SLPOUT_DISPON_DELAY_MS);
+        ili9341->dispon_pending = true;
+    }
     return ESP_OK;
 }
 
@@ -222,17 +357,21 @@ static const ili9341_lcd_init_cmd_t vendor_specific_init_default[] = {
 static esp_err_t panel_ili9341_init(esp_lcd_panel_t *panel)
 {
     ili9341_panel_t *ili9341 = __containerof(panel, ili9341_panel_t, base);
-    esp_lcd_panel_io_handle_t io = ili9341->io;
+
+    // Reset timing applies only right after panel_ili9341_reset()
+    if (!ili9341->reset_pending) {
+        ili9341->cmd_tick = ili9341->slpout_tick = xTaskGetTickCount();
+    }
+    ili9341->reset_pending = false;
 
     // LCD goes into sleep mode and display will be turned off after power on reset, exit sleep mode first
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SLPOUT, NULL, 0), TAG, "send command failed");
-    vTaskDelay(pdMS_TO_TICKS(100));
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_ili9341_tx_init_cmd(ili9341, LCD_CMD_SLPOUT, NULL, 0, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_ili9341_tx_init_cmd(ili9341, LCD_CMD_MADCTL, (uint8_t[]) {
         ili9341->madctl_val,
-    }, 1), TAG, "send command failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_COLMOD, (uint8_t[]) {
+    }, 1, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_ili9341_tx_init_cmd(ili9341, LCD_CMD_COLMOD, (uint8_t[]) {
         ili9341->colmod_val,
-    }, 1), TAG, "send command failed");
+    }, 1, 0), TAG, "send command failed");
 
     const ili9341_lcd_init_cmd_t *init_cmds = NULL;
     uint16_t init_cmds_size = 0;
@@ -265,9 +404,11 @@ static esp_err_t panel_ili9341_init(esp_lcd_panel_t *panel)
             ESP_LOGW(TAG, "The %02Xh command has been used and will be overwritten by external initialization sequence", init_cmds[i].cmd);
         }
 
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        ESP_RETURN_ON_ERROR(panel_ili9341_tx_init_cmd(ili9341, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes, init_cmds[i].delay_ms), TAG,
+                            "send command failed");
     }
+    // Delay of the last command
+    panel_ili9341_wait_until(ili9341->cmd_tick);
     ESP_LOGD(TAG, "send init commands success");
 
     return ESP_OK;
@@ -376,6 +517,11 @@ static esp_err_t panel_ili9341_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
     } else {
         command = LCD_CMD_DISPOFF;
     }
+    // Sleep out must settle before display on
+    if ((command == LCD_CMD_DISPON) && ili9341->dispon_pending) {
+        panel_ili9341_wait_until(ili9341->dispon_tick);
+        ili9341->dispon_pending = false;
+    }
     ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, command, NULL, 0), TAG, "send command failed");
     return ESP_OK;
 }
@@ -56,6 +56,82 @@ typedef struct {
  */
 esp_err_t esp_lcd_new_panel_ili9341(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel);
 
+/**
+ * @brief Define vertical scrolling area (hardware scroll)
+ *
+ * Lines above the area (top fixed area) and below it (bottom fixed area) do not move. Lines are counted in the vertical
+ * direction of the frame memory (320 lines), so hardware scroll is vertical only without swapped axes (`swap_xy`).
+ *
+ * @param[in] panel LCD panel handle of ILI9341
+ * @param[in] top_fixed Lines of top fixed area
+ * @param[in] scroll_height Lines of vertical scrolling area
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the area does not fit the frame memory or the panel is not ILI9341
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ili9341_set_scroll_area(esp_lcd_panel_handle_t panel, uint16_t top_fixed, uint16_t scroll_height);
+
+/**
+ * @brief Set the line of frame memory shown at the top of vertical scrolling area
+ *
+ * The scrolling area shows the memory from this line to its end and then from its start (wraps around).
+ * Setting `top_fixed` of `esp_lcd_ili9341_set_scroll_area()` shows the memory without scroll.
+ *
+ * @param[in] panel LCD panel handle of ILI9341
+ * @param[in] line Line of frame memory (in the vertical scrolling area)
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the line is out of frame memory or the panel is not ILI9341
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ili9341_set_scroll_start(esp_lcd_panel_handle_t panel, uint16_t line);
+
+/**
+ * @brief Change pixel format of the interface (COLMOD) in runtime
+ *
+ * Pixels of 18 and 24 bits take 3 bytes of `esp_lcd_panel_draw_bitmap()` data (red, green, blue; RGB666 in the 6 high bits
+ * of each byte), so they take 1.5 times longer to transfer than RGB565. Content of the frame memory is kept.
+ *
+ * @note Call it only when no `esp_lcd_panel_draw_bitmap()` transfer is in progress.
+ *
+ * @param[in] panel LCD panel handle of ILI9341
+ * @param[in] bits_per_pixel 16 (RGB565) or 18 (RGB666)
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the panel is not ILI9341
+ *          - ESP_ERR_NOT_SUPPORTED if the pixel width is not supported
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ili9341_set_bits_per_pixel(esp_lcd_panel_handle_t panel, uint8_t bits_per_pixel);
+
+/**
+ * @brief Turn Idle Mode (8 colors) on or off
+ *
+ * In Idle Mode, only the most significant bit of each color channel is shown (black, white, red, green, blue, cyan,
+ * magenta and yellow) and the panel takes less power. Content of the frame memory is kept, so the full colors
+ * come back after turning it off.
+ *
+ * @param[in] panel LCD panel handle of ILI9341
+ * @param[in] enable true to turn Idle Mode on
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the panel is not ILI9341
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ili9341_set_idle_mode(esp_lcd_panel_handle_t panel, bool enable);
+
+/**
+ * @brief Show only a band of lines (Partial Mode)
+ *
+ * Lines out of the area are not driven, they show the color of the non-display area (usually black) and the panel takes
+ * less power. Lines are counted in the vertical direction of the frame memory (320 lines), same as in hardware scroll.
+ *
+ * @param[in] panel LCD panel handle of ILI9341
+ * @param[in] start_line First line of the shown area
+ * @param[in] lines Lines of the shown area (0: Normal Mode, all lines are shown)
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the area is out of frame memory or the panel is not ILI9341
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ili9341_set_partial_area(esp_lcd_panel_handle_t panel, uint16_t start_line, uint16_t lines);
+
 /**
  * @brief LCD panel bus configuration structure
  *
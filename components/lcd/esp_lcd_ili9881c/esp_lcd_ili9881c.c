@@ -7,6 +7,7 @@
 #include "soc/soc_caps.h"
 
 #if SOC_MIPI_DSI_SUPPORTED
+#include <inttypes.h>
 #include "esp_check.h"
 #include "esp_log.h"
 #include "esp_lcd_panel_commands.h"
@@ -35,6 +36,12 @@
 #define ILI9881C_CMD_GS_BIT       (1 << 0)
 #define ILI9881C_CMD_SS_BIT       (1 << 1)
 
+// Init timing of the datasheet, the delays run while the following commands are sent
+#define ILI9881C_HW_RESET_CMD_DELAY_MS  (10)    // Hardware reset to the next command
+#define ILI9881C_SW_RESET_CMD_DELAY_MS  (20)    // Software reset to the next command
+#define ILI9881C_SLPOUT_CMD_DELAY_MS    (5)     // LCD_CMD_SLPOUT to the next command
+#define ILI9881C_SLPOUT_DISPON_DELAY_MS (120)   // LCD_CMD_SLPOUT to LCD_CMD_DISPON
+
 typedef struct {
     esp_lcd_panel_io_handle_t io;
     int reset_gpio_num;
@@ -43,8 +50,12 @@ typedef struct {
     const ili9881c_lcd_init_cmd_t *init_cmds;
     uint16_t init_cmds_size;
     uint8_t lane_num;
+    TickType_t cmd_tick;    // Earliest time of the next init command
+    TickType_t dispon_tick; // Earliest time of LCD_CMD_DISPON after LCD_CMD_SLPOUT
     struct {
         unsigned int reset_level: 1;
+        unsigned int reset_pending: 1;  // Reset timing applies to the next init
+        unsigned int dispon_pending: 1; // Sleep out timing applies to the next LCD_CMD_DISPON
     } flags;
     // To save the original functions of MIPI DPI panel
     esp_err_t (*del)(esp_lcd_panel_t *panel);
@@ -60,6 +71,8 @@ static esp_err_t panel_ili9881c_invert_color(esp_lcd_panel_t *panel, bool invert
 static esp_err_t panel_ili9881c_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool mirror_y);
 static esp_err_t panel_ili9881c_disp_on_off(esp_lcd_panel_t *panel, bool on_off);
 static esp_err_t panel_ili9881c_sleep(esp_lcd_panel_t *panel, bool sleep);
+static void panel_ili9881c_wait_until(TickType_t tick);
+static esp_err_t panel_ili9881c_tx_init_cmd(ili9881c_panel_t *ili9881c, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms);
 
 esp_err_t esp_lcd_new_panel_ili9881c(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config,
                                      esp_lcd_panel_handle_t *ret_panel)
@@ -387,36 +400,42 @@ static esp_err_t panel_ili9881c_init(esp_lcd_panel_t *panel)
         return ESP_ERR_INVALID_ARG;
     }
 
+    // Reset timing applies only right after panel_ili9881c_reset()
+    const TickType_t start_tick = xTaskGetTickCount();
+    if (!ili9881c->flags.reset_pending) {
+        ili9881c->cmd_tick = start_tick;
+    }
+    ili9881c->flags.reset_pending = false;
+
     // The ID register is on the CMD_Page 1
     uint8_t ID1, ID2, ID3;
-    esp_lcd_panel_io_tx_param(io, ILI9881C_CMD_CNDBKxSEL, (uint8_t[]) {
+    panel_ili9881c_tx_init_cmd(ili9881c, ILI9881C_CMD_CNDBKxSEL, (uint8_t[]) {
         ILI9881C_CMD_BKxSEL_BYTE0, ILI9881C_CMD_BKxSEL_BYTE1, ILI9881C_CMD_BKxSEL_BYTE2_PAGE1
-    }, 3);
+    }, 3, 0);
     esp_lcd_panel_io_rx_param(io, 0x00, &ID1, 1);
     esp_lcd_panel_io_rx_param(io, 0x01, &ID2, 1);
     esp_lcd_panel_io_rx_param(io, 0x02, &ID3, 1);
     ESP_LOGI(TAG, "ID1: 0x%x, ID2: 0x%x, ID3: 0x%x", ID1, ID2, ID3);
 
     // For modifying MIPI-DSI lane settings
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, ILI9881C_PAD_CONTROL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_ili9881c_tx_init_cmd(ili9881c, ILI9881C_PAD_CONTROL, (uint8_t[]) {
         lane_command,
-    }, 1), TAG, "send command failed");
+    }, 1, 0), TAG, "send command failed");
 
     // back to CMD_Page 0
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, ILI9881C_CMD_CNDBKxSEL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_ili9881c_tx_init_cmd(ili9881c, ILI9881C_CMD_CNDBKxSEL, (uint8_t[]) {
         ILI9881C_CMD_BKxSEL_BYTE0, ILI9881C_CMD_BKxSEL_BYTE1, ILI9881C_CMD_BKxSEL_BYTE2_PAGE0
-    }, 3), TAG, "send command failed");
-    // exit sleep mode
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SLPOUT, NULL, 0), TAG,
+    }, 3, 0), TAG, "send command failed");
+    // exit sleep mode, the settling time runs while the init table is sent (it is waited before LCD_CMD_DISPON)
+    ESP_RETURN_ON_ERROR(panel_ili9881c_tx_init_cmd(ili9881c, LCD_CMD_SLPOUT, NULL, 0, 0), TAG,
                         "io tx param failed");
-    vTaskDelay(pdMS_TO_TICKS(120));
 
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_ili9881c_tx_init_cmd(ili9881c, LCD_CMD_MADCTL, (uint8_t[]) {
         ili9881c->madctl_val,
-    }, 1), TAG, "send command failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_COLMOD, (uint8_t[]) {
+    }, 1, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_ili9881c_tx_init_cmd(ili9881c, LCD_CMD_COLMOD, (uint8_t[]) {
         ili9881c->colmod_val,
-    }, 1), TAG, "send command failed");
+    }, 1, 0), TAG, "send command failed");
 
     // vendor specific initialization, it can be different between manufacturers
     // should consult the LCD supplier for initialization sequence code
@@ -453,8 +472,8 @@ static esp_err_t panel_ili9881c_init(esp_lcd_panel_t *panel)
         }
 
         // Send command
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        ESP_RETURN_ON_ERROR(panel_ili9881c_tx_init_cmd(ili9881c, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes,
+                            init_cmds[i].delay_ms), TAG, "send command failed");
 
         if ((init_cmds[i].cmd == ILI9881C_CMD_CNDBKxSEL) && (((uint8_t *)init_cmds[i].data)[2] == ILI9881C_CMD_BKxSEL_BYTE2_PAGE0)) {
             is_command0_enable = true;
@@ -462,7 +481,9 @@ static esp_err_t panel_ili9881c_init(esp_lcd_panel_t *panel)
             is_command0_enable = false;
         }
     }
-    ESP_LOGD(TAG, "send init commands success");
+    // Display is turned on by the application, the rest of the table delay is waited as well
+    panel_ili9881c_wait_until(ili9881c->cmd_tick);
+    ESP_LOGD(TAG, "send init commands success (%"PRIu32" ms)", (uint32_t)pdTICKS_TO_MS(xTaskGetTickCount() - start_tick));
 
     ESP_RETURN_ON_ERROR(ili9881c->init(panel), TAG, "init MIPI DPI panel failed");
 
@@ -479,15 +500,47 @@ static esp_err_t panel_ili9881c_reset(esp_lcd_panel_t *panel)
         gpio_set_level(ili9881c->reset_gpio_num, ili9881c->flags.reset_level);
         vTaskDelay(pdMS_TO_TICKS(10));
         gpio_set_level(ili9881c->reset_gpio_num, !ili9881c->flags.reset_level);
-        vTaskDelay(pdMS_TO_TICKS(10));
+        ili9881c->cmd_tick = xTaskGetTickCount() + pdMS_TO_TICKS(ILI9881C_HW_RESET_CMD_DELAY_MS);
+        ili9881c->flags.reset_pending = true;
     } else if (io) { // Perform software reset
         ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SWRESET, NULL, 0), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(20));
+        ili9881c->cmd_tick = xTaskGetTickCount() + pdMS_TO_TICKS(ILI9881C_SW_RESET_CMD_DELAY_MS);
+        ili9881c->flags.reset_pending = true;
     }
 
     return ESP_OK;
 }
 
+static void panel_ili9881c_wait_until(TickType_t tick)
+{
+    const TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(tick - now) > 0) {
+        vTaskDelay(tick - now);
+    }
+}
+
+static esp_err_t panel_ili9881c_tx_init_cmd(ili9881c_panel_t *ili9881c, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms)
+{
+    panel_ili9881c_wait_until(ili9881c->cmd_tick);
+    if ((cmd == LCD_CMD_DISPON) && ili9881c->flags.dispon_pending) {
+        panel_ili9881c_wait_until(ili9881c->dispon_tick);
+        ili9881c->flags.dispon_pending = false;
+    }
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(ili9881c->io, cmd, data, data_bytes), TAG, "send command failed");
+
+    // The delay is waited only before the next command, no yield per command of long tables
+    const TickType_t now = xTaskGetTickCount();
+    ili9881c->cmd_tick = now + pdMS_TO_TICKS(delay_ms);
+    if (cmd == LCD_CMD_SLPOUT) {
+        if (delay_ms < ILI9881C_SLPOUT_CMD_DELAY_MS) {
+            ili9881c->cmd_tick = now + pdMS_TO_TICKS(ILI9881C_SLPOUT_CMD_DELAY_MS);
+        }
+        ili9881c->dispon_tick = now + pdMS_TO_TICKS(ILI9881C_SLPOUT_DISPON_DELAY_MS);
+        ili9881c->flags.dispon_pending = true;
+    }
+    return ESP_OK;
+}
+
 static esp_err_t panel_ili9881c_invert_color(esp_lcd_panel_t *panel, bool invert_color_data)
 {
     ili9881c_panel_t *ili9881c = (ili9881c_panel_t *)panel->user_data;
@@ -542,6 +595,11 @@ static esp_err_t panel_ili9881c_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
 
     if (on_off) {
         command = LCD_CMD_DISPON;
+        // Sleep out settling of init, when the init table does not turn on the display
+        if (ili9881c->flags.dispon_pending) {
+            panel_ili9881c_wait_until(ili9881c->dispon_tick);
+            ili9881c->flags.dispon_pending = false;
+        }
     } else {
         command = LCD_CMD_DISPOFF;
     }
@@ -32,7 +32,11 @@ static esp_err_t panel_lt8912b_disp_on_off(esp_lcd_panel_t *panel, bool off);
 static esp_err_t panel_lt8912b_sleep(esp_lcd_panel_t *panel, bool sleep);
 
 static esp_err_t _panel_lt8912b_detect_input_mipi(esp_lcd_panel_t *panel);
+static esp_err_t _panel_lt8912b_send_video_setup(esp_lcd_panel_t *panel);
+static esp_err_t _panel_lt8912b_send_avi_infoframe(esp_lcd_panel_t *panel);
+static esp_err_t _panel_lt8912b_mipi_rx_logic_reset(esp_lcd_panel_io_handle_t io_main);
 static bool _panel_lt8912b_get_hpd(esp_lcd_panel_t *panel);
+static esp_err_t _panel_lt8912b_hdmi_output(esp_lcd_panel_io_handle_t io_main, bool on);
 
 typedef struct {
     esp_lcd_panel_lt8912b_io_t io;
@@ -43,6 +47,14 @@ typedef struct {
     // To save the original functions of MIPI DPI panel
     esp_err_t (*del)(esp_lcd_panel_t *panel);
     esp_err_t (*init)(esp_lcd_panel_t *panel);
+    // HPD monitor
+    struct {
+        esp_lcd_panel_t *panel;
+        esp_lcd_panel_lt8912b_hpd_config_t config;
+        TaskHandle_t task;
+        volatile bool stop;
+        bool connected;
+    } hpd;
 } lt8912b_panel_t;
 
 typedef struct {
@@ -247,10 +259,158 @@ bool esp_lcd_panel_lt8912b_is_ready(esp_lcd_panel_t *panel)
     return _panel_lt8912b_get_hpd(panel);
 }
 
+esp_err_t esp_lcd_panel_lt8912b_set_video_timing(esp_lcd_panel_t *panel, const esp_lcd_panel_lt8912b_video_timing_t *video_timing)
+{
+    ESP_RETURN_ON_FALSE(panel && video_timing && panel->del == panel_lt8912b_del, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lt8912b_panel_t *lt8912b = (lt8912b_panel_t *)panel->user_data;
+
+    memcpy(&lt8912b->video_timing, video_timing, sizeof(esp_lcd_panel_lt8912b_video_timing_t));
+
+    /* Only the timing of MIPI input and HDMI output, clocks and analog parts stay configured */
+    ESP_RETURN_ON_ERROR(_panel_lt8912b_send_video_setup(panel), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(_panel_lt8912b_send_avi_infoframe(panel), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(_panel_lt8912b_mipi_rx_logic_reset(lt8912b->io.main), TAG, "send command failed");
+
+    return ESP_OK;
+}
+
+static void IRAM_ATTR _panel_lt8912b_hpd_isr(void *arg)
+{
+    lt8912b_panel_t *lt8912b = (lt8912b_panel_t *)arg;
+    BaseType_t need_yield = pdFALSE;
+
+    if (lt8912b->hpd.task) {
+        vTaskNotifyGiveFromISR(lt8912b->hpd.task, &need_yield);
+    }
+    portYIELD_FROM_ISR(need_yield);
+}
+
+static esp_err_t _panel_lt8912b_hpd_changed(lt8912b_panel_t *lt8912b, bool connected)
+{
+    esp_lcd_panel_t *panel = lt8912b->hpd.panel;
+    esp_lcd_panel_io_handle_t io_main = lt8912b->io.main;
+
+    if (connected) {
+        /* Fast re-init: the sink needs a new infoframe and TMDS, the rest of the bridge stays configured */
+        if (lt8912b->hpd.config.flags.pause_dpi) {
+            ESP_RETURN_ON_ERROR(esp_lcd_dpi_panel_set_pattern(panel, MIPI_DSI_PATTERN_NONE), TAG, "resume DPI failed");
+        }
+        ESP_RETURN_ON_ERROR(_panel_lt8912b_send_avi_infoframe(panel), TAG, "send command failed");
+        ESP_RETURN_ON_ERROR(_panel_lt8912b_mipi_rx_logic_reset(io_main), TAG, "send command failed");
+        ESP_RETURN_ON_ERROR(_panel_lt8912b_hdmi_output(io_main, true), TAG, "send command failed");
+    } else {
+        ESP_RETURN_ON_ERROR(_panel_lt8912b_hdmi_output(io_main, false), TAG, "send command failed");
+        if (lt8912b->hpd.config.flags.pause_dpi) {
+            /* The pattern generator feeds the DSI bridge, so the frame buffer is not read from PSRAM */
+            ESP_RETURN_ON_ERROR(esp_lcd_dpi_panel_set_pattern(panel, MIPI_DSI_PATTERN_BAR_VERTICAL), TAG, "pause DPI failed");
+        }
+    }
+
+    return ESP_OK;
+}
+
+static void _panel_lt8912b_hpd_task(void *arg)
+{
+    lt8912b_panel_t *lt8912b = (lt8912b_panel_t *)arg;
+    const esp_lcd_panel_lt8912b_hpd_config_t *config = &lt8912b->hpd.config;
+
+    while (!lt8912b->hpd.stop) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(config->poll_period_ms));
+        if (lt8912b->hpd.stop) {
+            break;
+        }
+
+        bool connected = _panel_lt8912b_get_hpd(lt8912b->hpd.panel);
+        if (connected == lt8912b->hpd.connected) {
+            continue;
+        }
+        /* Debounce: the HPD toggles while the connector is being inserted */
+        vTaskDelay(pdMS_TO_TICKS(config->debounce_ms));
+        if (_panel_lt8912b_get_hpd(lt8912b->hpd.panel) != connected || lt8912b->hpd.stop) {
+            continue;
+        }
+
+        ESP_LOGI(TAG, "HDMI %s", connected ? "connected" : "disconnected");
+        if (_panel_lt8912b_hpd_changed(lt8912b, connected) != ESP_OK) {
+            /* Keep the old state and try again in the next period */
+            continue;
+        }
+        lt8912b->hpd.connected = connected;
+        if (config->on_change) {
+            config->on_change(lt8912b->hpd.panel, connected, config->user_ctx);
+        }
+    }
+
+    lt8912b->hpd.task = NULL;
+    vTaskDelete(NULL);
+}
+
+esp_err_t esp_lcd_panel_lt8912b_hpd_monitor_start(esp_lcd_panel_t *panel, const esp_lcd_panel_lt8912b_hpd_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(panel && config && panel->del == panel_lt8912b_del, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->poll_period_ms > 0, ESP_ERR_INVALID_ARG, TAG, "invalid poll period");
+    lt8912b_panel_t *lt8912b = (lt8912b_panel_t *)panel->user_data;
+    ESP_RETURN_ON_FALSE(lt8912b->hpd.task == NULL, ESP_ERR_INVALID_STATE, TAG, "HPD monitor already started");
+
+    esp_err_t ret = ESP_OK;
+    memcpy(&lt8912b->hpd.config, config, sizeof(esp_lcd_panel_lt8912b_hpd_config_t));
+    lt8912b->hpd.panel = panel;
+    lt8912b->hpd.stop = false;
+    /* The panel was initialized with HDMI output enabled, the first poll handles a missing monitor */
+    lt8912b->hpd.connected = true;
+
+    BaseType_t res = xTaskCreate(_panel_lt8912b_hpd_task, "lt8912b_hpd", config->task.stack_size, lt8912b,
+                                 config->task.priority, &lt8912b->hpd.task);
+    ESP_RETURN_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, TAG, "create HPD task failed");
+
+    if (config->hpd_gpio_num >= 0) {
+        const gpio_config_t io_conf = {
+            .mode = GPIO_MODE_INPUT,
+            .pin_bit_mask = 1ULL << config->hpd_gpio_num,
+            .intr_type = GPIO_INTR_ANYEDGE,
+        };
+        ESP_GOTO_ON_ERROR(gpio_config(&io_conf), err, TAG, "configure GPIO for HPD failed");
+        ret = gpio_install_isr_service(0);
+        /* The ISR service may be already installed by the application */
+        ESP_GOTO_ON_FALSE(ret == ESP_OK || ret == ESP_ERR_INVALID_STATE, ret, err, TAG, "install GPIO ISR service failed");
+        ESP_GOTO_ON_ERROR(gpio_isr_handler_add(config->hpd_gpio_num, _panel_lt8912b_hpd_isr, lt8912b), err, TAG,
+                          "add HPD ISR handler failed");
+    }
+
+    return ESP_OK;
+
+err:
+    esp_lcd_panel_lt8912b_hpd_monitor_stop(panel);
+    return ret;
+}
+
+esp_err_t esp_lcd_panel_lt8912b_hpd_monitor_stop(esp_lcd_panel_t *panel)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_lt8912b_del, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    lt8912b_panel_t *lt8912b = (lt8912b_panel_t *)panel->user_data;
+
+    if (lt8912b->hpd.task == NULL) {
+        return ESP_OK;
+    }
+    if (lt8912b->hpd.config.hpd_gpio_num >= 0) {
+        gpio_isr_handler_remove(lt8912b->hpd.config.hpd_gpio_num);
+        gpio_reset_pin(lt8912b->hpd.config.hpd_gpio_num);
+    }
+
+    lt8912b->hpd.stop = true;
+    xTaskNotifyGive(lt8912b->hpd.task);
+    while (lt8912b->hpd.task) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    return ESP_OK;
+}
+
 static esp_err_t panel_lt8912b_del(esp_lcd_panel_t *panel)
 {
     lt8912b_panel_t *lt8912b = (lt8912b_panel_t *)panel->user_data;
 
+    esp_lcd_panel_lt8912b_hpd_monitor_stop(panel);
     if (lt8912b->reset_gpio_num >= 0) {
         gpio_reset_pin(lt8912b->reset_gpio_num);
     }
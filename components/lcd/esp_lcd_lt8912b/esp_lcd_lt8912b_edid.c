@@ -0,0 +1,349 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "esp_bit_defs.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_lcd_lt8912b.h"
+
+static const char *TAG = "lt8912b_edid";
+
+#define EDID_BLOCK_SIZE         128
+#define EDID_DESCRIPTOR_SIZE    18
+#define EDID_CEA_TAG            0x02
+
+/* Timing of CEA-861 video code */
+typedef struct {
+    uint8_t vic;
+    uint8_t aspect_ratio;
+    uint16_t hact, hfp, hs, hbp;
+    uint16_t vact, vfp, vs, vbp;
+    uint32_t pclk_khz;
+    bool polarity;      /* Positive H and V sync */
+} edid_cea_timing_t;
+
+static const edid_cea_timing_t edid_cea_timings[] = {
+    {1,  LT8912B_ASPECT_RATION_4_3,  640,  16,  96,  48,  480,  10, 2, 33, 25175,  false},
+    {2,  LT8912B_ASPECT_RATION_4_3,  720,  16,  62,  60,  480,  9,  6, 30, 27000,  false},
+    {3,  LT8912B_ASPECT_RATION_16_9, 720,  16,  62,  60,  480,  9,  6, 30, 27000,  false},
+    {4,  LT8912B_ASPECT_RATION_16_9, 1280, 110, 40,  220, 720,  5,  5, 20, 74250,  true},
+    {16, LT8912B_ASPECT_RATION_16_9, 1920, 88,  44,  148, 1080, 4,  5, 36, 148500, true},
+    {17, LT8912B_ASPECT_RATION_4_3,  720,  12,  64,  68,  576,  5,  5, 39, 27000,  false},
+    {18, LT8912B_ASPECT_RATION_16_9, 720,  12,  64,  68,  576,  5,  5, 39, 27000,  false},
+    {19, LT8912B_ASPECT_RATION_16_9, 1280, 440, 40,  220, 720,  5,  5, 20, 74250,  true},
+    {31, LT8912B_ASPECT_RATION_16_9, 1920, 528, 44,  148, 1080, 4,  5, 36, 148500, true},
+    {32, LT8912B_ASPECT_RATION_16_9, 1920, 638, 44,  148, 1080, 4,  5, 36, 74250,  true},
+    {33, LT8912B_ASPECT_RATION_16_9, 1920, 528, 44,  148, 1080, 4,  5, 36, 74250,  true},
+    {34, LT8912B_ASPECT_RATION_16_9, 1920, 88,  44,  148, 1080, 4,  5, 36, 74250,  true},
+};
+
+/* Timings of this driver, used for established and standard timings of the monitor */
+static const esp_lcd_panel_lt8912b_video_timing_t edid_driver_timings[] = {
+    ESP_LCD_LT8912B_VIDEO_TIMING_800x600_60Hz(),
+    ESP_LCD_LT8912B_VIDEO_TIMING_1024x768_60Hz(),
+    ESP_LCD_LT8912B_VIDEO_TIMING_1280x720_60Hz(),
+    ESP_LCD_LT8912B_VIDEO_TIMING_1280x800_60Hz(),
+    ESP_LCD_LT8912B_VIDEO_TIMING_1920x1080_30Hz(),
+};
+static const uint16_t edid_driver_timings_refresh[] = {60, 60, 60, 60, 30};
+
+static uint8_t edid_aspect_ratio(uint16_t hact, uint16_t vact)
+{
+    if (hact * 9 == vact * 16) {
+        return LT8912B_ASPECT_RATION_16_9;
+    }
+    if (hact * 3 == vact * 4) {
+        return LT8912B_ASPECT_RATION_4_3;
+    }
+    return LT8912B_ASPECT_RATION_NO;
+}
+
+static void edid_add_mode(esp_lcd_lt8912b_edid_t *edid, const esp_lcd_panel_lt8912b_video_timing_t *timing, uint32_t pclk_khz)
+{
+    if (timing->hact == 0 || timing->vact == 0 || timing->htotal == 0 || timing->vtotal == 0) {
+        return;
+    }
+    for (int i = 0; i < edid->mode_count; i++) {
+        const esp_lcd_lt8912b_edid_mode_t *mode = &edid->modes[i];
+        if (mode->pclk_khz == pclk_khz && mode->timing.hact == timing->hact && mode->timing.vact == timing->vact &&
+                mode->timing.htotal == timing->htotal && mode->timing.vtotal == timing->vtotal) {
+            return;
+        }
+    }
+    if (edid->mode_count >= LT8912B_EDID_MODES_MAX) {
+        ESP_LOGW(TAG, "Too many modes, %dx%d is ignored", timing->hact, timing->vact);
+        return;
+    }
+
+    esp_lcd_lt8912b_edid_mode_t *mode = &edid->modes[edid->mode_count++];
+    const uint32_t frame_px = (uint32_t)timing->htotal * timing->vtotal;
+    mode->timing = *timing;
+    mode->timing.pclk_mhz = (pclk_khz + 500) / 1000;
+    mode->pclk_khz = pclk_khz;
+    mode->refresh_hz = (pclk_khz * 1000 + frame_px / 2) / frame_px;
+    ESP_LOGD(TAG, "Mode %dx%d@%d (%"PRIu32" kHz, VIC %d)", timing->hact, timing->vact, mode->refresh_hz, pclk_khz, timing->vic);
+}
+
+/* Detailed timing descriptor or display descriptor */
+static void edid_parse_descriptor(esp_lcd_lt8912b_edid_t *edid, const uint8_t *d)
+{
+    const uint32_t pclk_khz = (d[0] | (d[1] << 8)) * 10;
+
+    if (pclk_khz == 0) {
+        if (d[3] == 0xFC) {
+            /* Monitor name, terminated by line feed */
+            for (size_t i = 0; i < sizeof(edid->monitor_name) - 1 && d[5 + i] != 0x0A; i++) {
+                edid->monitor_name[i] = d[5 + i];
+            }
+        } else if (d[3] == 0xFD) {
+            /* Range limits, maximum pixel clock in 10 MHz */
+            edid->max_pclk_mhz = d[9] * 10;
+        }
+        return;
+    }
+    /* Interlaced timings are not supported */
+    if (d[17] & 0x80) {
+        return;
+    }
+
+    const uint16_t hblank = d[3] | ((d[4] & 0x0F) << 8);
+    const uint16_t vblank = d[6] | ((d[7] & 0x0F) << 8);
+    esp_lcd_panel_lt8912b_video_timing_t timing = {
+        .hact = d[2] | ((d[4] & 0xF0) << 4),
+        .vact = d[5] | ((d[7] & 0xF0) << 4),
+        .hfp = d[8] | ((d[11] & 0xC0) << 2),
+        .hs = d[9] | ((d[11] & 0x30) << 4),
+        .vfp = (d[10] >> 4) | ((d[11] & 0x0C) << 2),
+        .vs = (d[10] & 0x0F) | ((d[11] & 0x03) << 4),
+        /* Digital separate sync has its polarity, positive otherwise */
+        .h_polarity = ((d[17] & 0x18) == 0x18) ? ((d[17] & 0x02) != 0) : true,
+        .v_polarity = ((d[17] & 0x18) == 0x18) ? ((d[17] & 0x04) != 0) : true,
+    };
+    if (hblank < timing.hfp + timing.hs || vblank < timing.vfp + timing.vs) {
+        return;
+    }
+    timing.hbp = hblank - timing.hfp - timing.hs;
+    timing.vbp = vblank - timing.vfp - timing.vs;
+    timing.htotal = timing.hact + hblank;
+    timing.vtotal = timing.vact + vblank;
+    timing.aspect_ratio = edid_aspect_ratio(timing.hact, timing.vact);
+    edid_add_mode(edid, &timing, pclk_khz);
+}
+
+static void edid_add_vic(esp_lcd_lt8912b_edid_t *edid, uint8_t vic)
+{
+    for (size_t i = 0; i < sizeof(edid_cea_timings) / sizeof(edid_cea_timings[0]); i++) {
+        const edid_cea_timing_t *cea = &edid_cea_timings[i];
+        if (cea->vic != vic) {
+            continue;
+        }
+        const esp_lcd_panel_lt8912b_video_timing_t timing = {
+            .hfp = cea->hfp,
+            .hs = cea->hs,
+            .hbp = cea->hbp,
+            .hact = cea->hact,
+            .htotal = cea->hact + cea->hfp + cea->hs + cea->hbp,
+            .vfp = cea->vfp,
+            .vs = cea->vs,
+            .vbp = cea->vbp,
+            .vact = cea->vact,
+            .vtotal = cea->vact + cea->vfp + cea->vs + cea->vbp,
+            .h_polarity = cea->polarity,
+            .v_polarity = cea->polarity,
+            .vic = cea->vic,
+            .aspect_ratio = cea->aspect_ratio,
+        };
+        edid_add_mode(edid, &timing, cea->pclk_khz);
+        return;
+    }
+}
+
+/* Resolution and refresh listed by the monitor (without timing) */
+static void edid_add_listed(esp_lcd_lt8912b_edid_t *edid, uint16_t hact, uint16_t vact, uint16_t refresh_hz)
+{
+    for (size_t i = 0; i < sizeof(edid_driver_timings) / sizeof(edid_driver_timings[0]); i++) {
+        const esp_lcd_panel_lt8912b_video_timing_t *timing = &edid_driver_timings[i];
+        if (timing->hact == hact && timing->vact == vact && edid_driver_timings_refresh[i] == refresh_hz) {
+            edid_add_mode(edid, timing, timing->pclk_mhz * 1000);
+        }
+    }
+}
+
+static void edid_parse_cea(esp_lcd_lt8912b_edid_t *edid, const uint8_t *block)
+{
+    const uint8_t dtd_offset = block[2];
+    if (dtd_offset < 4 || dtd_offset > EDID_BLOCK_SIZE - 1) {
+        return;
+    }
+
+    /* Data block collection, video data blocks list VICs */
+    for (int i = 4; i < dtd_offset;) {
+        const uint8_t tag = block[i] >> 5;
+        const uint8_t len = block[i] & 0x1F;
+        if (i + 1 + len > dtd_offset) {
+            break;
+        }
+        if (tag == 2) {
+            for (int j = 1; j <= len; j++) {
+                const uint8_t svd = block[i + j];
+                /* Bit 7 is native flag for VICs 1 - 64 */
+                edid_add_vic(edid, (svd >= 129 && svd <= 192) ? (svd & 0x7F) : svd);
+            }
+        }
+        i += 1 + len;
+    }
+
+    for (int i = dtd_offset; i + EDID_DESCRIPTOR_SIZE <= EDID_BLOCK_SIZE - 1; i += EDID_DESCRIPTOR_SIZE) {
+        if (block[i] == 0 && block[i + 1] == 0) {
+            break;
+        }
+        edid_parse_descriptor(edid, &block[i]);
+    }
+}
+
+static bool edid_checksum_ok(const uint8_t *block)
+{
+    uint8_t sum = 0;
+    for (int i = 0; i < EDID_BLOCK_SIZE; i++) {
+        sum += block[i];
+    }
+    return sum == 0;
+}
+
+esp_err_t esp_lcd_lt8912b_parse_edid(const uint8_t *data, size_t size, esp_lcd_lt8912b_edid_t *edid)
+{
+    static const uint8_t header[] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+    ESP_RETURN_ON_FALSE(data && edid && size >= EDID_BLOCK_SIZE, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(memcmp(data, header, sizeof(header)) == 0, ESP_ERR_INVALID_RESPONSE, TAG, "wrong EDID header");
+    ESP_RETURN_ON_FALSE(edid_checksum_ok(data), ESP_ERR_INVALID_CRC, TAG, "wrong EDID checksum");
+
+    memset(edid, 0, sizeof(esp_lcd_lt8912b_edid_t));
+
+    /* Detailed timings (the first one is preferred) and display descriptors */
+    for (int i = 54; i < 126; i += EDID_DESCRIPTOR_SIZE) {
+        edid_parse_descriptor(edid, &data[i]);
+    }
+
+    /* Established timings */
+    if (data[35] & BIT(0)) {
+        edid_add_listed(edid, 800, 600, 60);
+    }
+    if (data[36] & BIT(3)) {
+        edid_add_listed(edid, 1024, 768, 60);
+    }
+
+    /* Standard timings */
+    for (int i = 38; i < 54; i += 2) {
+        if (data[i] == 0x01 && data[i + 1] == 0x01) {
+            continue;
+        }
+        const uint16_t hact = (data[i] + 31) * 8;
+        const uint16_t refresh_hz = (data[i + 1] & 0x3F) + 60;
+        uint16_t vact;
+        switch (data[i + 1] >> 6) {
+        case 0:
+            vact = hact * 10 / 16;
+            break;
+        case 1:
+            vact = hact * 3 / 4;
+            break;
+        case 2:
+            vact = hact * 4 / 5;
+            break;
+        default:
+            vact = hact * 9 / 16;
+            break;
+        }
+        edid_add_listed(edid, hact, vact, refresh_hz);
+    }
+
+    /* Extension blocks */
+    const int blocks = MIN(data[126] + 1, size / EDID_BLOCK_SIZE);
+    for (int b = 1; b < blocks; b++) {
+        const uint8_t *block = &data[b * EDID_BLOCK_SIZE];
+        if (!edid_checksum_ok(block)) {
+            ESP_LOGW(TAG, "Wrong checksum of EDID extension %d", b);
+            continue;
+        }
+        if (block[0] == EDID_CEA_TAG) {
+            edid_parse_cea(edid, block);
+        }
+    }
+
+    ESP_LOGI(TAG, "Monitor \"%s\": %d modes, max pixel clock %d MHz", edid->monitor_name, edid->mode_count, edid->max_pclk_mhz);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_lt8912b_read_edid(esp_lcd_panel_io_handle_t ddc, esp_lcd_lt8912b_edid_t *edid)
+{
+    uint8_t data[EDID_BLOCK_SIZE * 2];
+    size_t size = EDID_BLOCK_SIZE;
+    ESP_RETURN_ON_FALSE(ddc && edid, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    /* Command is the offset of EDID */
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_rx_param(ddc, 0x00, data, EDID_BLOCK_SIZE), TAG, "read EDID failed");
+    if (data[126] > 0) {
+        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_rx_param(ddc, EDID_BLOCK_SIZE, &data[EDID_BLOCK_SIZE], EDID_BLOCK_SIZE), TAG,
+                            "read EDID extension failed");
+        size += EDID_BLOCK_SIZE;
+    }
+
+    return esp_lcd_lt8912b_parse_edid(data, size, edid);
+}
+
+esp_err_t esp_lcd_lt8912b_select_mode(const esp_lcd_lt8912b_edid_t *edid, const esp_lcd_lt8912b_mode_request_t *request,
+                                      esp_lcd_panel_lt8912b_video_timing_t *timing)
+{
+    const esp_lcd_lt8912b_edid_mode_t *best = NULL;
+    ESP_RETURN_ON_FALSE(edid && request && timing, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    for (int i = 0; i < edid->mode_count; i++) {
+        const esp_lcd_lt8912b_edid_mode_t *mode = &edid->modes[i];
+        if (mode->timing.hact < request->h_res || mode->timing.vact < request->v_res ||
+                mode->refresh_hz < request->refresh_hz) {
+            continue;
+        }
+        if ((request->max_pclk_mhz && mode->pclk_khz > request->max_pclk_mhz * 1000) ||
+                (edid->max_pclk_mhz && mode->pclk_khz > edid->max_pclk_mhz * 1000)) {
+            continue;
+        }
+        /* Lowest pixel clock, then the smallest resolution */
+        if (best == NULL || mode->pclk_khz < best->pclk_khz ||
+                (mode->pclk_khz == best->pclk_khz &&
+                 (uint32_t)mode->timing.hact * mode->timing.vact < (uint32_t)best->timing.hact * best->timing.vact)) {
+            best = mode;
+        }
+    }
+    ESP_RETURN_ON_FALSE(best, ESP_ERR_NOT_FOUND, TAG, "no mode for %dx%d@%d", request->h_res, request->v_res,
+                        request->refresh_hz);
+
+    ESP_LOGI(TAG, "Selected mode %dx%d@%d, pixel clock %"PRIu32" kHz", best->timing.hact, best->timing.vact,
+             best->refresh_hz, best->pclk_khz);
+    *timing = best->timing;
+
+    return ESP_OK;
+}
+
+void esp_lcd_lt8912b_timing_to_dpi(const esp_lcd_panel_lt8912b_video_timing_t *timing, esp_lcd_dpi_panel_config_t *dpi_config)
+{
+    assert(timing && dpi_config);
+
+    dpi_config->dpi_clock_freq_mhz = timing->pclk_mhz;
+    dpi_config->video_timing.h_size = timing->hact;
+    dpi_config->video_timing.v_size = timing->vact;
+    dpi_config->video_timing.hsync_back_porch = timing->hbp;
+    dpi_config->video_timing.hsync_pulse_width = timing->hs;
+    dpi_config->video_timing.hsync_front_porch = timing->hfp;
+    dpi_config->video_timing.vsync_back_porch = timing->vbp;
+    dpi_config->video_timing.vsync_pulse_width = timing->vs;
+    dpi_config->video_timing.vsync_front_porch = timing->vfp;
+}
@@ -86,6 +86,195 @@ esp_err_t esp_lcd_new_panel_lt8912b(const esp_lcd_panel_lt8912b_io_t *io, const
  */
 bool esp_lcd_panel_lt8912b_is_ready(esp_lcd_panel_t *panel);
 
+/**
+ * @brief Change video timing of initialized LT8912B (e.g. 60 Hz and 30 Hz profile of one resolution)
+ *
+ * Only the timing registers, AVI infoframe and MIPI RX logic are updated, the rest of the initialization is kept.
+ * The MIPI-DPI output must be switched to the same timing (the bridge follows its input after MIPI RX reset).
+ *
+ * @param[in] panel LCD panel handle of LT8912B
+ * @param[in] video_timing New video timing
+ * @return
+ *      - ESP_OK: Timing changed successfully
+ *      - ESP_ERR_INVALID_ARG: Invalid argument or the panel is not LT8912B
+ *      - Error of the communication otherwise
+ */
+esp_err_t esp_lcd_panel_lt8912b_set_video_timing(esp_lcd_panel_t *panel, const esp_lcd_panel_lt8912b_video_timing_t *video_timing);
+
+/**
+ * @brief Callback of HDMI hot-plug change, called from the HPD monitor task
+ *
+ * @param[in] panel     LCD panel handle of LT8912B
+ * @param[in] connected True when the monitor was connected (and HDMI output restored), false when disconnected
+ * @param[in] user_ctx  User context from `esp_lcd_panel_lt8912b_hpd_config_t`
+ */
+typedef void (*esp_lcd_panel_lt8912b_hpd_cb_t)(esp_lcd_panel_t *panel, bool connected, void *user_ctx);
+
+/**
+ * @brief HDMI hot-plug monitor configuration
+ */
+typedef struct {
+    int hpd_gpio_num;                           /*!< GPIO connected to HPD of the HDMI connector for immediate detection, -1 to only poll the bridge */
+    uint32_t poll_period_ms;                    /*!< Period of HPD status polling */
+    uint32_t debounce_ms;                       /*!< HPD must be stable for this time before the change is handled */
+    esp_lcd_panel_lt8912b_hpd_cb_t on_change;   /*!< Called after the change is handled (optional) */
+    void *user_ctx;                             /*!< User context passed to the callback */
+    struct {
+        unsigned int priority;                  /*!< Priority of the monitor task */
+        uint32_t stack_size;                    /*!< Stack size of the monitor task */
+    } task;
+    struct {
+        unsigned int pause_dpi: 1;              /*!< Feed MIPI-DPI from its pattern generator instead of the frame buffer while disconnected */
+    } flags;
+} esp_lcd_panel_lt8912b_hpd_config_t;
+
+/**
+ * @brief Default configuration of HDMI hot-plug monitor
+ */
+#define LT8912B_HPD_CONFIG_DEFAULT()    \
+    {                                   \
+        .hpd_gpio_num = -1,             \
+        .poll_period_ms = 500,          \
+        .debounce_ms = 100,             \
+        .on_change = NULL,              \
+        .user_ctx = NULL,               \
+        .task = {                       \
+            .priority = 2,              \
+            .stack_size = 3072,         \
+        },                              \
+        .flags = {                      \
+            .pause_dpi = 1,             \
+        },                              \
+    }
+
+/**
+ * @brief Start monitoring of HDMI hot-plug
+ *
+ * On disconnect, the HDMI output is disabled (and the MIPI-DPI scan-out paused if requested). On reconnect, only
+ * the AVI infoframe, MIPI RX logic reset and HDMI output are sent again, the rest of the initialization is kept.
+ *
+ * @note The panel must be initialized. The monitor task accesses the bridge over I2C, other calls to the bridge
+ *       (e.g. `esp_lcd_panel_lt8912b_set_video_timing()`) should be done from the callback or with the monitor stopped.
+ *
+ * @param[in] panel  LCD panel handle of LT8912B
+ * @param[in] config Monitor configuration
+ * @return
+ *      - ESP_OK: Monitor started
+ *      - ESP_ERR_INVALID_ARG: Invalid argument or the panel is not LT8912B
+ *      - ESP_ERR_INVALID_STATE: Monitor already started
+ *      - ESP_ERR_NO_MEM: Task creation failed
+ *      - Error of GPIO configuration otherwise
+ */
+esp_err_t esp_lcd_panel_lt8912b_hpd_monitor_start(esp_lcd_panel_t *panel, const esp_lcd_panel_lt8912b_hpd_config_t *config);
+
+/**
+ * @brief Stop monitoring of HDMI hot-plug
+ *
+ * The output is left in its current state. It is called by `esp_lcd_panel_del()` of the panel too.
+ *
+ * @param[in] panel LCD panel handle of LT8912B
+ * @return
+ *      - ESP_OK: Monitor stopped (or not running)
+ *      - ESP_ERR_INVALID_ARG: Invalid argument or the panel is not LT8912B
+ */
+esp_err_t esp_lcd_panel_lt8912b_hpd_monitor_stop(esp_lcd_panel_t *panel);
+
+/**
+ * @brief Maximum count of video modes parsed from EDID
+ */
+#define LT8912B_EDID_MODES_MAX      (24)
+
+/**
+ * @brief Video mode accepted by the monitor
+ */
+typedef struct {
+    esp_lcd_panel_lt8912b_video_timing_t timing;    /*!< Video timing (`pclk_mhz` is rounded) */
+    uint32_t pclk_khz;                              /*!< Exact pixel clock in [kHz] */
+    uint16_t refresh_hz;                            /*!< Refresh rate (rounded) */
+} esp_lcd_lt8912b_edid_mode_t;
+
+/**
+ * @brief Monitor capabilities parsed from EDID
+ *
+ * Modes are collected from detailed timings (base block and CEA-861 extension), CEA-861 video codes with known timing
+ * and established or standard timings that match one of the timings of this driver.
+ */
+typedef struct {
+    char monitor_name[14];                          /*!< Monitor name (empty string if not present) */
+    uint16_t max_pclk_mhz;                          /*!< Maximum pixel clock from range limits (0 if not present) */
+    uint8_t mode_count;                             /*!< Count of valid modes */
+    esp_lcd_lt8912b_edid_mode_t modes[LT8912B_EDID_MODES_MAX]; /*!< Accepted modes */
+} esp_lcd_lt8912b_edid_t;
+
+/**
+ * @brief Requirements of the selected video mode
+ */
+typedef struct {
+    uint16_t h_res;             /*!< Minimum horizontal resolution */
+    uint16_t v_res;             /*!< Minimum vertical resolution */
+    uint16_t refresh_hz;        /*!< Minimum refresh rate (0 for any) */
+    uint32_t max_pclk_mhz;      /*!< Maximum pixel clock of MIPI-DSI link (0 for no limit), e.g. lanes * lane_bit_rate_mbps / 24 */
+} esp_lcd_lt8912b_mode_request_t;
+
+/**
+ * @brief Read EDID of the monitor over DDC
+ *
+ * DDC (I2C address 0x50 of the HDMI connector) must be accessible by the host, e.g. on the same I2C bus as LT8912B.
+ * The base block and the first extension block are read.
+ *
+ * @param[in]  ddc  Panel IO handle of DDC created with `LT8912B_IO_CFG(100000, LT8912B_IO_I2C_EDID_ADDRESS)`
+ * @param[out] edid Parsed monitor capabilities
+ * @return
+ *      - ESP_OK: EDID read successfully
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_INVALID_CRC: Checksum of the base block is wrong
+ *      - ESP_ERR_INVALID_RESPONSE: The data is not EDID
+ *      - Error of the communication otherwise (e.g. monitor is not connected)
+ */
+esp_err_t esp_lcd_lt8912b_read_edid(esp_lcd_panel_io_handle_t ddc, esp_lcd_lt8912b_edid_t *edid);
+
+/**
+ * @brief Parse EDID already read from the monitor
+ *
+ * @param[in]  data EDID data (base block and optional extension blocks)
+ * @param[in]  size Size of the data in bytes (multiple of 128)
+ * @param[out] edid Parsed monitor capabilities
+ * @return
+ *      - ESP_OK: EDID parsed successfully
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_INVALID_CRC: Checksum of the base block is wrong
+ *      - ESP_ERR_INVALID_RESPONSE: The data is not EDID
+ */
+esp_err_t esp_lcd_lt8912b_parse_edid(const uint8_t *data, size_t size, esp_lcd_lt8912b_edid_t *edid);
+
+/**
+ * @brief Select the mode with the lowest pixel clock that satisfies the request
+ *
+ * The selected resolution can be larger than requested (e.g. 1920x1080 when the monitor does not accept 1280x720),
+ * the frame buffer must follow `hact` and `vact` of the returned timing.
+ *
+ * @param[in]  edid    Monitor capabilities
+ * @param[in]  request Requirements of the mode
+ * @param[out] timing  Selected video timing
+ * @return
+ *      - ESP_OK: Mode selected
+ *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_ERR_NOT_FOUND: No mode of the monitor satisfies the request
+ */
+esp_err_t esp_lcd_lt8912b_select_mode(const esp_lcd_lt8912b_edid_t *edid, const esp_lcd_lt8912b_mode_request_t *request,
+                                      esp_lcd_panel_lt8912b_video_timing_t *timing);
+
+/**
+ * @brief Set timing of MIPI-DPI panel configuration to the video timing of LT8912B
+ *
+ * Only the clock and the timing are changed, the rest of `dpi_config` is kept (e.g. from `LT8912B_*_DPI_CONFIG()`).
+ * Use it before creating the panel by `esp_lcd_new_panel_lt8912b()` with the same timing in `lt8912b_vendor_config_t`.
+ *
+ * @param[in]  timing     Video timing
+ * @param[out] dpi_config MIPI-DPI panel configuration
+ */
+void esp_lcd_lt8912b_timing_to_dpi(const esp_lcd_panel_lt8912b_video_timing_t *timing, esp_lcd_dpi_panel_config_t *dpi_config);
+
 /**
  * @brief I2C address of the LT8912B controller
  *
@@ -94,6 +283,12 @@ bool esp_lcd_panel_lt8912b_is_ready(esp_lcd_panel_t *panel);
 #define LT8912B_IO_I2C_CEC_ADDRESS  (0x49)
 #define LT8912B_IO_I2C_AVI_ADDRESS  (0x4A)
 
+/**
+ * @brief I2C address of EDID of the monitor (DDC of HDMI connector)
+ *
+ */
+#define LT8912B_IO_I2C_EDID_ADDRESS (0x50)
+
 
 #define LT8912B_ASPECT_RATION_NO 0x00
 #define LT8912B_ASPECT_RATION_4_3 0x01
@@ -6,6 +6,7 @@
 
 #include <stdlib.h>
 #include <sys/cdefs.h>
+#include <sys/param.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_lcd_panel_interface.h"
@@ -20,6 +21,51 @@
 #include "esp_timer.h"
 
 #define ESP_RA8875_TIMEOUT_US   (10*1000)
+#define ESP_RA8875_ENGINE_TIMEOUT_US   (200*1000) // Fill and BTE of the whole screen
+
+// Graphic engines
+#define ESP_RA8875_MEMORY_SIZE  (768*1024) // Display memory of both layers
+
+#define RA8875_REG_DPCR         (0x20) // Display configuration (layers, scan direction)
+#define RA8875_REG_HOFS         (0x24) // Horizontal scroll offset (2 registers)
+#define RA8875_REG_VOFS         (0x26) // Vertical scroll offset (2 registers)
+#define RA8875_REG_HSSW         (0x38) // Scroll window start X (2 registers)
+#define RA8875_REG_VSSW         (0x3A) // Scroll window start Y (2 registers)
+#define RA8875_REG_HESW         (0x3C) // Scroll window end X (2 registers)
+#define RA8875_REG_VESW         (0x3E) // Scroll window end Y (2 registers)
+#define RA8875_REG_MWCR1        (0x41) // Memory write control 1 (write layer)
+#define RA8875_REG_LTPR0        (0x52) // Layer transparency 0 (display mode, scroll mode)
+#define RA8875_REG_LTPR1        (0x53) // Layer transparency 1 (mixing of layers)
+#define RA8875_REG_BECR0        (0x50) // BTE function control 0
+#define RA8875_REG_BECR1        (0x51) // BTE function control 1 (ROP and operation)
+#define RA8875_REG_HSBE         (0x54) // BTE source X (2 registers)
+#define RA8875_REG_VSBE         (0x56) // BTE source Y (2 registers)
+#define RA8875_REG_HDBE         (0x58) // BTE destination X (2 registers)
+#define RA8875_REG_VDBE         (0x5A) // BTE destination Y (2 registers)
+#define RA8875_REG_BEWR         (0x5C) // BTE width (2 registers)
+#define RA8875_REG_BEHR         (0x5E) // BTE height (2 registers)
+#define RA8875_REG_FGCR0        (0x63) // Foreground color red
+#define RA8875_REG_FGCR1        (0x64) // Foreground color green
+#define RA8875_REG_FGCR2        (0x65) // Foreground color blue
+#define RA8875_REG_BGTR0        (0x67) // Transparent color red
+#define RA8875_REG_BGTR1        (0x68) // Transparent color green
+#define RA8875_REG_BGTR2        (0x69) // Transparent color blue
+#define RA8875_REG_DCR          (0x90) // Draw line/circle/square control
+#define RA8875_REG_DLHSR        (0x91) // Draw start X (2 registers)
+#define RA8875_REG_DLVSR        (0x93) // Draw start Y (2 registers)
+#define RA8875_REG_DLHER        (0x95) // Draw end X (2 registers)
+#define RA8875_REG_DLVER        (0x97) // Draw end Y (2 registers)
+
+#define RA8875_DPCR_TWO_LAYERS  (0x80)
+#define RA8875_DPCR_SCAN_MASK   (0x0C)
+#define RA8875_MWCR1_LAYER_2    (0x01)
+#define RA8875_LTPR0_MODE_MASK  (0x07)
+#define RA8875_LTPR0_SCROLL_POS (6)
+#define RA8875_BTE_LAYER_2      (0x8000) // Layer bit of BTE Y coordinates
+#define RA8875_BECR0_START      (0x80)
+#define RA8875_BECR1_MOVE_POS   (0xC2) // ROP: source, move in positive direction
+#define RA8875_BECR1_MOVE_NEG   (0xC3) // ROP: source, move in negative direction
+#define RA8875_DCR_FILL_SQUARE  (0xB0) // Start, fill, square
 
 static const char *TAG = "ra8875";
 
@@ -46,6 +92,9 @@ typedef struct {
     uint16_t lcd_height;
     uint8_t sysr; // save surrent value of System Configuration Register (Color Depth settings and 8-bit/16-bit interface)
     bool swap_axes;
+    uint8_t dpcr;  // save current value of Display Configuration Register (layers and scan direction)
+    uint8_t ltpr0; // save current value of Layer Transparency Register 0 (layer display and scroll mode)
+    esp_lcd_ra8875_layer_t write_layer;
 } ra8875_panel_t;
 
 esp_err_t esp_lcd_new_panel_ra8875(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel)
@@ -346,7 +395,9 @@ static esp_err_t panel_ra8875_invert_color(esp_lcd_panel_t *panel, bool invert_c
 
 static esp_err_t panel_ra8875_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool mirror_y)
 {
-    uint8_t param = 0;
+    ra8875_panel_t *ra8875 = __containerof(panel, ra8875_panel_t, base);
+    // Keep the layer setting
+    uint8_t param = ra8875->dpcr & ~RA8875_DPCR_SCAN_MASK;
 
     if (mirror_y) {
         param |= 0x04;
@@ -355,7 +406,8 @@ static esp_err_t panel_ra8875_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool
         param |= 0x08;
     }
 
-    panel_ra8875_tx_param(panel, 0x20, param);
+    ra8875->dpcr = param;
+    panel_ra8875_tx_param(panel, RA8875_REG_DPCR, param);
 
     return ESP_OK;
 }
@@ -401,3 +453,233 @@ static esp_err_t panel_ra8875_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
     panel_ra8875_tx_param(panel, 0x01, param);
     return ESP_OK;
 }
+
+static esp_err_t panel_ra8875_tx_coord(esp_lcd_panel_t *panel, int reg, int value)
+{
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, reg, value & 0xFF), TAG, "send register failed");
+    return panel_ra8875_tx_param(panel, reg + 1, (value >> 8) & 0xFF);
+}
+
+static esp_err_t panel_ra8875_wait_engine(esp_lcd_panel_t *panel)
+{
+    ra8875_panel_t *ra8875 = __containerof(panel, ra8875_panel_t, base);
+
+    // Engine is busy while WAIT is low, it can take longer than one register access
+    uint64_t start = esp_timer_get_time();
+    while (gpio_get_level(ra8875->wait_gpio_num) == 0) {
+        if (esp_timer_get_time() - start > ESP_RA8875_ENGINE_TIMEOUT_US) {
+            ESP_LOGE(TAG, "RA8875 engine timeout!");
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_ra8875_fill_rect(esp_lcd_panel_handle_t panel, int x_start, int y_start, int x_end, int y_end, uint16_t color)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ra8875_del, ESP_ERR_INVALID_ARG, TAG, "invalid ra8875 panel");
+    ESP_RETURN_ON_FALSE(x_start < x_end && y_start < y_end, ESP_ERR_INVALID_ARG, TAG, "start position must be smaller than end position");
+    ra8875_panel_t *ra8875 = __containerof(panel, ra8875_panel_t, base);
+    // Busy state cannot be read back, only WAIT signal tells when the engine is done
+    ESP_RETURN_ON_FALSE(ra8875->wait_gpio_num >= 0, ESP_ERR_NOT_SUPPORTED, TAG, "graphic engine needs WAIT GPIO");
+
+    x_start += ra8875->x_gap;
+    x_end += ra8875->x_gap;
+    y_start += ra8875->y_gap;
+    y_end += ra8875->y_gap;
+
+    // Drawing is clipped by the active window
+    panel_ra8875_set_window(panel, x_start, y_start, x_end, y_end);
+    if (ra8875->swap_axes) {
+        int tmp = x_start;
+        x_start = y_start;
+        y_start = tmp;
+        tmp = x_end;
+        x_end = y_end;
+        y_end = tmp;
+    }
+
+    // RGB565 color, 8-bit color depth is RGB332
+    uint8_t r = (color >> 11) & 0x1F;
+    uint8_t g = (color >> 5) & 0x3F;
+    uint8_t b = color & 0x1F;
+    if (ra8875->bits_per_pixel == 8) {
+        r >>= 2;
+        g >>= 3;
+        b >>= 3;
+    }
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_FGCR0, r), TAG, "send color failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_FGCR1, g), TAG, "send color failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_FGCR2, b), TAG, "send color failed");
+
+    // Square from start to end point (inclusive)
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_DLHSR, x_start), TAG, "send position failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_DLVSR, y_start), TAG, "send position failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_DLHER, x_end - 1), TAG, "send position failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_DLVER, y_end - 1), TAG, "send position failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_DCR, RA8875_DCR_FILL_SQUARE), TAG, "start fill failed");
+
+    return panel_ra8875_wait_engine(panel);
+}
+
+esp_err_t esp_lcd_ra8875_copy_rect(esp_lcd_panel_handle_t panel, int src_x, int src_y, int dst_x, int dst_y, int width, int height)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ra8875_del, ESP_ERR_INVALID_ARG, TAG, "invalid ra8875 panel");
+    ESP_RETURN_ON_FALSE(width > 0 && height > 0 && src_x >= 0 && src_y >= 0 && dst_x >= 0 && dst_y >= 0, ESP_ERR_INVALID_ARG, TAG, "invalid block");
+    ra8875_panel_t *ra8875 = __containerof(panel, ra8875_panel_t, base);
+    ESP_RETURN_ON_FALSE(ra8875->wait_gpio_num >= 0, ESP_ERR_NOT_SUPPORTED, TAG, "graphic engine needs WAIT GPIO");
+
+    src_x += ra8875->x_gap;
+    dst_x += ra8875->x_gap;
+    src_y += ra8875->y_gap;
+    dst_y += ra8875->y_gap;
+
+    // Active window covers the source and the destination
+    panel_ra8875_set_window(panel, MIN(src_x, dst_x), MIN(src_y, dst_y), MAX(src_x, dst_x) + width, MAX(src_y, dst_y) + height);
+    if (ra8875->swap_axes) {
+        int tmp = src_x;
+        src_x = src_y;
+        src_y = tmp;
+        tmp = dst_x;
+        dst_x = dst_y;
+        dst_y = tmp;
+        tmp = width;
+        width = height;
+        height = tmp;
+    }
+
+    // Overlapping block moved down/right is copied from its end (negative direction), the positions are bottom-right corners
+    uint8_t becr1 = RA8875_BECR1_MOVE_POS;
+    if (dst_y > src_y || (dst_y == src_y && dst_x > src_x)) {
+        becr1 = RA8875_BECR1_MOVE_NEG;
+        src_x += width - 1;
+        src_y += height - 1;
+        dst_x += width - 1;
+        dst_y += height - 1;
+    }
+
+    // Block is moved within the selected write layer
+    if (ra8875->write_layer == ESP_LCD_RA8875_LAYER_2) {
+        src_y |= RA8875_BTE_LAYER_2;
+        dst_y |= RA8875_BTE_LAYER_2;
+    }
+
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_HSBE, src_x), TAG, "send position failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_VSBE, src_y), TAG, "send position failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_HDBE, dst_x), TAG, "send position failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_VDBE, dst_y), TAG, "send position failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_BEWR, width), TAG, "send size failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_BEHR, height), TAG, "send size failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_BECR1, becr1), TAG, "send BTE operation failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_BECR0, RA8875_BECR0_START), TAG, "start BTE failed");
+
+    return panel_ra8875_wait_engine(panel);
+}
+
+esp_err_t esp_lcd_ra8875_set_layer_mode(esp_lcd_panel_handle_t panel, esp_lcd_ra8875_layer_mode_t mode)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ra8875_del, ESP_ERR_INVALID_ARG, TAG, "invalid ra8875 panel");
+    ESP_RETURN_ON_FALSE(mode <= ESP_LCD_RA8875_LAYER_MODE_AND || mode == ESP_LCD_RA8875_LAYER_MODE_SINGLE, ESP_ERR_INVALID_ARG, TAG, "invalid layer mode");
+    ra8875_panel_t *ra8875 = __containerof(panel, ra8875_panel_t, base);
+
+    // Both layers must fit into the display memory (e.g. 800x480 only with 8-bit color depth)
+    const bool two_layers = (mode != ESP_LCD_RA8875_LAYER_MODE_SINGLE);
+    const uint32_t layer_size = (uint32_t)ra8875->lcd_width * ra8875->lcd_height * ra8875->bits_per_pixel / 8;
+    ESP_RETURN_ON_FALSE(!two_layers || 2 * layer_size <= ESP_RA8875_MEMORY_SIZE, ESP_ERR_NOT_SUPPORTED, TAG,
+                        "two layers do not fit into memory with this resolution and color depth");
+
+    uint8_t dpcr = (ra8875->dpcr & ~RA8875_DPCR_TWO_LAYERS) | (two_layers ? RA8875_DPCR_TWO_LAYERS : 0);
+    if (dpcr != ra8875->dpcr) {
+        ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_DPCR, dpcr), TAG, "send layer setting failed");
+        ra8875->dpcr = dpcr;
+    }
+    // Single layer shows layer 1
+    const uint8_t ltpr0 = (ra8875->ltpr0 & ~RA8875_LTPR0_MODE_MASK) | (two_layers ? mode : ESP_LCD_RA8875_LAYER_MODE_LAYER_1);
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_LTPR0, ltpr0), TAG, "send layer mode failed");
+    ra8875->ltpr0 = ltpr0;
+
+    if (!two_layers && ra8875->write_layer != ESP_LCD_RA8875_LAYER_1) {
+        return esp_lcd_ra8875_select_layer(panel, ESP_LCD_RA8875_LAYER_1);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_ra8875_select_layer(esp_lcd_panel_handle_t panel, esp_lcd_ra8875_layer_t layer)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ra8875_del, ESP_ERR_INVALID_ARG, TAG, "invalid ra8875 panel");
+    ESP_RETURN_ON_FALSE(layer == ESP_LCD_RA8875_LAYER_1 || layer == ESP_LCD_RA8875_LAYER_2, ESP_ERR_INVALID_ARG, TAG, "invalid layer");
+    ra8875_panel_t *ra8875 = __containerof(panel, ra8875_panel_t, base);
+    ESP_RETURN_ON_FALSE(layer == ESP_LCD_RA8875_LAYER_1 || (ra8875->dpcr & RA8875_DPCR_TWO_LAYERS), ESP_ERR_INVALID_STATE, TAG,
+                        "layer 2 needs two layer mode");
+
+    // Destination of draw_bitmap, fill and BTE
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_MWCR1, (layer == ESP_LCD_RA8875_LAYER_2 ? RA8875_MWCR1_LAYER_2 : 0)),
+                        TAG, "send write layer failed");
+    ra8875->write_layer = layer;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_ra8875_set_layer_transparency(esp_lcd_panel_handle_t panel, uint8_t layer1_alpha, uint8_t layer2_alpha)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ra8875_del, ESP_ERR_INVALID_ARG, TAG, "invalid ra8875 panel");
+    ESP_RETURN_ON_FALSE(layer1_alpha <= 8 && layer2_alpha <= 8, ESP_ERR_INVALID_ARG, TAG, "alpha must be 0-8");
+
+    // Register holds levels of transparency (0: opaque, 8: disabled)
+    const uint8_t ltpr1 = ((8 - layer2_alpha) << 4) | (8 - layer1_alpha);
+    return panel_ra8875_tx_param(panel, RA8875_REG_LTPR1, ltpr1);
+}
+
+esp_err_t esp_lcd_ra8875_set_transparent_color(esp_lcd_panel_handle_t panel, uint16_t color)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ra8875_del, ESP_ERR_INVALID_ARG, TAG, "invalid ra8875 panel");
+    ra8875_panel_t *ra8875 = __containerof(panel, ra8875_panel_t, base);
+
+    // Same conversion as foreground color of fill
+    uint8_t r = (color >> 11) & 0x1F;
+    uint8_t g = (color >> 5) & 0x3F;
+    uint8_t b = color & 0x1F;
+    if (ra8875->bits_per_pixel == 8) {
+        r >>= 2;
+        g >>= 3;
+        b >>= 3;
+    }
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_BGTR0, r), TAG, "send color failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_BGTR1, g), TAG, "send color failed");
+    return panel_ra8875_tx_param(panel, RA8875_REG_BGTR2, b);
+}
+
+esp_err_t esp_lcd_ra8875_scroll_layer(esp_lcd_panel_handle_t panel, esp_lcd_ra8875_layer_t layer, int x_offset, int y_offset)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_ra8875_del, ESP_ERR_INVALID_ARG, TAG, "invalid ra8875 panel");
+    ESP_RETURN_ON_FALSE(layer <= ESP_LCD_RA8875_LAYER_BOTH, ESP_ERR_INVALID_ARG, TAG, "invalid layer");
+    ra8875_panel_t *ra8875 = __containerof(panel, ra8875_panel_t, base);
+
+    if (ra8875->swap_axes) {
+        int tmp = x_offset;
+        x_offset = y_offset;
+        y_offset = tmp;
+    }
+    ESP_RETURN_ON_FALSE(x_offset >= 0 && x_offset < ra8875->lcd_width && y_offset >= 0 && y_offset < ra8875->lcd_height,
+                        ESP_ERR_INVALID_ARG, TAG, "offset out of screen");
+
+    // Scroll function of LTPR0: 0 both layers, 1 only layer 1, 2 only layer 2
+    uint8_t scroll = 0;
+    if (layer == ESP_LCD_RA8875_LAYER_1) {
+        scroll = 1;
+    } else if (layer == ESP_LCD_RA8875_LAYER_2) {
+        scroll = 2;
+    }
+    const uint8_t ltpr0 = (ra8875->ltpr0 & RA8875_LTPR0_MODE_MASK) | (scroll << RA8875_LTPR0_SCROLL_POS);
+    if (ltpr0 != ra8875->ltpr0) {
+        ESP_RETURN_ON_ERROR(panel_ra8875_tx_param(panel, RA8875_REG_LTPR0, ltpr0), TAG, "send scroll mode failed");
+        ra8875->ltpr0 = ltpr0;
+    }
+
+    // Whole screen is the scroll window
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_HSSW, 0), TAG, "send scroll window failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_VSSW, 0), TAG, "send scroll window failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_HESW, ra8875->lcd_width - 1), TAG, "send scroll window failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_VESW, ra8875->lcd_height - 1), TAG, "send scroll window failed");
+    ESP_RETURN_ON_ERROR(panel_ra8875_tx_coord(panel, RA8875_REG_HOFS, x_offset), TAG, "send scroll offset failed");
+    return panel_ra8875_tx_coord(panel, RA8875_REG_VOFS, y_offset);
+}
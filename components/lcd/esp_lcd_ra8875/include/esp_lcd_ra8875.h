@@ -26,6 +26,28 @@ typedef struct {
     int mcu_bit_interface;  /*!< Selection between 8-bit and 16-bit MCU interface */
 } esp_lcd_panel_ra8875_config_t;
 
+/**
+ * @brief Display layer of RA8875
+ */
+typedef enum {
+    ESP_LCD_RA8875_LAYER_1 = 0,     /*!< Layer 1 (the only layer in single layer mode) */
+    ESP_LCD_RA8875_LAYER_2,         /*!< Layer 2 (two layer modes only) */
+    ESP_LCD_RA8875_LAYER_BOTH,      /*!< Both layers (scrolling only) */
+} esp_lcd_ra8875_layer_t;
+
+/**
+ * @brief Layer display mode of RA8875 (values of LTPR0 register)
+ */
+typedef enum {
+    ESP_LCD_RA8875_LAYER_MODE_LAYER_1 = 0,  /*!< Two layers, only layer 1 is shown */
+    ESP_LCD_RA8875_LAYER_MODE_LAYER_2,      /*!< Two layers, only layer 2 is shown */
+    ESP_LCD_RA8875_LAYER_MODE_LIGHTEN,      /*!< Two layers mixed by esp_lcd_ra8875_set_layer_transparency */
+    ESP_LCD_RA8875_LAYER_MODE_TRANSPARENT,  /*!< Layer 1 is shown through the pixels of layer 2 with the transparent color */
+    ESP_LCD_RA8875_LAYER_MODE_OR,           /*!< Boolean OR of both layers */
+    ESP_LCD_RA8875_LAYER_MODE_AND,          /*!< Boolean AND of both layers */
+    ESP_LCD_RA8875_LAYER_MODE_SINGLE = 0xFF,/*!< One layer of full display memory (default) */
+} esp_lcd_ra8875_layer_mode_t;
+
 /**
  * @brief Create LCD panel for model RA8875
  *
@@ -39,6 +61,112 @@ typedef struct {
  */
 esp_err_t esp_lcd_new_panel_ra8875(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel);
 
+/**
+ * @brief Fill rectangle by geometric drawing engine of RA8875 (without transfer of pixels)
+ *
+ * @note The function waits until the engine is done, it needs `wait_gpio_num`.
+ *
+ * @param[in] panel LCD panel handle of RA8875
+ * @param[in] x_start Start column (inclusive)
+ * @param[in] y_start Start row (inclusive)
+ * @param[in] x_end End column (exclusive)
+ * @param[in] y_end End row (exclusive)
+ * @param[in] color RGB565 color (converted to RGB332 with 8-bit color depth)
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid or the panel is not RA8875
+ *          - ESP_ERR_NOT_SUPPORTED if WAIT GPIO is not used
+ *          - ESP_ERR_TIMEOUT       if the engine is not done in time
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ra8875_fill_rect(esp_lcd_panel_handle_t panel, int x_start, int y_start, int x_end, int y_end, uint16_t color);
+
+/**
+ * @brief Copy/move block in display memory by Block Transfer Engine (BTE) of RA8875
+ *
+ * Overlapping blocks are copied correctly (e.g. when scrolling).
+ *
+ * @note The function waits until the engine is done, it needs `wait_gpio_num`.
+ *
+ * @param[in] panel LCD panel handle of RA8875
+ * @param[in] src_x Left column of source block
+ * @param[in] src_y Top row of source block
+ * @param[in] dst_x Left column of destination block
+ * @param[in] dst_y Top row of destination block
+ * @param[in] width Width of the block
+ * @param[in] height Height of the block
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid or the panel is not RA8875
+ *          - ESP_ERR_NOT_SUPPORTED if WAIT GPIO is not used
+ *          - ESP_ERR_TIMEOUT       if the engine is not done in time
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ra8875_copy_rect(esp_lcd_panel_handle_t panel, int src_x, int src_y, int dst_x, int dst_y, int width, int height);
+
+/**
+ * @brief Set layer display mode of RA8875
+ *
+ * The two layer modes need the memory of both layers, e.g. 800x480 only with 8-bit color depth or 480x272 with 16-bit.
+ * Switching to single layer mode selects layer 1 for writing.
+ *
+ * @param[in] panel LCD panel handle of RA8875
+ * @param[in] mode Layer display mode
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid or the panel is not RA8875
+ *          - ESP_ERR_NOT_SUPPORTED if two layers do not fit into the display memory
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ra8875_set_layer_mode(esp_lcd_panel_handle_t panel, esp_lcd_ra8875_layer_mode_t mode);
+
+/**
+ * @brief Select layer written by esp_lcd_panel_draw_bitmap, esp_lcd_ra8875_fill_rect and esp_lcd_ra8875_copy_rect
+ *
+ * @param[in] panel LCD panel handle of RA8875
+ * @param[in] layer ESP_LCD_RA8875_LAYER_1 or ESP_LCD_RA8875_LAYER_2
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid or the panel is not RA8875
+ *          - ESP_ERR_INVALID_STATE if layer 2 is selected in single layer mode
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ra8875_select_layer(esp_lcd_panel_handle_t panel, esp_lcd_ra8875_layer_t layer);
+
+/**
+ * @brief Set visibility of layers in ESP_LCD_RA8875_LAYER_MODE_LIGHTEN mode
+ *
+ * @param[in] panel LCD panel handle of RA8875
+ * @param[in] layer1_alpha Visibility of layer 1 in eighths (0: invisible, 8: opaque)
+ * @param[in] layer2_alpha Visibility of layer 2 in eighths (0: invisible, 8: opaque)
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid or the panel is not RA8875
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ra8875_set_layer_transparency(esp_lcd_panel_handle_t panel, uint8_t layer1_alpha, uint8_t layer2_alpha);
+
+/**
+ * @brief Set transparent color of layer 2 in ESP_LCD_RA8875_LAYER_MODE_TRANSPARENT mode
+ *
+ * @param[in] panel LCD panel handle of RA8875
+ * @param[in] color RGB565 color (converted to RGB332 with 8-bit color depth)
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid or the panel is not RA8875
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ra8875_set_transparent_color(esp_lcd_panel_handle_t panel, uint16_t color);
+
+/**
+ * @brief Scroll layer(s) of RA8875 without redrawing
+ *
+ * The whole screen is scrolled with wrap around, e.g. a static background on layer 1 stays while layer 2 is scrolled.
+ *
+ * @param[in] panel LCD panel handle of RA8875
+ * @param[in] layer Scrolled layer (ESP_LCD_RA8875_LAYER_BOTH in single layer mode)
+ * @param[in] x_offset Horizontal offset of the shown content
+ * @param[in] y_offset Vertical offset of the shown content
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid or the panel is not RA8875
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_ra8875_scroll_layer(esp_lcd_panel_handle_t panel, esp_lcd_ra8875_layer_t layer, int x_offset, int y_offset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,242 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/cdefs.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_idf_version.h"
+#include "esp_lcd_panel_io_interface.h"
+#include "esp_lcd_panel_io_async.h"
+#include "esp_log.h"
+#include "esp_check.h"
+
+static const char *TAG = "io_async";
+
+#if (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0))
+
+/* Parameters up to this size are copied into the queue */
+#define PANEL_IO_ASYNC_PARAM_MAX    16
+
+typedef enum {
+    PANEL_IO_ASYNC_PARAM,   /* Copied parameters */
+    PANEL_IO_ASYNC_COLOR,   /* Color buffer of the caller */
+    PANEL_IO_ASYNC_SYNC,    /* Give sync semaphore, all transfers before are sent */
+    PANEL_IO_ASYNC_STOP,    /* Stop the task */
+} panel_io_async_job_type_t;
+
+typedef struct {
+    panel_io_async_job_type_t type;
+    int lcd_cmd;
+    const void *data;
+    size_t size;
+    uint8_t param[PANEL_IO_ASYNC_PARAM_MAX];
+} panel_io_async_job_t;
+
+typedef struct {
+    esp_lcd_panel_io_t base;
+    esp_lcd_panel_io_handle_t io;       /* Panel IO, which sends the transfers */
+    QueueHandle_t queue;
+    SemaphoreHandle_t sync_sem;
+    TaskHandle_t task;
+    esp_lcd_panel_io_color_trans_done_cb_t on_color_trans_done;
+    void *user_ctx;
+} panel_io_async_t;
+
+static esp_err_t panel_io_async_rx_param(esp_lcd_panel_io_t *io, int lcd_cmd, void *param, size_t param_size);
+static esp_err_t panel_io_async_tx_param(esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size);
+static esp_err_t panel_io_async_tx_color(esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size);
+static esp_err_t panel_io_async_del(esp_lcd_panel_io_t *io);
+static esp_err_t panel_io_async_register_event_callbacks(esp_lcd_panel_io_t *io, const esp_lcd_panel_io_callbacks_t *cbs, void *user_ctx);
+static void panel_io_async_task(void *arg);
+
+esp_err_t esp_lcd_new_panel_io_async(esp_lcd_panel_io_handle_t io, const esp_lcd_panel_io_async_config_t *config, esp_lcd_panel_io_handle_t *ret_io)
+{
+    esp_err_t ret = ESP_OK;
+    panel_io_async_t *async = NULL;
+    ESP_GOTO_ON_FALSE(io && config && ret_io, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    ESP_GOTO_ON_FALSE(config->queue_depth > 0, ESP_ERR_INVALID_ARG, err, TAG, "queue depth must be > 0");
+    async = calloc(1, sizeof(panel_io_async_t));
+    ESP_GOTO_ON_FALSE(async, ESP_ERR_NO_MEM, err, TAG, "no mem for async panel IO");
+
+    async->queue = xQueueCreate(config->queue_depth, sizeof(panel_io_async_job_t));
+    ESP_GOTO_ON_FALSE(async->queue, ESP_ERR_NO_MEM, err, TAG, "no mem for queue");
+    async->sync_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(async->sync_sem, ESP_ERR_NO_MEM, err, TAG, "no mem for semaphore");
+
+    /* Done events are sent from the task of this IO, not from the original IO */
+    if (io->register_event_callbacks) {
+        const esp_lcd_panel_io_callbacks_t cbs = {0};
+        ESP_GOTO_ON_ERROR(io->register_event_callbacks(io, &cbs, NULL), err, TAG, "remove callbacks failed");
+    }
+
+    async->io = io;
+    async->base.rx_param = panel_io_async_rx_param;
+    async->base.tx_param = panel_io_async_tx_param;
+    async->base.tx_color = panel_io_async_tx_color;
+    async->base.del = panel_io_async_del;
+    async->base.register_event_callbacks = panel_io_async_register_event_callbacks;
+
+    BaseType_t res;
+    if (config->task_affinity < 0) {
+        res = xTaskCreate(panel_io_async_task, "io_async", config->task_stack, async, config->task_priority, &async->task);
+    } else {
+        res = xTaskCreatePinnedToCore(panel_io_async_task, "io_async", config->task_stack, async, config->task_priority, &async->task, config->task_affinity);
+    }
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "create task failed");
+
+    *ret_io = &async->base;
+    ESP_LOGD(TAG, "new async panel io @%p", async);
+
+    return ESP_OK;
+
+err:
+    if (async) {
+        if (async->queue) {
+            vQueueDelete(async->queue);
+        }
+        if (async->sync_sem) {
+            vSemaphoreDelete(async->sync_sem);
+        }
+        free(async);
+    }
+    return ret;
+}
+
+/* Wait until all queued transfers are sent */
+static void panel_io_async_sync(panel_io_async_t *async)
+{
+    const panel_io_async_job_t job = {
+        .type = PANEL_IO_ASYNC_SYNC,
+    };
+    xQueueSend(async->queue, &job, portMAX_DELAY);
+    xSemaphoreTake(async->sync_sem, portMAX_DELAY);
+}
+
+static esp_err_t panel_io_async_rx_param(esp_lcd_panel_io_t *io, int lcd_cmd, void *param, size_t param_size)
+{
+    panel_io_async_t *async = __containerof(io, panel_io_async_t, base);
+
+    panel_io_async_sync(async);
+    return esp_lcd_panel_io_rx_param(async->io, lcd_cmd, param, param_size);
+}
+
+static esp_err_t panel_io_async_tx_param(esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size)
+{
+    panel_io_async_t *async = __containerof(io, panel_io_async_t, base);
+
+    if (param_size > PANEL_IO_ASYNC_PARAM_MAX) {
+        panel_io_async_sync(async);
+        return esp_lcd_panel_io_tx_param(async->io, lcd_cmd, param, param_size);
+    }
+
+    panel_io_async_job_t job = {
+        .type = PANEL_IO_ASYNC_PARAM,
+        .lcd_cmd = lcd_cmd,
+        .size = param_size,
+    };
+    if (param && param_size) {
+        memcpy(job.param, param, param_size);
+        job.data = job.param;
+    }
+    xQueueSend(async->queue, &job, portMAX_DELAY);
+
+    return ESP_OK;
+}
+
+static esp_err_t panel_io_async_tx_color(esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size)
+{
+    panel_io_async_t *async = __containerof(io, panel_io_async_t, base);
+
+    const panel_io_async_job_t job = {
+        .type = PANEL_IO_ASYNC_COLOR,
+        .lcd_cmd = lcd_cmd,
+        .data = color,
+        .size = color_size,
+    };
+    xQueueSend(async->queue, &job, portMAX_DELAY);
+
+    return ESP_OK;
+}
+
+static esp_err_t panel_io_async_del(esp_lcd_panel_io_t *io)
+{
+    panel_io_async_t *async = __containerof(io, panel_io_async_t, base);
+
+    /* Queued transfers are sent before the task stops */
+    const panel_io_async_job_t job = {
+        .type = PANEL_IO_ASYNC_STOP,
+    };
+    xQueueSend(async->queue, &job, portMAX_DELAY);
+    xSemaphoreTake(async->sync_sem, portMAX_DELAY);
+
+    esp_err_t ret = esp_lcd_panel_io_del(async->io);
+    vQueueDelete(async->queue);
+    vSemaphoreDelete(async->sync_sem);
+    ESP_LOGD(TAG, "del async panel io @%p", async);
+    free(async);
+
+    return ret;
+}
+
+static esp_err_t panel_io_async_register_event_callbacks(esp_lcd_panel_io_t *io, const esp_lcd_panel_io_callbacks_t *cbs, void *user_ctx)
+{
+    panel_io_async_t *async = __containerof(io, panel_io_async_t, base);
+
+    async->on_color_trans_done = cbs->on_color_trans_done;
+    async->user_ctx = user_ctx;
+
+    return ESP_OK;
+}
+
+static void panel_io_async_task(void *arg)
+{
+    panel_io_async_t *async = (panel_io_async_t *)arg;
+    panel_io_async_job_t job;
+    esp_err_t ret;
+
+    while (xQueueReceive(async->queue, &job, portMAX_DELAY) == pdTRUE && job.type != PANEL_IO_ASYNC_STOP) {
+        switch (job.type) {
+        case PANEL_IO_ASYNC_PARAM:
+            ret = esp_lcd_panel_io_tx_param(async->io, job.lcd_cmd, job.data, job.size);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "send param 0x%02x failed (%s)", job.lcd_cmd, esp_err_to_name(ret));
+            }
+            break;
+        case PANEL_IO_ASYNC_COLOR:
+            ret = esp_lcd_panel_io_tx_color(async->io, job.lcd_cmd, job.data, job.size);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "send color failed (%s)", esp_err_to_name(ret));
+            }
+            /* Called on error too, the caller must not wait forever */
+            if (async->on_color_trans_done && async->on_color_trans_done(&async->base, NULL, async->user_ctx)) {
+                taskYIELD();
+            }
+            break;
+        case PANEL_IO_ASYNC_SYNC:
+            xSemaphoreGive(async->sync_sem);
+            break;
+        default:
+            break;
+        }
+    }
+
+    xSemaphoreGive(async->sync_sem);
+    vTaskDelete(NULL);
+}
+
+#else
+
+esp_err_t esp_lcd_new_panel_io_async(esp_lcd_panel_io_handle_t io, const esp_lcd_panel_io_async_config_t *config, esp_lcd_panel_io_handle_t *ret_io)
+{
+    ESP_LOGE(TAG, "async panel IO requires ESP-IDF v5.0 or newer");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif
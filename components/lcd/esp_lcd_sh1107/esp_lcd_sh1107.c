@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -192,7 +192,7 @@ static esp_err_t panel_sh1107_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
     uint8_t column_low = 0;
     uint8_t column_high = 0;
     uint8_t row_start = 0, row_end = 0;
-    const uint16_t *ptr;
+    const uint8_t *ptr;
     uint32_t size = 0;
 
     // adding extra gap
@@ -231,8 +231,9 @@ static esp_err_t panel_sh1107_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
             0xB0 | i
         }, 1);
 
-        ptr = color_data + i * x_end;
-        esp_lcd_panel_io_tx_color(io, LCD_SH1107_I2C_RAM, (uint8_t *)ptr, size);
+        /* color_data holds the pages of the area, size bytes each */
+        ptr = (const uint8_t *)color_data + (i - row_start) * size;
+        esp_lcd_panel_io_tx_color(io, LCD_SH1107_I2C_RAM, ptr, size);
     }
 
     return ESP_OK;
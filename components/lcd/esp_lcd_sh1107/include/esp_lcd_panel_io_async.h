@@ -0,0 +1,66 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/**
+ * @file
+ * @brief ESP LCD: Asynchronous panel IO
+ */
+
+#pragma once
+
+#include "esp_lcd_panel_io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Configuration of the asynchronous panel IO
+ */
+typedef struct {
+    uint32_t queue_depth;   /*!< Count of queued transfers (commands and colors), the caller blocks when the queue is full */
+    uint32_t task_priority; /*!< Priority of the task sending the transfers */
+    uint32_t task_stack;    /*!< Stack of the task sending the transfers */
+    int task_affinity;      /*!< Core of the task sending the transfers (-1 for no affinity) */
+} esp_lcd_panel_io_async_config_t;
+
+/**
+ * @brief Default configuration of the asynchronous panel IO
+ *
+ * The queue holds one whole frame of 128x64 SH1107 or SSD1306 panel (4 transfers of each page).
+ */
+#define ESP_LCD_PANEL_IO_ASYNC_CONFIG()     \
+    {                                       \
+        .queue_depth = 64,                  \
+        .task_priority = 5,                 \
+        .task_stack = 3072,                 \
+        .task_affinity = -1,                \
+    }
+
+/**
+ * @brief Create asynchronous panel IO over existing panel IO (e.g. I2C panel IO of SH1107 or SSD1306)
+ *
+ * Transfers are queued and sent by a task, so the caller (e.g. LVGL task) does not wait for the bus.
+ * The `on_color_trans_done` callback is called from this task after each color transfer is sent,
+ * the color buffer must be valid until then. Parameters up to 16 bytes are copied into the queue,
+ * longer parameters and reading of parameters wait until the queue is sent.
+ *
+ * @note The returned IO owns the `io`, deleting the returned IO deletes the `io` too.
+ * @note Callbacks registered before to the `io` are removed.
+ *
+ * @param[in] io Panel IO handle, which sends the transfers
+ * @param[in] config Configuration of the asynchronous panel IO
+ * @param[out] ret_io Returned asynchronous panel IO handle
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_ERR_NO_MEM        if out of memory
+ *          - ESP_ERR_NOT_SUPPORTED if ESP-IDF is older than v5.0
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_new_panel_io_async(esp_lcd_panel_io_handle_t io, const esp_lcd_panel_io_async_config_t *config, esp_lcd_panel_io_handle_t *ret_io);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,7 @@
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "sdkconfig.h"
 #if CONFIG_LCD_ENABLE_DEBUG_LOG
 // The local log level must be defined before including esp_log.h
@@ -26,6 +27,8 @@
 #define SSD1681_LUT_SIZE                   159
 #define SSD1681_EPD_1IN54_V2_WIDTH         200
 #define SSD1681_EPD_1IN54_V2_HEIGHT        200
+#define SSD1681_EPD_1IN54_V2_ROW_BYTES     (SSD1681_EPD_1IN54_V2_WIDTH / 8)
+#define SSD1681_EPD_1IN54_V2_FRAME_SIZE    (SSD1681_EPD_1IN54_V2_ROW_BYTES * SSD1681_EPD_1IN54_V2_HEIGHT)
 
 
 static const char *TAG = "lcd_panel.epaper";
@@ -35,6 +38,14 @@ typedef struct {
     void *args;
 } epaper_panel_callback_t;
 
+// Window of VRAM, X in bytes, both ends included (empty if x0 > x1)
+typedef struct {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+} epaper_area_t;
+
 typedef struct {
     esp_lcd_panel_t base;
     esp_lcd_panel_io_handle_t io;
@@ -61,12 +72,38 @@ typedef struct {
     bool _mirror_x;
     uint8_t *_framebuffer;
     bool _invert_color;
+    // --- Partial refresh (epaper_panel_set_refresh_mode)
+    esp_lcd_ssd1681_refresh_mode_t refresh_mode;
+    uint16_t full_refresh_interval;
+    uint16_t _partial_cnt;       // Partial refreshes since the last full refresh
+    uint8_t *_vram_shadow;       // Image in BLACK VRAM
+    uint8_t *_disp_shadow;       // Image shown on the panel
+    bool _vram_valid;            // _vram_shadow is known (whole panel was drawn)
+    bool _disp_valid;            // _disp_shadow is known (full refresh of valid VRAM)
+    epaper_area_t _red_stale;    // Window where RED VRAM differs from the shown image
+    // --- Asynchronous refresh (epaper_panel_set_async_refresh)
+    TaskHandle_t _async_task;
+    SemaphoreHandle_t _async_lock;  // Guards the pending images and the transfer to VRAM
+    uint8_t *_pending[2];           // Copies of BLACK and RED VRAM with the frames drawn after the last transfer
+    epaper_area_t _pending_area[2]; // Windows not transferred into VRAM yet
+    bool _pending_synced;           // VRAM was written whole from the copies
+    bool _refresh_requested;        // Refresh after the transfer
 } epaper_panel_t;
 
 // --- Utility functions
 static inline uint8_t byte_reverse(uint8_t data);
+static inline void transpose_8x8(const uint8_t *in, int in_stride, uint8_t *out);
 static esp_err_t process_bitmap(esp_lcd_panel_t *panel, int len_x, int len_y, int buffer_size, const void *color_data);
 static esp_err_t panel_epaper_wait_busy(esp_lcd_panel_t *panel);
+static inline void area_union(epaper_area_t *area, const epaper_area_t *other);
+static bool partial_diff_window(epaper_panel_t *epaper_panel, int x_start, int y_start, int len_x, int len_y, epaper_area_t *dirty);
+static esp_err_t partial_write_area(epaper_panel_t *epaper_panel, int cmd, const uint8_t *frame, const epaper_area_t *area);
+static esp_err_t epaper_panel_refresh_partial(epaper_panel_t *epaper_panel);
+static esp_err_t epaper_panel_start_refresh(epaper_panel_t *epaper_panel);
+static void epaper_async_merge(epaper_panel_t *epaper_panel, int x_start, int y_start, int len_x, int len_y);
+static esp_err_t epaper_async_transfer(epaper_panel_t *epaper_panel);
+static void epaper_async_task(void *arg);
+static void epaper_async_stop(epaper_panel_t *epaper_panel);
 // --- Callback functions & ISRs
 static void epaper_driver_gpio_isr_handler(void *arg);
 // --- IO wrapper functions, simply send command/param/buffer
@@ -81,6 +118,8 @@ static esp_err_t panel_epaper_set_vram(esp_lcd_panel_io_handle_t io, uint8_t *bw
 // extern esp_err_t epaper_panel_refresh_screen(esp_lcd_panel_t *panel);
 // extern esp_err_t epaper_panel_set_bitmap_color(esp_lcd_panel_t* panel, esp_lcd_ssd1681_bitmap_color_t color);
 // extern esp_err_t epaper_panel_set_custom_lut(esp_lcd_panel_t *panel, uint8_t *lut, size_t size);
+// extern esp_err_t epaper_panel_set_refresh_mode(esp_lcd_panel_t *panel, esp_lcd_ssd1681_refresh_mode_t mode, uint16_t full_refresh_interval);
+// extern esp_err_t epaper_panel_set_async_refresh(esp_lcd_panel_t *panel, const esp_lcd_ssd1681_async_config_t *config);
 // --- Used to implement esp_lcd_panel_interface
 static esp_err_t epaper_panel_del(esp_lcd_panel_t *panel);
 static esp_err_t epaper_panel_reset(esp_lcd_panel_t *panel);
@@ -96,12 +135,22 @@ static esp_err_t epaper_panel_disp_on_off(esp_lcd_panel_t *panel, bool on_off);
 static void epaper_driver_gpio_isr_handler(void *arg)
 {
     epaper_panel_t *epaper_panel = arg;
+    BaseType_t need_yield = pdFALSE;
     // --- Disable ISR handling
     gpio_intr_disable(epaper_panel->busy_gpio_num);
 
     // --- Call user callback func
     if (epaper_panel->epaper_refresh_done_isr_callback.callback_ptr) {
-        (epaper_panel->epaper_refresh_done_isr_callback.callback_ptr)(&(epaper_panel->base), NULL, epaper_panel->epaper_refresh_done_isr_callback.args);
+        if ((epaper_panel->epaper_refresh_done_isr_callback.callback_ptr)(&(epaper_panel->base), NULL, epaper_panel->epaper_refresh_done_isr_callback.args)) {
+            need_yield = pdTRUE;
+        }
+    }
+    // --- Start the next queued refresh
+    if (epaper_panel->_async_task) {
+        vTaskNotifyGiveFromISR(epaper_panel->_async_task, &need_yield);
+    }
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
     }
 }
 
@@ -209,10 +258,114 @@ esp_err_t panel_epaper_set_vram(esp_lcd_panel_io_handle_t io, uint8_t *bw_bitmap
     return ESP_OK;
 }
 
+esp_err_t epaper_panel_set_refresh_mode(esp_lcd_panel_t *panel, esp_lcd_ssd1681_refresh_mode_t mode, uint16_t full_refresh_interval)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "panel handler is NULL");
+    epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    if (mode == SSD1681_EPAPER_REFRESH_PARTIAL) {
+        ESP_RETURN_ON_FALSE(!(epaper_panel->_non_copy_mode), ESP_ERR_NOT_SUPPORTED, TAG, "partial refresh is unavailable when enabling non-copy mode");
+        ESP_RETURN_ON_FALSE(!(epaper_panel->_async_task), ESP_ERR_INVALID_STATE, TAG, "partial refresh is unavailable with async refresh");
+        if (!(epaper_panel->_vram_shadow)) {
+            epaper_panel->_vram_shadow = calloc(1, SSD1681_EPD_1IN54_V2_FRAME_SIZE);
+            epaper_panel->_disp_shadow = calloc(1, SSD1681_EPD_1IN54_V2_FRAME_SIZE);
+            if (!(epaper_panel->_vram_shadow) || !(epaper_panel->_disp_shadow)) {
+                free(epaper_panel->_vram_shadow);
+                free(epaper_panel->_disp_shadow);
+                epaper_panel->_vram_shadow = NULL;
+                epaper_panel->_disp_shadow = NULL;
+                ESP_LOGE(TAG, "no mem for partial refresh shadows");
+                return ESP_ERR_NO_MEM;
+            }
+            // VRAM content is unknown until the whole panel is drawn, the first refresh will be full
+            epaper_panel->_vram_valid = false;
+            epaper_panel->_disp_valid = false;
+        }
+    } else {
+        ESP_RETURN_ON_FALSE(mode == SSD1681_EPAPER_REFRESH_FULL, ESP_ERR_INVALID_ARG, TAG, "invalid refresh mode");
+        free(epaper_panel->_vram_shadow);
+        free(epaper_panel->_disp_shadow);
+        epaper_panel->_vram_shadow = NULL;
+        epaper_panel->_disp_shadow = NULL;
+    }
+    epaper_panel->refresh_mode = mode;
+    epaper_panel->full_refresh_interval = full_refresh_interval;
+    epaper_panel->_partial_cnt = 0;
+    return ESP_OK;
+}
+
+esp_err_t epaper_panel_set_async_refresh(esp_lcd_panel_t *panel, const esp_lcd_ssd1681_async_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "panel handler is NULL");
+    epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    esp_err_t ret = ESP_OK;
+    if (!config) {
+        epaper_async_stop(epaper_panel);
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_FALSE(!(epaper_panel->_async_task), ESP_ERR_INVALID_STATE, TAG, "async refresh is already enabled");
+    ESP_RETURN_ON_FALSE(epaper_panel->refresh_mode == SSD1681_EPAPER_REFRESH_FULL, ESP_ERR_INVALID_STATE, TAG,
+                        "async refresh is unavailable with partial refresh");
+    ESP_RETURN_ON_FALSE(epaper_panel->busy_gpio_num >= 0, ESP_ERR_NOT_SUPPORTED, TAG, "async refresh needs BUSY pin");
+
+    for (int i = 0; i < 2; i++) {
+        epaper_panel->_pending[i] = heap_caps_calloc(1, SSD1681_EPD_1IN54_V2_FRAME_SIZE, MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(epaper_panel->_pending[i], ESP_ERR_NO_MEM, err, TAG, "no mem for pending images");
+        epaper_panel->_pending_area[i] = (epaper_area_t) {
+            .x0 = SSD1681_EPD_1IN54_V2_ROW_BYTES, .x1 = -1, .y0 = SSD1681_EPD_1IN54_V2_HEIGHT, .y1 = -1
+        };
+    }
+    epaper_panel->_pending_synced = false;
+    epaper_panel->_refresh_requested = false;
+    epaper_panel->_async_lock = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(epaper_panel->_async_lock, ESP_ERR_NO_MEM, err, TAG, "no mem for async lock");
+    BaseType_t res;
+    if (config->task_affinity < 0) {
+        res = xTaskCreate(epaper_async_task, "epaper", config->task_stack, epaper_panel, config->task_priority, &epaper_panel->_async_task);
+    } else {
+        res = xTaskCreatePinnedToCore(epaper_async_task, "epaper", config->task_stack, epaper_panel, config->task_priority,
+                                      &epaper_panel->_async_task, config->task_affinity);
+    }
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "create async refresh task fail");
+    return ESP_OK;
+err:
+    epaper_async_stop(epaper_panel);
+    return ret;
+}
+
 esp_err_t epaper_panel_refresh_screen(esp_lcd_panel_t *panel)
 {
     ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "panel handler is NULL");
     epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
+    if (epaper_panel->_async_task) {
+        // Queue the refresh, the task starts it when the panel is idle
+        xSemaphoreTake(epaper_panel->_async_lock, portMAX_DELAY);
+        epaper_panel->_refresh_requested = true;
+        xSemaphoreGive(epaper_panel->_async_lock);
+        xTaskNotifyGive(epaper_panel->_async_task);
+        return ESP_OK;
+    }
+    return epaper_panel_start_refresh(epaper_panel);
+}
+
+static esp_err_t epaper_panel_start_refresh(epaper_panel_t *epaper_panel)
+{
+    if (epaper_panel->refresh_mode == SSD1681_EPAPER_REFRESH_PARTIAL) {
+        // Full refresh when the shown image is unknown and periodically against ghosting
+        if (epaper_panel->_vram_valid && epaper_panel->_disp_valid &&
+                !(epaper_panel->full_refresh_interval && epaper_panel->_partial_cnt >= epaper_panel->full_refresh_interval)) {
+            epaper_panel->_partial_cnt++;
+            return epaper_panel_refresh_partial(epaper_panel);
+        }
+        // RED VRAM will be rewritten by the next partial refresh
+        epaper_panel->_partial_cnt = 0;
+        epaper_panel->_red_stale = (epaper_area_t) {
+            0, 0, SSD1681_EPD_1IN54_V2_ROW_BYTES - 1, SSD1681_EPD_1IN54_V2_HEIGHT - 1
+        };
+        if (epaper_panel->_vram_valid) {
+            memcpy(epaper_panel->_disp_shadow, epaper_panel->_vram_shadow, SSD1681_EPD_1IN54_V2_FRAME_SIZE);
+            epaper_panel->_disp_valid = true;
+        }
+    }
     // --- Set color invert
     uint8_t duc_flag = 0x00;
     if (!(epaper_panel->_invert_color)) {
@@ -238,6 +391,146 @@ esp_err_t epaper_panel_refresh_screen(esp_lcd_panel_t *panel)
     return ESP_OK;
 }
 
+static void epaper_async_merge(epaper_panel_t *epaper_panel, int x_start, int y_start, int len_x, int len_y)
+{
+    // Framebuffer holds the window row by row (DATA ENTRY MODE 3), newer frames overwrite older ones
+    const int color = (epaper_panel->bitmap_color == SSD1681_EPAPER_BITMAP_RED) ? 1 : 0;
+    const int win_bytes = len_x / 8;
+    uint8_t *dst = epaper_panel->_pending[color] + y_start * SSD1681_EPD_1IN54_V2_ROW_BYTES + x_start / 8;
+    for (int y = 0; y < len_y; y++) {
+        memcpy(dst + y * SSD1681_EPD_1IN54_V2_ROW_BYTES, epaper_panel->_framebuffer + y * win_bytes, win_bytes);
+    }
+    const epaper_area_t area = {x_start / 8, y_start, x_start / 8 + win_bytes - 1, y_start + len_y - 1};
+    area_union(&epaper_panel->_pending_area[color], &area);
+}
+
+static esp_err_t epaper_async_transfer(epaper_panel_t *epaper_panel)
+{
+    static const int cmds[2] = {SSD1681_CMD_WRITE_BLACK_VRAM, SSD1681_CMD_WRITE_RED_VRAM};
+    for (int i = 0; i < 2; i++) {
+        epaper_area_t *area = &epaper_panel->_pending_area[i];
+        // VRAM content is unknown after init, so the first transfer writes whole copies
+        if (!(epaper_panel->_pending_synced)) {
+            *area = (epaper_area_t) {
+                0, 0, SSD1681_EPD_1IN54_V2_ROW_BYTES - 1, SSD1681_EPD_1IN54_V2_HEIGHT - 1
+            };
+        }
+        if (area->x0 > area->x1) {
+            continue;
+        }
+        // Whole rows are contiguous in the copy, no compaction is needed
+        ESP_RETURN_ON_ERROR(epaper_set_area(epaper_panel->io, 0, area->y0, SSD1681_EPD_1IN54_V2_WIDTH - 1, area->y1), TAG,
+                            "epaper_set_area() error");
+        ESP_RETURN_ON_ERROR(epaper_set_cursor(epaper_panel->io, 0, area->y0), TAG,
+                            "epaper_set_cursor() error");
+        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_DATA_ENTRY_MODE, (uint8_t[]) {
+            SSD1681_PARAM_DATA_ENTRY_MODE_3
+        }, 1), TAG, "SSD1681_CMD_DATA_ENTRY_MODE err");
+        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_color(epaper_panel->io, cmds[i],
+                            epaper_panel->_pending[i] + area->y0 * SSD1681_EPD_1IN54_V2_ROW_BYTES,
+                            (area->y1 - area->y0 + 1) * SSD1681_EPD_1IN54_V2_ROW_BYTES), TAG, "epaper_async_transfer tx err");
+        *area = (epaper_area_t) {
+            .x0 = SSD1681_EPD_1IN54_V2_ROW_BYTES, .x1 = -1, .y0 = SSD1681_EPD_1IN54_V2_HEIGHT, .y1 = -1
+        };
+    }
+    epaper_panel->_pending_synced = true;
+    return ESP_OK;
+}
+
+static void epaper_async_task(void *arg)
+{
+    epaper_panel_t *epaper_panel = arg;
+    while (1) {
+        // Woken by epaper_panel_refresh_screen() and by the BUSY ISR when the refresh finishes
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (gpio_get_level(epaper_panel->busy_gpio_num)) {
+            // Still refreshing, the BUSY ISR wakes the task again
+            continue;
+        }
+        xSemaphoreTake(epaper_panel->_async_lock, portMAX_DELAY);
+        if (epaper_panel->_refresh_requested) {
+            epaper_panel->_refresh_requested = false;
+            // tx_param waits for the transfer, the copies are not modified until the lock is given
+            if (epaper_async_transfer(epaper_panel) != ESP_OK || epaper_panel_start_refresh(epaper_panel) != ESP_OK) {
+                ESP_LOGE(TAG, "async refresh failed");
+            }
+        }
+        xSemaphoreGive(epaper_panel->_async_lock);
+    }
+}
+
+static void epaper_async_stop(epaper_panel_t *epaper_panel)
+{
+    if (epaper_panel->_async_task) {
+        // The task does not hold the lock when it is deleted
+        xSemaphoreTake(epaper_panel->_async_lock, portMAX_DELAY);
+        vTaskDelete(epaper_panel->_async_task);
+        epaper_panel->_async_task = NULL;
+        xSemaphoreGive(epaper_panel->_async_lock);
+    }
+    if (epaper_panel->_async_lock) {
+        vSemaphoreDelete(epaper_panel->_async_lock);
+        epaper_panel->_async_lock = NULL;
+    }
+    for (int i = 0; i < 2; i++) {
+        free(epaper_panel->_pending[i]);
+        epaper_panel->_pending[i] = NULL;
+    }
+}
+
+static esp_err_t epaper_panel_refresh_partial(epaper_panel_t *epaper_panel)
+{
+    // --- Changed bytes between VRAM and the shown image
+    epaper_area_t dirty = {.x0 = SSD1681_EPD_1IN54_V2_ROW_BYTES, .x1 = -1, .y0 = SSD1681_EPD_1IN54_V2_HEIGHT, .y1 = -1};
+    for (int y = 0; y < SSD1681_EPD_1IN54_V2_HEIGHT; y++) {
+        const uint8_t *vram_row = epaper_panel->_vram_shadow + y * SSD1681_EPD_1IN54_V2_ROW_BYTES;
+        const uint8_t *disp_row = epaper_panel->_disp_shadow + y * SSD1681_EPD_1IN54_V2_ROW_BYTES;
+        if (memcmp(vram_row, disp_row, SSD1681_EPD_1IN54_V2_ROW_BYTES) == 0) {
+            continue;
+        }
+        for (int x = 0; x < SSD1681_EPD_1IN54_V2_ROW_BYTES; x++) {
+            if (vram_row[x] != disp_row[x]) {
+                const epaper_area_t byte = {x, y, x, y};
+                area_union(&dirty, &byte);
+            }
+        }
+    }
+    // --- RED VRAM is the previous image of DISPLAY Mode 2, it must hold the shown image
+    // Also outside the changed window, where the last partial refresh left it stale
+    epaper_area_t red = epaper_panel->_red_stale;
+    area_union(&red, &dirty);
+    if (red.x0 <= red.x1) {
+        ESP_RETURN_ON_ERROR(partial_write_area(epaper_panel, SSD1681_CMD_WRITE_RED_VRAM, epaper_panel->_disp_shadow, &red), TAG,
+                            "partial_write_area() error");
+    }
+    for (int y = dirty.y0; y <= dirty.y1; y++) {
+        const int offset = y * SSD1681_EPD_1IN54_V2_ROW_BYTES + dirty.x0;
+        memcpy(epaper_panel->_disp_shadow + offset, epaper_panel->_vram_shadow + offset, dirty.x1 - dirty.x0 + 1);
+    }
+    epaper_panel->_red_stale = dirty;
+    ESP_LOGD(TAG, "partial refresh, changed bytes x %d-%d, y %d-%d", dirty.x0, dirty.x1, dirty.y0, dirty.y1);
+
+    // --- Both VRAMs must have the same polarity to compare them
+    uint8_t duc_flag = 0x00;
+    if (!(epaper_panel->_invert_color)) {
+        duc_flag |= (SSD1681_PARAM_COLOR_BW_INVERSE_BIT | SSD1681_PARAM_COLOR_RW_INVERSE_BIT);
+    }
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_DISP_UPDATE_CTRL, (uint8_t[]) {
+        duc_flag  // Color invert flag
+    }, 1), TAG, "SSD1681_CMD_DISP_UPDATE_CTRL err");
+    // --- Enable refresh done handler isr
+    gpio_intr_enable(epaper_panel->busy_gpio_num);
+    // --- Send partial refresh command
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_SET_DISP_UPDATE_CTRL, (uint8_t[]) {
+        SSD1681_PARAM_DISP_PARTIAL
+    }, 1), TAG, "SSD1681_CMD_SET_DISP_UPDATE_CTRL err");
+
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ, NULL, 0), TAG,
+                        "SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ err");
+
+    return ESP_OK;
+}
+
 esp_err_t
 esp_lcd_new_panel_ssd1681(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *const panel_dev_config,
                           esp_lcd_panel_handle_t *const ret_panel)
@@ -264,6 +557,7 @@ esp_lcd_new_panel_ssd1681(const esp_lcd_panel_io_handle_t io, const esp_lcd_pane
     epaper_panel->gap_y = 0;
     epaper_panel->bitmap_color = SSD1681_EPAPER_BITMAP_BLACK;
     epaper_panel->full_refresh = true;
+    epaper_panel->refresh_mode = SSD1681_EPAPER_REFRESH_FULL;
     // configurations
     epaper_panel->io = io;
     epaper_panel->reset_gpio_num = panel_dev_config->reset_gpio_num;
@@ -283,7 +577,7 @@ esp_lcd_new_panel_ssd1681(const esp_lcd_panel_io_handle_t io, const esp_lcd_pane
     *ret_panel = &(epaper_panel->base);
     // --- Init framebuffer
     if (!(epaper_panel->_non_copy_mode)) {
-        epaper_panel->_framebuffer = heap_caps_malloc(SSD1681_EPD_1IN54_V2_WIDTH * SSD1681_EPD_1IN54_V2_HEIGHT / 8,
+        epaper_panel->_framebuffer = heap_caps_malloc(SSD1681_EPD_1IN54_V2_FRAME_SIZE,
                                      MALLOC_CAP_DMA);
         ESP_RETURN_ON_FALSE(epaper_panel->_framebuffer, ESP_ERR_NO_MEM, TAG, "epaper_panel_draw_bitmap allocating buffer memory err");
     }
@@ -339,6 +633,9 @@ static esp_err_t epaper_panel_del(esp_lcd_panel_t *panel)
         // Should not free if buffer is not allocated by driver
         free(epaper_panel->_framebuffer);
     }
+    free(epaper_panel->_vram_shadow);
+    free(epaper_panel->_disp_shadow);
+    epaper_async_stop(epaper_panel);
     ESP_LOGD(TAG, "del ssd1681 epaper panel @%p", epaper_panel);
     free(epaper_panel);
     return ESP_OK;
@@ -414,7 +711,8 @@ static esp_err_t
 epaper_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int y_start, int x_end, int y_end, const void *color_data)
 {
     epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
-    if (gpio_get_level(epaper_panel->busy_gpio_num)) {
+    // Async refresh queues the bitmap also during refresh
+    if (!(epaper_panel->_async_task) && gpio_get_level(epaper_panel->busy_gpio_num)) {
         return ESP_ERR_NOT_FINISHED;
     }
     x_start += epaper_panel->gap_x;
@@ -443,7 +741,44 @@ epaper_panel_draw_bitmap(esp_lcd_panel_t *panel, int x_start, int y_start, int x
         }
     } else {
         // Copy & convert image according to configuration
-        process_bitmap(panel, len_x, len_y, buffer_size, color_data);
+        ESP_RETURN_ON_FALSE(buffer_size <= SSD1681_EPD_1IN54_V2_FRAME_SIZE, ESP_ERR_INVALID_ARG, TAG, "bitmap is larger than the panel");
+        ESP_RETURN_ON_ERROR(process_bitmap(panel, len_x, len_y, buffer_size, color_data), TAG, "process_bitmap error");
+    }
+    // --- Async refresh: the bitmap is merged into the pending copy, the task transfers it when the panel is idle
+    if (epaper_panel->_async_task) {
+        ESP_RETURN_ON_FALSE((epaper_panel->_mirror_x == epaper_panel->_mirror_y) && ((x_start % 8) == 0) && ((len_x % 8) == 0) &&
+                            (x_start >= 0) && (y_start >= 0) && (x_end < SSD1681_EPD_1IN54_V2_WIDTH) && (y_end < SSD1681_EPD_1IN54_V2_HEIGHT),
+                            ESP_ERR_INVALID_ARG, TAG, "async refresh needs byte-aligned window and mirror_x equal to mirror_y");
+        xSemaphoreTake(epaper_panel->_async_lock, portMAX_DELAY);
+        epaper_async_merge(epaper_panel, x_start, y_start, len_x, len_y);
+        xSemaphoreGive(epaper_panel->_async_lock);
+        return ESP_OK;
+    }
+    // --- Partial refresh: only the changed window is written into VRAM
+    if (epaper_panel->refresh_mode == SSD1681_EPAPER_REFRESH_PARTIAL) {
+        // Framebuffer holds the window row by row only with DATA ENTRY MODE 3 and no swap
+        const bool entry_mode_3 = (epaper_panel->_mirror_x == epaper_panel->_mirror_y) && !(epaper_panel->_swap_xy);
+        const bool aligned = ((x_start % 8) == 0) && ((len_x % 8) == 0) && (x_start >= 0) && (y_start >= 0) &&
+                             (x_end < SSD1681_EPD_1IN54_V2_WIDTH) && (y_end < SSD1681_EPD_1IN54_V2_HEIGHT);
+        if (epaper_panel->bitmap_color == SSD1681_EPAPER_BITMAP_RED) {
+            // RED VRAM gets own content, the next refresh is full
+            epaper_panel->_disp_valid = false;
+        } else if (!entry_mode_3 || !aligned) {
+            // VRAM content cannot be tracked
+            epaper_panel->_vram_valid = false;
+        } else {
+            epaper_area_t dirty;
+            if (!partial_diff_window(epaper_panel, x_start, y_start, len_x, len_y, &dirty)) {
+                // Nothing changed, VRAM already holds the bitmap
+                return ESP_OK;
+            }
+            x_start = dirty.x0 * 8;
+            x_end = dirty.x1 * 8 + 7;
+            y_start = dirty.y0;
+            y_end = dirty.y1;
+            len_x = x_end - x_start + 1;
+            len_y = y_end - y_start + 1;
+        }
     }
     // --- Set cursor & data entry sequence
     if ((!(epaper_panel->_mirror_x)) && (!(epaper_panel->_mirror_y))) {
@@ -576,68 +911,144 @@ static esp_err_t epaper_panel_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
 static esp_err_t process_bitmap(esp_lcd_panel_t *panel, int len_x, int len_y, int buffer_size, const void *color_data)
 {
     epaper_panel_t *epaper_panel = __containerof(panel, epaper_panel_t, base);
-    // --- Convert image according to configuration
-    if ((!(epaper_panel->_mirror_x)) && (!(epaper_panel->_mirror_y))) {
-        if (!(epaper_panel->_non_copy_mode)) {
-            if (epaper_panel->_swap_xy) {
-                memset(epaper_panel->_framebuffer, 0, 200 * 200 / 8);
-                for (int i = 0; i < buffer_size * 8; i++) {
-                    uint8_t bitmap_byte = ((uint8_t *) (color_data))[i / 8];
-                    uint8_t bitmap_pixel = (bitmap_byte & (0x01 << (7 - (i % 8)))) ? 0x01 : 0x00;
-                    (epaper_panel->_framebuffer)[((i * len_y / 8) % buffer_size) + (i / 8 / len_x)] |= (bitmap_pixel << (7 - ((i / len_x) % 8)));
-                }
-            } else {
-                for (int i = 0; i < buffer_size; i++) {
-                    (epaper_panel->_framebuffer)[i] = ((uint8_t *) (color_data))[i];
-                }
-            }
-        }
+    // Non-copy mode sends the bitmap as it is (mirror_y and swap_xy are rejected in this mode)
+    if (epaper_panel->_non_copy_mode) {
+        return ESP_OK;
     }
-    if ((!(epaper_panel->_mirror_x)) && (epaper_panel->_mirror_y)) {
-        if (epaper_panel->_swap_xy) {
-            memset((epaper_panel->_framebuffer), 0, 200 * 200 / 8);
-            for (int i = 0; i < buffer_size * 8; i++) {
-                uint8_t bitmap_byte = ((uint8_t *) (color_data))[i / 8];
-                uint8_t bitmap_pixel = (bitmap_byte & (0x01 << (7 - (i % 8)))) ? 0x01 : 0x00;
-                (epaper_panel->_framebuffer)[buffer_size - (((i * len_y / 8) % buffer_size) + (i / 8 / len_x)) - 1] |= (bitmap_pixel << (((i / len_x) % 8)));
-            }
+    const uint8_t *src = (const uint8_t *) color_data;
+    uint8_t *dst = epaper_panel->_framebuffer;
+    // mirror_x is done by the data entry mode, mirror_y rotates the window by 180 deg (reversed byte and bit order)
+    const bool rotate = epaper_panel->_mirror_y;
+    // --- No swap, plain copy
+    if (!(epaper_panel->_swap_xy)) {
+        if (!rotate) {
+            memcpy(dst, src, buffer_size);
         } else {
             for (int i = 0; i < buffer_size; i++) {
-                (epaper_panel->_framebuffer)[buffer_size - i - 1] = byte_reverse(((uint8_t *)(color_data))[i]);
+                dst[buffer_size - i - 1] = byte_reverse(src[i]);
             }
         }
+        return ESP_OK;
     }
-    if (((epaper_panel->_mirror_x)) && (!(epaper_panel->_mirror_y))) {
-        if (!(epaper_panel->_non_copy_mode)) {
-            if (epaper_panel->_swap_xy) {
-                memset((epaper_panel->_framebuffer), 0, 200 * 200 / 8);
-                for (int i = 0; i < buffer_size * 8; i++) {
-                    uint8_t bitmap_byte = ((uint8_t *) (color_data))[i / 8];
-                    uint8_t bitmap_pixel = (bitmap_byte & (0x01 << (7 - (i % 8)))) ? 0x01 : 0x00;
-                    (epaper_panel->_framebuffer)[((i * len_y / 8) % buffer_size) + (i / 8 / len_x)] |= (bitmap_pixel << (7 - ((i / len_x) % 8)));
-                }
-            } else {
-                for (int i = 0; i < buffer_size; i++) {
-                    (epaper_panel->_framebuffer)[i] = ((uint8_t *) (color_data))[i];
+    // --- Swap, transpose by blocks of 8x8 pixels (the source row of len_x pixels becomes the column)
+    ESP_RETURN_ON_FALSE(((len_x % 8) == 0) && ((len_y % 8) == 0), ESP_ERR_INVALID_ARG, TAG,
+                        "swap-xy needs bitmap width and height multiple of 8");
+    const int src_stride = len_x / 8;
+    const int dst_stride = len_y / 8;
+    uint8_t block[8];
+    for (int block_y = 0; block_y < dst_stride; block_y++) {
+        for (int block_x = 0; block_x < src_stride; block_x++) {
+            transpose_8x8(src + block_y * 8 * src_stride + block_x, src_stride, block);
+            int dst_idx = block_x * 8 * dst_stride + block_y;
+            for (int i = 0; i < 8; i++, dst_idx += dst_stride) {
+                if (rotate) {
+                    dst[buffer_size - dst_idx - 1] = byte_reverse(block[i]);
+                } else {
+                    dst[dst_idx] = block[i];
                 }
             }
         }
     }
-    if (((epaper_panel->_mirror_x)) && (epaper_panel->_mirror_y)) {
-        if (epaper_panel->_swap_xy) {
-            memset((epaper_panel->_framebuffer), 0, 200 * 200 / 8);
-            for (int i = 0; i < buffer_size * 8; i++) {
-                uint8_t bitmap_byte = ((uint8_t *) (color_data))[i / 8];
-                uint8_t bitmap_pixel = (bitmap_byte & (0x01 << (7 - (i % 8)))) ? 0x01 : 0x00;
-                (epaper_panel->_framebuffer)[buffer_size - (((i * len_y / 8) % buffer_size) + (i / 8 / len_x)) - 1] |= (bitmap_pixel << (((i / len_x) % 8)));
-            }
-        } else {
-            for (int i = 0; i < buffer_size; i++) {
-                (epaper_panel->_framebuffer)[buffer_size - i - 1] = byte_reverse(((uint8_t *)(color_data))[i]);
+
+    return ESP_OK;
+}
+
+static inline void transpose_8x8(const uint8_t *in, int in_stride, uint8_t *out)
+{
+    // Bit matrix transpose (MSB is the first pixel), see Hacker's Delight 7-3
+    uint32_t x = ((uint32_t)in[0] << 24) | ((uint32_t)in[in_stride] << 16) | ((uint32_t)in[2 * in_stride] << 8) | in[3 * in_stride];
+    uint32_t y = ((uint32_t)in[4 * in_stride] << 24) | ((uint32_t)in[5 * in_stride] << 16) | ((uint32_t)in[6 * in_stride] << 8) | in[7 * in_stride];
+    uint32_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;
+    y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC;
+    y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+    out[0] = x >> 24;
+    out[1] = x >> 16;
+    out[2] = x >> 8;
+    out[3] = x;
+    out[4] = y >> 24;
+    out[5] = y >> 16;
+    out[6] = y >> 8;
+    out[7] = y;
+}
+
+static inline void area_union(epaper_area_t *area, const epaper_area_t *other)
+{
+    if (other->x0 > other->x1) {
+        return;
+    }
+    if (area->x0 > area->x1) {
+        *area = *other;
+        return;
+    }
+    area->x0 = (other->x0 < area->x0) ? other->x0 : area->x0;
+    area->y0 = (other->y0 < area->y0) ? other->y0 : area->y0;
+    area->x1 = (other->x1 > area->x1) ? other->x1 : area->x1;
+    area->y1 = (other->y1 > area->y1) ? other->y1 : area->y1;
+}
+
+static bool partial_diff_window(epaper_panel_t *epaper_panel, int x_start, int y_start, int len_x, int len_y, epaper_area_t *dirty)
+{
+    // Framebuffer holds rows of the window (DATA ENTRY MODE 3), VRAM shadow holds rows of the panel
+    const int win_bytes = len_x / 8;
+    const int win_x = x_start / 8;
+    epaper_area_t changed = {.x0 = win_bytes, .x1 = -1, .y0 = len_y, .y1 = -1};
+    for (int y = 0; y < len_y; y++) {
+        uint8_t *fb_row = epaper_panel->_framebuffer + y * win_bytes;
+        uint8_t *vram_row = epaper_panel->_vram_shadow + (y_start + y) * SSD1681_EPD_1IN54_V2_ROW_BYTES + win_x;
+        for (int x = 0; x < win_bytes; x++) {
+            if (!(epaper_panel->_vram_valid) || fb_row[x] != vram_row[x]) {
+                vram_row[x] = fb_row[x];
+                const epaper_area_t byte = {x, y, x, y};
+                area_union(&changed, &byte);
             }
         }
     }
+    // Whole panel drawn, VRAM content is known from now
+    if (win_bytes == SSD1681_EPD_1IN54_V2_ROW_BYTES && len_y == SSD1681_EPD_1IN54_V2_HEIGHT) {
+        epaper_panel->_vram_valid = true;
+    }
+    if (changed.x0 > changed.x1) {
+        return false;
+    }
+
+    // Move the changed window to the beginning of framebuffer (rows only move towards the beginning)
+    const int dirty_bytes = changed.x1 - changed.x0 + 1;
+    for (int y = changed.y0; y <= changed.y1; y++) {
+        memmove(epaper_panel->_framebuffer + (y - changed.y0) * dirty_bytes, epaper_panel->_framebuffer + y * win_bytes + changed.x0, dirty_bytes);
+    }
+    dirty->x0 = win_x + changed.x0;
+    dirty->x1 = win_x + changed.x1;
+    dirty->y0 = y_start + changed.y0;
+    dirty->y1 = y_start + changed.y1;
+    return true;
+}
 
+static esp_err_t partial_write_area(epaper_panel_t *epaper_panel, int cmd, const uint8_t *frame, const epaper_area_t *area)
+{
+    // Framebuffer is free after draw_bitmap, it is used for the rows of the window
+    const int area_bytes = area->x1 - area->x0 + 1;
+    const int area_rows = area->y1 - area->y0 + 1;
+    for (int y = 0; y < area_rows; y++) {
+        memcpy(epaper_panel->_framebuffer + y * area_bytes, frame + (area->y0 + y) * SSD1681_EPD_1IN54_V2_ROW_BYTES + area->x0, area_bytes);
+    }
+    ESP_RETURN_ON_ERROR(epaper_set_area(epaper_panel->io, area->x0 * 8, area->y0, area->x1 * 8 + 7, area->y1), TAG,
+                        "epaper_set_area() error");
+    ESP_RETURN_ON_ERROR(epaper_set_cursor(epaper_panel->io, area->x0 * 8, area->y0), TAG,
+                        "epaper_set_cursor() error");
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(epaper_panel->io, SSD1681_CMD_DATA_ENTRY_MODE, (uint8_t[]) {
+        SSD1681_PARAM_DATA_ENTRY_MODE_3
+    }, 1), TAG, "SSD1681_CMD_DATA_ENTRY_MODE err");
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_color(epaper_panel->io, cmd, epaper_panel->_framebuffer, area_bytes * area_rows), TAG,
+                        "partial_write_area tx err");
     return ESP_OK;
 }
 
@@ -65,6 +65,14 @@
 // Disable Analog
 // Disable OSC
 #define SSD1681_PARAM_DISP_UPDATE_MODE_2      0xcf
+// Enable clock signal
+// Enable Analog
+// Load temperature value
+// Load LUT with DISPLAY Mode 2
+// Display with DISPLAY Mode 2 (differential, RED RAM holds the previous image)
+// Disable Analog
+// Disable OSC
+#define SSD1681_PARAM_DISP_PARTIAL            0xff
 // --- Active display update sequence
 #define SSD1681_CMD_ACTIVE_DISP_UPDATE_SEQ  0x20
 // ---
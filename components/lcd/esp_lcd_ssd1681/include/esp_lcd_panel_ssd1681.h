@@ -54,6 +54,36 @@ typedef enum {
     SSD1681_EPAPER_BITMAP_RED    /*!< Draw the bitmap in red */
 } esp_lcd_ssd1681_bitmap_color_t;
 
+/**
+ * @brief Enum of refresh modes of ssd1681 e-paper
+ *        Set by `epaper_panel_set_refresh_mode()`.
+ * @note Default to `SSD1681_EPAPER_REFRESH_FULL` if not set.
+ */
+typedef enum {
+    SSD1681_EPAPER_REFRESH_FULL,    /*!< Every refresh drives all the pixels with full waveform */
+    SSD1681_EPAPER_REFRESH_PARTIAL  /*!< Only changed pixels are driven with fast waveform, black/white panels only */
+} esp_lcd_ssd1681_refresh_mode_t;
+
+/**
+ * @brief Configuration of asynchronous refresh
+ *        Set by `epaper_panel_set_async_refresh()`.
+ */
+typedef struct {
+    int task_priority;      /*!< Priority of the refresh task */
+    uint32_t task_stack;    /*!< Stack size of the refresh task */
+    int task_affinity;      /*!< Core of the refresh task (-1: no affinity) */
+} esp_lcd_ssd1681_async_config_t;
+
+/**
+ * @brief Default configuration of asynchronous refresh
+ */
+#define ESP_LCD_SSD1681_ASYNC_DEFAULT_CONFIG()  \
+    {                                           \
+        .task_priority = 4,                     \
+        .task_stack = 2048,                     \
+        .task_affinity = -1,                    \
+    }
+
 /**
  * @brief Create LCD panel for model ssd1681 e-Paper
  * @attention
@@ -77,6 +107,7 @@ esp_err_t esp_lcd_new_panel_ssd1681(const esp_lcd_panel_io_handle_t io, const es
  * @attention
  *       If you want to call this function, you have to wait manually until the BUSY pin goes LOW
  *       before calling other functions that interacts with the e-paper.
+ *       With `epaper_panel_set_async_refresh()` the refresh is only queued and no waiting is needed.
  *
  * @param[in] panel LCD panel handle
  * @return
@@ -98,6 +129,51 @@ esp_err_t epaper_panel_refresh_screen(esp_lcd_panel_t *panel);
  */
 esp_err_t epaper_panel_set_bitmap_color(esp_lcd_panel_t *panel, esp_lcd_ssd1681_bitmap_color_t color);
 
+/**
+ * @brief Set the refresh mode
+ *
+ * @note In partial mode, the driver keeps the image in VRAM and the image shown on the panel.
+ *       `draw_bitmap()` writes only the changed bytes (the smallest byte-aligned window) into VRAM and
+ *       `epaper_panel_refresh_screen()` refreshes only the changed pixels by the fast waveform of DISPLAY Mode 2.
+ *       The RED VRAM is used as the previous image, so red bitmaps are not available in partial mode.
+ * @note The first refresh is always full, as well as the refresh after drawing a red bitmap or a bitmap mirrored in one axis.
+ *       The whole panel must be drawn once before partial refreshes, e.g. with LVGL `full_refresh`.
+ * @attention Partial mode needs 10 kB of RAM and it is unavailable when enabling non-copy mode.
+ *
+ * @param[in] panel LCD panel handle
+ * @param[in] mode a enum value, SSD1681_EPAPER_REFRESH_FULL or SSD1681_EPAPER_REFRESH_PARTIAL
+ * @param[in] full_refresh_interval every Nth refresh is full against ghosting in partial mode (0: only when needed)
+ * @return
+ *          - ESP_OK                on success
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_ERR_NOT_SUPPORTED if non-copy mode is enabled
+ *          - ESP_ERR_NO_MEM        if out of memory
+ */
+esp_err_t epaper_panel_set_refresh_mode(esp_lcd_panel_t *panel, esp_lcd_ssd1681_refresh_mode_t mode, uint16_t full_refresh_interval);
+
+/**
+ * @brief Enable or disable asynchronous refresh
+ *
+ * @note With asynchronous refresh, `draw_bitmap()` only copies the bitmap into the pending copies of VRAM and returns,
+ *       also during a refresh. Bitmaps drawn into the same region before the next refresh overwrite the older ones.
+ *       `epaper_panel_refresh_screen()` only queues the refresh. A driver task transfers the pending windows into VRAM
+ *       and starts the refresh as soon as the BUSY pin goes LOW, woken by the BUSY interrupt, so no task polls the panel.
+ * @note The first transfer writes the whole VRAM from the copies (cleared at enabling), draw the whole panel first.
+ *       Bitmaps must be byte-aligned in X and `mirror_x` must be equal to `mirror_y`.
+ * @attention Asynchronous refresh needs 10 kB of DMA capable RAM and it is unavailable in partial refresh mode.
+ *            Pending bitmaps are dropped when disabling.
+ *
+ * @param[in] panel LCD panel handle
+ * @param[in] config configuration of the refresh task (NULL: disable)
+ * @return
+ *          - ESP_OK                on success
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_ERR_INVALID_STATE if already enabled or partial refresh mode is set
+ *          - ESP_ERR_NOT_SUPPORTED if BUSY pin is not set
+ *          - ESP_ERR_NO_MEM        if out of memory
+ */
+esp_err_t epaper_panel_set_async_refresh(esp_lcd_panel_t *panel, const esp_lcd_ssd1681_async_config_t *config);
+
 /**
  * @brief Set the callback function
  *
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -22,6 +22,19 @@
 
 static const char *TAG = "st7796_general";
 
+// Init timing of the datasheet, the delays run while other work is done
+#define ST7796_RESET_CMD_DELAY_MS       (5)     // Reset to the next command
+#define ST7796_RESET_SLPOUT_DELAY_MS    (120)   // Reset to LCD_CMD_SLPOUT
+#define ST7796_SLPOUT_CMD_DELAY_MS      (5)     // LCD_CMD_SLPOUT to the next command
+#define ST7796_SLPOUT_DISPON_DELAY_MS   (100)   // LCD_CMD_SLPOUT to LCD_CMD_DISPON
+
+// Lines of the frame memory, vertical scrolling area definition must cover all of them
+#define ST7796_FRAME_MEMORY_LINES       (480)
+
+// QSPI framing, the command is sent in the address phase after the opcode
+#define ST7796_QSPI_OPCODE_WRITE_CMD    (0x02)
+#define ST7796_QSPI_OPCODE_WRITE_COLOR  (0x32)
+
 static esp_err_t panel_st7796_del(esp_lcd_panel_t *panel);
 static esp_err_t panel_st7796_reset(esp_lcd_panel_t *panel);
 static esp_err_t panel_st7796_init(esp_lcd_panel_t *panel);
@@ -44,8 +57,21 @@ typedef struct {
     uint8_t colmod_val; // save current value of LCD_CMD_COLMOD register
     const st7796_lcd_init_cmd_t *init_cmds;
     uint16_t init_cmds_size;
+    TickType_t cmd_tick;    // Earliest time of the next init command
+    TickType_t slpout_tick; // Earliest time of LCD_CMD_SLPOUT after reset
+    TickType_t dispon_tick; // Earliest time of LCD_CMD_DISPON after LCD_CMD_SLPOUT
+    bool reset_pending;     // Reset timing applies to the next init
+    bool dispon_pending;    // Sleep out timing applies to the next LCD_CMD_DISPON
+    struct {
+        unsigned int use_qspi_interface: 1;
+    } flags;
 } st7796_panel_t;
 
+static void panel_st7796_wait_until(TickType_t tick);
+static esp_err_t panel_st7796_tx_param(st7796_panel_t *st7796, int cmd, const void *param, size_t param_size);
+static esp_err_t panel_st7796_tx_color(st7796_panel_t *st7796, int cmd, const void *color, size_t color_size);
+static esp_err_t panel_st7796_tx_init_cmd(st7796_panel_t *st7796, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms);
+
 esp_err_t esp_lcd_new_panel_st7796_general(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel)
 {
     esp_err_t ret = ESP_OK;
@@ -113,6 +139,7 @@ esp_err_t esp_lcd_new_panel_st7796_general(const esp_lcd_panel_io_handle_t io, c
     if (panel_dev_config->vendor_config) {
         st7796->init_cmds = ((st7796_vendor_config_t *)panel_dev_config->vendor_config)->init_cmds;
         st7796->init_cmds_size = ((st7796_vendor_config_t *)panel_dev_config->vendor_config)->init_cmds_size;
+        st7796->flags.use_qspi_interface = ((st7796_vendor_config_t *)panel_dev_config->vendor_config)->flags.use_qspi_interface;
     }
     st7796->base.del = panel_st7796_del;
     st7796->base.reset = panel_st7796_reset;
@@ -145,6 +172,94 @@ err:
     return ret;
 }
 
+esp_err_t esp_lcd_st7796_set_scroll_area(esp_lcd_panel_handle_t panel, uint16_t top_fixed, uint16_t scroll_height)
+{
+    // Only SPI/I80 panels, MIPI panels are refreshed from the frame buffer of the host
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_st7796_del, ESP_ERR_INVALID_ARG, TAG, "invalid st7796 SPI/I80 panel");
+    st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
+    const int top = top_fixed + st7796->y_gap;
+    ESP_RETURN_ON_FALSE(scroll_height > 0 && top + scroll_height <= ST7796_FRAME_MEMORY_LINES, ESP_ERR_INVALID_ARG, TAG,
+                        "scroll area out of frame memory");
+
+    // Top fixed area, vertical scrolling area and bottom fixed area, sum must be the lines of frame memory
+    const int bottom = ST7796_FRAME_MEMORY_LINES - top - scroll_height;
+    return panel_st7796_tx_param(st7796, LCD_CMD_VSCRDEF, (uint8_t[]) {
+        (top >> 8) & 0xFF, top & 0xFF,
+        (scroll_height >> 8) & 0xFF, scroll_height & 0xFF,
+        (bottom >> 8) & 0xFF, bottom & 0xFF,
+    }, 6);
+}
+
+esp_err_t esp_lcd_st7796_set_scroll_start(esp_lcd_panel_handle_t panel, uint16_t line)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_st7796_del, ESP_ERR_INVALID_ARG, TAG, "invalid st7796 SPI/I80 panel");
+    st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
+    const int start = line + st7796->y_gap;
+    ESP_RETURN_ON_FALSE(start < ST7796_FRAME_MEMORY_LINES, ESP_ERR_INVALID_ARG, TAG, "scroll start out of frame memory");
+
+    return panel_st7796_tx_param(st7796, LCD_CMD_VSCSAD, (uint8_t[]) {
+        (start >> 8) & 0xFF, start & 0xFF,
+    }, 2);
+}
+
+esp_err_t esp_lcd_st7796_set_bits_per_pixel(esp_lcd_panel_handle_t panel, uint8_t bits_per_pixel)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_st7796_del, ESP_ERR_INVALID_ARG, TAG, "invalid st7796 SPI/I80 panel");
+    st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
+    uint8_t colmod_val;
+    uint8_t fb_bits_per_pixel;
+    switch (bits_per_pixel) {
+    case 16: // RGB565
+        colmod_val = 0x05;
+        fb_bits_per_pixel = 16;
+        break;
+    case 18: // RGB666, 3 bytes per pixel
+        colmod_val = 0x06;
+        fb_bits_per_pixel = 24;
+        break;
+    case 24: // RGB888
+        colmod_val = 0x07;
+        fb_bits_per_pixel = 24;
+        break;
+    default:
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, TAG, "unsupported pixel width");
+    }
+
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_param(st7796, LCD_CMD_COLMOD, (uint8_t[]) {
+        colmod_val,
+    }, 1), TAG, "send command failed");
+    st7796->colmod_val = colmod_val;
+    st7796->fb_bits_per_pixel = fb_bits_per_pixel;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_st7796_set_idle_mode(esp_lcd_panel_handle_t panel, bool enable)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_st7796_del, ESP_ERR_INVALID_ARG, TAG, "invalid st7796 SPI/I80 panel");
+    st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
+
+    return esp_lcd_panel_io_tx_param(st7796->io, enable ? LCD_CMD_IDMON : LCD_CMD_IDMOFF, NULL, 0);
+}
+
+esp_err_t esp_lcd_st7796_set_partial_area(esp_lcd_panel_handle_t panel, uint16_t start_line, uint16_t lines)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->del == panel_st7796_del, ESP_ERR_INVALID_ARG, TAG, "invalid st7796 SPI/I80 panel");
+    st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
+    if (lines == 0) {
+        return esp_lcd_panel_io_tx_param(st7796->io, LCD_CMD_NORON, NULL, 0);
+    }
+
+    const int start = start_line + st7796->y_gap;
+    const int end = start + lines - 1;
+    ESP_RETURN_ON_FALSE(end < ST7796_FRAME_MEMORY_LINES, ESP_ERR_INVALID_ARG, TAG, "partial area out of frame memory");
+    // Lines out of the area are not driven (shown in the color of the non-display area), frame memory is kept
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(st7796->io, LCD_CMD_PTLAR, (uint8_t[]) {
+        (start >> 8) & 0xFF, start & 0xFF,
+        (end >> 8) & 0xFF, end & 0xFF,
+    }, 4), TAG, "send command failed");
+    return esp_lcd_panel_io_tx_param(st7796->io, LCD_CMD_PTLON, NULL, 0);
+}
+
 static esp_err_t panel_st7796_del(esp_lcd_panel_t *panel)
 {
     st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
@@ -160,19 +275,73 @@ static esp_err_t panel_st7796_del(esp_lcd_panel_t *panel)
 static esp_err_t panel_st7796_reset(esp_lcd_panel_t *panel)
 {
     st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
-    esp_lcd_panel_io_handle_t io = st7796->io;
 
     // perform hardware reset
     if (st7796->reset_gpio_num >= 0) {
         gpio_set_level(st7796->reset_gpio_num, st7796->reset_level);
         vTaskDelay(pdMS_TO_TICKS(10));
         gpio_set_level(st7796->reset_gpio_num, !st7796->reset_level);
-        vTaskDelay(pdMS_TO_TICKS(120));
     } else { // perform software reset
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SWRESET, NULL, 0), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(120)); // spec, wait at least 5ms before sending new command
+        ESP_RETURN_ON_ERROR(panel_st7796_tx_param(st7796, LCD_CMD_SWRESET, NULL, 0), TAG, "send command failed");
+    }
+    // spec, wait before sending new command and before sleep out, init waits only for the rest
+    const TickType_t now = xTaskGetTickCount();
+    st7796->cmd_tick = now + pdMS_TO_TICKS(ST7796_RESET_CMD_DELAY_MS);
+    st7796->slpout_tick = now + pdMS_TO_TICKS(ST7796_RESET_SLPOUT_DELAY_MS);
+    st7796->reset_pending = true;
+
+    return ESP_OK;
+}
+
+static void panel_st7796_wait_until(TickType_t tick)
+{
+    const TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(tick - now) > 0) {
+        vTaskDelay(tick - now);
+    }
+}
+
+static esp_err_t panel_st7796_tx_param(st7796_panel_t *st7796, int cmd, const void *param, size_t param_size)
+{
+    if (st7796->flags.use_qspi_interface) {
+        cmd &= 0xff;
+        cmd <<= 8;
+        cmd |= ST7796_QSPI_OPCODE_WRITE_CMD << 24;
+    }
+    return esp_lcd_panel_io_tx_param(st7796->io, cmd, param, param_size);
+}
+
+static esp_err_t panel_st7796_tx_color(st7796_panel_t *st7796, int cmd, const void *color, size_t color_size)
+{
+    if (st7796->flags.use_qspi_interface) {
+        cmd &= 0xff;
+        cmd <<= 8;
+        cmd |= ST7796_QSPI_OPCODE_WRITE_COLOR << 24;
     }
+    return esp_lcd_panel_io_tx_color(st7796->io, cmd, color, color_size);
+}
 
+static esp_err_t panel_st7796_tx_init_cmd(st7796_panel_t *st7796, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms)
+{
+    panel_st7796_wait_until(st7796->cmd_tick);
+    if (cmd == LCD_CMD_SLPOUT) {
+        panel_st7796_wait_until(st7796->slpout_tick);
+    } else if ((cmd == LCD_CMD_DISPON) && st7796->dispon_pending) {
+        panel_st7796_wait_until(st7796->dispon_tick);
+        st7796->dispon_pending = false;
+    }
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_param(st7796, cmd, data, data_bytes), TAG, "send command failed");
+
+    // The delay is waited only before the next command
+    const TickType_t now = xTaskGetTickCount();
+    st7796->cmd_tick = now + pdMS_TO_TICKS(delay_ms);
+    if (cmd == LCD_CMD_SLPOUT) {
+        if (delay_ms < ST7796_SLPOUT_CMD_DELAY_MS) {
+            st7796->cmd_tick = now + pdMS_TO_TICKS(ST7796_SLPOUT_CMD_DELAY_MS);
+        }
+        st7796->dispon_tick = now + pdMS_TO_TICKS(ST7796_SLPOUT_DISPON_DELAY_MS);
+        st7796->dispon_pending = true;
+    }
     return ESP_OK;
 }
 
@@ -195,17 +364,21 @@ static const st7796_lcd_init_cmd_t vendor_specific_init_default[] = {
 static esp_err_t panel_st7796_init(esp_lcd_panel_t *panel)
 {
     st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
-    esp_lcd_panel_io_handle_t io = st7796->io;
+
+    // Reset timing applies only right after panel_st7796_reset()
+    if (!st7796->reset_pending) {
+        st7796->cmd_tick = st7796->slpout_tick = xTaskGetTickCount();
+    }
+    st7796->reset_pending = false;
 
     // LCD goes into sleep mode and display will be turned off after power on reset, exit sleep mode first
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SLPOUT, NULL, 0), TAG, "send command failed");
-    vTaskDelay(pdMS_TO_TICKS(100));
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_init_cmd(st7796, LCD_CMD_SLPOUT, NULL, 0, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_init_cmd(st7796, LCD_CMD_MADCTL, (uint8_t[]) {
         st7796->madctl_val,
-    }, 1), TAG, "send command failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_COLMOD, (uint8_t[]) {
+    }, 1, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_init_cmd(st7796, LCD_CMD_COLMOD, (uint8_t[]) {
         st7796->colmod_val,
-    }, 1), TAG, "send command failed");
+    }, 1, 0), TAG, "send command failed");
 
     const st7796_lcd_init_cmd_t *init_cmds = NULL;
     uint16_t init_cmds_size = 0;
@@ -238,9 +411,11 @@ static esp_err_t panel_st7796_init(esp_lcd_panel_t *panel)
             ESP_LOGW(TAG, "The %02Xh command has been used and will be overwritten by external initialization sequence", init_cmds[i].cmd);
         }
 
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        ESP_RETURN_ON_ERROR(panel_st7796_tx_init_cmd(st7796, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes, init_cmds[i].delay_ms), TAG,
+                            "send command failed");
     }
+    // Delay of the last command
+    panel_st7796_wait_until(st7796->cmd_tick);
     ESP_LOGD(TAG, "send init commands success");
 
     return ESP_OK;
@@ -250,7 +425,6 @@ static esp_err_t panel_st7796_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
 {
     st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
     assert((x_start < x_end) && (y_start < y_end) && "start position must be smaller than end position");
-    esp_lcd_panel_io_handle_t io = st7796->io;
 
     x_start += st7796->x_gap;
     x_end += st7796->x_gap;
@@ -258,13 +432,13 @@ static esp_err_t panel_st7796_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
     y_end += st7796->y_gap;
 
     // define an area of frame memory where MCU can access
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_CASET, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_param(st7796, LCD_CMD_CASET, (uint8_t[]) {
         (x_start >> 8) & 0xFF,
         x_start & 0xFF,
         ((x_end - 1) >> 8) & 0xFF,
         (x_end - 1) & 0xFF,
     }, 4), TAG, "send command failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_RASET, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_param(st7796, LCD_CMD_RASET, (uint8_t[]) {
         (y_start >> 8) & 0xFF,
         y_start & 0xFF,
         ((y_end - 1) >> 8) & 0xFF,
@@ -272,7 +446,7 @@ static esp_err_t panel_st7796_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
     }, 4), TAG, "send command failed");
     // transfer frame buffer
     size_t len = (x_end - x_start) * (y_end - y_start) * st7796->fb_bits_per_pixel / 8;
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_color(io, LCD_CMD_RAMWR, color_data, len), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_color(st7796, LCD_CMD_RAMWR, color_data, len), TAG, "send command failed");
 
     return ESP_OK;
 }
@@ -280,21 +454,19 @@ static esp_err_t panel_st7796_draw_bitmap(esp_lcd_panel_t *panel, int x_start, i
 static esp_err_t panel_st7796_invert_color(esp_lcd_panel_t *panel, bool invert_color_data)
 {
     st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
-    esp_lcd_panel_io_handle_t io = st7796->io;
     int command = 0;
     if (invert_color_data) {
         command = LCD_CMD_INVON;
     } else {
         command = LCD_CMD_INVOFF;
     }
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, command, NULL, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_param(st7796, command, NULL, 0), TAG, "send command failed");
     return ESP_OK;
 }
 
 static esp_err_t panel_st7796_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool mirror_y)
 {
     st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
-    esp_lcd_panel_io_handle_t io = st7796->io;
     if (mirror_x) {
         st7796->madctl_val |= LCD_CMD_MX_BIT;
     } else {
@@ -305,7 +477,7 @@ static esp_err_t panel_st7796_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool
     } else {
         st7796->madctl_val &= ~LCD_CMD_MY_BIT;
     }
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_param(st7796, LCD_CMD_MADCTL, (uint8_t[]) {
         st7796->madctl_val
     }, 1), TAG, "send command failed");
     return ESP_OK;
@@ -314,13 +486,12 @@ static esp_err_t panel_st7796_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool
 static esp_err_t panel_st7796_swap_xy(esp_lcd_panel_t *panel, bool swap_axes)
 {
     st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
-    esp_lcd_panel_io_handle_t io = st7796->io;
     if (swap_axes) {
         st7796->madctl_val |= LCD_CMD_MV_BIT;
     } else {
         st7796->madctl_val &= ~LCD_CMD_MV_BIT;
     }
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_param(st7796, LCD_CMD_MADCTL, (uint8_t[]) {
         st7796->madctl_val
     }, 1), TAG, "send command failed");
     return ESP_OK;
@@ -337,7 +508,6 @@ static esp_err_t panel_st7796_set_gap(esp_lcd_panel_t *panel, int x_gap, int y_g
 static esp_err_t panel_st7796_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
 {
     st7796_panel_t *st7796 = __containerof(panel, st7796_panel_t, base);
-    esp_lcd_panel_io_handle_t io = st7796->io;
     int command = 0;
 
 #if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
@@ -349,6 +519,11 @@ static esp_err_t panel_st7796_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
     } else {
         command = LCD_CMD_DISPOFF;
     }
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, command, NULL, 0), TAG, "send command failed");
+    // Sleep out must settle before display on
+    if ((command == LCD_CMD_DISPON) && st7796->dispon_pending) {
+        panel_st7796_wait_until(st7796->dispon_tick);
+        st7796->dispon_pending = false;
+    }
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_param(st7796, command, NULL, 0), TAG, "send command failed");
     return ESP_OK;
 }
@@ -7,6 +7,7 @@
 #include "soc/soc_caps.h"
 
 #if SOC_MIPI_DSI_SUPPORTED
+#include <inttypes.h>
 #include "esp_check.h"
 #include "esp_log.h"
 #include "esp_lcd_panel_commands.h"
@@ -21,6 +22,12 @@
 #include "esp_lcd_st7796.h"
 #include "esp_lcd_st7796_interface.h"
 
+// Init timing of the datasheet, the delays run while the following commands are sent
+#define ST7796_RESET_CMD_DELAY_MS       (5)     // Reset to the next command
+#define ST7796_RESET_SLPOUT_DELAY_MS    (120)   // Reset to LCD_CMD_SLPOUT
+#define ST7796_SLPOUT_CMD_DELAY_MS      (5)     // LCD_CMD_SLPOUT to the next command
+#define ST7796_SLPOUT_DISPON_DELAY_MS   (100)   // LCD_CMD_SLPOUT to LCD_CMD_DISPON
+
 typedef struct {
     esp_lcd_panel_io_handle_t io;
     int reset_gpio_num;
@@ -28,8 +35,13 @@ typedef struct {
     uint8_t colmod_val; // save surrent value of LCD_CMD_COLMOD register
     const st7796_lcd_init_cmd_t *init_cmds;
     uint16_t init_cmds_size;
+    TickType_t cmd_tick;    // Earliest time of the next init command
+    TickType_t slpout_tick; // Earliest time of LCD_CMD_SLPOUT after reset
+    TickType_t dispon_tick; // Earliest time of LCD_CMD_DISPON after LCD_CMD_SLPOUT
     struct {
         unsigned int reset_level: 1;
+        unsigned int reset_pending: 1;  // Reset timing applies to the next init
+        unsigned int dispon_pending: 1; // Sleep out timing applies to the next LCD_CMD_DISPON
     } flags;
     // To save the original functions of MIPI DPI panel
     esp_err_t (*del)(esp_lcd_panel_t *panel);
@@ -44,6 +56,8 @@ static esp_err_t panel_st7796_reset(esp_lcd_panel_t *panel);
 static esp_err_t panel_st7796_invert_color(esp_lcd_panel_t *panel, bool invert_color_data);
 static esp_err_t panel_st7796_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool mirror_y);
 static esp_err_t panel_st7796_disp_on_off(esp_lcd_panel_t *panel, bool on_off);
+static void panel_st7796_wait_until(TickType_t tick);
+static esp_err_t panel_st7796_tx_init_cmd(st7796_panel_t *st7796, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms);
 
 esp_err_t esp_lcd_new_panel_st7796_mipi(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config,
                                         esp_lcd_panel_handle_t *ret_panel)
@@ -135,7 +149,7 @@ err:
 
 static const st7796_lcd_init_cmd_t vendor_specific_init_default[] = {
 //  {cmd, { data }, data_size, delay_ms}
-    {0x11, (uint8_t []){0x00}, 0, 120},
+    {0x11, (uint8_t []){0x00}, 0, 0},
     {0x36, (uint8_t []){0x48}, 1, 0},
     {0x3A, (uint8_t []){0x77}, 1, 0},
     {0xF0, (uint8_t []){0xC3}, 1, 0},
@@ -181,16 +195,22 @@ static esp_err_t panel_st7796_del(esp_lcd_panel_t *panel)
 static esp_err_t panel_st7796_init(esp_lcd_panel_t *panel)
 {
     st7796_panel_t *st7796 = (st7796_panel_t *)panel->user_data;
-    esp_lcd_panel_io_handle_t io = st7796->io;
     const st7796_lcd_init_cmd_t *init_cmds = NULL;
     uint16_t init_cmds_size = 0;
 
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_MADCTL, (uint8_t[]) {
+    // Reset timing applies only right after panel_st7796_reset()
+    const TickType_t start_tick = xTaskGetTickCount();
+    if (!st7796->flags.reset_pending) {
+        st7796->cmd_tick = st7796->slpout_tick = start_tick;
+    }
+    st7796->flags.reset_pending = false;
+
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_init_cmd(st7796, LCD_CMD_MADCTL, (uint8_t[]) {
         st7796->madctl_val,
-    }, 1), TAG, "send command failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_COLMOD, (uint8_t[]) {
+    }, 1, 0), TAG, "send command failed");
+    ESP_RETURN_ON_ERROR(panel_st7796_tx_init_cmd(st7796, LCD_CMD_COLMOD, (uint8_t[]) {
         st7796->colmod_val,
-    }, 1), TAG, "send command failed");
+    }, 1, 0), TAG, "send command failed");
 
     // vendor specific initialization, it can be different between manufacturers
     // should consult the LCD supplier for initialization sequence code
@@ -204,10 +224,12 @@ static esp_err_t panel_st7796_init(esp_lcd_panel_t *panel)
 
     for (int i = 0; i < init_cmds_size; i++) {
         // Send command
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        ESP_RETURN_ON_ERROR(panel_st7796_tx_init_cmd(st7796, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes,
+                            init_cmds[i].delay_ms), TAG, "send command failed");
     }
-    ESP_LOGD(TAG, "send init commands success");
+    // Video stream starts after init, the rest of the table delay is waited as well
+    panel_st7796_wait_until(st7796->cmd_tick);
+    ESP_LOGD(TAG, "send init commands success (%"PRIu32" ms)", (uint32_t)pdTICKS_TO_MS(xTaskGetTickCount() - start_tick));
 
     ESP_RETURN_ON_ERROR(st7796->init(panel), TAG, "init MIPI DPI panel failed");
 
@@ -224,15 +246,55 @@ static esp_err_t panel_st7796_reset(esp_lcd_panel_t *panel)
         gpio_set_level(st7796->reset_gpio_num, st7796->flags.reset_level);
         vTaskDelay(pdMS_TO_TICKS(10));
         gpio_set_level(st7796->reset_gpio_num, !st7796->flags.reset_level);
-        vTaskDelay(pdMS_TO_TICKS(120));
     } else if (io) { // Perform software reset
         ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, LCD_CMD_SWRESET, NULL, 0), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(120));
+    } else {
+        return ESP_OK;
     }
+    // spec, wait before sending new command and before sleep out, init waits only for the rest
+    const TickType_t now = xTaskGetTickCount();
+    st7796->cmd_tick = now + pdMS_TO_TICKS(ST7796_RESET_CMD_DELAY_MS);
+    st7796->slpout_tick = now + pdMS_TO_TICKS(ST7796_RESET_SLPOUT_DELAY_MS);
+    st7796->flags.reset_pending = true;
 
     return ESP_OK;
 }
 
+static void panel_st7796_wait_until(TickType_t tick)
+{
+    const TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(tick - now) > 0) {
+        vTaskDelay(tick - now);
+    }
+}
+
+static esp_err_t panel_st7796_tx_init_cmd(st7796_panel_t *st7796, int cmd, const void *data, size_t data_bytes, unsigned int delay_ms)
+{
+    // Vendor tables send also parameters with command 11h, only the plain command is a sleep out
+    const bool slpout = (cmd == LCD_CMD_SLPOUT) && (data_bytes == 0);
+
+    panel_st7796_wait_until(st7796->cmd_tick);
+    if (slpout) {
+        panel_st7796_wait_until(st7796->slpout_tick);
+    } else if ((cmd == LCD_CMD_DISPON) && st7796->flags.dispon_pending) {
+        panel_st7796_wait_until(st7796->dispon_tick);
+        st7796->flags.dispon_pending = false;
+    }
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(st7796->io, cmd, data, data_bytes), TAG, "send command failed");
+
+    // The delay is waited only before the next command, no yield per command of long tables
+    const TickType_t now = xTaskGetTickCount();
+    st7796->cmd_tick = now + pdMS_TO_TICKS(delay_ms);
+    if (slpout) {
+        if (delay_ms < ST7796_SLPOUT_CMD_DELAY_MS) {
+            st7796->cmd_tick = now + pdMS_TO_TICKS(ST7796_SLPOUT_CMD_DELAY_MS);
+        }
+        st7796->dispon_tick = now + pdMS_TO_TICKS(ST7796_SLPOUT_DISPON_DELAY_MS);
+        st7796->flags.dispon_pending = true;
+    }
+    return ESP_OK;
+}
+
 static esp_err_t panel_st7796_invert_color(esp_lcd_panel_t *panel, bool invert_color_data)
 {
     st7796_panel_t *st7796 = (st7796_panel_t *)panel->user_data;
@@ -287,6 +349,11 @@ static esp_err_t panel_st7796_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
 
     if (on_off) {
         command = LCD_CMD_DISPON;
+        // Sleep out settling of init, when the init table does not turn on the display
+        if (st7796->flags.dispon_pending) {
+            panel_st7796_wait_until(st7796->dispon_tick);
+            st7796->flags.dispon_pending = false;
+        }
     } else {
         command = LCD_CMD_DISPOFF;
     }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -52,6 +52,8 @@ typedef struct {
 #endif
     struct {
         unsigned int use_mipi_interface: 1;         /*<! Set to 1 if using MIPI interface, default is SPI/I80 interface */
+        unsigned int use_qspi_interface: 1;         /*<! Set to 1 if the panel IO is QSPI (`ST7796_PANEL_IO_QSPI_CONFIG`), commands are
+                                                     *   framed by the 0x02 (command) and 0x32 (color) opcodes of QSPI modules */
     } flags;
 } st7796_vendor_config_t;
 
@@ -70,6 +72,92 @@ typedef struct {
  */
 esp_err_t esp_lcd_new_panel_st7796(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel);
 
+/**
+ * @brief Define vertical scrolling area (hardware scroll)
+ *
+ * Lines above the area (top fixed area) and below it (bottom fixed area) do not move. Lines are counted in the vertical
+ * direction of the frame memory (480 lines), so hardware scroll is vertical only without swapped axes (`swap_xy`).
+ *
+ * @note Only for SPI/I80 interface.
+ *
+ * @param[in] panel LCD panel handle of ST7796
+ * @param[in] top_fixed Lines of top fixed area
+ * @param[in] scroll_height Lines of vertical scrolling area
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the area does not fit the frame memory or the panel is not ST7796 with SPI/I80 interface
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_st7796_set_scroll_area(esp_lcd_panel_handle_t panel, uint16_t top_fixed, uint16_t scroll_height);
+
+/**
+ * @brief Set the line of frame memory shown at the top of vertical scrolling area
+ *
+ * The scrolling area shows the memory from this line to its end and then from its start (wraps around).
+ * Setting `top_fixed` of `esp_lcd_st7796_set_scroll_area()` shows the memory without scroll.
+ *
+ * @note Only for SPI/I80 interface.
+ *
+ * @param[in] panel LCD panel handle of ST7796
+ * @param[in] line Line of frame memory (in the vertical scrolling area)
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the line is out of frame memory or the panel is not ST7796 with SPI/I80 interface
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_st7796_set_scroll_start(esp_lcd_panel_handle_t panel, uint16_t line);
+
+/**
+ * @brief Change pixel format of the interface (COLMOD) in runtime
+ *
+ * Pixels of 18 and 24 bits take 3 bytes of `esp_lcd_panel_draw_bitmap()` data (red, green, blue; RGB666 in the 6 high bits
+ * of each byte), so they take 1.5 times longer to transfer than RGB565. Content of the frame memory is kept.
+ *
+ * @note Only for SPI/I80 interface.
+ *
+ * @note Call it only when no `esp_lcd_panel_draw_bitmap()` transfer is in progress.
+ *
+ * @param[in] panel LCD panel handle of ST7796
+ * @param[in] bits_per_pixel 16 (RGB565), 18 (RGB666) or 24 (RGB888)
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the panel is not ST7796 with SPI/I80 interface
+ *          - ESP_ERR_NOT_SUPPORTED if the pixel width is not supported
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_st7796_set_bits_per_pixel(esp_lcd_panel_handle_t panel, uint8_t bits_per_pixel);
+
+/**
+ * @brief Turn Idle Mode (8 colors) on or off
+ *
+ * In Idle Mode, only the most significant bit of each color channel is shown (black, white, red, green, blue, cyan,
+ * magenta and yellow) and the panel takes less power. Content of the frame memory is kept, so the full colors
+ * come back after turning it off.
+ *
+ * @note Only for SPI/I80 interface.
+ *
+ * @param[in] panel LCD panel handle of ST7796
+ * @param[in] enable true to turn Idle Mode on
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the panel is not ST7796 with SPI/I80 interface
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_st7796_set_idle_mode(esp_lcd_panel_handle_t panel, bool enable);
+
+/**
+ * @brief Show only a band of lines (Partial Mode)
+ *
+ * Lines out of the area are not driven, they show the color of the non-display area (usually black) and the panel takes
+ * less power. Lines are counted in the vertical direction of the frame memory (480 lines), same as in hardware scroll.
+ *
+ * @note Only for SPI/I80 interface.
+ *
+ * @param[in] panel LCD panel handle of ST7796
+ * @param[in] start_line First line of the shown area
+ * @param[in] lines Lines of the shown area (0: Normal Mode, all lines are shown)
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if the area is out of frame memory or the panel is not ST7796 with SPI/I80 interface
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_st7796_set_partial_area(esp_lcd_panel_handle_t panel, uint16_t start_line, uint16_t lines);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////// Default Configuration Macros for I80 Interface /////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -142,6 +230,57 @@ esp_err_t esp_lcd_new_panel_st7796(const esp_lcd_panel_io_handle_t io, const esp
         .lcd_param_bits = 8,                        \
     }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////// Default Configuration Macros for QSPI Interface ///////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief LCD panel bus configuration structure
+ *
+ * @param[in] sclk SPI clock pin number
+ * @param[in] d0 SPI data 0 pin number
+ * @param[in] d1 SPI data 1 pin number
+ * @param[in] d2 SPI data 2 pin number
+ * @param[in] d3 SPI data 3 pin number
+ * @param[in] max_trans_sz Maximum transfer size in bytes
+ *
+ */
+#define ST7796_PANEL_BUS_QSPI_CONFIG(sclk, d0, d1, d2, d3, max_trans_sz)    \
+    {                                                                       \
+        .data0_io_num = d0,                                                 \
+        .data1_io_num = d1,                                                 \
+        .sclk_io_num = sclk,                                                \
+        .data2_io_num = d2,                                                 \
+        .data3_io_num = d3,                                                 \
+        .max_transfer_sz = max_trans_sz,                                    \
+    }
+
+/**
+ * @brief LCD panel IO configuration structure
+ *
+ * @note  The command is sent in the 32-bit address phase, so `flags.use_qspi_interface` of `st7796_vendor_config_t` must be set.
+ *
+ * @param[in] cs SPI chip select pin number
+ * @param[in] cb Callback function when SPI transfer is done
+ * @param[in] cb_ctx Callback function context
+ *
+ */
+#define ST7796_PANEL_IO_QSPI_CONFIG(cs, cb, cb_ctx) \
+    {                                               \
+        .cs_gpio_num = cs,                          \
+        .dc_gpio_num = -1,                          \
+        .spi_mode = 0,                              \
+        .pclk_hz = 40 * 1000 * 1000,                \
+        .trans_queue_depth = 10,                    \
+        .on_color_trans_done = cb,                  \
+        .user_ctx = cb_ctx,                         \
+        .lcd_cmd_bits = 32,                         \
+        .lcd_param_bits = 8,                        \
+        .flags = {                                  \
+            .quad_mode = true,                      \
+        },                                          \
+    }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ///////////////////////////// Default Configuration Macros for MIPI-DSI Interface //////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
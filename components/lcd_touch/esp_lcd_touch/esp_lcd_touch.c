@@ -5,25 +5,49 @@
  */
 
 #include <stdlib.h>
+#include <math.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
 #include "driver/gpio.h"
 #include "esp_system.h"
 #include "esp_err.h"
 #include "esp_check.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "esp_lcd_touch.h"
 
 static const char *TAG = "TP";
 
+#define ESP_LCD_TOUCH_READ_QUEUE_LEN   (4)
+#define ESP_LCD_TOUCH_MATRIX_ONE       (1 << 16)
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
 
+static esp_err_t touch_read_blocking(esp_lcd_touch_handle_t tp);
+static void touch_read_async_done(esp_lcd_touch_handle_t tp, esp_err_t err, void *user_ctx);
+static void touch_sample_update(esp_lcd_touch_handle_t tp, int64_t start, esp_err_t err);
+static void touch_adjust_coordinates(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength, uint8_t *point_num, uint8_t max_point_num);
+static void touch_get_matrix(esp_lcd_touch_handle_t tp, esp_lcd_touch_matrix_t *matrix, bool *identity);
+static void touch_isr(void *arg);
+static esp_err_t touch_read_task_init(void);
+static void touch_read_task(void *arg);
+
 /*******************************************************************************
 * Local variables
 *******************************************************************************/
 
+typedef struct {
+    esp_lcd_touch_handle_t tp;
+    esp_lcd_touch_read_done_cb_t done_cb;
+    void *user_ctx;
+} touch_read_req_t;
+
+static QueueHandle_t touch_read_queue = NULL;
+static portMUX_TYPE touch_read_lock = portMUX_INITIALIZER_UNLOCKED;
+
 /*******************************************************************************
 * Public API functions
 *******************************************************************************/
@@ -35,7 +59,11 @@ esp_err_t esp_lcd_touch_enter_sleep(esp_lcd_touch_handle_t tp)
         ESP_LOGE(TAG, "Sleep mode not supported!");
         return ESP_FAIL;
     } else {
-        return tp->enter_sleep(tp);
+        esp_err_t ret = tp->enter_sleep(tp);
+        if (ret == ESP_OK) {
+            tp->power_mode = ESP_LCD_TOUCH_POWER_MODE_SLEEP;
+        }
+        return ret;
     }
 }
 
@@ -46,16 +74,84 @@ esp_err_t esp_lcd_touch_exit_sleep(esp_lcd_touch_handle_t tp)
         ESP_LOGE(TAG, "Sleep mode not supported!");
         return ESP_FAIL;
     } else {
-        return tp->exit_sleep(tp);
+        esp_err_t ret = tp->exit_sleep(tp);
+        if (ret == ESP_OK) {
+            tp->power_mode = ESP_LCD_TOUCH_POWER_MODE_ACTIVE;
+        }
+        return ret;
     }
 }
 
+esp_err_t esp_lcd_touch_set_power_mode(esp_lcd_touch_handle_t tp, esp_lcd_touch_power_mode_t mode)
+{
+    esp_err_t ret = ESP_OK;
+    assert(tp != NULL);
+
+    if (mode == tp->power_mode) {
+        return ESP_OK;
+    }
+
+    if (tp->set_power_mode) {
+        ret = tp->set_power_mode(tp, mode);
+    } else if (mode == ESP_LCD_TOUCH_POWER_MODE_SLEEP && tp->enter_sleep) {
+        ret = tp->enter_sleep(tp);
+    } else if (mode == ESP_LCD_TOUCH_POWER_MODE_ACTIVE && tp->power_mode == ESP_LCD_TOUCH_POWER_MODE_SLEEP && tp->exit_sleep) {
+        ret = tp->exit_sleep(tp);
+    } else {
+        ESP_LOGE(TAG, "Power mode %d not supported!", mode);
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    if (ret == ESP_OK) {
+        tp->power_mode = mode;
+    }
+
+    return ret;
+}
+
+esp_err_t esp_lcd_touch_get_power_mode(esp_lcd_touch_handle_t tp, esp_lcd_touch_power_mode_t *mode)
+{
+    assert(tp != NULL);
+    assert(mode != NULL);
+
+    *mode = tp->power_mode;
+
+    return ESP_OK;
+}
+
 esp_err_t esp_lcd_touch_read_data(esp_lcd_touch_handle_t tp)
 {
     assert(tp != NULL);
     assert(tp->read_data != NULL);
 
-    return tp->read_data(tp);
+    return touch_read_blocking(tp);
+}
+
+esp_err_t esp_lcd_touch_read_data_async(esp_lcd_touch_handle_t tp, esp_lcd_touch_read_done_cb_t done_cb, void *user_ctx)
+{
+    assert(tp != NULL);
+    assert(done_cb != NULL);
+
+    /* Driver can read without blocking */
+    if (tp->read_data_async) {
+        tp->async.done_cb = done_cb;
+        tp->async.user_ctx = user_ctx;
+        tp->async.start = esp_timer_get_time();
+        return tp->read_data_async(tp, touch_read_async_done, NULL);
+    }
+
+    assert(tp->read_data != NULL);
+    ESP_RETURN_ON_ERROR(touch_read_task_init(), TAG, "Read task init failed");
+
+    /* Blocking read in the common read task */
+    const touch_read_req_t req = {
+        .tp = tp,
+        .done_cb = done_cb,
+        .user_ctx = user_ctx,
+    };
+    ESP_RETURN_ON_FALSE(xQueueSend(touch_read_queue, &req, 0) == pdTRUE, ESP_ERR_TIMEOUT, TAG, "Too many pending reads");
+
+    return ESP_OK;
 }
 
 bool esp_lcd_touch_get_coordinates(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength, uint8_t *point_num, uint8_t max_point_num)
@@ -72,39 +168,78 @@ bool esp_lcd_touch_get_coordinates(esp_lcd_touch_handle_t tp, uint16_t *x, uint1
         return false;
     }
 
-    /* Process coordinates by user */
-    if (tp->config.process_coordinates != NULL) {
-        tp->config.process_coordinates(tp, x, y, strength, point_num, max_point_num);
+    touch_adjust_coordinates(tp, x, y, strength, point_num, max_point_num);
+
+    return touched;
+}
+
+esp_err_t esp_lcd_touch_get_timestamp(esp_lcd_touch_handle_t tp, int64_t *timestamp)
+{
+    assert(tp != NULL);
+    assert(timestamp != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    *timestamp = tp->sample.timestamp;
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return (*timestamp != 0) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+#if CONFIG_ESP_LCD_TOUCH_MOTION
+bool esp_lcd_touch_get_motion(esp_lcd_touch_handle_t tp, esp_lcd_touch_motion_t *motion, uint8_t *point_num, uint8_t max_point_num)
+{
+    assert(tp != NULL);
+    assert(motion != NULL);
+    assert(point_num != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    *point_num = (tp->sample.points > max_point_num ? max_point_num : tp->sample.points);
+    for (int i = 0; i < *point_num; i++) {
+        motion[i] = tp->sample.point[i].motion;
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    /* Transform the motion the same way as coordinates (without offset) */
+    esp_lcd_touch_matrix_t m;
+    bool identity;
+    touch_get_matrix(tp, &m, &identity);
+    for (int i = 0; (!identity && i < *point_num); i++) {
+        const esp_lcd_touch_motion_t tmp = motion[i];
+        motion[i].vx = (int32_t)(((int64_t)m.a * tmp.vx + (int64_t)m.b * tmp.vy) >> 16);
+        motion[i].vy = (int32_t)(((int64_t)m.d * tmp.vx + (int64_t)m.e * tmp.vy) >> 16);
+        motion[i].ax = (int32_t)(((int64_t)m.a * tmp.ax + (int64_t)m.b * tmp.ay) >> 16);
+        motion[i].ay = (int32_t)(((int64_t)m.d * tmp.ax + (int64_t)m.e * tmp.ay) >> 16);
     }
 
-    /* Software coordinates adjustment needed */
-    bool sw_adj_needed = ((tp->config.flags.mirror_x && (tp->set_mirror_x == NULL)) ||
-                          (tp->config.flags.mirror_y && (tp->set_mirror_y == NULL)) ||
-                          (tp->config.flags.swap_xy && (tp->set_swap_xy == NULL)));
+    return (*point_num > 0);
+}
+#endif
 
-    /* Adjust all coordinates */
-    for (int i = 0; (sw_adj_needed && i < *point_num); i++) {
+#if (CONFIG_ESP_LCD_TOUCH_HISTORY_LEN > 0)
+uint8_t esp_lcd_touch_get_history(esp_lcd_touch_handle_t tp, esp_lcd_touch_history_t *samples, uint8_t max_samples)
+{
+    uint8_t cnt = 0;
 
-        /*  Mirror X coordinates (if not supported by HW) */
-        if (tp->config.flags.mirror_x && tp->set_mirror_x == NULL) {
-            x[i] = tp->config.x_max - x[i];
-        }
+    assert(tp != NULL);
+    assert(samples != NULL);
 
-        /*  Mirror Y coordinates (if not supported by HW) */
-        if (tp->config.flags.mirror_y && tp->set_mirror_y == NULL) {
-            y[i] = tp->config.y_max - y[i];
-        }
+    portENTER_CRITICAL(&tp->data.lock);
+    while (cnt < max_samples && tp->sample.history_cnt > 0) {
+        samples[cnt++] = tp->sample.history[tp->sample.history_head];
+        tp->sample.history_head = (tp->sample.history_head + 1) % CONFIG_ESP_LCD_TOUCH_HISTORY_LEN;
+        tp->sample.history_cnt--;
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
 
-        /* Swap X and Y coordinates (if not supported by HW) */
-        if (tp->config.flags.swap_xy && tp->set_swap_xy == NULL) {
-            uint16_t tmp = x[i];
-            x[i] = y[i];
-            y[i] = tmp;
+    for (int i = 0; i < cnt; i++) {
+        if (samples[i].points > 0) {
+            touch_adjust_coordinates(tp, samples[i].x, samples[i].y, samples[i].strength, &samples[i].points, CONFIG_ESP_LCD_TOUCH_MAX_POINTS);
         }
     }
 
-    return touched;
+    return cnt;
 }
+#endif
 
 #if (CONFIG_ESP_LCD_TOUCH_MAX_BUTTONS > 0)
 esp_err_t esp_lcd_touch_get_button_state(esp_lcd_touch_handle_t tp, uint8_t n, uint8_t *state)
@@ -129,6 +264,7 @@ esp_err_t esp_lcd_touch_set_swap_xy(esp_lcd_touch_handle_t tp, bool swap)
     assert(tp != NULL);
 
     tp->config.flags.swap_xy = swap;
+    tp->transform.valid = false;
 
     /* Is swap supported by HW? */
     if (tp->set_swap_xy) {
@@ -158,6 +294,7 @@ esp_err_t esp_lcd_touch_set_mirror_x(esp_lcd_touch_handle_t tp, bool mirror)
     assert(tp != NULL);
 
     tp->config.flags.mirror_x = mirror;
+    tp->transform.valid = false;
 
     /* Is mirror supported by HW? */
     if (tp->set_mirror_x) {
@@ -187,6 +324,7 @@ esp_err_t esp_lcd_touch_set_mirror_y(esp_lcd_touch_handle_t tp, bool mirror)
     assert(tp != NULL);
 
     tp->config.flags.mirror_y = mirror;
+    tp->transform.valid = false;
 
     /* Is mirror supported by HW? */
     if (tp->set_mirror_y) {
@@ -222,6 +360,86 @@ esp_err_t esp_lcd_touch_del(esp_lcd_touch_handle_t tp)
     return ESP_OK;
 }
 
+esp_err_t esp_lcd_touch_set_calibration(esp_lcd_touch_handle_t tp, const esp_lcd_touch_matrix_t *matrix)
+{
+    assert(tp != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    tp->transform.calibrated = (matrix != NULL);
+    if (matrix) {
+        tp->transform.calibration = *matrix;
+    }
+    tp->transform.valid = false;
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_touch_get_calibration(esp_lcd_touch_handle_t tp, esp_lcd_touch_matrix_t *matrix)
+{
+    assert(tp != NULL);
+    assert(matrix != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    if (tp->transform.calibrated) {
+        *matrix = tp->transform.calibration;
+    } else {
+        *matrix = (esp_lcd_touch_matrix_t) {
+            .a = ESP_LCD_TOUCH_MATRIX_ONE,
+            .e = ESP_LCD_TOUCH_MATRIX_ONE,
+        };
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_touch_calibrate(const esp_lcd_touch_calib_point_t *points, uint8_t point_num, esp_lcd_touch_matrix_t *matrix)
+{
+    ESP_RETURN_ON_FALSE(points && matrix && point_num >= 3, ESP_ERR_INVALID_ARG, TAG, "At least 3 points needed");
+
+    /* Least squares: normal equations of X' = a*x + b*y + c (and Y' = d*x + e*y + f) */
+    double sxx = 0, sxy = 0, syy = 0, sx = 0, sy = 0, n = point_num;
+    double sxX = 0, syX = 0, sX = 0, sxY = 0, syY = 0, sY = 0;
+    for (int i = 0; i < point_num; i++) {
+        const double x = points[i].touch.x;
+        const double y = points[i].touch.y;
+        const double X = points[i].display.x;
+        const double Y = points[i].display.y;
+        sxx += x * x;
+        sxy += x * y;
+        syy += y * y;
+        sx += x;
+        sy += y;
+        sxX += x * X;
+        syX += y * X;
+        sX += X;
+        sxY += x * Y;
+        syY += y * Y;
+        sY += Y;
+    }
+
+    /* Cramer's rule for | sxx sxy sx | | syy sy | | n | system */
+    const double det = sxx * (syy * n - sy * sy) - sxy * (sxy * n - sy * sx) + sx * (sxy * sy - syy * sx);
+    ESP_RETURN_ON_FALSE(fabs(det) > 1e-6 * (sxx + syy + 1.0), ESP_ERR_INVALID_ARG, TAG, "Calibration points are on one line");
+
+    const double a = (sxX * (syy * n - sy * sy) - sxy * (syX * n - sy * sX) + sx * (syX * sy - syy * sX)) / det;
+    const double b = (sxx * (syX * n - sy * sX) - sxX * (sxy * n - sy * sx) + sx * (sxy * sX - syX * sx)) / det;
+    const double c = (sxx * (syy * sX - sy * syX) - sxy * (sxy * sX - sx * syX) + sxX * (sxy * sy - syy * sx)) / det;
+    const double d = (sxY * (syy * n - sy * sy) - sxy * (syY * n - sy * sY) + sx * (syY * sy - syy * sY)) / det;
+    const double e = (sxx * (syY * n - sy * sY) - sxY * (sxy * n - sy * sx) + sx * (sxy * sY - syY * sx)) / det;
+    const double f = (sxx * (syy * sY - sy * syY) - sxy * (sxy * sY - sx * syY) + sxY * (sxy * sy - syy * sx)) / det;
+
+    matrix->a = (int32_t)lround(a * ESP_LCD_TOUCH_MATRIX_ONE);
+    matrix->b = (int32_t)lround(b * ESP_LCD_TOUCH_MATRIX_ONE);
+    matrix->c = (int32_t)lround(c * ESP_LCD_TOUCH_MATRIX_ONE);
+    matrix->d = (int32_t)lround(d * ESP_LCD_TOUCH_MATRIX_ONE);
+    matrix->e = (int32_t)lround(e * ESP_LCD_TOUCH_MATRIX_ONE);
+    matrix->f = (int32_t)lround(f * ESP_LCD_TOUCH_MATRIX_ONE);
+
+    return ESP_OK;
+}
+
 esp_err_t esp_lcd_touch_register_interrupt_callback(esp_lcd_touch_handle_t tp, esp_lcd_touch_interrupt_callback_t callback)
 {
     esp_err_t ret = ESP_OK;
@@ -244,7 +462,7 @@ esp_err_t esp_lcd_touch_register_interrupt_callback(esp_lcd_touch_handle_t tp, e
         /* Add GPIO ISR handler */
         ret = gpio_intr_enable(tp->config.int_gpio_num);
         ESP_RETURN_ON_ERROR(ret, TAG, "GPIO ISR install failed");
-        ret = gpio_isr_handler_add(tp->config.int_gpio_num, (gpio_isr_t)tp->config.interrupt_callback, tp);
+        ret = gpio_isr_handler_add(tp->config.int_gpio_num, touch_isr, tp);
         ESP_RETURN_ON_ERROR(ret, TAG, "GPIO ISR install failed");
     } else {
         /* Remove GPIO ISR handler */
@@ -264,3 +482,254 @@ esp_err_t esp_lcd_touch_register_interrupt_callback_with_data(esp_lcd_touch_hand
     tp->config.user_data = user_data;
     return esp_lcd_touch_register_interrupt_callback(tp, callback);
 }
+
+/*******************************************************************************
+* Private API function
+*******************************************************************************/
+
+static esp_err_t touch_read_blocking(esp_lcd_touch_handle_t tp)
+{
+    const int64_t start = esp_timer_get_time();
+    esp_err_t err = tp->read_data(tp);
+    touch_sample_update(tp, start, err);
+    return err;
+}
+
+static void touch_read_async_done(esp_lcd_touch_handle_t tp, esp_err_t err, void *user_ctx)
+{
+    touch_sample_update(tp, tp->async.start, err);
+    tp->async.done_cb(tp, err, tp->async.user_ctx);
+}
+
+#if CONFIG_ESP_LCD_TOUCH_MOTION
+/* Change per second */
+static inline int32_t touch_motion_rate(int32_t diff, int64_t dt)
+{
+    return (int32_t)((int64_t)diff * 1000000 / dt);
+}
+#endif
+
+static void touch_sample_update(esp_lcd_touch_handle_t tp, int64_t start, esp_err_t err)
+{
+    if (err != ESP_OK) {
+        return;
+    }
+
+    portENTER_CRITICAL(&tp->data.lock);
+    /* Interrupt, which came during the read, belongs to the next sample */
+    int64_t timestamp = start;
+    if (tp->sample.irq_time != 0 && tp->sample.irq_time <= start) {
+        timestamp = tp->sample.irq_time;
+        tp->sample.irq_time = 0;
+    }
+
+#if CONFIG_ESP_LCD_TOUCH_MOTION
+    const int64_t dt = timestamp - tp->sample.timestamp;
+    const bool continuous = (tp->sample.timestamp != 0 && dt > 0 && dt <= CONFIG_ESP_LCD_TOUCH_MOTION_MAX_GAP_MS * 1000);
+    const uint8_t points = (tp->data.points > CONFIG_ESP_LCD_TOUCH_MAX_POINTS ? CONFIG_ESP_LCD_TOUCH_MAX_POINTS : tp->data.points);
+
+    for (int i = 0; i < points; i++) {
+        const int32_t x = tp->data.coords[i].x;
+        const int32_t y = tp->data.coords[i].y;
+        esp_lcd_touch_motion_t *motion = &tp->sample.point[i].motion;
+
+        /* New press (or too old previous sample) */
+        if (i >= tp->sample.points || !continuous) {
+            tp->sample.point[i].samples = 0;
+        }
+
+        if (tp->sample.point[i].samples == 0) {
+            *motion = (esp_lcd_touch_motion_t) {
+                0
+            };
+        } else {
+            int32_t vx = touch_motion_rate(x - tp->sample.point[i].x, dt);
+            int32_t vy = touch_motion_rate(y - tp->sample.point[i].y, dt);
+            /* Smooth velocity, acceleration needs two velocities */
+            if (tp->sample.point[i].samples > 1) {
+                vx = (motion->vx + vx) / 2;
+                vy = (motion->vy + vy) / 2;
+                motion->ax = touch_motion_rate(vx - motion->vx, dt);
+                motion->ay = touch_motion_rate(vy - motion->vy, dt);
+            }
+            motion->vx = vx;
+            motion->vy = vy;
+        }
+
+        tp->sample.point[i].x = x;
+        tp->sample.point[i].y = y;
+        if (tp->sample.point[i].samples < UINT8_MAX) {
+            tp->sample.point[i].samples++;
+        }
+    }
+    tp->sample.points = points;
+#endif
+
+#if (CONFIG_ESP_LCD_TOUCH_HISTORY_LEN > 0)
+    /* Save touched samples and the first released one, overwrite the oldest one when full */
+    const uint8_t history_points = (tp->data.points > CONFIG_ESP_LCD_TOUCH_MAX_POINTS ? CONFIG_ESP_LCD_TOUCH_MAX_POINTS : tp->data.points);
+    if (history_points > 0 || tp->sample.history_touched) {
+        if (tp->sample.history_cnt == CONFIG_ESP_LCD_TOUCH_HISTORY_LEN) {
+            tp->sample.history_head = (tp->sample.history_head + 1) % CONFIG_ESP_LCD_TOUCH_HISTORY_LEN;
+            tp->sample.history_cnt--;
+        }
+        esp_lcd_touch_history_t *entry = &tp->sample.history[(tp->sample.history_head + tp->sample.history_cnt) % CONFIG_ESP_LCD_TOUCH_HISTORY_LEN];
+        entry->timestamp = timestamp;
+        entry->points = history_points;
+        for (int i = 0; i < history_points; i++) {
+            entry->x[i] = tp->data.coords[i].x;
+            entry->y[i] = tp->data.coords[i].y;
+            entry->strength[i] = tp->data.coords[i].strength;
+        }
+        tp->sample.history_cnt++;
+        tp->sample.history_touched = (history_points > 0);
+    }
+#endif
+
+    tp->sample.timestamp = timestamp;
+    portEXIT_CRITICAL(&tp->data.lock);
+}
+
+static void touch_get_matrix(esp_lcd_touch_handle_t tp, esp_lcd_touch_matrix_t *matrix, bool *identity)
+{
+    portENTER_CRITICAL(&tp->data.lock);
+    if (!tp->transform.valid) {
+        /* Software mirror and swap (if not supported by HW) */
+        esp_lcd_touch_matrix_t m = {
+            .a = ESP_LCD_TOUCH_MATRIX_ONE,
+            .e = ESP_LCD_TOUCH_MATRIX_ONE,
+        };
+        if (tp->config.flags.mirror_x && tp->set_mirror_x == NULL) {
+            m.a = -ESP_LCD_TOUCH_MATRIX_ONE;
+            m.c = tp->config.x_max * ESP_LCD_TOUCH_MATRIX_ONE;
+        }
+        if (tp->config.flags.mirror_y && tp->set_mirror_y == NULL) {
+            m.e = -ESP_LCD_TOUCH_MATRIX_ONE;
+            m.f = tp->config.y_max * ESP_LCD_TOUCH_MATRIX_ONE;
+        }
+        if (tp->config.flags.swap_xy && tp->set_swap_xy == NULL) {
+            m = (esp_lcd_touch_matrix_t) {
+                .a = m.d, .b = m.e, .c = m.f,
+                .d = m.a, .e = m.b, .f = m.c,
+            };
+        }
+
+        /* Calibration after mirror and swap */
+        if (tp->transform.calibrated) {
+            const esp_lcd_touch_matrix_t *k = &tp->transform.calibration;
+            const esp_lcd_touch_matrix_t s = m;
+            m.a = (int32_t)(((int64_t)k->a * s.a + (int64_t)k->b * s.d) >> 16);
+            m.b = (int32_t)(((int64_t)k->a * s.b + (int64_t)k->b * s.e) >> 16);
+            m.c = (int32_t)((((int64_t)k->a * s.c + (int64_t)k->b * s.f) >> 16) + k->c);
+            m.d = (int32_t)(((int64_t)k->d * s.a + (int64_t)k->e * s.d) >> 16);
+            m.e = (int32_t)(((int64_t)k->d * s.b + (int64_t)k->e * s.e) >> 16);
+            m.f = (int32_t)((((int64_t)k->d * s.c + (int64_t)k->e * s.f) >> 16) + k->f);
+        }
+
+        tp->transform.matrix = m;
+        tp->transform.identity = (m.a == ESP_LCD_TOUCH_MATRIX_ONE && m.b == 0 && m.c == 0 &&
+                                  m.d == 0 && m.e == ESP_LCD_TOUCH_MATRIX_ONE && m.f == 0);
+        tp->transform.valid = true;
+    }
+    *matrix = tp->transform.matrix;
+    *identity = tp->transform.identity;
+    portEXIT_CRITICAL(&tp->data.lock);
+}
+
+static inline uint16_t touch_clamp_coordinate(int64_t value)
+{
+    /* Round and clamp to the coordinates range */
+    value = (value + (ESP_LCD_TOUCH_MATRIX_ONE / 2)) >> 16;
+    return (value < 0) ? 0 : ((value > UINT16_MAX) ? UINT16_MAX : (uint16_t)value);
+}
+
+static void touch_adjust_coordinates(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength, uint8_t *point_num, uint8_t max_point_num)
+{
+    /* Process coordinates by user */
+    if (tp->config.process_coordinates != NULL) {
+        tp->config.process_coordinates(tp, x, y, strength, point_num, max_point_num);
+    }
+
+    esp_lcd_touch_matrix_t m;
+    bool identity;
+    touch_get_matrix(tp, &m, &identity);
+
+    /* Transform all coordinates (mirror, swap and calibration at once) */
+    for (int i = 0; (!identity && i < *point_num); i++) {
+        const int64_t tx = x[i];
+        const int64_t ty = y[i];
+        x[i] = touch_clamp_coordinate(m.a * tx + m.b * ty + m.c);
+        y[i] = touch_clamp_coordinate(m.d * tx + m.e * ty + m.f);
+    }
+}
+
+static void touch_isr(void *arg)
+{
+    esp_lcd_touch_handle_t tp = (esp_lcd_touch_handle_t)arg;
+    const int64_t now = esp_timer_get_time();
+
+    /* Keep time of the first interrupt since the last read */
+    portENTER_CRITICAL_ISR(&tp->data.lock);
+    if (tp->sample.irq_time == 0) {
+        tp->sample.irq_time = now;
+    }
+    portEXIT_CRITICAL_ISR(&tp->data.lock);
+
+    if (tp->config.interrupt_callback) {
+        tp->config.interrupt_callback(tp);
+    }
+}
+
+static esp_err_t touch_read_task_init(void)
+{
+    QueueHandle_t queue;
+    bool created = false;
+
+    taskENTER_CRITICAL(&touch_read_lock);
+    queue = touch_read_queue;
+    taskEXIT_CRITICAL(&touch_read_lock);
+    if (queue) {
+        return ESP_OK;
+    }
+
+    queue = xQueueCreate(ESP_LCD_TOUCH_READ_QUEUE_LEN, sizeof(touch_read_req_t));
+    ESP_RETURN_ON_FALSE(queue, ESP_ERR_NO_MEM, TAG, "Not enough memory for read queue");
+
+    /* Only one of concurrent callers creates the read task */
+    taskENTER_CRITICAL(&touch_read_lock);
+    if (touch_read_queue == NULL) {
+        touch_read_queue = queue;
+        created = true;
+    }
+    taskEXIT_CRITICAL(&touch_read_lock);
+    if (!created) {
+        vQueueDelete(queue);
+        return ESP_OK;
+    }
+
+    BaseType_t res = xTaskCreate(touch_read_task, "taskTouchRead", CONFIG_ESP_LCD_TOUCH_READ_TASK_STACK, queue,
+                                 CONFIG_ESP_LCD_TOUCH_READ_TASK_PRIORITY, NULL);
+    if (res != pdPASS) {
+        taskENTER_CRITICAL(&touch_read_lock);
+        touch_read_queue = NULL;
+        taskEXIT_CRITICAL(&touch_read_lock);
+        vQueueDelete(queue);
+        ESP_LOGE(TAG, "Create read task fail!");
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+static void touch_read_task(void *arg)
+{
+    QueueHandle_t queue = (QueueHandle_t)arg;
+    touch_read_req_t req;
+
+    while (1) {
+        if (xQueueReceive(queue, &req, portMAX_DELAY) == pdTRUE) {
+            esp_err_t err = touch_read_blocking(req.tp);
+            req.done_cb(req.tp, err, req.user_ctx);
+        }
+    }
+}
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "sdkconfig.h"
 #include "esp_err.h"
 #include "driver/gpio.h"
@@ -36,6 +37,24 @@ typedef esp_lcd_touch_t *esp_lcd_touch_handle_t;
  */
 typedef void (*esp_lcd_touch_interrupt_callback_t)(esp_lcd_touch_handle_t tp);
 
+/**
+ * @brief Touch controller power mode
+ */
+typedef enum {
+    ESP_LCD_TOUCH_POWER_MODE_ACTIVE = 0,    /*!< Normal scanning (default) */
+    ESP_LCD_TOUCH_POWER_MODE_MONITOR,       /*!< Low rate scanning, touch is signaled by interrupt (wakes the SoC) */
+    ESP_LCD_TOUCH_POWER_MODE_SLEEP,         /*!< Sleep, touch is not detected (as esp_lcd_touch_enter_sleep) */
+} esp_lcd_touch_power_mode_t;
+
+/**
+ * @brief Touch controller read done callback type
+ *
+ * @param tp: Touch handler
+ * @param err: Result of the read, new data can be got by esp_lcd_touch_get_coordinates on ESP_OK
+ * @param user_ctx: User data passed to esp_lcd_touch_read_data_async
+ */
+typedef void (*esp_lcd_touch_read_done_cb_t)(esp_lcd_touch_handle_t tp, esp_err_t err, void *user_ctx);
+
 /**
  * @brief Touch Configuration Type
  *
@@ -88,6 +107,84 @@ typedef struct {
     portMUX_TYPE lock; /*!< Lock for read/write */
 } esp_lcd_touch_data_t;
 
+/**
+ * @brief Motion of one touch point
+ *
+ * @note Zero for the first sample after press and after a gap longer than CONFIG_ESP_LCD_TOUCH_MOTION_MAX_GAP_MS.
+ */
+typedef struct {
+    int32_t vx; /*!< X velocity in pixels per second */
+    int32_t vy; /*!< Y velocity in pixels per second */
+    int32_t ax; /*!< X acceleration in pixels per second^2 */
+    int32_t ay; /*!< Y acceleration in pixels per second^2 */
+} esp_lcd_touch_motion_t;
+
+/**
+ * @brief Affine transformation of touch coordinates (fixed point, 16 fractional bits)
+ *
+ * x' = (a * x + b * y + c) / 65536
+ * y' = (d * x + e * y + f) / 65536
+ */
+typedef struct {
+    int32_t a; /*!< X' coefficient of X */
+    int32_t b; /*!< X' coefficient of Y */
+    int32_t c; /*!< X' offset */
+    int32_t d; /*!< Y' coefficient of X */
+    int32_t e; /*!< Y' coefficient of Y */
+    int32_t f; /*!< Y' offset */
+} esp_lcd_touch_matrix_t;
+
+/**
+ * @brief One calibration point
+ */
+typedef struct {
+    struct {
+        uint16_t x; /*!< X coordinate */
+        uint16_t y; /*!< Y coordinate */
+    } touch;        /*!< Coordinates got from esp_lcd_touch_get_coordinates without calibration */
+    struct {
+        uint16_t x; /*!< X coordinate */
+        uint16_t y; /*!< Y coordinate */
+    } display;      /*!< Coordinates of the target shown on the display */
+} esp_lcd_touch_calib_point_t;
+
+#if (CONFIG_ESP_LCD_TOUCH_HISTORY_LEN > 0)
+/**
+ * @brief One read sample saved in the history
+ */
+typedef struct {
+    int64_t timestamp;                                  /*!< Time of the sample in microseconds (esp_timer) */
+    uint8_t points;                                     /*!< Count of touch points (0: released) */
+    uint16_t x[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];        /*!< X coordinates */
+    uint16_t y[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];        /*!< Y coordinates */
+    uint16_t strength[CONFIG_ESP_LCD_TOUCH_MAX_POINTS]; /*!< Strength */
+} esp_lcd_touch_history_t;
+#endif
+
+/**
+ * @brief Timing (motion and history) of the read samples, updated by esp_lcd_touch after each read
+ */
+typedef struct {
+    int64_t irq_time;   /*!< Time of the first interrupt since the last read (0: no interrupt) */
+    int64_t timestamp;  /*!< Time of the last read sample in microseconds (esp_timer) */
+#if CONFIG_ESP_LCD_TOUCH_MOTION
+    uint8_t points;     /*!< Count of touch points of the last read sample */
+
+    struct {
+        uint16_t x;                     /*!< Last X coordinate (controller coordinates) */
+        uint16_t y;                     /*!< Last Y coordinate (controller coordinates) */
+        uint8_t samples;                /*!< Count of samples since press (saturated) */
+        esp_lcd_touch_motion_t motion;  /*!< Estimated motion (controller coordinates) */
+    } point[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+#endif
+#if (CONFIG_ESP_LCD_TOUCH_HISTORY_LEN > 0)
+    uint8_t history_head;   /*!< Index of the oldest saved sample */
+    uint8_t history_cnt;    /*!< Count of saved samples */
+    bool history_touched;   /*!< Last saved sample has touch points */
+    esp_lcd_touch_history_t history[CONFIG_ESP_LCD_TOUCH_HISTORY_LEN]; /*!< Ring of the last read samples */
+#endif
+} esp_lcd_touch_sample_t;
+
 /**
  * @brief Declare of Touch Type
  *
@@ -118,6 +215,19 @@ struct esp_lcd_touch_s {
      */
     esp_err_t (*exit_sleep)(esp_lcd_touch_handle_t tp);
 
+    /**
+     * @brief Set power mode of touch controller (optional)
+     *
+     * @note The current mode is in power_mode, it is updated by esp_lcd_touch after success.
+     *
+     * @param tp: Touch handler
+     * @param mode: New power mode
+     *
+     * @return
+     *      - ESP_OK on success, otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*set_power_mode)(esp_lcd_touch_handle_t tp, esp_lcd_touch_power_mode_t mode);
+
     /**
      * @brief Read data from touch controller (mandatory)
      *
@@ -130,6 +240,20 @@ struct esp_lcd_touch_s {
      */
     esp_err_t (*read_data)(esp_lcd_touch_handle_t tp);
 
+    /**
+     * @brief Start reading data from touch controller without blocking (optional)
+     *
+     * @note The driver calls done_cb from its own task or ISR context, when the data are read.
+     *
+     * @param tp: Touch handler
+     * @param done_cb: Callback called when the read is finished
+     * @param user_ctx: User data passed to done_cb
+     *
+     * @return
+     *      - ESP_OK on success (done_cb will be called), otherwise returns ESP_ERR_xxx
+     */
+    esp_err_t (*read_data_async)(esp_lcd_touch_handle_t tp, esp_lcd_touch_read_done_cb_t done_cb, void *user_ctx);
+
     /**
      * @brief Get coordinates from touch controller (mandatory)
      *
@@ -253,6 +377,36 @@ struct esp_lcd_touch_s {
      * @brief Data structure
      */
     esp_lcd_touch_data_t data;
+
+    /**
+     * @brief Timing and motion of samples (protected by data.lock)
+     */
+    esp_lcd_touch_sample_t sample;
+
+    /**
+     * @brief Current power mode
+     */
+    esp_lcd_touch_power_mode_t power_mode;
+
+    /**
+     * @brief Transformation of coordinates (calibration, software mirror and swap)
+     */
+    struct {
+        esp_lcd_touch_matrix_t calibration; /*!< User calibration (applied after mirror and swap) */
+        esp_lcd_touch_matrix_t matrix;      /*!< Combined transformation, computed when settings change */
+        bool calibrated;                    /*!< User calibration is set */
+        bool valid;                         /*!< Combined transformation is up to date */
+        bool identity;                      /*!< Combined transformation doesn't change coordinates */
+    } transform;
+
+    /**
+     * @brief Pending asynchronous read of the driver
+     */
+    struct {
+        esp_lcd_touch_read_done_cb_t done_cb;   /*!< User callback */
+        void *user_ctx;                         /*!< User data passed to done_cb */
+        int64_t start;                          /*!< Time of the read start */
+    } async;
 };
 
 /**
@@ -271,6 +425,118 @@ struct esp_lcd_touch_s {
  */
 esp_err_t esp_lcd_touch_read_data(esp_lcd_touch_handle_t tp);
 
+/**
+ * @brief Start reading data from touch controller without blocking
+ *
+ * The read is done by the driver (if it supports asynchronous read) or by the common read task
+ * of this component, the caller is not blocked by the touch bus.
+ *
+ * @note Start a new read of the same touch after the previous done_cb only.
+ * @note done_cb is called from the driver or read task context, it must not block.
+ *
+ * @param tp: Touch handler
+ * @param done_cb: Callback called when the read is finished
+ * @param user_ctx: User data passed to done_cb
+ *
+ * @return
+ *     - ESP_OK                 on success (done_cb will be called)
+ *     - ESP_ERR_NO_MEM         read task cannot be created
+ *     - ESP_ERR_TIMEOUT        too many reads are pending
+ */
+esp_err_t esp_lcd_touch_read_data_async(esp_lcd_touch_handle_t tp, esp_lcd_touch_read_done_cb_t done_cb, void *user_ctx);
+
+/**
+ * @brief Get time of the last read sample
+ *
+ * The time is captured in the interrupt handler (if the interrupt callback is registered),
+ * otherwise at the beginning of the read.
+ *
+ * @param tp: Touch handler
+ * @param timestamp: Output time in microseconds (esp_timer_get_time)
+ *
+ * @return
+ *     - ESP_OK                 on success
+ *     - ESP_ERR_INVALID_STATE  no sample was read yet
+ */
+esp_err_t esp_lcd_touch_get_timestamp(esp_lcd_touch_handle_t tp, int64_t *timestamp);
+
+#if CONFIG_ESP_LCD_TOUCH_MOTION
+/**
+ * @brief Get velocity and acceleration of touch points of the last read sample
+ *
+ * Mirror and swap of the axes are applied as in esp_lcd_touch_get_coordinates, process_coordinates callback is not.
+ * Unlike esp_lcd_touch_get_coordinates, it doesn't invalidate the read data.
+ *
+ * @param tp: Touch handler
+ * @param motion: Array of motion of touch points
+ * @param point_num: Count of touch points
+ * @param max_point_num: Maximum count of touch points
+ *
+ * @return
+ *     - Returns true, when touched
+ */
+bool esp_lcd_touch_get_motion(esp_lcd_touch_handle_t tp, esp_lcd_touch_motion_t *motion, uint8_t *point_num, uint8_t max_point_num);
+#endif
+
+#if (CONFIG_ESP_LCD_TOUCH_HISTORY_LEN > 0)
+/**
+ * @brief Get saved samples from the history (oldest first) and remove them from the history
+ *
+ * Every read with touch points and the first read after release are saved into the history,
+ * when it is full, the oldest sample is overwritten. Coordinates are processed as in esp_lcd_touch_get_coordinates.
+ * The history is independent of esp_lcd_touch_get_coordinates, which returns the last read sample only.
+ *
+ * @param tp: Touch handler
+ * @param samples: Array of output samples
+ * @param max_samples: Maximum count of output samples
+ *
+ * @return
+ *     - Count of returned samples
+ */
+uint8_t esp_lcd_touch_get_history(esp_lcd_touch_handle_t tp, esp_lcd_touch_history_t *samples, uint8_t max_samples);
+#endif
+
+/**
+ * @brief Set calibration of touch coordinates
+ *
+ * The calibration is applied to all coordinates after mirror and swap (if they are not supported by HW)
+ * and after process_coordinates callback.
+ *
+ * @param tp: Touch handler
+ * @param matrix: Calibration (e.g. from esp_lcd_touch_calibrate), NULL for no calibration
+ *
+ * @return
+ *     - ESP_OK on success
+ */
+esp_err_t esp_lcd_touch_set_calibration(esp_lcd_touch_handle_t tp, const esp_lcd_touch_matrix_t *matrix);
+
+/**
+ * @brief Get calibration of touch coordinates
+ *
+ * @param tp: Touch handler
+ * @param matrix: Output calibration (identity, when not set)
+ *
+ * @return
+ *     - ESP_OK on success
+ */
+esp_err_t esp_lcd_touch_get_calibration(esp_lcd_touch_handle_t tp, esp_lcd_touch_matrix_t *matrix);
+
+/**
+ * @brief Compute calibration from touched targets
+ *
+ * With 3 points, the calibration maps them exactly, more points (e.g. 5) are fitted by least squares.
+ * Touch coordinates must be got with no calibration set (see esp_lcd_touch_set_calibration).
+ *
+ * @param points: Array of calibration points
+ * @param point_num: Count of calibration points (at least 3)
+ * @param matrix: Output calibration
+ *
+ * @return
+ *     - ESP_OK                 on success
+ *     - ESP_ERR_INVALID_ARG    less than 3 points or the points are on one line
+ */
+esp_err_t esp_lcd_touch_calibrate(const esp_lcd_touch_calib_point_t *points, uint8_t point_num, esp_lcd_touch_matrix_t *matrix);
+
 /**
  * @brief Read coordinates from touch controller
  *
@@ -424,6 +690,34 @@ esp_err_t esp_lcd_touch_enter_sleep(esp_lcd_touch_handle_t tp);
  */
 esp_err_t esp_lcd_touch_exit_sleep(esp_lcd_touch_handle_t tp);
 
+/**
+ * @brief Set power mode of touch controller
+ *
+ * In monitor mode, the controller scans with low rate and signals touch by the interrupt pin,
+ * so the application (and the display) can stop until the touch.
+ *
+ * @note Return from sleep mode can reset the touch controller.
+ *
+ * @param tp: Touch handler
+ * @param mode: New power mode
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_SUPPORTED     power mode is not supported by the driver
+ */
+esp_err_t esp_lcd_touch_set_power_mode(esp_lcd_touch_handle_t tp, esp_lcd_touch_power_mode_t mode);
+
+/**
+ * @brief Get power mode of touch controller
+ *
+ * @param tp: Touch handler
+ * @param mode: Output power mode
+ *
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t esp_lcd_touch_get_power_mode(esp_lcd_touch_handle_t tp, esp_lcd_touch_power_mode_t *mode);
+
 #ifdef __cplusplus
 }
 #endif
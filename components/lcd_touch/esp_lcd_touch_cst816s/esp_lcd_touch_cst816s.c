@@ -21,14 +21,24 @@
 
 #define DATA_START_REG      (0x02)
 #define CHIP_ID_REG         (0xA7)
+#define SLEEP_MODE_REG      (0xE5)
+#define AUTO_SLEEP_TIME_REG (0xF9)
+#define IRQ_CTL_REG         (0xFA)
+#define DIS_AUTO_SLEEP_REG  (0xFE)
+
+#define SLEEP_MODE_DEEP     (0x03)
+#define IRQ_CTL_EN_TOUCH    (0x40)
+#define IRQ_CTL_EN_CHANGE   (0x20)
 
 static const char *TAG = "CST816S";
 
 static esp_err_t read_data(esp_lcd_touch_handle_t tp);
 static bool get_xy(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength, uint8_t *point_num, uint8_t max_point_num);
+static esp_err_t set_power_mode(esp_lcd_touch_handle_t tp, esp_lcd_touch_power_mode_t mode);
 static esp_err_t del(esp_lcd_touch_handle_t tp);
 
 static esp_err_t i2c_read_bytes(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t *data, uint8_t len);
+static esp_err_t i2c_write_byte(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t data);
 
 static esp_err_t reset(esp_lcd_touch_handle_t tp);
 static esp_err_t read_id(esp_lcd_touch_handle_t tp);
@@ -49,6 +59,7 @@ esp_err_t esp_lcd_touch_new_i2c_cst816s(const esp_lcd_panel_io_handle_t io, cons
     /* Only supported callbacks are set */
     cst816s->read_data = read_data;
     cst816s->get_xy = get_xy;
+    cst816s->set_power_mode = set_power_mode;
     cst816s->del = del;
     /* Mutex */
     cst816s->data.lock.owner = portMUX_FREE_VAL;
@@ -140,6 +151,35 @@ static bool get_xy(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t
     return (*point_num > 0);
 }
 
+static esp_err_t set_power_mode(esp_lcd_touch_handle_t tp, esp_lcd_touch_power_mode_t mode)
+{
+    /* Deep sleep is left by reset only */
+    if (tp->power_mode == ESP_LCD_TOUCH_POWER_MODE_SLEEP) {
+        ESP_RETURN_ON_FALSE(tp->config.rst_gpio_num != GPIO_NUM_NC, ESP_ERR_NOT_SUPPORTED, TAG, "Wake up needs reset pin");
+        ESP_RETURN_ON_ERROR(reset(tp), TAG, "Reset failed");
+    }
+
+    switch (mode) {
+    case ESP_LCD_TOUCH_POWER_MODE_ACTIVE:
+        /* Keep scanning with normal rate */
+        ESP_RETURN_ON_ERROR(i2c_write_byte(tp, DIS_AUTO_SLEEP_REG, 0x01), TAG, "I2C write failed");
+        break;
+    case ESP_LCD_TOUCH_POWER_MODE_MONITOR:
+        /* Low power scanning after 1 s without touch, interrupt on touch */
+        ESP_RETURN_ON_ERROR(i2c_write_byte(tp, IRQ_CTL_REG, IRQ_CTL_EN_TOUCH | IRQ_CTL_EN_CHANGE), TAG, "I2C write failed");
+        ESP_RETURN_ON_ERROR(i2c_write_byte(tp, AUTO_SLEEP_TIME_REG, 1), TAG, "I2C write failed");
+        ESP_RETURN_ON_ERROR(i2c_write_byte(tp, DIS_AUTO_SLEEP_REG, 0x00), TAG, "I2C write failed");
+        break;
+    case ESP_LCD_TOUCH_POWER_MODE_SLEEP:
+        ESP_RETURN_ON_ERROR(i2c_write_byte(tp, SLEEP_MODE_REG, SLEEP_MODE_DEEP), TAG, "I2C write failed");
+        break;
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return ESP_OK;
+}
+
 static esp_err_t del(esp_lcd_touch_handle_t tp)
 {
     /* Reset GPIO pin settings */
@@ -184,3 +224,8 @@ static esp_err_t i2c_read_bytes(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t
 
     return esp_lcd_panel_io_rx_param(tp->io, reg, data, len);
 }
+
+static esp_err_t i2c_write_byte(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t data)
+{
+    return esp_lcd_panel_io_tx_param(tp->io, reg, &data, 1);
+}
@@ -74,11 +74,17 @@ static const char *TAG = "FT5x06";
 #define FT5x06_ID_G_FT5201ID            (0xA8)
 #define FT5x06_ID_G_ERR                 (0xA9)
 
+/* FT5x06_ID_G_PMODE values */
+#define FT5x06_PMODE_ACTIVE             (0x00)
+#define FT5x06_PMODE_MONITOR            (0x01)
+#define FT5x06_PMODE_HIBERNATE          (0x03)
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
 static esp_err_t esp_lcd_touch_ft5x06_read_data(esp_lcd_touch_handle_t tp);
 static bool esp_lcd_touch_ft5x06_get_xy(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength, uint8_t *point_num, uint8_t max_point_num);
+static esp_err_t esp_lcd_touch_ft5x06_set_power_mode(esp_lcd_touch_handle_t tp, esp_lcd_touch_power_mode_t mode);
 static esp_err_t esp_lcd_touch_ft5x06_del(esp_lcd_touch_handle_t tp);
 
 /* I2C read */
@@ -111,6 +117,7 @@ esp_err_t esp_lcd_touch_new_i2c_ft5x06(const esp_lcd_panel_io_handle_t io, const
     /* Only supported callbacks are set */
     esp_lcd_touch_ft5x06->read_data = esp_lcd_touch_ft5x06_read_data;
     esp_lcd_touch_ft5x06->get_xy = esp_lcd_touch_ft5x06_get_xy;
+    esp_lcd_touch_ft5x06->set_power_mode = esp_lcd_touch_ft5x06_set_power_mode;
     esp_lcd_touch_ft5x06->del = esp_lcd_touch_ft5x06_del;
 
     /* Mutex */
@@ -175,8 +182,17 @@ static esp_err_t esp_lcd_touch_ft5x06_read_data(esp_lcd_touch_handle_t tp)
 
     assert(tp != NULL);
 
+#if CONFIG_ESP_LCD_TOUCH_FT5X06_BURST_READ
+    /* Number of points and all used points in one transaction (points registers follow FT5x06_TOUCH_POINTS) */
+    uint8_t burst[1 + sizeof(data)];
+    const uint8_t read_points = (CONFIG_ESP_LCD_TOUCH_MAX_POINTS < 5 ? CONFIG_ESP_LCD_TOUCH_MAX_POINTS : 5);
+    err = touch_ft5x06_i2c_read(tp, FT5x06_TOUCH_POINTS, burst, 1 + 6 * read_points);
+    ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+    points = burst[0];
+#else
     err = touch_ft5x06_i2c_read(tp, FT5x06_TOUCH_POINTS, &points, 1);
     ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+#endif
 
     if (points > 5 || points == 0) {
         return ESP_OK;
@@ -185,8 +201,12 @@ static esp_err_t esp_lcd_touch_ft5x06_read_data(esp_lcd_touch_handle_t tp)
     /* Number of touched points */
     points = (points > CONFIG_ESP_LCD_TOUCH_MAX_POINTS ? CONFIG_ESP_LCD_TOUCH_MAX_POINTS : points);
 
+#if CONFIG_ESP_LCD_TOUCH_FT5X06_BURST_READ
+    memcpy(data, &burst[1], 6 * points);
+#else
     err = touch_ft5x06_i2c_read(tp, FT5x06_TOUCH1_XH, data, 6 * points);
     ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+#endif
 
     portENTER_CRITICAL(&tp->data.lock);
 
@@ -234,6 +254,39 @@ static bool esp_lcd_touch_ft5x06_get_xy(esp_lcd_touch_handle_t tp, uint16_t *x,
     return (*point_num > 0);
 }
 
+static esp_err_t esp_lcd_touch_ft5x06_set_power_mode(esp_lcd_touch_handle_t tp, esp_lcd_touch_power_mode_t mode)
+{
+    uint8_t pmode;
+
+    assert(tp != NULL);
+
+    /* Hibernate is left by reset only */
+    if (tp->power_mode == ESP_LCD_TOUCH_POWER_MODE_SLEEP) {
+        ESP_RETURN_ON_FALSE(tp->config.rst_gpio_num != GPIO_NUM_NC, ESP_ERR_NOT_SUPPORTED, TAG, "Wake up needs reset pin!");
+        ESP_RETURN_ON_ERROR(touch_ft5x06_reset(tp), TAG, "FT5x06 reset failed");
+        ESP_RETURN_ON_ERROR(touch_ft5x06_init(tp), TAG, "FT5x06 init failed");
+    }
+
+    switch (mode) {
+    case ESP_LCD_TOUCH_POWER_MODE_ACTIVE:
+        pmode = FT5x06_PMODE_ACTIVE;
+        break;
+    case ESP_LCD_TOUCH_POWER_MODE_MONITOR:
+        /* Scanning with FT5x06_ID_G_PERIODMONITOR period, interrupt on touch */
+        pmode = FT5x06_PMODE_MONITOR;
+        break;
+    case ESP_LCD_TOUCH_POWER_MODE_SLEEP:
+        pmode = FT5x06_PMODE_HIBERNATE;
+        break;
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ESP_RETURN_ON_ERROR(touch_ft5x06_i2c_write(tp, FT5x06_ID_G_PMODE, pmode), TAG, "I2C write error!");
+
+    return ESP_OK;
+}
+
 static esp_err_t esp_lcd_touch_ft5x06_del(esp_lcd_touch_handle_t tp)
 {
     assert(tp != NULL);
@@ -0,0 +1,246 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_lcd_touch_gesture.h"
+
+static const char *TAG = "TP_GESTURE";
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef enum {
+    GESTURE_STATE_IDLE,         /* Released */
+    GESTURE_STATE_SINGLE,       /* One finger (swipe, long press) */
+    GESTURE_STATE_MULTI,        /* Two fingers (pinch, rotate) */
+    GESTURE_STATE_WAIT_RELEASE, /* Gesture finished, waiting for release of all fingers */
+} gesture_state_t;
+
+struct esp_lcd_touch_gesture_s {
+    esp_lcd_touch_gesture_config_t config;
+    gesture_state_t state;
+    int64_t start_time;         /* Start of the gesture [us] */
+    uint16_t start_x;           /* First point of one finger gesture */
+    uint16_t start_y;
+    uint16_t last_x;            /* Last point of one finger gesture */
+    uint16_t last_y;
+    bool moved;                 /* Moved over move_tolerance, not long press */
+    float start_dist;           /* Distance of two fingers at the start */
+    float start_angle;          /* Angle of two fingers at the start [rad] */
+    esp_lcd_touch_gesture_t multi;  /* Last state of two finger gesture */
+    int32_t reported_scale;     /* Scale of last pinch event */
+    int16_t reported_angle;     /* Angle of last rotate event */
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void gesture_add(esp_lcd_touch_gesture_t *events, uint8_t max_events, uint8_t *cnt, const esp_lcd_touch_gesture_t *event);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_lcd_touch_gesture_new(const esp_lcd_touch_gesture_config_t *config, esp_lcd_touch_gesture_handle_t *ret_gesture)
+{
+    ESP_RETURN_ON_FALSE(config && ret_gesture, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_lcd_touch_gesture_handle_t gesture = calloc(1, sizeof(struct esp_lcd_touch_gesture_s));
+    ESP_RETURN_ON_FALSE(gesture, ESP_ERR_NO_MEM, TAG, "no mem for gesture recognizer");
+    gesture->config = *config;
+    /* Zero steps would report every sample */
+    if (gesture->config.pinch_step == 0) {
+        gesture->config.pinch_step = 1;
+    }
+    if (gesture->config.rotate_step == 0) {
+        gesture->config.rotate_step = 1;
+    }
+
+    *ret_gesture = gesture;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_touch_gesture_del(esp_lcd_touch_gesture_handle_t gesture)
+{
+    ESP_RETURN_ON_FALSE(gesture, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    free(gesture);
+    return ESP_OK;
+}
+
+void esp_lcd_touch_gesture_reset(esp_lcd_touch_gesture_handle_t gesture)
+{
+    assert(gesture);
+    /* Fingers still pressed cannot start a new gesture */
+    gesture->state = (gesture->state == GESTURE_STATE_IDLE ? GESTURE_STATE_IDLE : GESTURE_STATE_WAIT_RELEASE);
+}
+
+uint8_t esp_lcd_touch_gesture_process_points(esp_lcd_touch_gesture_handle_t gesture, const uint16_t *x, const uint16_t *y, uint8_t point_num,
+        int64_t timestamp, esp_lcd_touch_gesture_t *events, uint8_t max_events)
+{
+    assert(gesture);
+    assert(point_num == 0 || (x && y));
+    assert(max_events == 0 || events);
+
+    const esp_lcd_touch_gesture_config_t *cfg = &gesture->config;
+    uint8_t cnt = 0;
+
+    /* First finger starts one finger gesture, it can change to two finger gesture later */
+    if (gesture->state == GESTURE_STATE_IDLE && point_num > 0) {
+        gesture->state = GESTURE_STATE_SINGLE;
+        gesture->start_time = timestamp;
+        gesture->start_x = gesture->last_x = x[0];
+        gesture->start_y = gesture->last_y = y[0];
+        gesture->moved = false;
+    }
+    const uint32_t duration_ms = (timestamp - gesture->start_time) / 1000;
+
+    switch (gesture->state) {
+    case GESTURE_STATE_SINGLE:
+        if (point_num == 1) {
+            gesture->last_x = x[0];
+            gesture->last_y = y[0];
+            if (abs(x[0] - gesture->start_x) > cfg->move_tolerance || abs(y[0] - gesture->start_y) > cfg->move_tolerance) {
+                gesture->moved = true;
+            }
+            if (!gesture->moved && duration_ms >= cfg->long_press_time_ms) {
+                const esp_lcd_touch_gesture_t event = {
+                    .type = ESP_LCD_TOUCH_GESTURE_LONG_PRESS,
+                    .x = gesture->start_x,
+                    .y = gesture->start_y,
+                    .scale = 256,
+                    .duration_ms = duration_ms,
+                };
+                gesture_add(events, max_events, &cnt, &event);
+                /* Long press cannot be a swipe */
+                gesture->state = GESTURE_STATE_WAIT_RELEASE;
+            }
+        } else if (point_num == 0) {
+            /* Released, fast and long enough move is a swipe (in the dominant direction) */
+            const int dx = gesture->last_x - gesture->start_x;
+            const int dy = gesture->last_y - gesture->start_y;
+            const uint16_t distance = sqrtf((float)(dx * dx + dy * dy)) + 0.5f;
+            if (duration_ms <= cfg->swipe_max_time_ms && distance >= cfg->swipe_min_distance) {
+                esp_lcd_touch_gesture_t event = {
+                    .x = gesture->start_x,
+                    .y = gesture->start_y,
+                    .distance = distance,
+                    .scale = 256,
+                    .duration_ms = duration_ms,
+                };
+                if (abs(dx) >= abs(dy)) {
+                    event.type = (dx < 0 ? ESP_LCD_TOUCH_GESTURE_SWIPE_LEFT : ESP_LCD_TOUCH_GESTURE_SWIPE_RIGHT);
+                } else {
+                    event.type = (dy < 0 ? ESP_LCD_TOUCH_GESTURE_SWIPE_UP : ESP_LCD_TOUCH_GESTURE_SWIPE_DOWN);
+                }
+                gesture_add(events, max_events, &cnt, &event);
+            }
+            gesture->state = GESTURE_STATE_IDLE;
+        } else {
+            /* Second finger, two finger gesture starts from here */
+            const float dx = (float)x[1] - x[0];
+            const float dy = (float)y[1] - y[0];
+            gesture->start_dist = sqrtf(dx * dx + dy * dy);
+            if (gesture->start_dist < 1.0f) {
+                gesture->start_dist = 1.0f;
+            }
+            gesture->start_angle = atan2f(dy, dx);
+            gesture->start_time = timestamp;
+            memset(&gesture->multi, 0, sizeof(gesture->multi));
+            gesture->multi.x = (x[0] + x[1]) / 2;
+            gesture->multi.y = (y[0] + y[1]) / 2;
+            gesture->multi.scale = 256;
+            gesture->reported_scale = 256;
+            gesture->reported_angle = 0;
+            gesture->state = GESTURE_STATE_MULTI;
+        }
+        break;
+    case GESTURE_STATE_MULTI:
+        if (point_num >= 2) {
+            const float dx = (float)x[1] - x[0];
+            const float dy = (float)y[1] - y[0];
+            /* Angle difference wrapped to (-180, 180] deg */
+            float angle = atan2f(dy, dx) - gesture->start_angle;
+            if (angle > (float)M_PI) {
+                angle -= 2.0f * (float)M_PI;
+            } else if (angle <= -(float)M_PI) {
+                angle += 2.0f * (float)M_PI;
+            }
+            gesture->multi.x = (x[0] + x[1]) / 2;
+            gesture->multi.y = (y[0] + y[1]) / 2;
+            gesture->multi.scale = sqrtf(dx * dx + dy * dy) * 256.0f / gesture->start_dist + 0.5f;
+            gesture->multi.angle = lroundf(angle * 1800.0f / (float)M_PI);
+            gesture->multi.duration_ms = duration_ms;
+
+            /* Only changes bigger than the step, not every sample */
+            if (abs(gesture->multi.scale - gesture->reported_scale) >= cfg->pinch_step) {
+                gesture->multi.type = ESP_LCD_TOUCH_GESTURE_PINCH;
+                gesture_add(events, max_events, &cnt, &gesture->multi);
+                gesture->reported_scale = gesture->multi.scale;
+            }
+            if (abs(gesture->multi.angle - gesture->reported_angle) >= cfg->rotate_step) {
+                gesture->multi.type = ESP_LCD_TOUCH_GESTURE_ROTATE;
+                gesture_add(events, max_events, &cnt, &gesture->multi);
+                gesture->reported_angle = gesture->multi.angle;
+            }
+        } else {
+            /* One finger was lifted, the rest does not start a new gesture */
+            gesture->multi.type = ESP_LCD_TOUCH_GESTURE_MULTI_END;
+            gesture->multi.duration_ms = duration_ms;
+            gesture_add(events, max_events, &cnt, &gesture->multi);
+            gesture->state = (point_num == 0 ? GESTURE_STATE_IDLE : GESTURE_STATE_WAIT_RELEASE);
+        }
+        break;
+    case GESTURE_STATE_WAIT_RELEASE:
+        if (point_num == 0) {
+            gesture->state = GESTURE_STATE_IDLE;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return cnt;
+}
+
+uint8_t esp_lcd_touch_gesture_process(esp_lcd_touch_gesture_handle_t gesture, esp_lcd_touch_handle_t tp, esp_lcd_touch_gesture_t *events, uint8_t max_events)
+{
+    assert(gesture);
+    assert(tp);
+
+    uint16_t x[2] = {0};
+    uint16_t y[2] = {0};
+    uint8_t point_num = 0;
+    int64_t timestamp = 0;
+
+    if (!esp_lcd_touch_get_coordinates(tp, x, y, NULL, &point_num, 2)) {
+        point_num = 0;
+    }
+    if (esp_lcd_touch_get_timestamp(tp, &timestamp) != ESP_OK) {
+        timestamp = esp_timer_get_time();
+    }
+
+    return esp_lcd_touch_gesture_process_points(gesture, x, y, point_num, timestamp, events, max_events);
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void gesture_add(esp_lcd_touch_gesture_t *events, uint8_t max_events, uint8_t *cnt, const esp_lcd_touch_gesture_t *event)
+{
+    if (*cnt < max_events) {
+        events[*cnt] = *event;
+        (*cnt)++;
+    } else {
+        ESP_LOGD(TAG, "Gesture %d dropped, events array is full", event->type);
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LCD touch: Gesture recognizer
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_lcd_touch.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Gesture recognizer handle
+ */
+typedef struct esp_lcd_touch_gesture_s *esp_lcd_touch_gesture_handle_t;
+
+/**
+ * @brief Gesture type
+ */
+typedef enum {
+    ESP_LCD_TOUCH_GESTURE_SWIPE_LEFT,   /*!< One finger quickly moved to the left and released */
+    ESP_LCD_TOUCH_GESTURE_SWIPE_RIGHT,  /*!< One finger quickly moved to the right and released */
+    ESP_LCD_TOUCH_GESTURE_SWIPE_UP,     /*!< One finger quickly moved up and released */
+    ESP_LCD_TOUCH_GESTURE_SWIPE_DOWN,   /*!< One finger quickly moved down and released */
+    ESP_LCD_TOUCH_GESTURE_LONG_PRESS,   /*!< One finger held without moving (reported once, still pressed) */
+    ESP_LCD_TOUCH_GESTURE_PINCH,        /*!< Distance of two fingers changed by pinch_step */
+    ESP_LCD_TOUCH_GESTURE_ROTATE,       /*!< Angle of two fingers changed by rotate_step */
+    ESP_LCD_TOUCH_GESTURE_MULTI_END,    /*!< Two finger gesture finished, final scale and angle */
+} esp_lcd_touch_gesture_type_t;
+
+/**
+ * @brief Recognized gesture
+ */
+typedef struct {
+    esp_lcd_touch_gesture_type_t type;  /*!< Gesture type */
+    uint16_t x;             /*!< X of the start point (swipe, long press) or the center of two fingers */
+    uint16_t y;             /*!< Y of the start point (swipe, long press) or the center of two fingers */
+    uint16_t distance;      /*!< Length of swipe [px] */
+    int32_t  scale;         /*!< Distance of two fingers relative to the start of the gesture [1/256] (256: unchanged) */
+    int16_t  angle;         /*!< Rotation of two fingers from the start of the gesture [0.1 deg], clockwise is positive */
+    uint32_t duration_ms;   /*!< Time from the start of the gesture */
+} esp_lcd_touch_gesture_t;
+
+/**
+ * @brief Gesture recognizer configuration
+ */
+typedef struct {
+    uint16_t swipe_min_distance;    /*!< Minimal length of swipe [px] */
+    uint16_t swipe_max_time_ms;     /*!< Maximal duration of swipe */
+    uint16_t long_press_time_ms;    /*!< Duration of long press */
+    uint16_t move_tolerance;        /*!< Maximal movement of long press [px] */
+    uint16_t pinch_step;            /*!< Change of scale reported by next pinch event [1/256] */
+    uint16_t rotate_step;           /*!< Change of angle reported by next rotate event [0.1 deg] */
+} esp_lcd_touch_gesture_config_t;
+
+/**
+ * @brief Default gesture recognizer configuration
+ */
+#define ESP_LCD_TOUCH_GESTURE_DEFAULT_CONFIG()  \
+    {                                           \
+        .swipe_min_distance = 50,               \
+        .swipe_max_time_ms = 500,               \
+        .long_press_time_ms = 600,              \
+        .move_tolerance = 10,                   \
+        .pinch_step = 8,                        \
+        .rotate_step = 50,                      \
+    }
+
+/**
+ * @brief Create gesture recognizer
+ *
+ * @param config: Recognizer configuration
+ * @param ret_gesture: Output recognizer handle
+ *
+ * @return
+ *     - ESP_OK                 on success
+ *     - ESP_ERR_INVALID_ARG    parameter error
+ *     - ESP_ERR_NO_MEM         not enough memory
+ */
+esp_err_t esp_lcd_touch_gesture_new(const esp_lcd_touch_gesture_config_t *config, esp_lcd_touch_gesture_handle_t *ret_gesture);
+
+/**
+ * @brief Delete gesture recognizer
+ *
+ * @param gesture: Recognizer handle
+ *
+ * @return
+ *     - ESP_OK                 on success
+ *     - ESP_ERR_INVALID_ARG    parameter error
+ */
+esp_err_t esp_lcd_touch_gesture_del(esp_lcd_touch_gesture_handle_t gesture);
+
+/**
+ * @brief Forget the pending gesture (e.g. after the screen was changed)
+ *
+ * @param gesture: Recognizer handle
+ */
+void esp_lcd_touch_gesture_reset(esp_lcd_touch_gesture_handle_t gesture);
+
+/**
+ * @brief Process one touch sample
+ *
+ * Call for every sample, also released (point_num is 0). Long press is detected only while new samples come,
+ * so the touch must be polled while pressed.
+ *
+ * @param gesture: Recognizer handle
+ * @param x: X coordinates of points
+ * @param y: Y coordinates of points
+ * @param point_num: Count of points (only the first two are used)
+ * @param timestamp: Time of the sample in microseconds (esp_timer_get_time)
+ * @param events: Output recognized gestures
+ * @param max_events: Size of events array (4 is enough for one sample)
+ *
+ * @return
+ *     - Count of recognized gestures
+ */
+uint8_t esp_lcd_touch_gesture_process_points(esp_lcd_touch_gesture_handle_t gesture, const uint16_t *x, const uint16_t *y, uint8_t point_num,
+        int64_t timestamp, esp_lcd_touch_gesture_t *events, uint8_t max_events);
+
+/**
+ * @brief Process the last sample read from touch controller
+ *
+ * @note Call after esp_lcd_touch_read_data instead of esp_lcd_touch_get_coordinates (the coordinates are read by this function).
+ *
+ * @param gesture: Recognizer handle
+ * @param tp: Touch handler
+ * @param events: Output recognized gestures
+ * @param max_events: Size of events array
+ *
+ * @return
+ *     - Count of recognized gestures
+ */
+uint8_t esp_lcd_touch_gesture_process(esp_lcd_touch_gesture_handle_t gesture, esp_lcd_touch_handle_t tp, esp_lcd_touch_gesture_t *events, uint8_t max_events);
+
+#ifdef __cplusplus
+}
+#endif
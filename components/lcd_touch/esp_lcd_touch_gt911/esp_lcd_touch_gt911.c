@@ -29,6 +29,10 @@ static const char *TAG = "GT911";
 /* GT911 support key num */
 #define ESP_GT911_TOUCH_MAX_BUTTONS         (4)
 
+/* GT911 reports up to 5 points, 8 bytes each */
+#define ESP_GT911_TOUCH_MAX_POINTS          (5)
+#define ESP_GT911_TOUCH_READ_POINTS         ((CONFIG_ESP_LCD_TOUCH_MAX_POINTS < ESP_GT911_TOUCH_MAX_POINTS) ? CONFIG_ESP_LCD_TOUCH_MAX_POINTS : ESP_GT911_TOUCH_MAX_POINTS)
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
@@ -216,8 +220,19 @@ static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
 
     assert(tp != NULL);
 
+#if CONFIG_ESP_LCD_TOUCH_GT911_BURST_READ
+    /* Status and all used points in one transaction */
+    err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, buf, 1 + ESP_GT911_TOUCH_READ_POINTS * 8);
+    ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+
+    /* No new data, there is nothing to clear */
+    if ((buf[0] & 0x80) == 0x00) {
+        return ESP_OK;
+    }
+#else
     err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, buf, 1);
     ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+#endif
 
     /* Any touch data? */
     if ((buf[0] & 0x80) == 0x00) {
@@ -259,9 +274,11 @@ static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
             return ESP_OK;
         }
 
-        /* Read all points */
+#if !CONFIG_ESP_LCD_TOUCH_GT911_BURST_READ
+        /* Read all points (already read with the status in burst mode) */
         err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG + 1, &buf[1], touch_cnt * 8);
         ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+#endif
 
         /* Clear all */
         err = touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2022 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -15,6 +15,7 @@
 #include "driver/gpio.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_touch.h"
+#include "sdkconfig.h"
 
 static const char *TAG = "STMPE610";
 
@@ -48,7 +49,9 @@ static const char *TAG = "STMPE610";
 #define ESP_LCD_TOUCH_STMPE610_REG_ADC_CTRL2_6_5MHZ   (0x02)
 
 #define ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_4SAMPLE    (0x80)
+#define ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_8SAMPLE    (0xC0)
 #define ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_DELAY_1MS  (0x20)
+#define ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_SETTLE_1MS (0x03)
 #define ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_SETTLE_5MS (0x04)
 
 #define ESP_LCD_TOUCH_STMPE610_REG_FIFO_STA_RESET     (0x01)
@@ -60,6 +63,13 @@ static const char *TAG = "STMPE610";
 #define ESP_LCD_TOUCH_STMPE610_REG_INT_CTRL_EDGE      (0x02)
 #define ESP_LCD_TOUCH_STMPE610_REG_INT_CTRL_ENABLE    (0x01)
 
+#define ESP_LCD_TOUCH_STMPE610_REG_INT_EN_TOUCH_DET   (0x01)
+#define ESP_LCD_TOUCH_STMPE610_REG_INT_EN_FIFO_TH     (0x02)
+
+/* Interrupt is raised, when this count of samples is queued (they are read together) */
+#define ESP_LCD_TOUCH_STMPE610_FIFO_TH                (4)
+/* Depth of the FIFO */
+#define ESP_LCD_TOUCH_STMPE610_FIFO_DEPTH             (128)
 
 /*******************************************************************************
 * Function definitions
@@ -158,39 +168,42 @@ err:
 
 static esp_err_t esp_lcd_touch_stmpe610_read_data(esp_lcd_touch_handle_t tp)
 {
-    uint8_t buf[100];
-    uint16_t x = 0;
-    uint16_t y = 0;
-    uint16_t z = 0;
+    uint8_t buf[4];
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t z = 0;
     uint8_t cnt = 0;
-    uint8_t fifo_status = 0;
+    uint8_t valid = 0;
 
     assert(tp != NULL);
 
-    /* Read fifo status */
-    ESP_RETURN_ON_ERROR(touch_stmpe610_read(tp, ESP_LCD_TOUCH_STMPE610_REG_FIFO_STA, (uint8_t *)&fifo_status, 1), TAG, "STMPE610 read error!");
-    if (fifo_status & ESP_LCD_TOUCH_STMPE610_REG_FIFO_STA_EMPTY) {
-        return ESP_OK;
-    }
-
-    /* Read count of samples */
+    /* Read count of samples (zero, when FIFO is empty) */
     ESP_RETURN_ON_ERROR(touch_stmpe610_read(tp, ESP_LCD_TOUCH_STMPE610_REG_FIFO_SIZE, (uint8_t *)&cnt, 1), TAG, "STMPE610 read error!");
     if (cnt == 0) {
         return ESP_OK;
     }
+    if (cnt > ESP_LCD_TOUCH_STMPE610_FIFO_DEPTH) {
+        cnt = ESP_LCD_TOUCH_STMPE610_FIFO_DEPTH;
+    }
 
+    /* Drain all queued samples, every one is already averaged by the controller (TSC_CFG) */
     for (int i = 0; i < cnt; i++) {
         /* Read XYZ data */
         //Note: There is not working read 4 bytes in one read. It reads bad data.
-        ESP_RETURN_ON_ERROR(touch_stmpe610_read(tp, ESP_LCD_TOUCH_STMPE610_REG_TSC_DATA, (uint8_t *)&buf[0], 1), TAG, "STMPE610 read error!");
-        ESP_RETURN_ON_ERROR(touch_stmpe610_read(tp, ESP_LCD_TOUCH_STMPE610_REG_TSC_DATA, (uint8_t *)&buf[1], 1), TAG, "STMPE610 read error!");
-        ESP_RETURN_ON_ERROR(touch_stmpe610_read(tp, ESP_LCD_TOUCH_STMPE610_REG_TSC_DATA, (uint8_t *)&buf[2], 1), TAG, "STMPE610 read error!");
-        ESP_RETURN_ON_ERROR(touch_stmpe610_read(tp, ESP_LCD_TOUCH_STMPE610_REG_TSC_DATA, (uint8_t *)&buf[3], 1), TAG, "STMPE610 read error!");
+        for (int j = 0; j < 4; j++) {
+            ESP_RETURN_ON_ERROR(touch_stmpe610_read(tp, ESP_LCD_TOUCH_STMPE610_REG_TSC_DATA, (uint8_t *)&buf[j], 1), TAG, "STMPE610 read error!");
+        }
+
+        /* Drop light touches, Z decreases with pressure */
+        if (buf[3] == 0 || buf[3] > CONFIG_ESP_LCD_TOUCH_STMPE610_Z_MAX) {
+            continue;
+        }
 
         /* Get XYZ from buffer data */
         x += (uint16_t)(((uint16_t)buf[0] << 4) | ((buf[1] >> 4) & 0x0F));
         y += (uint16_t)(((uint16_t)(buf[1] & 0x0F) << 8) | buf[2]);
         z += buf[3];
+        valid++;
     }
 
     /* Reset FIFO */
@@ -199,10 +212,15 @@ static esp_err_t esp_lcd_touch_stmpe610_read_data(esp_lcd_touch_handle_t tp)
     /* Reset all ints */
     ESP_RETURN_ON_ERROR(touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_INT_STA, 0xFF), TAG, "STMPE610 write error!");
 
+    /* All samples were rejected */
+    if (valid == 0) {
+        return ESP_OK;
+    }
+
     portENTER_CRITICAL(&tp->data.lock);
-    tp->data.coords[0].x = data_convert(x / cnt, 150, 3800, 0, tp->config.x_max);
-    tp->data.coords[0].y = data_convert(y / cnt, 150, 3800, 0, tp->config.y_max);
-    tp->data.coords[0].strength = z / cnt;
+    tp->data.coords[0].x = data_convert(x / valid, 150, 3800, 0, tp->config.x_max);
+    tp->data.coords[0].y = data_convert(y / valid, 150, 3800, 0, tp->config.y_max);
+    tp->data.coords[0].strength = z / valid;
     tp->data.points = 1;
     portEXIT_CRITICAL(&tp->data.lock);
 
@@ -285,15 +303,16 @@ static esp_err_t touch_stmpe610_init(esp_lcd_touch_handle_t tp)
 
     /* XYZ and enable */
     touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_TSC_CTRL, ESP_LCD_TOUCH_STMPE610_REG_TSC_CTRL_XYZ | ESP_LCD_TOUCH_STMPE610_REG_TSC_CTRL_EN);
-    touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_INT_EN, 0x01);
+    touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_INT_EN, ESP_LCD_TOUCH_STMPE610_REG_INT_EN_TOUCH_DET | ESP_LCD_TOUCH_STMPE610_REG_INT_EN_FIFO_TH);
 
     /* 96 clocks per conversion */
     touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_ADC_CTRL1, ESP_LCD_TOUCH_STMPE610_REG_ADC_CTRL1_10BIT | (0x6 << 4));
     touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_ADC_CTRL2, ESP_LCD_TOUCH_STMPE610_REG_ADC_CTRL2_6_5MHZ);
 
-    touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG, ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_4SAMPLE | ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_DELAY_1MS | ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_SETTLE_5MS);
+    /* Average of 8 samples per FIFO entry, shorter settling keeps the sample rate */
+    touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG, ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_8SAMPLE | ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_DELAY_1MS | ESP_LCD_TOUCH_STMPE610_REG_TSC_CFG_SETTLE_1MS);
     touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_TSC_FRACTION_Z, 0x6);
-    touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_FIFO_TH, 1);
+    touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_FIFO_TH, ESP_LCD_TOUCH_STMPE610_FIFO_TH);
 
     /* Reset FIFO */
     touch_stmpe610_write(tp, ESP_LCD_TOUCH_STMPE610_REG_FIFO_STA, ESP_LCD_TOUCH_STMPE610_REG_FIFO_STA_RESET);
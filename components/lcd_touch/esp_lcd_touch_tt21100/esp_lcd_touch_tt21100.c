@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -192,14 +192,28 @@ static esp_err_t esp_lcd_touch_tt21100_read_data(esp_lcd_touch_handle_t tp)
 
     assert(tp != NULL);
 
+#if CONFIG_ESP_LCD_TOUCH_TT21100_BURST_READ
+    /* Interrupt line is held active, while there is an unread report */
+    if (tp->config.int_gpio_num != GPIO_NUM_NC && gpio_get_level(tp->config.int_gpio_num) != tp->config.levels.interrupt) {
+        return ESP_OK;
+    }
+
+    /* Report of maximal length in one transaction, it starts by its length */
+    err = touch_tt21100_i2c_read(tp, data, sizeof(data));
+    ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+    data_len = (uint16_t)data[0] | ((uint16_t)data[1] << 8);
+#else
     /* Get report data length */
     err = touch_tt21100_i2c_read(tp, (uint8_t *)&data_len, sizeof(data_len));
     ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+#endif
 
     /* Read report data if length */
     if (data_len > 0 && data_len < sizeof(data)) {
-        touch_tt21100_i2c_read(tp, data, data_len);
+#if !CONFIG_ESP_LCD_TOUCH_TT21100_BURST_READ
+        err = touch_tt21100_i2c_read(tp, data, data_len);
         ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+#endif
 
         portENTER_CRITICAL(&tp->data.lock);
 
@@ -15,7 +15,10 @@
 extern "C" {
 #endif
 
-#include "driver/i2c.h"
+#include <stdbool.h>
+#include "driver/i2c_master.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
 
 /**
 * @brief Device Identification value
@@ -27,6 +30,42 @@ typedef struct {
     int16_t x, y, z;
 } mag3110_result_t;
 
+/**
+ * @brief Fraction bits of soft-iron scale
+ */
+#define MAG3110_CAL_SCALE_SHIFT 12
+
+/**
+ * @brief Hard-iron and soft-iron correction of raw data
+ *
+ * corrected = (raw - offset) * scale / 2^MAG3110_CAL_SCALE_SHIFT
+ */
+typedef struct {
+    mag3110_result_t offset;    /*!< Hard-iron offset in [0.1uT] */
+    uint16_t scale[3];          /*!< Soft-iron scale of x, y, z axis (1 << MAG3110_CAL_SCALE_SHIFT: no scaling) */
+} mag3110_calibration_t;
+
+/**
+ * @brief Callback function type for DRDY mode (called from the DRDY task)
+ *
+ * @param sensor object handle of mag3110
+ * @param[in] mag_induction New sample in units of 0.1uT
+ * @param[in] user_ctx User context of the DRDY configuration
+ */
+typedef void (*mag3110_drdy_callback_t)(mag3110_handle_t sensor, const mag3110_result_t *mag_induction, void *user_ctx);
+
+/**
+ * @brief Configuration structure for DRDY mode
+ */
+typedef struct {
+    gpio_num_t              drdy_pin;           /*!< GPIO connected to INT1 pin of MAG3110 */
+    mag3110_drdy_callback_t drdy_callback;      /*!< Callback of new sample */
+    void                    *user_ctx;          /*!< User context passed to the callback */
+    bool                    online_calibration; /*!< Update the calibration by every sample, see mag3110_calibration_update() */
+    bool                    apply_calibration;  /*!< Pass corrected samples to the callback, see mag3110_apply_calibration() */
+    UBaseType_t             drdy_task_priority; /*!< Priority of the DRDY task */
+} mag3110_drdy_config_t;
+
 /**
  * @brief Data rate and oversampling settings
  *
@@ -72,15 +111,18 @@ typedef enum {
 } mag3110_data_rate_t;
 
 /**
- * @brief Create and init sensor object and return a sensor handle
+ * @brief Create and init sensor object
  *
- * @param[in] port I2C number
+ * @param[in]  i2c_bus    I2C bus handle. Obtained from i2c_new_master_bus()
+ * @param[out] handle_ret Handle to created MAG3110 driver object
  *
  * @return
- *     - NULL Fail
- *     - Others Success
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ *     - ESP_ERR_NO_MEM Not enough memory for the driver
+ *     - Others Error from underlying I2C driver
  */
-mag3110_handle_t mag3110_create(const i2c_port_t port);
+esp_err_t mag3110_create(i2c_master_bus_handle_t i2c_bus, mag3110_handle_t *handle_ret);
 
 /**
  * @brief Delete and release a sensor object
@@ -165,6 +207,99 @@ esp_err_t mag3110_get_magnetic_induction(mag3110_handle_t sensor, mag3110_result
  */
 esp_err_t mag3110_calibrate(mag3110_handle_t sensor, const uint32_t cal_duration_ms);
 
+/**
+ * @brief Reset the online calibration
+ *
+ * The online calibration estimates hard-iron offset and soft-iron scale in software, sample by sample,
+ * from minimum and maximum of each axis. The soft-iron correction is aligned with the axes of the sensor.
+ * Use it with raw data (mag3110_start_raw()), the offset registers of MAG3110 are not changed.
+ *
+ * @param sensor MAG3110 handle
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ */
+esp_err_t mag3110_calibration_reset(mag3110_handle_t sensor);
+
+/**
+ * @brief Update the online calibration by a new raw sample
+ *
+ * The calibration becomes valid when the sensor was rotated enough to see a range of at least 30uT on every axis.
+ * Can be called from any task.
+ *
+ * @param sensor MAG3110 handle
+ * @param[in] sample Raw sample in units of 0.1uT
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ */
+esp_err_t mag3110_calibration_update(mag3110_handle_t sensor, const mag3110_result_t *const sample);
+
+/**
+ * @brief Get the current calibration (e.g. to store it in NVS)
+ *
+ * @param sensor MAG3110 handle
+ * @param[out] cal Calibration
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ *     - ESP_ERR_NOT_FINISHED Calibration is not valid yet, keep rotating the sensor
+ */
+esp_err_t mag3110_get_calibration(mag3110_handle_t sensor, mag3110_calibration_t *const cal);
+
+/**
+ * @brief Set a stored calibration
+ *
+ * Use the calibration from the last run immediately after boot, the online calibration continues from it.
+ *
+ * @param sensor MAG3110 handle
+ * @param[in] cal Calibration
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ */
+esp_err_t mag3110_set_calibration(mag3110_handle_t sensor, const mag3110_calibration_t *const cal);
+
+/**
+ * @brief Correct a raw sample by the current calibration
+ *
+ * @param sensor MAG3110 handle
+ * @param[in] raw Raw sample in units of 0.1uT
+ * @param[out] corrected Corrected sample in units of 0.1uT, can be the same as raw
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ */
+esp_err_t mag3110_apply_calibration(mag3110_handle_t sensor, const mag3110_result_t *const raw, mag3110_result_t *const corrected);
+
+/**
+ * @brief Enable DRDY mode
+ *
+ * A task reads status and output registers in one burst on every rising edge of INT1 pin and passes the sample
+ * to the callback. The measurement must be started by mag3110_start() or mag3110_start_raw().
+ *
+ * @note GPIO ISR service must be installed by gpio_install_isr_service() before.
+ *
+ * @param sensor MAG3110 handle
+ * @param[in] config DRDY mode configuration structure
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG Invalid argument
+ *     - ESP_ERR_INVALID_STATE DRDY mode is already enabled
+ *     - ESP_ERR_NO_MEM Not enough memory for the task
+ */
+esp_err_t mag3110_drdy_enable(mag3110_handle_t sensor, const mag3110_drdy_config_t *const config);
+
+/**
+ * @brief Disable DRDY mode
+ *
+ * @param sensor MAG3110 handle
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_STATE DRDY mode was not enabled
+ */
+esp_err_t mag3110_drdy_disable(mag3110_handle_t sensor);
+
 #ifdef __cplusplus
 }
 #endif
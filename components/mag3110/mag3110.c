@@ -4,17 +4,23 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "mag3110.h"
-#include "esp_log.h"
+#include "esp_check.h"
 #include "esp_timer.h" // for calibration function
-#include "esp_idf_version.h" // for backward compatibility of esp-timer
 
 #define MAG3110_I2C_ADDRESS 0x0Eu // MAG3110 constant address
+#define MAG3110_DR_STATUS   0x00u
 #define MAG3110_OUT_X_MSB   0x01u
 #define MAG3110_WHO_AM_I    0x07u
 #define MAG3110_OFF_X_MSB   0x09u
 #define MAG3110_CTRL_REG1   0x10u
 
+#define I2C_CLK_SPEED  400000
+#define I2C_TIMEOUT_MS 1000
+
 // ctrl reg1
 #define MAG3110_ACTIVE_MODE  0x01u
 #define MAG3110_STANDBY_MODE 0x00u
@@ -23,72 +29,83 @@
 #define MAG3110_AUTO_MRST_EN 0x80u
 #define MAG3110_RAW_DATA     0x20u
 
+// dr status
+#define MAG3110_ZYXDR        0x08u
+
+#define MAG3110_CAL_MIN_RADIUS 150  // minimal half-range of every axis in [0.1uT] for valid calibration
+#define MAG3110_CAL_SCALE_ONE  (1 << MAG3110_CAL_SCALE_SHIFT)
+
+static const char *TAG = "MAG3110";
+
 typedef struct {
-    i2c_port_t bus;
-    uint16_t dev_addr;
+    i2c_master_dev_handle_t i2c_handle;
 
     // calibration data
     int16_t max[3];
     int16_t min[3];
+    portMUX_TYPE cal_lock;
+    bool cal_valid;
+    mag3110_calibration_t cal;
+
+    // Data-ready (DRDY) related variables
+    TaskHandle_t drdy_task_handle;
+    mag3110_drdy_config_t drdy_config;
 } mag3110_dev_t;
 
 static esp_err_t mag3110_write(mag3110_handle_t sensor, const uint8_t reg_start_addr, const uint8_t *const data_buf, const uint8_t data_len)
 {
     mag3110_dev_t *sens = (mag3110_dev_t *) sensor;
-    esp_err_t  ret;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_WRITE, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, reg_start_addr, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write(cmd, data_buf, data_len, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_stop(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_cmd_begin(sens->bus, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
 
-    return ret;
+    assert(data_len < 8);
+    uint8_t write_buff[8] = {reg_start_addr};
+    memcpy(&write_buff[1], data_buf, data_len);
+    return i2c_master_transmit(sens->i2c_handle, write_buff, data_len + 1, I2C_TIMEOUT_MS);
 }
 
 static esp_err_t mag3110_read(mag3110_handle_t sensor, const uint8_t reg_start_addr, uint8_t *const data_buf, const uint8_t data_len)
 {
     mag3110_dev_t *sens = (mag3110_dev_t *) sensor;
-    esp_err_t ret;
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_WRITE, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, reg_start_addr, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_start(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_write_byte(cmd, sens->dev_addr | I2C_MASTER_READ, true);
-    assert(ESP_OK == ret);
-    ret = i2c_master_read(cmd, data_buf, data_len, I2C_MASTER_LAST_NACK);
-    assert(ESP_OK == ret);
-    ret = i2c_master_stop(cmd);
-    assert(ESP_OK == ret);
-    ret = i2c_master_cmd_begin(sens->bus, cmd, 1000 / portTICK_PERIOD_MS);
-    i2c_cmd_link_delete(cmd);
+    const uint8_t reg_buff[] = {reg_start_addr};
 
-    return ret;
+    return i2c_master_transmit_receive(sens->i2c_handle, reg_buff, sizeof(reg_buff), data_buf, data_len, I2C_TIMEOUT_MS);
 }
 
-mag3110_handle_t mag3110_create(const i2c_port_t port)
+esp_err_t mag3110_create(i2c_master_bus_handle_t i2c_bus, mag3110_handle_t *handle_ret)
 {
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(i2c_bus && handle_ret, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
     mag3110_dev_t *sensor = (mag3110_dev_t *) calloc(1, sizeof(mag3110_dev_t));
-    sensor->bus = port;
-    sensor->dev_addr = MAG3110_I2C_ADDRESS << 1;
-    return (mag3110_handle_t) sensor;
+    ESP_RETURN_ON_FALSE(sensor, ESP_ERR_NO_MEM, TAG, "Not enough memory");
+    portMUX_INITIALIZE(&sensor->cal_lock);
+    mag3110_calibration_reset(sensor);
+
+    // Add new I2C device
+    const i2c_device_config_t i2c_dev_cfg = {
+        .device_address = MAG3110_I2C_ADDRESS,
+        .scl_speed_hz = I2C_CLK_SPEED,
+    };
+    ESP_GOTO_ON_ERROR(i2c_master_bus_add_device(i2c_bus, &i2c_dev_cfg, &sensor->i2c_handle), err, TAG, "Failed to add new I2C device");
+
+    *handle_ret = sensor;
+    return ESP_OK;
+
+err:
+    mag3110_delete(sensor);
+    return ret;
 }
 
 void mag3110_delete(mag3110_handle_t sensor)
 {
     mag3110_dev_t *sens = (mag3110_dev_t *) sensor;
+
+    if (sens->drdy_task_handle) {
+        mag3110_drdy_disable(sensor);
+    }
+
+    if (sens->i2c_handle) {
+        i2c_master_bus_rm_device(sens->i2c_handle);
+    }
     free(sens);
 }
 
@@ -139,23 +156,145 @@ esp_err_t mag3110_get_magnetic_induction(mag3110_handle_t sensor, mag3110_result
     return ret;
 }
 
-static void mag3110_timer_callback(void *arg)
+// Burst read of status and output registers, the data are valid only if ready is set
+static esp_err_t mag3110_read_sample(mag3110_handle_t sensor, mag3110_result_t *const mag_induction, bool *const ready)
 {
-    mag3110_dev_t *sens = (mag3110_dev_t *) arg;
-    mag3110_result_t mag_data; // raw data from the magnetometer
-    int16_t *axis_data = &mag_data.x; // we will iterate through struct members, so pointer to it is useful
+    uint8_t result_buffer[7];
+    esp_err_t ret = mag3110_read(sensor, MAG3110_DR_STATUS, result_buffer, sizeof(result_buffer));
+    if (ESP_OK != ret) {
+        return ret;
+    }
 
-    mag3110_get_magnetic_induction((mag3110_handle_t)arg, &mag_data);
+    *ready = result_buffer[0] & MAG3110_ZYXDR;
+    mag_induction->x = ((uint16_t)result_buffer[1] << 8) | (uint16_t)result_buffer[2];
+    mag_induction->y = ((uint16_t)result_buffer[3] << 8) | (uint16_t)result_buffer[4];
+    mag_induction->z = ((uint16_t)result_buffer[5] << 8) | (uint16_t)result_buffer[6];
+    return ESP_OK;
+}
+
+esp_err_t mag3110_calibration_reset(mag3110_handle_t sensor)
+{
+    mag3110_dev_t *sens = (mag3110_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
 
+    portENTER_CRITICAL(&sens->cal_lock);
+    for (int i = 0; i < 3; i++) {
+        sens->max[i] = INT16_MIN;
+        sens->min[i] = INT16_MAX;
+        sens->cal.scale[i] = MAG3110_CAL_SCALE_ONE;
+    }
+    sens->cal.offset = (mag3110_result_t) {
+        0
+    };
+    sens->cal_valid = false;
+    portEXIT_CRITICAL(&sens->cal_lock);
+    return ESP_OK;
+}
+
+esp_err_t mag3110_calibration_update(mag3110_handle_t sensor, const mag3110_result_t *const sample)
+{
+    mag3110_dev_t *sens = (mag3110_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens && sample, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    const int16_t *axis_data = &sample->x; // we will iterate through struct members, so pointer to it is useful
+    bool changed = false;
+
+    portENTER_CRITICAL(&sens->cal_lock);
     // compare the new data to stored min/max values
-    for (int i = 0; i < 3; i++, axis_data++) {
-        if (*axis_data > sens->max[i]) {
-            sens->max[i] = *axis_data;
+    for (int i = 0; i < 3; i++) {
+        if (axis_data[i] > sens->max[i]) {
+            sens->max[i] = axis_data[i];
+            changed = true;
+        }
+        if (axis_data[i] < sens->min[i]) {
+            sens->min[i] = axis_data[i];
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        // hard-iron offset is the center, soft-iron scale equalizes the half-ranges of the axes
+        int32_t radius[3];
+        int32_t radius_sum = 0;
+        bool valid = true;
+        for (int i = 0; i < 3; i++) {
+            radius[i] = ((int32_t)sens->max[i] - sens->min[i]) / 2;
+            radius_sum += radius[i];
+            valid = valid && (radius[i] >= MAG3110_CAL_MIN_RADIUS);
         }
-        if (*axis_data < sens->min[i]) {
-            sens->min[i] = *axis_data;
+        if (valid) {
+            int16_t *offset = &sens->cal.offset.x;
+            for (int i = 0; i < 3; i++) {
+                offset[i] = ((int32_t)sens->max[i] + sens->min[i]) / 2;
+                const int32_t scale = (radius_sum * MAG3110_CAL_SCALE_ONE) / (3 * radius[i]);
+                sens->cal.scale[i] = (scale > UINT16_MAX) ? UINT16_MAX : scale;
+            }
+            sens->cal_valid = true;
         }
     }
+    portEXIT_CRITICAL(&sens->cal_lock);
+    return ESP_OK;
+}
+
+esp_err_t mag3110_get_calibration(mag3110_handle_t sensor, mag3110_calibration_t *const cal)
+{
+    mag3110_dev_t *sens = (mag3110_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens && cal, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    portENTER_CRITICAL(&sens->cal_lock);
+    const bool valid = sens->cal_valid;
+    *cal = sens->cal;
+    portEXIT_CRITICAL(&sens->cal_lock);
+    return valid ? ESP_OK : ESP_ERR_NOT_FINISHED;
+}
+
+esp_err_t mag3110_set_calibration(mag3110_handle_t sensor, const mag3110_calibration_t *const cal)
+{
+    mag3110_dev_t *sens = (mag3110_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens && cal, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(cal->scale[0] && cal->scale[1] && cal->scale[2], ESP_ERR_INVALID_ARG, TAG, "invalid scale");
+
+    portENTER_CRITICAL(&sens->cal_lock);
+    sens->cal = *cal;
+    sens->cal_valid = true;
+    // continue the online calibration from the restored one
+    const int16_t *offset = &cal->offset.x;
+    for (int i = 0; i < 3; i++) {
+        sens->max[i] = offset[i];
+        sens->min[i] = offset[i];
+    }
+    portEXIT_CRITICAL(&sens->cal_lock);
+    return ESP_OK;
+}
+
+esp_err_t mag3110_apply_calibration(mag3110_handle_t sensor, const mag3110_result_t *const raw, mag3110_result_t *const corrected)
+{
+    mag3110_dev_t *sens = (mag3110_dev_t *) sensor;
+    ESP_RETURN_ON_FALSE(sens && raw && corrected, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    const int16_t *raw_data = &raw->x;
+    int16_t *corrected_data = &corrected->x;
+    mag3110_calibration_t cal;
+
+    portENTER_CRITICAL(&sens->cal_lock);
+    cal = sens->cal;
+    portEXIT_CRITICAL(&sens->cal_lock);
+
+    const int16_t *offset = &cal.offset.x;
+    for (int i = 0; i < 3; i++) {
+        int32_t value = (((int32_t)raw_data[i] - offset[i]) * cal.scale[i]) >> MAG3110_CAL_SCALE_SHIFT;
+        corrected_data[i] = (value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value;
+    }
+    return ESP_OK;
+}
+
+static void mag3110_timer_callback(void *arg)
+{
+    mag3110_result_t mag_data; // raw data from the magnetometer
+    bool ready;
+
+    // only new samples, the first one is ready after start-up
+    if (ESP_OK == mag3110_read_sample((mag3110_handle_t)arg, &mag_data, &ready) && ready) {
+        mag3110_calibration_update((mag3110_handle_t)arg, &mag_data);
+    }
 }
 
 esp_err_t mag3110_calibrate(mag3110_handle_t sensor, const uint32_t cal_duration_ms)
@@ -169,10 +308,7 @@ esp_err_t mag3110_calibrate(mag3110_handle_t sensor, const uint32_t cal_duration
     }
 
     // initialize calibration values to their starting point
-    for (int i = 0; i < 3; i++) {
-        sens->max[i] = INT16_MIN;
-        sens->min[i] = INT16_MAX;
-    }
+    mag3110_calibration_reset(sensor);
 
     // reset MAG3110 to factory default
     ctrl_reg[0] = MAG3110_STANDBY_MODE;
@@ -186,15 +322,11 @@ esp_err_t mag3110_calibrate(mag3110_handle_t sensor, const uint32_t cal_duration
     ret = mag3110_write(sensor, MAG3110_CTRL_REG1, ctrl_reg, sizeof(ctrl_reg));
     assert(ESP_OK == ret);
 
-    vTaskDelay(100 / portTICK_PERIOD_MS); // Wait for start-up
-
     const esp_timer_create_args_t cal_timer_config = {
         .callback = mag3110_timer_callback,
         .arg = sensor,
         .name = "MAG3110 calibration timer",
-#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 3, 0)
         .skip_unhandled_events = true,
-#endif
         .dispatch_method = ESP_TIMER_TASK
     };
     esp_timer_handle_t cal_timer = NULL;
@@ -236,7 +368,86 @@ esp_err_t mag3110_calibrate(mag3110_handle_t sensor, const uint32_t cal_duration
 
     ESP_LOGD("MAG3110", "offset data %i %i %i", offset[0], offset[1], offset[2]);
 
-    vTaskDelay(100 / portTICK_PERIOD_MS); // Wait for shutdown
-
     return ret;
 }
+
+static void IRAM_ATTR drdy_isr(void *args)
+{
+    mag3110_dev_t *sens = (mag3110_dev_t *)args;
+    BaseType_t xYieldRequired;
+
+    vTaskNotifyGiveFromISR(sens->drdy_task_handle, &xYieldRequired);
+    if (xYieldRequired) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void drdy_task(void *args)
+{
+    mag3110_dev_t *sens = (mag3110_dev_t *)args;
+    const mag3110_drdy_config_t *config = &sens->drdy_config;
+    mag3110_result_t mag_data;
+    bool ready;
+
+    const gpio_config_t drdy_pin_config = {
+        .intr_type = GPIO_INTR_POSEDGE,
+        .mode = GPIO_MODE_INPUT,
+        .pin_bit_mask = BIT64(config->drdy_pin),
+        .pull_down_en = false,
+        .pull_up_en = false
+    };
+
+    ESP_ERROR_CHECK(gpio_isr_handler_add(config->drdy_pin, drdy_isr, args));
+    ESP_ERROR_CHECK(gpio_config(&drdy_pin_config));
+
+    // perform dummy read to reset INT1 pin, new rising edge comes with the next sample
+    mag3110_read_sample(args, &mag_data, &ready);
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // Wait for new data from ISR
+        if (mag3110_read_sample(args, &mag_data, &ready) != ESP_OK || !ready) {
+            continue;
+        }
+        if (config->online_calibration) {
+            mag3110_calibration_update(args, &mag_data);
+        }
+        if (config->apply_calibration) {
+            mag3110_apply_calibration(args, &mag_data, &mag_data);
+        }
+        config->drdy_callback(args, &mag_data, config->user_ctx);
+    }
+    vTaskDelete(NULL);
+}
+
+esp_err_t mag3110_drdy_enable(mag3110_handle_t sensor, const mag3110_drdy_config_t *const config)
+{
+    mag3110_dev_t *sens = (mag3110_dev_t *)sensor;
+    ESP_RETURN_ON_FALSE(sens && config && config->drdy_callback, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(!sens->drdy_task_handle, ESP_ERR_INVALID_STATE, TAG, "DRDY mode already enabled");
+
+    // store parameters that are needed in a new FreeRTOS task
+    sens->drdy_config = *config;
+
+    // Create FreeRTOS task - interrupt allocation should be done in pinned to core task
+    BaseType_t freertos_ret = xTaskCreatePinnedToCore(
+                                  drdy_task, "MAG3110 DRDY", 2048, sensor, config->drdy_task_priority, &sens->drdy_task_handle, 0
+                              );
+    if (pdPASS != freertos_ret) {
+        sens->drdy_task_handle = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t mag3110_drdy_disable(mag3110_handle_t sensor)
+{
+    mag3110_dev_t *sens = (mag3110_dev_t *)sensor;
+    ESP_RETURN_ON_FALSE(sens, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(sens->drdy_task_handle, ESP_ERR_INVALID_STATE, TAG, "DRDY mode not enabled");
+
+    // Delete FreeRTOS task and disable GPIO interrupt
+    gpio_isr_handler_remove(sens->drdy_config.drdy_pin);
+    vTaskDelete(sens->drdy_task_handle);
+    sens->drdy_task_handle = NULL;
+    return ESP_OK;
+}
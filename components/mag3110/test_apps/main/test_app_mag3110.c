@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "driver/i2c_master.h"
+#include "mag3110.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "unity_test_runner.h"
+#include "unity_test_utils_memory.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define I2C_MASTER_SCL_IO 26      /*!< gpio number for I2C master clock */
+#define I2C_MASTER_SDA_IO 25      /*!< gpio number for I2C master data  */
+#define I2C_MASTER_NUM I2C_NUM_0  /*!< I2C port number for master dev */
+
+static const char *TAG = "mag3110 test";
+static mag3110_handle_t mag3110 = NULL;
+static i2c_master_bus_handle_t i2c_handle = NULL;
+
+/**
+ * @brief i2c master initialization
+ */
+static void i2c_bus_init(void)
+{
+    const i2c_master_bus_config_t bus_config = {
+        .i2c_port = I2C_MASTER_NUM,
+        .sda_io_num = I2C_MASTER_SDA_IO,
+        .scl_io_num = I2C_MASTER_SCL_IO,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .flags.enable_internal_pullup = true,
+    };
+
+    esp_err_t ret = i2c_new_master_bus(&bus_config, &i2c_handle);
+    TEST_ASSERT_EQUAL_MESSAGE(ESP_OK, ret, "I2C install returned error");
+}
+
+/**
+ * @brief i2c master initialization
+ */
+static void i2c_sensor_mag3110_init(void)
+{
+    i2c_bus_init();
+    esp_err_t ret = mag3110_create(i2c_handle, &mag3110);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_NOT_NULL_MESSAGE(mag3110, "mag3110 create returned NULL");
+}
+
+TEST_CASE("Sensor mag3110 test", "[mag3110][iot][sensor]")
+{
+    esp_err_t ret;
+    uint8_t mag3110_deviceid;
+    mag3110_result_t mag_induction;
+
+    i2c_sensor_mag3110_init();
+
+    ret = mag3110_get_deviceid(mag3110, &mag3110_deviceid);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(MAG3110_WHO_AM_I_VAL, mag3110_deviceid, "Who Am I register does not contain expected data");
+
+    ret = mag3110_start(mag3110, MAG3110_DR_OS_10_128);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    ret = mag3110_get_magnetic_induction(mag3110, &mag_induction);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ESP_LOGI(TAG, "mag_x:%i, mag_y:%i, mag_z:%i", mag_induction.x, mag_induction.y, mag_induction.z);
+
+    mag3110_delete(mag3110);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(10); // Give FreeRTOS some time to free its resources
+}
+
+TEST_CASE("Sensor mag3110 online calibration test", "[mag3110][iot][sensor]")
+{
+    esp_err_t ret;
+    mag3110_calibration_t cal;
+    mag3110_result_t corrected;
+
+    i2c_sensor_mag3110_init();
+
+    ret = mag3110_get_calibration(mag3110, &cal);
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FINISHED, ret);
+
+    // samples on axis extremes of an ellipsoid with center (100, -200, 50) and half-ranges (400, 300, 500)
+    const mag3110_result_t samples[] = {
+        {500, -200, 50}, {-300, -200, 50},
+        {100, 100, 50}, {100, -500, 50},
+        {100, -200, 550}, {100, -200, -450},
+    };
+    for (int i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        ret = mag3110_calibration_update(mag3110, &samples[i]);
+        TEST_ASSERT_EQUAL(ESP_OK, ret);
+    }
+
+    ret = mag3110_get_calibration(mag3110, &cal);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_EQUAL_INT16(100, cal.offset.x);
+    TEST_ASSERT_EQUAL_INT16(-200, cal.offset.y);
+    TEST_ASSERT_EQUAL_INT16(50, cal.offset.z);
+
+    // all extremes are corrected to the mean half-range
+    for (int i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        ret = mag3110_apply_calibration(mag3110, &samples[i], &corrected);
+        TEST_ASSERT_EQUAL(ESP_OK, ret);
+        TEST_ASSERT_INT_WITHIN(2, 400, abs(corrected.x) + abs(corrected.y) + abs(corrected.z));
+    }
+
+    // restored calibration is valid immediately
+    ret = mag3110_calibration_reset(mag3110);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = mag3110_set_calibration(mag3110, &cal);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = mag3110_get_calibration(mag3110, &cal);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+
+    mag3110_delete(mag3110);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(10); // Give FreeRTOS some time to free its resources
+}
+
+#define TEST_MEMORY_LEAK_THRESHOLD  (500)
+
+void setUp(void)
+{
+    unity_utils_set_leak_level(TEST_MEMORY_LEAK_THRESHOLD);
+    unity_utils_record_free_mem();
+}
+
+void tearDown(void)
+{
+    unity_utils_evaluate_leaks();
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
@@ -82,6 +82,25 @@ typedef struct {
     int16_t raw_gyro_z;
 } mpu6050_raw_gyro_value_t;
 
+/**
+ * @brief Raw accelerometer, temperature and gyroscope measurements of one sample
+ */
+typedef struct {
+    mpu6050_raw_acce_value_t acce;  /*!< Raw accelerometer measurements */
+    int16_t raw_temp;               /*!< Raw temperature (temp = raw_temp / 340 + 36.53) */
+    mpu6050_raw_gyro_value_t gyro;  /*!< Raw gyroscope measurements */
+} mpu6050_raw_sample_t;
+
+/**
+ * @brief FIFO configuration
+ */
+typedef struct {
+    bool acce;                  /*!< Store accelerometer measurements */
+    bool temp;                  /*!< Store temperature */
+    bool gyro;                  /*!< Store gyroscope measurements */
+    uint8_t sample_rate_div;    /*!< SMPLRT_DIV, sample rate is 8 kHz (DLPF disabled) or 1 kHz (DLPF enabled) / (1 + sample_rate_div) */
+} mpu6050_fifo_config_t;
+
 typedef struct {
     float acce_x;
     float acce_y;
@@ -177,6 +196,8 @@ esp_err_t mpu6050_config(mpu6050_handle_t sensor, const mpu6050_acce_fs_t acce_f
 /**
  * @brief Get accelerometer sensitivity
  *
+ * @note Full scale ranges are read from the sensor once and then cached in the handle, mpu6050_config() updates them.
+ *
  * @param sensor object handle of mpu6050
  * @param acce_sensitivity accelerometer sensitivity
  *
@@ -343,6 +364,85 @@ esp_err_t mpu6050_get_raw_acce(mpu6050_handle_t sensor, mpu6050_raw_acce_value_t
  */
 esp_err_t mpu6050_get_raw_gyro(mpu6050_handle_t sensor, mpu6050_raw_gyro_value_t *const raw_gyro_value);
 
+/**
+ * @brief Read raw accelerometer, temperature and gyroscope measurements in one transaction
+ *
+ * All values come from the same sample, with one I2C read instead of three (mpu6050_get_raw_acce, mpu6050_get_temp, mpu6050_get_raw_gyro).
+ *
+ * @param sensor object handle of mpu6050
+ * @param raw_sample raw measurements
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG raw_sample is NULL
+ *     - ESP_FAIL Fail
+ */
+esp_err_t mpu6050_get_raw_sample(mpu6050_handle_t sensor, mpu6050_raw_sample_t *const raw_sample);
+
+/**
+ * @brief Configure sample rate and content of FIFO
+ *
+ * FIFO is emptied and started. When no measurement is selected, FIFO is stopped.
+ *
+ * MPU6050 has no FIFO watermark interrupt. Drain the FIFO periodically (1024 bytes hold 73 samples of accelerometer,
+ * temperature and gyroscope) or after every N-th DATA READY interrupt.
+ *
+ * @param sensor object handle of mpu6050
+ * @param fifo_config FIFO configuration
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG A parameter is NULL
+ *     - ESP_FAIL Fail
+ */
+esp_err_t mpu6050_fifo_config(mpu6050_handle_t sensor, const mpu6050_fifo_config_t *const fifo_config);
+
+/**
+ * @brief Empty FIFO
+ *
+ * @param sensor object handle of mpu6050
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_FAIL Fail
+ */
+esp_err_t mpu6050_fifo_reset(mpu6050_handle_t sensor);
+
+/**
+ * @brief Get count of samples waiting in FIFO
+ *
+ * @param sensor object handle of mpu6050
+ * @param count count of complete samples
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG A parameter is NULL
+ *     - ESP_ERR_INVALID_STATE FIFO is not configured
+ *     - ESP_FAIL Fail
+ */
+esp_err_t mpu6050_fifo_get_count(mpu6050_handle_t sensor, uint16_t *const count);
+
+/**
+ * @brief Read samples waiting in FIFO
+ *
+ * Samples are read in bursts of 16. Values not stored in FIFO (see mpu6050_fifo_config) are zero.
+ *
+ * @note INT_STATUS register is read to detect FIFO overflow, it clears the interrupt status.
+ *
+ * @param sensor object handle of mpu6050
+ * @param samples output samples (the oldest first)
+ * @param max_samples size of samples array
+ * @param read_samples count of read samples
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG A parameter is NULL
+ *     - ESP_ERR_INVALID_STATE FIFO is not configured
+ *     - ESP_ERR_INVALID_SIZE FIFO overflowed, it was emptied and nothing was read
+ *     - ESP_FAIL Fail
+ */
+esp_err_t mpu6050_fifo_read(mpu6050_handle_t sensor, mpu6050_raw_sample_t *const samples, size_t max_samples, size_t *const read_samples);
+
 /**
  * @brief Read accelerometer measurements
  *
@@ -367,6 +467,22 @@ esp_err_t mpu6050_get_acce(mpu6050_handle_t sensor, mpu6050_acce_value_t *const
  */
 esp_err_t mpu6050_get_gyro(mpu6050_handle_t sensor, mpu6050_gyro_value_t *const gyro_value);
 
+/**
+ * @brief Read accelerometer and gyroscope values in one transaction
+ *
+ * The values come from the same sample (mpu6050_get_raw_sample) and they are scaled by the cached full scale ranges.
+ *
+ * @param sensor object handle of mpu6050
+ * @param acce_value accelerometer measurements [g]
+ * @param gyro_value gyroscope measurements [dps]
+ *
+ * @return
+ *     - ESP_OK Success
+ *     - ESP_ERR_INVALID_ARG A parameter is NULL
+ *     - ESP_FAIL Fail
+ */
+esp_err_t mpu6050_get_acce_gyro(mpu6050_handle_t sensor, mpu6050_acce_value_t *const acce_value, mpu6050_gyro_value_t *const gyro_value);
+
 /**
  * @brief Read temperature values
  *
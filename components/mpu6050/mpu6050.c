@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 #include <sys/time.h>
@@ -16,17 +17,32 @@
 #define RAD_TO_DEG                  57.27272727f /*!< Radians to degrees */
 
 /* MPU6050 register */
+#define MPU6050_SMPLRT_DIV          0x19u
 #define MPU6050_GYRO_CONFIG         0x1Bu
 #define MPU6050_ACCEL_CONFIG        0x1Cu
+#define MPU6050_FIFO_EN             0x23u
 #define MPU6050_INTR_PIN_CFG         0x37u
 #define MPU6050_INTR_ENABLE          0x38u
 #define MPU6050_INTR_STATUS          0x3Au
 #define MPU6050_ACCEL_XOUT_H        0x3Bu
 #define MPU6050_GYRO_XOUT_H         0x43u
 #define MPU6050_TEMP_XOUT_H         0x41u
+#define MPU6050_USER_CTRL           0x6Au
 #define MPU6050_PWR_MGMT_1          0x6Bu
+#define MPU6050_FIFO_COUNT_H        0x72u
+#define MPU6050_FIFO_R_W            0x74u
 #define MPU6050_WHO_AM_I            0x75u
 
+/* FIFO_EN and USER_CTRL bits */
+#define MPU6050_FIFO_EN_TEMP        BIT7
+#define MPU6050_FIFO_EN_GYRO        (BIT6 | BIT5 | BIT4)
+#define MPU6050_FIFO_EN_ACCEL       BIT3
+#define MPU6050_USER_CTRL_FIFO_EN   BIT6
+#define MPU6050_USER_CTRL_FIFO_RST  BIT2
+
+#define MPU6050_SAMPLE_SIZE         14u     /*!< ACCEL_XOUT_H .. GYRO_ZOUT_L */
+#define MPU6050_FIFO_READ_SAMPLES   16u     /*!< Samples read from FIFO in one transaction */
+
 const uint8_t MPU6050_DATA_RDY_INT_BIT =      (uint8_t) BIT0;
 const uint8_t MPU6050_I2C_MASTER_INT_BIT =    (uint8_t) BIT3;
 const uint8_t MPU6050_FIFO_OVERFLOW_INT_BIT = (uint8_t) BIT4;
@@ -40,6 +56,13 @@ typedef struct {
     uint32_t counter;
     float dt;  /*!< delay time between two measurements, dt should be small (ms level) */
     struct timeval *timer;
+    mpu6050_fifo_config_t fifo;     /*!< Content of FIFO packets */
+    uint8_t fifo_packet_size;       /*!< 0: FIFO disabled */
+    bool scale_valid;               /*!< Sensitivities below match the full scale ranges of the sensor */
+    float acce_sensitivity;         /*!< Accelerometer sensitivity [LSB/g] */
+    float gyro_sensitivity;         /*!< Gyroscope sensitivity [LSB/dps] */
+    float acce_scale;               /*!< Reciprocal of accelerometer sensitivity */
+    float gyro_scale;               /*!< Reciprocal of gyroscope sensitivity */
 } mpu6050_dev_t;
 
 static esp_err_t mpu6050_write(mpu6050_handle_t sensor, const uint8_t reg_start_addr, const uint8_t *const data_buf, const uint8_t data_len)
@@ -90,6 +113,89 @@ static esp_err_t mpu6050_read(mpu6050_handle_t sensor, const uint8_t reg_start_a
     return ret;
 }
 
+/* FIFO_RST works only while FIFO is disabled */
+static esp_err_t mpu6050_fifo_restart(mpu6050_handle_t sensor, uint8_t user_ctrl)
+{
+    esp_err_t ret;
+
+    user_ctrl &= ~MPU6050_USER_CTRL_FIFO_EN;
+    ret = mpu6050_write(sensor, MPU6050_USER_CTRL, &user_ctrl, 1);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    user_ctrl |= MPU6050_USER_CTRL_FIFO_RST;
+    ret = mpu6050_write(sensor, MPU6050_USER_CTRL, &user_ctrl, 1);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    user_ctrl &= ~MPU6050_USER_CTRL_FIFO_RST;
+    user_ctrl |= MPU6050_USER_CTRL_FIFO_EN;
+    return mpu6050_write(sensor, MPU6050_USER_CTRL, &user_ctrl, 1);
+}
+
+static void mpu6050_set_scale(mpu6050_handle_t sensor, uint8_t gyro_config, uint8_t accel_config)
+{
+    mpu6050_dev_t *sens = (mpu6050_dev_t *) sensor;
+
+    switch ((accel_config >> 3) & 0x03) {
+    case ACCE_FS_2G:
+        sens->acce_sensitivity = 16384;
+        break;
+
+    case ACCE_FS_4G:
+        sens->acce_sensitivity = 8192;
+        break;
+
+    case ACCE_FS_8G:
+        sens->acce_sensitivity = 4096;
+        break;
+
+    default:
+        sens->acce_sensitivity = 2048;
+        break;
+    }
+
+    switch ((gyro_config >> 3) & 0x03) {
+    case GYRO_FS_250DPS:
+        sens->gyro_sensitivity = 131;
+        break;
+
+    case GYRO_FS_500DPS:
+        sens->gyro_sensitivity = 65.5;
+        break;
+
+    case GYRO_FS_1000DPS:
+        sens->gyro_sensitivity = 32.8;
+        break;
+
+    default:
+        sens->gyro_sensitivity = 16.4;
+        break;
+    }
+
+    /* Samples are scaled by multiplication, no float division per sample */
+    sens->acce_scale = 1.0f / sens->acce_sensitivity;
+    sens->gyro_scale = 1.0f / sens->gyro_sensitivity;
+    sens->scale_valid = true;
+}
+
+/* Full scale ranges are read once, then they follow mpu6050_config() */
+static esp_err_t mpu6050_load_scale(mpu6050_handle_t sensor)
+{
+    mpu6050_dev_t *sens = (mpu6050_dev_t *) sensor;
+    uint8_t config_regs[2];
+
+    if (sens->scale_valid) {
+        return ESP_OK;
+    }
+    esp_err_t ret = mpu6050_read(sensor, MPU6050_GYRO_CONFIG, config_regs, sizeof(config_regs));
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    mpu6050_set_scale(sensor, config_regs[0], config_regs[1]);
+    return ESP_OK;
+}
+
 mpu6050_handle_t mpu6050_create(i2c_port_t port, const uint16_t dev_addr)
 {
     mpu6050_dev_t *sensor = (mpu6050_dev_t *) calloc(1, sizeof(mpu6050_dev_t));
@@ -141,63 +247,29 @@ esp_err_t mpu6050_sleep(mpu6050_handle_t sensor)
 esp_err_t mpu6050_config(mpu6050_handle_t sensor, const mpu6050_acce_fs_t acce_fs, const mpu6050_gyro_fs_t gyro_fs)
 {
     uint8_t config_regs[2] = {gyro_fs << 3,  acce_fs << 3};
-    return mpu6050_write(sensor, MPU6050_GYRO_CONFIG, config_regs, sizeof(config_regs));
+    esp_err_t ret = mpu6050_write(sensor, MPU6050_GYRO_CONFIG, config_regs, sizeof(config_regs));
+    if (ESP_OK == ret) {
+        mpu6050_set_scale(sensor, config_regs[0], config_regs[1]);
+    } else {
+        ((mpu6050_dev_t *) sensor)->scale_valid = false;
+    }
+    return ret;
 }
 
 esp_err_t mpu6050_get_acce_sensitivity(mpu6050_handle_t sensor, float *const acce_sensitivity)
 {
-    esp_err_t ret;
-    uint8_t acce_fs;
-    ret = mpu6050_read(sensor, MPU6050_ACCEL_CONFIG, &acce_fs, 1);
-    acce_fs = (acce_fs >> 3) & 0x03;
-    switch (acce_fs) {
-    case ACCE_FS_2G:
-        *acce_sensitivity = 16384;
-        break;
-
-    case ACCE_FS_4G:
-        *acce_sensitivity = 8192;
-        break;
-
-    case ACCE_FS_8G:
-        *acce_sensitivity = 4096;
-        break;
-
-    case ACCE_FS_16G:
-        *acce_sensitivity = 2048;
-        break;
-
-    default:
-        break;
+    esp_err_t ret = mpu6050_load_scale(sensor);
+    if (ESP_OK == ret) {
+        *acce_sensitivity = ((mpu6050_dev_t *) sensor)->acce_sensitivity;
     }
     return ret;
 }
 
 esp_err_t mpu6050_get_gyro_sensitivity(mpu6050_handle_t sensor, float *const gyro_sensitivity)
 {
-    esp_err_t ret;
-    uint8_t gyro_fs;
-    ret = mpu6050_read(sensor, MPU6050_GYRO_CONFIG, &gyro_fs, 1);
-    gyro_fs = (gyro_fs >> 3) & 0x03;
-    switch (gyro_fs) {
-    case GYRO_FS_250DPS:
-        *gyro_sensitivity = 131;
-        break;
-
-    case GYRO_FS_500DPS:
-        *gyro_sensitivity = 65.5;
-        break;
-
-    case GYRO_FS_1000DPS:
-        *gyro_sensitivity = 32.8;
-        break;
-
-    case GYRO_FS_2000DPS:
-        *gyro_sensitivity = 16.4;
-        break;
-
-    default:
-        break;
+    esp_err_t ret = mpu6050_load_scale(sensor);
+    if (ESP_OK == ret) {
+        *gyro_sensitivity = ((mpu6050_dev_t *) sensor)->gyro_sensitivity;
     }
     return ret;
 }
@@ -387,13 +459,191 @@ esp_err_t mpu6050_get_raw_gyro(mpu6050_handle_t sensor, mpu6050_raw_gyro_value_t
     return ret;
 }
 
+esp_err_t mpu6050_get_raw_sample(mpu6050_handle_t sensor, mpu6050_raw_sample_t *const raw_sample)
+{
+    uint8_t data_rd[MPU6050_SAMPLE_SIZE];
+
+    if (NULL == raw_sample) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Accelerometer, temperature and gyroscope registers follow each other, one read gives a consistent sample */
+    esp_err_t ret = mpu6050_read(sensor, MPU6050_ACCEL_XOUT_H, data_rd, sizeof(data_rd));
+    if (ESP_OK != ret) {
+        return ret;
+    }
+
+    raw_sample->acce.raw_acce_x = (int16_t)((data_rd[0] << 8) + (data_rd[1]));
+    raw_sample->acce.raw_acce_y = (int16_t)((data_rd[2] << 8) + (data_rd[3]));
+    raw_sample->acce.raw_acce_z = (int16_t)((data_rd[4] << 8) + (data_rd[5]));
+    raw_sample->raw_temp = (int16_t)((data_rd[6] << 8) + (data_rd[7]));
+    raw_sample->gyro.raw_gyro_x = (int16_t)((data_rd[8] << 8) + (data_rd[9]));
+    raw_sample->gyro.raw_gyro_y = (int16_t)((data_rd[10] << 8) + (data_rd[11]));
+    raw_sample->gyro.raw_gyro_z = (int16_t)((data_rd[12] << 8) + (data_rd[13]));
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_fifo_config(mpu6050_handle_t sensor, const mpu6050_fifo_config_t *const fifo_config)
+{
+    esp_err_t ret;
+    mpu6050_dev_t *sens = (mpu6050_dev_t *) sensor;
+    uint8_t fifo_en = 0x00;
+    uint8_t user_ctrl;
+
+    if (NULL == sens || NULL == fifo_config) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (fifo_config->acce) {
+        fifo_en |= MPU6050_FIFO_EN_ACCEL;
+    }
+    if (fifo_config->temp) {
+        fifo_en |= MPU6050_FIFO_EN_TEMP;
+    }
+    if (fifo_config->gyro) {
+        fifo_en |= MPU6050_FIFO_EN_GYRO;
+    }
+
+    ret = mpu6050_write(sensor, MPU6050_SMPLRT_DIV, &fifo_config->sample_rate_div, 1);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+
+    /* Stop FIFO before changing its content */
+    ret = mpu6050_read(sensor, MPU6050_USER_CTRL, &user_ctrl, 1);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    user_ctrl &= ~MPU6050_USER_CTRL_FIFO_EN;
+    ret = mpu6050_write(sensor, MPU6050_USER_CTRL, &user_ctrl, 1);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    sens->fifo_packet_size = 0;
+    ret = mpu6050_write(sensor, MPU6050_FIFO_EN, &fifo_en, 1);
+    if (ESP_OK != ret || 0 == fifo_en) {
+        return ret;
+    }
+
+    /* Empty FIFO starts with an aligned packet */
+    ret = mpu6050_fifo_restart(sensor, user_ctrl);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+
+    sens->fifo = *fifo_config;
+    sens->fifo_packet_size = (fifo_config->acce ? 6 : 0) + (fifo_config->temp ? 2 : 0) + (fifo_config->gyro ? 6 : 0);
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_fifo_reset(mpu6050_handle_t sensor)
+{
+    esp_err_t ret;
+    uint8_t user_ctrl;
+
+    ret = mpu6050_read(sensor, MPU6050_USER_CTRL, &user_ctrl, 1);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    return mpu6050_fifo_restart(sensor, user_ctrl);
+}
+
+esp_err_t mpu6050_fifo_get_count(mpu6050_handle_t sensor, uint16_t *const count)
+{
+    esp_err_t ret;
+    mpu6050_dev_t *sens = (mpu6050_dev_t *) sensor;
+    uint8_t data_rd[2];
+
+    if (NULL == sens || NULL == count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *count = 0;
+    if (0 == sens->fifo_packet_size) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ret = mpu6050_read(sensor, MPU6050_FIFO_COUNT_H, data_rd, sizeof(data_rd));
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    *count = ((data_rd[0] << 8) | data_rd[1]) / sens->fifo_packet_size;
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_fifo_read(mpu6050_handle_t sensor, mpu6050_raw_sample_t *const samples, size_t max_samples, size_t *const read_samples)
+{
+    esp_err_t ret;
+    mpu6050_dev_t *sens = (mpu6050_dev_t *) sensor;
+    uint8_t data_rd[MPU6050_FIFO_READ_SAMPLES * MPU6050_SAMPLE_SIZE];
+    uint8_t intr_status;
+    uint16_t count;
+
+    if (NULL == sens || (NULL == samples && max_samples > 0) || NULL == read_samples) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *read_samples = 0;
+
+    /* Overflowed FIFO drops the oldest bytes, the packets are not aligned anymore */
+    ret = mpu6050_read(sensor, MPU6050_INTR_STATUS, &intr_status, 1);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    if (mpu6050_is_fifo_overflow_interrupt(intr_status)) {
+        mpu6050_fifo_reset(sensor);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    ret = mpu6050_fifo_get_count(sensor, &count);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    if (count > max_samples) {
+        count = max_samples;
+    }
+
+    while (count > 0) {
+        const size_t chunk = (count < MPU6050_FIFO_READ_SAMPLES) ? count : MPU6050_FIFO_READ_SAMPLES;
+        ret = mpu6050_read(sensor, MPU6050_FIFO_R_W, data_rd, chunk * sens->fifo_packet_size);
+        if (ESP_OK != ret) {
+            return ret;
+        }
+
+        /* Packet has the enabled registers in order of their addresses (accelerometer, temperature, gyroscope) */
+        const uint8_t *p = data_rd;
+        for (size_t i = 0; i < chunk; i++) {
+            mpu6050_raw_sample_t *sample = &samples[*read_samples + i];
+            memset(sample, 0, sizeof(mpu6050_raw_sample_t));
+            if (sens->fifo.acce) {
+                sample->acce.raw_acce_x = (int16_t)((p[0] << 8) + (p[1]));
+                sample->acce.raw_acce_y = (int16_t)((p[2] << 8) + (p[3]));
+                sample->acce.raw_acce_z = (int16_t)((p[4] << 8) + (p[5]));
+                p += 6;
+            }
+            if (sens->fifo.temp) {
+                sample->raw_temp = (int16_t)((p[0] << 8) + (p[1]));
+                p += 2;
+            }
+            if (sens->fifo.gyro) {
+                sample->gyro.raw_gyro_x = (int16_t)((p[0] << 8) + (p[1]));
+                sample->gyro.raw_gyro_y = (int16_t)((p[2] << 8) + (p[3]));
+                sample->gyro.raw_gyro_z = (int16_t)((p[4] << 8) + (p[5]));
+                p += 6;
+            }
+        }
+        *read_samples += chunk;
+        count -= chunk;
+    }
+
+    return ESP_OK;
+}
+
 esp_err_t mpu6050_get_acce(mpu6050_handle_t sensor, mpu6050_acce_value_t *const acce_value)
 {
     esp_err_t ret;
-    float acce_sensitivity;
+    mpu6050_dev_t *sens = (mpu6050_dev_t *) sensor;
     mpu6050_raw_acce_value_t raw_acce;
 
-    ret = mpu6050_get_acce_sensitivity(sensor, &acce_sensitivity);
+    ret = mpu6050_load_scale(sensor);
     if (ret != ESP_OK) {
         return ret;
     }
@@ -402,19 +652,19 @@ esp_err_t mpu6050_get_acce(mpu6050_handle_t sensor, mpu6050_acce_value_t *const
         return ret;
     }
 
-    acce_value->acce_x = raw_acce.raw_acce_x / acce_sensitivity;
-    acce_value->acce_y = raw_acce.raw_acce_y / acce_sensitivity;
-    acce_value->acce_z = raw_acce.raw_acce_z / acce_sensitivity;
+    acce_value->acce_x = raw_acce.raw_acce_x * sens->acce_scale;
+    acce_value->acce_y = raw_acce.raw_acce_y * sens->acce_scale;
+    acce_value->acce_z = raw_acce.raw_acce_z * sens->acce_scale;
     return ESP_OK;
 }
 
 esp_err_t mpu6050_get_gyro(mpu6050_handle_t sensor, mpu6050_gyro_value_t *const gyro_value)
 {
     esp_err_t ret;
-    float gyro_sensitivity;
+    mpu6050_dev_t *sens = (mpu6050_dev_t *) sensor;
     mpu6050_raw_gyro_value_t raw_gyro;
 
-    ret = mpu6050_get_gyro_sensitivity(sensor, &gyro_sensitivity);
+    ret = mpu6050_load_scale(sensor);
     if (ret != ESP_OK) {
         return ret;
     }
@@ -423,9 +673,37 @@ esp_err_t mpu6050_get_gyro(mpu6050_handle_t sensor, mpu6050_gyro_value_t *const
         return ret;
     }
 
-    gyro_value->gyro_x = raw_gyro.raw_gyro_x / gyro_sensitivity;
-    gyro_value->gyro_y = raw_gyro.raw_gyro_y / gyro_sensitivity;
-    gyro_value->gyro_z = raw_gyro.raw_gyro_z / gyro_sensitivity;
+    gyro_value->gyro_x = raw_gyro.raw_gyro_x * sens->gyro_scale;
+    gyro_value->gyro_y = raw_gyro.raw_gyro_y * sens->gyro_scale;
+    gyro_value->gyro_z = raw_gyro.raw_gyro_z * sens->gyro_scale;
+    return ESP_OK;
+}
+
+esp_err_t mpu6050_get_acce_gyro(mpu6050_handle_t sensor, mpu6050_acce_value_t *const acce_value, mpu6050_gyro_value_t *const gyro_value)
+{
+    esp_err_t ret;
+    mpu6050_dev_t *sens = (mpu6050_dev_t *) sensor;
+    mpu6050_raw_sample_t raw_sample;
+
+    if (NULL == acce_value || NULL == gyro_value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ret = mpu6050_load_scale(sensor);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = mpu6050_get_raw_sample(sensor, &raw_sample);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    acce_value->acce_x = raw_sample.acce.raw_acce_x * sens->acce_scale;
+    acce_value->acce_y = raw_sample.acce.raw_acce_y * sens->acce_scale;
+    acce_value->acce_z = raw_sample.acce.raw_acce_z * sens->acce_scale;
+    gyro_value->gyro_x = raw_sample.gyro.raw_gyro_x * sens->gyro_scale;
+    gyro_value->gyro_y = raw_sample.gyro.raw_gyro_y * sens->gyro_scale;
+    gyro_value->gyro_z = raw_sample.gyro.raw_gyro_z * sens->gyro_scale;
     return ESP_OK;
 }
 
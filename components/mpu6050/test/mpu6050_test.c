@@ -10,6 +10,8 @@
 #include "mpu6050.h"
 #include "esp_system.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 #define I2C_MASTER_SCL_IO 26      /*!< gpio number for I2C master clock */
 #define I2C_MASTER_SDA_IO 25      /*!< gpio number for I2C master data  */
@@ -80,6 +82,15 @@ TEST_CASE("Sensor mpu6050 test", "[mpu6050][iot][sensor]")
     TEST_ASSERT_EQUAL(ESP_OK, ret);
     ESP_LOGI(TAG, "gyro_x:%.2f, gyro_y:%.2f, gyro_z:%.2f\n", gyro.gyro_x, gyro.gyro_y, gyro.gyro_z);
 
+    /* Sensitivity is cached from mpu6050_config() */
+    float sensitivity;
+    ret = mpu6050_get_acce_sensitivity(mpu6050, &sensitivity);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_EQUAL_FLOAT(8192, sensitivity);
+    ret = mpu6050_get_acce_gyro(mpu6050, &acce, &gyro);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ESP_LOGI(TAG, "acce_z:%.2f, gyro_z:%.2f (one transaction)", acce.acce_z, gyro.gyro_z);
+
     ret = mpu6050_get_temp(mpu6050, &temp);
     TEST_ASSERT_EQUAL(ESP_OK, ret);
     ESP_LOGI(TAG, "t:%.2f \n", temp.temp);
@@ -88,3 +99,36 @@ TEST_CASE("Sensor mpu6050 test", "[mpu6050][iot][sensor]")
     ret = i2c_driver_delete(I2C_MASTER_NUM);
     TEST_ASSERT_EQUAL(ESP_OK, ret);
 }
+
+TEST_CASE("Sensor mpu6050 burst and FIFO test", "[mpu6050][iot][sensor]")
+{
+    esp_err_t ret;
+    mpu6050_raw_sample_t sample;
+    mpu6050_raw_sample_t samples[32];
+    size_t read = 0;
+    const mpu6050_fifo_config_t fifo_cfg = {
+        .acce = true,
+        .gyro = true,
+        .sample_rate_div = 7,   /* 1 kHz without DLPF */
+    };
+
+    i2c_sensor_mpu6050_init();
+
+    ret = mpu6050_get_raw_sample(mpu6050, &sample);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ESP_LOGI(TAG, "raw acce_x:%d, acce_y:%d, acce_z:%d, gyro_x:%d, gyro_y:%d, gyro_z:%d, temp:%d", sample.acce.raw_acce_x, sample.acce.raw_acce_y,
+             sample.acce.raw_acce_z, sample.gyro.raw_gyro_x, sample.gyro.raw_gyro_y, sample.gyro.raw_gyro_z, sample.raw_temp);
+
+    ret = mpu6050_fifo_config(mpu6050, &fifo_cfg);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(pdMS_TO_TICKS(20));
+
+    ret = mpu6050_fifo_read(mpu6050, samples, 32, &read);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_GREATER_THAN(0, read);
+    ESP_LOGI(TAG, "FIFO read %u samples, first acce_z:%d", (unsigned)read, samples[0].acce.raw_acce_z);
+
+    mpu6050_delete(mpu6050);
+    ret = i2c_driver_delete(I2C_MASTER_NUM);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+}
@@ -15,6 +15,7 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include "driver/i2c_master.h"
 #include "driver/gpio.h"
 
@@ -63,11 +64,48 @@ typedef struct {
 } qma6100p_int_config_t;
 
 typedef enum {
-    FIFO_BYPASS_MODE = 0,
-    FIFO_FIFO_MODE   = 1,
-    FIFO_STREAM_MODE = 2
+    FIFO_BYPASS_MODE = 0,                   /*!< FIFO disabled */
+    FIFO_FIFO_MODE   = 1,                   /*!< FIFO stops storing when it is full */
+    FIFO_STREAM_MODE = 2                    /*!< Full FIFO drops the oldest frames */
 } qma6100p_fifo_mode_t;
 
+typedef struct {
+    qma6100p_fifo_mode_t mode;              /*!< FIFO mode                                    */
+    uint8_t watermark;                      /*!< FIFO Watermark interrupt level [frames] (0-63) */
+} qma6100p_fifo_config_t;
+
+typedef enum {
+    QMA6100P_ODR_100HZ  = 0,                /*!< Output data rate 100 Hz  */
+    QMA6100P_ODR_200HZ  = 1,                /*!< Output data rate 200 Hz  */
+    QMA6100P_ODR_400HZ  = 2,                /*!< Output data rate 400 Hz  */
+    QMA6100P_ODR_800HZ  = 3,                /*!< Output data rate 800 Hz  */
+    QMA6100P_ODR_1600HZ = 4,                /*!< Output data rate 1600 Hz */
+    QMA6100P_ODR_50HZ   = 5,                /*!< Output data rate 50 Hz   */
+    QMA6100P_ODR_25HZ   = 6,                /*!< Output data rate 25 Hz   */
+    QMA6100P_ODR_12_5HZ = 7,                /*!< Output data rate 12.5 Hz */
+} qma6100p_odr_t;
+
+typedef enum {
+    QMA6100P_INT_MAP_NONE = -1,             /*!< Event is not routed to INT pin */
+    QMA6100P_INT_MAP_INT1 = 0,              /*!< Event is routed to INT1 pin    */
+    QMA6100P_INT_MAP_INT2 = 1,              /*!< Event is routed to INT2 pin    */
+} qma6100p_int_map_t;
+
+typedef struct {
+    bool enable;                            /*!< Enable step counting */
+    qma6100p_int_map_t int_map;             /*!< INT pin of the step interrupt */
+} qma6100p_step_config_t;
+
+typedef struct {
+    bool enable;                            /*!< Enable any-motion detection on X, Y and Z */
+    uint16_t threshold_mg;                  /*!< Slope threshold [mg], resolution depends on full scale range */
+    uint8_t duration;                       /*!< Consecutive samples over threshold (1-4) */
+    qma6100p_int_map_t int_map;             /*!< INT pin of the any-motion interrupt */
+} qma6100p_any_motion_config_t;
+
+#define QMA6100P_EVENT_ANY_MOTION   (1 << 0)    /*!< Any-motion detected */
+#define QMA6100P_EVENT_STEP         (1 << 1)    /*!< Step detected */
+
 extern const uint8_t QMA6100P_DATA_RDY_INT_BIT;      /*!< DATA READY interrupt bit               */
 extern const uint8_t QMA6100P_FIFO_FULL_INT_BIT;     /*!< FIFO Full interrupt bit                */
 extern const uint8_t QMA6100P_FIFO_WM_INT_BIT;       /*!< FIFO Watermark interrupt bit           */
@@ -288,6 +326,17 @@ extern uint8_t qma6100p_is_fifo_overflow_interrupt(uint8_t interrupt_status);
  */
 extern uint8_t qma6100p_is_fifo_full_interrupt(uint8_t interrupt_status);
 
+/**
+ * @brief Determine if the last qma6100p interrupt was triggered by fifo watermark.
+ *
+ * @param interrupt_status qma6100p interrupt status, obtained by invoking qma6100p_get_interrupt_status()
+ *
+ * @return
+ *      - 0: The interrupt is not a fifo watermark interrupt
+ *      - Any other positive integer: Interrupt was triggered by fifo watermark
+ */
+extern uint8_t qma6100p_is_fifo_watermark_interrupt(uint8_t interrupt_status);
+
 /**
  * @brief Read raw accelerometer measurements
  *
@@ -336,6 +385,129 @@ esp_err_t qma6100p_get_fifo_frame_counter(qma6100p_handle_t sensor, uint8_t *cou
  */
 esp_err_t qma6100p_get_fifo_data(qma6100p_handle_t sensor, uint8_t *data);
 
+/**
+ * @brief Configure FIFO mode and watermark
+ *
+ * FIFO stores X, Y and Z frames (up to 64) at the output data rate and it is emptied by this call.
+ * For batch acquisition, pass QMA6100P_FIFO_WM_INT_BIT in interrupt_sources of qma6100p_config_interrupt
+ * and read the FIFO by qma6100p_fifo_read from a task notified by the ISR.
+ *
+ * @param sensor object handle of qma6100p
+ * @param fifo_config FIFO configuration
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG A parameter is NULL or not valid
+ *      - ESP_FAIL Fail
+ */
+esp_err_t qma6100p_fifo_config(qma6100p_handle_t sensor, const qma6100p_fifo_config_t *const fifo_config);
+
+/**
+ * @brief Read frames waiting in FIFO
+ *
+ * Frames are read in bursts of 16 frames. In FIFO mode, FIFO is restarted when all frames were read.
+ *
+ * @param sensor object handle of qma6100p
+ * @param samples output raw accelerometer measurements (the oldest first)
+ * @param max_samples size of samples array
+ * @param read_samples count of read samples
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG A parameter is NULL
+ *      - ESP_ERR_INVALID_STATE FIFO is not configured
+ *      - ESP_FAIL Fail
+ */
+esp_err_t qma6100p_fifo_read(qma6100p_handle_t sensor, qma6100p_raw_acce_value_t *const samples, size_t max_samples, size_t *const read_samples);
+
+/**
+ * @brief Set output data rate
+ *
+ * A low output data rate together with any-motion interrupt keeps the sensor in the low-power
+ * measurement and wakes up the host only on movement.
+ *
+ * @param sensor object handle of qma6100p
+ * @param odr output data rate
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG A parameter is not valid
+ *      - ESP_FAIL Fail
+ */
+esp_err_t qma6100p_set_odr(qma6100p_handle_t sensor, const qma6100p_odr_t odr);
+
+/**
+ * @brief Configure the on-chip step counter
+ *
+ * When int_map is not QMA6100P_INT_MAP_NONE, the INT pin must be configured by qma6100p_config_interrupt.
+ *
+ * @warning Not tested, implemented according to datasheet.
+ *
+ * @param sensor object handle of qma6100p
+ * @param step_config step counter configuration
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG A parameter is NULL or not valid
+ *      - ESP_FAIL Fail
+ */
+esp_err_t qma6100p_step_counter_config(qma6100p_handle_t sensor, const qma6100p_step_config_t *const step_config);
+
+/**
+ * @brief Read the on-chip step counter
+ *
+ * @param sensor object handle of qma6100p
+ * @param steps steps counted since the last reset (24 bits)
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG A parameter is NULL
+ *      - ESP_FAIL Fail
+ */
+esp_err_t qma6100p_step_counter_read(qma6100p_handle_t sensor, uint32_t *const steps);
+
+/**
+ * @brief Reset the on-chip step counter to zero
+ *
+ * @param sensor object handle of qma6100p
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_FAIL Fail
+ */
+esp_err_t qma6100p_step_counter_reset(qma6100p_handle_t sensor);
+
+/**
+ * @brief Configure any-motion (slope) detection
+ *
+ * When int_map is not QMA6100P_INT_MAP_NONE, the INT pin must be configured by qma6100p_config_interrupt.
+ * Threshold is converted with the current full scale range, so call qma6100p_config first.
+ *
+ * @warning Not tested, implemented according to datasheet.
+ *
+ * @param sensor object handle of qma6100p
+ * @param motion_config any-motion configuration
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG A parameter is NULL or not valid
+ *      - ESP_FAIL Fail
+ */
+esp_err_t qma6100p_any_motion_config(qma6100p_handle_t sensor, const qma6100p_any_motion_config_t *const motion_config);
+
+/**
+ * @brief Get step and any-motion events
+ *
+ * @param sensor object handle of qma6100p
+ * @param events bit mask of QMA6100P_EVENT_* events
+ *
+ * @return
+ *      - ESP_OK Success
+ *      - ESP_ERR_INVALID_ARG A parameter is NULL
+ *      - ESP_FAIL Fail
+ */
+esp_err_t qma6100p_get_motion_events(qma6100p_handle_t sensor, uint8_t *const events);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,7 @@
 #define QMA6100P_WHO_AM_I             0x00u
 #define QMA6100P_ACCEL_CONFIG         0x0Fu
 #define QMA6100P_ACCEL_XOUT_H         0x01u
+#define QMA6100P_ODR_BW               0x10u
 #define QMA6100P_PWR_MGMT_1           0x11u
 #define QMA6100P_NVM_LOAD             0x33u
 
@@ -38,10 +39,32 @@
 #define QMA6100P_INT2_MAP_TAP         0x1Bu
 #define QMA6100P_INT2_MAP_FIFO        0x1Cu
 
+#define QMA6100P_STEP_CNT_L           0x07u
+#define QMA6100P_STEP_CNT_M           0x08u
+#define QMA6100P_STEP_CNT_H           0x0Du
+#define QMA6100P_STEP_CONF0           0x12u
+#define QMA6100P_STEP_CONF1           0x13u
+#define QMA6100P_MOT_CONF0            0x2Cu
+#define QMA6100P_ANY_MOT_TH           0x2Eu
+
+#define QMA6100P_STEP_EN              BIT7    /*!< STEP_CONF0: step counter enable */
+#define QMA6100P_STEP_CLR             BIT7    /*!< STEP_CONF1: clear step counter */
+#define QMA6100P_STEP_INT_EN          BIT3    /*!< INT_EN0 and INT_MAP0: step interrupt */
+#define QMA6100P_ANY_MOT_EN_XYZ       0x07u   /*!< INT_EN2: any-motion on X, Y and Z */
+#define QMA6100P_ANY_MOT_INT_MAP      BIT0    /*!< INT_MAP1: any-motion interrupt */
+#define QMA6100P_ANY_MOT_ST           0x07u   /*!< INT_ST0: any-motion first X, Y or Z */
+#define QMA6100P_STEP_ST              BIT3    /*!< INT_ST1: step detected */
+
 #define QMA6100P_FIFO_FRAME_CTR       0x0Eu
+#define QMA6100P_FIFO_WM              0x31u
 #define QMA6100P_FIFO_DATA            0x3Fu
 #define QMA6100P_FIFO_MODE            0x3Eu
 
+#define QMA6100P_FIFO_SIZE            64u     /*!< Frames of X, Y and Z */
+#define QMA6100P_FIFO_FRAME_SIZE      6u
+#define QMA6100P_FIFO_READ_FRAMES     16u     /*!< Frames read from FIFO in one transaction */
+#define QMA6100P_FIFO_CH_XYZ          0x07u   /*!< FIFO_MODE register: store all three axes */
+
 const uint8_t QMA6100P_DATA_RDY_INT_BIT =      (uint8_t) BIT4;
 // FIFO full interrupt
 const uint8_t QMA6100P_FIFO_FULL_INT_BIT =     (uint8_t) BIT5;
@@ -58,6 +81,7 @@ typedef struct {
     uint32_t counter;
     float dt;  /*!< delay time between two measurements, dt should be small (ms level) */
     struct timeval *timer;
+    qma6100p_fifo_mode_t fifo_mode;
 } qma6100p_dev_t;
 
 static esp_err_t qma6100p_write(qma6100p_handle_t sensor, const uint8_t reg_start_addr, const uint8_t data_buf)
@@ -148,6 +172,18 @@ esp_err_t qma6100p_wake_up(qma6100p_handle_t sensor)
     return ret;
 }
 
+esp_err_t qma6100p_sleep(qma6100p_handle_t sensor)
+{
+    esp_err_t ret;
+    uint8_t tmp;
+    ret = qma6100p_read(sensor, QMA6100P_PWR_MGMT_1, &tmp, 1);
+    if (ESP_OK != ret) {
+        return ret;
+    }
+    tmp &= (~BIT7);
+    return qma6100p_write(sensor, QMA6100P_PWR_MGMT_1, tmp);
+}
+
 esp_err_t qma6100p_config(qma6100p_handle_t sensor, const qma6100p_acce_fs_t acce_fs)
 {
     uint8_t config_reg;
@@ -377,7 +413,8 @@ esp_err_t qma6100p_disable_interrupts(qma6100p_handle_t sensor, uint8_t interrup
     esp_err_t ret;
     uint8_t enabled_interrupts = 0x00;
 
-    ret = qma6100p_read(sensor, QMA6100P_INTR_ENABLE, &enabled_interrupts, 1);
+    /* Data ready and FIFO interrupts are in the same register as in qma6100p_enable_interrupts */
+    ret = qma6100p_read(sensor, QMA6100P_INTR_FIFO_EN, &enabled_interrupts, 1);
 
     if (ESP_OK != ret) {
         return ret;
@@ -386,7 +423,7 @@ esp_err_t qma6100p_disable_interrupts(qma6100p_handle_t sensor, uint8_t interrup
     if (0 != (enabled_interrupts & interrupt_sources)) {
         enabled_interrupts &= (~interrupt_sources);
 
-        ret = qma6100p_write(sensor, QMA6100P_INTR_ENABLE, enabled_interrupts);
+        ret = qma6100p_write(sensor, QMA6100P_INTR_FIFO_EN, enabled_interrupts);
     }
 
     return ret;
@@ -421,6 +458,11 @@ inline uint8_t qma6100p_is_fifo_full_interrupt(uint8_t interrupt_status)
     return (QMA6100P_FIFO_FULL_INT_BIT == (QMA6100P_FIFO_FULL_INT_BIT & interrupt_status));
 }
 
+inline uint8_t qma6100p_is_fifo_watermark_interrupt(uint8_t interrupt_status)
+{
+    return (QMA6100P_FIFO_WM_INT_BIT == (QMA6100P_FIFO_WM_INT_BIT & interrupt_status));
+}
+
 esp_err_t qma6100p_get_raw_acce(qma6100p_handle_t sensor, qma6100p_raw_acce_value_t *const raw_acce_value)
 {
     uint8_t data_rd[6];
@@ -462,3 +504,164 @@ esp_err_t qma6100p_get_fifo_data(qma6100p_handle_t sensor, uint8_t *data)
 {
     return qma6100p_read(sensor, QMA6100P_FIFO_DATA, data, 1);
 }
+
+esp_err_t qma6100p_fifo_config(qma6100p_handle_t sensor, const qma6100p_fifo_config_t *const fifo_config)
+{
+    qma6100p_dev_t *sens = (qma6100p_dev_t *) sensor;
+
+    ESP_RETURN_ON_FALSE(sens && fifo_config, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(fifo_config->mode <= FIFO_STREAM_MODE, ESP_ERR_INVALID_ARG, TAG, "Invalid FIFO mode");
+    ESP_RETURN_ON_FALSE(fifo_config->watermark < QMA6100P_FIFO_SIZE, ESP_ERR_INVALID_ARG, TAG, "Watermark must be lower than 64");
+
+    ESP_RETURN_ON_ERROR(qma6100p_write(sensor, QMA6100P_FIFO_WM, fifo_config->watermark), TAG, "Write FIFO watermark error");
+    /* Writing FIFO_MODE register also empties FIFO */
+    const uint8_t fifo_mode = (fifo_config->mode << 6) | (fifo_config->mode == FIFO_BYPASS_MODE ? 0 : QMA6100P_FIFO_CH_XYZ);
+    ESP_RETURN_ON_ERROR(qma6100p_write(sensor, QMA6100P_FIFO_MODE, fifo_mode), TAG, "Write FIFO mode error");
+    sens->fifo_mode = fifo_config->mode;
+
+    return ESP_OK;
+}
+
+esp_err_t qma6100p_fifo_read(qma6100p_handle_t sensor, qma6100p_raw_acce_value_t *const samples, size_t max_samples, size_t *const read_samples)
+{
+    qma6100p_dev_t *sens = (qma6100p_dev_t *) sensor;
+    uint8_t data_rd[QMA6100P_FIFO_READ_FRAMES * QMA6100P_FIFO_FRAME_SIZE];
+    uint8_t count;
+    bool drained = true;
+
+    ESP_RETURN_ON_FALSE(sens && read_samples && (samples || max_samples == 0), ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    *read_samples = 0;
+    ESP_RETURN_ON_FALSE(sens->fifo_mode != FIFO_BYPASS_MODE, ESP_ERR_INVALID_STATE, TAG, "FIFO not configured");
+
+    ESP_RETURN_ON_ERROR(qma6100p_get_fifo_frame_counter(sensor, &count), TAG, "Read FIFO frame counter error");
+    count &= 0x7F;
+    if (count > max_samples) {
+        count = max_samples;
+        drained = false;
+    }
+
+    /* Burst read of FIFO_DATA register returns the following frames */
+    while (count > 0) {
+        const uint8_t frames = (count < QMA6100P_FIFO_READ_FRAMES) ? count : QMA6100P_FIFO_READ_FRAMES;
+        ESP_RETURN_ON_ERROR(qma6100p_read(sensor, QMA6100P_FIFO_DATA, data_rd, frames * QMA6100P_FIFO_FRAME_SIZE), TAG, "Read FIFO error");
+
+        for (uint8_t i = 0; i < frames; i++) {
+            const uint8_t *frame = &data_rd[i * QMA6100P_FIFO_FRAME_SIZE];
+            qma6100p_raw_acce_value_t *sample = &samples[*read_samples + i];
+            sample->raw_acce_x = (int16_t)((frame[1] << 8) + (frame[0])) / 4;
+            sample->raw_acce_y = (int16_t)((frame[3] << 8) + (frame[2])) / 4;
+            sample->raw_acce_z = (int16_t)((frame[5] << 8) + (frame[4])) / 4;
+        }
+        *read_samples += frames;
+        count -= frames;
+    }
+
+    /* In FIFO mode, the full FIFO stops storing until it is restarted by rewriting the mode */
+    if (sens->fifo_mode == FIFO_FIFO_MODE && drained) {
+        ESP_RETURN_ON_ERROR(qma6100p_write(sensor, QMA6100P_FIFO_MODE, (FIFO_FIFO_MODE << 6) | QMA6100P_FIFO_CH_XYZ), TAG, "Write FIFO mode error");
+    }
+
+    return ESP_OK;
+}
+
+/* Read-modify-write of bits selected by mask */
+static esp_err_t qma6100p_update_bits(qma6100p_handle_t sensor, const uint8_t reg, const uint8_t mask, const uint8_t value)
+{
+    uint8_t tmp;
+    ESP_RETURN_ON_ERROR(qma6100p_read(sensor, reg, &tmp, 1), TAG, "Read register 0x%02x error", reg);
+    tmp = (tmp & ~mask) | (value & mask);
+    return qma6100p_write(sensor, reg, tmp);
+}
+
+/* Route an event to INT1 or INT2 map register, the other pin is unmapped */
+static esp_err_t qma6100p_map_event(qma6100p_handle_t sensor, const qma6100p_int_map_t int_map, const uint8_t int1_reg, const uint8_t int2_reg, const uint8_t bit)
+{
+    ESP_RETURN_ON_ERROR(qma6100p_update_bits(sensor, int1_reg, bit, (int_map == QMA6100P_INT_MAP_INT1) ? bit : 0), TAG, "Map INT1 error");
+    return qma6100p_update_bits(sensor, int2_reg, bit, (int_map == QMA6100P_INT_MAP_INT2) ? bit : 0);
+}
+
+esp_err_t qma6100p_set_odr(qma6100p_handle_t sensor, const qma6100p_odr_t odr)
+{
+    ESP_RETURN_ON_FALSE(sensor && odr <= QMA6100P_ODR_12_5HZ, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    return qma6100p_update_bits(sensor, QMA6100P_ODR_BW, 0x07, odr);
+}
+
+esp_err_t qma6100p_step_counter_config(qma6100p_handle_t sensor, const qma6100p_step_config_t *const step_config)
+{
+    ESP_RETURN_ON_FALSE(sensor && step_config, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(step_config->int_map >= QMA6100P_INT_MAP_NONE && step_config->int_map <= QMA6100P_INT_MAP_INT2,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid INT map");
+
+    const bool step_int = step_config->enable && step_config->int_map != QMA6100P_INT_MAP_NONE;
+    ESP_RETURN_ON_ERROR(qma6100p_update_bits(sensor, QMA6100P_STEP_CONF0, QMA6100P_STEP_EN, step_config->enable ? QMA6100P_STEP_EN : 0),
+                        TAG, "Write step config error");
+    ESP_RETURN_ON_ERROR(qma6100p_map_event(sensor, step_int ? step_config->int_map : QMA6100P_INT_MAP_NONE,
+                                           QMA6100P_INT1_MAP_TAP, QMA6100P_INT2_MAP_TAP, QMA6100P_STEP_INT_EN), TAG, "Map step interrupt error");
+    return qma6100p_update_bits(sensor, QMA6100P_INTR_TAP_EN, QMA6100P_STEP_INT_EN, step_int ? QMA6100P_STEP_INT_EN : 0);
+}
+
+esp_err_t qma6100p_step_counter_read(qma6100p_handle_t sensor, uint32_t *const steps)
+{
+    uint8_t data_rd[2];
+    uint8_t high;
+
+    ESP_RETURN_ON_FALSE(sensor && steps, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    /* Low and middle byte are next to each other, high byte is separated by the interrupt status registers */
+    ESP_RETURN_ON_ERROR(qma6100p_read(sensor, QMA6100P_STEP_CNT_L, data_rd, sizeof(data_rd)), TAG, "Read step counter error");
+    ESP_RETURN_ON_ERROR(qma6100p_read(sensor, QMA6100P_STEP_CNT_H, &high, 1), TAG, "Read step counter error");
+    *steps = ((uint32_t)high << 16) | ((uint32_t)data_rd[1] << 8) | data_rd[0];
+    return ESP_OK;
+}
+
+esp_err_t qma6100p_step_counter_reset(qma6100p_handle_t sensor)
+{
+    uint8_t conf;
+
+    ESP_RETURN_ON_FALSE(sensor, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_ERROR(qma6100p_read(sensor, QMA6100P_STEP_CONF1, &conf, 1), TAG, "Read step config error");
+    /* Clear bit is not self-clearing, counting resumes when it is written back to 0 */
+    ESP_RETURN_ON_ERROR(qma6100p_write(sensor, QMA6100P_STEP_CONF1, conf | QMA6100P_STEP_CLR), TAG, "Clear step counter error");
+    return qma6100p_write(sensor, QMA6100P_STEP_CONF1, conf & ~QMA6100P_STEP_CLR);
+}
+
+esp_err_t qma6100p_any_motion_config(qma6100p_handle_t sensor, const qma6100p_any_motion_config_t *const motion_config)
+{
+    float acce_sensitivity;
+
+    ESP_RETURN_ON_FALSE(sensor && motion_config, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(motion_config->int_map >= QMA6100P_INT_MAP_NONE && motion_config->int_map <= QMA6100P_INT_MAP_INT2,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid INT map");
+
+    if (motion_config->enable) {
+        ESP_RETURN_ON_FALSE(motion_config->duration >= 1 && motion_config->duration <= 4, ESP_ERR_INVALID_ARG, TAG, "Duration must be 1-4 samples");
+        ESP_RETURN_ON_ERROR(qma6100p_get_acce_sensitivity(sensor, &acce_sensitivity), TAG, "Read full scale range error");
+
+        /* Threshold LSB is 16 LSB of acceleration data, i.e. 3.9 mg at +/- 2g */
+        const float lsb_mg = 16.0f * 1000.0f / acce_sensitivity;
+        float th = motion_config->threshold_mg / lsb_mg + 0.5f;
+        th = (th > 255.0f) ? 255.0f : th;
+        ESP_RETURN_ON_ERROR(qma6100p_write(sensor, QMA6100P_ANY_MOT_TH, (uint8_t)th), TAG, "Write any-motion threshold error");
+        ESP_RETURN_ON_ERROR(qma6100p_update_bits(sensor, QMA6100P_MOT_CONF0, 0x03, motion_config->duration - 1), TAG, "Write any-motion duration error");
+    }
+
+    ESP_RETURN_ON_ERROR(qma6100p_map_event(sensor, motion_config->enable ? motion_config->int_map : QMA6100P_INT_MAP_NONE,
+                                           QMA6100P_INT1_MAP_FIFO, QMA6100P_INT2_MAP_FIFO, QMA6100P_ANY_MOT_INT_MAP), TAG, "Map any-motion interrupt error");
+    return qma6100p_update_bits(sensor, QMA6100P_INTR_MOT_EN, QMA6100P_ANY_MOT_EN_XYZ, motion_config->enable ? QMA6100P_ANY_MOT_EN_XYZ : 0);
+}
+
+esp_err_t qma6100p_get_motion_events(qma6100p_handle_t sensor, uint8_t *const events)
+{
+    uint8_t status[2];
+
+    ESP_RETURN_ON_FALSE(sensor && events, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_ERROR(qma6100p_read(sensor, QMA6100P_INTR_STATUS, status, sizeof(status)), TAG, "Read interrupt status error");
+
+    *events = 0;
+    if (status[0] & QMA6100P_ANY_MOT_ST) {
+        *events |= QMA6100P_EVENT_ANY_MOTION;
+    }
+    if (status[1] & QMA6100P_STEP_ST) {
+        *events |= QMA6100P_EVENT_STEP;
+    }
+    return ESP_OK;
+}
@@ -5,11 +5,14 @@
  */
 
 #include <stdio.h>
+#include <inttypes.h>
 #include "unity.h"
 #include "driver/i2c_master.h"
 #include "qma6100p.h"
 #include "esp_system.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "unity.h"
 #include "unity_test_runner.h"
 #include "unity_test_utils_memory.h"
@@ -76,6 +79,77 @@ TEST_CASE("Sensor qma6100p test", "[qma6100p][iot][sensor]")
     TEST_ASSERT_EQUAL(ESP_OK, ret);
 }
 
+TEST_CASE("Sensor qma6100p FIFO test", "[qma6100p][iot][sensor]")
+{
+    esp_err_t ret;
+    qma6100p_raw_acce_value_t samples[64];
+    size_t read = 0;
+    const qma6100p_fifo_config_t fifo_cfg = {
+        .mode = FIFO_STREAM_MODE,
+        .watermark = 32,
+    };
+
+    i2c_sensor_qma6100p_init();
+
+    ret = qma6100p_fifo_config(qma6100p, &fifo_cfg);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    ret = qma6100p_fifo_read(qma6100p, samples, 64, &read);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    TEST_ASSERT_GREATER_THAN(0, read);
+    ESP_LOGI(TAG, "FIFO read %u frames, first raw_acce_z:%d", (unsigned)read, samples[0].raw_acce_z);
+
+    qma6100p_delete(qma6100p);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+}
+
+TEST_CASE("Sensor qma6100p step counter and any-motion test", "[qma6100p][iot][sensor]")
+{
+    esp_err_t ret;
+    uint32_t steps = 0;
+    uint8_t events = 0;
+    const qma6100p_step_config_t step_cfg = {
+        .enable = true,
+        .int_map = QMA6100P_INT_MAP_NONE,
+    };
+    const qma6100p_any_motion_config_t motion_cfg = {
+        .enable = true,
+        .threshold_mg = 100,
+        .duration = 2,
+        .int_map = QMA6100P_INT_MAP_NONE,
+    };
+
+    i2c_sensor_qma6100p_init();
+
+    ret = qma6100p_step_counter_config(qma6100p, &step_cfg);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = qma6100p_step_counter_reset(qma6100p);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = qma6100p_step_counter_read(qma6100p, &steps);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    /* Sensor lies still on the table */
+    TEST_ASSERT_EQUAL_UINT32(0, steps);
+
+    ret = qma6100p_set_odr(qma6100p, QMA6100P_ODR_12_5HZ);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ret = qma6100p_any_motion_config(qma6100p, &motion_cfg);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    vTaskDelay(pdMS_TO_TICKS(500));
+    ret = qma6100p_get_motion_events(qma6100p, &events);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+    ESP_LOGI(TAG, "steps:%"PRIu32", events:0x%02x", steps, events);
+
+    const qma6100p_any_motion_config_t motion_off = {.enable = false};
+    TEST_ASSERT_EQUAL(ESP_OK, qma6100p_any_motion_config(qma6100p, &motion_off));
+    TEST_ASSERT_EQUAL(ESP_OK, qma6100p_set_odr(qma6100p, QMA6100P_ODR_100HZ));
+
+    qma6100p_delete(qma6100p);
+    ret = i2c_del_master_bus(i2c_handle);
+    TEST_ASSERT_EQUAL(ESP_OK, ret);
+}
+
 #define TEST_MEMORY_LEAK_THRESHOLD  (300)
 
 void setUp(void)
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2021-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2021-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: CC0-1.0
  */
@@ -12,13 +12,16 @@
 #include "freertos/queue.h"
 #include "esp_log.h"
 #include "bsp/esp-bsp.h"
+#include "esp_wav_player.h"
+#include "esp_wav_recorder.h"
 
 /* Buffer for reading/writing to I2S driver. Same length as SPIFFS buffer and I2S buffer, for optimal read/write performance.
    Recording audio data path:
-   I2S peripheral -> I2S buffer (DMA) -> App buffer (RAM) -> SPIFFS buffer -> External SPI Flash.
+   I2S peripheral -> I2S buffer (DMA) -> Ring buffer (PSRAM) -> Block buffer (RAM) -> External SPI Flash.
    Vice versa for playback. */
 #define BUFFER_SIZE     (1024)
 #define SAMPLE_RATE     (16000) // For recording
+#define PLAYBACK_SAMPLE_RATE (44100) // All files are resampled to it
 #define DEFAULT_VOLUME  (50)
 /* The recording will be RECORDING_LENGTH * BUFFER_SIZE long (in bytes)
    With sampling frequency 16000 Hz and 16bit mono resolution it equals to ~5.12 seconds */
@@ -34,18 +37,21 @@ static void btn_handler(void *button_handle, void *usr_data)
     xQueueSend(audio_button_q, &button_pressed, 0);
 }
 
-// Very simple WAV header, ignores most fields
-typedef struct __attribute__((packed))
+static void play_done_cb(esp_wav_player_handle_t player, void *user_ctx)
 {
-    uint8_t ignore_0[22];
-    uint16_t num_channels;
-    uint32_t sample_rate;
-    uint8_t ignore_1[6];
-    uint16_t bits_per_sample;
-    uint8_t ignore_2[4];
-    uint32_t data_size;
-    uint8_t data[];
-} dumb_wav_header_t;
+    esp_wav_player_stats_t stats;
+    esp_wav_player_get_stats(player, &stats, true);
+    ESP_LOGI(TAG, "Playback done, underruns: %" PRIu32 ", lowest ring level: %" PRIu32 " bytes, longest read: %" PRIu32 " us",
+             stats.underruns, stats.min_ring_level, stats.max_read_us);
+}
+
+static void record_done_cb(esp_wav_recorder_handle_t recorder, void *user_ctx)
+{
+    esp_wav_recorder_stats_t stats;
+    esp_wav_recorder_get_stats(recorder, &stats, true);
+    ESP_LOGI(TAG, "Recording done, %" PRIu32 " bytes, overruns: %" PRIu32 ", highest ring level: %" PRIu32 " bytes, longest write: %" PRIu32 " us",
+             stats.bytes_recorded, stats.overruns, stats.max_ring_level, stats.max_write_us);
+}
 
 static void audio_task(void *arg)
 {
@@ -54,6 +60,30 @@ static void audio_task(void *arg)
     esp_codec_dev_set_out_vol(spk_codec_dev, DEFAULT_VOLUME);
     esp_codec_dev_handle_t mic_codec_dev = bsp_audio_codec_microphone_init();
 
+    /* WAV player with read-ahead, so file system latency does not cause underruns.
+       The music and the recording are resampled to one codec rate, so switching of the files does not reconfigure the codec. */
+    const esp_wav_player_config_t player_cfg = {
+        .codec = spk_codec_dev,
+        .chunk_size = BUFFER_SIZE,
+        .sample_rate = PLAYBACK_SAMPLE_RATE,
+        .done_cb = play_done_cb,
+    };
+    esp_wav_player_handle_t player = NULL;
+    ESP_ERROR_CHECK(esp_wav_player_new(&player_cfg, &player));
+
+    /* WAV recorder with ring buffer, so file system latency does not drop samples */
+    esp_wav_recorder_handle_t recorder = NULL;
+    if (mic_codec_dev) {
+        const esp_wav_recorder_config_t recorder_cfg = {
+            .codec = mic_codec_dev,
+            .ring_size = 32 * 1024,
+            .block_size = 4096,
+            .chunk_size = BUFFER_SIZE,
+            .done_cb = record_done_cb,
+        };
+        ESP_ERROR_CHECK(esp_wav_recorder_new(&recorder_cfg, &recorder));
+    }
+
     /* Pointer to a file that is going to be played */
     const char music_filename[] = BSP_SPIFFS_MOUNT_POINT"/16bit_mono_22_05khz.wav";
     const char recording_filename[] = BSP_SPIFFS_MOUNT_POINT"/recording.wav";
@@ -68,47 +98,19 @@ static void audio_task(void *arg)
                     ESP_LOGW(TAG, "This board does not support microphone recording!");
                     break;
                 }
-                int16_t *recording_buffer = heap_caps_malloc(BUFFER_SIZE, MALLOC_CAP_DEFAULT);
-                assert(recording_buffer != NULL);
-
-                /* Open file for recording */
-                FILE *record_file = fopen(recording_filename, "wb");
-                assert(record_file != NULL);
-
-                /* Write WAV file header */
-                const dumb_wav_header_t recording_header = {
-                    .bits_per_sample = 16,
-                    .data_size = RECORDING_LENGTH * BUFFER_SIZE,
-                    .num_channels = 1,
-                    .sample_rate = SAMPLE_RATE
-                };
-                if (fwrite((void *)&recording_header, 1, sizeof(dumb_wav_header_t), record_file) != sizeof(dumb_wav_header_t)) {
-                    ESP_LOGW(TAG, "Error in writing to file");
-                    continue;
-                }
-                setvbuf(record_file, NULL, _IOFBF, BUFFER_SIZE);
+                /* Do not record the playback */
+                esp_wav_player_stop(player);
+                esp_codec_dev_set_in_gain(mic_codec_dev, 42.0);
 
-                esp_codec_dev_sample_info_t fs = {
+                /* Samples are written to SPIFFS by the recorder tasks, this task is not blocked by the recording */
+                const esp_wav_recorder_file_t recording_file = {
+                    .path = recording_filename,
                     .sample_rate = SAMPLE_RATE,
-                    .channel = 1,
+                    .channels = 1,
                     .bits_per_sample = 16,
+                    .max_bytes = RECORDING_LENGTH * BUFFER_SIZE,
                 };
-                esp_codec_dev_set_in_gain(mic_codec_dev, 42.0);
-                esp_codec_dev_open(mic_codec_dev, &fs);
-
-                ESP_LOGI(TAG, "Recording start");
-                size_t bytes_written_to_spiffs = 0;
-                while (bytes_written_to_spiffs < RECORDING_LENGTH * BUFFER_SIZE) {
-                    /* Read data from codec and write it to SPIFFS */
-                    ESP_ERROR_CHECK(esp_codec_dev_read(mic_codec_dev, recording_buffer, BUFFER_SIZE));
-                    size_t data_written = fwrite(recording_buffer, 1, BUFFER_SIZE, record_file);
-                    bytes_written_to_spiffs += data_written;
-                }
-
-                ESP_LOGI(TAG, "Recording stop, length: %i bytes", bytes_written_to_spiffs);
-                fclose(record_file);
-                free(recording_buffer);
-                esp_codec_dev_close(mic_codec_dev);
+                esp_wav_recorder_start(recorder, &recording_file);
                 break;
             }
             case BSP_BUTTON_SET: {
@@ -121,45 +123,12 @@ static void audio_task(void *arg)
                 break;
             }
             case BSP_BUTTON_PLAY: {
-                int16_t *wav_bytes = malloc(BUFFER_SIZE);
-                assert(wav_bytes != NULL);
-
-                /* Open WAV file */
-                ESP_LOGI(TAG, "Playing file %s", play_filename);
-                FILE *play_file = fopen(play_filename, "rb");
-                if (play_file == NULL) {
-                    ESP_LOGW(TAG, "%s file does not exist!", play_filename);
+                /* The file is read ahead by the player tasks, this task is not blocked by the playback */
+                if (recorder && esp_wav_recorder_is_recording(recorder)) {
+                    ESP_LOGW(TAG, "Recording is running");
                     break;
                 }
-
-                /* Read WAV header file */
-                dumb_wav_header_t wav_header;
-                if (fread((void *)&wav_header, 1, sizeof(wav_header), play_file) != sizeof(wav_header)) {
-                    ESP_LOGW(TAG, "Error in reading file");
-                    break;
-                }
-                ESP_LOGI(TAG, "Number of channels: %" PRIu16 "", wav_header.num_channels);
-                ESP_LOGI(TAG, "Bits per sample: %" PRIu16 "", wav_header.bits_per_sample);
-                ESP_LOGI(TAG, "Sample rate: %" PRIu32 "", wav_header.sample_rate);
-                ESP_LOGI(TAG, "Data size: %" PRIu32 "", wav_header.data_size);
-
-                esp_codec_dev_sample_info_t fs = {
-                    .sample_rate = wav_header.sample_rate,
-                    .channel = wav_header.num_channels,
-                    .bits_per_sample = wav_header.bits_per_sample,
-                };
-                esp_codec_dev_open(spk_codec_dev, &fs);
-
-                uint32_t bytes_send_to_i2s = 0;
-                while (bytes_send_to_i2s < wav_header.data_size) {
-                    /* Get data from SPIFFS and send it to codec */
-                    size_t bytes_read_from_spiffs = fread(wav_bytes, 1, BUFFER_SIZE, play_file);
-                    esp_codec_dev_write(spk_codec_dev, wav_bytes, bytes_read_from_spiffs);
-                    bytes_send_to_i2s += bytes_read_from_spiffs;
-                }
-                fclose(play_file);
-                free(wav_bytes);
-                esp_codec_dev_close(spk_codec_dev);
+                esp_wav_player_play(player, play_filename, false);
                 break;
             }
             case BSP_BUTTON_VOLDOWN: {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -21,18 +21,22 @@
 #include "bsp/esp-bsp.h"
 #include "lvgl.h"
 #include "app_disp_fs.h"
-#include "jpeg_decoder.h"
+#include "app_jpeg_stream.h"
+#include "esp_wav_player.h"
+#include "esp_wav_recorder.h"
 
 /* SPIFFS mount root */
 #define FS_MNT_PATH  BSP_SPIFFS_MOUNT_POINT
 
 /* Buffer for reading/writing to I2S driver. Same length as SPIFFS buffer and I2S buffer, for optimal read/write performance.
    Recording audio data path:
-   I2S peripheral -> I2S buffer (DMA) -> App buffer (RAM) -> SPIFFS buffer -> External SPI Flash.
+   I2S peripheral -> I2S buffer (DMA) -> Ring buffer (PSRAM) -> Block buffer (RAM) -> External SPI Flash.
    Vice versa for playback. */
 #define BUFFER_SIZE     (1024)
 #define SAMPLE_RATE     (22050)
+#define PLAYBACK_SAMPLE_RATE (44100) // All files are resampled to it
 #define DEFAULT_VOLUME  (70)
+#define VOLUME_UPDATE_MS (50)   /* Slider drags are written to the codec at most every 50 ms */
 /* The recording will be RECORDING_LENGTH * BUFFER_SIZE long (in bytes)
    With sampling frequency 22050 Hz and 16bit mono resolution it equals to ~3.715 seconds */
 #define RECORDING_LENGTH (160)
@@ -54,19 +58,6 @@ typedef enum {
     APP_FILE_TYPE_WAV,
 } app_file_type_t;
 
-// Very simple WAV header, ignores most fields
-typedef struct __attribute__((packed))
-{
-    uint8_t ignore_0[22];
-    uint16_t num_channels;
-    uint32_t sample_rate;
-    uint8_t ignore_1[6];
-    uint16_t bits_per_sample;
-    uint8_t ignore_2[4];
-    uint32_t data_size;
-    uint8_t data[];
-} dumb_wav_header_t;
-
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
@@ -77,6 +68,10 @@ static void app_disp_lvgl_show_files(const char *path);
 static void scroll_begin_event(lv_event_t *e);
 static void tab_changed_event(lv_event_t *e);
 static void set_tab_group(void);
+static void play_done_cb(esp_wav_player_handle_t player, void *user_ctx);
+#if BSP_CAPS_AUDIO_MIC
+static void rec_done_cb(esp_wav_recorder_handle_t recorder, void *user_ctx);
+#endif
 
 /*******************************************************************************
 * Local variables
@@ -90,16 +85,17 @@ static lv_group_t *settings_group = NULL;
 
 /* FS */
 static lv_obj_t *fs_list = NULL;
-static lv_obj_t *fs_img = NULL;
 static char fs_current_path[250];
 
-static uint8_t *file_buffer = NULL;
-static size_t file_buffer_size = 0;
-
 /* Audio */
-static SemaphoreHandle_t audio_mux;
+static esp_wav_player_handle_t wav_player = NULL;
+#if BSP_CAPS_AUDIO_MIC
+static esp_wav_recorder_handle_t wav_recorder = NULL;
+#endif
 static bool play_file_repeat = false;
-static bool play_file_stop = false;
+/* Started and ended playbacks (under display lock), each started playback ends once (done or stopped by the next one) */
+static uint32_t play_started = 0;
+static uint32_t play_ended = 0;
 static char usb_drive_play_file[250];
 static lv_obj_t *play_btn = NULL, *play1_btn = NULL, *rec_btn = NULL, *rec_stop_btn = NULL;
 
@@ -163,21 +159,39 @@ void app_audio_init(void)
     /* Speaker output volume */
     esp_codec_dev_set_out_vol(spk_codec_dev, DEFAULT_VOLUME);
 
+    /* WAV player reads the file ahead in its own task, the playback is not blocked by UI and file system.
+       All files are resampled to one codec rate, so switching of the files does not reconfigure the codec. */
+    const esp_wav_player_config_t player_cfg = {
+        .codec = spk_codec_dev,
+        .chunk_size = BUFFER_SIZE,
+        .mclk_multiple = I2S_MCLK_MULTIPLE_384,
+        .sample_rate = PLAYBACK_SAMPLE_RATE,
+        .done_cb = play_done_cb,
+    };
+    ESP_ERROR_CHECK(esp_wav_player_new(&player_cfg, &wav_player));
+
     /* Initialize microphone */
 #if BSP_CAPS_AUDIO_MIC
     mic_codec_dev = bsp_audio_codec_microphone_init();
     assert(mic_codec_dev);
     /* Microphone input gain */
     esp_codec_dev_set_in_gain(mic_codec_dev, 50.0);
+
+    /* WAV recorder writes the file in its own task, the codec is not blocked by UI and file system */
+    const esp_wav_recorder_config_t recorder_cfg = {
+        .codec = mic_codec_dev,
+        .ring_size = 32 * 1024,
+        .block_size = 4096,
+        .chunk_size = BUFFER_SIZE,
+        .mclk_multiple = I2S_MCLK_MULTIPLE_384,
+        .done_cb = rec_done_cb,
+    };
+    ESP_ERROR_CHECK(esp_wav_recorder_new(&recorder_cfg, &wav_recorder));
 #endif
 }
 
 void app_disp_fs_init(void)
 {
-    file_buffer_size = BSP_LCD_H_RES * BSP_LCD_V_RES * sizeof(lv_color_t);
-    file_buffer = heap_caps_calloc(file_buffer_size, 1, MALLOC_CAP_DEFAULT);
-    assert(file_buffer);
-
     /* Initialize root path */
     strcpy(fs_current_path, FS_MNT_PATH);
 
@@ -216,7 +230,7 @@ static void close_window_handler(lv_event_t *e)
     lv_event_code_t code = lv_event_get_code(e);
 
     if (code == LV_EVENT_CLICKED) {
-        memset(file_buffer, 0, file_buffer_size);
+        app_jpeg_stream_stop();
         lv_obj_del(lv_event_get_user_data(e));
 
         /* Re-set the TAB group */
@@ -244,12 +258,17 @@ static void show_window(const char *path, app_file_type_t type)
     lv_label_set_text(label, "");
     lv_obj_center(label);
 
-    if (type == APP_FILE_TYPE_IMG) {
-        fs_img = lv_canvas_create(cont);
-    }
-
     /* Show image or text file */
-    if (type == APP_FILE_TYPE_TXT || type == APP_FILE_TYPE_IMG) {
+    if (type == APP_FILE_TYPE_IMG) {
+        /* The image is decoded in parts directly into the window, the whole decoded image is not held in RAM */
+        lv_area_t area;
+        lv_obj_update_layout(win);
+        lv_obj_get_content_coords(cont, &area);
+        esp_err_t err = app_jpeg_stream_start(path, lv_obj_get_display(win), &area, BSP_LCD_BIGENDIAN);
+        if (err != ESP_OK) {
+            lv_label_set_text(label, (err == ESP_ERR_INVALID_STATE ? "Previous image is still decoding!" : "Not enough memory!"));
+        }
+    } else if (type == APP_FILE_TYPE_TXT) {
         /* Get file size */
         int f = stat(path, &st);
         if (f == 0) {
@@ -265,32 +284,8 @@ static void show_window(const char *path, app_file_type_t type)
             if (f > 0) {
                 /* Read file */
                 read(f, file_buf, filesize);
-                if (type == APP_FILE_TYPE_TXT && label) {
-                    file_buf[filesize] = 0;
-                    lv_label_set_text(label, file_buf);
-                } else if (fs_img) {
-                    ESP_LOGI(TAG, "Decoding JPEG image...");
-                    /* JPEG decode */
-                    esp_jpeg_image_cfg_t jpeg_cfg = {
-                        .indata = (uint8_t *)file_buf,
-                        .indata_size = filesize,
-                        .outbuf = file_buffer,
-                        .outbuf_size = file_buffer_size,
-                        .out_format = JPEG_IMAGE_FORMAT_RGB565,
-                        .out_scale = JPEG_IMAGE_SCALE_0,
-                        .flags = {
-#if CONFIG_LV_COLOR_16_SWAP
-                            .swap_color_bytes = 1,
-#endif
-                        }
-                    };
-                    esp_jpeg_image_output_t outimg;
-                    esp_jpeg_decode(&jpeg_cfg, &outimg);
-
-                    lv_canvas_set_buffer(fs_img, file_buffer, outimg.width, outimg.height, LV_COLOR_FORMAT_RGB565);
-                    lv_obj_center(fs_img);
-                    lv_obj_invalidate(fs_img);
-                }
+                file_buf[filesize] = 0;
+                lv_label_set_text(label, file_buf);
 
                 close(f);
             } else {
@@ -315,90 +310,25 @@ static void show_window(const char *path, app_file_type_t type)
 
 }
 
-static void play_file(void *arg)
+/* Called from WAV player task */
+static void play_done_cb(esp_wav_player_handle_t player, void *user_ctx)
 {
-    char *path = arg;
-    FILE *file = NULL;
-    int16_t *wav_bytes = heap_caps_malloc(BUFFER_SIZE, MALLOC_CAP_DEFAULT);
-    if (wav_bytes == NULL) {
-        ESP_LOGE(TAG, "Not enough memory for playing!");
-        goto END;
-    }
-
-    /* Open file */
-    file = fopen(path, "rb");
-    if (file == NULL) {
-        ESP_LOGE(TAG, "%s file does not exist!", path);
-        goto END;
-    }
+    esp_wav_player_stats_t stats;
+    esp_wav_player_get_stats(player, &stats, true);
+    ESP_LOGI(TAG, "Playback done, underruns: %" PRIu32 ", lowest ring level: %" PRIu32 " bytes", stats.underruns, stats.min_ring_level);
 
-    /* Read WAV header file */
-    dumb_wav_header_t wav_header;
-    if (fread((void *)&wav_header, 1, sizeof(wav_header), file) != sizeof(wav_header)) {
-        ESP_LOGW(TAG, "Error in reading file");
-        goto END;
-    }
-    ESP_LOGI(TAG, "Number of channels: %" PRIu16 "", wav_header.num_channels);
-    ESP_LOGI(TAG, "Bits per sample: %" PRIu16 "", wav_header.bits_per_sample);
-    ESP_LOGI(TAG, "Sample rate: %" PRIu32 "", wav_header.sample_rate);
-    ESP_LOGI(TAG, "Data size: %" PRIu32 "", wav_header.data_size);
-
-
-    esp_codec_dev_sample_info_t fs = {
-        .sample_rate = wav_header.sample_rate,
-        .channel = wav_header.num_channels,
-        .bits_per_sample = wav_header.bits_per_sample,
-        .mclk_multiple = I2S_MCLK_MULTIPLE_384,
-    };
-    esp_codec_dev_open(spk_codec_dev, &fs);
-
-    uint32_t bytes_send_to_i2s = 0;
-    do {
-        bytes_send_to_i2s = 0;
-        fseek(file, sizeof(wav_header), SEEK_SET);
-        while (bytes_send_to_i2s < wav_header.data_size) {
-            if (play_file_stop) {
-                goto END;
-            }
-            xSemaphoreTake(audio_mux, portMAX_DELAY);
-
-            /* Get data from SPIFFS */
-            size_t bytes_read_from_spiffs = fread(wav_bytes, 1, BUFFER_SIZE, file);
-
-            /* Send it to I2S */
-            esp_codec_dev_write(spk_codec_dev, wav_bytes, bytes_read_from_spiffs);
-            bytes_send_to_i2s += bytes_read_from_spiffs;
-            xSemaphoreGive(audio_mux);
+    bsp_display_lock(0);
+    /* Playback stopped by the next one is ignored, the buttons stay disabled while the next one is playing */
+    play_ended++;
+    if (play_ended == play_started) {
+        if (play_btn) {
+            lv_obj_clear_state(play_btn, LV_STATE_DISABLED);
+        }
+        if (play1_btn) {
+            lv_obj_clear_state(play1_btn, LV_STATE_DISABLED);
         }
-        vTaskDelay(pdMS_TO_TICKS(100));
-    } while (play_file_repeat);
-
-
-
-END:
-    esp_codec_dev_close(spk_codec_dev);
-
-    if (file) {
-        fclose(file);
-    }
-
-    if (wav_bytes) {
-        free(wav_bytes);
-    }
-
-    if (play_btn) {
-        bsp_display_lock(0);
-        lv_obj_clear_state(play_btn, LV_STATE_DISABLED);
-        bsp_display_unlock();
-    }
-
-    if (play1_btn) {
-        bsp_display_lock(0);
-        lv_obj_clear_state(play1_btn, LV_STATE_DISABLED);
-        bsp_display_unlock();
     }
-
-    vTaskDelete(NULL);
+    bsp_display_unlock();
 }
 
 /* Play selected audio file */
@@ -408,9 +338,10 @@ static void play_event_cb(lv_event_t *e)
     lv_obj_t *obj = lv_event_get_target(e);
 
     if (code == LV_EVENT_CLICKED) {
-        play_file_stop = false;
-        lv_obj_add_state(obj, LV_STATE_DISABLED);
-        xTaskCreate(play_file, "audio_task", 4096, lv_event_get_user_data(e), 6, NULL);
+        if (esp_wav_player_play(wav_player, lv_event_get_user_data(e), play_file_repeat) == ESP_OK) {
+            play_started++;
+            lv_obj_add_state(obj, LV_STATE_DISABLED);
+        }
     }
 }
 
@@ -420,7 +351,7 @@ static void stop_event_cb(lv_event_t *e)
     lv_event_code_t code = lv_event_get_code(e);
 
     if (code == LV_EVENT_CLICKED) {
-        play_file_stop = true;
+        esp_wav_player_stop(wav_player);
     }
 }
 
@@ -432,7 +363,20 @@ static void repeat_event_cb(lv_event_t *e)
 
     if (code == LV_EVENT_VALUE_CHANGED) {
         play_file_repeat = ( (lv_obj_get_state(obj) & LV_STATE_CHECKED) ? true : false);
+        esp_wav_player_set_repeat(wav_player, play_file_repeat);
+    }
+}
+
+static int32_t volume_pending = DEFAULT_VOLUME;
+static lv_timer_t *volume_timer = NULL;
+
+/* Write only the latest slider value, so dragging does not flood the I2C bus shared with touch */
+static void volume_timer_cb(lv_timer_t *timer)
+{
+    if (spk_codec_dev) {
+        esp_codec_dev_set_out_vol(spk_codec_dev, volume_pending);
     }
+    lv_timer_pause(timer);
 }
 
 static void volume_event_cb(lv_event_t *e)
@@ -441,9 +385,11 @@ static void volume_event_cb(lv_event_t *e)
 
     assert(slider != NULL);
 
-    int32_t volume = lv_slider_get_value(slider);
-    if (spk_codec_dev) {
-        esp_codec_dev_set_out_vol(spk_codec_dev, volume);
+    volume_pending = lv_slider_get_value(slider);
+    if (volume_timer == NULL) {
+        volume_timer = lv_timer_create(volume_timer_cb, VOLUME_UPDATE_MS, NULL);
+    } else {
+        lv_timer_resume(volume_timer);
     }
 }
 
@@ -452,12 +398,9 @@ static void close_window_wav_handler(lv_event_t *e)
     lv_event_code_t code = lv_event_get_code(e);
 
     if (code == LV_EVENT_CLICKED) {
-        memset(file_buffer, 0, file_buffer_size);
+        esp_wav_player_stop(wav_player);
         lv_obj_del(lv_event_get_user_data(e));
-        play_file_stop = true;
-
-        xSemaphoreTake(audio_mux, portMAX_DELAY);
-        vSemaphoreDelete(audio_mux);
+        play_btn = NULL;
 
         /* Re-set the TAB group */
         set_tab_group();
@@ -475,9 +418,6 @@ static void show_window_wav(const char *path)
 
     play_file_repeat = false;
 
-    audio_mux = xSemaphoreCreateMutex();
-    assert(audio_mux);
-
     /* Close button */
     btn = lv_win_add_button(win, LV_SYMBOL_CLOSE, 60);
     lv_obj_add_event_cb(btn, close_window_wav_handler, LV_EVENT_CLICKED, win);
@@ -748,11 +688,10 @@ static void rec_play_event_cb(lv_event_t *e)
     lv_obj_t *obj = lv_event_get_target(e);
 
     if (code == LV_EVENT_CLICKED) {
-        audio_mux = xSemaphoreCreateMutex();
-        assert(audio_mux);
-        play_file_stop = false;
-        lv_obj_add_state(obj, LV_STATE_DISABLED);
-        xTaskCreate(play_file, "audio_task", 4096, lv_event_get_user_data(e), 6, NULL);
+        if (esp_wav_player_play(wav_player, lv_event_get_user_data(e), false) == ESP_OK) {
+            play_started++;
+            lv_obj_add_state(obj, LV_STATE_DISABLED);
+        }
     }
 }
 
@@ -762,71 +701,18 @@ static void rec_stop_event_cb(lv_event_t *e)
     lv_event_code_t code = lv_event_get_code(e);
 
     if (code == LV_EVENT_CLICKED) {
-        play_file_stop = true;
+        esp_wav_player_stop(wav_player);
     }
 }
 
-static void rec_file(void *arg)
-{
 #if BSP_CAPS_AUDIO_MIC
-    char *path = arg;
-    FILE *record_file = NULL;
-    int16_t *recording_buffer = heap_caps_malloc(BUFFER_SIZE, MALLOC_CAP_DEFAULT);
-    if (recording_buffer == NULL) {
-        ESP_LOGE(TAG, "Not enough memory for playing!");
-        goto END;
-    }
-
-    /* Open file for recording */
-    record_file = fopen(path, "wb");
-    if (record_file == NULL) {
-        ESP_LOGE(TAG, "%s file does not exist!", path);
-        goto END;
-    }
-
-    /* Write WAV file header */
-    const dumb_wav_header_t recording_header = {
-        .bits_per_sample = 16,
-        .data_size = RECORDING_LENGTH * BUFFER_SIZE,
-        .num_channels = 1,
-        .sample_rate = SAMPLE_RATE
-    };
-    if (fwrite((void *)&recording_header, 1, sizeof(dumb_wav_header_t), record_file) != sizeof(dumb_wav_header_t)) {
-        ESP_LOGW(TAG, "Error in writting to file");
-        goto END;
-    }
-
-    ESP_LOGI(TAG, "Recording start");
-
-    esp_codec_dev_sample_info_t fs = {
-        .sample_rate = SAMPLE_RATE,
-        .channel = 1,
-        .bits_per_sample = 16,
-        .mclk_multiple = I2S_MCLK_MULTIPLE_384,
-    };
-    esp_codec_dev_open(mic_codec_dev, &fs);
-
-    size_t bytes_written_to_spiffs = 0;
-    while (bytes_written_to_spiffs < RECORDING_LENGTH * BUFFER_SIZE) {
-        ESP_ERROR_CHECK(esp_codec_dev_read(mic_codec_dev, recording_buffer, BUFFER_SIZE));
-
-        /* Write WAV file data */
-        size_t data_written = fwrite(recording_buffer, 1, BUFFER_SIZE, record_file);
-        bytes_written_to_spiffs += data_written;
-    }
-
-    ESP_LOGI(TAG, "Recording stop, length: %i bytes", bytes_written_to_spiffs);
-
-END:
-    esp_codec_dev_close(mic_codec_dev);
-
-    if (record_file) {
-        fclose(record_file);
-    }
-
-    if (recording_buffer) {
-        free(recording_buffer);
-    }
+/* Called from WAV recorder task */
+static void rec_done_cb(esp_wav_recorder_handle_t recorder, void *user_ctx)
+{
+    esp_wav_recorder_stats_t stats;
+    esp_wav_recorder_get_stats(recorder, &stats, true);
+    ESP_LOGI(TAG, "Recording done, %" PRIu32 " bytes, overruns: %" PRIu32 ", longest write: %" PRIu32 " us",
+             stats.bytes_recorded, stats.overruns, stats.max_write_us);
 
     if (rec_btn && play1_btn && rec_stop_btn) {
         bsp_display_lock(0);
@@ -835,12 +721,8 @@ END:
         lv_obj_clear_state(rec_stop_btn, LV_STATE_DISABLED);
         bsp_display_unlock();
     }
-
-    vTaskDelete(NULL);
-#else
-    ESP_LOGI(TAG, "Recording not supported!");
-#endif
 }
+#endif
 
 /* Stop playing recorded audio file */
 static void rec_event_cb(lv_event_t *e)
@@ -849,12 +731,28 @@ static void rec_event_cb(lv_event_t *e)
     lv_obj_t *obj = lv_event_get_target(e);
 
     if (code == LV_EVENT_CLICKED) {
+        esp_wav_player_stop(wav_player);
         lv_obj_add_state(obj, LV_STATE_DISABLED);
         if (rec_stop_btn && play1_btn) {
             lv_obj_add_state(play1_btn, LV_STATE_DISABLED);
             lv_obj_add_state(rec_stop_btn, LV_STATE_DISABLED);
         }
-        xTaskCreate(rec_file, "rec_file", 4096, lv_event_get_user_data(e), 6, NULL);
+#if BSP_CAPS_AUDIO_MIC
+        const esp_wav_recorder_file_t rec_file = {
+            .path = lv_event_get_user_data(e),
+            .sample_rate = SAMPLE_RATE,
+            .channels = 1,
+            .bits_per_sample = 16,
+            .max_bytes = RECORDING_LENGTH * BUFFER_SIZE,
+        };
+        if (esp_wav_recorder_start(wav_recorder, &rec_file) != ESP_OK) {
+            lv_obj_clear_state(obj, LV_STATE_DISABLED);
+            lv_obj_clear_state(play1_btn, LV_STATE_DISABLED);
+            lv_obj_clear_state(rec_stop_btn, LV_STATE_DISABLED);
+        }
+#else
+        ESP_LOGI(TAG, "Recording not supported!");
+#endif
     }
 }
 
@@ -0,0 +1,354 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/stream_buffer.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp32s3/rom/tjpgd.h"
+#include "bsp/esp-bsp.h"
+#include "esp_lvgl_port.h"
+#include "app_jpeg_stream.h"
+
+/* Size of one file read */
+#define APP_JPEG_STREAM_CHUNK       (4096)
+/* Read-ahead of the reader task */
+#define APP_JPEG_STREAM_READ_AHEAD  (2 * APP_JPEG_STREAM_CHUNK)
+/* Number of band (MCU row) buffers, one is decoded, while the other one is sent to LCD */
+#define APP_JPEG_STREAM_BANDS       (2)
+/* Work buffer of TJpgDec in ROM */
+#define APP_JPEG_WORK_BUF_SIZE      (3100)
+/* Maximal scale down of TJpgDec (1/8) */
+#define APP_JPEG_MAX_SCALE          (3)
+
+static const char *TAG = "JPEG";
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+typedef struct {
+    char                        *path;
+    FILE                        *file;
+    lv_display_t                *disp;
+    lv_area_t                   area;           /* LCD area for the image */
+    bool                        swap_bytes;
+    /* Reader */
+    StreamBufferHandle_t        stream;         /* Read-ahead of the file */
+    SemaphoreHandle_t           reader_done;
+    volatile bool               reader_stop;
+    volatile bool               eof;            /* The whole file is in the stream */
+    /* Output */
+    lvgl_port_video_handle_t    video;
+    QueueHandle_t               free_bands;     /* Band buffers not used by LCD */
+    uint16_t                    *bands[APP_JPEG_STREAM_BANDS];
+    uint16_t                    *band;          /* Band being decoded */
+    int32_t                     out_width;      /* Width of the decoded (scaled) image */
+    int32_t                     src_x;          /* Visible part of the decoded image */
+    int32_t                     src_y;
+    int32_t                     width;
+    int32_t                     height;
+} app_jpeg_stream_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void app_jpeg_stream_task(void *arg);
+static void app_jpeg_reader_task(void *arg);
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+static volatile bool jpeg_stream_running = false;
+static volatile bool jpeg_stream_stop = false;
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t app_jpeg_stream_start(const char *path, lv_display_t *disp, const lv_area_t *area, bool swap_bytes)
+{
+    assert(path && disp && area);
+
+    if (jpeg_stream_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    app_jpeg_stream_t *ctx = calloc(1, sizeof(app_jpeg_stream_t));
+    if (ctx == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    ctx->path = strdup(path);
+    ctx->disp = disp;
+    ctx->swap_bytes = swap_bytes;
+    lv_area_copy(&ctx->area, area);
+
+    jpeg_stream_stop = false;
+    jpeg_stream_running = true;
+    if (ctx->path == NULL || xTaskCreate(app_jpeg_stream_task, "jpeg_stream", 4096, ctx, 3, NULL) != pdPASS) {
+        jpeg_stream_running = false;
+        free(ctx->path);
+        free(ctx);
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+void app_jpeg_stream_stop(void)
+{
+    jpeg_stream_stop = true;
+}
+
+/*******************************************************************************
+* Private API function
+*******************************************************************************/
+
+static void app_jpeg_reader_task(void *arg)
+{
+    app_jpeg_stream_t *ctx = (app_jpeg_stream_t *)arg;
+    uint8_t *chunk = malloc(APP_JPEG_STREAM_CHUNK);
+    size_t len = 0;
+
+    while (chunk && !ctx->reader_stop && (len = fread(chunk, 1, APP_JPEG_STREAM_CHUNK, ctx->file)) > 0) {
+        size_t sent = 0;
+        while (sent < len && !ctx->reader_stop) {
+            sent += xStreamBufferSend(ctx->stream, chunk + sent, len - sent, pdMS_TO_TICKS(100));
+        }
+    }
+
+    free(chunk);
+    ctx->eof = true;
+    xSemaphoreGive(ctx->reader_done);
+    vTaskDelete(NULL);
+}
+
+/* TJpgDec input: read (or skip, when buff is NULL) nbyte bytes from the read-ahead stream */
+static unsigned int app_jpeg_stream_input(JDEC *dec, uint8_t *buff, unsigned int nbyte)
+{
+    app_jpeg_stream_t *ctx = (app_jpeg_stream_t *)dec->device;
+    uint8_t skip[64];
+    unsigned int got = 0;
+
+    while (got < nbyte) {
+        uint8_t *dst = (buff ? buff + got : skip);
+        size_t len = (buff ? nbyte - got : MIN(nbyte - got, sizeof(skip)));
+        size_t received = xStreamBufferReceive(ctx->stream, dst, len, pdMS_TO_TICKS(10));
+        if (received == 0 && ctx->eof && xStreamBufferIsEmpty(ctx->stream)) {
+            break;
+        }
+        got += received;
+    }
+
+    return got;
+}
+
+/* TJpgDec output: put the RGB888 block into the band, send the band to LCD after the last block in MCU row */
+static unsigned int app_jpeg_stream_output(JDEC *dec, void *bitmap, JRECT *rect)
+{
+    app_jpeg_stream_t *ctx = (app_jpeg_stream_t *)dec->device;
+
+    if (jpeg_stream_stop) {
+        return 0;
+    }
+
+    /* Visible rows of the block */
+    const int32_t y1 = MAX(rect->top, ctx->src_y);
+    const int32_t y2 = MIN(rect->bottom, ctx->src_y + ctx->height - 1);
+    if (y1 > y2) {
+        return 1;
+    }
+
+    if (ctx->band == NULL) {
+        xQueueReceive(ctx->free_bands, &ctx->band, portMAX_DELAY);
+    }
+
+    /* Visible columns of the block */
+    const int32_t x1 = MAX(rect->left, ctx->src_x);
+    const int32_t x2 = MIN(rect->right, ctx->src_x + ctx->width - 1);
+    const int32_t block_width = rect->right - rect->left + 1;
+    for (int32_t y = y1; y <= y2; y++) {
+        const uint8_t *in = (const uint8_t *)bitmap + ((y - rect->top) * block_width + (x1 - rect->left)) * 3;
+        uint16_t *out = ctx->band + (y - y1) * ctx->width + (x1 - ctx->src_x);
+        for (int32_t x = x1; x <= x2; x++) {
+            uint16_t color = ((in[0] & 0xF8) << 8) | ((in[1] & 0xFC) << 3) | (in[2] >> 3);
+            *out++ = (ctx->swap_bytes ? (color >> 8) | (color << 8) : color);
+            in += 3;
+        }
+    }
+
+    if (rect->right == ctx->out_width - 1) {
+        const lv_area_t area = {
+            .x1 = 0,
+            .y1 = y1 - ctx->src_y,
+            .x2 = ctx->width - 1,
+            .y2 = y2 - ctx->src_y,
+        };
+        /* The band is returned by release callback, when its transfer is done */
+        if (lvgl_port_video_push_area(ctx->video, &area, ctx->band, ctx->band) != ESP_OK) {
+            xQueueSend(ctx->free_bands, &ctx->band, 0);
+        }
+        ctx->band = NULL;
+    }
+
+    return 1;
+}
+
+/* Called from LVGL task */
+static void app_jpeg_stream_release(void *frame, void *user_ctx)
+{
+    app_jpeg_stream_t *ctx = (app_jpeg_stream_t *)user_ctx;
+    xQueueSend(ctx->free_bands, &frame, 0);
+}
+
+static void app_jpeg_stream_task(void *arg)
+{
+    app_jpeg_stream_t *ctx = (app_jpeg_stream_t *)arg;
+    bool reader_started = false;
+    JDEC dec;
+    JRESULT res;
+    uint8_t *work = NULL;
+
+    ctx->file = fopen(ctx->path, "rb");
+    if (ctx->file == NULL) {
+        ESP_LOGE(TAG, "%s file does not exist!", ctx->path);
+        goto END;
+    }
+
+    ctx->stream = xStreamBufferCreate(APP_JPEG_STREAM_READ_AHEAD, 1);
+    ctx->reader_done = xSemaphoreCreateBinary();
+    ctx->free_bands = xQueueCreate(APP_JPEG_STREAM_BANDS, sizeof(uint16_t *));
+    work = malloc(APP_JPEG_WORK_BUF_SIZE);
+    if (ctx->stream == NULL || ctx->reader_done == NULL || ctx->free_bands == NULL || work == NULL) {
+        ESP_LOGE(TAG, "Not enough memory for decoding!");
+        goto END;
+    }
+
+    /* Reader fills the stream, while the decoder waits for the LCD transfers */
+    if (xTaskCreate(app_jpeg_reader_task, "jpeg_reader", 3072, ctx, 4, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Not enough memory for reader task!");
+        goto END;
+    }
+    reader_started = true;
+
+    res = jd_prepare(&dec, app_jpeg_stream_input, work, APP_JPEG_WORK_BUF_SIZE, ctx);
+    if (res != JDR_OK) {
+        ESP_LOGE(TAG, "Unsupported JPEG image (%d)!", res);
+        goto END;
+    }
+
+    /* Scale down to fit the area, crop the rest */
+    const int32_t area_width = lv_area_get_width(&ctx->area);
+    const int32_t area_height = lv_area_get_height(&ctx->area);
+    uint8_t scale = 0;
+    while (scale < APP_JPEG_MAX_SCALE && ((dec.width >> scale) > area_width || (dec.height >> scale) > area_height)) {
+        scale++;
+    }
+    const int32_t out_height = dec.height >> scale;
+    ctx->out_width = dec.width >> scale;
+    ctx->width = MIN(ctx->out_width, area_width);
+    ctx->height = MIN(out_height, area_height);
+    ctx->src_x = (ctx->out_width - ctx->width) / 2;
+    ctx->src_y = (out_height - ctx->height) / 2;
+
+    /* One MCU row, in internal RAM for DMA */
+    const size_t band_size = ctx->width * ((dec.msy * 8) >> scale) * sizeof(uint16_t);
+    for (int i = 0; i < APP_JPEG_STREAM_BANDS; i++) {
+        ctx->bands[i] = heap_caps_malloc(band_size, MALLOC_CAP_DMA);
+        if (ctx->bands[i] == NULL) {
+            ESP_LOGE(TAG, "Not enough memory for decoding!");
+            goto END;
+        }
+        xQueueSend(ctx->free_bands, &ctx->bands[i], 0);
+    }
+
+    /* The window must be on the LCD, before the image is drawn over it */
+    bsp_display_lock(0);
+    if (!jpeg_stream_stop) {
+        lv_refr_now(ctx->disp);
+    }
+    bsp_display_unlock();
+
+    const lvgl_port_video_cfg_t video_cfg = {
+        .disp = ctx->disp,
+        .hres = ctx->width,
+        .vres = ctx->height,
+        .x = ctx->area.x1 + (area_width - ctx->width) / 2,
+        .y = ctx->area.y1 + (area_height - ctx->height) / 2,
+        .release_cb = app_jpeg_stream_release,
+        .user_ctx = ctx,
+        .flags = {
+            .direct = 1,
+        }
+    };
+    if (jpeg_stream_stop || lvgl_port_video_create(&video_cfg, &ctx->video) != ESP_OK) {
+        ESP_LOGE(TAG, "Image cannot be sent to LCD!");
+        goto END;
+    }
+
+    ESP_LOGI(TAG, "Decoding JPEG image %dx%d (scale 1/%d)...", (int)dec.width, (int)dec.height, 1 << scale);
+    res = jd_decomp(&dec, app_jpeg_stream_output, scale);
+    if (res != JDR_OK && !jpeg_stream_stop) {
+        ESP_LOGE(TAG, "JPEG decoding failed (%d)!", res);
+    }
+
+END:
+    if (ctx->video) {
+        if (ctx->band) {
+            xQueueSend(ctx->free_bands, &ctx->band, 0);
+        }
+        while (lvgl_port_video_delete(ctx->video) == ESP_ERR_NO_MEM) {
+            vTaskDelay(1);
+        }
+        /* All bands are released after the last transfer */
+        for (int i = 0; i < APP_JPEG_STREAM_BANDS; i++) {
+            uint16_t *band;
+            xQueueReceive(ctx->free_bands, &band, portMAX_DELAY);
+        }
+    }
+
+    if (reader_started) {
+        ctx->reader_stop = true;
+        xSemaphoreTake(ctx->reader_done, portMAX_DELAY);
+    }
+
+    /* Parts of the image could be drawn over the objects behind the closed window */
+    if (jpeg_stream_stop) {
+        bsp_display_lock(0);
+        lv_obj_invalidate(lv_display_get_screen_active(ctx->disp));
+        bsp_display_unlock();
+    }
+
+    for (int i = 0; i < APP_JPEG_STREAM_BANDS; i++) {
+        free(ctx->bands[i]);
+    }
+    free(work);
+    if (ctx->free_bands) {
+        vQueueDelete(ctx->free_bands);
+    }
+    if (ctx->reader_done) {
+        vSemaphoreDelete(ctx->reader_done);
+    }
+    if (ctx->stream) {
+        vStreamBufferDelete(ctx->stream);
+    }
+    if (ctx->file) {
+        fclose(ctx->file);
+    }
+    free(ctx->path);
+    free(ctx);
+
+    jpeg_stream_running = false;
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Show JPEG file in LCD area without decoding the whole image into RAM
+ *
+ * The file is read ahead in chunks by a reader task and decoded in MCU rows, which are sent directly to the LCD.
+ * The image is scaled down (up to 1/8) to fit the area and centered. It is drawn over LVGL objects in the area.
+ *
+ * @note It returns immediately, decoding runs in its own task.
+ *
+ * @param path       path of the JPEG file
+ * @param disp       LVGL display
+ * @param area       LCD area of the image
+ * @param swap_bytes swap bytes of RGB565 pixels (big endian LCD)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if another image is still being decoded
+ *      - ESP_ERR_NO_MEM            if there is not enough memory
+ */
+esp_err_t app_jpeg_stream_start(const char *path, lv_display_t *disp, const lv_area_t *area, bool swap_bytes);
+
+/**
+ * @brief Stop decoding of the shown JPEG file (e.g. the window was closed)
+ *
+ * @note The screen is invalidated, when the decoding was interrupted.
+ */
+void app_jpeg_stream_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,10 +1,11 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: CC0-1.0
  */
 
 #include <stdio.h>
+#include <inttypes.h>
 #include <string.h>
 #include "sdkconfig.h"
 #include "bsp/esp-bsp.h"
@@ -18,18 +19,34 @@
 #include "esp_lcd_panel_vendor.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_camera.h"
+#include "esp_camera_pipe.h"
 
 static const char *TAG = "example";
 
+static lvgl_port_video_handle_t video = NULL;
+
+static void camera_frame_release(void *frame, void *user_ctx)
+{
+    esp_camera_pipe_release((esp_camera_pipe_consumer_handle_t)user_ctx, (const esp_camera_pipe_frame_t *)frame);
+}
+
+/* Runs in the capture task, the frame is released by the video layer when the next one is shown */
+static void camera_frame_display(esp_camera_pipe_consumer_handle_t consumer, const esp_camera_pipe_frame_t *frame, void *user_ctx)
+{
+    lvgl_port_video_push(video, frame->buf, (void *)frame);
+}
+
 void app_main(void)
 {
     bsp_i2c_init();
-    bsp_display_start();
+    lv_display_t *disp = bsp_display_start();
     bsp_display_backlight_on(); // Set display brightness to 100%
 
-    // Initialize the camera
+    // Initialize the camera pipeline, it initializes the camera
     const camera_config_t camera_config = BSP_CAMERA_DEFAULT_CONFIG;
-    esp_err_t err = esp_camera_init(&camera_config);
+    const esp_camera_pipe_config_t pipe_config = ESP_CAMERA_PIPE_DEFAULT_CONFIG(&camera_config);
+    esp_camera_pipe_handle_t pipe = NULL;
+    esp_err_t err = esp_camera_pipe_new(&pipe_config, &pipe);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Camera Init Failed");
         return;
@@ -39,34 +56,48 @@ void app_main(void)
     s->set_hmirror(s, BSP_CAMERA_HMIRROR);
     ESP_LOGI(TAG, "Camera Init done");
 
-    uint32_t cam_buff_size = BSP_LCD_H_RES * BSP_LCD_V_RES * 2;
-    uint8_t *cam_buff = heap_caps_malloc(cam_buff_size, MALLOC_CAP_SPIRAM);
-    assert(cam_buff);
+    // Display is the consumer of the pipeline, other consumers (e.g. ML) can be added before start
+    esp_camera_pipe_consumer_handle_t display_consumer = NULL;
+    const esp_camera_pipe_consumer_config_t consumer_config = {
+        .frame_cb = camera_frame_display,
+        .max_frames = 2,
+    };
+    ESP_ERROR_CHECK(esp_camera_pipe_add_consumer(pipe, &consumer_config, &display_consumer));
 
-    // Create LVGL canvas for camera image
-    bsp_display_lock(0);
-    lv_obj_t *camera_canvas = lv_canvas_create(lv_scr_act());
-    lv_canvas_set_buffer(camera_canvas, cam_buff, BSP_LCD_H_RES, BSP_LCD_V_RES, LV_COLOR_FORMAT_RGB565);
-    assert(camera_canvas);
-    lv_obj_center(camera_canvas);
-    bsp_display_unlock();
+    // Camera frames are shown without copying. The camera frame is returned, when the next one is shown.
+    // Byte order of camera RGB565 is big-endian. On big-endian LCDs the frames are sent directly to LCD,
+    // otherwise they are drawn by LVGL as an image.
+    const uint16_t frame_width = resolution[camera_config.frame_size].width;
+    const uint16_t frame_height = resolution[camera_config.frame_size].height;
+    const lvgl_port_video_cfg_t video_cfg = {
+        .disp = disp,
+        .hres = frame_width,
+        .vres = frame_height,
+        .color_format = LV_COLOR_FORMAT_RGB565,
+        .x = (BSP_LCD_H_RES - (int32_t)frame_width) / 2,
+        .y = (BSP_LCD_V_RES - (int32_t)frame_height) / 2,
+        .release_cb = camera_frame_release,
+        .user_ctx = display_consumer,
+        .flags = {
+            .direct = BSP_LCD_BIGENDIAN,
+        }
+    };
+    ESP_ERROR_CHECK(lvgl_port_video_create(&video_cfg, &video));
+    if (!BSP_LCD_BIGENDIAN) {
+        bsp_display_lock(0);
+        lv_obj_center(lvgl_port_video_get_obj(video));
+        bsp_display_unlock();
+    }
+
+    ESP_ERROR_CHECK(esp_camera_pipe_start(pipe));
 
-    camera_fb_t *pic;
     while (1) {
-        pic = esp_camera_fb_get();
-        if (pic) {
-            esp_camera_fb_return(pic);
-            bsp_display_lock(0);
-            memcpy(cam_buff, pic->buf, cam_buff_size);
-            if (BSP_LCD_BIGENDIAN) {
-                /* Swap bytes in RGB565 */
-                lv_draw_sw_rgb565_swap(cam_buff, cam_buff_size);
-            }
-            lv_obj_invalidate(camera_canvas);
-            bsp_display_unlock();
-        } else {
-            ESP_LOGE(TAG, "Get frame failed");
-        }
-        vTaskDelay(1);
+        vTaskDelay(pdMS_TO_TICKS(5000));
+        esp_camera_pipe_stats_t stats;
+        esp_camera_pipe_consumer_stats_t display_stats;
+        esp_camera_pipe_get_stats(pipe, &stats, true);
+        esp_camera_pipe_get_consumer_stats(display_consumer, &display_stats, true);
+        ESP_LOGI(TAG, "Frames: %"PRIu32", dropped: %"PRIu32", capture: %"PRIu32" us, display: %"PRIu32" us",
+                 stats.frames, stats.dropped, stats.avg_capture_us, display_stats.avg_hold_us);
     }
 }
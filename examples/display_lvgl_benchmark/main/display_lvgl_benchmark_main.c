@@ -0,0 +1,269 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "esp_timer.h"
+
+#include "lvgl.h"
+#include "esp_lvgl_port.h"
+#include "bsp/esp-bsp.h"
+
+static const char *TAG = "app_main";
+
+/* Benchmark results are printed as lines "DISP_BENCH,..." parsed by pytest_display_lvgl_benchmark.py */
+#define BENCH_IMAGE_SIZE    (100)
+#define BENCH_RECTS         (8)
+
+typedef enum {
+    SCENE_FILL,     /* Full screen color change */
+    SCENE_RECTS,    /* Small moving rectangles (many small partial areas) */
+    SCENE_IMAGE,    /* Moving opaque RGB565 image */
+    SCENE_TEXT,     /* Full width text changed every frame */
+    SCENE_MAX,
+} bench_scene_t;
+
+static const char *const scene_names[SCENE_MAX] = {"fill", "rects", "image", "text"};
+
+typedef struct {
+    const char *name;
+    uint32_t caps;                      /* 0 is buffers of BSP */
+    bool full;                          /* Full refresh with full screen buffers */
+} bench_variant_t;
+
+static const bench_variant_t variants[] = {
+    {.name = "bsp"},
+#if CONFIG_EXAMPLE_BENCH_BUFFER_VARIANTS
+    {.name = "sram_partial", .caps = MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL},
+#if CONFIG_SPIRAM
+    {.name = "psram_partial", .caps = MALLOC_CAP_SPIRAM},
+    {.name = "psram_full", .caps = MALLOC_CAP_SPIRAM, .full = true},
+#endif
+#endif
+};
+
+static const lv_display_rotation_t rotations[] = {
+    LV_DISPLAY_ROTATION_0, LV_DISPLAY_ROTATION_90, LV_DISPLAY_ROTATION_180, LV_DISPLAY_ROTATION_270,
+};
+
+static struct {
+    lv_display_t *disp;
+    bench_scene_t scene;
+    lv_obj_t *objs[BENCH_RECTS];
+    lv_image_dsc_t image;
+    uint32_t frames;
+    bool running;
+} bench;
+
+/* Next frame of the scene, called after each finished refresh */
+static void bench_scene_step(void)
+{
+    const int32_t hres = lv_display_get_horizontal_resolution(bench.disp);
+    const int32_t vres = lv_display_get_vertical_resolution(bench.disp);
+    const uint32_t f = bench.frames;
+
+    switch (bench.scene) {
+    case SCENE_FILL:
+        lv_obj_set_style_bg_color(bench.objs[0], lv_palette_main((lv_palette_t)(f % LV_PALETTE_LAST)), 0);
+        break;
+    case SCENE_RECTS:
+        for (int i = 0; i < BENCH_RECTS; i++) {
+            const int32_t w = hres / BENCH_RECTS;
+            lv_obj_set_pos(bench.objs[i], (i * w + f * 3) % (hres - w), ((i + 1) * 37 + f * 5) % (vres - w));
+        }
+        break;
+    case SCENE_IMAGE:
+        lv_obj_set_pos(bench.objs[0], (f * 4) % (hres - BENCH_IMAGE_SIZE), (f * 3) % (vres - BENCH_IMAGE_SIZE));
+        break;
+    case SCENE_TEXT:
+        lv_label_set_text_fmt(bench.objs[0], "Frame %"PRIu32"\nThe quick brown fox jumps over the lazy dog.\n"
+                              "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG.\n0123456789 %"PRIu32, f, f * 7);
+        break;
+    default:
+        break;
+    }
+}
+
+static void bench_refr_ready_cb(lv_event_t *e)
+{
+    if (bench.running) {
+        bench.frames++;
+        bench_scene_step();
+    }
+}
+
+/* Create objects of the scene on the empty screen (called with LVGL lock) */
+static void bench_scene_create(bench_scene_t scene)
+{
+    lv_obj_t *scr = lv_screen_active();
+    lv_obj_clean(scr);
+    lv_obj_set_style_bg_color(scr, lv_color_black(), 0);
+    lv_obj_set_scrollbar_mode(scr, LV_SCROLLBAR_MODE_OFF);
+    const int32_t hres = lv_display_get_horizontal_resolution(bench.disp);
+
+    bench.scene = scene;
+    switch (scene) {
+    case SCENE_FILL:
+        bench.objs[0] = lv_obj_create(scr);
+        lv_obj_remove_style_all(bench.objs[0]);
+        lv_obj_set_size(bench.objs[0], LV_PCT(100), LV_PCT(100));
+        lv_obj_set_style_bg_opa(bench.objs[0], LV_OPA_COVER, 0);
+        break;
+    case SCENE_RECTS:
+        for (int i = 0; i < BENCH_RECTS; i++) {
+            bench.objs[i] = lv_obj_create(scr);
+            lv_obj_remove_style_all(bench.objs[i]);
+            lv_obj_set_size(bench.objs[i], hres / BENCH_RECTS, hres / BENCH_RECTS);
+            lv_obj_set_style_bg_opa(bench.objs[i], LV_OPA_COVER, 0);
+            lv_obj_set_style_bg_color(bench.objs[i], lv_palette_main((lv_palette_t)i), 0);
+        }
+        break;
+    case SCENE_IMAGE:
+        bench.objs[0] = lv_image_create(scr);
+        lv_image_set_src(bench.objs[0], &bench.image);
+        break;
+    case SCENE_TEXT:
+        bench.objs[0] = lv_label_create(scr);
+        lv_obj_set_width(bench.objs[0], LV_PCT(100));
+        lv_obj_set_style_text_color(bench.objs[0], lv_color_white(), 0);
+        lv_label_set_long_mode(bench.objs[0], LV_LABEL_LONG_WRAP);
+        break;
+    default:
+        break;
+    }
+    bench_scene_step();
+}
+
+static void bench_image_init(void)
+{
+    const uint32_t stride = BENCH_IMAGE_SIZE * sizeof(uint16_t);
+    uint16_t *data = heap_caps_malloc(stride * BENCH_IMAGE_SIZE, MALLOC_CAP_DEFAULT);
+    assert(data);
+    /* RGB565 gradient */
+    for (int y = 0; y < BENCH_IMAGE_SIZE; y++) {
+        for (int x = 0; x < BENCH_IMAGE_SIZE; x++) {
+            data[y * BENCH_IMAGE_SIZE + x] = ((x * 31 / BENCH_IMAGE_SIZE) << 11) | ((y * 63 / BENCH_IMAGE_SIZE) << 5) | ((x + y) * 31 / (2 * BENCH_IMAGE_SIZE));
+        }
+    }
+#if LV_VERSION_CHECK(9, 1, 0)
+    bench.image.header.magic = LV_IMAGE_HEADER_MAGIC;
+#endif
+    bench.image.header.cf = LV_COLOR_FORMAT_RGB565;
+    bench.image.header.w = BENCH_IMAGE_SIZE;
+    bench.image.header.h = BENCH_IMAGE_SIZE;
+    bench.image.header.stride = stride;
+    bench.image.data_size = stride * BENCH_IMAGE_SIZE;
+    bench.image.data = (const uint8_t *)data;
+}
+
+/* Replace draw buffers of the display, previous variant buffers are freed */
+static bool bench_set_buffers(const bench_variant_t *variant, void *bufs[2])
+{
+    void *old[2] = {bufs[0], bufs[1]};
+    const uint32_t px_size = lv_color_format_get_size(lv_display_get_color_format(bench.disp));
+    const uint32_t hres = lv_display_get_physical_horizontal_resolution(bench.disp);
+    const uint32_t vres = lv_display_get_physical_vertical_resolution(bench.disp);
+    const uint32_t size = hres * (variant->full ? vres : vres / 10) * px_size;
+
+    bufs[0] = heap_caps_malloc(size, variant->caps);
+    bufs[1] = heap_caps_malloc(size, variant->caps);
+    if (bufs[0] == NULL || bufs[1] == NULL) {
+        free(bufs[0]);
+        free(bufs[1]);
+        bufs[0] = old[0];
+        bufs[1] = old[1];
+        return false;
+    }
+
+    lvgl_port_lock(0);
+    lv_display_set_buffers(bench.disp, bufs[0], bufs[1], size, variant->full ? LV_DISPLAY_RENDER_MODE_FULL : LV_DISPLAY_RENDER_MODE_PARTIAL);
+    /* Next flush waits for the end of transfer from the old buffers */
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(bench.disp);
+    lvgl_port_unlock();
+
+    free(old[0]);
+    free(old[1]);
+    return true;
+}
+
+static void bench_print_info(const char *variant)
+{
+    lv_draw_buf_t *buf = lv_display_get_buf_active(bench.disp);
+    printf("DISP_BENCH_INFO,%s,%"PRId32",%"PRId32",%"PRIu32",%s,%d\n", variant,
+           lv_display_get_physical_horizontal_resolution(bench.disp), lv_display_get_physical_vertical_resolution(bench.disp),
+           buf ? buf->data_size : 0, (buf && esp_ptr_external_ram(buf->data)) ? "psram" : "sram", LV_COLOR_DEPTH);
+}
+
+static void bench_run(const char *variant, bench_scene_t scene, lv_display_rotation_t rotation)
+{
+    lvgl_port_disp_stats_t start = {0}, end = {0};
+
+    lvgl_port_lock(0);
+    lv_display_set_rotation(bench.disp, rotation);
+    bench_scene_create(scene);
+    lv_refr_now(bench.disp);
+    lvgl_port_get_disp_stats(bench.disp, &start);
+    bench.frames = 0;
+    bench.running = true;
+    const int64_t t_start = esp_timer_get_time();
+    lvgl_port_unlock();
+
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_EXAMPLE_BENCH_SCENE_MS));
+
+    lvgl_port_lock(0);
+    bench.running = false;
+    const int64_t t_us = esp_timer_get_time() - t_start;
+    const uint32_t frames = bench.frames;
+    lvgl_port_get_disp_stats(bench.disp, &end);
+    lvgl_port_unlock();
+
+    printf("DISP_BENCH,%s,%s,%d,%"PRIu32",%.1f,%"PRIu64",%"PRIu64",%"PRIu32",%"PRIu64"\n",
+           variant, scene_names[scene], (int)rotation * 90, frames, frames * 1000000.0 / t_us,
+           (end.total.render_us - start.total.render_us) / (frames ? frames : 1),
+           (end.total.trans_wait_us - start.total.trans_wait_us) / (frames ? frames : 1),
+           end.total.flushes - start.total.flushes, end.total.pixels - start.total.pixels);
+}
+
+void app_main(void)
+{
+    /* Initialize display and LVGL */
+    bench.disp = bsp_display_start();
+    assert(bench.disp);
+    bsp_display_backlight_on();
+    bench_image_init();
+
+    ESP_LOGI(TAG, "Display LVGL benchmark");
+    lvgl_port_lock(0);
+    lv_display_add_event_cb(bench.disp, bench_refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+    /* Render the next frame as soon as possible */
+    lv_timer_set_period(lv_display_get_refr_timer(bench.disp), 1);
+    lvgl_port_unlock();
+
+    void *bufs[2] = {NULL, NULL};
+    for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+        if (variants[v].caps && !bench_set_buffers(&variants[v], bufs)) {
+            printf("DISP_BENCH_SKIP,%s,no memory\n", variants[v].name);
+            continue;
+        }
+        bench_print_info(variants[v].name);
+        for (size_t r = 0; r < sizeof(rotations) / sizeof(rotations[0]); r++) {
+            for (int s = 0; s < SCENE_MAX; s++) {
+                bench_run(variants[v].name, s, rotations[r]);
+            }
+        }
+    }
+
+    lvgl_port_lock(0);
+    lv_display_set_rotation(bench.disp, LV_DISPLAY_ROTATION_0);
+    lvgl_port_unlock();
+    printf("DISP_BENCH_DONE\n");
+}
@@ -0,0 +1,110 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: CC0-1.0
+
+import csv
+import json
+import os
+import re
+
+import pytest
+from pytest_embedded import Dut
+
+# JSON file with stored FPS per board, variant, scene and rotation (e.g. measured on the previous release)
+BASELINE_FILE = os.getenv('DISP_BENCH_BASELINE', '')
+# Allowed FPS drop against the baseline (0.1 = 10 %)
+TOLERANCE = float(os.getenv('DISP_BENCH_TOLERANCE', '0.1'))
+
+# Lines printed by display_lvgl_benchmark_main.c
+INFO_RE = re.compile(rb'DISP_BENCH_INFO,(\w+),(\d+),(\d+),(\d+),(\w+),(\d+)')
+RESULT_RE = re.compile(rb'DISP_BENCH,(\w+),(\w+),(\d+),(\d+),([\d.]+),(\d+),(\d+),(\d+),(\d+)')
+SKIP_RE = re.compile(rb'DISP_BENCH_SKIP,(\w+),([^\r\n]*)')
+DONE_RE = re.compile(rb'DISP_BENCH_DONE')
+INFO_FIELDS = ['variant', 'hres', 'vres', 'buffer_size', 'buffer_mem', 'color_depth']
+FIELDS = ['variant', 'scene', 'rotation', 'frames', 'fps', 'render_us', 'trans_wait_us', 'flushes', 'pixels']
+
+LVGL_PORT_MANIFEST = os.path.join(os.path.dirname(__file__), '..', '..', 'components', 'esp_lvgl_port', 'idf_component.yml')
+
+
+def lvgl_port_version() -> str:
+    with open(LVGL_PORT_MANIFEST) as f:
+        match = re.search(r'^version:\s*"?([^"\s]+)"?', f.read(), re.MULTILINE)
+    return match.group(1) if match else 'unknown'
+
+
+def run_benchmark(dut: Dut) -> tuple:
+    info, results, skipped = {}, [], {}
+    while True:
+        match = dut.expect([INFO_RE, RESULT_RE, SKIP_RE, DONE_RE], timeout=300)
+        line = match.group(0)
+        if line.startswith(b'DISP_BENCH_DONE'):
+            return info, results, skipped
+        values = [group.decode() for group in match.groups()]
+        if line.startswith(b'DISP_BENCH_INFO'):
+            entry = dict(zip(INFO_FIELDS, values))
+            for field in ('hres', 'vres', 'buffer_size', 'color_depth'):
+                entry[field] = int(entry[field])
+            info[entry.pop('variant')] = entry
+        elif line.startswith(b'DISP_BENCH_SKIP'):
+            skipped[values[0]] = values[1]
+        else:
+            result = dict(zip(FIELDS, values))
+            for field in ('rotation', 'frames', 'render_us', 'trans_wait_us', 'flushes', 'pixels'):
+                result[field] = int(result[field])
+            result['fps'] = float(result['fps'])
+            results.append(result)
+
+
+def write_report(logdir: str, board: str, info: dict, results: list, skipped: dict) -> None:
+    name = f'display_benchmark_{board}'
+    with open(os.path.join(logdir, f'{name}.json'), 'w') as f:
+        json.dump({'board': board, 'esp_lvgl_port': lvgl_port_version(), 'variants': info,
+                   'skipped': skipped, 'results': results}, f, indent=4)
+    with open(os.path.join(logdir, f'{name}.csv'), 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=FIELDS)
+        writer.writeheader()
+        writer.writerows(results)
+    # Table for the pages of the boards, FPS per scene and rotation
+    with open(os.path.join(logdir, f'{name}.md'), 'w') as f:
+        f.write(f'### {board} (esp_lvgl_port {lvgl_port_version()})\n\n')
+        f.write('| Buffers | Scene | 0° | 90° | 180° | 270° |\n|---|---|---|---|---|---|\n')
+        table = {}
+        for result in results:
+            table.setdefault((result['variant'], result['scene']), {})[result['rotation']] = result['fps']
+        for (variant, scene), fps in table.items():
+            cells = ' | '.join(f'{fps[rot]:.1f}' if rot in fps else '-' for rot in (0, 90, 180, 270))
+            f.write(f'| {variant} | {scene} | {cells} |\n')
+        for variant, reason in skipped.items():
+            f.write(f'| {variant} | skipped: {reason} | - | - | - | - |\n')
+
+
+def check_baseline(board: str, results: list) -> None:
+    if not BASELINE_FILE or not os.path.exists(BASELINE_FILE):
+        return
+    with open(BASELINE_FILE) as f:
+        baseline = json.load(f).get(board, {})
+
+    regressions = []
+    for result in results:
+        key = f"{result['variant']},{result['scene']},{result['rotation']}"
+        expected = baseline.get(key)
+        if expected is not None and result['fps'] < expected * (1 - TOLERANCE):
+            regressions.append(f"{key}: {result['fps']:.1f} < {expected:.1f} FPS")
+    assert not regressions, 'FPS regressions against the baseline:\n' + '\n'.join(regressions)
+
+
+@pytest.mark.esp_box_3
+@pytest.mark.esp32_p4_function_ev_board
+@pytest.mark.esp32_s3_eye
+@pytest.mark.esp32_s3_lcd_ev_board
+@pytest.mark.esp32_s3_lcd_ev_board_2
+@pytest.mark.m5dial
+@pytest.mark.m5stack_core_s3
+@pytest.mark.m5stack_core_s3_se
+def test_display_benchmark(dut: Dut, request: pytest.FixtureRequest) -> None:
+    # The board is selected by its marker (see conftest.py)
+    board = request.config.getoption('-m') or dut.target
+    dut.expect_exact('app_main: Display LVGL benchmark')
+    info, results, skipped = run_benchmark(dut)
+    assert results, 'No benchmark results'
+    write_report(dut.logdir, board, info, results, skipped)
+    check_baseline(board, results)
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: CC0-1.0
  */
@@ -7,8 +7,12 @@
 #include "esp_log.h"
 #include "bsp/esp-bsp.h"
 #include "lvgl.h"
-#if BSP_CAPS_IMU
-#include "icm42670.h"
+
+/* Rotation by IMU, when the BSP has the automatic rotation service */
+#if BSP_CAPS_IMU && defined(BSP_DISPLAY_AUTO_ROTATE_DEFAULT_CONFIG)
+#define APP_AUTO_ROTATE 1
+#else
+#define APP_AUTO_ROTATE 0
 #endif
 
 static const char *TAG = "example";
@@ -19,9 +23,7 @@ LV_IMG_DECLARE(esp_logo)
 static lv_disp_t *display;
 static lv_obj_t *lbl_rotation;
 static lv_disp_rotation_t rotation = LV_DISPLAY_ROTATION_0;
-#if BSP_CAPS_IMU
-static icm42670_handle_t imu = NULL;
-#endif
+static bool auto_rotate = false;
 
 
 /*******************************************************************************
@@ -75,11 +77,26 @@ static void app_lvgl_btn_left_cb(lv_event_t *e)
     bsp_display_unlock();
 }
 
+#if APP_AUTO_ROTATE
+/* Called with display lock, right after the display was rotated */
+static void app_display_rotated_cb(lv_display_t *disp, lv_disp_rotation_t new_rotation, void *user_ctx)
+{
+    rotation = new_rotation;
+    if (lbl_rotation) {
+        lv_label_set_text_fmt(lbl_rotation, "Rotation %d°", app_lvgl_get_rotation_degrees(rotation));
+    }
+}
+#endif
+
 static void app_lvgl_display(void)
 {
     lv_obj_t *scr = lv_scr_act();
     lv_obj_t *lbl;
     bsp_display_lock(0);
+#if LV_VERSION_CHECK(9, 2, 0)
+    /* Images are compressed in flash (lvgl_port_create_c_image_compressed() in CMakeLists.txt) */
+    lvgl_port_cimage_decoder_init();
+#endif
 
     // Create image
     lv_obj_t *img_logo = lv_img_create(scr);
@@ -90,10 +107,7 @@ static void app_lvgl_display(void)
     lv_label_set_text(lbl_rotation, "Rotation 0°");
     lv_obj_align(lbl_rotation, LV_ALIGN_CENTER, 0, 20);
 
-#if BSP_CAPS_IMU
-    if (!imu)
-#endif
-    {
+    if (!auto_rotate) {
         lv_obj_t *cont_row = lv_obj_create(scr);
         lv_obj_set_size(cont_row, BSP_LCD_V_RES - 10, 50);
         lv_obj_align(cont_row, LV_ALIGN_BOTTOM_MID, 0, -20);
@@ -137,82 +151,6 @@ static void app_lvgl_display(void)
     bsp_display_unlock();
 }
 
-#if BSP_CAPS_IMU
-static void app_imu_init(void)
-{
-    i2c_master_bus_handle_t i2c_handle = bsp_i2c_get_handle();
-    ESP_ERROR_CHECK(icm42670_create(i2c_handle, ICM42670_I2C_ADDRESS, &imu));
-    if (imu) {
-        /* Configuration of the accelerometer and gyroscope */
-        const icm42670_cfg_t imu_cfg = {
-            .acce_fs = ACCE_FS_2G,
-            .acce_odr = ACCE_ODR_400HZ,
-            .gyro_fs = GYRO_FS_2000DPS,
-            .gyro_odr = GYRO_ODR_400HZ,
-        };
-        ESP_ERROR_CHECK(icm42670_config(imu, &imu_cfg));
-
-        /* Set accelerometer and gyroscope to ON */
-        icm42670_acce_set_pwr(imu, ACCE_PWR_LOWNOISE);
-        icm42670_gyro_set_pwr(imu, GYRO_PWR_LOWNOISE);
-    }
-}
-
-static void app_imu_read(void)
-{
-    icm42670_value_t acce_val;
-    icm42670_get_acce_value(imu, &acce_val);
-    ESP_LOGI(TAG, "ACCE val: %.2f, %.2f, %.2f", acce_val.x, acce_val.y, acce_val.z);
-
-    icm42670_value_t gyro_val;
-    icm42670_get_gyro_value(imu, &gyro_val);
-    ESP_LOGI(TAG, "GYRO val: %.2f, %.2f, %.2f", gyro_val.x, gyro_val.y, gyro_val.z);
-
-    float val;
-    icm42670_get_temp_value(imu, &val);
-    ESP_LOGI(TAG, "TEMP val: %.2f", val);
-
-    complimentary_angle_t angle;
-    icm42670_complimentory_filter(imu, &acce_val, &gyro_val, &angle);
-    ESP_LOGI(TAG, "Angle roll: %.2f pitch: %.2f ", angle.roll, angle.pitch);
-
-    if (acce_val.y < -0.6) {
-        if (rotation != LV_DISPLAY_ROTATION_0) {
-            rotation = LV_DISPLAY_ROTATION_0;
-            bsp_display_lock(0);
-            bsp_display_rotate(display, rotation);
-            lv_label_set_text_fmt(lbl_rotation, "Rotation %d°", app_lvgl_get_rotation_degrees(rotation));
-            bsp_display_unlock();
-        }
-    } else if (acce_val.y > 0.6) {
-        if (rotation != LV_DISPLAY_ROTATION_180) {
-            rotation = LV_DISPLAY_ROTATION_180;
-            bsp_display_lock(0);
-            bsp_display_rotate(display, rotation);
-            lv_label_set_text_fmt(lbl_rotation, "Rotation %d°", app_lvgl_get_rotation_degrees(rotation));
-            bsp_display_unlock();
-        }
-    } else if (acce_val.x > 0.6) {
-        if (rotation != LV_DISPLAY_ROTATION_270) {
-            rotation = LV_DISPLAY_ROTATION_270;
-            bsp_display_lock(0);
-            bsp_display_rotate(display, rotation);
-            lv_label_set_text_fmt(lbl_rotation, "Rotation %d°", app_lvgl_get_rotation_degrees(rotation));
-            bsp_display_unlock();
-        }
-    } else if (acce_val.x < -0.6) {
-        if (rotation != LV_DISPLAY_ROTATION_90) {
-            rotation = LV_DISPLAY_ROTATION_90;
-            bsp_display_lock(0);
-            bsp_display_rotate(display, rotation);
-            lv_label_set_text_fmt(lbl_rotation, "Rotation %d°", app_lvgl_get_rotation_degrees(rotation));
-            bsp_display_unlock();
-        }
-    }
-
-}
-#endif
-
 void app_main(void)
 {
     /* Initialize display and LVGL */
@@ -221,19 +159,25 @@ void app_main(void)
     /* Set display brightness to 100% */
     bsp_display_backlight_on();
 
-#if BSP_CAPS_IMU
-    app_imu_init();
+#if APP_AUTO_ROTATE
+    const bsp_display_auto_rotate_cfg_t rotate_cfg = {
+        .enter_g = 0.6f,
+        .leave_g = 0.4f,
+        .debounce_ms = 300,
+        .period_ms = 100,
+        .rotated_cb = app_display_rotated_cb,
+        .task_priority = 2,
+        .task_stack = 3072,
+    };
+    if (bsp_display_auto_rotate_start(&rotate_cfg) == ESP_OK) {
+        auto_rotate = true;
+    } else {
+        ESP_LOGW(TAG, "IMU not available, use buttons for rotation");
+    }
 #endif
 
     /* Add and show objects on display */
     app_lvgl_display();
 
     ESP_LOGI(TAG, "Example initialization done.");
-
-#if BSP_CAPS_IMU
-    while (1) {
-        app_imu_read();
-        vTaskDelay(pdMS_TO_TICKS(500));
-    }
-#endif
 }
@@ -0,0 +1,265 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_lvgl_port.h"
+#include "sensor_ui.h"
+
+static const char *TAG = "sensor_ui";
+
+/* Longest wait for samples, the stop request is served after it */
+#define SENSOR_UI_POLL_MS   (100)
+
+struct sensor_ui_binding_s {
+    sensor_ui_binding_config_t config;
+    sensor_ui_handle_t ui;
+    esp_sensor_hub_data_t latest;   /* Last sample (value_num 0: none) */
+    esp_sensor_hub_data_t shown;    /* Sample of the last update (value_num 0: none) */
+    bool dirty;                     /* Latest sample should be shown */
+    int64_t next_update;            /* Throttling of the widget */
+};
+
+struct sensor_ui_s {
+    sensor_ui_config_t config;
+    esp_sensor_hub_sub_handle_t sub;
+    portMUX_TYPE lock;              /* Lock of bindings and async state */
+    struct sensor_ui_binding_s *bindings;
+    uint8_t binding_num;
+    bool async_pending;             /* Updates are scheduled by lv_async_call */
+    int64_t next_batch;             /* Throttling of all updates */
+    TaskHandle_t task;
+    volatile bool stop;
+    SemaphoreHandle_t stopped;      /* Given by the task before exit */
+};
+
+static void sensor_ui_task(void *arg);
+static void sensor_ui_apply(void *arg);
+
+esp_err_t sensor_ui_new(const sensor_ui_config_t *config, sensor_ui_handle_t *ret_ui)
+{
+    esp_err_t ret = ESP_OK;
+    ESP_RETURN_ON_FALSE(config && ret_ui && config->hub && config->max_bindings, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    sensor_ui_handle_t ui = calloc(1, sizeof(struct sensor_ui_s));
+    ESP_RETURN_ON_FALSE(ui, ESP_ERR_NO_MEM, TAG, "Not enough memory");
+    ui->config = *config;
+    if (ui->config.frame_period_ms == 0) {
+        ui->config.frame_period_ms = LV_DEF_REFR_PERIOD;
+    }
+    portMUX_INITIALIZE(&ui->lock);
+    ui->bindings = calloc(config->max_bindings, sizeof(struct sensor_ui_binding_s));
+    ui->stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(ui->bindings && ui->stopped, ESP_ERR_NO_MEM, err, TAG, "Not enough memory");
+    ESP_GOTO_ON_ERROR(esp_sensor_hub_subscribe(config->hub, config->sensor_mask, config->queue_len, &ui->sub), err, TAG, "subscribe fail");
+
+    if (xTaskCreate(sensor_ui_task, "sensor_ui", config->task_stack, ui, config->task_priority, &ui->task) != pdPASS) {
+        ui->task = NULL;
+        ESP_GOTO_ON_FALSE(false, ESP_ERR_NO_MEM, err, TAG, "Create task fail!");
+    }
+    *ret_ui = ui;
+    return ESP_OK;
+
+err:
+    sensor_ui_del(ui);
+    return ret;
+}
+
+esp_err_t sensor_ui_del(sensor_ui_handle_t ui)
+{
+    ESP_RETURN_ON_FALSE(ui, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    if (ui->task) {
+        ui->stop = true;
+        xSemaphoreTake(ui->stopped, portMAX_DELAY);
+        lvgl_port_lock(0);
+        lv_async_call_cancel(sensor_ui_apply, ui);
+        lvgl_port_unlock();
+    }
+    if (ui->stopped) {
+        vSemaphoreDelete(ui->stopped);
+    }
+    free(ui->bindings);
+    free(ui);
+    return ESP_OK;
+}
+
+esp_err_t sensor_ui_bind(sensor_ui_handle_t ui, const sensor_ui_binding_config_t *config, sensor_ui_binding_handle_t *ret_binding)
+{
+    ESP_RETURN_ON_FALSE(ui && config && ret_binding && config->widget && config->update_cb, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(ui->config.sensor_mask & (1UL << config->sensor_id), ESP_ERR_INVALID_ARG, TAG, "sensor is not subscribed");
+
+    sensor_ui_binding_handle_t binding = NULL;
+    portENTER_CRITICAL(&ui->lock);
+    if (ui->binding_num < ui->config.max_bindings) {
+        binding = &ui->bindings[ui->binding_num];
+        binding->config = *config;
+        binding->ui = ui;
+        ui->binding_num++;
+    }
+    portEXIT_CRITICAL(&ui->lock);
+    ESP_RETURN_ON_FALSE(binding, ESP_ERR_NO_MEM, TAG, "Too many bindings");
+
+    *ret_binding = binding;
+    return ESP_OK;
+}
+
+void sensor_ui_set_enabled(sensor_ui_binding_handle_t binding, bool enabled)
+{
+    sensor_ui_handle_t ui = binding->ui;
+    esp_sensor_hub_data_t data;
+    bool update = false;
+
+    portENTER_CRITICAL(&ui->lock);
+    binding->config.enabled = enabled;
+    if (enabled && binding->latest.value_num > 0) {
+        data = binding->latest;
+        binding->shown = data;
+        binding->dirty = false;
+        binding->next_update = esp_timer_get_time() + (int64_t)binding->config.min_period_ms * 1000;
+        update = true;
+    }
+    portEXIT_CRITICAL(&ui->lock);
+
+    /* Caller holds LVGL lock */
+    if (update) {
+        binding->config.update_cb(binding->config.widget, &data, binding->config.user_ctx);
+    }
+}
+
+static bool sensor_ui_changed(const sensor_ui_binding_handle_t binding, const esp_sensor_hub_data_t *data)
+{
+    if (binding->shown.value_num != data->value_num) {
+        return true;
+    }
+    for (int i = 0; i < data->value_num; i++) {
+        if (fabsf(data->values[i] - binding->shown.values[i]) > binding->config.deadband) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* In LVGL task with LVGL lock, all due widgets are updated in one batch */
+static void sensor_ui_apply(void *arg)
+{
+    sensor_ui_handle_t ui = arg;
+    const int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&ui->lock);
+    ui->async_pending = false;
+    ui->next_batch = now + (int64_t)ui->config.frame_period_ms * 1000;
+    const uint8_t binding_num = ui->binding_num;
+    portEXIT_CRITICAL(&ui->lock);
+
+    for (int i = 0; i < binding_num; i++) {
+        sensor_ui_binding_handle_t binding = &ui->bindings[i];
+        esp_sensor_hub_data_t data;
+        bool update = false;
+
+        portENTER_CRITICAL(&ui->lock);
+        if (binding->dirty && binding->config.enabled && binding->next_update <= now) {
+            data = binding->latest;
+            binding->shown = data;
+            binding->dirty = false;
+            binding->next_update = now + (int64_t)binding->config.min_period_ms * 1000;
+            update = true;
+        }
+        portEXIT_CRITICAL(&ui->lock);
+
+        if (update) {
+            binding->config.update_cb(binding->config.widget, &data, binding->config.user_ctx);
+        }
+    }
+}
+
+static void sensor_ui_process(sensor_ui_handle_t ui, const esp_sensor_hub_data_t *data)
+{
+    portENTER_CRITICAL(&ui->lock);
+    for (int i = 0; i < ui->binding_num; i++) {
+        sensor_ui_binding_handle_t binding = &ui->bindings[i];
+        if (binding->config.sensor_id != data->sensor_id) {
+            continue;
+        }
+        binding->latest = *data;
+        /* Disabled widgets get the latest sample, when they are enabled */
+        if (binding->config.enabled && sensor_ui_changed(binding, data)) {
+            binding->dirty = true;
+        }
+    }
+    portEXIT_CRITICAL(&ui->lock);
+}
+
+/* Schedule updates, when some are due, returns time to the next due update */
+static int sensor_ui_schedule(sensor_ui_handle_t ui)
+{
+    const int64_t now = esp_timer_get_time();
+    int64_t due = INT64_MAX;
+    bool schedule = false;
+
+    portENTER_CRITICAL(&ui->lock);
+    if (!ui->async_pending) {
+        for (int i = 0; i < ui->binding_num; i++) {
+            sensor_ui_binding_handle_t binding = &ui->bindings[i];
+            if (binding->dirty && binding->config.enabled && binding->next_update < due) {
+                due = binding->next_update;
+            }
+        }
+        if (due != INT64_MAX && due < ui->next_batch) {
+            due = ui->next_batch;
+        }
+        if (due <= now) {
+            ui->async_pending = true;
+            schedule = true;
+        }
+    }
+    portEXIT_CRITICAL(&ui->lock);
+
+    if (schedule) {
+        /* The only LVGL lock of this task, once per batch */
+        lvgl_port_lock(0);
+        const bool ok = (lv_async_call(sensor_ui_apply, ui) == LV_RESULT_OK);
+        lvgl_port_unlock();
+        if (!ok) {
+            portENTER_CRITICAL(&ui->lock);
+            ui->async_pending = false;
+            portEXIT_CRITICAL(&ui->lock);
+        }
+    }
+    if (schedule || ui->async_pending) {
+        /* Throttled widgets are checked again after the batch */
+        return (ui->config.frame_period_ms < SENSOR_UI_POLL_MS) ? (int)ui->config.frame_period_ms : SENSOR_UI_POLL_MS;
+    }
+    if (due == INT64_MAX) {
+        return SENSOR_UI_POLL_MS;
+    }
+    const int64_t wait_ms = (due - now + 999) / 1000;
+    return (wait_ms < SENSOR_UI_POLL_MS) ? (int)wait_ms : SENSOR_UI_POLL_MS;
+}
+
+static void sensor_ui_task(void *arg)
+{
+    sensor_ui_handle_t ui = arg;
+    int timeout_ms = SENSOR_UI_POLL_MS;
+
+    while (!ui->stop) {
+        esp_sensor_hub_data_t data;
+        if (esp_sensor_hub_receive(ui->sub, &data, timeout_ms) == ESP_OK) {
+            do {
+                sensor_ui_process(ui, &data);
+            } while (esp_sensor_hub_receive(ui->sub, &data, 0) == ESP_OK);
+        }
+        timeout_ms = sensor_ui_schedule(ui);
+    }
+
+    xSemaphoreGive(ui->stopped);
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+/**
+ * @file
+ * @brief Binding of sensor hub samples to LVGL widgets
+ *
+ * One task reads samples of the bound sensors. A widget is updated only when a value changed more than deadband
+ * and at most once per min_period_ms. All due updates are applied together in one lv_async_call() in LVGL task,
+ * so the LVGL lock is taken at most once per frame_period_ms and never by the sensor tasks.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+#include "esp_sensor_hub.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sensor_ui_s *sensor_ui_handle_t;
+typedef struct sensor_ui_binding_s *sensor_ui_binding_handle_t;
+
+/**
+ * @brief Update of widget, called in LVGL task with LVGL lock
+ */
+typedef void (*sensor_ui_update_cb_t)(lv_obj_t *widget, const esp_sensor_hub_data_t *data, void *user_ctx);
+
+typedef struct {
+    esp_sensor_hub_handle_t hub;    /*!< Sensor hub (stopped, it is subscribed) */
+    uint32_t sensor_mask;           /*!< Sensors, which can be bound */
+    size_t   queue_len;             /*!< Count of samples buffered by the subscriber */
+    uint8_t  max_bindings;          /*!< Maximal count of bindings */
+    uint32_t frame_period_ms;       /*!< Minimal time between two batches of updates (0: LV_DEF_REFR_PERIOD) */
+    uint32_t task_priority;         /*!< Priority of the binding task */
+    uint32_t task_stack;            /*!< Stack of the binding task */
+} sensor_ui_config_t;
+
+typedef struct {
+    uint8_t  sensor_id;             /*!< Sensor ID from esp_sensor_hub_add_sensor() */
+    lv_obj_t *widget;               /*!< Updated widget */
+    float    deadband;              /*!< Widget is updated, when any value changed more than this since the last update */
+    uint32_t min_period_ms;         /*!< Minimal time between two updates of the widget */
+    sensor_ui_update_cb_t update_cb;/*!< Update of the widget */
+    void     *user_ctx;             /*!< Passed to update_cb */
+    bool     enabled;               /*!< Disabled (e.g. hidden) widgets are not updated */
+} sensor_ui_binding_config_t;
+
+/**
+ * @brief Subscribe to sensor hub and start the binding task
+ *
+ * @param[in]  config   configuration
+ * @param[out] ret_ui   handle
+ * @return ESP_OK on success, otherwise error from esp_sensor_hub_subscribe() or ESP_ERR_NO_MEM
+ */
+esp_err_t sensor_ui_new(const sensor_ui_config_t *config, sensor_ui_handle_t *ret_ui);
+
+/**
+ * @brief Stop the binding task and delete all bindings
+ *
+ * @note It must not be called with LVGL lock.
+ *
+ * @param ui    handle
+ * @return ESP_OK on success
+ */
+esp_err_t sensor_ui_del(sensor_ui_handle_t ui);
+
+/**
+ * @brief Bind sensor to widget
+ *
+ * @param[in]  ui           handle
+ * @param[in]  config       binding configuration
+ * @param[out] ret_binding  binding handle
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if argument is NULL or sensor is not in sensor_mask
+ *      - ESP_ERR_NO_MEM        if max_bindings were added
+ */
+esp_err_t sensor_ui_bind(sensor_ui_handle_t ui, const sensor_ui_binding_config_t *config, sensor_ui_binding_handle_t *ret_binding);
+
+/**
+ * @brief Enable or disable updates of widget (e.g. when it is shown or hidden)
+ *
+ * Enabled widget is updated right away by the last sample.
+ *
+ * @note It must be called with LVGL lock.
+ *
+ * @param binding   binding handle
+ * @param enabled   enable updates
+ */
+void sensor_ui_set_enabled(sensor_ui_binding_handle_t binding, bool enabled);
+
+#ifdef __cplusplus
+}
+#endif
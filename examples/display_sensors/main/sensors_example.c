@@ -14,7 +14,10 @@
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "sdmmc_cmd.h" // for sdmmc_card_print_info
-#include "esp_idf_version.h" // for backward compatibility of esp-timer
+#include "esp_check.h"
+#include "esp_bit_defs.h"
+#include "esp_sensor_hub.h"
+#include "sensor_ui.h"
 
 // Enable SD card test
 #define EXAMPLE_TEST_SD_CARD 0
@@ -32,13 +35,34 @@ static mpu6050_handle_t mpu6050_dev = NULL;
 static fbm320_handle_t fbm320_dev = NULL;
 static mag3110_handle_t mag3110_dev = NULL;
 
-static QueueHandle_t q_page_num;
-static uint8_t g_page_num = 0;
+static esp_sensor_hub_handle_t hub = NULL;
+static sensor_ui_handle_t sensor_ui = NULL;
 
+/* Last IMU results, written and read only by the sensor hub task */
 static mpu6050_acce_value_t acce;
 static mpu6050_gyro_value_t gyro;
 static complimentary_angle_t complimentary_angle;
 
+/* Pages of the display, one is shown */
+#define PAGE_BINDINGS_MAX   (2)
+typedef struct {
+    lv_obj_t *cont;
+    sensor_ui_binding_handle_t bindings[PAGE_BINDINGS_MAX];
+    uint8_t binding_num;
+} page_t;
+
+#define PAGE_NUM        (7)
+#define PAGE_CHART      (6)     /* Plot of accelerometer, fed by its own subscriber */
+static page_t pages[PAGE_NUM];
+static uint8_t g_page_num = 0;
+static esp_timer_handle_t beep_timer = NULL;
+
+/* Accelerometer plot at 100 Hz, only the column of each new point is drawn */
+#define CHART_HEIGHT    (32)
+#define CHART_RANGE_MG  (2000)
+static lvgl_port_chart_handle_t acce_chart = NULL;
+static esp_sensor_hub_sub_handle_t chart_sub = NULL;
+
 static void display_show_signs(void)
 {
     bsp_display_lock(0);
@@ -87,134 +111,265 @@ static void app_mag3110_init()
     mag3110_dev = mag3110_create(BSP_I2C_NUM);
 }
 
-static void display_show_env_data(void)
+/* Sensors for sensor hub, the hub reads all of them in one task */
+static esp_err_t hts221_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
 {
-    int16_t temp;
-    int16_t humi;
-    float lumi;
+    int16_t temp, humi;
+    ESP_RETURN_ON_ERROR(hts221_get_temperature(hts221_dev, &temp), TAG, "hts221 read error");
+    ESP_RETURN_ON_ERROR(hts221_get_humidity(hts221_dev, &humi), TAG, "hts221 read error");
+    data->value_num = 2;
+    data->values[0] = (float)temp / 10;
+    data->values[1] = (float)humi / 10;
+    return ESP_OK;
+}
 
-    hts221_get_temperature(hts221_dev, &temp);
-    hts221_get_humidity(hts221_dev, &humi);
-    bh1750_get_data(bh1750_dev, &lumi);
-    ESP_LOGI(TAG, "temperature: %.1f, humidity: %.1f, luminance: %.1f", (float)temp / 10, (float)humi / 10, lumi);
+static esp_err_t bh1750_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
+{
+    data->value_num = 1;
+    return bh1750_get_data(bh1750_dev, &data->values[0]);
+}
 
-    bsp_display_lock(0);
-    lv_label_set_text_fmt(main_label, "Temp: %.1f\nHumi: %.1f\nLumi: %.1f", (float)temp / 10, (float)humi / 10, lumi);
-    lv_obj_set_style_text_align(main_label, LV_TEXT_ALIGN_LEFT, 0);
-    bsp_display_unlock();
+static esp_err_t fbm320_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
+{
+    int32_t real_p, real_t;
+    ESP_RETURN_ON_ERROR(fbm320_get_data(fbm320_dev, FBM320_MEAS_PRESS_OSR_1024, &real_t, &real_p), TAG, "fbm320 read error");
+    data->value_num = 2;
+    data->values[0] = (float)real_p / 1000;
+    data->values[1] = (float)real_t / 100;
+    return ESP_OK;
 }
 
-static void display_show_acce_data(void)
+static esp_err_t mag3110_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
 {
-    ESP_LOGI(TAG, "acce_x:%.2f, acce_y:%.2f, acce_z:%.2f", acce.acce_x, acce.acce_y, acce.acce_z);
+    mag3110_result_t mag_induction;
+    ESP_RETURN_ON_ERROR(mag3110_get_magnetic_induction(mag3110_dev, &mag_induction), TAG, "mag3110 read error");
+    data->value_num = 3;
+    data->values[0] = mag_induction.x;
+    data->values[1] = mag_induction.y;
+    data->values[2] = mag_induction.z;
+    return ESP_OK;
+}
 
-    bsp_display_lock(0);
-    lv_label_set_text_fmt(main_label, "Acce_x: %.2f\nAcce_y: %.2f\nAcce_z: %.2f", acce.acce_x, acce.acce_y, acce.acce_z);
-    lv_obj_set_style_text_align(main_label, LV_TEXT_ALIGN_LEFT, 0);
-    bsp_display_unlock();
+// In order to get accurate calculation of complimentary angle we need fast reading (5ms)
+static esp_err_t mpu6050_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
+{
+    ESP_RETURN_ON_ERROR(mpu6050_get_acce(mpu6050_dev, &acce), TAG, "mpu6050 read error");
+    ESP_RETURN_ON_ERROR(mpu6050_get_gyro(mpu6050_dev, &gyro), TAG, "mpu6050 read error");
+    mpu6050_complimentory_filter(mpu6050_dev, &acce, &gyro, &complimentary_angle);
+    data->value_num = 0;
+    return ESP_OK;
 }
 
-static void display_show_gyro_data(void)
+/* Slower copies of the last IMU results for the display, without bus access */
+static esp_err_t acce_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
 {
-    ESP_LOGI(TAG, "gyro_x:%.2f, gyro_y:%.2f, gyro_z:%.2f", gyro.gyro_x, gyro.gyro_y, gyro.gyro_z);
+    data->value_num = 3;
+    data->values[0] = acce.acce_x;
+    data->values[1] = acce.acce_y;
+    data->values[2] = acce.acce_z;
+    return ESP_OK;
+}
 
-    bsp_display_lock(0);
-    lv_label_set_text_fmt(main_label, "Gyro_x: %.2f\nGyro_y: %.2f\nGyro_z: %.2f", gyro.gyro_x, gyro.gyro_y, gyro.gyro_z);
-    lv_obj_set_style_text_align(main_label, LV_TEXT_ALIGN_LEFT, 0);
-    bsp_display_unlock();
+static esp_err_t gyro_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
+{
+    data->value_num = 3;
+    data->values[0] = gyro.gyro_x;
+    data->values[1] = gyro.gyro_y;
+    data->values[2] = gyro.gyro_z;
+    return ESP_OK;
 }
 
-static void display_show_complimentary_angle(void)
+static esp_err_t angle_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
 {
-    ESP_LOGI(TAG, "roll:%.2f, pitch:%.2f", complimentary_angle.roll, complimentary_angle.pitch);
+    data->value_num = 2;
+    data->values[0] = complimentary_angle.roll;
+    data->values[1] = complimentary_angle.pitch;
+    return ESP_OK;
+}
 
-    bsp_display_lock(0);
-    lv_label_set_text_fmt(main_label, "Roll: %.2f\nPitch: %.2f", complimentary_angle.roll, complimentary_angle.pitch);
-    lv_obj_set_style_text_align(main_label, LV_TEXT_ALIGN_LEFT, 0);
-    bsp_display_unlock();
+/* Widget updates, called in LVGL task only when the shown values changed */
+static void label_update(lv_obj_t *widget, const esp_sensor_hub_data_t *data, void *user_ctx)
+{
+    lv_label_set_text_fmt(widget, (const char *)user_ctx, data->values[0], data->values[1], data->values[2]);
 }
 
-static void display_show_barometer_data(void)
+static float luminance = 0;
+
+static void lumi_update(lv_obj_t *widget, const esp_sensor_hub_data_t *data, void *user_ctx)
 {
-    int32_t real_p, real_t;
-    float pressure, temperature;
+    luminance = data->values[0];
+    label_update(widget, data, user_ctx);
+}
 
-    if (ESP_OK == fbm320_get_data(fbm320_dev, FBM320_MEAS_PRESS_OSR_1024, &real_t, &real_p)) {
-        pressure = (float)real_p / 1000;
-        temperature = (float)real_t / 100;
-        ESP_LOGI(TAG, "pressure: %.1f, temperature: %.1f", pressure, temperature);
+static void env_update(lv_obj_t *widget, const esp_sensor_hub_data_t *data, void *user_ctx)
+{
+    ESP_LOGI(TAG, "temperature: %.1f, humidity: %.1f, luminance: %.1f", data->values[0], data->values[1], luminance);
+    label_update(widget, data, user_ctx);
+}
 
-        bsp_display_lock(0);
-        lv_label_set_text_fmt(main_label, "Press: %.1f\nTemp: %.1f", pressure, temperature);
-        lv_obj_set_style_text_align(main_label, LV_TEXT_ALIGN_LEFT, 0);
-        bsp_display_unlock();
+typedef struct {
+    const char *name;
+    uint32_t period_ms;
+    esp_sensor_hub_sensor_ops_t ops;
+    uint8_t page;           /* Page of the label (PAGE_NUM: not shown) */
+    const char *fmt;        /* Label format of the values */
+    float deadband;         /* Label is updated, when a value changes more */
+    uint32_t min_period_ms; /* Label is not updated more often */
+    sensor_ui_update_cb_t update_cb;
+} app_sensor_t;
+
+static const app_sensor_t app_sensors[] = {
+    {"hts221",  1000, {.read = hts221_read},  0, "Temp: %.1f\nHumi: %.1f", 0.05f, 0, env_update},
+    {"bh1750",  1000, {.read = bh1750_read},  0, "Lumi: %.1f", 0.05f, 0, lumi_update},
+    {"acce",    100,  {.read = acce_read},    1, "Acce_x: %.2f\nAcce_y: %.2f\nAcce_z: %.2f", 0.005f, 200, label_update},
+    {"gyro",    100,  {.read = gyro_read},    2, "Gyro_x: %.2f\nGyro_y: %.2f\nGyro_z: %.2f", 0.005f, 200, label_update},
+    {"angle",   100,  {.read = angle_read},   3, "Roll: %.2f\nPitch: %.2f", 0.005f, 200, label_update},
+    {"fbm320",  1000, {.read = fbm320_read},  4, "Press: %.1f\nTemp: %.1f", 0.05f, 0, label_update},
+    {"mag3110", 100,  {.read = mag3110_read}, 5, "Mag_x: %5.0f\nMag_y: %5.0f\nMag_z: %5.0f", 0.5f, 200, label_update},
+    {"mpu6050", 5,    {.read = mpu6050_read}, PAGE_NUM},
+    {"acce_plot", 10, {.read = acce_read},    PAGE_NUM},
+};
+/* Index of the plotted sensor in app_sensors */
+#define APP_SENSOR_ACCE_PLOT    (8)
+
+static void chart_task(void *arg)
+{
+    while (1) {
+        esp_sensor_hub_data_t data;
+        if (esp_sensor_hub_receive(chart_sub, &data, -1) != ESP_OK || g_page_num != PAGE_CHART) {
+            continue;
+        }
+        const int32_t acce_mg[3] = {
+            (int32_t)(data.values[0] * 1000), (int32_t)(data.values[1] * 1000), (int32_t)(data.values[2] * 1000)
+        };
+        lvgl_port_chart_add_point(acce_chart, acce_mg);
     }
 }
 
-static void display_show_magmeter_data(void)
+/* Chart is filled regardless of the rate of the display, the display draws all new points in one refresh */
+static void app_chart_init(uint8_t sensor_id)
 {
-    mag3110_result_t mag_induction;
-
-    mag3110_get_magnetic_induction(mag3110_dev, &mag_induction);
-    ESP_LOGI(TAG, "mag_x:%i, mag_y:%i, mag_z:%i", mag_induction.x, mag_induction.y, mag_induction.z);
+    ESP_ERROR_CHECK(esp_sensor_hub_subscribe(hub, BIT(sensor_id), 16, &chart_sub));
 
     bsp_display_lock(0);
-    lv_label_set_text_fmt(main_label, "Mag_x: %5i\nMag_y: %5i\nMag_z: %5i", mag_induction.x, mag_induction.y, mag_induction.z);
-    lv_obj_set_style_text_align(main_label, LV_TEXT_ALIGN_LEFT, 0);
+    lv_obj_t *label = lv_label_create(pages[PAGE_CHART].cont);
+    lv_label_set_text_static(label, "Acce +-2g");
+    const lvgl_port_chart_cfg_t chart_cfg = {
+        .parent = pages[PAGE_CHART].cont,
+        .mode = LVGL_PORT_CHART_MODE_SWEEP,
+        .point_num = lv_display_get_physical_horizontal_resolution(disp),
+        .height = CHART_HEIGHT,
+        .min = -CHART_RANGE_MG,
+        .max = CHART_RANGE_MG,
+        .series_num = 3,
+        .series_color = {lv_color_white(), lv_color_white(), lv_color_white()},
+        .bg_color = lv_color_black(),
+    };
+    ESP_ERROR_CHECK(lvgl_port_chart_create(&chart_cfg, &acce_chart));
     bsp_display_unlock();
+
+    BaseType_t res = xTaskCreate(chart_task, "chart", 3072, NULL, 4, NULL);
+    assert(res == pdPASS);
 }
 
-static void display_show_task(void *pvParameters)
+static void app_sensor_hub_init(void)
 {
-    uint8_t page_num = 0;
-    while (1) {
-        bsp_led_set(BSP_LED_AZURE, false);
-        bsp_buzzer_set(false);
-
-        if (xQueueReceive(q_page_num, &page_num, 1000 / portTICK_PERIOD_MS) == pdTRUE) {
-            // Turn on LED and Buzzer when button is pressed
-            bsp_led_set(BSP_LED_AZURE, true);
-            bsp_buzzer_set(true);
+    const esp_sensor_hub_config_t hub_cfg = ESP_SENSOR_HUB_DEFAULT_CONFIG();
+    ESP_ERROR_CHECK(esp_sensor_hub_new(&hub_cfg, &hub));
+
+    uint8_t ids[sizeof(app_sensors) / sizeof(app_sensors[0])];
+    uint32_t ui_mask = 0;
+    for (int i = 0; i < sizeof(app_sensors) / sizeof(app_sensors[0]); i++) {
+        const esp_sensor_hub_sensor_config_t sensor_cfg = {
+            .name = app_sensors[i].name,
+            .period_ms = app_sensors[i].period_ms,
+            .ops = &app_sensors[i].ops,
+        };
+        ESP_ERROR_CHECK(esp_sensor_hub_add_sensor(hub, &sensor_cfg, &ids[i]));
+        if (app_sensors[i].page < PAGE_NUM) {
+            ui_mask |= BIT(ids[i]);
         }
+    }
+
+    const sensor_ui_config_t ui_cfg = {
+        .hub = hub,
+        .sensor_mask = ui_mask,
+        .queue_len = 16,
+        .max_bindings = PAGE_NUM * PAGE_BINDINGS_MAX,
+        .task_priority = 4,
+        .task_stack = 3072,
+    };
+    ESP_ERROR_CHECK(sensor_ui_new(&ui_cfg, &sensor_ui));
 
-        switch (page_num) {
-        case 0:
-            display_show_env_data();
-            break;
-        case 1:
-            display_show_acce_data();
-            break;
-        case 2:
-            display_show_gyro_data();
-            break;
-        case 3:
-            display_show_complimentary_angle();
-            break;
-        case 4:
-            display_show_barometer_data();
-            break;
-        case 5:
-            display_show_magmeter_data();
-            break;
-        default:
-            break;
+    /* One container with labels per page, only the first one is shown and updated */
+    bsp_display_lock(0);
+    for (int p = 0; p < PAGE_NUM; p++) {
+        pages[p].cont = lv_obj_create(main_screen);
+        lv_obj_remove_style_all(pages[p].cont);
+        lv_obj_set_size(pages[p].cont, lv_display_get_physical_horizontal_resolution(disp), LV_SIZE_CONTENT);
+        lv_obj_align(pages[p].cont, LV_ALIGN_TOP_MID, 0, 15);
+        lv_obj_set_flex_flow(pages[p].cont, LV_FLEX_FLOW_COLUMN);
+        if (p != g_page_num) {
+            lv_obj_add_flag(pages[p].cont, LV_OBJ_FLAG_HIDDEN);
         }
     }
+    for (int i = 0; i < sizeof(app_sensors) / sizeof(app_sensors[0]); i++) {
+        if (app_sensors[i].page >= PAGE_NUM) {
+            continue;
+        }
+        page_t *page = &pages[app_sensors[i].page];
+        assert(page->binding_num < PAGE_BINDINGS_MAX);
+        lv_obj_t *label = lv_label_create(page->cont);
+        lv_label_set_text_static(label, "");
+        const sensor_ui_binding_config_t bind_cfg = {
+            .sensor_id = ids[i],
+            .widget = label,
+            .deadband = app_sensors[i].deadband,
+            .min_period_ms = app_sensors[i].min_period_ms,
+            .update_cb = app_sensors[i].update_cb,
+            .user_ctx = (void *)app_sensors[i].fmt,
+            .enabled = (app_sensors[i].page == g_page_num),
+        };
+        ESP_ERROR_CHECK(sensor_ui_bind(sensor_ui, &bind_cfg, &page->bindings[page->binding_num++]));
+    }
+    bsp_display_unlock();
+
+    app_chart_init(ids[APP_SENSOR_ACCE_PLOT]);
+}
+
+static void page_show(uint8_t page_num, bool show)
+{
+    if (show) {
+        lv_obj_remove_flag(pages[page_num].cont, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(pages[page_num].cont, LV_OBJ_FLAG_HIDDEN);
+    }
+    for (int i = 0; i < pages[page_num].binding_num; i++) {
+        sensor_ui_set_enabled(pages[page_num].bindings[i], show);
+    }
 }
 
-static void mpu6050_read(void *pvParameters)
+static void beep_off(void *arg)
 {
-    mpu6050_get_acce(mpu6050_dev, &acce);
-    mpu6050_get_gyro(mpu6050_dev, &gyro);
-    mpu6050_complimentory_filter(mpu6050_dev, &acce, &gyro, &complimentary_angle);
+    bsp_led_set(BSP_LED_AZURE, false);
+    bsp_buzzer_set(false);
 }
 
 static void btn_handler(void *button_handle, void *usr_data)
 {
-    if (++g_page_num >= 6) {
+    bsp_display_lock(0);
+    page_show(g_page_num, false);
+    if (++g_page_num >= PAGE_NUM) {
         g_page_num = 0;
     }
-    xQueueSend(q_page_num, &g_page_num, 0);
+    page_show(g_page_num, true);
+    bsp_display_unlock();
+
+    // Turn on LED and Buzzer when button is pressed
+    bsp_led_set(BSP_LED_AZURE, true);
+    bsp_buzzer_set(true);
+    esp_timer_stop(beep_timer);
+    esp_timer_start_once(beep_timer, 200 * 1000);
 }
 
 void app_main(void)
@@ -263,24 +418,20 @@ void app_main(void)
     bsp_display_unlock();
     mag3110_start(mag3110_dev, MAG3110_DR_OS_10_128); // Magnetometer is stopped after calibration; it must be started here
 
-    // Create FreeRTOS tasks and queues
-    q_page_num = xQueueCreate(10, sizeof(uint8_t));
-    xTaskCreate(display_show_task, "display_show_task", 2048 * 2, NULL, 5, NULL);
-
-    // In order to get accurate calculation of complimentary angle we need fast reading (5ms)
-    // FreeRTOS resolution is 10ms, so esp_timer is used
-    const esp_timer_create_args_t cal_timer_config = {
-        .callback = mpu6050_read,
-        .arg = NULL,
-        .name = "MPU6050 timer",
-#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 3, 0)
-        .skip_unhandled_events = true,
-#endif
-        .dispatch_method = ESP_TIMER_TASK
+    bsp_display_lock(0);
+    lv_obj_add_flag(main_label, LV_OBJ_FLAG_HIDDEN);
+    bsp_display_unlock();
+
+    // All sensors are sampled by sensor hub, labels are updated only on change
+    // MPU6050 is sampled every 5 ms (CONFIG_FREERTOS_HZ=1000) for accurate complimentary angle
+    app_sensor_hub_init();
+    ESP_ERROR_CHECK(esp_sensor_hub_start(hub));
+
+    const esp_timer_create_args_t beep_timer_config = {
+        .callback = beep_off,
+        .name = "beep",
     };
-    esp_timer_handle_t cal_timer = NULL;
-    esp_timer_create(&cal_timer_config, &cal_timer);
-    esp_timer_start_periodic(cal_timer, 5000); // 5ms
+    ESP_ERROR_CHECK(esp_timer_create(&beep_timer_config, &beep_timer));
 
     /* Init buttons */
     button_handle_t btns[BSP_BUTTON_NUM];
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: CC0-1.0
  */
@@ -11,6 +11,8 @@
 #include "bh1750.h"
 #include "bsp/esp-bsp.h"
 #include "esp_log.h"
+#include "esp_check.h"
+#include "esp_timer.h"
 
 #include "esp_wifi.h"
 #include "esp_system.h"
@@ -18,22 +20,19 @@
 #include "esp_event.h"
 #include "esp_netif.h"
 #include "mqtt_client.h"
+#include "esp_sensor_hub.h"
+#include "esp_sensor_telemetry.h"
 
 void wifi_init_sta(void);
 
 static const char *TAG = "Azure";
 
-static bool mqtt_connected = false;
 static bh1750_handle_t bh1750_dev = NULL;
 static hts221_handle_t hts221_dev = NULL;
 static fbm320_handle_t fbm320_dev = NULL;
 
-typedef struct {
-    int16_t temperature;
-    int16_t humidity;
-    float luminescence;
-    int32_t pressure;
-} sensor_data_t;
+/* Sensor IDs in the hub (sensor_id in telemetry frames) */
+static uint8_t hts221_id, bh1750_id, fbm320_id;
 
 static void app_sensors_init()
 {
@@ -54,13 +53,53 @@ static void app_sensors_init()
     ESP_ERROR_CHECK(fbm320_init(fbm320_dev));
 }
 
-static void app_sensors_get(sensor_data_t *data)
+/* HTS221 and BH1750 measure continuously, the hub only reads the last results */
+static esp_err_t hts221_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
 {
-    int32_t temp;
-    hts221_get_humidity(hts221_dev, &data->humidity);
-    hts221_get_temperature(hts221_dev, &data->temperature);
-    bh1750_get_data(bh1750_dev, &data->luminescence);
-    fbm320_get_data(fbm320_dev, FBM320_MEAS_PRESS_OSR_2048, &temp, &data->pressure);
+    int16_t temperature, humidity;
+    ESP_RETURN_ON_ERROR(hts221_get_temperature((hts221_handle_t)ctx, &temperature), TAG, "hts221 read error");
+    ESP_RETURN_ON_ERROR(hts221_get_humidity((hts221_handle_t)ctx, &humidity), TAG, "hts221 read error");
+    data->value_num = 2;
+    data->values[0] = temperature / 10.0f; // In degree Celsius
+    data->values[1] = humidity / 10.0f; // In percent
+    return ESP_OK;
+}
+
+static esp_err_t bh1750_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
+{
+    data->value_num = 1;
+    return bh1750_get_data((bh1750_handle_t)ctx, &data->values[0]); // In lux
+}
+
+static esp_err_t fbm320_read(void *ctx, esp_sensor_hub_data_t *data, uint32_t *wait_us)
+{
+    int32_t temperature, pressure;
+    ESP_RETURN_ON_ERROR(fbm320_get_data((fbm320_handle_t)ctx, FBM320_MEAS_PRESS_OSR_2048, &temperature, &pressure), TAG, "fbm320 read error");
+    data->value_num = 1;
+    data->values[0] = pressure / 1000.0f; // In kPa
+    return ESP_OK;
+}
+
+static const esp_sensor_hub_sensor_ops_t hts221_ops = {.read = hts221_read};
+static const esp_sensor_hub_sensor_ops_t bh1750_ops = {.read = bh1750_read};
+static const esp_sensor_hub_sensor_ops_t fbm320_ops = {.read = fbm320_read};
+
+static esp_sensor_hub_handle_t app_sensor_hub_init(void)
+{
+    esp_sensor_hub_handle_t hub = NULL;
+    const esp_sensor_hub_config_t hub_cfg = ESP_SENSOR_HUB_DEFAULT_CONFIG();
+    ESP_ERROR_CHECK(esp_sensor_hub_new(&hub_cfg, &hub));
+
+    const esp_sensor_hub_sensor_config_t sensors[] = {
+        {.name = "hts221", .period_ms = CONFIG_SENSOR_PERIOD_MS, .ops = &hts221_ops, .user_ctx = hts221_dev},
+        {.name = "bh1750", .period_ms = CONFIG_SENSOR_PERIOD_MS, .ops = &bh1750_ops, .user_ctx = bh1750_dev},
+        {.name = "fbm320", .period_ms = CONFIG_SENSOR_PERIOD_MS, .ops = &fbm320_ops, .user_ctx = fbm320_dev},
+    };
+    uint8_t *ids[] = {&hts221_id, &bh1750_id, &fbm320_id};
+    for (int i = 0; i < sizeof(sensors) / sizeof(sensors[0]); i++) {
+        ESP_ERROR_CHECK(esp_sensor_hub_add_sensor(hub, &sensors[i], ids[i]));
+    }
+    return hub;
 }
 
 /**
@@ -81,13 +120,11 @@ static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_
     switch ((esp_mqtt_event_id_t)event_id) {
     case MQTT_EVENT_CONNECTED:
         ESP_LOGI(TAG, "MQTT_EVENT_CONNECTED");
-        mqtt_connected = true;
         bsp_led_set(BSP_LED_AZURE, true);
         break;
 
     case MQTT_EVENT_DISCONNECTED:
         ESP_LOGI(TAG, "MQTT_EVENT_DISCONNECTED");
-        mqtt_connected = false;
         bsp_led_set(BSP_LED_AZURE, false);
         break;
 
@@ -126,8 +163,20 @@ void app_main(void)
 {
     ESP_ERROR_CHECK(bsp_i2c_init());
     ESP_ERROR_CHECK(bsp_leds_init());
-    lv_disp_t *disp = bsp_display_start();
+    bsp_display_cfg_t disp_cfg = {
+        .lvgl_port_cfg = ESP_LVGL_PORT_INIT_CONFIG(),
+#if CONFIG_EXAMPLE_DISPLAY_TASK_PROFILE_COEX
+        .task_profile = BSP_DISPLAY_TASK_PROFILE_COEX,
+#endif
+        .buffer_size = BSP_LCD_DRAW_BUFF_SIZE,
+        .double_buffer = BSP_LCD_DRAW_BUFF_DOUBLE,
+        .flags = {
+            .buff_dma = true,
+        }
+    };
+    lv_disp_t *disp = bsp_display_start_with_config(&disp_cfg);
     app_sensors_init();
+    esp_sensor_hub_handle_t hub = app_sensor_hub_init();
     ESP_ERROR_CHECK(nvs_flash_init());
 
     /* Write labels on display */
@@ -143,16 +192,27 @@ void app_main(void)
     wifi_init_sta();
 
     const esp_mqtt_client_config_t mqtt_cfg = {
-#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
-        .uri = CONFIG_BROKER_URL,
-#else
         .broker.address.uri = CONFIG_BROKER_URL,
-#endif
     };
 
     esp_mqtt_client_handle_t client = esp_mqtt_client_init(&mqtt_cfg);
     /* The last argument may be used to pass data to the event handler, in this example mqtt_event_handler */
     esp_mqtt_client_register_event(client, ESP_EVENT_ANY_ID, mqtt_event_handler, NULL);
+
+    /* All samples are batched to CBOR frames, one MQTT message per frame instead of one per value */
+    esp_sensor_telemetry_config_t tel_cfg = ESP_SENSOR_TELEMETRY_DEFAULT_CONFIG();
+    tel_cfg.hub = hub;
+    tel_cfg.sensor_mask = BIT(hts221_id) | BIT(bh1750_id) | BIT(fbm320_id);
+    tel_cfg.client = client;
+    tel_cfg.topic = CONFIG_TELEMETRY_TOPIC;
+    tel_cfg.max_delay_ms = CONFIG_TELEMETRY_MAX_DELAY_MS;
+    esp_sensor_telemetry_handle_t telemetry = NULL;
+    ESP_ERROR_CHECK(esp_sensor_telemetry_new(&tel_cfg, &telemetry));
+
+    /* Display gets the same samples by its own subscriber */
+    esp_sensor_hub_sub_handle_t display_sub = NULL;
+    ESP_ERROR_CHECK(esp_sensor_hub_subscribe(hub, tel_cfg.sensor_mask, 8, &display_sub));
+    ESP_ERROR_CHECK(esp_sensor_hub_start(hub));
     esp_mqtt_client_start(client);
 
     /* Write labels on display */
@@ -161,29 +221,37 @@ void app_main(void)
     lv_obj_set_style_text_align(main_label, LV_TEXT_ALIGN_LEFT, 0);
     bsp_display_unlock();
 
+    float temperature = 0, humidity = 0, luminescence = 0, pressure = 0;
+    int64_t stats_time = esp_timer_get_time();
     while (1) {
-        sensor_data_t sensor_data;
-        app_sensors_get(&sensor_data);
-
-        /* Strings to be sent to MQTT and display */
-        char t[10], h[10], l[10], p[10];
-        sprintf(t, "%4.2f", ((float)sensor_data.temperature) / 10); // In degree Celsius
-        sprintf(h, "%4.2f", ((float)sensor_data.humidity) / 10); // In percent
-        sprintf(l, "%4.2f", ((float)sensor_data.luminescence)); // In lux
-        sprintf(p, "%4.2f", ((float)sensor_data.pressure) / 1000); // in kPa
-
-        /* Publish sensor data, if connected */
-        if (mqtt_connected) {
-            esp_mqtt_client_publish(client, "esp-azure/temperature", t, 0, 1, 0);
-            esp_mqtt_client_publish(client, "esp-azure/humidity", h, 0, 1, 0);
-            esp_mqtt_client_publish(client, "esp-azure/luminescence", l, 0, 1, 0);
-            esp_mqtt_client_publish(client, "esp-azure/pressure", p, 0, 1, 0);
+        esp_sensor_hub_data_t data;
+        if (esp_sensor_hub_receive(display_sub, &data, 1000) == ESP_OK) {
+            if (data.sensor_id == hts221_id) {
+                temperature = data.values[0];
+                humidity = data.values[1];
+            } else if (data.sensor_id == bh1750_id) {
+                luminescence = data.values[0];
+            } else if (data.sensor_id == fbm320_id) {
+                pressure = data.values[0];
+            }
+            bsp_display_lock(0);
+            lv_label_set_text_fmt(main_label, "Temp: %4.2f\nHumi: %4.2f\nLumi: %4.2f\nPress: %4.2f", temperature, humidity, luminescence, pressure);
+            bsp_display_unlock();
         }
 
-        bsp_display_lock(0);
-        lv_label_set_text_fmt(main_label, "Temp: %s\nHumi: %s\nLumi: %s\nPress: %s", t, h, l, p);
-        bsp_display_unlock();
-
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        if (esp_timer_get_time() - stats_time >= 10 * 1000 * 1000) {
+            esp_sensor_telemetry_stats_t stats;
+            esp_sensor_telemetry_get_stats(telemetry, &stats, true);
+            ESP_LOGI(TAG, "Telemetry: %"PRIu32" samples in %"PRIu32" frames (%"PRIu32" B), dropped %"PRIu32", backpressure %"PRIu32", pending %d",
+                     stats.samples, stats.frames, stats.bytes, stats.samples_dropped, stats.backpressure, stats.frames_pending);
+#if CONFIG_LVGL_PORT_ENABLE_STATS
+            /* Longest flush shows the frames delayed by network traffic */
+            lvgl_port_disp_stats_t disp_stats;
+            if (lvgl_port_get_disp_stats(disp, &disp_stats) == ESP_OK) {
+                ESP_LOGI(TAG, "Display: %"PRIu32" frames, max flush %"PRIu32" us", disp_stats.window.frames, disp_stats.window.max_flush_us);
+            }
+#endif
+            stats_time = esp_timer_get_time();
+        }
     }
 }
@@ -0,0 +1,179 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_lcd_panel_ops.h"
+#include "esp_lcd_panel_io.h"
+
+#include "bsp/esp-bsp.h"
+#include "bus_benchmark.h"
+
+static const char *TAG = "bus_bench";
+
+#define BENCH_BYTES_PER_PIXEL   ((BSP_LCD_BITS_PER_PIXEL + 7) / 8)
+#define BENCH_FRAME_SIZE        (BSP_LCD_H_RES * BSP_LCD_V_RES * BENCH_BYTES_PER_PIXEL)
+// Panel IO queue is created for the deepest case, shallower cases limit the transfers in flight themselves
+#define BENCH_MAX_DEPTH         (8)
+// Number of vertical stripes of one band in the striped pattern (each stripe is one draw call)
+#define BENCH_STRIPES           (8)
+
+typedef struct {
+    const char *name;
+    uint32_t caps;
+} bench_mem_t;
+
+static const bench_mem_t bench_mems[] = {
+    {"SRAM",  MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL},
+#if CONFIG_SPIRAM
+    {"PSRAM", MALLOC_CAP_SPIRAM},
+#endif
+};
+
+// Lines of one draw call, the last one is a full frame in one transfer
+static const int bench_lines[] = {BSP_LCD_V_RES / 10, BSP_LCD_V_RES / 4, BSP_LCD_V_RES / 2, BSP_LCD_V_RES};
+static const int bench_depths[] = {1, 2, 4, BENCH_MAX_DEPTH};
+
+// Transfers in flight, given back when the color data was sent
+static SemaphoreHandle_t bench_slots;
+
+static bool bench_trans_done(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+    BaseType_t need_yield = pdFALSE;
+    xSemaphoreGiveFromISR(bench_slots, &need_yield);
+    return (need_yield == pdTRUE);
+}
+
+static esp_err_t bench_draw(esp_lcd_panel_handle_t panel, int x1, int y1, int x2, int y2, const void *data)
+{
+    xSemaphoreTake(bench_slots, portMAX_DELAY);
+    esp_err_t ret = esp_lcd_panel_draw_bitmap(panel, x1, y1, x2, y2, data);
+    if (ret != ESP_OK) {
+        xSemaphoreGive(bench_slots);
+    }
+    return ret;
+}
+
+// Send frames for CONFIG_NOGLIB_BENCH_CASE_MS, returns sent bytes, frames and the measured time
+static esp_err_t bench_case(esp_lcd_panel_handle_t panel, const void *buf, int lines, int depth, bool striped,
+                            uint64_t *bytes, uint32_t *frames, int64_t *time_us)
+{
+    esp_err_t ret = ESP_OK;
+    const int stripe_w = striped ? (BSP_LCD_H_RES / BENCH_STRIPES) : BSP_LCD_H_RES;
+    // Slots above the depth of this case are taken for the whole case
+    for (int i = depth; i < BENCH_MAX_DEPTH; i++) {
+        xSemaphoreTake(bench_slots, portMAX_DELAY);
+    }
+
+    *bytes = 0;
+    *frames = 0;
+    const int64_t start = esp_timer_get_time();
+    const int64_t end = start + CONFIG_NOGLIB_BENCH_CASE_MS * 1000LL;
+    while (ret == ESP_OK && esp_timer_get_time() < end) {
+        for (int y = 0; y < BSP_LCD_V_RES && ret == ESP_OK; y += lines) {
+            const int y2 = (y + lines < BSP_LCD_V_RES) ? (y + lines) : BSP_LCD_V_RES;
+            for (int x = 0; x < BSP_LCD_H_RES && ret == ESP_OK; x += stripe_w) {
+                const int x2 = (x + stripe_w < BSP_LCD_H_RES) ? (x + stripe_w) : BSP_LCD_H_RES;
+                ret = bench_draw(panel, x, y, x2, y2, buf);
+                *bytes += (x2 - x) * (y2 - y) * BENCH_BYTES_PER_PIXEL;
+            }
+        }
+        (*frames)++;
+    }
+
+    // Wait for the last transfers
+    for (int i = 0; i < depth; i++) {
+        xSemaphoreTake(bench_slots, portMAX_DELAY);
+    }
+    *time_us = esp_timer_get_time() - start;
+    for (int i = 0; i < BENCH_MAX_DEPTH; i++) {
+        xSemaphoreGive(bench_slots);
+    }
+    return ret;
+}
+
+esp_err_t bus_benchmark_run(void)
+{
+    esp_err_t ret = ESP_OK;
+    esp_lcd_panel_handle_t panel = NULL;
+    esp_lcd_panel_io_handle_t io = NULL;
+    float best_mbps = 0;
+    float best_fps = 0;
+
+    bench_slots = xSemaphoreCreateCounting(BENCH_MAX_DEPTH, BENCH_MAX_DEPTH);
+    ESP_RETURN_ON_FALSE(bench_slots, ESP_ERR_NO_MEM, TAG, "Not enough memory");
+
+    // One transfer can carry a full frame
+    const bsp_display_config_t lcd_config = {
+        .max_transfer_sz = BENCH_FRAME_SIZE,
+        .trans_queue_depth = BENCH_MAX_DEPTH,
+    };
+    ESP_GOTO_ON_ERROR(bsp_display_new(&lcd_config, &panel, &io), err, TAG, "Display init failed");
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_disp_on_off(panel, true), err, TAG, "Display on failed");
+    const esp_lcd_panel_io_callbacks_t cbs = {
+        .on_color_trans_done = bench_trans_done,
+    };
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_io_register_event_callbacks(io, &cbs, NULL), err, TAG, "Register callback failed");
+    bsp_display_backlight_on();
+
+    ESP_LOGI(TAG, "Display %dx%d, %d bits per pixel, frame %d bytes", BSP_LCD_H_RES, BSP_LCD_V_RES, BSP_LCD_BITS_PER_PIXEL, BENCH_FRAME_SIZE);
+    ESP_LOGI(TAG, "pattern  lines  depth  mem     MB/s     FPS");
+    for (int m = 0; m < sizeof(bench_mems) / sizeof(bench_mems[0]); m++) {
+        for (int l = 0; l < sizeof(bench_lines) / sizeof(bench_lines[0]); l++) {
+            const int lines = bench_lines[l];
+            const size_t buf_size = BSP_LCD_H_RES * lines * BENCH_BYTES_PER_PIXEL;
+            void *buf = heap_caps_aligned_alloc(64, buf_size, bench_mems[m].caps);
+            if (buf == NULL) {
+                ESP_LOGW(TAG, "%-5s buffer of %d lines (%d bytes) not allocated, skipped", bench_mems[m].name, lines, (int)buf_size);
+                continue;
+            }
+            // Each buffer size has its own color, so the cases can be told apart on the display
+            memset(buf, 0x18 * (l + 1), buf_size);
+
+            for (int p = 0; p < 2; p++) {
+                for (int d = 0; d < sizeof(bench_depths) / sizeof(bench_depths[0]); d++) {
+                    uint64_t bytes;
+                    uint32_t frames;
+                    int64_t time_us;
+                    ret = bench_case(panel, buf, lines, bench_depths[d], (p == 1), &bytes, &frames, &time_us);
+                    if (ret != ESP_OK) {
+                        ESP_LOGW(TAG, "%-7s  %5d  %5d  %-5s  failed (%s)", p ? "striped" : "full", lines, bench_depths[d],
+                                 bench_mems[m].name, esp_err_to_name(ret));
+                        continue;
+                    }
+                    // Bytes per microsecond is MB/s
+                    const float mbps = (float)bytes / time_us;
+                    const float fps = frames * 1000000.0f / time_us;
+                    ESP_LOGI(TAG, "%-7s  %5d  %5d  %-5s  %7.2f  %6.1f", p ? "striped" : "full", lines, bench_depths[d],
+                             bench_mems[m].name, mbps, fps);
+                    if (mbps > best_mbps) {
+                        best_mbps = mbps;
+                        best_fps = fps;
+                    }
+                }
+            }
+            heap_caps_free(buf);
+        }
+    }
+    ESP_LOGI(TAG, "Bus ceiling %.2f MB/s, %.1f FPS of full frames", best_mbps, best_fps);
+    ret = ESP_OK;
+
+err:
+    if (io) {
+        const esp_lcd_panel_io_callbacks_t no_cbs = {0};
+        esp_lcd_panel_io_register_event_callbacks(io, &no_cbs, NULL);
+    }
+    vSemaphoreDelete(bench_slots);
+    bench_slots = NULL;
+    return ret;
+}
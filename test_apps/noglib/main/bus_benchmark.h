@@ -0,0 +1,21 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#pragma once
+#include "esp_err.h"
+
+/**
+ * @brief Measure throughput of the display bus of the BSP
+ *
+ * The display is created by bsp_display_new() and full frames are sent by esp_lcd_panel_draw_bitmap()
+ * in bands or stripes of different sizes, with different number of transfers in flight and with
+ * the pixel buffer in SRAM and PSRAM. Effective MB/s and FPS of each case are printed to the log.
+ *
+ * @return
+ *      - ESP_OK         On success
+ *      - Else           esp_lcd or memory failure
+ */
+esp_err_t bus_benchmark_run(void);
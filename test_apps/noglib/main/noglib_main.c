@@ -6,48 +6,53 @@
 
 #include <stdbool.h>
 #include "esp_err.h"
-#include "esp_heap_caps.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_panel_io.h"
 #include "driver/spi_master.h"
 
 #include "bsp/esp-bsp.h"
 #include "pretty_effect.h"
+#include "bus_benchmark.h"
 
 // To speed up transfers, every SPI transfer sends a bunch of lines. This define specifies how many.
 // More means more memory use, but less overhead for setting up / finishing transfers
 #define PARALLEL_LINES (240 / 5)
 #define FRAME_BUF_SIZE (320 * PARALLEL_LINES * BSP_LCD_BITS_PER_PIXEL / 8)
-#define FRAME_BUF_NUM  (2)
 
 // The number of frames to show before rotate the graph
 #define ROTATE_FRAME   30
 
-// Simple routine to generate some patterns and send them to the LCD. Because the
-// SPI driver handles transactions in the background, we can calculate the next line
-// while the previous one is being sent.
-static uint16_t *s_lines[FRAME_BUF_NUM];
-static void display_pretty_colors(esp_lcd_panel_handle_t panel_handle)
+#if !CONFIG_NOGLIB_BUS_BENCHMARK
+// Simple routine to generate some patterns and send them to the LCD. The framebuffer
+// alternates two DMA buffers, so we can calculate the next lines while the previous
+// ones are being sent.
+static void display_pretty_colors(bsp_display_fb_handle_t fb)
 {
     int frame = 0;
-    // Indexes of the line currently being sent to the LCD and the line we're calculating
-    int sending_line = 0;
-    int calc_line = 0;
 
     // After ROTATE_FRAME frames, the image will be rotated
     while (frame <= ROTATE_FRAME) {
         frame++;
         for (int y = 0; y < 240; y += PARALLEL_LINES) {
-            // Calculate a line
-            pretty_effect_calc_lines(s_lines[calc_line], y, frame, PARALLEL_LINES);
-            sending_line = calc_line;
-            calc_line = !calc_line;
-            // Send the calculated data
-            esp_lcd_panel_draw_bitmap(panel_handle, 0, y, 0 + 320, y + PARALLEL_LINES, s_lines[sending_line]);
+            // Calculate lines into a free buffer
+            uint16_t *lines = bsp_display_fb_acquire(fb, 0);
+            pretty_effect_calc_lines(lines, y, frame, PARALLEL_LINES);
+            // Send the calculated data, it is not waited for
+            ESP_ERROR_CHECK(bsp_display_fb_present(fb, 0, y, 0 + 320, y + PARALLEL_LINES));
         }
     }
 }
 
+#endif
+
+#if CONFIG_NOGLIB_BUS_BENCHMARK
+void app_main(void)
+{
+    // Only bsp_display_new() is used, so the benchmark runs with any SPI/I8080 BSP
+    ESP_ERROR_CHECK(bsp_display_brightness_init());
+    ESP_ERROR_CHECK(bus_benchmark_run());
+}
+#else
 void app_main(void)
 {
     bool is_rotated = false;
@@ -71,25 +76,32 @@ void app_main(void)
     ESP_ERROR_CHECK(esp_lcd_panel_swap_xy(lcd_panel, true));
     ESP_ERROR_CHECK(bsp_display_backlight_on());
 
-    // Allocate memory for the pixel buffers
-    for (int i = 0; i < FRAME_BUF_NUM; i++) {
-        s_lines[i] = heap_caps_malloc(FRAME_BUF_SIZE, MALLOC_CAP_DMA);
-        assert(s_lines[i] != NULL);
-    }
+    // Two DMA pixel buffers sent in turn
+    bsp_display_fb_handle_t fb;
+    const bsp_display_fb_config_t fb_config = {
+        .panel = lcd_panel,
+        .io = lcd_panel_io,
+        .buffer_size = FRAME_BUF_SIZE,
+    };
+    ESP_ERROR_CHECK(bsp_display_fb_new(&fb_config, &fb));
 
     // Start and rotate
     while (1) {
+        // Mirroring must not change during transfers of the previous frame
+        ESP_ERROR_CHECK(bsp_display_fb_wait(fb, 0));
         // Set driver configuration to rotate 180 degrees each time
         ESP_ERROR_CHECK(esp_lcd_panel_mirror(lcd_panel, is_rotated, is_rotated));
         // Display
-        display_pretty_colors(lcd_panel);
+        display_pretty_colors(fb);
         is_rotated = !is_rotated;
 
         ESP_ERROR_CHECK(bsp_led_set(BSP_LED_BLUE, is_rotated));
     }
 
     // Clean-up with esp_lcd API
+    bsp_display_fb_del(fb);
     esp_lcd_panel_del(lcd_panel);
     esp_lcd_panel_io_del(lcd_panel_io);
     spi_bus_free(BSP_LCD_SPI_NUM);
 }
+#endif